@@ -0,0 +1,787 @@
+#! /usr/bin/env python3
+##
+#       wrap -- text reformatter
+#       mkunicode.py
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+"""
+Generates src/unicode_tables.c from the Unicode Character Database (UCD).
+
+Usage: mkunicode.py UCD_DIR > src/unicode_tables.c
+
+where UCD_DIR contains UnicodeData.txt, EastAsianWidth.txt, LineBreak.txt,
+auxiliary/GraphemeBreakProperty.txt, and emoji/emoji-data.txt (or all of them
+directly in UCD_DIR) from https://www.unicode.org/Public/UCD/latest/ucd/.
+"""
+
+import os
+import re
+import sys
+
+########## Table parameters ###################################################
+
+# These must match the constants of the same name in src/unicode.h.
+CP_WIDTH_BLOCK_SHIFT  = 7
+CP_WIDTH_TABLE_END    = 0x40000
+
+CP_PROPS_BLOCK_SHIFT  = 7
+CP_PROPS_TABLE_END    = 0x40000
+
+CP_GCB_BLOCK_SHIFT    = 7
+CP_GCB_TABLE_END      = 0x40000
+
+CP_LB_BLOCK_SHIFT     = 7
+CP_LB_TABLE_END       = 0x40000
+
+CP_VALID_MAX          = 0x10FFFF
+
+# Bits of enum cp_prop in src/unicode.h.
+CP_PROP_ALPHA         = 1 << 0
+CP_PROP_CONTROL       = 1 << 1
+CP_PROP_EOS           = 1 << 2
+CP_PROP_EOS_EXT       = 1 << 3
+CP_PROP_HYPHEN        = 1 << 4
+CP_PROP_SPACE         = 1 << 5
+CP_PROP_WORD          = 1 << 6
+
+CP_PROP_NAMES = [
+  ( CP_PROP_ALPHA,   'CP_PROP_ALPHA'   ),
+  ( CP_PROP_CONTROL, 'CP_PROP_CONTROL' ),
+  ( CP_PROP_EOS,     'CP_PROP_EOS'     ),
+  ( CP_PROP_EOS_EXT, 'CP_PROP_EOS_EXT' ),
+  ( CP_PROP_HYPHEN,  'CP_PROP_HYPHEN'  ),
+  ( CP_PROP_SPACE,   'CP_PROP_SPACE'   ),
+  ( CP_PROP_WORD,    'CP_PROP_WORD'    ),
+]
+
+########## Property rules #####################################################
+
+# Code-points that are end-of-sentence, end-of-sentence-extender, or hyphen
+# characters even though the rules below don't select them.
+EXTRA_EOS     = { 0x2757, 0x2762, 0x2763 }  # heavy exclamation mark dingbats
+EXTRA_EOS_EXT = { 0x275C, 0x275E }          # heavy quotation mark dingbats
+EXTRA_HYPHEN  = { 0x00AD, 0x2053, 0x30FB, 0xFF65 }
+
+# Space separators that don't separate words.
+NO_BREAK_SPACE = { 0x00A0, 0x2007, 0x202F }
+
+# Join_Control characters: they're part of words (UTS #18).
+JOIN_CONTROL   = { 0x200C, 0x200D }
+
+RE_EOS_NAME     = re.compile(
+  r'(^| )(FULL STOP|QUESTION MARK|EXCLAMATION MARK)$'
+)
+RE_EOS_NOT_NAME = re.compile( r'INITIAL|INVERTED|REVERSED|TURNED' )
+RE_QUOTE_NAME   = re.compile( r'^(FULLWIDTH )?(APOSTROPHE|QUOTATION MARK)$' )
+RE_HYPHEN_NAME  = re.compile( r'\bHYPHEN' )
+
+def is_alpha( gc ):
+  """Letters, letter numbers, and the combining marks that either are part of
+  letters or modify them."""
+  return gc[0] == 'L' or gc in ( 'Mc', 'Mn', 'Nl' )
+
+def is_control( gc ):
+  """Control characters plus the line and paragraph separators."""
+  return gc in ( 'Cc', 'Zl', 'Zp' )
+
+def is_eos( cp, gc, name ):
+  """Sentence-terminating punctuation: full stops, question marks, and
+  exclamation marks (but not ones that begin sentences)."""
+  return cp in EXTRA_EOS or \
+    (gc == 'Po' and RE_EOS_NAME.search( name ) is not None and
+     RE_EOS_NOT_NAME.search( name ) is None)
+
+def is_eos_ext( cp, gc, name ):
+  """Punctuation that may follow an end-of-sentence character and still end
+  a sentence: closing brackets and quotation marks."""
+  return cp in EXTRA_EOS_EXT or gc in ( 'Pe', 'Pf' ) or \
+    (gc == 'Po' and RE_QUOTE_NAME.search( name ) is not None)
+
+def is_hyphen( cp, gc, name, lb ):
+  """Dashes and hyphens after which a line may be wrapped, i.e., excluding
+  non-breaking ones."""
+  if cp in EXTRA_HYPHEN:
+    return True
+  if lb == 'GL':
+    return False
+  return gc == 'Pd' or \
+    (gc == 'Po' and RE_HYPHEN_NAME.search( name ) is not None)
+
+def is_space( cp, gc ):
+  """Whitespace that separates words, i.e., excluding no-break spaces."""
+  return gc in ( 'Zl', 'Zp' ) or (gc == 'Zs' and cp not in NO_BREAK_SPACE)
+
+def is_word( cp, gc ):
+  """Characters of words (UTS #18's \\w): alphabetic characters, all marks,
+  decimal digits, connector punctuation, and joiners."""
+  return is_alpha( gc ) or gc in ( 'Me', 'Nd', 'Pc' ) or cp in JOIN_CONTROL
+
+def width_of( cp, gc, eaw ):
+  """The number of columns a code-point occupies when displayed."""
+  if cp < 0x20 or 0x7F <= cp < 0xA0 or cp == 0x00AD:
+    return 1
+  if gc in ( 'Mn', 'Me', 'Cf' ):
+    return 0
+  if 0x1160 <= cp <= 0x11FF or 0xD7B0 <= cp <= 0xD7FF or cp == 0x200B:
+    return 0                            # Hangul medial/final jamo, ZWSP
+  if eaw in ( 'W', 'F' ) and (gc != 'Cn' or cp < CP_WIDTH_TABLE_END):
+    return 2
+  return 1
+
+########## Grapheme cluster rules ############################################
+
+# Grapheme_Cluster_Break values to names of enum cp_gcb in src/unicode.h.
+GCB_NAMES = {
+  'Other': 'OTHER', 'Control': 'CONTROL', 'CR': 'CR', 'Extend': 'EXTEND',
+  'L': 'L', 'LF': 'LF', 'LV': 'LV', 'LVT': 'LVT', 'Prepend': 'PREPEND',
+  'Regional_Indicator': 'RI', 'SpacingMark': 'SPACING_MARK', 'T': 'T',
+  'V': 'V', 'ZWJ': 'ZWJ',
+}
+
+def gcb_is_break( a, b ):
+  """Whether UAX #29 allows a grapheme cluster boundary between adjacent
+  characters with properties a and b by rules GB3-GB9b.  The rules that need
+  more context (GB11-GB13) are in cp_gcb_is_break_impl() in src/unicode.c."""
+  if (a, b) == ('CR', 'LF'):                            # GB3
+    return False
+  if a in ( 'CONTROL', 'CR', 'LF' ) or \
+     b in ( 'CONTROL', 'CR', 'LF' ):                    # GB4, GB5
+    return True
+  if (a == 'L' and b in ( 'L', 'V', 'LV', 'LVT' )) or \
+     (a in ( 'LV', 'V' ) and b in ( 'V', 'T' )) or \
+     (a in ( 'LVT', 'T' ) and b == 'T'):                # GB6, GB7, GB8
+    return False
+  if b in ( 'EXTEND', 'ZWJ', 'SPACING_MARK' ) or \
+     a == 'PREPEND':                                    # GB9, GB9a, GB9b
+    return False
+  return True                                           # GB999
+
+########## Line-breaking rules ###############################################
+
+def lb_resolve( lb, gc ):
+  """Resolves a Line_Break value per UAX #14 rule LB1 without a dictionary:
+  unknown and ambiguous classes become AL (so runs of South East Asian
+  characters like Thai aren't broken within) and conditional Japanese
+  starters become ID (like the CSS "normal" line-break strictness)."""
+  if lb == 'SA':
+    return 'CM' if gc in ( 'Mn', 'Mc' ) else 'AL'
+  if lb == 'CJ':
+    return 'ID'
+  if lb in ( 'CR', 'LF', 'NL' ):
+    return 'BK'
+  return lb if lb in LB_CLASSES else 'AL'
+
+KOREAN = ( 'JL', 'JV', 'JT', 'H2', 'H3' )
+
+LB25_PAIRS = {
+  ('CL', 'PO'), ('CP', 'PO'), ('CL', 'PR'), ('CP', 'PR'), ('NU', 'PO'),
+  ('NU', 'PR'), ('PO', 'OP'), ('PO', 'NU'), ('PR', 'OP'), ('PR', 'NU'),
+  ('HY', 'NU'), ('IS', 'NU'), ('NU', 'NU'), ('SY', 'NU'),
+}
+
+def lb_is_break( a, b ):
+  """Whether UAX #14 allows a line break between adjacent characters of
+  classes a and b (with no spaces between them), applying rules LB4-LB31 in
+  order.  Rules needing more context are approximated as documented for
+  cp_lb_is_break() in src/unicode.h."""
+  if a == 'BK':                                         # LB4, LB5
+    return True
+  if b in ( 'BK', 'SP', 'ZW' ):                         # LB6, LB7
+    return False
+  if a in ( 'SP', 'ZW' ):                               # LB8, LB18
+    return True
+  if a == 'ZWJ' or b in ( 'CM', 'ZWJ' ):                # LB8a, LB9
+    return False
+  if a == 'CM':                                         # LB10
+    a = 'AL'
+  if 'WJ' in ( a, b ) or a == 'GL':                     # LB11, LB12
+    return False
+  if b == 'GL' and a not in ( 'BA', 'HY' ):             # LB12a
+    return False
+  if b in ( 'CL', 'CP', 'EX', 'IS', 'SY' ):             # LB13
+    return False
+  if a == 'OP' or (a, b) in { ('CL', 'NS'), ('CP', 'NS'), ('B2', 'B2') }:
+    return False                                        # LB14, LB16, LB17
+  if 'QU' in ( a, b ):                                  # LB15, LB19
+    return False
+  if 'CB' in ( a, b ):                                  # LB20
+    return True
+  if b in ( 'BA', 'HY', 'NS' ) or a == 'BB':            # LB21
+    return False
+  if (a, b) == ('SY', 'HL') or b == 'IN':               # LB21b, LB22
+    return False
+  if (a in ( 'AL', 'HL' ) and b == 'NU') or \
+     (a == 'NU' and b in ( 'AL', 'HL' )):               # LB23
+    return False
+  if (a == 'PR' and b in ( 'ID', 'EB', 'EM' )) or \
+     (a in ( 'ID', 'EB', 'EM' ) and b == 'PO'):         # LB23a
+    return False
+  if (a in ( 'PR', 'PO' ) and b in ( 'AL', 'HL' )) or \
+     (a in ( 'AL', 'HL' ) and b in ( 'PR', 'PO' )):     # LB24
+    return False
+  if (a, b) in LB25_PAIRS:                              # LB25
+    return False
+  if (a == 'JL' and b in ( 'JL', 'JV', 'H2', 'H3' )) or \
+     (a in ( 'JV', 'H2' ) and b in ( 'JV', 'JT' )) or \
+     (a in ( 'JT', 'H3' ) and b == 'JT'):               # LB26
+    return False
+  if (a in KOREAN and b == 'PO') or (a == 'PR' and b in KOREAN):
+    return False                                        # LB27
+  if a in ( 'AL', 'HL' ) and b in ( 'AL', 'HL' ):       # LB28
+    return False
+  if a == 'IS' and b in ( 'AL', 'HL' ):                 # LB29
+    return False
+  if (a in ( 'AL', 'HL', 'NU' ) and b == 'OP') or \
+     (a == 'CP' and b in ( 'AL', 'HL', 'NU' )):         # LB30
+    return False
+  if (a, b) in { ('RI', 'RI'), ('EB', 'EM') }:          # LB30a, LB30b
+    return False
+  return True                                           # LB31
+
+########## UCD parsing ########################################################
+
+def ucd_path( ucd_dir, file_name ):
+  """Gets the path of a UCD file either in its subdirectory, if any, as in
+  the UCD proper or directly in ucd_dir."""
+  for sub_dir in ( 'auxiliary', 'emoji' ):
+    path = os.path.join( ucd_dir, sub_dir, file_name )
+    if os.path.exists( path ):
+      return path
+  return os.path.join( ucd_dir, file_name )
+
+def ucd_lines( ucd_dir, file_name ):
+  """Yields the (first, last, fields) of every line of a UCD file."""
+  with open( ucd_path( ucd_dir, file_name ), encoding='utf-8' ) as f:
+    for line in f:
+      missing = line.startswith( '# @missing:' )
+      if missing:
+        line = line[ len( '# @missing:' ): ]
+      else:
+        line = line.split( '#', 1 )[0]
+      fields = [ field.strip() for field in line.split( ';' ) ]
+      if len( fields ) < 2:
+        continue
+      cps = fields[0].split( '..' )
+      yield int( cps[0], 16 ), int( cps[-1], 16 ), fields[1:], missing
+
+def ucd_property( ucd_dir, file_name, default ):
+  """Gets a list of the values of a simple UCD property for every
+  code-point."""
+  values = [ default ] * (CP_VALID_MAX + 1)
+  explicit = []
+  for first, last, fields, missing in ucd_lines( ucd_dir, file_name ):
+    if missing:                         # @missing lines come first
+      values[ first:last + 1 ] = [ fields[0] ] * (last - first + 1)
+    else:
+      explicit.append( (first, last, fields[0]) )
+  for first, last, value in explicit:
+    values[ first:last + 1 ] = [ value ] * (last - first + 1)
+  return values
+
+def ucd_extended_pictographic( ucd_dir ):
+  """Gets the set of Extended_Pictographic code-points."""
+  cps = set()
+  for first, last, fields, missing in ucd_lines( ucd_dir, 'emoji-data.txt' ):
+    if not missing and fields[0] == 'Extended_Pictographic':
+      cps.update( range( first, last + 1 ) )
+  return cps
+
+def ucd_unicode_data( ucd_dir ):
+  """Gets lists of the general category and name of every code-point."""
+  gcs = [ 'Cn' ] * (CP_VALID_MAX + 1)
+  names = [ '' ] * (CP_VALID_MAX + 1)
+  first = None
+  for cp, _, fields, _ in ucd_lines( ucd_dir, 'UnicodeData.txt' ):
+    name, gc = fields[0], fields[1]
+    if name.endswith( ', First>' ):
+      first = cp
+      continue
+    if name.endswith( ', Last>' ):
+      gcs[ first:cp + 1 ] = [ gc ] * (cp - first + 1)
+      first = None
+      continue
+    gcs[ cp ] = gc
+    names[ cp ] = fields[9] if name == '<control>' else name
+  return gcs, names
+
+def ucd_version( ucd_dir ):
+  """Gets the Unicode version from the first line of EastAsianWidth.txt."""
+  with open( os.path.join( ucd_dir, 'EastAsianWidth.txt' ),
+             encoding='utf-8' ) as f:
+    m = re.search( r'-(\d+\.\d+)\.\d+\.txt', f.readline() )
+  return m.group( 1 ) if m else '?'
+
+def enum_names( header, enum, prefix ):
+  """Gets the list of names (sans prefix) in the order they're declared by an
+  enum in src/unicode.h except for the last (the count)."""
+  with open( header, encoding='utf-8' ) as f:
+    body = re.search( r'enum %s \{(.*?)\};' % enum, f.read(), re.S ).group( 1 )
+  return re.findall( r'^\s*%s(\w+),' % prefix, body, re.M )
+
+UNICODE_H = os.path.join(
+  os.path.dirname( os.path.abspath( __file__ ) ), 'src', 'unicode.h'
+)
+GCB_CLASSES = enum_names( UNICODE_H, 'cp_gcb', 'CP_GCB_' )
+LB_CLASSES  = enum_names( UNICODE_H, 'cp_lb', 'CP_LB_' )
+
+########## Output #############################################################
+
+def two_stage( values, shift, end ):
+  """Compresses values[0:end] into two stages: a list of block indices and a
+  list of unique blocks each of 2^shift values."""
+  size = 1 << shift
+  index = {}
+  blocks = []
+  stage1 = []
+  for i in range( 0, end, size ):
+    block = tuple( values[ i:i + size ] )
+    if block not in index:
+      index[ block ] = len( blocks )
+      blocks.append( block )
+    stage1.append( index[ block ] )
+  return stage1, blocks
+
+def emit_stage1( decl, stage1, shift ):
+  print( '%s[] = {' % decl )
+  for i in range( 0, len( stage1 ), 16 ):
+    row = ','.join( '%3d' % x for x in stage1[ i:i + 16 ] )
+    last = i + 16 >= len( stage1 )
+    print( '  /* %05X */ %s%s' % (i << shift, row, '' if last else ',') )
+  print( '};' )
+
+def emit_stage2( decl, blocks, per_line ):
+  print( '%s[] = {' % decl )
+  for b, block in enumerate( blocks ):
+    for i in range( 0, len( block ), per_line ):
+      prefix = '  /* %3d */ ' % b if i == 0 else '            '
+      last = b == len( blocks ) - 1 and i + per_line >= len( block )
+      row = ', '.join( '0x%02X' % x for x in block[ i:i + per_line ] )
+      print( prefix + row + ('' if last else ',') )
+  print( '};' )
+
+def ranges( cps ):
+  """Yields the (first, last) of every run of consecutive code-points."""
+  first = last = None
+  for cp in cps:
+    if last is not None and cp == last + 1:
+      last = cp
+      continue
+    if first is not None:
+      yield first, last
+    first = last = cp
+  if first is not None:
+    yield first, last
+
+def range_name( first, last ):
+  """Gets the name for a range of code-points given the names of its first
+  and last code-points, e.g., "VARIATION SELECTOR-17 - 256"."""
+  n = len( os.path.commonprefix( [ first, last ] ) )
+  while n > 0 and first[ n - 1 ] not in ' -':
+    n -= 1
+  return '%s - %s' % (first, last[ n: ])
+
+def emit_cond_return( cps, names, if_true, if_false ):
+  """Emits the body of a function returning if_true only for the given
+  code-points or if_false otherwise."""
+  conds = []
+  for first, last in ranges( cps ):
+    if first == last:
+      conds.append( ('cp == 0x%X' % first, names[ first ]) )
+    else:
+      conds.append( ('(cp >= 0x%X && cp <= 0x%X)' % (first, last),
+                     range_name( names[ first ], names[ last ] )) )
+  if not conds:
+    print( '  (void)cp;' )
+    print( '  return %s;' % if_false )
+    return
+  pad = max( len( c ) for c, _ in conds ) + 3
+  for i, (cond, comment) in enumerate( conds ):
+    lead = '  return  ' if i == 0 else '          '
+    tail = ' ||' if i < len( conds ) - 1 else ' ?'
+    print( ('%s%s%s' % (lead, cond, tail)).ljust( 10 + pad ) +
+           ' // ' + comment )
+  print( '          %s : %s;' % (if_true, if_false) )
+
+def emit_if_returns( values, names, first_cp, default, prefix ):
+  """Emits the body of a function returning the value of every code-point
+  from first_cp on that isn't the default."""
+  for value in sorted( set( values[ first_cp: ] ) - { default } ):
+    conds = []
+    for first, last in ranges(
+        [ cp for cp in range( first_cp, CP_VALID_MAX + 1 )
+          if values[ cp ] == value ] ):
+      first_name = names[ first ] or 'U+%04X' % first
+      last_name = names[ last ] or 'U+%04X' % last
+      if first == last:
+        conds.append( ('cp == 0x%X' % first, first_name) )
+      else:
+        conds.append( ('(cp >= 0x%X && cp <= 0x%X)' % (first, last),
+                       range_name( first_name, last_name )) )
+    pad = max( len( c ) for c, _ in conds ) + 4
+    for i, (cond, comment) in enumerate( conds ):
+      lead = '  if ( ' if i == 0 else '       '
+      tail = ' ||' if i < len( conds ) - 1 else ' )'
+      print( ('%s%s%s' % (lead, cond, tail)).ljust( 7 + pad ) +
+             ' // ' + comment )
+    print( '    return %s%s;' % (prefix, value) )
+  print( '  return %s%s;' % (prefix, default) )
+
+def prop_names( props ):
+  """Gets the C expression for a set of cp_prop bits."""
+  return ' | '.join( name for bit, name in CP_PROP_NAMES if props & bit ) or '0'
+
+def emit_gcb_breaks():
+  print( 'uint16_t const CP_GCB_BREAKS[] = {' )
+  for i, a in enumerate( GCB_CLASSES ):
+    a_rule = 'OTHER' if a == 'EXT_PICT' else a
+    bits = sum( 1 << j for j, b in enumerate( GCB_CLASSES )
+                if gcb_is_break( a_rule, 'OTHER' if b == 'EXT_PICT' else b ) )
+    last = i == len( GCB_CLASSES ) - 1
+    print( '  /* %-12s */ 0x%04X%s' % (a, bits, '' if last else ',') )
+  print( '};' )
+
+def emit_lb_impl( lbs, names ):
+  above = range( CP_LB_TABLE_END, CP_VALID_MAX + 1 )
+  others = { lbs[ cp ] for cp in above } - { 'AL' }
+  assert len( others ) <= 1
+  lb = others.pop() if others else 'CM'
+  print( 'cp_lb_t cp_lb_impl( char32_t cp ) {' )
+  emit_cond_return( [ cp for cp in above if lbs[ cp ] == lb ], names,
+                    'CP_LB_' + lb, 'CP_LB_AL' )
+  print( '}' )
+
+def emit_lb_breaks():
+  print( 'uint64_t const CP_LB_BREAKS[] = {' )
+  for i, a in enumerate( LB_CLASSES ):
+    bits = sum( 1 << j for j, b in enumerate( LB_CLASSES )
+                if lb_is_break( a, b ) )
+    last = i == len( LB_CLASSES ) - 1
+    print( '  /* %-3s */ UINT64_C(0x%016X)%s' % (a, bits, '' if last else ',') )
+  print( '};' )
+
+def emit_width_impl( widths, names ):
+  assert all( widths[ cp ] in ( 0, 1 )
+              for cp in range( CP_WIDTH_TABLE_END, CP_VALID_MAX + 1 ) )
+  print( 'size_t cp_width_impl( char32_t cp ) {' )
+  emit_cond_return(
+    [ cp for cp in range( CP_WIDTH_TABLE_END, CP_VALID_MAX + 1 )
+      if widths[ cp ] == 0 ], names, '0', '1'
+  )
+  print( '}' )
+
+HEADER = '''\
+/*
+**      wrap -- text reformatter
+**      src/unicode_tables.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines tables of Unicode code-point properties.
+ *
+ * @note This file was generated by `mkunicode.py` from Unicode %(version)s;
+ * don't edit it by hand.  To regenerate it, do `make unicode-tables
+ * UCD_DIR=`_dir_ where _dir_ contains the `UnicodeData.txt`,
+ * `EastAsianWidth.txt`, and `LineBreak.txt` files.
+ *
+ * Widths are:
+ *
+ *  + 0 for characters of general category Mn, Me, or Cf (except U+00AD SOFT
+ *    HYPHEN), Hangul Jamo medial vowels and final consonants (U+1160-U+11FF
+ *    and U+D7B0-U+D7FF), and U+200B ZERO WIDTH SPACE.
+ *  + 2 for characters whose East_Asian_Width is W or F.
+ *  + 1 for all other characters.
+ *
+ * Properties are:
+ *
+ *  + Alphabetic: characters of general category L*, Mc, Mn, or Nl.
+ *  + Control: characters of general category Cc, Zl, or Zp.
+ *  + End-of-sentence: characters of general category Po named "FULL STOP,"
+ *    "QUESTION MARK," or "EXCLAMATION MARK" except ones that begin sentences.
+ *  + End-of-sentence-extender: characters of general category Pe or Pf
+ *    (closing brackets and quotation marks) plus apostrophes and neutral
+ *    quotation marks.
+ *  + Hyphen: characters of general category Pd or punctuation named "HYPHEN"
+ *    except ones whose Line_Break is GL (non-breaking).
+ *  + Space: characters of general category Zl, Zp, or Zs except no-break
+ *    spaces.
+ *  + Word: alphabetic characters plus characters of general category Me, Nd,
+ *    or Pc and U+200C ZERO WIDTH NON-JOINER and U+200D ZERO WIDTH JOINER.
+ *
+ * plus a few dingbats and other characters listed in `mkunicode.py`.  ASCII
+ * characters' properties are in `CP_PROPS_ASCII` in unicode.c instead.
+ *
+ * Grapheme cluster break properties are Grapheme_Cluster_Break values except
+ * that Extended_Pictographic characters (that are all Other) are \\ref
+ * CP_GCB_EXT_PICT.  Whether there's a boundary between each pair of
+ * properties is derived from the rules of UAX #29 by `gcb_is_break()` in
+ * `mkunicode.py`.
+ *
+ * Line-breaking classes are Line_Break values resolved as described for \\ref
+ * cp_lb.  Whether a line may be broken between each pair of classes is
+ * derived from the rules of UAX #14 by `lb_is_break()` in `mkunicode.py`.
+ *
+ * Since they're sparse, the tables are compressed into two stages: blocks of
+ * code-points that are identical are stored only once.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "unicode.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <inttypes.h>                   /* for uint8_t */
+
+/// @endcond
+
+/**
+ * @addtogroup unicode-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+static_assert( CP_WIDTH_BLOCK_SHIFT == %(width_shift)d, "regenerate table" );
+static_assert( CP_WIDTH_TABLE_END == 0x%(width_end)XU, "regenerate table" );
+static_assert( CP_GCB_BLOCK_SHIFT == %(gcb_shift)d, "regenerate table" );
+static_assert( CP_GCB_TABLE_END == 0x%(gcb_end)XU, "regenerate table" );
+static_assert( CP_GCB_COUNT == %(gcb_count)d, "regenerate table" );
+static_assert( CP_LB_BLOCK_SHIFT == %(lb_shift)d, "regenerate table" );
+static_assert( CP_LB_TABLE_END == 0x%(lb_end)XU, "regenerate table" );
+static_assert( CP_LB_COUNT == %(lb_count)d, "regenerate table" );
+static_assert( CP_PROPS_BLOCK_SHIFT == %(props_shift)d, "regenerate table" );
+static_assert( CP_PROPS_TABLE_END == 0x%(props_end)XU, "regenerate table" );
+'''
+
+FOOTER = '''
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */'''
+
+def main():
+  if len( sys.argv ) != 2:
+    sys.exit( 'usage: mkunicode.py UCD_DIR' )
+  ucd_dir = sys.argv[1]
+  gcs, names = ucd_unicode_data( ucd_dir )
+  eaws = ucd_property( ucd_dir, 'EastAsianWidth.txt', 'N' )
+  lbs = ucd_property( ucd_dir, 'LineBreak.txt', 'XX' )
+  gcbs = ucd_property( ucd_dir, 'GraphemeBreakProperty.txt', 'Other' )
+  pictographic = ucd_extended_pictographic( ucd_dir )
+
+  widths = [ width_of( cp, gcs[ cp ], eaws[ cp ] )
+             for cp in range( CP_VALID_MAX + 1 ) ]
+  props = [ 0 ] * (CP_VALID_MAX + 1)
+  for cp in range( 0x80, CP_VALID_MAX + 1 ):
+    gc, name = gcs[ cp ], names[ cp ]
+    props[ cp ] = \
+      (CP_PROP_ALPHA   if is_alpha( gc )                       else 0) | \
+      (CP_PROP_CONTROL if is_control( gc )                     else 0) | \
+      (CP_PROP_EOS     if is_eos( cp, gc, name )               else 0) | \
+      (CP_PROP_EOS_EXT if is_eos_ext( cp, gc, name )           else 0) | \
+      (CP_PROP_HYPHEN  if is_hyphen( cp, gc, name, lbs[ cp ] ) else 0) | \
+      (CP_PROP_SPACE   if is_space( cp, gc )                   else 0) | \
+      (CP_PROP_WORD    if is_word( cp, gc )                    else 0)
+  lbs = [ lb_resolve( lbs[ cp ], gcs[ cp ] )
+          for cp in range( CP_VALID_MAX + 1 ) ]
+  gcbs = [ GCB_NAMES[ gcb ] for gcb in gcbs ]
+  for cp in pictographic:
+    assert gcbs[ cp ] == 'OTHER'
+    gcbs[ cp ] = 'EXT_PICT'
+
+  print( HEADER % {
+    'version': ucd_version( ucd_dir ),
+    'width_shift': CP_WIDTH_BLOCK_SHIFT, 'width_end': CP_WIDTH_TABLE_END,
+    'props_shift': CP_PROPS_BLOCK_SHIFT, 'props_end': CP_PROPS_TABLE_END,
+    'gcb_shift': CP_GCB_BLOCK_SHIFT, 'gcb_end': CP_GCB_TABLE_END,
+    'gcb_count': len( GCB_CLASSES ),
+    'lb_shift': CP_LB_BLOCK_SHIFT, 'lb_end': CP_LB_TABLE_END,
+    'lb_count': len( LB_CLASSES ),
+  } )
+
+  stage1, blocks = \
+    two_stage( widths, CP_WIDTH_BLOCK_SHIFT, CP_WIDTH_TABLE_END )
+  assert len( blocks ) <= 256
+  packed = [ tuple( b[i] | b[i+1] << 2 | b[i+2] << 4 | b[i+3] << 6
+                    for i in range( 0, len( b ), 4 ) ) for b in blocks ]
+  print( '''/**
+ * Stage 1 of the display width table: indexed by a code-point shifted right by
+ * #CP_WIDTH_BLOCK_SHIFT, gives the index of its block in #CP_WIDTH_STAGE2.
+ */''' )
+  emit_stage1( 'uint8_t const CP_WIDTH_STAGE1', stage1, CP_WIDTH_BLOCK_SHIFT )
+  print( '''
+/**
+ * Stage 2 of the display width table: blocks of the widths of
+ * 2<sup>#CP_WIDTH_BLOCK_SHIFT</sup> code-points packed 4 per byte, 2 bits
+ * each, least significant first.
+ */''' )
+  emit_stage2( 'uint8_t const CP_WIDTH_STAGE2', packed, 8 )
+
+  stage1, blocks = two_stage( props, CP_PROPS_BLOCK_SHIFT, CP_PROPS_TABLE_END )
+  assert len( blocks ) <= 256
+  print( '''
+/**
+ * Stage 1 of the property table: indexed by a code-point shifted right by
+ * #CP_PROPS_BLOCK_SHIFT, gives the index of its block in #CP_PROPS_STAGE2.
+ */''' )
+  emit_stage1(
+    'uint8_t const CP_PROPS_STAGE1', stage1, CP_PROPS_BLOCK_SHIFT
+  )
+  print( '''
+/**
+ * Stage 2 of the property table: blocks of the \\ref cp_prop bits of
+ * 2<sup>#CP_PROPS_BLOCK_SHIFT</sup> code-points.
+ */''' )
+  emit_stage2( 'cp_props_t const CP_PROPS_STAGE2', blocks, 8 )
+
+  stage1, blocks = two_stage(
+    [ GCB_CLASSES.index( gcb ) for gcb in gcbs ], CP_GCB_BLOCK_SHIFT,
+    CP_GCB_TABLE_END
+  )
+  assert len( blocks ) <= 256
+  print( '''
+/**
+ * Stage 1 of the grapheme cluster break property table: indexed by a
+ * code-point shifted right by #CP_GCB_BLOCK_SHIFT, gives the index of its
+ * block in #CP_GCB_STAGE2.
+ */''' )
+  emit_stage1( 'uint8_t const CP_GCB_STAGE1', stage1, CP_GCB_BLOCK_SHIFT )
+  print( '''
+/**
+ * Stage 2 of the grapheme cluster break property table: blocks of the \\ref
+ * cp_gcb properties of 2<sup>#CP_GCB_BLOCK_SHIFT</sup> code-points.
+ */''' )
+  emit_stage2( 'cp_gcb_t const CP_GCB_STAGE2', blocks, 16 )
+  print( '''
+/**
+ * The grapheme cluster pair table: bit _b_ of the element for property _a_ is
+ * set only if there is a boundary between a character with property _a_ and
+ * a following character with property _b_.
+ *
+ * @sa cp_gcb_is_break()
+ */''' )
+  emit_gcb_breaks()
+
+  stage1, blocks = two_stage(
+    [ LB_CLASSES.index( lb ) for lb in lbs ], CP_LB_BLOCK_SHIFT,
+    CP_LB_TABLE_END
+  )
+  assert len( blocks ) <= 256
+  print( '''
+/**
+ * Stage 1 of the line-breaking class table: indexed by a code-point shifted
+ * right by #CP_LB_BLOCK_SHIFT, gives the index of its block in #CP_LB_STAGE2.
+ */''' )
+  emit_stage1( 'uint8_t const CP_LB_STAGE1', stage1, CP_LB_BLOCK_SHIFT )
+  print( '''
+/**
+ * Stage 2 of the line-breaking class table: blocks of the \\ref cp_lb classes
+ * of 2<sup>#CP_LB_BLOCK_SHIFT</sup> code-points.
+ */''' )
+  emit_stage2( 'cp_lb_t const CP_LB_STAGE2', blocks, 16 )
+  print( '''
+/**
+ * The line-breaking pair table: bit _b_ of the element for class _a_ is set
+ * only if a line may be broken between a character of class _a_ and a
+ * following character of class _b_.
+ *
+ * @sa cp_lb_is_break()
+ */''' )
+  emit_lb_breaks()
+
+  print( '''
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the grapheme cluster break property of \\a cp.
+ *
+ * @note This out-of-line version is for code-points not in the table.
+ *
+ * @param cp The Unicode code-point to get the grapheme cluster break property
+ * of.
+ * @return Returns said property.
+ *
+ * @sa cp_gcb()
+ */
+cp_gcb_t cp_gcb_impl( char32_t cp ) {''' )
+  emit_if_returns( gcbs, names, CP_GCB_TABLE_END, 'OTHER', 'CP_GCB_' )
+  print( '''}
+
+/**
+ * Gets the line-breaking class of \\a cp.
+ *
+ * @note This out-of-line version is for code-points not in the table.
+ *
+ * @param cp The Unicode code-point to get the line-breaking class of.
+ * @return Returns said class.
+ *
+ * @sa cp_lb()
+ */''' )
+  emit_lb_impl( lbs, names )
+  print( '''
+/**
+ * Gets the number of columns \\a cp occupies when displayed.
+ *
+ * @note This out-of-line version is for code-points not in the table.
+ *
+ * @param cp The Unicode code-point to get the width of.
+ * @return Returns said width.
+ *
+ * @sa cp_width()
+ */''' )
+  emit_width_impl( widths, names )
+  print( '''
+/**
+ * Gets the properties of \\a cp.
+ *
+ * @note This out-of-line version is for code-points not in the table.
+ *
+ * @param cp The Unicode code-point to get the properties of.
+ * @return Returns said properties.
+ *
+ * @sa cp_props()
+ */
+cp_props_t cp_props_impl( char32_t cp ) {''' )
+  emit_if_returns( [ prop_names( p ) for p in props ], names,
+                   CP_PROPS_TABLE_END, '0', '' )
+  print( '}' )
+  print( FOOTER )
+
+if __name__ == '__main__':
+  main()
+
+# vim:set et sw=2 ts=2:
@@ -0,0 +1,438 @@
+#! /usr/bin/env python3
+##
+#       wrap -- text reformatter
+#       mkwregex.py
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+"""
+Generates src/wregex_tables.c: a DFA that recognizes WRAP_RE.
+
+Usage: mkwregex.py src/wregex.h > src/wregex_tables.c
+
+The regular expression is taken from the macros in src/wregex.h, parsed as a
+POSIX extended regular expression, then converted to a minimal DFA.
+"""
+
+import re
+import sys
+
+########## Alphabet ###########################################################
+
+# The DFA's input symbols: ASCII bytes are themselves; SYM_ALNUM is any
+# non-ASCII alphanumeric character (that [:alnum:] matches in a UTF-8 locale).
+# Any other character never matches.
+SYM_ALNUM = 0x80
+SYMBOLS   = range( SYM_ALNUM + 1 )
+
+# This must match the constant of the same name in src/wregex.h.
+WRAP_RE_DFA_ACCEPT = 0x8000
+
+ASCII_CLASSES = {
+  'alnum':  { c for c in range( 0x80 ) if chr( c ).isalnum() } | { SYM_ALNUM },
+  'xdigit': { c for c in range( 0x80 ) if chr( c ) in '0123456789ABCDEFabcdef' },
+}
+
+########## Macros #############################################################
+
+RE_DEFINE = re.compile( r'^#define\s+(\w+)\s+(.*)$' )
+RE_TOKEN  = re.compile( r'"((?:[^"\\]|\\.)*)"|(\w+)|(\S)' )
+
+def header_macros( header ):
+  """Gets the macros of header whose values are sequences of string literals
+  and other such macros."""
+  macros = { }
+  with open( header, encoding='utf-8' ) as f:
+    text = f.read().replace( '\\\n', ' ' )
+  for line in text.split( '\n' ):
+    m = RE_DEFINE.match( line )
+    if m is None:
+      continue
+    tokens = [ ]
+    for string, name, other in RE_TOKEN.findall( m.group( 2 ) ):
+      if other:                         # a comment or not a string macro
+        if other != '/':
+          tokens = None
+        break
+      tokens.append( ('s', c_unescape( string )) if not name else ('m', name) )
+    if tokens:
+      macros[ m.group( 1 ) ] = tokens
+  return macros
+
+def c_unescape( s ):
+  return re.sub( r'\\(.)', r'\1', s )
+
+def expand( macros, name ):
+  """Expands macro name into the string it denotes."""
+  return ''.join( t if kind == 's' else expand( macros, t )
+                  for kind, t in macros[ name ] )
+
+########## ERE parser #########################################################
+
+class ERE:
+  """Parses a POSIX extended regular expression into a tree of tuples:
+  ('set', symbols), ('cat', a, b), ('alt', a, b), ('rep', a, min, max), and
+  ('empty',)."""
+
+  def __init__( self, pattern ):
+    self.p = pattern
+    self.i = 0
+
+  def parse( self ):
+    node = self.alt()
+    if self.i != len( self.p ):
+      sys.exit( 'unexpected "%s" at %d' % (self.p[ self.i ], self.i) )
+    return node
+
+  def peek( self ):
+    return self.p[ self.i ] if self.i < len( self.p ) else None
+
+  def alt( self ):
+    node = self.cat()
+    while self.peek() == '|':
+      self.i += 1
+      node = ('alt', node, self.cat())
+    return node
+
+  def cat( self ):
+    node = ('empty',)
+    while self.peek() not in ( None, '|', ')' ):
+      node = ('cat', node, self.repeat())
+    return node
+
+  def repeat( self ):
+    node = self.atom()
+    while True:
+      c = self.peek()
+      if c == '*':
+        node = ('rep', node, 0, None)
+      elif c == '+':
+        node = ('rep', node, 1, None)
+      elif c == '?':
+        node = ('rep', node, 0, 1)
+      elif c == '{':
+        j = self.p.index( '}', self.i )
+        bounds = self.p[ self.i + 1 : j ].split( ',' )
+        lo = int( bounds[0] )
+        hi = lo if len( bounds ) == 1 else \
+             (int( bounds[1] ) if bounds[1] else None)
+        node = ('rep', node, lo, hi)
+        self.i = j
+      else:
+        return node
+      self.i += 1
+
+  def atom( self ):
+    c = self.p[ self.i ]
+    self.i += 1
+    if c == '(':
+      node = self.alt()
+      if self.peek() != ')':
+        sys.exit( 'missing ")"' )
+      self.i += 1
+      return node
+    if c == '[':
+      return ('set', self.bracket())
+    if c == '\\':
+      c = self.p[ self.i ]
+      self.i += 1
+    elif c in '.^$':
+      sys.exit( '"%s" not supported' % c )
+    return ('set', frozenset( { ord( c ) } ))
+
+  def bracket( self ):
+    if self.peek() == '^':
+      sys.exit( '"[^" not supported' )
+    syms = set()
+    first = True
+    while first or self.peek() != ']':
+      first = False
+      if self.p.startswith( '[:', self.i ):
+        j = self.p.index( ':]', self.i )
+        syms |= ASCII_CLASSES[ self.p[ self.i + 2 : j ] ]
+        self.i = j + 2
+        continue
+      c = self.p[ self.i ]
+      if self.p[ self.i + 1 ] == '-' and self.p[ self.i + 2 ] != ']':
+        syms |= set( range( ord( c ), ord( self.p[ self.i + 2 ] ) + 1 ) )
+        self.i += 3
+      else:
+        syms.add( ord( c ) )
+        self.i += 1
+    self.i += 1
+    return frozenset( syms )
+
+########## Automata ###########################################################
+
+class NFA:
+  """A Thompson NFA: states are indices into eps (epsilon transitions) and
+  moves (a list of (symbols, target) pairs)."""
+
+  def __init__( self ):
+    self.eps = [ ]
+    self.moves = [ ]
+
+  def state( self ):
+    self.eps.append( [ ] )
+    self.moves.append( [ ] )
+    return len( self.eps ) - 1
+
+  def build( self, node ):
+    """Returns the (start, end) states of a fragment for node."""
+    kind = node[0]
+    s = self.state()
+    if kind == 'empty':
+      return s, s
+    if kind == 'set':
+      e = self.state()
+      self.moves[ s ].append( (node[1], e) )
+      return s, e
+    if kind == 'cat':
+      s1, e1 = self.build( node[1] )
+      s2, e2 = self.build( node[2] )
+      self.eps[ s ].append( s1 )
+      self.eps[ e1 ].append( s2 )
+      return s, e2
+    if kind == 'alt':
+      e = self.state()
+      for sub in node[1:]:
+        s1, e1 = self.build( sub )
+        self.eps[ s ].append( s1 )
+        self.eps[ e1 ].append( e )
+      return s, e
+    _, sub, lo, hi = node
+    e = s
+    for _ in range( lo ):
+      s1, e1 = self.build( sub )
+      self.eps[ e ].append( s1 )
+      e = e1
+    if hi is None:
+      s1, e1 = self.build( sub )
+      self.eps[ e ].append( s1 )
+      self.eps[ e1 ].append( s1 )
+      end = self.state()
+      self.eps[ e ].append( end )
+      self.eps[ e1 ].append( end )
+      return s, end
+    end = self.state()
+    for _ in range( hi - lo ):
+      self.eps[ e ].append( end )
+      s1, e1 = self.build( sub )
+      self.eps[ e ].append( s1 )
+      e = e1
+    self.eps[ e ].append( end )
+    return s, end
+
+  def closure( self, states ):
+    stack = list( states )
+    seen = set( states )
+    while stack:
+      for t in self.eps[ stack.pop() ]:
+        if t not in seen:
+          seen.add( t )
+          stack.append( t )
+    return frozenset( seen )
+
+def dfa_from_nfa( nfa, start, accept ):
+  """Converts nfa to a DFA by subset construction.  Returns (next, accepting)
+  where state 0 is dead, state 1 is the start, and next[s][sym] is the state
+  after sym."""
+  dead = frozenset()
+  index = { dead: 0 }
+  order = [ dead ]
+  init = nfa.closure( { start } )
+  index[ init ] = 1
+  order.append( init )
+  nexts = [ ]
+  i = 0
+  while i < len( order ):
+    subset = order[ i ]
+    row = [ ]
+    for sym in SYMBOLS:
+      targets = { t for s in subset for syms, t in nfa.moves[ s ]
+                  if sym in syms }
+      t = nfa.closure( targets ) if targets else dead
+      if t not in index:
+        index[ t ] = len( order )
+        order.append( t )
+      row.append( index[ t ] )
+    nexts.append( row )
+    i += 1
+  return nexts, [ accept in subset for subset in order ]
+
+def minimize( nexts, accepting ):
+  """Minimizes a DFA by partition refinement keeping states 0 and 1 first."""
+  part = [ (0 if not a else 1) for a in accepting ]
+  while True:
+    sigs = { }
+    new = [ ]
+    for s, row in enumerate( nexts ):
+      sig = (part[ s ], tuple( part[ t ] for t in row ))
+      new.append( sigs.setdefault( sig, len( sigs ) ) )
+    if len( sigs ) == len( set( part ) ):
+      break
+    part = new
+  #
+  # Renumber so the dead state is 0 and the start state is 1.
+  #
+  number = { part[0]: 0, part[1]: 1 }
+  for p in part:
+    number.setdefault( p, len( number ) )
+  n = len( number )
+  min_nexts = [ None ] * n
+  min_accepting = [ False ] * n
+  for s, row in enumerate( nexts ):
+    min_nexts[ number[ part[ s ] ] ] = [ number[ part[ t ] ] for t in row ]
+    min_accepting[ number[ part[ s ] ] ] = accepting[ s ]
+  return min_nexts, min_accepting
+
+def symbol_classes( nexts ):
+  """Partitions the symbols into classes that every state treats alike.
+  Class 0 is for symbols (and all other characters) that never match."""
+  columns = { }
+  classes = [ ]
+  never = tuple( [ 0 ] * len( nexts ) )
+  columns[ never ] = 0
+  for sym in SYMBOLS:
+    col = tuple( row[ sym ] for row in nexts )
+    classes.append( columns.setdefault( col, len( columns ) ) )
+  reps = [ None ] * len( columns )
+  for sym, c in enumerate( classes ):
+    if reps[ c ] is None:
+      reps[ c ] = sym
+  return classes, reps
+
+########## Output #############################################################
+
+HEADER = '''\
+/*
+**      wrap -- text reformatter
+**      src/wregex_tables.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines the tables of a DFA that recognizes #WRAP_RE.
+ *
+ * @note This file was generated by `mkwregex.py` from the macros in
+ * `wregex.h`; don't edit it by hand.  To regenerate it, do `make
+ * wregex-tables`.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "wregex.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdint.h>                     /* for uint8_t, uint16_t */
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+static_assert( WRAP_RE_DFA_ACCEPT == 0x8000u, "regenerate table" );
+static_assert( WRAP_RE_DFA_CLASSES == %(classes)d, "regenerate table" );
+static_assert( WRAP_RE_DFA_STATES == %(states)d, "regenerate table" );
+static_assert( sizeof WRAP_RE == %(size)d, "regenerate table" );
+'''
+
+FOOTER = '''
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */'''
+
+def main():
+  if len( sys.argv ) != 2:
+    sys.exit( 'usage: mkwregex.py src/wregex.h' )
+  pattern = expand( header_macros( sys.argv[1] ), 'WRAP_RE' )
+  nfa = NFA()
+  start, accept = nfa.build( ERE( pattern ).parse() )
+  nexts, accepting = minimize( *dfa_from_nfa( nfa, start, accept ) )
+  classes, reps = symbol_classes( nexts )
+  assert len( nexts ) < WRAP_RE_DFA_ACCEPT and len( reps ) <= 0x100
+
+  print( HEADER % { 'classes': len( reps ), 'size': len( pattern ) + 1,
+                  'states': len( nexts ) } )
+
+  print( '''/**
+ * The #WRAP_RE the tables were generated from so a stale build can be caught
+ * at run-time if \\c sizeof #WRAP_RE didn't change.
+ */
+char const WRAP_RE_DFA_PATTERN[] =''' )
+  literal = pattern.replace( '\\', '\\\\' ).replace( '"', '\\"' )
+  chunks = [ literal[ i : i + 72 ] for i in range( 0, len( literal ), 72 ) ]
+  # don't split an escape sequence across chunks
+  for i in range( len( chunks ) - 1 ):
+    n = len( chunks[i] ) - len( chunks[i].rstrip( '\\' ) )
+    if n % 2 == 1:
+      chunks[i] = chunks[i][ : -1 ]
+      chunks[i + 1] = '\\' + chunks[i + 1]
+  print( '\n'.join( '  "%s"' % c for c in chunks ) + ';\n' )
+
+  print( '''/**
+ * The \\ref WRAP_RE_DFA symbol class of each ASCII character.
+ */
+uint8_t const WRAP_RE_DFA_ASCII[] = {
+  /*       0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F */''' )
+  for hi in range( 0, 0x80, 16 ):
+    print( '  /* %X */ ' % (hi >> 4) +
+           ','.join( '%3d' % classes[ c ] for c in range( hi, hi + 16 ) ) +
+           (',' if hi < 0x70 else '') )
+  print( '''};
+
+/**
+ * The \\ref WRAP_RE_DFA symbol class of non-ASCII alphanumeric characters.
+ */
+uint8_t const WRAP_RE_DFA_ALNUM = %d;
+
+/**
+ * The DFA that recognizes #WRAP_RE: indexed by state and symbol class, gives
+ * the next state.  State 0 is dead; state 1 is the start.  A next state has
+ * #WRAP_RE_DFA_ACCEPT set only if it is accepting.
+ */
+uint16_t const WRAP_RE_DFA[][ WRAP_RE_DFA_CLASSES ] = {''' %
+         classes[ SYM_ALNUM ] )
+  for s, row in enumerate( nexts ):
+    cells = [ 0 ] * len( reps )
+    for sym, c in enumerate( classes ):
+      t = row[ sym ]
+      cells[ c ] = t | (WRAP_RE_DFA_ACCEPT if accepting[ t ] else 0)
+    lines = [ ','.join( '%5d' % x for x in cells[ i : i + 10 ] )
+              for i in range( 0, len( cells ), 10 ) ]
+    print( '  /* %4d */ { ' % s + ',\n               '.join( lines ) + ' },' )
+  print( '};' )
+  print( FOOTER )
+
+if __name__ == '__main__':
+  main()
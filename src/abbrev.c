@@ -0,0 +1,271 @@
+/*
+**      wrap -- text reformatter
+**      src/abbrev.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for recognizing abbreviations whose period doesn't end a
+ * sentence.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "abbrev.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t */
+#include <stdio.h>                      /* for getline(3) */
+#include <string.h>
+#include <sysexits.h>
+
+/// @endcond
+
+/**
+ * @addtogroup abbrev-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The built-in abbreviations.  Ones that often end sentences anyway, e.g.,
+ * `etc.`, aren't included since then the sentence after wouldn't get its
+ * end-of-sentence spaces.
+ */
+static char const *const ABBREVS_BUILTIN[] = {
+  "Dr", "Eq", "Eqs", "Fig", "Figs", "Jr", "Mr", "Mrs", "Ms", "Prof", "Ref",
+  "Refs", "Sr", "St", "U.K", "U.S", "Vol", "a.k.a", "al", "approx", "cf",
+  "e.g", "i.e", "resp", "viz", "vs"
+};
+
+// local variable definitions
+static char      *abbrev_pool;          ///< Null-separated abbreviations.
+static size_t     abbrev_pool_cap;      ///< Capacity of \ref abbrev_pool.
+static size_t     abbrev_pool_len;      ///< Length of \ref abbrev_pool.
+
+/**
+ * Open-addressing hash set of the abbreviations: each slot is either 0 for
+ * empty or 1 + the offset of an abbreviation in \ref abbrev_pool.
+ */
+static uint32_t  *abbrev_table;
+static size_t     abbrev_table_cap;     ///< Capacity (a power of 2).
+static size_t     abbrev_table_len;     ///< Number of abbreviations.
+
+// local functions
+static void       abbrev_add( char const*, size_t );
+
+NODISCARD
+static bool       abbrev_find( char const*, size_t );
+
+NODISCARD
+static uint32_t*  abbrev_slot( char const*, size_t );
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Checks whether \a c may be in an abbreviation.
+ *
+ * @param c The character to check.
+ * @return Returns `true` only if \a c is an ASCII letter, digit, or period.
+ */
+NODISCARD
+static inline bool abbrev_is_char( char c ) {
+  return  (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9') || c == '.';
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Adds an abbreviation to the set, if it's not already in it.
+ *
+ * @param s The abbreviation.  It need not be null-terminated.
+ * @param len The length of \a s; must be at most #ABBREV_LEN_MAX.
+ */
+static void abbrev_add( char const *s, size_t len ) {
+  assert( s != NULL );
+  assert( len > 0 && len <= ABBREV_LEN_MAX );
+
+  if ( (abbrev_table_len + 1) * 2 > abbrev_table_cap ) {
+    //
+    // Keep the table at most half full so probe sequences stay short.
+    //
+    uint32_t *const old_table = abbrev_table;
+    size_t const old_cap = abbrev_table_cap;
+    abbrev_table_cap = old_cap == 0 ? 64 : old_cap * 2;
+    abbrev_table = MALLOC( uint32_t, abbrev_table_cap );
+    memset( abbrev_table, 0, abbrev_table_cap * sizeof( uint32_t ) );
+    for ( size_t i = 0; i < old_cap; ++i ) {
+      if ( old_table[i] == 0 )
+        continue;
+      char const *const old = abbrev_pool + old_table[i] - 1;
+      *abbrev_slot( old, strlen( old ) ) = old_table[i];
+    } // for
+    FREE( old_table );
+  }
+
+  uint32_t *const slot = abbrev_slot( s, len );
+  if ( *slot != 0 )
+    return;
+
+  if ( abbrev_pool_len + len + 1 > abbrev_pool_cap ) {
+    abbrev_pool_cap = abbrev_pool_cap == 0 ? 256 : abbrev_pool_cap * 2;
+    REALLOC( abbrev_pool, char, abbrev_pool_cap );
+  }
+  memcpy( abbrev_pool + abbrev_pool_len, s, len );
+  abbrev_pool[ abbrev_pool_len + len ] = '\0';
+  *slot = STATIC_CAST( uint32_t, abbrev_pool_len + 1 );
+  abbrev_pool_len += len + 1;
+  ++abbrev_table_len;
+}
+
+/**
+ * Checks whether \a s is an abbreviation.
+ *
+ * @param s The word to check.  It need not be null-terminated.
+ * @param len The length of \a s.
+ * @return Returns `true` only if \a s is an abbreviation.
+ */
+NODISCARD
+static bool abbrev_find( char const *s, size_t len ) {
+  return *abbrev_slot( s, len ) != 0;
+}
+
+/**
+ * Gets the \ref abbrev_table slot for \a s.
+ *
+ * @param s The abbreviation.  It need not be null-terminated.
+ * @param len The length of \a s.
+ * @return Returns a pointer to either the slot for \a s or the empty slot
+ * where it would go.
+ */
+NODISCARD
+static uint32_t* abbrev_slot( char const *s, size_t len ) {
+  assert( s != NULL );
+  assert( abbrev_table_cap > 0 );
+  size_t const mask = abbrev_table_cap - 1;
+  for ( size_t i = STATIC_CAST( size_t, mem_hash( s, len, 0 ) ) & mask; ;
+        i = (i + 1) & mask ) {
+    uint32_t *const slot = &abbrev_table[i];
+    if ( *slot == 0 )
+      return slot;
+    char const *const abbrev = abbrev_pool + *slot - 1;
+    if ( strncmp( abbrev, s, len ) == 0 && abbrev[ len ] == '\0' )
+      return slot;
+  } // for
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void abbrev_cleanup( void ) {
+  FREE( abbrev_pool );
+  FREE( abbrev_table );
+  abbrev_pool = NULL;
+  abbrev_pool_cap = abbrev_pool_len = 0;
+  abbrev_table = NULL;
+  abbrev_table_cap = abbrev_table_len = 0;
+}
+
+bool abbrev_ends( char const *s, size_t len ) {
+  assert( s != NULL || len == 0 );
+  assert( abbrev_table != NULL );
+
+  size_t begin = len;
+  while ( begin > 0 && abbrev_is_char( s[ begin - 1 ] ) ) {
+    if ( len - begin == ABBREV_LEN_MAX )
+      return false;                     // too long to be an abbreviation
+    --begin;
+  } // while
+  size_t const word_len = len - begin;
+  if ( word_len == 0 )
+    return false;
+  char const *const word = s + begin;
+  if ( abbrev_find( word, word_len ) )
+    return true;
+
+  if ( word[0] < 'A' || word[0] > 'Z' )
+    return false;
+  //
+  // The word may be capitalized only because it starts a sentence, e.g.,
+  // "E.g.", so try it in lowercase.
+  //
+  char lower[ ABBREV_LEN_MAX ];
+  memcpy( lower, word, word_len );
+  lower[0] = STATIC_CAST( char, lower[0] - 'A' + 'a' );
+  return abbrev_find( lower, word_len );
+}
+
+void abbrev_init( char const *path ) {
+  assert( abbrev_table == NULL );
+  ATEXIT( &abbrev_cleanup );
+
+  for ( size_t i = 0; i < ARRAY_SIZE( ABBREVS_BUILTIN ); ++i )
+    abbrev_add( ABBREVS_BUILTIN[i], strlen( ABBREVS_BUILTIN[i] ) );
+  if ( path == NULL )
+    return;
+
+  FILE *const fin = fopen( path, "r" );
+  if ( fin == NULL )
+    fatal_error( EX_NOINPUT, "%s: %s\n", path, STRERROR() );
+
+  char *line = NULL;
+  size_t line_cap = 0;
+  unsigned line_no = 0;
+
+  while ( getline( &line, &line_cap, fin ) != -1 ) {
+    ++line_no;
+    char *abbrev = line;
+    SKIP_CHARS( abbrev, WS_STRN );
+    if ( *abbrev == '\0' || *abbrev == '#' )
+      continue;
+    size_t len = strlen( abbrev );
+    while ( strchr( WS_STRN, abbrev[ len - 1 ] ) != NULL )
+      --len;
+    abbrev[ len ] = '\0';
+    if ( abbrev[ len - 1 ] == '.' )     // final period is optional
+      abbrev[ --len ] = '\0';
+    bool is_valid = len > 0 && len <= ABBREV_LEN_MAX;
+    for ( size_t i = 0; is_valid && i < len; ++i )
+      is_valid = abbrev_is_char( abbrev[i] );
+    if ( !is_valid ) {
+      fatal_error( EX_DATAERR,
+        "%s:%u: \"%s\": invalid abbreviation\n",
+        path, line_no, abbrev
+      );
+    }
+    abbrev_add( abbrev, len );
+  } // while
+
+  if ( unlikely( ferror( fin ) ) )
+    fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+  fclose( fin );
+  free( line );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,98 @@
+/*
+**      wrap -- text reformatter
+**      src/abbrev.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_abbrev_H
+#define wrap_abbrev_H
+
+/**
+ * @file
+ * Declares functions for recognizing abbreviations, e.g., `e.g.` or `Dr.`,
+ * whose period doesn't end a sentence.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup abbrev-group Abbreviations
+ * Functions for recognizing abbreviations using a hash set of the words
+ * before their periods so a period after one isn't taken to end a sentence.
+ * @{
+ */
+
+/**
+ * Maximum length of an abbreviation, not including its final period.
+ */
+#define ABBREV_LEN_MAX            15
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees all memory used by abbreviations.
+ *
+ * @sa abbrev_init()
+ */
+void abbrev_cleanup( void );
+
+/**
+ * Checks whether the word that ends \a s is an abbreviation, i.e., whether a
+ * period following \a s wouldn't end a sentence.  The word is the longest run
+ * of ASCII letters, digits, and periods ending \a s.  If it's not found as-is
+ * but starts with an uppercase letter, it's looked up again with that letter
+ * in lowercase, e.g., `E.g` is found as `e.g`.
+ *
+ * @param s The characters just before a period.  They need not be
+ * null-terminated.
+ * @param len The number of characters of \a s.
+ * @return Returns `true` only if said word is an abbreviation.
+ *
+ * @note abbrev_init() must have been called first.
+ */
+NODISCARD
+bool abbrev_ends( char const *s, size_t len );
+
+/**
+ * Initializes the set of abbreviations with the built-in ones plus any read
+ * from a file.  The file has one abbreviation per line with or without its
+ * final period.  Leading and trailing whitespace is ignored as are blank lines
+ * and lines whose first non-whitespace character is `#`.  If the file can't
+ * be read or an abbreviation is invalid, prints an error message and exits.
+ *
+ * @param path The path of the file to read or NULL for only the built-in
+ * abbreviations.
+ *
+ * @sa abbrev_cleanup()
+ */
+void abbrev_init( char const *path );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_abbrev_H */
+/* vim:set et sw=2 ts=2: */
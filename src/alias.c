@@ -33,7 +33,9 @@
 
 // standard
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -61,6 +63,9 @@ static size_t const ALIAS_ARGV_ALLOC_DEFAULT    = 10;
 /// Number of alias arguments to increment by.
 static size_t const ALIAS_ARGV_ALLOC_INCREMENT  = 10;
 
+/// Number of \ref alias_table slots to allocate by default.
+static size_t const ALIAS_TABLE_CAP_DEFAULT     = 32;
+
 /// Characters allowable in alias names.
 static char const   ALIAS_NAME_CHARS[]          = "abcdefghijklmnopqrstuvwxyz"
                                                   "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
@@ -69,10 +74,23 @@ static char const   ALIAS_NAME_CHARS[]          = "abcdefghijklmnopqrstuvwxyz"
 // local variable definitions
 static alias_t     *aliases = NULL;     ///< Global list of aliases.
 static size_t       n_aliases = 0;      ///< Number of aliases in global list.
+static size_t       n_aliases_alloc;    ///< Number of aliases allocated.
+static bool         aliases_borrowed;   ///< Set via alias_set_list()?
+
+/**
+ * Open-addressing hash table of aliases by name: each slot is either 0 for
+ * empty or 1 + an index into \ref aliases.  Indices rather than pointers are
+ * used since \ref aliases may be reallocated.
+ */
+static uint32_t    *alias_table;
+static size_t       alias_table_cap;    ///< Capacity (a power of 2) or 0.
 
 // local functions
-static void   alias_cleanup( void );
 static void   alias_free( alias_t* );
+static void   alias_table_grow( void );
+
+NODISCARD
+static uint32_t* alias_table_slot( char const* );
 
 NODISCARD
 static size_t strcpy_set( char*, size_t, char const*, char const* );
@@ -88,12 +106,10 @@ NODISCARD
 static alias_t* alias_alloc( void ) {
   RUN_ONCE ATEXIT( &alias_cleanup );
 
-  static size_t n_aliases_alloc = 0;    // number of aliases allocated
-
   if ( n_aliases_alloc == 0 ) {
     n_aliases_alloc = ALIAS_ALLOC_DEFAULT;
     aliases = MALLOC( alias_t, n_aliases_alloc );
-  } else if ( n_aliases > n_aliases_alloc ) {
+  } else if ( n_aliases >= n_aliases_alloc ) {
     n_aliases_alloc += ALIAS_ALLOC_INCREMENT;
     REALLOC( aliases, alias_t, n_aliases_alloc );
   }
@@ -103,49 +119,38 @@ static alias_t* alias_alloc( void ) {
 
 /**
  * Checks the most-recently-added alias against all previous aliases for a
- * duplicate name.  If a duplicate is found, prints an error message and exits.
+ * duplicate name.  If a duplicate is found, prints an error message and exits;
+ * otherwise adds it to \ref alias_table.
  *
  * @param conf_file The configuration file path-name.
  * @param line_no The line-number within \a conf_file.
  */
 static void alias_check_dup( char const *conf_file, unsigned line_no ) {
   assert( conf_file != NULL );
-  if ( n_aliases > 1 ) {
-    //
-    // The number of aliases is assumed to be small, so linear search is good
-    // enough.
-    //
-    int i = STATIC_CAST( int, n_aliases ) - 1;
-    char const *const last_name = aliases[i].argv[0];
-    while ( --i >= 0 ) {
-      if ( strcmp( aliases[i].argv[0], last_name ) == 0 ) {
-        fatal_error( EX_CONFIG,
-          "%s:%u: \"%s\": duplicate alias name (first is on line %u)\n",
-          conf_file, line_no, last_name, aliases[i].line_no
-        );
-      }
-    } // while
-  }
-}
+  assert( n_aliases > 0 );
 
-/**
- * Cleans-up all alias data.
- */
-void alias_cleanup( void ) {
-  while ( n_aliases > 0 )
-    alias_free( &aliases[ --n_aliases ] );
-  free( aliases );
+  if ( n_aliases * 2 > alias_table_cap )
+    alias_table_grow();
+  char const *const last_name = aliases[ n_aliases - 1 ].argv[0];
+  uint32_t *const slot = alias_table_slot( last_name );
+  if ( *slot != 0 ) {
+    fatal_error( EX_CONFIG,
+      "%s:%u: \"%s\": duplicate alias name (first is on line %u)\n",
+      conf_file, line_no, last_name, aliases[ *slot - 1 ].line_no
+    );
+  }
+  *slot = STATIC_CAST( uint32_t, n_aliases );
 }
 
 /**
  * Frees all memory used by an alias.
  *
  * @param alias The alias to free.
+ *
+ * @note The arguments themselves were allocated via arena_alloc().
  */
 static void alias_free( alias_t *alias ) {
   assert( alias != NULL );
-  while ( alias->argc > 0 )
-    FREE( alias->argv[ --alias->argc ] );
   FREE( alias->argv );
 }
 
@@ -176,8 +181,9 @@ static void alias_import( alias_t *to_alias, char const **ps,
       conf_file, line_no, from_name
     );
   }
+  // Arguments are never freed individually, so they can simply be shared.
   for ( int i = 1; i < from_alias->argc; ++i )
-    to_alias->argv[ to_alias->argc++ ] = check_strdup( from_alias->argv[ i ] );
+    to_alias->argv[ to_alias->argc++ ] = from_alias->argv[ i ];
 }
 
 /**
@@ -191,7 +197,10 @@ static char* arg_dup( char const **ps ) {
   assert( ps != NULL );
 
   char const *s = *ps;
-  char *const arg_buf = MALLOC( char, strlen( s ) + 1/*\0*/ );
+  // The configuration file is read a line at a time into a buffer of this size
+  // and an argument can't be longer than the rest of its line.
+  char arg_buf[ LINE_BUF_SIZE ];
+  assert( strlen( s ) < sizeof arg_buf );
   char *arg = arg_buf;
   char quote = '\0';
 
@@ -222,9 +231,43 @@ static char* arg_dup( char const **ps ) {
   } // for
 
 done:
-  *arg = '\0';
   *ps = s;
-  return arg_buf;
+  return arena_strndup( arg_buf, STATIC_CAST( size_t, arg - arg_buf ) );
+}
+
+/**
+ * Doubles the capacity of \ref alias_table (or allocates it) and adds all but
+ * the most-recently-added alias to it.
+ */
+static void alias_table_grow( void ) {
+  FREE( alias_table );
+  alias_table_cap = alias_table_cap == 0 ?
+    ALIAS_TABLE_CAP_DEFAULT : alias_table_cap * 2;
+  while ( n_aliases * 2 > alias_table_cap )
+    alias_table_cap *= 2;
+  alias_table = check_realloc( NULL, alias_table_cap * sizeof( uint32_t ) );
+  memset( alias_table, 0, alias_table_cap * sizeof( uint32_t ) );
+  for ( size_t i = 0; i + 1 < n_aliases; ++i )
+    *alias_table_slot( aliases[i].argv[0] ) = STATIC_CAST( uint32_t, i + 1 );
+}
+
+/**
+ * Gets the \ref alias_table slot for \a name.
+ *
+ * @param name The name of the alias.
+ * @return Returns a pointer to either the slot of the alias having \a name or
+ * the empty slot where it would go.
+ */
+NODISCARD
+static uint32_t* alias_table_slot( char const *name ) {
+  assert( name != NULL );
+  assert( alias_table_cap > 0 );
+  size_t const mask = alias_table_cap - 1;
+  for ( size_t i = str_hash( name ) & mask; ; i = (i + 1) & mask ) {
+    uint32_t *const slot = &alias_table[i];
+    if ( *slot == 0 || strcmp( aliases[ *slot - 1 ].argv[0], name ) == 0 )
+      return slot;
+  } // for
 }
 
 /**
@@ -257,12 +300,46 @@ static size_t strcpy_set( char *dest, size_t dest_size, char const *set,
 
 ////////// extern functions ///////////////////////////////////////////////////
 
+void alias_cleanup( void ) {
+  if ( aliases_borrowed ) {
+    n_aliases = 0;
+  } else {
+    while ( n_aliases > 0 )
+      alias_free( &aliases[ --n_aliases ] );
+    free( aliases );
+  }
+  aliases = NULL;
+  n_aliases_alloc = 0;
+  aliases_borrowed = false;
+  FREE( alias_table );
+  alias_table = NULL;
+  alias_table_cap = 0;
+}
+
 alias_t const* alias_find( char const *name ) {
   assert( name != NULL );
-  for ( size_t i = 0; i < n_aliases; ++i )
-    if ( strcmp( aliases[i].argv[0], name ) == 0 )
-      return &aliases[i];
-  return NULL;
+  if ( alias_table_cap == 0 )
+    return NULL;
+  uint32_t const slot = *alias_table_slot( name );
+  return slot == 0 ? NULL : &aliases[ slot - 1 ];
+}
+
+alias_t const* alias_list( size_t *n ) {
+  assert( n != NULL );
+  *n = n_aliases;
+  return aliases;
+}
+
+size_t alias_mem( void ) {
+  size_t size = alias_table_cap * sizeof( uint32_t );
+  if ( !aliases_borrowed ) {
+    size += n_aliases_alloc * sizeof( alias_t );
+    for ( size_t i = 0; i < n_aliases; ++i ) {
+      size += STATIC_CAST( size_t, aliases[i].argc + 1 ) *
+              sizeof( char const* );
+    } // for
+  }
+  return size;
 }
 
 void alias_parse( char const *line, char const *conf_file, unsigned line_no ) {
@@ -281,7 +358,7 @@ void alias_parse( char const *line, char const *conf_file, unsigned line_no ) {
 
   // part 1: name
   size_t const span = strspn( line, ALIAS_NAME_CHARS );
-  alias->argv[0] = strndup( line, span );
+  alias->argv[0] = arena_strndup( line, span );
   alias_check_dup( conf_file, line_no );
   line += span;
 
@@ -328,6 +405,22 @@ void alias_parse( char const *line, char const *conf_file, unsigned line_no ) {
   alias->argv[ alias->argc ] = NULL;
 }
 
+void alias_set_list( alias_t *list, size_t n ) {
+  assert( list != NULL || n == 0 );
+  assert( n_aliases == 0 );
+  RUN_ONCE ATEXIT( &alias_cleanup );
+  aliases = list;
+  aliases_borrowed = true;
+  n_aliases = 0;
+  while ( n_aliases < n ) {
+    ++n_aliases;
+    if ( n_aliases * 2 > alias_table_cap )
+      alias_table_grow();
+    *alias_table_slot( aliases[ n_aliases - 1 ].argv[0] ) =
+      STATIC_CAST( uint32_t, n_aliases );
+  } // while
+}
+
 #ifndef NDEBUG
 void dump_aliases( void ) {
   for ( size_t i = 0; i < n_aliases; ++i ) {
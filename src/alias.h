@@ -30,6 +30,13 @@
 // local
 #include "pjl_config.h"                 /* must go first */
 
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
 /**
  * @ingroup config-file-group
  * @defgroup alias-group Aliases
@@ -53,6 +60,11 @@ typedef struct alias alias_t;
 
 ////////// extern functions ///////////////////////////////////////////////////
 
+/**
+ * Frees all aliases so that those of another configuration file may be read.
+ */
+void alias_cleanup( void );
+
 /**
  * Attempts to find an alias from the internal list of aliases having the given
  * name and return that alias.
@@ -64,6 +76,26 @@ typedef struct alias alias_t;
 NODISCARD
 alias_t const* alias_find( char const *name );
 
+/**
+ * Gets the internal list of aliases.
+ *
+ * @param n Set to the number of aliases.
+ * @return Returns said list.
+ *
+ * @sa alias_set_list()
+ */
+NODISCARD
+alias_t const* alias_list( size_t *n );
+
+/**
+ * Gets the number of bytes of heap memory used by the internal list of
+ * aliases, but not by those borrowed via alias_set_list().
+ *
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t alias_mem( void );
+
 /**
  * Parses an alias from the given line and adds it to the internal list of
  * aliases.
@@ -74,6 +106,17 @@ alias_t const* alias_find( char const *name );
  */
 void alias_parse( char const *line, char const *conf_file, unsigned line_no );
 
+/**
+ * Sets the internal list of aliases to \a list rather than parsing them.
+ *
+ * @param list The list of aliases.  It and everything it points to are
+ * borrowed: they must remain valid until exit and aren't freed.
+ * @param n The number of aliases in \a list.
+ *
+ * @sa alias_list()
+ */
+void alias_set_list( alias_t *list, size_t n );
+
 #ifndef NDEBUG
 /**
  * Dumps the in-memory data structures for aliases read from a configuration
@@ -27,7 +27,10 @@
 #include "pjl_config.h"                 /* must go first */
 #include "cc_map.h"
 #include "common.h"
+#include "lang.h"
 #include "options.h"
+#include "reader.h"
+#include "simd.h"
 #include "util.h"
 
 /// @cond DOXYGEN_IGNORE
@@ -37,8 +40,13 @@
 #include <ctype.h>
 #include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for SIZE_MAX */
 #include <stdio.h>
+#include <stdlib.h>                     /* for exit() */
 #include <string.h>                     /* for str...() */
+#include <sys/wait.h>                   /* for waitpid(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for fork(2), sysconf(3) */
 
 /// @endcond
 
@@ -50,250 +58,743 @@
  * @{
  */
 
-////////// local functions ////////////////////////////////////////////////////
+/**
+ * Maximum number of lines of a block when aligning comments in each block to
+ * that block's widest code via `--align-column=block`: a block longer than
+ * that is aligned in pieces.
+ */
+#define ALIGN_BLOCK_LINES_MAX     256
 
 /**
- * Gets whether \a s starts an end-of-line comment.
+ * Minimum number of characters of input per chunk when aligning comments in
+ * parallel: below this, the cost of forking outweighs any gain.
+ */
+#define ALIGN_CHUNK_SIZE_MIN      (1024 * 1024)
+
+/**
+ * A child process aligning comments of a chunk of standard input.
  *
- * @param s The null-terminated string to check.
- * @return Returns `true` only if \a s starts an end-of-line comment.
+ * @sa align_fork()
+ */
+struct align_job {
+  pid_t   pid;                          ///< Process ID of the child.
+  FILE   *fout;                         ///< Temporary file the child writes.
+};
+typedef struct align_job align_job_t;
+
+/**
+ * A line of a block and what's needed to align its end-of-line comment, if
+ * any.
+ */
+struct align_line {
+  size_t  pos;                          ///< Offset within \ref align_block.
+  size_t  len;                          ///< Length sans end-of-line.
+  size_t  cc_pos;                       ///< Offset of comment, if aligned.
+  size_t  code_col;                     ///< Column past code before comment.
+  size_t  code_len;                     ///< Length of said code.
+  char    ws_char;                      ///< Alignment character were it auto.
+  bool    is_aligned;                   ///< Is its comment to be aligned?
+  bool    is_blank;                     ///< Is it a blank line?
+};
+typedef struct align_line align_line_t;
+
+/**
+ * The lines read, but not yet printed, of the current block.
  */
+struct align_block {
+  lang_t const *lang;                   ///< How strings are quoted.
+  lang_quote_t  ml;                     ///< Multi-line string, if within one.
+  line_buf_t    text;                   ///< Their null-terminated text.
+  size_t        text_len;               ///< Length of \a text used.
+  align_line_t *lines;                  ///< Their alignment data.
+  size_t        lines_len;              ///< Number of \a lines.
+  size_t        lines_max;              ///< Maximum number of \a lines.
+  line_buf_t    output_buf;             ///< Buffer for an aligned line.
+  line_buf_t    expand_buf;             ///< Buffer for expanding its tabs.
+};
+typedef struct align_block align_block_t;
+
+// local variable definitions
+
+/// Characters that can start a string.
+static bool         quote_chars[ 256 ];
+
+// local functions
+static void         align_block_add( align_block_t*, char const* );
+static void         align_block_cleanup( align_block_t* );
+static void         align_block_flush( align_block_t* );
+static void         align_block_init( align_block_t*, size_t );
+static void         align_fork( void );
+
 NODISCARD
-static bool is_eol_comment( char const *s ) {
-  assert( s != NULL );
-  char const *const cc = cc_map_get( *s );
+static bool         align_is_settled( lang_t const* );
+NODISCARD
+static size_t       align_pad( char*, size_t, size_t );
+
+static void         align_line_print( char const*, align_line_t const*, size_t,
+                                      line_buf_t*, line_buf_t* );
+static void         align_line_put( char const*, size_t, line_buf_t* );
+static void         align_line_scan( lang_t const*, lang_quote_t const*,
+                                     char const*, char const*,
+                                     align_line_t* );
+
+NODISCARD
+static size_t       align_tab_stop( size_t );
+
+NODISCARD
+static char const*  find_eol_comment( lang_t const*, char const*,
+                                      lang_quote_t*, char const** );
+
+NODISCARD
+static bool         is_after_word( char const*, char const* );
+
+NODISCARD
+static bool         is_eol_comment( char const*, cc_delim_t const* );
+
+NODISCARD
+static size_t       span_width( char const*, size_t );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Adds \a line to \a block.
+ *
+ * @param block The \ref align_block to add to.  It must not be full.
+ * @param line The null-terminated line to add.
+ */
+static void align_block_add( align_block_t *block, char const *line ) {
+  assert( block != NULL );
+  assert( line != NULL );
+  assert( block->lines_len < block->lines_max );
+  align_line_t *const al = &block->lines[ block->lines_len++ ];
+
+  lang_quote_t const ml = block->ml;
+  char const *end;
+  char const *const cc =
+    find_eol_comment( block->lang, line, &block->ml, &end );
+  //
+  // Most lines don't have an end-of-line comment: they're passed through
+  // verbatim (except that the line-ending is replaced by whatever the chosen
+  // line-ending is) without scanning them again.
+  //
+  size_t len = cc == NULL ? STATIC_CAST( size_t, end - line ) : strlen( line );
+
+  line_buf_reserve( &block->text, block->text_len + len );
+  char *const text = block->text.str + block->text_len;
+  memcpy( text, line, len );
+  text[ len ] = '\0';
   if ( cc == NULL )
+    al->is_aligned = false;
+  else {
+    len = chop_eol( text, len );
+    align_line_scan( block->lang, &ml, line, cc, al );
+  }
+
+  al->pos = block->text_len;
+  al->len = len;
+  al->is_blank = simd_ws_span( text, len ) == len;
+  block->text_len += len + 1/*null*/;
+}
+
+/**
+ * Frees all memory used by \a block.
+ *
+ * @param block The \ref align_block to clean up.
+ *
+ * @sa align_block_init()
+ */
+static void align_block_cleanup( align_block_t *block ) {
+  assert( block != NULL );
+  line_buf_cleanup( &block->text );
+  line_buf_cleanup( &block->output_buf );
+  line_buf_cleanup( &block->expand_buf );
+  FREE( block->lines );
+}
+
+/**
+ * Prints all the lines of \a block, aligning their end-of-line comments, and
+ * empties it for the next block.
+ *
+ * @param block The \ref align_block to flush.
+ */
+static void align_block_flush( align_block_t *block ) {
+  assert( block != NULL );
+
+  size_t column = opt_align_column;
+  if ( opt_align_block ) {
+    //
+    // Align the comments one space past the widest code before any of them.
+    //
+    column = 0;
+    for ( size_t i = 0; i < block->lines_len; ++i ) {
+      align_line_t const *const al = &block->lines[i];
+      if ( al->is_aligned && al->code_col + 2 > column )
+        column = al->code_col + 2;
+    } // for
+  }
+
+  for ( size_t i = 0; i < block->lines_len; ++i ) {
+    align_line_t const *const al = &block->lines[i];
+    align_line_print(
+      block->text.str + al->pos, al, column, &block->output_buf,
+      &block->expand_buf
+    );
+  } // for
+
+  block->lines_len = 0;
+  block->text_len = 0;
+}
+
+/**
+ * Initializes \a block.
+ *
+ * @param block The \ref align_block to initialize.
+ * @param lines_max The maximum number of lines it can have.
+ *
+ * @sa align_block_cleanup()
+ */
+static void align_block_init( align_block_t *block, size_t lines_max ) {
+  assert( block != NULL );
+  assert( lines_max > 0 );
+  *block = (align_block_t){
+    .lang = lang_find( opt_fin_name ),
+    .lines = MALLOC( align_line_t, lines_max ),
+    .lines_max = lines_max
+  };
+  line_buf_init( &block->text );
+  line_buf_init( &block->output_buf );
+  line_buf_init( &block->expand_buf );
+}
+
+/**
+ * Aligns the rest of standard input in parallel, if possible.  When standard
+ * input is a large regular file, splits the rest of it at line boundaries
+ * into up to \ref opt_jobs chunks and forks a child process to align each
+ * into a temporary file.  The parent then copies the temporary files to
+ * standard output in order.
+ *
+ * @remarks If aligning in parallel, in the parent, this function never
+ * returns: it exits with the status of the first child that failed, if any.
+ * In each child, it returns so that align_eol_comments() proceeds as if only
+ * that child's chunk were the rest of its input.  Otherwise, it returns so
+ * that align_eol_comments() proceeds serially.
+ *
+ * @note This must be called only when align_is_settled() returns `true`.
+ */
+static void align_fork( void ) {
+  size_t size;
+  char const *const s = reader_peek( stdin, &size );
+  if ( s == NULL )
+    return;
+
+  size_t chunks = opt_jobs;
+  if ( chunks == 0 ) {
+    long const cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    chunks = cpus > 0 ? STATIC_CAST( size_t, cpus ) : 1;
+  }
+  if ( chunks > size / ALIGN_CHUNK_SIZE_MIN )
+    chunks = size / ALIGN_CHUNK_SIZE_MIN;
+  if ( chunks < 2 )
+    return;
+
+  align_job_t *const jobs = MALLOC( align_job_t, chunks );
+  size_t jobs_len = 0;
+
+  for ( size_t start = 0; start < size; ++jobs_len ) {
+    size_t end = size;
+    if ( jobs_len + 1 < chunks ) {
+      size_t pos = size / chunks * (jobs_len + 1);
+      if ( pos < start )
+        pos = start;
+      char const *const nl = memchr( s + pos, '\n', size - pos );
+      if ( nl != NULL )
+        end = STATIC_CAST( size_t, nl - s ) + 1;
+    }
+    FILE *const ftemp = tmpfile();
+    PERROR_EXIT_IF( ftemp == NULL, EX_CANTCREAT );
+
+    PERROR_EXIT_IF( fflush( stdout ) != 0, EX_IOERR );
+    pid_t const pid = fork();
+    PERROR_EXIT_IF( pid == -1, EX_OSERR );
+    if ( pid == 0 ) {                   // child
+      DUP2( fileno( ftemp ), STDOUT_FILENO );
+      PJL_DISCARD_RV( fclose( ftemp ) );
+      reader_limit( stdin, start, end - start );
+      FREE( jobs );
+      return;
+    }
+
+    jobs[ jobs_len ] = (align_job_t){ .pid = pid, .fout = ftemp };
+    start = end;
+  } // for
+
+  int exit_status = EX_OK;
+  for ( size_t i = 0; i < jobs_len; ++i ) {
+    int wait_status;
+    PERROR_EXIT_IF( waitpid( jobs[i].pid, &wait_status, 0 ) == -1, EX_OSERR );
+    if ( exit_status == EX_OK ) {
+      exit_status = WIFEXITED( wait_status ) ?
+        WEXITSTATUS( wait_status ) : EX_SOFTWARE;
+      if ( exit_status == EX_OK ) {
+        rewind( jobs[i].fout );
+        fcopy( jobs[i].fout, stdout );
+      }
+    }
+    PJL_DISCARD_RV( fclose( jobs[i].fout ) );
+  } // for
+
+  FREE( jobs );
+  exit( exit_status );
+}
+
+/**
+ * Gets whether how comments are aligned no longer depends on the lines
+ * before, i.e., the alignment character has been determined and, if it's a
+ * tab, tabs alone can reach the alignment column so there will be no falling
+ * back to spaces.  Only then can the rest of the lines be aligned in
+ * parallel.
+ *
+ * @param lang The \ref lang in use.  If it has strings that can span lines,
+ * whether a line is within one depends on the lines before, so it's never
+ * settled.
+ * @return Returns `true` only if settled.
+ */
+static bool align_is_settled( lang_t const *lang ) {
+  if ( opt_align_block || opt_align_char == '\0' || lang_is_ml( lang ) )
     return false;
+  return opt_align_char != '\t' || opt_align_column < 2 ||
+    align_tab_stop( opt_align_column ) + 1 >= opt_align_column;
+}
 
-  char closing = closing_char( *s );
+/**
+ * Pads with opt_align_char from \a col up to, but not including, \a column.
+ * If opt_align_char is a tab and the last tab would go past \a column, falls
+ * back to using (and sets opt_align_char to) spaces.
+ *
+ * @param buf The buffer to pad into.
+ * @param col The column to pad from.
+ * @param column The column to pad up to.
+ * @return Returns the number of characters of padding.
+ */
+static size_t align_pad( char *buf, size_t col, size_t column ) {
+  assert( buf != NULL );
+  if ( col + 1 >= column )
+    return 0;
 
-  if ( cc_is_single( cc ) ) {
+  size_t tabs_len = 0;
+  if ( opt_align_char == '\t' ) {
     //
-    // Single-character comment delimiter, e.g., '#' (Python) or '{' (Pascal).
+    // Rather than adding one tab at a time, compute the tab-stop tabs can take
+    // us to.
     //
-    if ( closing == '\0' ) {
-      //
-      // A single-character comment delimiter that has no closing character,
-      // e.g., '#', invariably is a comment to the end of the line.
-      //
-      return true;
+    size_t const stop = align_tab_stop( column );
+    if ( stop > col ) {
+      tabs_len = stop / opt_tab_spaces - col / opt_tab_spaces;
+      memset( buf, '\t', tabs_len );
+      col = stop;
+      if ( col + 1 >= column )
+        return tabs_len;
     }
+    //
+    // Another tab would go past the alignment column (or there wasn't room for
+    // even one): fall back to using spaces.
+    //
+    opt_align_char = ' ';
+  }
+
+  size_t const spaces_len = column - 1 - col;
+  memset( buf + tabs_len, opt_align_char, spaces_len );
+  return tabs_len + spaces_len;
+}
+
+/**
+ * Prints \a line aligning its end-of-line comment, if any, at \a column.
+ *
+ * @param line The null-terminated line sans end-of-line to print.
+ * @param al The \ref align_line of \a line.
+ * @param column The column to align the comment at.
+ * @param output_buf The buffer to use for the aligned line.
+ * @param expand_buf The buffer to use for expanding its tabs, if need be.
+ */
+static void align_line_print( char const *line, align_line_t const *al,
+                              size_t column, line_buf_t *output_buf,
+                              line_buf_t *expand_buf ) {
+  assert( line != NULL );
+  assert( al != NULL );
+  assert( output_buf != NULL );
+
+  if ( !al->is_aligned ) {
+    align_line_put( line, strlen( line ), expand_buf );
+    return;
+  }
+
+  if ( opt_align_char == '\0' ) {
+    //
+    // The user hasn't specified an alignment character: use the one for the
+    // first line whose comment is aligned.
+    //
+    opt_align_char = al->ws_char;
+  }
+
+  //
+  // The output is at most the input plus the padding up to the alignment
+  // column.
+  //
+  line_buf_reserve( output_buf, al->len + column );
+
+  //
+  // Copy the code up to its last non-whitespace character before the comment.
+  // We want to replace all the whitespace between there and the comment with
+  // opt_align_char.
+  //
+  size_t output_len = al->code_len;
+  memcpy( output_buf->str, line, output_len );
+  output_len += align_pad( output_buf->str + output_len, al->code_col, column );
+
+  size_t const cc_len = al->len - al->cc_pos;
+  memcpy( output_buf->str + output_len, line + al->cc_pos, cc_len );
+  output_len += cc_len;
+  output_buf->str[ output_len ] = '\0';
+  align_line_put( output_buf->str, output_len, expand_buf );
+}
+
+/**
+ * Prints \a line with its tabs, including any used for padding, expanded if
+ * \ref opt_expand_tabs.
+ *
+ * @param line The null-terminated line sans end-of-line to print.
+ * @param len The length of \a line.
+ * @param expand_buf The buffer to use for expanding its tabs, if need be.
+ */
+static void align_line_put( char const *line, size_t len,
+                            line_buf_t *expand_buf ) {
+  if ( opt_expand_tabs ) {
+    size_t col = 0;
+    line = tabs_expand( line, &len, &col, expand_buf );
+  }
+  PRINTF( "%s%s", line, eol() );
+}
 
+/**
+ * Scans the code of \a line before its end-of-line comment to determine
+ * whether the comment is aligned and, if so, where the code ends.
+ *
+ * @param lang The \ref lang to use.
+ * @param ml The multi-line string \a line starts within, if any.
+ * @param line The null-terminated line to scan.
+ * @param cc The start of the end-of-line comment within \a line.
+ * @param al The \ref align_line to set.
+ */
+static void align_line_scan( lang_t const *lang, lang_quote_t const *ml,
+                             char const *line, char const *cc,
+                             align_line_t *al ) {
+  assert( lang != NULL );
+  assert( ml != NULL );
+  assert( line != NULL );
+  assert( cc != NULL );
+  assert( al != NULL );
+
+  bool        is_word = false;          // got a word character?
+  ssize_t     last_nonws_len = -1;      // length to non-whitespace character
+  char        last_ws = ' ';            // last whitespace encountered
+  char const *s = line;
+  unsigned    token_count = 0;
+
+  if ( ml->close_len > 0 ) {
     //
-    // We're dealing with a case like '{' ... '}' (Pascal): we have to attempt
-    // to find the closing comment delimiter character.
+    // Since find_eol_comment() found a comment, the string must end.
     //
-    for (;;) {
-      if ( *s == '\0' )
-        return false;
-      if ( *s++ == closing ) {
+    s = lang_close( ml, line, line );
+    assert( s != NULL );
+    ++token_count;
+    last_nonws_len = s - line + 1;
+    ++s;
+  }
+
+  for ( ; s < cc; ++s ) {
+    bool const was_word = true_clear( &is_word );
+
+    if ( quote_chars[ STATIC_CAST( unsigned char, *s ) ] ) {
+      lang_quote_t q;
+      char const *const open_end = lang_open( lang, line, s, &q );
+      if ( open_end != NULL ) {
         //
-        // We found the closing comment delimiter character: now check to see
-        // if there's non-whitespace characters after it, e.g.:
+        // A string, in its entirety, is a single token.
         //
-        //      { comment } something else?
+        s = lang_close( &q, line, open_end );
+        assert( s != NULL );
+        ++token_count;
+        last_nonws_len = s - line + 1;
+        continue;
+      }
+    }
+
+    if ( *s == lang->esc ) {
+      // neither a token nor part of one
+    }
+    else if ( ispunct( *s ) ) {
+      if ( s[0] == '#' && isalnum( s[1] ) && !was_word ) {
         //
-        // If so, then this comment isn't an end-of-line comment.
+        // Special case: allow '#' to start words so C/C++ preprocessor
+        // directives, e.g., #endif, are considered single tokens.
         //
-        return is_blank_line( s );
+        is_word = true;
       }
-    } // for
-  }
+      ++token_count;
+    }
+    else if ( isalnum( *s ) ) {
+      if ( !was_word )
+        ++token_count;
+      is_word = true;
+    }
 
-  if ( s[1] == s[0] ) {
     //
-    // A two-character comment delimiter where both characters are the same,
-    // e.g., "//", invariably is a comment to the end of the line.
+    // Keep track of the last whitespace character and non-whitespace
+    // position.
     //
-    return true;
+    if ( is_space( *s ) )
+      last_ws = *s;
+    else
+      last_nonws_len = s - line + 1;
+  } // for
+
+  //
+  // Align comment only if:
+  //
+  //  1. It is the last thing on the line -- so a comment within a line is not
+  //     aligned, e.g.:
+  //
+  //          char cc_buf[ 3 + 1/*null*/ ];
+  //
+  //     (That's already been checked by find_eol_comment().)
+  //
+  //  2. There is more than one "token" on the line before the comment -- so
+  //     comments like:
+  //
+  //            } // for
+  //          #endif /* NDEBUG */
+  //
+  //     are not aligned.  A "token" is one of:
+  //
+  //        * A "word": an optional '#' followed by one or more alpha-numeric
+  //          characters.
+  //        * A single punctuation character.
+  //        * A single- or-double-quoted string.
+  //
+  // An end-of-line comment that does not meet these criteria is passed
+  // through verbatim (except that the line-ending is replaced by whatever the
+  // chosen line-ending is).
+  //
+  al->is_aligned = token_count > 1;
+  if ( !al->is_aligned )
+    return;
+
+  al->cc_pos = STATIC_CAST( size_t, cc - line );
+  al->code_len = STATIC_CAST( size_t, last_nonws_len );
+  al->code_col = span_width( line, al->code_len );
+  //
+  // Were the alignment character auto, it'd be whatever the first character
+  // is after the last non-whitespace character before the comment.  If that
+  // isn't a whitespace character, it'd be whatever the last whitespace
+  // character encountered was.
+  //
+  char const c = line[ last_nonws_len + 1 ];
+  al->ws_char = isspace( c ) ? c : last_ws;
+}
+
+/**
+ * Gets the tab-stop that tabs can take the padding before a comment aligned
+ * at \a column to: the first one at or past where the comment goes unless
+ * that's past \a column, in which case the one before it.
+ *
+ * @param column The column to align the comment at.  It must be at least 2.
+ * @return Returns said tab-stop.
+ */
+static size_t align_tab_stop( size_t column ) {
+  assert( column >= 2 );
+  size_t const stop =
+    (column - 2) / opt_tab_spaces * opt_tab_spaces + opt_tab_spaces;
+  return stop > column ? stop - opt_tab_spaces : stop;
+}
+
+/**
+ * Finds the end-of-line comment in \a line, if any, checking only the
+ * characters that either can start a string or a comment delimiter, or end
+ * the line: all others are skipped over via simd_scan() several at a time.
+ *
+ * @param lang The \ref lang to use.
+ * @param line The null-terminated line to check.
+ * @param ml The multi-line string \a line starts within, if any.  It's updated
+ * to the one it ends within, if any.
+ * @param pend Set to the end of \a line, i.e., either its end-of-line or
+ * terminating null, only if there's no end-of-line comment.
+ * @return Returns a pointer to the start of said comment or NULL if none.
+ */
+static char const* find_eol_comment( lang_t const *lang, char const *line,
+                                     lang_quote_t *ml, char const **pend ) {
+  assert( lang != NULL );
+  assert( line != NULL );
+  assert( ml != NULL );
+  assert( pend != NULL );
+  cc_delim_t const *cc_delim;
+  char const *s = line;
+
+  if ( ml->close_len > 0 ) {
+    char const *const close = lang_close( ml, line, line );
+    if ( close == NULL )
+      goto within_string;
+    ml->close_len = 0;
+    s = close + 1;
   }
 
-  char const d1 = *s;                   // save first delimiter character
-  if ( !(*++s != '\0' && strchr( cc, *s ) != NULL) ) {
-    //
-    // If the next character isn't the second character in a two-character
-    // comment delimiter, then it's not a comment.
-    //
+  for ( ;; ++s ) {
+    s += simd_scan( s );
+    switch ( *s ) {
+      case '\0':
+      case '\n':
+      case '\r':
+        *pend = s;
+        return NULL;
+    } // switch
+    if ( *s == lang->esc )
+      continue;
+    if ( quote_chars[ STATIC_CAST( unsigned char, *s ) ] ) {
+      lang_quote_t q;
+      char const *const open_end = lang_open( lang, line, s, &q );
+      if ( open_end != NULL ) {
+        char const *const close = lang_close( &q, line, open_end );
+        if ( close == NULL ) {
+          if ( q.is_ml )
+            *ml = q;
+          s = open_end;
+          goto within_string;
+        }
+        s = close;
+        continue;
+      }
+    }
+    if ( cc_map_match( s, &cc_delim ) > 0 &&
+         !(cc_delim->is_word && is_after_word( line, s )) &&
+         is_eol_comment( s, cc_delim ) ) {
+      return s;
+    }
+  } // for
+
+within_string:
+  *pend = s + strcspn( s, "\n\r" );
+  return NULL;
+}
+
+/**
+ * Gets whether \a s is just after a "word" as align_eol_comments() counts
+ * words as tokens.
+ *
+ * @param line The line \a s is within.
+ * @param s The position within \a line that must be a letter or digit.
+ * @return Returns `true` only if \a s is.
+ */
+static bool is_after_word( char const *line, char const *s ) {
+  if ( s == line )
     return false;
-  }
+  if ( isalnum( s[-1] ) )
+    return true;
+  //
+  // A '#' starts a word unless it's itself after one.
+  //
+  return s[-1] == '#' && (s - 1 == line || !isalnum( s[-2] ));
+}
 
-  if ( closing == '\0' ) {
+/**
+ * Gets whether \a s starts an end-of-line comment.
+ *
+ * @param s The null-terminated string to check.  It must start with \a delim.
+ * @param delim The comment delimiter \a s starts with.
+ * @return Returns `true` only if \a s starts an end-of-line comment.
+ */
+static bool is_eol_comment( char const *s, cc_delim_t const *delim ) {
+  assert( s != NULL );
+  assert( delim != NULL );
+  if ( delim->close_len == 0 ) {
     //
-    // If the first character in a two-character comment delimiter doesn't
-    // have a closing character, then it's its own closing character, e.g.,
-    // "/*" ... "*/".
+    // A comment delimiter that has no closing delimiter, e.g., '#' or "//",
+    // invariably is a comment to the end of the line.
     //
-    closing = d1;
+    return true;
   }
 
   //
-  // Attempt to find the closing comment delimiter characters.
+  // We're dealing with a case like "/*" ... "*/" (C) or '{' ... '}' (Pascal):
+  // we have to attempt to find the closing comment delimiter.
   //
-  char const d2 = *s;                   // save second delimiter character
-  for ( char prev_c = '\0'; *++s != '\0'; prev_c = *s ) {
-    if ( prev_c == d2 && *s == closing ) {
-      //
-      // We found the closing comment delimiter characters: now it's just like
-      // the single-character comment delimiter case above.
-      //
-      return is_blank_line( ++s );
-    }
-  } // for
+  char const *const close = strstr( s + delim->open_len, delim->close );
+  //
+  // If we found it, check to see if there's non-whitespace characters after
+  // it, e.g.:
+  //
+  //      { comment } something else?
+  //
+  // If so, then this comment isn't an end-of-line comment.
+  //
+  return close != NULL && is_blank_line( close + delim->close_len );
+}
 
-  return false;
+/**
+ * Computes the width of the first \a len characters of \a s the same way as
+ * char_width() does, but a run of characters between tabs at a time.
+ *
+ * @param s The string to calculate the width of.
+ * @param len The number of characters of \a s.
+ * @return Returns said width.
+ */
+static size_t span_width( char const *s, size_t len ) {
+  assert( s != NULL );
+  char const *const end = s + len;
+  size_t width = 0;
+  for (;;) {
+    char const *const tab = memchr( s, '\t', STATIC_CAST( size_t, end - s ) );
+    if ( tab == NULL )
+      return width + STATIC_CAST( size_t, end - s );
+    width += STATIC_CAST( size_t, tab - s );
+    width += char_width( '\t', width );
+    s = tab + 1;
+  } // for
 }
 
 ////////// extern functions ///////////////////////////////////////////////////
 
-void align_eol_comments( char input_buf[const] ) {
+void align_eol_comments( line_buf_t *input_buf ) {
+  assert( input_buf != NULL );
+  align_block_t block;
+  align_block_init( &block, opt_align_block ? ALIGN_BLOCK_LINES_MAX : 1 );
+
+  lang_quote_chars( block.lang, quote_chars );
+  bool scan_set[ 256 ] = { ['\0'] = true, ['\n'] = true, ['\r'] = true };
+  scan_set[ STATIC_CAST( unsigned char, block.lang->esc ) ] = true;
+  for ( unsigned c = 1; c < 256; ++c ) {
+    if ( quote_chars[c] ||
+         (c < 128 && cc_map_is_first( STATIC_CAST( char, c ) )) ) {
+      scan_set[c] = true;
+    }
+  } // for
+  simd_scan_init( scan_set );
+
+  bool is_fork_tried = false;
+
   do {
-    size_t      col = 0;
-    bool        is_backslash = false;   // got a backslash?
-    bool        is_word = false;        // got a word character?
-    ssize_t     last_nonws_col = -1;    // last non-whitespace column
-    ssize_t     last_nonws_len = -1;    // length to non-whitespace character
-    char        last_ws = ' ';          // last whitespace encountered
-    line_buf_t  output_buf;
-    size_t      output_len = 0;
-    char        quote = '\0';           // between quotes?
-    unsigned    token_count = 0;
-
-    for ( char const *s = input_buf; *s != '\0' && !is_eol( *s ); ++s ) {
-      bool const was_backslash = true_clear( &is_backslash );
-      bool const was_word = true_clear( &is_word );
-
-      switch ( *s ) {
-        case '"':
-        case '\'':
-          if ( quote == '\0' ) {
-            quote = *s;
-          }
-          else if ( !was_backslash && *s == quote ) {
-            quote = '\0';
-            ++token_count;
-          }
-          break;
-        case '\\':
-          is_backslash = true;
-          break;
-
-        default:
-          if ( quote != '\0' )          // do nothing else while between quotes
-            break;
-
-          if ( is_eol_comment( s ) ) {
-            //
-            // Align comment only if:
-            //
-            //  1. It is the last thing on the line -- so a comment within a
-            //     line is not aligned, e.g.:
-            //
-            //          char cc_buf[ 3 + 1/*null*/ ];
-            //
-            //  2. There is more than one "token" on the line before the
-            //     comment -- so comments like:
-            //
-            //            } // for
-            //          #endif /* NDEBUG */
-            //
-            //     are not aligned.  A "token" is one of:
-            //
-            //        * A "word": an optional '#' followed by one or more
-            //          alpha-numeric characters.
-            //        * A single punctuation character.
-            //        * A single- or-double-quoted string.
-            //
-            // An end-of-line comment that does not meet these criteria is
-            // passed through verbatim (except that the line-ending is replaced
-            // by whatever the chosen line-ending is).
-            //
-            if ( token_count > 1 ) {
-              if ( opt_align_char == '\0' ) {
-                //
-                // The user hasn't specified an alignment character: use
-                // whatever the first character is after the last non-
-                // whitespace character before the comment.  If that isn't a
-                // whitespace character, use whatever the last whitespace
-                // character we encountered was.
-                //
-                char const c = input_buf[ last_nonws_len + 1 ];
-                opt_align_char = isspace( c ) ? c : last_ws;
-              }
-
-              //
-              // Reset the column and length to those of the last non-
-              // whitespace character before the comment.  We want to replace
-              // all the whitespace between there and the comment with
-              // opt_align_char.
-              //
-              col = STATIC_CAST( size_t, last_nonws_col );
-              output_len = STATIC_CAST( size_t, last_nonws_len );
-
-              //
-              // While we're less than the alignment column, insert whitespace.
-              //
-              while ( col < opt_align_column - 1 ) {
-                size_t width = char_width( opt_align_char, col );
-                if ( col + width > opt_align_column ) {
-                  //
-                  // If width > 1 (as it could be when using tabs) and the new
-                  // column > the alignment column, fall back to using spaces.
-                  //
-                  width = 1;
-                  opt_align_char = ' ';
-                }
-                col += width;
-                output_buf[ output_len++ ] = opt_align_char;
-              } // while
-            }
-
-            //
-            // Copy the comment without the end-of-line so we can replace it by
-            // whatever the chosen line-ending is.
-            //
-            output_len += strcpy_len( output_buf + output_len, s );
-            output_len = chop_eol( output_buf, output_len );
-            goto print_line;
-          }
-
-          if ( ispunct( *s ) ) {
-            if ( s[0] == '#' && isalnum( s[1] ) && !was_word ) {
-              //
-              // Special case: allow '#' to start words so C/C++ preprocessor
-              // directives, e.g., #endif, are considered single tokens.
-              //
-              is_word = true;
-            }
-            ++token_count;
-          }
-          else if ( isalnum( *s ) ) {
-            if ( !was_word )
-              ++token_count;
-            is_word = true;
-          }
-      } // switch
-
-      col += char_width( *s, col );
-      output_buf[ output_len++ ] = *s;
-
-      if ( quote == '\0' ) {
-        //
-        // Keep track of the last whitespace character and non-whitespace
-        // column & position.
-        //
-        if ( is_space( *s ) ) {
-          last_ws = *s;
-        } else {
-          last_nonws_col = STATIC_CAST( ssize_t, col );
-          last_nonws_len = s - input_buf + 1;
-        }
-      }
-    } // for
+    char const *const line = input_buf->str;
+    align_block_add( &block, line );
+    if ( block.lines_len == block.lines_max ||
+         block.lines[ block.lines_len - 1 ].is_blank ) {
+      align_block_flush( &block );
+    }
+    if ( !is_fork_tried && align_is_settled( block.lang ) ) {
+      is_fork_tried = true;
+      align_fork();
+    }
+  } while ( check_readline( input_buf, stdin, SIZE_MAX ) );
 
-print_line:
-    output_buf[ output_len ] = '\0';
-    PRINTF( "%s%s", output_buf, eol() );
-  } while ( check_readline( input_buf, stdin ) );
+  align_block_flush( &block );
+  align_block_cleanup( &block );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -26,10 +26,11 @@
 // local
 #include "pjl_config.h"                 /* must go first */
 /// @cond DOXYGEN_IGNORE
-#define W_CC_MAP_INLINE _GL_EXTERN_INLINE
+#define W_CC_MAP_H_INLINE _GL_EXTERN_INLINE
 /// @endcond
 #include "cc_map.h"
 #include "options.h"
+#include "unicode.h"
 #include "util.h"
 
 /// @cond DOXYGEN_IGNORE
@@ -38,9 +39,10 @@
 #include <assert.h>
 #include <ctype.h>
 #include <stdbool.h>
-#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for UINT64_C */
 #include <stdio.h>
-#include <string.h>                     /* for str...() */
+#include <stdlib.h>                     /* for getenv(3) */
+#include <string.h>                     /* for memcpy(3), strchr(3) */
 
 /// @endcond
 
@@ -51,148 +53,281 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-/**
- * Comment delimiter character set indexed by character.
- */
-typedef bool cc_set_t[128];
-
 // extern variable definitions
-cc_map_t            cc_map;             ///< Comment delimeter character map.
+cc_map_t            cc_map;             ///< Comment delimeter map.
+
+// local functions
+NODISCARD
+static bool     cc_bits_add( uint64_t[static 4], char );
+
+static void     cc_delim_init_close( cc_delim_t* );
+
+NODISCARD
+static unsigned cc_map_add_char( char );
 
-////////// inline functions ///////////////////////////////////////////////////
+static void     cc_map_add_delim( char const*, size_t, char const*,
+                                  unsigned* );
+
+////////// local functions ////////////////////////////////////////////////////
 
 /**
- * Initializes the comment character map.
+ * Adds \a c to \a bits.
  *
- * @sa cc_map_free()
+ * @param bits The set of characters as a bitmap indexed by character.
+ * @param c The character to add.
+ * @return Returns `true` only if \a c wasn't already in \a bits.
  */
-static inline void cc_map_init( void ) {
-  MEM_ZERO( &cc_map );
+static bool cc_bits_add( uint64_t bits[static 4], char c ) {
+  if ( cc_bits_has( bits, c ) )
+    return false;
+  unsigned char const u = STATIC_CAST( unsigned char, c );
+  bits[ u >> 6 ] |= UINT64_C(1) << (u & 63);
+  return true;
 }
 
-////////// local functions ////////////////////////////////////////////////////
-
 /**
- * Frees the memory used by the comment delimiter character map.
+ * Initializes the closing comment delimiter of \a delim from its opening one.
+ * Where the opening delimiter ends with a run of a character:
+ *
+ *  + If it's an opening bracket, the closing delimiter is a run of the same
+ *    length of its closing bracket, e.g., `{` and `}` or `--[[` and `]]`.
  *
- * @sa cc_map_init()
+ *  + Otherwise, if the run is all of it, there's a closing delimiter, the
+ *    same as the opening one, only for three or more quotes, e.g., `"""`;
+ *    otherwise it's a to-end-of-line delimiter, e.g., `#` or `//`.
+ *
+ *  + Otherwise, unless it's a closing bracket, e.g., `*>`, the closing
+ *    delimiter is the run followed by the closing bracket of (if any) or else
+ *    the first character, e.g., `(*` and `*)` or `<!--` and `-->`.
+ *
+ * Words are always to-end-of-line delimiters.
+ *
+ * @param delim The \ref cc_delim to initialize.
  */
-static void cc_map_free( void ) {
-  for ( size_t i = 0; i < ARRAY_SIZE( cc_map ); ++i )
-    FREE( cc_map[i] );
+static void cc_delim_init_close( cc_delim_t *delim ) {
+  assert( delim != NULL );
+  char const *const open = delim->open;
+  size_t const len = delim->open_len;
+  size_t close_len = 0;
+
+  if ( !delim->is_word ) {
+    char const last = open[ len - 1 ];
+    size_t run_len = 1;
+    while ( run_len < len && open[ len - run_len - 1 ] == last )
+      ++run_len;
+    char const closing = closing_char( last );
+
+    if ( closing != '\0' ) {
+      memset( delim->close, closing, run_len );
+      close_len = run_len;
+    }
+    else if ( run_len == len ) {
+      if ( (last == '"' || last == '\'') && run_len >= 3 ) {
+        memcpy( delim->close, open, len );
+        close_len = len;
+      }
+    }
+    else if ( strchr( ")>]}", last ) == NULL ) {
+      memcpy( delim->close, open + len - run_len, run_len );
+      char const first_closing = closing_char( open[0] );
+      delim->close[ run_len ] = first_closing != '\0' ? first_closing : open[0];
+      close_len = run_len + 1;
+    }
+  }
+
+  delim->close[ close_len ] = '\0';
+  delim->close_len = STATIC_CAST( uint8_t, close_len );
 }
 
 /**
  * Adds a comment delimiter character, and its corresponding closing comment
- * delimiter character (if any), to the given set.
+ * delimiter character (if any), to \ref cc_map::cc_chars.
  *
- * @param cc_set The set to add to.
  * @param c The character to add.
  * @return Returns the number of distinct comment delimiter characters added.
  */
-NODISCARD
-static unsigned cc_set_add( cc_set_t cc_set, char c ) {
-  unsigned added = 0;
-  if ( !cc_set[ STATIC_CAST( unsigned char, c ) ] ) {
-    cc_set[ STATIC_CAST( unsigned char, c ) ] = true;
+static unsigned cc_map_add_char( char c ) {
+  if ( !cc_bits_add( cc_map.cc_chars, c ) )
+    return 0;
+  unsigned added = 1;
+  char const closing = closing_char( c );
+  if ( closing != '\0' && cc_bits_add( cc_map.cc_chars, closing ) )
     ++added;
-    char const closing = closing_char( c );
-    if ( closing != '\0' && !cc_set[ (unsigned char)closing ] ) {
-      cc_set[ STATIC_CAST( unsigned char, closing ) ] = true;
-      ++added;
-    }
-  }
   return added;
 }
 
+/**
+ * Adds a comment delimiter to \ref cc_map's trie, unless it's already there.
+ *
+ * @param open The opening comment delimiter to add.  It need not be
+ * null-terminated.
+ * @param len The length of \a open.
+ * @param in_cc The comment delimiters being compiled (for error messages).
+ * @param pnodes_len A pointer to the number of nodes so far.
+ */
+static void cc_map_add_delim( char const *open, size_t len, char const *in_cc,
+                              unsigned *pnodes_len ) {
+  assert( open != NULL );
+  assert( len > 0 && len <= CC_DELIM_LEN_MAX );
+  assert( pnodes_len != NULL );
+
+  unsigned node = 0;
+  for ( size_t i = 0; i < len; ++i ) {
+    unsigned char const c = STATIC_CAST( unsigned char, open[i] );
+    unsigned next = cc_map.cc_next[ node ][ c ];
+    if ( next == 0 ) {
+      if ( *pnodes_len == CC_NODES_MAX )
+        goto too_many;
+      next = (*pnodes_len)++;
+      cc_map.cc_next[ node ][ c ] = STATIC_CAST( uint8_t, next );
+    }
+    node = next;
+  } // for
+
+  if ( cc_map.cc_out[ node ] != 0 )     // a duplicate
+    return;
+  if ( cc_map.cc_delims_len == CC_DELIMS_MAX )
+    goto too_many;
+
+  cc_delim_t *const delim = &cc_map.cc_delims[ cc_map.cc_delims_len++ ];
+  memcpy( delim->open, open, len );
+  delim->open[ len ] = '\0';
+  delim->open_len = STATIC_CAST( uint8_t, len );
+  delim->is_word = isalnum( open[0] );
+  cc_delim_init_close( delim );
+  cc_map.cc_out[ node ] = STATIC_CAST( uint8_t, cc_map.cc_delims_len );
+  PJL_DISCARD_RV( cc_bits_add( cc_map.cc_first, open[0] ) );
+  return;
+
+too_many:
+  fatal_error( EX_USAGE,
+    "\"%s\": invalid value for %s: too many comment delimiters\n",
+    in_cc, opt_format( COPT(COMMENT_CHARS) )
+  );
+}
+
 ////////// extern functions ///////////////////////////////////////////////////
 
 char const* cc_map_compile( char const *in_cc ) {
   assert( in_cc != NULL );
 
-  RUN_ONCE ATEXIT( &cc_map_free );
-
-  cc_set_t cc_set = { false };
   unsigned distinct_cc = 0;             // distinct comment characters
+  unsigned nodes_len = 1;               // node 0 is the root
+  MEM_ZERO( &cc_map );
 
-  cc_map_free();
-  cc_map_init();
-
-  for ( char const *cc = in_cc; *cc != '\0'; ++cc ) {
-    if ( isspace( *cc ) || *cc == ',' )
+  for ( char const *cc = in_cc; *cc != '\0'; ) {
+    if ( isspace( *cc ) || *cc == ',' ) {
+      ++cc;
       continue;
-    if ( !ispunct( *cc ) ) {
-      fatal_error( EX_USAGE,
-        "\"%s\": invalid value for %s;\n\tmust only be either:"
-        " punctuation or whitespace characters\n",
-        in_cc, opt_format( COPT(COMMENT_CHARS) )
-      );
     }
 
-    bool const is_double_cc = ispunct( cc[1] ) && cc[1] != ',';
-    if ( is_double_cc && ispunct( cc[2] ) && cc[2] != ',' ) {
+    bool const is_word = isalnum( *cc );
+    size_t len = 0;
+    for ( ; cc[ len ] != '\0' && !isspace( cc[ len ] ) && cc[ len ] != ',';
+          ++len ) {
+      if ( !cp_is_ascii( STATIC_CAST( unsigned char, cc[ len ] ) ) ||
+           !(is_word ? isalnum( cc[ len ] ) : ispunct( cc[ len ] )) ) {
+        fatal_error( EX_USAGE,
+          "\"%s\": invalid value for %s;\n\tmust only be either:"
+          " punctuation, alphanumeric, or whitespace characters, but not"
+          " both punctuation and alphanumeric characters in a delimiter\n",
+          in_cc, opt_format( COPT(COMMENT_CHARS) )
+        );
+      }
+    } // for
+    if ( len > CC_DELIM_LEN_MAX ) {
       fatal_error( EX_USAGE,
-        "\"%s\": invalid value for %s: \"%c%c%c\":"
-        " more than two consecutive comment characters\n",
-        in_cc, opt_format( COPT(COMMENT_CHARS) ), cc[0], cc[1], cc[2]
+        "\"%s\": invalid value for %s: \"%.*s\":"
+        " more than %d comment characters\n",
+        in_cc, opt_format( COPT(COMMENT_CHARS) ), STATIC_CAST( int, len ), cc,
+        CC_DELIM_LEN_MAX
       );
     }
-    char const cc1 = is_double_cc ? cc[1] : CC_SINGLE_CHAR;
-
-    unsigned char const *const ucc = STATIC_CAST( unsigned char*, cc );
-    char *cc_map_entry = cc_map[ ucc[0] ];
-    if ( cc_map_entry == NULL ) {
-      cc_map_entry = MALLOC( char, 1 + 1/*\0*/ );
-      cc_map_entry[0] = cc1;
-      cc_map_entry[1] = '\0';
-    }
-    else if ( strchr( cc_map_entry, cc1 ) == NULL ) {
-      //
-      // Add the second comment delimiter character only if it's not already
-      // there.
-      //
-      size_t const len = strlen( cc_map_entry );
-      REALLOC( cc_map_entry, char, len + 1 + 1/*\0*/ );
-      cc_map_entry[ len ] = cc1;
-      cc_map_entry[ len + 1 ] = '\0';
-    }
-    cc_map[ ucc[0] ] = cc_map_entry;
 
-    distinct_cc += cc_set_add( cc_set, cc[0] );
-    if ( is_double_cc ) {
-      distinct_cc += cc_set_add( cc_set, cc[1] );
-      ++cc;                             // skip past second comment character
+    cc_map_add_delim( cc, len, in_cc, &nodes_len );
+    //
+    // Only the characters of one- or two-character delimiters are comment
+    // delimiter characters: any other delimiter, e.g., "<!--", must be
+    // matched as a whole so that, e.g., "<p>" isn't mistaken for a comment.
+    //
+    if ( !is_word && len <= 2 ) {
+      for ( size_t i = 0; i < len; ++i )
+        distinct_cc += cc_map_add_char( cc[i] );
     }
+    cc += len;
   } // for
 
-  if ( distinct_cc == 0 ) {
+  if ( cc_map.cc_delims_len == 0 ) {
     fatal_error( EX_USAGE,
       "value for %s must not be only whitespace or commas\n",
       opt_format( COPT(COMMENT_CHARS) )
     );
   }
 
-  char *const out_cc = free_later( MALLOC( char, distinct_cc + 1/*\0*/ ) );
+  memcpy( cc_map.cc_all_chars, cc_map.cc_chars, sizeof cc_map.cc_chars );
+
+  char *const out_cc = ARENA_ALLOC( char, distinct_cc + 1/*\0*/ );
   char *s = out_cc;
-  for ( size_t i = 0; i < ARRAY_SIZE( cc_set ); ++i ) {
-    if ( cc_set[i] )
+  for ( unsigned i = 1; i < 128; ++i ) {
+    if ( cc_map_is_char( STATIC_CAST( char, i ) ) )
       *s++ = STATIC_CAST( char, i );
   } // for
   *s = '\0';
 
 #ifndef NDEBUG
   if ( is_affirmative( getenv( "WRAP_DUMP_CC_MAP" ) ) ) {
-    for ( size_t i = 0; i < ARRAY_SIZE( cc_map ); ++i ) {
-      if ( cc_map[i] )
-        EPRINTF( "%c \"%s\"\n", STATIC_CAST( char, i ), cc_map[i] );
+    for ( unsigned i = 0; i < cc_map.cc_delims_len; ++i ) {
+      cc_delim_t const *const delim = &cc_map.cc_delims[i];
+      EPRINTF( "\"%s\" \"%s\"\n", delim->open, delim->close );
     } // for
-    EPRINTF( "\n%u distinct = \"%s\"\n", distinct_cc, out_cc );
+    EPRINTF(
+      "\n%u nodes, %u distinct = \"%s\"\n", nodes_len, distinct_cc, out_cc
+    );
   }
 #endif /* NDEBUG */
 
   return out_cc;
 }
 
+size_t cc_map_match( char const *s, cc_delim_t const **pdelim ) {
+  assert( s != NULL );
+  cc_delim_t const *found = NULL;
+  unsigned node = 0;
+
+  for ( size_t i = 0; cp_is_ascii( STATIC_CAST( unsigned char, s[i] ) );
+        ++i ) {
+    node = cc_map.cc_next[ node ][ STATIC_CAST( unsigned char, s[i] ) ];
+    if ( node == 0 )
+      break;
+    unsigned const out = cc_map.cc_out[ node ];
+    if ( out == 0 )
+      continue;
+    cc_delim_t const *const delim = &cc_map.cc_delims[ out - 1 ];
+    if ( (!cc_map.cc_is_restricted || delim == cc_map.cc_only) &&
+         !(delim->is_word && isalnum( s[ i + 1 ] )) ) {
+      found = delim;
+    }
+  } // for
+
+  if ( pdelim != NULL )
+    *pdelim = found;
+  return found != NULL ? found->open_len : 0;
+}
+
+void cc_map_restrict( char const *cc, cc_delim_t const *delim ) {
+  cc_map.cc_is_restricted = cc != NULL;
+  cc_map.cc_only = delim;
+  if ( cc == NULL ) {
+    memcpy( cc_map.cc_chars, cc_map.cc_all_chars, sizeof cc_map.cc_chars );
+    return;
+  }
+  MEM_ZERO( &cc_map.cc_chars );
+  for ( ; *cc != '\0'; ++cc ) {
+    if ( !isalnum( *cc ) )
+      PJL_DISCARD_RV( cc_map_add_char( *cc ) );
+  } // for
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
@@ -23,8 +23,8 @@
 
 /**
  * @file
- * Contains a type for a comment delimiter character map and functions to
- * manipulate it.
+ * Contains a type for a comment delimiter map and functions to manipulate
+ * it.
  */
 
 // local
@@ -34,7 +34,8 @@
 
 // standard
 #include <stdbool.h>
-#include <string.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint8_t, uint64_t */
 
 /// @endcond
 
@@ -45,74 +46,147 @@ _GL_INLINE_HEADER_BEGIN
 
 /**
  * @ingroup wrapc-group
- * @defgroup cc-map-group Comment Delimiter Character Map
- * Declares a \ref cc_map_t "comment delimiter character map" and related
- * functions.
+ * @defgroup cc-map-group Comment Delimiter Map
+ * Declares a \ref cc_map "comment delimiter map" and related functions.
  * @{
  */
 
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
- * Presence of this within a comment delimiter character map entry means the
- * delimeter is a single comment delimiter character.
+ * Maximum number of characters in a comment delimiter.
  */
-#define CC_SINGLE_CHAR            ' '
+#define CC_DELIM_LEN_MAX          8
 
 /**
- * Comment delimiter character map indexed by character.  If an entry is:
- *
- *  + NULL, that character is not a comment delimiter character.
- *
- *  + A non-empty string, that character followed by each character (except
- *    space) in said string forms a two-character comment delimiter, e.g., `//`
- *    or `(*`.  A space means it forms a single comment character delimiter,
- *    e.g., `#`.
+ * Maximum number of distinct comment delimiters.
+ */
+#define CC_DELIMS_MAX             64
+
+/**
+ * Maximum number of nodes of a \ref cc_map's trie: one more than the maximum
+ * total number of characters of its distinct comment delimiters.
+ */
+#define CC_NODES_MAX              256
+
+/**
+ * A comment delimiter.
  */
-typedef char* cc_map_t[128];
+struct cc_delim {
+  char    open[ CC_DELIM_LEN_MAX + 1 ]; ///< The opening delimiter.
+  char    close[ CC_DELIM_LEN_MAX + 1 ];///< The closing one; empty if none.
+  uint8_t open_len;                     ///< Length of \a open.
+  uint8_t close_len;                    ///< Length of \a close.
+
+  /// Is it made of letters and digits, e.g., `REM`, hence a word?
+  bool    is_word;
+};
+typedef struct cc_delim cc_delim_t;
+
+/**
+ * Comment delimiter map: sets of characters, each as a bitmap indexed by
+ * character, and a trie of the comment delimiters with a transition table so
+ * that checking whether a character is a comment delimiter character is only
+ * a load and a mask and the longest comment delimiter at a position is found
+ * in one pass of at most #CC_DELIM_LEN_MAX loads however many there are.
+ */
+struct cc_map {
+  uint64_t    cc_chars[4];              ///< Comment delimiter characters.
+  uint64_t    cc_all_chars[4];          ///< Ditto unless restricted.
+  uint64_t    cc_first[4];              ///< First character of a delimiter.
+  bool        cc_is_restricted;         ///< Restricted via cc_map_restrict()?
+  cc_delim_t const *cc_only;            ///< If so, only this, if any.
+  unsigned    cc_delims_len;            ///< Number of distinct delimiters.
+  cc_delim_t  cc_delims[ CC_DELIMS_MAX ];
+
+  /// The child of a node for a character, if any; 0 (the root) otherwise.
+  uint8_t     cc_next[ CC_NODES_MAX ][128];
+
+  /// One more than the index into \a cc_delims of the delimiter that ends at
+  /// a node, if any; 0 otherwise.
+  uint8_t     cc_out[ CC_NODES_MAX ];
+};
+typedef struct cc_map cc_map_t;
+
+extern cc_map_t     cc_map;             ///< The comment delimiter map.
 
 ////////// extern functions ///////////////////////////////////////////////////
 
 /**
- * Gets whether the comment delimiter character referred to by the given map
- * entry is a single comment delimiter character.
+ * Gets whether \a c is in \a bits.
  *
- * @param cc_map_entry A comment delimiter character map entry returned by
- * cc_map_get().
- * @return Returns `true` only if \a cc_map_entry is a single comment delimiter
- * character.
+ * @param bits The set of characters as a bitmap indexed by character.
+ * @param c The character to check.
+ * @return Returns `true` only if \a c is in \a bits.
  */
 NODISCARD W_CC_MAP_H_INLINE
-bool cc_is_single( char const *cc_map_entry ) {
-  return strchr( cc_map_entry, CC_SINGLE_CHAR ) != NULL;
+bool cc_bits_has( uint64_t const bits[static 4], char c ) {
+  unsigned char const u = (unsigned char)c;
+  return (bits[ u >> 6 ] >> (u & 63)) & 1;
 }
 
 /**
- * Compiles a set of comment delimiter characters into a string of distinct
- * comment delimiter characters and a \ref cc_map_t used by
- * align_eol_comments().
+ * Compiles a set of comment delimiters into a string of distinct comment
+ * delimiter characters and \ref cc_map.
  *
- * @param in_cc The comment delimiter characters to compile.  It is one or more
- * one- or two-character comment delimiters separated by either commas or
- * whitesspace.
+ * @param in_cc The comment delimiters to compile.  It is one or more comment
+ * delimiters separated by either commas or whitespace.  Each is either one or
+ * more punctuation characters, e.g., `<!--`, or one or more letters and
+ * digits, e.g., `REM`, that is recognized only as a whole word.
  * @return Returns said string of distinct comment delimiter characters.
  */
 NODISCARD
 char const* cc_map_compile( char const *in_cc );
 
 /**
- * Gets the comment delimiter character map entry for the given character.
+ * Gets whether \a c is a comment delimiter character, i.e., either any
+ * character of a one- or two-character comment delimiter other than a word or
+ * the closing character of one.
  *
- * @param c The character to get the comment delimiter character map entry for.
- * @return Returns said entry or null if \a c is not a comment delimiter
- * character.
+ * @param c The character to check.
+ * @return Returns `true` only if it is.
  */
 NODISCARD W_CC_MAP_H_INLINE
-char const* cc_map_get( char c ) {
-  extern cc_map_t cc_map;
-  return cc_map[ (unsigned char)c ];
+bool cc_map_is_char( char c ) {
+  return cc_bits_has( cc_map.cc_chars, c );
 }
 
+/**
+ * Gets whether \a c is the first character of any comment delimiter
+ * regardless of any restriction via cc_map_restrict().
+ *
+ * @param c The character to check.
+ * @return Returns `true` only if it is.
+ */
+NODISCARD W_CC_MAP_H_INLINE
+bool cc_map_is_first( char c ) {
+  return cc_bits_has( cc_map.cc_first, c );
+}
+
+/**
+ * Gets the longest comment delimiter that \a s starts with.  A word is
+ * matched only if it's not followed by a letter or digit; whether it's
+ * preceded by one must be checked by the caller.
+ *
+ * @param s The null-terminated string to check.
+ * @param pdelim If not NULL, set to said delimiter, if any.
+ * @return Returns the length of said delimiter or 0 if none.
+ */
+NODISCARD
+size_t cc_map_match( char const *s, cc_delim_t const **pdelim );
+
+/**
+ * Restricts the comment delimiter characters to only those (that aren't
+ * letters or digits) in \a cc and their closing characters, if any, and the
+ * comment delimiters recognized by cc_map_match() to only \a delim.
+ *
+ * @param cc The comment delimiter characters to restrict to or NULL to lift
+ * any restriction.
+ * @param delim The comment delimiter to restrict to or NULL for none.  Ignored
+ * if \a cc is NULL.
+ */
+void cc_map_restrict( char const *cc, cc_delim_t const *delim );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 _GL_INLINE_HEADER_END
@@ -0,0 +1,1066 @@
+/*
+**      wrap -- text reformatter
+**      src/codec.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for transparently decompressing (or transcoding) input
+ * and compressing (or transcoding) output.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "codec.h"
+#include "ring.h"                       /* for WITH_RING */
+#include "simd.h"
+#include "unicode.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>                      /* for fcntl(2), open(2) */
+#include <limits.h>                     /* for UINT_MAX */
+#include <stdbool.h>
+#include <stdint.h>                     /* for uint8_t */
+#include <stdio.h>
+#include <stdlib.h>                     /* for free(3) */
+#include <string.h>                     /* for memcmp(3), strcmp(3) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for close(2), pipe(2), read(2) */
+
+#ifdef WITH_ZLIB
+# include <zlib.h>
+#endif /* WITH_ZLIB */
+#ifdef WITH_ZSTD
+# include <zstd.h>
+#endif /* WITH_ZSTD */
+
+/// @endcond
+
+/**
+ * @addtogroup codec-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Size of the buffers used for compressing output.
+ */
+#define CODEC_BUF_SIZE            (64 * 1024)
+
+/**
+ * Decompression state for a single compressed input.
+ */
+struct decoder {
+  codec_t       codec;                  ///< Codec of \a src.
+  char const   *src;                    ///< Next compressed byte not yet given.
+  char const   *src_end;                ///< One past last compressed byte.
+  int           fd;                     ///< Read more from; -1 = none.
+  char         *buf;                    ///< Buffer read into, if \a fd.
+  size_t        buf_size;               ///< Size of \a buf.
+  char const   *error;                  ///< Why decoding failed, if it did.
+  bool          eof;                    ///< All decompressed?
+  bool          in_stream;              ///< Within a compressed stream?
+  size_t        mem;                    ///< Heap bytes allocated by the codec.
+  char          utf8[4];                ///< Transcoded character not yet read.
+  uint8_t       utf8_pos;               ///< Next byte of \a utf8 to read.
+  uint8_t       utf8_len;               ///< Length of \a utf8; 0 = none.
+#ifdef WITH_ZLIB
+  z_stream      gz;                     ///< zlib state.
+#endif /* WITH_ZLIB */
+#ifdef WITH_ZSTD
+  ZSTD_DCtx    *zstd;                   ///< libzstd state.
+  ZSTD_inBuffer zstd_in;                ///< libzstd input.
+#endif /* WITH_ZSTD */
+};
+
+#ifdef WITH_RING
+/**
+ * Compression thread for standard output.
+ */
+struct encoder {
+  codec_t       codec;                  ///< Codec to compress with.
+  int           in_fd;                  ///< Read end of the pipe.
+  int           out_fd;                 ///< The compressed file.
+  pid_t         pid;                    ///< Process that started the thread.
+  pthread_t     tid;                    ///< Thread ID.
+  int           error;                  ///< `errno` of failed I/O, if any.
+  char const   *codec_error;            ///< Why compressing failed, if it did.
+  char          carry[4];               ///< Start of an incomplete character.
+  size_t        carry_len;              ///< Length of \a carry.
+#ifdef WITH_ZLIB
+  z_stream      gz;                     ///< zlib state.
+#endif /* WITH_ZLIB */
+#ifdef WITH_ZSTD
+  ZSTD_CCtx    *zstd;                   ///< libzstd state.
+#endif /* WITH_ZSTD */
+};
+typedef struct encoder encoder_t;
+
+// local variable definitions
+static encoder_t    encoder;            ///< The one for standard output.
+#endif /* WITH_RING */
+
+// local functions
+#if defined(WITH_ZLIB) || defined(WITH_ZSTD)
+NODISCARD
+static ssize_t      decoder_fail( decoder_t*, char const* );
+#endif /* WITH_ZLIB || WITH_ZSTD */
+
+NODISCARD
+static ssize_t      decoder_refill( decoder_t* );
+
+#ifdef WITH_RING
+static void         encoder_finish( void );
+
+NODISCARD
+static int          encoder_out( encoder_t*, char const*, size_t, bool,
+                                 char* );
+
+static void*        encoder_thread_main( void* );
+#endif /* WITH_RING */
+
+#ifdef WITH_ZLIB
+static voidpf       gzip_alloc( voidpf, uInt, uInt );
+static void         gzip_free( voidpf, voidpf );
+
+NODISCARD
+static ssize_t      gzip_read( decoder_t*, char*, size_t );
+#endif /* WITH_ZLIB */
+
+NODISCARD
+static char32_t     unicode_get( codec_t, char const**, char const* );
+
+#ifdef WITH_RING
+NODISCARD
+static size_t       unicode_get8( char const*, size_t, char32_t* );
+
+NODISCARD
+static int          unicode_out( encoder_t*, char const*, size_t, bool,
+                                 char* );
+
+NODISCARD
+static size_t       unicode_put( codec_t, char32_t, char* );
+#endif /* WITH_RING */
+
+NODISCARD
+static ssize_t      unicode_read( decoder_t*, char*, size_t );
+
+#ifdef WITH_ZSTD
+NODISCARD
+static ssize_t      zstd_read( decoder_t*, char*, size_t );
+#endif /* WITH_ZSTD */
+
+////////// local functions ////////////////////////////////////////////////////
+
+#if defined(WITH_ZLIB) || defined(WITH_ZSTD)
+/**
+ * Notes that \a d failed.
+ *
+ * @param d The \ref decoder that failed.
+ * @param error Why it failed.
+ * @return Always returns -1.
+ */
+static ssize_t decoder_fail( decoder_t *d, char const *error ) {
+  d->error = error;
+  d->eof = true;
+  return -1;
+}
+#endif /* WITH_ZLIB || WITH_ZSTD */
+
+/**
+ * Reads more compressed bytes from the file descriptor of \a d, if it has one,
+ * into its buffer after those not yet given.
+ *
+ * @param d The \ref decoder to read more for.
+ * @return Returns the number of bytes read, 0 on EOF (or if \a d has no file
+ * descriptor), or -1 on error (in which case `errno` says why).
+ */
+static ssize_t decoder_refill( decoder_t *d ) {
+  if ( d->fd == -1 )
+    return 0;
+  size_t const left = STATIC_CAST( size_t, d->src_end - d->src );
+  memmove( d->buf, d->src, left );
+  d->src = d->buf;
+  d->src_end = d->buf + left;
+
+  for (;;) {
+    ssize_t const n = read( d->fd, d->buf + left, d->buf_size - left );
+    if ( n > 0 ) {
+      d->src_end += n;
+      return n;
+    }
+    if ( n == 0 || errno != EINTR ) {
+      d->fd = -1;                       // don't read again
+      if ( n == -1 )
+        d->eof = true;
+      return n;
+    }
+  } // for
+}
+
+#ifdef WITH_RING
+/**
+ * Finishes compressing standard output: makes the compression thread see EOF
+ * on its pipe, waits for it to finish, and closes the compressed file.  This
+ * is called only via **atexit**(3).
+ *
+ * @note Since calling **exit**(3) from within a function called via
+ * **atexit**(3) is undefined behavior, errors are reported via **_exit**(2).
+ */
+static void encoder_finish( void ) {
+  if ( getpid() != encoder.pid )        // a child process: not ours
+    return;
+  if ( fflush( stdout ) != 0 && encoder.error == 0 )
+    encoder.error = errno;
+  //
+  // The thread sees EOF once every write end of the pipe, including those of
+  // child processes, if any, is closed.  Rather than simply closing standard
+  // output (so that whatever file is opened next doesn't get its descriptor),
+  // replace it.
+  //
+  int const null_fd = open( "/dev/null", O_WRONLY );
+  if ( null_fd == -1 ) {
+    close( STDOUT_FILENO );
+  } else {
+    PJL_DISCARD_RV( dup2( null_fd, STDOUT_FILENO ) );
+    close( null_fd );
+  }
+  PJL_DISCARD_RV( pthread_join( encoder.tid, /*retval=*/NULL ) );
+  if ( close( encoder.out_fd ) == -1 && encoder.error == 0 )
+    encoder.error = errno;
+
+  if ( unlikely( encoder.codec_error != NULL ) ) {
+    EPRINTF( "%s: %s: %s\n",
+      me, codec_name( encoder.codec ), encoder.codec_error
+    );
+    _exit( EX_SOFTWARE );
+  }
+  if ( unlikely( encoder.error != 0 ) ) {
+    errno = encoder.error;
+    perror( me );
+    _exit( EX_IOERR );
+  }
+}
+
+/**
+ * Compresses (or transcodes) \a len bytes of \a s via \a e and writes the
+ * result.
+ *
+ * @param e The \ref encoder to use.
+ * @param s The bytes to compress.
+ * @param len The number of bytes of \a s.
+ * @param finish If `true`, also finishes the compressed stream.
+ * @param out A buffer of #CODEC_BUF_SIZE bytes to compress into.
+ * @return Returns 0 on success, the value of `errno` on failure to write, or
+ * -1 on failure to compress (in which case \a e's \a codec_error says why).
+ */
+static int encoder_out( encoder_t *e, char const *s, size_t len, bool finish,
+                        char *out ) {
+  switch ( e->codec ) {
+    case CODEC_NONE:
+      break;
+
+    case CODEC_GZIP:
+#ifdef WITH_ZLIB
+      e->gz.next_in = POINTER_CAST( Bytef*, s );
+      e->gz.avail_in = STATIC_CAST( uInt, len );
+      do {
+        e->gz.next_out = POINTER_CAST( Bytef*, out );
+        e->gz.avail_out = CODEC_BUF_SIZE;
+        PJL_DISCARD_RV( deflate( &e->gz, finish ? Z_FINISH : Z_NO_FLUSH ) );
+        int const error =
+          fd_write( e->out_fd, out, CODEC_BUF_SIZE - e->gz.avail_out );
+        if ( error != 0 )
+          return error;
+      } while ( e->gz.avail_out == 0 );
+#endif /* WITH_ZLIB */
+      break;
+
+    case CODEC_ZSTD: {
+#ifdef WITH_ZSTD
+      ZSTD_inBuffer in = { s, len, 0 };
+      for (;;) {
+        ZSTD_outBuffer o = { out, CODEC_BUF_SIZE, 0 };
+        size_t const rv = ZSTD_compressStream2(
+          e->zstd, &o, &in, finish ? ZSTD_e_end : ZSTD_e_continue
+        );
+        if ( ZSTD_isError( rv ) ) {
+          e->codec_error = ZSTD_getErrorName( rv );
+          return -1;
+        }
+        int const error = fd_write( e->out_fd, out, o.pos );
+        if ( error != 0 )
+          return error;
+        if ( finish ? rv == 0 : in.pos == in.size )
+          break;
+      } // for
+#endif /* WITH_ZSTD */
+      break;
+    }
+
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE:
+    case CODEC_UTF32BE:
+    case CODEC_UTF32LE:
+      return unicode_out( e, s, len, finish, out );
+  } // switch
+  (void)s;
+  (void)len;
+  (void)finish;
+  (void)out;
+  return 0;
+}
+
+/**
+ * The main function of the \ref encoder thread: reads from its pipe and
+ * compresses what it reads until EOF.
+ *
+ * @param arg A pointer to the \ref encoder.
+ * @return Always returns NULL.
+ */
+static void* encoder_thread_main( void *arg ) {
+  encoder_t *const e = arg;
+  char *const in = MALLOC( char, CODEC_BUF_SIZE );
+  char *const out = MALLOC( char, CODEC_BUF_SIZE );
+  bool failed = false;
+
+  for (;;) {
+    ssize_t const n = read( e->in_fd, in, CODEC_BUF_SIZE );
+    if ( n == -1 ) {
+      if ( errno == EINTR )
+        continue;
+      e->error = errno;
+      break;
+    }
+    //
+    // After an error, keep reading (and discarding) so that writers never
+    // block on a full pipe.
+    //
+    if ( !failed ) {
+      int const rv = encoder_out(
+        e, in, STATIC_CAST( size_t, n ), /*finish=*/n == 0, out
+      );
+      if ( rv != 0 ) {
+        if ( rv > 0 )
+          e->error = rv;
+        failed = true;
+      }
+    }
+    if ( n == 0 )
+      break;
+  } // for
+
+  FREE( in );
+  FREE( out );
+  return NULL;
+}
+#endif /* WITH_RING */
+
+#ifdef WITH_ZLIB
+/**
+ * The zlib allocation function that also counts the bytes allocated.
+ *
+ * @param opaque A pointer to the \ref decoder.
+ * @param items The number of items to allocate.
+ * @param size The size of each item.
+ * @return Returns a pointer to the allocated memory.
+ */
+static voidpf gzip_alloc( voidpf opaque, uInt items, uInt size ) {
+  decoder_t *const d = opaque;
+  size_t const bytes = STATIC_CAST( size_t, items ) * size;
+  d->mem += bytes;
+  return MALLOC( char, bytes );
+}
+
+/**
+ * The zlib deallocation function.
+ *
+ * @param opaque Not used.
+ * @param p A pointer to the memory to free.
+ */
+static void gzip_free( voidpf opaque, voidpf p ) {
+  (void)opaque;
+  free( p );
+}
+
+/**
+ * Decompresses gzip data.
+ *
+ * @param d The \ref decoder to use.
+ * @param buf The buffer to decompress into.
+ * @param size The size of \a buf.
+ * @return Returns the number of bytes decompressed, 0 on EOF, or -1 on error.
+ *
+ * @sa decoder_read()
+ */
+static ssize_t gzip_read( decoder_t *d, char *buf, size_t size ) {
+  z_stream *const gz = &d->gz;
+  if ( size > UINT_MAX )
+    size = UINT_MAX;
+  gz->next_out = POINTER_CAST( Bytef*, buf );
+  gz->avail_out = STATIC_CAST( uInt, size );
+
+  while ( gz->avail_out > 0 ) {
+    if ( gz->avail_in == 0 ) {
+      size_t left = STATIC_CAST( size_t, d->src_end - d->src );
+      if ( left == 0 && d->fd != -1 ) {
+        //
+        // Rather than wait for more to be read (e.g., from a pipe), return
+        // what's been decompressed so far, if anything.
+        //
+        if ( gz->avail_out < size )
+          break;
+        if ( decoder_refill( d ) == -1 )
+          return -1;
+        left = STATIC_CAST( size_t, d->src_end - d->src );
+      }
+      if ( left == 0 ) {
+        if ( d->in_stream )
+          return decoder_fail( d, "unexpected end of compressed data" );
+        d->eof = true;
+        break;
+      }
+      if ( left > UINT_MAX )
+        left = UINT_MAX;
+      gz->next_in = POINTER_CAST( Bytef*, d->src );
+      gz->avail_in = STATIC_CAST( uInt, left );
+      d->src += left;
+    }
+    d->in_stream = true;
+    int const rv = inflate( gz, Z_NO_FLUSH );
+    if ( rv == Z_STREAM_END ) {
+      //
+      // There may be another gzip member concatenated after this one.
+      //
+      d->in_stream = false;
+      PJL_DISCARD_RV( inflateReset( gz ) );
+      continue;
+    }
+    if ( rv != Z_OK )
+      return decoder_fail( d, gz->msg != NULL ? gz->msg : "invalid data" );
+  } // while
+
+  return STATIC_CAST( ssize_t, size - gz->avail_out );
+}
+#endif /* WITH_ZLIB */
+
+/**
+ * Decodes the next character of UTF-16 or UTF-32.
+ *
+ * @param codec The codec of the character.
+ * @param ps A pointer to the pointer to the character's first byte.  It's
+ * advanced past the character.
+ * @param end One past the last byte.  There must be at least one byte.
+ * @return Returns the character's code-point or #CP_REPLACEMENT if either it's
+ * invalid or incomplete.
+ */
+static char32_t unicode_get( codec_t codec, char const **ps,
+                             char const *end ) {
+  assert( ps != NULL );
+  assert( *ps < end );
+  uint8_t const *const u = (void const*)*ps;
+  size_t const left = STATIC_CAST( size_t, end - *ps );
+  char32_t cp;
+
+  switch ( codec ) {
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE: {
+      if ( left < 2 )
+        break;
+      bool const is_be = codec == CODEC_UTF16BE;
+      cp = STATIC_CAST( char32_t, u[ !is_be ] << 8 | u[ is_be ] );
+      *ps += 2;
+      if ( cp >= 0xD800 && cp <= 0xDBFF && left >= 4 ) {
+        char32_t const lo =
+          STATIC_CAST( char32_t, u[ 2 + !is_be ] << 8 | u[ 2 + is_be ] );
+        if ( lo >= 0xDC00 && lo <= 0xDFFF ) {
+          *ps += 2;
+          return 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+        }
+      }
+      return cp >= 0xD800 && cp <= 0xDFFF ? CP_REPLACEMENT : cp;
+    }
+    case CODEC_UTF32BE:
+    case CODEC_UTF32LE: {
+      if ( left < 4 )
+        break;
+      bool const is_be = codec == CODEC_UTF32BE;
+      cp = STATIC_CAST( char32_t, u[ is_be ? 0 : 3 ] ) << 24 |
+           STATIC_CAST( char32_t, u[ is_be ? 1 : 2 ] ) << 16 |
+           STATIC_CAST( char32_t, u[ is_be ? 2 : 1 ] ) <<  8 |
+           STATIC_CAST( char32_t, u[ is_be ? 3 : 0 ] );
+      *ps += 4;
+      return cp > CP_VALID_MAX || (cp >= 0xD800 && cp <= 0xDFFF) ?
+        CP_REPLACEMENT : cp;
+    }
+    default:
+      unreachable();
+  } // switch
+
+  *ps = end;                            // incomplete last character
+  return CP_REPLACEMENT;
+}
+
+#ifdef WITH_RING
+/**
+ * Decodes the UTF-8 character at the start of \a s.
+ *
+ * @param s The characters.
+ * @param len The number of characters of \a s.  It must be at least 1.
+ * @param pcp A pointer to receive the character's code-point or
+ * #CP_REPLACEMENT if it's invalid.
+ * @return Returns the number of bytes decoded or 0 if the character continues
+ * past \a len.
+ */
+static size_t unicode_get8( char const *s, size_t len, char32_t *pcp ) {
+  assert( s != NULL );
+  assert( len > 0 );
+  assert( pcp != NULL );
+  size_t const n = utf8_len( s[0] );
+  if ( n <= 1 || n > 4 ) {
+    *pcp = n == 1 ? STATIC_CAST( char32_t, s[0] ) : CP_REPLACEMENT;
+    return 1;
+  }
+  for ( size_t i = 1; i < n; ++i ) {
+    if ( i == len )
+      return 0;
+    if ( !utf8_is_cont( s[i] ) ) {
+      *pcp = CP_REPLACEMENT;
+      return i;
+    }
+  } // for
+  char32_t const cp = utf8_decode( s );
+  *pcp = cp == CP_INVALID ? CP_REPLACEMENT : cp;
+  return n;
+}
+
+/**
+ * Transcodes \a len bytes of UTF-8 to UTF-16 or UTF-32 via \a e and writes
+ * the result.  A character split between calls is carried over to the next.
+ *
+ * @param e The \ref encoder to use.
+ * @param s The bytes to transcode.
+ * @param len The number of bytes of \a s.
+ * @param finish If `true`, there are no more bytes.
+ * @param out A buffer of #CODEC_BUF_SIZE bytes to transcode into.
+ * @return Returns 0 on success or the value of `errno` on failure to write.
+ */
+static int unicode_out( encoder_t *e, char const *s, size_t len, bool finish,
+                        char *out ) {
+  bool const is_utf16 =
+    e->codec == CODEC_UTF16BE || e->codec == CODEC_UTF16LE;
+  bool const is_be = e->codec == CODEC_UTF16BE || e->codec == CODEC_UTF32BE;
+  char const *const end = s + len;
+  size_t n = 0;                         // bytes of out used
+
+  while ( s < end || (finish && e->carry_len > 0) ) {
+    if ( CODEC_BUF_SIZE - n < 4 ) {     // no room for a character
+      int const error = fd_write( e->out_fd, out, n );
+      if ( error != 0 )
+        return error;
+      n = 0;
+    }
+
+    char32_t cp;
+    if ( e->carry_len > 0 ) {
+      char buf[8];
+      memcpy( buf, e->carry, e->carry_len );
+      size_t from_s = STATIC_CAST( size_t, end - s );
+      if ( from_s > 4 )
+        from_s = 4;
+      memcpy( buf + e->carry_len, s, from_s );
+      size_t const got = unicode_get8( buf, e->carry_len + from_s, &cp );
+      if ( got == 0 && !finish ) {      // still incomplete
+        memcpy( e->carry + e->carry_len, s, from_s );
+        e->carry_len += from_s;
+        break;
+      }
+      s += got == 0 ? from_s : got - e->carry_len;
+      if ( got == 0 )
+        cp = CP_REPLACEMENT;
+      e->carry_len = 0;
+    }
+    else {
+      if ( is_utf16 ) {
+        size_t max = (CODEC_BUF_SIZE - n) / 2;
+        if ( max > STATIC_CAST( size_t, end - s ) )
+          max = STATIC_CAST( size_t, end - s );
+        size_t const widened = simd_utf16_widen( s, max, is_be, out + n );
+        s += widened;
+        n += 2 * widened;
+        if ( s == end || CODEC_BUF_SIZE - n < 4 )
+          continue;
+      }
+      size_t const got =
+        unicode_get8( s, STATIC_CAST( size_t, end - s ), &cp );
+      if ( got == 0 ) {
+        if ( !finish ) {
+          e->carry_len = STATIC_CAST( size_t, end - s );
+          memcpy( e->carry, s, e->carry_len );
+          break;
+        }
+        cp = CP_REPLACEMENT;
+        s = end;
+      } else {
+        s += got;
+      }
+    }
+    n += unicode_put( e->codec, cp, out + n );
+  } // while
+
+  return fd_write( e->out_fd, out, n );
+}
+
+/**
+ * Encodes a Unicode code-point in UTF-16 or UTF-32.
+ *
+ * @param codec The codec to encode in.
+ * @param cp The code-point.  It must be valid.
+ * @param out A pointer to receive the 2 or 4 bytes.
+ * @return Returns the number of bytes.
+ */
+static size_t unicode_put( codec_t codec, char32_t cp, char *out ) {
+  assert( out != NULL );
+  uint8_t *const u = (void*)out;
+  switch ( codec ) {
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE: {
+      bool const is_be = codec == CODEC_UTF16BE;
+      if ( cp < 0x10000 ) {
+        u[ !is_be ] = STATIC_CAST( uint8_t, cp >> 8 );
+        u[ is_be ] = STATIC_CAST( uint8_t, cp );
+        return 2;
+      }
+      char32_t const hi = 0xD800 + ((cp - 0x10000) >> 10);
+      char32_t const lo = 0xDC00 + (cp & 0x3FF);
+      u[ !is_be ] = STATIC_CAST( uint8_t, hi >> 8 );
+      u[ is_be ] = STATIC_CAST( uint8_t, hi );
+      u[ 2 + !is_be ] = STATIC_CAST( uint8_t, lo >> 8 );
+      u[ 2 + is_be ] = STATIC_CAST( uint8_t, lo );
+      return 4;
+    }
+    case CODEC_UTF32BE:
+      u[0] = 0;
+      u[1] = STATIC_CAST( uint8_t, cp >> 16 );
+      u[2] = STATIC_CAST( uint8_t, cp >> 8 );
+      u[3] = STATIC_CAST( uint8_t, cp );
+      return 4;
+    case CODEC_UTF32LE:
+      u[0] = STATIC_CAST( uint8_t, cp );
+      u[1] = STATIC_CAST( uint8_t, cp >> 8 );
+      u[2] = STATIC_CAST( uint8_t, cp >> 16 );
+      u[3] = 0;
+      return 4;
+    default:
+      unreachable();
+  } // switch
+}
+#endif /* WITH_RING */
+
+/**
+ * Transcodes UTF-16 or UTF-32 to UTF-8.
+ *
+ * @param d The \ref decoder to use.
+ * @param buf The buffer to transcode into.
+ * @param size The size of \a buf.
+ * @return Returns the number of bytes transcoded or 0 on EOF.
+ *
+ * @sa decoder_read()
+ */
+static ssize_t unicode_read( decoder_t *d, char *buf, size_t size ) {
+  bool const is_utf16 =
+    d->codec == CODEC_UTF16BE || d->codec == CODEC_UTF16LE;
+  bool const is_be = d->codec == CODEC_UTF16BE;
+  char *o = buf;
+  char *const o_end = buf + size;
+
+  while ( o < o_end ) {
+    if ( d->utf8_len > 0 ) {            // rest of a character that didn't fit
+      *o++ = d->utf8[ d->utf8_pos++ ];
+      if ( d->utf8_pos == d->utf8_len )
+        d->utf8_pos = d->utf8_len = 0;
+      continue;
+    }
+    if ( d->src_end - d->src < 4 && d->fd != -1 ) {
+      //
+      // A character may be split between reads, so read more before decoding
+      // the last few bytes -- but, rather than wait for more to be read
+      // (e.g., from a pipe), return what's been transcoded so far, if
+      // anything.
+      //
+      if ( o > buf )
+        break;
+      if ( decoder_refill( d ) == -1 )
+        return -1;
+      continue;
+    }
+    if ( d->src == d->src_end )
+      break;
+    if ( is_utf16 ) {
+      size_t n = STATIC_CAST( size_t, d->src_end - d->src ) / 2;
+      if ( n > STATIC_CAST( size_t, o_end - o ) )
+        n = STATIC_CAST( size_t, o_end - o );
+      n = simd_utf16_narrow( d->src, n, is_be, o );
+      d->src += 2 * n;
+      o += n;
+      if ( o == o_end || d->src == d->src_end )
+        continue;
+    }
+    char32_t const cp = unicode_get( d->codec, &d->src, d->src_end );
+    size_t const len = utf8_encode( cp, d->utf8 );
+    size_t const room = STATIC_CAST( size_t, o_end - o );
+    if ( len <= room ) {
+      memcpy( o, d->utf8, len );
+      o += len;
+    } else {
+      memcpy( o, d->utf8, room );
+      o += room;
+      d->utf8_pos = STATIC_CAST( uint8_t, room );
+      d->utf8_len = STATIC_CAST( uint8_t, len );
+    }
+  } // while
+
+  if ( o == buf )
+    d->eof = true;
+  return STATIC_CAST( ssize_t, o - buf );
+}
+
+#ifdef WITH_ZSTD
+/**
+ * Decompresses zstd data.
+ *
+ * @param d The \ref decoder to use.
+ * @param buf The buffer to decompress into.
+ * @param size The size of \a buf.
+ * @return Returns the number of bytes decompressed, 0 on EOF, or -1 on error.
+ *
+ * @sa decoder_read()
+ */
+static ssize_t zstd_read( decoder_t *d, char *buf, size_t size ) {
+  ZSTD_outBuffer out = { buf, size, 0 };
+  while ( out.pos < out.size ) {
+    //
+    // Concatenated frames are decompressed as one automatically.
+    //
+    size_t const in_pos = d->zstd_in.pos, out_pos = out.pos;
+    size_t const rv = ZSTD_decompressStream( d->zstd, &out, &d->zstd_in );
+    if ( ZSTD_isError( rv ) )
+      return decoder_fail( d, ZSTD_getErrorName( rv ) );
+    //
+    // Once a frame has ended, calling again with no input returns nonzero
+    // (the size of the next frame's header) rather than 0, so note whether
+    // it's within a frame only when there's been progress.
+    //
+    if ( d->zstd_in.pos > in_pos || out.pos > out_pos )
+      d->in_stream = rv != 0;
+    if ( d->zstd_in.pos == d->zstd_in.size && out.pos < out.size ) {
+      if ( d->fd != -1 ) {
+        if ( out.pos > 0 )              // see gzip_read()
+          break;
+        ssize_t const n = decoder_refill( d );
+        if ( n == -1 )
+          return -1;
+        d->zstd_in = (ZSTD_inBuffer){ d->src, STATIC_CAST( size_t, n ), 0 };
+        d->src = d->src_end;
+        if ( n > 0 )
+          continue;
+      }
+      if ( d->in_stream )
+        return decoder_fail( d, "unexpected end of compressed data" );
+      d->eof = true;
+      break;
+    }
+  } // while
+  return STATIC_CAST( ssize_t, out.pos );
+}
+#endif /* WITH_ZSTD */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+codec_t codec_detect( char const *s, size_t size ) {
+  assert( s != NULL || size == 0 );
+#ifdef WITH_ZLIB
+  //
+  // A gzip member starts with its ID bytes followed by the compression method
+  // that's always 8 (deflate).
+  //
+  if ( size >= 3 && memcmp( s, "\x1F\x8B\x08", 3 ) == 0 )
+    return CODEC_GZIP;
+#endif /* WITH_ZLIB */
+#ifdef WITH_ZSTD
+  if ( size >= 4 && memcmp( s, "\x28\xB5\x2F\xFD", 4 ) == 0 )
+    return CODEC_ZSTD;
+#endif /* WITH_ZSTD */
+  //
+  // The UTF-32LE byte order mark starts with that of UTF-16LE, so check for it
+  // first.
+  //
+  if ( size >= 4 && memcmp( s, "\x00\x00\xFE\xFF", 4 ) == 0 )
+    return CODEC_UTF32BE;
+  if ( size >= 4 && memcmp( s, "\xFF\xFE\x00\x00", 4 ) == 0 )
+    return CODEC_UTF32LE;
+  if ( size >= 2 && memcmp( s, "\xFE\xFF", 2 ) == 0 )
+    return CODEC_UTF16BE;
+  if ( size >= 2 && memcmp( s, "\xFF\xFE", 2 ) == 0 )
+    return CODEC_UTF16LE;
+  return CODEC_NONE;
+}
+
+bool codec_is_unicode( codec_t codec ) {
+  switch ( codec ) {
+    case CODEC_NONE:
+    case CODEC_GZIP:
+    case CODEC_ZSTD:
+      return false;
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE:
+    case CODEC_UTF32BE:
+    case CODEC_UTF32LE:
+      return true;
+  } // switch
+  unreachable();
+}
+
+char const* codec_name( codec_t codec ) {
+  switch ( codec ) {
+    case CODEC_NONE: return "none";
+    case CODEC_GZIP: return "gzip";
+    case CODEC_ZSTD: return "zstd";
+    case CODEC_UTF16BE: return "UTF-16BE";
+    case CODEC_UTF16LE: return "UTF-16LE";
+    case CODEC_UTF32BE: return "UTF-32BE";
+    case CODEC_UTF32LE: return "UTF-32LE";
+  } // switch
+  unreachable();
+}
+
+codec_t codec_of_path( char const *path ) {
+  assert( path != NULL );
+  static struct {
+    char const *ext;
+    codec_t     codec;
+    bool        supported;
+    char const *option;
+  } const EXTS[] = {
+#ifdef WITH_ZLIB
+    { ".gz",  CODEC_GZIP, true,  "--with-zlib" },
+#else
+    { ".gz",  CODEC_GZIP, false, "--with-zlib" },
+#endif /* WITH_ZLIB */
+#ifdef WITH_ZSTD
+    { ".zst", CODEC_ZSTD, true,  "--with-zstd" },
+#else
+    { ".zst", CODEC_ZSTD, false, "--with-zstd" },
+#endif /* WITH_ZSTD */
+  };
+
+  size_t const path_len = strlen( path );
+  for ( size_t i = 0; i < ARRAY_SIZE( EXTS ); ++i ) {
+    size_t const ext_len = strlen( EXTS[i].ext );
+    if ( path_len <= ext_len ||
+         strcmp( path + path_len - ext_len, EXTS[i].ext ) != 0 ) {
+      continue;
+    }
+    if ( !EXTS[i].supported ) {
+      fatal_error( EX_UNAVAILABLE,
+        "\"%s\": %s compression not supported; configure with %s\n",
+        path, codec_name( EXTS[i].codec ), EXTS[i].option
+      );
+    }
+    return EXTS[i].codec;
+  } // for
+  return CODEC_NONE;
+}
+
+char const* decoder_error( decoder_t const *d ) {
+  assert( d != NULL );
+  return d->error;
+}
+
+size_t decoder_mem( decoder_t const *d ) {
+  assert( d != NULL );
+  size_t size = sizeof( decoder_t ) + d->mem;
+#ifdef WITH_ZSTD
+  if ( d->zstd != NULL )
+    size += ZSTD_sizeof_DCtx( d->zstd );
+#endif /* WITH_ZSTD */
+  return size;
+}
+
+decoder_t* decoder_new( codec_t codec, char const *src, size_t size ) {
+  assert( src != NULL );
+  decoder_t *const d = MALLOC( decoder_t, 1 );
+  MEM_ZERO( d );
+  d->codec = codec;
+  d->src = src;
+  d->src_end = src + size;
+  d->fd = -1;
+
+  switch ( codec ) {
+    case CODEC_NONE:
+      break;
+    case CODEC_GZIP:
+#ifdef WITH_ZLIB
+      d->gz.zalloc = &gzip_alloc;
+      d->gz.zfree = &gzip_free;
+      d->gz.opaque = d;
+      //
+      // Adding 16 to the window bits means to expect a gzip header.
+      //
+      if ( inflateInit2( &d->gz, /*windowBits=*/15 + 16 ) != Z_OK )
+        PJL_DISCARD_RV( decoder_fail( d, "can't initialize" ) );
+#endif /* WITH_ZLIB */
+      break;
+    case CODEC_ZSTD:
+#ifdef WITH_ZSTD
+      d->zstd_in = (ZSTD_inBuffer){ src, size, 0 };
+      d->src = d->src_end;              // all given to libzstd at once
+      if ( (d->zstd = ZSTD_createDCtx()) == NULL )
+        PJL_DISCARD_RV( decoder_fail( d, "can't initialize" ) );
+#endif /* WITH_ZSTD */
+      break;
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE:
+    case CODEC_UTF32BE:
+    case CODEC_UTF32LE:
+      break;                            // the BOM is transcoded like the rest
+  } // switch
+
+  return d;
+}
+
+decoder_t* decoder_new_fd( codec_t codec, int fd, char const *head,
+                           size_t size ) {
+  assert( fd >= 0 );
+  assert( head != NULL );
+  size_t const buf_size = size > CODEC_BUF_SIZE ? size : CODEC_BUF_SIZE;
+  char *const buf = MALLOC( char, buf_size );
+  memcpy( buf, head, size );
+  decoder_t *const d = decoder_new( codec, buf, size );
+  d->fd = fd;
+  d->buf = buf;
+  d->buf_size = buf_size;
+  d->mem += buf_size;
+  return d;
+}
+
+ssize_t decoder_read( decoder_t *d, char *buf, size_t size ) {
+  assert( d != NULL );
+  assert( buf != NULL );
+  if ( d->error != NULL )
+    return -1;
+  if ( d->eof || size == 0 )
+    return 0;
+  switch ( d->codec ) {
+    case CODEC_NONE:
+      break;
+    case CODEC_GZIP:
+#ifdef WITH_ZLIB
+      return gzip_read( d, buf, size );
+#else
+      break;
+#endif /* WITH_ZLIB */
+    case CODEC_ZSTD:
+#ifdef WITH_ZSTD
+      return zstd_read( d, buf, size );
+#else
+      break;
+#endif /* WITH_ZSTD */
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE:
+    case CODEC_UTF32BE:
+    case CODEC_UTF32LE:
+      return unicode_read( d, buf, size );
+  } // switch
+  return 0;
+}
+
+void encoder_stdout( codec_t codec ) {
+  if ( codec == CODEC_NONE )
+    return;
+#ifdef WITH_RING
+  ASSERT_RUN_ONCE();
+  int fds[2];
+  PERROR_EXIT_IF( pipe( fds ) == -1, EX_OSERR );
+  encoder.codec = codec;
+  encoder.in_fd = fds[ STDIN_FILENO ];
+  encoder.out_fd = fcntl( STDOUT_FILENO, F_DUPFD_CLOEXEC, 3 );
+  PERROR_EXIT_IF( encoder.out_fd == -1, EX_OSERR );
+  PERROR_EXIT_IF(
+    fcntl( encoder.in_fd, F_SETFD, FD_CLOEXEC ) == -1, EX_OSERR
+  );
+  DUP2( fds[ STDOUT_FILENO ], STDOUT_FILENO );
+  close( fds[ STDOUT_FILENO ] );
+  encoder.pid = getpid();
+
+  switch ( codec ) {
+    case CODEC_NONE:
+      break;
+    case CODEC_GZIP:
+#ifdef WITH_ZLIB
+      //
+      // Adding 16 to the window bits means to write a gzip header.
+      //
+      if ( deflateInit2( &encoder.gz, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         /*windowBits=*/15 + 16, /*memLevel=*/8,
+                         Z_DEFAULT_STRATEGY ) != Z_OK ) {
+        fatal_error( EX_SOFTWARE, "can't initialize gzip compression\n" );
+      }
+#endif /* WITH_ZLIB */
+      break;
+    case CODEC_ZSTD:
+#ifdef WITH_ZSTD
+      if ( (encoder.zstd = ZSTD_createCCtx()) == NULL )
+        fatal_error( EX_SOFTWARE, "can't initialize zstd compression\n" );
+#endif /* WITH_ZSTD */
+      break;
+    case CODEC_UTF16BE:
+    case CODEC_UTF16LE:
+    case CODEC_UTF32BE:
+    case CODEC_UTF32LE:
+      break;
+  } // switch
+
+  int const err = pthread_create(
+    &encoder.tid, /*attr=*/NULL, &encoder_thread_main, &encoder
+  );
+  if ( unlikely( err != 0 ) ) {
+    fatal_error( EX_OSERR,
+      "can't create %s thread: %s\n", codec_name( codec ), strerror( err )
+    );
+  }
+  ATEXIT( &encoder_finish );
+#else
+  fatal_error( EX_UNAVAILABLE,
+    "%s output requires threads; configure with --enable-pipeline\n",
+    codec_name( codec )
+  );
+#endif /* WITH_RING */
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,213 @@
+/*
+**      wrap -- text reformatter
+**      src/codec.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_codec_H
+#define wrap_codec_H
+
+/**
+ * @file
+ * Declares types and functions for transparently decompressing (or
+ * transcoding) input and compressing (or transcoding) output.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <sys/types.h>                  /* for ssize_t */
+
+/// @endcond
+
+/**
+ * @defgroup codec-group Compression Codecs
+ * Types and functions for decompressing input in-process as it's read and
+ * compressing output in-process as it's written.  Only the codecs that were
+ * compiled in (via the `--with-zlib` and `--with-zstd` options to
+ * `configure`) are supported.
+ *
+ * @remarks Input in UTF-16 or UTF-32 that starts with a byte order mark is
+ * likewise transcoded to UTF-8 (that's all the rest of **wrap**(1)
+ * understands) as it's read and output can be transcoded back as it's
+ * written.  Runs of ASCII, the common case, are transcoded several characters
+ * at a time via simd_utf16_narrow() and simd_utf16_widen().  Code units that
+ * aren't valid are replaced by #CP_REPLACEMENT.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Compression formats.
+ */
+enum codec {
+  CODEC_NONE,                           ///< Not compressed.
+  CODEC_GZIP,                           ///< **gzip**(1) via zlib.
+  CODEC_ZSTD,                           ///< **zstd**(1) via libzstd.
+  CODEC_UTF16BE,                        ///< UTF-16 big-endian.
+  CODEC_UTF16LE,                        ///< UTF-16 little-endian.
+  CODEC_UTF32BE,                        ///< UTF-32 big-endian.
+  CODEC_UTF32LE                         ///< UTF-32 little-endian.
+};
+typedef enum codec codec_t;
+
+/**
+ * Decompression state for a single compressed input.
+ */
+typedef struct decoder decoder_t;
+
+/**
+ * The maximum number of bytes codec_detect() needs to detect a codec.
+ */
+#define CODEC_DETECT_SIZE_MAX     4
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the codec that \a s is compressed with by its magic bytes or, for
+ * UTF-16 or UTF-32, its byte order mark.
+ *
+ * @param s The start of the possibly compressed data.
+ * @param size The number of bytes of \a s.
+ * @return Returns said codec or #CODEC_NONE if either \a s isn't compressed
+ * or its codec wasn't compiled in.
+ */
+NODISCARD
+codec_t codec_detect( char const *s, size_t size );
+
+/**
+ * Checks whether \a codec is a Unicode encoding other than UTF-8 rather than a
+ * compression format.
+ *
+ * @param codec The codec to check.
+ * @return Returns `true` only if it is.
+ */
+NODISCARD
+bool codec_is_unicode( codec_t codec );
+
+/**
+ * Gets the name of \a codec.
+ *
+ * @param codec The codec to get the name of.
+ * @return Returns said name.
+ */
+NODISCARD
+char const* codec_name( codec_t codec );
+
+/**
+ * Gets the codec that a file should be compressed with by the extension of
+ * its \a path.
+ *
+ * @param path The path of the file.
+ * @return Returns said codec or #CODEC_NONE if the extension isn't that of a
+ * compressed file.  If it is, but its codec wasn't compiled in, prints an
+ * error message and exits.
+ */
+NODISCARD
+codec_t codec_of_path( char const *path );
+
+/**
+ * Gets the number of bytes of heap memory used by \a d.
+ *
+ * @param d The \ref decoder to get the memory of.
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t decoder_mem( decoder_t const *d );
+
+/**
+ * Creates a \ref decoder that decompresses \a size bytes of \a src.
+ *
+ * @param codec The codec \a src is compressed with.
+ * @param src The compressed data that must remain valid for the lifetime of
+ * the \ref decoder.
+ * @param size The number of bytes of \a src.
+ * @return Returns a new \ref decoder.
+ */
+NODISCARD
+decoder_t* decoder_new( codec_t codec, char const *src, size_t size );
+
+/**
+ * Creates a \ref decoder that decompresses whatever is read from \a fd, e.g.,
+ * a pipe, as it's read.
+ *
+ * @param codec The codec the data are compressed with.
+ * @param fd The file descriptor to read from.
+ * @param head The first \a size bytes of the data that were already read from
+ * \a fd (to detect \a codec); they're copied.
+ * @param size The number of bytes of \a head.
+ * @return Returns a new \ref decoder.
+ *
+ * @sa decoder_new()
+ */
+NODISCARD
+decoder_t* decoder_new_fd( codec_t codec, int fd, char const *head,
+                           size_t size );
+
+/**
+ * Decompresses the next at most \a size bytes via \a d into \a buf.
+ * Concatenated compressed streams (as produced by, e.g., `cat a.gz b.gz`) are
+ * decompressed as one.
+ *
+ * @param d The \ref decoder to use.
+ * @param buf The buffer to decompress into.
+ * @param size The size of \a buf.
+ * @return Returns the number of bytes decompressed, 0 on EOF, or -1 if either
+ * the compressed data are invalid, in which case decoder_error() says why, or
+ * reading from the file descriptor of a \ref decoder created by
+ * decoder_new_fd() failed, in which case `errno` does.
+ *
+ * @note This may be called from any one thread at a time.
+ */
+NODISCARD
+ssize_t decoder_read( decoder_t *d, char *buf, size_t size );
+
+/**
+ * Gets why decoder_read() failed, if it did.
+ *
+ * @param d The \ref decoder to get the error of.
+ * @return Returns said message or NULL if decoder_read() hasn't failed.
+ */
+NODISCARD
+char const* decoder_error( decoder_t const *d );
+
+/**
+ * Compresses everything subsequently written to standard output via \a codec
+ * on a thread so that writing overlaps with compressing.  Standard output is
+ * redirected to a pipe whose other end the thread reads from so that all ways
+ * of writing to standard output (including by child processes) are
+ * compressed.  Compression is finished upon exit.
+ *
+ * @param codec The codec to compress with.  If #CODEC_NONE, does nothing.
+ *
+ * @note This must be called at most once and only after standard output has
+ * been opened for the output file.
+ */
+void encoder_stdout( codec_t codec );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_codec_H */
+/* vim:set et sw=2 ts=2: */
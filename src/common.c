@@ -27,27 +27,146 @@
 #include "pjl_config.h"                 /* must go first */
 #define W_COMMON_H_INLINE _GL_EXTERN_INLINE
 #include "common.h"
+#include "reader.h"
+#include "simd.h"
+#include "unicode.h"
 #include "util.h"
 
 /// @cond DOXYGEN_IGNORE
 
 // standard
 #include <assert.h>
+#include <string.h>                     /* for memcpy(3) */
 
 /// @endcond
 
+// local functions
+NODISCARD
+static size_t col_advance( char const*, size_t, size_t );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Advances a column past \a s: only the characters after its last newline, if
+ * any, are counted.
+ *
+ * @param s The characters to advance past.  They must not contain tabs.
+ * @param len The number of characters of \a s.
+ * @param col The column \a s starts at.
+ * @return Returns the column just after \a s.
+ */
+static size_t col_advance( char const *s, size_t len, size_t col ) {
+  size_t begin = len;
+  while ( begin > 0 && s[ begin - 1 ] != '\n' && s[ begin - 1 ] != '\r' )
+    --begin;
+  if ( begin > 0 )
+    col = 0;
+  for ( size_t i = begin; i < len; ++i ) {
+    if ( cp_is_ascii( STATIC_CAST( unsigned char, s[i] ) ) ) {
+      ++col;
+    } else if ( !utf8_is_cont( s[i] ) ) {
+      //
+      // A character split across calls counts as 1 column.
+      //
+      size_t const cp_len = utf8_len( s[i] );
+      col += cp_len > 1 && i + cp_len <= len ?
+        cp_width( utf8_decode( s + i ) ) : 1;
+    }
+  } // for
+  return col;
+}
+
 ////////// extern functions ///////////////////////////////////////////////////
 
-size_t check_readline( line_buf_t line, FILE *ffrom ) {
+size_t check_readline( line_buf_t *line, FILE *ffrom, size_t size_max ) {
+  assert( line != NULL );
   assert( ffrom != NULL );
-  size_t size = sizeof( line_buf_t );
-  if ( fgetsz( line, &size, ffrom ) == NULL )
-    FERROR( ffrom );
-  return size;
+  assert( size_max > 0 );
+
+  size_t len = 0;
+  while ( len < size_max ) {
+    size_t size;
+    char const *const s = reader_getline( ffrom, size_max - len, &size );
+    if ( s == NULL )
+      break;
+    line_buf_reserve( line, len + size );
+    memcpy( line->str + len, s, size );
+    len += size;
+    if ( s[ size - 1 ] == '\n' )
+      break;
+  } // while
+
+  line_buf_reserve( line, len + SIMD_SPAN_PAD );
+  line->str[ len ] = '\0';
+  line->len = len;
+  return len;
 }
 
 void common_cleanup( void ) {
-  free_now();
+  arena_reset( /*keep_chunk=*/false );
+}
+
+void line_buf_cleanup( line_buf_t *buf ) {
+  assert( buf != NULL );
+  FREE( buf->str );
+  buf->str = NULL;
+  buf->len = buf->cap = 0;
+}
+
+void line_buf_grow( line_buf_t *buf, size_t len ) {
+  assert( buf != NULL );
+  size_t cap = buf->cap > 0 ? buf->cap : LINE_BUF_SIZE;
+  while ( cap <= len )
+    cap *= 2;
+  buf->str = check_realloc( buf->str, cap );
+  if ( buf->cap == 0 )
+    buf->str[0] = '\0';
+  buf->cap = cap;
+}
+
+void line_buf_init( line_buf_t *buf ) {
+  assert( buf != NULL );
+  buf->str = NULL;
+  buf->len = buf->cap = 0;
+  line_buf_grow( buf, 0 );
+}
+
+char const* tabs_expand( char const *s, size_t *plen, size_t *pcol,
+                         line_buf_t *buf ) {
+  assert( s != NULL );
+  assert( plen != NULL );
+  assert( pcol != NULL );
+  assert( buf != NULL );
+
+  char const *const end = s + *plen;
+  char const *tab = memchr( s, '\t', *plen );
+  if ( tab == NULL ) {                  // common case: nothing to expand
+    *pcol = col_advance( s, *plen, *pcol );
+    return s;
+  }
+
+  size_t col = *pcol, len = 0;
+  for (;;) {
+    size_t const run_len = STATIC_CAST( size_t, tab - s );
+    col = col_advance( s, run_len, col );
+    size_t const spaces = tab < end ? opt_tab_spaces - col % opt_tab_spaces : 0;
+    line_buf_reserve( buf, len + run_len + spaces );
+    memcpy( buf->str + len, s, run_len );
+    memset( buf->str + len + run_len, ' ', spaces );
+    len += run_len + spaces;
+    col += spaces;
+    if ( tab == end )
+      break;
+    s = tab + 1;
+    tab = memchr( s, '\t', STATIC_CAST( size_t, end - s ) );
+    if ( tab == NULL )
+      tab = end;
+  } // for
+
+  buf->str[ len ] = '\0';
+  *plen = len;
+  *pcol = col;
+  return buf->str;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -30,11 +30,15 @@
 // local
 #include "pjl_config.h"                 /* must go first */
 #include "options.h"                    /* for opt_eol */
+#include "probe.h"                      /* for PROBE1() */
+#include "util.h"                       /* for unlikely() */
+#include "writer.h"                     /* for writer_printf() */
 
 /// @cond DOXYGEN_IGNORE
 
 // standard
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for SIZE_MAX */
 #include <stdio.h>                      /* for FILE */
 
 /// @endcond
@@ -48,16 +52,34 @@ _GL_INLINE_HEADER_BEGIN
 
 #define CONF_FILE_NAME_DEFAULT    "." PACKAGE "rc"
 #define EOS_SPACES_DEFAULT        2     /* # spaces after end-of-sentence */
-#define LINE_BUF_SIZE             8192  /* hopefully, no one will exceed this */
+#define FOLLOW_MS_DEFAULT         200   /* idle ms before --follow flushes */
+#define LINE_BUF_SIZE             8192  /* initial line buffer capacity */
+#define LINE_CHUNK_SIZE_MAX       (1024 * 1024) /* read long lines in chunks */
 #define LINE_WIDTH_DEFAULT        80    /* wrap text to this line width */
 #define LINE_WIDTH_MINIMUM        1
+#define LINE_WIDTH_AUTO           SIZE_MAX /* --width=auto: estimate it */
 #define NEWLINES_DELIMIT_DEFAULT  2     /* # newlines that delimit a para */
+#define OPTIMAL_WORDS_DEFAULT     4096  /* # words kept to minimize ragged */
 #define TAB_SPACES_DEFAULT        8     /* number of spaces a tab equals */
+#define WIDTHS_MAX                16    /* max # of widths for --widths */
 
 /**
- * Line buffer.
+ * Growable line buffer.
+ *
+ * @remarks A line buffer is reused for every line read into it and its
+ * capacity is doubled only when a line doesn't fit, so there is neither a
+ * per-line allocation nor a maximum line length.
+ *
+ * @sa line_buf_cleanup()
+ * @sa line_buf_init()
+ * @sa line_buf_reserve()
  */
-typedef char line_buf_t[ LINE_BUF_SIZE ];
+struct line_buf {
+  char   *str;                          ///< Null-terminated line.
+  size_t  len;                          ///< Length of \a str when read.
+  size_t  cap;                          ///< Capacity of \a str.
+};
+typedef struct line_buf line_buf_t;
 
 ////////// Interprocess Communication (IPC) ///////////////////////////////////
 
@@ -104,6 +126,14 @@ typedef char line_buf_t[ LINE_BUF_SIZE ];
  */
 #define ASCII_SOH                 '\x01'
 
+/**
+ * From Wikipedia: The synchronous idle (SYN) character is used by a
+ * synchronous transmission system in the absence of any other character
+ * (idle condition) to provide a signal from which synchronism may be achieved
+ * or retained between data terminal equipment.
+ */
+#define ASCII_SYN                 '\x16'
+
 /**
  * Character used to separate parameters in an Interprocess Communication (IPC)
  * message.
@@ -111,35 +141,38 @@ typedef char line_buf_t[ LINE_BUF_SIZE ];
 #define WIPC_PARAM_SEP            "|"
 
 /**
- * Sends a no-argument Interprocess Communication (IPC) message.
+ * Sends a no-argument Interprocess Communication (IPC) message in-band.
  *
- * @param STREAM The `FILE` to send to.
+ * @param W The \ref writer to send via.
  * @param CODE The \ref wipc_code.
  *
  * @sa #WIPC_SENDF()
  */
-#define WIPC_SEND(STREAM,CODE)    WIPC_SENDF( STREAM, CODE, "%c", '\n' )
+#define WIPC_SEND(W,CODE)         WIPC_SENDF( W, CODE, "%c", '\n' )
 
 /**
- * Formats and sends an Interprocess Communication (IPC) message.
+ * Formats and sends an Interprocess Communication (IPC) message in-band.
  *
- * @param STREAM The `FILE` to send to.
+ * @param W The \ref writer to send via.
  * @param CODE The \ref wipc_code.
  * @param FORMAT The `printf()` format string literal to use.
  * @param ... The `printf()` arguments.
  *
  * @sa #WIPC_SEND()
  */
-#define WIPC_SENDF(STREAM,CODE,FORMAT,...) \
-  FPRINTF( (STREAM), ("%c%c" FORMAT), WIPC_CODE_HELLO, (CODE), __VA_ARGS__ )
+#define WIPC_SENDF(W,CODE,FORMAT,...) BLOCK(                        \
+  PROBE1( ipc_send, (CODE) );                                           \
+  writer_printf( (W), ("%c%c" FORMAT), WIPC_CODE_HELLO, (CODE), __VA_ARGS__ ); )
 
 /**
  * Interprocess Communication (IPC) command codes.
  *
  * @remarks **wrap**(1) and **wrapc**(1) communicate using stdin and stdout via
  * Unix pipes.  To distinguish an IPC message from ordinary text, all IPC
- * messages start "in-band" with a character unlikely to appear otherwise:
- * #ASCII_DLE via #WIPC_CODE_HELLO.
+ * messages start "in-band" at the start of a line with a character unlikely
+ * to appear otherwise: #ASCII_DLE via #WIPC_CODE_HELLO.  Alternatively, they
+ * can be sent "out-of-band" through pipes of their own as binary frames (see
+ * \ref wipc-group) so the text is never checked for them at all.
  */
 enum wipc_code {
   /**
@@ -180,6 +213,12 @@ enum wipc_code {
    * wrapping normally.
    */
   WIPC_CODE_PREFORMATTED_END      = ASCII_DC1,
+
+  /**
+   * IPC code, used only out-of-band, to signal that every message that
+   * applies before a given offset into the text has been sent.
+   */
+  WIPC_CODE_SYNC                  = ASCII_SYN,
   
   /**
    * IPC code to signal the end of the block of text to be wrapped.  Any text
@@ -208,21 +247,86 @@ size_t char_width( char c, size_t width ) {
 }
 
 /**
- * Reads a newline-terminated line from \a ffrom.
+ * Reads a newline-terminated line from \a ffrom in its entirety growing \a line
+ * as necessary.
  * If reading fails, prints an error message and exits.
  *
- * @param line The line buffer to read into.
+ * @param line The line buffer to read into; its \ref line_buf::len is set so
+ * the line need never be scanned for its end.  At least #SIMD_SPAN_PAD
+ * characters past the terminating null are guaranteed to be readable.
  * @param ffrom The `FILE` to read from.
+ * @param size_max The maximum number of characters to read.  If the line is
+ * longer, only this many are read and the rest is read by subsequent calls.
  * @return Returns the number of characters read.
  */
 NODISCARD
-size_t check_readline( line_buf_t line, FILE *ffrom );
+size_t check_readline( line_buf_t *line, FILE *ffrom, size_t size_max );
 
 /**
  * Cleans up all data and closes files.
  */
 void common_cleanup( void );
 
+/**
+ * Frees the memory used by \a buf.
+ *
+ * @param buf The \ref line_buf to clean up.
+ *
+ * @sa line_buf_init()
+ */
+void line_buf_cleanup( line_buf_t *buf );
+
+/**
+ * Grows \a buf so that it can hold at least \a len characters plus a
+ * terminating null.
+ *
+ * @param buf The \ref line_buf to grow.
+ * @param len The length required.
+ *
+ * @sa line_buf_reserve()
+ */
+void line_buf_grow( line_buf_t *buf, size_t len );
+
+/**
+ * Initializes \a buf to an empty string having a capacity of #LINE_BUF_SIZE.
+ *
+ * @param buf The \ref line_buf to initialize.
+ *
+ * @sa line_buf_cleanup()
+ */
+void line_buf_init( line_buf_t *buf );
+
+/**
+ * Ensures \a buf can hold at least \a len characters plus a terminating null.
+ *
+ * @param buf The \ref line_buf to check.
+ * @param len The length required.
+ */
+W_COMMON_H_INLINE
+void line_buf_reserve( line_buf_t *buf, size_t len ) {
+  if ( unlikely( len >= buf->cap ) )
+    line_buf_grow( buf, len );
+}
+
+/**
+ * Expands the tabs in \a s to spaces up to the next tab-stop every
+ * \ref opt_tab_spaces columns.  The tabs are found via **memchr**(3) and only
+ * the column of the text just before each tab is computed.
+ *
+ * @param s The characters to expand the tabs of.  They need not be
+ * null-terminated.
+ * @param plen A pointer to the number of characters of \a s that's set to the
+ * number of expanded characters.
+ * @param pcol A pointer to the column \a s starts at that's set to the column
+ * it ends at.  Newlines reset it to 0.
+ * @param buf The \ref line_buf to expand into, if there are any tabs.
+ * @return Returns \a s if it has no tabs or \a buf's null-terminated string
+ * otherwise.
+ */
+NODISCARD
+char const* tabs_expand( char const *s, size_t *plen, size_t *pcol,
+                         line_buf_t *buf );
+
 /**
  * Gets the end-of-line string to use.
  *
@@ -0,0 +1,572 @@
+/*
+**      wrap -- text reformatter
+**      src/conf_cache.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for reading and writing a compiled cache of the aliases
+ * and patterns parsed from a **wrap**(1) configuration file.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "conf_cache.h"
+#include "alias.h"
+#include "common.h"
+#include "pattern.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <fcntl.h>                      /* for open(2) */
+#include <limits.h>                     /* for PATH_MAX */
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t, uint64_t */
+#include <stdio.h>                      /* for rename(2), snprintf(3) */
+#include <stdlib.h>                     /* for mkstemp(3) */
+#include <string.h>
+#include <sys/stat.h>                   /* for fstat(2) */
+#include <unistd.h>                     /* for close(2), read(2), unlink(2) */
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+# include <sys/mman.h>                  /* for mmap(2) */
+# define WITH_CONF_CACHE_MMAP 1
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+
+/// @endcond
+
+/**
+ * @addtogroup conf-cache-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Byte-order mark of a cache file: if it's anything else, the file was written
+ * on a machine of the other endianness and is treated as stale.
+ */
+#define CONF_CACHE_BOM            0x01020304u
+
+/**
+ * Magic number of a cache file.
+ */
+#define CONF_CACHE_MAGIC          "WRAPCONF"
+
+/**
+ * Version of the format of cache files.
+ */
+#define CONF_CACHE_VERSION        2u
+
+/**
+ * The header of a cache file.  It's followed by:
+ *
+ *  1. \a n_sources \ref conf_cache_source structures, the configuration file
+ *     itself first, then every file it included;
+ *  2. \a n_aliases \ref conf_cache_alias structures;
+ *  3. \a n_args string offsets of the arguments of all aliases, each alias's
+ *     name first;
+ *  4. \a n_patterns \ref conf_cache_pattern structures; and
+ *  5. \a strings_len bytes of null-terminated strings, the first of which is
+ *     the path of the configuration file.
+ *
+ * All integers are in the byte order of the machine that wrote the file so the
+ * file can be used as-is once memory-mapped.
+ */
+struct conf_cache_header {
+  char      magic[8];                   ///< #CONF_CACHE_MAGIC (no null).
+  uint32_t  bom;                        ///< #CONF_CACHE_BOM.
+  uint32_t  version;                    ///< #CONF_CACHE_VERSION.
+  uint32_t  n_sources;                  ///< Number of files parsed.
+  uint32_t  n_aliases;                  ///< Number of aliases.
+  uint32_t  n_args;                     ///< Number of arguments of all aliases.
+  uint32_t  n_patterns;                 ///< Number of patterns.
+  uint32_t  strings_len;                ///< Number of bytes of strings.
+  uint32_t  reserved;                   ///< Pads to a multiple of 8 bytes.
+};
+typedef struct conf_cache_header conf_cache_header_t;
+
+/**
+ * A file that was parsed, i.e., the key the cache is current for.
+ */
+struct conf_cache_source {
+  uint64_t  dev;                        ///< Device of file.
+  uint64_t  ino;                        ///< I-node of file.
+  uint64_t  size;                       ///< Size of file.
+  uint64_t  mtime_sec;                  ///< Modification time (seconds).
+  uint64_t  mtime_nsec;                 ///< Modification time (nanoseconds).
+  uint64_t  ctime_sec;                  ///< Status change time (seconds).
+  uint64_t  ctime_nsec;                 ///< Status change time (nanoseconds).
+  uint32_t  path;                       ///< String offset of path.
+  uint32_t  reserved;                   ///< Pads to a multiple of 8 bytes.
+};
+typedef struct conf_cache_source conf_cache_source_t;
+
+/**
+ * An alias in a cache file.
+ */
+struct conf_cache_alias {
+  uint32_t  argc;                       ///< Number of arguments + 1.
+  uint32_t  line_no;                    ///< Line in conf. file defined on.
+};
+typedef struct conf_cache_alias conf_cache_alias_t;
+
+/**
+ * A pattern in a cache file.
+ */
+struct conf_cache_pattern {
+  uint32_t  pattern;                    ///< String offset of pattern.
+  uint32_t  alias;                      ///< Index of alias.
+};
+typedef struct conf_cache_pattern conf_cache_pattern_t;
+
+static_assert(
+  sizeof( conf_cache_header_t ) == 40, "conf_cache_header_t must be packed"
+);
+static_assert(
+  sizeof( conf_cache_source_t ) == 64, "conf_cache_source_t must be packed"
+);
+
+// local variable definitions
+static alias_t     *cache_aliases;      ///< Aliases set from the cache.
+static char const **cache_argv;         ///< Arguments of \ref cache_aliases.
+static char        *cache_image;        ///< Cache file's contents.
+static size_t       cache_mem;          ///< Heap bytes of the `cache_` lists.
+static bool         cache_image_mapped; ///< Is \ref cache_image mmap'd?
+static size_t       cache_image_size;   ///< Size of \ref cache_image.
+static pattern_t   *cache_patterns;     ///< Patterns set from the cache.
+
+// local functions
+static void         conf_cache_cleanup( void );
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the nanoseconds part of a time from a `struct stat`.
+ *
+ * @param st The `struct stat` to use.
+ * @param is_ctime If `true`, gets that of the status change time; if `false`,
+ * of the modification time.
+ * @return Returns said nanoseconds or 0 if unavailable.
+ */
+NODISCARD
+static inline uint64_t stat_nsec( struct stat const *st, bool is_ctime ) {
+#if HAVE_STRUCT_STAT_ST_MTIM
+  return STATIC_CAST( uint64_t,
+    is_ctime ? st->st_ctim.tv_nsec : st->st_mtim.tv_nsec
+  );
+#else
+  (void)st;
+  (void)is_ctime;
+  return 0;
+#endif /* HAVE_STRUCT_STAT_ST_MTIM */
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Cleans-up all cache data.
+ */
+static void conf_cache_cleanup( void ) {
+  FREE( cache_aliases );
+  FREE( cache_argv );
+  FREE( cache_patterns );
+  cache_mem = 0;
+#ifdef WITH_CONF_CACHE_MMAP
+  if ( cache_image_mapped )
+    PJL_DISCARD_RV( munmap( cache_image, cache_image_size ) );
+  else
+#endif /* WITH_CONF_CACHE_MMAP */
+    FREE( cache_image );
+  cache_image = NULL;
+  cache_image_mapped = false;
+  cache_image_size = 0;
+}
+
+/**
+ * Gets the full path of the cache file for \a conf_file.  The file's name is
+ * the 64-bit FNV-1a hash of \a conf_file in hexadecimal; since two paths can
+ * hash the same, the path is also stored in the file and checked.
+ *
+ * @param conf_file The full path of the configuration file.
+ * @param path_buf The buffer to receive the path.  It must be at least
+ * `PATH_MAX` bytes.
+ * @param make_dir If `true`, also creates the cache directory if necessary.
+ * @return Returns `true` only if the path was obtained (and, if \a make_dir,
+ * the cache directory exists).
+ */
+NODISCARD
+static bool conf_cache_path( char const *conf_file, char *path_buf,
+                             bool make_dir ) {
+  assert( conf_file != NULL );
+
+  uint64_t hash = 0xCBF29CE484222325u;
+  for ( char const *s = conf_file; *s != '\0'; ++s ) {
+    hash ^= STATIC_CAST( unsigned char, *s );
+    hash *= 0x100000001B3u;
+  } // for
+
+  char name[ sizeof "conf-" + 16 ];
+  snprintf(
+    name, sizeof name, "conf-%016llx", STATIC_CAST( unsigned long long, hash )
+  );
+  return cache_path( name, path_buf, make_dir );
+}
+
+/**
+ * Fills in the key fields of \a source from \a st.
+ *
+ * @param source The source to fill in.
+ * @param st The status of the file.
+ */
+static void conf_cache_key( conf_cache_source_t *source,
+                            struct stat const *st ) {
+  assert( source != NULL );
+  assert( st != NULL );
+  source->dev        = STATIC_CAST( uint64_t, st->st_dev );
+  source->ino        = STATIC_CAST( uint64_t, st->st_ino );
+  source->size       = STATIC_CAST( uint64_t, st->st_size );
+  source->mtime_sec  = STATIC_CAST( uint64_t, st->st_mtime );
+  source->mtime_nsec = stat_nsec( st, /*is_ctime=*/false );
+  source->ctime_sec  = STATIC_CAST( uint64_t, st->st_ctime );
+  source->ctime_nsec = stat_nsec( st, /*is_ctime=*/true );
+}
+
+/**
+ * Checks whether the key fields of \a source match \a st.
+ *
+ * @param source The source to check.
+ * @param st The current status of the file.
+ * @return Returns `true` only if the file hasn't changed.
+ */
+NODISCARD
+static bool conf_cache_key_eq( conf_cache_source_t const *source,
+                               struct stat const *st ) {
+  conf_cache_source_t key;
+  conf_cache_key( &key, st );
+  return  source->dev        == key.dev        &&
+          source->ino        == key.ino        &&
+          source->size       == key.size       &&
+          source->mtime_sec  == key.mtime_sec  &&
+          source->mtime_nsec == key.mtime_nsec &&
+          source->ctime_sec  == key.ctime_sec  &&
+          source->ctime_nsec == key.ctime_nsec;
+}
+
+/**
+ * Checks whether the cache \a image is current for and consistent with \a
+ * conf_file and every file it included and, if so, sets the aliases and
+ * patterns from it.
+ *
+ * @param image The cache file's contents.
+ * @param size The size of \a image.
+ * @param conf_file The full path of the configuration file.
+ * @param conf_st The status of \a conf_file.
+ * @return Returns `true` only if the aliases and patterns were set.
+ */
+NODISCARD
+static bool conf_cache_load( char const *image, size_t size,
+                             char const *conf_file,
+                             struct stat const *conf_st ) {
+  assert( image != NULL );
+  assert( conf_file != NULL );
+  assert( conf_st != NULL );
+
+  conf_cache_header_t const *const header =
+    POINTER_CAST( conf_cache_header_t const*, image );
+  if ( header->bom != CONF_CACHE_BOM ||
+       header->version != CONF_CACHE_VERSION ||
+       header->n_sources == 0 ) {
+    return false;
+  }
+
+  uint64_t const sources_off = sizeof( conf_cache_header_t );
+  uint64_t const aliases_off = sources_off +
+    STATIC_CAST( uint64_t, header->n_sources ) * sizeof( conf_cache_source_t );
+  if ( aliases_off > size )
+    return false;
+  conf_cache_source_t const *const c_sources =
+    POINTER_CAST( conf_cache_source_t const*, image + sources_off );
+  if ( c_sources[0].path != 0 || !conf_cache_key_eq( &c_sources[0], conf_st ) )
+    return false;
+
+  uint64_t const args_off = aliases_off +
+    STATIC_CAST( uint64_t, header->n_aliases ) * sizeof( conf_cache_alias_t );
+  uint64_t const patterns_off = args_off +
+    STATIC_CAST( uint64_t, header->n_args ) * sizeof( uint32_t );
+  uint64_t const strings_off = patterns_off +
+    STATIC_CAST( uint64_t, header->n_patterns ) *
+    sizeof( conf_cache_pattern_t );
+  uint32_t const strings_len = header->strings_len;
+  if ( strings_off + strings_len != size || strings_len == 0 )
+    return false;
+
+  char const *const strings = image + strings_off;
+  if ( strings[ strings_len - 1 ] != '\0' ||
+       strcmp( strings, conf_file ) != 0 ) {
+    return false;
+  }
+
+  //
+  // The configuration file itself is unchanged, but any file it included may
+  // have been.
+  //
+  for ( uint32_t i = 1; i < header->n_sources; ++i ) {
+    struct stat st;
+    if ( c_sources[i].path >= strings_len ||
+         stat( strings + c_sources[i].path, &st ) == -1 ||
+         !conf_cache_key_eq( &c_sources[i], &st ) ) {
+      return false;
+    }
+  } // for
+
+  conf_cache_alias_t const *const c_aliases =
+    POINTER_CAST( conf_cache_alias_t const*, image + aliases_off );
+  uint32_t const *const c_args =
+    POINTER_CAST( uint32_t const*, image + args_off );
+  conf_cache_pattern_t const *const c_patterns =
+    POINTER_CAST( conf_cache_pattern_t const*, image + patterns_off );
+
+  //
+  // Validate everything first so nothing need be undone.
+  //
+  uint64_t n_args = 0;
+  for ( uint32_t i = 0; i < header->n_aliases; ++i ) {
+    if ( c_aliases[i].argc == 0 || c_aliases[i].argc > INT_MAX )
+      return false;
+    n_args += c_aliases[i].argc;
+  } // for
+  if ( n_args != header->n_args )
+    return false;
+  for ( uint32_t i = 0; i < header->n_args; ++i )
+    if ( c_args[i] >= strings_len )
+      return false;
+  for ( uint32_t i = 0; i < header->n_patterns; ++i ) {
+    if ( c_patterns[i].pattern >= strings_len ||
+         c_patterns[i].alias >= header->n_aliases ) {
+      return false;
+    }
+  } // for
+
+  //
+  // Each alias's argv needs a trailing NULL, hence the extra n_aliases.
+  //
+  if ( header->n_aliases > 0 ) {
+    cache_aliases = MALLOC( alias_t, header->n_aliases );
+    cache_argv = MALLOC( char const*, header->n_args + header->n_aliases );
+    cache_mem += header->n_aliases * sizeof( alias_t ) +
+      (header->n_args + header->n_aliases) * sizeof( char const* );
+  }
+  char const **argv = cache_argv;
+  uint32_t const *arg = c_args;
+  for ( uint32_t i = 0; i < header->n_aliases; ++i ) {
+    alias_t *const alias = &cache_aliases[i];
+    alias->argc = STATIC_CAST( int, c_aliases[i].argc );
+    alias->argv = argv;
+    alias->line_no = c_aliases[i].line_no;
+    for ( uint32_t j = 0; j < c_aliases[i].argc; ++j )
+      *argv++ = strings + *arg++;
+    *argv++ = NULL;
+  } // for
+
+  if ( header->n_patterns > 0 ) {
+    cache_patterns = MALLOC( pattern_t, header->n_patterns );
+    cache_mem += header->n_patterns * sizeof( pattern_t );
+  }
+  for ( uint32_t i = 0; i < header->n_patterns; ++i ) {
+    cache_patterns[i].pattern = strings + c_patterns[i].pattern;
+    cache_patterns[i].alias = &cache_aliases[ c_patterns[i].alias ];
+  } // for
+
+  alias_set_list( cache_aliases, header->n_aliases );
+  pattern_set_list( cache_patterns, header->n_patterns );
+  return true;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+size_t conf_cache_mem( void ) {
+  return cache_mem + (cache_image_mapped ? 0 : cache_image_size);
+}
+
+bool conf_cache_read( char const *conf_file, struct stat const *conf_st ) {
+  assert( conf_file != NULL );
+  assert( conf_st != NULL );
+
+  char path_buf[ PATH_MAX ];
+  if ( !conf_cache_path( conf_file, path_buf, /*make_dir=*/false ) )
+    return false;
+  int const fd = open( path_buf, O_RDONLY );
+  if ( fd == -1 )
+    return false;
+
+  struct stat st;
+  if ( fstat( fd, &st ) == -1 ||
+       STATIC_CAST( size_t, st.st_size ) < sizeof( conf_cache_header_t ) ) {
+    close( fd );
+    return false;
+  }
+  size_t const size = STATIC_CAST( size_t, st.st_size );
+
+  RUN_ONCE ATEXIT( &conf_cache_cleanup );
+
+#ifdef WITH_CONF_CACHE_MMAP
+  void *const map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  if ( map != MAP_FAILED ) {
+    cache_image = map;
+    cache_image_mapped = true;
+  }
+#endif /* WITH_CONF_CACHE_MMAP */
+  if ( cache_image == NULL ) {
+    cache_image = MALLOC( char, size );
+    for ( size_t n = 0; n < size; ) {
+      ssize_t const bytes_read = read( fd, cache_image + n, size - n );
+      if ( bytes_read <= 0 ) {
+        close( fd );
+        conf_cache_cleanup();
+        return false;
+      }
+      n += STATIC_CAST( size_t, bytes_read );
+    } // for
+  }
+  cache_image_size = size;
+  close( fd );
+
+  if ( memcmp( cache_image, CONF_CACHE_MAGIC, 8 ) != 0 ||
+       !conf_cache_load( cache_image, size, conf_file, conf_st ) ) {
+    conf_cache_cleanup();
+    return false;
+  }
+  return true;
+}
+
+void conf_cache_write( conf_source_t const sources[], size_t n_sources ) {
+  assert( sources != NULL );
+  assert( n_sources > 0 );
+  char const *const conf_file = sources[0].path;
+
+  size_t n_aliases, n_patterns;
+  alias_t const *const aliases = alias_list( &n_aliases );
+  pattern_t const *const patterns = pattern_list( &n_patterns );
+
+  size_t n_args = 0;
+  size_t strings_len = 0;
+  for ( size_t i = 0; i < n_sources; ++i )
+    strings_len += strlen( sources[i].path ) + 1;
+  for ( size_t i = 0; i < n_aliases; ++i ) {
+    n_args += STATIC_CAST( size_t, aliases[i].argc );
+    for ( int j = 0; j < aliases[i].argc; ++j )
+      strings_len += strlen( aliases[i].argv[j] ) + 1;
+  } // for
+  for ( size_t i = 0; i < n_patterns; ++i )
+    strings_len += strlen( patterns[i].pattern ) + 1;
+
+  size_t const aliases_off =
+    sizeof( conf_cache_header_t ) + n_sources * sizeof( conf_cache_source_t );
+  size_t const args_off =
+    aliases_off + n_aliases * sizeof( conf_cache_alias_t );
+  size_t const patterns_off = args_off + n_args * sizeof( uint32_t );
+  size_t const strings_off =
+    patterns_off + n_patterns * sizeof( conf_cache_pattern_t );
+  size_t const size = strings_off + strings_len;
+  if ( size > UINT32_MAX )
+    return;
+
+  char *const image = MALLOC( char, size );
+  conf_cache_header_t *const header =
+    POINTER_CAST( conf_cache_header_t*, image );
+  MEM_ZERO( header );
+  memcpy( header->magic, CONF_CACHE_MAGIC, sizeof header->magic );
+  header->bom = CONF_CACHE_BOM;
+  header->version = CONF_CACHE_VERSION;
+  header->n_sources = STATIC_CAST( uint32_t, n_sources );
+  header->n_aliases = STATIC_CAST( uint32_t, n_aliases );
+  header->n_args = STATIC_CAST( uint32_t, n_args );
+  header->n_patterns = STATIC_CAST( uint32_t, n_patterns );
+  header->strings_len = STATIC_CAST( uint32_t, strings_len );
+
+  conf_cache_source_t *const c_sources = POINTER_CAST(
+    conf_cache_source_t*, image + sizeof( conf_cache_header_t )
+  );
+  conf_cache_alias_t *const c_aliases =
+    POINTER_CAST( conf_cache_alias_t*, image + aliases_off );
+  uint32_t *c_arg = POINTER_CAST( uint32_t*, image + args_off );
+  conf_cache_pattern_t *const c_patterns =
+    POINTER_CAST( conf_cache_pattern_t*, image + patterns_off );
+  char *const strings = image + strings_off;
+  uint32_t string_off = 0;
+
+  for ( size_t i = 0; i < n_sources; ++i ) {
+    MEM_ZERO( &c_sources[i] );
+    conf_cache_key( &c_sources[i], &sources[i].st );
+    c_sources[i].path = string_off;
+    string_off += STATIC_CAST( uint32_t,
+      strcpy_len( strings + string_off, sources[i].path ) + 1
+    );
+  } // for
+
+  for ( size_t i = 0; i < n_aliases; ++i ) {
+    c_aliases[i].argc = STATIC_CAST( uint32_t, aliases[i].argc );
+    c_aliases[i].line_no = aliases[i].line_no;
+    for ( int j = 0; j < aliases[i].argc; ++j ) {
+      *c_arg++ = string_off;
+      string_off += STATIC_CAST( uint32_t,
+        strcpy_len( strings + string_off, aliases[i].argv[j] ) + 1
+      );
+    } // for
+  } // for
+  for ( size_t i = 0; i < n_patterns; ++i ) {
+    c_patterns[i].pattern = string_off;
+    c_patterns[i].alias = STATIC_CAST( uint32_t, patterns[i].alias - aliases );
+    string_off += STATIC_CAST( uint32_t,
+      strcpy_len( strings + string_off, patterns[i].pattern ) + 1
+    );
+  } // for
+  assert( string_off == strings_len );
+
+  //
+  // Write to a temporary file and rename it so a concurrent reader never sees
+  // a partial cache file.
+  //
+  char path_buf[ PATH_MAX ];
+  char temp_buf[ PATH_MAX ];
+  if ( !conf_cache_path( conf_file, path_buf, /*make_dir=*/true ) )
+    goto done;
+  int const len = snprintf( temp_buf, sizeof temp_buf, "%s.XXXXXX", path_buf );
+  if ( len < 0 || STATIC_CAST( size_t, len ) >= sizeof temp_buf )
+    goto done;
+  int const fd = mkstemp( temp_buf );
+  if ( fd == -1 )
+    goto done;
+  bool const ok = fd_write( fd, image, size ) == 0;
+  if ( close( fd ) == -1 || !ok || rename( temp_buf, path_buf ) == -1 )
+    PJL_DISCARD_RV( unlink( temp_buf ) );
+
+done:
+  free( image );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
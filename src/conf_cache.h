@@ -0,0 +1,111 @@
+/*
+**      wrap -- text reformatter
+**      src/conf_cache.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_conf_cache_H
+#define wrap_conf_cache_H
+
+/**
+ * @file
+ * Declares functions for reading and writing a compiled cache of the aliases
+ * and patterns parsed from a **wrap**(1) configuration file.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <sys/stat.h>                   /* for struct stat */
+
+/// @endcond
+
+/**
+ * @ingroup config-file-group
+ * @defgroup conf-cache-group Configuration File Cache
+ * Functions for a compiled cache of the aliases and patterns parsed from a
+ * configuration file so that, unless the file has changed since, they can be
+ * memory-mapped rather than parsed from text again.
+ *
+ * @remarks The cache for a configuration file is in the `wrap` subdirectory
+ * of either `$XDG_CACHE_HOME` or `$HOME/.cache` and is keyed on the file's
+ * path and on the device, i-node, size, and modification and status change
+ * times of it and every file it includes (directly or indirectly).  It's
+ * only an optimization: if it can't be read, is stale, or is corrupt, the
+ * configuration file is parsed as usual; if it can't be written, it's silently
+ * not.
+ * @{
+ */
+
+/**
+ * A configuration file that contributed to the aliases and patterns: either
+ * the one read or one it included (directly or indirectly).
+ */
+struct conf_source {
+  char const   *path;                   ///< Path of the file.
+  struct stat   st;                     ///< Status from just before parsing.
+};
+typedef struct conf_source conf_source_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the number of bytes of heap memory used by the aliases and patterns
+ * set from the cache, including the cache file's contents unless it was
+ * memory-mapped.
+ *
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t conf_cache_mem( void );
+
+/**
+ * Reads the compiled cache of \a conf_file, if any, and, if it's current for
+ * it and every file it included when the cache was written, sets the aliases
+ * and patterns from it.
+ *
+ * @param conf_file The full path of the configuration file.
+ * @param conf_st The status of \a conf_file.
+ * @return Returns `true` only if the aliases and patterns were set.
+ *
+ * @sa conf_cache_write()
+ */
+NODISCARD
+bool conf_cache_read( char const *conf_file, struct stat const *conf_st );
+
+/**
+ * Writes the compiled cache of the aliases and patterns just parsed from a
+ * configuration file and the files it included.
+ *
+ * @param sources The files parsed, the configuration file itself first.
+ * @param n_sources The number of \a sources; must be at least 1.
+ *
+ * @sa conf_cache_read()
+ */
+void conf_cache_write( conf_source_t const sources[], size_t n_sources );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_conf_cache_H */
+/* vim:set et sw=2 ts=2: */
@@ -33,6 +33,7 @@
 
 // standard
 #include <assert.h>
+#include <stdint.h>
 
 #define DOX_INIT_INLINE            DOX_INLINE
 #define DOX_INIT_BOL               DOX_BOL
@@ -52,6 +53,15 @@
  */
 #define DOX_CMD_CHARS             "abcdefghijklmnopqrstuvwxyz()[]{}"
 
+/// Number of bits of a hash for \ref dox_cmd_table.
+#define DOX_CMD_HASH_BITS         10
+
+/**
+ * Seed for dox_cmd_hash() chosen so that no two commands of \ref DOX_COMMANDS
+ * hash to the same entry of \ref dox_cmd_table.
+ */
+#define DOX_CMD_HASH_SEED         137560400u
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -281,32 +291,130 @@ static dox_cmd_t const DOX_COMMANDS[] = {
   { "}",                      DOX_INIT_EOL,     NULL },
 };
 
+static_assert(
+  ARRAY_SIZE( DOX_COMMANDS ) < 256, "dox_cmd_table needs more than 8 bits"
+);
+
+// local variable definitions
+
+/**
+ * Perfect hash table of all Doxygen commands: each entry is either 0 for none
+ * or one more than the index into \ref DOX_COMMANDS of the command.
+ */
+static uint8_t dox_cmd_table[ 1u << DOX_CMD_HASH_BITS ];
+
+// local functions
+NODISCARD
+static unsigned dox_cmd_hash( char const* );
+
+NODISCARD
+static size_t   dox_cmd_name_len( char const* );
+
+static void     dox_cmd_table_init( void );
+
+NODISCARD
+static bool     dox_is_end_cmd( dox_cmd_t const*, char const* );
+
 ////////// local functions ////////////////////////////////////////////////////
 
 /**
- * Comparison function for **bsearch**(3) that compares a string key against an
- * element of array of dox_cmd_t.
+ * Hashes the name of a Doxygen command.
+ *
+ * @param s The null-terminated name to hash.
+ * @return Returns an index into \ref dox_cmd_table.
  *
- * @param key A pointer to the string being searched for.
- * @param elt A pointer to the current element to compare against.
- * @return Returns an integer less than zero, zero, or greater thatn zero if
- * the key is less than, equal to, or greater than the element's name,
- * respectively.
+ * @sa [FNV Hash](http://www.isthe.com/chongo/tech/comp/fnv/)
  */
 NODISCARD
-static int dox_cmd_cmp( dox_cmd_t const *i_dox, dox_cmd_t const *j_dox ) {
-  return strcmp( i_dox->name, j_dox->name );
+static unsigned dox_cmd_hash( char const *s ) {
+  assert( s != NULL );
+  uint32_t h = DOX_CMD_HASH_SEED;
+  while ( *s != '\0' )
+    h = (h ^ STATIC_CAST( unsigned char, *s++ )) * 16777619u;
+  return h >> (32 - DOX_CMD_HASH_BITS);
+}
+
+/**
+ * Gets the length of the name of the Doxygen command, if any, at \a s.
+ *
+ * @param s The string to check.  It must be terminated by either a newline or
+ * a null.
+ * @return Returns said length (that's never more than #DOX_CMD_NAME_SIZE_MAX)
+ * if \a s starts with a `\` or `@` followed by the characters of a command
+ * name; 0 otherwise.
+ */
+NODISCARD
+static size_t dox_cmd_name_len( char const *s ) {
+  assert( s != NULL );
+  if ( !(s[0] == '@' || s[0] == '\\') )
+    return 0;
+  size_t const len = strspn( s + 1, DOX_CMD_CHARS );
+  return len <= DOX_CMD_NAME_SIZE_MAX ? len : 0;
+}
+
+/**
+ * Initializes \ref dox_cmd_table.
+ */
+static void dox_cmd_table_init( void ) {
+  for ( size_t i = 0; i < ARRAY_SIZE( DOX_COMMANDS ); ++i ) {
+    uint8_t *const e = &dox_cmd_table[ dox_cmd_hash( DOX_COMMANDS[i].name ) ];
+    if ( *e != 0 ) {
+      INTERNAL_ERROR(
+        "Doxygen commands \"%s\" and \"%s\" hash to the same value;"
+        " change DOX_CMD_HASH_SEED\n",
+        DOX_COMMANDS[ *e - 1 ].name, DOX_COMMANDS[i].name
+      );
+    }
+    *e = STATIC_CAST( uint8_t, i + 1 );
+  } // for
+}
+
+/**
+ * Gets whether \a s starts with the end command of \a pre_cmd.
+ *
+ * @param pre_cmd The #DOX_PRE command to check for the end of.
+ * @param s The string to check.  It must be terminated by either a newline or
+ * a null.
+ * @return Returns `true` only if \a s starts with said end command.
+ */
+NODISCARD
+static bool dox_is_end_cmd( dox_cmd_t const *pre_cmd, char const *s ) {
+  assert( pre_cmd != NULL );
+  size_t const len = dox_cmd_name_len( s );
+  return  len > 0 && strncmp( s + 1, pre_cmd->end_name, len ) == 0 &&
+          pre_cmd->end_name[ len ] == '\0';
 }
 
 ////////// extern functions ///////////////////////////////////////////////////
 
 dox_cmd_t const* dox_find_cmd( char const *s ) {
-  dox_cmd_t const find_dox = { .name = s };
-  return bsearch(
-    &find_dox, DOX_COMMANDS,
-    ARRAY_SIZE( DOX_COMMANDS ), sizeof( DOX_COMMANDS[0] ),
-    POINTER_CAST( bsearch_cmp_fn_t, &dox_cmd_cmp )
-  );
+  assert( s != NULL );
+  dox_init();
+
+  unsigned const i = dox_cmd_table[ dox_cmd_hash( s ) ];
+  if ( i == 0 )
+    return NULL;
+  dox_cmd_t const *const dox_cmd = &DOX_COMMANDS[ i - 1 ];
+  return strcmp( s, dox_cmd->name ) == 0 ? dox_cmd : NULL;
+}
+
+void dox_init( void ) {
+  RUN_ONCE dox_cmd_table_init();
+}
+
+bool dox_is_pre_end( dox_parser_t const *parser, char const *line ) {
+  assert( parser != NULL );
+  assert( parser->pre_cmd != NULL );
+  assert( line != NULL );
+
+  SKIP_CHARS( line, WS_ST );
+  return dox_is_end_cmd( parser->pre_cmd, line );
+}
+
+dox_line_t dox_parse( dox_parser_t *parser, char const *line ) {
+  assert( line != NULL );
+  SKIP_CHARS( line, WS_ST );
+  return dox_parse_nws( parser, line );
 }
 
 bool dox_parse_cmd_name( char const *s, char *dox_cmd_name ) {
@@ -314,17 +422,51 @@ bool dox_parse_cmd_name( char const *s, char *dox_cmd_name ) {
   assert( dox_cmd_name != NULL );
 
   SKIP_CHARS( s, WS_ST );
-  if ( !(s[0] == '@' || s[0] == '\\') )
+  size_t const len = dox_cmd_name_len( s );
+  if ( len == 0 )
     return false;
+  strncpy( dox_cmd_name, s + 1, len );
+  dox_cmd_name[ len ] = '\0';
+  return true;
+}
+
+dox_line_t dox_parse_nws( dox_parser_t *parser, char const *nws ) {
+  assert( parser != NULL );
+  assert( nws != NULL );
 
-  size_t const len = strspn( ++s, DOX_CMD_CHARS );
-  if ( len > 0 && len <= DOX_CMD_NAME_SIZE_MAX ) {
-    strncpy( dox_cmd_name, s, len );
-    dox_cmd_name[ len ] = '\0';
-    return true;
+  if ( parser->pre_cmd != NULL ) {
+    if ( !dox_is_end_cmd( parser->pre_cmd, nws ) )
+      return DOX_LINE_PRE;
+    parser->pre_cmd = NULL;
+    return DOX_LINE_PRE_END;
   }
 
-  return false;
+  size_t const len = dox_cmd_name_len( nws );
+  if ( len == 0 )
+    return DOX_LINE_TEXT;
+  char dox_cmd_name[ DOX_CMD_NAME_SIZE_MAX + 1 ];
+  strncpy( dox_cmd_name, nws + 1, len );
+  dox_cmd_name[ len ] = '\0';
+
+  //
+  // A Doxygen command we know nothing about (or something that looks like a
+  // Doxygen command, e.g., "\t") is treated as ordinary text.
+  //
+  dox_cmd_t const *const dox_cmd = dox_find_cmd( dox_cmd_name );
+  if ( dox_cmd == NULL || (dox_cmd->type & DOX_BOL) == 0 )
+    return DOX_LINE_TEXT;
+  if ( (dox_cmd->type & DOX_EOL) != 0 )
+    return DOX_LINE_EOL;
+  if ( (dox_cmd->type & DOX_PRE) != 0 ) {
+    parser->pre_cmd = dox_cmd;
+    return DOX_LINE_PRE_BEGIN;
+  }
+  return DOX_LINE_BOL;
+}
+
+void dox_parser_init( dox_parser_t *parser ) {
+  assert( parser != NULL );
+  parser->pre_cmd = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -39,7 +39,6 @@
 /// @endcond
 
 /**
- * @ingroup wrapc-group
  * @defgroup doxygen-group Doxygen Support
  * Macros, data structures, and functions for reformatting
  * [Doxygen](http://www.doxygen.org/) within source code comments.
@@ -211,6 +210,46 @@ struct dox_cmd {
 };
 typedef struct dox_cmd dox_cmd_t;
 
+/**
+ * Doxygen line types, i.e., how a line is to be handled.
+ */
+enum dox_line {
+  /// Ordinary text, possibly starting with a #DOX_INLINE or unknown command:
+  /// wrapped normally.
+  DOX_LINE_TEXT,
+
+  /// Starts with a #DOX_BOL or #DOX_PAR command: the paragraph is delimited
+  /// before the line that's then wrapped normally.
+  DOX_LINE_BOL,
+
+  /// Starts with a #DOX_EOL command: the paragraph is delimited before the
+  /// line that's then kept verbatim.
+  DOX_LINE_EOL,
+
+  /// Starts with a #DOX_PRE command: like #DOX_LINE_BOL, but the lines after
+  /// it are preformatted.
+  DOX_LINE_PRE_BEGIN,
+
+  /// Preformatted text: kept verbatim.
+  DOX_LINE_PRE,
+
+  /// Starts with the end command of the previous #DOX_PRE command: kept
+  /// verbatim and ends the preformatted text.
+  DOX_LINE_PRE_END
+};
+typedef enum dox_line dox_line_t;
+
+/**
+ * Doxygen parser state that persists across calls to dox_parse().
+ *
+ * @sa dox_parser_init()
+ */
+struct dox_parser {
+  /// The #DOX_PRE command whose preformatted text is being parsed, if any.
+  dox_cmd_t const  *pre_cmd;
+};
+typedef struct dox_parser dox_parser_t;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -223,6 +262,30 @@ typedef struct dox_cmd dox_cmd_t;
 NODISCARD
 dox_cmd_t const* dox_find_cmd( char const *s );
 
+/**
+ * Initializes the table of Doxygen commands unless it has been already.
+ * dox_find_cmd() calls this itself, but a program that parses in several
+ * threads at once must call it first so the table is only ever read by them.
+ */
+void dox_init( void );
+
+/**
+ * Gets whether \a line, a line of the preformatted text of the #DOX_PRE command
+ * \a parser is parsing, ends it.
+ *
+ * @param parser The \ref dox_parser whose \ref dox_parser::pre_cmd "pre_cmd"
+ * isn't null.
+ * @param line The line to check that is terminated by either a newline or a
+ * null.  It need not be null-terminated so can be obtained via
+ * reader_getline().
+ * @return Returns `true` only if \a line starts with the end command of said
+ * #DOX_PRE command.
+ *
+ * @sa dox_parse()
+ */
+NODISCARD
+bool dox_is_pre_end( dox_parser_t const *parser, char const *line );
+
 /**
  * Attempts to parse a Doxygen command at the start of \a s.
  *
@@ -235,6 +298,39 @@ dox_cmd_t const* dox_find_cmd( char const *s );
 NODISCARD
 bool dox_parse_cmd_name( char const *s, char *dox_cmd_name );
 
+/**
+ * Classifies a line of text that may start with a Doxygen command.
+ *
+ * @param parser The \ref dox_parser previously initialized by
+ * dox_parser_init().
+ * @param line The null-terminated line to classify.
+ * @return Returns said line's type.
+ */
+NODISCARD
+dox_line_t dox_parse( dox_parser_t *parser, char const *line );
+
+/**
+ * Classifies a line of text that may start with a Doxygen command the same as
+ * dox_parse() except that the line's leading whitespace has already been
+ * skipped, e.g., by md_line_desc_init() when wrapping Markdown, so it isn't
+ * scanned again.
+ *
+ * @param parser The \ref dox_parser previously initialized by
+ * dox_parser_init().
+ * @param nws A pointer to just past the leading whitespace of the line to
+ * classify that's terminated by either a newline or a null.
+ * @return Returns said line's type.
+ */
+NODISCARD
+dox_line_t dox_parse_nws( dox_parser_t *parser, char const *nws );
+
+/**
+ * Initializes \a parser.
+ *
+ * @param parser The \ref dox_parser to initialize.
+ */
+void dox_parser_init( dox_parser_t *parser );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
@@ -0,0 +1,276 @@
+/*
+**      wrap -- text reformatter
+**      src/git.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for getting the files and lines changed in a **git**(1)
+ * working tree.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "git.h"
+#include "common.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdio.h>                      /* for fdopen(3), getline(3) */
+#include <stdlib.h>                     /* for exit(), strtoull(3) */
+#include <string.h>
+#include <sys/wait.h>                   /* for waitpid(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for execvp(3), fork(2) */
+
+/// @endcond
+
+/**
+ * @addtogroup git-group
+ * @{
+ */
+
+/**
+ * The arguments to **git**(1) before the revision.  The options make the
+ * output parseable regardless of the user's configuration: paths are quoted
+ * only when necessary, are relative to the current directory, and always have
+ * the `b/` prefix; only added or modified files are listed, without context.
+ */
+#define GIT_DIFF_ARGS                                           \
+  "git", "-c", "core.quotePath=false", "diff", "--no-color",    \
+  "--no-ext-diff", "--no-renames", "--no-textconv", "--relative", \
+  "--src-prefix=a/", "--dst-prefix=b/", "--diff-filter=AM", "-U0"
+
+// local variables
+static git_file_t  *git_files;          ///< Changed files.
+static size_t       git_files_len;      ///< Length of \ref git_files.
+static char const **git_paths;          ///< Paths of \ref git_files.
+
+// local functions
+static void         git_cleanup( void );
+
+NODISCARD
+static bool         git_hunk_parse( char const*, git_lines_t*, size_t* );
+
+NODISCARD
+static pid_t        git_spawn( char const*, char const *const[], size_t,
+                               int* );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Frees the files gotten by git_changed().
+ */
+static void git_cleanup( void ) {
+  for ( size_t i = 0; i < git_files_len; ++i ) {
+    FREE( git_files[i].path );
+    FREE( git_files[i].lines );
+  } // for
+  FREE( git_files );
+  FREE( git_paths );
+}
+
+/**
+ * Parses a hunk header line of a unified diff, e.g., `@@ -12,3 +12,4 @@`.
+ *
+ * @param line The hunk header line.
+ * @param lines A pointer to receive the range of new lines.  When lines were
+ * only deleted, the range is the lines just before and after them since their
+ * paragraph may need reformatting.
+ * @param pbody_len A pointer to receive the number of lines of the hunk's
+ * body, i.e., the number of old plus new lines.
+ * @return Returns `true` only if \a line is a valid hunk header line.
+ */
+NODISCARD
+static bool git_hunk_parse( char const *line, git_lines_t *lines,
+                            size_t *pbody_len ) {
+  assert( line != NULL );
+  assert( lines != NULL );
+  assert( pbody_len != NULL );
+
+  unsigned long long n[4];              // old first, count, new first, count
+  char const *s = line + 3;
+  for ( unsigned i = 0; i < 4; i += 2 ) {
+    if ( *s++ != "-+"[ i / 2 ] )
+      return false;
+    char *end;
+    n[i] = strtoull( s, &end, 10 );
+    if ( end == s )
+      return false;
+    n[i+1] = 1;
+    if ( *end == ',' )
+      n[i+1] = strtoull( end + 1, &end, 10 );
+    if ( *end++ != ' ' )
+      return false;
+    s = end;
+  } // for
+
+  if ( n[3] == 0 ) {
+    lines->first = n[2] > 0 ? STATIC_CAST( size_t, n[2] ) : 1;
+    lines->last = STATIC_CAST( size_t, n[2] + 1 );
+  } else {
+    lines->first = STATIC_CAST( size_t, n[2] );
+    lines->last = STATIC_CAST( size_t, n[2] + n[3] - 1 );
+  }
+  *pbody_len = STATIC_CAST( size_t, n[1] + n[3] );
+  return true;
+}
+
+/**
+ * Spawns `git diff` whose standard output is a pipe.
+ *
+ * @param rev The revision to diff against.
+ * @param pathspecs The pathspecs to limit the diff to.
+ * @param pathspecs_len The number of \a pathspecs.
+ * @param pfd A pointer to receive the file descriptor to read the diff from.
+ * @return Returns the process ID of **git**(1).
+ */
+NODISCARD
+static pid_t git_spawn( char const *rev, char const *const pathspecs[],
+                        size_t pathspecs_len, int *pfd ) {
+  assert( rev != NULL );
+  assert( pfd != NULL );
+
+  static char const *const DIFF_ARGS[] = { GIT_DIFF_ARGS };
+  size_t const argv_len = ARRAY_SIZE( DIFF_ARGS ) + 2/*rev --*/
+    + pathspecs_len + 1/*NULL*/;
+  char const **const argv = MALLOC( char const*, argv_len );
+  size_t argc = 0;
+  for ( size_t i = 0; i < ARRAY_SIZE( DIFF_ARGS ); ++i )
+    argv[ argc++ ] = DIFF_ARGS[i];
+  argv[ argc++ ] = rev;
+  argv[ argc++ ] = "--";
+  for ( size_t i = 0; i < pathspecs_len; ++i )
+    argv[ argc++ ] = pathspecs[i];
+  argv[ argc ] = NULL;
+
+  int fds[2];
+  PIPE( fds );
+  PERROR_EXIT_IF( fflush( stdout ) != 0, EX_IOERR );
+  pid_t const pid = fork();
+  PERROR_EXIT_IF( pid == -1, EX_OSERR );
+  if ( pid == 0 ) {                     // child
+    DUP2( fds[1], STDOUT_FILENO );
+    close( fds[0] );
+    close( fds[1] );
+    execvp( argv[0], CONST_CAST( char**, argv ) );
+    fatal_error( EX_UNAVAILABLE, "can't run git: %s\n", STRERROR() );
+  }
+
+  close( fds[1] );
+  FREE( argv );
+  *pfd = fds[0];
+  return pid;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+git_file_t const* git_changed( char const *rev,
+                               char const *const pathspecs[],
+                               size_t pathspecs_len,
+                               char const *const **ppaths,
+                               size_t *pfiles_len ) {
+  assert( rev != NULL );
+  assert( ppaths != NULL );
+  assert( pfiles_len != NULL );
+  ASSERT_RUN_ONCE();
+
+  int fd;
+  pid_t const pid = git_spawn( rev, pathspecs, pathspecs_len, &fd );
+  FILE *const fdiff = fdopen( fd, "r" );
+  PERROR_EXIT_IF( fdiff == NULL, EX_OSERR );
+  ATEXIT( git_cleanup );
+
+  size_t      body_len = 0;             // lines of the hunk's body left
+  size_t      files_cap = 0;
+  git_file_t *file = NULL;              // file whose hunks are being read
+  char       *line = NULL;
+  size_t      line_cap = 0;
+  size_t      lines_cap = 0;
+
+  for ( ssize_t line_len;
+        (line_len = getline( &line, &line_cap, fdiff )) != -1; ) {
+    if ( line_len > 0 && line[ line_len - 1 ] == '\n' )
+      line[ --line_len ] = '\0';
+
+    if ( body_len > 0 ) {               // skip the hunk's body
+      if ( line[0] != '\\' )            // "\ No newline at end of file"
+        --body_len;
+      continue;
+    }
+
+    if ( strncmp( line, "+++ ", 4 ) == 0 ) {
+      file = NULL;
+      if ( strncmp( line + 4, "b/", 2 ) != 0 ) {
+        if ( line[4] == '"' )
+          EPRINTF( "%s: %s: path needs quoting; skipped\n", me, line + 4 );
+        continue;
+      }
+      if ( git_files_len == files_cap ) {
+        files_cap = files_cap == 0 ? 16 : files_cap * 2;
+        REALLOC( git_files, git_file_t, files_cap );
+      }
+      file = &git_files[ git_files_len++ ];
+      *file = (git_file_t){ .path = check_strdup( line + 4 + 2 ) };
+      lines_cap = 0;
+      continue;
+    }
+
+    if ( file == NULL || strncmp( line, "@@ ", 3 ) != 0 )
+      continue;
+    git_lines_t lines;
+    if ( !git_hunk_parse( line, &lines, &body_len ) )
+      continue;
+    if ( file->lines_len == lines_cap ) {
+      lines_cap = lines_cap == 0 ? 8 : lines_cap * 2;
+      REALLOC( file->lines, git_lines_t, lines_cap );
+    }
+    file->lines[ file->lines_len++ ] = lines;
+  } // for
+
+  FERROR( fdiff );
+  free( line );
+  fclose( fdiff );
+
+  int wait_status;
+  while ( waitpid( pid, &wait_status, 0 ) == -1 )
+    PERROR_EXIT_IF( errno != EINTR, EX_OSERR );
+  if ( !WIFEXITED( wait_status ) || WEXITSTATUS( wait_status ) != 0 )
+    fatal_error( EX_UNAVAILABLE, "\"%s\": git diff failed\n", rev );
+
+  if ( git_files_len > 0 ) {
+    git_paths = MALLOC( char const*, git_files_len );
+    for ( size_t i = 0; i < git_files_len; ++i )
+      git_paths[i] = git_files[i].path;
+  }
+
+  *ppaths = git_paths;
+  *pfiles_len = git_files_len;
+  return git_files;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,96 @@
+/*
+**      wrap -- text reformatter
+**      src/git.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_git_H
+#define wrap_git_H
+
+/**
+ * @file
+ * Declares types and functions for getting the files and lines changed in a
+ * **git**(1) working tree.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup git-group Git Changes
+ * Types and functions for getting the files and lines changed in a **git**(1)
+ * working tree since a revision so that only they need be reformatted.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A range of changed lines.  Line numbers start at 1.
+ */
+struct git_lines {
+  size_t  first;                        ///< First changed line.
+  size_t  last;                         ///< Last changed line.
+};
+typedef struct git_lines git_lines_t;
+
+/**
+ * A changed file.
+ */
+struct git_file {
+  char const   *path;                   ///< Path relative to the current dir.
+  git_lines_t  *lines;                  ///< Changed lines in ascending order.
+  size_t        lines_len;              ///< Length of \ref lines.
+};
+typedef struct git_file git_file_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the text files in the current directory (or its subdirectories) that
+ * either were added or modified since \a rev and the lines changed in each by
+ * parsing the output of `git diff -U0`.  A file whose path **git**(1) would
+ * have to quote isn't included.
+ *
+ * @param rev The revision to get the changes since.
+ * @param pathspecs The **git**(1) pathspecs to limit the files to.
+ * @param pathspecs_len The number of \a pathspecs; if 0, all files.
+ * @param ppaths A pointer to receive the paths of the files in the same order
+ * as the files themselves.
+ * @param pfiles_len A pointer to receive the number of files.
+ * @return Returns said files or NULL if none.  If **git**(1) fails, exits.
+ */
+NODISCARD
+git_file_t const* git_changed( char const *rev,
+                               char const *const pathspecs[],
+                               size_t pathspecs_len,
+                               char const *const **ppaths,
+                               size_t *pfiles_len );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_git_H */
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,994 @@
+/*
+**      wrap -- text reformatter
+**      src/hyphenate.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for hyphenating words using Liang's algorithm and TeX
+ * hyphenation patterns.
+ *
+ * @sa Franklin Mark Liang. [Word Hy-phen-a-tion by Com-put-er](https://tug.org/docs/liang/).
+ * Ph.D. thesis, Stanford University, 1983.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "hyphenate.h"
+#include "unicode.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <ctype.h>                      /* for isalpha(3), isspace(3) */
+#include <fcntl.h>                      /* for open(2) */
+#include <stdint.h>                     /* for uint8_t, uint32_t */
+#include <stdio.h>
+#include <stdlib.h>                     /* for qsort(3) */
+#include <string.h>                     /* for memset(3), strncmp(3) */
+#include <sys/stat.h>                   /* for fstat(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for read(2) */
+#include <wctype.h>                     /* for towlower(3) */
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+# include <sys/mman.h>                  /* for mmap(2) */
+# define WITH_HYPH_MMAP 1
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+
+/// @endcond
+
+/**
+ * @addtogroup hyphenate-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Digit of an exception's letter pair that forbids a hyphen: it's larger than
+ * any digit of a real pattern so exceptions override patterns.
+ */
+#define EXCEPTION_NO_BREAK        8
+
+/**
+ * Digit of an exception's letter pair that allows a hyphen.
+ *
+ * @sa #EXCEPTION_NO_BREAK
+ */
+#define EXCEPTION_BREAK           9
+
+/**
+ * Byte-order mark of a compiled hyphenation file: if read as its byte-swapped
+ * value, the file was compiled on a machine of the other endianness.
+ */
+#define HYPH_BOM                  0x01020304u
+
+/**
+ * The number of times a free entry of the trie being packed may not fit a
+ * node before it's no longer tried.
+ *
+ * @sa hyph_pack()
+ */
+#define HYPH_PACK_FAILS_MAX       32
+
+/**
+ * Magic number of a compiled hyphenation file.
+ */
+#define HYPH_MAGIC                "WRAPHYPH"
+
+/**
+ * Version of the format of compiled hyphenation files.
+ */
+#define HYPH_VERSION              1u
+
+/**
+ * The header of a compiled hyphenation file.  It's followed by:
+ *
+ *  1. \a alphabet_len code-points of \ref hyph_alphabet;
+ *  2. \a trie_len \ref hyph_entry structures of \ref hyph_trie; and
+ *  3. \a ops_len bytes of \ref hyph_ops.
+ *
+ * All integers are in the byte order of the machine that compiled the file so
+ * the file can be used as-is once memory-mapped.
+ */
+struct hyph_header {
+  char      magic[8];                   ///< #HYPH_MAGIC (not null-terminated).
+  uint32_t  bom;                        ///< #HYPH_BOM.
+  uint32_t  version;                    ///< #HYPH_VERSION.
+  uint32_t  root;                       ///< \ref hyph_root.
+  uint32_t  alphabet_len;               ///< \ref hyph_alphabet_len.
+  uint32_t  trie_len;                   ///< \ref hyph_trie_len.
+  uint32_t  ops_len;                    ///< \ref hyph_ops_len.
+};
+typedef struct hyph_header hyph_header_t;
+
+/**
+ * An entry of the packed trie.  The children of a node are at the entries at
+ * the node's base plus the symbol of each child; an entry belongs to a node
+ * only if its \a sym is the symbol being looked for.
+ */
+struct hyph_entry {
+  uint32_t  sym;                        ///< Symbol of child or 0 if free.
+  uint32_t  base;                       ///< Base of child's children or 0.
+  uint32_t  ops;                        ///< 1 + offset into hyph_ops or 0.
+};
+typedef struct hyph_entry hyph_entry_t;
+
+static_assert( sizeof( char32_t ) == 4, "char32_t must be 4 bytes" );
+static_assert( sizeof( hyph_entry_t ) == 12, "hyph_entry_t must be packed" );
+static_assert( sizeof( hyph_header_t ) == 32, "hyph_header_t must be packed" );
+
+/**
+ * A node of the trie while it's being built before it's packed.
+ */
+struct hyph_node {
+  uint32_t  sym;                        ///< Symbol of edge from parent.
+  uint32_t  child;                      ///< First child or 0 if none.
+  uint32_t  sibling;                    ///< Next sibling or 0 if none.
+  uint32_t  ops;                        ///< 1 + offset into hyph_ops or 0.
+  uint32_t  entry;                      ///< Index of entry in packed trie.
+  uint32_t  base;                       ///< Base of children in packed trie.
+  uint32_t  children;                   ///< Number of children.
+};
+typedef struct hyph_node hyph_node_t;
+
+/**
+ * The free entries of \ref hyph_trie while it's being packed.
+ */
+struct hyph_pack_list {
+  size_t    cap;                        ///< Capacity of all arrays.
+  bool     *base_used;                  ///< Base of some node already?
+  uint8_t  *fails;                      ///< Times free entry didn't fit.
+  uint32_t *next;                       ///< Next free entry or 0 if none.
+  uint32_t *prev;                       ///< Previous free entry or 0 if none.
+};
+typedef struct hyph_pack_list hyph_pack_list_t;
+
+/**
+ * What the tokens of a hyphenation pattern file currently are.
+ */
+enum hyph_section {
+  HYPH_NONE,                            ///< Ignored.
+  HYPH_EXCEPTIONS,                      ///< Within `\hyphenation{...}`.
+  HYPH_PATTERNS                         ///< Within `\patterns{...}`.
+};
+typedef enum hyph_section hyph_section_t;
+
+/**
+ * A hyphenation pattern (or exception) as parsed, before being inserted into
+ * the trie.
+ */
+struct hyph_pattern {
+  size_t    cps;                        ///< Offset into pattern code-points.
+  size_t    len;                        ///< Number of code-points.
+  uint32_t  ops;                        ///< 1 + offset into hyph_ops.
+};
+typedef struct hyph_pattern hyph_pattern_t;
+
+// local variables
+static char32_t      *hyph_alphabet;    ///< Sorted code-points of symbols.
+static size_t         hyph_alphabet_len;///< Length of \ref hyph_alphabet.
+static uint32_t       hyph_ascii_sym[ 128 ];  ///< Symbols of ASCII chars.
+static uint8_t       *hyph_ops;         ///< Pattern digits: length, digits.
+static size_t         hyph_ops_cap;     ///< Capacity of \ref hyph_ops.
+static size_t         hyph_ops_len;     ///< Length of \ref hyph_ops.
+static uint32_t       hyph_root;        ///< Base of trie root's children.
+static void          *hyph_image;       ///< Compiled file, if any.
+static size_t         hyph_image_size;  ///< Size of \ref hyph_image.
+static bool           hyph_image_mapped;///< Is \ref hyph_image mapped?
+static hyph_entry_t  *hyph_trie;        ///< Packed trie.
+static size_t         hyph_trie_len;    ///< Length of \ref hyph_trie.
+
+// local functions
+NODISCARD
+static int            cp_cmp( void const*, void const* );
+
+static void           hyph_ascii_init( void );
+
+NODISCARD
+static uint32_t       hyph_bswap32( uint32_t );
+
+NODISCARD
+static size_t         hyph_decode( char const*, size_t, char32_t* );
+
+static void           hyph_load( int, size_t, hyph_header_t const*,
+                                 char const* );
+
+static void           hyph_pack( hyph_node_t*, size_t );
+static void           hyph_pack_grow( hyph_pack_list_t*, size_t );
+static void           hyph_pack_unlink( hyph_pack_list_t*, size_t );
+
+NODISCARD
+static hyph_section_t hyph_parse( char const*, size_t, hyph_section_t,
+                                  char32_t**, size_t*, size_t*,
+                                  hyph_pattern_t**, size_t*, size_t*,
+                                  char const*, unsigned );
+
+NODISCARD
+static uint32_t       hyph_sym( char32_t );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Comparison function for **qsort**(3) that compares two code-points.
+ *
+ * @param i_data A pointer to the first code-point.
+ * @param j_data A pointer to the second code-point.
+ * @return Returns an integer less than zero, zero, or greater than zero if
+ * the first code-point is less than, equal to, or greater than the second,
+ * respectively.
+ */
+static int cp_cmp( void const *i_data, void const *j_data ) {
+  char32_t const i_cp = *STATIC_CAST( char32_t const*, i_data );
+  char32_t const j_cp = *STATIC_CAST( char32_t const*, j_data );
+  return (i_cp > j_cp) - (i_cp < j_cp);
+}
+
+/**
+ * Initializes \ref hyph_ascii_sym from \ref hyph_alphabet.
+ */
+static void hyph_ascii_init( void ) {
+  for ( size_t i = 0; i < hyph_alphabet_len && hyph_alphabet[i] < 128; ++i )
+    hyph_ascii_sym[ hyph_alphabet[i] ] = STATIC_CAST( uint32_t, i + 1 );
+}
+
+/**
+ * Swaps the bytes of a 32-bit integer.
+ *
+ * @param n The integer to swap the bytes of.
+ * @return Returns \a n with its bytes swapped.
+ */
+static uint32_t hyph_bswap32( uint32_t n ) {
+  return (n >> 24) | ((n >> 8) & 0xFF00u) | ((n << 8) & 0xFF0000u) | (n << 24);
+}
+
+/**
+ * Decodes a UTF-8 encoded character checking that it's valid.
+ *
+ * @param s A pointer to the first byte of the character.
+ * @param s_len The number of bytes remaining starting at \a s.
+ * @param pcp A pointer to receive the code-point.
+ * @return Returns the number of bytes of the character or 0 if it's invalid
+ * or truncated.
+ */
+static size_t hyph_decode( char const *s, size_t s_len, char32_t *pcp ) {
+  assert( s != NULL );
+  assert( pcp != NULL );
+
+  size_t const len = utf8_len( *s );
+  if ( len == 0 || len > s_len )
+    return 0;
+  for ( size_t i = 1; i < len; ++i ) {
+    if ( !utf8_is_cont( s[i] ) )
+      return 0;
+  } // for
+  *pcp = utf8_decode( s );
+  return *pcp == CP_INVALID ? 0 : len;
+}
+
+/**
+ * Loads a compiled hyphenation file by memory-mapping it (or, if it can't be,
+ * reading it) and pointing \ref hyph_alphabet, \ref hyph_trie, and \ref
+ * hyph_ops into it.  If the file was compiled on a machine of the other
+ * endianness, copies of them are byte-swapped instead.  If the file is
+ * corrupt, prints an error message and exits.
+ *
+ * @param fd The file descriptor of the file.
+ * @param size The size of the file.
+ * @param header The header of the file, already read.
+ * @param path The path of the file (for error messages).
+ */
+static void hyph_load( int fd, size_t size, hyph_header_t const *header,
+                       char const *path ) {
+  assert( header != NULL );
+
+  bool const swapped = header->bom != HYPH_BOM;
+  if ( swapped && header->bom != hyph_bswap32( HYPH_BOM ) )
+    goto corrupt;
+
+  uint32_t const version =
+    swapped ? hyph_bswap32( header->version ) : header->version;
+  if ( version != HYPH_VERSION ) {
+    fatal_error( EX_DATAERR,
+      "%s: compiled hyphenation file version %u; expected %u\n",
+      path, version, HYPH_VERSION
+    );
+  }
+
+  uint32_t const alphabet_len =
+    swapped ? hyph_bswap32( header->alphabet_len ) : header->alphabet_len;
+  uint32_t const trie_len =
+    swapped ? hyph_bswap32( header->trie_len ) : header->trie_len;
+  uint32_t const ops_len =
+    swapped ? hyph_bswap32( header->ops_len ) : header->ops_len;
+
+  uint64_t const alphabet_off = sizeof( hyph_header_t );
+  uint64_t const trie_off =
+    alphabet_off + STATIC_CAST( uint64_t, alphabet_len ) * sizeof( char32_t );
+  uint64_t const ops_off =
+    trie_off + STATIC_CAST( uint64_t, trie_len ) * sizeof( hyph_entry_t );
+  if ( trie_len == 0 || ops_off + ops_len != size )
+    goto corrupt;
+
+  char *image = NULL;
+#ifdef WITH_HYPH_MMAP
+  image = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  if ( image == MAP_FAILED )
+    image = NULL;
+  else
+    hyph_image_mapped = true;
+#endif /* WITH_HYPH_MMAP */
+  if ( image == NULL ) {
+    image = MALLOC( char, size );
+    if ( lseek( fd, 0, SEEK_SET ) == -1 )
+      fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+    for ( size_t n = 0; n < size; ) {
+      ssize_t const bytes_read = read( fd, image + n, size - n );
+      if ( bytes_read == -1 )
+        fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+      if ( bytes_read == 0 )
+        goto corrupt;
+      n += STATIC_CAST( size_t, bytes_read );
+    } // for
+  }
+
+  hyph_alphabet = POINTER_CAST( char32_t*, image + alphabet_off );
+  hyph_alphabet_len = alphabet_len;
+  hyph_trie = POINTER_CAST( hyph_entry_t*, image + trie_off );
+  hyph_trie_len = trie_len;
+  hyph_ops = POINTER_CAST( uint8_t*, image + ops_off );
+  hyph_ops_len = ops_len;
+  hyph_root = swapped ? hyph_bswap32( header->root ) : header->root;
+  hyph_image = image;
+  hyph_image_size = size;
+
+  if ( swapped ) {
+    char32_t *const alphabet = MALLOC( char32_t, alphabet_len );
+    for ( size_t i = 0; i < alphabet_len; ++i )
+      alphabet[i] = hyph_bswap32( hyph_alphabet[i] );
+    hyph_entry_t *const trie = MALLOC( hyph_entry_t, trie_len );
+    for ( size_t i = 0; i < trie_len; ++i ) {
+      trie[i] = (hyph_entry_t){
+        .sym  = hyph_bswap32( hyph_trie[i].sym ),
+        .base = hyph_bswap32( hyph_trie[i].base ),
+        .ops  = hyph_bswap32( hyph_trie[i].ops )
+      };
+    } // for
+    uint8_t *const ops = MALLOC( uint8_t, ops_len );
+    memcpy( ops, hyph_ops, ops_len );
+
+    hyphenate_cleanup();                // releases just the image
+
+    hyph_alphabet = alphabet;
+    hyph_alphabet_len = alphabet_len;
+    hyph_trie = trie;
+    hyph_trie_len = trie_len;
+    hyph_ops = ops;
+    hyph_ops_len = ops_len;
+    hyph_root = hyph_bswap32( header->root );
+  }
+
+  hyph_ascii_init();
+  return;
+
+corrupt:
+  fatal_error( EX_DATAERR, "%s: corrupt compiled hyphenation file\n", path );
+}
+
+/**
+ * Packs the trie into \ref hyph_trie by placing the children of every node
+ * at the first base where they all fit among the children already placed.
+ * Nodes having the most children are placed first, while \ref hyph_trie is
+ * still mostly empty; nodes having few children then fill in the holes.
+ * Candidate bases are found via a list of the free entries so placing a node
+ * takes time proportional to the number of free entries rather than all
+ * entries.
+ *
+ * @param nodes The nodes of the trie; node 0 is the root.  The \a entry and
+ * \a base of each are set.
+ * @param nodes_len The number of nodes.
+ */
+static void hyph_pack( hyph_node_t *nodes, size_t nodes_len ) {
+  assert( nodes != NULL );
+
+  hyph_pack_list_t list = { 0 };
+  hyph_pack_grow( &list, 1024 );
+
+  uint32_t children_max = 0;
+  for ( size_t n = 0; n < nodes_len; ++n ) {
+    if ( nodes[n].children > children_max )
+      children_max = nodes[n].children;
+  } // for
+
+  for ( uint32_t children = children_max; children > 0; --children ) {
+    for ( size_t n = 0; n < nodes_len; ++n ) {
+      if ( nodes[n].children != children )
+        continue;
+
+      uint32_t sym_min = UINT32_MAX, sym_max = 0;
+      for ( uint32_t c = nodes[n].child; c != 0; c = nodes[c].sibling ) {
+        if ( nodes[c].sym < sym_min )
+          sym_min = nodes[c].sym;
+        if ( nodes[c].sym > sym_max )
+          sym_max = nodes[c].sym;
+      } // for
+
+      size_t base;
+      for ( size_t f = list.next[0]; ; f = list.next[f] ) {
+        if ( f == 0 ) {                 // no free entry fits: make more
+          f = list.cap;
+          hyph_pack_grow( &list, list.cap + sym_max + 1 );
+        }
+        if ( f > sym_min ) {
+          base = f - sym_min;
+          if ( base + sym_max >= list.cap )
+            hyph_pack_grow( &list, base + sym_max + 1 );
+          if ( !list.base_used[ base ] ) {
+            uint32_t c = nodes[n].child;
+            while ( c != 0 && hyph_trie[ base + nodes[c].sym ].sym == 0 )
+              c = nodes[c].sibling;
+            if ( c == 0 )
+              break;
+          }
+        }
+        //
+        // A free entry that has been found not to fit many times is unlikely
+        // ever to fit, so stop trying it: otherwise, the holes left near the
+        // beginning would be tried for every node.
+        //
+        if ( ++list.fails[f] == HYPH_PACK_FAILS_MAX )
+          hyph_pack_unlink( &list, f );
+      } // for
+
+      list.base_used[ base ] = true;
+      nodes[n].base = STATIC_CAST( uint32_t, base );
+
+      for ( uint32_t c = nodes[n].child; c != 0; c = nodes[c].sibling ) {
+        size_t const e = base + nodes[c].sym;
+        hyph_trie[e].sym = nodes[c].sym;
+        hyph_trie[e].ops = nodes[c].ops;
+        nodes[c].entry = STATIC_CAST( uint32_t, e );
+        if ( list.fails[e] < HYPH_PACK_FAILS_MAX )
+          hyph_pack_unlink( &list, e );
+        if ( e + 1 > hyph_trie_len )
+          hyph_trie_len = e + 1;
+      } // for
+    } // for
+  } // for
+
+  //
+  // A node's entry is known only once its parent has been placed, so set the
+  // bases of entries only now.
+  //
+  hyph_root = nodes[0].base;
+  for ( size_t n = 1; n < nodes_len; ++n )
+    hyph_trie[ nodes[n].entry ].base = nodes[n].base;
+
+  FREE( list.base_used );
+  FREE( list.fails );
+  FREE( list.next );
+  FREE( list.prev );
+}
+
+/**
+ * Grows \ref hyph_trie and \a list to at least \a cap_min entries, appending
+ * the new entries to the list of free entries.
+ *
+ * @param list The \ref hyph_pack_list to grow.
+ * @param cap_min The minimum capacity.
+ */
+static void hyph_pack_grow( hyph_pack_list_t *list, size_t cap_min ) {
+  assert( list != NULL );
+  if ( cap_min <= list->cap )
+    return;
+
+  size_t const new_cap = cap_min * 2;
+  REALLOC( hyph_trie, hyph_entry_t, new_cap );
+  REALLOC( list->base_used, bool, new_cap );
+  REALLOC( list->fails, uint8_t, new_cap );
+  REALLOC( list->next, uint32_t, new_cap );
+  REALLOC( list->prev, uint32_t, new_cap );
+  memset(
+    hyph_trie + list->cap, 0, (new_cap - list->cap) * sizeof( hyph_entry_t )
+  );
+  memset( list->base_used + list->cap, 0, new_cap - list->cap );
+  memset( list->fails + list->cap, 0, new_cap - list->cap );
+
+  //
+  // Entry 0 is never used (every symbol and base is at least 1) so it's the
+  // sentinel of the circular list of free entries.
+  //
+  size_t i = list->cap;
+  if ( i == 0 ) {
+    list->next[0] = list->prev[0] = 0;
+    i = 1;
+  }
+  uint32_t tail = list->prev[0];
+  for ( ; i < new_cap; ++i ) {
+    list->prev[i] = tail;
+    list->next[ tail ] = STATIC_CAST( uint32_t, i );
+    tail = STATIC_CAST( uint32_t, i );
+  } // for
+  list->next[ tail ] = 0;
+  list->prev[0] = tail;
+  list->cap = new_cap;
+}
+
+/**
+ * Unlinks an entry from the list of free entries.
+ *
+ * @param list The \ref hyph_pack_list to unlink \a e from.
+ * @param e The entry to unlink.
+ */
+static void hyph_pack_unlink( hyph_pack_list_t *list, size_t e ) {
+  assert( list != NULL );
+  assert( e > 0 && e < list->cap );
+  list->next[ list->prev[e] ] = list->next[e];
+  list->prev[ list->next[e] ] = list->prev[e];
+  list->fails[e] = HYPH_PACK_FAILS_MAX;
+}
+
+/**
+ * Parses a chunk of a hyphenation pattern file.
+ *
+ * @param s The chunk.  It must be null-terminated.
+ * @param s_len The length of \a s.
+ * @param section The section at the beginning of \a s.
+ * @param pcps A pointer to the code-points of all patterns.
+ * @param pcps_len A pointer to the length of \a *pcps.
+ * @param pcps_cap A pointer to the capacity of \a *pcps.
+ * @param ppatterns A pointer to the patterns.
+ * @param ppatterns_len A pointer to the length of \a *ppatterns.
+ * @param ppatterns_cap A pointer to the capacity of \a *ppatterns.
+ * @param path The path of the file (for error messages).
+ * @param line_no The line number of the beginning of \a s.
+ * @return Returns the section at the end of \a s.
+ */
+static hyph_section_t hyph_parse( char const *s, size_t s_len,
+                                  hyph_section_t section,
+                                  char32_t **pcps, size_t *pcps_len,
+                                  size_t *pcps_cap,
+                                  hyph_pattern_t **ppatterns,
+                                  size_t *ppatterns_len,
+                                  size_t *ppatterns_cap,
+                                  char const *path, unsigned line_no ) {
+  assert( s != NULL );
+  char const *const end = s + s_len;
+
+  while ( s < end ) {
+    if ( *s == '\n' ) {
+      ++line_no;
+      ++s;
+      continue;
+    }
+    if ( isspace( STATIC_CAST( unsigned char, *s ) ) || *s == '{' ) {
+      ++s;
+      continue;
+    }
+    if ( *s == '%' ) {                  // TeX comment
+      while ( s < end && *s != '\n' )
+        ++s;
+      continue;
+    }
+    if ( *s == '}' ) {
+      section = HYPH_NONE;
+      ++s;
+      continue;
+    }
+    if ( *s == '\\' ) {                 // TeX command
+      char const *const name = ++s;
+      while ( s < end && isalpha( STATIC_CAST( unsigned char, *s ) ) )
+        ++s;
+      size_t const name_len = STATIC_CAST( size_t, s - name );
+      if ( name_len == 8 && strncmp( name, "patterns", 8 ) == 0 )
+        section = HYPH_PATTERNS;
+      else if ( name_len == 11 && strncmp( name, "hyphenation", 11 ) == 0 )
+        section = HYPH_EXCEPTIONS;
+      else
+        section = HYPH_NONE;
+      continue;
+    }
+
+    char const *const token = s;
+    while ( s < end && !isspace( STATIC_CAST( unsigned char, *s ) ) &&
+            *s != '%' && *s != '}' ) {
+      ++s;
+    }
+    if ( section == HYPH_NONE )
+      continue;
+    size_t const token_len = STATIC_CAST( size_t, s - token );
+
+    //
+    // A pattern of n letters has n + 1 digits: digit i is the value of the
+    // point before letter i.  An exception is turned into a pattern that
+    // matches only the whole word and whose digits override those of any real
+    // pattern.
+    //
+    if ( *pcps_len + token_len + 2 > *pcps_cap ) {
+      *pcps_cap = (*pcps_len + token_len + 2) * 2;
+      REALLOC( *pcps, char32_t, *pcps_cap );
+    }
+    if ( hyph_ops_len + token_len + 4 > hyph_ops_cap ) {
+      hyph_ops_cap = (hyph_ops_len + token_len + 4) * 2;
+      REALLOC( hyph_ops, uint8_t, hyph_ops_cap );
+    }
+
+    char32_t *const cps = *pcps + *pcps_len;
+    uint8_t *const digits = hyph_ops + hyph_ops_len + 1;
+    size_t len = 0;
+    bool is_exception = section == HYPH_EXCEPTIONS;
+    bool was_digit = false;
+
+    if ( is_exception ) {
+      cps[ len ] = '.';
+      digits[ len++ ] = 0;
+    }
+    digits[ len ] = 0;
+
+    for ( char const *t = token; t < s; ) {
+      if ( !is_exception && *t >= '0' && *t <= '9' ) {
+        if ( was_digit )
+          goto invalid;
+        digits[ len ] = STATIC_CAST( uint8_t, *t++ - '0' );
+        was_digit = true;
+        continue;
+      }
+      if ( is_exception && *t == '-' ) {
+        if ( len < 2 || was_digit )
+          goto invalid;
+        digits[ len ] = EXCEPTION_BREAK;
+        was_digit = true;
+        ++t;
+        continue;
+      }
+      char32_t cp;
+      size_t const cp_len =
+        hyph_decode( t, STATIC_CAST( size_t, s - t ), &cp );
+      if ( cp_len == 0 )
+        goto invalid;
+      if ( is_exception && !was_digit && len > 1 )
+        digits[ len ] = EXCEPTION_NO_BREAK;
+      cps[ len++ ] =
+        STATIC_CAST( char32_t, towlower( STATIC_CAST( wint_t, cp ) ) );
+      digits[ len ] = 0;
+      was_digit = false;
+      t += cp_len;
+    } // for
+
+    if ( is_exception ) {
+      if ( len < 2 || was_digit )
+        goto invalid;
+      cps[ len++ ] = '.';
+      digits[ len ] = 0;
+    }
+    else if ( len == 0 ) {
+      goto invalid;
+    }
+
+    if ( *ppatterns_len == *ppatterns_cap ) {
+      *ppatterns_cap = *ppatterns_cap == 0 ? 256 : *ppatterns_cap * 2;
+      REALLOC( *ppatterns, hyph_pattern_t, *ppatterns_cap );
+    }
+    (*ppatterns)[ (*ppatterns_len)++ ] = (hyph_pattern_t){
+      .cps = *pcps_len,
+      .len = len,
+      .ops = STATIC_CAST( uint32_t, hyph_ops_len + 1 )
+    };
+    hyph_ops[ hyph_ops_len ] = STATIC_CAST( uint8_t, len + 1 );
+    hyph_ops_len += len + 2;
+    *pcps_len += len;
+    continue;
+
+invalid:
+    fatal_error( EX_DATAERR,
+      "%s:%u: \"%.*s\": invalid hyphenation %s\n",
+      path, line_no, STATIC_CAST( int, token_len ), token,
+      is_exception ? "exception" : "pattern"
+    );
+  } // while
+
+  return section;
+}
+
+/**
+ * Gets the trie symbol of a code-point.
+ *
+ * @param cp The code-point to get the symbol of.
+ * @return Returns said symbol or 0 if \a cp isn't in any pattern.
+ */
+static uint32_t hyph_sym( char32_t cp ) {
+  if ( cp < ARRAY_SIZE( hyph_ascii_sym ) )
+    return hyph_ascii_sym[ cp ];
+  size_t lo = 0, hi = hyph_alphabet_len;
+  while ( lo < hi ) {
+    size_t const mid = lo + (hi - lo) / 2;
+    if ( hyph_alphabet[ mid ] < cp )
+      lo = mid + 1;
+    else
+      hi = mid;
+  } // while
+  return lo < hyph_alphabet_len && hyph_alphabet[ lo ] == cp ?
+    STATIC_CAST( uint32_t, lo + 1 ) : 0;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void hyphenate_cleanup( void ) {
+  if ( hyph_image == NULL ) {
+    FREE( hyph_alphabet );
+    FREE( hyph_ops );
+    FREE( hyph_trie );
+  }
+#ifdef WITH_HYPH_MMAP
+  else if ( hyph_image_mapped ) {
+    PJL_DISCARD_RV( munmap( hyph_image, hyph_image_size ) );
+  }
+#endif /* WITH_HYPH_MMAP */
+  else {
+    FREE( hyph_image );
+  }
+  hyph_image = NULL;
+  hyph_image_mapped = false;
+  hyph_image_size = 0;
+
+  hyph_alphabet = NULL;
+  hyph_alphabet_len = 0;
+  MEM_ZERO( &hyph_ascii_sym );
+  hyph_ops = NULL;
+  hyph_ops_cap = hyph_ops_len = 0;
+  hyph_trie = NULL;
+  hyph_trie_len = 0;
+  hyph_root = 0;
+}
+
+void hyphenate_init( char const *path ) {
+  assert( path != NULL );
+  assert( hyph_trie == NULL );
+
+  int const fd = open( path, O_RDONLY );
+  if ( fd == -1 )
+    fatal_error( EX_NOINPUT, "%s: %s\n", path, STRERROR() );
+
+  //
+  // A compiled file is used as-is; anything else is parsed as TeX patterns.
+  //
+  hyph_header_t header;
+  struct stat st;
+  if ( read( fd, &header, sizeof header ) == sizeof header &&
+       memcmp( header.magic, HYPH_MAGIC, sizeof header.magic ) == 0 ) {
+    if ( fstat( fd, &st ) == -1 )
+      fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+    hyph_load( fd, STATIC_CAST( size_t, st.st_size ), &header, path );
+    close( fd );
+    return;
+  }
+
+  FILE *const fin = lseek( fd, 0, SEEK_SET ) == -1 ? NULL : fdopen( fd, "r" );
+  if ( fin == NULL )
+    fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+
+  char *buf = NULL;
+  size_t buf_cap = 0, buf_len = 0;
+  for (;;) {
+    if ( buf_len + 1 >= buf_cap ) {
+      buf_cap = buf_cap == 0 ? 64 * 1024 : buf_cap * 2;
+      REALLOC( buf, char, buf_cap );
+    }
+    size_t const n = fread( buf + buf_len, 1, buf_cap - buf_len - 1, fin );
+    if ( n == 0 )
+      break;
+    buf_len += n;
+  } // for
+  if ( unlikely( ferror( fin ) ) )
+    fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+  fclose( fin );
+  buf[ buf_len ] = '\0';
+
+  char32_t *cps = NULL;
+  size_t cps_cap = 0, cps_len = 0;
+  hyph_pattern_t *patterns = NULL;
+  size_t patterns_cap = 0, patterns_len = 0;
+
+  //
+  // A file that has no \patterns command is taken to be just patterns.
+  //
+  PJL_DISCARD_RV(
+    hyph_parse(
+      buf, buf_len,
+      strstr( buf, "\\patterns" ) == NULL ? HYPH_PATTERNS : HYPH_NONE,
+      &cps, &cps_len, &cps_cap, &patterns, &patterns_len, &patterns_cap,
+      path, /*line_no=*/1
+    )
+  );
+  FREE( buf );
+
+  if ( patterns_len == 0 )
+    fatal_error( EX_DATAERR, "%s: no hyphenation patterns\n", path );
+
+  //
+  // The alphabet is every distinct code-point of the patterns; each code-
+  // point's symbol is 1 + its index.
+  //
+  hyph_alphabet = MALLOC( char32_t, cps_len );
+  memcpy( hyph_alphabet, cps, cps_len * sizeof( char32_t ) );
+  qsort( hyph_alphabet, cps_len, sizeof( char32_t ), &cp_cmp );
+  for ( size_t i = 0; i < cps_len; ++i ) {
+    if ( hyph_alphabet_len == 0 ||
+         hyph_alphabet[ hyph_alphabet_len - 1 ] != hyph_alphabet[i] ) {
+      hyph_alphabet[ hyph_alphabet_len++ ] = hyph_alphabet[i];
+    }
+  } // for
+  hyph_ascii_init();
+
+  //
+  // Build the trie with nodes that are later packed.
+  //
+  size_t nodes_cap = 1024, nodes_len = 1;
+  hyph_node_t *nodes = MALLOC( hyph_node_t, nodes_cap );
+  nodes[0] = (hyph_node_t){ 0 };
+
+  for ( size_t p = 0; p < patterns_len; ++p ) {
+    uint32_t n = 0;
+    for ( size_t i = 0; i < patterns[p].len; ++i ) {
+      uint32_t const sym = hyph_sym( cps[ patterns[p].cps + i ] );
+      uint32_t c = nodes[n].child;
+      while ( c != 0 && nodes[c].sym != sym )
+        c = nodes[c].sibling;
+      if ( c == 0 ) {
+        if ( nodes_len == nodes_cap ) {
+          nodes_cap *= 2;
+          REALLOC( nodes, hyph_node_t, nodes_cap );
+        }
+        c = STATIC_CAST( uint32_t, nodes_len++ );
+        nodes[c] = (hyph_node_t){ .sym = sym, .sibling = nodes[n].child };
+        nodes[n].child = c;
+        ++nodes[n].children;
+      }
+      n = c;
+    } // for
+    nodes[n].ops = patterns[p].ops;
+  } // for
+
+  FREE( cps );
+  FREE( patterns );
+
+  hyph_pack( nodes, nodes_len );
+  FREE( nodes );
+}
+
+bool hyphenate_word( char const *word, size_t word_len, bool breaks[] ) {
+  assert( word != NULL );
+  assert( breaks != NULL );
+
+  memset( breaks, 0, word_len * sizeof( bool ) );
+  if ( hyph_trie == NULL )
+    return false;
+
+  //
+  // The symbols are those of the word's letters surrounded by dots.
+  //
+  uint32_t syms[ HYPHENATE_WORD_MAX + 2 ];
+  size_t offsets[ HYPHENATE_WORD_MAX ];
+  size_t n = 0;
+  bool after_letters = false;
+
+  for ( size_t i = 0; i < word_len; ) {
+    char32_t cp;
+    size_t const cp_len = hyph_decode( word + i, word_len - i, &cp );
+    if ( cp_len == 0 )
+      return false;
+    if ( cp_is_hyphen( cp ) )
+      return false;
+    if ( cp_is_alpha( cp ) ) {
+      if ( after_letters || n == HYPHENATE_WORD_MAX )
+        return false;
+      offsets[ n ] = i;
+      syms[ ++n ] = hyph_sym(
+        STATIC_CAST( char32_t, towlower( STATIC_CAST( wint_t, cp ) ) )
+      );
+    }
+    else if ( n > 0 ) {
+      after_letters = true;
+    }
+    i += cp_len;
+  } // for
+
+  if ( n < HYPHENATE_LEFT_MIN + HYPHENATE_RIGHT_MIN )
+    return false;
+  syms[0] = syms[ n + 1 ] = hyph_sym( '.' );
+
+  //
+  // Point i is between symbols i - 1 and i: the point between letters j - 1
+  // and j is therefore point j + 1 due to the leading dot.
+  //
+  uint8_t points[ HYPHENATE_WORD_MAX + 3 ] = { 0 };
+
+  for ( size_t i = 0; i < n + 2; ++i ) {
+    uint32_t base = hyph_root;
+    for ( size_t j = i; j < n + 2 && base != 0; ++j ) {
+      uint32_t const sym = syms[j];
+      if ( sym == 0 )
+        break;
+      size_t const e = base + sym;
+      if ( e >= hyph_trie_len || hyph_trie[e].sym != sym )
+        break;
+      if ( hyph_trie[e].ops != 0 ) {
+        //
+        // A pattern of j - i + 1 symbols has j - i + 2 digits; anything else
+        // (or digits past the end of hyph_ops) means a corrupt compiled file.
+        //
+        size_t const o = hyph_trie[e].ops - 1;
+        uint8_t const *const op = hyph_ops + o;
+        if ( o >= hyph_ops_len || op[0] != j - i + 2 ||
+             o + op[0] >= hyph_ops_len ) {
+          break;
+        }
+        for ( size_t k = 0; k < op[0]; ++k ) {
+          if ( op[ k + 1 ] > points[ i + k ] )
+            points[ i + k ] = op[ k + 1 ];
+        } // for
+      }
+      base = hyph_trie[e].base;
+    } // for
+  } // for
+
+  bool any = false;
+  for ( size_t j = HYPHENATE_LEFT_MIN; j + HYPHENATE_RIGHT_MIN <= n; ++j ) {
+    if ( points[ j + 1 ] % 2 != 0 )
+      any = breaks[ offsets[j] ] = true;
+  } // for
+  return any;
+}
+
+void hyphenate_write( char const *path ) {
+  assert( path != NULL );
+  assert( hyph_trie != NULL );
+
+  hyph_header_t header = {
+    .bom = HYPH_BOM,
+    .version = HYPH_VERSION,
+    .root = hyph_root,
+    .alphabet_len = STATIC_CAST( uint32_t, hyph_alphabet_len ),
+    .trie_len = STATIC_CAST( uint32_t, hyph_trie_len ),
+    .ops_len = STATIC_CAST( uint32_t, hyph_ops_len )
+  };
+  memcpy( header.magic, HYPH_MAGIC, sizeof header.magic );
+
+  FILE *const fout = fopen( path, "wb" );
+  if ( fout == NULL )
+    fatal_error( EX_CANTCREAT, "%s: %s\n", path, STRERROR() );
+  PJL_DISCARD_RV( fwrite( &header, sizeof header, 1, fout ) );
+  PJL_DISCARD_RV(
+    fwrite( hyph_alphabet, sizeof( char32_t ), hyph_alphabet_len, fout )
+  );
+  PJL_DISCARD_RV(
+    fwrite( hyph_trie, sizeof( hyph_entry_t ), hyph_trie_len, fout )
+  );
+  PJL_DISCARD_RV( fwrite( hyph_ops, 1, hyph_ops_len, fout ) );
+  if ( unlikely( ferror( fout ) ) || fclose( fout ) != 0 )
+    fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,123 @@
+/*
+**      wrap -- text reformatter
+**      src/hyphenate.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_hyphenate_H
+#define wrap_hyphenate_H
+
+/**
+ * @file
+ * Declares functions for hyphenating words using Liang's algorithm and TeX
+ * hyphenation patterns.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup hyphenate-group Hyphenation
+ * Functions for hyphenating words using Liang's algorithm and TeX hyphenation
+ * patterns.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The minimum number of letters before a hyphenation point (TeX's
+ * `\lefthyphenmin`).
+ */
+#define HYPHENATE_LEFT_MIN        2
+
+/**
+ * The minimum number of letters after a hyphenation point (TeX's
+ * `\righthyphenmin`).
+ */
+#define HYPHENATE_RIGHT_MIN       3
+
+/**
+ * The maximum number of letters of a word that can be hyphenated.
+ */
+#define HYPHENATE_WORD_MAX        128
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees all memory used by the hyphenation patterns, if any.
+ *
+ * @sa hyphenate_init()
+ */
+void hyphenate_cleanup( void );
+
+/**
+ * Reads hyphenation patterns from a file compiled by hyphenate_write() (that
+ * is memory-mapped and used as-is), a TeX hyphenation pattern file, i.e., one
+ * containing `\patterns{...}` and optionally `\hyphenation{...}` (exceptions),
+ * or a file containing only patterns, one or more per line.
+ * If the file can't be read or contains an invalid pattern, prints an error
+ * message and exits.
+ *
+ * @param path The path of the file to read.
+ *
+ * @sa hyphenate_cleanup()
+ */
+void hyphenate_init( char const *path );
+
+/**
+ * Gets the points at which \a word may be hyphenated.  Non-letters before and
+ * after the letters of \a word are ignored; a \a word having either a hyphen
+ * character (including U+00AD SOFT HYPHEN) anywhere, since it has its own
+ * break points, or other non-letters (such as digits or apostrophes) between
+ * letters, since it's not a word, isn't hyphenated.
+ *
+ * @param word The UTF-8 encoded word.  It need not be null-terminated.
+ * @param word_len The length in bytes of \a word.
+ * @param breaks An array of at least \a word_len bools: \a breaks[_i_] is set
+ * to `true` only if \a word may be hyphenated before byte _i_.
+ * @return Returns `true` only if \a word may be hyphenated at all.
+ *
+ * @note hyphenate_init() must have been called first.
+ */
+NODISCARD
+bool hyphenate_word( char const *word, size_t word_len, bool breaks[] );
+
+/**
+ * Writes the hyphenation patterns read by hyphenate_init() to a file in a
+ * compiled form that hyphenate_init() can later use without parsing.  The file
+ * is in the byte order of the current machine.  If the file can't be written,
+ * prints an error message and exits.
+ *
+ * @param path The path of the file to write.
+ */
+void hyphenate_write( char const *path );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_hyphenate_H */
+/* vim:set et sw=2 ts=2: */
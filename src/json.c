@@ -0,0 +1,652 @@
+/*
+**      wrap -- text reformatter
+**      src/json.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for parsing and writing JSON.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "json.h"
+#include "simd.h"
+#include "unicode.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdarg.h>
+#include <stdint.h>                     /* for uint32_t */
+#include <stdio.h>                      /* for vsnprintf(3) */
+#include <stdlib.h>                     /* for strtod(3) */
+#include <string.h>
+#include <sysexits.h>
+
+/// @endcond
+
+/**
+ * @addtogroup json-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maximum nesting depth of arrays and objects.
+ */
+#define JSON_DEPTH_MAX            64
+
+/**
+ * JSON parser state.
+ */
+struct json_parser {
+  char const *s;                        ///< Next character to parse.
+  char const *end;                      ///< End of JSON text.
+  unsigned    depth;                    ///< Current nesting depth.
+};
+typedef struct json_parser json_parser_t;
+
+// local functions
+NODISCARD
+static json_value_t* json_parse_value( json_parser_t* );
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Skips whitespace other than newlines.
+ *
+ * @param s The characters to skip.
+ * @return Returns a pointer to the first character that isn't such
+ * whitespace.
+ */
+NODISCARD
+static inline char const* json_scan_ws( char const *s ) {
+  while ( *s == ' ' || *s == '\t' || *s == '\r' )
+    ++s;
+  return s;
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Skips whitespace.
+ *
+ * @param p The \ref json_parser to use.
+ */
+static void json_skip_ws( json_parser_t *p ) {
+  assert( p != NULL );
+  for ( ; p->s < p->end; ++p->s ) {
+    switch ( *p->s ) {
+      case ' ' :
+      case '\t':
+      case '\n':
+      case '\r':
+        continue;
+    } // switch
+    break;
+  } // for
+}
+
+/**
+ * Checks whether \a c is a decimal digit.
+ *
+ * @param c The character to check.
+ * @return Returns `true` only if \a c is a decimal digit.
+ */
+NODISCARD
+static inline bool json_is_digit( char c ) {
+  return c >= '0' && c <= '9';
+}
+
+/**
+ * Parses exactly \a lit.
+ *
+ * @param p The \ref json_parser to use.
+ * @param lit The literal to parse, e.g., `true`.
+ * @return Returns `true` only if the next characters are \a lit.
+ */
+NODISCARD
+static bool json_parse_lit( json_parser_t *p, char const *lit ) {
+  assert( p != NULL );
+  assert( lit != NULL );
+  size_t const len = strlen( lit );
+  if ( STATIC_CAST( size_t, p->end - p->s ) < len ||
+       strncmp( p->s, lit, len ) != 0 ) {
+    return false;
+  }
+  p->s += len;
+  return true;
+}
+
+/**
+ * Parses 4 hexadecimal digits.
+ *
+ * @param p The \ref json_parser to use.
+ * @param pcp A pointer to receive the value.
+ * @return Returns `true` only if there were 4 hexadecimal digits.
+ */
+NODISCARD
+static bool json_parse_hex4( json_parser_t *p, uint32_t *pcp ) {
+  assert( p != NULL );
+  assert( pcp != NULL );
+  if ( p->end - p->s < 4 )
+    return false;
+  uint32_t cp = 0;
+  for ( unsigned i = 0; i < 4; ++i ) {
+    char const c = *p->s++;
+    cp <<= 4;
+    if ( c >= '0' && c <= '9' )
+      cp |= STATIC_CAST( uint32_t, c - '0' );
+    else if ( c >= 'a' && c <= 'f' )
+      cp |= STATIC_CAST( uint32_t, c - 'a' + 10 );
+    else if ( c >= 'A' && c <= 'F' )
+      cp |= STATIC_CAST( uint32_t, c - 'A' + 10 );
+    else
+      return false;
+  } // for
+  *pcp = cp;
+  return true;
+}
+
+/**
+ * Decodes the rest of a string up to and including its closing quote.
+ *
+ * @param p The \ref json_parser to use.  Its next character must be just after
+ * the opening `"` and there must be a closing `"`.
+ * @param dest A pointer to receive the decoded characters.  It must have room
+ * for as many characters as the string's raw length.
+ * @param plen A pointer to receive the number of decoded characters.
+ * @return Returns `true` only if the string is well-formed.
+ */
+NODISCARD
+static bool json_decode( json_parser_t *p, char *dest, size_t *plen ) {
+  assert( p != NULL );
+  assert( dest != NULL );
+  assert( plen != NULL );
+  char *d = dest;
+
+  for (;;) {
+    char const c = *p->s++;
+    if ( c == '"' )
+      break;
+    if ( STATIC_CAST( unsigned char, c ) < 0x20 )
+      return false;
+    if ( c != '\\' ) {
+      *d++ = c;
+      continue;
+    }
+    switch ( *p->s++ ) {
+      case '"' : *d++ = '"';  break;
+      case '\\': *d++ = '\\'; break;
+      case '/' : *d++ = '/';  break;
+      case 'b' : *d++ = '\b'; break;
+      case 'f' : *d++ = '\f'; break;
+      case 'n' : *d++ = '\n'; break;
+      case 'r' : *d++ = '\r'; break;
+      case 't' : *d++ = '\t'; break;
+      case 'u': {
+        uint32_t cp;
+        if ( !json_parse_hex4( p, &cp ) )
+          return false;
+        if ( cp >= 0xD800 && cp <= 0xDBFF && p->end - p->s >= 6 &&
+             p->s[0] == '\\' && p->s[1] == 'u' ) {
+          char const *const s = p->s;
+          uint32_t lo;
+          p->s += 2;
+          if ( json_parse_hex4( p, &lo ) && lo >= 0xDC00 && lo <= 0xDFFF )
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+          else
+            p->s = s;
+        }
+        if ( cp >= 0xD800 && cp <= 0xDFFF )
+          cp = 0xFFFD;                  // unpaired surrogate
+        d += utf8_encode( cp, d );
+        break;
+      }
+      default:
+        return false;
+    } // switch
+  } // for
+
+  *plen = STATIC_CAST( size_t, d - dest );
+  return true;
+}
+
+/**
+ * Parses a string.
+ *
+ * @param p The \ref json_parser to use.  Its next character must be `"`.
+ * @param plen A pointer to receive the length of the string.
+ * @return Returns said string (allocated via arena_alloc()) or NULL if it's
+ * malformed.
+ */
+NODISCARD
+static char* json_parse_str( json_parser_t *p, size_t *plen ) {
+  assert( p != NULL );
+  assert( plen != NULL );
+  assert( *p->s == '"' );
+  ++p->s;
+
+  //
+  // Find the closing quote first: an escape is never shorter than what it
+  // decodes to, so the string's raw length is enough to decode into.
+  //
+  char const *q = p->s;
+  for ( ; q < p->end && *q != '"'; ++q ) {
+    if ( *q == '\\' && ++q == p->end )
+      return NULL;
+  } // for
+  if ( q == p->end )
+    return NULL;
+  char *const str = arena_alloc( STATIC_CAST( size_t, q - p->s ) + 1 );
+  if ( !json_decode( p, str, plen ) )
+    return NULL;
+  str[ *plen ] = '\0';
+  return str;
+}
+
+/**
+ * Parses a number.
+ *
+ * @param p The \ref json_parser to use.
+ * @param pn A pointer to receive the number.
+ * @return Returns `true` only if the number is well-formed.
+ */
+NODISCARD
+static bool json_parse_num( json_parser_t *p, double *pn ) {
+  assert( p != NULL );
+  assert( pn != NULL );
+
+  char const *const start = p->s;
+  if ( p->s < p->end && *p->s == '-' )
+    ++p->s;
+  if ( p->s == p->end || !json_is_digit( *p->s ) )
+    return false;
+  if ( *p->s == '0' )
+    ++p->s;
+  else
+    while ( p->s < p->end && json_is_digit( *p->s ) )
+      ++p->s;
+  if ( p->s < p->end && *p->s == '.' ) {
+    if ( ++p->s == p->end || !json_is_digit( *p->s ) )
+      return false;
+    while ( p->s < p->end && json_is_digit( *p->s ) )
+      ++p->s;
+  }
+  if ( p->s < p->end && (*p->s == 'e' || *p->s == 'E') ) {
+    if ( ++p->s < p->end && (*p->s == '+' || *p->s == '-') )
+      ++p->s;
+    if ( p->s == p->end || !json_is_digit( *p->s ) )
+      return false;
+    while ( p->s < p->end && json_is_digit( *p->s ) )
+      ++p->s;
+  }
+
+  // The text isn't null-terminated, so strtod() needs a copy.
+  char const *const num =
+    arena_strndup( start, STATIC_CAST( size_t, p->s - start ) );
+  *pn = strtod( num, NULL );
+  return true;
+}
+
+/**
+ * Parses the elements of an array or the members of an object.
+ *
+ * @param p The \ref json_parser to use.  Its next character must be either
+ * `[` or `{`.
+ * @param is_object `true` only if parsing an object.
+ * @return Returns the first element or member or NULL if there are none.
+ * Upon error, \a p->s is set to NULL.
+ */
+NODISCARD
+static json_value_t* json_parse_list( json_parser_t *p, bool is_object ) {
+  assert( p != NULL );
+  char const close = is_object ? '}' : ']';
+  ++p->s;
+
+  json_value_t *first = NULL, **plast = &first;
+  json_skip_ws( p );
+  if ( p->s < p->end && *p->s == close ) {
+    ++p->s;
+    return NULL;
+  }
+  for (;;) {
+    char const *name = NULL;
+    if ( is_object ) {
+      size_t name_len;
+      json_skip_ws( p );
+      if ( p->s == p->end || *p->s != '"' ||
+           (name = json_parse_str( p, &name_len )) == NULL ) {
+        goto error;
+      }
+      json_skip_ws( p );
+      if ( p->s == p->end || *p->s++ != ':' )
+        goto error;
+    }
+    json_value_t *const value = json_parse_value( p );
+    if ( value == NULL )
+      goto error;
+    value->name = name;
+    *plast = value;
+    plast = &value->next;
+
+    json_skip_ws( p );
+    if ( p->s == p->end )
+      goto error;
+    char const c = *p->s++;
+    if ( c == close )
+      return first;
+    if ( c != ',' )
+      goto error;
+  } // for
+
+error:
+  p->s = NULL;
+  return NULL;
+}
+
+/**
+ * Parses a value.
+ *
+ * @param p The \ref json_parser to use.
+ * @return Returns said value or NULL upon error.
+ */
+static json_value_t* json_parse_value( json_parser_t *p ) {
+  assert( p != NULL );
+
+  json_skip_ws( p );
+  if ( p->s == p->end )
+    return NULL;
+
+  json_value_t *const value = ARENA_ALLOC( json_value_t, 1 );
+  MEM_ZERO( value );
+
+  switch ( *p->s ) {
+    case '"':
+      value->type = JSON_STRING;
+      value->s = json_parse_str( p, &value->len );
+      if ( value->s == NULL )
+        return NULL;
+      break;
+    case '[':
+    case '{':
+      value->type = *p->s == '{' ? JSON_OBJECT : JSON_ARRAY;
+      if ( ++p->depth > JSON_DEPTH_MAX )
+        return NULL;
+      value->first = json_parse_list( p, value->type == JSON_OBJECT );
+      if ( p->s == NULL )
+        return NULL;
+      --p->depth;
+      break;
+    case 'f':
+      if ( !json_parse_lit( p, "false" ) )
+        return NULL;
+      value->type = JSON_BOOL;
+      break;
+    case 'n':
+      if ( !json_parse_lit( p, "null" ) )
+        return NULL;
+      value->type = JSON_NULL;
+      break;
+    case 't':
+      if ( !json_parse_lit( p, "true" ) )
+        return NULL;
+      value->type = JSON_BOOL;
+      value->b = true;
+      break;
+    default:
+      value->type = JSON_NUMBER;
+      if ( !json_parse_num( p, &value->n ) )
+        return NULL;
+  } // switch
+
+  return value;
+}
+
+/**
+ * Skips a string.
+ *
+ * @param s A pointer to the string's opening `"`.
+ * @return Returns a pointer to just after the string's closing `"` or NULL if
+ * a newline or null character is reached first.
+ *
+ * @sa json_scan_str_member()
+ */
+NODISCARD
+static char const* json_scan_str( char const *s ) {
+  assert( s != NULL );
+  assert( *s == '"' );
+  for ( ++s;; ) {
+    s += simd_scan( s );
+    switch ( *s ) {
+      case '"':
+        return s + 1;
+      case '\\':
+        if ( s[1] == '\0' || s[1] == '\n' )
+          return NULL;
+        s += 2;
+        continue;
+      case '\0':
+      case '\n':
+        return NULL;
+      default:                          // a bracket: no meaning in a string
+        ++s;
+    } // switch
+  } // for
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void json_buf_cleanup( json_buf_t *buf ) {
+  assert( buf != NULL );
+  FREE( buf->str );
+  *buf = (json_buf_t){ 0 };
+}
+
+void json_buf_printf( json_buf_t *buf, char const *format, ... ) {
+  assert( buf != NULL );
+  assert( format != NULL );
+
+  va_list args;
+  va_start( args, format );
+  int const raw_len = vsnprintf( NULL, 0, format, args );
+  va_end( args );
+  PERROR_EXIT_IF( raw_len < 0, EX_SOFTWARE );
+
+  size_t const len = STATIC_CAST( size_t, raw_len );
+  json_buf_reserve( buf, len + 1 );
+  va_start( args, format );
+  PJL_DISCARD_RV( vsnprintf( buf->str + buf->len, len + 1, format, args ) );
+  va_end( args );
+  buf->len += len;
+}
+
+void json_buf_put( json_buf_t *buf, char const *s, size_t len ) {
+  assert( buf != NULL );
+  assert( s != NULL || len == 0 );
+  if ( len == 0 )
+    return;
+  json_buf_reserve( buf, len );
+  memcpy( buf->str + buf->len, s, len );
+  buf->len += len;
+}
+
+void json_buf_put_str( json_buf_t *buf, char const *s, size_t len ) {
+  assert( buf != NULL );
+  assert( s != NULL || len == 0 );
+
+  json_buf_put( buf, "\"", 1 );
+  char const *const end = s + len;
+  while ( s < end ) {
+    char const *run = s;
+    while ( run < end && *run != '"' && *run != '\\' &&
+            STATIC_CAST( unsigned char, *run ) >= 0x20 ) {
+      ++run;
+    } // while
+    json_buf_put( buf, s, STATIC_CAST( size_t, run - s ) );
+    if ( run == end )
+      break;
+    switch ( *run ) {
+      case '"' : json_buf_put( buf, "\\\"", 2 ); break;
+      case '\\': json_buf_put( buf, "\\\\", 2 ); break;
+      case '\n': json_buf_put( buf, "\\n", 2 ); break;
+      case '\r': json_buf_put( buf, "\\r", 2 ); break;
+      case '\t': json_buf_put( buf, "\\t", 2 ); break;
+      default:
+        json_buf_printf( buf, "\\u%04X", STATIC_CAST( unsigned, *run ) );
+    } // switch
+    s = run + 1;
+  } // while
+  json_buf_put( buf, "\"", 1 );
+}
+
+void json_buf_reserve( json_buf_t *buf, size_t len ) {
+  assert( buf != NULL );
+  if ( buf->len + len <= buf->cap )
+    return;
+  if ( buf->cap == 0 )
+    buf->cap = 256;
+  while ( buf->cap < buf->len + len )
+    buf->cap *= 2;
+  REALLOC( buf->str, char, buf->cap );
+}
+
+json_value_t const* json_get( json_value_t const *obj, char const *name ) {
+  assert( name != NULL );
+  if ( obj == NULL || obj->type != JSON_OBJECT )
+    return NULL;
+  for ( json_value_t const *member = obj->first; member != NULL;
+        member = member->next ) {
+    if ( strcmp( member->name, name ) == 0 )
+      return member;
+  } // for
+  return NULL;
+}
+
+bool json_get_size( json_value_t const *obj, char const *name, size_t *pn ) {
+  assert( pn != NULL );
+  json_value_t const *const value = json_get( obj, name );
+  if ( value == NULL || value->type != JSON_NUMBER || value->n < 0 ||
+       value->n > 0x1p53 ) {
+    return false;
+  }
+  size_t const n = STATIC_CAST( size_t, value->n );
+  if ( STATIC_CAST( double, n ) < value->n )
+    return false;                       // not an integer
+  *pn = n;
+  return true;
+}
+
+json_value_t const* json_get_str( json_value_t const *obj, char const *name ) {
+  json_value_t const *const value = json_get( obj, name );
+  return value != NULL && value->type == JSON_STRING ? value : NULL;
+}
+
+json_value_t const* json_parse( char const *s, size_t len ) {
+  assert( s != NULL || len == 0 );
+  json_parser_t p = { .s = s, .end = s + len };
+  json_value_t const *const value = json_parse_value( &p );
+  if ( value == NULL )
+    return NULL;
+  json_skip_ws( &p );
+  return p.s == p.end ? value : NULL;
+}
+
+void json_scan_init( void ) {
+  static bool const SCAN_SET[ 256 ] = {
+    ['\0'] = true, ['\n'] = true, ['"' ] = true, ['\\'] = true,
+    ['[' ] = true, [']' ] = true, ['{' ] = true, ['}' ] = true
+  };
+  simd_scan_init( SCAN_SET );
+}
+
+bool json_scan_str_member( char const *s, char const *name, size_t name_len,
+                           char const **pbegin, char const **pend ) {
+  assert( s != NULL );
+  assert( name != NULL );
+  assert( pbegin != NULL );
+  assert( pend != NULL );
+
+  s = json_scan_ws( s );
+  if ( *s != '{' )
+    return false;
+
+  for ( unsigned depth = 0;; ) {
+    s += simd_scan( s );
+    switch ( *s ) {
+      case '[':
+      case '{':
+        ++depth;
+        ++s;
+        continue;
+      case ']':
+      case '}':
+        if ( --depth == 0 )
+          return false;
+        ++s;
+        continue;
+      case '"':
+        break;
+      default:                          // '\\', newline, or null
+        return false;
+    } // switch
+
+    char const *const str = s;
+    if ( (s = json_scan_str( s )) == NULL )
+      return false;
+    if ( depth > 1 )
+      continue;
+    char const *const colon = json_scan_ws( s );
+    if ( *colon != ':' )                // a value, not a member name
+      continue;
+    bool const is_name = STATIC_CAST( size_t, s - str ) == name_len + 2 &&
+      memcmp( str + 1, name, name_len ) == 0;
+    s = json_scan_ws( colon + 1 );
+    if ( !is_name )
+      continue;
+    if ( *s != '"' )
+      return false;
+    *pbegin = s;
+    *pend = json_scan_str( s );
+    return *pend != NULL;
+  } // for
+}
+
+bool json_str_decode( char const *s, size_t len, json_buf_t *buf ) {
+  assert( s != NULL );
+  assert( len >= 2 && s[0] == '"' && s[ len - 1 ] == '"' );
+  assert( buf != NULL );
+
+  json_buf_reserve( buf, len );
+  json_parser_t p = { .s = s + 1, .end = s + len };
+  size_t decoded_len;
+  if ( !json_decode( &p, buf->str + buf->len, &decoded_len ) )
+    return false;
+  buf->len += decoded_len;
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
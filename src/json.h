@@ -0,0 +1,234 @@
+/*
+**      wrap -- text reformatter
+**      src/json.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_json_H
+#define wrap_json_H
+
+/**
+ * @file
+ * Declares data structures and functions for parsing and writing JSON.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup json-group JSON
+ * Data structures and functions for parsing JSON into a tree of values,
+ * scanning JSON Lines records for a member, and writing JSON into a buffer,
+ * just enough for **wrap-lsp**(1) and `--jsonl`.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * JSON value types.
+ */
+enum json_type {
+  JSON_NULL,                            ///< `null`.
+  JSON_BOOL,                            ///< `true` or `false`.
+  JSON_NUMBER,                          ///< A number.
+  JSON_STRING,                          ///< A string.
+  JSON_ARRAY,                           ///< An array.
+  JSON_OBJECT                           ///< An object.
+};
+typedef enum json_type json_type_t;
+
+typedef struct json_value json_value_t;
+
+/**
+ * A JSON value.  An array's elements or an object's members are a list of
+ * values.
+ *
+ * @sa json_parse()
+ */
+struct json_value {
+  json_type_t   type;                   ///< Value type.
+  char const   *name;                   ///< Member name, if any.
+  json_value_t *next;                   ///< Next element or member, if any.
+
+  bool          b;                      ///< Value of #JSON_BOOL.
+  double        n;                      ///< Value of #JSON_NUMBER.
+  char const   *s;                      ///< Null-terminated #JSON_STRING.
+  size_t        len;                    ///< Length of \a s.
+  json_value_t *first;                  ///< First element or member, if any.
+};
+
+/**
+ * A growable buffer of characters, e.g., JSON being written.
+ *
+ * @sa json_buf_cleanup()
+ */
+struct json_buf {
+  char   *str;                          ///< Characters (not null-terminated).
+  size_t  len;                          ///< Number of characters.
+  size_t  cap;                          ///< Capacity of \a str.
+};
+typedef struct json_buf json_buf_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees the memory used by \a buf and makes it empty.
+ *
+ * @param buf The \ref json_buf to clean up.
+ */
+void json_buf_cleanup( json_buf_t *buf );
+
+/**
+ * Appends characters to \a buf.
+ *
+ * @param buf The \ref json_buf to append to.
+ * @param s The characters to append.
+ * @param len The number of characters to append.
+ */
+void json_buf_put( json_buf_t *buf, char const *s, size_t len );
+
+/**
+ * Appends formatted characters to \a buf.
+ *
+ * @param buf The \ref json_buf to append to.
+ * @param format The `printf()` style format string.
+ * @param ... The `printf()` arguments.
+ */
+PJL_PRINTF_LIKE_FUNC(2)
+void json_buf_printf( json_buf_t *buf, char const *format, ... );
+
+/**
+ * Appends characters to \a buf as a quoted and escaped JSON string.
+ *
+ * @param buf The \ref json_buf to append to.
+ * @param s The characters of the string.
+ * @param len The number of characters of the string.
+ */
+void json_buf_put_str( json_buf_t *buf, char const *s, size_t len );
+
+/**
+ * Ensures \a buf can hold at least \a len more characters.
+ *
+ * @param buf The \ref json_buf to check.
+ * @param len The additional length required.
+ */
+void json_buf_reserve( json_buf_t *buf, size_t len );
+
+/**
+ * Gets a member of an object.
+ *
+ * @param obj The object to get the member of.  It may be NULL.
+ * @param name The name of the member.
+ * @return Returns said member's value or NULL if either \a obj is NULL or not
+ * an object or it has no such member.
+ */
+NODISCARD
+json_value_t const* json_get( json_value_t const *obj, char const *name );
+
+/**
+ * Gets a member of an object that's a number as an unsigned integer.
+ *
+ * @param obj The object to get the member of.  It may be NULL.
+ * @param name The name of the member.
+ * @param pn A pointer to receive the number.
+ * @return Returns `true` only if the member exists and is a non-negative
+ * integer.
+ */
+NODISCARD
+bool json_get_size( json_value_t const *obj, char const *name, size_t *pn );
+
+/**
+ * Gets a member of an object that's a string.
+ *
+ * @param obj The object to get the member of.  It may be NULL.
+ * @param name The name of the member.
+ * @return Returns said string or NULL if there's no such member or it's not a
+ * string.
+ */
+NODISCARD
+json_value_t const* json_get_str( json_value_t const *obj, char const *name );
+
+/**
+ * Parses JSON.
+ *
+ * @param s The JSON text.  It need not be null-terminated.
+ * @param len The length of \a s.
+ * @return Returns the value parsed or NULL if \a s isn't valid JSON.  All
+ * values are allocated via arena_alloc().
+ */
+NODISCARD
+json_value_t const* json_parse( char const *s, size_t len );
+
+/**
+ * Sets the characters that simd_scan() stops at to those that
+ * json_scan_str_member() needs.  It must be called before the latter.
+ */
+void json_scan_init( void );
+
+/**
+ * Scans a JSON Lines record for a top-level member that's a string without
+ * either parsing or decoding anything else.  Strings are skipped over several
+ * characters at a time via simd_scan().
+ *
+ * @param s The null-terminated record.  The record ends at either a newline
+ * or the null.  It must be readable for #SIMD_SPAN_PAD characters past the
+ * null.
+ * @param name The name of the member.  It's compared to member names without
+ * decoding their escapes.
+ * @param name_len The length of \a name.
+ * @param pbegin A pointer to receive a pointer to the member's value's opening
+ * `"`.
+ * @param pend A pointer to receive a pointer to just after the member's
+ * value's closing `"`.
+ * @return Returns `true` only if the record is an object that has such a
+ * member before anything malformed.
+ *
+ * @sa json_scan_init()
+ * @sa json_str_decode()
+ */
+NODISCARD
+bool json_scan_str_member( char const *s, char const *name, size_t name_len,
+                           char const **pbegin, char const **pend );
+
+/**
+ * Decodes a string.
+ *
+ * @param s The string including its quotes, e.g., as found by
+ * json_scan_str_member().
+ * @param len The length of \a s.
+ * @param buf The \ref json_buf to append the decoded characters to.
+ * @return Returns `true` only if \a s is well-formed.  If not, \a buf may
+ * have characters past its length changed, but not its length.
+ */
+NODISCARD
+bool json_str_decode( char const *s, size_t len, json_buf_t *buf );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_json_H */
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,571 @@
+/*
+**      wrapc -- comment reformatter
+**      src/lang.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines how programming languages quote strings and functions for finding
+ * where strings start and end.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "lang.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>                     /* for NULL, size_t */
+#include <stdlib.h>                     /* for bsearch(3) */
+#include <string.h>
+
+/// @endcond
+
+/**
+ * @addtogroup lang-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+// local constant definitions
+
+/**
+ * Indices into \ref LANGS.
+ */
+enum lang_id {
+  LANG_ADA,
+  LANG_ASM,
+  LANG_BATCH,
+  LANG_C,
+  LANG_COBOL,
+  LANG_D,
+  LANG_ERLANG,
+  LANG_FORTH,
+  LANG_FORTRAN,
+  LANG_FSHARP,
+  LANG_GO,
+  LANG_HASKELL,
+  LANG_HTML,
+  LANG_INI,
+  LANG_JAVA,
+  LANG_JS,
+  LANG_JULIA,
+  LANG_LISP,
+  LANG_LUA,
+  LANG_ML,
+  LANG_PASCAL,
+  LANG_POWERSHELL,
+  LANG_PYTHON,
+  LANG_RUST,
+  LANG_SHELL,
+  LANG_SIMULA,
+  LANG_SQL,
+  LANG_TEX,
+  LANG_VB,
+  LANG_XQUERY,
+  LANG_ZIG
+};
+typedef enum lang_id lang_id_t;
+
+/**
+ * A file name or extension and its language.
+ */
+struct lang_ext {
+  char const *ext;                      ///< File name or extension.
+  lang_id_t   id;                       ///< Its language.
+};
+typedef struct lang_ext lang_ext_t;
+
+/**
+ * The languages, indexed by \ref lang_id.  Languages whose comments never
+ * contain Doxygen have it turned off.
+ *
+ * @remarks Rust has no `'` quote since it more often starts a lifetime, e.g.,
+ * `'a`, than a character literal; likewise for languages where `'` is part of
+ * an identifier or quotes a symbol, e.g., Haskell or Lisp.  Simula has `;`
+ * since it ends a comment started by `!`.
+ */
+static lang_t const LANGS[] = {
+  [ LANG_ADA        ] = { "Ada",        "--",         "\"",   "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_ASM        ] = { "Assembly",   ";",          "\"'",  "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_BATCH      ] = { "Batch",      "REM,::",     "\"",   "",   "",
+                          '^',  LANG_RAW_NONE,   false },
+  [ LANG_C          ] = { "C",          "/*,//",      "\"'",  "",   "",
+                          '\\', LANG_RAW_CPP,    true  },
+  [ LANG_COBOL      ] = { "COBOL",      "*,*>",       "\"'",  "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_D          ] = { "D",          "/*,/+,//",   "\"'",  "",   "`",
+                          '\\', LANG_RAW_NONE,   true  },
+  [ LANG_ERLANG     ] = { "Erlang",     "%",          "\"'",  "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_FORTH      ] = { "Forth",      "\\",         "\"",   "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_FORTRAN    ] = { "Fortran",    "!",          "\"'",  "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_FSHARP     ] = { "F#",         "(*,//",      "\"",   "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_GO         ] = { "Go",         "/*,//",      "\"'",  "",   "`",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_HASKELL    ] = { "Haskell",    "--,{-",      "\"",   "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_HTML       ] = { "HTML",       "<!--",       "",     "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_INI        ] = { "INI",        ";,#",        "\"",   "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_JAVA       ] = { "Java",       "/*,//",      "\"'",  "",   "",
+                          '\\', LANG_RAW_NONE,   true  },
+  [ LANG_JS         ] = { "JavaScript", "/*,//",      "\"'",  "`",  "",
+                          '\\', LANG_RAW_NONE,   true  },
+  [ LANG_JULIA      ] = { "Julia",      "#,#=",       "\"",   "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_LISP       ] = { "Lisp",       ";,#|",       "\"",   "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_LUA        ] = { "Lua",        "--,--[[",    "\"'",  "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_ML         ] = { "ML",         "(*",         "\"",   "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_PASCAL     ] = { "Pascal",     "{,(*,//",    "'",    "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_POWERSHELL ] = { "PowerShell", "#,<#",       "\"'",  "",   "",
+                          '`',  LANG_RAW_NONE,   false },
+  [ LANG_PYTHON     ] = { "Python",     "#",          "\"'",  "",   "",
+                          '\\', LANG_RAW_PYTHON, true  },
+  [ LANG_RUST       ] = { "Rust",       "/*,//",      "",     "\"", "",
+                          '\\', LANG_RAW_RUST,   false },
+  [ LANG_SHELL      ] = { "Shell",      "#",          "\"'",  "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+  [ LANG_SIMULA     ] = { "Simula",     "!,;",        "\"",   "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_SQL        ] = { "SQL",        "--,/*",      "\"'",  "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_TEX        ] = { "TeX",        "%",          "",     "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_VB         ] = { "Visual Basic", "',REM",    "\"",   "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_XQUERY     ] = { "XQuery",     "(:",         "\"'",  "",   "",
+                          '\0', LANG_RAW_NONE,   false },
+  [ LANG_ZIG        ] = { "Zig",        "//",         "\"'",  "",   "",
+                          '\\', LANG_RAW_NONE,   false },
+};
+
+/**
+ * File names and extensions of the languages sorted by **strcmp**(3) so
+ * lang_find() can binary search them.
+ *
+ * @remarks `.fs` is used by both F# and Forth, so it's in neither.
+ */
+static lang_ext_t const LANG_EXTS[] = {
+  { "4th",             LANG_FORTH },
+  { "C",               LANG_C },
+  { "CMakeLists.txt",  LANG_SHELL },
+  { "Dockerfile",      LANG_SHELL },
+  { "GNUmakefile",     LANG_SHELL },
+  { "H",               LANG_C },
+  { "Makefile",        LANG_SHELL },
+  { "R",               LANG_SHELL },
+  { "ada",             LANG_ADA },
+  { "adb",             LANG_ADA },
+  { "ads",             LANG_ADA },
+  { "asm",             LANG_ASM },
+  { "awk",             LANG_SHELL },
+  { "bas",             LANG_VB },
+  { "bash",            LANG_SHELL },
+  { "bat",             LANG_BATCH },
+  { "bib",             LANG_TEX },
+  { "c",               LANG_C },
+  { "c++",             LANG_C },
+  { "cbl",             LANG_COBOL },
+  { "cc",              LANG_C },
+  { "cfg",             LANG_INI },
+  { "cjs",             LANG_JS },
+  { "cl",              LANG_LISP },
+  { "clj",             LANG_LISP },
+  { "cljs",            LANG_LISP },
+  { "cls",             LANG_TEX },
+  { "cmake",           LANG_SHELL },
+  { "cmd",             LANG_BATCH },
+  { "cob",             LANG_COBOL },
+  { "cpp",             LANG_C },
+  { "cpy",             LANG_COBOL },
+  { "cr",              LANG_SHELL },
+  { "cs",              LANG_JAVA },
+  { "cxx",             LANG_C },
+  { "d",               LANG_D },
+  { "dart",            LANG_JAVA },
+  { "di",              LANG_D },
+  { "dpr",             LANG_PASCAL },
+  { "dtx",             LANG_TEX },
+  { "e",               LANG_ADA },
+  { "el",              LANG_LISP },
+  { "erl",             LANG_ERLANG },
+  { "f",               LANG_FORTRAN },
+  { "f03",             LANG_FORTRAN },
+  { "f08",             LANG_FORTRAN },
+  { "f90",             LANG_FORTRAN },
+  { "f95",             LANG_FORTRAN },
+  { "for",             LANG_FORTRAN },
+  { "fsi",             LANG_FSHARP },
+  { "fsx",             LANG_FSHARP },
+  { "fth",             LANG_FORTH },
+  { "go",              LANG_GO },
+  { "groovy",          LANG_JAVA },
+  { "h",               LANG_C },
+  { "h++",             LANG_C },
+  { "hh",              LANG_C },
+  { "hpp",             LANG_C },
+  { "hrl",             LANG_ERLANG },
+  { "hs",              LANG_HASKELL },
+  { "htm",             LANG_HTML },
+  { "html",            LANG_HTML },
+  { "hxx",             LANG_C },
+  { "ini",             LANG_INI },
+  { "java",            LANG_JAVA },
+  { "jl",              LANG_JULIA },
+  { "js",              LANG_JS },
+  { "jsx",             LANG_JS },
+  { "ksh",             LANG_SHELL },
+  { "kt",              LANG_JAVA },
+  { "kts",             LANG_JAVA },
+  { "lisp",            LANG_LISP },
+  { "lpr",             LANG_PASCAL },
+  { "lsp",             LANG_LISP },
+  { "ltx",             LANG_TEX },
+  { "lua",             LANG_LUA },
+  { "m",               LANG_C },
+  { "makefile",        LANG_SHELL },
+  { "mjs",             LANG_JS },
+  { "mk",              LANG_SHELL },
+  { "ml",              LANG_ML },
+  { "mli",             LANG_ML },
+  { "mm",              LANG_C },
+  { "nim",             LANG_SHELL },
+  { "pas",             LANG_PASCAL },
+  { "pl",              LANG_SHELL },
+  { "pm",              LANG_SHELL },
+  { "ps1",             LANG_POWERSHELL },
+  { "psd1",            LANG_POWERSHELL },
+  { "psm1",            LANG_POWERSHELL },
+  { "py",              LANG_PYTHON },
+  { "pyi",             LANG_PYTHON },
+  { "r",               LANG_SHELL },
+  { "rb",              LANG_SHELL },
+  { "rkt",             LANG_LISP },
+  { "rs",              LANG_RUST },
+  { "scala",           LANG_JAVA },
+  { "scm",             LANG_LISP },
+  { "sh",              LANG_SHELL },
+  { "sim",             LANG_SIMULA },
+  { "sml",             LANG_ML },
+  { "sql",             LANG_SQL },
+  { "ss",              LANG_LISP },
+  { "sty",             LANG_TEX },
+  { "svg",             LANG_HTML },
+  { "swift",           LANG_JAVA },
+  { "tcl",             LANG_SHELL },
+  { "tex",             LANG_TEX },
+  { "toml",            LANG_SHELL },
+  { "ts",              LANG_JS },
+  { "tsx",             LANG_JS },
+  { "vb",              LANG_VB },
+  { "vbs",             LANG_VB },
+  { "vhd",             LANG_ADA },
+  { "vhdl",            LANG_ADA },
+  { "xhtml",           LANG_HTML },
+  { "xml",             LANG_HTML },
+  { "xq",              LANG_XQUERY },
+  { "xql",             LANG_XQUERY },
+  { "xqm",             LANG_XQUERY },
+  { "xquery",          LANG_XQUERY },
+  { "yaml",            LANG_SHELL },
+  { "yml",             LANG_SHELL },
+  { "zig",             LANG_ZIG },
+  { "zsh",             LANG_SHELL },
+};
+
+/**
+ * The language used when no file name is given or it's not in \ref LANG_EXTS.
+ */
+static lang_t const LANG_DEFAULT = {
+  "default", NULL, "\"'", "", "", '\\', LANG_RAW_NONE, true
+};
+
+// local functions
+NODISCARD
+static bool         is_ident( char );
+
+NODISCARD
+static bool         is_prefix_start( char const*, char const* );
+
+NODISCARD
+static int          lang_ext_cmp( void const*, void const* );
+
+NODISCARD
+static lang_t const* lang_ext_find( char const* );
+
+NODISCARD
+static char const*  open_cpp( char const*, char const*, lang_quote_t* );
+
+NODISCARD
+static char const*  open_rust( char const*, char const*, lang_quote_t* );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Gets whether \a c is an identifier character.
+ *
+ * @param c The character to check.
+ * @return Returns `true` only if \a c is either a letter, digit, or `_`.
+ */
+static bool is_ident( char c ) {
+  return isalnum( c ) || c == '_';
+}
+
+/**
+ * Gets whether \a s starts a string prefix, i.e., is not within an identifier.
+ *
+ * @param line The line \a s is within.
+ * @param s The position within \a line to check.
+ * @return Returns `true` only if it does.
+ */
+static bool is_prefix_start( char const *line, char const *s ) {
+  return s == line || !is_ident( s[-1] );
+}
+
+/**
+ * Compares a file name or extension to that of a \ref lang_ext for bsearch().
+ *
+ * @param k The file name or extension.
+ * @param e The \ref lang_ext.
+ * @return Returns a number less than 0, 0, or greater than 0 if \a k is less
+ * than, equal to, or greater than the \ref lang_ext's, respectively.
+ */
+static int lang_ext_cmp( void const *k, void const *e ) {
+  lang_ext_t const *const ext = e;
+  return strcmp( k, ext->ext );
+}
+
+/**
+ * Attempts to find the \ref lang of a file name or extension.
+ *
+ * @param ext The file name or extension to find.
+ * @return Returns said \ref lang or NULL if none.
+ */
+static lang_t const* lang_ext_find( char const *ext ) {
+  lang_ext_t const *const found = bsearch(
+    ext, LANG_EXTS, ARRAY_SIZE( LANG_EXTS ), sizeof( LANG_EXTS[0] ),
+    &lang_ext_cmp
+  );
+  return found != NULL ? &LANGS[ found->id ] : NULL;
+}
+
+/**
+ * Checks whether \a s starts a C++ raw string, i.e., `R"xy(` optionally
+ * preceded by one of `u8`, `u`, `U`, or `L`.
+ *
+ * @param line The null-terminated line \a s is within.
+ * @param s The position within \a line of a `"` to check.
+ * @param q The \ref lang_quote to set if \a s starts a raw string.
+ * @return Returns a pointer just past the opening delimiter or NULL if not.
+ */
+static char const* open_cpp( char const *line, char const *s,
+                             lang_quote_t *q ) {
+  if ( s == line || s[-1] != 'R' )
+    return NULL;
+  char const *prefix = s - 1;
+  if ( prefix - line >= 2 && prefix[-2] == 'u' && prefix[-1] == '8' )
+    prefix -= 2;
+  else if ( prefix > line && strchr( "LUu", prefix[-1] ) != NULL )
+    --prefix;
+  if ( !is_prefix_start( line, prefix ) )
+    return NULL;
+
+  size_t const delim_len = strcspn( s + 1, " ()\\\t\v\f\r\n" );
+  if ( delim_len > LANG_RAW_DELIM_MAX || s[ 1 + delim_len ] != '(' )
+    return NULL;
+  q->close[0] = ')';
+  memcpy( q->close + 1, s + 1, delim_len );
+  q->close[ 1 + delim_len ] = '"';
+  q->close[ 2 + delim_len ] = '\0';
+  q->close_len = STATIC_CAST( uint8_t, 2 + delim_len );
+  return s + 1 + delim_len + 1;
+}
+
+/**
+ * Checks whether \a s starts a Rust raw string, i.e., `r"` or `r#"` with any
+ * number of `#`, optionally preceded by `b`.
+ *
+ * @param line The null-terminated line \a s is within.
+ * @param s The position within \a line of either a `"` or the first `#` to
+ * check.
+ * @param q The \ref lang_quote to set if \a s starts a raw string.
+ * @return Returns a pointer just past the opening delimiter or NULL if not.
+ */
+static char const* open_rust( char const *line, char const *s,
+                              lang_quote_t *q ) {
+  if ( s == line || s[-1] != 'r' )
+    return NULL;
+  char const *prefix = s - 1;
+  if ( prefix > line && prefix[-1] == 'b' )
+    --prefix;
+  if ( !is_prefix_start( line, prefix ) )
+    return NULL;
+
+  size_t const hashes_len = strspn( s, "#" );
+  if ( hashes_len > LANG_RAW_DELIM_MAX || s[ hashes_len ] != '"' )
+    return NULL;
+  q->close[0] = '"';
+  memset( q->close + 1, '#', hashes_len );
+  q->close[ 1 + hashes_len ] = '\0';
+  q->close_len = STATIC_CAST( uint8_t, 1 + hashes_len );
+  return s + hashes_len + 1;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+char const* lang_close( lang_quote_t const *q, char const *line,
+                        char const *s ) {
+  assert( q != NULL );
+  assert( q->close_len > 0 );
+  assert( line != NULL );
+  assert( s != NULL );
+
+  if ( q->close_len > 1 ) {
+    char const *const close = strstr( s, q->close );
+    return close != NULL ? close + q->close_len - 1 : NULL;
+  }
+
+  //
+  // A string that can't span lines ends at the end of the line regardless.
+  //
+  char const stops[] = { q->close[0], '\n', '\r', '\0' };
+  for ( ;; ++s ) {
+    s += strcspn( s, q->is_ml ? q->close : stops );
+    if ( *s != q->close[0] )
+      return NULL;
+    if ( q->esc == '\0' || s == line || s[-1] != q->esc )
+      return s;
+  } // for
+}
+
+lang_t const* lang_find( char const *file_name ) {
+  if ( file_name != NULL ) {
+    lang_t const *lang = lang_ext_find( file_name );
+    if ( lang != NULL )
+      return lang;
+    char const *const dot = strrchr( file_name, '.' );
+    if ( dot != NULL && (lang = lang_ext_find( dot + 1 )) != NULL )
+      return lang;
+  }
+  return &LANG_DEFAULT;
+}
+
+bool lang_is_ml( lang_t const *lang ) {
+  assert( lang != NULL );
+  return lang->ml_quotes[0] != '\0' || lang->raw_quotes[0] != '\0' ||
+    lang->raw != LANG_RAW_NONE;
+}
+
+char const* lang_open( lang_t const *lang, char const *line, char const *s,
+                       lang_quote_t *q ) {
+  assert( lang != NULL );
+  assert( line != NULL );
+  assert( s != NULL );
+  assert( q != NULL );
+
+  if ( *s == '\0' )
+    return NULL;
+
+  char const *raw_end = NULL;
+  q->esc = '\0';
+  q->is_ml = true;
+  switch ( lang->raw ) {
+    case LANG_RAW_NONE:
+      break;
+    case LANG_RAW_CPP:
+      if ( *s == '"' )
+        raw_end = open_cpp( line, s, q );
+      break;
+    case LANG_RAW_PYTHON:
+      if ( (*s == '"' || *s == '\'') && s[1] == *s && s[2] == *s ) {
+        memset( q->close, *s, 3 );
+        q->close[3] = '\0';
+        q->close_len = 3;
+        raw_end = s + 3;
+      }
+      break;
+    case LANG_RAW_RUST:
+      if ( *s == '"' || *s == '#' )
+        raw_end = open_rust( line, s, q );
+      break;
+  } // switch
+  if ( raw_end != NULL )
+    return raw_end;
+
+  if ( strchr( lang->quotes, *s ) != NULL ) {
+    q->esc = lang->esc;
+    q->is_ml = false;
+  }
+  else if ( strchr( lang->ml_quotes, *s ) != NULL )
+    q->esc = lang->esc;
+  else if ( strchr( lang->raw_quotes, *s ) == NULL )
+    return NULL;
+
+  q->close[0] = *s;
+  q->close[1] = '\0';
+  q->close_len = 1;
+  return s + 1;
+}
+
+void lang_quote_chars( lang_t const *lang, bool set[static 256] ) {
+  assert( lang != NULL );
+  assert( set != NULL );
+  char const *const quotes[] = {
+    lang->quotes, lang->ml_quotes, lang->raw_quotes
+  };
+  for ( size_t i = 0; i < ARRAY_SIZE( quotes ); ++i ) {
+    for ( char const *s = quotes[i]; *s != '\0'; ++s )
+      set[ STATIC_CAST( unsigned char, *s ) ] = true;
+  } // for
+  switch ( lang->raw ) {
+    case LANG_RAW_NONE:
+      break;
+    case LANG_RAW_CPP:
+    case LANG_RAW_PYTHON:
+      set[ '"' ] = true;
+      set[ '\'' ] = true;
+      break;
+    case LANG_RAW_RUST:
+      set[ '"' ] = true;
+      set[ '#' ] = true;
+      break;
+  } // switch
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
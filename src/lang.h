@@ -0,0 +1,164 @@
+/*
+**      wrapc -- comment reformatter
+**      src/lang.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_lang_H
+#define wrap_lang_H
+
+/**
+ * @file
+ * Declares a data structure for how a programming language delimits comments
+ * and quotes strings and functions for finding where strings start and end.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stdint.h>                     /* for uint8_t */
+
+/// @endcond
+
+/**
+ * @ingroup wrapc-group
+ * @defgroup lang-group Language Profiles
+ * A data structure and functions for how comments are delimited and strings
+ * are quoted in particular programming languages so that the right comment
+ * delimiters are used and those within strings aren't mistaken for comments.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maximum number of characters of the delimiter of a raw string, e.g., the
+ * `xy` of C++'s `R"xy(`...`)xy"` or the number of `#` of Rust's `r##"`...`"##`.
+ */
+#define LANG_RAW_DELIM_MAX        16
+
+/**
+ * Kinds of strings a language has other than those delimited by a single
+ * quote character at each end.
+ */
+enum lang_raw {
+  LANG_RAW_NONE,                        ///< None.
+  LANG_RAW_CPP,                         ///< C++: `R"xy(`...`)xy"`.
+  LANG_RAW_PYTHON,                      ///< Python: `"""`...`"""`.
+  LANG_RAW_RUST                         ///< Rust: `r#"`...`"#`.
+};
+typedef enum lang_raw lang_raw_t;
+
+/**
+ * How a programming language delimits comments and quotes strings.
+ */
+struct lang {
+  char const         *name;             ///< Language name.
+
+  /// Comment delimiters as given by `--comment-chars`; NULL for the default.
+  char const         *comment_chars;
+
+  char const         *quotes;           ///< Quotes of single-line strings.
+  char const         *ml_quotes;        ///< Quotes of multi-line strings.
+  char const         *raw_quotes;       ///< Raw multi-line string quotes.
+  char                esc;              ///< Escape character, if any.
+  lang_raw_t          raw;              ///< Other kind of strings, if any.
+  bool                is_doxygen;       ///< Can comments contain Doxygen?
+};
+typedef struct lang lang_t;
+
+/**
+ * A string that was started by lang_open() and how it ends.
+ */
+struct lang_quote {
+  char    close[ LANG_RAW_DELIM_MAX + 3 ];///< Closing delimiter.
+  uint8_t close_len;                    ///< Length of \a close; 0 = none.
+  char    esc;                          ///< Escape character, if any.
+  bool    is_ml;                        ///< Can the string span lines?
+};
+typedef struct lang_quote lang_quote_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Finds where the string started by lang_open() ends.
+ *
+ * @param q The \ref lang_quote that lang_open() set.
+ * @param line The null-terminated line \a s is within.
+ * @param s The position within \a line just past the opening delimiter or
+ * \a line itself if the string started on a previous line.
+ * @return Returns a pointer to the last character of the closing delimiter or
+ * NULL if the string doesn't end on \a line.
+ */
+NODISCARD
+char const* lang_close( lang_quote_t const *q, char const *line,
+                        char const *s );
+
+/**
+ * Attempts to find the \ref lang of \a file_name by either its whole name,
+ * e.g., `Makefile`, or its extension.
+ *
+ * @param file_name The file-name to match or NULL if none.
+ * @return Returns said \ref lang or a default one that has the default
+ * comment delimiters, quotes strings only by either `"` or `'`, and can have
+ * Doxygen if none matches.
+ */
+NODISCARD
+lang_t const* lang_find( char const *file_name );
+
+/**
+ * Gets whether \a lang has strings that can span lines.
+ *
+ * @param lang The \ref lang to check.
+ * @return Returns `true` only if it does.
+ */
+NODISCARD
+bool lang_is_ml( lang_t const *lang );
+
+/**
+ * Checks whether \a s starts a string.
+ *
+ * @param lang The \ref lang to use.
+ * @param line The null-terminated line \a s is within.
+ * @param s The position within \a line to check.
+ * @param q The \ref lang_quote to set if \a s starts a string.
+ * @return Returns a pointer just past the opening delimiter or NULL if \a s
+ * doesn't start a string.
+ */
+NODISCARD
+char const* lang_open( lang_t const *lang, char const *line, char const *s,
+                       lang_quote_t *q );
+
+/**
+ * Gets all the characters that can start a string in \a lang, i.e, all its
+ * quote characters.
+ *
+ * @param lang The \ref lang to use.
+ * @param set The set to add said characters to.
+ */
+void lang_quote_chars( lang_t const *lang, bool set[static 256] );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_lang_H */
+/* vim:set et sw=2 ts=2: */
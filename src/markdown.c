@@ -29,6 +29,8 @@
 #include "markdown.h"
 #include "common.h"
 #include "options.h"
+#include "probe.h"
+#include "unicode.h"
 #include "util.h"
 
 /// @cond DOXYGEN_IGNORE
@@ -37,6 +39,7 @@
 #include <assert.h>
 #include <ctype.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -53,42 +56,50 @@
  * Calls \ref md_stack_clear(), \ref md_stack_push( \a TOKEN ), and returns \a
  * TOKEN.
  *
+ * @param P A pointer to the \ref md_parser.
  * @param TOKEN The token to push and return.
  */
-#define CLEAR_RETURN(TOKEN) \
-  BLOCK( md_stack_clear(); md_stack_push( (TOKEN), 0, 0 ); return &MD_TOP; )
+#define CLEAR_RETURN(P,TOKEN)                               \
+  BLOCK(                                                    \
+    md_stack_clear( (P) ); md_stack_push( (P), (TOKEN), 0, 0 ); \
+    return &MD_TOP(P);                                      \
+  )
 
 /**
  * Gets an lvalue reference to the Nth Markdown state down from the top of the
  * stack.
  *
+ * @param P A pointer to the \ref md_parser.
  * @param N The Nth item to get (0 = top of stack).
  * @return Returns an lvalue reference to the Nth Markdown state.
  *
  * @note This is a macro instead of an inline function so it'll be an lvalue
  * reference.
  */
-#define MD_STACK(N)               (md_stack[ md_stack_top - (N) ])
+#define MD_STACK(P,N)             (md_stack_base( P )[ (P)->top - (N) ])
 
 /**
  * Gets an lvalue reference to the top Markdown state on the stack.
  *
+ * @param P A pointer to the \ref md_parser.
  * @return Returns an lvalue reference to the top Markdown state.
  *
  * @note This is a macro instead of an inline function so it'll be an lvalue
  * reference.
  */
-#define MD_TOP                    MD_STACK(0)
+#define MD_TOP(P)                 MD_STACK(P,0)
 
 /**
- * Declares \a NAME as a local, `const` `bool` variable, initializes it with a
- * variable named `prev_`<i>NAME</i>, and sets `prev_`<i>NAME</i> to `false`.
+ * Declares \a NAME as a local, `const` `bool` variable, initializes it with
+ * the \ref md_parser member named `prev_`<i>NAME</i>, and sets that to
+ * `false`.
  *
+ * @param P A pointer to the \ref md_parser.
  * @param NAME The name of the local variable.
  */
-#define PREV_BOOL(NAME)           \
-  bool const NAME = prev_##NAME;  \
-  prev_##NAME = false
+#define PREV_BOOL(P,NAME)             \
+  bool const NAME = (P)->prev_##NAME; \
+  (P)->prev_##NAME = false
 
 /**
  * Compares \a S to \a STRLIT for equality.
@@ -101,54 +112,85 @@
   (strncmp( (S), (STRLIT ""), sizeof( STRLIT "" ) - 1 ) == 0)
 
 /**
- * HTML markup types.
- *
- * @remarks Every type that is not #HTML_NONE nor #HTML_ELEMENT is a "special"
- * type in that it (a) has a unique terminator and (b) does not nest.
+ * Kinds of Markdown lines that can be recognized by their first
+ * non-whitespace character, used as bits in \ref MD_FIRST_CHAR_CLASS.
  */
-enum html_state {
-  /// No state.
-  HTML_NONE,
-
-  /// <tt>&lt;![CDATA[</tt>...<tt>]]&gt;</tt>
-  HTML_CDATA,
-
-  /// <tt>&lt;!-\-</tt> ... <tt>-\-&gt;</tt>
-  HTML_COMMENT,
-
-  /// <tt>&lt;!DOCTYPE</tt> ...<tt>&gt;</tt>
-  HTML_DOCTYPE,
-
-  /// <tt>&lt;</tt> _tag_ <tt>&gt;</tt> ... <tt>&lt;/</tt> _tag_ <tt>&gt;</tt>
-  HTML_ELEMENT,
-
-  /// <tt>&lt;?</tt> ... <tt>?&gt;</tt>
-  HTML_PI,
-
-  /// <tt>&lt;pre&gt;</tt>, <tt>&lt;script&gt;</tt>, or <tt>&lt;style&gt;</tt>
-  HTML_PRE,
+enum md_class {
+  MD_CLASS_NONE       = 0,              ///< Can only be text (or a table).
+  MD_CLASS_ABBR       = 1u << 0,        ///< PHP Markdown Extra abbreviation.
+  MD_CLASS_ATX        = 1u << 1,        ///< atx header.
+  MD_CLASS_CODE_FENCE = 1u << 2,        ///< PHP Markdown Extra code fence.
+  MD_CLASS_DL         = 1u << 3,        ///< Definition list.
+  MD_CLASS_DOX_OL     = 1u << 4,        ///< Doxygen ordered list.
+  MD_CLASS_HR         = 1u << 5,        ///< Horizontal rule.
+  MD_CLASS_HTML       = 1u << 6,        ///< Block-level HTML.
+  MD_CLASS_LINK       = 1u << 7,        ///< Link label or footnote definition.
+  MD_CLASS_OL         = 1u << 8,        ///< Ordered list.
+  MD_CLASS_SETEXT     = 1u << 9,        ///< Setext header.
+  MD_CLASS_UL         = 1u << 10        ///< Unordered list.
+};
+typedef uint16_t md_class_t;            ///< Bitwise-or of \ref md_class.
 
-  /// Ending HTML block.
-  HTML_END
+/**
+ * An entry in \ref html_element_table.
+ */
+struct html_element {
+  char const   *name;                   ///< Element name; `NULL` if unused.
+  html_state_t  html_state;             ///< #HTML_ELEMENT or #HTML_PRE.
 };
-typedef enum html_state html_state_t;
+typedef struct html_element html_element_t;
 
 /**
- * PHP Markdown Extra code fence info.
+ * A copy of all the Markdown parser's state so it can later be restored, or
+ * compared against, for incremental parsing of an \ref md_doc.
  */
-struct md_code_fence {
-  char    cf_c;                 ///< Character of the fence: `~` or <tt>`</tt>.
-  size_t  cf_len;               ///< Length of the fence.
+struct md_snapshot {
+  md_state_t       *stack;              ///< Copy of the stack.
+  size_t            stack_len;          ///< Number of states in \ref stack.
+  size_t            stack_cap;          ///< Capacity of \ref stack.
+  md_code_fence_t   code_fence;         ///< Copy of md_parser::code_fence.
+  html_state_t      html_state;         ///< Copy of md_parser::html_state.
+  md_seq_t          next_seq_num;       ///< Copy of md_parser::next_seq_num.
+  bool              blank_line;         ///< Copy of md_parser::prev_blank_line.
+
+  /// Copy of md_parser::prev_code_fence_end.
+  bool              code_fence_end;
+
+  /// Copy of md_parser::prev_link_label_has_title.
+  bool              link_label_has_title;
 };
-typedef struct md_code_fence md_code_fence_t;
+typedef struct md_snapshot md_snapshot_t;
 
-typedef ssize_t md_stack_pos_t;         ///< Markdown stack position type.
+/**
+ * The parser state before a line of an \ref md_doc.
+ */
+struct md_checkpoint {
+  size_t        line;                   ///< Index of the line.
+  md_snapshot_t snap;                   ///< Parser state before \ref line.
+};
+typedef struct md_checkpoint md_checkpoint_t;
 
 // local constant definitions
 
 /// HTML element name maximum length.
 #define HTML_ELEMENT_CHAR_MAX    10
 
+/// Number of bits of a hash for \ref html_element_table.
+#define HTML_ELEMENT_HASH_BITS    8
+
+/**
+ * Seed for html_element_hash() chosen so that no two elements of
+ * \ref HTML_BLOCK_ELEMENT nor \ref HTML_PRE_ELEMENT hash to the same entry of
+ * \ref html_element_table.
+ */
+#define HTML_ELEMENT_HASH_SEED    560760u
+
+/// Number of md_block objects to allocate by default.
+#define MD_BLOCK_ALLOC_DEFAULT   16
+
+/// Maximum number of lines between \ref md_checkpoint objects.
+#define MD_CHECKPOINT_LINES_MAX  32
+
 /// Maximum number of `#` in an atx header.
 #define MD_ATX_CHAR_MAX           6
 
@@ -179,11 +221,8 @@ typedef ssize_t md_stack_pos_t;         ///< Markdown stack position type.
 /// Ordered list minimum indent.
 #define MD_OL_INDENT_MIN          3
 
-/// Number of md_state objects to allocate by default.
-#define MD_STATE_ALLOC_DEFAULT    5
-
-/// Number of md_state objects to increment by.
-#define MD_STATE_ALLOC_INCREMENT  5
+/// Minimum width of a table column so its delimiter row has `---` at least.
+#define MD_TABLE_COL_WIDTH_MIN    3
 
 /**
  * Block-level HTML 5 elements.
@@ -209,20 +248,52 @@ static char const *const HTML_BLOCK_ELEMENT[] = {
   "video"
 };
 
-// local variable definitions
-static html_state_t   curr_html_state;  ///< Current HTML state.
-static md_state_t    *md_stack;         ///< Global stack of Markdown states.
-static md_stack_pos_t md_stack_top;     ///< Top of \ref md_stack.
-static md_seq_t       next_seq_num;     ///< Next sequence number.
-static bool           prev_blank_line;  ///< Previous blank line.
+/**
+ * Pre-formatted block-level HTML elements.
+ */
+static char const *const HTML_PRE_ELEMENT[] = {
+  "pre", "script", "style"
+};
+
+/**
+ * The kinds of Markdown lines that a line can possibly be given its first
+ * non-whitespace character so that markdown_parse() calls only those
+ * `md_is_*()` functions that could match.
+ */
+static md_class_t const MD_FIRST_CHAR_CLASS[256] = {
+  ['#'] = MD_CLASS_ATX,
+  ['*'] = MD_CLASS_ABBR | MD_CLASS_HR | MD_CLASS_UL,
+  ['+'] = MD_CLASS_UL,
+  ['-'] = MD_CLASS_DOX_OL | MD_CLASS_HR | MD_CLASS_SETEXT | MD_CLASS_UL,
+  ['0'] = MD_CLASS_OL, ['1'] = MD_CLASS_OL, ['2'] = MD_CLASS_OL,
+  ['3'] = MD_CLASS_OL, ['4'] = MD_CLASS_OL, ['5'] = MD_CLASS_OL,
+  ['6'] = MD_CLASS_OL, ['7'] = MD_CLASS_OL, ['8'] = MD_CLASS_OL,
+  ['9'] = MD_CLASS_OL,
+  [':'] = MD_CLASS_DL,
+  ['<'] = MD_CLASS_HTML,
+  ['='] = MD_CLASS_SETEXT,
+  ['['] = MD_CLASS_LINK,
+  ['_'] = MD_CLASS_HR,
+  ['`'] = MD_CLASS_CODE_FENCE,
+  ['~'] = MD_CLASS_CODE_FENCE,
+};
 
-/// Previous value for `code_fence_end` in markdown_parse().
-static bool           prev_code_fence_end;
+// local variable definitions
 
-/// Previous value for `link_lable_has_title` in markdown_parse().
-static bool           prev_link_label_has_title;
+/// Perfect hash table of all HTML block-level elements.
+static html_element_t html_element_table[ 1u << HTML_ELEMENT_HASH_BITS ];
 
 // local functions
+NODISCARD
+static unsigned       html_element_hash( char const* );
+
+static void           html_element_table_init( void );
+
+NODISCARD
+static char const*    md_autolink_end( char const* ),
+                 *    md_code_span_end( char const*, size_t ),
+                 *    md_link_dest_end( char const* );
+
 NODISCARD
 static bool           md_is_code_fence( char const*, md_code_fence_t* ),
                       md_is_dl_ul_helper( char const*, md_indent_t* );
@@ -231,48 +302,63 @@ NODISCARD
 static html_state_t   md_is_html_tag( char const*, bool* );
 
 NODISCARD
-static md_line_t      md_nested_within( void );
+static md_line_t      md_nested_within( md_parser_t* );
 
 NODISCARD
-static unsigned       md_ol_digits( md_ol_t );
+static md_seq_t       md_seq_remap( md_seq_t, md_snapshot_t const*,
+                                    md_snapshot_t const* );
 
 NODISCARD
-static char const*    skip_html_tag( char const*, bool* );
+static bool           md_snapshot_converged( md_snapshot_t const*,
+                                             md_snapshot_t const* );
 
 NODISCARD
-static int            str_ptr_cmp( char const**, char const** );
+static bool           md_state_same( md_state_t const*, md_state_t const* );
+
+static void           md_doc_add_block( md_doc_t*, md_block_t const* ),
+                      md_doc_add_checkpoint( md_doc_t*, size_t,
+                                             md_snapshot_t* ),
+                      md_snapshot_free( md_snapshot_t* ),
+                      md_snapshot_restore( md_parser_t*,
+                                           md_snapshot_t const* ),
+                      md_snapshot_save( md_parser_t*, md_snapshot_t* ),
+                      md_snapshot_remap( md_snapshot_t*, md_snapshot_t const*,
+                                         md_snapshot_t const* ),
+                      md_stack_push( md_parser_t*, md_line_t, md_indent_t,
+                                     md_indent_t );
 
-////////// inline functions ///////////////////////////////////////////////////
+NODISCARD
+static unsigned       md_ol_digits( md_ol_t );
 
-/**
- * Checks whether \a s is an HTML block-level element.
- *
- * @param s The null-terminated string to check. It is assumed to have been
- * converted to lower-case.
- * @return Returns `true` only if \a s is an HTML block-level element.
- */
 NODISCARD
-static inline bool is_html_block_element( char const *s ) {
-  return NULL != bsearch(
-    &s, HTML_BLOCK_ELEMENT, ARRAY_SIZE( HTML_BLOCK_ELEMENT ),
-    sizeof( HTML_BLOCK_ELEMENT[0] ),
-    POINTER_CAST( bsearch_cmp_fn_t, &str_ptr_cmp )
-  );
-}
+static bool           md_table_is_delim_row( md_table_t const*,
+                                             md_table_row_t const* );
+
+static void           md_table_add_cell( md_table_t*, size_t, char const*,
+                                         char const* ),
+                      md_table_put( line_buf_t*, size_t*, char const*,
+                                    size_t ),
+                      md_table_put_n( line_buf_t*, size_t*, char, size_t );
+
+NODISCARD
+static char const*    skip_html_tag( char const*, bool* );
+
+////////// inline functions ///////////////////////////////////////////////////
 
 /**
- * Checks whether \a s is an HTML pre-formatted block-level element.
+ * Gets the kind of HTML block-level element \a s is, if any.
  *
  * @param s The null-terminated string to check. It is assumed to have been
  * converted to lower-case.
- * @return Returns `true` only if \a s is an HTML pre-formatted block-level
- * element.
+ * @return Returns #HTML_PRE if \a s is an HTML pre-formatted block-level
+ * element, #HTML_ELEMENT if \a s is any other HTML block-level element, or
+ * #HTML_NONE if \a s isn't an HTML block-level element.
  */
 NODISCARD
-static inline bool is_html_pre_element( char const *s ) {
-  return  strcmp( s, "pre"    ) == 0 ||
-          strcmp( s, "script" ) == 0 ||
-          strcmp( s, "style"  ) == 0;
+static inline html_state_t html_element_state( char const *s ) {
+  html_element_t const *const e = &html_element_table[ html_element_hash( s ) ];
+  return e->name != NULL && strcmp( s, e->name ) == 0 ?
+    e->html_state : HTML_NONE;
 }
 
 /**
@@ -331,89 +417,128 @@ static inline bool md_is_ol_sep_char( char c ) {
   return c == '.' || c == ')';
 }
 
+/**
+ * Gets the bottom of the Markdown state stack of \a parser.
+ *
+ * @param parser The \ref md_parser to use.
+ * @return Returns md_parser::spill if the stack was ever deeper than
+ * #MD_STACK_INLINE_MAX or md_parser::stack_inline otherwise.
+ */
+NODISCARD
+static inline md_state_t* md_stack_base( md_parser_t *parser ) {
+  return parser->spill != NULL ? parser->spill : parser->stack_inline;
+}
+
 /**
  * Clears the Markdown stack down to the initial element.
+ *
+ * @param parser The \ref md_parser to use.
  */
-static inline void md_stack_clear( void ) {
-  md_stack_top = 0;
+static inline void md_stack_clear( md_parser_t *parser ) {
+  parser->top = 0;
 }
 
 /**
  * Checks whether the Markdown state stack is empty.
  *
+ * @param parser The \ref md_parser to use.
  * @return Returns `true` only if it is.
  */
 NODISCARD
-static inline bool md_stack_empty( void ) {
-  return md_stack_top < 0;
+static inline bool md_stack_empty( md_parser_t const *parser ) {
+  return parser->top < 0;
 }
 
 /**
  * Gets the size of the Markdown state stack.
  *
+ * @param parser The \ref md_parser to use.
  * @return Returns said size.
  */
 NODISCARD
-static inline size_t md_stack_size( void ) {
-  return STATIC_CAST( size_t, md_stack_top + 1 );
+static inline size_t md_stack_size( md_parser_t const *parser ) {
+  return STATIC_CAST( size_t, parser->top + 1 );
 }
 
 /**
  * Checks whether the line type that's part of the Markdown state on the top of
  * the stack is a particular type.
  *
+ * @param parser The \ref md_parser to use.
  * @param line_type The line type to check for.
  * @return Returns `true` only if it is.
  */
 NODISCARD
-static inline bool md_top_is( md_line_t line_type ) {
-  return MD_TOP.line_type == line_type;
+static inline bool md_top_is( md_parser_t *parser, md_line_t line_type ) {
+  return MD_TOP(parser).line_type == line_type;
 }
 
 /**
  * Calculates the minimum indent needed to be considered a line of code.
  *
+ * @param parser The \ref md_parser to use.
  * @return Returns said indent.
  */
 NODISCARD
-static inline md_indent_t md_code_indent_min( void ) {
-  return (md_stack_size() - md_top_is( MD_CODE )) * MD_CODE_INDENT_MIN;
+static inline md_indent_t md_code_indent_min( md_parser_t *parser ) {
+  return (md_stack_size( parser ) - md_top_is( parser, MD_CODE )) *
+    MD_CODE_INDENT_MIN;
 }
 
 ////////// local functions ////////////////////////////////////////////////////
 
 /**
- * Gets a pointer to the first non-whitespace character in \a s.
+ * Hashes the name of an HTML element using 32-bit FNV-1a.
+ *
+ * @param s The null-terminated element name to hash.
+ * @return Returns an index into \ref html_element_table.
  *
- * @param s The null-terminated line to use.
- * @param indent_left A pointer to receive the amount of indentation (with tabs
- * converted to equivalent spaces).
- * @return Returns a pointer to the first non-whitespace character.
+ * @sa [FNV Hash](http://www.isthe.com/chongo/tech/comp/fnv/)
  */
 NODISCARD
-static char* first_non_whitespace( char *s, md_indent_t *indent_left ) {
+static unsigned html_element_hash( char const *s ) {
   assert( s != NULL );
-  assert( indent_left != NULL );
+  uint32_t h = HTML_ELEMENT_HASH_SEED;
+  while ( *s != '\0' )
+    h = (h ^ STATIC_CAST( unsigned char, *s++ )) * 16777619u;
+  return h >> (32 - HTML_ELEMENT_HASH_BITS);
+}
 
-  *indent_left = 0;
-  for ( size_t tab_pos = 0; *s != '\0'; ++s, ++tab_pos ) {
-    switch ( *s ) {
-      case '\t':
-        *indent_left += MD_TAB_SPACES - tab_pos % MD_TAB_SPACES;
-        break;
-      case '\r':
-      case '\n':
-        break;
-      case ' ':
-        ++*indent_left;
-        break;
-      default:
-        goto done;
-    } // switch
+/**
+ * Adds all of \a elements to \ref html_element_table.
+ *
+ * @param elements The array of element names to add.
+ * @param n_elements The number of elements in \a elements.
+ * @param html_state The \ref html_state for each element.
+ */
+static void html_element_table_add( char const *const elements[],
+                                    size_t n_elements,
+                                    html_state_t html_state ) {
+  for ( size_t i = 0; i < n_elements; ++i ) {
+    html_element_t *const e =
+      &html_element_table[ html_element_hash( elements[i] ) ];
+    if ( e->name != NULL ) {
+      INTERNAL_ERROR(
+        "HTML elements \"%s\" and \"%s\" hash to the same value;"
+        " change HTML_ELEMENT_HASH_SEED\n",
+        e->name, elements[i]
+      );
+    }
+    e->name = elements[i];
+    e->html_state = html_state;
   } // for
+}
 
-done:
-  return s;
+/**
+ * Initializes \ref html_element_table.
+ */
+static void html_element_table_init( void ) {
+  html_element_table_add(
+    HTML_BLOCK_ELEMENT, ARRAY_SIZE( HTML_BLOCK_ELEMENT ), HTML_ELEMENT
+  );
+  html_element_table_add(
+    HTML_PRE_ELEMENT, ARRAY_SIZE( HTML_PRE_ELEMENT ), HTML_PRE
+  );
 }
 
 /**
@@ -440,10 +565,107 @@ static char const* is_uri_scheme( char const *s ) {
 }
 
 /**
- * Cleans-up all Markdown data.
+ * Checks whether \a s is the start of an autolink, i.e., either a URI or an
+ * e-mail address between `<` and `>`.
+ *
+ * @param s The null-terminated string to check.  It must start with `<`.
+ * @return Returns a pointer within \a s just after the `>` if \a s is an
+ * autolink or null otherwise.
+ *
+ * @sa [CommonMark: Autolinks](https://spec.commonmark.org/0.31.2/#autolinks)
+ */
+NODISCARD
+static char const* md_autolink_end( char const *s ) {
+  assert( s != NULL );
+  assert( s[0] == '<' );
+
+  ++s;
+  size_t const len = strcspn( s, " \t\r\n<>" );
+  if ( len == 0 || s[ len ] != '>' )
+    return NULL;
+  char const *const scheme_end = is_uri_scheme( s );
+  if ( scheme_end != NULL ) {
+    size_t const scheme_len = STATIC_CAST( size_t, scheme_end - s ) - 1;
+    if ( scheme_len < 2 || scheme_len > 32 )
+      return NULL;
+  }
+  else if ( memchr( s, '@', len ) == NULL ) {
+    return NULL;
+  }
+  return s + len + 1;
+}
+
+/**
+ * Gets the end of a code span whose opening backtick string has \a n_ticks
+ * backticks, i.e., the next backtick string of exactly that many backticks.
+ *
+ * @param s The null-terminated string just after the opening backtick string.
+ * @param n_ticks The number of backticks of the opening backtick string.
+ * @return Returns a pointer within \a s just after the closing backtick string
+ * or null if there is none.
+ *
+ * @sa [CommonMark: Code spans](https://spec.commonmark.org/0.31.2/#code-spans)
+ */
+NODISCARD
+static char const* md_code_span_end( char const *s, size_t n_ticks ) {
+  assert( s != NULL );
+  while ( (s = strchr( s, '`' )) != NULL ) {
+    size_t const len = strspn( s, "`" );
+    s += len;
+    if ( len == n_ticks )
+      return s;
+  } // while
+  return NULL;
+}
+
+/**
+ * Appends a block to \a doc or, if it has the same line type and sequence
+ * number as the last block, extends the last block by it.
+ *
+ * @param doc The \ref md_doc to append to.
+ * @param block The \ref md_block to append.
  */
-static void markdown_cleanup( void ) {
-  FREE( md_stack );
+static void md_doc_add_block( md_doc_t *doc, md_block_t const *block ) {
+  assert( doc != NULL );
+  assert( block != NULL );
+
+  if ( doc->len > 0 ) {
+    md_block_t *const last = &doc->blocks[ doc->len - 1 ];
+    if ( last->line_type == block->line_type &&
+         last->seq_num == block->seq_num ) {
+      assert( last->line_first + last->line_count == block->line_first );
+      last->line_count += block->line_count;
+      return;
+    }
+  }
+  if ( doc->len == doc->cap ) {
+    doc->cap = doc->cap == 0 ? MD_BLOCK_ALLOC_DEFAULT : doc->cap * 2;
+    REALLOC( doc->blocks, md_block_t, doc->cap );
+  }
+  doc->blocks[ doc->len++ ] = *block;
+}
+
+/**
+ * Appends a checkpoint to \a doc.
+ *
+ * @param doc The \ref md_doc to append to.
+ * @param line The index of the line.
+ * @param snap The parser state before \a line.  Ownership of its memory is
+ * transferred to \a doc and it's reset to empty.
+ */
+static void md_doc_add_checkpoint( md_doc_t *doc, size_t line,
+                                   md_snapshot_t *snap ) {
+  assert( doc != NULL );
+  assert( snap != NULL );
+
+  if ( doc->checkpoints_len == doc->checkpoints_cap ) {
+    doc->checkpoints_cap = doc->checkpoints_cap == 0 ?
+      MD_BLOCK_ALLOC_DEFAULT : doc->checkpoints_cap * 2;
+    REALLOC( doc->checkpoints, md_checkpoint_t, doc->checkpoints_cap );
+  }
+  doc->checkpoints[ doc->checkpoints_len++ ] =
+    (md_checkpoint_t){ .line = line, .snap = *snap };
+  *snap = (md_snapshot_t){ 0 };
 }
 
 /**
@@ -456,12 +678,14 @@ static void markdown_cleanup( void ) {
  * As a special case, we also allow 2 spaces per indent for definition and
  * unordered lists.
  *
+ * @param parser The \ref md_parser to use.
  * @param indent_left The raw indent (in spaces).
  * @return Returns the preferred divisor.
  */
 NODISCARD
-static md_indent_t md_indent_divisor( md_indent_t indent_left ) {
-  md_line_t const line_type = md_nested_within();
+static md_indent_t md_indent_divisor( md_parser_t *parser,
+                                      md_indent_t indent_left ) {
+  md_line_t const line_type = md_nested_within( parser );
   bool const dl_or_ul = line_type == MD_DL || line_type == MD_UL;
   md_indent_t const mod_a =            indent_left % MD_LIST_INDENT_MAX     ;
   md_indent_t const mod_b =            indent_left % MD_OL_INDENT_MIN       ;
@@ -789,7 +1013,9 @@ static html_state_t md_is_html_tag( char const *s, bool *is_end_tag ) {
     element[ len++ ] = STATIC_CAST( char, tolower( *s++ ) );
   } // for
 
-  if ( is_html_pre_element( element ) ) {
+  html_state_t const element_state = html_element_state( element );
+
+  if ( element_state == HTML_PRE ) {
     if ( !*is_end_tag ) {
       //
       // Does the HTML block end on the same line as it starts?
@@ -799,7 +1025,7 @@ static html_state_t md_is_html_tag( char const *s, bool *is_end_tag ) {
     return HTML_PRE;
   }
 
-  if ( is_html_block_element( element ) )
+  if ( element_state == HTML_ELEMENT )
     return HTML_ELEMENT;
 
   //
@@ -977,15 +1203,65 @@ static bool md_is_Setext_header( char const *s ) {
   return true;
 }
 
+/**
+ * Gets the end of a link destination, either one between `<` and `>` or a
+ * nonempty run of non-whitespace characters having balanced parentheses,
+ * including the closing `)` of the link, if it immediately follows.
+ *
+ * @param s The null-terminated string just after the `](`.
+ * @return Returns a pointer within \a s just after the destination or null if
+ * there is none.
+ *
+ * @sa [CommonMark: Links](https://spec.commonmark.org/0.31.2/#links)
+ */
+NODISCARD
+static char const* md_link_dest_end( char const *s ) {
+  assert( s != NULL );
+
+  if ( s[0] == '<' ) {
+    size_t const len = strcspn( ++s, "\n<>" );
+    if ( s[ len ] != '>' )
+      return NULL;
+    s += len + 1;
+  }
+  else {
+    char const *const dest = s;
+    for ( unsigned depth = 0; ; ++s ) {
+      switch ( *s ) {
+        case '(':
+          ++depth;
+          continue;
+        case ')':
+          if ( depth == 0 )
+            break;
+          --depth;
+          continue;
+        case '\\':
+          if ( s[1] != '\0' )
+            ++s;
+          continue;
+        default:
+          if ( !is_space( *s ) && !iscntrl( STATIC_CAST( unsigned char, *s ) ) )
+            continue;
+      } // switch
+      break;
+    } // for
+    if ( s == dest )
+      return NULL;
+  }
+  return s[0] == ')' ? s + 1 : s;
+}
+
 /**
  * Checks the innermost enclosing nestable line type, if any.
  *
+ * @param parser The \ref md_parser to use.
  * @return Returns said line type or MD_NONE if none.
  */
 NODISCARD
-static md_line_t md_nested_within( void ) {
-  for ( md_stack_pos_t pos = md_stack_top; pos >= 0; --pos ) {
-    md_line_t const line_type = MD_STACK(pos).line_type;
+static md_line_t md_nested_within( md_parser_t *parser ) {
+  for ( md_stack_pos_t pos = parser->top; pos >= 0; --pos ) {
+    md_line_t const line_type = MD_STACK(parser,pos).line_type;
     if ( md_is_nestable( line_type ) )
       return line_type;
   } // for
@@ -1038,6 +1314,293 @@ static void md_renumber_ol( char *s, md_ol_t old_n, md_ol_t new_n ) {
   }
 }
 
+/**
+ * Maps a sequence number of a parse that reached state \a old_conv to that of
+ * one that reached the equivalent state \a new_conv.  Every sequence number
+ * used after that point is either that of a state on the stack or one not yet
+ * used (greater than md_parser::next_seq_num since that's the last one used).
+ *
+ * @param seq_num The sequence number to map.
+ * @param old_conv The parser state the old parse reached.
+ * @param new_conv The equivalent parser state the new parse reached.
+ * @return Returns the mapped sequence number.
+ *
+ * @sa md_snapshot_converged()
+ */
+NODISCARD
+static md_seq_t md_seq_remap( md_seq_t seq_num, md_snapshot_t const *old_conv,
+                              md_snapshot_t const *new_conv ) {
+  assert( old_conv != NULL );
+  assert( new_conv != NULL );
+
+  if ( seq_num > old_conv->next_seq_num )  // not yet used at that point
+    return seq_num - old_conv->next_seq_num + new_conv->next_seq_num;
+  for ( size_t i = 0; i < old_conv->stack_len; ++i ) {
+    if ( old_conv->stack[i].seq_num == seq_num )
+      return new_conv->stack[i].seq_num;
+  } // for
+  return seq_num;
+}
+
+/**
+ * Checks whether the parser state \a new_snap is the same as \a old_snap,
+ * i.e., that parsing will proceed identically from either.  Since sequence
+ * numbers are arbitrary, those need only correspond one-to-one.
+ *
+ * @param old_snap The parser state previously saved.
+ * @param new_snap The parser state now.
+ * @return Returns `true` only if the states are the same.
+ *
+ * @sa md_seq_remap()
+ */
+NODISCARD
+static bool md_snapshot_converged( md_snapshot_t const *old_snap,
+                                   md_snapshot_t const *new_snap ) {
+  assert( old_snap != NULL );
+  assert( new_snap != NULL );
+
+  if ( old_snap->stack_len != new_snap->stack_len ||
+       old_snap->code_fence.cf_c != new_snap->code_fence.cf_c ||
+       old_snap->code_fence.cf_len != new_snap->code_fence.cf_len ||
+       old_snap->html_state != new_snap->html_state ||
+       old_snap->blank_line != new_snap->blank_line ||
+       old_snap->code_fence_end != new_snap->code_fence_end ||
+       old_snap->link_label_has_title != new_snap->link_label_has_title ) {
+    return false;
+  }
+
+  for ( size_t i = 0; i < old_snap->stack_len; ++i ) {
+    if ( !md_state_same( &old_snap->stack[i], &new_snap->stack[i] ) )
+      return false;
+  } // for
+  return true;
+}
+
+/**
+ * Frees all memory used by \a snap _but not_ \a snap itself.
+ *
+ * @param snap The \ref md_snapshot to free.
+ */
+static void md_snapshot_free( md_snapshot_t *snap ) {
+  assert( snap != NULL );
+  FREE( snap->stack );
+}
+
+/**
+ * Restores the parser state from \a snap.
+ *
+ * @param parser The \ref md_parser to restore into.
+ * @param snap The \ref md_snapshot to restore from.
+ *
+ * @sa md_snapshot_save()
+ */
+static void md_snapshot_restore( md_parser_t *parser,
+                                 md_snapshot_t const *snap ) {
+  assert( snap != NULL );
+  assert( snap->stack_len > 0 );
+
+  parser->top = -1;
+  for ( size_t i = 0; i < snap->stack_len; ++i ) {
+    md_stack_push( parser, MD_NONE, 0, 0 ); // ensures capacity
+    MD_TOP(parser) = snap->stack[i];
+  } // for
+  parser->code_fence = snap->code_fence;
+  parser->html_state = snap->html_state;
+  parser->next_seq_num = snap->next_seq_num;
+  parser->prev_blank_line = snap->blank_line;
+  parser->prev_code_fence_end = snap->code_fence_end;
+  parser->prev_link_label_has_title = snap->link_label_has_title;
+}
+
+/**
+ * Saves the parser state into \a snap.
+ *
+ * @param parser The \ref md_parser to save.
+ * @param snap The \ref md_snapshot to save into.  It's reused if it already
+ * contains a state.
+ *
+ * @sa md_snapshot_restore()
+ */
+static void md_snapshot_save( md_parser_t *parser, md_snapshot_t *snap ) {
+  assert( snap != NULL );
+
+  snap->stack_len = md_stack_size( parser );
+  if ( snap->stack_len > snap->stack_cap ) {
+    snap->stack_cap = snap->stack_len;
+    REALLOC( snap->stack, md_state_t, snap->stack_cap );
+  }
+  memcpy(
+    snap->stack, md_stack_base( parser ),
+    snap->stack_len * sizeof( md_state_t )
+  );
+  snap->code_fence = parser->code_fence;
+  snap->html_state = parser->html_state;
+  snap->next_seq_num = parser->next_seq_num;
+  snap->blank_line = parser->prev_blank_line;
+  snap->code_fence_end = parser->prev_code_fence_end;
+  snap->link_label_has_title = parser->prev_link_label_has_title;
+}
+
+/**
+ * Maps the sequence numbers in \a snap from those of a parse that reached
+ * state \a old_conv to those of one that reached \a new_conv.
+ *
+ * @param snap The \ref md_snapshot to adjust.
+ * @param old_conv The parser state the old parse reached.
+ * @param new_conv The equivalent parser state the new parse reached.
+ *
+ * @sa md_seq_remap()
+ */
+static void md_snapshot_remap( md_snapshot_t *snap,
+                               md_snapshot_t const *old_conv,
+                               md_snapshot_t const *new_conv ) {
+  assert( snap != NULL );
+  for ( size_t i = 0; i < snap->stack_len; ++i ) {
+    snap->stack[i].seq_num =
+      md_seq_remap( snap->stack[i].seq_num, old_conv, new_conv );
+  } // for
+  snap->next_seq_num = md_seq_remap( snap->next_seq_num, old_conv, new_conv );
+}
+
+/**
+ * Checks whether \a new_state is the same as \a old_state except for their
+ * sequence numbers that are arbitrary.
+ *
+ * @param old_state The old \ref md_state.
+ * @param new_state The new \ref md_state.
+ * @return Returns `true` only if the states are the same.
+ */
+NODISCARD
+static bool md_state_same( md_state_t const *old_state,
+                           md_state_t const *new_state ) {
+  assert( old_state != NULL );
+  assert( new_state != NULL );
+  return  new_state->line_type == old_state->line_type &&
+          new_state->depth == old_state->depth &&
+          new_state->footnote_def_has_text ==
+            old_state->footnote_def_has_text &&
+          new_state->indent_left == old_state->indent_left &&
+          new_state->indent_hang == old_state->indent_hang &&
+          new_state->ol_c == old_state->ol_c &&
+          new_state->ol_num == old_state->ol_num;
+}
+
+/**
+ * Adds a cell to \a table.
+ *
+ * @param table The \ref md_table to add to.
+ * @param col The index of the cell's column.
+ * @param begin A pointer to the first character of the cell.
+ * @param end A pointer to one past the last character of the cell.
+ */
+static void md_table_add_cell( md_table_t *table, size_t col,
+                                 char const *begin, char const *end ) {
+  assert( table != NULL );
+  assert( begin <= end );
+
+  while ( begin < end && isspace( *begin ) )
+    ++begin;
+  while ( end > begin && isspace( end[-1] ) )
+    --end;
+  size_t const len = STATIC_CAST( size_t, end - begin );
+
+  size_t width = 0;
+  for ( char const *s = begin; s < end; ++s ) {
+    if ( !utf8_is_cont( *s ) )
+      width += utf8_width( s );
+  } // for
+
+  line_buf_reserve( &table->text, table->text_len + len );
+  memcpy( table->text.str + table->text_len, begin, len );
+
+  if ( table->cells_len == table->cells_cap ) {
+    table->cells_cap = table->cells_cap == 0 ?
+      MD_BLOCK_ALLOC_DEFAULT : table->cells_cap * 2;
+    REALLOC( table->cells, md_table_cell_t, table->cells_cap );
+  }
+  table->cells[ table->cells_len++ ] = (md_table_cell_t){
+    .text_offset = table->text_len,
+    .text_len    = len,
+    .width       = width
+  };
+  table->text_len += len;
+
+  if ( col == table->cols_len ) {
+    if ( table->cols_len == table->cols_cap ) {
+      table->cols_cap = table->cols_cap == 0 ?
+        MD_BLOCK_ALLOC_DEFAULT : table->cols_cap * 2;
+      REALLOC( table->col_width, size_t, table->cols_cap );
+      REALLOC( table->col_align, md_table_align_t, table->cols_cap );
+    }
+    table->col_width[ col ] = 0;
+    table->col_align[ col ] = MD_TABLE_ALIGN_NONE;
+    ++table->cols_len;
+  }
+}
+
+/**
+ * Checks whether \a row of \a table is a delimiter row, i.e., every cell is
+ * one or more `-` optionally preceded and followed by `:`.
+ *
+ * @param table The \ref md_table \a row is part of.
+ * @param row The \ref md_table_row to check.
+ * @return Returns `true` only if it is.
+ */
+NODISCARD
+static bool md_table_is_delim_row( md_table_t const *table,
+                                   md_table_row_t const *row ) {
+  assert( table != NULL );
+  assert( row != NULL );
+
+  for ( size_t c = 0; c < row->cells_len; ++c ) {
+    md_table_cell_t const *const cell = &table->cells[ row->cells_first + c ];
+    char const *s = table->text.str + cell->text_offset;
+    char const *const end = s + cell->text_len;
+    if ( s < end && *s == ':' )
+      ++s;
+    if ( s == end || *s != '-' )
+      return false;
+    while ( s < end && *s == '-' )
+      ++s;
+    if ( s < end && *s == ':' )
+      ++s;
+    if ( s != end )
+      return false;
+  } // for
+  return true;
+}
+
+/**
+ * Appends characters to the output buffer of md_table_format().
+ *
+ * @param out The buffer to append to.
+ * @param out_len A pointer to the length of \a out.
+ * @param s The characters to append.
+ * @param s_len The number of characters to append.
+ */
+static void md_table_put( line_buf_t *out, size_t *out_len, char const *s,
+                          size_t s_len ) {
+  line_buf_reserve( out, *out_len + s_len );
+  memcpy( out->str + *out_len, s, s_len );
+  *out_len += s_len;
+}
+
+/**
+ * Appends a character some number of times to the output buffer of
+ * md_table_format().
+ *
+ * @param out The buffer to append to.
+ * @param out_len A pointer to the length of \a out.
+ * @param c The character to append.
+ * @param n The number of times to append \a c.
+ */
+static void md_table_put_n( line_buf_t *out, size_t *out_len, char c,
+                            size_t n ) {
+  line_buf_reserve( out, *out_len + n );
+  memset( out->str + *out_len, c, n );
+  *out_len += n;
+}
+
 /**
  * Skips past the end of the current HTML (or XML) tag.
  *
@@ -1088,117 +1651,267 @@ static char const* skip_html_tag( char const *s, bool *is_end_tag ) {
 
 /**
  * Pops a Markdown state from the stack.
+ *
+ * @param parser The \ref md_parser to use.
  */
-static void md_stack_pop( void ) {
+static void md_stack_pop( md_parser_t *parser ) {
   MD_DEBUG( "%s()\n", __func__ );
-  assert( !md_stack_empty() );
-  --md_stack_top;
+  assert( !md_stack_empty( parser ) );
+  PROBE2( md_pop, MD_TOP(parser).line_type, MD_TOP(parser).depth );
+  --parser->top;
 }
 
 /**
  * Pushes a new Markdown state onto the stack.
  *
+ * @param parser The \ref md_parser to use.
  * @param line_type The type of line.
  * @param indent_left The left indent (in spaces).
  * @param indent_hang The indent relative to \a indent_left for a hang-indent.
  */
-static void md_stack_push( md_line_t line_type, md_indent_t indent_left,
-                           md_indent_t indent_hang ) {
-  static size_t md_stack_capacity = 0;
-
+static void md_stack_push( md_parser_t *parser, md_line_t line_type,
+                           md_indent_t indent_left, md_indent_t indent_hang ) {
   MD_DEBUG(
     "%s(): T=%c L=%u H=%u\n",
     __func__, line_type, indent_left, indent_hang
   );
 
-  ++md_stack_top;
-  if ( md_stack_capacity == 0 ) {
-    md_stack_capacity = MD_STATE_ALLOC_DEFAULT;
-    md_stack = MALLOC( md_state_t, md_stack_capacity );
-  } else if ( STATIC_CAST( size_t, md_stack_top ) >= md_stack_capacity ) {
-    md_stack_capacity += MD_STATE_ALLOC_INCREMENT;
-    REALLOC( md_stack, md_state_t, md_stack_capacity );
+  ++parser->top;
+  size_t const size = md_stack_size( parser );
+  if ( parser->spill == NULL ) {
+    if ( size > MD_STACK_INLINE_MAX ) {
+      parser->spill_cap = MD_STACK_INLINE_MAX * 2;
+      parser->spill = MALLOC( md_state_t, parser->spill_cap );
+      memcpy(
+        parser->spill, parser->stack_inline, sizeof parser->stack_inline
+      );
+    }
+  }
+  else if ( size > parser->spill_cap ) {
+    parser->spill_cap *= 2;
+    REALLOC( parser->spill, md_state_t, parser->spill_cap );
   }
-  PERROR_EXIT_IF( md_stack == NULL, EX_OSERR );
 
-  md_state_t *const top = &MD_TOP;
+  md_state_t *const top = &MD_TOP(parser);
   *top = (md_state_t){
     .line_type   = line_type,
-    .seq_num     = ++next_seq_num,
-    .depth       = md_stack_size() > 0 ? md_stack_size() - 1 : 0,
+    .seq_num     = ++parser->next_seq_num,
+    .depth       = size > 0 ? size - 1 : 0,
     .indent_left = indent_left,
     .indent_hang = indent_hang,
     .ol_c        = '\0',
     .ol_num      = 0
   };
+  PROBE2( md_push, line_type, top->depth );
 }
 
-/**
- * Compares two string pointers by comparing the string pointed to.
- *
- * @param i_sptr The first string pointer to compare.
- * @param j_sptr The first string pointer to compare.
- * @return Returns a number less than 0, 0, or greater than 0 if \a *i_sptr is
- * less than, equal to, or greater than \a *j_sptr, respectively.
- */
-NODISCARD
-static int str_ptr_cmp( char const **i_sptr, char const **j_sptr ) {
-  return strcmp( *i_sptr, *j_sptr );
+////////// extern functions ///////////////////////////////////////////////////
+
+html_state_t html_tag_parse( char const *s, char const *end, bool *is_end_tag,
+                             char const **tag_end ) {
+  assert( s != NULL );
+  assert( s < end && s[0] == '<' );
+  assert( is_end_tag != NULL );
+  assert( tag_end != NULL );
+
+  md_init();
+  *is_end_tag = false;
+  *tag_end = NULL;
+
+  if ( ++s == end )
+    return HTML_NONE;
+
+  html_state_t html_state = HTML_NONE;
+  char const *html_end = NULL;          // string that ends special markup
+  //
+  // Is this "special" HTML markup?
+  //
+  if ( s[0] == '?' ) {
+    html_state = HTML_PI;
+    html_end = "?>";
+  }
+  else if ( s[0] == '!' ) {
+    size_t const n = STATIC_CAST( size_t, end - ++s );
+    if ( n >= 2 && STRN_EQ_LIT( s, "--" ) ) {
+      html_state = HTML_COMMENT;
+      html_end = "-->";
+      s += 2;
+    }
+    else if ( n >= 7 && STRN_EQ_LIT( s, "[CDATA[" ) ) {
+      html_state = HTML_CDATA;
+      html_end = "]]>";
+      s += 7;
+    }
+    else if ( n >= 1 && isupper( s[0] ) ) {
+      html_state = HTML_DOCTYPE;
+      html_end = ">";
+    }
+    else {
+      return HTML_NONE;
+    }
+  }
+
+  if ( html_state != HTML_NONE ) {
+    //
+    // Does the special markup end on the same line as it starts?
+    //
+    size_t const html_end_len = strlen( html_end );
+    for ( ; (s = memchr( s, html_end[0], STATIC_CAST( size_t, end - s ) ))
+            != NULL; ++s ) {
+      if ( STATIC_CAST( size_t, end - s ) >= html_end_len &&
+           strncmp( s, html_end, html_end_len ) == 0 ) {
+        *is_end_tag = true;
+        *tag_end = s + html_end_len;
+        break;
+      }
+    } // for
+    return html_state;
+  }
+
+  if ( s[0] == '/' ) {                  // </tag>
+    *is_end_tag = true;
+    ++s;
+  }
+
+  char element[ HTML_ELEMENT_CHAR_MAX + 1/*null*/ ];
+  size_t len = 0;
+  for ( ; s < end && is_html_element_char( *s ); ++s ) {
+    if ( len < HTML_ELEMENT_CHAR_MAX )
+      element[ len ] = STATIC_CAST( char, tolower( *s ) );
+    ++len;
+  } // for
+  if ( len == 0 || (s < end && !(isspace( *s ) || *s == '>' || *s == '/')) )
+    return HTML_NONE;                   // e.g., "a < b"
+
+  //
+  // Find the closing '>' ignoring any within quoted attribute values.
+  //
+  char quote = '\0';
+  for ( ; s < end; ++s ) {
+    if ( quote != '\0' ) {               // ignore everything ...
+      if ( *s == quote )                // ... until matching quote
+        quote = '\0';
+    }
+    else if ( *s == '"' || *s == '\'' ) {
+      quote = *s;                       // start ignoring everything
+    }
+    else if ( *s == '>' ) {
+      if ( s[-1] == '/' )               // <tag/>
+        *is_end_tag = true;
+      *tag_end = s + 1;
+      break;
+    }
+  } // for
+  if ( *tag_end == NULL || len > HTML_ELEMENT_CHAR_MAX )
+    return HTML_NONE;                   // unterminated or not block-level
+  element[ len ] = '\0';
+  return html_element_state( element );
 }
 
-////////// extern functions ///////////////////////////////////////////////////
+void markdown_cleanup( md_parser_t *parser ) {
+  if ( parser == NULL )
+    return;
+  FREE( parser->spill );
+  parser->spill = NULL;
+  parser->spill_cap = 0;
+}
 
-void markdown_init( void ) {
-  RUN_ONCE ATEXIT( &markdown_cleanup );
+void markdown_init( md_parser_t *parser ) {
+  assert( parser != NULL );
+  md_init();
 
-  curr_html_state = HTML_NONE;
-  prev_code_fence_end = false;
-  prev_link_label_has_title = false;
+  md_code_fence_init( &parser->code_fence );
+  parser->html_state = HTML_NONE;
+  parser->prev_code_fence_end = false;
+  parser->prev_link_label_has_title = false;
   //
   // We have to start out prev_blank_line = true because if a "---" occurs as
   // the first line, there is no text line before it so it must be a horizontal
   // rule and not a Setext 2nd-level header.
   //
-  prev_blank_line = true;
+  parser->prev_blank_line = true;
   //
   // Initialize the stack so that it always contains at least one element.
   //
-  md_stack_top = -1;
-  md_stack_push( MD_TEXT, 0, 0 );
+  parser->top = -1;
+  md_stack_push( parser, MD_TEXT, 0, 0 );
 }
 
-md_state_t const* markdown_parse( char *s ) {
-  assert( s != NULL );
+bool markdown_is_initial( md_parser_t *parser, char const *line,
+                          size_t size ) {
+  assert( parser != NULL );
+  assert( line != NULL );
+
+  md_snapshot_t saved = { 0 };
+  md_snapshot_save( parser, &saved );
+  md_parser_t initial = { 0 };
+  markdown_init( &initial );
+
+  //
+  // Parse a copy of the line from each state since an ordered list item's
+  // number may be renumbered in place.
+  //
+  char *const copy = MALLOC( char, size + 1 );
+  md_line_desc_t desc;
+  memcpy( copy, line, size );
+  copy[ size ] = '\0';
+  md_line_desc_init( &desc, copy );
+  md_state_t const state = *markdown_parse( parser, &desc );
+  memcpy( copy, line, size );
+  md_line_desc_init( &desc, copy );
+  md_state_t const initial_state = *markdown_parse( &initial, &desc );
+  FREE( copy );
+
+  md_snapshot_t initial_snap = { 0 }, snap = { 0 };
+  md_snapshot_save( &initial, &initial_snap );
+  md_snapshot_save( parser, &snap );
+  bool const is_initial = md_state_same( &initial_state, &state ) &&
+    md_snapshot_converged( &initial_snap, &snap );
+
+  md_snapshot_restore( parser, &saved );
+  md_snapshot_free( &saved );
+  md_snapshot_free( &snap );
+  md_snapshot_free( &initial_snap );
+  markdown_cleanup( &initial );
+  return is_initial;
+}
+
+md_state_t const* markdown_parse( md_parser_t *parser,
+                                  md_line_desc_t const *desc ) {
+  assert( parser != NULL );
+  assert( desc != NULL );
 
-  static md_code_fence_t code_fence;
-  md_indent_t indent_left;
-  char *const nws = first_non_whitespace( s, &indent_left );
+  char *const s = desc->line;
+  char *const nws = desc->nws;
+  md_indent_t const indent_left = desc->indent_left;
 
-  PREV_BOOL( code_fence_end );
-  PREV_BOOL( link_label_has_title );
+  PREV_BOOL( parser, code_fence_end );
+  PREV_BOOL( parser, link_label_has_title );
 
   /////////////////////////////////////////////////////////////////////////////
 
-  switch ( MD_TOP.line_type ) {
+  switch ( MD_TOP(parser).line_type ) {
     case MD_CODE:
       //
       // Check to see whether we've hit the end of a PHP Markdown Extra code
       // fence.
       //
-      if ( code_fence_end )
-        md_stack_pop();
-      else if ( code_fence.cf_c != '\0' ) {
+      if ( code_fence_end ) {
+        md_stack_pop( parser );
+        md_code_fence_init( &parser->code_fence );
+      }
+      else if ( parser->code_fence.cf_c != '\0' ) {
         //
-        // If code_fence.cf_c is set, that distinguishes a code fence from
-        // indented code.
+        // If code_fence.cf_c is set, that distinguishes a code fence
+        // from indented code.
         //
-        if ( md_is_code_fence_end( nws, &code_fence ) )
-          prev_code_fence_end = true;
+        if ( md_is_code_fence_end( nws, &parser->code_fence ) )
+          parser->prev_code_fence_end = true;
         //
         // As long as we're in the MD_CODE state, we can just return without
         // further checks.
         //
-        return &MD_TOP;
+        return &MD_TOP(parser);
       }
       break;
 
@@ -1210,7 +1923,7 @@ md_state_t const* markdown_parse( char *s ) {
       // These tokens are "one-shot," i.e., they never span multipe lines, so
       // pop them off the stack.
       //
-      md_stack_pop();
+      md_stack_pop( parser );
       break;
 
     case MD_LINK_LABEL:
@@ -1218,8 +1931,8 @@ md_state_t const* markdown_parse( char *s ) {
       // Markdown link label title attributes.
       //
       if ( !link_label_has_title && md_is_link_title( nws ) )
-        return &MD_TOP;
-      md_stack_pop();
+        return &MD_TOP(parser);
+      md_stack_pop( parser );
       break;
 
     case MD_TABLE:
@@ -1231,9 +1944,9 @@ md_state_t const* markdown_parse( char *s ) {
         // As long as we're in the MD_TABLE state and lines continue to be
         // table lines, we can just return without further checks.
         //
-        return &MD_TOP;
+        return &MD_TOP(parser);
       }
-      md_stack_pop();
+      md_stack_pop( parser );
       break;
 
     case MD_DL:
@@ -1258,124 +1971,110 @@ md_state_t const* markdown_parse( char *s ) {
   //  + They disambiguate "---" between a Setext 2nd-level header (that has to
   //    have a text line before it) and a horizontal rule (that doesn't).
   //
-  PREV_BOOL( blank_line );
+  PREV_BOOL( parser, blank_line );
   if ( nws[0] == '\0' ) {               // blank line
-    prev_blank_line = true;
-    return &MD_TOP;
+    parser->prev_blank_line = true;
+    return &MD_TOP(parser);
   }
 
   /////////////////////////////////////////////////////////////////////////////
 
-  if ( md_top_is( MD_HTML_BLOCK ) ) {
+  if ( md_top_is( parser, MD_HTML_BLOCK ) ) {
     //
     // HTML blocks.
     //
-    switch ( curr_html_state ) {
+    switch ( parser->html_state ) {
       case HTML_ELEMENT:
-        if ( blank_line )
-          md_stack_pop();
-        return &MD_TOP;
+        if ( blank_line ) {
+          md_stack_pop( parser );
+          parser->html_state = HTML_NONE;
+        }
+        return &MD_TOP(parser);
       case HTML_END:
-        md_stack_pop();
+        md_stack_pop( parser );
+        parser->html_state = HTML_NONE;
         break;
       default:
-        if ( md_is_html_end( curr_html_state, s ) )
-          curr_html_state = HTML_END;
+        if ( md_is_html_end( parser->html_state, s ) )
+          parser->html_state = HTML_END;
         //
         // As long as we're in the MD_HTML_BLOCK state, we can just return
         // without further checks.
         //
-        return &MD_TOP;
+        return &MD_TOP(parser);
     } // switch
   }
   else {
     //
     // Markdown code blocks.
     //
-    md_indent_t const code_indent_min = md_code_indent_min();
+    md_indent_t const code_indent_min = md_code_indent_min( parser );
     if ( indent_left >= code_indent_min ) {
-      if ( !md_top_is( MD_CODE ) )
-        md_stack_push( MD_CODE, code_indent_min, 0 );
+      if ( !md_top_is( parser, MD_CODE ) )
+        md_stack_push( parser, MD_CODE, code_indent_min, 0 );
       //
       // As long as we're in the MD_CODE state, we can just return without
       // further checks.
       //
-      return &MD_TOP;
+      return &MD_TOP(parser);
     }
   }
 
   /////////////////////////////////////////////////////////////////////////////
 
-  switch ( nws[0] ) {
+  md_class_t const nws_class =
+    MD_FIRST_CHAR_CLASS[ STATIC_CAST( unsigned char, nws[0] ) ];
 
-    // atx headers.
-    case '#':
-      if ( md_is_atx_header( nws ) )
-        CLEAR_RETURN( MD_HEADER_ATX );
-      break;
+  // atx headers.
+  if ( (nws_class & MD_CLASS_ATX) != 0 && md_is_atx_header( nws ) )
+    CLEAR_RETURN( parser, MD_HEADER_ATX );
 
-    // PHP Markdown Extra abbreviations.
-    case '*':
-      if ( md_is_html_abbr( nws ) )
-        CLEAR_RETURN( MD_HTML_ABBR );
-      break;
+  // PHP Markdown Extra abbreviations.
+  if ( (nws_class & MD_CLASS_ABBR) != 0 && md_is_html_abbr( nws ) )
+    CLEAR_RETURN( parser, MD_HTML_ABBR );
 
-    // Setext headers.
-    case '-':
-    case '=':
-      if ( !blank_line && md_is_Setext_header( nws ) )
-        CLEAR_RETURN( MD_HEADER_LINE );
-      break;
+  // Setext headers.
+  if ( (nws_class & MD_CLASS_SETEXT) != 0 && !blank_line &&
+       md_is_Setext_header( nws ) ) {
+    CLEAR_RETURN( parser, MD_HEADER_LINE );
+  }
 
-    // Markdown link labels or PHP Markdown Extra footnote definitions.
-    case '[':
-      if ( indent_left <= MD_LINK_INDENT_MAX ) {
-        bool def_has_text;
-        if ( md_is_footnote_def( nws, &def_has_text ) ) {
-          md_stack_clear();
-          md_stack_push( MD_FOOTNOTE_DEF, 0, MD_FOOTNOTE_INDENT );
-          MD_TOP.footnote_def_has_text = def_has_text;
-          return &MD_TOP;
-        }
-        if ( md_is_link_label( nws, &prev_link_label_has_title ) )
-          CLEAR_RETURN( MD_LINK_LABEL );
-      }
-      break;
+  // Markdown link labels or PHP Markdown Extra footnote definitions.
+  if ( (nws_class & MD_CLASS_LINK) != 0 &&
+       indent_left <= MD_LINK_INDENT_MAX ) {
+    bool def_has_text;
+    if ( md_is_footnote_def( nws, &def_has_text ) ) {
+      md_stack_clear( parser );
+      md_stack_push( parser, MD_FOOTNOTE_DEF, 0, MD_FOOTNOTE_INDENT );
+      MD_TOP(parser).footnote_def_has_text = def_has_text;
+      return &MD_TOP(parser);
+    }
+    if ( md_is_link_label( nws, &parser->prev_link_label_has_title ) )
+      CLEAR_RETURN( parser, MD_LINK_LABEL );
+  }
 
-    // PHP Markdown Extra code fences.
-    case '`':
-    case '~':
-      md_code_fence_init( &code_fence );
-      if ( md_is_code_fence( nws, &code_fence ) )
-        CLEAR_RETURN( MD_CODE );
-      break;
+  // PHP Markdown Extra code fences.
+  if ( (nws_class & MD_CLASS_CODE_FENCE) != 0 ) {
+    md_code_fence_init( &parser->code_fence );
+    if ( md_is_code_fence( nws, &parser->code_fence ) )
+      CLEAR_RETURN( parser, MD_CODE );
+  }
 
-    // Block-level HTML.
-    case '<':
-      NO_OP;
-      bool is_end_tag;
-      curr_html_state = md_is_html_tag( nws, &is_end_tag );
-      if ( curr_html_state != HTML_NONE ) {
-        if ( is_end_tag )               // HTML ends on same line as it begins
-          curr_html_state = HTML_END;
-        md_stack_push( MD_HTML_BLOCK, indent_left, 0 );
-        return &MD_TOP;
-      }
-      break;
-  } // switch
+  // Block-level HTML.
+  if ( (nws_class & MD_CLASS_HTML) != 0 ) {
+    bool is_end_tag;
+    parser->html_state = md_is_html_tag( nws, &is_end_tag );
+    if ( parser->html_state != HTML_NONE ) {
+      if ( is_end_tag )                 // HTML ends on same line as it begins
+        parser->html_state = HTML_END;
+      md_stack_push( parser, MD_HTML_BLOCK, indent_left, 0 );
+      return &MD_TOP(parser);
+    }
+  }
 
-  //
-  // Markdown horizontal rules: these are handled more simply if they are in
-  // their own switch statement since the * and - would otherwise be duplicate
-  // case values in the above switch statement.
-  //
-  switch ( nws[0] ) {
-    case '*':
-    case '-':
-    case '_':
-      if ( md_is_hr( nws ) )
-        CLEAR_RETURN( MD_HR );
-  } // switch
+  // Markdown horizontal rules.
+  if ( (nws_class & MD_CLASS_HR) != 0 && md_is_hr( nws ) )
+    CLEAR_RETURN( parser, MD_HR );
 
   /////////////////////////////////////////////////////////////////////////////
 
@@ -1388,46 +2087,36 @@ md_state_t const* markdown_parse( char *s ) {
   // We first have to determine the type of the current line because it affects
   // the depth calculation.
   //
-  switch ( nws[0] ) {
-
+  if ( (nws_class & MD_CLASS_OL) != 0 ) {
     // Ordered lists.
-    case '0': case '1': case '2': case '3': case '4':
-    case '5': case '6': case '7': case '8': case '9':
-      if ( md_is_ol( nws, &ol_num, &ol_c, &indent_hang ) )
-        curr_line_type = MD_OL;
-      break;
-
-    // Doxygen ordered lists.
-    case '-':
-      if ( opt_doxygen && md_is_dox_ol( nws, &indent_hang ) ) {
-        //
-        // Even though it's a Doxygen ordered list, we treat is as unordered
-        // since we leave the list marker alone, i.e., we don't renumber it.
-        //
-        curr_line_type = MD_UL;
-        break;
-      }
-      FALLTHROUGH;
-
+    if ( md_is_ol( nws, &ol_num, &ol_c, &indent_hang ) )
+      curr_line_type = MD_OL;
+  }
+  else if ( (nws_class & MD_CLASS_DOX_OL) != 0 && opt_doxygen &&
+            md_is_dox_ol( nws, &indent_hang ) ) {
+    //
+    // Even though it's a Doxygen ordered list, we treat is as unordered since
+    // we leave the list marker alone, i.e., we don't renumber it.
+    //
+    curr_line_type = MD_UL;
+  }
+  else if ( (nws_class & MD_CLASS_UL) != 0 ) {
     // Unordered lists.
-    case '*':
-    case '+':
-      if ( md_is_ul( nws, &indent_hang ) )
-        curr_line_type = MD_UL;
-      break;
-
+    if ( md_is_ul( nws, &indent_hang ) )
+      curr_line_type = MD_UL;
+  }
+  else if ( (nws_class & MD_CLASS_DL) != 0 ) {
     // Definition lists.
-    case ':':
-      if ( md_is_dl( nws, &indent_hang ) )
-        curr_line_type = MD_DL;
-  } // switch
+    if ( md_is_dl( nws, &indent_hang ) )
+      curr_line_type = MD_DL;
+  }
 
   //
   // Based on the indent, previous, and current line types, calculate the depth
   // of the current line.
   //
-  md_depth_t depth = indent_left / md_indent_divisor( indent_left );
-  if ( (!blank_line && md_is_nestable( MD_TOP.line_type )) ||
+  md_depth_t depth = indent_left / md_indent_divisor( parser, indent_left );
+  if ( (!blank_line && md_is_nestable( MD_TOP(parser).line_type )) ||
        md_is_nestable( curr_line_type ) ) {
     ++depth;
   }
@@ -1435,33 +2124,34 @@ md_state_t const* markdown_parse( char *s ) {
   //
   // Pop states for decreases in indentation.
   //
-  MD_DEBUG( "pop stack? D=%u MD_TOP.D=%u\n", depth, MD_TOP.depth );
-  while ( depth < MD_TOP.depth ) {
-    MD_DEBUG( "+ D=%u < MD_TOP.D=%u => ", depth, MD_TOP.depth );
-    md_stack_pop();
+  MD_DEBUG( "pop stack? D=%u MD_TOP.D=%u\n", depth, MD_TOP(parser).depth );
+  while ( depth < MD_TOP(parser).depth ) {
+    MD_DEBUG( "+ D=%u < MD_TOP.D=%u => ", depth, MD_TOP(parser).depth );
+    md_stack_pop( parser );
   } // while
 
-  md_indent_t const nested_indent_min = MD_TOP.depth * MD_LIST_INDENT_MAX;
+  md_indent_t const nested_indent_min =
+    MD_TOP(parser).depth * MD_LIST_INDENT_MAX;
   bool const is_nested = indent_left >= nested_indent_min;
   bool const is_same_type_not_nested =
-    md_top_is( curr_line_type ) && !is_nested;
+    md_top_is( parser, curr_line_type ) && !is_nested;
 
   switch ( curr_line_type ) {
 
     case MD_NONE:
       if ( blank_line && md_is_table( s ) ) {
-        assert( !md_top_is( MD_TABLE ) );
+        assert( !md_top_is( parser, MD_TABLE ) );
         if ( is_nested )
-          md_stack_push( MD_TABLE, indent_left, 0 );
+          md_stack_push( parser, MD_TABLE, indent_left, 0 );
       }
       break;
 
     case MD_OL:
       NO_OP;
-      bool const ol_same_char = MD_TOP.ol_c == ol_c;
+      bool const ol_same_char = MD_TOP(parser).ol_c == ol_c;
       if ( is_same_type_not_nested && ol_same_char ) {
-        MD_TOP.seq_num = ++next_seq_num;  // reuse current state
-        md_ol_t const next_ol_num = ++MD_TOP.ol_num;
+        MD_TOP(parser).seq_num = ++parser->next_seq_num; // reuse state
+        md_ol_t const next_ol_num = ++MD_TOP(parser).ol_num;
         if ( next_ol_num ==        10 ||
              next_ol_num ==       100 ||
              next_ol_num ==      1000 ||
@@ -1470,7 +2160,7 @@ md_state_t const* markdown_parse( char *s ) {
              next_ol_num ==   1000000 ||
              next_ol_num ==  10000000 ||
              next_ol_num == 100000000 ) {
-          ++MD_TOP.indent_hang;         // digits just got 1 wider
+          ++MD_TOP(parser).indent_hang; // digits just got 1 wider
         }
         md_renumber_ol( nws, ol_num, next_ol_num );
       } else {
@@ -1484,27 +2174,456 @@ md_state_t const* markdown_parse( char *s ) {
           // Just get rid of the current list (effectively replacing it with
           // the new list).
           //
-          md_stack_pop();
+          md_stack_pop( parser );
         }
-        md_stack_push( MD_OL, indent_left, indent_hang );
-        MD_TOP.ol_c   = ol_c;
-        MD_TOP.ol_num = ol_num;
+        md_stack_push( parser, MD_OL, indent_left, indent_hang );
+        MD_TOP(parser).ol_c   = ol_c;
+        MD_TOP(parser).ol_num = ol_num;
       }
       break;
 
     case MD_DL:
     case MD_UL:
       if ( is_same_type_not_nested )
-        MD_TOP.seq_num = ++next_seq_num;  // reuse current state
+        MD_TOP(parser).seq_num = ++parser->next_seq_num; // reuse state
       else
-        md_stack_push( curr_line_type, indent_left, indent_hang );
+        md_stack_push( parser, curr_line_type, indent_left, indent_hang );
       break;
 
     default:
       /* suppress warning */;
   } // switch
 
-  return &MD_TOP;
+  return &MD_TOP(parser);
+}
+
+void md_doc_cleanup( md_doc_t *doc ) {
+  if ( doc == NULL )
+    return;
+  markdown_cleanup( &doc->parser );
+  for ( size_t i = 0; i < doc->checkpoints_len; ++i )
+    md_snapshot_free( &doc->checkpoints[i].snap );
+  FREE( doc->blocks );
+  FREE( doc->checkpoints );
+  md_doc_init( doc );
+}
+
+void md_doc_init( md_doc_t *doc ) {
+  assert( doc != NULL );
+  *doc = (md_doc_t){ 0 };
+}
+
+void md_doc_parse( md_doc_t *doc, char *const lines[], size_t n_lines ) {
+  assert( doc != NULL );
+  md_doc_cleanup( doc );
+  md_doc_update( doc, lines, n_lines, 0, 0, n_lines );
+}
+
+size_t md_doc_update( md_doc_t *doc, char *const lines[], size_t n_lines,
+                      size_t line_first, size_t n_removed, size_t n_added ) {
+  assert( doc != NULL );
+  assert( lines != NULL || n_lines == 0 );
+  assert( line_first + n_added <= n_lines );
+
+  md_parser_t *const parser = &doc->parser;
+
+  //
+  // Restart from the last checkpoint at or before line_first: since
+  // classification depends only on preceding lines, everything before it is
+  // unaffected by the edit.
+  //
+  size_t cp_restart = 0;
+  for ( size_t lo = 0, hi = doc->checkpoints_len; lo < hi; ) {
+    size_t const mid = lo + (hi - lo) / 2;
+    if ( doc->checkpoints[ mid ].line <= line_first ) {
+      cp_restart = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  } // for
+
+  size_t line = 0;
+  if ( cp_restart < doc->checkpoints_len ) {
+    line = doc->checkpoints[ cp_restart ].line;
+    md_snapshot_restore( parser, &doc->checkpoints[ cp_restart ].snap );
+  } else {
+    markdown_init( parser );
+  }
+
+  size_t b_restart = 0;
+  for ( size_t lo = 0, hi = doc->len; lo < hi; ) {
+    size_t const mid = lo + (hi - lo) / 2;
+    if ( doc->blocks[ mid ].line_first <= line ) {
+      b_restart = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  } // for
+
+  //
+  // Detach the old checkpoints and blocks from the restart line onwards:
+  // they're compared against to detect convergence and then reused.
+  //
+  size_t const old_cps_len = doc->checkpoints_len - cp_restart;
+  md_checkpoint_t *old_cps = NULL;
+  size_t const old_blocks_len = doc->len - b_restart;
+  md_block_t *old_blocks = NULL;
+  if ( old_cps_len > 0 ) {
+    old_cps = MALLOC( md_checkpoint_t, old_cps_len );
+    memcpy(
+      old_cps, doc->checkpoints + cp_restart,
+      old_cps_len * sizeof( md_checkpoint_t )
+    );
+  }
+  if ( old_blocks_len > 0 ) {
+    old_blocks = MALLOC( md_block_t, old_blocks_len );
+    memcpy(
+      old_blocks, doc->blocks + b_restart,
+      old_blocks_len * sizeof( md_block_t )
+    );
+  }
+  doc->checkpoints_len = cp_restart;
+  doc->len = b_restart;
+  if ( old_blocks_len > 0 && old_blocks[0].line_first < line ) {
+    //
+    // The restart line is in the middle of a block: keep the part before it.
+    //
+    doc->blocks[ doc->len++ ].line_count = line - old_blocks[0].line_first;
+  }
+
+  md_snapshot_t snap = { 0 };
+  size_t n_parsed = 0;
+  size_t old_bi = 0, old_ci = 0;
+
+  for ( ; line < n_lines; ++line ) {
+    md_snapshot_save( parser, &snap );
+
+    if ( line >= line_first + n_added ) {
+      //
+      // We're past the edit: if there was an old checkpoint at the
+      // corresponding line and the parser state is the same as it was then,
+      // every line from there on would be classified the same as before.
+      //
+      size_t const old_line = line - n_added + n_removed;
+      while ( old_ci < old_cps_len && old_cps[ old_ci ].line < old_line )
+        ++old_ci;
+      if ( old_ci < old_cps_len && old_cps[ old_ci ].line == old_line &&
+           md_snapshot_converged( &old_cps[ old_ci ].snap, &snap ) ) {
+        md_snapshot_t const *const old_conv = &old_cps[ old_ci ].snap;
+        //
+        // A shallow copy since adding snap transfers its memory to doc.
+        //
+        md_snapshot_t const new_conv = snap;
+
+        while ( old_blocks[ old_bi ].line_first +
+                old_blocks[ old_bi ].line_count <= old_line ) {
+          ++old_bi;
+        } // while
+        md_block_t *const first = &old_blocks[ old_bi ];
+        first->line_count -= old_line - first->line_first;
+        first->line_first = old_line;
+        for ( size_t i = old_bi; i < old_blocks_len; ++i ) {
+          md_block_t *const block = &old_blocks[i];
+          block->line_first = block->line_first - n_removed + n_added;
+          block->seq_num = md_seq_remap( block->seq_num, old_conv, &new_conv );
+          md_doc_add_block( doc, block );
+        } // for
+
+        md_doc_add_checkpoint( doc, line, &snap );
+        for ( size_t i = old_ci + 1; i < old_cps_len; ++i ) {
+          md_checkpoint_t *const cp = &old_cps[i];
+          md_snapshot_remap( &cp->snap, old_conv, &new_conv );
+          md_doc_add_checkpoint(
+            doc, cp->line - n_removed + n_added, &cp->snap
+          );
+        } // for
+        break;
+      }
+    }
+
+    md_line_desc_t desc;
+    md_line_desc_init( &desc, lines[ line ] );
+    md_state_t const *const md = markdown_parse( parser, &desc );
+    ++n_parsed;
+
+    md_block_t const *const last =
+      doc->len > 0 ? &doc->blocks[ doc->len - 1 ] : NULL;
+    bool const is_block_start = last == NULL ||
+      last->line_type != md->line_type || last->seq_num != md->seq_num;
+
+    md_doc_add_block( doc, &(md_block_t){
+      .line_type   = md->line_type,
+      .seq_num     = md->seq_num,
+      .depth       = md->depth,
+      .indent_left = md->indent_left,
+      .indent_hang = md->indent_hang,
+      .line_first  = line,
+      .line_count  = 1
+    } );
+
+    //
+    // Checkpoint at the start of every block and paragraph, but at least
+    // every MD_CHECKPOINT_LINES_MAX lines, so edits within either needn't
+    // reclassify much.
+    //
+    md_checkpoint_t const *const last_cp = doc->checkpoints_len > 0 ?
+      &doc->checkpoints[ doc->checkpoints_len - 1 ] : NULL;
+    if ( is_block_start || snap.blank_line || last_cp == NULL ||
+         line - last_cp->line >= MD_CHECKPOINT_LINES_MAX ) {
+      md_doc_add_checkpoint( doc, line, &snap );
+    }
+  } // for
+
+  //
+  // Free the snapshots of the old checkpoints that weren't reused (those that
+  // were have been reset to empty).
+  //
+  for ( size_t i = 0; i < old_cps_len; ++i )
+    md_snapshot_free( &old_cps[i].snap );
+  FREE( old_cps );
+  FREE( old_blocks );
+  md_snapshot_free( &snap );
+
+  return n_parsed;
+}
+
+void md_init( void ) {
+  RUN_ONCE html_element_table_init();
+}
+
+size_t md_inline_no_wrap( char const *s, regex_ranges_t *ranges ) {
+  assert( s != NULL );
+  assert( ranges != NULL );
+
+  //
+  // Bit n is set once there's known to be no backtick string of exactly n
+  // backticks from the current position on so, with many unmatched backtick
+  // strings, the rest of the line isn't searched again for each.
+  //
+  uint64_t no_ticks = 0;
+
+  ranges->len = 0;
+  for ( char const *p = s; *p != '\0'; ) {
+    char const *end = NULL;
+    switch ( *p ) {
+      case '\\':                        // backslash escape
+        if ( p[1] != '\0' )
+          ++p;
+        break;
+      case '<':
+        end = md_autolink_end( p );
+        break;
+      case ']':
+        if ( p[1] == '(' )
+          end = md_link_dest_end( p + 2 );
+        break;
+      case '`': {
+        size_t const n_ticks = strspn( p, "`" );
+        bool const is_known = n_ticks < 64 &&
+          (no_ticks & (UINT64_C(1) << n_ticks)) != 0;
+        if ( !is_known ) {
+          end = md_code_span_end( p + n_ticks, n_ticks );
+          if ( end == NULL && n_ticks < 64 )
+            no_ticks |= UINT64_C(1) << n_ticks;
+        }
+        if ( end == NULL )              // literal backticks
+          p += n_ticks - 1;
+        break;
+      }
+    } // switch
+    if ( end == NULL ) {
+      ++p;
+      continue;
+    }
+    regex_ranges_add(
+      ranges, STATIC_CAST( size_t, p - s ), STATIC_CAST( size_t, end - s )
+    );
+    p = end;
+  } // for
+
+  return ranges->len;
+}
+
+void md_line_desc_init( md_line_desc_t *desc, char *line ) {
+  assert( desc != NULL );
+  assert( line != NULL );
+
+  char *s = line;
+  md_indent_t indent_left = 0;
+  for ( size_t tab_pos = 0; ; ++s, ++tab_pos ) {
+    switch ( *s ) {
+      case '\t':
+        indent_left += MD_TAB_SPACES - tab_pos % MD_TAB_SPACES;
+        break;
+      case '\r':
+        break;
+      case ' ':
+        ++indent_left;
+        break;
+      default:
+        goto done;
+    } // switch
+  } // for
+
+done:
+  *desc = (md_line_desc_t){
+    .line        = line,
+    .ws_end      = s,
+    .nws         = s + strspn( s, WS_STRN ),
+    .indent_left = indent_left
+  };
+}
+
+void md_table_add( md_table_t *table, char const *line ) {
+  assert( table != NULL );
+  assert( line != NULL );
+
+  char const *s = line;
+  SKIP_CHARS( s, WS_ST );
+  if ( table->rows_len == 0 ) {
+    //
+    // Every row gets the leading whitespace of the first row that's kept as
+    // the first text of the table.
+    //
+    table->indent_len = STATIC_CAST( size_t, s - line );
+    table->text_len = 0;
+    md_table_put( &table->text, &table->text_len, line, table->indent_len );
+  }
+
+  char const *end = s + strlen( s );
+  md_table_row_t row = { .cells_first = table->cells_len };
+  if ( end > s && end[-1] == '\n' )
+    row.eol_len = end - 1 > s && end[-2] == '\r' ? 2 : 1;
+  while ( end > s && isspace( end[-1] ) )
+    --end;
+  if ( s < end && *s == '|' ) {
+    table->pipe_lead = true;
+    ++s;
+  }
+
+  size_t widths_first = table->cells_len;
+  for ( char const *cell = s; ; ++s ) {
+    if ( *s == '\\' && s + 1 < end ) {
+      ++s;                              // keep the escaped character as-is
+      continue;
+    }
+    if ( s < end && *s != '|' )
+      continue;
+    if ( s == end && cell == end && row.cells_len > 0 ) {
+      table->pipe_trail = true;         // last cell was followed by a pipe
+      break;
+    }
+    md_table_add_cell( table, row.cells_len++, cell, s );
+    if ( s == end )
+      break;
+    cell = s + 1;
+  } // for
+
+  if ( table->rows_len == 1 && md_table_is_delim_row( table, &row ) ) {
+    //
+    // The delimiter row gives the alignment of each column, but its width is
+    // adjusted to that of the other rows.
+    //
+    table->delim_row = true;
+    for ( size_t c = 0; c < row.cells_len; ++c ) {
+      md_table_cell_t const *const cell = &table->cells[ row.cells_first + c ];
+      char const *const text = table->text.str + cell->text_offset;
+      bool const left = text[0] == ':';
+      bool const right = text[ cell->text_len - 1 ] == ':';
+      table->col_align[c] = left && right ? MD_TABLE_ALIGN_CENTER :
+                            left          ? MD_TABLE_ALIGN_LEFT   :
+                            right         ? MD_TABLE_ALIGN_RIGHT  :
+                                            MD_TABLE_ALIGN_NONE;
+    } // for
+    widths_first = table->cells_len;    // don't count its widths
+  }
+
+  for ( size_t c = widths_first; c < table->cells_len; ++c ) {
+    size_t const col = c - row.cells_first;
+    if ( table->cells[c].width > table->col_width[ col ] )
+      table->col_width[ col ] = table->cells[c].width;
+  } // for
+
+  if ( table->rows_len == table->rows_cap ) {
+    table->rows_cap = table->rows_cap == 0 ?
+      MD_BLOCK_ALLOC_DEFAULT : table->rows_cap * 2;
+    REALLOC( table->rows, md_table_row_t, table->rows_cap );
+  }
+  table->rows[ table->rows_len++ ] = row;
+}
+
+void md_table_cleanup( md_table_t *table ) {
+  if ( table == NULL )
+    return;
+  line_buf_cleanup( &table->text );
+  FREE( table->cells );
+  FREE( table->rows );
+  FREE( table->col_width );
+  FREE( table->col_align );
+  *table = (md_table_t){ 0 };
+}
+
+size_t md_table_format( md_table_t *table, line_buf_t *out ) {
+  assert( table != NULL );
+  assert( out != NULL );
+
+  size_t out_len = 0;
+  for ( size_t r = 0; r < table->rows_len; ++r ) {
+    md_table_row_t const *const row = &table->rows[r];
+    bool const is_delim_row = r == 1 && table->delim_row;
+
+    md_table_put( out, &out_len, table->text.str, table->indent_len );
+    if ( table->pipe_lead )
+      md_table_put( out, &out_len, "| ", 2 );
+
+    for ( size_t c = 0; c < row->cells_len; ++c ) {
+      md_table_cell_t const *const cell = &table->cells[ row->cells_first + c ];
+      size_t width = table->col_width[c];
+      if ( width < MD_TABLE_COL_WIDTH_MIN )
+        width = MD_TABLE_COL_WIDTH_MIN;
+      md_table_align_t const align = table->col_align[c];
+      bool const is_last = c + 1 == row->cells_len && !table->pipe_trail;
+
+      if ( c > 0 )
+        md_table_put( out, &out_len, " | ", 3 );
+
+      if ( is_delim_row ) {
+        bool const left =
+          align == MD_TABLE_ALIGN_LEFT || align == MD_TABLE_ALIGN_CENTER;
+        bool const right =
+          align == MD_TABLE_ALIGN_RIGHT || align == MD_TABLE_ALIGN_CENTER;
+        if ( left )
+          md_table_put( out, &out_len, ":", 1 );
+        md_table_put_n( out, &out_len, '-', width - left - right );
+        if ( right )
+          md_table_put( out, &out_len, ":", 1 );
+        continue;
+      }
+
+      size_t const pad = width - cell->width;
+      size_t const pad_left = align == MD_TABLE_ALIGN_RIGHT  ? pad     :
+                              align == MD_TABLE_ALIGN_CENTER ? pad / 2 :
+                                                               0;
+      md_table_put_n( out, &out_len, ' ', pad_left );
+      md_table_put(
+        out, &out_len, table->text.str + cell->text_offset, cell->text_len
+      );
+      if ( !is_last )                   // no trailing whitespace
+        md_table_put_n( out, &out_len, ' ', pad - pad_left );
+    } // for
+
+    if ( table->pipe_trail )
+      md_table_put( out, &out_len, " |", 2 );
+    // keep the row's end-of-line as-is like other lines that aren't wrapped
+    md_table_put( out, &out_len, &"\r\n"[ 2 - row->eol_len ], row->eol_len );
+  } // for
+  out->str[ out_len ] = '\0';
+
+  table->cells_len = table->cols_len = table->rows_len = table->text_len = 0;
+  table->delim_row = table->pipe_lead = table->pipe_trail = false;
+  return out_len;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
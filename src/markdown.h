@@ -29,12 +29,15 @@
 
 // local
 #include "pjl_config.h"                 /* must go first */
+#include "common.h"                     /* for line_buf_t */
+#include "wregex.h"                     /* for regex_ranges_t */
 
 /// @cond DOXYGEN_IGNORE
 
 // standard
 #include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <sys/types.h>                  /* for ssize_t */
 
 /// @endcond
 
@@ -46,7 +49,14 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Maximum number of characters an ordered list number may grow by when it's
+ * renumbered in place, e.g., from `1` to `4294967295`.
+ */
+#define MD_OL_RENUMBER_PAD        9u
+
 #define MD_SEQ_NUM_INIT           1u    /**< First Markdown state seq number. */
+#define MD_STACK_INLINE_MAX       8u    /**< Markdown states before spilling. */
 #define MD_TAB_SPACES             4u    /**< Number of spaces a tab equals. */
 
 /**
@@ -73,6 +83,11 @@ enum md_line {
 };
 typedef enum md_line md_line_t;
 
+/**
+ * Every \ref md_line as a string, e.g., to index counts of each by.
+ */
+#define MD_LINE_TYPES             "0C:^#=_A<[1|T*"
+
 typedef size_t   md_depth_t;            ///< How nested we are.
 typedef unsigned md_seq_t;              ///< Parser state sequence number.
 typedef size_t   md_indent_t;           ///< Indentation amount (in spaces).
@@ -136,12 +151,246 @@ struct md_state {
 };
 typedef struct md_state md_state_t;
 
+/**
+ * HTML markup types.
+ *
+ * @remarks Every type that is not #HTML_NONE nor #HTML_ELEMENT is a "special"
+ * type in that it (a) has a unique terminator and (b) does not nest.
+ */
+enum html_state {
+  /// No state.
+  HTML_NONE,
+
+  /// <tt>&lt;![CDATA[</tt>...<tt>]]&gt;</tt>
+  HTML_CDATA,
+
+  /// <tt>&lt;!-\-</tt> ... <tt>-\-&gt;</tt>
+  HTML_COMMENT,
+
+  /// <tt>&lt;!DOCTYPE</tt> ...<tt>&gt;</tt>
+  HTML_DOCTYPE,
+
+  /// <tt>&lt;</tt> _tag_ <tt>&gt;</tt> ... <tt>&lt;/</tt> _tag_ <tt>&gt;</tt>
+  HTML_ELEMENT,
+
+  /// <tt>&lt;?</tt> ... <tt>?&gt;</tt>
+  HTML_PI,
+
+  /// <tt>&lt;pre&gt;</tt>, <tt>&lt;script&gt;</tt>, or <tt>&lt;style&gt;</tt>
+  HTML_PRE,
+
+  /// Ending HTML block.
+  HTML_END
+};
+typedef enum html_state html_state_t;
+
+/**
+ * PHP Markdown Extra code fence info.
+ */
+struct md_code_fence {
+  char    cf_c;                 ///< Character of the fence: `~` or <tt>`</tt>.
+  size_t  cf_len;               ///< Length of the fence.
+};
+typedef struct md_code_fence md_code_fence_t;
+
+typedef ssize_t md_stack_pos_t;         ///< Markdown stack position type.
+
+/**
+ * A line of Markdown input along with the extent and width of its leading
+ * whitespace, computed by md_line_desc_init() once per line so that neither
+ * markdown_parse() nor its caller need to scan it again.
+ */
+struct md_line_desc {
+  char        *line;                    ///< The null-terminated line.
+
+  /// Just past the leading spaces, tabs, and `\r`s of \ref line.
+  char        *ws_end;
+
+  /// The first non-whitespace character of \ref line or its terminating
+  /// null if it's blank.
+  char        *nws;
+
+  /// Width of the leading whitespace with tabs expanded.
+  md_indent_t  indent_left;
+};
+typedef struct md_line_desc md_line_desc_t;
+
+/**
+ * Markdown parser: all the state needed to parse a document via
+ * markdown_parse().  Each concurrently parsed document needs its own.
+ *
+ * @remarks The stack of \ref md_state is kept in \ref stack_inline until it
+ * gets deeper than #MD_STACK_INLINE_MAX (which real documents almost never
+ * do), at which point it's moved to \ref spill.  The latter is kept by
+ * markdown_init() so a parser that's reused never allocates more once it's
+ * grown.
+ */
+struct md_parser {
+  /// Stack of Markdown states while no deeper than #MD_STACK_INLINE_MAX.
+  md_state_t      stack_inline[ MD_STACK_INLINE_MAX ];
+  md_state_t     *spill;                ///< Stack once deeper; else `NULL`.
+  size_t          spill_cap;            ///< Capacity of \ref spill.
+  md_stack_pos_t  top;                  ///< Top of the stack.
+  md_code_fence_t code_fence;           ///< Current code fence, if any.
+  html_state_t    html_state;           ///< Current HTML state.
+  md_seq_t        next_seq_num;         ///< Last sequence number used.
+  bool            prev_blank_line;      ///< Previous line was blank?
+
+  /// Previous value for `code_fence_end` in markdown_parse().
+  bool            prev_code_fence_end;
+
+  /// Previous value for `link_label_has_title` in markdown_parse().
+  bool            prev_link_label_has_title;
+};
+typedef struct md_parser md_parser_t;
+
+/**
+ * A block of consecutive Markdown lines having the same line type and sequence
+ * number, i.e., that markdown_parse() classified as being part of the same
+ * element.
+ */
+struct md_block {
+  md_line_t   line_type;                ///< Line type of every line.
+  md_seq_t    seq_num;                  ///< Sequence number of every line.
+  md_depth_t  depth;                    ///< Nesting depth of the first line.
+  md_indent_t indent_left;              ///< Left-indent of the first line.
+  md_indent_t indent_hang;              ///< Hang-indent of the first line.
+  size_t      line_first;               ///< Index of the first line.
+  size_t      line_count;               ///< Number of lines.
+};
+typedef struct md_block md_block_t;
+
+/**
+ * A Markdown document model: the sequence of blocks of a document's lines
+ * along with the parser state before some of the lines so that the document
+ * can be reclassified incrementally after an edit via md_doc_update().
+ */
+struct md_doc {
+  md_block_t            *blocks;        ///< Blocks in line order.
+  size_t                 len;           ///< Number of blocks.
+  size_t                 cap;           ///< Capacity of \ref blocks.
+  struct md_checkpoint  *checkpoints;   ///< Parser states in line order.
+  size_t                 checkpoints_len; ///< Number of \ref checkpoints.
+  size_t                 checkpoints_cap; ///< Capacity of \ref checkpoints.
+  md_parser_t            parser;        ///< Parser used to (re)classify.
+};
+typedef struct md_doc md_doc_t;
+
+/**
+ * Markdown table column alignment as given by the table's delimiter row.
+ */
+enum md_table_align {
+  MD_TABLE_ALIGN_NONE,                  ///< `---`
+  MD_TABLE_ALIGN_LEFT,                  ///< `:--`
+  MD_TABLE_ALIGN_CENTER,                ///< `:-:`
+  MD_TABLE_ALIGN_RIGHT                  ///< `--:`
+};
+typedef enum md_table_align md_table_align_t;
+
+/**
+ * A cell of a row of an \ref md_table.
+ */
+struct md_table_cell {
+  size_t  text_offset;                  ///< Offset of its text.
+  size_t  text_len;                     ///< Length of its (trimmed) text.
+  size_t  width;                        ///< Display width of its text.
+};
+typedef struct md_table_cell md_table_cell_t;
+
+/**
+ * A row of an \ref md_table.
+ */
+struct md_table_row {
+  size_t  cells_first;                  ///< Index of its first cell.
+  size_t  cells_len;                    ///< Number of its cells.
+  size_t  eol_len;                      ///< 2 = `\r\n`; 1 = `\n`; 0 = none.
+};
+typedef struct md_table_row md_table_row_t;
+
+/**
+ * The rows of a single Markdown table collected via md_table_add() so that
+ * md_table_format() can align its columns.  Memory is proportional to the
+ * size of the table and is reused for the next one.
+ */
+struct md_table {
+  line_buf_t         text;              ///< Indent and text of all cells.
+  size_t             text_len;          ///< Length of \ref text.
+  md_table_cell_t   *cells;             ///< Cells of all rows in order.
+  size_t             cells_len;         ///< Number of \ref cells.
+  size_t             cells_cap;         ///< Capacity of \ref cells.
+  md_table_row_t    *rows;              ///< Rows in order.
+  size_t             rows_len;          ///< Number of \ref rows.
+  size_t             rows_cap;          ///< Capacity of \ref rows.
+  size_t            *col_width;         ///< Maximum width of each column.
+  md_table_align_t  *col_align;         ///< Alignment of each column.
+  size_t             cols_len;          ///< Number of columns.
+  size_t             cols_cap;          ///< Capacity of the `col_` arrays.
+  size_t             indent_len;        ///< Length of leading whitespace.
+  bool               delim_row;         ///< Is the second row a delimiter?
+  bool               pipe_lead;         ///< Does any row begin with `|`?
+  bool               pipe_trail;        ///< Does any row end with `|`?
+};
+typedef struct md_table md_table_t;
+
 ////////// extern functions ///////////////////////////////////////////////////
 
 /**
- * Initializes the Markdown parser.
+ * Parses the HTML (or XML) tag or special markup (e.g., a comment) that \a s
+ * starts, if any, in text that isn't Markdown.  Unlike a Markdown HTML block,
+ * the tag need not be on a line by itself.
+ *
+ * @param s The string to parse; it must start with `<`.  It need not be
+ * null-terminated.
+ * @param end A pointer to just past the last character of the line \a s is
+ * in.
+ * @param is_end_tag A pointer to the variable to receive whether the tag is an
+ * end tag (or self-closing) or whether the special markup ends on the line.
+ * @param tag_end A pointer to receive a pointer to just past the end of the
+ * tag or special markup; or null if it doesn't end on the line or \a s isn't a
+ * tag.
+ * @return Returns #HTML_PRE for a pre-formatted block-level element;
+ * #HTML_ELEMENT for any other block-level element; #HTML_CDATA,
+ * #HTML_COMMENT, #HTML_DOCTYPE, or #HTML_PI for special markup; or #HTML_NONE
+ * for an inline element or if \a s isn't a tag.
  */
-void markdown_init( void );
+NODISCARD
+html_state_t html_tag_parse( char const *s, char const *end, bool *is_end_tag,
+                             char const **tag_end );
+
+/**
+ * Frees all memory used by \a parser _but not_ \a parser itself.
+ *
+ * @param parser The \ref md_parser to clean up.
+ *
+ * @sa markdown_init()
+ */
+void markdown_cleanup( md_parser_t *parser );
+
+/**
+ * Initializes \a parser to parse a new document.  \a parser must have been
+ * zero-initialized before the first call; memory from a previous document is
+ * reused.
+ *
+ * @param parser The \ref md_parser to initialize.
+ *
+ * @sa markdown_cleanup()
+ */
+void markdown_init( md_parser_t *parser );
+
+/**
+ * Checks whether parsing proceeds from \a parser's state as it would from that
+ * of one just initialized by markdown_init(), i.e., whether \a line, the next
+ * line, would be parsed the same and leave both in the same state, so that the
+ * rest of a document starting with \a line can be parsed separately.
+ *
+ * @param parser The \ref md_parser to check.  Its state is left unchanged.
+ * @param line The next line.  It need not be null-terminated.
+ * @param size The number of characters of \a line.
+ * @return Returns `true` only if parsing proceeds the same.
+ */
+NODISCARD
+bool markdown_is_initial( md_parser_t *parser, char const *line,
+                          size_t size );
 
 /**
  * Parses a line of Markdown text.  Note that this isn't a full Markdown parser
@@ -149,11 +398,135 @@ void markdown_init( void );
  * needs to parse block elements (headers, lists, code blocks, horizontal
  * rules) and not span elements (links, emphasis, inline code).
  *
- * @param s The null-terminated string to parse.
- * @return Returns a pointer to the current Markdown state.
+ * @param parser The \ref md_parser previously initialized by markdown_init().
+ * @param desc The \ref md_line_desc of the line to parse.  If the line is an
+ * ordered list item, its number may be renumbered in place, so the line
+ * must have room for #MD_OL_RENUMBER_PAD more characters past its terminating
+ * null.
+ * @return Returns a pointer to the current Markdown state.  It's valid only
+ * until the next call using \a parser.
+ */
+NODISCARD
+md_state_t const* markdown_parse( md_parser_t *parser,
+                                  md_line_desc_t const *desc );
+
+/**
+ * Frees all memory used by \a doc _but not_ \a doc itself.
+ *
+ * @param doc The \ref md_doc to clean up.
+ *
+ * @sa md_doc_init()
+ */
+void md_doc_cleanup( md_doc_t *doc );
+
+/**
+ * Initializes \a doc to be empty.
+ *
+ * @param doc The \ref md_doc to initialize.
+ *
+ * @sa md_doc_cleanup()
+ * @sa md_doc_parse()
+ */
+void md_doc_init( md_doc_t *doc );
+
+/**
+ * Classifies all the lines of a document from scratch.
+ *
+ * @param doc The \ref md_doc to parse into.  Any existing blocks are
+ * discarded.
+ * @param lines The null-terminated lines of the document.  As with
+ * markdown_parse(), ordered list numbers may be renumbered in place, so each
+ * line must have room for #MD_OL_RENUMBER_PAD more characters past its
+ * terminating null.
+ * @param n_lines The number of \a lines.
+ *
+ * @sa md_doc_update()
+ */
+void md_doc_parse( md_doc_t *doc, char *const lines[], size_t n_lines );
+
+/**
+ * Reclassifies the lines of a document after an edit, i.e., after \a
+ * n_removed lines starting at \a line_first were replaced by \a n_added
+ * lines.  Only lines from the start of the block containing \a line_first
+ * until the parser state again matches what it was before the edit are
+ * reclassified; the blocks after that are reused.
+ *
+ * @param doc The \ref md_doc previously parsed by either md_doc_parse() or
+ * md_doc_update() for the lines before the edit.
+ * @param lines The null-terminated lines of the document after the edit.
+ * As with md_doc_parse(), each must have room for #MD_OL_RENUMBER_PAD more
+ * characters past its terminating null.
+ * @param n_lines The number of \a lines.
+ * @param line_first The index of the first changed line.
+ * @param n_removed The number of lines that were removed.
+ * @param n_added The number of lines that were added in their place.
+ * @return Returns the number of lines reclassified.
+ *
+ * @note This uses \a doc's own \ref md_parser, so it doesn't disturb any
+ * other document being parsed via markdown_parse().
+ */
+size_t md_doc_update( md_doc_t *doc, char *const lines[], size_t n_lines,
+                      size_t line_first, size_t n_removed, size_t n_added );
+
+/**
+ * Initializes the table of HTML elements unless it has been already.
+ * markdown_init() calls this itself, but a program that parses in several
+ * threads at once must call it first so the table is only ever read by them.
+ */
+void md_init( void );
+
+/**
+ * Finds the ranges of a line of Markdown text that mustn't be wrapped within
+ * at non-whitespace characters: code spans, link destinations (including the
+ * preceding `](`), and autolinks.  This is a single, linear scan that only
+ * recognizes those span elements entirely on the line.
+ *
+ * @param s The null-terminated line to scan.
+ * @param ranges A pointer to the \ref regex_ranges to receive said ranges, in
+ * order.  Any existing ranges are discarded.
+ * @return Returns the number of ranges.
+ */
+PJL_DISCARD
+size_t md_inline_no_wrap( char const *s, regex_ranges_t *ranges );
+
+/**
+ * Initializes \a desc for \a line.
+ *
+ * @param desc The \ref md_line_desc to initialize.
+ * @param line The null-terminated line to describe.
+ */
+void md_line_desc_init( md_line_desc_t *desc, char *line );
+
+/**
+ * Adds a row to \a table.
+ *
+ * @param table The \ref md_table to add to.
+ * @param line The null-terminated line of the row that markdown_parse()
+ * classified as #MD_TABLE.  All rows are given the leading whitespace of the
+ * first row.
+ *
+ * @sa md_table_format()
+ */
+void md_table_add( md_table_t *table, char const *line );
+
+/**
+ * Frees all memory used by \a table _but not_ \a table itself.
+ *
+ * @param table The \ref md_table to clean up.
+ */
+void md_table_cleanup( md_table_t *table );
+
+/**
+ * Formats the rows of \a table so that all cells of each column are the same
+ * width (padded according to the column's alignment, if any), then empties
+ * \a table for the next table.
+ *
+ * @param table The \ref md_table to format.
+ * @param out The buffer to format into.
+ * @return Returns the length of \a out.
  */
 NODISCARD
-md_state_t const* markdown_parse( char *s );
+size_t md_table_format( md_table_t *table, line_buf_t *out );
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,927 @@
+/*
+**      wrap -- text reformatter
+**      src/markup.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for classifying lines of
+ * [reStructuredText](https://docutils.sourceforge.io/rst.html),
+ * [AsciiDoc](https://asciidoc.org/), HTML or XML, and **roff**(7).
+ *
+ * @sa [reStructuredText Markup Specification](https://docutils.sourceforge.io/docs/ref/rst/restructuredtext.html)
+ * @sa [AsciiDoc Language Documentation](https://docs.asciidoctor.org/asciidoc/latest/)
+ * @sa **groff**(7)
+ * @sa **mdoc**(7)
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "markdown.h"                   /* for html_tag_parse() */
+#include "markup.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <string.h>                     /* for memchr(3), memset(3) */
+#include <strings.h>                    /* for strncasecmp(3) */
+
+/// @endcond
+
+/**
+ * @addtogroup markup-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The reStructuredText directives whose content is text (that should be
+ * wrapped) rather than preformatted, in sorted order.
+ */
+static char const *const RST_TEXT_DIRECTIVES[] = {
+  "admonition", "attention", "caution", "danger", "deprecated", "epigraph",
+  "error", "highlights", "hint", "important", "note", "pull-quote", "seealso",
+  "sidebar", "tip", "topic", "versionadded", "versionchanged", "warning"
+};
+
+/**
+ * The **roff**(7) requests and macros that start a region of lines that are
+ * either not filled or not text along with the request or macro that ends it,
+ * in pairs.  A region started by `.Bd` is one only if it's `-literal` or
+ * `-unfilled`.
+ */
+static char const *const ROFF_REGIONS[][2] = {
+  { "Bd", "Ed" },                       // mdoc display
+  { "EQ", "EN" },                       // eqn(1) equation
+  { "EX", "EE" },                       // man example
+  { "PS", "PE" },                       // pic(1) picture
+  { "TS", "TE" },                       // tbl(1) table
+  { "Vb", "Ve" },                       // pod2man(1) verbatim
+  { "nf", "fi" },                       // no-fill mode
+};
+
+/// The characters an HTML pre-formatted element's name is made of.
+#define HTML_ALPHA_CHARS \
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+
+// local functions
+NODISCARD
+static markup_line_t  adoc_parse( markup_parser_t*, char const*, size_t,
+                                  size_t, size_t, bool );
+
+NODISCARD
+static char const*    html_delim_find( markup_parser_t const*, char const*,
+                                       char const* );
+
+NODISCARD
+static markup_line_t  html_parse( markup_parser_t*, char const*, size_t,
+                                  size_t, size_t, bool );
+
+static void           roff_macro_add( char*, size_t, char const*, size_t );
+
+NODISCARD
+static bool           roff_macro_find( char const*, char const*, size_t );
+
+NODISCARD
+static markup_line_t  roff_parse( markup_parser_t*, char const*, size_t,
+                                  size_t, bool );
+
+NODISCARD
+static markup_line_t  rst_parse( markup_parser_t*, char const*, size_t,
+                                 size_t, size_t, bool );
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Checks whether \a c is an ASCII decimal digit.
+ *
+ * @param c The character to check.
+ * @return Returns `true` only if \a c is a digit.
+ */
+NODISCARD
+static inline bool markup_is_digit( char c ) {
+  return c >= '0' && c <= '9';
+}
+
+/**
+ * Starts a paragraph.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @param indent The indent of the paragraph.
+ * @param hang The width of its list item marker, if any.
+ * @return Returns #MARKUP_LINE_PARA.
+ */
+NODISCARD
+static inline markup_line_t markup_para( markup_parser_t *parser,
+                                         size_t indent, size_t hang ) {
+  parser->indent = indent;
+  parser->hang = hang;
+  parser->in_item = hang > 0;
+  return MARKUP_LINE_PARA;
+}
+
+/**
+ * Gets the length of the run of characters equal to `s[pos]`.
+ *
+ * @param s The line.
+ * @param pos The position in \a s the run starts at.
+ * @param end The position just past the last non-whitespace character of \a s.
+ * @return Returns said length.
+ */
+NODISCARD
+static inline size_t markup_run( char const *s, size_t pos, size_t end ) {
+  size_t n = pos + 1;
+  while ( n < end && s[n] == s[pos] )
+    ++n;
+  return n - pos;
+}
+
+/**
+ * Passes a line through verbatim.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @return Returns #MARKUP_LINE_VERBATIM.
+ */
+NODISCARD
+static inline markup_line_t markup_verbatim( markup_parser_t *parser ) {
+  parser->prev_verbatim = true;
+  return MARKUP_LINE_VERBATIM;
+}
+
+/**
+ * Checks whether the name of a **roff**(7) request is that of \a base or one
+ * of its variants, e.g., `de1` or `dei` for `de`.
+ *
+ * @param name The name.  It need not be null-terminated.
+ * @param len The length of \a name.
+ * @param base The null-terminated two-character name of the base request.
+ * @return Returns `true` only if \a name is \a base or a variant of it.
+ */
+NODISCARD
+static inline bool roff_name_is( char const *name, size_t len,
+                                 char const *base ) {
+  if ( len < 2 || len > 4 || strncmp( name, base, 2 ) != 0 )
+    return false;
+  if ( base[0] == 'i' )
+    return len == 2;
+  char const *const v = name + 2;
+  switch ( len ) {
+    case 3: return v[0] == '1' || v[0] == 'i';
+    case 4: return v[0] == 'i' && v[1] == '1';
+  } // switch
+  return true;
+}
+
+/**
+ * Gets the next whitespace-separated word of a **roff**(7) control line.
+ *
+ * @param s The line.
+ * @param pos A pointer to the position in \a s to start at.  On return, it's
+ * just past the word.
+ * @param end The position just past the last non-whitespace character of \a s.
+ * @return Returns the length of the word (that ends at \a pos) or 0 if none.
+ */
+NODISCARD
+static inline size_t roff_word( char const *s, size_t *pos, size_t end ) {
+  size_t n = *pos;
+  while ( n < end && (s[n] == ' ' || s[n] == '\t') )
+    ++n;
+  size_t const begin = n;
+  while ( n < end && s[n] != ' ' && s[n] != '\t' && s[n] != '\\' )
+    ++n;
+  *pos = n;
+  return n - begin;
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Classifies a non-blank line of AsciiDoc.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @param s The line.
+ * @param pos The position of the first non-whitespace character of \a s.
+ * @param end The position just past the last non-whitespace character of \a s.
+ * @param indent The width of the leading whitespace of \a s.
+ * @param is_para_start Can \a s start a paragraph?
+ * @return Returns said line's type.
+ */
+NODISCARD
+static markup_line_t adoc_parse( markup_parser_t *parser, char const *s,
+                                 size_t pos, size_t end, size_t indent,
+                                 bool is_para_start ) {
+  if ( parser->delim_len > 0 ) {
+    if ( end - pos == parser->delim_len &&
+         strncmp( s + pos, parser->delim, parser->delim_len ) == 0 ) {
+      parser->delim_len = 0;
+    }
+    return markup_verbatim( parser );
+  }
+  if ( parser->in_pre )
+    return markup_verbatim( parser );
+
+  //
+  // A line ending in " +" ends with a hard line break, so the line after it
+  // mustn't be wrapped onto it.
+  //
+  bool const was_break = parser->prev_break;
+  parser->prev_break = end - pos > 1 && s[ end - 1 ] == '+' &&
+                       s[ end - 2 ] == ' ';
+
+  char const c = s[ pos ];
+  size_t const run = markup_run( s, pos, end );
+  bool const is_all_run = pos + run == end;
+  size_t marker = 0;                    // list item marker width, if any
+
+  switch ( c ) {
+    case '*':
+    case '.':
+      if ( run <= 5 && pos + run < end && s[ pos + run ] == ' ' ) {
+        marker = run + 1;               // "* ", "** ", ". ", ".. ", ...
+        break;
+      }
+      if ( c == '.' && run >= 4 && is_all_run )
+        goto delimit_verbatim;          // literal block
+      if ( c == '.' && run == 1 )
+        return markup_verbatim( parser );       // block title
+      if ( c == '*' && run >= 4 && is_all_run )
+        return markup_verbatim( parser );       // sidebar block
+      break;
+    case '-':
+      if ( run == 1 && pos + 1 < end && s[ pos + 1 ] == ' ' ) {
+        marker = 2;
+        break;
+      }
+      if ( is_all_run && run >= 4 )
+        goto delimit_verbatim;          // listing block
+      if ( is_all_run && run == 2 )
+        return markup_verbatim( parser );       // open block
+      break;
+    case '+':
+      if ( is_all_run && run >= 4 )
+        goto delimit_verbatim;          // passthrough block
+      if ( is_all_run && run == 1 )
+        return markup_verbatim( parser );       // list continuation
+      break;
+    case '/':
+      if ( is_all_run && run >= 4 )
+        goto delimit_verbatim;          // comment block
+      if ( run == 2 )
+        return markup_verbatim( parser );       // comment line
+      break;
+    case '`':
+      if ( run == 3 ) {                 // fenced code block
+        if ( !is_all_run )
+          end = pos + run;              // ignore its language
+        goto delimit_verbatim;
+      }
+      break;
+    case '!':
+    case ',':
+    case ':':
+    case '|':
+      if ( end - pos >= 4 && strncmp( s + pos + 1, "===", 3 ) == 0 &&
+           markup_run( s, pos + 1, end ) == end - pos - 1 ) {
+        goto delimit_verbatim;          // table
+      }
+      if ( c == ':' && run == 1 ) {
+        char const *const colon = memchr( s + pos + 1, ':', end - pos - 1 );
+        if ( colon != NULL && colon > s + pos + 1 && colon[-1] != ' ' )
+          return markup_verbatim( parser );     // attribute entry
+      }
+      break;
+    case '=':
+      if ( is_all_run && run >= 4 )
+        return markup_verbatim( parser );       // example block
+      if ( run <= 6 && pos + run < end && s[ pos + run ] == ' ' )
+        return markup_verbatim( parser );       // section title
+      break;
+    case '_':
+      if ( is_all_run && run >= 4 )
+        return markup_verbatim( parser );       // quote block
+      break;
+    case '\'':
+    case '<':
+      if ( is_all_run && run == 3 )
+        return markup_verbatim( parser );       // thematic or page break
+      break;
+    case '[':
+      if ( s[ end - 1 ] == ']' )
+        return markup_verbatim( parser );       // block attributes or anchor
+      break;
+    default:
+      if ( markup_is_digit( c ) ) {
+        size_t n = pos;
+        while ( n < end && markup_is_digit( s[n] ) )
+          ++n;
+        if ( n + 1 < end && s[n] == '.' && s[ n + 1 ] == ' ' )
+          marker = n + 2 - pos;
+      }
+  } // switch
+
+  if ( marker > 0 )
+    return markup_para( parser, indent, marker );
+
+  //
+  // Look for a description list term, e.g., "CPU:: The brain", or a block
+  // macro, e.g., "image::file.png[]": each line of either is on its own.
+  //
+  for ( char const *colon = s + pos;
+        (colon = memchr( colon, ':', STATIC_CAST( size_t, s + end - colon ) ))
+          != NULL; ) {
+    size_t const colons = markup_run( s, STATIC_CAST( size_t, colon - s ), end );
+    char const *const after = colon + colons;
+    if ( colons >= 2 && colon > s + pos ) {
+      if ( colons <= 4 && (after == s + end || *after == ' ') )
+        return markup_para( parser, indent, 0 );
+      if ( colons == 2 && s[ end - 1 ] == ']' )
+        return markup_verbatim( parser );
+    }
+    colon = after;
+  } // for
+
+  if ( is_para_start && indent > 0 ) {
+    parser->in_pre = true;              // literal paragraph
+    return markup_verbatim( parser );
+  }
+
+  if ( is_para_start )
+    return markup_para( parser, 0, 0 );
+  if ( was_break )
+    return markup_para( parser, parser->indent, parser->hang );
+  return MARKUP_LINE_TEXT;
+
+delimit_verbatim:
+  if ( end - pos < sizeof parser->delim ) {
+    parser->delim_len = end - pos;
+    memcpy( parser->delim, s + pos, parser->delim_len );
+  }
+  return markup_verbatim( parser );
+}
+
+/**
+ * Finds the end of the pre-formatted element or special markup that an HTML
+ * line is within, i.e., \ref markup_parser::delim "delim" ignoring case.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @param s The part of the line to search.
+ * @param end A pointer to just past the last character of the line.
+ * @return Returns a pointer to just past said end or null if not found.
+ */
+NODISCARD
+static char const* html_delim_find( markup_parser_t const *parser,
+                                    char const *s, char const *end ) {
+  assert( parser->delim_len > 0 );
+  for ( ; (s = memchr( s, parser->delim[0], STATIC_CAST( size_t, end - s ) ))
+          != NULL; ++s ) {
+    if ( STATIC_CAST( size_t, end - s ) >= parser->delim_len &&
+         strncasecmp( s, parser->delim, parser->delim_len ) == 0 ) {
+      return s + parser->delim_len;
+    }
+  } // for
+  return NULL;
+}
+
+/**
+ * Classifies a non-blank line of HTML or XML.  The line is scanned once,
+ * jumping from one `<` to the next: a line having only tags is passed through
+ * verbatim as is every line of a pre-formatted element (e.g., `<pre>`) or
+ * special markup (e.g., a comment) spanning lines; a line of text starting
+ * with a block-level tag or after one ending with one starts a paragraph.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @param s The line.
+ * @param pos The position of the first non-whitespace character of \a s.
+ * @param end The position just past the last non-whitespace character of \a s.
+ * @param indent The width of the leading whitespace of \a s.
+ * @param is_para_start Can \a s start a paragraph?
+ * @return Returns said line's type.
+ */
+NODISCARD
+static markup_line_t html_parse( markup_parser_t *parser, char const *s,
+                                 size_t pos, size_t end, size_t indent,
+                                 bool is_para_start ) {
+  char const *p = s + pos;
+  char const *const s_end = s + end;
+
+  if ( parser->delim_len > 0 ) {
+    if ( html_delim_find( parser, p, s_end ) != NULL )
+      parser->delim_len = 0;
+    return markup_verbatim( parser );
+  }
+
+  bool const was_break = parser->prev_break;
+  bool has_block = false, has_special = false, has_text = false;
+  bool is_pre = false, starts_block = false;
+
+  while ( p != NULL && p < s_end ) {
+    if ( *p != '<' ) {
+      has_text = true;
+      parser->prev_break = false;
+      p = memchr( p, '<', STATIC_CAST( size_t, s_end - p ) );
+      continue;
+    }
+    bool is_end_tag;
+    char const *tag_end;
+    html_state_t const html_state =
+      html_tag_parse( p, s_end, &is_end_tag, &tag_end );
+    switch ( html_state ) {
+      case HTML_END:                    // can't happen
+      case HTML_NONE:
+        if ( tag_end == NULL ) {        // not a tag, e.g., "a < b"
+          has_text = true;
+          parser->prev_break = false;
+          ++p;
+          continue;
+        }
+        break;                          // inline element
+      case HTML_ELEMENT:
+        has_block = true;
+        starts_block = starts_block || p == s + pos;
+        parser->prev_break = true;
+        break;
+      case HTML_PRE:
+        is_pre = true;
+        if ( !is_end_tag ) {
+          //
+          // Pass lines through verbatim until the matching end tag, e.g.,
+          // "</pre", that's found in a single pass over each line.
+          //
+          size_t const name_len = strspn( p + 1, HTML_ALPHA_CHARS );
+          parser->delim[0] = '<';
+          parser->delim[1] = '/';
+          memcpy( parser->delim + 2, p + 1, name_len );
+          parser->delim_len = 2 + name_len;
+          if ( html_delim_find( parser, tag_end, s_end ) != NULL )
+            parser->delim_len = 0;
+        }
+        break;
+      case HTML_CDATA:
+      case HTML_COMMENT:
+      case HTML_DOCTYPE:
+      case HTML_PI:
+        has_special = true;
+        if ( tag_end == NULL ) {
+          //
+          // The special markup continues on the next line: pass lines through
+          // verbatim until its end.
+          //
+          char const *const delim =
+            html_state == HTML_CDATA   ? "]]>" :
+            html_state == HTML_COMMENT ? "-->" :
+            html_state == HTML_PI      ? "?>"  : ">";
+          parser->delim_len = strlen( delim );
+          memcpy( parser->delim, delim, parser->delim_len );
+          return markup_verbatim( parser );
+        }
+        break;
+    } // switch
+    p = tag_end;
+  } // while
+
+  if ( is_pre || (!has_text && (has_block || has_special)) )
+    return markup_verbatim( parser );
+  if ( is_para_start || was_break || starts_block )
+    return markup_para( parser, indent, 0 );
+  return MARKUP_LINE_TEXT;
+}
+
+/**
+ * Adds the name of a **roff**(7) macro to a list of them, if there's room.
+ *
+ * @param list The list of space-terminated names to add to.
+ * @param cap The capacity of \a list.
+ * @param name The name to add.  It need not be null-terminated.
+ * @param len The length of \a name.
+ */
+static void roff_macro_add( char *list, size_t cap, char const *name,
+                            size_t len ) {
+  size_t const list_len = strlen( list );
+  if ( list_len + len + 2 > cap )
+    return;
+  memcpy( list + list_len, name, len );
+  list[ list_len + len ] = ' ';
+  list[ list_len + len + 1 ] = '\0';
+}
+
+/**
+ * Checks whether the name of a **roff**(7) macro is in a list of them.
+ *
+ * @param list The list of space-terminated names to search.
+ * @param name The name to find.  It need not be null-terminated.
+ * @param len The length of \a name.
+ * @return Returns `true` only if \a name is in \a list.
+ */
+NODISCARD
+static bool roff_macro_find( char const *list, char const *name, size_t len ) {
+  for ( char const *m = list; *m != '\0'; ) {
+    size_t const m_len = strcspn( m, " " );
+    if ( m_len == len && strncmp( m, name, len ) == 0 )
+      return true;
+    m += m_len + 1;
+  } // for
+  return false;
+}
+
+/**
+ * Classifies a non-blank line of **roff**(7).  A control line (one starting
+ * with `.` or `'`) or comment is passed through verbatim as is every line of a
+ * no-fill region (e.g., between `.nf` and `.fi` or macros defined to use
+ * them), macro definition, ignored block, or preprocessor region (e.g.,
+ * between `.TS` and `.TE`); so is a line of text starting with whitespace
+ * since **roff**(7) doesn't fill it either.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @param s The line.
+ * @param pos The position of the first non-whitespace character of \a s.
+ * @param end The position just past the last non-whitespace character of \a s.
+ * @param is_para_start Can \a s start a paragraph?
+ * @return Returns said line's type.
+ */
+NODISCARD
+static markup_line_t roff_parse( markup_parser_t *parser, char const *s,
+                                 size_t pos, size_t end, bool is_para_start ) {
+  if ( pos == 0 && (s[0] == '.' || s[0] == '\'') ) {
+    size_t n = 1;
+    size_t const name_len = roff_word( s, &n, end );
+    char const *const name = s + n - name_len;
+
+    if ( parser->delim_len > 0 ) {
+      //
+      // In a macro definition, ignored block, or preprocessor region: only
+      // the request or macro ending it matters.
+      //
+      if ( name_len == parser->delim_len &&
+           strncmp( name, parser->delim, name_len ) == 0 ) {
+        parser->delim_len = parser->roff_def_len = 0;
+      } else if ( parser->roff_def_len > 0 && name_len == 2 ) {
+        //
+        // A macro that turns no-fill mode on or off, e.g., one for examples:
+        // remember it so each use of it does too.
+        //
+        if ( strncmp( name, "nf", 2 ) == 0 || strncmp( name, "EX", 2 ) == 0 ) {
+          roff_macro_add( parser->roff_nf, sizeof parser->roff_nf,
+                          parser->roff_def, parser->roff_def_len );
+        } else if ( strncmp( name, "fi", 2 ) == 0 ||
+                    strncmp( name, "EE", 2 ) == 0 ) {
+          roff_macro_add( parser->roff_fi, sizeof parser->roff_fi,
+                          parser->roff_def, parser->roff_def_len );
+        }
+      }
+      return markup_verbatim( parser );
+    }
+
+    if ( roff_macro_find( parser->roff_nf, name, name_len ) ) {
+      parser->in_pre = true;
+      return markup_verbatim( parser );
+    }
+    if ( roff_macro_find( parser->roff_fi, name, name_len ) ) {
+      parser->in_pre = false;
+      return markup_verbatim( parser );
+    }
+
+    if ( roff_name_is( name, name_len, "am" ) ||
+         roff_name_is( name, name_len, "de" ) ||
+         roff_name_is( name, name_len, "ig" ) ) {
+      //
+      // A macro definition or ignored block ends with "..", or with the macro
+      // given after the name being defined (or after .ig itself).
+      //
+      if ( name[0] != 'i' ) {
+        size_t const def_len = roff_word( s, &n, end );
+        if ( def_len < sizeof parser->roff_def ) {
+          memcpy( parser->roff_def, s + n - def_len, def_len );
+          parser->roff_def_len = def_len;
+        }
+      }
+      size_t const end_len = roff_word( s, &n, end );
+      if ( end_len > 0 && end_len < sizeof parser->delim ) {
+        memcpy( parser->delim, s + n - end_len, end_len );
+        parser->delim_len = end_len;
+      } else {
+        parser->delim[0] = '.';
+        parser->delim_len = 1;
+      }
+      return markup_verbatim( parser );
+    }
+
+    for ( size_t i = 0; name_len == 2 && i < ARRAY_SIZE( ROFF_REGIONS ); ++i ) {
+      char const *const *const region = ROFF_REGIONS[i];
+      if ( strncmp( name, region[1], 2 ) == 0 ) {
+        parser->in_pre = false;
+        break;
+      }
+      if ( strncmp( name, region[0], 2 ) != 0 )
+        continue;
+      if ( region[0][0] == 'B' ) {
+        bool is_pre = false;
+        for ( size_t arg_len; !is_pre &&
+              (arg_len = roff_word( s, &n, end )) > 0; ) {
+          char const *const arg = s + n - arg_len;
+          is_pre = (arg_len == 8 && strncmp( arg, "-literal", 8 ) == 0) ||
+                   (arg_len == 9 && strncmp( arg, "-unfilled", 9 ) == 0);
+        } // for
+        if ( !is_pre )
+          break;
+      }
+      if ( strchr( "EfV", region[1][0] ) != NULL ) {
+        parser->in_pre = true;          // not filled until its end
+      } else {
+        memcpy( parser->delim, region[1], 2 );
+        parser->delim_len = 2;          // not text until its end
+      }
+      break;
+    } // for
+
+    return markup_verbatim( parser );
+  }
+
+  if ( parser->delim_len > 0 || parser->in_pre )
+    return markup_verbatim( parser );
+  if ( pos > 0 )
+    return markup_verbatim( parser );   // roff doesn't fill it either
+  if ( s[0] == '\\' && end > 1 && (s[1] == '"' || s[1] == '#') )
+    return markup_verbatim( parser );   // comment
+
+  return is_para_start ? markup_para( parser, 0, 0 ) : MARKUP_LINE_TEXT;
+}
+
+/**
+ * Classifies a non-blank line of reStructuredText.
+ *
+ * @param parser The \ref markup_parser to use.
+ * @param s The line.
+ * @param pos The position of the first non-whitespace character of \a s.
+ * @param end The position just past the last non-whitespace character of \a s.
+ * @param indent The width of the leading whitespace of \a s.
+ * @param is_para_start Can \a s start a paragraph?
+ * @return Returns said line's type.
+ */
+NODISCARD
+static markup_line_t rst_parse( markup_parser_t *parser, char const *s,
+                                size_t pos, size_t end, size_t indent,
+                                bool is_para_start ) {
+  if ( parser->in_pre ) {
+    if ( indent > parser->pre_indent )
+      return markup_verbatim( parser );
+    parser->in_pre = false;
+  }
+  if ( true_clear( &parser->pre_pending ) && indent > parser->pre_indent ) {
+    parser->in_pre = true;              // literal block or directive content
+    return markup_verbatim( parser );
+  }
+  if ( parser->in_table )
+    return markup_verbatim( parser );
+
+  char const c = s[ pos ];
+  size_t const run = markup_run( s, pos, end );
+
+  if ( run >= 2 && !markup_is_digit( c ) &&
+       !((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) ) {
+    //
+    // A line of only the same punctuation character, possibly with spaces, is
+    // either a section title adornment, a transition, or a simple table's
+    // border (that has spaces between its columns).
+    //
+    bool has_space = false;
+    size_t i = pos + run;
+    for ( ; i < end && (s[i] == c || s[i] == ' '); ++i )
+      has_space = has_space || s[i] == ' ';
+    if ( i == end ) {
+      parser->in_table = has_space;
+      return markup_verbatim( parser );
+    }
+  }
+
+  size_t marker = 0;                    // list item marker width, if any
+
+  switch ( c ) {
+    case '.':
+      if ( run == 2 && (pos + 2 == end || s[ pos + 2 ] == ' ') ) {
+        //
+        // Explicit markup: the content of a directive whose content is text
+        // is wrapped; that of anything else (e.g., a comment, code, or
+        // footnote) is passed through verbatim.
+        //
+        char const *const name = s + pos + 3;
+        char const *const colons = pos + 3 < end ?
+          memchr( name, ':', STATIC_CAST( size_t, s + end - name ) ) : NULL;
+        bool is_text = false;
+        if ( colons != NULL && colons + 1 < s + end && colons[1] == ':' ) {
+          size_t const name_len = STATIC_CAST( size_t, colons - name );
+          for ( size_t i = 0; i < ARRAY_SIZE( RST_TEXT_DIRECTIVES ); ++i ) {
+            char const *const d = RST_TEXT_DIRECTIVES[i];
+            if ( strncmp( d, name, name_len ) == 0 && d[ name_len ] == '\0' ) {
+              is_text = true;
+              break;
+            }
+          } // for
+        }
+        if ( !is_text ) {
+          parser->pre_pending = true;
+          parser->pre_indent = indent;
+        }
+        return markup_verbatim( parser );
+      }
+      break;
+    case '+':
+      if ( run == 1 && pos + 1 < end &&
+           (s[ pos + 1 ] == '-' || s[ pos + 1 ] == '=') ) {
+        parser->in_table = true;        // grid table
+        return markup_verbatim( parser );
+      }
+      FALLTHROUGH;
+    case '*':
+    case '-':
+      if ( run == 1 && (pos + 1 == end || s[ pos + 1 ] == ' ') )
+        marker = 2;
+      break;
+    case '|':
+      if ( pos + 1 == end || s[ pos + 1 ] == ' ' ) {
+        parser->in_table = true;        // line block
+        return markup_verbatim( parser );
+      }
+      break;
+    case '>':
+      if ( run == 3 ) {
+        parser->in_table = true;        // doctest block
+        return markup_verbatim( parser );
+      }
+      break;
+    case ':':
+      if ( run == 1 ) {
+        char const *const colon = memchr( s + pos + 1, ':', end - pos - 1 );
+        if ( colon != NULL && colon > s + pos + 1 && s[ pos + 1 ] != ' ' ) {
+          parser->pre_pending = true;   // field list
+          parser->pre_indent = indent;
+          return markup_verbatim( parser );
+        }
+      }
+      break;
+    default: {
+      //
+      // An enumerated list item: "1.", "1)", "(1)", "#.", "#)", or "(#)".
+      //
+      size_t n = pos + (c == '(');
+      if ( n < end && s[n] == '#' )
+        ++n;
+      else
+        while ( n < end && markup_is_digit( s[n] ) )
+          ++n;
+      if ( n > pos + (c == '(') && n < end &&
+           (s[n] == ')' || (s[n] == '.' && c != '(')) &&
+           (n + 1 == end || s[ n + 1 ] == ' ') ) {
+        marker = n + 2 - pos;
+      }
+    }
+  } // switch
+
+  if ( end - pos >= 2 && s[ end - 1 ] == ':' && s[ end - 2 ] == ':' ) {
+    //
+    // A paragraph ending in "::" is followed by a literal block.
+    //
+    parser->pre_pending = true;
+    parser->pre_indent = marker > 0 ? indent + marker :
+      is_para_start ? indent : parser->indent + parser->hang;
+  }
+
+  if ( marker > 0 && (is_para_start || parser->in_item) )
+    return markup_para( parser, indent, marker );
+  if ( is_para_start || indent != parser->indent + parser->hang )
+    return markup_para( parser, indent, 0 );
+  return MARKUP_LINE_TEXT;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+size_t markup_html_no_wrap( char const *s, regex_ranges_t *ranges ) {
+  assert( s != NULL );
+  assert( ranges != NULL );
+
+  ranges->len = 0;
+  char const *const end = s + strlen( s );
+  for ( char const *p = s;
+        (p = memchr( p, '<', STATIC_CAST( size_t, end - p ) )) != NULL; ) {
+    bool is_end_tag;
+    char const *tag_end;
+    PJL_DISCARD_RV( html_tag_parse( p, end, &is_end_tag, &tag_end ) );
+    if ( tag_end == NULL ) {
+      ++p;
+      continue;
+    }
+    regex_ranges_add(
+      ranges, STATIC_CAST( size_t, p - s ), STATIC_CAST( size_t, tag_end - s )
+    );
+    p = tag_end;
+  } // for
+  return ranges->len;
+}
+
+size_t markup_roff_no_wrap( char const *s, regex_ranges_t *ranges ) {
+  assert( s != NULL );
+  assert( ranges != NULL );
+
+  ranges->len = 0;
+  size_t prev = 0;                      // start of previous word
+  for ( size_t i = 0; s[i] != '\0'; ) {
+    if ( strchr( WS_STRN, s[i] ) == NULL ) {
+      prev = i;
+      while ( s[i] != '\0' && strchr( WS_STRN, s[i] ) == NULL )
+        ++i;
+      continue;
+    }
+    while ( s[i] != '\0' && strchr( WS_STRN, s[i] ) != NULL )
+      ++i;
+    if ( s[i] != '.' && s[i] != '\'' )
+      continue;
+    //
+    // Keep the word with the one before it so it never starts a line.
+    //
+    size_t end = i;
+    while ( s[ end ] != '\0' && strchr( WS_STRN, s[ end ] ) == NULL )
+      ++end;
+    if ( ranges->len > 0 && ranges->range[ ranges->len - 1 ][1] >= prev )
+      ranges->range[ ranges->len - 1 ][1] = end;
+    else
+      regex_ranges_add( ranges, prev, end );
+  } // for
+  return ranges->len;
+}
+
+markup_line_t markup_parse( markup_parser_t *parser, char const *line,
+                            size_t len ) {
+  assert( parser != NULL );
+  assert( line != NULL );
+
+  size_t pos = 0, indent = 0;
+  for ( ; pos < len; ++pos ) {
+    if ( line[ pos ] == ' ' )
+      ++indent;
+    else if ( line[ pos ] == '\t' )
+      indent = (indent / 8 + 1) * 8;
+    else
+      break;
+  } // for
+  size_t end = len;
+  while ( end > pos && strchr( WS_STRN, line[ end - 1 ] ) != NULL )
+    --end;
+
+  if ( pos == end ) {
+    bool const is_verbatim = parser->in_pre || parser->delim_len > 0;
+    parser->prev_blank = true;
+    parser->prev_break = false;
+    parser->in_table = false;
+    if ( parser->markup == MARKUP_ASCIIDOC )
+      parser->in_pre = false;
+    return is_verbatim ? markup_verbatim( parser ) : MARKUP_LINE_TEXT;
+  }
+
+  bool const is_para_start = parser->prev_blank || parser->prev_verbatim;
+  parser->prev_blank = parser->prev_verbatim = false;
+  switch ( parser->markup ) {
+    case MARKUP_ASCIIDOC:
+      return adoc_parse( parser, line, pos, end, indent, is_para_start );
+    case MARKUP_HTML:
+      return html_parse( parser, line, pos, end, indent, is_para_start );
+    case MARKUP_ROFF:
+      return roff_parse( parser, line, pos, end, is_para_start );
+    case MARKUP_NONE:                   // can't happen
+    case MARKUP_RST:
+      break;
+  } // switch
+  return rst_parse( parser, line, pos, end, indent, is_para_start );
+}
+
+void markup_parser_init( markup_parser_t *parser, markup_t markup ) {
+  assert( parser != NULL );
+  assert( markup != MARKUP_NONE );
+  memset( parser, 0, sizeof *parser );
+  parser->markup = markup;
+  parser->prev_blank = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
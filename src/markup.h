@@ -0,0 +1,158 @@
+/*
+**      wrap -- text reformatter
+**      src/markup.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_markup_H
+#define wrap_markup_H
+
+/**
+ * @file
+ * Declares data structures and functions for classifying lines of
+ * [reStructuredText](https://docutils.sourceforge.io/rst.html),
+ * [AsciiDoc](https://asciidoc.org/), HTML or XML, and **roff**(7).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "options.h"
+#include "wregex.h"                     /* for regex_ranges_t */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup markup-group Markup Support
+ * Data structures and functions for classifying lines of reStructuredText,
+ * AsciiDoc, HTML or XML, and roff so that only their paragraphs are wrapped.
+ * Unlike Markdown, only whole lines are classified: a line is either text or
+ * passed through as-is.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Markup line types, i.e., how a line is to be handled.
+ */
+enum markup_line {
+  /// Text continuing the current paragraph: wrapped normally.
+  MARKUP_LINE_TEXT,
+
+  /// Text starting a paragraph, list item, or block quote: the paragraph is
+  /// delimited before the line that's then wrapped normally, but indented per
+  /// \ref markup_parser::indent "indent" and
+  /// \ref markup_parser::hang "hang".
+  MARKUP_LINE_PARA,
+
+  /// Markup (e.g., a title, directive, delimiter, or line of only tags) or
+  /// preformatted text (e.g., a literal block): the paragraph is delimited before the line that's
+  /// then kept verbatim.
+  MARKUP_LINE_VERBATIM,
+};
+typedef enum markup_line markup_line_t;
+
+/**
+ * Markup parser state.
+ */
+struct markup_parser {
+  markup_t    markup;                   ///< Markup language being parsed.
+  size_t      indent;                   ///< Indent of last #MARKUP_LINE_PARA.
+  size_t      hang;                     ///< Hang of last #MARKUP_LINE_PARA.
+
+  size_t      delim_len;                ///< Length of verbatim delimiter.
+  char        delim[16];                ///< Delimiter ending verbatim block.
+  bool        in_item;                  ///< Is paragraph a list item?
+  bool        in_pre;                   ///< In indented preformatted text?
+  bool        in_table;                 ///< In table-like block?
+  bool        prev_blank;               ///< Was previous line blank?
+  bool        prev_break;               ///< Previous line ended in a break?
+  bool        prev_verbatim;            ///< Was previous line verbatim?
+  bool        pre_pending;              ///< Indented text after line is pre?
+  size_t      pre_indent;               ///< Indent pre text must exceed.
+
+  size_t      roff_def_len;             ///< Length of \ref roff_def.
+  char        roff_def[8];              ///< Name of roff macro being defined.
+  char        roff_nf[32];              ///< Roff macros that start no-fill.
+  char        roff_fi[32];              ///< Roff macros that end no-fill.
+};
+typedef struct markup_parser markup_parser_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Finds the ranges of a line of HTML or XML text that mustn't be wrapped
+ * within at non-whitespace characters: its tags and special markup (e.g.,
+ * comments) entirely on the line.  This is a single, linear scan that jumps
+ * from one `<` to the next.
+ *
+ * @param s The null-terminated line to scan.
+ * @param ranges A pointer to the \ref regex_ranges to receive said ranges, in
+ * order.  Any existing ranges are discarded.
+ * @return Returns the number of ranges.
+ */
+PJL_DISCARD
+size_t markup_html_no_wrap( char const *s, regex_ranges_t *ranges );
+
+/**
+ * Classifies a line of markup.
+ *
+ * @param parser The \ref markup_parser previously initialized by
+ * markup_parser_init().
+ * @param line The line to classify.  It need not be null-terminated.
+ * @param len The length of \a line including its newline, if any.
+ * @return Returns said line's type.  If #MARKUP_LINE_PARA, \a parser's
+ * \ref markup_parser::indent "indent" and \ref markup_parser::hang "hang"
+ * are set.
+ */
+NODISCARD
+markup_line_t markup_parse( markup_parser_t *parser, char const *line,
+                            size_t len );
+
+/**
+ * Finds the ranges of a line of **roff**(7) text that mustn't be wrapped
+ * within: each word starting with `.` or `'` along with the word before it
+ * since, were the former to start a line, it would become a control line.
+ *
+ * @param s The null-terminated line to scan.
+ * @param ranges A pointer to the \ref regex_ranges to receive said ranges, in
+ * order.  Any existing ranges are discarded.
+ * @return Returns the number of ranges.
+ */
+PJL_DISCARD
+size_t markup_roff_no_wrap( char const *s, regex_ranges_t *ranges );
+
+/**
+ * Initializes \a parser.
+ *
+ * @param parser The \ref markup_parser to initialize.
+ * @param markup The markup language to parse; must not be #MARKUP_NONE.
+ */
+void markup_parser_init( markup_parser_t *parser, markup_t markup );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_markup_H */
+/* vim:set et sw=2 ts=2: */
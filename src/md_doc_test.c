@@ -0,0 +1,291 @@
+/*
+**      wrap -- text reformatter
+**      src/md_doc_test.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Checks that reclassifying a Markdown document incrementally via
+ * md_doc_update() after each of a number of edits at every line gives the
+ * same blocks as classifying the edited document from scratch.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "markdown.h"
+#include "util.h"
+
+// standard
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sysexits.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An edit to make to a document at a given line.
+ */
+struct test_edit {
+  char const *name;                     ///< Name to report.
+  size_t      n_removed;                ///< Number of lines to remove.
+  char const *added;                    ///< Line to add, if any.
+  bool        dup_line;                 ///< Add a copy of the line instead?
+};
+typedef struct test_edit test_edit_t;
+
+/**
+ * A document: an array of lines.
+ */
+struct test_lines {
+  char  **line;                         ///< Null-terminated lines.
+  size_t  len;                          ///< Number of lines.
+};
+typedef struct test_lines test_lines_t;
+
+// local constant definitions
+
+/// Edits to make at every line.
+static test_edit_t const TEST_EDITS[] = {
+  { "delete",           1, NULL,        false },
+  { "duplicate",        0, NULL,        true  },
+  { "blank",            1, "\n",        false },
+  { "insert blank",     0, "\n",        false },
+  { "insert fence",     0, "```\n",     false },
+  { "insert list item", 0, "1. item\n", false },
+  { "insert HTML",      0, "<div>\n",   false },
+  { "insert text",      0, "text\n",    false },
+};
+
+// extern variable definitions
+char const       *me;                   ///< Program name.
+
+// local functions
+NODISCARD
+static bool blocks_equal( md_doc_t const*, md_doc_t const* );
+
+NODISCARD
+static char* line_dup( char const* );
+
+NODISCARD
+static test_lines_t lines_copy( test_lines_t const* );
+
+static void lines_free( test_lines_t* );
+
+NODISCARD
+static test_lines_t lines_read( char const* );
+
+_Noreturn
+static void test( char const* );
+
+_Noreturn
+static void usage( void );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Checks whether the blocks of two documents are the same.  Since sequence
+ * numbers are arbitrary, they need only correspond one-to-one.
+ *
+ * @param i_doc The first \ref md_doc.
+ * @param j_doc The second \ref md_doc.
+ * @return Returns `true` only if the blocks are the same.
+ */
+static bool blocks_equal( md_doc_t const *i_doc, md_doc_t const *j_doc ) {
+  if ( i_doc->len != j_doc->len )
+    return false;
+  for ( size_t b = 0; b < i_doc->len; ++b ) {
+    md_block_t const *const i = &i_doc->blocks[b];
+    md_block_t const *const j = &j_doc->blocks[b];
+    if ( i->line_type != j->line_type || i->depth != j->depth ||
+         i->indent_left != j->indent_left ||
+         i->indent_hang != j->indent_hang ||
+         i->line_first != j->line_first || i->line_count != j->line_count ) {
+      return false;
+    }
+    for ( size_t c = 0; c < b; ++c ) {
+      if ( (i_doc->blocks[c].seq_num == i->seq_num) !=
+           (j_doc->blocks[c].seq_num == j->seq_num) ) {
+        return false;
+      }
+    } // for
+  } // for
+  return true;
+}
+
+/**
+ * Duplicates \a line with room for its ordered list number, if any, to be
+ * renumbered in place.
+ *
+ * @param line The null-terminated line to duplicate.
+ * @return Returns said duplicate.  The caller is responsible for freeing it.
+ */
+static char* line_dup( char const *line ) {
+  assert( line != NULL );
+  size_t const size = strlen( line ) + 1;
+  char *const dup = MALLOC( char, size + MD_OL_RENUMBER_PAD );
+  memcpy( dup, line, size );
+  return dup;
+}
+
+/**
+ * Copies \a from.
+ *
+ * @param from The \ref test_lines to copy.
+ * @return Returns a copy that must be freed with lines_free().
+ */
+static test_lines_t lines_copy( test_lines_t const *from ) {
+  test_lines_t to = { .line = MALLOC( char*, from->len + 1 ), .len = 0 };
+  for ( ; to.len < from->len; ++to.len )
+    to.line[ to.len ] = line_dup( from->line[ to.len ] );
+  return to;
+}
+
+/**
+ * Frees all memory used by \a lines.
+ *
+ * @param lines The \ref test_lines to free.
+ */
+static void lines_free( test_lines_t *lines ) {
+  for ( size_t i = 0; i < lines->len; ++i )
+    FREE( lines->line[i] );
+  FREE( lines->line );
+}
+
+/**
+ * Reads all the lines of a file.
+ *
+ * @param path The full path of the file to read.
+ * @return Returns said lines that must be freed with lines_free().
+ */
+static test_lines_t lines_read( char const *path ) {
+  FILE *const fin = fopen( path, "r" );
+  if ( fin == NULL )
+    fatal_error( EX_NOINPUT, "\"%s\": %s\n", path, STRERROR() );
+
+  test_lines_t lines = { .line = MALLOC( char*, 1 ), .len = 0 };
+  char line_buf[ 256 ];
+  while ( fgets( line_buf, sizeof line_buf, fin ) != NULL ) {
+    REALLOC( lines.line, char*, lines.len + 2 );
+    lines.line[ lines.len++ ] = line_dup( line_buf );
+  } // while
+
+  FERROR( fin );
+  fclose( fin );
+  return lines;
+}
+
+/**
+ * Checks every edit of \ref TEST_EDITS at every line of \a test_path, then
+ * exits.
+ *
+ * @param test_path The full path of the test file.
+ */
+static void test( char const *test_path ) {
+  test_lines_t const orig = lines_read( test_path );
+  unsigned mismatches = 0;
+  size_t n_parsed = 0, n_full = 0;
+
+  for ( size_t l = 0; l <= orig.len; ++l ) {
+    for ( size_t e = 0; e < ARRAY_SIZE( TEST_EDITS ); ++e ) {
+      test_edit_t const *const edit = &TEST_EDITS[e];
+      if ( l + edit->n_removed > orig.len || (edit->dup_line && l == orig.len) )
+        continue;
+
+      test_lines_t doc_lines = lines_copy( &orig );
+      md_doc_t doc;
+      md_doc_init( &doc );
+      md_doc_parse( &doc, doc_lines.line, doc_lines.len );
+
+      //
+      // Make the edit.
+      //
+      char *const added = edit->dup_line ? line_dup( doc_lines.line[l] ) :
+                          edit->added != NULL ? line_dup( edit->added ) :
+                          NULL;
+      size_t const n_added = added != NULL;
+      for ( size_t i = 0; i < edit->n_removed; ++i )
+        FREE( doc_lines.line[ l + i ] );
+      memmove(
+        doc_lines.line + l + n_added, doc_lines.line + l + edit->n_removed,
+        (doc_lines.len - l - edit->n_removed) * sizeof( char* )
+      );
+      if ( added != NULL )
+        doc_lines.line[l] = added;
+      doc_lines.len = doc_lines.len - edit->n_removed + n_added;
+
+      test_lines_t full_lines = lines_copy( &doc_lines );
+      md_doc_t full;
+      md_doc_init( &full );
+      md_doc_parse( &full, full_lines.line, full_lines.len );
+
+      n_parsed += md_doc_update(
+        &doc, doc_lines.line, doc_lines.len, l, edit->n_removed, n_added
+      );
+      n_full += full_lines.len;
+
+      if ( !blocks_equal( &doc, &full ) ) {
+        EPRINTF(
+          "%s:%zu: %s: incremental and full blocks differ\n",
+          test_path, l + 1, edit->name
+        );
+        ++mismatches;
+      }
+      for ( size_t i = 0; i < doc_lines.len; ++i ) {
+        if ( strcmp( doc_lines.line[i], full_lines.line[i] ) != 0 ) {
+          EPRINTF(
+            "%s:%zu: %s: line %zu renumbered differently\n",
+            test_path, l + 1, edit->name, i + 1
+          );
+          ++mismatches;
+          break;
+        }
+      } // for
+
+      md_doc_cleanup( &doc );
+      md_doc_cleanup( &full );
+      lines_free( &doc_lines );
+      lines_free( &full_lines );
+    } // for
+  } // for
+
+  printf(
+    "%u mismatches; reclassified %zu of %zu lines\n",
+    mismatches, n_parsed, n_full
+  );
+  exit( mismatches > 0 ? EX_SOFTWARE : EX_OK );
+}
+
+static void usage( void ) {
+  EPRINTF( "usage: %s test\n", me );
+  exit( EX_USAGE );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+int main( int argc, char const *argv[] ) {
+  me = base_name( argv[0] );
+  if ( argc != 2 )
+    usage();
+  test( argv[1] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
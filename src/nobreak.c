@@ -0,0 +1,304 @@
+/*
+**      wrap -- text reformatter
+**      src/nobreak.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for finding tokens that are never to be broken within.
+ *
+ * @sa Alfred V. Aho and Margaret J. Corasick. "Efficient String Matching: An
+ * Aid to Bibliographic Search." _Communications of the ACM_ 18(6), 1975.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "nobreak.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdint.h>                     /* for uint8_t, uint32_t */
+#include <stdio.h>                      /* for getline(3) */
+#include <stdlib.h>                     /* for qsort(3) */
+#include <string.h>                     /* for memset(3), strcspn(3) */
+#include <sysexits.h>
+
+/// @endcond
+
+/**
+ * @addtogroup nobreak-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+// local variable definitions
+
+/**
+ * The class of each byte: 0 for one in no token; otherwise, 1 + the index of
+ * the distinct byte among those of all tokens.  Since all bytes in no token
+ * behave the same, this keeps the rows of \ref nb_next short.
+ */
+static uint8_t    nb_class[ 256 ];
+
+static size_t     nb_classes;           ///< Number of byte classes.
+static uint32_t  *nb_match_len;         ///< Longest token ending at state.
+
+/**
+ * The automaton as a DFA: the state after state _s_ and a byte of class _c_
+ * is `nb_next[` _s_ `*` \ref nb_classes `+` _c_ `]`.  State 0 is the start.
+ */
+static uint32_t  *nb_next;
+
+// local functions
+static void       nb_compile( char *const[], size_t );
+
+NODISCARD
+static int        nb_range_cmp( void const*, void const* );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Compiles \a tokens into the automaton.
+ *
+ * @param tokens The tokens.
+ * @param tokens_len The number of \a tokens; must be at least 1.
+ */
+static void nb_compile( char *const tokens[], size_t tokens_len ) {
+  assert( tokens != NULL );
+  assert( tokens_len > 0 );
+
+  size_t states_max = 1;
+  for ( size_t i = 0; i < tokens_len; ++i ) {
+    for ( char const *s = tokens[i]; *s != '\0'; ++s ) {
+      uint8_t *const class = &nb_class[ STATIC_CAST( uint8_t, *s ) ];
+      if ( *class == 0 )
+        *class = STATIC_CAST( uint8_t, ++nb_classes );
+      ++states_max;
+    } // for
+  } // for
+  ++nb_classes;                         // for class 0
+
+  size_t const next_len = states_max * nb_classes;
+  nb_next = MALLOC( uint32_t, next_len );
+  memset( nb_next, 0, next_len * sizeof( uint32_t ) );
+  nb_match_len = MALLOC( uint32_t, states_max );
+  memset( nb_match_len, 0, states_max * sizeof( uint32_t ) );
+
+  //
+  // Build the trie: since no state goes back to the start state 0, 0 means no
+  // transition.
+  //
+  uint32_t states = 1;
+  for ( size_t i = 0; i < tokens_len; ++i ) {
+    uint32_t state = 0;
+    for ( char const *s = tokens[i]; *s != '\0'; ++s ) {
+      uint8_t const class = nb_class[ STATIC_CAST( uint8_t, *s ) ];
+      uint32_t *const next = &nb_next[ state * nb_classes + class ];
+      if ( *next == 0 )
+        *next = states++;
+      state = *next;
+    } // for
+    nb_match_len[ state ] = STATIC_CAST( uint32_t, strlen( tokens[i] ) );
+  } // for
+
+  //
+  // Turn the trie into a DFA breadth-first: a missing transition of a state
+  // becomes that of its failure state (the state for the longest proper
+  // suffix of its string that's also a prefix of some token) that, being
+  // shallower, has already been turned.
+  //
+  uint32_t *const fail = MALLOC( uint32_t, states );
+  uint32_t *const queue = MALLOC( uint32_t, states );
+  size_t queue_head = 0, queue_tail = 0;
+  for ( size_t c = 0; c < nb_classes; ++c ) {
+    uint32_t const next = nb_next[c];
+    if ( next != 0 ) {
+      fail[ next ] = 0;
+      queue[ queue_tail++ ] = next;
+    }
+  } // for
+  while ( queue_head < queue_tail ) {
+    uint32_t const state = queue[ queue_head++ ];
+    uint32_t *const row = &nb_next[ state * nb_classes ];
+    uint32_t const *const fail_row = &nb_next[ fail[ state ] * nb_classes ];
+    for ( size_t c = 0; c < nb_classes; ++c ) {
+      if ( row[c] == 0 ) {
+        row[c] = fail_row[c];
+        continue;
+      }
+      uint32_t const next = row[c];
+      fail[ next ] = fail_row[c];
+      //
+      // A token ending at the failure state also ends here, but it's shorter
+      // than one ending here, if any.
+      //
+      if ( nb_match_len[ next ] == 0 )
+        nb_match_len[ next ] = nb_match_len[ fail[ next ] ];
+      queue[ queue_tail++ ] = next;
+    } // for
+  } // while
+
+  FREE( fail );
+  FREE( queue );
+}
+
+/**
+ * Comparison function for **qsort**(3) that compares two ranges by their
+ * beginning positions.
+ *
+ * @param i_data A pointer to the first range.
+ * @param j_data A pointer to the second range.
+ * @return Returns an integer less than zero, zero, or greater than zero if
+ * the first range begins before, at, or after the second, respectively.
+ */
+NODISCARD
+static int nb_range_cmp( void const *i_data, void const *j_data ) {
+  size_t const i_begin = *STATIC_CAST( size_t const*, i_data );
+  size_t const j_begin = *STATIC_CAST( size_t const*, j_data );
+  return (i_begin > j_begin) - (i_begin < j_begin);
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void nobreak_cleanup( void ) {
+  FREE( nb_next );
+  FREE( nb_match_len );
+  nb_next = NULL;
+  nb_match_len = NULL;
+  nb_classes = 0;
+  memset( nb_class, 0, sizeof nb_class );
+}
+
+size_t nobreak_find( char const *s, regex_ranges_t *ranges ) {
+  assert( s != NULL );
+  assert( ranges != NULL );
+  assert( nb_next != NULL );
+
+  size_t const ranges_len = ranges->len;
+  uint32_t state = 0;
+  for ( size_t i = 0; s[i] != '\0'; ++i ) {
+    uint8_t const class = nb_class[ STATIC_CAST( uint8_t, s[i] ) ];
+    state = nb_next[ state * nb_classes + class ];
+    if ( nb_match_len[ state ] == 0 )
+      continue;
+    size_t const begin = i + 1 - nb_match_len[ state ];
+    if ( ranges->len > ranges_len ) {
+      //
+      // Matches are found in order of their ends, so one that begins within
+      // the last one found just extends it.
+      //
+      size_t *const last = ranges->range[ ranges->len - 1 ];
+      if ( begin >= last[0] && begin < last[1] ) {
+        last[1] = i + 1;
+        continue;
+      }
+    }
+    if ( ranges->len == ranges->cap ) {
+      ranges->cap = ranges->cap == 0 ? 4 : ranges->cap * 2;
+      REALLOC( ranges->range, size_t[2], ranges->cap );
+    }
+    ranges->range[ ranges->len ][0] = begin;
+    ranges->range[ ranges->len ][1] = i + 1;
+    ++ranges->len;
+  } // for
+
+  size_t const found = ranges->len - ranges_len;
+  if ( found == 0 )
+    return 0;
+
+  //
+  // Merge the matches with the ranges that were already there.
+  //
+  qsort( ranges->range, ranges->len, sizeof *ranges->range, &nb_range_cmp );
+  size_t n = 0;
+  for ( size_t i = 0; i < ranges->len; ++i ) {
+    size_t const *const range = ranges->range[i];
+    if ( n > 0 && range[0] < ranges->range[ n - 1 ][1] ) {
+      if ( range[1] > ranges->range[ n - 1 ][1] )
+        ranges->range[ n - 1 ][1] = range[1];
+      continue;
+    }
+    ranges->range[ n ][0] = range[0];
+    ranges->range[ n ][1] = range[1];
+    ++n;
+  } // for
+  ranges->len = n;
+  return found;
+}
+
+void nobreak_init( char const *path ) {
+  assert( path != NULL );
+  assert( nb_next == NULL );
+
+  FILE *const fin = fopen( path, "r" );
+  if ( fin == NULL )
+    fatal_error( EX_NOINPUT, "%s: %s\n", path, STRERROR() );
+
+  char **tokens = NULL;
+  size_t tokens_cap = 0, tokens_len = 0;
+  char *line = NULL;
+  size_t line_cap = 0;
+  unsigned line_no = 0;
+
+  while ( getline( &line, &line_cap, fin ) != -1 ) {
+    ++line_no;
+    char *token = line;
+    SKIP_CHARS( token, WS_STRN );
+    if ( *token == '\0' || *token == '#' )
+      continue;
+    size_t len = strlen( token );
+    while ( strchr( WS_STRN, token[ len - 1 ] ) != NULL )
+      --len;
+    token[ len ] = '\0';
+    if ( token[ strcspn( token, WS_STR ) ] != '\0' ) {
+      fatal_error( EX_DATAERR,
+        "%s:%u: \"%s\": token may not contain whitespace\n",
+        path, line_no, token
+      );
+    }
+    if ( tokens_len == tokens_cap ) {
+      tokens_cap = tokens_cap == 0 ? 64 : tokens_cap * 2;
+      REALLOC( tokens, char*, tokens_cap );
+    }
+    tokens[ tokens_len++ ] = check_strdup( token );
+  } // while
+
+  if ( unlikely( ferror( fin ) ) )
+    fatal_error( EX_IOERR, "%s: %s\n", path, STRERROR() );
+  fclose( fin );
+  free( line );
+  if ( tokens_len == 0 )
+    fatal_error( EX_DATAERR, "%s: no tokens\n", path );
+
+  ATEXIT( &nobreak_cleanup );
+  nb_compile( tokens, tokens_len );
+
+  for ( size_t i = 0; i < tokens_len; ++i )
+    FREE( tokens[i] );
+  FREE( tokens );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
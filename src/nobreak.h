@@ -0,0 +1,90 @@
+/*
+**      wrap -- text reformatter
+**      src/nobreak.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_nobreak_H
+#define wrap_nobreak_H
+
+/**
+ * @file
+ * Declares functions for finding tokens, e.g., `x86-64` or `pre-commit`, that
+ * are never to be broken within.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "wregex.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup nobreak-group No-Break Tokens
+ * Functions for finding tokens that are never to be broken within using an
+ * Aho-Corasick automaton so all of them are found in a single pass over a
+ * line no matter how many there are.
+ * @{
+ */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees all memory used by the no-break tokens, if any.
+ *
+ * @sa nobreak_init()
+ */
+void nobreak_cleanup( void );
+
+/**
+ * Finds every occurrence of every no-break token in \a s and merges their
+ * ranges into \a ranges so that they remain in order and don't overlap.
+ *
+ * @param s The null-terminated string to search.
+ * @param ranges A pointer to the \ref regex_ranges to merge into.  Any ranges
+ * it already has must be in order and not overlap.
+ * @return Returns the number of occurrences found.
+ *
+ * @note nobreak_init() must have been called first.
+ */
+PJL_DISCARD
+size_t nobreak_find( char const *s, regex_ranges_t *ranges );
+
+/**
+ * Reads no-break tokens, one per line, from a file and compiles them into an
+ * Aho-Corasick automaton.  Leading and trailing whitespace is ignored as are
+ * blank lines and lines whose first non-whitespace character is `#`.  If the
+ * file can't be read, a token contains whitespace, or there are no tokens,
+ * prints an error message and exits.
+ *
+ * @param path The path of the file to read.
+ *
+ * @sa nobreak_cleanup()
+ */
+void nobreak_init( char const *path );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_nobreak_H */
+/* vim:set et sw=2 ts=2: */
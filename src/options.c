@@ -28,9 +28,11 @@
 #include "pjl_config.h"                 /* must go first */
 #include "options.h"
 #include "alias.h"
+#include "codec.h"
 #include "common.h"
 #include "pattern.h"
 #include "read_conf.h"
+#include "reader.h"
 #include "util.h"
 
 /// @cond DOXYGEN_IGNORE
@@ -42,6 +44,8 @@
 #include <getopt.h>
 #include <inttypes.h>                   /* for SIZE_MAX */
 #include <stdbool.h>
+#include <string.h>
+#include <sys/stat.h>                   /* for stat(2) */
 
 /// @endcond
 
@@ -84,38 +88,79 @@ static char const   COMMENT_CHARS_DEFAULT[] =
 /// Otherwise Doxygen generates two entries for each option.
 
 // extern option variables
+char const         *opt_abbreviations;
+bool                opt_affinity;
 char const         *opt_alias;
+bool                opt_align_block;
 char                opt_align_char;
 size_t              opt_align_column;
+bool                opt_all_comments;
 char const         *opt_block_regex;
+bool                opt_check;
 char const         *opt_comment_chars = COMMENT_CHARS_DEFAULT;
 char const         *opt_conf_file;
 bool                opt_doxygen;
+bool                opt_edits;
+bool                opt_email_quotes;
 eol_t               opt_eol = EOL_INPUT;
 bool                opt_eos_delimit;
 size_t              opt_eos_spaces = EOS_SPACES_DEFAULT;
+bool                opt_expand_tabs;
 bool                opt_data_link_esc;
+bool                opt_diff;
 char const         *opt_fin_name;
+char const         *opt_fin_path;
+char const *const  *opt_files;
+size_t              opt_files_len;
+size_t              opt_follow;
+char const         *opt_git_changed;
+git_file_t const   *opt_git_files;
 size_t              opt_hang_spaces;
 size_t              opt_hang_tabs;
+char const         *opt_hyphenate;
 size_t              opt_indt_spaces;
 size_t              opt_indt_tabs;
+bool                opt_in_place;
+size_t              opt_jobs = 1;
+char const         *opt_jsonl;
+bool                opt_jsonl_text;
+bool                opt_justify;
+bool                opt_keep_bom;
+bool                opt_keep_encoding;
 bool                opt_lead_dot_ignore;
 size_t              opt_lead_spaces;
 char const         *opt_lead_string;
 size_t              opt_lead_tabs;
 bool                opt_lead_ws_delimit;
 size_t              opt_line_width = LINE_WIDTH_DEFAULT;
+size_t              opt_lines_first;
+size_t              opt_lines_last = SIZE_MAX;
 bool                opt_markdown;
+bool                opt_markdown_tables;
+markup_t            opt_markup = MARKUP_NONE;
+size_t              opt_max_lines;
+bool                opt_measure;
+bool                opt_minimal;
 size_t              opt_mirror_spaces;
 size_t              opt_mirror_tabs;
 size_t              opt_newlines_delimit = NEWLINES_DELIMIT_DEFAULT;
+char const         *opt_no_break;
 bool                opt_no_conf;
 bool                opt_no_hyphen;
+size_t              opt_optimal;
+char const         *opt_para_cache;
 char const         *opt_para_delims;
 bool                opt_prototype;
+char const         *opt_read_index;
+bool                opt_stats;
+size_t              opt_stats_paras;
 size_t              opt_tab_spaces = TAB_SPACES_DEFAULT;
 bool                opt_title_line;
+bool                opt_unicode_breaks;
+size_t              opt_widths[ WIDTHS_MAX ];
+size_t              opt_widths_len;
+char const         *opt_widths_path;
+char const         *opt_write_index;
 
 /// @endcond
 
@@ -124,10 +169,19 @@ static char const  *fin_path = "-";     ///< File in path.
 static char const  *fout_path = "-";    ///< File out path.
 static bool         is_wrapc;           ///< Are we **wrapc**(1)?
 static bool         opts_given[ 128 ];  ///< Options given indexed by `char`.
+static void       (*usage_fn)(int);     ///< Usage function.
 
 // local functions
+static void         apply_alias( alias_t const* );
+static void         parse_options( int, char const*[], char const[const static 2],
+                                   struct option const[const static 2],
+                                   char const[const static 1], void (*)(int),
+                                   unsigned );
+
 NODISCARD
-static unsigned     parse_width( char const* );
+static size_t       parse_width( char const* );
+
+static void         parse_widths( char const* );
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -148,16 +202,23 @@ static unsigned     parse_width( char const* );
   SOPT(EOL)                   SOPT_REQUIRED_ARGUMENT  \
   SOPT(EOS_DELIMIT)           SOPT_NO_ARGUMENT        \
   SOPT(EOS_SPACES)            SOPT_REQUIRED_ARGUMENT  \
+  SOPT(EXPAND_TABS)           SOPT_NO_ARGUMENT        \
   SOPT(FILE)                  SOPT_REQUIRED_ARGUMENT  \
   SOPT(FILE_NAME)             SOPT_REQUIRED_ARGUMENT  \
+  SOPT(GIT_CHANGED)           SOPT_OPTIONAL_ARGUMENT  \
   SOPT(HELP)                  SOPT_OPTIONAL_ARGUMENT  \
+  SOPT(IN_PLACE)              SOPT_NO_ARGUMENT        \
+  SOPT(JOBS)                  SOPT_REQUIRED_ARGUMENT  \
   SOPT(MARKDOWN)              SOPT_NO_ARGUMENT        \
+  SOPT(MAX_LINES)             SOPT_REQUIRED_ARGUMENT  \
   SOPT(NO_CONFIG)             SOPT_NO_ARGUMENT        \
   SOPT(NO_HYPHEN)             SOPT_NO_ARGUMENT        \
   SOPT(OUTPUT)                SOPT_REQUIRED_ARGUMENT  \
   SOPT(PARA_CHARS)            SOPT_REQUIRED_ARGUMENT  \
+  SOPT(STATS)                 SOPT_OPTIONAL_ARGUMENT  \
   SOPT(TAB_SPACES)            SOPT_REQUIRED_ARGUMENT  \
   SOPT(TITLE_LINE)            SOPT_NO_ARGUMENT        \
+  SOPT(UNICODE_BREAKS)        SOPT_NO_ARGUMENT        \
   SOPT(VERSION)               SOPT_NO_ARGUMENT        \
   SOPT(WIDTH)                 SOPT_REQUIRED_ARGUMENT
 
@@ -165,13 +226,29 @@ static unsigned     parse_width( char const* );
  * Command-line options forbidden in configuration files.
  */
 #define CONF_FORBIDDEN_OPTS_SHORT \
+  SOPT(AFFINITY)                  \
   SOPT(ALIAS)                     \
+  SOPT(CHECK)                     \
   SOPT(CONFIG)                    \
+  SOPT(DIFF)                      \
+  SOPT(EDITS)                     \
   SOPT(FILE)                      \
   SOPT(FILE_NAME)                 \
+  SOPT(FOLLOW)                    \
+  SOPT(GIT_CHANGED)               \
+  SOPT(IN_PLACE)                  \
+  SOPT(JOBS)                      \
+  SOPT(JSONL)                     \
+  SOPT(LINES)                     \
+  SOPT(MAX_LINES)                 \
+  SOPT(MEASURE)                   \
   SOPT(NO_CONFIG)                 \
   SOPT(OUTPUT)                    \
-  SOPT(VERSION)
+  SOPT(STATS)                     \
+  SOPT(VERSION)                   \
+  SOPT(WIDTHS)                    \
+  SOPT_READ_INDEX                 \
+  SOPT_WRITE_INDEX
 
 /**
  * Command-line short options specific to **wrap**(1).
@@ -181,27 +258,47 @@ static unsigned     parse_width( char const* );
  * special-case code in parse_options() that disambiguates `-h`.
  */
 #define WRAP_SPECIFIC_OPTS_SHORT                      \
+  SOPT(ABBREVIATIONS)         SOPT_REQUIRED_ARGUMENT  \
+  SOPT(AFFINITY)              SOPT_NO_ARGUMENT        \
   SOPT(ALL_NEWLINES_DELIMIT)  SOPT_NO_ARGUMENT        \
+  SOPT(CHECK)                 SOPT_NO_ARGUMENT        \
+  SOPT(DIFF)                  SOPT_NO_ARGUMENT        \
+  SOPT(EDITS)                 SOPT_NO_ARGUMENT        \
   SOPT(ENABLE_IPC)            SOPT_NO_ARGUMENT        \
   SOPT(DOT_IGNORE)            SOPT_NO_ARGUMENT        \
+  SOPT(EMAIL_QUOTES)          SOPT_NO_ARGUMENT        \
+  SOPT(FOLLOW)                SOPT_OPTIONAL_ARGUMENT  \
   SOPT(HANG_SPACES)           SOPT_REQUIRED_ARGUMENT  \
 /*SOPT(HANG_TABS)             SOPT_REQUIRED_ARGUMENT*/\
+  SOPT(HYPHENATE)             SOPT_REQUIRED_ARGUMENT  \
   SOPT(INDENT_SPACES)         SOPT_REQUIRED_ARGUMENT  \
   SOPT(INDENT_TABS)           SOPT_REQUIRED_ARGUMENT  \
+  SOPT(JSONL)                 SOPT_REQUIRED_ARGUMENT  \
+  SOPT(JUSTIFY)               SOPT_NO_ARGUMENT        \
+  SOPT(KEEP_BOM)              SOPT_NO_ARGUMENT        \
   SOPT(LEAD_SPACES)           SOPT_REQUIRED_ARGUMENT  \
   SOPT(LEAD_STRING)           SOPT_REQUIRED_ARGUMENT  \
   SOPT(LEAD_TABS)             SOPT_REQUIRED_ARGUMENT  \
+  SOPT(LINES)                 SOPT_REQUIRED_ARGUMENT  \
+  SOPT(MARKDOWN_TABLES)       SOPT_NO_ARGUMENT        \
+  SOPT(MARKUP)                SOPT_REQUIRED_ARGUMENT  \
+  SOPT(MEASURE)               SOPT_NO_ARGUMENT        \
   SOPT(MIRROR_SPACES)         SOPT_REQUIRED_ARGUMENT  \
   SOPT(MIRROR_TABS)           SOPT_REQUIRED_ARGUMENT  \
+  SOPT(NO_BREAK)              SOPT_REQUIRED_ARGUMENT  \
   SOPT(NO_NEWLINES_DELIMIT)   SOPT_NO_ARGUMENT        \
+  SOPT(OPTIMAL)               SOPT_OPTIONAL_ARGUMENT  \
+  SOPT(PARA_CACHE)            SOPT_OPTIONAL_ARGUMENT  \
   SOPT(PROTOTYPE)             SOPT_NO_ARGUMENT        \
-  SOPT(WHITESPACE_DELIMIT)    SOPT_NO_ARGUMENT
+  SOPT(WHITESPACE_DELIMIT)    SOPT_NO_ARGUMENT        \
+  SOPT(WIDTHS)                SOPT_REQUIRED_ARGUMENT
 
 /**
  * Command-line short options specific to **wrapc**(1).
  */
 #define WRAPC_SPECIFIC_OPTS_SHORT                     \
   SOPT(ALIGN_COLUMN)          SOPT_REQUIRED_ARGUMENT  \
+  SOPT(ALL_COMMENTS)          SOPT_NO_ARGUMENT        \
   SOPT(COMMENT_CHARS)         SOPT_REQUIRED_ARGUMENT
 
 //
@@ -238,16 +335,23 @@ static char const *const OPTS_SHORT[] = {
   { "eol",                  required_argument,  NULL, COPT(EOL)           },  \
   { "eos-delimit",          no_argument,        NULL, COPT(EOS_DELIMIT)   },  \
   { "eos-spaces",           required_argument,  NULL, COPT(EOS_SPACES)    },  \
+  { "expand-tabs",          no_argument,        NULL, COPT(EXPAND_TABS)   },  \
   { "file",                 required_argument,  NULL, COPT(FILE)          },  \
   { "file-name",            required_argument,  NULL, COPT(FILE_NAME)     },  \
+  { "git-changed",          optional_argument,  NULL, COPT(GIT_CHANGED)   },  \
   { "help",                 no_argument,        NULL, COPT(HELP)          },  \
+  { "in-place",             no_argument,        NULL, COPT(IN_PLACE)      },  \
+  { "jobs",                 required_argument,  NULL, COPT(JOBS)          },  \
   { "markdown",             no_argument,        NULL, COPT(MARKDOWN)      },  \
+  { "max-lines",            required_argument,  NULL, COPT(MAX_LINES)     },  \
   { "no-config",            no_argument,        NULL, COPT(NO_CONFIG)     },  \
   { "no-hyphen",            no_argument,        NULL, COPT(NO_HYPHEN)     },  \
   { "output",               required_argument,  NULL, COPT(OUTPUT)        },  \
   { "para-chars",           required_argument,  NULL, COPT(PARA_CHARS)    },  \
+  { "stats",                optional_argument,  NULL, COPT(STATS)         },  \
   { "tab-spaces",           required_argument,  NULL, COPT(TAB_SPACES)    },  \
   { "title-line",           no_argument,        NULL, COPT(TITLE_LINE)    },  \
+  { "unicode-breaks",       no_argument,        NULL, COPT(UNICODE_BREAKS) }, \
   { "version",              no_argument,        NULL, COPT(VERSION)       },  \
   { "width",                required_argument,  NULL, COPT(WIDTH)         }
 
@@ -256,6 +360,7 @@ static char const *const OPTS_SHORT[] = {
  */
 #define WRAPC_SPECIFIC_OPTS_LONG                                              \
   { "align-column",         required_argument,  NULL, COPT(ALIGN_COLUMN)  },  \
+  { "all-comments",         no_argument,        NULL, COPT(ALL_COMMENTS)  },  \
   { "comment-chars",        required_argument,  NULL, COPT(COMMENT_CHARS) }
 
 /**
@@ -263,20 +368,43 @@ static char const *const OPTS_SHORT[] = {
  */
 static struct option const WRAP_OPTS_LONG[] = {
   COMMON_OPTS_LONG,
+  { "abbreviations",        required_argument,  NULL, COPT(ABBREVIATIONS) },
+  { "affinity",             no_argument,        NULL, COPT(AFFINITY)      },
   { "all-newlines-delimit", no_argument,        NULL, COPT(ALL_NEWLINES_DELIMIT) },
+  { "check",                no_argument,        NULL, COPT(CHECK)         },
+  { "diff",                 no_argument,        NULL, COPT(DIFF)          },
   { "dot-ignore",           no_argument,        NULL, COPT(DOT_IGNORE)    },
+  { "edits",                no_argument,        NULL, COPT(EDITS)         },
+  { "email-quotes",         no_argument,        NULL, COPT(EMAIL_QUOTES)  },
+  { "follow",               optional_argument,  NULL, COPT(FOLLOW)        },
   { "hang-spaces",          required_argument,  NULL, COPT(HANG_SPACES)   },
   { "hang-tabs",            required_argument,  NULL, COPT(HANG_TABS)     },
+  { "hyphenate",            required_argument,  NULL, COPT(HYPHENATE)     },
   { "indent-spaces",        required_argument,  NULL, COPT(INDENT_SPACES) },
   { "indent-tabs",          required_argument,  NULL, COPT(INDENT_TABS)   },
+  { "jsonl",                required_argument,  NULL, COPT(JSONL)         },
+  { "justify",              no_argument,        NULL, COPT(JUSTIFY)       },
+  { "keep-bom",             no_argument,        NULL, COPT(KEEP_BOM)      },
+  { "keep-encoding",        no_argument,        NULL, COPT_KEEP_ENCODING  },
   { "lead-spaces",          required_argument,  NULL, COPT(LEAD_SPACES)   },
   { "lead-string",          required_argument,  NULL, COPT(LEAD_STRING)   },
   { "lead-tabs",            required_argument,  NULL, COPT(LEAD_TABS)     },
+  { "lines",                required_argument,  NULL, COPT(LINES)         },
+  { "markdown-tables",      no_argument,        NULL, COPT(MARKDOWN_TABLES) },
+  { "markup",               required_argument,  NULL, COPT(MARKUP)        },
+  { "measure",              no_argument,        NULL, COPT(MEASURE)       },
+  { "minimal",              no_argument,        NULL, COPT_MINIMAL        },
   { "mirror-spaces",        required_argument,  NULL, COPT(MIRROR_SPACES) },
   { "mirror-tabs",          required_argument,  NULL, COPT(MIRROR_TABS)   },
+  { "no-break",             required_argument,  NULL, COPT(NO_BREAK)      },
   { "no-newlines-delimit",  no_argument,        NULL, COPT(NO_NEWLINES_DELIMIT) },
+  { "optimal",              optional_argument,  NULL, COPT(OPTIMAL)       },
+  { "para-cache",           optional_argument,  NULL, COPT(PARA_CACHE)    },
   { "prototype",            no_argument,        NULL, COPT(PROTOTYPE)     },
+  { "read-index",           required_argument,  NULL, COPT_READ_INDEX     },
   { "whitespace-delimit",   no_argument,        NULL, COPT(WHITESPACE_DELIMIT) },
+  { "widths",               required_argument,  NULL, COPT(WIDTHS)        },
+  { "write-index",          required_argument,  NULL, COPT_WRITE_INDEX    },
   { "_ENABLE-IPC",          no_argument,        NULL, COPT(ENABLE_IPC)    },
 
   // wrap's options have to include wrapc's specific options so they're
@@ -308,6 +436,20 @@ static struct option const *const OPTS_LONG[] = {
 
 ////////// local functions ////////////////////////////////////////////////////
 
+/**
+ * Applies the options of \a alias, if any.
+ *
+ * @param alias The \ref alias to apply or NULL for none.
+ */
+static void apply_alias( alias_t const *alias ) {
+  if ( alias != NULL ) {
+    parse_options(
+      alias->argc, alias->argv, OPTS_SHORT[0], OPTS_LONG[0],
+      /*cmdline_forbidden_opts=*/"", usage_fn, alias->line_no
+    );
+  }
+}
+
 /**
  * If \a opt was given, checks that _only_ it was given and, if not, prints an
  * error message and exits; if \a opt was not given, does nothing.
@@ -389,28 +531,76 @@ static char const* get_opt_long( char short_opt ) {
 }
 
 /**
- * Parses an alignment column specification, that is an integer optionally
- * followed by an alignment character specification.
+ * Hashes the size and modification time of a file given by an option so the
+ * hash changes if the file is changed in place.
+ *
+ * @param path The path of the file or NULL for none.
+ * @param h The hash to start with.
+ * @return Returns said hash or \a h if \a path is NULL or can't be
+ * **stat**(2)'d.
+ */
+NODISCARD
+static uint64_t hash_file_stat( char const *path, uint64_t h ) {
+  struct stat st;
+  if ( path == NULL || stat( path, &st ) != 0 )
+    return h;
+  uint64_t const key[] = {
+    STATIC_CAST( uint64_t, st.st_size ),
+    STATIC_CAST( uint64_t, st.st_mtime )
+  };
+  return mem_hash( key, sizeof key, h );
+}
+
+/**
+ * Hashes a string option.
+ *
+ * @param s The null-terminated string to hash or NULL for none.
+ * @param h The hash to start with.
+ * @return Returns said hash.
+ */
+NODISCARD
+static uint64_t hash_str( char const *s, uint64_t h ) {
+  //
+  // Include the null so NULL (hashed as no bytes) differs from "".
+  //
+  return s == NULL ? mem_hash( NULL, 0, h ) :
+    mem_hash( s, strlen( s ) + 1, h );
+}
+
+/**
+ * Parses an alignment column specification, that is either an integer or
+ * `b` or `block` optionally followed by an alignment character specification.
  *
  * @param s The null-terminated string to parse.
  * @param align_char A pointer to the character to set if an alignment
  * character specification is given.
- * @return Returns the alignment column.
+ * @param is_block A pointer to the flag to set if `b` or `block` is given
+ * rather than an integer.
+ * @return Returns the alignment column or 0 for `b` or `block`.
  */
 NODISCARD
-static unsigned parse_align( char const *s, char *align_char ) {
+static unsigned parse_align( char const *s, char *align_char,
+                             bool *is_block ) {
   assert( s != NULL );
   assert( align_char != NULL );
+  assert( is_block != NULL );
 
   static char const *const AUTO  [] = { "a", "auto", NULL };
   static char const *const SPACES[] = { "s", "space", "spaces", NULL };
   static char const *const TABS  [] = { "t", "tab", "tabs", NULL };
 
   char *end = NULL;
-  errno = 0;
-  unsigned const col = STATIC_CAST( unsigned, strtoul( s, &end, 10 ) );
-  if ( unlikely( errno != 0 || end == s ) )
-    goto error;
+  unsigned col = 0;
+  if ( s[0] == 'b' ) {
+    *is_block = true;
+    end = CONST_CAST( char*, s + (strncmp( s, "block", 5 ) == 0 ? 5 : 1) );
+  }
+  else {
+    errno = 0;
+    col = STATIC_CAST( unsigned, strtoul( s, &end, 10 ) );
+    if ( unlikely( errno != 0 || end == s ) )
+      goto error;
+  }
   if ( *end != '\0' ) {
     if ( *end == ',' )
       ++end;
@@ -428,7 +618,7 @@ static unsigned parse_align( char const *s, char *align_char ) {
 error:
   fatal_error( EX_USAGE,
     "\"%s\": invalid value for %s;"
-    " must be digits followed by one of:"
+    " must be digits or b or block followed by one of:"
     " a, auto, s, space, spaces, t, tab, tabs\n",
     s, opt_format( 'A' )
   );
@@ -475,7 +665,7 @@ static eol_t parse_eol( char const *s ) {
   } // for
 
   // name not found: construct valid name list for an error message
-  char *const values_buf = free_later( MALLOC( char, values_buf_size ) );
+  char *const values_buf = ARENA_ALLOC( char, values_buf_size );
   char *pvalues = values_buf;
   for ( eol_map_t const *m = EOL_MAP; m->em_name != NULL; ++m ) {
     if ( pvalues > values_buf ) {
@@ -492,6 +682,80 @@ static eol_t parse_eol( char const *s ) {
   );
 }
 
+/**
+ * Parses a range of lines, that is either `N`, `N-`, or `N-M`, into
+ * \ref opt_lines_first and \ref opt_lines_last.  Line numbers start at 1.
+ *
+ * @param s The null-terminated string to parse.
+ */
+static void parse_lines( char const *s ) {
+  assert( s != NULL );
+
+  char *end = NULL;
+  size_t first, last;
+
+  if ( !isdigit( STATIC_CAST( unsigned char, *s ) ) )
+    goto error;
+  errno = 0;
+  first = last = STATIC_CAST( size_t, strtoull( s, &end, 10 ) );
+  if ( *end == '-' ) {
+    char const *const t = end + 1;
+    if ( *t == '\0' ) {
+      last = SIZE_MAX;
+      end = CONST_CAST( char*, t );
+    }
+    else {
+      if ( !isdigit( STATIC_CAST( unsigned char, *t ) ) )
+        goto error;
+      last = STATIC_CAST( size_t, strtoull( t, &end, 10 ) );
+    }
+  }
+  if ( unlikely( errno != 0 || *end != '\0' || first == 0 || last < first ) )
+    goto error;
+
+  opt_lines_first = first;
+  opt_lines_last = last;
+  return;
+
+error:
+  fatal_error( EX_USAGE,
+    "\"%s\": invalid value for %s; must be N, N-, or N-M where 0 < N <= M\n",
+    s, opt_format( COPT(LINES) )
+  );
+}
+
+/**
+ * Parses a markup language name.
+ *
+ * @param s The null-terminated string to parse.
+ * @return Returns the corresponding \ref markup_t or prints an error message
+ * and exits if \a s is invalid.
+ */
+NODISCARD
+static markup_t parse_markup( char const *s ) {
+  assert( s != NULL );
+  if ( strcasecmp( s, "adoc" ) == 0 || strcasecmp( s, "asciidoc" ) == 0 )
+    return MARKUP_ASCIIDOC;
+  if ( strcasecmp( s, "html" ) == 0 || strcasecmp( s, "xhtml" ) == 0 ||
+       strcasecmp( s, "xml" ) == 0 ) {
+    return MARKUP_HTML;
+  }
+  if ( strcasecmp( s, "man" ) == 0 || strcasecmp( s, "mdoc" ) == 0 ||
+       strcasecmp( s, "roff" ) == 0 ) {
+    return MARKUP_ROFF;
+  }
+  if ( strcasecmp( s, "rest" ) == 0 || strcasecmp( s, "rst" ) == 0 ||
+       strcasecmp( s, "restructuredtext" ) == 0 ) {
+    return MARKUP_RST;
+  }
+  fatal_error( EX_USAGE,
+    "\"%s\": invalid value for %s; must be one of:\n"
+    "\tadoc, asciidoc, html, man, mdoc, rest, restructuredtext, roff, rst,\n"
+    "\txhtml, xml\n",
+    s, opt_format( COPT(MARKUP) )
+  );
+}
+
 /**
  * Parses command-line options.
  *
@@ -545,13 +809,23 @@ static void parse_options( int argc, char const *argv[],
     }
 
     switch ( opt ) {
+      case COPT(ABBREVIATIONS):
+        opt_abbreviations = optarg;
+        break;
+      case COPT(AFFINITY):
+        opt_affinity = true;
+        break;
       case COPT(ALIAS):
         if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
           goto missing_arg;
         opt_alias = optarg;
         break;
       case COPT(ALIGN_COLUMN):
-        opt_align_column = parse_align( optarg, &opt_align_char );
+        opt_align_column =
+          parse_align( optarg, &opt_align_char, &opt_align_block );
+        break;
+      case COPT(ALL_COMMENTS):
+        opt_all_comments = true;
         break;
       case COPT(ALL_NEWLINES_DELIMIT):
         opt_newlines_delimit = 1;
@@ -561,6 +835,9 @@ static void parse_options( int argc, char const *argv[],
           goto missing_arg;
         opt_block_regex = optarg;
         break;
+      case COPT(CHECK):
+        opt_check = true;
+        break;
       case COPT(COMMENT_CHARS):
         if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
           goto missing_arg;
@@ -571,12 +848,21 @@ static void parse_options( int argc, char const *argv[],
           goto missing_arg;
         opt_conf_file = optarg;
         break;
+      case COPT(DIFF):
+        opt_diff = true;
+        break;
       case COPT(DOT_IGNORE):
         opt_lead_dot_ignore = true;
         break;
       case COPT(DOXYGEN):
         opt_doxygen = true;
         break;
+      case COPT(EDITS):
+        opt_edits = true;
+        break;
+      case COPT(EMAIL_QUOTES):
+        opt_email_quotes = true;
+        break;
       case COPT(ENABLE_IPC):
         opt_data_link_esc = true;
         break;
@@ -589,6 +875,9 @@ static void parse_options( int argc, char const *argv[],
       case COPT(EOS_SPACES):
         opt_eos_spaces = check_atou( optarg );
         break;
+      case COPT(EXPAND_TABS):
+        opt_expand_tabs = true;
+        break;
       case COPT(FILE):
         if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
           goto missing_arg;
@@ -598,6 +887,22 @@ static void parse_options( int argc, char const *argv[],
         if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
           goto missing_arg;
         opt_fin_name = base_name( optarg );
+        opt_fin_path = optarg;
+        break;
+      case COPT(FOLLOW):
+        opt_follow = optarg == NULL ?
+          FOLLOW_MS_DEFAULT : check_atou( optarg );
+        if ( opt_follow == 0 ) {
+          fatal_error( EX_USAGE,
+            "\"%s\": invalid value for %s; must be at least 1\n",
+            optarg, opt_format( COPT(FOLLOW) )
+          );
+        }
+        break;
+      case COPT(GIT_CHANGED):
+        opt_git_changed = optarg == NULL ? "HEAD" : optarg;
+        if ( SKIP_CHARS( opt_git_changed, WS_ST )[0] == '\0' )
+          goto missing_arg;
         break;
       case COPT(HANG_TABS):
 //    case COPT(HELP):
@@ -614,12 +919,38 @@ static void parse_options( int argc, char const *argv[],
       case COPT(HANG_SPACES):
         opt_hang_spaces = check_atou( optarg );
         break;
+      case COPT(HYPHENATE):
+        if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
+          goto missing_arg;
+        opt_hyphenate = optarg;
+        break;
       case COPT(INDENT_SPACES):
         opt_indt_spaces = check_atou( optarg );
         break;
       case COPT(INDENT_TABS):
         opt_indt_tabs = check_atou( optarg );
         break;
+      case COPT(IN_PLACE):
+        opt_in_place = true;
+        break;
+      case COPT(JOBS):
+        opt_jobs = check_atou( optarg );
+        break;
+      case COPT(JSONL):
+        opt_jsonl_text = strncmp( optarg, "text:", 5 ) == 0;
+        opt_jsonl = opt_jsonl_text ? optarg + 5 : optarg;
+        if ( opt_jsonl[0] == '\0' )
+          goto missing_arg;
+        break;
+      case COPT(JUSTIFY):
+        opt_justify = true;
+        break;
+      case COPT(KEEP_BOM):
+        opt_keep_bom = true;
+        break;
+      case COPT_KEEP_ENCODING:
+        opt_keep_encoding = true;
+        break;
       case COPT(LEAD_SPACES):
         opt_lead_spaces = check_atou( optarg );
         break;
@@ -630,15 +961,42 @@ static void parse_options( int argc, char const *argv[],
       case COPT(LEAD_TABS):
         opt_lead_tabs = check_atou( optarg );
         break;
+      case COPT(LINES):
+        parse_lines( optarg );
+        break;
       case COPT(MARKDOWN):
         opt_markdown = true;
         break;
+      case COPT(MARKDOWN_TABLES):
+        opt_markdown_tables = true;
+        break;
+      case COPT(MARKUP):
+        opt_markup = parse_markup( optarg );
+        break;
+      case COPT(MAX_LINES):
+        opt_max_lines = check_atou( optarg );
+        if ( opt_max_lines == 0 ) {
+          fatal_error( EX_USAGE,
+            "\"%s\": invalid value for %s; must be at least 1\n",
+            optarg, opt_format( COPT(MAX_LINES) )
+          );
+        }
+        break;
+      case COPT(MEASURE):
+        opt_measure = true;
+        break;
+      case COPT_MINIMAL:
+        opt_minimal = true;
+        break;
       case COPT(MIRROR_SPACES):
         opt_mirror_spaces = check_atou( optarg );
         break;
       case COPT(MIRROR_TABS):
         opt_mirror_tabs = check_atou( optarg );
         break;
+      case COPT(NO_BREAK):
+        opt_no_break = optarg;
+        break;
       case COPT(NO_CONFIG):
         opt_no_conf = true;
         break;
@@ -648,11 +1006,24 @@ static void parse_options( int argc, char const *argv[],
       case COPT(NO_NEWLINES_DELIMIT):
         opt_newlines_delimit = SIZE_MAX;
         break;
+      case COPT(OPTIMAL):
+        opt_optimal = optarg == NULL ?
+          OPTIMAL_WORDS_DEFAULT : check_atou( optarg );
+        if ( opt_optimal < 2 ) {
+          fatal_error( EX_USAGE,
+            "\"%s\": invalid value for %s; must be at least 2\n",
+            optarg, opt_format( COPT(OPTIMAL) )
+          );
+        }
+        break;
       case COPT(OUTPUT):
         if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
           goto missing_arg;
         fout_path = optarg;
         break;
+      case COPT(PARA_CACHE):
+        opt_para_cache = optarg == NULL ? "" : optarg;
+        break;
       case COPT(PARA_CHARS):
         if ( SKIP_CHARS( optarg, WS_ST )[0] == '\0' )
           goto missing_arg;
@@ -661,12 +1032,36 @@ static void parse_options( int argc, char const *argv[],
       case COPT(PROTOTYPE):
         opt_prototype = true;
         break;
+      case COPT_READ_INDEX:
+        opt_read_index = optarg;
+        break;
+      case COPT(STATS):
+        opt_stats = true;
+        if ( optarg == NULL )
+          break;
+        if ( is_wrapc ) {
+          fatal_error( EX_USAGE,
+            "\"%s\": %s takes no value for " PACKAGE "c\n",
+            optarg, opt_format( COPT(STATS) )
+          );
+        }
+        opt_stats_paras = check_atou( optarg );
+        if ( opt_stats_paras == 0 ) {
+          fatal_error( EX_USAGE,
+            "\"%s\": invalid value for %s; must be at least 1\n",
+            optarg, opt_format( COPT(STATS) )
+          );
+        }
+        break;
       case COPT(TAB_SPACES):
         opt_tab_spaces = check_atou( optarg );
         break;
       case COPT(TITLE_LINE):
         opt_title_line = true;
         break;
+      case COPT(UNICODE_BREAKS):
+        opt_unicode_breaks = true;
+        break;
       case COPT(VERSION):
         opt_version = true;
         break;
@@ -676,6 +1071,12 @@ static void parse_options( int argc, char const *argv[],
       case COPT(WIDTH):
         opt_line_width = parse_width( optarg );
         break;
+      case COPT(WIDTHS):
+        parse_widths( optarg );
+        break;
+      case COPT_WRITE_INDEX:
+        opt_write_index = optarg;
+        break;
 
       case ':':
         goto missing_arg;
@@ -699,38 +1100,194 @@ static void parse_options( int argc, char const *argv[],
     // Check for mutually exclusive options only when parsing the command-line.
     //
     check_opt_mutually_exclusive( COPT(ALIGN_COLUMN),
+      SOPT(ABBREVIATIONS)
       SOPT(ALIAS)
+      SOPT(ALL_COMMENTS)
       SOPT(ALL_NEWLINES_DELIMIT)
       SOPT(BLOCK_REGEX)
       SOPT(DOT_IGNORE)
       SOPT(DOXYGEN)
+      SOPT(EMAIL_QUOTES)
       SOPT(EOS_DELIMIT)
       SOPT(EOS_SPACES)
+      SOPT(GIT_CHANGED)
       SOPT(HANG_SPACES)
       SOPT(HANG_TABS)
+      SOPT(HYPHENATE)
       SOPT(INDENT_SPACES)
       SOPT(INDENT_TABS)
+      SOPT(IN_PLACE)
+      SOPT(JSONL)
       SOPT(LEAD_STRING)
       SOPT(MARKDOWN)
+      SOPT(MARKUP)
+      SOPT(MAX_LINES)
       SOPT(MIRROR_SPACES)
       SOPT(MIRROR_TABS)
+      SOPT(NO_BREAK)
       SOPT(NO_HYPHEN)
       SOPT(NO_NEWLINES_DELIMIT)
       SOPT(PARA_CHARS)
       SOPT(PROTOTYPE)
+      SOPT(STATS)
       SOPT(TITLE_LINE)
+      SOPT(UNICODE_BREAKS)
       SOPT(WHITESPACE_DELIMIT)
       SOPT(WIDTH)
     );
     check_opt_mutually_exclusive( COPT(ALL_NEWLINES_DELIMIT),
       SOPT(NO_NEWLINES_DELIMIT)
     );
+    check_opt_mutually_exclusive( COPT(CHECK),
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(IN_PLACE)
+      SOPT(LINES)
+    );
+    check_opt_mutually_exclusive( COPT(DIFF),
+      SOPT(ENABLE_IPC)
+      SOPT(IN_PLACE)
+      SOPT(LINES)
+    );
+    check_opt_mutually_exclusive( COPT(EDITS),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(FOLLOW)
+      SOPT(GIT_CHANGED)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+      SOPT(JSONL)
+      SOPT(LINES)
+      SOPT(MAX_LINES)
+      SOPT(MEASURE)
+      SOPT(PARA_CACHE)
+      SOPT(WIDTHS)
+    );
+    check_opt_mutually_exclusive( COPT(EXPAND_TABS),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(EDITS)
+      SOPT(MEASURE)
+    );
     check_opt_mutually_exclusive( COPT(FILE), SOPT(FILE_NAME) );
+    check_opt_mutually_exclusive( COPT(FOLLOW),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+      SOPT(LINES)
+      SOPT(PARA_CACHE)
+    );
+    check_opt_mutually_exclusive( COPT(GIT_CHANGED),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(FILE)
+      SOPT(FILE_NAME)
+      SOPT(FOLLOW)
+      SOPT(LINES)
+      SOPT(MAX_LINES)
+      SOPT(OUTPUT)
+      SOPT(STATS)
+    );
+    check_opt_mutually_exclusive( COPT(JSONL),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(FOLLOW)
+      SOPT(GIT_CHANGED)
+      SOPT(JOBS)
+      SOPT(LINES)
+      SOPT(PARA_CACHE)
+      SOPT(WIDTHS)
+    );
+    check_opt_mutually_exclusive( COPT(LINES), SOPT(ENABLE_IPC) );
+    check_opt_mutually_exclusive( COPT_WRITE_INDEX,
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(EDITS)
+      SOPT(ENABLE_IPC)
+      SOPT(FOLLOW)
+      SOPT(GIT_CHANGED)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+      SOPT(JSONL)
+      SOPT(LINES)
+      SOPT(MEASURE)
+      SOPT_MINIMAL
+      SOPT(WIDTHS)
+    );
+    check_opt_mutually_exclusive( COPT(PARA_CACHE), SOPT(ENABLE_IPC) );
+    check_opt_mutually_exclusive( COPT(IN_PLACE),
+      SOPT(ENABLE_IPC)
+      SOPT(FILE)
+      SOPT(FILE_NAME)
+      SOPT(OUTPUT)
+    );
+    check_opt_mutually_exclusive( COPT(MAX_LINES),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+    );
+    check_opt_mutually_exclusive( COPT(MEASURE),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(FOLLOW)
+      SOPT(GIT_CHANGED)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+      SOPT(JSONL)
+      SOPT(LINES)
+      SOPT(MAX_LINES)
+      SOPT(PARA_CACHE)
+    );
+    check_opt_mutually_exclusive( COPT_MINIMAL,
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(DOXYGEN)
+      SOPT(EDITS)
+      SOPT(EMAIL_QUOTES)
+      SOPT(ENABLE_IPC)
+      SOPT(FOLLOW)
+      SOPT(GIT_CHANGED)
+      SOPT(JOBS)
+      SOPT(JSONL)
+      SOPT(JUSTIFY)
+      SOPT(LINES)
+      SOPT(MARKDOWN)
+      SOPT(MARKUP)
+      SOPT(MEASURE)
+      SOPT(OPTIMAL)
+      SOPT(PARA_CACHE)
+      SOPT(PROTOTYPE)
+      SOPT(STATS)
+      SOPT(WIDTHS)
+    );
     check_opt_mutually_exclusive( COPT(MARKDOWN),
+      SOPT(JUSTIFY)
+      SOPT(OPTIMAL)
       SOPT(TAB_SPACES)
       SOPT(TITLE_LINE)
     );
-    check_opt_s_mutually_exclusive( SOPT(MARKDOWN) SOPT(PROTOTYPE),
+    check_opt_mutually_exclusive( COPT(EMAIL_QUOTES),
+      SOPT(DOXYGEN)
+      SOPT(MARKDOWN)
+      SOPT(MARKUP)
+      SOPT(PROTOTYPE)
+    );
+    check_opt_mutually_exclusive( COPT(MARKUP),
+      SOPT(DOXYGEN)
+      SOPT(MARKDOWN)
+      SOPT(PROTOTYPE)
+      SOPT(TITLE_LINE)
+    );
+    check_opt_s_mutually_exclusive(
+      SOPT(EMAIL_QUOTES) SOPT(MARKDOWN) SOPT(MARKUP) SOPT(PROTOTYPE),
       SOPT(DOT_IGNORE)
       SOPT(HANG_SPACES)
       SOPT(HANG_TABS)
@@ -743,7 +1300,65 @@ static void parse_options( int argc, char const *argv[],
       SOPT(MIRROR_TABS)
       SOPT(WHITESPACE_DELIMIT)
     );
+    check_opt_mutually_exclusive( COPT(STATS),
+      SOPT(ALL_COMMENTS)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+    );
     check_opt_exclusive( COPT(VERSION) );
+    check_opt_mutually_exclusive( COPT(WIDTHS),
+      SOPT(CHECK)
+      SOPT(DIFF)
+      SOPT(ENABLE_IPC)
+      SOPT(FOLLOW)
+      SOPT(GIT_CHANGED)
+      SOPT(IN_PLACE)
+      SOPT(JOBS)
+      SOPT(LINES)
+      SOPT(MAX_LINES)
+      SOPT(PARA_CACHE)
+      SOPT(STATS)
+      SOPT(WIDTH)
+    );
+
+    if ( opts_given[ STATIC_CAST( unsigned, COPT(AFFINITY) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(JOBS) ) ] ) {
+      fatal_error( EX_USAGE,
+        "%s requires %s\n",
+        opt_format( COPT(AFFINITY) ), opt_format( COPT(JOBS) )
+      );
+    }
+    if ( opts_given[ STATIC_CAST( unsigned, COPT_READ_INDEX ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(LINES) ) ] ) {
+      fatal_error( EX_USAGE,
+        "%s requires %s\n",
+        opt_format( COPT_READ_INDEX ), opt_format( COPT(LINES) )
+      );
+    }
+    if ( opts_given[ STATIC_CAST( unsigned, COPT(WIDTHS) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(MEASURE) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(OUTPUT) ) ] ) {
+      fatal_error( EX_USAGE,
+        "%s requires %s\n",
+        opt_format( COPT(WIDTHS) ), opt_format( COPT(OUTPUT) )
+      );
+    }
+
+    //
+    // For wrapc, only files are reformatted in parallel, not standard input,
+    // unless only aligning comments or reformatting all comments.
+    //
+    if ( is_wrapc && opts_given[ STATIC_CAST( unsigned, COPT(JOBS) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(ALIGN_COLUMN) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(ALL_COMMENTS) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(GIT_CHANGED) ) ] &&
+         !opts_given[ STATIC_CAST( unsigned, COPT(IN_PLACE) ) ] ) {
+      fatal_error( EX_USAGE,
+        "%s requires %s, %s, or %s\n", opt_format( COPT(JOBS) ),
+        opt_format( COPT(ALIGN_COLUMN) ), opt_format( COPT(ALL_COMMENTS) ),
+        opt_format( COPT(IN_PLACE) )
+      );
+    }
   }
 
   if ( opt_help ) {
@@ -781,27 +1396,29 @@ missing_arg:
  * Parses a width value.
  *
  * @param s The null-terminated string to parse.
- * @return Returns the width value
- * or prints an error message and exits if \a s is invalid.
+ * @return Returns the width value, #LINE_WIDTH_AUTO for `auto` (**wrap**(1)
+ * only), or prints an error message and exits if \a s is invalid.
  */
 NODISCARD
-static unsigned parse_width( char const *s ) {
+static size_t parse_width( char const *s ) {
+  assert( s != NULL );
 #ifdef WITH_WIDTH_TERM
-  static char const *const TERM[] = {
+  static char const *const VALUES[] = {
+    "auto",                             // must be first: wrap only
     "t",
     "term",
     "terminal",
     NULL
   };
+  char const *const *const values = VALUES + is_wrapc;
 
-  assert( s != NULL );
   if ( is_digits( s ) )
-    return STATIC_CAST( unsigned, strtoul( s, NULL, 10 ) );
+    return strtoul( s, NULL, 10 );
 
   size_t values_buf_size = 1;           // for trailing null
-  for ( char const *const *t = TERM; *t != NULL; ++t ) {
+  for ( char const *const *t = values; *t != NULL; ++t ) {
     if ( strcasecmp( s, *t ) == 0 )
-      return get_term_columns();
+      return t == VALUES ? LINE_WIDTH_AUTO : get_term_columns();
     // sum sizes of values in case we need to construct an error message
     values_buf_size += strlen( *t ) + 2 /* ", " */;
   } // for
@@ -809,7 +1426,7 @@ static unsigned parse_width( char const *s ) {
   // value not found: construct valid value list for an error message
   char values_buf[ values_buf_size ];
   char *pvalues = values_buf;
-  for ( char const *const *t = TERM; *t != NULL; ++t ) {
+  for ( char const *const *t = values; *t != NULL; ++t ) {
     if ( pvalues > values_buf ) {
       strcpy( pvalues, ", " );
       pvalues += 2;
@@ -823,10 +1440,46 @@ static unsigned parse_width( char const *s ) {
     s, opt_format( 'w' ), values_buf
   );
 #else
+  if ( !is_wrapc && strcasecmp( s, "auto" ) == 0 )
+    return LINE_WIDTH_AUTO;
   return check_atou( s );
 #endif /* WITH_WIDTH_TERM */
 }
 
+/**
+ * Parses a comma-separated list of line widths into \ref opt_widths.
+ *
+ * @param s The null-terminated string to parse.
+ */
+static void parse_widths( char const *s ) {
+  assert( s != NULL );
+
+  opt_widths_len = 0;
+  for ( char const *t = s;; ++t ) {
+    if ( opt_widths_len == WIDTHS_MAX ||
+         !isdigit( STATIC_CAST( unsigned char, *t ) ) ) {
+      goto error;
+    }
+    char *end;
+    errno = 0;
+    size_t const width = STATIC_CAST( size_t, strtoull( t, &end, 10 ) );
+    if ( unlikely( errno != 0 || width == 0 ) )
+      goto error;
+    opt_widths[ opt_widths_len++ ] = width;
+    if ( *end == '\0' )
+      return;
+    if ( *end != ',' )
+      goto error;
+    t = end;
+  } // for
+
+error:
+  fatal_error( EX_USAGE,
+    "\"%s\": invalid value for %s; must be 1 to %d widths separated by commas\n",
+    s, opt_format( COPT(WIDTHS) ), WIDTHS_MAX
+  );
+}
+
 ////////// extern functions ///////////////////////////////////////////////////
 
 char const* opt_format( char short_opt ) {
@@ -835,6 +1488,10 @@ char const* opt_format( char short_opt ) {
   char *const buf = bufs[ buf_index++ % 2 ];
 
   char const *const long_opt = get_opt_long( short_opt );
+  if ( !isgraph( STATIC_CAST( unsigned char, short_opt ) ) ) {
+    snprintf( buf, OPT_BUF_SIZE, "--%s", long_opt );
+    return buf;
+  }
   snprintf(
     buf, OPT_BUF_SIZE, "%s%s%s-%c",
     long_opt[0] != '\0' ? "--" : "", long_opt,
@@ -843,12 +1500,107 @@ char const* opt_format( char short_opt ) {
   return buf;
 }
 
+bool opt_given( char short_opt ) {
+  return opts_given[ STATIC_CAST( unsigned char, short_opt ) ];
+}
+
+char const* options_alias_block_regex( alias_t const *alias ) {
+  assert( alias != NULL );
+  char const *block_regex = NULL;
+  opterr = 0;
+  optind = 1;
+  for (;;) {
+    int const opt = getopt_long(
+      alias->argc, CONST_CAST( char**, alias->argv ), OPTS_SHORT[0],
+      OPTS_LONG[0], /*longindex=*/NULL
+    );
+    if ( opt == -1 )
+      break;
+    if ( opt == COPT(BLOCK_REGEX) )
+      block_regex = optarg;
+  } // for
+  return block_regex;
+}
+
+uint64_t options_file_hash( char const *path ) {
+  assert( path != NULL );
+  char const *const name = base_name( path );
+  //
+  // For wrapc, the language is determined by the file's name, so only files
+  // of the same name are reformatted the same.
+  //
+  if ( is_wrapc )
+    return mem_hash( name, strlen( name ), 0 );
+  alias_t const *const alias = !opt_no_conf && opt_alias == NULL ?
+    pattern_find( name ) : NULL;
+  return mem_hash( &alias, sizeof alias, 0 );
+}
+
+uint64_t options_hash( void ) {
+/// @cond DOXYGEN_IGNORE
+#define HASH_OPT(VAR)             h = mem_hash( &(VAR), sizeof (VAR), h )
+/// @endcond
+
+  //
+  // The version is included since how text is reformatted may change from one
+  // version to the next.
+  //
+  uint64_t h = hash_str( PACKAGE_VERSION, 0 );
+  h = hash_str( opt_abbreviations, h );
+  h = hash_str( opt_block_regex, h );
+  HASH_OPT( opt_data_link_esc );
+  HASH_OPT( opt_doxygen );
+  HASH_OPT( opt_email_quotes );
+  HASH_OPT( opt_eol );
+  HASH_OPT( opt_eos_delimit );
+  HASH_OPT( opt_eos_spaces );
+  HASH_OPT( opt_hang_spaces );
+  HASH_OPT( opt_hang_tabs );
+  h = hash_str( opt_hyphenate, h );
+  HASH_OPT( opt_indt_spaces );
+  HASH_OPT( opt_indt_tabs );
+  HASH_OPT( opt_justify );
+  HASH_OPT( opt_keep_bom );
+  HASH_OPT( opt_lead_dot_ignore );
+  HASH_OPT( opt_lead_spaces );
+  h = hash_str( opt_lead_string, h );
+  HASH_OPT( opt_lead_tabs );
+  HASH_OPT( opt_lead_ws_delimit );
+  HASH_OPT( opt_line_width );
+  HASH_OPT( opt_markdown );
+  HASH_OPT( opt_markdown_tables );
+  HASH_OPT( opt_markup );
+  HASH_OPT( opt_mirror_spaces );
+  HASH_OPT( opt_mirror_tabs );
+  HASH_OPT( opt_newlines_delimit );
+  h = hash_str( opt_no_break, h );
+  HASH_OPT( opt_no_hyphen );
+  HASH_OPT( opt_optimal );
+  h = hash_str( opt_para_delims, h );
+  HASH_OPT( opt_prototype );
+  HASH_OPT( opt_tab_spaces );
+  HASH_OPT( opt_title_line );
+  HASH_OPT( opt_unicode_breaks );
+
+  //
+  // The hyphenation patterns, abbreviations, and no-break tokens in their
+  // files may have been changed in place.
+  //
+  h = hash_file_stat( opt_hyphenate, h );
+  h = hash_file_stat( opt_abbreviations, h );
+  h = hash_file_stat( opt_no_break, h );
+
+#undef HASH_OPT
+  return h;
+}
+
 void options_init( int argc, char const *argv[], void (*usage)(int) ) {
   ASSERT_RUN_ONCE();
   assert( usage != NULL );
 
   me = base_name( argv[0] );
   is_wrapc = strcmp( me, PACKAGE "c" ) == 0;
+  usage_fn = usage;
 
   parse_options(
     argc, argv, OPTS_SHORT[ is_wrapc ], OPTS_LONG[ is_wrapc ],
@@ -856,14 +1608,37 @@ void options_init( int argc, char const *argv[], void (*usage)(int) ) {
   );
   argc -= optind;
   argv += optind;
-  if ( argc > 0 ) {
+  if ( opt_git_changed != NULL ) {
+    //
+    // Any arguments limit the changed files git considers.
+    //
+    opt_git_files = git_changed(
+      opt_git_changed, argv, STATIC_CAST( size_t, argc ), &opt_files,
+      &opt_files_len
+    );
+    if ( opt_files_len == 0 )
+      exit( EX_OK );                    // nothing changed
+    opt_in_place = true;
+  }
+  else if ( opt_in_place ) {
+    if ( argc == 0 ) {
+      (*usage)( EX_USAGE );
+      unreachable();
+    }
+    opt_files = argv;
+    opt_files_len = STATIC_CAST( size_t, argc );
+  }
+  else if ( argc > 0 ) {
     (*usage)( EX_USAGE );
     unreachable();
   }
 
-  if ( !opt_no_conf && (opt_alias != NULL || opt_fin_name != NULL) ) {
+  if ( !opt_no_conf &&
+       (opt_alias != NULL || opt_fin_name != NULL || opt_in_place) ) {
     alias_t const *alias = NULL;
+    startup_charge( STARTUP_OPTIONS );
     opt_conf_file = read_conf( opt_conf_file );
+    startup_charge( STARTUP_CONF );
     if ( opt_alias != NULL ) {
       if ( (alias = alias_find( opt_alias )) == NULL ) {
         fatal_error( EX_USAGE,
@@ -875,19 +1650,58 @@ void options_init( int argc, char const *argv[], void (*usage)(int) ) {
     else if ( opt_fin_name != NULL ) {
       alias = pattern_find( opt_fin_name );
     }
-    if ( alias != NULL ) {
-      parse_options(
-        alias->argc, alias->argv, OPTS_SHORT[0], OPTS_LONG[0],
-        /*cmdline_forbidden_opts=*/"", usage, alias->line_no
-      );
-    }
+    apply_alias( alias );
   }
 
+  if ( opt_in_place )
+    return;                             // see options_init_file()
+
   if ( strcmp( fin_path, "-" ) != 0 && !freopen( fin_path, "r", stdin ) )
     fatal_error( EX_NOINPUT, "\"%s\": %s\n", fin_path, STRERROR() );
 
-  if ( strcmp( fout_path, "-" ) != 0 && !freopen( fout_path, "w", stdout ) )
-    fatal_error( EX_CANTCREAT, "\"%s\": %s\n", fout_path, STRERROR() );
+  if ( opt_widths_len > 0 && !opt_measure ) {
+    //
+    // Each width's output is written to its own file by wrap_run().
+    //
+    if ( codec_of_path( fout_path ) != CODEC_NONE ) {
+      fatal_error( EX_USAGE,
+        "\"%s\": compressed output can not be given with %s\n",
+        fout_path, opt_format( COPT(WIDTHS) )
+      );
+    }
+    opt_widths_path = fout_path;
+  }
+  else {
+    codec_t codec = codec_of_path( fout_path );
+    if ( opt_keep_encoding ) {
+      codec_t const in_codec = reader_codec( stdin );
+      if ( codec_is_unicode( in_codec ) ) {
+        if ( codec != CODEC_NONE ) {
+          fatal_error( EX_USAGE,
+            "\"%s\": compressed output can not be given with %s\n",
+            fout_path, opt_format( COPT_KEEP_ENCODING )
+          );
+        }
+        //
+        // The byte order mark was transcoded to UTF-8 along with the rest of
+        // the input: keep it so it's transcoded back.
+        //
+        codec = in_codec;
+        opt_keep_bom = true;
+      }
+    }
+    if ( strcmp( fout_path, "-" ) != 0 && !freopen( fout_path, "w", stdout ) )
+      fatal_error( EX_CANTCREAT, "\"%s\": %s\n", fout_path, STRERROR() );
+    encoder_stdout( codec );
+  }
+}
+
+void options_init_file( char const *path ) {
+  assert( path != NULL );
+  ASSERT_RUN_ONCE();
+  opt_fin_name = base_name( path );
+  if ( !opt_no_conf && opt_alias == NULL )
+    apply_alias( pattern_find( opt_fin_name ) );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -30,30 +30,51 @@
 
 // local
 #include "pjl_config.h"                 /* must go first */
+#include "alias.h"
+#include "git.h"
 
 /// @cond DOXYGEN_IGNORE
 
 // standard
 #include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint64_t */
 
 // in ascending option character ASCII order
+#define OPT_MEASURE               0
+#define OPT_EDITS                 1
+#define OPT_JSONL                 2
+#define OPT_EMAIL_QUOTES          3
+#define OPT_MARKUP                4
+#define OPT_ABBREVIATIONS         5
+#define OPT_NO_BREAK              6
+#define OPT_WIDTHS                7
+#define OPT_KEEP_BOM              8
+#define OPT_GIT_CHANGED           9
 #define OPT_ALIAS                 a
 #define OPT_ALIGN_COLUMN          A
+#define OPT_UNICODE_BREAKS        B
 #define OPT_BLOCK_REGEX           b
 #define OPT_CONFIG                c
 #define OPT_NO_CONFIG             C
+#define OPT_DIFF                  X
 #define OPT_DOT_IGNORE            d
 #define OPT_COMMENT_CHARS         D
 #define OPT_EOS_DELIMIT           e
 #define OPT_EOS_SPACES            E
 #define OPT_FILE                  f
 #define OPT_FILE_NAME             F
+#define OPT_LINES                 g
+#define OPT_ALL_COMMENTS          G
 #define OPT_HANG_TABS             h     /* ambiguous with OPT_HELP */
 #define OPT_HELP                  h     /* ambiguous with OPT_HANG_TABS */
 #define OPT_HANG_SPACES           H
 #define OPT_INDENT_TABS           i
 #define OPT_INDENT_SPACES         I
+#define OPT_JOBS                  j
+#define OPT_JUSTIFY               J
+#define OPT_CHECK                 k
+#define OPT_PARA_CACHE            K
 #define OPT_EOL                   l
 #define OPT_LEAD_STRING           L
 #define OPT_MIRROR_TABS           m
@@ -61,19 +82,41 @@
 #define OPT_NO_NEWLINES_DELIMIT   n
 #define OPT_ALL_NEWLINES_DELIMIT  N
 #define OPT_OUTPUT                o
+#define OPT_IN_PLACE              O
 #define OPT_PARA_CHARS            p
 #define OPT_PROTOTYPE             P
+#define OPT_EXPAND_TABS           q
+#define OPT_FOLLOW                Q
+#define OPT_OPTIMAL               r
+#define OPT_STATS                 R
 #define OPT_TAB_SPACES            s
 #define OPT_LEAD_SPACES           S
 #define OPT_LEAD_TABS             t
 #define OPT_TITLE_LINE            T
 #define OPT_MARKDOWN              u
+#define OPT_MARKDOWN_TABLES       U
 #define OPT_VERSION               v
+#define OPT_MAX_LINES             V
 #define OPT_WIDTH                 w
 #define OPT_WHITESPACE_DELIMIT    W
 #define OPT_DOXYGEN               x
 #define OPT_NO_HYPHEN             y
+#define OPT_HYPHENATE             Y
 #define OPT_ENABLE_IPC            Z
+#define OPT_AFFINITY              z
+
+//
+// Every short option character is taken, so these options are long only: each
+// is given a control character that getopt_long() returns for it instead.
+//
+#define COPT_READ_INDEX           '\1'
+#define SOPT_READ_INDEX           "\1"
+#define COPT_WRITE_INDEX          '\2'
+#define SOPT_WRITE_INDEX          "\2"
+#define COPT_KEEP_ENCODING        '\3'
+#define SOPT_KEEP_ENCODING        "\3"
+#define COPT_MINIMAL              '\4'
+#define SOPT_MINIMAL              "\4"
 
 /// Command-line option character as a character literal.
 #define COPT(X)                   CHARIFY(OPT_##X)
@@ -105,48 +148,112 @@ enum eol {
 };
 typedef enum eol eol_t;
 
+/**
+ * Markup languages other than Markdown.
+ */
+enum markup {
+  MARKUP_NONE,                          ///< None: plain text.
+  MARKUP_ASCIIDOC,                      ///< AsciiDoc.
+  MARKUP_HTML,                          ///< HTML or XML.
+  MARKUP_ROFF,                          ///< **roff**(7), e.g., man or mdoc.
+  MARKUP_RST                            ///< reStructuredText.
+};
+typedef enum markup markup_t;
+
 // extern option variables
+/// Path of abbreviations file.
+extern char const  *opt_abbreviations;
+
+extern bool         opt_affinity;       ///< Pin parallel jobs to CPUs?
 extern char const  *opt_alias;          ///< Alias name to use.
+extern bool         opt_align_block;    ///< Align comments per block?
 extern char         opt_align_char;     ///< Use this to pad comment alignment.
 extern size_t       opt_align_column;   ///< Align comment on given column.
+extern bool         opt_all_comments;   ///< Reformat all comments?
 extern char const  *opt_block_regex;    ///< Block regular expression.
+extern bool         opt_check;          ///< Only check input is formatted?
 extern char const  *opt_comment_chars;  ///< Chars that delimit comments.
 extern char const  *opt_conf_file;      ///< Configuration file path.
 extern bool         opt_data_link_esc;  ///< Respond to in-band control?
+extern bool         opt_diff;           ///< Only diff input and output?
 extern bool         opt_doxygen;        ///< Handle Doxygen commands?
+extern bool         opt_edits;          ///< Only write edits to the input?
+extern bool         opt_email_quotes;   ///< Reformat quoted e-mail?
 extern eol_t        opt_eol;            ///< End-of-line treatment.
 extern bool         opt_eos_delimit;    ///< End-of-sentence delimits para's?
 extern size_t       opt_eos_spaces;     ///< Spaces after end-of-sentence.
+extern bool         opt_expand_tabs;    ///< Expand tabs in output to spaces?
 extern char const  *opt_fin_name;       ///< File in name (only).
+extern char const  *opt_fin_path;       ///< File in path, if any.
+extern char const *const *opt_files;    ///< Files to reformat in place.
+extern size_t       opt_files_len;      ///< Length of \ref opt_files.
+extern size_t       opt_follow;         ///< Idle ms before flush; 0 = off.
+extern char const  *opt_git_changed;    ///< Git revision to reformat since.
+extern git_file_t const *opt_git_files; ///< Changed \ref opt_files, if any.
 extern size_t       opt_hang_spaces;    ///< Hanging-indent spaces.
 extern size_t       opt_hang_tabs;      ///< Hanging-indent tabs.
+extern char const  *opt_hyphenate;      ///< Hyphenation pattern file path.
 extern size_t       opt_indt_spaces;    ///< Indent spaces.
 extern size_t       opt_indt_tabs;      ///< Indent tabs.
+extern bool         opt_in_place;       ///< Reformat \ref opt_files in place?
+extern size_t       opt_jobs;           ///< Parallel jobs; 0 = number of CPUs.
+extern char const  *opt_jsonl;          ///< JSON Lines member to reformat.
+extern bool         opt_jsonl_text;     ///< Write \ref opt_jsonl as text?
+extern bool         opt_justify;        ///< Justify lines?
+extern bool         opt_keep_bom;       ///< Keep input's byte order mark?
+extern bool         opt_keep_encoding;  ///< Keep input's UTF-16/32 encoding?
 extern bool         opt_lead_dot_ignore;///< Ignore lines starting with '.'?
 extern size_t       opt_lead_spaces;    ///< Number of leading spaces.
 extern char const  *opt_lead_string;    ///< Leading string.
 extern size_t       opt_lead_tabs;      ///< Number of leading tabs.
 extern bool         opt_lead_ws_delimit;///< Leading whitespace delimit para's?
 extern size_t       opt_line_width;     ///< Maximum line width.
+extern size_t       opt_lines_first;    ///< First line to reformat; 0 = all.
+extern size_t       opt_lines_last;     ///< Last line to reformat.
 extern bool         opt_markdown;       ///< Recognize and reformat Markdown?
+extern bool         opt_markdown_tables;///< Align Markdown table columns?
+extern markup_t     opt_markup;         ///< Other markup to reformat.
+extern size_t       opt_max_lines;      ///< Stop after lines; 0 = no limit.
+extern bool         opt_measure;        ///< Only measure paragraphs?
+extern bool         opt_minimal;        ///< Only break over-long lines?
 extern size_t       opt_mirror_spaces;  ///< Mirror spaces?
 extern size_t       opt_mirror_tabs;    ///< Mirror tabs?
 
 /// Number of consecutive newlines that delimit a paragraph.
 extern size_t       opt_newlines_delimit;
 
+extern char const  *opt_no_break;       ///< Path of no-break tokens file.
 extern bool         opt_no_conf;        ///< Do not read configuration file.
 extern bool         opt_no_hyphen;      ///< Do not treat hyphens specially.
+
+/// Maximum number of words to keep to minimize raggedness; 0 = don't.
+extern size_t       opt_optimal;
+
+/// Paragraph cache file path; `""` = default; NULL = don't cache.
+extern char const  *opt_para_cache;
+
 extern char const  *opt_para_delims;    ///< Additional para delimiter chars.
 extern bool         opt_prototype;      ///< First line whitespace is prototype?
+extern char const  *opt_read_index;     ///< Paragraph index to seek via.
+extern bool         opt_stats;          ///< Print per-stage statistics?
+
+/// Number of costliest paragraphs to print for `--stats`; 0 = none.
+extern size_t       opt_stats_paras;
+
 extern size_t       opt_tab_spaces;     ///< Number of spaces 1 tab equals.
 extern bool         opt_title_line;     ///< First line of paragraph is title?
+extern bool         opt_unicode_breaks; ///< Break per Unicode (UAX #14)?
+extern size_t       opt_widths[];       ///< Line widths for --widths.
+extern size_t       opt_widths_len;     ///< Length of \ref opt_widths.
+extern char const  *opt_widths_path;    ///< Output path for \ref opt_widths.
+extern char const  *opt_write_index;    ///< Paragraph index to write.
 
 ////////// extern functions ///////////////////////////////////////////////////
 
 /**
  * Formats an option as <code>[--%%s/]-%%c</code> where `%s` is the long option
- * (if any) and `%c` is the short option.
+ * (if any) and `%c` is the short option, or as only <code>--%%s</code> if the
+ * option is long only.
  *
  * @param short_opt The short option (along with its corresponding long option,
  * if any) to format.
@@ -159,6 +266,46 @@ extern bool         opt_title_line;     ///< First line of paragraph is title?
 PJL_DISCARD
 char const* opt_format( char short_opt );
 
+/**
+ * Gets whether an option was given either on the command line or by an alias.
+ *
+ * @param short_opt The short option to check.
+ * @return Returns `true` only if it was.
+ */
+NODISCARD
+bool opt_given( char short_opt );
+
+/**
+ * Gets the block regular expression, if any, that an alias sets.
+ *
+ * @param alias The \ref alias to get the block regular expression of.
+ * @return Returns said regular expression or NULL if none.
+ */
+NODISCARD
+char const* options_alias_block_regex( alias_t const *alias );
+
+/**
+ * Hashes the options that affect how text is reformatted so output cached
+ * under one set of options is never used for another.
+ *
+ * @return Returns said hash.
+ *
+ * @sa para_cache_open()
+ */
+NODISCARD
+uint64_t options_hash( void );
+
+/**
+ * Hashes the options that options_init_file() would set for \a path so two
+ * files whose contents are the same and whose hashes are the same are
+ * reformatted the same.
+ *
+ * @param path The path of the file to reformat.
+ * @return Returns said hash.
+ */
+NODISCARD
+uint64_t options_file_hash( char const *path );
+
 /**
  * Initializes command-line option variables.
  *
@@ -169,6 +316,18 @@ char const* opt_format( char short_opt );
  */
 void options_init( int argc, char const *argv[], void (*usage)(int) );
 
+/**
+ * Sets the options for reformatting \a path in place: if no alias was given,
+ * applies the alias of the configuration file pattern, if any, that matches
+ * \a path.
+ *
+ * @param path The path of the file to reformat.
+ *
+ * @note This must be called at most once per process after options_init()
+ * since options are modified in place.
+ */
+void options_init_file( char const *path );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
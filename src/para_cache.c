@@ -0,0 +1,872 @@
+/*
+**      wrap -- text reformatter
+**      src/para_cache.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for an on-disk cache of reformatted paragraphs.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "para_cache.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <fcntl.h>                      /* for open(2) */
+#include <limits.h>                     /* for PATH_MAX */
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t, uint64_t */
+#include <stdio.h>                      /* for rename(2), snprintf(3) */
+#include <stdlib.h>                     /* for mkstemp(3), qsort(3) */
+#include <string.h>
+#include <sys/stat.h>                   /* for fstat(2), stat(2) */
+#include <unistd.h>                     /* for close(2), read(2), unlink(2) */
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+# include <sys/mman.h>                  /* for mmap(2) */
+# define WITH_PARA_CACHE_MMAP 1
+# if defined(MAP_ANONYMOUS) && HAVE_SCHED_H && HAVE_STDATOMIC_H
+#   include <sched.h>                   /* for sched_yield(2) */
+#   include <stdatomic.h>
+#   define WITH_PARA_CACHE_SHM 1
+# endif /* MAP_ANONYMOUS && HAVE_SCHED_H && HAVE_STDATOMIC_H */
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+
+/// @endcond
+
+/**
+ * @addtogroup para-cache-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Byte-order mark of a cache file: if it's anything else, the file was written
+ * on a machine of the other endianness and is treated as empty.
+ */
+#define PARA_CACHE_BOM            0x01020304u
+
+/**
+ * Magic number of a cache file.
+ */
+#define PARA_CACHE_MAGIC          "WRAPPARA"
+
+/**
+ * Maximum size of a cache file: when writing it would exceed this, the
+ * paragraphs neither added nor used by this run are dropped first.
+ */
+#define PARA_CACHE_SIZE_MAX       (64 * 1024 * 1024)
+
+/**
+ * Number of shards of the shared cache: each has its own lock so workers
+ * seldom wait on one another.
+ */
+#define PARA_CACHE_SHM_SHARDS     16
+
+/**
+ * Size of each slot of the shared cache: a paragraph whose text and output
+ * together don't fit in one isn't shared.
+ */
+#define PARA_CACHE_SHM_SLOT_SIZE  4096
+
+/**
+ * Number of slots of each set of the shared cache: a paragraph can be cached
+ * only in the set its key maps to, so this many of those whose keys map to
+ * the same set can be cached at once.
+ */
+#define PARA_CACHE_SHM_WAYS       8
+
+/**
+ * Version of the format of cache files.
+ */
+#define PARA_CACHE_VERSION        1u
+
+/**
+ * The header of a cache file.  It's followed by:
+ *
+ *  1. \a n_entries \ref para_cache_entry structures sorted by key; and
+ *  2. \a data_len bytes of the text and output of every entry.
+ *
+ * All integers are in the byte order of the machine that wrote the file so the
+ * file can be used as-is once memory-mapped.
+ */
+struct para_cache_header {
+  char      magic[8];                   ///< #PARA_CACHE_MAGIC (no null).
+  uint32_t  bom;                        ///< #PARA_CACHE_BOM.
+  uint32_t  version;                    ///< #PARA_CACHE_VERSION.
+  uint64_t  n_entries;                  ///< Number of entries.
+  uint64_t  data_len;                   ///< Number of bytes of data.
+};
+typedef struct para_cache_header para_cache_header_t;
+
+/**
+ * A paragraph in a cache file.
+ */
+struct para_cache_entry {
+  uint64_t  key;                        ///< Hash of options and text.
+  uint64_t  off;                        ///< Data offset of text, then output.
+  uint32_t  in_len;                     ///< Length of text.
+  uint32_t  out_len;                    ///< Length of output.
+};
+typedef struct para_cache_entry para_cache_entry_t;
+
+static_assert(
+  sizeof( para_cache_header_t ) == 32, "para_cache_header_t must be packed"
+);
+static_assert(
+  sizeof( para_cache_entry_t ) == 24, "para_cache_entry_t must be packed"
+);
+
+/**
+ * A cache file read into memory.
+ */
+struct para_cache_image {
+  char                     *buf;        ///< File's contents.
+  size_t                    size;       ///< Size of \a buf.
+  bool                      mapped;     ///< Is \a buf mmap'd?
+  para_cache_entry_t const *entries;    ///< Entries sorted by key.
+  size_t                    n_entries;  ///< Number of \a entries.
+  char const               *data;       ///< Text and output of \a entries.
+  uint64_t                  data_len;   ///< Length of \a data.
+};
+typedef struct para_cache_image para_cache_image_t;
+
+/**
+ * A paragraph added by this run.
+ */
+struct para_cache_new {
+  uint64_t  key;                        ///< Hash of options and text.
+  size_t    off;                        ///< Offset of text, then output.
+  uint32_t  in_len;                     ///< Length of text.
+  uint32_t  out_len;                    ///< Length of output.
+};
+typedef struct para_cache_new para_cache_new_t;
+
+/**
+ * A paragraph to be written to a cache file.
+ */
+struct para_cache_rec {
+  uint64_t    key;                      ///< Hash of options and text.
+  char const *in;                       ///< Text.
+  char const *out;                      ///< Output.
+  uint32_t    in_len;                   ///< Length of \a in.
+  uint32_t    out_len;                  ///< Length of \a out.
+  size_t      rank;                     ///< Lower ranks are kept first.
+};
+typedef struct para_cache_rec para_cache_rec_t;
+
+#ifdef WITH_PARA_CACHE_SHM
+/**
+ * A shard of the shared cache.
+ */
+struct para_cache_shm_shard {
+  atomic_flag lock;                     ///< Held while using the shard.
+  uint64_t    clock;                    ///< Incremented upon every use.
+};
+typedef struct para_cache_shm_shard para_cache_shm_shard_t;
+
+/**
+ * A paragraph in the shared cache.
+ */
+struct para_cache_shm_slot {
+  uint64_t  key;                        ///< Hash of options and text.
+  uint64_t  used;                       ///< Clock at last use or 0 if free.
+  uint32_t  in_len;                     ///< Length of text.
+  uint32_t  out_len;                    ///< Length of output.
+  char      data[ PARA_CACHE_SHM_SLOT_SIZE - 24 ];  ///< Text, then output.
+};
+typedef struct para_cache_shm_slot para_cache_shm_slot_t;
+
+static_assert(
+  sizeof( para_cache_shm_slot_t ) == PARA_CACHE_SHM_SLOT_SIZE,
+  "para_cache_shm_slot_t must be packed"
+);
+#endif /* WITH_PARA_CACHE_SHM */
+
+// local variable definitions
+static bool               *cache_hits;  ///< Entries of \ref cache_image used.
+static para_cache_image_t  cache_image; ///< Cache file read at open.
+static uint64_t            cache_key_seed;  ///< Hash of options.
+static char                cache_path_buf[ PATH_MAX ];  ///< Cache file path.
+static char               *new_data;    ///< Text and output of \ref new_recs.
+static size_t              new_data_cap;///< Capacity of \ref new_data.
+static size_t              new_data_len;///< Length of \ref new_data.
+static size_t             *new_index;   ///< Hash table of \ref new_recs + 1.
+static size_t              new_index_cap;   ///< Capacity of \ref new_index.
+static para_cache_new_t   *new_recs;    ///< Paragraphs added by this run.
+static size_t              new_recs_cap;///< Capacity of \ref new_recs.
+static size_t              new_recs_len;///< Length of \ref new_recs.
+static para_cache_stats_t  cache_stats; ///< Statistics of this run.
+
+#ifdef WITH_PARA_CACHE_SHM
+static char                 shm_out_buf[ PARA_CACHE_SHM_SLOT_SIZE ];
+                                        ///< Output copied from \ref shm_slots.
+static size_t               shm_sets;   ///< Number of sets of each shard.
+static para_cache_shm_shard_t *shm_shards;  ///< Shards of the shared cache.
+static para_cache_shm_slot_t  *shm_slots;   ///< Slots of every shard.
+#endif /* WITH_PARA_CACHE_SHM */
+
+// local functions
+static void                para_cache_close( void );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Frees the memory used by \a image and makes it empty.
+ *
+ * @param image The \ref para_cache_image to clean up.
+ */
+static void para_cache_image_cleanup( para_cache_image_t *image ) {
+  assert( image != NULL );
+#ifdef WITH_PARA_CACHE_MMAP
+  if ( image->mapped )
+    PJL_DISCARD_RV( munmap( image->buf, image->size ) );
+  else
+#endif /* WITH_PARA_CACHE_MMAP */
+    free( image->buf );
+  *image = (para_cache_image_t){ 0 };
+}
+
+/**
+ * Reads the cache file at \a path into \a image.
+ *
+ * @param path The path of the cache file.
+ * @param image The \ref para_cache_image to read into.
+ * @return Returns `true` only if the file was read and is consistent.
+ */
+NODISCARD
+static bool para_cache_image_read( char const *path,
+                                   para_cache_image_t *image ) {
+  assert( path != NULL );
+  assert( image != NULL );
+
+  int const fd = open( path, O_RDONLY );
+  if ( fd == -1 )
+    return false;
+  struct stat st;
+  if ( fstat( fd, &st ) == -1 || !S_ISREG( st.st_mode ) ||
+       STATIC_CAST( size_t, st.st_size ) < sizeof( para_cache_header_t ) ) {
+    close( fd );
+    return false;
+  }
+  size_t const size = STATIC_CAST( size_t, st.st_size );
+
+#ifdef WITH_PARA_CACHE_MMAP
+  void *const map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  if ( map != MAP_FAILED ) {
+    image->buf = map;
+    image->mapped = true;
+  }
+#endif /* WITH_PARA_CACHE_MMAP */
+  if ( image->buf == NULL ) {
+    image->buf = MALLOC( char, size );
+    for ( size_t n = 0; n < size; ) {
+      ssize_t const bytes_read = read( fd, image->buf + n, size - n );
+      if ( bytes_read <= 0 ) {
+        close( fd );
+        para_cache_image_cleanup( image );
+        return false;
+      }
+      n += STATIC_CAST( size_t, bytes_read );
+    } // for
+  }
+  image->size = size;
+  close( fd );
+
+  para_cache_header_t const *const header =
+    POINTER_CAST( para_cache_header_t const*, image->buf );
+  uint64_t const entries_size = size - sizeof( para_cache_header_t );
+  if ( memcmp( header->magic, PARA_CACHE_MAGIC, 8 ) != 0 ||
+       header->bom != PARA_CACHE_BOM ||
+       header->version != PARA_CACHE_VERSION ||
+       header->n_entries > entries_size / sizeof( para_cache_entry_t ) ||
+       header->data_len != entries_size -
+         header->n_entries * sizeof( para_cache_entry_t ) ) {
+    para_cache_image_cleanup( image );
+    return false;
+  }
+
+  image->entries = POINTER_CAST(
+    para_cache_entry_t const*, image->buf + sizeof( para_cache_header_t )
+  );
+  image->n_entries = STATIC_CAST( size_t, header->n_entries );
+  image->data = POINTER_CAST( char const*, image->entries + image->n_entries );
+  image->data_len = header->data_len;
+  return true;
+}
+
+/**
+ * Checks whether an entry of \a image is within its data.
+ *
+ * @param image The \ref para_cache_image containing the entry.
+ * @param i The index of the entry.
+ * @return Returns `true` only if the entry is not corrupt.
+ */
+NODISCARD
+static bool para_cache_entry_ok( para_cache_image_t const *image, size_t i ) {
+  assert( image != NULL );
+  assert( i < image->n_entries );
+  para_cache_entry_t const *const entry = &image->entries[i];
+  return  entry->off <= image->data_len &&
+          STATIC_CAST( uint64_t, entry->in_len ) + entry->out_len <=
+          image->data_len - entry->off;
+}
+
+/**
+ * Gets the entry of \a image for \a key.
+ *
+ * @param image The \ref para_cache_image to search.
+ * @param key The key to find.
+ * @return Returns the index of said entry or `SIZE_MAX` if none or it's
+ * corrupt.
+ */
+NODISCARD
+static size_t para_cache_image_find( para_cache_image_t const *image,
+                                     uint64_t key ) {
+  assert( image != NULL );
+  size_t lo = 0, hi = image->n_entries;
+  while ( lo < hi ) {
+    size_t const mid = lo + (hi - lo) / 2;
+    uint64_t const mid_key = image->entries[ mid ].key;
+    if ( mid_key < key )
+      lo = mid + 1;
+    else if ( mid_key > key )
+      hi = mid;
+    else
+      return para_cache_entry_ok( image, mid ) ? mid : SIZE_MAX;
+  } // while
+  return SIZE_MAX;
+}
+
+/**
+ * Gets a \ref para_cache_rec for an entry of \a image.
+ *
+ * @param image The \ref para_cache_image containing the entry.
+ * @param i The index of the entry.
+ * @param rank The rank to give it.
+ * @return Returns said \ref para_cache_rec.
+ */
+NODISCARD
+static para_cache_rec_t para_cache_image_rec( para_cache_image_t const *image,
+                                              size_t i, size_t rank ) {
+  para_cache_entry_t const *const entry = &image->entries[i];
+  char const *const in = image->data + entry->off;
+  return (para_cache_rec_t){
+    .key = entry->key,
+    .in = in,
+    .out = in + entry->in_len,
+    .in_len = entry->in_len,
+    .out_len = entry->out_len,
+    .rank = rank
+  };
+}
+
+/**
+ * Compares two \ref para_cache_rec objects by key, then rank.
+ *
+ * @param i_data A pointer to the first \ref para_cache_rec.
+ * @param j_data A pointer to the second \ref para_cache_rec.
+ * @return Returns a number less than 0, 0, or greater than 0 if \a i_data is
+ * less than, equal to, or greater than \a j_data, respectively.
+ */
+NODISCARD
+static int para_cache_rec_cmp_key( void const *i_data, void const *j_data ) {
+  para_cache_rec_t const *const i_rec = i_data;
+  para_cache_rec_t const *const j_rec = j_data;
+  if ( i_rec->key != j_rec->key )
+    return i_rec->key < j_rec->key ? -1 : 1;
+  return (i_rec->rank > j_rec->rank) - (i_rec->rank < j_rec->rank);
+}
+
+/**
+ * Compares two \ref para_cache_rec objects by rank.
+ *
+ * @param i_data A pointer to the first \ref para_cache_rec.
+ * @param j_data A pointer to the second \ref para_cache_rec.
+ * @return Returns a number less than 0, 0, or greater than 0 if \a i_data is
+ * less than, equal to, or greater than \a j_data, respectively.
+ */
+NODISCARD
+static int para_cache_rec_cmp_rank( void const *i_data, void const *j_data ) {
+  para_cache_rec_t const *const i_rec = i_data;
+  para_cache_rec_t const *const j_rec = j_data;
+  return (i_rec->rank > j_rec->rank) - (i_rec->rank < j_rec->rank);
+}
+
+/**
+ * Writes the cache file with the paragraphs added by this run followed by, as
+ * space permits, those used by this run, then all others.
+ *
+ * @remarks The cache file is read again first since another **wrap**(1) may
+ * have written it since it was opened.
+ */
+static void para_cache_write( void ) {
+  para_cache_image_t current = { 0 };
+  PJL_DISCARD_RV( para_cache_image_read( cache_path_buf, &current ) );
+
+  size_t const n_max =
+    new_recs_len + cache_image.n_entries + current.n_entries;
+  para_cache_rec_t *const recs = MALLOC( para_cache_rec_t, n_max );
+  size_t n = 0;
+
+  for ( size_t i = 0; i < new_recs_len; ++i, ++n ) {
+    char const *const in = new_data + new_recs[i].off;
+    recs[n] = (para_cache_rec_t){
+      .key = new_recs[i].key,
+      .in = in,
+      .out = in + new_recs[i].in_len,
+      .in_len = new_recs[i].in_len,
+      .out_len = new_recs[i].out_len,
+      .rank = n
+    };
+  } // for
+  for ( size_t i = 0; i < cache_image.n_entries; ++i ) {
+    if ( cache_hits[i] ) {
+      recs[n] = para_cache_image_rec( &cache_image, i, n );
+      ++n;
+    }
+  } // for
+  for ( size_t i = 0; i < current.n_entries; ++i ) {
+    if ( para_cache_entry_ok( &current, i ) ) {
+      recs[n] = para_cache_image_rec( &current, i, n );
+      ++n;
+    }
+  } // for
+  for ( size_t i = 0; i < cache_image.n_entries; ++i ) {
+    if ( !cache_hits[i] && para_cache_entry_ok( &cache_image, i ) ) {
+      recs[n] = para_cache_image_rec( &cache_image, i, n );
+      ++n;
+    }
+  } // for
+
+  //
+  // Remove duplicates keeping the lowest ranked one of each key.
+  //
+  qsort( recs, n, sizeof( para_cache_rec_t ), &para_cache_rec_cmp_key );
+  size_t n_unique = 0;
+  for ( size_t i = 0; i < n; ++i ) {
+    if ( n_unique == 0 || recs[i].key != recs[ n_unique - 1 ].key )
+      recs[ n_unique++ ] = recs[i];
+  } // for
+  n = n_unique;
+
+  size_t size = sizeof( para_cache_header_t );
+  for ( size_t i = 0; i < n; ++i )
+    size += sizeof( para_cache_entry_t ) + recs[i].in_len + recs[i].out_len;
+  if ( size > PARA_CACHE_SIZE_MAX ) {
+    qsort( recs, n, sizeof( para_cache_rec_t ), &para_cache_rec_cmp_rank );
+    size = sizeof( para_cache_header_t );
+    size_t n_kept = 0;
+    for ( ; n_kept < n; ++n_kept ) {
+      size_t const rec_size = sizeof( para_cache_entry_t ) +
+        recs[ n_kept ].in_len + recs[ n_kept ].out_len;
+      if ( size + rec_size > PARA_CACHE_SIZE_MAX )
+        break;
+      size += rec_size;
+    } // for
+    n = n_kept;
+    qsort( recs, n, sizeof( para_cache_rec_t ), &para_cache_rec_cmp_key );
+  }
+
+  char *const image = MALLOC( char, size );
+  para_cache_header_t *const header =
+    POINTER_CAST( para_cache_header_t*, image );
+  MEM_ZERO( header );
+  memcpy( header->magic, PARA_CACHE_MAGIC, sizeof header->magic );
+  header->bom = PARA_CACHE_BOM;
+  header->version = PARA_CACHE_VERSION;
+  header->n_entries = n;
+  header->data_len = size - sizeof( para_cache_header_t ) -
+    n * sizeof( para_cache_entry_t );
+
+  para_cache_entry_t *const entries = POINTER_CAST(
+    para_cache_entry_t*, image + sizeof( para_cache_header_t )
+  );
+  char *const data = POINTER_CAST( char*, entries + n );
+  uint64_t off = 0;
+  for ( size_t i = 0; i < n; ++i ) {
+    entries[i] = (para_cache_entry_t){
+      .key = recs[i].key,
+      .off = off,
+      .in_len = recs[i].in_len,
+      .out_len = recs[i].out_len
+    };
+    memcpy( data + off, recs[i].in, recs[i].in_len );
+    off += recs[i].in_len;
+    memcpy( data + off, recs[i].out, recs[i].out_len );
+    off += recs[i].out_len;
+  } // for
+  assert( off == header->data_len );
+  free( recs );
+  para_cache_image_cleanup( &current );
+
+  //
+  // Write to a temporary file and rename it so a concurrent reader never sees
+  // a partial cache file -- but never replace something that isn't a regular
+  // file, e.g., /dev/null.
+  //
+  char temp_buf[ PATH_MAX ];
+  struct stat st;
+  if ( stat( cache_path_buf, &st ) == 0 && !S_ISREG( st.st_mode ) )
+    goto done;
+  int const len =
+    snprintf( temp_buf, sizeof temp_buf, "%s.XXXXXX", cache_path_buf );
+  if ( len < 0 || STATIC_CAST( size_t, len ) >= sizeof temp_buf )
+    goto done;
+  int const fd = mkstemp( temp_buf );
+  if ( fd == -1 )
+    goto done;
+  bool const ok = fd_write( fd, image, size ) == 0;
+  if ( close( fd ) == -1 || !ok || rename( temp_buf, cache_path_buf ) == -1 )
+    PJL_DISCARD_RV( unlink( temp_buf ) );
+
+done:
+  free( image );
+}
+
+/**
+ * Writes the cache file, if any paragraphs were added, and cleans-up all cache
+ * data.
+ */
+static void para_cache_close( void ) {
+  if ( new_recs_len > 0 )
+    para_cache_write();
+  para_cache_image_cleanup( &cache_image );
+  FREE( cache_hits );
+  FREE( new_data );
+  FREE( new_index );
+  FREE( new_recs );
+  new_data_cap = new_data_len = new_index_cap = 0;
+  new_recs_cap = new_recs_len = 0;
+}
+
+/**
+ * Inserts the last of \ref new_recs into \ref new_index, growing it first if
+ * necessary.
+ */
+static void para_cache_index_new( void ) {
+  if ( 2 * new_recs_len > new_index_cap ) {
+    FREE( new_index );
+    new_index_cap = new_index_cap == 0 ? 64 : new_index_cap * 2;
+    new_index = MALLOC( size_t, new_index_cap );
+    memset( new_index, 0, new_index_cap * sizeof( size_t ) );
+    for ( size_t i = 0; i + 1 < new_recs_len; ++i ) {
+      size_t j = new_recs[i].key & (new_index_cap - 1);
+      while ( new_index[j] != 0 )
+        j = (j + 1) & (new_index_cap - 1);
+      new_index[j] = i + 1;
+    } // for
+  }
+  size_t j = new_recs[ new_recs_len - 1 ].key & (new_index_cap - 1);
+  while ( new_index[j] != 0 )
+    j = (j + 1) & (new_index_cap - 1);
+  new_index[j] = new_recs_len;
+}
+
+#ifdef WITH_PARA_CACHE_SHM
+/**
+ * Finds the paragraph having \a key and text \a in in a set of the shared
+ * cache.
+ *
+ * @param set The first slot of the set to search.
+ * @param key The key of the paragraph.
+ * @param in The text of the paragraph.
+ * @param in_len The length of \a in.
+ * @return Returns the slot of said paragraph or NULL if none.
+ *
+ * @note The set's shard must be locked.
+ */
+NODISCARD
+static para_cache_shm_slot_t* para_cache_shm_find( para_cache_shm_slot_t *set,
+                                                   uint64_t key,
+                                                   char const *in,
+                                                   size_t in_len ) {
+  for ( size_t i = 0; i < PARA_CACHE_SHM_WAYS; ++i ) {
+    para_cache_shm_slot_t *const slot = &set[i];
+    if ( slot->used != 0 && slot->key == key && slot->in_len == in_len &&
+         memcmp( slot->data, in, in_len ) == 0 ) {
+      return slot;
+    }
+  } // for
+  return NULL;
+}
+
+/**
+ * Gets the shard and the first slot of the set of the shared cache for
+ * \a key, then locks the shard.
+ *
+ * @param key The key of the paragraph.
+ * @param pset A pointer to receive the first slot of the set.
+ * @return Returns the shard to pass to para_cache_shm_unlock().
+ */
+NODISCARD
+static para_cache_shm_shard_t* para_cache_shm_lock( uint64_t key,
+                                                    para_cache_shm_slot_t
+                                                      **pset ) {
+  size_t const shard = key % PARA_CACHE_SHM_SHARDS;
+  size_t const set = (key / PARA_CACHE_SHM_SHARDS) % shm_sets;
+  *pset = &shm_slots[ (shard * shm_sets + set) * PARA_CACHE_SHM_WAYS ];
+  para_cache_shm_shard_t *const s = &shm_shards[ shard ];
+  while ( atomic_flag_test_and_set_explicit( &s->lock, memory_order_acquire ) )
+    sched_yield();
+  return s;
+}
+
+/**
+ * Unlocks a shard of the shared cache.
+ *
+ * @param shard The shard gotten from para_cache_shm_lock().
+ */
+static void para_cache_shm_unlock( para_cache_shm_shard_t *shard ) {
+  atomic_flag_clear_explicit( &shard->lock, memory_order_release );
+}
+
+/**
+ * Gets the reformatted output of a paragraph from the shared cache, if any.
+ *
+ * @param key The key of the paragraph.
+ * @param in The text of the paragraph.
+ * @param in_len The length of \a in.
+ * @param pout_len A pointer to receive the length of the output.
+ * @return Returns a pointer to a copy of the output (since another worker may
+ * evict it at any time) or NULL if none.
+ */
+NODISCARD
+static char const* para_cache_shm_get( uint64_t key, char const *in,
+                                       size_t in_len, size_t *pout_len ) {
+  if ( shm_slots == NULL )
+    return NULL;
+  para_cache_shm_slot_t *set;
+  para_cache_shm_shard_t *const shard = para_cache_shm_lock( key, &set );
+  para_cache_shm_slot_t *const slot =
+    para_cache_shm_find( set, key, in, in_len );
+  if ( slot != NULL ) {
+    slot->used = ++shard->clock;
+    *pout_len = slot->out_len;
+    memcpy( shm_out_buf, slot->data + in_len, slot->out_len );
+  }
+  para_cache_shm_unlock( shard );
+  return slot != NULL ? shm_out_buf : NULL;
+}
+
+/**
+ * Adds the reformatted output of a paragraph to the shared cache evicting the
+ * least recently used paragraph of its set, if necessary.
+ *
+ * @param key The key of the paragraph.
+ * @param in The text of the paragraph.
+ * @param in_len The length of \a in.
+ * @param out The reformatted output of \a in.
+ * @param out_len The length of \a out.
+ */
+static void para_cache_shm_put( uint64_t key, char const *in, size_t in_len,
+                                char const *out, size_t out_len ) {
+  if ( shm_slots == NULL ||
+       in_len + out_len > sizeof( shm_slots->data ) ) {
+    return;
+  }
+  para_cache_shm_slot_t *set;
+  para_cache_shm_shard_t *const shard = para_cache_shm_lock( key, &set );
+  para_cache_shm_slot_t *slot = para_cache_shm_find( set, key, in, in_len );
+  if ( slot == NULL ) {                 // not added by another worker
+    slot = &set[0];
+    for ( size_t i = 1; i < PARA_CACHE_SHM_WAYS; ++i ) {
+      if ( set[i].used < slot->used )
+        slot = &set[i];
+    } // for
+    if ( slot->used != 0 )
+      ++cache_stats.evictions;
+    slot->key = key;
+    slot->in_len = STATIC_CAST( uint32_t, in_len );
+    slot->out_len = STATIC_CAST( uint32_t, out_len );
+    memcpy( slot->data, in, in_len );
+    if ( out_len > 0 )
+      memcpy( slot->data + in_len, out, out_len );
+  }
+  slot->used = ++shard->clock;
+  para_cache_shm_unlock( shard );
+}
+#endif /* WITH_PARA_CACHE_SHM */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+char const* para_cache_get( char const *in, size_t in_len,
+                            size_t *pout_len ) {
+  assert( in != NULL );
+  assert( pout_len != NULL );
+  uint64_t const key = mem_hash( in, in_len, cache_key_seed );
+
+  size_t const i = para_cache_image_find( &cache_image, key );
+  if ( i != SIZE_MAX ) {
+    para_cache_entry_t const *const entry = &cache_image.entries[i];
+    char const *const c_in = cache_image.data + entry->off;
+    if ( entry->in_len == in_len && memcmp( c_in, in, in_len ) == 0 ) {
+      cache_hits[i] = true;
+      ++cache_stats.hits;
+      *pout_len = entry->out_len;
+      return c_in + in_len;
+    }
+  }
+
+  if ( new_index_cap > 0 ) {
+    for ( size_t j = key & (new_index_cap - 1); new_index[j] != 0;
+          j = (j + 1) & (new_index_cap - 1) ) {
+      para_cache_new_t const *const rec = &new_recs[ new_index[j] - 1 ];
+      if ( rec->key != key || rec->in_len != in_len )
+        continue;
+      char const *const c_in = new_data + rec->off;
+      if ( memcmp( c_in, in, in_len ) == 0 ) {
+        ++cache_stats.hits;
+        *pout_len = rec->out_len;
+        return c_in + in_len;
+      }
+    } // for
+  }
+
+#ifdef WITH_PARA_CACHE_SHM
+  char const *const out = para_cache_shm_get( key, in, in_len, pout_len );
+  if ( out != NULL ) {
+    ++cache_stats.hits;
+    return out;
+  }
+#endif /* WITH_PARA_CACHE_SHM */
+
+  ++cache_stats.misses;
+  return NULL;
+}
+
+size_t para_cache_mem( void ) {
+  size_t size = new_data_cap + new_index_cap * sizeof( size_t ) +
+                new_recs_cap * sizeof( para_cache_new_t );
+  if ( cache_hits != NULL )
+    size += cache_image.n_entries * sizeof( bool );
+  if ( !cache_image.mapped )
+    size += cache_image.size;
+  return size;
+}
+
+void para_cache_open( char const *path, uint64_t options_hash ) {
+  ASSERT_RUN_ONCE();
+  assert( path != NULL );
+
+  if ( path[0] == '\0' ) {
+    if ( !cache_path( "para", cache_path_buf, /*make_dir=*/true ) )
+      return;
+  } else {
+    int const len = snprintf( cache_path_buf, PATH_MAX, "%s", path );
+    if ( len < 0 || len >= PATH_MAX )
+      return;
+  }
+  cache_key_seed = options_hash;
+  ATEXIT( &para_cache_close );
+
+  if ( para_cache_image_read( cache_path_buf, &cache_image ) &&
+       cache_image.n_entries > 0 ) {
+    cache_hits = MALLOC( bool, cache_image.n_entries );
+    memset( cache_hits, 0, cache_image.n_entries * sizeof( bool ) );
+  }
+}
+
+void para_cache_put( char const *in, size_t in_len, char const *out,
+                     size_t out_len ) {
+  assert( in != NULL );
+  assert( out != NULL || out_len == 0 );
+  uint64_t const key = mem_hash( in, in_len, cache_key_seed );
+#ifdef WITH_PARA_CACHE_SHM
+  para_cache_shm_put( key, in, in_len, out, out_len );
+#endif /* WITH_PARA_CACHE_SHM */
+  //
+  // Paragraphs added beyond the maximum size of a cache file would only be
+  // dropped when writing it, so stop keeping them.
+  //
+  if ( cache_path_buf[0] == '\0' ||
+       new_data_len + in_len + out_len > PARA_CACHE_SIZE_MAX ) {
+    return;
+  }
+
+  if ( new_data_len + in_len + out_len > new_data_cap ) {
+    new_data_cap *= 2;
+    if ( new_data_cap < new_data_len + in_len + out_len )
+      new_data_cap = new_data_len + in_len + out_len;
+    REALLOC( new_data, char, new_data_cap );
+  }
+  if ( new_recs_len == new_recs_cap ) {
+    new_recs_cap = new_recs_cap == 0 ? 64 : new_recs_cap * 2;
+    REALLOC( new_recs, para_cache_new_t, new_recs_cap );
+  }
+
+  new_recs[ new_recs_len++ ] = (para_cache_new_t){
+    .key = key,
+    .off = new_data_len,
+    .in_len = STATIC_CAST( uint32_t, in_len ),
+    .out_len = STATIC_CAST( uint32_t, out_len )
+  };
+  memcpy( new_data + new_data_len, in, in_len );
+  new_data_len += in_len;
+  if ( out_len > 0 )
+    memcpy( new_data + new_data_len, out, out_len );
+  new_data_len += out_len;
+  para_cache_index_new();
+}
+
+void para_cache_shm_init( size_t size ) {
+  ASSERT_RUN_ONCE();
+#ifdef WITH_PARA_CACHE_SHM
+  size_t const sets =
+    size / (PARA_CACHE_SHM_SHARDS * PARA_CACHE_SHM_WAYS) /
+    sizeof( para_cache_shm_slot_t );
+  if ( sets == 0 )
+    return;
+  size_t const shards_size =
+    PARA_CACHE_SHM_SHARDS * sizeof( para_cache_shm_shard_t );
+  void *const map = mmap(
+    NULL,
+    shards_size + PARA_CACHE_SHM_SHARDS * PARA_CACHE_SHM_WAYS * sets *
+      sizeof( para_cache_shm_slot_t ),
+    PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_SHARED, -1, 0
+  );
+  if ( map == MAP_FAILED )              // only an optimization
+    return;
+  shm_shards = map;
+  for ( size_t i = 0; i < PARA_CACHE_SHM_SHARDS; ++i )
+    atomic_flag_clear( &shm_shards[i].lock );
+  shm_slots = POINTER_CAST( para_cache_shm_slot_t*,
+    POINTER_CAST( char*, map ) + shards_size
+  );
+  shm_sets = sets;
+#else
+  (void)size;
+#endif /* WITH_PARA_CACHE_SHM */
+}
+
+para_cache_stats_t para_cache_stats( void ) {
+  return cache_stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,154 @@
+/*
+**      wrap -- text reformatter
+**      src/para_cache.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_para_cache_H
+#define wrap_para_cache_H
+
+/**
+ * @file
+ * Declares functions for an on-disk cache of reformatted paragraphs.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint64_t */
+
+/// @endcond
+
+/**
+ * @defgroup para-cache-group Paragraph Cache
+ * Functions for an on-disk cache of reformatted paragraphs so that, when the
+ * same text is reformatted again with the same options, paragraphs that
+ * haven't changed can be copied from the cache rather than reformatted.
+ *
+ * @remarks The cache is a single file, by default `para` in the `wrap`
+ * subdirectory of either `$XDG_CACHE_HOME` or `$HOME/.cache`, that's memory-
+ * mapped when possible.  Each paragraph is keyed on the hash of its text
+ * seeded with the hash of the options.  Since two paragraphs can hash the
+ * same, the text is also stored in the file and compared.  It's only an
+ * optimization: if the file can't be read or is corrupt, every paragraph is
+ * reformatted as usual; if it can't be written, it's silently not.
+ *
+ * @remarks A server (see server_main()) can additionally share paragraphs
+ * among all of its workers via a cache of fixed size in shared memory created
+ * by para_cache_shm_init() before forking any.  It's split into shards, each
+ * having its own lock, that are split into sets of a few slots of fixed size.
+ * A paragraph can be cached only in the set its key maps to, evicting the
+ * least recently used one of the set if none is free.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Default size of the shared cache.
+ *
+ * @sa para_cache_shm_init()
+ */
+#define PARA_CACHE_SHM_SIZE_DEFAULT (16 * 1024 * 1024)
+
+/**
+ * Statistics of the paragraph cache.
+ */
+struct para_cache_stats {
+  uint64_t  hits;                       ///< Paragraphs found.
+  uint64_t  misses;                     ///< Paragraphs not found.
+  uint64_t  evictions;                  ///< Shared paragraphs evicted.
+};
+typedef struct para_cache_stats para_cache_stats_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the cached reformatted output of a paragraph, if any.
+ *
+ * @param in The text of the paragraph as read.
+ * @param in_len The length of \a in.
+ * @param pout_len A pointer to receive the length of the output.
+ * @return Returns a pointer to the output (that's valid until the next call
+ * of either this function or para_cache_put()) or NULL if none.
+ *
+ * @sa para_cache_put()
+ */
+NODISCARD
+char const* para_cache_get( char const *in, size_t in_len, size_t *pout_len );
+
+/**
+ * Gets the number of bytes of heap memory used by the paragraph cache,
+ * including the cache file's contents unless it was memory-mapped.
+ *
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t para_cache_mem( void );
+
+/**
+ * Opens the paragraph cache.  Paragraphs added via para_cache_put() are
+ * written to it upon exit.
+ *
+ * @param path The path of the cache file or `""` for the default.
+ * @param options_hash The hash of the options that affect reformatting.
+ *
+ * @sa options_hash()
+ */
+void para_cache_open( char const *path, uint64_t options_hash );
+
+/**
+ * Adds the reformatted output of a paragraph to the cache.
+ *
+ * @param in The text of the paragraph as read.
+ * @param in_len The length of \a in.
+ * @param out The reformatted output of \a in.
+ * @param out_len The length of \a out.
+ *
+ * @sa para_cache_get()
+ */
+void para_cache_put( char const *in, size_t in_len, char const *out,
+                     size_t out_len );
+
+/**
+ * Creates the cache shared by all processes forked after this is called.  If
+ * it can't be created, paragraphs are silently not shared.
+ *
+ * @param size The size of the cache in bytes or 0 for none.
+ *
+ * @sa #PARA_CACHE_SHM_SIZE_DEFAULT
+ */
+void para_cache_shm_init( size_t size );
+
+/**
+ * Gets the statistics of the paragraph cache for this process.
+ *
+ * @return Returns said statistics.
+ */
+NODISCARD
+para_cache_stats_t para_cache_stats( void );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_para_cache_H */
+/* vim:set et sw=2 ts=2: */
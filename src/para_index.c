@@ -0,0 +1,209 @@
+/*
+**      wrap -- text reformatter
+**      src/para_index.c
+**
+**      Copyright (C) 2026  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for an on-disk index of the paragraph boundaries of a
+ * file.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "para_index.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <fcntl.h>                      /* for open(2) */
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t, uint64_t */
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>                   /* for fstat(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for close(2), pread(2) */
+
+/// @endcond
+
+/**
+ * @addtogroup para-index-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Byte-order mark of an index file: if it's anything else, the file was
+ * written on a machine of the other endianness and isn't used.
+ */
+#define PARA_INDEX_BOM            0x01020304u
+
+/**
+ * Magic number of an index file.
+ */
+#define PARA_INDEX_MAGIC          "WRAPINDX"
+
+/**
+ * Version of the format of index files.
+ */
+#define PARA_INDEX_VERSION        1u
+
+/**
+ * The header of an index file.  It's followed by a \ref para_index_entry for
+ * each paragraph boundary in ascending order.
+ *
+ * All integers are in the byte order of the machine that wrote the file.
+ */
+struct para_index_header {
+  char      magic[8];                   ///< #PARA_INDEX_MAGIC (no null).
+  uint32_t  bom;                        ///< #PARA_INDEX_BOM.
+  uint32_t  version;                    ///< #PARA_INDEX_VERSION.
+  uint64_t  size;                       ///< Size of the indexed file.
+  uint64_t  mtime;                      ///< Modification time of it.
+};
+typedef struct para_index_header para_index_header_t;
+
+/**
+ * A paragraph boundary in an index file.
+ */
+struct para_index_entry {
+  uint64_t  offset;                     ///< Byte offset.
+  uint64_t  line_no;                    ///< Line number.
+};
+typedef struct para_index_entry para_index_entry_t;
+
+static_assert(
+  sizeof( para_index_header_t ) == 32, "para_index_header_t must be packed"
+);
+static_assert(
+  sizeof( para_index_entry_t ) == 16, "para_index_entry_t must be packed"
+);
+
+// local functions
+NODISCARD
+static bool para_index_read( int, size_t, para_index_entry_t* );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Reads an entry of an index file.
+ *
+ * @param fd The file descriptor of the index file.
+ * @param i The index of the entry to read.
+ * @param entry A pointer to the \ref para_index_entry to read into.
+ * @return Returns `true` only if the entry was read.
+ */
+static bool para_index_read( int fd, size_t i, para_index_entry_t *entry ) {
+  assert( entry != NULL );
+  off_t const offset = STATIC_CAST( off_t,
+    sizeof( para_index_header_t ) + i * sizeof( para_index_entry_t )
+  );
+  return pread( fd, entry, sizeof *entry, offset ) ==
+         STATIC_CAST( ssize_t, sizeof *entry );
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void para_index_add( FILE *findex, size_t offset, size_t line_no ) {
+  assert( findex != NULL );
+  para_index_entry_t const entry = { .offset = offset, .line_no = line_no };
+  PERROR_EXIT_IF( fwrite( &entry, sizeof entry, 1, findex ) != 1, EX_IOERR );
+}
+
+void para_index_close( FILE *findex ) {
+  assert( findex != NULL );
+  PERROR_EXIT_IF( fclose( findex ) != 0, EX_IOERR );
+}
+
+FILE* para_index_create( char const *path, uint64_t size, uint64_t mtime ) {
+  assert( path != NULL );
+  FILE *const findex = fopen( path, "wb" );
+  if ( findex == NULL )
+    fatal_error( EX_CANTCREAT, "\"%s\": %s\n", path, STRERROR() );
+  para_index_header_t header = {
+    .bom = PARA_INDEX_BOM,
+    .version = PARA_INDEX_VERSION,
+    .size = size,
+    .mtime = mtime
+  };
+  memcpy( header.magic, PARA_INDEX_MAGIC, sizeof header.magic );
+  PERROR_EXIT_IF( fwrite( &header, sizeof header, 1, findex ) != 1, EX_IOERR );
+  return findex;
+}
+
+size_t para_index_find( char const *path, uint64_t size, uint64_t mtime,
+                        size_t line_no, size_t *poffset ) {
+  assert( path != NULL );
+  assert( poffset != NULL );
+
+  *poffset = 0;
+  int const fd = open( path, O_RDONLY );
+  if ( fd == -1 )
+    return 1;
+
+  struct stat st;
+  para_index_header_t header;
+  if ( fstat( fd, &st ) == -1 ||
+       STATIC_CAST( size_t, st.st_size ) < sizeof header ||
+       pread( fd, &header, sizeof header, 0 ) !=
+         STATIC_CAST( ssize_t, sizeof header ) ||
+       memcmp( header.magic, PARA_INDEX_MAGIC, sizeof header.magic ) != 0 ||
+       header.bom != PARA_INDEX_BOM ||
+       header.version != PARA_INDEX_VERSION ||
+       header.size != size || header.mtime != mtime ) {
+    close( fd );
+    return 1;
+  }
+
+  //
+  // Binary search for the last entry whose line number is <= line_no.
+  //
+  size_t lo = 0;
+  size_t hi = (STATIC_CAST( size_t, st.st_size ) - sizeof header) /
+              sizeof( para_index_entry_t );
+  para_index_entry_t found = { .offset = 0, .line_no = 1 };
+  while ( lo < hi ) {
+    size_t const mid = lo + (hi - lo) / 2;
+    para_index_entry_t entry;
+    if ( !para_index_read( fd, mid, &entry ) )
+      break;
+    if ( entry.line_no <= line_no ) {
+      found = entry;
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  } // while
+  close( fd );
+
+  if ( found.offset > size )            // corrupt
+    return 1;
+  *poffset = STATIC_CAST( size_t, found.offset );
+  return STATIC_CAST( size_t, found.line_no );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,109 @@
+/*
+**      wrap -- text reformatter
+**      src/para_index.h
+**
+**      Copyright (C) 2026  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_para_index_H
+#define wrap_para_index_H
+
+/**
+ * @file
+ * Declares functions for an on-disk index of the paragraph boundaries of a
+ * file.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint64_t */
+#include <stdio.h>                      /* for FILE */
+
+/// @endcond
+
+/**
+ * @defgroup para-index-group Paragraph Index
+ * Functions for an on-disk index of the paragraph boundaries of a file so
+ * that reformatting only a range of lines of a huge file can seek straight to
+ * the last boundary before the range rather than scan every line before it.
+ *
+ * @remarks An index is a header identifying the file it was written for by
+ * its size and modification time followed by a record of the byte offset and
+ * line number of each boundary in ascending order.  Records are of fixed size
+ * so a boundary is found via a binary search of only a few of them.  It's
+ * only an optimization: if the file can't be read, is corrupt, or was written
+ * for a different file, it's not used.
+ * @{
+ */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Adds a paragraph boundary to an index.
+ *
+ * @param findex The index gotten from para_index_create().
+ * @param offset The byte offset of the boundary.  It must be greater than that
+ * of the previous boundary added.
+ * @param line_no The line number of the boundary where the first line is 1.
+ */
+void para_index_add( FILE *findex, size_t offset, size_t line_no );
+
+/**
+ * Closes an index.
+ *
+ * @param findex The index gotten from para_index_create().
+ */
+void para_index_close( FILE *findex );
+
+/**
+ * Creates an index.  Exits on error.
+ *
+ * @param path The path of the index file.
+ * @param size The size of the file to index.
+ * @param mtime The modification time of the file to index.
+ * @return Returns the index to add boundaries to via para_index_add().
+ *
+ * @sa para_index_close()
+ */
+NODISCARD
+FILE* para_index_create( char const *path, uint64_t size, uint64_t mtime );
+
+/**
+ * Finds the last paragraph boundary at or before a line in an index.
+ *
+ * @param path The path of the index file.
+ * @param size The size of the indexed file.
+ * @param mtime The modification time of the indexed file.
+ * @param line_no The number of the line to find the boundary for.
+ * @param poffset A pointer to receive the byte offset of the boundary.
+ * @return Returns the line number of the boundary or 1 (with \a *poffset set
+ * to 0) if there is none or the index wasn't written for this file.
+ */
+NODISCARD
+size_t para_index_find( char const *path, uint64_t size, uint64_t mtime,
+                        size_t line_no, size_t *poffset );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_para_index_H */
+/* vim:set et sw=2 ts=2: */
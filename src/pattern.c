@@ -33,8 +33,10 @@
 
 // standard
 #include <assert.h>
+#include <stdbool.h>
 #include <fnmatch.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -48,6 +50,16 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * A slot of \ref pattern_table.
+ */
+struct pattern_slot {
+  char const *key;                      ///< Literal file-name or suffix.
+  uint32_t    idx;                      ///< 1 + index of pattern or 0.
+  bool        is_suffix;                ///< Is \a key a `*.ext` suffix?
+};
+typedef struct pattern_slot pattern_slot_t;
+
 // local constant definitions
 static size_t const PATTERN_ALLOC_DEFAULT   = 10;
 static size_t const PATTERN_ALLOC_INCREMENT = 10;
@@ -55,20 +67,32 @@ static size_t const PATTERN_ALLOC_INCREMENT = 10;
 // local variable definitions
 static size_t       n_patterns = 0;     // number of patterns
 static pattern_t   *patterns = NULL;    // global list of patterns
+static size_t       n_patterns_alloc;   // number of patterns allocated
+static bool         patterns_borrowed;  // set via pattern_set_list()?
 
-// local functions
-static void   pattern_cleanup( void );
-
-////////// inline functions ///////////////////////////////////////////////////
+/**
+ * Open-addressing hash table of the patterns that are either literal
+ * file-names or `*` followed by a literal suffix starting with `.`, e.g.,
+ * `Makefile` or `*.c`: only these can be matched without **fnmatch**(3).
+ *
+ * @sa pattern_globs
+ */
+static pattern_slot_t *pattern_table;
+static size_t       pattern_table_cap;  // capacity (a power of 2) or 0
 
 /**
- * Frees all memory used by a pattern.
+ * Indices of all other patterns, in order.
  *
- * @param pattern The pattern to free.
+ * @sa pattern_table
  */
-static inline void pattern_free( pattern_t *pattern ) {
-  FREE( pattern->pattern );
-}
+static uint32_t    *pattern_globs;
+static size_t       n_pattern_globs;
+
+static bool         patterns_compiled;  // pattern_compile() called?
+
+// local functions
+NODISCARD
+static pattern_slot_t* pattern_table_slot( char const*, bool );
 
 ////////// local functions ////////////////////////////////////////////////////
 
@@ -81,12 +105,10 @@ NODISCARD
 static pattern_t* pattern_alloc( void ) {
   RUN_ONCE ATEXIT( &pattern_cleanup );
 
-  static size_t n_patterns_alloc = 0;   // number of patterns allocated
-
   if ( n_patterns_alloc == 0 ) {
     n_patterns_alloc = PATTERN_ALLOC_DEFAULT;
     patterns = MALLOC( pattern_t, n_patterns_alloc );
-  } else if ( n_patterns > n_patterns_alloc ) {
+  } else if ( n_patterns >= n_patterns_alloc ) {
     n_patterns_alloc += PATTERN_ALLOC_INCREMENT;
     REALLOC( patterns, pattern_t, n_patterns_alloc );
   }
@@ -95,12 +117,76 @@ static pattern_t* pattern_alloc( void ) {
 }
 
 /**
- * Cleans-up all pattern data.
+ * Compiles all patterns into \ref pattern_table and \ref pattern_globs.
+ */
+static void pattern_compile( void ) {
+  patterns_compiled = true;
+  if ( n_patterns == 0 )
+    return;
+
+  pattern_table_cap = 16;
+  while ( pattern_table_cap < n_patterns * 2 )
+    pattern_table_cap *= 2;
+  pattern_table = check_realloc( NULL,
+    pattern_table_cap * sizeof( pattern_slot_t )
+  );
+  memset( pattern_table, 0, pattern_table_cap * sizeof( pattern_slot_t ) );
+  pattern_globs = MALLOC( uint32_t, n_patterns );
+
+  for ( size_t i = 0; i < n_patterns; ++i ) {
+    char const *key = patterns[i].pattern;
+    bool const is_suffix = key[0] == '*' && key[1] == '.';
+    if ( is_suffix )
+      ++key;
+    if ( key[ strcspn( key, "*?[\\" ) ] != '\0' ) {
+      pattern_globs[ n_pattern_globs++ ] = STATIC_CAST( uint32_t, i );
+      continue;
+    }
+    pattern_slot_t *const slot = pattern_table_slot( key, is_suffix );
+    if ( slot->idx == 0 ) {             // else earlier pattern wins
+      slot->key = key;
+      slot->idx = STATIC_CAST( uint32_t, i + 1 );
+      slot->is_suffix = is_suffix;
+    }
+  } // for
+}
+
+/**
+ * Gets the index of the pattern in \ref pattern_table for \a key, if any.
+ *
+ * @param key The literal file-name or suffix to look up.
+ * @param is_suffix Is \a key a suffix?
+ * @return Returns said index or \ref n_patterns if none.
  */
-static void pattern_cleanup( void ) {
-  while ( n_patterns > 0 )
-    pattern_free( &patterns[ --n_patterns ] );
-  free( patterns );
+NODISCARD
+static size_t pattern_table_find( char const *key, bool is_suffix ) {
+  if ( pattern_table_cap == 0 )
+    return n_patterns;
+  pattern_slot_t const *const slot = pattern_table_slot( key, is_suffix );
+  return slot->idx == 0 ? n_patterns : slot->idx - 1;
+}
+
+/**
+ * Gets the \ref pattern_table slot for \a key.
+ *
+ * @param key The literal file-name or suffix.
+ * @param is_suffix Is \a key a suffix?
+ * @return Returns a pointer to either the slot for \a key or the empty slot
+ * where it would go.
+ */
+NODISCARD
+static pattern_slot_t* pattern_table_slot( char const *key, bool is_suffix ) {
+  assert( key != NULL );
+  assert( pattern_table_cap > 0 );
+  size_t const mask = pattern_table_cap - 1;
+  for ( size_t i = (str_hash( key ) ^ is_suffix) & mask; ;
+        i = (i + 1) & mask ) {
+    pattern_slot_t *const slot = &pattern_table[i];
+    if ( slot->idx == 0 ||
+         (slot->is_suffix == is_suffix && strcmp( slot->key, key ) == 0) ) {
+      return slot;
+    }
+  } // for
 }
 
 ////////// extern functions ///////////////////////////////////////////////////
@@ -116,12 +202,62 @@ void dump_patterns( void ) {
 }
 #endif /* NDEBUG */
 
+void pattern_cleanup( void ) {
+  // The patterns themselves were allocated via arena_alloc().
+  if ( !patterns_borrowed )
+    free( patterns );
+  n_patterns = 0;
+  patterns = NULL;
+  n_patterns_alloc = 0;
+  patterns_borrowed = false;
+  FREE( pattern_globs );
+  pattern_globs = NULL;
+  n_pattern_globs = 0;
+  FREE( pattern_table );
+  pattern_table = NULL;
+  pattern_table_cap = 0;
+  patterns_compiled = false;
+}
+
 alias_t const* pattern_find( char const *file_name ) {
   assert( file_name != NULL );
-  for ( size_t i = 0; i < n_patterns; ++i )
-    if ( fnmatch( patterns[i].pattern, file_name, 0 ) == 0 )
-      return patterns[i].alias;
-  return NULL;
+  if ( !patterns_compiled )
+    pattern_compile();
+
+  //
+  // The first pattern that matches wins, so find the earliest literal match,
+  // if any, then try only the globs before it.
+  //
+  size_t best = pattern_table_find( file_name, /*is_suffix=*/false );
+  for ( char const *dot = strchr( file_name, '.' ); dot != NULL;
+        dot = strchr( dot + 1, '.' ) ) {
+    size_t const i = pattern_table_find( dot, /*is_suffix=*/true );
+    if ( i < best )
+      best = i;
+  } // for
+  for ( size_t g = 0; g < n_pattern_globs && pattern_globs[g] < best; ++g ) {
+    if ( fnmatch( patterns[ pattern_globs[g] ].pattern, file_name, 0 ) == 0 ) {
+      best = pattern_globs[g];
+      break;
+    }
+  } // for
+
+  return best < n_patterns ? patterns[ best ].alias : NULL;
+}
+
+pattern_t const* pattern_list( size_t *n ) {
+  assert( n != NULL );
+  *n = n_patterns;
+  return patterns;
+}
+
+size_t pattern_mem( void ) {
+  size_t size = pattern_table_cap * sizeof( pattern_slot_t );
+  if ( pattern_globs != NULL )
+    size += n_patterns * sizeof( uint32_t );
+  if ( !patterns_borrowed )
+    size += n_patterns_alloc * sizeof( pattern_t );
+  return size;
 }
 
 void pattern_parse( char const *line, char const *conf_file,
@@ -129,6 +265,7 @@ void pattern_parse( char const *line, char const *conf_file,
   assert( line != NULL );
   assert( conf_file != NULL );
   assert( line_no > 0 );
+  assert( !patterns_compiled );
 
   pattern_t *const pattern = pattern_alloc();
 
@@ -137,7 +274,7 @@ void pattern_parse( char const *line, char const *conf_file,
 
   // part 1: pattern
   size_t const span = strcspn( line, " \t=" );
-  pattern->pattern = strndup( line, span );
+  pattern->pattern = arena_strndup( line, span );
   line += span;
 
   // part 2: whitespace
@@ -173,6 +310,15 @@ void pattern_parse( char const *line, char const *conf_file,
   pattern->alias = alias;
 }
 
+void pattern_set_list( pattern_t *list, size_t n ) {
+  assert( list != NULL || n == 0 );
+  assert( n_patterns == 0 );
+  RUN_ONCE ATEXIT( &pattern_cleanup );
+  patterns = list;
+  patterns_borrowed = true;
+  n_patterns = n;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
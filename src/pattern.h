@@ -31,6 +31,13 @@
 #include "pjl_config.h"                 /* must go first */
 #include "alias.h"
 
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
 /**
  * @ingroup config-file-group
  * @defgroup patterns-group Filename Patterns
@@ -61,6 +68,11 @@ typedef struct pattern pattern_t;
 void dump_patterns( void );
 #endif /* NDEBUG */
 
+/**
+ * Frees all patterns so that those of another configuration file may be read.
+ */
+void pattern_cleanup( void );
+
 /**
  * Attempts to find a pattern from the internal list of patterns that matches
  * the given file-name and return the \ref alias associated with that pattern.
@@ -72,6 +84,26 @@ void dump_patterns( void );
 NODISCARD
 alias_t const* pattern_find( char const *file_name );
 
+/**
+ * Gets the internal list of patterns.
+ *
+ * @param n Set to the number of patterns.
+ * @return Returns said list.
+ *
+ * @sa pattern_set_list()
+ */
+NODISCARD
+pattern_t const* pattern_list( size_t *n );
+
+/**
+ * Gets the number of bytes of heap memory used by the internal list of
+ * patterns, but not by those borrowed via pattern_set_list().
+ *
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t pattern_mem( void );
+
 /**
  * Parses a pattern from the given line and adds it to the internal list of
  * patterns.
@@ -82,6 +114,17 @@ alias_t const* pattern_find( char const *file_name );
  */
 void pattern_parse( char const *line, char const *conf_file, unsigned line_no );
 
+/**
+ * Sets the internal list of patterns to \a list rather than parsing them.
+ *
+ * @param list The list of patterns.  It and everything it points to are
+ * borrowed: they must remain valid until exit and aren't freed.
+ * @param n The number of patterns in \a list.
+ *
+ * @sa pattern_list()
+ */
+void pattern_set_list( pattern_t *list, size_t n );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
@@ -55,6 +55,12 @@
 
 #ifdef HAVE___ATTRIBUTE__
 
+/**
+ * Denote that a function must always be inlined, e.g., so that it's
+ * specialized for each constant argument it's called with.
+ */
+#define PJL_ALWAYS_INLINE         __attribute__((always_inline))
+
 /**
  * Denote a function declaration takes a `printf`-like format string followed
  * by a variable number of arguments.
@@ -79,6 +85,10 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifndef PJL_ALWAYS_INLINE
+#define PJL_ALWAYS_INLINE         /* nothing */
+#endif /* PJL_ALWAYS_INLINE */
+
 #ifndef PJL_DISCARD_RV
 #define PJL_DISCARD_RV(FN_CALL)   ((void)(FN_CALL))
 #endif /* PJL_DISCARD_RV */
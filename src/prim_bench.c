@@ -0,0 +1,553 @@
+/*
+**      wrap -- text reformatter
+**      src/prim_bench.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Microbenchmarks the character and line primitives of unicode.h and util.h
+ * that wrap and wrapc call for (nearly) every byte or line of input, over
+ * generated text with realistic distributions of characters.  Each primitive
+ * is run over the whole text several times and the mean time per operation is
+ * printed along with its standard deviation and the minimum so that results
+ * can be compared across runs and builds.  An operation is on a character, a
+ * byte, or a line, whichever the primitive takes.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "reader.h"
+#include "unicode.h"
+#include "util.h"
+
+// standard
+#include <assert.h>
+#include <math.h>                       /* for sqrt(3) */
+#include <stdbool.h>
+#include <stdint.h>                     /* for uint32_t, uint64_t */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sysexits.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A kind of generated text to benchmark over.
+ */
+struct bench_corpus {
+  char const         *name;             ///< Name of the corpus.
+  char const *const  *words;            ///< Words to generate lines from.
+};
+typedef struct bench_corpus bench_corpus_t;
+
+/**
+ * Generated text in the forms the primitives take it.
+ */
+struct bench_text {
+  char       *buf;                      ///< All lines, newline-terminated.
+  size_t      len;                      ///< Length of \a buf.
+  char32_t   *cps;                      ///< Code-points of \a buf.
+  size_t      cps_len;                  ///< Number of code-points.
+  char       *lines;                    ///< Null-terminated lines with EOLs.
+  char       *chopped;                  ///< Null-terminated lines sans EOLs.
+  size_t      lines_len;                ///< Number of lines.
+  FILE       *file;                     ///< Temporary file of \a buf.
+};
+typedef struct bench_text bench_text_t;
+
+/**
+ * The signature for a function that runs a primitive over the whole of a
+ * \ref bench_text once.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into so that calls can't
+ * be optimized away.
+ * @return Returns the number of operations performed.
+ */
+typedef size_t (*bench_fn_t)( bench_text_t*, uint64_t *sink );
+
+/**
+ * A primitive to benchmark.
+ */
+struct bench_prim {
+  char const *name;                     ///< Name to report.
+  char const *op;                       ///< What an operation is done on.
+  bench_fn_t  fn;                       ///< Function that runs it.
+};
+typedef struct bench_prim bench_prim_t;
+
+// local constant definitions
+static unsigned const BENCH_LINE_LEN = 72;
+static unsigned const BENCH_RUNS_DEFAULT = 10;
+static unsigned const BENCH_SIZE_DEFAULT = 1024;  ///< In KB.
+
+/// Mostly ASCII prose with the punctuation and hyphens wrap looks for.
+static char const *const BENCH_ASCII_WORDS[] = {
+  "the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog.",
+  "It's", "well-known", "that", "text", "reformatting", "is", "hard!", "See",
+  "section", "3.4:", "(aside)", "and", "re-wrap", "e.g.,", "paragraphs", "a",
+  "of", "to", "in", "is", "it", "\"quoted.\"", "Why?", "--", "x-ray",
+  NULL
+};
+
+/// Western European text: mostly ASCII with some two-byte characters.
+static char const *const BENCH_LATIN_WORDS[] = {
+  "naïve", "café", "Straße", "façade", "résumé", "Ångström", "über", "der",
+  "die", "und", "le", "la", "et", "très", "élève", "garçon", "año", "niño",
+  "¿qué?", "¡sí!", "l'été", "Müller-Lüdenscheidt", "«quoted»", "fin.",
+  NULL
+};
+
+/// CJK text: almost all three-byte characters.
+static char const *const BENCH_CJK_WORDS[] = {
+  "日本語の", "文章を", "折り返す。", "中文", "文本", "段落、", "テキスト",
+  "「引用」", "한국어", "문장", "입니다.", "です。", "何？", "はい！",
+  NULL
+};
+
+/// Mixed scripts with emoji (four-byte characters).
+static char const *const BENCH_MIXED_WORDS[] = {
+  "Добрый", "день,", "мир!", "ελληνικά", "λέξη.", "עברית", "—", "and",
+  "the", "emoji🙂", "🎉", "👍🏽", "rocket🚀.", "日本", "naïve", "x‐y",
+  "soft\xC2\xADhyphen", "text", "…", "end.",
+  NULL
+};
+
+/// The corpora to benchmark over.
+static bench_corpus_t const BENCH_CORPORA[] = {
+  { "ASCII",  BENCH_ASCII_WORDS },
+  { "Latin",  BENCH_LATIN_WORDS },
+  { "CJK",    BENCH_CJK_WORDS   },
+  { "mixed",  BENCH_MIXED_WORDS },
+};
+
+/// Where results are stored so that runs can't be optimized away.
+static uint64_t volatile bench_sink;
+
+// extern variable definitions
+char const       *me;                   ///< Program name.
+
+// local functions
+static size_t bench_chop_eol( bench_text_t*, uint64_t* );
+static size_t bench_cp_is_eos( bench_text_t*, uint64_t* );
+static size_t bench_cp_is_hyphen( bench_text_t*, uint64_t* );
+static size_t bench_cp_is_hyphen_adjacent( bench_text_t*, uint64_t* );
+static size_t bench_fgetsz( bench_text_t*, uint64_t* );
+
+NODISCARD
+static unsigned bench_rand( void );
+
+static void bench_run( bench_corpus_t const*, bench_prim_t const*,
+                       bench_text_t*, unsigned );
+
+static size_t bench_split_tws( bench_text_t*, uint64_t* );
+static size_t bench_strrspn( bench_text_t*, uint64_t* );
+static void bench_text_free( bench_text_t* );
+
+NODISCARD
+static bench_text_t bench_text_gen( bench_corpus_t const*, size_t );
+
+static size_t bench_utf8_decode( bench_text_t*, uint64_t* );
+static size_t bench_utf8_len( bench_text_t*, uint64_t* );
+static size_t bench_utf8_rsync( bench_text_t*, uint64_t* );
+
+_Noreturn
+static void usage( void );
+
+/// The primitives to benchmark.
+static bench_prim_t const BENCH_PRIMS[] = {
+  { "utf8_decode",            "char", &bench_utf8_decode            },
+  { "utf8_len",               "char", &bench_utf8_len               },
+  { "utf8_rsync",             "byte", &bench_utf8_rsync             },
+  { "cp_is_eos",              "char", &bench_cp_is_eos              },
+  { "cp_is_hyphen",           "char", &bench_cp_is_hyphen           },
+  { "cp_is_hyphen_adjacent",  "char", &bench_cp_is_hyphen_adjacent  },
+  { "fgetsz",                 "line", &bench_fgetsz                 },
+  { "strrspn",                "line", &bench_strrspn                },
+  { "split_tws",              "line", &bench_split_tws              },
+  { "chop_eol",               "line", &bench_chop_eol               },
+};
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Runs chop_eol() over every line that has an end-of-line, then puts the
+ * end-of-line back.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of lines.
+ */
+static size_t bench_chop_eol( bench_text_t *text, uint64_t *sink ) {
+  char *line = text->lines;
+  for ( size_t i = 0; i < text->lines_len; ++i ) {
+    size_t const len = strlen( line );
+    size_t const chopped_len = chop_eol( line, len );
+    *sink += chopped_len;
+    if ( chopped_len < len )
+      line[ chopped_len ] = chopped_len + 1 < len ? '\r' : '\n';
+    line += len + 1;
+  } // for
+  return text->lines_len;
+}
+
+/**
+ * Runs cp_is_eos() over every code-point.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of code-points.
+ */
+static size_t bench_cp_is_eos( bench_text_t *text, uint64_t *sink ) {
+  for ( size_t i = 0; i < text->cps_len; ++i )
+    *sink += cp_is_eos( text->cps[i] );
+  return text->cps_len;
+}
+
+/**
+ * Runs cp_is_hyphen() over every code-point.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of code-points.
+ */
+static size_t bench_cp_is_hyphen( bench_text_t *text, uint64_t *sink ) {
+  for ( size_t i = 0; i < text->cps_len; ++i )
+    *sink += cp_is_hyphen( text->cps[i] );
+  return text->cps_len;
+}
+
+/**
+ * Runs cp_is_hyphen_adjacent() over every code-point.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of code-points.
+ */
+static size_t bench_cp_is_hyphen_adjacent( bench_text_t *text,
+                                           uint64_t *sink ) {
+  for ( size_t i = 0; i < text->cps_len; ++i )
+    *sink += cp_is_hyphen_adjacent( text->cps[i] );
+  return text->cps_len;
+}
+
+/**
+ * Reads every line of the text's temporary file via fgetsz().
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of lines read.
+ */
+static size_t bench_fgetsz( bench_text_t *text, uint64_t *sink ) {
+  rewind( text->file );
+  reader_forget( text->file );
+
+  char line[ 1024 ];
+  size_t lines = 0;
+  for ( size_t size = sizeof line; fgetsz( line, &size, text->file ) != NULL;
+        size = sizeof line ) {
+    *sink += size;
+    ++lines;
+  } // for
+  FERROR( text->file );
+  return lines;
+}
+
+/**
+ * Gets a pseudo-random number.  Unlike **rand**(3), the sequence is the same
+ * on every platform so the text is reproducible.
+ *
+ * @return Returns said number.
+ */
+static unsigned bench_rand( void ) {
+  static uint32_t state = 2463534242u;  // xorshift32
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+/**
+ * Runs a single primitive over \a text \a runs times (after one run to warm
+ * up caches) and prints the mean, standard deviation, and minimum time per
+ * operation.
+ *
+ * @param corpus The corpus \a text was generated from.
+ * @param prim The primitive to run.
+ * @param text The \ref bench_text to run over.
+ * @param runs The number of timed runs.
+ */
+static void bench_run( bench_corpus_t const *corpus, bench_prim_t const *prim,
+                       bench_text_t *text, unsigned runs ) {
+  uint64_t sink = 0;
+  PJL_DISCARD_RV( (*prim->fn)( text, &sink ) );
+
+  double sum = 0, sum_sq = 0, min = 0;
+  for ( unsigned run = 0; run < runs; ++run ) {
+    uint64_t const start = now_ns();
+    size_t const ops = (*prim->fn)( text, &sink );
+    double const ns_op = (double)(now_ns() - start) / (double)ops;
+    sum += ns_op;
+    sum_sq += ns_op * ns_op;
+    if ( run == 0 || ns_op < min )
+      min = ns_op;
+  } // for
+
+  double const mean = sum / runs;
+  double const var = runs > 1 ?
+    (sum_sq - sum * mean) / (runs - 1) : 0;
+  double const sd = var > 0 ? sqrt( var ) : 0;
+  printf( "%-6s  %-22s  %8.3f ns/%s  ± %7.3f (%5.1f%%)  min %8.3f\n",
+    corpus->name, prim->name, mean, prim->op, sd,
+    mean > 0 ? sd / mean * 100 : 0.0, min
+  );
+  bench_sink = sink;
+}
+
+/**
+ * Runs split_tws() over every line without an end-of-line, then puts the
+ * trailing whitespace back.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of lines.
+ */
+static size_t bench_split_tws( bench_text_t *text, uint64_t *sink ) {
+  char tws[ 16 ];
+  char *line = text->chopped;
+  for ( size_t i = 0; i < text->lines_len; ++i ) {
+    size_t const len = strlen( line );
+    size_t const split_len = split_tws( line, len, tws );
+    *sink += split_len;
+    if ( split_len < len )
+      line[ split_len ] = tws[0];
+    line += len + 1;
+  } // for
+  return text->lines_len;
+}
+
+/**
+ * Runs strrspn() over every line without an end-of-line.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of lines.
+ */
+static size_t bench_strrspn( bench_text_t *text, uint64_t *sink ) {
+  char const *line = text->chopped;
+  for ( size_t i = 0; i < text->lines_len; ++i ) {
+    *sink += strrspn( line, WS_ST );
+    line += strlen( line ) + 1;
+  } // for
+  return text->lines_len;
+}
+
+/**
+ * Frees a \ref bench_text.
+ *
+ * @param text The \ref bench_text to free.
+ */
+static void bench_text_free( bench_text_t *text ) {
+  fclose( text->file );
+  FREE( text->buf );
+  FREE( text->chopped );
+  FREE( text->cps );
+  FREE( text->lines );
+}
+
+/**
+ * Generates text of lines, each about \ref BENCH_LINE_LEN bytes long.  About
+ * a quarter of the lines have trailing whitespace and about an eighth end in
+ * `\r\n` rather than `\n`.
+ *
+ * @param corpus The kind of corpus to generate.
+ * @param size The approximate number of bytes to generate.
+ * @return Returns said text that must be freed via bench_text_free().
+ */
+static bench_text_t bench_text_gen( bench_corpus_t const *corpus,
+                                    size_t size ) {
+  static char const *const LINE_ENDS[] = {
+    "", "", "", "", "", " ", "\t", "  \t "
+  };
+  assert( corpus != NULL );
+
+  size_t n_words = 0;
+  while ( corpus->words[ n_words ] != NULL )
+    ++n_words;
+
+  //
+  // A line is at most BENCH_LINE_LEN bytes plus the longest word plus its
+  // trailing whitespace and end-of-line; 256 per line is plenty.
+  //
+  size_t const lines_max = size / BENCH_LINE_LEN + 1;
+  bench_text_t text = {
+    .buf = MALLOC( char, lines_max * 256 + 1 ),
+    .lines = MALLOC( char, lines_max * 256 + 1 ),
+    .chopped = MALLOC( char, lines_max * 256 + 1 )
+  };
+  char *p = text.buf, *l = text.lines, *c = text.chopped;
+
+  while ( text.len < size ) {
+    char *const line_begin = p;
+    do {
+      if ( p > line_begin )
+        *p++ = ' ';
+      p += strcpy_len( p, corpus->words[ bench_rand() % n_words ] );
+    } while ( STATIC_CAST( size_t, p - line_begin ) < BENCH_LINE_LEN );
+    p += strcpy_len( p, LINE_ENDS[ bench_rand() % ARRAY_SIZE( LINE_ENDS ) ] );
+
+    size_t const chopped_len = STATIC_CAST( size_t, p - line_begin );
+    memcpy( c, line_begin, chopped_len );
+    c += chopped_len;
+    *c++ = '\0';
+
+    p += strcpy_len( p, bench_rand() % 8 == 0 ? "\r\n" : "\n" );
+    size_t const line_len = STATIC_CAST( size_t, p - line_begin );
+    memcpy( l, line_begin, line_len );
+    l += line_len;
+    *l++ = '\0';
+
+    text.len += line_len;
+    ++text.lines_len;
+  } // while
+  *p = '\0';
+
+  text.cps = MALLOC( char32_t, text.len );
+  for ( char const *s = text.buf; *s != '\0'; s += utf8_len( *s ) )
+    text.cps[ text.cps_len++ ] = utf8_decode( s );
+
+  text.file = tmpfile();
+  PERROR_EXIT_IF( text.file == NULL, EX_CANTCREAT );
+  PERROR_EXIT_IF( fwrite( text.buf, 1, text.len, text.file ) != text.len,
+                  EX_IOERR );
+  PERROR_EXIT_IF( fflush( text.file ) != 0, EX_IOERR );
+
+  return text;
+}
+
+/**
+ * Runs utf8_decode() over every character.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of characters.
+ */
+static size_t bench_utf8_decode( bench_text_t *text, uint64_t *sink ) {
+  size_t chars = 0;
+  for ( char const *s = text->buf; *s != '\0'; s += utf8_len( *s ) ) {
+    *sink += utf8_decode( s );
+    ++chars;
+  } // for
+  return chars;
+}
+
+/**
+ * Runs utf8_len() over every character.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of characters.
+ */
+static size_t bench_utf8_len( bench_text_t *text, uint64_t *sink ) {
+  size_t chars = 0;
+  for ( char const *s = text->buf; *s != '\0'; ++chars ) {
+    size_t const len = utf8_len( *s );
+    *sink += len;
+    s += len;
+  } // for
+  return chars;
+}
+
+/**
+ * Runs utf8_rsync() at every byte.
+ *
+ * @param text The \ref bench_text to run over.
+ * @param sink A pointer to a value to fold results into.
+ * @return Returns the number of bytes.
+ */
+static size_t bench_utf8_rsync( bench_text_t *text, uint64_t *sink ) {
+  for ( char const *s = text->buf; *s != '\0'; ++s )
+    *sink += STATIC_CAST( uint64_t, s - utf8_rsync( text->buf, s ) );
+  return text->len;
+}
+
+/**
+ * Prints the usage message and exits.
+ */
+static void usage( void ) {
+  EPRINTF( "usage: %s [-n runs] [-s size-KB] [primitive ...]\n", me );
+  exit( EX_USAGE );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  me = base_name( argv[0] );
+  unsigned runs = BENCH_RUNS_DEFAULT;
+  unsigned size_kb = BENCH_SIZE_DEFAULT;
+
+  int argi = 1;
+  for ( ; argi < argc && argv[ argi ][0] == '-'; argi += 2 ) {
+    if ( argi + 1 == argc )
+      usage();
+    if ( strcmp( argv[ argi ], "-n" ) == 0 )
+      runs = check_atou( argv[ argi + 1 ] );
+    else if ( strcmp( argv[ argi ], "-s" ) == 0 )
+      size_kb = check_atou( argv[ argi + 1 ] );
+    else
+      usage();
+  } // for
+  if ( runs == 0 || size_kb == 0 )
+    usage();
+
+  for ( int i = argi; i < argc; ++i ) {
+    size_t p = 0;
+    while ( p < ARRAY_SIZE( BENCH_PRIMS ) &&
+            strcmp( argv[i], BENCH_PRIMS[p].name ) != 0 ) {
+      ++p;
+    }
+    if ( p == ARRAY_SIZE( BENCH_PRIMS ) )
+      fatal_error( EX_USAGE, "\"%s\": no such primitive\n", argv[i] );
+  } // for
+
+  for ( size_t c = 0; c < ARRAY_SIZE( BENCH_CORPORA ); ++c ) {
+    bench_text_t text =
+      bench_text_gen( &BENCH_CORPORA[c], (size_t)size_kb * 1024 );
+    for ( size_t p = 0; p < ARRAY_SIZE( BENCH_PRIMS ); ++p ) {
+      bool run = argi == argc;
+      for ( int i = argi; !run && i < argc; ++i )
+        run = strcmp( argv[i], BENCH_PRIMS[p].name ) == 0;
+      if ( run )
+        bench_run( &BENCH_CORPORA[c], &BENCH_PRIMS[p], &text, runs );
+    } // for
+    bench_text_free( &text );
+  } // for
+
+  exit( EX_OK );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,116 @@
+/*
+**      wrap -- text reformatter
+**      src/probe.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_probe_H
+#define wrap_probe_H
+
+/**
+ * @file
+ * Declares macros for static tracing probes.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+#if defined(WITH_PROBES) && HAVE_SYS_SDT_H
+# include <sys/sdt.h>
+#endif
+
+/// @endcond
+
+/**
+ * @defgroup probe-group Static Tracing Probes
+ * Macros for USDT (DTrace-style) static probes at points on the hot path.
+ *
+ * @remarks When built with `configure --enable-probes`, each probe compiles
+ * to a single `nop` instruction plus a note in the ELF file that tools such
+ * as **bpftrace**(8) or **perf**(1) use to find it; the `nop` is replaced by
+ * a trap only while something is tracing it.  Otherwise, probes compile to
+ * nothing.
+ *
+ * All probes are in the `wrap` provider for both **wrap**(1) and
+ * **wrapc**(1):
+ *
+ * Probe           | Arguments
+ * ----------------|------------------------------------------------
+ * `line_read`     | length of the line read
+ * `para_delimit`  | none
+ * `line_emit`     | none
+ * `regex`         | `b` (block) or `u` (URI); whether it matched
+ * `md_push`       | \ref md_line; depth
+ * `md_pop`        | \ref md_line; depth
+ * `ipc_send`      | \ref wipc_code
+ * `ipc_recv`      | \ref wipc_code
+ *
+ * For example:
+ *
+ *      bpftrace -e 'usdt:./wrap:wrap:line_read { @ = hist(arg0); }'
+ * @{
+ */
+
+#if defined(WITH_PROBES) && HAVE_SYS_SDT_H
+
+/**
+ * Fires the static probe \a NAME having no arguments.
+ *
+ * @param NAME The name of the probe.
+ *
+ * @sa #PROBE1()
+ * @sa #PROBE2()
+ */
+#define PROBE(NAME)               DTRACE_PROBE( wrap, NAME )
+
+/**
+ * Fires the static probe \a NAME having one argument.
+ *
+ * @param NAME The name of the probe.
+ * @param A1 The argument.
+ *
+ * @sa #PROBE()
+ * @sa #PROBE2()
+ */
+#define PROBE1(NAME,A1)           DTRACE_PROBE1( wrap, NAME, (A1) )
+
+/**
+ * Fires the static probe \a NAME having two arguments.
+ *
+ * @param NAME The name of the probe.
+ * @param A1 The first argument.
+ * @param A2 The second argument.
+ *
+ * @sa #PROBE()
+ * @sa #PROBE1()
+ */
+#define PROBE2(NAME,A1,A2)        DTRACE_PROBE2( wrap, NAME, (A1), (A2) )
+
+#else
+# define PROBE(NAME)              ((void)0)
+# define PROBE1(NAME,A1)          ((void)0)
+# define PROBE2(NAME,A1,A2)       ((void)0)
+#endif /* WITH_PROBES && HAVE_SYS_SDT_H */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_probe_H */
+/* vim:set et sw=2 ts=2: */
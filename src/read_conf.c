@@ -27,6 +27,7 @@
 #include "pjl_config.h"                 /* must go first */
 #include "alias.h"
 #include "common.h"
+#include "conf_cache.h"
 #include "pattern.h"
 #include "util.h"
 
@@ -45,7 +46,8 @@
 #include <stdio.h>
 #include <stdlib.h>                     /* for getenv(), ... */
 #include <string.h>
-#include <unistd.h>                     /* for geteuid() */
+#include <sys/stat.h>                   /* for stat(2) */
+#include <unistd.h>                     /* for getcwd(), geteuid() */
 
 /// @endcond
 
@@ -56,6 +58,17 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * The configuration file directive to include another file.
+ */
+#define CONF_INCLUDE              "include"
+
+/**
+ * Maximum nesting depth of included files.  It's also what stops a file that
+ * includes itself (directly or indirectly).
+ */
+#define CONF_INCLUDE_DEPTH_MAX    8
+
 /** 
  * Configuration file section.
  */
@@ -66,6 +79,14 @@ enum section {
 };
 typedef enum section section_t;
 
+// local variable definitions
+static conf_source_t *conf_sources;     ///< Files parsed, read file first.
+static size_t         conf_sources_len; ///< Length of \ref conf_sources.
+
+// local functions
+static void           conf_parse( char const*, struct stat const*, FILE*,
+                                  unsigned );
+
 ////////// local functions ////////////////////////////////////////////////////
 
 /**
@@ -171,34 +192,167 @@ static char* trim_ws( char *s ) {
   return s;
 }
 
-////////// extern functions ///////////////////////////////////////////////////
+/**
+ * Finds the configuration file to read when none is given explicitly: the
+ * nearest #CONF_FILE_NAME_DEFAULT in the current directory or any of its
+ * parents short of the user's home directory or, if none, the one in the
+ * user's home directory.
+ *
+ * @return Returns the full path of said file or NULL if none.
+ */
+NODISCARD
+static char const* conf_find( void ) {
+  static char conf_path_buf[ PATH_MAX ];
+  char const *const home = home_dir();
+  struct stat st;
 
-char const* read_conf( char const *conf_file ) {
-  bool const is_explicit_conf_file = (conf_file != NULL);
+  if ( getcwd( conf_path_buf,
+               PATH_MAX - (sizeof CONF_FILE_NAME_DEFAULT + 1) ) != NULL ) {
+    while ( home == NULL || strcmp( conf_path_buf, home ) != 0 ) {
+      size_t const dir_len = strlen( conf_path_buf );
+      path_append( conf_path_buf, CONF_FILE_NAME_DEFAULT );
+      if ( stat( conf_path_buf, &st ) == 0 && S_ISREG( st.st_mode ) )
+        return conf_path_buf;
+      conf_path_buf[ dir_len ] = '\0';
+      char *const slash = strrchr( conf_path_buf, '/' );
+      if ( slash == NULL || dir_len == 1 )
+        break;                          // checked the root directory
+      slash[ slash == conf_path_buf ] = '\0';
+    } // while
+  }
 
-  section_t section = SECTION_NONE;     // section we're in
+  if ( home == NULL ||
+       strlen( home ) >= PATH_MAX - (sizeof CONF_FILE_NAME_DEFAULT + 1) ) {
+    return NULL;
+  }
+  strcpy( conf_path_buf, home );
+  path_append( conf_path_buf, CONF_FILE_NAME_DEFAULT );
+  return conf_path_buf;
+}
+
+/**
+ * Parses an `include` directive.
+ *
+ * @param line The trimmed line to parse.
+ * @return Returns a pointer within \a line to the name of the file to include
+ * (with any quotes removed) or NULL if \a line isn't an `include` directive
+ * (including a definition of an alias named `include`).
+ */
+NODISCARD
+static char* include_parse( char *line ) {
+  assert( line != NULL );
+  size_t const len = sizeof CONF_INCLUDE - 1;
+  if ( strncmp( line, CONF_INCLUDE, len ) != 0 || !isspace( line[ len ] ) )
+    return NULL;
+  char *file = line + len;
+  SKIP_CHARS( file, WS_STR );
+  if ( *file == '=' )
+    return NULL;
+  size_t const file_len = strlen( file );
+  if ( file_len >= 2 && (*file == '"' || *file == '\'') &&
+       file[ file_len - 1 ] == *file ) {
+    file[ file_len - 1 ] = '\0';
+    ++file;
+  }
+  return file;
+}
 
-  if ( !is_explicit_conf_file ) {       // no explicit conf file: use default
+/**
+ * Includes a configuration file.
+ *
+ * @param include_file The name of the file to include.  A relative path is
+ * relative to the directory of \a conf_file; a leading `~/` is the user's home
+ * directory.
+ * @param conf_file The configuration file containing the `include`.
+ * @param line_no The line-number within \a conf_file.
+ * @param depth The nesting depth of \a conf_file.
+ */
+static void conf_include( char const *include_file, char const *conf_file,
+                          unsigned line_no, unsigned depth ) {
+  assert( include_file != NULL );
+  assert( conf_file != NULL );
+
+  if ( *include_file == '\0' ) {
+    fatal_error( EX_CONFIG,
+      "%s:%u: " CONF_INCLUDE ": file name expected\n", conf_file, line_no
+    );
+  }
+  if ( depth >= CONF_INCLUDE_DEPTH_MAX ) {
+    fatal_error( EX_CONFIG,
+      "%s:%u: \"%s\": includes nested too deeply\n",
+      conf_file, line_no, include_file
+    );
+  }
+
+  char path_buf[ PATH_MAX ];
+  int len;
+  if ( include_file[0] == '~' && include_file[1] == '/' ) {
     char const *const home = home_dir();
-    if ( home == NULL )
-      return NULL;
-    static char conf_path_buf[ PATH_MAX ];
-    strcpy( conf_path_buf, home );
-    path_append( conf_path_buf, CONF_FILE_NAME_DEFAULT );
-    conf_file = conf_path_buf;
+    if ( home == NULL ) {
+      fatal_error( EX_CONFIG,
+        "%s:%u: \"%s\": home directory unknown\n",
+        conf_file, line_no, include_file
+      );
+    }
+    len = snprintf( path_buf, sizeof path_buf, "%s%s", home, include_file + 1 );
+  }
+  else if ( include_file[0] != '/' && strrchr( conf_file, '/' ) != NULL ) {
+    int const dir_len = STATIC_CAST( int,
+      strrchr( conf_file, '/' ) - conf_file + 1
+    );
+    len = snprintf( path_buf, sizeof path_buf, "%.*s%s",
+      dir_len, conf_file, include_file
+    );
+  }
+  else {
+    len = snprintf( path_buf, sizeof path_buf, "%s", include_file );
+  }
+  if ( len < 0 || STATIC_CAST( size_t, len ) >= sizeof path_buf ) {
+    fatal_error( EX_CONFIG,
+      "%s:%u: \"%s\": path too long\n", conf_file, line_no, include_file
+    );
   }
 
-  // open configuration file
-  FILE *const fconf = fopen( conf_file, "r" );
-  if ( fconf == NULL ) {
-    if ( is_explicit_conf_file )
-      fatal_error( EX_NOINPUT, "%s: %s\n", conf_file, STRERROR() );
-    return NULL;
+  struct stat include_st;
+  FILE *const finclude = stat( path_buf, &include_st ) == 0 ?
+    fopen( path_buf, "r" ) : NULL;
+  if ( finclude == NULL ) {
+    fatal_error( EX_CONFIG,
+      "%s:%u: \"%s\": %s\n", conf_file, line_no, path_buf, STRERROR()
+    );
   }
+  conf_parse(
+    arena_strndup( path_buf, STATIC_CAST( size_t, len ) ), &include_st,
+    finclude, depth + 1
+  );
+}
 
-  // parse configuration file
-  line_buf_t line_buf;
+/**
+ * Parses a configuration file and every file it includes.
+ *
+ * @param conf_file The path of the configuration file.
+ * @param conf_st The status of \a conf_file from just before it was opened.
+ * @param fconf The open \a conf_file.  It's closed.
+ * @param depth The nesting depth of \a conf_file: 0 for the file being read.
+ */
+static void conf_parse( char const *conf_file, struct stat const *conf_st,
+                        FILE *fconf, unsigned depth ) {
+  assert( conf_file != NULL );
+  assert( conf_st != NULL );
+  assert( fconf != NULL );
+
+  static size_t n_sources_alloc;
+  if ( conf_sources_len >= n_sources_alloc ) {
+    n_sources_alloc = n_sources_alloc == 0 ? 4 : n_sources_alloc * 2;
+    REALLOC( conf_sources, conf_source_t, n_sources_alloc );
+  }
+  conf_sources[ conf_sources_len++ ] =
+    (conf_source_t){ .path = conf_file, .st = *conf_st };
+
+  section_t section = SECTION_NONE;     // section we're in
+  char line_buf[ LINE_BUF_SIZE ];
   unsigned line_no = 0;
+
   while ( fgets( line_buf, sizeof line_buf, fconf ) != NULL ) {
     ++line_no;
     char *line = strip_comment( line_buf );
@@ -212,6 +366,13 @@ char const* read_conf( char const *conf_file ) {
     if ( *line == '\0' )                // line was entirely whitespace
       continue;
 
+    // parse include line
+    char const *const include_file = include_parse( line );
+    if ( include_file != NULL ) {
+      conf_include( include_file, conf_file, line_no, depth );
+      continue;
+    }
+
     // parse section line
     if ( line[0] == '[' ) {
       section = section_parse( line );
@@ -243,7 +404,43 @@ char const* read_conf( char const *conf_file ) {
   if ( unlikely( ferror( fconf ) ) )
     fatal_error( EX_IOERR, "%s: %s\n", conf_file, STRERROR() );
   fclose( fconf );
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+char const* read_conf( char const *conf_file ) {
+  bool const is_explicit_conf_file = (conf_file != NULL);
+
+  if ( !is_explicit_conf_file ) {       // no explicit conf file: find one
+    conf_file = conf_find();
+    if ( conf_file == NULL )
+      return NULL;
+  }
+
+  struct stat conf_st;
+  if ( stat( conf_file, &conf_st ) == -1 ) {
+    if ( is_explicit_conf_file )
+      fatal_error( EX_NOINPUT, "%s: %s\n", conf_file, STRERROR() );
+    return NULL;
+  }
+  if ( conf_cache_read( conf_file, &conf_st ) )
+    goto done;
+
+  // open configuration file
+  FILE *const fconf = fopen( conf_file, "r" );
+  if ( fconf == NULL ) {
+    if ( is_explicit_conf_file )
+      fatal_error( EX_NOINPUT, "%s: %s\n", conf_file, STRERROR() );
+    return NULL;
+  }
+
+  conf_parse( conf_file, &conf_st, fconf, /*depth=*/0 );
+  conf_cache_write( conf_sources, conf_sources_len );
+  FREE( conf_sources );
+  conf_sources = NULL;
+  conf_sources_len = 0;
 
+done:
 #ifndef NDEBUG
   if ( is_affirmative( getenv( "WRAP_DUMP_CONF" ) ) ) {
     dump_aliases();
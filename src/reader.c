@@ -0,0 +1,880 @@
+/*
+**      wrap -- text reformatter
+**      src/reader.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for reading lines from a file using large block reads
+ * rather than one character at a time.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "reader.h"
+#include "codec.h"
+#include "ring.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>                      /* for posix_fadvise(2) */
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for SIZE_MAX */
+#include <stdio.h>
+#include <string.h>                     /* for memchr(3), memmove(3) */
+#include <sys/stat.h>                   /* for fstat(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for lseek(2), read(2) */
+
+#if HAVE_SYS_SENDFILE_H
+# include <sys/sendfile.h>              /* for sendfile(2) */
+#endif /* HAVE_SYS_SENDFILE_H */
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+# include <sys/mman.h>                  /* for madvise(2), mmap(2) */
+# define WITH_READER_MMAP 1
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+
+/// @endcond
+
+/**
+ * @addtogroup reader-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maximum number of bytes to ask the kernel to copy per call of
+ * **copy_file_range**(2), **sendfile**(2), or **splice**(2).
+ */
+#define KERNEL_COPY_SIZE_MAX      (1024 * 1024 * 1024)
+
+/**
+ * Number of bytes of a memory-mapped file to have consumed before giving the
+ * pages back to the kernel via **madvise**(2) so that reading a huge file
+ * doesn't grow the resident set size to the size of the file.
+ */
+#define READER_RELEASE_SIZE       (4 * 1024 * 1024)
+
+/**
+ * Maximum number of distinct files that can be read from at the same time.
+ * Neither **wrap**(1) nor any **wrapc**(1) process reads from more than one.
+ */
+#define READERS_MAX               4
+
+/**
+ * Input buffer for a single file descriptor.
+ */
+struct reader {
+  int     fd;                           ///< File descriptor read from.
+  char   *buf;                          ///< Buffer; NULL = unused.
+  char   *pos;                          ///< Next unconsumed character.
+  char   *end;                          ///< One past the last valid character.
+  bool    eof;                          ///< Has EOF been reached?
+  bool    mapped;                       ///< Is \a buf a memory-mapped file?
+  eol_t   eol;                          ///< End-of-line of first newline.
+  bool    eol_cr;                       ///< Was last byte probed a `\r`?
+  char   *released;                     ///< One past last released character.
+  size_t  lines_left;                   ///< Lines left to get; SIZE_MAX = all.
+  decoder_t *decoder;                   ///< Decompressor, if any.
+  codec_t codec;                        ///< Codec of \a decoder, if any.
+  bool    sniffed;                      ///< Has \a codec been detected?
+#ifdef WITH_RING
+  ring_t *ring;                         ///< Read-ahead ring, if any.
+  char const *slot_pos;                 ///< Next character in acquired slot.
+  char const *slot_end;                 ///< One past last character in slot.
+  int     error;                        ///< `errno` of failed read, if any.
+                                        ///< (-1 = decompressing failed).
+#endif /* WITH_RING */
+};
+typedef struct reader reader_t;
+
+// local variable definitions
+static reader_t readers[ READERS_MAX ];
+
+// local functions
+NODISCARD
+static bool       fd_copy_kernel( int, int, size_t* );
+
+NODISCARD
+static size_t     fd_copy_user( int, int );
+
+NODISCARD
+static reader_t*  reader_find( FILE*, bool );
+
+#ifdef WITH_READER_MMAP
+NODISCARD
+static bool       reader_mmap( reader_t* );
+
+static void       reader_release( reader_t* );
+#endif /* WITH_READER_MMAP */
+
+static void       reader_eol_probe( reader_t*, char const*, size_t );
+
+_Noreturn
+static void       reader_error( reader_t const*, int );
+
+NODISCARD
+static size_t     reader_fill( reader_t* );
+
+NODISCARD
+static size_t     reader_sniff( reader_t* );
+
+#ifdef WITH_RING
+static void*      reader_thread_main( void* );
+#endif /* WITH_RING */
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Attempts to copy \a from_fd to \a to_fd until EOF entirely within the kernel
+ * via **splice**(2) (if either is a pipe), **copy_file_range**(2), or
+ * **sendfile**(2), whichever is available and works for the kinds of files
+ * involved.
+ * If copying fails after having started, prints an error message and exits.
+ *
+ * @param from_fd The file descriptor to copy from.
+ * @param to_fd The file descriptor to copy to.
+ * @param copied Incremented by the number of bytes copied.
+ * @return Returns `true` only if the copy was done; `false` if none of the
+ * kernel methods applies and the caller should copy via user space instead.
+ */
+static bool fd_copy_kernel( int from_fd, int to_fd, size_t *copied ) {
+  struct stat from_st, to_st;
+  if ( fstat( from_fd, &from_st ) == -1 || fstat( to_fd, &to_st ) == -1 )
+    return false;
+
+  ssize_t n;
+  bool started = false;
+
+#if HAVE_SPLICE && defined(SPLICE_F_MOVE)
+  if ( S_ISFIFO( from_st.st_mode ) || S_ISFIFO( to_st.st_mode ) ) {
+    while ( (n = splice( from_fd, NULL, to_fd, NULL, KERNEL_COPY_SIZE_MAX,
+                         SPLICE_F_MOVE )) != 0 ) {
+      if ( n > 0 ) {
+        *copied += STATIC_CAST( size_t, n );
+        started = true;
+      } else if ( errno != EINTR ) {
+        PERROR_EXIT_IF( started, EX_IOERR );
+        break;                          // try something else
+      }
+    } // while
+    if ( n == 0 )
+      return true;
+  }
+#endif /* HAVE_SPLICE && SPLICE_F_MOVE */
+
+  if ( !S_ISREG( from_st.st_mode ) )
+    return false;
+
+#if HAVE_COPY_FILE_RANGE
+  if ( S_ISREG( to_st.st_mode ) ) {
+    while ( (n = copy_file_range( from_fd, NULL, to_fd, NULL,
+                                  KERNEL_COPY_SIZE_MAX, 0 )) != 0 ) {
+      if ( n > 0 ) {
+        *copied += STATIC_CAST( size_t, n );
+        started = true;
+      } else if ( errno != EINTR ) {
+        PERROR_EXIT_IF( started, EX_IOERR );
+        break;                          // e.g., EXDEV: try something else
+      }
+    } // while
+    if ( n == 0 )
+      return true;
+  }
+#endif /* HAVE_COPY_FILE_RANGE */
+
+#if HAVE_SENDFILE && HAVE_SYS_SENDFILE_H
+  while ( (n = sendfile( to_fd, from_fd, NULL, KERNEL_COPY_SIZE_MAX )) != 0 ) {
+    if ( n > 0 ) {
+      *copied += STATIC_CAST( size_t, n );
+      started = true;
+    } else if ( errno != EINTR ) {
+      PERROR_EXIT_IF( started, EX_IOERR );
+      break;
+    }
+  } // while
+  if ( n == 0 )
+    return true;
+#endif /* HAVE_SENDFILE && HAVE_SYS_SENDFILE_H */
+
+  (void)n;
+  (void)started;
+  return false;
+}
+
+/**
+ * Copies \a from_fd to \a to_fd until EOF via a large buffer.
+ * If copying fails, prints an error message and exits.
+ *
+ * @param from_fd The file descriptor to copy from.
+ * @param to_fd The file descriptor to copy to.
+ * @return Returns the number of bytes copied.
+ */
+static size_t fd_copy_user( int from_fd, int to_fd ) {
+  char *const buf = MALLOC( char, READER_BUF_SIZE );
+  size_t copied = 0;
+  for (;;) {
+    ssize_t n = read( from_fd, buf, READER_BUF_SIZE );
+    if ( n == 0 )
+      break;
+    if ( n == -1 ) {
+      PERROR_EXIT_IF( errno != EINTR, EX_IOERR );
+      continue;
+    }
+    copied += STATIC_CAST( size_t, n );
+    for ( char const *p = buf; n > 0; ) {
+      ssize_t const w = write( to_fd, p, STATIC_CAST( size_t, n ) );
+      if ( w == -1 ) {
+        PERROR_EXIT_IF( errno != EINTR, EX_IOERR );
+        continue;
+      }
+      p += w;
+      n -= w;
+    } // for
+  } // for
+  FREE( buf );
+  return copied;
+}
+
+/**
+ * Determines the reader's end-of-line convention from the first newline in
+ * newly read data, if any, unless it already has been.  Since every way of
+ * reading goes through here, it also marks #PROFILE_FIRST_IN.
+ *
+ * @param r The \ref reader to probe.
+ * @param s The newly read data.
+ * @param size The number of characters of \a s.
+ */
+static void reader_eol_probe( reader_t *r, char const *s, size_t size ) {
+  assert( r != NULL );
+  profile_mark( PROFILE_FIRST_IN );
+  if ( r->eol != EOL_INPUT || size == 0 )
+    return;
+  char const *const nl = memchr( s, '\n', size );
+  if ( nl == NULL ) {
+    //
+    // A \r\n may straddle two reads, so remember whether this one ended with
+    // the \r.
+    //
+    r->eol_cr = s[ size - 1 ] == '\r';
+    return;
+  }
+  bool const is_cr = nl > s ? nl[-1] == '\r' : r->eol_cr;
+  r->eol = is_cr ? EOL_WINDOWS : EOL_UNIX;
+}
+
+/**
+ * Prints an error message for a failed read of \a r and exits.
+ *
+ * @param r The \ref reader that failed.
+ * @param error The `errno` of the failed read; ignored if decompressing
+ * failed.
+ */
+static void reader_error( reader_t const *r, int error ) {
+  if ( r->decoder != NULL && decoder_error( r->decoder ) != NULL ) {
+    fatal_error( EX_DATAERR,
+      "compressed input: %s\n", decoder_error( r->decoder )
+    );
+  }
+  errno = error;
+  perror_exit( EX_IOERR );
+}
+
+/**
+ * Reads from the reader's file descriptor (decompressing, if need be) into the
+ * free space at the end of its buffer.
+ *
+ * @param r The \ref reader to read into.
+ * @return Returns the number of characters read or 0 on EOF.
+ */
+static size_t reader_fill( reader_t *r ) {
+  assert( r != NULL );
+  assert( !r->mapped );
+  assert( r->end < r->buf + READER_BUF_SIZE );
+
+  size_t const sniffed = reader_sniff( r );
+  if ( sniffed > 0 || r->eof )
+    return sniffed;
+
+  size_t const free_size =
+    STATIC_CAST( size_t, r->buf + READER_BUF_SIZE - r->end );
+
+#ifdef WITH_RING
+  if ( r->ring != NULL ) {
+    if ( r->slot_pos == NULL ) {
+      size_t len;
+      char const *const slot = ring_acquire_full( r->ring, &len );
+      if ( len == 0 ) {                 // the thread has stopped
+        if ( unlikely( r->error != 0 ) )
+          reader_error( r, r->error );
+        r->eof = true;
+        return 0;
+      }
+      r->slot_pos = slot;
+      r->slot_end = slot + len;
+    }
+    size_t const slot_len = STATIC_CAST( size_t, r->slot_end - r->slot_pos );
+    size_t const n = slot_len < free_size ? slot_len : free_size;
+    memcpy( r->end, r->slot_pos, n );
+    reader_eol_probe( r, r->end, n );
+    r->end += n;
+    r->slot_pos += n;
+    if ( r->slot_pos == r->slot_end ) {
+      r->slot_pos = NULL;
+      ring_consume( r->ring );
+    }
+    return n;
+  }
+#endif /* WITH_RING */
+
+  for (;;) {
+    ssize_t const n = r->decoder != NULL ?
+      decoder_read( r->decoder, r->end, free_size ) :
+      read( r->fd, r->end, free_size );
+    if ( likely( n > 0 ) ) {
+      reader_eol_probe( r, r->end, STATIC_CAST( size_t, n ) );
+      r->end += n;
+      return STATIC_CAST( size_t, n );
+    }
+    if ( n == 0 ) {
+      r->eof = true;
+      return 0;
+    }
+    if ( r->decoder != NULL || errno != EINTR )
+      reader_error( r, errno );
+  } // for
+}
+
+/**
+ * Finds the \ref reader for \a file.
+ *
+ * @param file The FILE to find the \ref reader for.
+ * @param create If `true` and no \ref reader exists for \a file, create one.
+ * @return Returns said \ref reader or NULL if none and \a create is `false`.
+ */
+static reader_t* reader_find( FILE *file, bool create ) {
+  assert( file != NULL );
+  int const fd = fileno( file );
+  reader_t *unused = NULL;
+
+  for ( reader_t *r = readers; r < readers + ARRAY_SIZE( readers ); ++r ) {
+    if ( r->buf == NULL ) {
+      if ( unused == NULL )
+        unused = r;
+    } else if ( r->fd == fd ) {
+      return r;
+    }
+  } // for
+
+  if ( !create )
+    return NULL;
+  if ( unlikely( unused == NULL ) )
+    INTERNAL_ERROR( "more than %d readers\n", READERS_MAX );
+
+  unused->fd = fd;
+  unused->eof = false;
+  unused->eol = EOL_INPUT;
+  unused->eol_cr = false;
+  unused->lines_left = SIZE_MAX;
+  unused->decoder = NULL;
+  unused->codec = CODEC_NONE;
+  unused->sniffed = false;
+#ifdef WITH_READER_MMAP
+  if ( reader_mmap( unused ) )
+    return unused;
+#endif /* WITH_READER_MMAP */
+#if HAVE_POSIX_FADVISE && defined(POSIX_FADV_SEQUENTIAL)
+  //
+  // A regular file that's read rather than mapped, e.g., because it's
+  // compressed, is read sequentially, so have the kernel read further ahead.
+  // For anything else, e.g., a pipe, this fails harmlessly.
+  //
+  PJL_DISCARD_RV( posix_fadvise( fd, 0, 0, POSIX_FADV_SEQUENTIAL ) );
+#endif /* HAVE_POSIX_FADVISE && POSIX_FADV_SEQUENTIAL */
+  unused->buf = ARENA_ALLOC( char, READER_BUF_SIZE );
+  unused->pos = unused->end = unused->buf;
+  unused->mapped = false;
+#ifdef WITH_RING
+  unused->ring = NULL;
+#endif /* WITH_RING */
+  return unused;
+}
+
+#ifdef WITH_READER_MMAP
+/**
+ * Attempts to memory-map the reader's file in its entirety so lines can be
+ * returned directly from the mapped pages without either **read**(2) calls or
+ * copying.  Only non-empty regular files can be mapped; everything else
+ * (e.g., pipes and terminals) uses block reads.
+ *
+ * @param r The \ref reader whose file to map.
+ * @return Returns `true` only if the file was mapped.
+ */
+static bool reader_mmap( reader_t *r ) {
+  assert( r != NULL );
+
+  struct stat st;
+  if ( fstat( r->fd, &st ) == -1 || !S_ISREG( st.st_mode ) || st.st_size <= 0 )
+    return false;
+  //
+  // The file might not be positioned at its beginning, e.g., if the user did
+  // something like:
+  //
+  //      ( head -1 ; wrap ) < file
+  //
+  off_t const offset = lseek( r->fd, 0, SEEK_CUR );
+  if ( offset == -1 || offset > st.st_size )
+    return false;
+
+  size_t const size = STATIC_CAST( size_t, st.st_size );
+  void *const map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, r->fd, 0 );
+  if ( map == MAP_FAILED )
+    return false;
+#if HAVE_MADVISE && defined(MADV_SEQUENTIAL)
+  PJL_DISCARD_RV( madvise( map, size, MADV_SEQUENTIAL ) );
+#endif /* HAVE_MADVISE && MADV_SEQUENTIAL */
+  huge_advise( map, size );             // only some file systems support it
+
+  char const *const pos = STATIC_CAST( char const*, map ) + offset;
+  size_t const left = size - STATIC_CAST( size_t, offset );
+  codec_t const codec = codec_detect( pos, left );
+  if ( codec != CODEC_NONE ) {
+    //
+    // The file is compressed (or not UTF-8): decompress it directly from the
+    // mapped pages into the buffer as it's read rather than returning lines
+    // from them.
+    //
+    r->decoder = decoder_new( codec, pos, left );
+    r->codec = codec;
+    r->sniffed = true;
+    return false;
+  }
+
+  r->buf = map;
+  r->pos = r->buf + offset;
+  r->end = r->buf + size;
+  r->released = r->buf;
+  r->eof = true;                        // nothing more to read
+  r->mapped = true;
+  reader_eol_probe( r, r->pos, STATIC_CAST( size_t, r->end - r->pos ) );
+  return true;
+}
+
+/**
+ * Gives the pages of the reader's memory-mapped file that have been consumed
+ * back to the kernel, but only once at least #READER_RELEASE_SIZE bytes have
+ * been.  The pages remain mapped: if accessed again, they're simply read from
+ * the file again.
+ *
+ * @param r The \ref reader whose consumed pages to release.
+ */
+static void reader_release( reader_t *r ) {
+  assert( r != NULL );
+  assert( r->mapped );
+#if HAVE_MADVISE && defined(MADV_DONTNEED)
+  size_t const consumed = STATIC_CAST( size_t, r->pos - r->released );
+  if ( consumed < READER_RELEASE_SIZE )
+    return;
+  //
+  // The start of the mapping is page-aligned, so releasing only multiples of
+  // READER_RELEASE_SIZE keeps the released range page-aligned.
+  //
+  size_t const size = consumed - consumed % READER_RELEASE_SIZE;
+  PJL_DISCARD_RV( madvise( r->released, size, MADV_DONTNEED ) );
+  r->released += size;
+#endif /* HAVE_MADVISE && MADV_DONTNEED */
+}
+#endif /* WITH_READER_MMAP */
+
+/**
+ * Reads the first block from the reader's file descriptor to detect whether
+ * it's compressed or encoded in UTF-16 or UTF-32 and, if so, creates a \ref
+ * decoder for it.  (A file that's memory-mapped has this done by reader_mmap()
+ * instead; this is for everything else, e.g., a pipe.)  This does nothing if
+ * it's been done already.
+ *
+ * @param r The \ref reader to detect the codec of.
+ * @return Returns the number of characters read into the buffer if they're
+ * not to be decoded or 0 if either they are (in which case they've been given
+ * to the \ref decoder instead) or it's been done already.
+ */
+static size_t reader_sniff( reader_t *r ) {
+  assert( r != NULL );
+  assert( !r->mapped );
+  if ( r->sniffed )
+    return 0;
+  r->sniffed = true;
+
+  size_t const free_size =
+    STATIC_CAST( size_t, r->buf + READER_BUF_SIZE - r->end );
+  assert( free_size >= CODEC_DETECT_SIZE_MAX );
+  size_t size = 0;
+  bool eof = false;
+
+  //
+  // A pipe may return fewer bytes than are needed to detect a codec, so keep
+  // reading until there are enough.
+  //
+  while ( size < CODEC_DETECT_SIZE_MAX ) {
+    ssize_t const n = read( r->fd, r->end + size, free_size - size );
+    if ( n > 0 ) {
+      size += STATIC_CAST( size_t, n );
+    } else if ( n == 0 ) {
+      eof = true;
+      break;
+    } else if ( errno != EINTR ) {
+      reader_error( r, errno );
+    }
+  } // while
+
+  codec_t const codec = codec_detect( r->end, size );
+  if ( codec == CODEC_NONE ) {
+    reader_eol_probe( r, r->end, size );
+    r->end += size;
+    r->eof = eof;
+    return size;
+  }
+  r->decoder = decoder_new_fd( codec, r->fd, r->end, size );
+  r->codec = codec;
+  return 0;
+}
+
+#ifdef WITH_RING
+/**
+ * The main function of a reader's read-ahead thread: reads (and decompresses,
+ * if need be) blocks into the reader's ring until EOF or an error.
+ *
+ * @param arg A pointer to the \ref reader.
+ * @return Always returns NULL.
+ */
+static void* reader_thread_main( void *arg ) {
+  reader_t *const r = arg;
+  for (;;) {
+    char *const slot = ring_acquire_empty( r->ring );
+    ssize_t n;
+    if ( r->decoder != NULL ) {
+      n = decoder_read( r->decoder, slot, RING_SLOT_SIZE );
+    } else {
+      while ( (n = read( r->fd, slot, RING_SLOT_SIZE )) == -1 &&
+              errno == EINTR ) {
+        ;
+      }
+    }
+    if ( n == -1 ) {
+      r->error = r->decoder != NULL && decoder_error( r->decoder ) != NULL ?
+        -1 : errno;
+      n = 0;
+    }
+    ring_produce( r->ring, STATIC_CAST( size_t, n ) );
+    if ( n == 0 )
+      return NULL;                      // EOF or error
+  } // for
+}
+#endif /* WITH_RING */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+char const* reader_buffered( FILE *ffrom, size_t *psize ) {
+  assert( psize != NULL );
+  reader_t *const r = reader_find( ffrom, /*create=*/true );
+  if ( r->pos == r->end && !r->mapped && !r->eof ) {
+    r->pos = r->end = r->buf;
+    PJL_DISCARD_RV( reader_fill( r ) );
+  }
+  *psize = STATIC_CAST( size_t, r->end - r->pos );
+  return r->pos;
+}
+
+void reader_async( FILE *ffrom ) {
+#ifdef WITH_RING
+  reader_t *const r = reader_find( ffrom, /*create=*/true );
+  if ( r->mapped || r->ring != NULL )
+    return;
+  //
+  // Detect the codec now, before the thread owns the file descriptor.
+  //
+  PJL_DISCARD_RV( reader_sniff( r ) );
+  if ( r->eof )
+    return;
+  ring_t *const ring = MALLOC( ring_t, 1 );
+  if ( !ring_init( ring ) ) {
+    FREE( ring );
+    return;
+  }
+  r->ring = ring;
+  r->slot_pos = NULL;
+  r->error = 0;
+  pthread_t tid;
+  if ( pthread_create( &tid, /*attr=*/NULL, &reader_thread_main, r ) != 0 ) {
+    r->ring = NULL;
+    ring_cleanup( ring );
+    FREE( ring );
+    return;
+  }
+  //
+  // The thread may be blocked in read(2) when the program exits so it's never
+  // joined and its ring is never freed.
+  //
+  PJL_DISCARD_RV( pthread_detach( tid ) );
+#else
+  (void)ffrom;
+#endif /* WITH_RING */
+}
+
+codec_t reader_codec( FILE *ffrom ) {
+  reader_t *const r = reader_find( ffrom, /*create=*/true );
+  if ( !r->mapped )
+    PJL_DISCARD_RV( reader_sniff( r ) );
+  return r->codec;
+}
+
+size_t reader_copy( FILE *ffrom, FILE *fto ) {
+  assert( ffrom != NULL );
+  assert( fto != NULL );
+
+  size_t copied = 0;
+  reader_t *const r = reader_find( ffrom, /*create=*/false );
+  if ( r == NULL ) {
+    char buf[ READER_BUF_SIZE ];
+    for ( size_t size; (size = fread( buf, 1, sizeof buf, ffrom )) > 0; ) {
+      PERROR_EXIT_IF( fwrite( buf, 1, size, fto ) < size, EX_IOERR );
+      copied += size;
+    } // for
+    FERROR( ffrom );
+    return copied;
+  }
+  if ( !r->mapped )
+    PJL_DISCARD_RV( reader_sniff( r ) );
+
+  //
+  // First drain whatever is already buffered.
+  //
+  size_t const size = STATIC_CAST( size_t, r->end - r->pos );
+  if ( size > 0 )
+    PERROR_EXIT_IF( fwrite( r->pos, 1, size, fto ) < size, EX_IOERR );
+  copied = size;
+  r->pos = r->end;
+  if ( r->eof )
+    return copied;
+
+  bool indirect = r->decoder != NULL;
+#ifdef WITH_RING
+  indirect = indirect || r->ring != NULL;
+#endif /* WITH_RING */
+  if ( indirect ) {
+    //
+    // Either the read-ahead thread owns the file descriptor or what's read
+    // must be decompressed, so keep getting data via reader_fill().
+    //
+    for (;;) {
+      r->pos = r->end = r->buf;
+      size_t const n = reader_fill( r );
+      if ( n == 0 )
+        break;
+      PERROR_EXIT_IF( fwrite( r->buf, 1, n, fto ) < n, EX_IOERR );
+      copied += n;
+    } // for
+    r->pos = r->end = r->buf;
+    return copied;
+  }
+
+  //
+  // Then copy the rest directly between the file descriptors, preferably
+  // without the data ever being copied into user space.
+  //
+  PERROR_EXIT_IF( fflush( fto ) != 0, EX_IOERR );
+  int const to_fd = fileno( fto );
+  if ( !fd_copy_kernel( r->fd, to_fd, &copied ) )
+    copied += fd_copy_user( r->fd, to_fd );
+  r->pos = r->end = r->buf;
+  r->eof = true;
+  return copied;
+}
+
+eol_t reader_eol( FILE *ffrom ) {
+  reader_t const *const r = reader_find( ffrom, /*create=*/false );
+  return r != NULL ? r->eol : EOL_INPUT;
+}
+
+void reader_extend( FILE *ffrom, size_t size ) {
+  reader_t *const r = reader_find( ffrom, /*create=*/false );
+  assert( r != NULL );
+  assert( r->mapped );
+  r->end += size;
+}
+
+void reader_forget( FILE *ffrom ) {
+  reader_t *const r = reader_find( ffrom, /*create=*/false );
+  if ( r == NULL )
+    return;
+  //
+  // The buffer, either allocated via arena_alloc() or memory-mapped, is freed
+  // upon exit.  Any read-ahead thread didn't survive fork(2), so its ring is
+  // simply abandoned.
+  //
+  r->buf = NULL;
+}
+
+char const* reader_getline( FILE *ffrom, size_t size_max, size_t *psize ) {
+  assert( ffrom != NULL );
+  assert( size_max > 0 );
+  assert( psize != NULL );
+
+  reader_t *const r = reader_find( ffrom, /*create=*/true );
+  if ( r->lines_left == 0 ) {
+    *psize = 0;
+    return NULL;
+  }
+  if ( !r->mapped && size_max > READER_BUF_SIZE )
+    size_max = READER_BUF_SIZE;
+
+  size_t size;
+  for (;;) {
+    size_t const avail = STATIC_CAST( size_t, r->end - r->pos );
+    size_t const n = avail < size_max ? avail : size_max;
+    char const *const nl = memchr( r->pos, '\n', n );
+    if ( nl != NULL ) {
+      size = STATIC_CAST( size_t, nl - r->pos ) + 1;
+      break;
+    }
+    if ( avail >= size_max || r->eof ) {
+      size = n;
+      break;
+    }
+    assert( !r->mapped );
+    if ( r->pos > r->buf ) {            // slide partial line to the front
+      memmove( r->buf, r->pos, avail );
+      r->pos = r->buf;
+      r->end = r->buf + avail;
+    }
+    PJL_DISCARD_RV( reader_fill( r ) );
+  } // for
+
+#ifdef WITH_READER_MMAP
+  if ( r->mapped )
+    reader_release( r );
+#endif /* WITH_READER_MMAP */
+  char const *const line = r->pos;
+  r->pos += size;
+  if ( r->lines_left != SIZE_MAX && size > 0 && line[ size - 1 ] == '\n' )
+    --r->lines_left;
+  *psize = size;
+  return size > 0 ? line : NULL;
+}
+
+char const* reader_getlines( FILE *ffrom, size_t *plines, size_t *psize ) {
+  assert( plines != NULL );
+  assert( psize != NULL );
+
+  reader_t *const r = reader_find( ffrom, /*create=*/true );
+  if ( r->pos == r->end && !r->mapped && !r->eof ) {
+    r->pos = r->end = r->buf;
+    PJL_DISCARD_RV( reader_fill( r ) );
+  }
+
+  size_t const lines_max = *plines < r->lines_left ? *plines : r->lines_left;
+  size_t lines = 0;
+  char const *end = r->pos;
+  while ( lines < lines_max && end < r->end ) {
+    char const *const nl =
+      memchr( end, '\n', STATIC_CAST( size_t, r->end - end ) );
+    if ( nl == NULL ) {
+      //
+      // Either the rest is the last line that has no newline or only part of
+      // a line has been read so far: either way, get it now.
+      //
+      lines += r->eof || r->mapped;
+      end = r->end;
+      break;
+    }
+    end = nl + 1;
+    ++lines;
+  } // while
+
+  *plines -= lines;
+  if ( r->lines_left != SIZE_MAX )
+    r->lines_left -= lines;
+#ifdef WITH_READER_MMAP
+  if ( r->mapped )
+    reader_release( r );
+#endif /* WITH_READER_MMAP */
+  char const *const s = r->pos;
+  *psize = STATIC_CAST( size_t, end - s );
+  r->pos = CONST_CAST( char*, end );
+  return *psize > 0 ? s : NULL;
+}
+
+void reader_limit( FILE *ffrom, size_t skip, size_t size ) {
+  reader_t *const r = reader_find( ffrom, /*create=*/false );
+  assert( r != NULL );
+  assert( r->mapped );
+  assert( skip + size <= STATIC_CAST( size_t, r->end - r->pos ) );
+  r->pos += skip;
+  r->end = r->pos + size;
+}
+
+void reader_limit_lines( FILE *ffrom, size_t lines ) {
+  reader_find( ffrom, /*create=*/true )->lines_left = lines;
+}
+
+size_t reader_mem( void ) {
+  size_t size = 0;
+  for ( reader_t const *r = readers; r < readers + ARRAY_SIZE( readers );
+        ++r ) {
+    if ( r->buf != NULL && !r->mapped )
+      size += READER_BUF_SIZE;
+    if ( r->buf != NULL && r->decoder != NULL )
+      size += decoder_mem( r->decoder );
+#ifdef WITH_RING
+    if ( r->ring != NULL )
+      size += sizeof( ring_t ) + RING_SLOTS * RING_SLOT_SIZE;
+#endif /* WITH_RING */
+  } // for
+  return size;
+}
+
+char const* reader_peek( FILE *ffrom, size_t *psize ) {
+  assert( psize != NULL );
+  reader_t *const r = reader_find( ffrom, /*create=*/true );
+  if ( !r->mapped )
+    return NULL;
+  *psize = STATIC_CAST( size_t, r->end - r->pos );
+  return r->pos;
+}
+
+void reader_unget( FILE *ffrom, size_t size ) {
+  reader_t *const r = reader_find( ffrom, /*create=*/false );
+  assert( r != NULL );
+  assert( size <= STATIC_CAST( size_t, r->pos - r->buf ) );
+  if ( r->lines_left != SIZE_MAX && size > 0 && r->pos[-1] == '\n' )
+    ++r->lines_left;
+  r->pos -= size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
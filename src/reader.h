@@ -0,0 +1,246 @@
+/*
+**      wrap -- text reformatter
+**      src/reader.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_reader_H
+#define wrap_reader_H
+
+/**
+ * @file
+ * Declares functions for reading lines from a file using large block reads
+ * rather than one character at a time.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "codec.h"                      /* for codec_t */
+#include "options.h"                    /* for eol_t */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+#include <stdio.h>                      /* for FILE */
+
+/// @endcond
+
+/**
+ * @defgroup reader-group Block Line Reader
+ * Functions for reading lines from a file using large block reads via
+ * **read**(2) into a reusable buffer or, for regular files, directly from the
+ * file's memory-mapped pages.  Regular files compressed with a supported
+ * \ref codec-group "codec" are instead decompressed from their memory-mapped
+ * pages into the buffer (on the read-ahead thread, if any) as they're read.
+ *
+ * @note Once any of these functions has been called for a `FILE`, the only
+ * ways to read from that `FILE` are via these functions since data may be
+ * buffered here rather than in the `FILE`.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define READER_BUF_SIZE           (64 * 1024)   /**< Block read size. */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets whatever input of \a ffrom is buffered without consuming it, first
+ * reading a block of it if none is.  If \a ffrom is memory-mapped, that's all
+ * of the remaining input.
+ *
+ * @param ffrom The FILE to get the buffered input of.
+ * @param psize A pointer to receive the number of characters buffered.
+ * @return Returns a pointer to the buffered input that is valid only until the
+ * next call of any `reader_*()` function for \a ffrom.
+ *
+ * @sa reader_peek()
+ */
+NODISCARD
+char const* reader_buffered( FILE *ffrom, size_t *psize );
+
+/**
+ * Starts a thread for \a ffrom that reads ahead into a ring buffer so that
+ * reading overlaps with processing what was already read.  If \a ffrom is
+ * memory-mapped or threads aren't supported, does nothing.
+ *
+ * @param ffrom The FILE to start a read-ahead thread for.
+ */
+void reader_async( FILE *ffrom );
+
+/**
+ * Gets the codec that \a ffrom is being decoded from.  It's determined as
+ * soon as \a ffrom is first read (so this reads from \a ffrom if it hasn't
+ * been yet).
+ *
+ * @param ffrom The FILE to get the codec of.
+ * @return Returns said codec or #CODEC_NONE if \a ffrom is neither compressed
+ * nor in an encoding other than UTF-8.
+ */
+NODISCARD
+codec_t reader_codec( FILE *ffrom );
+
+/**
+ * Copies whatever is currently buffered for \a ffrom to \a fto, then copies
+ * the remainder of \a ffrom to \a fto until EOF.
+ *
+ * @param ffrom The FILE to copy from.
+ * @param fto The FILE to copy to.
+ * @return Returns the number of bytes copied.
+ *
+ * @sa fcopy()
+ */
+size_t reader_copy( FILE *ffrom, FILE *fto );
+
+/**
+ * Gets the end-of-line convention of \a ffrom as determined by the first
+ * newline read from it so far.  It's determined as soon as the block
+ * containing that newline is read, i.e., without having to wait for a
+ * complete line to be gotten via reader_getline().
+ *
+ * @param ffrom The FILE to get the end-of-line convention of.
+ * @return Returns #EOL_WINDOWS if the first newline was preceded by a carriage
+ * return, #EOL_UNIX if not, or #EOL_INPUT if no newline has been read yet
+ * (including if there is none at all).
+ */
+NODISCARD
+eol_t reader_eol( FILE *ffrom );
+
+/**
+ * Extends what can be read from \a ffrom as limited by reader_limit() by
+ * another \a size characters, e.g., once what it was limited to has been read.
+ *
+ * @param ffrom The FILE to extend.  The characters must have been part of its
+ * remaining input obtained by reader_peek() before it was limited.
+ * @param size The number of characters to extend by.
+ *
+ * @sa reader_limit()
+ */
+void reader_extend( FILE *ffrom, size_t size );
+
+/**
+ * Forgets the \ref reader for \a ffrom, if any, along with whatever it has
+ * buffered, e.g., because the file descriptor of \a ffrom has been made to
+ * refer to a different file via **dup2**(2).  The next read from \a ffrom
+ * starts afresh.
+ *
+ * @param ffrom The FILE to forget the \ref reader for.
+ *
+ * @note This is meant to be called only in a child process after **fork**(2).
+ */
+void reader_forget( FILE *ffrom );
+
+/**
+ * Gets as many as \a *plines complete lines from \a ffrom without copying
+ * them, but only as many as are already buffered (or, if none are, as many as
+ * the next block read contains).
+ *
+ * @param ffrom The FILE to read from.
+ * @param plines A pointer to the number of lines to get that is decremented
+ * by the number of lines gotten.
+ * @param psize A pointer to receive the number of characters of the lines.
+ * @return Returns a pointer to the start of the lines within an internal
+ * buffer that is valid only until the next call of any `reader_*()` function
+ * for \a ffrom or NULL only on EOF.  The last line is not newline-terminated
+ * only if it's the last line of \a ffrom.
+ *
+ * @sa reader_getline()
+ */
+NODISCARD
+char const* reader_getlines( FILE *ffrom, size_t *plines, size_t *psize );
+
+/**
+ * Limits what subsequently can be read from \a ffrom to \a size characters
+ * starting \a skip characters from the current position.
+ *
+ * @param ffrom The FILE to limit.  Its remaining input must have been obtained
+ * by reader_peek().
+ * @param skip The number of characters to skip.
+ * @param size The maximum number of characters to read after skipping.
+ */
+void reader_limit( FILE *ffrom, size_t skip, size_t size );
+
+/**
+ * Limits what subsequently can be read from \a ffrom to \a lines lines: once
+ * they've been gotten, reader_getline() and reader_getlines() return NULL as
+ * if at EOF.
+ *
+ * @param ffrom The FILE to limit.
+ * @param lines The maximum number of lines to get or `SIZE_MAX` for no limit.
+ */
+void reader_limit_lines( FILE *ffrom, size_t lines );
+
+/**
+ * Gets the number of bytes of heap memory used by the buffers of all readers,
+ * including those of their read-ahead threads and decompressors, if any, but
+ * not memory-mapped files.
+ *
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t reader_mem( void );
+
+/**
+ * Gets all of the remaining input of \a ffrom without consuming it, but only
+ * if it can be memory-mapped.
+ *
+ * @param ffrom The FILE to peek at.
+ * @param psize A pointer to receive the number of characters remaining.
+ * @return Returns a pointer to all of the remaining input (that is valid until
+ * the program exits) or NULL if \a ffrom can't be memory-mapped.
+ *
+ * @sa reader_limit()
+ */
+NODISCARD
+char const* reader_peek( FILE *ffrom, size_t *psize );
+
+/**
+ * Gets a newline-terminated line from \a ffrom without copying it.
+ *
+ * @param ffrom The FILE to read from.
+ * @param size_max The maximum number of characters to return.  If the line is
+ * longer, only this many are returned and the rest is returned by subsequent
+ * calls.
+ * @param psize A pointer to receive the number of characters of the line
+ * including the newline, if any.
+ * @return Returns a pointer to the start of the line within an internal
+ * buffer that is valid only until the next call of any `reader_*()` function
+ * for \a ffrom or NULL only on EOF.  The line is _not_ null-terminated.
+ *
+ * @sa fgetsz()
+ */
+NODISCARD
+char const* reader_getline( FILE *ffrom, size_t size_max, size_t *psize );
+
+/**
+ * Un-gets the line most recently gotten from \a ffrom via reader_getline() so
+ * that it's gotten again by the next call.
+ *
+ * @param ffrom The FILE to un-get the line for.
+ * @param size The number of characters of the line, i.e., what was returned
+ * via \a psize by reader_getline().
+ */
+void reader_unget( FILE *ffrom, size_t size );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_reader_H */
+/* vim:set et sw=2 ts=2: */
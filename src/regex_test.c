@@ -24,48 +24,322 @@
 #include "wregex.h"
 
 // standard
+#include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>                     /* for uint32_t */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sysexits.h>
+#include <time.h>                       /* for clock_gettime(3) */
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * A kind of generated corpus to benchmark against.
+ */
+struct bench_corpus {
+  char const         *name;             ///< Name of the corpus.
+  char const *const  *words;            ///< Words to generate lines from.
+  unsigned            url_every;        ///< Insert a URL every _n_ words.
+};
+typedef struct bench_corpus bench_corpus_t;
+
+/**
+ * A block regular expression to benchmark.
+ */
+struct bench_regex {
+  char const *name;                     ///< Name to report.
+  char const *pattern;                  ///< Pattern to compile.
+};
+typedef struct bench_regex bench_regex_t;
+
 // local constant definitions
-static char const TEST_SEP = ' ';
+static unsigned const BENCH_LINE_LEN = 72;
+static unsigned const BENCH_LINES_DEFAULT = 100000;
+static char const     TEST_SEP = ' ';
+
+/// Words for corpora without URIs.
+static char const *const BENCH_ASCII_WORDS[] = {
+  "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog;", "it's",
+  "well-known", "that", "text", "reformatting", "is", "hard.", "See",
+  "section", "3.4:", "(aside)", "and", "re-wrap", "e.g.,", "paragraphs",
+  NULL
+};
+
+/// Words for the non-ASCII corpus.
+static char const *const BENCH_UTF8_WORDS[] = {
+  "naïve", "café", "Straße", "façade", "résumé", "Ångström", "über",
+  "Добрый", "день", "мир", "日本語", "の", "テキスト", "中文", "文本",
+  "ελληνικά", "λέξη", "עברית", "—", "«quoted»", "emoji🙂", "and", "the",
+  NULL
+};
+
+/// URIs and e-mail addresses inserted into the URL-dense corpus.
+static char const *const BENCH_URLS[] = {
+  "https://example.com/some-path/to/a/page.html",
+  "http://www.gnu.org/licenses/",
+  "<mailto:paul@example.org>",
+  "jane.doe@mail.example.co.uk",
+  "ftp://ftp.example.net:2121/pub/file-1.0.tar.gz",
+  "file:///usr/share/doc/wrap/README.md",
+  "https://en.wikipedia.org/wiki/Text_editor?action=raw#History",
+  NULL
+};
+
+/// The corpora to benchmark against.
+static bench_corpus_t const BENCH_CORPORA[] = {
+  { "URL-dense",  BENCH_ASCII_WORDS,  3 },
+  { "URL-free",   BENCH_ASCII_WORDS,  0 },
+  { "non-ASCII",  BENCH_UTF8_WORDS,   0 },
+};
+
+/// Sample block regular expressions (as given to `-b`).
+static bench_regex_t const BENCH_REGEXES[] = {
+  { "-b '.. '",           "^\\.\\. " },
+  { "-b '---'",           "^---" },
+  { "-b '[ \\t]*[-*+] '", "^[ \t]*[-*+] " },
+  { "-b '#+ '",           "^#+ " },
+};
 
 // extern variable definitions
 char const       *me;                   ///< Program name.
 
-////////// local functions ////////////////////////////////////////////////////
+// local functions
+static void bench( unsigned );
+
+NODISCARD
+static char* bench_corpus_gen( bench_corpus_t const*, unsigned );
+
+NODISCARD
+static unsigned bench_rand( void );
+
+static void bench_report( char const*, char const*, unsigned, unsigned,
+                          struct timespec const* );
+
+static void bench_start( struct timespec* );
 
 _Noreturn
-static void usage( void ) {
-  EPRINTF( "usage: %s test\n", me );
-  exit( EX_USAGE );
+static void test( char const* );
+
+_Noreturn
+static void usage( void );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Benchmarks regex_match() with #WRAP_RE, regex_wrap_re_match_all(), and
+ * regex_match() with \ref BENCH_REGEXES against each of \ref BENCH_CORPORA,
+ * printing the results to standard output.
+ *
+ * @param lines The number of lines of each corpus.
+ */
+static void bench( unsigned lines ) {
+  wregex_t wrap_re;
+  int regex_err_code = regex_compile( &wrap_re, WRAP_RE );
+  if ( regex_err_code != 0 ) {
+    char err_buf[ REGEX_ERROR_SIZE ];
+    fatal_error( EX_SOFTWARE,
+      "internal regular expression error (%d): %s\n",
+      regex_err_code, regex_error( &wrap_re, regex_err_code, err_buf )
+    );
+  }
+
+  wregex_t block_re[ ARRAY_SIZE( BENCH_REGEXES ) ];
+  for ( size_t i = 0; i < ARRAY_SIZE( BENCH_REGEXES ); ++i ) {
+    regex_err_code = regex_compile( &block_re[i], BENCH_REGEXES[i].pattern );
+    if ( regex_err_code != 0 ) {
+      char err_buf[ REGEX_ERROR_SIZE ];
+      fatal_error( EX_SOFTWARE,
+        "\"%s\": internal regular expression error (%d): %s\n",
+        BENCH_REGEXES[i].pattern, regex_err_code,
+        regex_error( &block_re[i], regex_err_code, err_buf )
+      );
+    }
+  } // for
+
+  regex_words_t words = { 0 };
+  regex_ranges_t ranges = { 0 };
+
+  for ( size_t c = 0; c < ARRAY_SIZE( BENCH_CORPORA ); ++c ) {
+    bench_corpus_t const *const corpus = &BENCH_CORPORA[c];
+    char *const buf = bench_corpus_gen( corpus, lines );
+    struct timespec start;
+    unsigned matches;
+
+    bench_start( &start );
+    matches = 0;
+    for ( char const *line = buf; *line != '\0';
+          line += strlen( line ) + 1 ) {
+      regex_words_reset( &words );
+      size_t range[2];
+      for ( size_t offset = 0;
+            regex_match( &wrap_re, line, offset, &words, range );
+            offset = range[1] ) {
+        ++matches;
+      } // for
+    } // for
+    bench_report( corpus->name, "WRAP_RE (regex)", lines, matches, &start );
+
+    bench_start( &start );
+    matches = 0;
+    for ( char const *line = buf; *line != '\0';
+          line += strlen( line ) + 1 ) {
+      regex_words_reset( &words );
+      matches += STATIC_CAST( unsigned,
+        regex_wrap_re_match_all( line, &words, &ranges )
+      );
+    } // for
+    bench_report( corpus->name, "WRAP_RE (DFA)", lines, matches, &start );
+
+    for ( size_t i = 0; i < ARRAY_SIZE( BENCH_REGEXES ); ++i ) {
+      bench_start( &start );
+      matches = 0;
+      for ( char const *line = buf; *line != '\0';
+            line += strlen( line ) + 1 ) {
+        if ( regex_match( &block_re[i], line, 0, /*words=*/NULL,
+                          /*range=*/NULL ) ) {
+          ++matches;
+        }
+      } // for
+      bench_report( corpus->name, BENCH_REGEXES[i].name, lines, matches,
+                    &start );
+    } // for
+
+    FREE( buf );
+  } // for
+
+  regex_ranges_cleanup( &ranges );
+  regex_words_cleanup( &words );
+  for ( size_t i = 0; i < ARRAY_SIZE( BENCH_REGEXES ); ++i )
+    regex_free( &block_re[i] );
+  regex_free( &wrap_re );
 }
 
-////////// main ///////////////////////////////////////////////////////////////
+/**
+ * Generates a corpus of lines, each about \ref BENCH_LINE_LEN bytes long.
+ * Some lines begin with text that sample block regular expressions match.
+ *
+ * @param corpus The kind of corpus to generate.
+ * @param lines The number of lines to generate.
+ * @return Returns a buffer (that the caller is responsible for freeing) of
+ * \a lines null-terminated lines followed by an empty one.
+ */
+static char* bench_corpus_gen( bench_corpus_t const *corpus, unsigned lines ) {
+  static char const *const LINE_BEGINS[] = {
+    "", "", "", "", "", "", ".. ", "--- ", "  - ", "## "
+  };
+  assert( corpus != NULL );
 
-int main( int argc, char const *argv[] ) {
-  me = base_name( argv[0] );
-  if ( --argc != 1 )
-    usage();
+  size_t n_words = 0;
+  while ( corpus->words[ n_words ] != NULL )
+    ++n_words;
+  size_t n_urls = 0;
+  while ( BENCH_URLS[ n_urls ] != NULL )
+    ++n_urls;
+
+  //
+  // A line is at most BENCH_LINE_LEN bytes plus the longest word or URL plus
+  // a space and a null byte; 256 per line is plenty.
+  //
+  char *const buf = MALLOC( char, (size_t)lines * 256 + 1 );
+  char *p = buf;
+  unsigned word_count = 0;
+
+  for ( unsigned line = 0; line < lines; ++line ) {
+    char *const line_begin = p;
+    p += strcpy_len( p,
+      LINE_BEGINS[ bench_rand() % ARRAY_SIZE( LINE_BEGINS ) ]
+    );
+    do {
+      if ( p > line_begin && p[-1] != ' ' )
+        *p++ = ' ';
+      char const *const word =
+        corpus->url_every > 0 && ++word_count % corpus->url_every == 0 ?
+          BENCH_URLS[ bench_rand() % n_urls ] :
+          corpus->words[ bench_rand() % n_words ];
+      p += strcpy_len( p, word );
+    } while ( STATIC_CAST( size_t, p - line_begin ) < BENCH_LINE_LEN );
+    *p++ = '\0';
+  } // for
 
-  char const *const test_path = argv[1];
+  *p = '\0';
+  return buf;
+}
+
+/**
+ * Gets a pseudo-random number.  Unlike **rand**(3), the sequence is the same
+ * on every platform so corpora are reproducible.
+ *
+ * @return Returns said number.
+ */
+static unsigned bench_rand( void ) {
+  static uint32_t state = 2463534242u;  // xorshift32
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+/**
+ * Prints the result of a single benchmark.
+ *
+ * @param corpus_name The name of the corpus.
+ * @param regex_name The name of what was matched.
+ * @param lines The number of lines matched against.
+ * @param matches The number of matches.
+ * @param start The time the benchmark started.
+ */
+static void bench_report( char const *corpus_name, char const *regex_name,
+                          unsigned lines, unsigned matches,
+                          struct timespec const *start ) {
+  struct timespec end;
+  bench_start( &end );
+  double const ns =
+    (double)(end.tv_sec - start->tv_sec) * 1e9 +
+    (double)(end.tv_nsec - start->tv_nsec);
+  printf( "%-10s  %-20s  %10.1f ns/line  %12.0f matches/s\n",
+    corpus_name, regex_name, ns / lines,
+    ns > 0 ? matches / (ns / 1e9) : 0.0
+  );
+}
+
+/**
+ * Gets the current time for a benchmark.
+ *
+ * @param ts A pointer to receive the current time.
+ */
+static void bench_start( struct timespec *ts ) {
+  PERROR_EXIT_IF( clock_gettime( CLOCK_MONOTONIC, ts ) != 0, EX_OSERR );
+}
+
+/**
+ * Checks that #WRAP_RE matches (or doesn't match) each subject in \a
+ * test_path as expected, and that the DFA agrees, then exits.
+ *
+ * @param test_path The full path of the test file.
+ */
+static void test( char const *test_path ) {
   FILE *const fin = fopen( test_path, "r" );
   if ( fin == NULL )
     fatal_error( EX_NOINPUT, "\"%s\": %s\n", test_path, STRERROR() );
 
   setlocale_utf8();
 
+  extern char const WRAP_RE_DFA_PATTERN[];
+  if ( strcmp( WRAP_RE_DFA_PATTERN, WRAP_RE ) != 0 ) {
+    fatal_error( EX_SOFTWARE,
+      "wregex_tables.c is stale: do \"make wregex-tables\"\n"
+    );
+  }
+
   wregex_t re;
   int const regex_err_code = regex_compile( &re, WRAP_RE );
   if ( regex_err_code != 0 ) {
+    char err_buf[ REGEX_ERROR_SIZE ];
     fatal_error( EX_SOFTWARE,
       "internal regular expression error (%d): %s\n",
-      regex_err_code, regex_error( &re, regex_err_code )
+      regex_err_code, regex_error( &re, regex_err_code, err_buf )
     );
   }
 
@@ -92,7 +366,20 @@ int main( int argc, char const *argv[] ) {
     char const *const subject = sep + 1;
 
     size_t match_range[2];
-    bool const matched = regex_match( &re, subject, 0, match_range );
+    bool const matched =
+      regex_match( &re, subject, 0, /*words=*/NULL, match_range );
+
+    size_t dfa_range[2];
+    bool const dfa_matched =
+      regex_wrap_re_match( subject, 0, /*words=*/NULL, dfa_range );
+    if ( dfa_matched != matched || (matched &&
+         (dfa_range[0] != match_range[0] || dfa_range[1] != match_range[1])) ) {
+      EPRINTF(
+        "%s:%u: DFA and regular expression matches differ\n",
+        test_path, line_no
+      );
+      ++mismatches;
+    }
 
     if ( !matched ) {
       if ( expected_len > 0 ) {
@@ -138,5 +425,36 @@ int main( int argc, char const *argv[] ) {
   exit( mismatches > 0 ? EX_SOFTWARE : EX_OK );
 }
 
+static void usage( void ) {
+  EPRINTF(
+    "usage: %s test\n"
+    "       %s -b [lines]\n",
+    me, me
+  );
+  exit( EX_USAGE );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+int main( int argc, char const *argv[] ) {
+  me = base_name( argv[0] );
+  if ( argc < 2 || argc > 3 )
+    usage();
+
+  if ( strcmp( argv[1], "-b" ) == 0 ) {
+    unsigned const lines =
+      argc == 3 ? check_atou( argv[2] ) : BENCH_LINES_DEFAULT;
+    if ( lines == 0 )
+      usage();
+    setlocale_utf8();
+    bench( lines );
+    exit( EX_OK );
+  }
+
+  if ( argc != 2 )
+    usage();
+  test( argv[1] );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /* vim:set et sw=2 ts=2: */
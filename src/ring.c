@@ -0,0 +1,128 @@
+/*
+**      wrap -- text reformatter
+**      src/ring.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for passing blocks of characters from one thread to
+ * another.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "ring.h"
+#include "util.h"
+
+#ifdef WITH_RING
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <sysexits.h>
+
+/// @endcond
+
+/**
+ * @addtogroup ring-group
+ * @{
+ */
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Waits on \a sem handling interrupts.
+ *
+ * @param sem The semaphore to wait on.
+ */
+static void sem_wait_nointr( sem_t *sem ) {
+  while ( sem_wait( sem ) == -1 )
+    PERROR_EXIT_IF( errno != EINTR, EX_OSERR );
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+char const* ring_acquire_full( ring_t *ring, size_t *plen ) {
+  assert( ring != NULL );
+  assert( plen != NULL );
+  sem_wait_nointr( &ring->full );
+  unsigned const i = ring->head % RING_SLOTS;
+  *plen = ring->slot_len[i];
+  return ring->slot_buf[i];
+}
+
+char* ring_acquire_empty( ring_t *ring ) {
+  assert( ring != NULL );
+  sem_wait_nointr( &ring->empty );
+  return ring->slot_buf[ ring->tail % RING_SLOTS ];
+}
+
+void ring_cleanup( ring_t *ring ) {
+  assert( ring != NULL );
+  for ( unsigned i = 0; i < RING_SLOTS; ++i )
+    FREE( ring->slot_buf[i] );
+  PJL_DISCARD_RV( sem_destroy( &ring->empty ) );
+  PJL_DISCARD_RV( sem_destroy( &ring->full ) );
+}
+
+void ring_consume( ring_t *ring ) {
+  assert( ring != NULL );
+  ++ring->head;
+  PERROR_EXIT_IF( sem_post( &ring->empty ) == -1, EX_OSERR );
+}
+
+bool ring_init( ring_t *ring ) {
+  assert( ring != NULL );
+  if ( sem_init( &ring->empty, /*pshared=*/0, RING_SLOTS ) == -1 )
+    return false;                       // e.g., macOS: ENOSYS
+  if ( sem_init( &ring->full, /*pshared=*/0, 0 ) == -1 ) {
+    PJL_DISCARD_RV( sem_destroy( &ring->empty ) );
+    return false;
+  }
+  for ( unsigned i = 0; i < RING_SLOTS; ++i ) {
+    ring->slot_buf[i] = MALLOC( char, RING_SLOT_SIZE );
+    ring->slot_len[i] = 0;
+  } // for
+  ring->head = ring->tail = 0;
+  return true;
+}
+
+void ring_produce( ring_t *ring, size_t len ) {
+  assert( ring != NULL );
+  assert( len <= RING_SLOT_SIZE );
+  ring->slot_len[ ring->tail++ % RING_SLOTS ] = len;
+  PERROR_EXIT_IF( sem_post( &ring->full ) == -1, EX_OSERR );
+}
+
+void ring_wait_empty( ring_t *ring ) {
+  assert( ring != NULL );
+  for ( unsigned i = 1; i < RING_SLOTS; ++i )
+    sem_wait_nointr( &ring->empty );
+  for ( unsigned i = 1; i < RING_SLOTS; ++i )
+    PERROR_EXIT_IF( sem_post( &ring->empty ) == -1, EX_OSERR );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* WITH_RING */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,162 @@
+/*
+**      wrap -- text reformatter
+**      src/ring.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_ring_H
+#define wrap_ring_H
+
+/**
+ * @file
+ * Declares a data structure and functions for passing blocks of characters
+ * from one thread to another.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+
+#if defined(WITH_PIPELINE) && HAVE_PTHREAD_H && HAVE_SEMAPHORE_H \
+ && HAVE_SEM_INIT && HAVE_STDATOMIC_H
+# include <pthread.h>
+# include <semaphore.h>
+# include <stdatomic.h>
+# define WITH_RING 1
+#endif
+
+/// @endcond
+
+/**
+ * @defgroup ring-group Ring Buffer
+ * A data structure and functions for passing blocks of characters from
+ * exactly one producer thread to exactly one consumer thread.
+ *
+ * @remarks Each of the producer and the consumer touches only its own index
+ * into the ring, so neither ever waits on a lock; a thread blocks (on a
+ * semaphore) only when the ring is full (for the producer) or empty (for the
+ * consumer).
+ * @{
+ */
+
+#ifdef WITH_RING
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define RING_SLOT_SIZE            (64 * 1024)   /**< Size of each slot. */
+#define RING_SLOTS                4             /**< Number of slots. */
+
+/**
+ * Single-producer, single-consumer ring buffer of blocks of characters.
+ */
+struct ring {
+  char     *slot_buf[ RING_SLOTS ];     ///< Buffers of #RING_SLOT_SIZE chars.
+  size_t    slot_len[ RING_SLOTS ];     ///< Number of characters in each.
+  unsigned  head;                       ///< Next slot to consume.
+  unsigned  tail;                       ///< Next slot to produce.
+  sem_t     empty;                      ///< Count of empty slots.
+  sem_t     full;                       ///< Count of full slots.
+};
+typedef struct ring ring_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Waits for a slot to be produced, if necessary.
+ * May be called only by the consumer.
+ *
+ * @param ring The \ref ring to get a full slot from.
+ * @param plen A pointer to receive the number of characters in the slot.
+ * @return Returns the slot's buffer.
+ *
+ * @sa ring_consume()
+ */
+NODISCARD
+char const* ring_acquire_full( ring_t *ring, size_t *plen );
+
+/**
+ * Waits for a slot to be consumed, if necessary.
+ * May be called only by the producer.
+ *
+ * @param ring The \ref ring to get an empty slot from.
+ * @return Returns the slot's buffer of #RING_SLOT_SIZE characters.
+ *
+ * @sa ring_produce()
+ */
+NODISCARD
+char* ring_acquire_empty( ring_t *ring );
+
+/**
+ * Frees all memory used by \a ring.
+ *
+ * @param ring The \ref ring to clean up.
+ *
+ * @sa ring_init()
+ */
+void ring_cleanup( ring_t *ring );
+
+/**
+ * Releases the slot most recently acquired by ring_acquire_full() back to the
+ * producer.
+ *
+ * @param ring The \ref ring to use.
+ */
+void ring_consume( ring_t *ring );
+
+/**
+ * Initializes \a ring.
+ *
+ * @param ring The \ref ring to initialize.
+ * @return Returns `true` only if \a ring was initialized; `false` if the
+ * platform doesn't support the required semaphores.
+ *
+ * @sa ring_cleanup()
+ */
+NODISCARD
+bool ring_init( ring_t *ring );
+
+/**
+ * Publishes the slot most recently acquired by ring_acquire_empty() to the
+ * consumer.
+ *
+ * @param ring The \ref ring to use.
+ * @param len The number of characters in the slot.
+ */
+void ring_produce( ring_t *ring, size_t len );
+
+/**
+ * Waits until the consumer has consumed every slot produced so far.
+ * May be called only by the producer while it has exactly one empty slot
+ * acquired.
+ *
+ * @param ring The \ref ring to wait on.
+ */
+void ring_wait_empty( ring_t *ring );
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif /* WITH_RING */
+
+/** @} */
+
+#endif /* wrap_ring_H */
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,428 @@
+/*
+**      wrap -- text reformatter
+**      src/rope.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for a rope: text held as a sequence of chunks in a
+ * balanced tree.
+ *
+ * @remarks The tree is a treap: in order, its nodes are the chunks of the
+ * text; by random priority, they're a heap.  That keeps it balanced (with
+ * high probability) and lets it be split at, and joined after, any chunk in
+ * _O(log n)_ time.  Characters are replaced by splitting out the chunks they
+ * span and joining new chunks in their place.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#define W_ROPE_H_INLINE _GL_EXTERN_INLINE
+#include "rope.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>                     /* for uint32_t */
+#include <stdlib.h>
+#include <string.h>                     /* for memchr(3), memcpy(3) */
+
+/// @endcond
+
+/**
+ * @addtogroup rope-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maximum length of a chunk: long enough that there are few nodes, but short
+ * enough that copying one upon every edit is cheap.
+ */
+#define ROPE_CHUNK_MAX            2048
+
+/**
+ * Minimum length of the new chunks replacing characters: any shorter and the
+ * chunks next to them are made part of them so that many small edits don't
+ * leave many small chunks.
+ */
+#define ROPE_CHUNK_MIN            (ROPE_CHUNK_MAX / 4)
+
+/**
+ * A node of a \ref rope: a chunk of its text.
+ */
+struct rope_node {
+  rope_node_t  *left;                   ///< Chunks before, if any.
+  rope_node_t  *right;                  ///< Chunks after, if any.
+  uint32_t      prio;                   ///< Random heap priority.
+  size_t        len;                    ///< Length of \a str.
+  size_t        lines;                  ///< Number of newlines in \a str.
+  size_t        sub_len;                ///< Length of the subtree.
+  size_t        sub_lines;              ///< Number of newlines of subtree.
+  char          str[];                  ///< Characters (not null-terminated).
+};
+
+/**
+ * A segment of characters.
+ */
+struct rope_seg {
+  char const *s;                        ///< Characters.
+  size_t      len;                      ///< Length of \a s.
+};
+typedef struct rope_seg rope_seg_t;
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Counts the newlines of \a s.
+ *
+ * @param s The characters to count the newlines of.
+ * @param len The length of \a s.
+ * @return Returns said number of newlines.
+ */
+NODISCARD
+static size_t count_newlines( char const *s, size_t len ) {
+  size_t lines = 0;
+  for ( char const *const end = s + len;
+        (s = memchr( s, '\n', STATIC_CAST( size_t, end - s ) )) != NULL;
+        ++s ) {
+    ++lines;
+  } // for
+  return lines;
+}
+
+/**
+ * Copies characters of a subtree.
+ *
+ * @param t The root of the subtree.
+ * @param off The offset of the first character to copy.
+ * @param len The number of characters to copy.
+ * @param dst The buffer to copy into.
+ */
+static void node_copy( rope_node_t const *t, size_t off, size_t len,
+                       char *dst ) {
+  while ( t != NULL && len > 0 ) {
+    size_t const left_len = t->left != NULL ? t->left->sub_len : 0;
+    if ( off < left_len ) {
+      size_t const n = len < left_len - off ? len : left_len - off;
+      node_copy( t->left, off, n, dst );
+      dst += n;
+      len -= n;
+      off = left_len;
+    }
+    if ( off < left_len + t->len ) {
+      size_t const i = off - left_len;
+      size_t const n = len < t->len - i ? len : t->len - i;
+      memcpy( dst, t->str + i, n );
+      dst += n;
+      len -= n;
+      off += n;
+    }
+    off -= left_len + t->len;
+    t = t->right;
+  } // while
+}
+
+/**
+ * Frees a subtree.
+ *
+ * @param t The root of the subtree.  It may be NULL.
+ */
+static void node_free( rope_node_t *t ) {
+  while ( t != NULL ) {
+    node_free( t->left );
+    rope_node_t *const right = t->right;
+    free( t );
+    t = right;
+  } // while
+}
+
+/**
+ * Updates the subtree length and number of newlines of \a t from its
+ * children.
+ *
+ * @param t The \ref rope_node to update.
+ * @return Returns \a t.
+ */
+static rope_node_t* node_update( rope_node_t *t ) {
+  t->sub_len = t->len;
+  t->sub_lines = t->lines;
+  if ( t->left != NULL ) {
+    t->sub_len += t->left->sub_len;
+    t->sub_lines += t->left->sub_lines;
+  }
+  if ( t->right != NULL ) {
+    t->sub_len += t->right->sub_len;
+    t->sub_lines += t->right->sub_lines;
+  }
+  return t;
+}
+
+/**
+ * Joins two subtrees.
+ *
+ * @param a The root of the subtree of the chunks to go first.  It may be NULL.
+ * @param b The root of the subtree of the chunks to go after.  It may be NULL.
+ * @return Returns the root of the joined subtree.
+ */
+NODISCARD
+static rope_node_t* node_merge( rope_node_t *a, rope_node_t *b ) {
+  if ( a == NULL )
+    return b;
+  if ( b == NULL )
+    return a;
+  if ( a->prio > b->prio ) {
+    a->right = node_merge( a->right, b );
+    return node_update( a );
+  }
+  b->left = node_merge( a, b->left );
+  return node_update( b );
+}
+
+/**
+ * Creates a new node.
+ *
+ * @param segs The segments of characters to copy the node's characters from.
+ * They're advanced past those copied.
+ * @param len The number of characters of the node.
+ * @return Returns said node.
+ */
+NODISCARD
+static rope_node_t* node_new( rope_seg_t *segs, size_t len ) {
+  static uint32_t prio = 2463534242u;   // xorshift32 state
+  rope_node_t *const t = check_realloc( NULL, sizeof( rope_node_t ) + len );
+  prio ^= prio << 13;
+  prio ^= prio >> 17;
+  prio ^= prio << 5;
+  *t = (rope_node_t){ .prio = prio, .len = len };
+  for ( char *dst = t->str; len > 0; ++segs ) {
+    if ( segs->len == 0 )
+      continue;
+    size_t const n = len < segs->len ? len : segs->len;
+    memcpy( dst, segs->s, n );
+    segs->s += n;
+    segs->len -= n;
+    dst += n;
+    len -= n;
+  } // for
+  t->lines = count_newlines( t->str, t->len );
+  return node_update( t );
+}
+
+/**
+ * Splits a subtree in two.
+ *
+ * @param t The root of the subtree to split.  It may be NULL.
+ * @param off The offset to split at.
+ * @param by_end If `true`, chunks that end at or before \a off go to the
+ * first subtree; if `false`, chunks that begin before \a off do.
+ * @param pa A pointer to receive the root of the first subtree.
+ * @param pb A pointer to receive the root of the second subtree.
+ */
+static void node_split( rope_node_t *t, size_t off, bool by_end,
+                        rope_node_t **pa, rope_node_t **pb ) {
+  if ( t == NULL ) {
+    *pa = *pb = NULL;
+    return;
+  }
+  size_t const left_len = t->left != NULL ? t->left->sub_len : 0;
+  size_t const t_end = left_len + t->len;
+  if ( by_end ? t_end <= off : left_len < off ) {
+    node_split( t->right, off > t_end ? off - t_end : 0, by_end, &t->right,
+                pb );
+    *pa = node_update( t );
+  }
+  else {
+    node_split( t->left, off, by_end, pa, &t->left );
+    *pb = node_update( t );
+  }
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+char const* rope_chunk( rope_t const *rope, size_t off, size_t *pbegin,
+                        size_t *plen ) {
+  assert( rope != NULL );
+  assert( pbegin != NULL );
+  assert( plen != NULL );
+
+  rope_node_t const *t = rope->root;
+  if ( t == NULL ) {
+    *pbegin = *plen = 0;
+    return "";
+  }
+  if ( off >= t->sub_len )
+    off = t->sub_len - 1;
+
+  for ( size_t begin = 0;; ) {
+    size_t const left_len = t->left != NULL ? t->left->sub_len : 0;
+    if ( off < left_len ) {
+      t = t->left;
+      continue;
+    }
+    off -= left_len;
+    begin += left_len;
+    if ( off < t->len ) {
+      *pbegin = begin;
+      *plen = t->len;
+      return t->str;
+    }
+    off -= t->len;
+    begin += t->len;
+    t = t->right;
+  } // for
+}
+
+void rope_cleanup( rope_t *rope ) {
+  assert( rope != NULL );
+  node_free( rope->root );
+  rope->root = NULL;
+}
+
+size_t rope_len( rope_t const *rope ) {
+  assert( rope != NULL );
+  return rope->root != NULL ? rope->root->sub_len : 0;
+}
+
+size_t rope_line( rope_t const *rope, size_t off ) {
+  assert( rope != NULL );
+  size_t line = 0;
+  for ( rope_node_t const *t = rope->root; t != NULL; ) {
+    size_t const left_len = t->left != NULL ? t->left->sub_len : 0;
+    if ( off < left_len ) {
+      t = t->left;
+      continue;
+    }
+    if ( t->left != NULL )
+      line += t->left->sub_lines;
+    off -= left_len;
+    if ( off <= t->len )
+      return line + count_newlines( t->str, off );
+    line += t->lines;
+    off -= t->len;
+    t = t->right;
+  } // for
+  return line;
+}
+
+size_t rope_line_offset( rope_t const *rope, size_t line ) {
+  assert( rope != NULL );
+  if ( line == 0 )
+    return 0;
+  size_t off = 0;
+  for ( rope_node_t const *t = rope->root; t != NULL; ) {
+    size_t const left_lines = t->left != NULL ? t->left->sub_lines : 0;
+    if ( line <= left_lines ) {
+      t = t->left;
+      continue;
+    }
+    line -= left_lines;
+    if ( t->left != NULL )
+      off += t->left->sub_len;
+    if ( line <= t->lines ) {
+      char const *nl = t->str;
+      for ( ;; ++nl ) {
+        nl = memchr( nl, '\n', t->len - STATIC_CAST( size_t, nl - t->str ) );
+        assert( nl != NULL );
+        if ( --line == 0 )
+          break;
+      } // for
+      return off + STATIC_CAST( size_t, nl - t->str ) + 1;
+    }
+    line -= t->lines;
+    off += t->len;
+    t = t->right;
+  } // for
+  return rope_len( rope );
+}
+
+void rope_replace( rope_t *rope, size_t begin, size_t end, char const *s,
+                   size_t len ) {
+  assert( rope != NULL );
+  assert( begin <= end );
+  assert( end <= rope_len( rope ) );
+  assert( s != NULL || len == 0 );
+
+  if ( begin == end && len == 0 )
+    return;
+
+  //
+  // Split out the chunks the characters span: a is those before; b is those
+  // spanned; c is those after.
+  //
+  rope_node_t *a, *b, *c;
+  node_split( rope->root, begin, /*by_end=*/true, &a, &b );
+  size_t const a_len = a != NULL ? a->sub_len : 0;
+  node_split( b, end - a_len, /*by_end=*/false, &b, &c );
+
+  size_t head = begin - a_len;          // characters of b kept before s
+  size_t tail =                         // characters of b kept after s
+    (b != NULL ? b->sub_len : 0) - (end - a_len);
+
+  while ( head + len + tail < ROPE_CHUNK_MIN && (a != NULL || c != NULL) ) {
+    rope_node_t *n;
+    if ( a != NULL ) {
+      node_split( a, a->sub_len - 1, /*by_end=*/true, &a, &n );
+      head += n->len;
+      b = node_merge( n, b );
+    }
+    else {
+      node_split( c, 1, /*by_end=*/false, &n, &c );
+      tail += n->len;
+      b = node_merge( b, n );
+    }
+  } // while
+
+  char *const kept = head + tail > 0 ? MALLOC( char, head + tail ) : NULL;
+  if ( kept != NULL ) {
+    node_copy( b, 0, head, kept );
+    node_copy( b, b->sub_len - tail, tail, kept + head );
+  }
+  node_free( b );
+
+  rope_seg_t segs[] = {
+    { kept, head },
+    { s, len },
+    { kept != NULL ? kept + head : NULL, tail }
+  };
+  size_t const new_len = head + len + tail;
+  size_t const n_chunks = (new_len + ROPE_CHUNK_MAX - 1) / ROPE_CHUNK_MAX;
+  rope_node_t *new_b = NULL;
+  for ( size_t i = 0, done = 0; i < n_chunks; ++i ) {
+    //
+    // Divide the characters among the chunks evenly so that none is much
+    // shorter than the others.
+    //
+    size_t const chunk_end = new_len * (i + 1) / n_chunks;
+    new_b = node_merge( new_b, node_new( segs, chunk_end - done ) );
+    done = chunk_end;
+  } // for
+  free( kept );
+
+  rope->root = node_merge( node_merge( a, new_b ), c );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,180 @@
+/*
+**      wrap -- text reformatter
+**      src/rope.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_rope_H
+#define wrap_rope_H
+
+/**
+ * @file
+ * Declares data structures and functions for a rope: text held as a sequence
+ * of chunks in a balanced tree.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+_GL_INLINE_HEADER_BEGIN
+#ifndef W_ROPE_H_INLINE
+# define W_ROPE_H_INLINE _GL_INLINE
+#endif /* W_ROPE_H_INLINE */
+
+/**
+ * @defgroup rope-group Rope
+ * Data structures and functions for a rope: text held as a sequence of chunks
+ * of at most a few kilobytes each in a balanced tree where each node also
+ * knows the number of characters and newlines of its subtree.  Replacing
+ * characters, getting the chunk containing an offset, and converting between
+ * offsets and line numbers take _O(log n)_ time (plus the size of a chunk)
+ * rather than _O(n)_.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct rope_node rope_node_t;
+
+/**
+ * A rope.  A zero-initialized rope is empty.
+ *
+ * @sa rope_cleanup()
+ */
+struct rope {
+  rope_node_t  *root;                   ///< Root of the tree, if any.
+};
+typedef struct rope rope_t;
+
+/**
+ * An iterator over the characters of a \ref rope that caches the chunk last
+ * accessed so that accessing characters near one another, in either
+ * direction, is _O(1)_ amortized.
+ *
+ * @sa rope_iter_at()
+ */
+struct rope_iter {
+  rope_t const *rope;                   ///< The rope iterated over.
+  char const   *chunk;                  ///< Characters of the current chunk.
+  size_t        begin;                  ///< Offset of \a chunk in \a rope.
+  size_t        len;                    ///< Length of \a chunk.
+};
+typedef struct rope_iter rope_iter_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Gets the chunk of a rope containing an offset.
+ *
+ * @param rope The \ref rope to use.
+ * @param off The offset.  If it's the length of \a rope, gets the last chunk.
+ * @param pbegin A pointer to receive the offset of the chunk's first
+ * character.
+ * @param plen A pointer to receive the length of the chunk.  It's 0 only if
+ * \a rope is empty.
+ * @return Returns a pointer to the chunk's characters.
+ */
+NODISCARD
+char const* rope_chunk( rope_t const *rope, size_t off, size_t *pbegin,
+                        size_t *plen );
+
+/**
+ * Frees the memory used by \a rope and makes it empty.
+ *
+ * @param rope The \ref rope to clean up.
+ */
+void rope_cleanup( rope_t *rope );
+
+/**
+ * Gets the length of a rope.
+ *
+ * @param rope The \ref rope to get the length of.
+ * @return Returns said length.
+ */
+NODISCARD
+size_t rope_len( rope_t const *rope );
+
+/**
+ * Gets the number of the line (the number of newlines before it) containing
+ * an offset.
+ *
+ * @param rope The \ref rope to use.
+ * @param off The offset.
+ * @return Returns said line number starting at 0.
+ *
+ * @sa rope_line_offset()
+ */
+NODISCARD
+size_t rope_line( rope_t const *rope, size_t off );
+
+/**
+ * Gets the offset of the beginning of a line.
+ *
+ * @param rope The \ref rope to use.
+ * @param line The line number starting at 0.
+ * @return Returns said offset or the length of \a rope if it has fewer lines.
+ *
+ * @sa rope_line()
+ */
+NODISCARD
+size_t rope_line_offset( rope_t const *rope, size_t line );
+
+/**
+ * Replaces characters of a rope.
+ *
+ * @param rope The \ref rope to replace the characters of.
+ * @param begin The offset of the first character to replace.
+ * @param end The offset of one past the last character to replace.
+ * @param s The characters to replace them with.
+ * @param len The number of characters to replace them with.
+ */
+void rope_replace( rope_t *rope, size_t begin, size_t end, char const *s,
+                   size_t len );
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Gets a character of the rope of an iterator.
+ *
+ * @param it The \ref rope_iter to use.  It must have been initialized with
+ * its \a rope and zero for everything else.
+ * @param off The offset of the character.  It must be less than the length of
+ * the rope.
+ * @return Returns said character.
+ */
+NODISCARD W_ROPE_H_INLINE
+char rope_iter_at( rope_iter_t *it, size_t off ) {
+  if ( off < it->begin || off - it->begin >= it->len )
+    it->chunk = rope_chunk( it->rope, off, &it->begin, &it->len );
+  return it->chunk[ off - it->begin ];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+_GL_INLINE_HEADER_END
+
+#endif /* wrap_rope_H */
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,1131 @@
+/*
+**      wrap -- text reformatter
+**      src/server.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines the functions implementing the server and client modes of
+ * **wrap**(1) and **wrapc**(1).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "server.h"
+#include "common.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>                      /* for fcntl(2), open(2) */
+#include <signal.h>                     /* for sigaction(2) */
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for int32_t, uint32_t */
+#include <stdio.h>                      /* for dprintf(3) */
+#include <stdlib.h>                     /* for exit(3), getenv(3) */
+#include <string.h>
+#include <sys/stat.h>                   /* for lstat(2), umask(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for fork(2), read(2), ... */
+#if HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY
+#include <sched.h>                      /* for sched_setaffinity(2) */
+#endif /* HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY */
+
+#if HAVE_POLL_H && HAVE_SYS_SOCKET_H && HAVE_SYS_UN_H
+# include <poll.h>
+# include <sys/socket.h>
+# include <sys/un.h>                    /* for sockaddr_un */
+# include <sys/wait.h>                  /* for waitpid(2) */
+# define WITH_SERVER 1
+#endif /* HAVE_POLL_H && HAVE_SYS_SOCKET_H && HAVE_SYS_UN_H */
+
+/// @endcond
+
+/**
+ * @addtogroup server-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define SERVER_OPT_CLIENT         "--client="   /**< Client mode option. */
+#define SERVER_OPT_SERVER         "--server="   /**< Server mode option. */
+
+#ifdef WITH_SERVER
+
+/**
+ * Maximum number of bytes of strings in a request.
+ */
+#define SERVER_STRINGS_MAX        (1024 * 1024)
+
+/**
+ * Maximum number of idle workers kept ready to run requests.
+ */
+#define SERVER_IDLE_MAX           2
+
+/**
+ * Version of the request format.
+ */
+#define SERVER_VERSION            2u
+
+/**
+ * A request from a client.  It's sent along with the client's file
+ * descriptors and followed by \a strings_len bytes of null-terminated strings:
+ * the program name, then \a argc arguments, then \a envc environment
+ * variables.
+ */
+struct server_request {
+  uint32_t  version;                    ///< #SERVER_VERSION.
+  uint32_t  id;                         ///< ID chosen by the client.
+  uint32_t  argc;                       ///< Number of arguments.
+  uint32_t  envc;                       ///< Number of environment variables.
+  uint32_t  strings_len;                ///< Number of bytes of strings.
+};
+typedef struct server_request server_request_t;
+
+/**
+ * The response to a request sent to its client once it's been run.
+ */
+struct server_response {
+  uint32_t  id;                         ///< ID of the request.
+  int32_t   status;                     ///< Exit status of the request.
+};
+typedef struct server_response server_response_t;
+
+/**
+ * What an idle worker that accepted a connection sends to the server along
+ * with the connection.
+ */
+struct server_handoff {
+  pid_t     pid;                        ///< Worker's process ID.
+  uint32_t  id;                         ///< ID of the request it's running.
+};
+typedef struct server_handoff server_handoff_t;
+
+/**
+ * A connection from a client.
+ */
+struct server_conn {
+  int       fd;                         ///< Connection to the client.
+  size_t    running;                    ///< Number of its requests running.
+  bool      is_eof;                     ///< Will it send no more requests?
+};
+typedef struct server_conn server_conn_t;
+
+/**
+ * A worker, either idle or running a request.
+ */
+struct server_worker {
+  pid_t     pid;                        ///< Worker's process ID.
+  int       conn;                       ///< Connection to client or -1 if idle.
+  uint32_t  id;                         ///< ID of the request being run.
+};
+typedef struct server_worker server_worker_t;
+
+#if !HAVE_DECL_ENVIRON
+// extern variables
+extern char       **environ;
+#endif /* !HAVE_DECL_ENVIRON */
+
+/// Signals the server waits for.
+static int const    SERVER_SIGNALS[] = { SIGCHLD, SIGHUP, SIGINT, SIGTERM };
+
+// local variable definitions
+static sig_atomic_t volatile server_quit; ///< Should the server quit?
+static int          signal_pipe[2];     ///< Written to upon a signal.
+#if HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY
+static cpu_set_t    server_cpus;        ///< CPUs the server may run on.
+static bool         server_pinned;      ///< Pinned via server_pin()?
+#endif /* HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY */
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Reads \a size bytes from \a fd into \a buf handling both partial reads and
+ * interrupts.
+ *
+ * @param fd The file descriptor to read from.
+ * @param buf The buffer to read into.
+ * @param size The number of bytes to read.
+ * @return Returns `true` only if all \a size bytes were read.
+ */
+NODISCARD
+static bool server_read( int fd, void *buf, size_t size ) {
+  assert( buf != NULL );
+  char *const p = buf;
+  for ( size_t bytes_read = 0; bytes_read < size; ) {
+    ssize_t const n = read( fd, p + bytes_read, size - bytes_read );
+    if ( n == 0 )
+      return false;
+    if ( n == -1 ) {
+      if ( errno == EINTR )
+        continue;
+      return false;
+    }
+    bytes_read += STATIC_CAST( size_t, n );
+  } // for
+  return true;
+}
+
+/**
+ * Fills in the address of a Unix domain socket.
+ *
+ * @param path The path of the socket.
+ * @param addr The address to fill in.
+ * @return Returns `true` only if \a path isn't too long.
+ */
+NODISCARD
+static bool server_addr( char const *path, struct sockaddr_un *addr ) {
+  assert( path != NULL );
+  assert( addr != NULL );
+  MEM_ZERO( addr );
+  addr->sun_family = AF_UNIX;
+  if ( strlen( path ) >= sizeof addr->sun_path )
+    return false;
+  strcpy( addr->sun_path, path );
+  return true;
+}
+
+/**
+ * Runs a request as a client: sends it to the server at \a path and exits
+ * with the exit status of the request once it's been run.
+ *
+ * @param prog The name of the program.
+ * @param path The path of the server's socket.
+ * @param argc The command-line argument count without the `--client` option.
+ * @param argv The command-line argument values without the `--client` option.
+ *
+ * @note Returns only if the request couldn't be sent, e.g., because the
+ * server isn't running, in which case nothing has been read from standard
+ * input and so the request can be run locally instead.
+ */
+static void server_client( char const *prog, char const *path, int argc,
+                           char const *argv[] ) {
+  assert( prog != NULL );
+  assert( path != NULL );
+  assert( argv != NULL );
+
+  int const sock = server_connect( path );
+  if ( sock == -1 )
+    return;
+  int const cwd_fd = open( ".", O_RDONLY );
+  int const fds[ SERVER_FDS ] = {
+    STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO, cwd_fd
+  };
+  bool const sent = cwd_fd != -1 &&
+    server_request_send( sock, /*id=*/0, prog, argc, argv, fds );
+  if ( cwd_fd != -1 )
+    close( cwd_fd );
+  if ( !sent ) {
+    close( sock );
+    return;
+  }
+  PJL_DISCARD_RV( shutdown( sock, SHUT_WR ) ); // no more requests
+
+  //
+  // The request has been sent, so the server may have started reading our
+  // standard input: from here on, it's too late to run it locally.
+  //
+  uint32_t id;
+  int status;
+  if ( !server_response_recv( sock, &id, &status ) )
+    fatal_error( EX_UNAVAILABLE, "%s: server closed connection\n", path );
+  exit( status );
+}
+
+/**
+ * Finds a connection by its file descriptor.
+ *
+ * @param conns The array of connections.
+ * @param conns_len The length of \a conns.
+ * @param fd The file descriptor of the connection to find.
+ * @return Returns said connection or NULL if not found.
+ */
+NODISCARD
+static server_conn_t* server_conn_find( server_conn_t conns[],
+                                        size_t conns_len, int fd ) {
+  for ( size_t i = 0; i < conns_len; ++i ) {
+    if ( conns[i].fd == fd )
+      return &conns[i];
+  } // for
+  return NULL;
+}
+
+/**
+ * Finds a worker by its process ID.
+ *
+ * @param workers The array of workers.
+ * @param workers_len The length of \a workers.
+ * @param pid The process ID of the worker to find.
+ * @return Returns said worker or NULL if not found.
+ */
+NODISCARD
+static server_worker_t* server_worker_find( server_worker_t workers[],
+                                            size_t workers_len, pid_t pid ) {
+  for ( size_t i = 0; i < workers_len; ++i ) {
+    if ( workers[i].pid == pid )
+      return &workers[i];
+  } // for
+  return NULL;
+}
+
+/**
+ * Receives a request from a client.
+ *
+ * @param conn The connection to the client.
+ * @param fds The array to receive the client's file descriptors.
+ * @param pargc A pointer to receive the request's argument count.
+ * @param prequest_id A pointer to receive the request's ID.
+ * @return Returns a null-terminated array of the program name, the request's
+ * arguments, a NULL, and then the request's environment; or NULL if the
+ * client sent no more requests or the request is malformed.  The array and
+ * the strings, starting at the program name, must be freed.
+ */
+NODISCARD
+static char const** server_recv( int conn, int fds[const static SERVER_FDS],
+                                 int *pargc, uint32_t *prequest_id ) {
+  assert( pargc != NULL );
+  assert( prequest_id != NULL );
+
+  server_request_t request;
+  union {
+    struct cmsghdr  align;
+    char            buf[ CMSG_SPACE( sizeof( int ) * SERVER_FDS ) ];
+  } control;
+  struct iovec iov = { .iov_base = &request, .iov_len = sizeof request };
+  struct msghdr msg = {
+    .msg_iov = &iov,
+    .msg_iovlen = 1,
+    .msg_control = control.buf,
+    .msg_controllen = sizeof control.buf
+  };
+  ssize_t n;
+  while ( (n = recvmsg( conn, &msg, 0 )) == -1 && errno == EINTR )
+    ;
+  struct cmsghdr const *const cmsg = CMSG_FIRSTHDR( &msg );
+  if ( n != STATIC_CAST( ssize_t, sizeof request ) || cmsg == NULL ||
+       cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+       cmsg->cmsg_len != CMSG_LEN( sizeof( int ) * SERVER_FDS ) ) {
+    return NULL;
+  }
+  memcpy( fds, CMSG_DATA( cmsg ), sizeof( int ) * SERVER_FDS );
+  if ( request.version != SERVER_VERSION ||
+       request.strings_len == 0 ||
+       request.strings_len > SERVER_STRINGS_MAX ) {
+    goto error;
+  }
+
+  char *const strings = MALLOC( char, request.strings_len );
+  size_t const n_strings = 1 + (size_t)request.argc + request.envc;
+  char const **const argv = MALLOC( char const*, n_strings + 2 );
+  if ( !server_read( conn, strings, request.strings_len ) ||
+       strings[ request.strings_len - 1 ] != '\0' ) {
+    goto free_error;
+  }
+  char const *s = strings;
+  for ( size_t i = 0; i < n_strings; ++i ) {
+    if ( s == strings + request.strings_len )
+      goto free_error;
+    argv[i] = s;
+    s += strlen( s ) + 1;
+  } // for
+  memmove( argv + 1 + request.argc + 1, argv + 1 + request.argc,
+           request.envc * sizeof *argv );
+  argv[ 1 + request.argc ] = NULL;
+  argv[ n_strings + 1 ] = NULL;
+
+  *pargc = STATIC_CAST( int, request.argc );
+  *prequest_id = request.id;
+  return argv;
+
+free_error:
+  FREE( argv );
+  FREE( strings );
+error:
+  for ( size_t i = 0; i < SERVER_FDS; ++i )
+    close( fds[i] );
+  return NULL;
+}
+
+/**
+ * Sends the response to a request to its client.
+ *
+ * @param conn The connection to the client.
+ * @param id The ID of the request.
+ * @param status The exit status of the request.
+ */
+static void server_send_response( int conn, uint32_t id, int status ) {
+  server_response_t const response = { .id = id, .status = status };
+  PJL_DISCARD_RV(
+    fd_write( conn, POINTER_CAST( char const*, &response ), sizeof response )
+  );
+}
+
+/**
+ * Initializes a child just forked by the server to be a worker: restores the
+ * default actions of the signals the server waits for or ignores and closes
+ * the server's file descriptors other than its listening and control sockets.
+ *
+ * @param conns The server's connections.
+ * @param workers The server's workers.
+ */
+static void server_child_init( server_conn_t *conns,
+                               server_worker_t *workers ) {
+  for ( size_t i = 0; i < ARRAY_SIZE( SERVER_SIGNALS ); ++i )
+    PJL_DISCARD_RV( signal( SERVER_SIGNALS[i], SIG_DFL ) );
+  PJL_DISCARD_RV( signal( SIGPIPE, SIG_DFL ) );
+  close( signal_pipe[0] );
+  close( signal_pipe[1] );
+  // conns is terminated by an fd of -1.
+  for ( server_conn_t const *conn = conns; conn->fd != -1; ++conn )
+    close( conn->fd );
+  FREE( conns );
+  FREE( workers );
+}
+
+/**
+ * Adopts a client's file descriptors, current directory, and environment as
+ * those of the current process so it can run the client's request.
+ *
+ * @param prog The name of the program.
+ * @param fds The client's file descriptors.
+ * @param argc The request's argument count.
+ * @param argv The request's program name, arguments, and environment as
+ * returned by server_recv().
+ * @param pargc A pointer to receive the request's argument count.
+ * @param pargv A pointer to receive the request's argument values.
+ */
+static void server_adopt( char const *prog, int fds[const static SERVER_FDS],
+                          int argc, char const *argv[], int *pargc,
+                          char const **pargv[] ) {
+  assert( prog != NULL );
+  assert( argv != NULL );
+  assert( pargc != NULL );
+  assert( pargv != NULL );
+
+  if ( strcmp( argv[0], prog ) != 0 ) {
+    dprintf( fds[2], "%s: server is for %s, not %s\n", me, prog, argv[0] );
+    _exit( EX_USAGE );
+  }
+  for ( int fd = 0; fd < SERVER_FDS - 1; ++fd )
+    DUP2( fds[ fd ], fd );
+  PERROR_EXIT_IF( fchdir( fds[ SERVER_FDS - 1 ] ) == -1, EX_OSERR );
+  for ( int fd = 0; fd < SERVER_FDS; ++fd ) {
+    if ( fds[ fd ] >= SERVER_FDS - 1 )
+      close( fds[ fd ] );
+  } // for
+  environ = CONST_CAST( char**, argv + 1 + argc + 1 );
+  *pargc = argc;
+  *pargv = argv + 1;
+}
+
+/**
+ * Runs an idle worker: accepts a connection from a client, receives its first
+ * request, hands the connection to the server, and adopts the client's file
+ * descriptors, current directory, and environment as its own.
+ *
+ * @param sock The server's listening socket.
+ * @param ctl The worker's end of the control socket to the server.
+ * @param prog The name of the program.
+ * @param pargc A pointer to receive the request's argument count.
+ * @param pargv A pointer to receive the request's argument values.
+ */
+static void server_worker( int sock, int ctl, char const *prog, int *pargc,
+                           char const **pargv[] ) {
+  assert( prog != NULL );
+  assert( pargc != NULL );
+  assert( pargv != NULL );
+
+  int conn;
+  while ( (conn = accept( sock, NULL, NULL )) == -1 ) {
+    if ( errno != EINTR && errno != ECONNABORTED )
+      _exit( EX_OSERR );
+  } // while
+  close( sock );
+
+  int fds[ SERVER_FDS ];
+  int argc;
+  uint32_t id;
+  char const **const argv = server_recv( conn, fds, &argc, &id );
+  if ( argv == NULL )
+    _exit( EX_PROTOCOL );
+
+  //
+  // Hand the connection to the server that sends our exit status to the
+  // client once it reaps us and receives any further requests from it.
+  //
+  server_handoff_t const handoff = { .pid = getpid(), .id = id };
+  union {
+    struct cmsghdr  align;
+    char            buf[ CMSG_SPACE( sizeof conn ) ];
+  } control;
+  MEM_ZERO( &control );
+  struct iovec iov = { .iov_base = CONST_CAST( server_handoff_t*, &handoff ),
+                       .iov_len = sizeof handoff };
+  struct msghdr msg = {
+    .msg_iov = &iov,
+    .msg_iovlen = 1,
+    .msg_control = control.buf,
+    .msg_controllen = sizeof control.buf
+  };
+  struct cmsghdr *const cmsg = CMSG_FIRSTHDR( &msg );
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN( sizeof conn );
+  memcpy( CMSG_DATA( cmsg ), &conn, sizeof conn );
+  if ( sendmsg( ctl, &msg, 0 ) != STATIC_CAST( ssize_t, sizeof handoff ) )
+    _exit( EX_OSERR );
+  close( ctl );
+  close( conn );
+
+  server_adopt( prog, fds, argc, argv, pargc, pargv );
+}
+
+/**
+ * Signal handler for the signals server_run() waits for that just notes
+ * whether the server should quit and wakes it up.
+ *
+ * @param sig The signal number.
+ */
+static void server_signal( int sig ) {
+  int const saved_errno = errno;
+  if ( sig != SIGCHLD )
+    server_quit = 1;
+  PJL_DISCARD_RV( write( signal_pipe[1], "", 1 ) );
+  errno = saved_errno;
+}
+
+/**
+ * Creates, binds, and listens on the server's socket at \a path.  Exits on
+ * error, including if a server is already running there.
+ *
+ * @param path The path of the socket.
+ * @return Returns the listening socket.
+ */
+NODISCARD
+static int server_listen( char const *path ) {
+  assert( path != NULL );
+
+  struct sockaddr_un addr;
+  if ( !server_addr( path, &addr ) )
+    fatal_error( EX_USAGE, "\"%s\": socket path too long\n", path );
+  int const sock = socket( AF_UNIX, SOCK_STREAM, 0 );
+  PERROR_EXIT_IF( sock == -1, EX_OSERR );
+
+  struct stat st;
+  if ( lstat( path, &st ) == 0 && S_ISSOCK( st.st_mode ) ) {
+    if ( connect( sock, POINTER_CAST( struct sockaddr*, &addr ),
+                  sizeof addr ) == 0 ) {
+      fatal_error( EX_UNAVAILABLE, "%s: server already running\n", path );
+    }
+    PJL_DISCARD_RV( unlink( path ) );   // left over from a previous server
+  }
+
+  //
+  // Only the user may connect since a client's request is run as the user
+  // running the server.
+  //
+  mode_t const old_umask = umask( 0077 );
+  int const rv = bind(
+    sock, POINTER_CAST( struct sockaddr const*, &addr ), sizeof addr
+  );
+  umask( old_umask );
+  if ( rv == -1 || listen( sock, SOMAXCONN ) == -1 )
+    fatal_error( EX_CANTCREAT, "%s: %s\n", path, STRERROR() );
+
+  return sock;
+}
+
+/**
+ * Pins the calling process, a shard of the server, to one CPU: the \a
+ * shard'th (modulo their number) of those it may run on.  Every worker it
+ * forks inherits the pinning.
+ *
+ * @param shard The shard's index.
+ *
+ * @sa server_unpin()
+ */
+static void server_pin( size_t shard ) {
+#if HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY
+  if ( sched_getaffinity( 0, sizeof server_cpus, &server_cpus ) == -1 )
+    return;
+  int const cpus_len = CPU_COUNT( &server_cpus );
+  if ( cpus_len < 2 )
+    return;
+  shard %= STATIC_CAST( size_t, cpus_len );
+  for ( size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+    if ( CPU_ISSET( cpu, &server_cpus ) && shard-- == 0 ) {
+      cpu_set_t cpus;
+      CPU_ZERO( &cpus );
+      CPU_SET( cpu, &cpus );
+      server_pinned = sched_setaffinity( 0, sizeof cpus, &cpus ) == 0;
+      return;
+    }
+  } // for
+#else
+  (void)shard;
+#endif /* HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY */
+}
+
+/**
+ * Undoes server_pin() for the calling process, if pinned, so it may again run
+ * on any of the CPUs the server may.
+ */
+static void server_unpin( void ) {
+#if HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY
+  if ( server_pinned ) {
+    PJL_DISCARD_RV( sched_setaffinity( 0, sizeof server_cpus, &server_cpus ) );
+    server_pinned = false;
+  }
+#endif /* HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY */
+}
+
+/**
+ * Creates the pipe that server_signal() writes to and sets it as the handler
+ * of the signals the server waits for.  A shard calls this again so that it
+ * has a pipe of its own.
+ */
+static void server_signals_init( void ) {
+  PIPE( signal_pipe );
+  PERROR_EXIT_IF(
+    fcntl( signal_pipe[0], F_SETFL, O_NONBLOCK ) == -1 ||
+    fcntl( signal_pipe[1], F_SETFL, O_NONBLOCK ) == -1,
+    EX_OSERR
+  );
+  struct sigaction sa = { .sa_handler = &server_signal };
+  sigemptyset( &sa.sa_mask );
+  for ( size_t i = 0; i < ARRAY_SIZE( SERVER_SIGNALS ); ++i ) {
+    PERROR_EXIT_IF(
+      sigaction( SERVER_SIGNALS[i], &sa, NULL ) == -1, EX_OSERR
+    );
+  } // for
+}
+
+/**
+ * Runs the event loop of the server or of one of its shards: keeps a pool of
+ * idle workers, each waiting to accept a connection on \a sock and run its
+ * first request, and, as each worker that ran a request exits, sends its exit
+ * status to its client.  Further requests a client sends on the same
+ * connection without waiting are received by the loop and each run by a
+ * worker forked for it, up to \a jobs_max at a time.  Upon `SIGHUP`,
+ * `SIGINT`, or `SIGTERM`, stops accepting connections and requests, lets the
+ * requests being run finish, and exits.
+ *
+ * @param sock The listening socket.
+ * @param path The path of the socket to remove upon quitting or NULL if this
+ * is a shard (whose parent removes it).
+ * @param jobs_max The maximum number of requests to run at a time.
+ * @param prog The name of the program.
+ * @param pargc A pointer to receive a request's argument count.
+ * @param pargv A pointer to receive a request's argument values.
+ *
+ * @note Returns only in a worker.
+ */
+static void server_loop( int sock, char const *path, size_t jobs_max,
+                         char const *prog, int *pargc,
+                         char const **pargv[] ) {
+  assert( sock != -1 );
+
+  int ctl[2];                           // [0] = server, [1] = workers
+  PERROR_EXIT_IF( socketpair( AF_UNIX, SOCK_DGRAM, 0, ctl ) == -1, EX_OSERR );
+
+  // conns always has room for a terminating fd of -1 for server_child_init().
+  server_conn_t *conns = MALLOC( server_conn_t, 1 );
+  size_t conns_len = 0;
+  conns[0].fd = -1;
+  server_worker_t *workers = NULL;
+  size_t workers_len = 0, workers_cap = 0;
+  size_t n_idle = 0;
+  struct pollfd *pfds = NULL;
+
+  for (;;) {
+    if ( server_quit && sock != -1 ) {
+      if ( path != NULL )
+        PJL_DISCARD_RV( unlink( path ) );
+      close( sock );
+      sock = -1;
+      for ( size_t i = 0; i < workers_len; ++i ) {
+        if ( workers[i].conn == -1 )
+          PJL_DISCARD_RV( kill( workers[i].pid, SIGTERM ) );
+      } // for
+      for ( size_t i = 0; i < conns_len; ++i )
+        conns[i].is_eof = true;
+    }
+
+    //
+    // Close connections from clients that will send no more requests once
+    // all of their requests have been run.
+    //
+    for ( size_t i = 0; i < conns_len; ) {
+      if ( conns[i].is_eof && conns[i].running == 0 ) {
+        close( conns[i].fd );
+        conns[i] = conns[ --conns_len ];
+        conns[ conns_len ].fd = -1;
+      }
+      else {
+        ++i;
+      }
+    } // for
+
+    if ( sock == -1 && workers_len == 0 )
+      exit( EX_OK );
+
+    //
+    // While requests are running, replace idle workers only as needed so
+    // forking doesn't compete with them; otherwise, fill the pool.
+    //
+    while ( sock != -1 &&
+            n_idle < (workers_len == n_idle ? SERVER_IDLE_MAX : 1) ) {
+      pid_t const pid = fork();
+      if ( pid == 0 ) {
+        server_child_init( conns, workers );
+        close( ctl[0] );
+        FREE( pfds );
+        server_worker( sock, ctl[1], prog, pargc, pargv );
+        return;
+      }
+      if ( pid == -1 ) {
+        EPRINTF( "%s: %s\n", me, STRERROR() );
+        break;
+      }
+      if ( workers_len == workers_cap ) {
+        workers_cap = workers_cap == 0 ? SERVER_IDLE_MAX * 2 : workers_cap * 2;
+        REALLOC( workers, server_worker_t, workers_cap );
+      }
+      workers[ workers_len++ ] = (server_worker_t){ .pid = pid, .conn = -1 };
+      ++n_idle;
+    } // while
+
+    //
+    // Receive further requests from clients only while fewer requests than
+    // CPUs are running; otherwise, they wait in their connections.
+    //
+    size_t pfds_len = 0;
+    REALLOC( pfds, struct pollfd, 2 + conns_len );
+    pfds[ pfds_len++ ] = (struct pollfd){ .fd = ctl[0], .events = POLLIN };
+    pfds[ pfds_len++ ] =
+      (struct pollfd){ .fd = signal_pipe[0], .events = POLLIN };
+    size_t const conns_polled =
+      workers_len - n_idle < jobs_max ? conns_len : 0;
+    for ( size_t i = 0; i < conns_polled; ++i ) {
+      pfds[ pfds_len++ ] = (struct pollfd){
+        .fd = conns[i].is_eof ? -1 : conns[i].fd,
+        .events = POLLIN
+      };
+    } // for
+    if ( poll( pfds, pfds_len, /*timeout=*/-1 ) == -1 ) {
+      if ( errno == EINTR )
+        continue;
+      perror_exit( EX_OSERR );
+    }
+
+    for ( size_t i = 0; i < conns_polled; ++i ) {
+      server_conn_t *const conn = &conns[i];
+      if ( pfds[ 2 + i ].revents == 0 || workers_len - n_idle >= jobs_max )
+        continue;
+      int fds[ SERVER_FDS ];
+      int argc;
+      uint32_t id;
+      char const **const argv = server_recv( conn->fd, fds, &argc, &id );
+      if ( argv == NULL ) {
+        conn->is_eof = true;
+        continue;
+      }
+      pid_t const pid = fork();
+      if ( pid == 0 ) {
+        server_child_init( conns, workers );
+        close( ctl[0] );
+        close( ctl[1] );
+        if ( sock != -1 )
+          close( sock );
+        FREE( pfds );
+        server_unpin();                 // spread a batch across CPUs
+        server_adopt( prog, fds, argc, argv, pargc, pargv );
+        return;
+      }
+      for ( size_t j = 0; j < SERVER_FDS; ++j )
+        close( fds[j] );
+      FREE( argv[0] );
+      FREE( argv );
+      if ( pid == -1 ) {
+        EPRINTF( "%s: %s\n", me, STRERROR() );
+        server_send_response( conn->fd, id, EX_OSERR );
+        continue;
+      }
+      if ( workers_len == workers_cap ) {
+        workers_cap = workers_cap == 0 ? SERVER_IDLE_MAX * 2 : workers_cap * 2;
+        REALLOC( workers, server_worker_t, workers_cap );
+      }
+      workers[ workers_len++ ] =
+        (server_worker_t){ .pid = pid, .conn = conn->fd, .id = id };
+      ++conn->running;
+    } // for
+
+    //
+    // Always receive workers' connections before reaping since a worker may
+    // already have exited by the time its connection is received.
+    //
+    for (;;) {
+      server_handoff_t handoff;
+      int conn;
+      union {
+        struct cmsghdr  align;
+        char            buf[ CMSG_SPACE( sizeof conn ) ];
+      } control;
+      struct iovec iov = { .iov_base = &handoff, .iov_len = sizeof handoff };
+      struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = control.buf,
+        .msg_controllen = sizeof control.buf
+      };
+      if ( recvmsg( ctl[0], &msg, MSG_DONTWAIT ) == -1 ) {
+        if ( errno == EINTR )
+          continue;
+        break;
+      }
+      struct cmsghdr const *const cmsg = CMSG_FIRSTHDR( &msg );
+      if ( cmsg == NULL || cmsg->cmsg_type != SCM_RIGHTS )
+        continue;
+      memcpy( &conn, CMSG_DATA( cmsg ), sizeof conn );
+      server_worker_t *const worker =
+        server_worker_find( workers, workers_len, handoff.pid );
+      if ( worker == NULL || worker->conn != -1 ) {
+        close( conn );
+        continue;
+      }
+      worker->conn = conn;
+      worker->id = handoff.id;
+      --n_idle;
+      REALLOC( conns, server_conn_t, conns_len + 2 );
+      conns[ conns_len++ ] = (server_conn_t){
+        .fd = conn, .running = 1, .is_eof = sock == -1
+      };
+      conns[ conns_len ].fd = -1;
+    } // for
+
+    char drain[ 64 ];
+    while ( read( signal_pipe[0], drain, sizeof drain ) > 0 )
+      ;
+    int wstatus;
+    for ( pid_t pid; (pid = waitpid( -1, &wstatus, WNOHANG )) > 0; ) {
+      server_worker_t *const worker =
+        server_worker_find( workers, workers_len, pid );
+      if ( worker == NULL )
+        continue;
+      if ( worker->conn == -1 ) {
+        --n_idle;
+      }
+      else {
+        server_send_response( worker->conn, worker->id,
+          WIFEXITED( wstatus ) ? WEXITSTATUS( wstatus ) :
+          WIFSIGNALED( wstatus ) ? 128 + WTERMSIG( wstatus ) : EX_SOFTWARE
+        );
+        server_conn_t *const conn =
+          server_conn_find( conns, conns_len, worker->conn );
+        assert( conn != NULL );
+        --conn->running;
+      }
+      *worker = workers[ --workers_len ];
+    } // for
+  } // for
+}
+
+/**
+ * Runs the server: listens on the socket at \a path and runs its event loop
+ * via server_loop().  If `WRAP_SERVER_SHARDS` is more than 1 (or is 0 for one
+ * per CPU), instead forks that many shards, each pinned to its own CPU and
+ * running its own event loop with its own pool of workers on the same socket
+ * so that the kernel spreads connections among them and a connection is
+ * handled entirely by the shard whose worker accepted it; the server itself
+ * just waits for them.  Upon `SIGHUP`, `SIGINT`, or `SIGTERM`, tells every
+ * shard to quit and exits once they all have.
+ *
+ * @param path The path of the socket.
+ * @param prog The name of the program.
+ * @param preset The function to call once before forking any worker or NULL.
+ * @param pargc A pointer to receive a request's argument count.
+ * @param pargv A pointer to receive a request's argument values.
+ *
+ * @note Returns only in a worker.
+ */
+static void server_run( char const *path, char const *prog,
+                        void (*preset)( void ), int *pargc,
+                        char const **pargv[] ) {
+  assert( path != NULL );
+
+  int const sock = server_listen( path );
+  server_signals_init();
+  // A client may close its connection before it gets all its responses.
+  PJL_DISCARD_RV( signal( SIGPIPE, SIG_IGN ) );
+
+  //
+  // Pay what start-up costs can be paid in advance once, here, so every
+  // worker inherits them already paid.
+  //
+  PJL_DISCARD_RV( try_setlocale_utf8() );
+  if ( preset != NULL )
+    (*preset)();
+
+  long const cpus = sysconf( _SC_NPROCESSORS_ONLN );
+  size_t jobs_max = cpus > 0 ? STATIC_CAST( size_t, cpus ) : 1;
+  char const *const jobs = getenv( "WRAP_SERVER_JOBS" );
+  if ( jobs != NULL && *jobs != '\0' ) {
+    jobs_max = check_atou( jobs );
+    if ( jobs_max == 0 ) {
+      fatal_error( EX_USAGE,
+        "\"%s\": invalid value for WRAP_SERVER_JOBS; must be at least 1\n",
+        jobs
+      );
+    }
+  }
+
+  size_t shards = 1;
+  char const *const shards_env = getenv( "WRAP_SERVER_SHARDS" );
+  if ( shards_env != NULL && *shards_env != '\0' ) {
+    shards = check_atou( shards_env );
+    if ( shards == 0 )
+      shards = cpus > 0 ? STATIC_CAST( size_t, cpus ) : 1;
+  }
+  if ( shards == 1 ) {
+    server_loop( sock, path, jobs_max, prog, pargc, pargv );
+    return;                             // in a worker
+  }
+
+  //
+  // Requests are spread among the shards, so each runs its share of them.
+  //
+  jobs_max = (jobs_max + shards - 1) / shards;
+
+  pid_t *const pids = MALLOC( pid_t, shards );
+  size_t pids_len = 0;
+  for ( size_t i = 0; i < shards; ++i ) {
+    pid_t const pid = fork();
+    if ( pid == 0 ) {
+      FREE( pids );
+      close( signal_pipe[0] );
+      close( signal_pipe[1] );
+      server_signals_init();
+      server_pin( i );
+      server_loop( sock, /*path=*/NULL, jobs_max, prog, pargc, pargv );
+      return;                           // in a worker
+    }
+    if ( pid == -1 ) {
+      EPRINTF( "%s: %s\n", me, STRERROR() );
+      server_quit = 1;
+      break;
+    }
+    pids[ pids_len++ ] = pid;
+  } // for
+  close( sock );
+
+  for ( bool is_quitting = false; pids_len > 0; ) {
+    if ( server_quit && !is_quitting ) {
+      PJL_DISCARD_RV( unlink( path ) );
+      for ( size_t i = 0; i < pids_len; ++i )
+        PJL_DISCARD_RV( kill( pids[i], SIGTERM ) );
+      is_quitting = true;
+    }
+    struct pollfd pfd = { .fd = signal_pipe[0], .events = POLLIN };
+    if ( poll( &pfd, 1, /*timeout=*/-1 ) == -1 && errno != EINTR )
+      perror_exit( EX_OSERR );
+    char drain[ 64 ];
+    while ( read( signal_pipe[0], drain, sizeof drain ) > 0 )
+      ;
+    int wstatus;
+    for ( pid_t pid; (pid = waitpid( -1, &wstatus, WNOHANG )) > 0; ) {
+      for ( size_t i = 0; i < pids_len; ++i ) {
+        if ( pids[i] == pid ) {
+          pids[i] = pids[ --pids_len ];
+          break;
+        }
+      } // for
+    } // for
+  } // for
+  FREE( pids );
+  exit( EX_OK );
+}
+
+#endif /* WITH_SERVER */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+int server_connect( char const *path ) {
+  assert( path != NULL );
+#ifdef WITH_SERVER
+  struct sockaddr_un addr;
+  if ( !server_addr( path, &addr ) )
+    return -1;
+  int const sock = socket( AF_UNIX, SOCK_STREAM, 0 );
+  if ( sock == -1 )
+    return -1;
+  if ( connect( sock, POINTER_CAST( struct sockaddr*, &addr ),
+                sizeof addr ) == -1 ) {
+    close( sock );
+    return -1;
+  }
+  return sock;
+#else
+  return -1;
+#endif /* WITH_SERVER */
+}
+
+void server_main( char const *prog, void (*preset)( void ), int *pargc,
+                  char const **pargv[] ) {
+  assert( prog != NULL );
+  assert( pargc != NULL );
+  assert( pargv != NULL );
+
+  int const argc = *pargc;
+  char const **const argv = *pargv;
+  if ( argc < 2 )
+    return;
+
+  char const *path;
+  bool is_server;
+  if ( strncmp( argv[1], SERVER_OPT_SERVER,
+                sizeof SERVER_OPT_SERVER - 1 ) == 0 ) {
+    path = argv[1] + sizeof SERVER_OPT_SERVER - 1;
+    is_server = true;
+  }
+  else if ( strncmp( argv[1], SERVER_OPT_CLIENT,
+                     sizeof SERVER_OPT_CLIENT - 1 ) == 0 ) {
+    path = argv[1] + sizeof SERVER_OPT_CLIENT - 1;
+    is_server = false;
+  }
+  else {
+    return;
+  }
+
+  me = base_name( argv[0] );
+  if ( *path == '\0' )
+    fatal_error( EX_USAGE, "\"%s\": socket path expected\n", argv[1] );
+
+#ifdef WITH_SERVER
+  if ( is_server ) {
+    if ( argc > 2 )
+      fatal_error( EX_USAGE, "%s: no other options allowed\n", argv[1] );
+    server_run( path, prog, preset, pargc, pargv );
+    return;                             // in a worker
+  }
+  //
+  // Send the client's argv[0], but not the --client option itself.
+  //
+  argv[1] = argv[0];
+  server_client( prog, path, argc - 1, argv + 1 );
+#else
+  if ( is_server )
+    fatal_error( EX_UNAVAILABLE, "server mode not supported on this system\n" );
+  argv[1] = argv[0];
+#endif /* WITH_SERVER */
+
+  // No server: run locally without the --client option.
+  *pargc = argc - 1;
+  *pargv = argv + 1;
+}
+
+bool server_request_send( int sock, uint32_t id, char const *prog,
+                          int argc, char const *const argv[],
+                          int const fds[] ) {
+  assert( prog != NULL );
+  assert( argv != NULL );
+  assert( fds != NULL );
+#ifdef WITH_SERVER
+  uint32_t envc = 0;
+  size_t strings_len = strlen( prog ) + 1;
+  for ( int i = 0; i < argc; ++i )
+    strings_len += strlen( argv[i] ) + 1;
+  for ( char **env = environ; *env != NULL; ++env, ++envc )
+    strings_len += strlen( *env ) + 1;
+  if ( strings_len > SERVER_STRINGS_MAX )
+    return false;
+
+  char *const strings = MALLOC( char, strings_len );
+  char *s = strings;
+  s += strcpy_len( s, prog ) + 1;
+  for ( int i = 0; i < argc; ++i )
+    s += strcpy_len( s, argv[i] ) + 1;
+  for ( char **env = environ; *env != NULL; ++env )
+    s += strcpy_len( s, *env ) + 1;
+
+  server_request_t request = {
+    .version = SERVER_VERSION,
+    .id = id,
+    .argc = STATIC_CAST( uint32_t, argc ),
+    .envc = envc,
+    .strings_len = STATIC_CAST( uint32_t, strings_len )
+  };
+  size_t const fds_size = SERVER_FDS * sizeof fds[0];
+  union {
+    struct cmsghdr  align;
+    char            buf[ CMSG_SPACE( SERVER_FDS * sizeof(int) ) ];
+  } control;
+  MEM_ZERO( &control );
+  struct iovec iov = { .iov_base = &request, .iov_len = sizeof request };
+  struct msghdr msg = {
+    .msg_iov = &iov,
+    .msg_iovlen = 1,
+    .msg_control = control.buf,
+    .msg_controllen = sizeof control.buf
+  };
+  struct cmsghdr *const cmsg = CMSG_FIRSTHDR( &msg );
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN( fds_size );
+  memcpy( CMSG_DATA( cmsg ), fds, fds_size );
+
+  ssize_t n;
+  while ( (n = sendmsg( sock, &msg, 0 )) == -1 && errno == EINTR )
+    ;
+  bool const sent = n == STATIC_CAST( ssize_t, sizeof request ) &&
+    fd_write( sock, strings, strings_len ) == 0;
+  FREE( strings );
+  return sent;
+#else
+  (void)sock;
+  (void)id;
+  (void)argc;
+  return false;
+#endif /* WITH_SERVER */
+}
+
+bool server_response_recv( int sock, uint32_t *pid, int *pstatus ) {
+  assert( pid != NULL );
+  assert( pstatus != NULL );
+#ifdef WITH_SERVER
+  server_response_t response;
+  if ( !server_read( sock, &response, sizeof response ) )
+    return false;
+  *pid = response.id;
+  *pstatus = response.status;
+  return true;
+#else
+  (void)sock;
+  return false;
+#endif /* WITH_SERVER */
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
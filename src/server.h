@@ -0,0 +1,172 @@
+/*
+**      wrap -- text reformatter
+**      src/server.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_server_H
+#define wrap_server_H
+
+/**
+ * @file
+ * Declares the functions implementing the server and client modes of
+ * **wrap**(1) and **wrapc**(1).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stdint.h>                     /* for uint32_t */
+
+/// @endcond
+
+/**
+ * @defgroup server-group Server and Client Modes
+ * A persistent server that runs requests from clients over a Unix domain
+ * socket so that a client is spared the start-up costs that the server has
+ * already paid once.
+ *
+ * @remarks A client sends its program name, command-line arguments, and
+ * environment along with its standard input, output, and error and current
+ * directory as file descriptors.  The server keeps a small pool of idle
+ * workers, each a fork of the server, waiting to accept a request.  A worker
+ * that accepts one hands its connection to the server, adopts all of the
+ * client's as its own, and returns from server_main() to run exactly as if it
+ * had been executed by the client; when the server reaps the worker, it sends
+ * the worker's exit status back to the client that exits with it.  Since each
+ * worker is a fresh copy of the server, requests share no state and so any
+ * options can be used.
+ *
+ * @remarks Since a client's standard input and output are sent as file
+ * descriptors, a document itself never crosses the socket: a worker reads and
+ * writes the client's files directly.  A client on the same host holding a
+ * large document in memory can therefore put it in a **memfd_create**(2) file
+ * (or any regular file) sent as its standard input, which a worker
+ * memory-maps rather than reads, and receive the output in another sent as
+ * its standard output, which it may then memory-map in turn, so the document
+ * is never copied between the processes.
+ *
+ * @remarks A client may also send any number of requests on the same
+ * connection without waiting for any to finish, e.g., one per file to
+ * reformat, then shut down its side of the connection.  Each request carries
+ * an ID chosen by the client; each response carries the ID of its request
+ * along with its exit status and is sent as soon as the request finishes, so
+ * responses may be in any order.  The first request is run by the idle worker
+ * that accepted the connection; the server receives each of the rest itself
+ * and runs it in a worker forked for it, up to one request per CPU at a time
+ * (further requests wait in the connection), so a batch of requests is spread
+ * across CPUs.  Since the server may stop receiving requests until some
+ * finish, a client must read responses while it's still sending requests.
+ *
+ * @remarks So that a single event loop doesn't become the bottleneck when
+ * many clients connect at once to a server on a host with many CPUs, the
+ * server may be split into shards (via `WRAP_SERVER_SHARDS`): each is a fork
+ * of the server pinned to its own CPU that runs its own event loop with its
+ * own pool of workers (and so its own memory) accepting connections on the
+ * same listening socket.  Whichever shard's worker accepts a connection
+ * handles it entirely, so connections don't cross shards.  (Unix domain
+ * sockets don't support `SO_REUSEPORT`, so the shards share one socket
+ * rather than each binding its own.)
+ * @{
+ */
+
+/**
+ * The file descriptors a client sends: its standard input, output, and error
+ * and its current directory, in that order.
+ */
+#define SERVER_FDS                4
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Connects to the server whose socket is at \a path as a client.
+ *
+ * @param path The path of the server's socket.
+ * @return Returns the connection or -1 if the server isn't running or servers
+ * aren't supported on this system.
+ *
+ * @sa server_request_send()
+ * @sa server_response_recv()
+ */
+NODISCARD
+int server_connect( char const *path );
+
+/**
+ * Handles the `--server` and `--client` modes, either of which must be the
+ * first command-line argument.
+ *
+ * + `--server=`_socket_: Never returns in the server itself; returns only in
+ *   a worker with \a pargc and \a pargv set to those of the request.
+ * + `--client=`_socket_: If the server is running, never returns; otherwise
+ *   returns with the `--client` argument removed so the request is run
+ *   locally.
+ *
+ * Otherwise, returns having done nothing.
+ *
+ * @param prog The name of the program, either `wrap` or `wrapc`.  A server
+ * runs requests only from clients of the same program.
+ * @param preset A function a server calls once before forking any worker to
+ * prepare what every worker then inherits already prepared, or NULL.
+ * @param pargc A pointer to the command-line argument count from main().
+ * @param pargv A pointer to the command-line argument values from main().
+ */
+void server_main( char const *prog, void (*preset)( void ), int *pargc,
+                  char const **pargv[] );
+
+/**
+ * Sends a request as a client along with the client's environment.  Any
+ * number of requests may be sent on the same connection without waiting for
+ * any to finish, but their responses must be received via
+ * server_response_recv() while sending.
+ *
+ * @param sock The connection gotten from server_connect().
+ * @param id The ID of the request that its response carries.
+ * @param prog The name of the program, either `wrap` or `wrapc`.
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values starting with the program's.
+ * @param fds The #SERVER_FDS file descriptors to run the request with.
+ * @return Returns `true` only if the request was sent.
+ */
+NODISCARD
+bool server_request_send( int sock, uint32_t id, char const *prog,
+                          int argc, char const *const argv[],
+                          int const fds[] );
+
+/**
+ * Receives the response to a request sent via server_request_send().
+ * Responses to requests sent on the same connection may be received in any
+ * order.
+ *
+ * @param sock The connection gotten from server_connect().
+ * @param pid A pointer to receive the ID of the request.
+ * @param pstatus A pointer to receive the exit status of the request.
+ * @return Returns `true` only if a response was received; `false` if the
+ * server closed the connection.
+ */
+NODISCARD
+bool server_response_recv( int sock, uint32_t *pid, int *pstatus );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_server_H */
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,538 @@
+/*
+**      wrap -- text reformatter
+**      src/server_bench.c
+**
+**      Copyright (C) 2026  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Load-tests the server mode of **wrap**(1): starts a server, then has many
+ * concurrent clients each send it requests over its own connection, one at a
+ * time, as an editor would, for a mix of editor-sized snippets (plain text
+ * and Markdown) and an occasional large file.  The latency of each request,
+ * from sending it to receiving its response, is measured and the 50th, 95th,
+ * 99th, and 99.9th percentiles and maximum are printed for all requests and
+ * for each kind of document along with the throughput.
+ *
+ * Given a budget for the 99th percentile latency, the exit status is non-zero
+ * if it's exceeded or if any request failed, so it can be used as a
+ * regression check.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "server.h"
+#include "util.h"
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>                      /* for open(2) */
+#include <poll.h>
+#include <signal.h>                     /* for kill(2) */
+#include <stdbool.h>
+#include <stdint.h>                     /* for uint32_t, uint64_t */
+#include <stdio.h>
+#include <stdlib.h>                     /* for mkdtemp(3), qsort(3) */
+#include <string.h>
+#include <sys/socket.h>                 /* for shutdown(2) */
+#include <sys/wait.h>                   /* for waitpid(2) */
+#include <sysexits.h>
+#include <unistd.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The kinds of documents requests are for.
+ */
+enum bench_kind {
+  BENCH_SNIPPET,                        ///< Editor-sized snippet.
+  BENCH_LARGE                           ///< Large file.
+};
+typedef enum bench_kind bench_kind_t;
+
+/**
+ * A client sending requests over its own connection one at a time.
+ */
+struct bench_client {
+  int           sock;                   ///< Connection or -1 if done.
+  unsigned      left;                   ///< Number of requests left to send.
+  uint32_t      id;                     ///< ID of the outstanding request.
+  bench_kind_t  kind;                   ///< Kind of the outstanding request.
+  uint64_t      start_ns;               ///< When it was sent.
+};
+typedef struct bench_client bench_client_t;
+
+/**
+ * The latencies of requests of one kind.
+ */
+struct bench_lat {
+  uint64_t   *ns;                       ///< Latencies in nanoseconds.
+  size_t      len;                      ///< Number of latencies.
+};
+typedef struct bench_lat bench_lat_t;
+
+// local constant definitions
+static unsigned const BENCH_CLIENTS_DEFAULT = 16;
+static unsigned const BENCH_LARGE_PCT_DEFAULT = 5;
+static unsigned const BENCH_LARGE_SIZE_DEFAULT = 1024;  ///< In KB.
+static unsigned const BENCH_LINE_LEN = 72;
+static unsigned const BENCH_REQUESTS_DEFAULT = 100;
+static unsigned const BENCH_SNIPPET_SIZE_MAX = 4096;
+static unsigned const BENCH_SNIPPETS = 16;
+static unsigned const BENCH_START_TRIES = 500;          ///< 10ms apart.
+
+/// Words to generate text from.
+static char const *const BENCH_WORDS[] = {
+  "the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog.",
+  "It's", "well-known", "that", "text", "reformatting", "is", "hard!", "See",
+  "section", "3.4:", "(aside)", "and", "re-wrap", "e.g.,", "paragraphs", "a",
+  "of", "to", "in", "is", "it", "\"quoted.\"", "Why?", "naïve", "café",
+  "日本語の", "文章を", "emoji🙂",
+  NULL
+};
+
+/// Percentiles to print, in tenths of a percent.
+static unsigned const BENCH_PERMILLES[] = { 500, 950, 990, 999 };
+
+/// Arguments of a request for a plain text snippet or a large file.
+static char const *const BENCH_ARGV_PLAIN[] = { "wrap", "-w72" };
+
+/// Arguments of a request for a Markdown snippet.
+static char const *const BENCH_ARGV_MARKDOWN[] = {
+  "wrap", "--markdown", "-w72"
+};
+
+// local variable definitions
+static int          bench_cwd_fd;       ///< Current directory.
+static char         bench_dir[] = "/tmp/server_bench.XXXXXX";
+static int          bench_null_fd;      ///< `/dev/null` for output.
+static char         bench_path[ sizeof bench_dir + 32 ];  ///< Scratch path.
+static char         bench_sock_path[ sizeof bench_dir + 8 ];  ///< Socket.
+static size_t       bench_sizes[ BENCH_LARGE + 1 ];  ///< Bytes per kind.
+
+// extern variable definitions
+char const         *me;                 ///< Program name.
+
+// local functions
+static void         bench_cleanup( unsigned );
+
+NODISCARD
+static char const*  bench_doc_path( unsigned );
+
+static void         bench_gen( unsigned, size_t, bool );
+
+NODISCARD
+static int          bench_ns_cmp( void const*, void const* );
+
+static void         bench_print( char const*, bench_lat_t* );
+
+NODISCARD
+static unsigned     bench_rand( void );
+
+static void         bench_send( bench_client_t*, unsigned );
+
+NODISCARD
+static pid_t        bench_server_start( char const*, unsigned );
+
+_Noreturn
+static void         usage( void );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Removes the generated documents, the server's socket, and the directory
+ * containing them.
+ *
+ * @param docs The number of generated documents.
+ */
+static void bench_cleanup( unsigned docs ) {
+  for ( unsigned i = 0; i < docs; ++i )
+    PJL_DISCARD_RV( unlink( bench_doc_path( i ) ) );
+  PJL_DISCARD_RV( unlink( bench_sock_path ) );
+  PJL_DISCARD_RV( rmdir( bench_dir ) );
+}
+
+/**
+ * Gets the path of a generated document.
+ *
+ * @param i The index of the document: the snippets are first and the large
+ * file is last.
+ * @return Returns said path that is valid only until the next call.
+ */
+static char const* bench_doc_path( unsigned i ) {
+  snprintf( bench_path, sizeof bench_path, "%s/doc-%02u.txt", bench_dir, i );
+  return bench_path;
+}
+
+/**
+ * Generates a document of paragraphs of lines, each about \ref BENCH_LINE_LEN
+ * bytes long, written as if by an author who hand-wrapped them unevenly.
+ *
+ * @param i The index of the document.
+ * @param size The approximate number of bytes to generate.
+ * @param is_markdown If `true`, also generate Markdown headings and lists.
+ */
+static void bench_gen( unsigned i, size_t size, bool is_markdown ) {
+  size_t n_words = 0;
+  while ( BENCH_WORDS[ n_words ] != NULL )
+    ++n_words;
+
+  FILE *const file = fopen( bench_doc_path( i ), "w" );
+  PERROR_EXIT_IF( file == NULL, EX_CANTCREAT );
+
+  size_t len = 0;
+  unsigned para_lines = 0;
+  while ( len < size ) {
+    if ( is_markdown && para_lines == 0 ) {
+      if ( bench_rand() % 4 == 0 )
+        len += STATIC_CAST( size_t, fprintf( file, "## Section %u\n\n", i ) );
+      else if ( bench_rand() % 2 == 0 )
+        len += STATIC_CAST( size_t, fprintf( file, "* " ) );
+    }
+    unsigned const line_len =
+      BENCH_LINE_LEN / 2 + bench_rand() % BENCH_LINE_LEN;
+    size_t line = 0;
+    do {
+      if ( line > 0 )
+        line += STATIC_CAST( size_t, fprintf( file, " " ) );
+      line += STATIC_CAST( size_t,
+        fprintf( file, "%s", BENCH_WORDS[ bench_rand() % n_words ] )
+      );
+    } while ( line < line_len );
+    len += line + STATIC_CAST( size_t, fprintf( file, "\n" ) );
+    if ( ++para_lines > 2 && bench_rand() % 6 == 0 ) {
+      len += STATIC_CAST( size_t, fprintf( file, "\n" ) );
+      para_lines = 0;
+    }
+  } // while
+
+  PERROR_EXIT_IF( fclose( file ) != 0, EX_IOERR );
+}
+
+/**
+ * Comparison function for **qsort**(3) that compares two latencies.
+ *
+ * @param i_data A pointer to the first latency.
+ * @param j_data A pointer to the second latency.
+ * @return Returns an integer less than zero, zero, or greater than zero if
+ * the first latency is less than, equal to, or greater than the second,
+ * respectively.
+ */
+static int bench_ns_cmp( void const *i_data, void const *j_data ) {
+  uint64_t const i_ns = *STATIC_CAST( uint64_t const*, i_data );
+  uint64_t const j_ns = *STATIC_CAST( uint64_t const*, j_data );
+  return (i_ns > j_ns) - (i_ns < j_ns);
+}
+
+/**
+ * Prints the percentiles and maximum of latencies.
+ *
+ * @param name The name of the kind of requests.
+ * @param lat The latencies to print.  They are sorted.
+ */
+static void bench_print( char const *name, bench_lat_t *lat ) {
+  assert( name != NULL );
+  assert( lat != NULL );
+  if ( lat->len == 0 )
+    return;
+  qsort( lat->ns, lat->len, sizeof lat->ns[0], &bench_ns_cmp );
+  printf( "%-8s  %7zu", name, lat->len );
+  for ( size_t i = 0; i < ARRAY_SIZE( BENCH_PERMILLES ); ++i ) {
+    // The nearest-rank percentile.
+    size_t const rank = (lat->len * BENCH_PERMILLES[i] + 999) / 1000;
+    printf( "  %9.3f", (double)lat->ns[ rank - 1 ] / 1e6 );
+  } // for
+  printf( "  %9.3f\n", (double)lat->ns[ lat->len - 1 ] / 1e6 );
+}
+
+/**
+ * Generates a pseudo-random number via xorshift so that runs are repeatable.
+ *
+ * @return Returns said number.
+ */
+static unsigned bench_rand( void ) {
+  static uint32_t state = 2463534242u;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+/**
+ * Sends a client's next request.
+ *
+ * @param client The \ref bench_client to send a request for.
+ * @param large_pct The percentage of requests that are for the large file.
+ */
+static void bench_send( bench_client_t *client, unsigned large_pct ) {
+  assert( client != NULL );
+  assert( client->left > 0 );
+
+  unsigned doc;
+  char const *const *argv;
+  int argc;
+  if ( bench_rand() % 100 < large_pct ) {
+    client->kind = BENCH_LARGE;
+    doc = BENCH_SNIPPETS;
+    argv = BENCH_ARGV_PLAIN;
+    argc = STATIC_CAST( int, ARRAY_SIZE( BENCH_ARGV_PLAIN ) );
+  }
+  else {
+    client->kind = BENCH_SNIPPET;
+    doc = bench_rand() % BENCH_SNIPPETS;
+    bool const is_markdown = doc % 2 != 0;
+    argv = is_markdown ? BENCH_ARGV_MARKDOWN : BENCH_ARGV_PLAIN;
+    argc = STATIC_CAST( int, is_markdown ?
+      ARRAY_SIZE( BENCH_ARGV_MARKDOWN ) : ARRAY_SIZE( BENCH_ARGV_PLAIN )
+    );
+  }
+
+  int const in_fd = open( bench_doc_path( doc ), O_RDONLY );
+  PERROR_EXIT_IF( in_fd == -1, EX_NOINPUT );
+  int const fds[ SERVER_FDS ] = {
+    in_fd, bench_null_fd, bench_null_fd, bench_cwd_fd
+  };
+  ++client->id;
+  client->start_ns = now_ns();
+  if ( !server_request_send( client->sock, client->id, "wrap", argc, argv,
+                             fds ) ) {
+    fatal_error( EX_UNAVAILABLE, "request not sent: %s\n", STRERROR() );
+  }
+  close( in_fd );
+  if ( --client->left == 0 )
+    PJL_DISCARD_RV( shutdown( client->sock, SHUT_WR ) );
+}
+
+/**
+ * Starts a server and waits until it accepts connections.
+ *
+ * @param wrap_path The path of the **wrap**(1) to run as the server.
+ * @param jobs The value of `WRAP_SERVER_JOBS` to start it with or 0 for its
+ * default.
+ * @return Returns the process ID of the server.
+ */
+static pid_t bench_server_start( char const *wrap_path, unsigned jobs ) {
+  assert( wrap_path != NULL );
+
+  char server_opt[ sizeof bench_sock_path + 16 ];
+  snprintf( server_opt, sizeof server_opt, "--server=%s", bench_sock_path );
+
+  pid_t const pid = fork();
+  PERROR_EXIT_IF( pid == -1, EX_OSERR );
+  if ( pid == 0 ) {
+    if ( jobs > 0 ) {
+      char buf[ 16 ];
+      snprintf( buf, sizeof buf, "%u", jobs );
+      PERROR_EXIT_IF( setenv( "WRAP_SERVER_JOBS", buf, 1 ) == -1, EX_OSERR );
+    }
+    execl( wrap_path, "wrap", server_opt, (char*)NULL );
+    fatal_error( EX_UNAVAILABLE, "%s: %s\n", wrap_path, STRERROR() );
+  }
+
+  for ( unsigned try = 0; try < BENCH_START_TRIES; ++try ) {
+    int const sock = server_connect( bench_sock_path );
+    if ( sock != -1 ) {
+      close( sock );
+      return pid;
+    }
+    int status;
+    if ( waitpid( pid, &status, WNOHANG ) == pid )
+      fatal_error( EX_UNAVAILABLE, "%s: server exited\n", wrap_path );
+    usleep( 10000 );
+  } // for
+  PJL_DISCARD_RV( kill( pid, SIGTERM ) );
+  fatal_error( EX_UNAVAILABLE, "%s: server didn't start\n", wrap_path );
+}
+
+/**
+ * Prints the usage message and exits.
+ */
+static void usage( void ) {
+  EPRINTF(
+    "usage: %s [-b p99-budget-us] [-c clients] [-j jobs] [-l large-percent]\n"
+    "       [-n requests-per-client] [-s large-size-KB] [wrap-path]\n",
+    me
+  );
+  exit( EX_USAGE );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  me = base_name( argv[0] );
+  unsigned budget_us = 0;
+  unsigned clients_len = BENCH_CLIENTS_DEFAULT;
+  unsigned jobs = 0;
+  unsigned large_pct = BENCH_LARGE_PCT_DEFAULT;
+  unsigned large_size_kb = BENCH_LARGE_SIZE_DEFAULT;
+  unsigned requests = BENCH_REQUESTS_DEFAULT;
+
+  int argi = 1;
+  for ( ; argi < argc && argv[ argi ][0] == '-'; argi += 2 ) {
+    if ( argi + 1 == argc )
+      usage();
+    unsigned const value = check_atou( argv[ argi + 1 ] );
+    if ( strcmp( argv[ argi ], "-b" ) == 0 )
+      budget_us = value;
+    else if ( strcmp( argv[ argi ], "-c" ) == 0 )
+      clients_len = value;
+    else if ( strcmp( argv[ argi ], "-j" ) == 0 )
+      jobs = value;
+    else if ( strcmp( argv[ argi ], "-l" ) == 0 )
+      large_pct = value;
+    else if ( strcmp( argv[ argi ], "-n" ) == 0 )
+      requests = value;
+    else if ( strcmp( argv[ argi ], "-s" ) == 0 )
+      large_size_kb = value;
+    else
+      usage();
+  } // for
+  if ( clients_len == 0 || requests == 0 || large_pct > 100 ||
+       large_size_kb == 0 || argc - argi > 1 ) {
+    usage();
+  }
+  char const *const wrap_path = argi < argc ? argv[ argi ] : "./wrap";
+
+  PERROR_EXIT_IF( mkdtemp( bench_dir ) == NULL, EX_CANTCREAT );
+  snprintf( bench_sock_path, sizeof bench_sock_path, "%s/sock", bench_dir );
+  for ( unsigned i = 0; i < BENCH_SNIPPETS; ++i ) {
+    size_t const size = 64 + bench_rand() % BENCH_SNIPPET_SIZE_MAX;
+    bench_gen( i, size, /*is_markdown=*/i % 2 != 0 );
+    bench_sizes[ BENCH_SNIPPET ] += size;
+  } // for
+  bench_gen( BENCH_SNIPPETS, (size_t)large_size_kb * 1024, false );
+  bench_sizes[ BENCH_SNIPPET ] /= BENCH_SNIPPETS;
+  bench_sizes[ BENCH_LARGE ] = (size_t)large_size_kb * 1024;
+
+  bench_cwd_fd = open( ".", O_RDONLY );
+  PERROR_EXIT_IF( bench_cwd_fd == -1, EX_OSERR );
+  bench_null_fd = open( "/dev/null", O_WRONLY );
+  PERROR_EXIT_IF( bench_null_fd == -1, EX_OSERR );
+
+  pid_t const server_pid = bench_server_start( wrap_path, jobs );
+
+  size_t const total = (size_t)clients_len * requests;
+  bench_lat_t lats[ BENCH_LARGE + 1 ] = {
+    { .ns = MALLOC( uint64_t, total ) },
+    { .ns = MALLOC( uint64_t, total ) }
+  };
+  bench_client_t *const clients = MALLOC( bench_client_t, clients_len );
+  struct pollfd *const pfds = MALLOC( struct pollfd, clients_len );
+  size_t bytes = 0, failed = 0;
+
+  uint64_t const start_ns = now_ns();
+  for ( unsigned i = 0; i < clients_len; ++i ) {
+    clients[i] = (bench_client_t){
+      .sock = server_connect( bench_sock_path ),
+      .left = requests
+    };
+    if ( clients[i].sock == -1 )
+      fatal_error( EX_UNAVAILABLE, "%s: can't connect\n", bench_sock_path );
+    pfds[i] = (struct pollfd){ .fd = clients[i].sock, .events = POLLIN };
+    bench_send( &clients[i], large_pct );
+  } // for
+
+  for ( unsigned active = clients_len; active > 0; ) {
+    if ( poll( pfds, clients_len, /*timeout=*/-1 ) == -1 ) {
+      PERROR_EXIT_IF( errno != EINTR, EX_OSERR );
+      continue;
+    }
+    for ( unsigned i = 0; i < clients_len; ++i ) {
+      if ( pfds[i].revents == 0 )
+        continue;
+      bench_client_t *const client = &clients[i];
+      uint32_t id;
+      int status;
+      if ( !server_response_recv( client->sock, &id, &status ) ) {
+        fatal_error( EX_UNAVAILABLE,
+          "%s: server closed connection\n", bench_sock_path
+        );
+      }
+      uint64_t const end_ns = now_ns();
+      if ( id != client->id || status != EX_OK )
+        ++failed;
+      bench_lat_t *const lat = &lats[ client->kind ];
+      lat->ns[ lat->len++ ] = end_ns - client->start_ns;
+      bytes += bench_sizes[ client->kind ];
+      if ( client->left > 0 ) {
+        bench_send( client, large_pct );
+        continue;
+      }
+      close( client->sock );
+      client->sock = pfds[i].fd = -1;
+      --active;
+    } // for
+  } // for
+  uint64_t const elapsed_ns = now_ns() - start_ns;
+
+  PJL_DISCARD_RV( kill( server_pid, SIGTERM ) );
+  PJL_DISCARD_RV( waitpid( server_pid, NULL, 0 ) );
+  bench_cleanup( BENCH_SNIPPETS + 1 );
+
+  bench_lat_t all = { .ns = MALLOC( uint64_t, total ) };
+  for ( size_t k = 0; k < ARRAY_SIZE( lats ); ++k ) {
+    memcpy( all.ns + all.len, lats[k].ns, lats[k].len * sizeof all.ns[0] );
+    all.len += lats[k].len;
+  } // for
+
+  printf( "%u clients, %u requests each, %u%% large (%u KB)",
+          clients_len, requests, large_pct, large_size_kb );
+  if ( jobs > 0 )
+    printf( ", %u jobs", jobs );
+  printf( "\n\n%-8s  %7s  %9s  %9s  %9s  %9s  %9s  (ms)\n",
+          "", "count", "p50", "p95", "p99", "p99.9", "max" );
+  bench_print( "all", &all );
+  bench_print( "snippet", &lats[ BENCH_SNIPPET ] );
+  bench_print( "large", &lats[ BENCH_LARGE ] );
+
+  double const elapsed_s = (double)elapsed_ns / 1e9;
+  printf( "\n%.1f requests/s, %.1f MB/s\n",
+          (double)all.len / elapsed_s,
+          (double)bytes / (1024 * 1024) / elapsed_s );
+  fflush( stdout );                     // before any failure is printed
+
+  // The nearest-rank 99th percentile of all requests.
+  uint64_t const p99_ns = all.ns[ (all.len * 99 + 99) / 100 - 1 ];
+  int status = EX_OK;
+  if ( failed > 0 ) {
+    EPRINTF( "%s: %zu request(s) failed\n", me, failed );
+    status = EX_SOFTWARE;
+  }
+  if ( budget_us > 0 && p99_ns > (uint64_t)budget_us * 1000 ) {
+    EPRINTF( "%s: p99 latency of %.3f ms exceeds budget of %.3f ms\n",
+             me, (double)p99_ns / 1e6, (double)budget_us / 1e3 );
+    status = EX_SOFTWARE;
+  }
+
+  FREE( all.ns );
+  FREE( clients );
+  FREE( lats[ BENCH_LARGE ].ns );
+  FREE( lats[ BENCH_SNIPPET ].ns );
+  FREE( pfds );
+  exit( status );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
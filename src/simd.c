@@ -0,0 +1,1826 @@
+/*
+**      wrap -- text reformatter
+**      src/simd.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for scanning runs of characters or validating UTF-8
+ * several at a time using SIMD instructions, when available.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "simd.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint8_t */
+#include <stdlib.h>                     /* for getenv(3) */
+#include <string.h>                     /* for memchr(3), memcpy(3) */
+#include <sysexits.h>
+
+#if defined(__GNUC__) && defined(__SSE2__)
+# include <emmintrin.h>
+# define WITH_SIMD_SSE2 1
+# if HAVE___BUILTIN_CPU_SUPPORTS
+#   include <immintrin.h>
+#   define WITH_SIMD_AVX2 1
+# endif /* HAVE___BUILTIN_CPU_SUPPORTS */
+#endif /* __GNUC__ && __SSE2__ */
+
+#if defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define WITH_SIMD_NEON 1
+#endif /* __GNUC__ && __ARM_NEON && __aarch64__ */
+
+#if defined(__GNUC__) && defined(__wasm_simd128__)
+# include <wasm_simd128.h>
+# define WITH_SIMD_WASM 1
+#endif /* __GNUC__ && __wasm_simd128__ */
+
+/// @endcond
+
+/**
+ * @addtogroup simd-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maximum number of characters that can be in the set of characters for the
+ * SSE2 implementation of simd_scan() to be used.
+ */
+#define SCAN_STOP_MAX             24
+
+/**
+ * Maximum number of characters that can be excluded from the range of
+ * characters for one of the SIMD implementations to be used.
+ */
+#define SPAN_EXCLUDE_MAX          16
+
+/**
+ * Signature of a scan function.
+ *
+ * @param s The null-terminated string to scan.
+ * @return Returns the number of characters at the start of \a s that are not
+ * in the set.
+ */
+typedef size_t (*scan_fn_t)( char const *s );
+
+/**
+ * Signature of a span function.
+ *
+ * @param s The null-terminated string to span.
+ * @param max The maximum number of characters to span.
+ * @return Returns the number of characters at the start of \a s that are in
+ * the set.
+ */
+typedef size_t (*span_fn_t)( char const *s, size_t max );
+
+/**
+ * Signature of a UTF-8 check function.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+typedef simd_utf8_t (*utf8_check_fn_t)( char const *s, size_t len );
+
+/**
+ * Signature of a UTF-16 narrowing function.
+ *
+ * @param s The UTF-16 code units.
+ * @param n The number of code units of \a s.
+ * @param is_be If `true`, \a s is big-endian; else little-endian.
+ * @param out The buffer to narrow into.  It must have room for \a n bytes.
+ * @return Returns the number of code units narrowed.
+ */
+typedef size_t (*utf16_narrow_fn_t)( char const *s, size_t n, bool is_be,
+                                     char *out );
+
+/**
+ * Signature of a UTF-16 widening function.
+ *
+ * @param s The UTF-8 characters.
+ * @param len The number of characters of \a s.
+ * @param is_be If `true`, widen to big-endian; else little-endian.
+ * @param out The buffer to widen into.  It must have room for 2 * \a len
+ * bytes.
+ * @return Returns the number of characters widened.
+ */
+typedef size_t (*utf16_widen_fn_t)( char const *s, size_t len, bool is_be,
+                                    char *out );
+
+/**
+ * Signature of a whitespace span function.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+typedef size_t (*ws_fn_t)( char const *s, size_t len );
+
+#ifdef WITH_SIMD_AVX2
+/**
+ * Lookup table bits for utf8_check_avx2().  Each is a kind of error that the
+ * table for a nibble either of a byte or the byte before it can indicate; a
+ * kind of error occurred only if all three tables indicate it.
+ *
+ * @sa "Validating UTF-8 In Less Than One Instruction Per Byte," John Keiser
+ * and Daniel Lemire, _Software: Practice and Experience_, 51(5), 2021.
+ */
+enum utf8_err {
+  UTF8_TOO_SHORT  = 1u << 0,            ///< Lead byte not followed by cont.
+  UTF8_TOO_LONG   = 1u << 1,            ///< ASCII followed by cont.
+  UTF8_OVERLONG_3 = 1u << 2,            ///< E0 followed by 80-9F.
+  UTF8_TOO_LARGE  = 1u << 3,            ///< F4 followed by 90-BF or F5-FF.
+  UTF8_SURROGATE  = 1u << 4,            ///< ED followed by A0-BF.
+  UTF8_OVERLONG_2 = 1u << 5,            ///< C0 or C1.
+  UTF8_TOO_LARGE2 = 1u << 6,            ///< F5-FF followed by 80-8F.
+  UTF8_TWO_CONTS  = 1u << 7,            ///< Cont followed by cont.
+  UTF8_OVERLONG_4 = 1u << 6,            ///< F0 followed by 80-8F.
+  UTF8_CARRY      = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS
+};
+#endif /* WITH_SIMD_AVX2 */
+
+/// Names of the instruction sets indexed by \ref simd_isa.
+static char const *const SIMD_ISA_NAMES[] = {
+  "scalar", "sse2", "avx2", "neon", "wasm"
+};
+
+// local variable definitions
+static simd_isa_t isa;                  ///< Instruction set in use.
+static bool     is_isa_chosen;          ///< Has \ref isa been chosen?
+static bool     scan_set[ 256 ];        ///< Set of characters to stop at.
+
+/// For each low nibble, the bit for each high nibble of a character in \ref
+/// scan_set that has both.
+static uint8_t  scan_lo_bits[ 16 ];
+
+/// Characters in \ref scan_set.
+static char     scan_stop[ SCAN_STOP_MAX ];
+
+static unsigned scan_stop_len;          ///< Length of \ref scan_stop.
+static bool     span_set[ 256 ];        ///< Set of characters to span.
+static char     span_lo;                ///< Lowest character in the set.
+static char     span_hi;                ///< Highest character in the set.
+
+/// Characters between \ref span_lo and \ref span_hi not in the set.
+static char     span_exclude[ SPAN_EXCLUDE_MAX ];
+
+static unsigned span_exclude_len;       ///< Length of \ref span_exclude.
+
+// local functions
+NODISCARD
+static simd_isa_t isa_best( void );
+
+NODISCARD
+static bool     isa_is_supported( simd_isa_t );
+
+static void     isa_use( simd_isa_t );
+
+#ifdef WITH_SIMD_AVX2
+NODISCARD
+static size_t   scan_avx2( char const* );
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static size_t   scan_neon( char const* );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static size_t   scan_scalar( char const* );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static size_t   scan_sse2( char const* );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+NODISCARD
+static size_t   scan_wasm( char const* );
+#endif /* WITH_SIMD_WASM */
+
+#ifdef WITH_SIMD_AVX2
+NODISCARD
+static size_t   span_avx2( char const*, size_t );
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static size_t   span_neon( char const*, size_t );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static size_t   span_scalar( char const*, size_t );
+
+NODISCARD
+static bool     span_set_is_range( void );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static size_t   span_sse2( char const*, size_t );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+NODISCARD
+static size_t   span_wasm( char const*, size_t );
+#endif /* WITH_SIMD_WASM */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static size_t       utf16_narrow_neon( char const*, size_t, bool, char* );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static size_t       utf16_narrow_resolve( char const*, size_t, bool, char* );
+
+NODISCARD
+static size_t       utf16_narrow_scalar( char const*, size_t, bool, char* );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static size_t       utf16_narrow_sse2( char const*, size_t, bool, char* );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static size_t       utf16_widen_neon( char const*, size_t, bool, char* );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static size_t       utf16_widen_resolve( char const*, size_t, bool, char* );
+
+NODISCARD
+static size_t       utf16_widen_scalar( char const*, size_t, bool, char* );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static size_t       utf16_widen_sse2( char const*, size_t, bool, char* );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_AVX2
+NODISCARD
+static __m256i      utf8_block_avx2( __m256i, __m256i );
+
+NODISCARD
+static simd_utf8_t  utf8_check_avx2( char const*, size_t );
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static simd_utf8_t  utf8_check_neon( char const*, size_t );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static simd_utf8_t  utf8_check_resolve( char const*, size_t );
+
+NODISCARD
+static simd_utf8_t  utf8_check_scalar( char const*, size_t );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static simd_utf8_t  utf8_check_sse2( char const*, size_t );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+NODISCARD
+static simd_utf8_t  utf8_check_wasm( char const*, size_t );
+#endif /* WITH_SIMD_WASM */
+
+NODISCARD
+static size_t       utf8_seq_len( uint8_t const*, size_t );
+
+#ifdef WITH_SIMD_AVX2
+NODISCARD
+static size_t       ws_rspan_avx2( char const*, size_t );
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static size_t       ws_rspan_neon( char const*, size_t );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static size_t       ws_rspan_resolve( char const*, size_t );
+
+NODISCARD
+static size_t       ws_rspan_scalar( char const*, size_t );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static size_t       ws_rspan_sse2( char const*, size_t );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+NODISCARD
+static size_t       ws_rspan_wasm( char const*, size_t );
+#endif /* WITH_SIMD_WASM */
+
+#ifdef WITH_SIMD_AVX2
+NODISCARD
+static size_t       ws_span_avx2( char const*, size_t );
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+NODISCARD
+static size_t       ws_span_neon( char const*, size_t );
+#endif /* WITH_SIMD_NEON */
+
+NODISCARD
+static size_t       ws_span_resolve( char const*, size_t );
+
+NODISCARD
+static size_t       ws_span_scalar( char const*, size_t );
+
+#ifdef WITH_SIMD_SSE2
+NODISCARD
+static size_t       ws_span_sse2( char const*, size_t );
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+NODISCARD
+static size_t       ws_span_wasm( char const*, size_t );
+#endif /* WITH_SIMD_WASM */
+
+/// The scan implementation to use.
+static scan_fn_t scan_fn = &scan_scalar;
+
+/// The span implementation to use.
+static span_fn_t span_fn = &span_scalar;
+
+/// The UTF-16 narrowing implementation to use; chosen on first use.
+static utf16_narrow_fn_t utf16_narrow_fn = &utf16_narrow_resolve;
+
+/// The UTF-16 widening implementation to use; chosen on first use.
+static utf16_widen_fn_t utf16_widen_fn = &utf16_widen_resolve;
+
+/// The UTF-8 check implementation to use; chosen on first use.
+static utf8_check_fn_t utf8_check_fn = &utf8_check_resolve;
+
+/// The trailing whitespace span implementation to use; chosen on first use.
+static ws_fn_t ws_rspan_fn = &ws_rspan_resolve;
+
+/// The leading whitespace span implementation to use; chosen on first use.
+static ws_fn_t ws_span_fn = &ws_span_resolve;
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Gets the best instruction set that's both compiled in and supported by the
+ * CPU.
+ *
+ * @return Returns said instruction set.
+ */
+static simd_isa_t isa_best( void ) {
+  for ( simd_isa_t i = SIMD_ISA_WASM; i > SIMD_ISA_SCALAR; --i ) {
+    if ( isa_is_supported( i ) )
+      return i;
+  } // for
+  return SIMD_ISA_SCALAR;
+}
+
+/**
+ * Checks whether an instruction set is both compiled in and supported by the
+ * CPU.
+ *
+ * @param i The instruction set to check.
+ * @return Returns `true` only if it is.
+ */
+static bool isa_is_supported( simd_isa_t i ) {
+  switch ( i ) {
+    case SIMD_ISA_SCALAR:
+      return true;
+    case SIMD_ISA_SSE2:
+#ifdef WITH_SIMD_SSE2
+      return true;
+#else
+      return false;
+#endif /* WITH_SIMD_SSE2 */
+    case SIMD_ISA_AVX2:
+#ifdef WITH_SIMD_AVX2
+      return __builtin_cpu_supports( "avx2" );
+#else
+      return false;
+#endif /* WITH_SIMD_AVX2 */
+    case SIMD_ISA_NEON:
+#ifdef WITH_SIMD_NEON
+      return true;
+#else
+      return false;
+#endif /* WITH_SIMD_NEON */
+    case SIMD_ISA_WASM:
+#ifdef WITH_SIMD_WASM
+      return true;
+#else
+      return false;
+#endif /* WITH_SIMD_WASM */
+  } // switch
+  unreachable();
+}
+
+/**
+ * Uses \a i as the instruction set: chooses the implementations that don't
+ * depend on a set of characters.  Those that do are chosen by
+ * simd_scan_init() and simd_span_init().
+ *
+ * @param i The instruction set to use.  It must be supported.
+ */
+static void isa_use( simd_isa_t i ) {
+  assert( isa_is_supported( i ) );
+  isa = i;
+  is_isa_chosen = true;
+
+  utf16_narrow_fn = &utf16_narrow_scalar;
+  utf16_widen_fn = &utf16_widen_scalar;
+  utf8_check_fn = &utf8_check_scalar;
+  ws_rspan_fn = &ws_rspan_scalar;
+  ws_span_fn = &ws_span_scalar;
+
+  switch ( i ) {
+    case SIMD_ISA_SCALAR:
+      break;
+    case SIMD_ISA_SSE2:
+#ifdef WITH_SIMD_SSE2
+      utf16_narrow_fn = &utf16_narrow_sse2;
+      utf16_widen_fn = &utf16_widen_sse2;
+      utf8_check_fn = &utf8_check_sse2;
+      ws_rspan_fn = &ws_rspan_sse2;
+      ws_span_fn = &ws_span_sse2;
+#endif /* WITH_SIMD_SSE2 */
+      break;
+    case SIMD_ISA_AVX2:
+#ifdef WITH_SIMD_AVX2
+      // There are no AVX2 UTF-16 implementations, but AVX2 implies SSE2.
+      utf16_narrow_fn = &utf16_narrow_sse2;
+      utf16_widen_fn = &utf16_widen_sse2;
+      utf8_check_fn = &utf8_check_avx2;
+      ws_rspan_fn = &ws_rspan_avx2;
+      ws_span_fn = &ws_span_avx2;
+#endif /* WITH_SIMD_AVX2 */
+      break;
+    case SIMD_ISA_NEON:
+#ifdef WITH_SIMD_NEON
+      utf16_narrow_fn = &utf16_narrow_neon;
+      utf16_widen_fn = &utf16_widen_neon;
+      utf8_check_fn = &utf8_check_neon;
+      ws_rspan_fn = &ws_rspan_neon;
+      ws_span_fn = &ws_span_neon;
+#endif /* WITH_SIMD_NEON */
+      break;
+    case SIMD_ISA_WASM:
+#ifdef WITH_SIMD_WASM
+      utf8_check_fn = &utf8_check_wasm;
+      ws_rspan_fn = &ws_rspan_wasm;
+      ws_span_fn = &ws_span_wasm;
+#endif /* WITH_SIMD_WASM */
+      break;
+  } // switch
+}
+
+#ifdef WITH_SIMD_AVX2
+/**
+ * Scans characters 32 at a time using AVX2 instructions.  A character is in
+ * the set only if the bit for its high nibble is set in the bits for its low
+ * nibble, each looked up in a table for 32 characters at once.
+ *
+ * @param s The null-terminated string to scan.
+ * @return Returns the number of characters at the start of \a s that are not
+ * in the set.
+ */
+NODISCARD __attribute__((target("avx2")))
+static size_t scan_avx2( char const *s ) {
+  __m128i const lo_bits128 = _mm_loadu_si128( (void const*)scan_lo_bits );
+  __m256i const lo_bits = _mm256_broadcastsi128_si256( lo_bits128 );
+  __m256i const hi_bits = _mm256_setr_epi8(
+    1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0
+  );
+  __m256i const NIBBLE = _mm256_set1_epi8( 0x0F );
+  for ( size_t i = 0;; i += 32 ) {
+    __m256i const *const p = (void const*)(s + i);
+    __m256i const x = _mm256_loadu_si256( p );
+    __m256i const lo = _mm256_and_si256( x, NIBBLE );
+    __m256i const hi = _mm256_and_si256( _mm256_srli_epi16( x, 4 ), NIBBLE );
+    __m256i const in = _mm256_and_si256(
+      _mm256_shuffle_epi8( lo_bits, lo ), _mm256_shuffle_epi8( hi_bits, hi )
+    );
+    unsigned const stop = ~STATIC_CAST( unsigned,
+      _mm256_movemask_epi8( _mm256_cmpeq_epi8( in, _mm256_setzero_si256() ) )
+    );
+    if ( stop != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctz( stop ) );
+  } // for
+}
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Scans characters 16 at a time using NEON instructions the same way as
+ * scan_avx2().
+ *
+ * @param s The null-terminated string to scan.
+ * @return Returns the number of characters at the start of \a s that are not
+ * in the set.
+ */
+NODISCARD
+static size_t scan_neon( char const *s ) {
+  static uint8_t const HI_BITS[16] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t const lo_bits = vld1q_u8( scan_lo_bits );
+  uint8x16_t const hi_bits = vld1q_u8( HI_BITS );
+  for ( size_t i = 0;; i += 16 ) {
+    uint8x16_t const x = vld1q_u8( (void const*)(s + i) );
+    uint8x16_t const in = vandq_u8(
+      vqtbl1q_u8( lo_bits, vandq_u8( x, vdupq_n_u8( 0x0F ) ) ),
+      vqtbl1q_u8( hi_bits, vshrq_n_u8( x, 4 ) )
+    );
+    uint8x8_t const nibbles =
+      vshrn_n_u16( vreinterpretq_u16_u8( vtstq_u8( in, in ) ), 4 );
+    uint64_t const stop = vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 );
+    if ( stop != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctzll( stop ) / 4 );
+  } // for
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Scans characters one at a time.
+ *
+ * @param s The null-terminated string to scan.
+ * @return Returns the number of characters at the start of \a s that are not
+ * in the set.
+ */
+NODISCARD
+static size_t scan_scalar( char const *s ) {
+  size_t n = 0;
+  while ( !scan_set[ STATIC_CAST( unsigned char, s[n] ) ] )
+    ++n;
+  return n;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Scans characters 16 at a time using SSE2 instructions by comparing them
+ * against each character in the set.
+ *
+ * @param s The null-terminated string to scan.
+ * @return Returns the number of characters at the start of \a s that are not
+ * in the set.
+ */
+NODISCARD
+static size_t scan_sse2( char const *s ) {
+  for ( size_t i = 0;; i += 16 ) {
+    __m128i const *const p = (void const*)(s + i);
+    __m128i const x = _mm_loadu_si128( p );
+    __m128i in = _mm_setzero_si128();
+    for ( unsigned j = 0; j < scan_stop_len; ++j ) {
+      __m128i const c = _mm_set1_epi8( scan_stop[j] );
+      in = _mm_or_si128( in, _mm_cmpeq_epi8( x, c ) );
+    } // for
+    unsigned const stop = STATIC_CAST( unsigned, _mm_movemask_epi8( in ) );
+    if ( stop != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctz( stop ) );
+  } // for
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+/**
+ * Scans characters 16 at a time using WebAssembly SIMD128 instructions the
+ * same way as scan_avx2().
+ *
+ * @param s The null-terminated string to scan.
+ * @return Returns the number of characters at the start of \a s that are not
+ * in the set.
+ */
+NODISCARD
+static size_t scan_wasm( char const *s ) {
+  static uint8_t const HI_BITS[16] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+  v128_t const lo_bits = wasm_v128_load( scan_lo_bits );
+  v128_t const hi_bits = wasm_v128_load( HI_BITS );
+  v128_t const LO_NIBBLE = wasm_i8x16_splat( 0x0F );
+  for ( size_t i = 0;; i += 16 ) {
+    v128_t const x = wasm_v128_load( s + i );
+    v128_t const in = wasm_v128_and(
+      wasm_i8x16_swizzle( lo_bits, wasm_v128_and( x, LO_NIBBLE ) ),
+      wasm_i8x16_swizzle( hi_bits, wasm_u8x16_shr( x, 4 ) )
+    );
+    unsigned const stop = STATIC_CAST( unsigned,
+      wasm_i8x16_bitmask( wasm_i8x16_ne( in, wasm_i8x16_splat( 0 ) ) )
+    );
+    if ( stop != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctz( stop ) );
+  } // for
+}
+#endif /* WITH_SIMD_WASM */
+
+#ifdef WITH_SIMD_AVX2
+/**
+ * Spans characters 32 at a time using AVX2 instructions.
+ *
+ * @param s The null-terminated string to span.
+ * @param max The maximum number of characters to span.
+ * @return Returns the number of characters at the start of \a s that are in
+ * the set.
+ */
+NODISCARD __attribute__((target("avx2")))
+static size_t span_avx2( char const *s, size_t max ) {
+  __m256i const lo = _mm256_set1_epi8( STATIC_CAST( char, span_lo - 1 ) );
+  __m256i const hi = _mm256_set1_epi8( STATIC_CAST( char, span_hi + 1 ) );
+  for ( size_t i = 0; i < max; i += 32 ) {
+    __m256i const *const p = (void const*)(s + i);
+    __m256i const x = _mm256_loadu_si256( p );
+    __m256i in = _mm256_and_si256(
+      _mm256_cmpgt_epi8( x, lo ), _mm256_cmpgt_epi8( hi, x )
+    );
+    for ( unsigned j = 0; j < span_exclude_len; ++j ) {
+      __m256i const e = _mm256_set1_epi8( span_exclude[j] );
+      in = _mm256_andnot_si256( _mm256_cmpeq_epi8( x, e ), in );
+    } // for
+    unsigned const out =
+      ~STATIC_CAST( unsigned, _mm256_movemask_epi8( in ) );
+    if ( out != 0 ) {
+      size_t const n = i + STATIC_CAST( size_t, __builtin_ctz( out ) );
+      return n < max ? n : max;
+    }
+  } // for
+  return max;
+}
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Spans characters 16 at a time using NEON instructions.
+ *
+ * @param s The null-terminated string to span.
+ * @param max The maximum number of characters to span.
+ * @return Returns the number of characters at the start of \a s that are in
+ * the set.
+ */
+NODISCARD
+static size_t span_neon( char const *s, size_t max ) {
+  uint8x16_t const lo = vdupq_n_u8( STATIC_CAST( uint8_t, span_lo - 1 ) );
+  uint8x16_t const hi = vdupq_n_u8( STATIC_CAST( uint8_t, span_hi + 1 ) );
+  for ( size_t i = 0; i < max; i += 16 ) {
+    uint8x16_t const x = vld1q_u8( (void const*)(s + i) );
+    uint8x16_t in = vandq_u8( vcgtq_u8( x, lo ), vcltq_u8( x, hi ) );
+    for ( unsigned j = 0; j < span_exclude_len; ++j ) {
+      uint8x16_t const e = vdupq_n_u8( STATIC_CAST( uint8_t, span_exclude[j] ) );
+      in = vbicq_u8( in, vceqq_u8( x, e ) );
+    } // for
+    //
+    // NEON has no "move mask" instruction, so narrow each 8-bit lane to 4 bits
+    // to get a 64-bit mask having 4 bits per character.
+    //
+    uint8x8_t const nibbles = vshrn_n_u16( vreinterpretq_u16_u8( in ), 4 );
+    uint64_t const out = ~vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 );
+    if ( out != 0 ) {
+      size_t const n = i + STATIC_CAST( size_t, __builtin_ctzll( out ) / 4 );
+      return n < max ? n : max;
+    }
+  } // for
+  return max;
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Spans characters one at a time.
+ *
+ * @param s The null-terminated string to span.
+ * @param max The maximum number of characters to span.
+ * @return Returns the number of characters at the start of \a s that are in
+ * the set.
+ */
+NODISCARD
+static size_t span_scalar( char const *s, size_t max ) {
+  size_t n = 0;
+  while ( n < max && span_set[ STATIC_CAST( unsigned char, s[n] ) ] )
+    ++n;
+  return n;
+}
+
+/**
+ * Checks whether \ref span_set can be represented as a range of ASCII
+ * characters excluding a few and, if so, sets \ref span_lo, \ref span_hi, and
+ * \ref span_exclude.
+ *
+ * @return Returns `true` only if it can.
+ */
+NODISCARD
+static bool span_set_is_range( void ) {
+  //
+  // The SIMD compares are signed and span_hi + 1 must not overflow, so the
+  // set may contain only characters below DEL.
+  //
+  for ( unsigned c = 0x7F; c < 256; ++c ) {
+    if ( span_set[c] )
+      return false;
+  } // for
+  unsigned lo = 1, hi = 0x7E;
+  while ( lo <= hi && !span_set[ lo ] )
+    ++lo;
+  if ( lo > hi )                        // empty set
+    return false;
+  while ( !span_set[ hi ] )
+    --hi;
+
+  span_exclude_len = 0;
+  for ( unsigned c = lo + 1; c < hi; ++c ) {
+    if ( span_set[c] )
+      continue;
+    if ( span_exclude_len == SPAN_EXCLUDE_MAX )
+      return false;
+    span_exclude[ span_exclude_len++ ] = STATIC_CAST( char, c );
+  } // for
+  span_lo = STATIC_CAST( char, lo );
+  span_hi = STATIC_CAST( char, hi );
+  return true;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Spans characters 16 at a time using SSE2 instructions.
+ *
+ * @param s The null-terminated string to span.
+ * @param max The maximum number of characters to span.
+ * @return Returns the number of characters at the start of \a s that are in
+ * the set.
+ */
+NODISCARD
+static size_t span_sse2( char const *s, size_t max ) {
+  __m128i const lo = _mm_set1_epi8( STATIC_CAST( char, span_lo - 1 ) );
+  __m128i const hi = _mm_set1_epi8( STATIC_CAST( char, span_hi + 1 ) );
+  for ( size_t i = 0; i < max; i += 16 ) {
+    __m128i const *const p = (void const*)(s + i);
+    __m128i const x = _mm_loadu_si128( p );
+    __m128i in = _mm_and_si128(
+      _mm_cmpgt_epi8( x, lo ), _mm_cmplt_epi8( x, hi )
+    );
+    for ( unsigned j = 0; j < span_exclude_len; ++j ) {
+      __m128i const e = _mm_set1_epi8( span_exclude[j] );
+      in = _mm_andnot_si128( _mm_cmpeq_epi8( x, e ), in );
+    } // for
+    unsigned const out =
+      ~STATIC_CAST( unsigned, _mm_movemask_epi8( in ) ) & 0xFFFFu;
+    if ( out != 0 ) {
+      size_t const n = i + STATIC_CAST( size_t, __builtin_ctz( out ) );
+      return n < max ? n : max;
+    }
+  } // for
+  return max;
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+/**
+ * Spans characters 16 at a time using WebAssembly SIMD128 instructions.
+ *
+ * @param s The null-terminated string to span.
+ * @param max The maximum number of characters to span.
+ * @return Returns the number of characters at the start of \a s that are in
+ * the set.
+ */
+NODISCARD
+static size_t span_wasm( char const *s, size_t max ) {
+  v128_t const lo = wasm_i8x16_splat( STATIC_CAST( int8_t, span_lo - 1 ) );
+  v128_t const hi = wasm_i8x16_splat( STATIC_CAST( int8_t, span_hi + 1 ) );
+  for ( size_t i = 0; i < max; i += 16 ) {
+    v128_t const x = wasm_v128_load( s + i );
+    v128_t in =
+      wasm_v128_and( wasm_u8x16_gt( x, lo ), wasm_u8x16_lt( x, hi ) );
+    for ( unsigned j = 0; j < span_exclude_len; ++j ) {
+      v128_t const e = wasm_i8x16_splat( span_exclude[j] );
+      in = wasm_v128_andnot( in, wasm_i8x16_eq( x, e ) );
+    } // for
+    unsigned const out =
+      ~STATIC_CAST( unsigned, wasm_i8x16_bitmask( in ) ) & 0xFFFFu;
+    if ( out != 0 ) {
+      size_t const n = i + STATIC_CAST( size_t, __builtin_ctz( out ) );
+      return n < max ? n : max;
+    }
+  } // for
+  return max;
+}
+#endif /* WITH_SIMD_WASM */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Narrows UTF-16 code units that are ASCII 16 at a time using NEON
+ * instructions.
+ *
+ * @param s The UTF-16 code units.
+ * @param n The number of code units of \a s.
+ * @param is_be If `true`, \a s is big-endian; else little-endian.
+ * @param out The buffer to narrow into.
+ * @return Returns the number of code units narrowed.
+ */
+NODISCARD
+static size_t utf16_narrow_neon( char const *s, size_t n, bool is_be,
+                                 char *out ) {
+  uint8_t const *const u = (void const*)s;
+  size_t i = 0;
+  for ( ; n - i >= 16; i += 16 ) {
+    uint8x16_t a8 = vld1q_u8( u + 2 * i );
+    uint8x16_t b8 = vld1q_u8( u + 2 * i + 16 );
+    if ( is_be ) {
+      a8 = vrev16q_u8( a8 );
+      b8 = vrev16q_u8( b8 );
+    }
+    uint16x8_t const a = vreinterpretq_u16_u8( a8 );
+    uint16x8_t const b = vreinterpretq_u16_u8( b8 );
+    if ( vmaxvq_u16( vorrq_u16( a, b ) ) >= 0x80 )
+      break;
+    vst1q_u8(
+      (void*)(out + i), vcombine_u8( vmovn_u16( a ), vmovn_u16( b ) )
+    );
+  } // for
+  return i + utf16_narrow_scalar( s + 2 * i, n - i, is_be, out + i );
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Chooses the UTF-16 narrowing implementation to use, then uses it.
+ *
+ * @param s The UTF-16 code units.
+ * @param n The number of code units of \a s.
+ * @param is_be If `true`, \a s is big-endian; else little-endian.
+ * @param out The buffer to narrow into.
+ * @return Returns the number of code units narrowed.
+ */
+NODISCARD
+static size_t utf16_narrow_resolve( char const *s, size_t n, bool is_be,
+                                    char *out ) {
+  simd_init();
+  return (*utf16_narrow_fn)( s, n, is_be, out );
+}
+
+/**
+ * Narrows UTF-16 code units that are ASCII one at a time.
+ *
+ * @param s The UTF-16 code units.
+ * @param n The number of code units of \a s.
+ * @param is_be If `true`, \a s is big-endian; else little-endian.
+ * @param out The buffer to narrow into.
+ * @return Returns the number of code units narrowed.
+ */
+NODISCARD
+static size_t utf16_narrow_scalar( char const *s, size_t n, bool is_be,
+                                   char *out ) {
+  uint8_t const *const u = (void const*)s;
+  size_t i = 0;
+  for ( ; i < n; ++i ) {
+    uint8_t const hi = u[ 2 * i + !is_be ];
+    uint8_t const lo = u[ 2 * i + is_be ];
+    if ( hi != 0 || lo >= 0x80 )
+      break;
+    out[i] = STATIC_CAST( char, lo );
+  } // for
+  return i;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Narrows UTF-16 code units that are ASCII 16 at a time using SSE2
+ * instructions.
+ *
+ * @param s The UTF-16 code units.
+ * @param n The number of code units of \a s.
+ * @param is_be If `true`, \a s is big-endian; else little-endian.
+ * @param out The buffer to narrow into.
+ * @return Returns the number of code units narrowed.
+ */
+NODISCARD
+static size_t utf16_narrow_sse2( char const *s, size_t n, bool is_be,
+                                 char *out ) {
+  __m128i const NON_ASCII = _mm_set1_epi16( STATIC_CAST( short, 0xFF80 ) );
+  size_t i = 0;
+  for ( ; n - i >= 16; i += 16 ) {
+    __m128i a = _mm_loadu_si128( (void const*)(s + 2 * i) );
+    __m128i b = _mm_loadu_si128( (void const*)(s + 2 * i + 16) );
+    if ( is_be ) {
+      a = _mm_or_si128( _mm_slli_epi16( a, 8 ), _mm_srli_epi16( a, 8 ) );
+      b = _mm_or_si128( _mm_slli_epi16( b, 8 ), _mm_srli_epi16( b, 8 ) );
+    }
+    __m128i const non_ascii = _mm_and_si128( _mm_or_si128( a, b ), NON_ASCII );
+    if ( _mm_movemask_epi8(
+           _mm_cmpeq_epi16( non_ascii, _mm_setzero_si128() )
+         ) != 0xFFFF ) {
+      break;
+    }
+    _mm_storeu_si128( (void*)(out + i), _mm_packus_epi16( a, b ) );
+  } // for
+  return i + utf16_narrow_scalar( s + 2 * i, n - i, is_be, out + i );
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Widens ASCII characters to UTF-16 code units 16 at a time using NEON
+ * instructions.
+ *
+ * @param s The UTF-8 characters.
+ * @param len The number of characters of \a s.
+ * @param is_be If `true`, widen to big-endian; else little-endian.
+ * @param out The buffer to widen into.
+ * @return Returns the number of characters widened.
+ */
+NODISCARD
+static size_t utf16_widen_neon( char const *s, size_t len, bool is_be,
+                                char *out ) {
+  uint8_t const *const u = (void const*)s;
+  uint8_t *const o = (void*)out;
+  size_t i = 0;
+  for ( ; len - i >= 16; i += 16 ) {
+    uint8x16_t const x = vld1q_u8( u + i );
+    if ( vmaxvq_u8( x ) >= 0x80 )
+      break;
+    uint8x16_t lo = vreinterpretq_u8_u16( vmovl_u8( vget_low_u8( x ) ) );
+    uint8x16_t hi = vreinterpretq_u8_u16( vmovl_high_u8( x ) );
+    if ( is_be ) {
+      lo = vrev16q_u8( lo );
+      hi = vrev16q_u8( hi );
+    }
+    vst1q_u8( o + 2 * i, lo );
+    vst1q_u8( o + 2 * i + 16, hi );
+  } // for
+  return i + utf16_widen_scalar( s + i, len - i, is_be, out + 2 * i );
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Chooses the UTF-16 widening implementation to use, then uses it.
+ *
+ * @param s The UTF-8 characters.
+ * @param len The number of characters of \a s.
+ * @param is_be If `true`, widen to big-endian; else little-endian.
+ * @param out The buffer to widen into.
+ * @return Returns the number of characters widened.
+ */
+NODISCARD
+static size_t utf16_widen_resolve( char const *s, size_t len, bool is_be,
+                                   char *out ) {
+  simd_init();
+  return (*utf16_widen_fn)( s, len, is_be, out );
+}
+
+/**
+ * Widens ASCII characters to UTF-16 code units one at a time.
+ *
+ * @param s The UTF-8 characters.
+ * @param len The number of characters of \a s.
+ * @param is_be If `true`, widen to big-endian; else little-endian.
+ * @param out The buffer to widen into.
+ * @return Returns the number of characters widened.
+ */
+NODISCARD
+static size_t utf16_widen_scalar( char const *s, size_t len, bool is_be,
+                                  char *out ) {
+  size_t i = 0;
+  for ( ; i < len && STATIC_CAST( uint8_t, s[i] ) < 0x80; ++i ) {
+    out[ 2 * i + !is_be ] = '\0';
+    out[ 2 * i + is_be ] = s[i];
+  } // for
+  return i;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Widens ASCII characters to UTF-16 code units 16 at a time using SSE2
+ * instructions.
+ *
+ * @param s The UTF-8 characters.
+ * @param len The number of characters of \a s.
+ * @param is_be If `true`, widen to big-endian; else little-endian.
+ * @param out The buffer to widen into.
+ * @return Returns the number of characters widened.
+ */
+NODISCARD
+static size_t utf16_widen_sse2( char const *s, size_t len, bool is_be,
+                                char *out ) {
+  __m128i const ZERO = _mm_setzero_si128();
+  size_t i = 0;
+  for ( ; len - i >= 16; i += 16 ) {
+    __m128i const x = _mm_loadu_si128( (void const*)(s + i) );
+    if ( _mm_movemask_epi8( x ) != 0 )
+      break;
+    __m128i const lo = is_be ?
+      _mm_unpacklo_epi8( ZERO, x ) : _mm_unpacklo_epi8( x, ZERO );
+    __m128i const hi = is_be ?
+      _mm_unpackhi_epi8( ZERO, x ) : _mm_unpackhi_epi8( x, ZERO );
+    _mm_storeu_si128( (void*)(out + 2 * i), lo );
+    _mm_storeu_si128( (void*)(out + 2 * i + 16), hi );
+  } // for
+  return i + utf16_widen_scalar( s + i, len - i, is_be, out + 2 * i );
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_AVX2
+/**
+ * Gets the error bits for the 32 characters of \a x given the 32 before them.
+ *
+ * @param x The characters to check.
+ * @param prev The previous 32 characters.
+ * @return Returns the error bits that are non-zero only if something is
+ * invalid, except for a character continuing past the end of \a x that is
+ * detected only by the next call.
+ */
+NODISCARD __attribute__((target("avx2")))
+static inline __m256i utf8_block_avx2( __m256i x, __m256i prev ) {
+# define E(B) STATIC_CAST( char, (B) )
+# define T16(...) _mm256_setr_epi8( __VA_ARGS__, __VA_ARGS__ )
+  __m256i const BYTE_1_HIGH = T16(
+    E(UTF8_TOO_LONG), E(UTF8_TOO_LONG), E(UTF8_TOO_LONG), E(UTF8_TOO_LONG),
+    E(UTF8_TOO_LONG), E(UTF8_TOO_LONG), E(UTF8_TOO_LONG), E(UTF8_TOO_LONG),
+    E(UTF8_TWO_CONTS), E(UTF8_TWO_CONTS), E(UTF8_TWO_CONTS),
+    E(UTF8_TWO_CONTS),
+    E(UTF8_TOO_SHORT | UTF8_OVERLONG_2),
+    E(UTF8_TOO_SHORT),
+    E(UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE),
+    E(UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE2 | UTF8_OVERLONG_4)
+  );
+  __m256i const BYTE_1_LOW = T16(
+    E(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+    E(UTF8_CARRY | UTF8_OVERLONG_2),
+    E(UTF8_CARRY),
+    E(UTF8_CARRY),
+    E(UTF8_CARRY | UTF8_TOO_LARGE),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2 | UTF8_SURROGATE),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2),
+    E(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2)
+  );
+  __m256i const BYTE_2_HIGH = T16(
+    E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT),
+    E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT),
+    E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT),
+    E(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 |
+      UTF8_TOO_LARGE2 | UTF8_OVERLONG_4),
+    E(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 |
+      UTF8_TOO_LARGE),
+    E(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE |
+      UTF8_TOO_LARGE),
+    E(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE |
+      UTF8_TOO_LARGE),
+    E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT), E(UTF8_TOO_SHORT),
+    E(UTF8_TOO_SHORT)
+  );
+# undef E
+# undef T16
+
+  __m256i const NIBBLE = _mm256_set1_epi8( 0x0F );
+  __m256i const straddle = _mm256_permute2x128_si256( prev, x, 0x21 );
+  __m256i const prev1 = _mm256_alignr_epi8( x, straddle, 16 - 1 );
+  __m256i const prev2 = _mm256_alignr_epi8( x, straddle, 16 - 2 );
+  __m256i const prev3 = _mm256_alignr_epi8( x, straddle, 16 - 3 );
+
+  __m256i const special = _mm256_and_si256(
+    _mm256_and_si256(
+      _mm256_shuffle_epi8( BYTE_1_HIGH,
+        _mm256_and_si256( _mm256_srli_epi16( prev1, 4 ), NIBBLE )
+      ),
+      _mm256_shuffle_epi8( BYTE_1_LOW, _mm256_and_si256( prev1, NIBBLE ) )
+    ),
+    _mm256_shuffle_epi8( BYTE_2_HIGH,
+      _mm256_and_si256( _mm256_srli_epi16( x, 4 ), NIBBLE )
+    )
+  );
+
+  //
+  // The tables catch every error involving only a byte and the one before it.
+  // The 3rd and 4th bytes of 3- and 4-byte characters must also be
+  // continuation bytes: those are exactly the UTF8_TWO_CONTS cases.
+  // Subtracting with saturation sets the high bit of a byte only if the byte
+  // 2 (or 3) before it is at least E0 (or F0).
+  //
+  __m256i const is_3rd =
+    _mm256_subs_epu8( prev2, _mm256_set1_epi8( 0xE0 - 0x80 ) );
+  __m256i const is_4th =
+    _mm256_subs_epu8( prev3, _mm256_set1_epi8( 0xF0 - 0x80 ) );
+  __m256i const must_be_cont = _mm256_and_si256(
+    _mm256_or_si256( is_3rd, is_4th ),
+    _mm256_set1_epi8( STATIC_CAST( char, 0x80 ) )
+  );
+  return _mm256_xor_si256( must_be_cont, special );
+}
+
+/**
+ * Checks whether UTF-8 is valid 32 characters at a time using AVX2
+ * instructions.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD __attribute__((target("avx2")))
+static simd_utf8_t utf8_check_avx2( char const *s, size_t len ) {
+  __m256i prev = _mm256_setzero_si256();
+  __m256i error = prev, any = prev;
+  size_t i = 0;
+
+  for ( ; len - i >= 32; i += 32 ) {
+    __m256i const x = _mm256_loadu_si256( (void const*)(s + i) );
+    error = _mm256_or_si256( error, utf8_block_avx2( x, prev ) );
+    any = _mm256_or_si256( any, x );
+    prev = x;
+  } // for
+
+  //
+  // Always check a final (possibly empty) block padded with nulls: since a
+  // null isn't a continuation byte, a character continuing past the end is
+  // then detected as being too short.
+  //
+  char tail[32] = { 0 };
+  memcpy( tail, s + i, len - i );
+  __m256i const x = _mm256_loadu_si256( (void const*)tail );
+  error = _mm256_or_si256( error, utf8_block_avx2( x, prev ) );
+  any = _mm256_or_si256( any, x );
+
+  if ( !_mm256_testz_si256( error, error ) )
+    return SIMD_UTF8_INVALID;
+  return _mm256_movemask_epi8( any ) == 0 ? SIMD_UTF8_ASCII : SIMD_UTF8_VALID;
+}
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Checks whether UTF-8 is valid skipping ASCII characters 16 at a time using
+ * NEON instructions.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD
+static simd_utf8_t utf8_check_neon( char const *s, size_t len ) {
+  uint8_t const *const u = (void const*)s;
+  simd_utf8_t rv = SIMD_UTF8_ASCII;
+  for ( size_t i = 0; i < len; ) {
+    if ( len - i >= 16 && vmaxvq_u8( vld1q_u8( u + i ) ) < 0x80 ) {
+      i += 16;
+      continue;
+    }
+    size_t const n = utf8_seq_len( u + i, len - i );
+    if ( n == 0 )
+      return SIMD_UTF8_INVALID;
+    if ( n > 1 )
+      rv = SIMD_UTF8_VALID;
+    i += n;
+  } // for
+  return rv;
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Chooses the UTF-8 check implementation to use, then uses it.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD
+static simd_utf8_t utf8_check_resolve( char const *s, size_t len ) {
+  simd_init();
+  return (*utf8_check_fn)( s, len );
+}
+
+/**
+ * Checks whether UTF-8 is valid one character at a time.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD
+static simd_utf8_t utf8_check_scalar( char const *s, size_t len ) {
+  uint8_t const *const u = (void const*)s;
+  simd_utf8_t rv = SIMD_UTF8_ASCII;
+  for ( size_t i = 0; i < len; ) {
+    size_t const n = utf8_seq_len( u + i, len - i );
+    if ( n == 0 )
+      return SIMD_UTF8_INVALID;
+    if ( n > 1 )
+      rv = SIMD_UTF8_VALID;
+    i += n;
+  } // for
+  return rv;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Checks whether UTF-8 is valid skipping ASCII characters 16 at a time using
+ * SSE2 instructions.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD
+static simd_utf8_t utf8_check_sse2( char const *s, size_t len ) {
+  uint8_t const *const u = (void const*)s;
+  simd_utf8_t rv = SIMD_UTF8_ASCII;
+  for ( size_t i = 0; i < len; ) {
+    if ( len - i >= 16 &&
+         _mm_movemask_epi8( _mm_loadu_si128( (void const*)(u + i) ) ) == 0 ) {
+      i += 16;
+      continue;
+    }
+    size_t const n = utf8_seq_len( u + i, len - i );
+    if ( n == 0 )
+      return SIMD_UTF8_INVALID;
+    if ( n > 1 )
+      rv = SIMD_UTF8_VALID;
+    i += n;
+  } // for
+  return rv;
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+/**
+ * Checks whether UTF-8 is valid skipping ASCII characters 16 at a time using
+ * WebAssembly SIMD128 instructions.
+ *
+ * @param s The characters to check.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD
+static simd_utf8_t utf8_check_wasm( char const *s, size_t len ) {
+  uint8_t const *const u = (void const*)s;
+  simd_utf8_t rv = SIMD_UTF8_ASCII;
+  for ( size_t i = 0; i < len; ) {
+    if ( len - i >= 16 &&
+         wasm_i8x16_bitmask( wasm_v128_load( u + i ) ) == 0 ) {
+      i += 16;
+      continue;
+    }
+    size_t const n = utf8_seq_len( u + i, len - i );
+    if ( n == 0 )
+      return SIMD_UTF8_INVALID;
+    if ( n > 1 )
+      rv = SIMD_UTF8_VALID;
+    i += n;
+  } // for
+  return rv;
+}
+#endif /* WITH_SIMD_WASM */
+
+/**
+ * Gets the length of the valid UTF-8 character at the start of \a u.
+ *
+ * @param u The characters to check.
+ * @param len The number of characters remaining; must be &gt; 0.
+ * @return Returns said length or 0 if the character is invalid.
+ */
+NODISCARD
+static size_t utf8_seq_len( uint8_t const *u, size_t len ) {
+  assert( len > 0 );
+  uint8_t const c = u[0];
+  if ( c < 0x80 )
+    return 1;
+  uint8_t lo = 0x80, hi = 0xBF;         // range of the 2nd byte
+  size_t n;
+  if ( c < 0xC2 )
+    return 0;
+  if ( c < 0xE0 ) {
+    n = 2;
+  } else if ( c < 0xF0 ) {
+    n = 3;
+    if ( c == 0xE0 )
+      lo = 0xA0;                        // overlong
+    else if ( c == 0xED )
+      hi = 0x9F;                        // surrogate
+  } else if ( c < 0xF5 ) {
+    n = 4;
+    if ( c == 0xF0 )
+      lo = 0x90;                        // overlong
+    else if ( c == 0xF4 )
+      hi = 0x8F;                        // > U+10FFFF
+  } else {
+    return 0;
+  }
+  if ( n > len || u[1] < lo || u[1] > hi )
+    return 0;
+  for ( size_t i = 2; i < n; ++i ) {
+    if ( (u[i] & 0xC0) != 0x80 )
+      return 0;
+  } // for
+  return n;
+}
+
+#ifdef WITH_SIMD_AVX2
+/**
+ * Spans trailing spaces and tabs 32 at a time using AVX2 instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD __attribute__((target("avx2")))
+static size_t ws_rspan_avx2( char const *s, size_t len ) {
+  __m256i const SPACE = _mm256_set1_epi8( ' ' );
+  __m256i const TAB = _mm256_set1_epi8( '\t' );
+  size_t n = len;
+  for ( ; n >= 32; n -= 32 ) {
+    __m256i const x = _mm256_loadu_si256( (void const*)(s + n - 32) );
+    __m256i const ws = _mm256_or_si256(
+      _mm256_cmpeq_epi8( x, SPACE ), _mm256_cmpeq_epi8( x, TAB )
+    );
+    unsigned const non_ws =
+      ~STATIC_CAST( unsigned, _mm256_movemask_epi8( ws ) );
+    if ( non_ws != 0 )
+      return len - n + STATIC_CAST( size_t, __builtin_clz( non_ws ) );
+  } // for
+  return len - n + ws_rspan_scalar( s, n );
+}
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Spans trailing spaces and tabs 16 at a time using NEON instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_rspan_neon( char const *s, size_t len ) {
+  size_t n = len;
+  for ( ; n >= 16; n -= 16 ) {
+    uint8x16_t const x = vld1q_u8( (void const*)(s + n - 16) );
+    uint8x16_t const ws =
+      vorrq_u8( vceqq_u8( x, vdupq_n_u8( ' ' ) ),
+                vceqq_u8( x, vdupq_n_u8( '\t' ) ) );
+    uint8x8_t const nibbles =
+      vshrn_n_u16( vreinterpretq_u16_u8( ws ), 4 );
+    uint64_t const non_ws =
+      ~vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 );
+    if ( non_ws != 0 )
+      return len - n + STATIC_CAST( size_t, __builtin_clzll( non_ws ) / 4 );
+  } // for
+  return len - n + ws_rspan_scalar( s, n );
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Chooses the whitespace span implementations to use, then uses the trailing
+ * one.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_rspan_resolve( char const *s, size_t len ) {
+  simd_init();
+  return (*ws_rspan_fn)( s, len );
+}
+
+/**
+ * Spans trailing spaces and tabs one at a time.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_rspan_scalar( char const *s, size_t len ) {
+  size_t n = len;
+  while ( n > 0 && (s[ n - 1 ] == ' ' || s[ n - 1 ] == '\t') )
+    --n;
+  return len - n;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Spans trailing spaces and tabs 16 at a time using SSE2 instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_rspan_sse2( char const *s, size_t len ) {
+  __m128i const SPACE = _mm_set1_epi8( ' ' );
+  __m128i const TAB = _mm_set1_epi8( '\t' );
+  size_t n = len;
+  for ( ; n >= 16; n -= 16 ) {
+    __m128i const x = _mm_loadu_si128( (void const*)(s + n - 16) );
+    __m128i const ws =
+      _mm_or_si128( _mm_cmpeq_epi8( x, SPACE ), _mm_cmpeq_epi8( x, TAB ) );
+    unsigned const non_ws =
+      ~STATIC_CAST( unsigned, _mm_movemask_epi8( ws ) ) & 0xFFFFu;
+    if ( non_ws != 0 )
+      return len - n + STATIC_CAST( size_t, __builtin_clz( non_ws ) - 16 );
+  } // for
+  return len - n + ws_rspan_scalar( s, n );
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+/**
+ * Spans trailing spaces and tabs 16 at a time using WebAssembly SIMD128
+ * instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_rspan_wasm( char const *s, size_t len ) {
+  v128_t const SPACE = wasm_i8x16_splat( ' ' );
+  v128_t const TAB = wasm_i8x16_splat( '\t' );
+  size_t n = len;
+  for ( ; n >= 16; n -= 16 ) {
+    v128_t const x = wasm_v128_load( s + n - 16 );
+    v128_t const ws =
+      wasm_v128_or( wasm_i8x16_eq( x, SPACE ), wasm_i8x16_eq( x, TAB ) );
+    unsigned const non_ws =
+      ~STATIC_CAST( unsigned, wasm_i8x16_bitmask( ws ) ) & 0xFFFFu;
+    if ( non_ws != 0 )
+      return len - n + STATIC_CAST( size_t, __builtin_clz( non_ws ) - 16 );
+  } // for
+  return len - n + ws_rspan_scalar( s, n );
+}
+#endif /* WITH_SIMD_WASM */
+
+#ifdef WITH_SIMD_AVX2
+/**
+ * Spans leading whitespace 32 at a time using AVX2 instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD __attribute__((target("avx2")))
+static size_t ws_span_avx2( char const *s, size_t len ) {
+  __m256i const SPACE = _mm256_set1_epi8( ' ' );
+  __m256i const TAB = _mm256_set1_epi8( '\t' );
+  __m256i const CR = _mm256_set1_epi8( '\r' );
+  __m256i const NL = _mm256_set1_epi8( '\n' );
+  size_t i = 0;
+  for ( ; len - i >= 32; i += 32 ) {
+    __m256i const x = _mm256_loadu_si256( (void const*)(s + i) );
+    __m256i const ws = _mm256_or_si256(
+      _mm256_or_si256( _mm256_cmpeq_epi8( x, SPACE ),
+                       _mm256_cmpeq_epi8( x, TAB ) ),
+      _mm256_or_si256( _mm256_cmpeq_epi8( x, CR ),
+                       _mm256_cmpeq_epi8( x, NL ) )
+    );
+    unsigned const non_ws =
+      ~STATIC_CAST( unsigned, _mm256_movemask_epi8( ws ) );
+    if ( non_ws != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctz( non_ws ) );
+  } // for
+  return i + ws_span_scalar( s + i, len - i );
+}
+#endif /* WITH_SIMD_AVX2 */
+
+#ifdef WITH_SIMD_NEON
+/**
+ * Spans leading whitespace 16 at a time using NEON instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_span_neon( char const *s, size_t len ) {
+  size_t i = 0;
+  for ( ; len - i >= 16; i += 16 ) {
+    uint8x16_t const x = vld1q_u8( (void const*)(s + i) );
+    uint8x16_t const ws = vorrq_u8(
+      vorrq_u8( vceqq_u8( x, vdupq_n_u8( ' ' ) ),
+                vceqq_u8( x, vdupq_n_u8( '\t' ) ) ),
+      vorrq_u8( vceqq_u8( x, vdupq_n_u8( '\r' ) ),
+                vceqq_u8( x, vdupq_n_u8( '\n' ) ) )
+    );
+    uint8x8_t const nibbles =
+      vshrn_n_u16( vreinterpretq_u16_u8( ws ), 4 );
+    uint64_t const non_ws =
+      ~vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 );
+    if ( non_ws != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctzll( non_ws ) / 4 );
+  } // for
+  return i + ws_span_scalar( s + i, len - i );
+}
+#endif /* WITH_SIMD_NEON */
+
+/**
+ * Chooses the whitespace span implementations to use, then uses the leading
+ * one.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_span_resolve( char const *s, size_t len ) {
+  simd_init();
+  return (*ws_span_fn)( s, len );
+}
+
+/**
+ * Spans leading whitespace one at a time.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_span_scalar( char const *s, size_t len ) {
+  size_t n = 0;
+  while ( n < len && (s[n] == ' ' || s[n] == '\t' || s[n] == '\r' ||
+                      s[n] == '\n') ) {
+    ++n;
+  } // while
+  return n;
+}
+
+#ifdef WITH_SIMD_SSE2
+/**
+ * Spans leading whitespace 16 at a time using SSE2 instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_span_sse2( char const *s, size_t len ) {
+  __m128i const SPACE = _mm_set1_epi8( ' ' );
+  __m128i const TAB = _mm_set1_epi8( '\t' );
+  __m128i const CR = _mm_set1_epi8( '\r' );
+  __m128i const NL = _mm_set1_epi8( '\n' );
+  size_t i = 0;
+  for ( ; len - i >= 16; i += 16 ) {
+    __m128i const x = _mm_loadu_si128( (void const*)(s + i) );
+    __m128i const ws = _mm_or_si128(
+      _mm_or_si128( _mm_cmpeq_epi8( x, SPACE ), _mm_cmpeq_epi8( x, TAB ) ),
+      _mm_or_si128( _mm_cmpeq_epi8( x, CR ), _mm_cmpeq_epi8( x, NL ) )
+    );
+    unsigned const non_ws =
+      ~STATIC_CAST( unsigned, _mm_movemask_epi8( ws ) ) & 0xFFFFu;
+    if ( non_ws != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctz( non_ws ) );
+  } // for
+  return i + ws_span_scalar( s + i, len - i );
+}
+#endif /* WITH_SIMD_SSE2 */
+
+#ifdef WITH_SIMD_WASM
+/**
+ * Spans leading whitespace 16 at a time using WebAssembly SIMD128
+ * instructions.
+ *
+ * @param s The characters to span.
+ * @param len The number of characters of \a s.
+ * @return Returns the number of characters spanned.
+ */
+NODISCARD
+static size_t ws_span_wasm( char const *s, size_t len ) {
+  v128_t const SPACE = wasm_i8x16_splat( ' ' );
+  v128_t const TAB = wasm_i8x16_splat( '\t' );
+  v128_t const CR = wasm_i8x16_splat( '\r' );
+  v128_t const NL = wasm_i8x16_splat( '\n' );
+  size_t i = 0;
+  for ( ; len - i >= 16; i += 16 ) {
+    v128_t const x = wasm_v128_load( s + i );
+    v128_t const ws = wasm_v128_or(
+      wasm_v128_or( wasm_i8x16_eq( x, SPACE ), wasm_i8x16_eq( x, TAB ) ),
+      wasm_v128_or( wasm_i8x16_eq( x, CR ), wasm_i8x16_eq( x, NL ) )
+    );
+    unsigned const non_ws =
+      ~STATIC_CAST( unsigned, wasm_i8x16_bitmask( ws ) ) & 0xFFFFu;
+    if ( non_ws != 0 )
+      return i + STATIC_CAST( size_t, __builtin_ctz( non_ws ) );
+  } // for
+  return i + ws_span_scalar( s + i, len - i );
+}
+#endif /* WITH_SIMD_WASM */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void simd_init( void ) {
+  if ( is_isa_chosen )
+    return;
+  simd_isa_t i = isa_best();
+  char const *const force = getenv( "WRAP_FORCE_ISA" );
+  if ( force != NULL && *force != '\0' ) {
+    for ( i = SIMD_ISA_SCALAR; ; ++i ) {
+      if ( i > SIMD_ISA_WASM ) {
+        fatal_error( EX_USAGE,
+          "\"%s\": invalid value for WRAP_FORCE_ISA;\n\tmust be one of:"
+          " scalar, sse2, avx2, neon, or wasm\n", force
+        );
+      }
+      if ( strcmp( force, SIMD_ISA_NAMES[ i ] ) == 0 )
+        break;
+    } // for
+    if ( !isa_is_supported( i ) ) {
+      fatal_error( EX_UNAVAILABLE,
+        "\"%s\": instruction set not supported by this build or CPU\n",
+        force
+      );
+    }
+  }
+  isa_use( i );
+}
+
+bool simd_is_binary( char const *s, size_t len ) {
+  assert( s != NULL );
+  uint8_t const *const u = (void const*)s;
+  if ( len >= 2 && ((u[0] == 0xFE && u[1] == 0xFF) ||
+                    (u[0] == 0xFF && u[1] == 0xFE)) ) {
+    return true;                        // UTF-16 (or UTF-32LE) BOM
+  }
+  if ( memchr( s, '\0', len ) != NULL )
+    return true;
+  if ( simd_utf8_check( s, len ) != SIMD_UTF8_INVALID )
+    return false;
+
+  //
+  // Only text in an 8-bit encoding (or binary data without a null) gets here,
+  // so counting invalid characters one at a time is fine.
+  //
+  size_t invalid_len = 0;
+  for ( size_t i = 0; i < len; ) {
+    size_t const n = utf8_seq_len( u + i, len - i );
+    if ( n == 0 ) {
+      ++invalid_len;
+      ++i;
+    } else {
+      i += n;
+    }
+  } // for
+  return invalid_len * SIMD_BINARY_INVALID_RATIO > len;
+}
+
+simd_isa_t simd_isa( void ) {
+  simd_init();
+  return isa;
+}
+
+char const* simd_isa_name( simd_isa_t i ) {
+  assert( STATIC_CAST( size_t, i ) < ARRAY_SIZE( SIMD_ISA_NAMES ) );
+  return SIMD_ISA_NAMES[ i ];
+}
+
+void simd_scalar_only( void ) {
+  isa_use( SIMD_ISA_SCALAR );
+  scan_fn = &scan_scalar;
+  span_fn = &span_scalar;
+}
+
+size_t simd_scan( char const *s ) {
+  assert( s != NULL );
+  return (*scan_fn)( s );
+}
+
+void simd_scan_init( bool const set[const static 256] ) {
+  assert( set[0] );
+  memcpy( scan_set, set, sizeof scan_set );
+  MEM_ZERO( &scan_lo_bits );
+  scan_stop_len = 0;
+  bool is_sse2_ok = true;
+  for ( unsigned c = 0; c < 128; ++c ) {
+    if ( !set[c] )
+      continue;
+    scan_lo_bits[ c & 0x0F ] |= STATIC_CAST( uint8_t, 1u << (c >> 4) );
+    if ( scan_stop_len == SCAN_STOP_MAX )
+      is_sse2_ok = false;
+    else
+      scan_stop[ scan_stop_len++ ] = STATIC_CAST( char, c );
+  } // for
+
+  scan_fn = &scan_scalar;
+  for ( unsigned c = 128; c < 256; ++c ) {
+    if ( set[c] )
+      return;
+  } // for
+  switch ( simd_isa() ) {
+    case SIMD_ISA_SCALAR:
+      break;
+    case SIMD_ISA_SSE2:
+#ifdef WITH_SIMD_SSE2
+      if ( is_sse2_ok )
+        scan_fn = &scan_sse2;
+#endif /* WITH_SIMD_SSE2 */
+      break;
+    case SIMD_ISA_AVX2:
+#ifdef WITH_SIMD_AVX2
+      scan_fn = &scan_avx2;
+#endif /* WITH_SIMD_AVX2 */
+      break;
+    case SIMD_ISA_NEON:
+#ifdef WITH_SIMD_NEON
+      scan_fn = &scan_neon;
+#endif /* WITH_SIMD_NEON */
+      break;
+    case SIMD_ISA_WASM:
+#ifdef WITH_SIMD_WASM
+      scan_fn = &scan_wasm;
+#endif /* WITH_SIMD_WASM */
+      break;
+  } // switch
+  (void)is_sse2_ok;
+}
+
+size_t simd_span( char const *s, size_t max ) {
+  assert( s != NULL );
+  return (*span_fn)( s, max );
+}
+
+void simd_span_init( bool const set[const static 256] ) {
+  assert( !set[0] );
+  memcpy( span_set, set, sizeof span_set );
+  span_fn = &span_scalar;
+  if ( !span_set_is_range() )
+    return;
+  switch ( simd_isa() ) {
+    case SIMD_ISA_SCALAR:
+      break;
+    case SIMD_ISA_SSE2:
+#ifdef WITH_SIMD_SSE2
+      span_fn = &span_sse2;
+#endif /* WITH_SIMD_SSE2 */
+      break;
+    case SIMD_ISA_AVX2:
+#ifdef WITH_SIMD_AVX2
+      span_fn = &span_avx2;
+#endif /* WITH_SIMD_AVX2 */
+      break;
+    case SIMD_ISA_NEON:
+#ifdef WITH_SIMD_NEON
+      span_fn = &span_neon;
+#endif /* WITH_SIMD_NEON */
+      break;
+    case SIMD_ISA_WASM:
+#ifdef WITH_SIMD_WASM
+      span_fn = &span_wasm;
+#endif /* WITH_SIMD_WASM */
+      break;
+  } // switch
+}
+
+size_t simd_utf16_narrow( char const *s, size_t n, bool is_be, char *out ) {
+  assert( s != NULL || n == 0 );
+  assert( out != NULL || n == 0 );
+  return (*utf16_narrow_fn)( s, n, is_be, out );
+}
+
+size_t simd_utf16_widen( char const *s, size_t len, bool is_be, char *out ) {
+  assert( s != NULL || len == 0 );
+  assert( out != NULL || len == 0 );
+  return (*utf16_widen_fn)( s, len, is_be, out );
+}
+
+simd_utf8_t simd_utf8_check( char const *s, size_t len ) {
+  assert( s != NULL );
+  return (*utf8_check_fn)( s, len );
+}
+
+size_t simd_ws_rspan( char const *s, size_t len ) {
+  assert( s != NULL || len == 0 );
+  return (*ws_rspan_fn)( s, len );
+}
+
+size_t simd_ws_span( char const *s, size_t len ) {
+  assert( s != NULL || len == 0 );
+  return (*ws_span_fn)( s, len );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,268 @@
+/*
+**      wrap -- text reformatter
+**      src/simd.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_simd_H
+#define wrap_simd_H
+
+/**
+ * @file
+ * Declares functions for scanning runs of characters several at a time using
+ * SIMD instructions, when available.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+/**
+ * @defgroup simd-group SIMD Scanning
+ * Functions for scanning runs of characters or validating UTF-8 16 or 32 at a
+ * time using whichever SIMD instructions the CPU supports (chosen at
+ * run-time), falling back to one at a time.
+ *
+ * @remarks Every implementation of every function is compiled into the same
+ * binary for each instruction set the compiler supports for the target; which
+ * instruction set is used is chosen once by simd_init(): the best the CPU
+ * supports unless the `WRAP_FORCE_ISA` environment variable names another,
+ * e.g., to check that every one gives the same results on the same host.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The number of characters past the terminating null that must be readable
+ * for either simd_scan() or simd_span().
+ */
+#define SIMD_SPAN_PAD             32
+
+/**
+ * The reciprocal of the fraction of invalid UTF-8 characters above which
+ * simd_is_binary() considers characters binary.  It's low enough that text in
+ * an 8-bit encoding such as ISO 8859-1 isn't considered binary.
+ */
+#define SIMD_BINARY_INVALID_RATIO 4
+
+/**
+ * What simd_utf8_check() found.
+ */
+enum simd_utf8 {
+  SIMD_UTF8_ASCII,                      ///< Only ASCII characters.
+  SIMD_UTF8_VALID,                      ///< Only valid UTF-8 characters.
+  SIMD_UTF8_INVALID                     ///< At least one invalid byte.
+};
+typedef enum simd_utf8 simd_utf8_t;
+
+/**
+ * An instruction set the `simd_*()` functions may use.  Their order is that
+ * of preference.
+ */
+enum simd_isa {
+  SIMD_ISA_SCALAR,                      ///< None: one character at a time.
+  SIMD_ISA_SSE2,                        ///< x86-64 SSE2.
+  SIMD_ISA_AVX2,                        ///< x86-64 AVX2 (and SSE2).
+  SIMD_ISA_NEON,                        ///< AArch64 NEON.
+  SIMD_ISA_WASM                         ///< WebAssembly SIMD128.
+};
+typedef enum simd_isa simd_isa_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Chooses the instruction set to use and the implementations of the functions
+ * that don't depend on a set of characters unless they have been already.
+ * The functions choose them themselves when first called, but a program that
+ * calls them in several threads at once must call this first so the choice is
+ * only ever read by them.  Exits if `WRAP_FORCE_ISA` is set to an invalid
+ * value or to an instruction set this build or CPU doesn't support.
+ *
+ * @sa simd_isa()
+ */
+void simd_init( void );
+
+/**
+ * Checks whether \a s, typically the first block of a file, looks like binary
+ * data rather than text: it starts with a UTF-16 byte order mark, contains a
+ * null character, or more than 1 in #SIMD_BINARY_INVALID_RATIO of its
+ * characters are invalid UTF-8.  The common case of text is decided using
+ * only SIMD instructions.
+ *
+ * @param s The characters to check.  They need not be null-terminated.
+ * @param len The number of characters to check.
+ * @return Returns `true` only if \a s looks like binary data.
+ */
+NODISCARD
+bool simd_is_binary( char const *s, size_t len );
+
+/**
+ * Gets the instruction set in use, choosing it if it hasn't been already.
+ *
+ * @return Returns said instruction set.
+ *
+ * @sa simd_init()
+ * @sa simd_isa_name()
+ */
+NODISCARD
+simd_isa_t simd_isa( void );
+
+/**
+ * Gets the name of an instruction set, the same as `WRAP_FORCE_ISA` takes.
+ *
+ * @param isa The instruction set to get the name of.
+ * @return Returns said name.
+ */
+NODISCARD
+char const* simd_isa_name( simd_isa_t isa );
+
+/**
+ * Gets the number of characters at the start of \a s that are not in the set
+ * given to simd_scan_init().
+ *
+ * @param s The null-terminated string to scan.  It must be readable for
+ * #SIMD_SPAN_PAD characters past the terminating null.
+ * @return Returns said number of characters.
+ */
+NODISCARD
+size_t simd_scan( char const *s );
+
+/**
+ * Makes simd_scan(), simd_span(), simd_utf16_narrow(), simd_utf16_widen(),
+ * simd_utf8_check(), simd_ws_rspan(), and simd_ws_span() use only their scalar
+ * implementations from now on regardless of what the CPU supports or
+ * `WRAP_FORCE_ISA` names, e.g., to check that the SIMD ones give the same
+ * results.
+ */
+void simd_scalar_only( void );
+
+/**
+ * Sets the set of characters that simd_scan() stops at and chooses the
+ * implementation to use.
+ *
+ * @param set The set of characters indexed by `unsigned char`.  It must
+ * include the null character.  If it includes only ASCII characters, one of
+ * the SIMD implementations is used.
+ */
+void simd_scan_init( bool const set[const static 256] );
+
+/**
+ * Sets the set of characters that simd_span() spans and chooses the
+ * implementation to use.
+ *
+ * @param set The set of characters indexed by `unsigned char`.  It must not
+ * include the null character.  If it is a contiguous range of characters
+ * excluding no more than a few, one of the SIMD implementations is used.
+ */
+void simd_span_init( bool const set[const static 256] );
+
+/**
+ * Gets the number of characters at the start of \a s that are in the set
+ * given to simd_span_init().
+ *
+ * @param s The null-terminated string to span.  It must be readable for
+ * #SIMD_SPAN_PAD characters past the terminating null.
+ * @param max The maximum number of characters to span.
+ * @return Returns said number of characters.
+ */
+NODISCARD
+size_t simd_span( char const *s, size_t max );
+
+/**
+ * Narrows the UTF-16 code units at the start of \a s that are ASCII to UTF-8
+ * (where they're single bytes).  It stops at the first one that isn't so the
+ * caller can transcode it.
+ *
+ * @param s The UTF-16 code units.  They need not be aligned.
+ * @param n The number of code units (not bytes) of \a s.
+ * @param is_be If `true`, \a s is big-endian; else little-endian.
+ * @param out The buffer to narrow into.  It must have room for \a n bytes.
+ * @return Returns the number of code units narrowed.
+ *
+ * @sa simd_utf16_widen()
+ */
+NODISCARD
+size_t simd_utf16_narrow( char const *s, size_t n, bool is_be, char *out );
+
+/**
+ * Widens the ASCII characters at the start of \a s to UTF-16.  It stops at
+ * the first one that isn't ASCII so the caller can transcode it.
+ *
+ * @param s The UTF-8 characters.  They need not be null-terminated.
+ * @param len The number of characters of \a s.
+ * @param is_be If `true`, widen to big-endian; else little-endian.
+ * @param out The buffer to widen into.  It must have room for 2 * \a len
+ * bytes.
+ * @return Returns the number of characters widened.
+ *
+ * @sa simd_utf16_narrow()
+ */
+NODISCARD
+size_t simd_utf16_widen( char const *s, size_t len, bool is_be, char *out );
+
+/**
+ * Checks whether \a s is valid UTF-8.  Valid means: every character is
+ * encoded in the shortest possible form, is not a UTF-16 surrogate, is at
+ * most U+10FFFF, and is complete, i.e., does not continue past \a len.
+ *
+ * @param s The characters to check.  They need not be null-terminated.
+ * @param len The number of characters to check.
+ * @return Returns which of the \ref simd_utf8 cases \a s is.
+ */
+NODISCARD
+simd_utf8_t simd_utf8_check( char const *s, size_t len );
+
+/**
+ * Gets the number of spaces and tabs at the end of \a s.
+ *
+ * @param s The characters to span.  They need not be null-terminated.
+ * @param len The number of characters of \a s.
+ * @return Returns said number of characters.
+ *
+ * @sa simd_ws_span()
+ */
+NODISCARD
+size_t simd_ws_rspan( char const *s, size_t len );
+
+/**
+ * Gets the number of whitespace characters, including carriage returns and
+ * newlines, at the start of \a s.  Hence \a s is a blank line only if all of
+ * it is spanned.
+ *
+ * @param s The characters to span.  They need not be null-terminated.
+ * @param len The number of characters of \a s.
+ * @return Returns said number of characters.
+ *
+ * @sa simd_ws_rspan()
+ */
+NODISCARD
+size_t simd_ws_span( char const *s, size_t len );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_simd_H */
+/* vim:set et sw=2 ts=2: */
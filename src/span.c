@@ -0,0 +1,383 @@
+/*
+**      wrap -- text reformatter
+**      src/span.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for representing the words of output as spans.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#define W_SPAN_H_INLINE _GL_EXTERN_INLINE
+#include "span.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <float.h>                      /* for DBL_MAX */
+
+/// @endcond
+
+/**
+ * @addtogroup span-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Initial capacity of a \ref span_list.
+ */
+#define SPAN_LIST_CAP_INIT        64
+
+/**
+ * Cost per column of a line that's too wide.  It's proportional to (rather
+ * than infinitely more than) the excess width so that the cost of a line
+ * remains a convex function of its width as span_break_optimal() requires,
+ * but large enough that no amount of raggedness elsewhere outweighs it.
+ */
+#define SPAN_OVERFLOW_COST        1e12
+
+/**
+ * State for span_break_optimal().
+ *
+ * @remarks Breaks are numbered from 0 to the number of spans: break _k_ is
+ * just before span _k_ and the last break is just after the last span.  A
+ * line from break _i_ to break _j_ comprises spans _i_ through _j_-1.
+ *
+ * @remarks Lines starting at break 0 (the first line) are indented
+ * differently than those starting at any other break, so the cost of a line
+ * isn't a function of only where it ends minus where it starts (that the
+ * SMAWK algorithm relies on) for them.  Hence, break 0 is never one of the
+ * rows given to optimal_smawk(); instead, optimal_min() also considers it.
+ */
+struct optimal_state {
+  /**
+   * For each break, the width from the start of the line just before its
+   * span, including any preceding gap, as if there were only one line.
+   */
+  size_t   *pos;
+
+  /**
+   * For each break, \a pos minus the indentation of a line starting there
+   * plus the gap that is discarded, i.e., the width of the line from break
+   * _i_ (other than 0) to break _j_ is `pos[j] - start[i]`.
+   */
+  size_t   *start;
+
+  size_t    first_indent;               ///< Indentation of the first line.
+  double   *minima;                     ///< Minimal cost up to a break ...
+  size_t   *breaks;                     ///< ... and its last line's start ...
+                                        ///< ... both excluding break 0.
+  size_t    width_max;                  ///< Maximum width of a line.
+  size_t   *scratch;                    ///< Stack of rows and columns.
+  size_t    scratch_len;                ///< Length of \a scratch in use.
+};
+typedef struct optimal_state optimal_state_t;
+
+// local functions
+NODISCARD
+static double optimal_cost( optimal_state_t const*, size_t, size_t );
+
+NODISCARD
+static double optimal_line_cost( optimal_state_t const*, size_t );
+
+NODISCARD
+static double optimal_min( optimal_state_t const*, size_t );
+
+static void   optimal_smawk( optimal_state_t*, size_t const*, size_t,
+                             size_t const*, size_t );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Gets the minimal cost of all lines up to break \a j given that the last of
+ * them starts at break \a i.
+ *
+ * @param os The \ref optimal_state to use.
+ * @param i The break at which the last line starts.  It must not be 0.
+ * @param j The break at which the last line ends.
+ * @return Returns said cost.
+ */
+NODISCARD
+static double optimal_cost( optimal_state_t const *os, size_t i, size_t j ) {
+  assert( i > 0 );
+  assert( i < j );
+  return optimal_min( os, i ) + optimal_line_cost( os, os->pos[j] - os->start[i] );
+}
+
+/**
+ * Gets the cost of a line.
+ *
+ * @param os The \ref optimal_state to use.
+ * @param width The width of the line.
+ * @return Returns the square of the number of unused columns or, if \a width
+ * is too wide, a cost proportional to the excess width.
+ */
+NODISCARD
+static double optimal_line_cost( optimal_state_t const *os, size_t width ) {
+  if ( width > os->width_max )
+    return SPAN_OVERFLOW_COST * STATIC_CAST( double, width - os->width_max );
+  double const unused = STATIC_CAST( double, os->width_max - width );
+  return unused * unused;
+}
+
+/**
+ * Gets the minimal cost of all lines up to break \a j, i.e., the lesser of
+ * the cost of only a first line up to it and \ref optimal_state::minima.
+ *
+ * @param os The \ref optimal_state to use.
+ * @param j The break.  Unless it's 0, \ref optimal_state::minima for it must
+ * already be final.
+ * @return Returns said cost.
+ */
+NODISCARD
+static double optimal_min( optimal_state_t const *os, size_t j ) {
+  if ( j == 0 )
+    return 0;
+  double const first =
+    optimal_line_cost( os, os->first_indent + os->pos[j] - os->pos[0] );
+  return first < os->minima[j] ? first : os->minima[j];
+}
+
+/**
+ * Finds, for each of \a cols, the row of \a rows at which optimal_cost() is
+ * minimal and updates \ref optimal_state::minima and \ref
+ * optimal_state::breaks accordingly using the SMAWK algorithm, that is linear
+ * in the number of rows plus columns.
+ *
+ * @param os The \ref optimal_state to use.
+ * @param rows The breaks at which lines may start in ascending order.
+ * @param rows_len The number of \a rows.
+ * @param cols The breaks at which lines may end in ascending order.  Each
+ * must be greater than every one of \a rows.
+ * @param cols_len The number of \a cols.
+ */
+static void optimal_smawk( optimal_state_t *os, size_t const *rows,
+                           size_t rows_len, size_t const *cols,
+                           size_t cols_len ) {
+  assert( rows_len > 0 );
+  assert( cols_len > 0 );
+
+  //
+  // Reduce: discard rows that can't contain the minimum of any column so that
+  // there are no more rows than columns.
+  //
+  size_t *const stack = os->scratch + os->scratch_len;
+  size_t stack_len = 0;
+  for ( size_t i = 0; i < rows_len; ) {
+    if ( stack_len == 0 ) {
+      stack[ stack_len++ ] = rows[ i++ ];
+      continue;
+    }
+    size_t const col = cols[ stack_len - 1 ];
+    if ( optimal_cost( os, stack[ stack_len - 1 ], col ) <
+         optimal_cost( os, rows[i], col ) ) {
+      if ( stack_len < cols_len )
+        stack[ stack_len++ ] = rows[i];
+      ++i;
+    } else {
+      --stack_len;
+    }
+  } // for
+  os->scratch_len += stack_len;
+
+  //
+  // Recurse on the odd columns.
+  //
+  if ( cols_len > 1 ) {
+    size_t *const odd_cols = os->scratch + os->scratch_len;
+    size_t const odd_cols_len = cols_len / 2;
+    for ( size_t j = 0; j < odd_cols_len; ++j )
+      odd_cols[j] = cols[ 2 * j + 1 ];
+    os->scratch_len += odd_cols_len;
+    optimal_smawk( os, stack, stack_len, odd_cols, odd_cols_len );
+    os->scratch_len -= odd_cols_len;
+  }
+
+  //
+  // Interpolate: the minimum of each even column lies between the minima of
+  // its neighboring odd columns.
+  //
+  for ( size_t i = 0, j = 0; j < cols_len; ) {
+    size_t const end = j + 1 < cols_len ?
+      os->breaks[ cols[ j + 1 ] ] : stack[ stack_len - 1 ];
+    double const cost = optimal_cost( os, stack[i], cols[j] );
+    if ( cost < os->minima[ cols[j] ] ) {
+      os->minima[ cols[j] ] = cost;
+      os->breaks[ cols[j] ] = stack[i];
+    }
+    if ( stack[i] < end )
+      ++i;
+    else
+      j += 2;
+  } // for
+
+  os->scratch_len -= stack_len;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+size_t* span_break_optimal( span_list_t const *list, size_t first_indent,
+                            size_t indent, size_t width_max,
+                            size_t *plines_len ) {
+  assert( list != NULL );
+  assert( list->len > 0 );
+  assert( plines_len != NULL );
+
+  size_t const spans_len = list->len;
+  size_t const breaks_len = spans_len + 1;
+
+  size_t const array_size = breaks_len * sizeof( size_t );
+  size_t const minima_size = breaks_len * sizeof( double );
+  optimal_state_t os = {
+    .pos = huge_alloc( array_size ),
+    .start = huge_alloc( array_size ),
+    .first_indent = first_indent,
+    .minima = huge_alloc( minima_size ),
+    .breaks = huge_alloc( array_size ),
+    .width_max = width_max,
+    .scratch = huge_alloc( 5 * array_size ),
+  };
+
+  os.pos[0] = indent;                   // so start[] never underflows
+  os.start[0] = os.pos[0];
+  os.minima[0] = 0;
+  os.breaks[0] = 0;
+  for ( size_t k = 0; k < spans_len; ++k ) {
+    word_span_t const *const span = &list->spans[k];
+    size_t const gap = k > 0 ? span->gap : 0;
+    if ( k > 0 ) {
+      os.start[k] = os.pos[k] + gap - indent;
+      os.minima[k] = DBL_MAX;
+    }
+    os.pos[ k + 1 ] = os.pos[k] + gap + span->width;
+  } // for
+  os.start[ spans_len ] = os.pos[ spans_len ];
+  os.minima[ spans_len ] = DBL_MAX;
+
+  //
+  // Find the minima of successively twice as many columns (breaks) at a time
+  // using only the rows (breaks) whose minima have already been found.  If a
+  // column's minimum could come from one of the breaks within the current
+  // batch of columns, start over from that break.  (This is a simplified form
+  // of Wilber's algorithm for the concave least-weight subsequence problem.)
+  //
+  size_t *const rows = os.scratch;
+  size_t *const cols = os.scratch + breaks_len;
+  os.scratch_len = 2 * breaks_len;
+
+  for ( size_t batch = 1, n = spans_len, offset = 1; n > 1; ) {
+    size_t const r = n < batch * 2 ? n : batch * 2;
+    for ( size_t k = 0; k < batch; ++k )
+      rows[k] = offset + k;
+    for ( size_t k = batch; k < r; ++k )
+      cols[ k - batch ] = offset + k;
+    optimal_smawk( &os, rows, batch, cols, r - batch );
+
+    double const last_min = os.minima[ offset + r - 1 ];
+    size_t restart = 0;
+    for ( size_t k = batch; k < r - 1; ++k ) {
+      if ( optimal_cost( &os, offset + k, offset + r - 1 ) <= last_min ) {
+        restart = k;
+        break;
+      }
+    } // for
+    if ( restart > 0 ) {
+      n -= restart;
+      offset += restart;
+      batch = 1;
+    }
+    else if ( r == n ) {
+      break;
+    }
+    else {
+      batch *= 2;
+    }
+  } // for
+
+  //
+  // Given where a line ends, gets where it starts.
+  //
+#define LINE_START(J) \
+  ( optimal_min( &os, (J) ) < os.minima[ (J) ] ? 0 : os.breaks[ (J) ] )
+
+  //
+  // The last line doesn't count toward the raggedness, so it can start at any
+  // break after which it fits: pick the one having the minimal cost before
+  // it.
+  //
+  size_t last_start = LINE_START( spans_len );
+  double last_min = DBL_MAX;
+  for ( size_t i = spans_len; --i > 0; ) {
+    if ( os.pos[ spans_len ] - os.start[i] > width_max )
+      break;
+    double const cost = optimal_min( &os, i );
+    if ( cost < last_min ) {
+      last_min = cost;
+      last_start = i;
+    }
+  } // for
+  if ( first_indent + os.pos[ spans_len ] - os.pos[0] <= width_max )
+    last_start = 0;                     // it all fits on the first line
+
+  size_t lines_len = 1;
+  for ( size_t i = last_start; i > 0; i = LINE_START( i ) )
+    ++lines_len;
+  size_t *const starts = MALLOC( size_t, lines_len );
+  for ( size_t i = last_start, line = lines_len; line > 0;
+        i = LINE_START( i ) ) {
+    starts[ --line ] = i;
+  } // for
+
+#undef LINE_START
+
+  huge_free( os.pos, array_size );
+  huge_free( os.start, array_size );
+  huge_free( os.minima, minima_size );
+  huge_free( os.breaks, array_size );
+  huge_free( os.scratch, 5 * array_size );
+  *plines_len = lines_len;
+  return starts;
+}
+
+void span_list_cleanup( span_list_t *list ) {
+  assert( list != NULL );
+  huge_free( list->spans, list->cap * sizeof( word_span_t ) );
+  *list = (span_list_t){ 0 };
+}
+
+void span_list_grow( span_list_t *list ) {
+  assert( list != NULL );
+  size_t const old_cap = list->cap;
+  list->cap = old_cap > 0 ? old_cap * 2 : SPAN_LIST_CAP_INIT;
+  list->spans = huge_realloc(
+    list->spans, old_cap * sizeof( word_span_t ),
+    list->cap * sizeof( word_span_t )
+  );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
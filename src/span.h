@@ -0,0 +1,166 @@
+/*
+**      wrap -- text reformatter
+**      src/span.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_span_H
+#define wrap_span_H
+
+/**
+ * @file
+ * Declares data structures and functions for representing the words of
+ * output as spans.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stddef.h>                     /* for size_t */
+
+/// @endcond
+
+_GL_INLINE_HEADER_BEGIN
+#ifndef W_SPAN_H_INLINE
+# define W_SPAN_H_INLINE _GL_INLINE
+#endif /* W_SPAN_H_INLINE */
+
+/**
+ * @defgroup span-group Word Spans
+ * Data structures and functions for representing the words of output as an
+ * array of spans so that where lines can be broken is known without having
+ * to rescan (or decode) the characters of the words themselves.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A span of characters in an output buffer between two places at which a line
+ * can be broken, i.e., a word or, for a hyphenated word, the part of it after
+ * a hyphen.
+ */
+struct word_span {
+  size_t  offset;                       ///< Offset of first character.
+  size_t  len;                          ///< Length in bytes.
+  size_t  width;                        ///< Width in characters.
+
+  /**
+   * Number of spaces preceding the span that are discarded if the line is
+   * broken before it, or 0 if it follows a hyphen.
+   */
+  size_t  gap;
+};
+typedef struct word_span word_span_t;
+
+/**
+ * An array of \ref word_span.
+ */
+struct span_list {
+  word_span_t  *spans;                  ///< Array of spans.
+  size_t        len;                    ///< Number of spans.
+  size_t        cap;                    ///< Capacity of \a spans.
+};
+typedef struct span_list span_list_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees the memory used by \a list.
+ *
+ * @param list The \ref span_list to clean up.
+ */
+void span_list_cleanup( span_list_t *list );
+
+/**
+ * Chooses where to break the spans of \a list into lines so that the total
+ * raggedness, i.e., the sum of the squares of the number of unused columns
+ * at the ends of all lines but the last, is minimal.  The time taken is
+ * linear in the number of spans.
+ *
+ * @param list The \ref span_list to break into lines.  It must not be empty.
+ * @param first_indent The width preceding the first span of the first line.
+ * @param indent The width preceding the first span of every other line.
+ * @param width_max The maximum width of a line including indentation.  A line
+ * is wider only if some span is too wide to fit on a line by itself.
+ * @param plines_len A pointer to receive the number of lines.
+ * @return Returns an array of the indices into \a list of the first span of
+ * each line.  The caller is responsible for freeing it.
+ */
+NODISCARD
+size_t* span_break_optimal( span_list_t const *list, size_t first_indent,
+                            size_t indent, size_t width_max,
+                            size_t *plines_len );
+
+/**
+ * Grows \a list so that it can hold at least one more span.
+ *
+ * @param list The \ref span_list to grow.
+ *
+ * @sa span_list_push()
+ */
+void span_list_grow( span_list_t *list );
+
+/**
+ * Empties \a list.
+ *
+ * @param list The \ref span_list to empty.
+ */
+W_SPAN_H_INLINE
+void span_list_clear( span_list_t *list ) {
+  list->len = 0;
+}
+
+/**
+ * Gets the last span of \a list.
+ *
+ * @param list The \ref span_list to use.  It must not be empty.
+ * @return Returns said span.
+ */
+NODISCARD W_SPAN_H_INLINE
+word_span_t* span_list_last( span_list_t *list ) {
+  return &list->spans[ list->len - 1 ];
+}
+
+/**
+ * Appends a new, empty span to \a list.
+ *
+ * @param list The \ref span_list to append to.
+ * @param offset The offset of the span's first character.
+ * @param gap The number of spaces preceding the span.
+ * @return Returns the new span.
+ */
+W_SPAN_H_INLINE
+word_span_t* span_list_push( span_list_t *list, size_t offset, size_t gap ) {
+  if ( list->len == list->cap )
+    span_list_grow( list );
+  word_span_t *const span = &list->spans[ list->len++ ];
+  *span = (word_span_t){ .offset = offset, .gap = gap };
+  return span;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+_GL_INLINE_HEADER_END
+
+#endif /* wrap_span_H */
+/* vim:set et sw=2 ts=2: */
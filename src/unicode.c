@@ -49,9 +49,6 @@ static char32_t const CP_SURROGATE_HIGH_START = 0x00D800u;
 /// Unicode code-point surrogate low end.
 static char32_t const CP_SURROGATE_LOW_END    = 0x00DFFFu;
 
-/// Maximum valid Unicode code-point.
-static char32_t const CP_VALID_MAX            = 0x10FFFFu;
-
 /**
  * UTF-8 character length table indexed by the first octet of the character.
  */
@@ -75,6 +72,39 @@ char8_t const UTF8_LEN_TABLE[] = {
   /* F */ 4,4,4,4,4,4,4,4,5,5,5,5,6,6,0,0
 };
 
+/// @cond DOXYGEN_IGNORE
+#define A   CP_PROP_ALPHA
+#define C   CP_PROP_CONTROL
+#define E   CP_PROP_EOS
+#define H   CP_PROP_HYPHEN
+#define S   CP_PROP_SPACE
+#define W   CP_PROP_WORD
+#define X   CP_PROP_EOS_EXT
+/// @endcond
+
+/**
+ * Properties of ASCII characters indexed by code-point.
+ */
+cp_props_t const CP_PROPS_ASCII[] = {
+  /*        0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F */
+  /* 0 */   C,  C,  C,  C,  C,  C,  C,  C,  C,C|S,C|S,C|S,C|S,C|S,  C,  C,
+  /* 1 */   C,  C,  C,  C,  C,  C,  C,  C,  C,  C,  C,  C,  C,  C,  C,  C,
+  /* 2 */   S,  E,  X,  0,  0,  0,  0,  X,  0,  X,  0,  0,  0,  H,  E,  0,
+  /* 3 */   W,  W,  W,  W,  W,  W,  W,  W,  W,  W,  0,  0,  0,  0,  0,  E,
+  /* 4 */   0,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,
+  /* 5 */ A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,  0,  0,  X,  0,  W,
+  /* 6 */   0,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,
+  /* 7 */ A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,A|W,  0,  0,  X,  0,  C
+};
+
+#undef A
+#undef C
+#undef E
+#undef H
+#undef S
+#undef W
+#undef X
+
 ////////// inline functions ///////////////////////////////////////////////////
 
 /**
@@ -91,115 +121,53 @@ static inline bool cp_is_valid( char32_t cp ) {
 
 ////////// extern functions ///////////////////////////////////////////////////
 
-bool cp_is_eos( char32_t cp ) {
-  switch ( cp ) {
-    case '.'   :  // FULL STOP
-    case 0xFF0E:  // FULLWIDTH FULL STOP
-
-    case '?'   :  // QUESTION MARK
-    case 0x037E:  // GREEK QUESTION MARK
-    case 0x055E:  // ARMENIAN QUESTION MARK
-    case 0x1367:  // ETHIOPIC QUESTION MARK
-    case 0x1945:  // LIMBU QUESTION MARK
-    case 0x2047:  // DOUBLE QUESTION MARK
-    case 0x2048:  // QUESTION EXCLAMATION MARK
-    case 0xA60F:  // VAI QUESTION MARK
-    case 0xA6F7:  // BAMUM QUESTION MARK
-    case 0xFE16:  // PRESENTATION FORM FOR VERTICAL QUESTION MARK
-    case 0xFE56:  // SMALL QUESTION MARK
-    case 0xFF1F:  // FULLWIDTH QUESTION MARK
-
-    case '!'   :  // EXCLAMATION MARK
-    case 0x055C:  // ARMENIAN EXCLAMATION MARK
-    case 0x07F9:  // NKO EXCLAMATION MARK
-    case 0x1944:  // LIMBU EXCLAMATION MARK
-    case 0x203C:  // DOUBLE EXCLAMATION MARK
-    case 0x2049:  // EXCLAMATION QUESTION MARK
-    case 0x2757:  // HEAVY EXCLAMATION MARK SYMBOL
-    case 0x2762:  // HEAVY EXCLAMATION MARK ORNAMENT
-    case 0x2763:  // HEAVY HEART EXCLAMATION MARK ORNAMENT
-    case 0xFE15:  // PRESENTATION FORM FOR VERTICAL EXCLAMATION MARK
-    case 0xFE57:  // SMALL EXCLAMATION MARK
-    case 0xFF01:  // FULLWIDTH EXCLAMATION MARK
-      return true;
-
-    default:
-      return false;
-  } // switch
-}
-
-bool cp_is_eos_ext( char32_t cp ) {
-  switch ( cp ) {
-    case '\''  :  // APOSTROPHE
-    case 0x2019:  // RIGHT SINGLE QUOTATION MARK
-    case 0x203A:  // SINGLE RIGHT-POINTING ANGLE QUOTATION MARK
-    case 0x275C:  // HEAVY SINGLE COMMA QUOTATION MARK ORNAMENT
-
-    case '"'   :  // QUOTATION MARK
-    case 0x00BB:  // RIGHT-POINTING DOUBLE ANGLE QUOTATION MARK
-    case 0x201D:  // RIGHT DOUBLE QUOTATION MARK
-    case 0x275E:  // HEAVY DOUBLE COMMA QUOTATION MARK ORNAMENT
-    case 0x276F:  // HEAVY RIGHT-POINTING ANGLE QUOTATION MARK ORNAMENT
-    case 0xFF02:  // FULLWIDTH QUOTATION MARK
-
-    case ')'   :  // RIGHT PARENTHESIS
-    case 0x2769:  // MEDIUM RIGHT PARENTHESIS ORNAMENT
-    case 0x276B:  // MEDIUM FLATTENED RIGHT PARENTHESIS ORNAMENT
-    case 0x27EF:  // MATHEMATICAL RIGHT FLATTENED PARENTHESIS
-    case 0x2986:  // RIGHT WHITE PARENTHESIS
-    case 0x2E29:  // RIGHT DOUBLE PARENTHESIS
-    case 0xFD3F:  // ORNATE RIGHT PARENTHESIS
-    case 0xFE5A:  // SMALL RIGHT PARENTHESIS
-    case 0xFF09:  // FULLWIDTH RIGHT PARENTHESIS
-    case 0xFF60:  // FULLWIDTH RIGHT WHITE PARENTHESIS
-
-    case ']'   :  // RIGHT SQUATE BRACKET
-    case 0x2046:  // RIGHT SQUARE BRACKET WITH QUILL
-    case 0x27E7:  // MATHEMATICAL RIGHT WHITE SQUARE BRACKET
-    case 0x298C:  // RIGHT SQUARE BRACKET WITH UNDERBAR
-    case 0x298E:  // RIGHT SQUARE BRACKET WITH TICK IN BOTTOM CORNER
-    case 0x2990:  // RIGHT SQUARE BRACKET WITH TICK IN TOP CORNER
-    case 0x301B:  // RIGHT WHITE SQUARE BRACKET
-    case 0xFF3D:  // FULLWIDTH RIGHT SQUARE BRACKET
-      return true;
-
-    default:
-      return false;
+/**
+ * Checks whether there is a grapheme cluster boundary before \a cp.
+ *
+ * @note This out-of-line version is for all but printable ASCII.
+ *
+ * @param state A pointer to the segmentation state to update.
+ * @param cp The Unicode code-point to check.
+ * @return Returns `true` only if there is a boundary before \a cp.
+ *
+ * @sa cp_gcb_is_break()
+ */
+bool cp_gcb_is_break_impl( cp_gcb_state_t *state, char32_t cp ) {
+  extern uint16_t const CP_GCB_BREAKS[];
+  assert( state != NULL );
+
+  cp_gcb_t const gcb = cp_gcb( cp );
+  cp_gcb_state_t const prev = *state;
+  cp_gcb_t const prev_gcb = prev & CP_GCB_STATE_MASK;
+  bool is_break = ((CP_GCB_BREAKS[ prev_gcb ] >> gcb) & 1u) != 0;
+  unsigned flags = 0;
+
+  //
+  // The pair table has rules GB3-GB9b; these rules need more context.
+  //
+  switch ( gcb ) {
+    case CP_GCB_EXT_PICT:               // GB11: ExtPict Extend* ZWJ x ExtPict
+      if ( prev_gcb == CP_GCB_ZWJ && (prev & CP_GCB_STATE_PICT) != 0 )
+        is_break = false;
+      flags = CP_GCB_STATE_PICT;
+      break;
+    case CP_GCB_EXTEND:
+    case CP_GCB_ZWJ:
+      if ( prev_gcb != CP_GCB_ZWJ )
+        flags = prev & CP_GCB_STATE_PICT;
+      break;
+    case CP_GCB_RI:                     // GB12, GB13: pairs of RIs
+      if ( prev_gcb == CP_GCB_RI && (prev & CP_GCB_STATE_RI_ODD) != 0 )
+        is_break = false;
+      else
+        flags = CP_GCB_STATE_RI_ODD;
+      break;
   } // switch
-}
 
-bool cp_is_hyphen( char32_t cp ) {
-  switch ( cp ) {
-    case '-'   :  // HYPHEN-MINUS
-    case 0x00AD:  // SOFT HYPHEN
-    case 0x058A:  // ARMENIAN HYPHEN
-    case 0x05BE:  // HEBREW PUNCTUATION MAQAF
-    case 0x1400:  // CANADIAN SYLLABICS HYPHEN
-    case 0x1806:  // MONGOLIAN SOFT HYPHEN
-    case 0x2010:  // HYPHEN
-//  case 0x2011:  // NON-BREAKING HYPHEN // obviously don't want to wrap here
-    case 0x2013:  // EN DASH
-    case 0x2014:  // EM DASH
-    case 0x2015:  // HORIZONTAL BAR
-    case 0x2027:  // HYPHENATION POINT
-    case 0x2043:  // HYPHEN BULLET
-    case 0x2053:  // SWUNG DASH
-    case 0x2E17:  // DOUBLE OBLIQUE HYPHEN
-    case 0x2E1A:  // HYPHEN WITH DIAERESIS
-    case 0x2E40:  // DOUBLE HYPHEN
-    case 0x301C:  // WAVE DASH
-    case 0x3030:  // WAVY DASH
-    case 0x30A0:  // KATAKANA-HIRAGANA DOUBLE HYPHEN
-    case 0x30FB:  // KATAKANA MIDDLE DOT
-    case 0xFE58:  // SMALL EM DASH
-    case 0xFE63:  // SMALL HYPHEN-MINUS
-    case 0xFF0D:  // FULLWIDTH HYPHEN-MINUS
-    case 0xFF65:  // HALFWIDTH KATAKANA MIDDLE DOT
-      return true;
-
-    default:
-      return false;
-  } // switch
+  if ( !is_break )
+    flags |= CP_GCB_STATE_CONT;
+  *state = STATIC_CAST( cp_gcb_state_t, gcb | flags );
+  return is_break;
 }
 
 /**
@@ -253,12 +221,48 @@ char32_t utf8_decode_impl( char const *s ) {
  *
  * @sa utf8_rsync()
  */
+size_t utf8_encode( char32_t cp, char *dest ) {
+  assert( dest != NULL );
+  if ( cp < 0x80 ) {
+    dest[0] = STATIC_CAST( char, cp );
+    return 1;
+  }
+  if ( cp < 0x800 ) {
+    dest[0] = STATIC_CAST( char, 0xC0 | (cp >> 6) );
+    dest[1] = STATIC_CAST( char, 0x80 | (cp & 0x3F) );
+    return 2;
+  }
+  if ( cp < 0x10000 ) {
+    dest[0] = STATIC_CAST( char, 0xE0 | (cp >> 12) );
+    dest[1] = STATIC_CAST( char, 0x80 | ((cp >> 6) & 0x3F) );
+    dest[2] = STATIC_CAST( char, 0x80 | (cp & 0x3F) );
+    return 3;
+  }
+  dest[0] = STATIC_CAST( char, 0xF0 | (cp >> 18) );
+  dest[1] = STATIC_CAST( char, 0x80 | ((cp >> 12) & 0x3F) );
+  dest[2] = STATIC_CAST( char, 0x80 | ((cp >> 6) & 0x3F) );
+  dest[3] = STATIC_CAST( char, 0x80 | (cp & 0x3F) );
+  return 4;
+}
+
 char const* utf8_rsync_impl( char const *buf, char const *pos ) {
   while ( pos > buf && utf8_is_cont( *pos ) )
     --pos;
   return utf8_is_start( *pos ) ? pos : NULL;
 }
 
+size_t utf8_width( char const *s ) {
+  assert( s != NULL );
+  size_t const len = utf8_len( *s );
+  if ( len <= 1 )                       // ASCII or invalid
+    return 1;
+  for ( size_t i = 1; i < len; ++i ) {
+    if ( !utf8_is_cont( s[i] ) )        // truncated, e.g., by the terminator
+      return 1;
+  } // for
+  return cp_width( utf8_decode( s ) );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
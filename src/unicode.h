@@ -41,7 +41,6 @@
 #if HAVE_CHAR8_T || HAVE_CHAR32_T
 #include <uchar.h>
 #endif /* HAVE_CHAR8_T || HAVE_CHAR32_T */
-#include <wctype.h>
 
 /// @endcond
 
@@ -70,15 +69,194 @@ typedef uint32_t char32_t;
 /// Unicode byte order mark (BOM).
 #define CP_BYTE_ORDER_MARK        0x00FEFFu
 
+/// UTF-8 encoding of #CP_BYTE_ORDER_MARK.
+#define UTF8_BYTE_ORDER_MARK      "\xEF\xBB\xBF"
+
 /// A UTF-32 version of `EOF`.
 #define CP_EOF                    ((char32_t)EOF)
 
 /// Value for invalid Unicode code-point.
 #define CP_INVALID                0x1FFFFFu
 
+/// Code-point replacing a character that can't be decoded.
+#define CP_REPLACEMENT            0x00FFFDu
+
+/// Maximum valid Unicode code-point.
+#define CP_VALID_MAX              0x10FFFFu
+
 /// Max number of bytes needed for a UTF-8 character.
 #define UTF8_CHAR_SIZE_MAX        6
 
+/**
+ * Number of bits of a code-point that index into a block of the table of
+ * code-point properties.
+ *
+ * @sa cp_props()
+ */
+#define CP_PROPS_BLOCK_SHIFT      7
+
+/// One past the last code-point in the table of code-point properties.
+#define CP_PROPS_TABLE_END        0x40000u
+
+/**
+ * Number of bits of a code-point that index into a block of the table of
+ * code-point display widths.
+ *
+ * @sa cp_width()
+ */
+#define CP_WIDTH_BLOCK_SHIFT      7
+
+/// One past the last code-point in the table of code-point display widths.
+#define CP_WIDTH_TABLE_END        0x40000u
+
+/**
+ * Number of bits of a code-point that index into a block of the table of
+ * code-point grapheme cluster break properties.
+ *
+ * @sa cp_gcb()
+ */
+#define CP_GCB_BLOCK_SHIFT        7
+
+/// One past the last code-point in the table of grapheme cluster break
+/// properties.
+#define CP_GCB_TABLE_END          0x40000u
+
+/// Initial grapheme cluster segmentation state: the start of text.
+#define CP_GCB_STATE_INIT         CP_GCB_CONTROL
+
+/**
+ * Number of bits of a code-point that index into a block of the table of
+ * code-point line-breaking classes.
+ *
+ * @sa cp_lb()
+ */
+#define CP_LB_BLOCK_SHIFT         7
+
+/// One past the last code-point in the table of line-breaking classes.
+#define CP_LB_TABLE_END           0x40000u
+
+/**
+ * Unicode grapheme cluster break properties (see [Unicode Standard Annex #29:
+ * Unicode Text Segmentation](https://www.unicode.org/reports/tr29/)) plus
+ * Extended_Pictographic (that are otherwise Other).
+ *
+ * @note `mkunicode.py` reads these to generate the tables, so they must be
+ * listed one per line in this form.
+ *
+ * @sa cp_gcb()
+ */
+enum cp_gcb {
+  CP_GCB_OTHER,                         ///< Any other character.
+  CP_GCB_CONTROL,                       ///< Control.
+  CP_GCB_CR,                            ///< Carriage return.
+  CP_GCB_EXTEND,                        ///< Extend.
+  CP_GCB_EXT_PICT,                      ///< Extended pictographic.
+  CP_GCB_L,                             ///< Hangul leading jamo.
+  CP_GCB_LF,                            ///< Line feed.
+  CP_GCB_LV,                            ///< Hangul LV syllable.
+  CP_GCB_LVT,                           ///< Hangul LVT syllable.
+  CP_GCB_PREPEND,                       ///< Prepended concatenation mark.
+  CP_GCB_RI,                            ///< Regional indicator.
+  CP_GCB_SPACING_MARK,                  ///< Spacing mark.
+  CP_GCB_T,                             ///< Hangul trailing jamo.
+  CP_GCB_V,                             ///< Hangul vowel jamo.
+  CP_GCB_ZWJ,                           ///< Zero width joiner.
+  CP_GCB_COUNT                          ///< Number of properties.
+};
+
+/**
+ * A \ref cp_gcb value.
+ */
+typedef uint8_t cp_gcb_t;
+
+/**
+ * Grapheme cluster segmentation state: the \ref cp_gcb of the previous
+ * code-point in the low 4 bits plus the `CP_GCB_STATE_*` bits.
+ *
+ * @sa cp_gcb_is_break()
+ */
+typedef uint8_t cp_gcb_state_t;
+
+#define CP_GCB_STATE_MASK   0x0Fu       /**< The previous \ref cp_gcb. */
+#define CP_GCB_STATE_CONT   (1u << 4)   /**< Previous continued a cluster. */
+#define CP_GCB_STATE_PICT   (1u << 5)   /**< In ExtPict Extend* ZWJ? */
+#define CP_GCB_STATE_RI_ODD (1u << 6)   /**< Odd number of RIs so far. */
+
+/**
+ * Unicode line-breaking classes (see [Unicode Standard Annex #14: Unicode Line
+ * Breaking Algorithm](https://www.unicode.org/reports/tr14/)) as resolved by
+ * rule LB1 without a dictionary: AI, SG, SA, and XX are AL (except SA
+ * combining marks that are CM); CJ is ID; and CR, LF, and NL are BK.
+ *
+ * @note `mkunicode.py` reads these to generate the tables, so they must be
+ * listed one per line in this form.
+ *
+ * @sa cp_lb()
+ */
+enum cp_lb {
+  CP_LB_AL,                             ///< Alphabetic.
+  CP_LB_B2,                             ///< Break opportunity before & after.
+  CP_LB_BA,                             ///< Break after.
+  CP_LB_BB,                             ///< Break before.
+  CP_LB_BK,                             ///< Mandatory break.
+  CP_LB_CB,                             ///< Contingent break.
+  CP_LB_CL,                             ///< Close punctuation.
+  CP_LB_CM,                             ///< Combining mark.
+  CP_LB_CP,                             ///< Close parenthesis.
+  CP_LB_EB,                             ///< Emoji base.
+  CP_LB_EM,                             ///< Emoji modifier.
+  CP_LB_EX,                             ///< Exclamation or interrogation.
+  CP_LB_GL,                             ///< Non-breaking ("glue").
+  CP_LB_H2,                             ///< Hangul LV syllable.
+  CP_LB_H3,                             ///< Hangul LVT syllable.
+  CP_LB_HL,                             ///< Hebrew letter.
+  CP_LB_HY,                             ///< Hyphen.
+  CP_LB_ID,                             ///< Ideographic.
+  CP_LB_IN,                             ///< Inseparable.
+  CP_LB_IS,                             ///< Infix numeric separator.
+  CP_LB_JL,                             ///< Hangul L jamo.
+  CP_LB_JT,                             ///< Hangul T jamo.
+  CP_LB_JV,                             ///< Hangul V jamo.
+  CP_LB_NS,                             ///< Nonstarter.
+  CP_LB_NU,                             ///< Numeric.
+  CP_LB_OP,                             ///< Open punctuation.
+  CP_LB_PO,                             ///< Postfix numeric.
+  CP_LB_PR,                             ///< Prefix numeric.
+  CP_LB_QU,                             ///< Quotation.
+  CP_LB_RI,                             ///< Regional indicator.
+  CP_LB_SP,                             ///< Space.
+  CP_LB_SY,                             ///< Symbols allowing break after.
+  CP_LB_WJ,                             ///< Word joiner.
+  CP_LB_ZW,                             ///< Zero width space.
+  CP_LB_ZWJ,                            ///< Zero width joiner.
+  CP_LB_COUNT                           ///< Number of classes.
+};
+
+/**
+ * A \ref cp_lb value.
+ */
+typedef uint8_t cp_lb_t;
+
+/**
+ * Unicode code-point properties.
+ *
+ * @sa cp_props()
+ */
+enum cp_prop {
+  CP_PROP_ALPHA   = 1u << 0,            ///< Alphabetic.
+  CP_PROP_CONTROL = 1u << 1,            ///< Control.
+  CP_PROP_EOS     = 1u << 2,            ///< End-of-sentence.
+  CP_PROP_EOS_EXT = 1u << 3,            ///< End-of-sentence-extender.
+  CP_PROP_HYPHEN  = 1u << 4,            ///< Hyphen-like.
+  CP_PROP_SPACE   = 1u << 5,            ///< Space.
+  CP_PROP_WORD    = 1u << 6             ///< Alphanumeric or `_`.
+};
+
+/**
+ * Bitwise-or of \ref cp_prop.
+ */
+typedef uint8_t cp_props_t;
+
 /**
  * UTF-8 character.
  */
@@ -86,6 +264,144 @@ typedef char utf8c_t[ UTF8_CHAR_SIZE_MAX ];
 
 ////////// extern functions ///////////////////////////////////////////////////
 
+/**
+ * Gets the grapheme cluster break property of \a cp.
+ *
+ * @note This inline version is optimized for the common case of code-points in
+ * the table.
+ *
+ * @param cp The Unicode code-point to get the grapheme cluster break property
+ * of.
+ * @return Returns said property.
+ *
+ * @sa cp_gcb_impl()
+ * @sa cp_gcb_is_break()
+ */
+NODISCARD W_UNICODE_H_INLINE
+cp_gcb_t cp_gcb( char32_t cp ) {
+  extern uint8_t const CP_GCB_STAGE1[];
+  extern cp_gcb_t const CP_GCB_STAGE2[];
+  extern cp_gcb_t cp_gcb_impl( char32_t );
+  if ( cp >= CP_GCB_TABLE_END )
+    return cp_gcb_impl( cp );
+  size_t const block = CP_GCB_STAGE1[ cp >> CP_GCB_BLOCK_SHIFT ];
+  return CP_GCB_STAGE2[
+    (block << CP_GCB_BLOCK_SHIFT) | (cp & ((1u << CP_GCB_BLOCK_SHIFT) - 1))
+  ];
+}
+
+/**
+ * Checks whether there is a grapheme cluster boundary before \a cp, that is
+ * whether \a cp starts a new user-perceived character rather than continuing
+ * the previous one, e.g., as a combining mark, an emoji modifier, or the
+ * second half of a flag.
+ *
+ * @note This inline version is optimized for the common case of text that's
+ * already in Normalization Form C (NFC), i.e., using precomposed characters:
+ * a code-point whose property is Other (as printable ASCII and almost all
+ * precomposed letters and ideographs are) following one that's Other or a
+ * control character always starts a new cluster, so that takes just one
+ * table lookup.  Only decomposed text (e.g., a letter followed by a combining
+ * mark) and the other, rarer properties need the full rules.
+ *
+ * @param state A pointer to the segmentation state that must have been
+ * initialized to #CP_GCB_STATE_INIT and is updated.
+ * @param cp The Unicode code-point to check.
+ * @return Returns `true` only if there is a boundary before \a cp.
+ *
+ * @sa cp_gcb_is_break_impl()
+ * @sa cp_gcb_width()
+ */
+NODISCARD W_UNICODE_H_INLINE
+bool cp_gcb_is_break( cp_gcb_state_t *state, char32_t cp ) {
+  extern bool cp_gcb_is_break_impl( cp_gcb_state_t*, char32_t );
+  if ( *state == CP_GCB_OTHER || *state == CP_GCB_CONTROL ) {
+    if ( (cp >= 0x20 && cp <= 0x7E) || cp_gcb( cp ) == CP_GCB_OTHER ) {
+      *state = CP_GCB_OTHER;            // GB4, GB999
+      return true;
+    }
+  }
+  return cp_gcb_is_break_impl( state, cp );
+}
+
+/**
+ * Gets the line-breaking class of \a cp.
+ *
+ * @note This inline version is optimized for the common case of code-points in
+ * the table.
+ *
+ * @param cp The Unicode code-point to get the line-breaking class of.
+ * @return Returns said class.
+ *
+ * @sa cp_lb_impl()
+ * @sa cp_lb_is_break()
+ */
+NODISCARD W_UNICODE_H_INLINE
+cp_lb_t cp_lb( char32_t cp ) {
+  extern uint8_t const CP_LB_STAGE1[];
+  extern cp_lb_t const CP_LB_STAGE2[];
+  extern cp_lb_t cp_lb_impl( char32_t );
+  if ( cp >= CP_LB_TABLE_END )
+    return cp_lb_impl( cp );
+  size_t const block = CP_LB_STAGE1[ cp >> CP_LB_BLOCK_SHIFT ];
+  return CP_LB_STAGE2[
+    (block << CP_LB_BLOCK_SHIFT) | (cp & ((1u << CP_LB_BLOCK_SHIFT) - 1))
+  ];
+}
+
+/**
+ * Checks whether a line may be broken between two adjacent non-space
+ * characters, that is a _direct break_ of the UAX #14 pair table.
+ *
+ * @note Rules that need more context than a pair of characters are
+ * approximated: numbers (LB25) are handled pairwise; regional indicators
+ * (LB30a) are never broken between; the (AL | HL | NU) &times; OP and CP
+ * &times; (AL | HL | NU) rules (LB30) ignore East_Asian_Width; and HL (HY |
+ * BA) &times; (LB21a) isn't applied.  Breaks around spaces aren't covered
+ * since the caller handles those.
+ *
+ * @param before The line-breaking class of the character before the
+ * potential break.  For a sequence of combining marks, it should be that of
+ * the character they combine with (LB9).
+ * @param after The line-breaking class of the character after the potential
+ * break.
+ * @return Returns `true` only if a line may be broken between \a before and
+ * \a after.
+ *
+ * @sa cp_lb()
+ */
+NODISCARD W_UNICODE_H_INLINE
+bool cp_lb_is_break( cp_lb_t before, cp_lb_t after ) {
+  extern uint64_t const CP_LB_BREAKS[];
+  return (CP_LB_BREAKS[ before ] >> after) & 1u;
+}
+
+/**
+ * Gets the properties of \a cp from tables generated from the Unicode
+ * Character Database, so they're the same regardless of the locale or C
+ * library.
+ *
+ * @param cp The Unicode code-point to get the properties of.
+ * @return Returns said properties.
+ *
+ * @sa cp_props_impl()
+ */
+NODISCARD W_UNICODE_H_INLINE
+cp_props_t cp_props( char32_t cp ) {
+  extern cp_props_t const CP_PROPS_ASCII[];
+  extern uint8_t const CP_PROPS_STAGE1[];
+  extern cp_props_t const CP_PROPS_STAGE2[];
+  extern cp_props_t cp_props_impl( char32_t );
+  if ( cp <= 0x7F )
+    return CP_PROPS_ASCII[ cp ];
+  if ( cp >= CP_PROPS_TABLE_END )
+    return cp_props_impl( cp );
+  size_t const block = CP_PROPS_STAGE1[ cp >> CP_PROPS_BLOCK_SHIFT ];
+  return CP_PROPS_STAGE2[
+    (block << CP_PROPS_BLOCK_SHIFT) | (cp & ((1u << CP_PROPS_BLOCK_SHIFT) - 1))
+  ];
+}
+
 /**
  * Checks whether \a cp is an alphabetic character.
  *
@@ -98,7 +414,7 @@ typedef char utf8c_t[ UTF8_CHAR_SIZE_MAX ];
  */
 NODISCARD W_UNICODE_H_INLINE
 bool cp_is_alpha( char32_t cp ) {
-  return iswalpha( STATIC_CAST( wint_t, cp ) );
+  return (cp_props( cp ) & CP_PROP_ALPHA) != 0;
 }
 
 /**
@@ -128,7 +444,7 @@ bool cp_is_ascii( char32_t cp ) {
  */
 NODISCARD W_UNICODE_H_INLINE
 bool cp_is_control( char32_t cp ) {
-  return iswcntrl( STATIC_CAST( wint_t, cp ) );
+  return (cp_props( cp ) & CP_PROP_CONTROL) != 0;
 }
 
 /**
@@ -139,8 +455,10 @@ bool cp_is_control( char32_t cp ) {
  *
  * @sa cp_is_eos_ext()
  */
-NODISCARD
-bool cp_is_eos( char32_t cp );
+NODISCARD W_UNICODE_H_INLINE
+bool cp_is_eos( char32_t cp ) {
+  return (cp_props( cp ) & CP_PROP_EOS) != 0;
+}
 
 /**
  * Checks whether \a cp is an "end-of-sentence-extender" Unicode character,
@@ -153,8 +471,10 @@ bool cp_is_eos( char32_t cp );
  *
  * @sa cp_is_eos()
  */
-NODISCARD
-bool cp_is_eos_ext( char32_t cp );
+NODISCARD W_UNICODE_H_INLINE
+bool cp_is_eos_ext( char32_t cp ) {
+  return (cp_props( cp ) & CP_PROP_EOS_EXT) != 0;
+}
 
 /**
  * Checks whether the given Unicode code-point is a hyphen-like character.
@@ -164,8 +484,10 @@ bool cp_is_eos_ext( char32_t cp );
  *
  * @sa cp_is_hyphen_adjacent()
  */
-NODISCARD
-bool cp_is_hyphen( char32_t cp );
+NODISCARD W_UNICODE_H_INLINE
+bool cp_is_hyphen( char32_t cp ) {
+  return (cp_props( cp ) & CP_PROP_HYPHEN) != 0;
+}
 
 /**
  * Checks whether \a cp is a "hyphen adjacent" Unicode character, that is a
@@ -193,7 +515,64 @@ bool cp_is_hyphen_adjacent( char32_t cp ) {
  */
 NODISCARD W_UNICODE_H_INLINE
 bool cp_is_space( char32_t cp ) {
-  return iswspace( STATIC_CAST( wint_t, cp ) );
+  return (cp_props( cp ) & CP_PROP_SPACE) != 0;
+}
+
+/**
+ * Gets the number of columns \a cp occupies when displayed: 0 for combining,
+ * format, and other zero-width characters; 2 for East Asian wide and
+ * fullwidth characters (including most emoji); and 1 for all others.
+ *
+ * @note This inline version is optimized for the common case of code-points in
+ * the table.
+ *
+ * @param cp The Unicode code-point to get the width of.
+ * @return Returns said width.
+ *
+ * @sa cp_width_impl()
+ */
+NODISCARD W_UNICODE_H_INLINE
+size_t cp_width( char32_t cp ) {
+  extern uint8_t const CP_WIDTH_STAGE1[];
+  extern uint8_t const CP_WIDTH_STAGE2[];
+  extern size_t cp_width_impl( char32_t );
+  if ( cp <= 0x7F )
+    return 1;
+  if ( cp >= CP_WIDTH_TABLE_END )
+    return cp_width_impl( cp );
+  size_t const block = CP_WIDTH_STAGE1[ cp >> CP_WIDTH_BLOCK_SHIFT ];
+  size_t const i = cp & ((1u << CP_WIDTH_BLOCK_SHIFT) - 1);
+  uint8_t const packed =
+    CP_WIDTH_STAGE2[ (block << (CP_WIDTH_BLOCK_SHIFT - 2)) | (i >> 2) ];
+  return (packed >> ((i & 3) << 1)) & 3u;
+}
+
+/**
+ * Gets the number of columns \a cp adds to the display width of the grapheme
+ * cluster it's part of: the same as cp_width() except for extending
+ * characters (including emoji modifiers and U+FE0F VARIATION SELECTOR-16),
+ * zero width joiners, and pictographs joined by them that all add 0 so that,
+ * say, an emoji ZWJ sequence is as wide as its first emoji.
+ *
+ * @param state The segmentation state just after calling cp_gcb_is_break()
+ * for \a cp.
+ * @param cp The Unicode code-point to get the width of.
+ * @return Returns said width.
+ *
+ * @sa cp_gcb_is_break()
+ * @sa cp_width()
+ */
+NODISCARD W_UNICODE_H_INLINE
+size_t cp_gcb_width( cp_gcb_state_t state, char32_t cp ) {
+  if ( (state & CP_GCB_STATE_CONT) != 0 ) {
+    switch ( state & CP_GCB_STATE_MASK ) {
+      case CP_GCB_EXTEND:
+      case CP_GCB_EXT_PICT:
+      case CP_GCB_ZWJ:
+        return 0;
+    } // switch
+  }
+  return cp_width( cp );
 }
 
 /**
@@ -214,6 +593,16 @@ char32_t utf8_decode( char const *s ) {
   return cp_is_ascii( cp ) ? cp : utf8_decode_impl( s );
 }
 
+/**
+ * Encodes a Unicode code-point in UTF-8.
+ *
+ * @param cp The code-point.  It must be valid.
+ * @param dest A pointer to receive the 1-4 bytes.
+ * @return Returns the number of bytes.
+ */
+NODISCARD
+size_t utf8_encode( char32_t cp, char *dest );
+
 /**
  * Checks whether the given byte is not the first byte of a UTF-8 byte sequence
  * of an encoded character.
@@ -295,6 +684,18 @@ char const* utf8_rsync( char const *buf, char const *pos ) {
   return cp_is_ascii( cp ) ? pos : utf8_rsync_impl( buf, pos );
 }
 
+/**
+ * Gets the number of columns the UTF-8 encoded character at \a s occupies
+ * when displayed.
+ *
+ * @param s A pointer to the first byte of the UTF-8 encoded character.
+ * @return Returns said width or 1 if the UTF-8 byte sequence is invalid.
+ *
+ * @sa cp_width()
+ */
+NODISCARD
+size_t utf8_width( char const *s );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 _GL_INLINE_HEADER_END
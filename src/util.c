@@ -27,6 +27,8 @@
 #include "pjl_config.h"                 /* must go first */
 #define W_UTIL_H_INLINE _GL_EXTERN_INLINE
 #include "util.h"
+#include "reader.h"
+#include "simd.h"
 
 /// @cond DOXYGEN_IGNORE
 
@@ -34,20 +36,32 @@
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>                      /* for open(2) */
+#include <limits.h>                     /* for PATH_MAX, UINT_MAX */
 #include <locale.h>
 #ifndef NDEBUG
 #include <signal.h>                     /* for raise(3) */
 #endif /* NDEBUG */
+#include <stdalign.h>                   /* for alignof */
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>                     /* for malloc(), ... */
 #include <string.h>
+#include <sys/resource.h>               /* for getrusage(2) */
+#include <sys/stat.h>                   /* for mkdir(2) */
 #include <sysexits.h>
-#include <unistd.h>                     /* for close(2), getpid(3) */
+#include <time.h>                       /* for clock_gettime(2) */
+#include <unistd.h>                     /* for close(2), getpid(3), ... */
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+# include <sys/mman.h>                  /* for madvise(2), mmap(2) */
+# if defined(MAP_ANONYMOUS) && (defined(MADV_HUGEPAGE) || defined(MAP_HUGETLB))
+#   define WITH_HUGE_PAGES 1
+# endif
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
 
 #ifdef WITH_WIDTH_TERM
-# include <fcntl.h>                     /* for open(2) */
 # if HAVE_CURSES_H
 #   define _BOOL /* nothing */          /* prevent bool clash on AIX/Solaris */
 #   include <curses.h>
@@ -56,6 +70,9 @@
 #   include <ncurses.h>
 # endif
 # include <term.h>                      /* for setupterm(3) */
+# if HAVE_SYS_IOCTL_H
+#   include <sys/ioctl.h>               /* for ioctl(2), TIOCGWINSZ */
+# endif /* HAVE_SYS_IOCTL_H */
 #endif /* WITH_WIDTH_TERM */
 
 /// @endcond
@@ -68,20 +85,248 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
- * A node for a singly linked list of pointers to memory to be freed via
- * `atexit()`.
+ * Default number of bytes allocated per arena chunk.  An allocation larger
+ * than this gets a chunk to itself.
+ */
+#define ARENA_CHUNK_SIZE          (4 * 1024)
+
+/**
+ * A chunk of memory that arena_alloc() allocates from.
  */
-struct free_node {
-  void             *fn_ptr;
-  struct free_node *fn_next;
+struct arena_chunk {
+  struct arena_chunk *ac_next;          ///< Next (older) chunk, if any.
+  size_t              ac_size;          ///< Number of bytes in \ref ac_buf.
+  max_align_t         ac_buf[];         ///< Memory to allocate from.
 };
-typedef struct free_node free_node_t;
+typedef struct arena_chunk arena_chunk_t;
+
+/**
+ * How huge_alloc() allocates blocks of at least #HUGE_PAGE_SIZE bytes.
+ */
+enum huge_pages {
+  HUGE_PAGES_NONE,                      ///< Via **malloc**(3).
+  HUGE_PAGES_THP,                       ///< Transparent huge pages.
+  HUGE_PAGES_EXPLICIT                   ///< Reserved huge pages, if any.
+};
+typedef enum huge_pages huge_pages_t;
 
 // local variable definitions
-static free_node_t *free_head;          // linked list of stuff to free
+static arena_chunk_t *arena_head;       // chunk being allocated from
+static char          *arena_pos;        // next free byte in arena_head
+static char          *arena_end;        // end of arena_head
+static huge_pages_t   huge_pages;       // set once by huge_init()
+static char const  *profile_path;       // WRAP_PROFILE, if any
+static pid_t        profile_pid;        // process profile_ns is for
+static char const  *profile_role_name;  // profile_role(), if any
+static uint64_t     profile_ns[ PROFILE_EXIT + 1 ]; // time of each event
+static bool         startup_enabled;    // startup_stats_init() enabled?
+static uint64_t     startup_last_ns;    // time of last startup_charge()
+static pid_t        startup_pid;        // process startup_ns is for
+static uint64_t     startup_ns[ STARTUP_RUN + 1 ]; // time charged per phase
+
+/**
+ * Names of UTF-8 locales to try, in order.
+ */
+static char const *const UTF8_LOCALES[] = {
+  "UTF-8", "UTF8",
+  "en_US.UTF-8", "en_US.UTF8",
+  NULL
+};
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Checks whether a block of \a size bytes is allocated by huge_alloc() via
+ * **mmap**(2) rather than **malloc**(3).
+ *
+ * @param size The size of the block.
+ * @return Returns `true` only if it is.
+ */
+NODISCARD
+static inline bool huge_is( size_t size ) {
+  return huge_pages != HUGE_PAGES_NONE && size >= HUGE_PAGE_SIZE;
+}
+
+/**
+ * Rounds \a size up to a multiple of #HUGE_PAGE_SIZE.
+ *
+ * @param size The size to round.
+ * @return Returns said size.
+ */
+NODISCARD
+static inline size_t huge_round( size_t size ) {
+  return (size + HUGE_PAGE_SIZE - 1) & ~STATIC_CAST( size_t, HUGE_PAGE_SIZE - 1 );
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Allocates a new chunk for the arena.
+ *
+ * @param size The minimum number of bytes the chunk must have.
+ * @return Returns a pointer to the new chunk.
+ */
+NODISCARD
+static arena_chunk_t* arena_chunk_new( size_t size ) {
+  if ( size < ARENA_CHUNK_SIZE )
+    size = ARENA_CHUNK_SIZE;
+  arena_chunk_t *const chunk =
+    check_realloc( NULL, sizeof( arena_chunk_t ) + size );
+  chunk->ac_size = size;
+  return chunk;
+}
+
+#ifdef WITH_WIDTH_TERM
+/**
+ * Gets the number of columns of the terminal, if any, that \a fd refers to
+ * from its window size.
+ *
+ * @param fd The file descriptor to use.
+ * @return Returns said number of columns or 0 if it can not be determined.
+ */
+NODISCARD
+static unsigned ioctl_term_columns( int fd ) {
+#ifdef TIOCGWINSZ
+  struct winsize ws;
+  if ( ioctl( fd, TIOCGWINSZ, &ws ) == 0 )
+    return ws.ws_col;
+#else
+  (void)fd;
+#endif /* TIOCGWINSZ */
+  return 0;
+}
+#endif /* WITH_WIDTH_TERM */
+
+/**
+ * Appends the time of each \ref profile_event to the file given by the
+ * `WRAP_PROFILE` environment variable.
+ *
+ * @sa profile_init()
+ */
+static void profile_write( void ) {
+  static char const *const EVENT_NAME[] = {
+    "start", "conf", "regex", "first_in", "first_out", "last_out", "exit"
+  };
+  static_assert(
+    ARRAY_SIZE( EVENT_NAME ) == ARRAY_SIZE( profile_ns ),
+    "EVENT_NAME[] must have an entry for every profile_event"
+  );
+
+  profile_mark( PROFILE_EXIT );
+
+  //
+  // Format the whole line first so it's appended by a single write(2) and so
+  // can't be interleaved with those of other processes.
+  //
+  char line[ 512 ];
+  int len = snprintf( line, sizeof line, "%s%s%s pid=%d %s=%.9f",
+    me, profile_role_name != NULL ? ":" : "",
+    profile_role_name != NULL ? profile_role_name : "",
+    STATIC_CAST( int, getpid() ),
+    EVENT_NAME[ PROFILE_START ],
+    STATIC_CAST( double, profile_ns[ PROFILE_START ] ) / 1000000000.0
+  );
+  for ( size_t i = PROFILE_START + 1; i < ARRAY_SIZE( profile_ns ); ++i ) {
+    if ( profile_ns[i] == 0 )           // never happened
+      continue;
+    len += snprintf( line + len, sizeof line - STATIC_CAST( size_t, len ),
+      " %s=%.9f", EVENT_NAME[i],
+      STATIC_CAST( double, profile_ns[i] - profile_ns[ PROFILE_START ] )
+        / 1000000000.0
+    );
+  } // for
+  line[ len++ ] = '\n';
+
+  int const fd = open( profile_path, O_WRONLY | O_CREAT | O_APPEND, 0644 );
+  if ( fd == -1 )
+    return;                             // profiling mustn't break wrapping
+  PJL_DISCARD_RV( write( fd, line, STATIC_CAST( size_t, len ) ) );
+  close( fd );
+}
+
+/**
+ * Prints the time charged to each \ref startup_phase to standard error.
+ *
+ * @sa startup_stats_init()
+ */
+static void startup_stats_print( void ) {
+  static char const *const PHASE_NAME[] = {
+    "options", "conf", "locale", "regex", "markdown", "init", "run"
+  };
+  static_assert(
+    ARRAY_SIZE( PHASE_NAME ) == ARRAY_SIZE( startup_ns ),
+    "PHASE_NAME[] must have an entry for every startup_phase"
+  );
+
+  startup_charge( STARTUP_RUN );
+  EPRINTF( "%s: startup:", me );
+  for ( size_t i = 0; i < ARRAY_SIZE( startup_ns ); ++i ) {
+    EPRINTF( " %s=%.9f",
+      PHASE_NAME[i], STATIC_CAST( double, startup_ns[i] ) / 1000000000.0
+    );
+  } // for
+  EPUTC( '\n' );
+}
 
 ////////// extern functions ///////////////////////////////////////////////////
 
+void* arena_alloc( size_t size ) {
+  size_t const ALIGN = alignof( max_align_t );
+  size = (size + ALIGN - 1) & ~(ALIGN - 1);
+
+  if ( unlikely( STATIC_CAST( size_t, arena_end - arena_pos ) < size ) ) {
+    arena_chunk_t *const chunk = arena_chunk_new( size );
+    if ( size > ARENA_CHUNK_SIZE / 2 && arena_head != NULL ) {
+      //
+      // A large allocation gets its own chunk that's put after the current one
+      // so whatever is left in the current one can still be used.
+      //
+      chunk->ac_next = arena_head->ac_next;
+      arena_head->ac_next = chunk;
+      return chunk->ac_buf;
+    }
+    chunk->ac_next = arena_head;
+    arena_head = chunk;
+    arena_pos = POINTER_CAST( char*, chunk->ac_buf );
+    arena_end = arena_pos + chunk->ac_size;
+  }
+
+  void *const p = arena_pos;
+  arena_pos += size;
+  return p;
+}
+
+void arena_reset( bool keep_chunk ) {
+  arena_chunk_t *keep = NULL;
+  for ( arena_chunk_t *chunk = arena_head; chunk != NULL; ) {
+    arena_chunk_t *const next = chunk->ac_next;
+    if ( keep_chunk && keep == NULL && chunk->ac_size == ARENA_CHUNK_SIZE ) {
+      keep = chunk;
+      keep->ac_next = NULL;
+    } else {
+      FREE( chunk );
+    }
+    chunk = next;
+  } // for
+
+  arena_head = keep;
+  if ( keep == NULL ) {
+    arena_pos = arena_end = NULL;
+  } else {
+    arena_pos = POINTER_CAST( char*, keep->ac_buf );
+    arena_end = arena_pos + keep->ac_size;
+  }
+}
+
+char* arena_strndup( char const *s, size_t n ) {
+  assert( s != NULL );
+  size_t const len = strnlen( s, n );
+  char *const dup = arena_alloc( len + 1/*\0*/ );
+  memcpy( dup, s, len );
+  dup[ len ] = '\0';
+  return dup;
+}
+
 char const* base_name( char const *path_name ) {
   assert( path_name != NULL );
   char const *const slash = strrchr( path_name, '/' );
@@ -90,6 +335,42 @@ char const* base_name( char const *path_name ) {
   return path_name;
 }
 
+bool cache_path( char const *name, char *path_buf, bool make_dir ) {
+  assert( name != NULL );
+  assert( path_buf != NULL );
+
+  char const *cache_home = getenv( "XDG_CACHE_HOME" );
+  int len;
+  if ( cache_home != NULL && cache_home[0] == '/' ) {
+    len = snprintf( path_buf, PATH_MAX, "%s", cache_home );
+  } else {
+    char const *const home = getenv( "HOME" );
+    if ( home == NULL || home[0] != '/' )
+      return false;
+    len = snprintf( path_buf, PATH_MAX, "%s/.cache", home );
+  }
+  if ( len < 0 || len >= PATH_MAX )
+    return false;
+  if ( make_dir && mkdir( path_buf, 0700 ) == -1 && errno != EEXIST )
+    return false;
+
+  size_t const dir_len = STATIC_CAST( size_t, len );
+  len = snprintf(
+    path_buf + dir_len, PATH_MAX - dir_len, "/" PACKAGE "/%s", name
+  );
+  if ( len < 0 || STATIC_CAST( size_t, len ) >= PATH_MAX - dir_len )
+    return false;
+
+  if ( make_dir ) {
+    char *const slash = strrchr( path_buf, '/' );
+    *slash = '\0';
+    bool const ok = mkdir( path_buf, 0700 ) == 0 || errno == EEXIST;
+    *slash = '/';
+    return ok;
+  }
+  return true;
+}
+
 unsigned check_atou( char const *s ) {
   assert( s != NULL );
   if ( !is_digits( s ) )
@@ -143,57 +424,43 @@ void fatal_error( int status, char const *format, ... ) {
   _Exit( status );
 }
 
-void fcopy( FILE *ffrom, FILE *fto ) {
-  assert( ffrom != NULL );
-  assert( fto != NULL );
+size_t fcopy( FILE *ffrom, FILE *fto ) {
+  return reader_copy( ffrom, fto );
+}
 
-  char buf[ 8192 ];
-  for ( size_t size; (size = fread( buf, 1, sizeof buf, ffrom )) > 0; )
-    PERROR_EXIT_IF( fwrite( buf, 1, size, fto ) < size, EX_IOERR );
-  FERROR( ffrom );
+int fd_write( int fd, char const *s, size_t len ) {
+  assert( s != NULL );
+  while ( len > 0 ) {
+    ssize_t const n = write( fd, s, len );
+    if ( unlikely( n == -1 ) ) {
+      if ( errno != EINTR )
+        return errno;
+      continue;
+    }
+    s += n;
+    len -= STATIC_CAST( size_t, n );
+  } // while
+  return 0;
 }
 
 char* fgetsz( char *buf, size_t *size, FILE *ffrom ) {
   assert( buf != NULL );
   assert( size != NULL );
+  assert( *size > 0 );
   assert( ffrom != NULL );
-  //
-  // Based on the implementation given in:
-  //
-  //  + Brian W. Kernighan and Dennis M. Ritchie: "The C Programming Language,"
-  //    2nd ed., section 7.7 "Line Input and Output," Prentice Hall, 1988, p.
-  //    134.
-  //
-  int c = 0;
-  char *s = buf;
-
-  for ( size_t n = *size; n > 0 && (c = getc( ffrom )) != EOF; --n )
-    if ( (*s++ = STATIC_CAST( char, c )) == '\n' )
-      break;
-
-  *s = '\0';
-  *size = STATIC_CAST( size_t, s - buf );
-
-  return c == EOF && *size == 0 ? NULL : buf;
-}
 
-void* free_later( void *p ) {
-  assert( p != NULL );
-  free_node_t *const new_node = MALLOC( free_node_t, 1 );
-  new_node->fn_ptr = p;
-  new_node->fn_next = free_head;
-  free_head = new_node;
-  return p;
-}
+  size_t line_size;
+  char const *const line = reader_getline( ffrom, *size - 1, &line_size );
+  if ( line == NULL ) {
+    *buf = '\0';
+    *size = 0;
+    return NULL;
+  }
 
-void free_now( void ) {
-  for ( free_node_t *p = free_head; p != NULL; ) {
-    free_node_t *const next = p->fn_next;
-    FREE( p->fn_ptr );
-    FREE( p );
-    p = next;
-  } // for
-  free_head = NULL;
+  memcpy( buf, line, line_size );
+  buf[ line_size ] = '\0';
+  *size = line_size;
+  return buf;
 }
 
 #ifdef WITH_WIDTH_TERM
@@ -204,16 +471,29 @@ unsigned get_term_columns( void ) {
   if ( cols == UNSET ) {
     cols = 0;
 
+    //
+    // In order of cost: $COLUMNS (that takes precedence as it does for
+    // curses); the window size of whichever of standard output, error, or
+    // input is a terminal; and, only as a last resort, that of the controlling
+    // terminal or, failing that, the terminfo database.
+    //
+    char const *const env_cols = getenv( "COLUMNS" );
+    if ( env_cols != NULL && *env_cols != '\0' && is_digits( env_cols ) ) {
+      unsigned long const n = strtoul( env_cols, NULL, 10 );
+      if ( n > 0 && n <= UINT_MAX )
+        return cols = STATIC_CAST( unsigned, n );
+    }
+
+    static int const STD_FDS[] = { STDOUT_FILENO, STDERR_FILENO, STDIN_FILENO };
+    for ( size_t i = 0; i < ARRAY_SIZE( STD_FDS ); ++i ) {
+      if ( (cols = ioctl_term_columns( STD_FDS[i] )) > 0 )
+        return cols;
+    } // for
+
     int         cterm_fd = -1;
     char        reason_buf[ 128 ];
     char const *reason = NULL;
 
-    char const *const term = getenv( "TERM" );
-    if ( unlikely( term == NULL ) ) {
-      reason = "TERM environment variable not set";
-      goto error;
-    }
-
     char const *const cterm_path = ctermid( NULL );
     if ( unlikely( cterm_path == NULL || *cterm_path == '\0' ) ) {
       reason = "ctermid(3) failed to get controlling terminal";
@@ -225,6 +505,15 @@ unsigned get_term_columns( void ) {
       goto error;
     }
 
+    if ( (cols = ioctl_term_columns( cterm_fd )) > 0 )
+      goto error;                       // not really an error
+
+    char const *const term = getenv( "TERM" );
+    if ( unlikely( term == NULL ) ) {
+      reason = "TERM environment variable not set";
+      goto error;
+    }
+
     int sut_err;
     if ( setupterm( CONST_CAST( char*, term ), cterm_fd, &sut_err ) == ERR ) {
       reason = reason_buf;
@@ -276,7 +565,82 @@ error:
 }
 #endif /* WITH_WIDTH_TERM */
 
-#ifndef NDEBUG
+void huge_advise( void *p, size_t size ) {
+#if HAVE_MADVISE && defined(MADV_HUGEPAGE)
+  if ( huge_pages != HUGE_PAGES_NONE && size >= HUGE_PAGE_SIZE )
+    PJL_DISCARD_RV( madvise( p, size, MADV_HUGEPAGE ) );
+#else
+  (void)p;
+  (void)size;
+#endif /* HAVE_MADVISE && MADV_HUGEPAGE */
+}
+
+void* huge_alloc( size_t size ) {
+#ifdef WITH_HUGE_PAGES
+  if ( huge_is( size ) ) {
+    size_t const map_size = huge_round( size );
+    void *p = MAP_FAILED;
+# ifdef MAP_HUGETLB
+    if ( huge_pages == HUGE_PAGES_EXPLICIT ) {
+      p = mmap( NULL, map_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+    }
+# endif /* MAP_HUGETLB */
+    if ( p == MAP_FAILED ) {            // none reserved: use transparent ones
+      p = mmap( NULL, map_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+      PERROR_EXIT_IF( p == MAP_FAILED, EX_OSERR );
+      huge_advise( p, map_size );
+    }
+    return p;
+  }
+#endif /* WITH_HUGE_PAGES */
+  return check_realloc( NULL, size );
+}
+
+void huge_free( void *p, size_t size ) {
+#ifdef WITH_HUGE_PAGES
+  if ( p != NULL && huge_is( size ) ) {
+    PJL_DISCARD_RV( munmap( p, huge_round( size ) ) );
+    return;
+  }
+#else
+  (void)size;
+#endif /* WITH_HUGE_PAGES */
+  free( p );
+}
+
+void huge_init( void ) {
+#ifdef WITH_HUGE_PAGES
+  RUN_ONCE {
+    char const *const value = getenv( "WRAP_HUGE_PAGES" );
+    if ( value != NULL && strcmp( value, "explicit" ) == 0 )
+      huge_pages = HUGE_PAGES_EXPLICIT;
+    else if ( is_affirmative( value ) )
+      huge_pages = HUGE_PAGES_THP;
+  }
+#endif /* WITH_HUGE_PAGES */
+}
+
+size_t huge_page_size( void ) {
+  return huge_pages != HUGE_PAGES_NONE ? HUGE_PAGE_SIZE : 0;
+}
+
+void* huge_realloc( void *p, size_t old_size, size_t new_size ) {
+  if ( !huge_is( old_size ) && !huge_is( new_size ) )
+    return check_realloc( p, new_size );
+  if ( huge_is( old_size ) && huge_is( new_size ) &&
+       huge_round( old_size ) == huge_round( new_size ) ) {
+    return p;
+  }
+  void *const q = huge_alloc( new_size );
+  if ( p != NULL ) {
+    memcpy( q, p, old_size < new_size ? old_size : new_size );
+    huge_free( p, old_size );
+  }
+  return q;
+}
+
 bool is_affirmative( char const *s ) {
   static char const *const AFFIRMATIVES[] = {
     "1",
@@ -288,7 +652,6 @@ bool is_affirmative( char const *s ) {
   };
   return is_any( s, AFFIRMATIVES );
 }
-#endif /* NDEBUG */
 
 bool is_any( char const *s, char const *const matches[const static 2] ) {
   if ( s != NULL ) {
@@ -300,21 +663,92 @@ bool is_any( char const *s, char const *const matches[const static 2] ) {
   return false;
 }
 
+uint64_t mem_hash( void const *p, size_t n, uint64_t seed ) {
+  assert( p != NULL || n == 0 );
+  char const *s = p;
+  uint64_t h = seed ^ (n * 0x9E3779B97F4A7C15u);
+  uint64_t w;
+  for ( ; n >= sizeof w; n -= sizeof w, s += sizeof w ) {
+    memcpy( &w, s, sizeof w );          // may be unaligned
+    h ^= w * 0x87C37B91114253D5u;
+    h = ((h << 31) | (h >> 33)) * 0x4CF5AD432745937Fu;
+  } // for
+  if ( n > 0 ) {
+    w = 0;
+    memcpy( &w, s, n );
+    h ^= w * 0x87C37B91114253D5u;
+    h = ((h << 31) | (h >> 33)) * 0x4CF5AD432745937Fu;
+  }
+  // final mix so every bit of input affects every bit of the hash
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDu;
+  h ^= h >> 33;
+  return h;
+}
+
+uint64_t now_ns( void ) {
+  struct timespec ts;
+  PERROR_EXIT_IF( clock_gettime( CLOCK_MONOTONIC, &ts ) == -1, EX_OSERR );
+  return STATIC_CAST( uint64_t, ts.tv_sec ) * 1000000000u +
+         STATIC_CAST( uint64_t, ts.tv_nsec );
+}
+
+size_t peak_rss_kb( int who ) {
+  struct rusage ru;
+  PERROR_EXIT_IF( getrusage( who, &ru ) == -1, EX_OSERR );
+#ifdef __APPLE__
+  return STATIC_CAST( size_t, ru.ru_maxrss ) / 1024;  // macOS: in bytes
+#else
+  return STATIC_CAST( size_t, ru.ru_maxrss );
+#endif /* __APPLE__ */
+}
+
 void perror_exit( int status ) {
+  if ( errno == EPIPE ) {
+    //
+    // Whatever was reading our output (e.g., head(1)) has gone away (and
+    // SIGPIPE is being ignored), so there's no point continuing, but it's not
+    // an error either.
+    //
+    exit( EX_OK );
+  }
   perror( me );
   exit( status );
 }
 
+void profile_init( void ) {
+  char const *const path = getenv( "WRAP_PROFILE" );
+  if ( path != NULL && path[0] != '\0' ) {
+    profile_path = path;
+    profile_pid = getpid();
+    profile_ns[ PROFILE_START ] = now_ns();
+    ATEXIT( &profile_write );
+  }
+}
+
+void profile_mark( profile_event_t event ) {
+  if ( profile_path != NULL &&
+       (profile_ns[ event ] == 0 || event == PROFILE_LAST_OUT) ) {
+    profile_ns[ event ] = now_ns();
+  }
+}
+
+void profile_role( char const *role ) {
+  assert( role != NULL );
+  if ( profile_path == NULL )
+    return;
+  profile_role_name = role;
+  pid_t const pid = getpid();
+  if ( pid != profile_pid ) {
+    for ( size_t i = PROFILE_FIRST_IN; i < ARRAY_SIZE( profile_ns ); ++i )
+      profile_ns[i] = 0;
+    profile_pid = pid;
+  }
+}
+
 void setlocale_utf8( void ) {
-  static char const *const UTF8_LOCALES[] = {
-    "UTF-8", "UTF8",
-    "en_US.UTF-8", "en_US.UTF8",
-    NULL
-  };
-  for ( char const *const *loc = UTF8_LOCALES; *loc != NULL; ++loc ) {
-    if ( setlocale( LC_COLLATE, *loc ) && setlocale( LC_CTYPE, *loc ) )
-      return;
-  } // for
+  if ( try_setlocale_utf8() )
+    return;
 
   EPRINTF( "%s: could not set locale to UTF-8; tried: ", me );
   bool comma = false;
@@ -327,10 +761,48 @@ void setlocale_utf8( void ) {
   exit( EX_UNAVAILABLE );
 }
 
-void split_tws( char buf[const], size_t buf_len, char tws[const] ) {
-  size_t const tnws_len = buf_len - strrspn( buf, WS_ST );
-  strcpy( tws, buf + tnws_len );
+void startup_charge( startup_phase_t phase ) {
+  if ( startup_enabled ) {
+    uint64_t const ns = now_ns();
+    pid_t const pid = getpid();
+    if ( pid == startup_pid ) {
+      startup_ns[ phase ] += ns - startup_last_ns;
+    } else {
+      //
+      // We're in a child process (of wrapc) that inherited its parent's times:
+      // since when it was forked is unknown, start charging it only from now.
+      //
+      memset( startup_ns, 0, sizeof startup_ns );
+      startup_pid = pid;
+    }
+    startup_last_ns = ns;
+  }
+}
+
+void startup_stats_init( void ) {
+  if ( is_affirmative( getenv( "WRAP_STARTUP_STATS" ) ) ) {
+    startup_last_ns = now_ns();
+    startup_pid = getpid();
+    startup_enabled = true;
+    ATEXIT( &startup_stats_print );
+  }
+}
+
+size_t split_tws( char buf[const], size_t buf_len, char tws[const] ) {
+  size_t const tws_len = simd_ws_rspan( buf, buf_len );
+  size_t const tnws_len = buf_len - tws_len;
+  memcpy( tws, buf + tnws_len, tws_len );
+  tws[ tws_len ] = '\0';
   buf[ tnws_len ] = '\0';
+  return tnws_len;
+}
+
+uint32_t str_hash( char const *s ) {
+  assert( s != NULL );
+  uint32_t h = 2166136261u;
+  while ( *s != '\0' )
+    h = (h ^ STATIC_CAST( unsigned char, *s++ )) * 16777619u;
+  return h;
 }
 
 size_t strcpy_len( char *dst, char const *src ) {
@@ -346,6 +818,9 @@ size_t strrspn( char const *s, char const *set ) {
   assert( s != NULL );
   assert( set != NULL );
 
+  if ( strcmp( set, WS_ST ) == 0 )      // the common case
+    return simd_ws_rspan( s, strlen( s ) );
+
   size_t n = 0;
   for ( char const *t = s + strlen( s );
         t-- > s && strchr( set, *t ) != NULL;
@@ -355,6 +830,14 @@ size_t strrspn( char const *s, char const *set ) {
   return n;
 }
 
+bool try_setlocale_utf8( void ) {
+  for ( char const *const *loc = UTF8_LOCALES; *loc != NULL; ++loc ) {
+    if ( setlocale( LC_COLLATE, *loc ) && setlocale( LC_CTYPE, *loc ) )
+      return true;
+  } // for
+  return false;
+}
+
 #ifndef NDEBUG
 void wait_for_debugger_attach( char const *env_var ) {
   assert( env_var != NULL );
@@ -365,6 +848,35 @@ void wait_for_debugger_attach( char const *env_var ) {
 }
 #endif /* NDEBUG */
 
+void write_all( int fd, char const *s, size_t len ) {
+  int const err = fd_write( fd, s, len );
+  if ( unlikely( err != 0 ) ) {
+    errno = err;
+    perror_exit( EX_IOERR );
+  }
+}
+
+void writev_all( int fd, struct iovec *iov, size_t iov_len ) {
+  assert( iov != NULL || iov_len == 0 );
+  while ( iov_len > 0 ) {
+    int const n_iov = iov_len < IOV_MAX ? STATIC_CAST( int, iov_len ) : IOV_MAX;
+    ssize_t n = writev( fd, iov, n_iov );
+    if ( unlikely( n == -1 ) ) {
+      if ( errno != EINTR )
+        perror_exit( EX_IOERR );
+      continue;
+    }
+    for ( ; iov_len > 0 && STATIC_CAST( size_t, n ) >= iov->iov_len; ++iov ) {
+      n -= STATIC_CAST( ssize_t, iov->iov_len );
+      --iov_len;
+    } // for
+    if ( n > 0 ) {
+      iov->iov_base = STATIC_CAST( char*, iov->iov_base ) + n;
+      iov->iov_len -= STATIC_CAST( size_t, n );
+    }
+  } // while
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
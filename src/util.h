@@ -39,6 +39,7 @@
 #include <stdio.h>                      /* for FILE */
 #include <stdlib.h>                     /* for exit(3) */
 #include <string.h>                     /* for strspn(3) */
+#include <sys/uio.h>                    /* for struct iovec */
 #include <sysexits.h>
 
 _GL_INLINE_HEADER_BEGIN
@@ -131,6 +132,19 @@ _GL_INLINE_HEADER_BEGIN
 
 /// @endcond
 
+/**
+ * Convenience macro for calling arena_alloc().
+ *
+ * @param TYPE The type to allocate.
+ * @param N The number of objects of \a TYPE to allocate.
+ * @return Returns a pointer to \a N uninitialized objects of \a TYPE.
+ *
+ * @sa arena_alloc()
+ * @sa #MALLOC()
+ */
+#define ARENA_ALLOC(TYPE,N) \
+  STATIC_CAST( TYPE*, arena_alloc( sizeof(TYPE) * (size_t)(N) ) )
+
 /**
  * Gets the number of elements of the given array.
  *
@@ -308,6 +322,12 @@ _GL_INLINE_HEADER_BEGIN
  */
 #define FREE(PTR)                 free( CONST_CAST( void*, (PTR) ) )
 
+/**
+ * Size of a huge page, also the minimum size of a block that huge_alloc()
+ * backs by huge pages.
+ */
+#define HUGE_PAGE_SIZE            (2 * 1024 * 1024)
+
 /**
  * A special-case of fatal_error() that additionally prints the file and line
  * where an internal error occurred.
@@ -633,11 +653,83 @@ _GL_INLINE_HEADER_BEGIN
  */
 typedef int (*bsearch_cmp_fn_t)( void const *i_data, void const *j_data );
 
+/**
+ * Events whose times are written when the `WRAP_PROFILE` environment variable
+ * is set.
+ *
+ * @sa profile_mark()
+ */
+enum profile_event {
+  PROFILE_START,                        ///< profile_init() called.
+  PROFILE_CONF,                         ///< Options and config. file parsed.
+  PROFILE_REGEX,                        ///< Regular expressions compiled.
+  PROFILE_FIRST_IN,                     ///< First byte read.
+  PROFILE_FIRST_OUT,                    ///< First byte written.
+  PROFILE_LAST_OUT,                     ///< Last byte written.
+  PROFILE_EXIT                          ///< Exiting.
+};
+typedef enum profile_event profile_event_t;
+
+/**
+ * Phases of start-up timed when the `WRAP_STARTUP_STATS` environment variable
+ * is affirmative.
+ *
+ * @sa startup_charge()
+ */
+enum startup_phase {
+  STARTUP_OPTIONS,                      ///< Options but the config. file.
+  STARTUP_CONF,                         ///< read_conf().
+  STARTUP_LOCALE,                       ///< setlocale_utf8().
+  STARTUP_REGEX,                        ///< regex_compile().
+  STARTUP_MARKDOWN,                     ///< markdown_init().
+  STARTUP_INIT,                         ///< All other initialization.
+  STARTUP_RUN                           ///< Reading, wrapping, and writing.
+};
+typedef enum startup_phase startup_phase_t;
+
 // extern variable definitions
 extern char const  *me;                 ///< Program name.
 
 ////////// extern functions ///////////////////////////////////////////////////
 
+/**
+ * Allocates memory from the arena: memory that lives until the next call to
+ * arena_reset().  Allocating is just bumping a pointer within the current
+ * chunk; a new chunk is allocated only when the current one is full.  There is
+ * no way to free individual allocations.
+ *
+ * @param size The number of bytes to allocate.
+ * @return Returns a pointer to the allocated memory suitably aligned for any
+ * type.
+ *
+ * @sa #ARENA_ALLOC()
+ * @sa arena_reset()
+ * @sa arena_strndup()
+ */
+NODISCARD
+void* arena_alloc( size_t size );
+
+/**
+ * Frees all memory allocated via arena_alloc().
+ *
+ * @param keep_chunk If `true`, keeps one chunk for subsequent allocations to
+ * reuse, e.g., between jobs; if `false`, frees everything, e.g., upon exit.
+ *
+ * @warning All pointers previously returned by arena_alloc() become invalid.
+ */
+void arena_reset( bool keep_chunk );
+
+/**
+ * Duplicates at most \a n characters of \a s into memory allocated via
+ * arena_alloc().
+ *
+ * @param s The string to duplicate.
+ * @param n The maximum number of characters of \a s to duplicate.
+ * @return Returns a null-terminated copy of at most \a n characters of \a s.
+ */
+NODISCARD
+char* arena_strndup( char const *s, size_t n );
+
 /**
  * Extracts the base portion of a path-name.
  * Unlike **basename**(3):
@@ -653,6 +745,20 @@ extern char const  *me;                 ///< Program name.
 NODISCARD
 char const* base_name( char const *path_name );
 
+/**
+ * Gets the full path of a file in the **wrap**(1) cache directory, i.e., the
+ * `wrap` subdirectory of either `$XDG_CACHE_HOME` or `$HOME/.cache`.
+ *
+ * @param name The name of the file within the cache directory.
+ * @param path_buf The buffer to receive the path.  It must be at least
+ * `PATH_MAX` bytes.
+ * @param make_dir If `true`, also creates the cache directory if necessary.
+ * @return Returns `true` only if the path was obtained (and, if \a make_dir,
+ * the cache directory exists).
+ */
+NODISCARD
+bool cache_path( char const *name, char *path_buf, bool make_dir );
+
 /**
  * Converts an ASCII string to an unsigned integer.
  * Unlike **atoi**(3), insists that all characters in \a s are digits.
@@ -723,8 +829,23 @@ _Noreturn void fatal_error( int status, char const *format, ... );
  *
  * @param ffrom The FILE to copy from.
  * @param fto The FILE to copy to.
+ * @return Returns the number of bytes copied.
+ */
+size_t fcopy( FILE *ffrom, FILE *fto );
+
+/**
+ * Writes \a len characters of \a s to \a fd handling both partial writes and
+ * interrupts.
+ *
+ * @param fd The file descriptor to write to.
+ * @param s The characters to write.
+ * @param len The number of characters to write.
+ * @return Returns 0 on success or the value of `errno` on failure.
+ *
+ * @sa write_all()
  */
-void fcopy( FILE *ffrom, FILE *fto );
+NODISCARD
+int fd_write( int fd, char const *s, size_t len );
 
 /**
  * Gets a newline-terminated line from \a ffrom reading at most one fewer
@@ -740,31 +861,76 @@ void fcopy( FILE *ffrom, FILE *fto );
 NODISCARD
 char* fgetsz( char *buf, size_t *size, FILE *ffrom );
 
+#ifdef WITH_WIDTH_TERM
 /**
- * Adds a pointer to the head of the free-later-list.
+ * Gets the number of columns of the terminal.
  *
- * @param p The pointer to add.
- * @return Returns \a p.
+ * @return Returns said number of columns or 0 if it can not be determined.
  */
-PJL_DISCARD
-void* free_later( void *p );
+NODISCARD
+unsigned get_term_columns( void );
+#endif /* WITH_WIDTH_TERM */
 
 /**
- * Frees all the memory pointed to by all the nodes in the free-later-list.
+ * Advises the kernel to back the memory of \a p with transparent huge pages,
+ * but only if huge pages were enabled by huge_init() and \a size is at least
+ * #HUGE_PAGE_SIZE, e.g., for a memory-mapped file.
+ *
+ * @param p A pointer to the page-aligned memory.
+ * @param size The number of bytes.
  */
-void free_now( void );
+void huge_advise( void *p, size_t size );
 
-#ifdef WITH_WIDTH_TERM
 /**
- * Gets the number of columns of the terminal.
+ * Allocates memory like **malloc**(3) except that, if huge pages were enabled
+ * by huge_init() and \a size is at least #HUGE_PAGE_SIZE, it's allocated via
+ * **mmap**(2) backed by huge pages to reduce TLB misses when scanning it.
  *
- * @return Returns said number of columns or 0 if it can not be determined.
+ * @param size The number of bytes to allocate.
+ * @return Returns a pointer to the allocated memory.
+ *
+ * @sa huge_free()
+ * @sa huge_realloc()
  */
 NODISCARD
-unsigned get_term_columns( void );
-#endif /* WITH_WIDTH_TERM */
+void* huge_alloc( size_t size );
+
+/**
+ * Frees memory allocated by either huge_alloc() or huge_realloc().
+ *
+ * @param p A pointer to the memory or NULL.
+ * @param size The number of bytes allocated.
+ */
+void huge_free( void *p, size_t size );
+
+/**
+ * Enables huge pages for huge_alloc() if the `WRAP_HUGE_PAGES` environment
+ * variable is `explicit` (huge pages reserved by the system administrator,
+ * falling back to transparent ones if there are none) or affirmative
+ * (transparent huge pages).  Only the first call does anything.
+ */
+void huge_init( void );
+
+/**
+ * Gets the size of a huge page if huge pages are enabled.
+ *
+ * @return Returns #HUGE_PAGE_SIZE if huge pages were enabled by huge_init() or
+ * 0 if not.
+ */
+NODISCARD
+size_t huge_page_size( void );
+
+/**
+ * Reallocates memory allocated by huge_alloc() or huge_realloc().
+ *
+ * @param p A pointer to the memory or NULL.
+ * @param old_size The number of bytes allocated.
+ * @param new_size The new number of bytes to allocate.
+ * @return Returns a pointer to the reallocated memory.
+ */
+NODISCARD
+void* huge_realloc( void *p, size_t old_size, size_t new_size );
 
-#ifndef NDEBUG
 /**
  * Checks whether \a s is an affirmative value.  An affirmative value is one of
  * 1, t, true, y, or yes, case-insensitive.
@@ -774,7 +940,6 @@ unsigned get_term_columns( void );
  */
 NODISCARD
 bool is_affirmative( char const *s );
-#endif /* NDEBUG */
 
 /**
  * Checks whether \a s is any one of \a matches, case-insensitive.
@@ -847,17 +1012,108 @@ bool is_windows_eol( char const buf[const], size_t buf_len ) {
 }
 
 /**
- * Prints an error message for `errno` to standard error and exits.
+ * Hashes bytes eight at a time.  Unlike str_hash(), it's suitable for hashing
+ * large amounts of data, but isn't cryptographic: two inputs can hash the
+ * same, so callers that care must compare the inputs themselves.
+ *
+ * @param p A pointer to the bytes to hash.
+ * @param n The number of bytes to hash.
+ * @param seed The hash to start with, e.g., that of preceding data.
+ * @return Returns said hash.
+ */
+NODISCARD
+uint64_t mem_hash( void const *p, size_t n, uint64_t seed );
+
+/**
+ * Gets the current time of the monotonic clock.
+ *
+ * @return Returns said time in nanoseconds.
+ */
+NODISCARD
+uint64_t now_ns( void );
+
+/**
+ * Gets the peak resident set size.
+ *
+ * @param who Either `RUSAGE_SELF` or `RUSAGE_CHILDREN` (the largest of all
+ * waited-for).
+ * @return Returns said size in kilobytes.
+ */
+NODISCARD
+size_t peak_rss_kb( int who );
+
+/**
+ * Prints an error message for `errno` to standard error and exits.  However,
+ * if `errno` is `EPIPE`, i.e., whatever was reading the output has gone away,
+ * just exits successfully.
  *
  * @param status The exit status code.
  */
 _Noreturn void perror_exit( int status );
 
+/**
+ * If the `WRAP_PROFILE` environment variable is set to a path, starts a
+ * timeline of \ref profile_event times and, at exit, appends it to that file
+ * as a single line of the program name, \ref profile_role() (if any), process
+ * ID, and _event_`=`_seconds_ pairs where each time is since
+ * #PROFILE_START.  The time of #PROFILE_START itself is that of the monotonic
+ * clock, so the lines of different processes can be put on one timeline.
+ * This must be called first thing in main().
+ *
+ * @sa profile_mark()
+ * @sa profile_role()
+ */
+void profile_init( void );
+
+/**
+ * If profiling is enabled, notes the current time for \a event.  For every
+ * event but #PROFILE_LAST_OUT, only the first time is kept.
+ *
+ * @param event The \ref profile_event to note.
+ *
+ * @sa profile_init()
+ */
+void profile_mark( profile_event_t event );
+
+/**
+ * Sets the role of the current process for profiling.  If the current process
+ * is a child that inherited its parent's timeline, the events from
+ * #PROFILE_FIRST_IN on are forgotten since they were the parent's.
+ *
+ * @param role The role, e.g., `"read"`.  It must persist until exit.
+ *
+ * @sa profile_init()
+ */
+void profile_role( char const *role );
+
 /**
  * Sets the locale for the `LC_COLLATE` and `LC_CTYPE` categories to UTF-8.
+ * If it can't be, prints an error message and exits.
+ *
+ * @sa try_setlocale_utf8()
  */
 void setlocale_utf8( void );
 
+/**
+ * If start-up statistics are enabled, charges the time since either the
+ * previous call or startup_stats_init() to \a phase.
+ *
+ * @param phase The \ref startup_phase to charge.
+ *
+ * @sa startup_stats_init()
+ */
+void startup_charge( startup_phase_t phase );
+
+/**
+ * If the `WRAP_STARTUP_STATS` environment variable is affirmative, starts
+ * timing the phases of start-up and, at exit, prints the time charged to each
+ * to standard error as a single line of _phase_`=`_seconds_ pairs.  This must
+ * be called first thing in main().
+ *
+ * @sa startup_charge()
+ */
+void startup_stats_init( void );
+
 /**
  * Splits off the trailing whitespace (tws) from \a buf into \a tws.  For
  * example, if \a buf is initially <code>"# "</code>, it will become `#` and
@@ -868,8 +1124,20 @@ void setlocale_utf8( void );
  * @param buf_len The length of \a buf.
  * @param tws The buffer to receive the trailing whitespace from \a buf, if
  * any.
+ * @return Returns the length of \a buf after the split.
  */
-void split_tws( char buf[const], size_t buf_len, char tws[const] );
+size_t split_tws( char buf[const], size_t buf_len, char tws[const] );
+
+/**
+ * Hashes a string.
+ *
+ * @param s The null-terminated string to hash.
+ * @return Returns said hash.
+ *
+ * @sa [FNV Hash](http://www.isthe.com/chongo/tech/comp/fnv/)
+ */
+NODISCARD
+uint32_t str_hash( char const *s );
 
 /**
  * A variant of **strcpy**(3) that returns the number of characters copied.
@@ -920,6 +1188,17 @@ bool true_clear( bool *flag ) {
   return *flag && !(*flag = false);
 }
 
+/**
+ * Attempts to set the locale for the `LC_COLLATE` and `LC_CTYPE` categories to
+ * UTF-8.
+ *
+ * @return Returns `true` only if the locale was set.
+ *
+ * @sa setlocale_utf8()
+ */
+NODISCARD
+bool try_setlocale_utf8( void );
+
 #ifndef NDEBUG
 /**
  * Suspends process execution until a debugger attaches if \a env_var is set
@@ -932,6 +1211,31 @@ void wait_for_debugger_attach( char const *env_var );
 # define wait_for_debugger_attach( env_var ) NO_OP
 #endif /* NDEBUG */
 
+/**
+ * Writes \a len characters of \a s to \a fd.
+ * If writing fails, prints an error message and exits.
+ *
+ * @param fd The file descriptor to write to.
+ * @param s The characters to write.
+ * @param len The number of characters to write.
+ *
+ * @sa fd_write()
+ * @sa writev_all()
+ */
+void write_all( int fd, char const *s, size_t len );
+
+/**
+ * Writes all the characters of \a iov to \a fd via as few **writev**(2)
+ * calls as possible.  If writing fails, prints an error message and exits.
+ *
+ * @param fd The file descriptor to write to.
+ * @param iov The array of buffers to write.  It is modified.
+ * @param iov_len The number of buffers of \a iov.
+ *
+ * @sa write_all()
+ */
+void writev_all( int fd, struct iovec *iov, size_t iov_len );
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /** @} */
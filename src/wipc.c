@@ -0,0 +1,214 @@
+/*
+**      wrap -- text reformatter
+**      src/wipc.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for sending Interprocess Communication (IPC) messages
+ * out-of-band as binary frames.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#define W_WIPC_H_INLINE _GL_EXTERN_INLINE
+#include "wipc.h"
+#include "common.h"
+#include "probe.h"
+#include "util.h"
+#include "writer.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <string.h>                     /* for strlen(3) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for read(2) */
+
+/// @endcond
+
+/**
+ * @addtogroup wipc-group
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maximum number of bytes of messages a \ref wipc_out sends without the text
+ * buffered meanwhile also being written.  Were it unbounded, the pipe for
+ * messages could fill while the receiver is waiting for text that the sender
+ * can't write until the receiver reads some messages.
+ */
+#define WIPC_UNSYNCED_MAX         2048
+
+// local functions
+NODISCARD
+static size_t fd_read( int, void*, size_t );
+
+static void   frame_send( int, uint64_t, wipc_code_t, size_t, char const* );
+static void   wipc_out_write( char const*, size_t, void* );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Reads \a size bytes from \a fd into \a buf handling both partial reads and
+ * interrupts.
+ * If reading fails, prints an error message and exits.
+ *
+ * @param fd The file descriptor to read from.
+ * @param buf The buffer to read into.
+ * @param size The number of bytes to read.
+ * @return Returns the number of bytes read that is less than \a size only on
+ * EOF.
+ */
+static size_t fd_read( int fd, void *buf, size_t size ) {
+  assert( buf != NULL );
+  char *const p = buf;
+  size_t bytes_read = 0;
+  while ( bytes_read < size ) {
+    ssize_t const n = read( fd, p + bytes_read, size - bytes_read );
+    if ( n == 0 )
+      break;
+    if ( unlikely( n == -1 ) ) {
+      if ( errno == EINTR )
+        continue;
+      perror_exit( EX_IOERR );
+    }
+    bytes_read += STATIC_CAST( size_t, n );
+  } // while
+  return bytes_read;
+}
+
+/**
+ * Sends a message.
+ *
+ * @param fd The file descriptor to send to.
+ * @param offset The offset into the text the message applies at.
+ * @param code The \ref wipc_code.
+ * @param line_width The new line width for #WIPC_CODE_NEW_LEADER.
+ * @param leader The new leader for #WIPC_CODE_NEW_LEADER; NULL otherwise.
+ */
+static void frame_send( int fd, uint64_t offset, wipc_code_t code,
+                        size_t line_width, char const *leader ) {
+  size_t const leader_len = leader != NULL ? strlen( leader ) : 0;
+  wipc_frame_t const frame = {
+    .offset = offset,
+    .code = STATIC_CAST( uint32_t, code ),
+    .line_width = STATIC_CAST( uint32_t, line_width ),
+    .leader_len = STATIC_CAST( uint32_t, leader_len ),
+    .reserved = 0
+  };
+  write_all( fd, POINTER_CAST( char const*, &frame ), sizeof frame );
+  if ( leader_len > 0 )
+    write_all( fd, leader, leader_len );
+}
+
+/**
+ * The \ref writer_fn_t of a \ref wipc_out's writer of the text: sends a
+ * #WIPC_CODE_SYNC message for the end of the text, then writes it.
+ *
+ * @param s The characters to write.
+ * @param len The number of characters to write.
+ * @param data A pointer to the \ref wipc_out.
+ */
+static void wipc_out_write( char const *s, size_t len, void *data ) {
+  wipc_out_t *const out = data;
+  out->written += len;
+  frame_send( out->fd, out->written, WIPC_CODE_SYNC, 0, /*leader=*/NULL );
+  write_all( out->data_fd, s, len );
+  out->unsynced = 0;
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void wipc_in_cleanup( wipc_in_t *in ) {
+  assert( in != NULL );
+  line_buf_cleanup( &in->leader );
+}
+
+void wipc_in_init( wipc_in_t *in, int fd ) {
+  assert( in != NULL );
+  *in = (wipc_in_t){ .fd = fd };
+  line_buf_init( &in->leader );
+}
+
+bool wipc_in_read( wipc_in_t *in, uint64_t offset ) {
+  assert( in != NULL );
+  while ( !in->has_frame ) {
+    if ( in->is_eof || offset < in->synced )
+      return false;
+    size_t const n = fd_read( in->fd, &in->frame, sizeof in->frame );
+    if ( n == 0 ) {
+      in->is_eof = true;
+      return false;
+    }
+    if ( unlikely( n < sizeof in->frame ) )
+      fatal_error( EX_IOERR, "truncated IPC message\n" );
+    if ( in->frame.code == WIPC_CODE_SYNC ) {
+      in->synced = in->frame.offset;
+      continue;
+    }
+    size_t const leader_len = in->frame.leader_len;
+    line_buf_reserve( &in->leader, leader_len );
+    if ( unlikely( fd_read( in->fd, in->leader.str, leader_len ) !=
+                   leader_len ) ) {
+      fatal_error( EX_IOERR, "truncated IPC message\n" );
+    }
+    in->leader.str[ leader_len ] = '\0';
+    in->has_frame = true;
+  } // while
+  return in->frame.offset <= offset;
+}
+
+void wipc_out_init( wipc_out_t *out, writer_t *data, int data_fd, int fd ) {
+  assert( out != NULL );
+  assert( data != NULL );
+  *out = (wipc_out_t){ .data = data, .data_fd = data_fd, .fd = fd };
+  writer_init_fn( data, &wipc_out_write, out );
+}
+
+void wipc_out_send( wipc_out_t *out, wipc_code_t code, size_t line_width,
+                    char const *leader ) {
+  assert( out != NULL );
+  assert( code != WIPC_CODE_SYNC );
+  PROBE1( ipc_send, code );
+  frame_send(
+    out->fd, out->written + out->data->len, code, line_width, leader
+  );
+  out->unsynced += sizeof( wipc_frame_t );
+  if ( leader != NULL )
+    out->unsynced += strlen( leader );
+  if ( out->unsynced > WIPC_UNSYNCED_MAX ) {
+    //
+    // If nothing is buffered, every message sent applies at the end of what's
+    // been written, so the receiver will read them all before waiting for more
+    // text.
+    //
+    writer_spill( out->data );
+    out->unsynced = 0;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,217 @@
+/*
+**      wrap -- text reformatter
+**      src/wipc.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_wipc_H
+#define wrap_wipc_H
+
+/**
+ * @file
+ * Declares data structures and functions for sending Interprocess
+ * Communication (IPC) messages between **wrapc**(1) and the **wrap**(1)
+ * engine out-of-band as binary frames.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "writer.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint32_t, uint64_t */
+
+/// @endcond
+
+_GL_INLINE_HEADER_BEGIN
+#ifndef W_WIPC_H_INLINE
+# define W_WIPC_H_INLINE _GL_INLINE
+#endif /* W_WIPC_H_INLINE */
+
+/**
+ * @defgroup wipc-group Out-of-Band IPC
+ * Data structures and functions for sending IPC messages through a pipe of
+ * their own alongside the pipe of the text they apply to so that the text
+ * never has to be checked for them.
+ *
+ * @remarks Each message is a fixed-size \ref wipc_frame (followed only by a
+ * #WIPC_CODE_NEW_LEADER's leader) tagged with the offset into the text at
+ * which it applies, i.e., just before the line starting there.  A sender
+ * sends each message _before_ writing any of the text at or after its offset;
+ * and, before writing each buffer of text, a #WIPC_CODE_SYNC message tagged
+ * with the offset of the end of that buffer.  Hence a receiver about to read
+ * the line at a given offset needs to read a message only when it has no
+ * message pending and hasn't already been told that none applies there:
+ * about once per buffer rather than once per line.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An out-of-band IPC message.
+ */
+struct wipc_frame {
+  uint64_t  offset;                     ///< Offset into the text it applies at.
+  uint32_t  code;                       ///< The \ref wipc_code.
+  uint32_t  line_width;                 ///< #WIPC_CODE_NEW_LEADER line width.
+  uint32_t  leader_len;                 ///< Length of the leader that follows.
+  uint32_t  reserved;                   ///< Unused; always 0.
+};
+typedef struct wipc_frame wipc_frame_t;
+
+/**
+ * The receiving end of an out-of-band IPC channel.
+ */
+struct wipc_in {
+  int           fd;                     ///< File descriptor to read from.
+  wipc_frame_t  frame;                  ///< Pending message, if any.
+  line_buf_t    leader;                 ///< Its leader, if any.
+  uint64_t      synced;                 ///< All messages before it were read.
+  bool          has_frame;              ///< Is \a frame pending?
+  bool          is_eof;                 ///< No more messages are coming?
+};
+typedef struct wipc_in wipc_in_t;
+
+/**
+ * The sending end of an out-of-band IPC channel.
+ */
+struct wipc_out {
+  writer_t *data;                       ///< Writer of the text.
+  int       data_fd;                    ///< File descriptor \a data writes to.
+  int       fd;                         ///< File descriptor to send to.
+  uint64_t  written;                    ///< Characters of text written.
+  size_t    unsynced;                   ///< Bytes sent since text written.
+};
+typedef struct wipc_out wipc_out_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees all memory used by \a in.
+ *
+ * @param in The \ref wipc_in to clean up.
+ *
+ * @sa wipc_in_init()
+ */
+void wipc_in_cleanup( wipc_in_t *in );
+
+/**
+ * Consumes the message that wipc_in_due() just returned `true` for.
+ *
+ * @param in The \ref wipc_in to use.
+ */
+W_WIPC_H_INLINE
+void wipc_in_consume( wipc_in_t *in ) {
+  in->has_frame = false;
+}
+
+/**
+ * Reads messages, as needed, until either one is pending or it's known that
+ * none applies at \a offset.
+ *
+ * @param in The \ref wipc_in to use.
+ * @param offset The offset into the text of the line about to be read.
+ * @return Returns `true` only if a message is pending that applies at (or
+ * before) \a offset.
+ *
+ * @sa wipc_in_due()
+ */
+NODISCARD
+bool wipc_in_read( wipc_in_t *in, uint64_t offset );
+
+/**
+ * Checks whether there's a message that applies at \a offset.  If so, it's
+ * \ref wipc_in::frame (and \ref wipc_in::leader) until wipc_in_consume() is
+ * called.
+ *
+ * @param in The \ref wipc_in to use.
+ * @param offset The offset into the text of the line about to be read.
+ * @return Returns `true` only if there's such a message.
+ */
+NODISCARD W_WIPC_H_INLINE
+bool wipc_in_due( wipc_in_t *in, uint64_t offset ) {
+  if ( !in->has_frame && (in->is_eof || offset < in->synced) )
+    return false;
+  return wipc_in_read( in, offset );
+}
+
+/**
+ * Initializes \a in.
+ *
+ * @param in The \ref wipc_in to initialize.
+ * @param fd The file descriptor to read messages from.
+ *
+ * @sa wipc_in_cleanup()
+ */
+void wipc_in_init( wipc_in_t *in, int fd );
+
+/**
+ * Gets the maximum number of characters of text that can be read at \a offset
+ * without reading past where a message might apply.
+ *
+ * @param in The \ref wipc_in to use.
+ * @param offset The offset into the text of the line about to be read.  There
+ * must be no message that applies at it, i.e., wipc_in_due() must have just
+ * returned `false` for it.
+ * @param size_max The maximum number of characters to read otherwise.
+ * @return Returns said number of characters.
+ */
+NODISCARD W_WIPC_H_INLINE
+size_t wipc_in_limit( wipc_in_t const *in, uint64_t offset, size_t size_max ) {
+  if ( !in->has_frame && in->is_eof )
+    return size_max;
+  uint64_t const end = in->has_frame ? in->frame.offset : in->synced;
+  return end - offset < size_max ? STATIC_CAST( size_t, end - offset ) :
+    size_max;
+}
+
+/**
+ * Initializes \a out and also initializes \a data to write to \a data_fd
+ * sending each #WIPC_CODE_SYNC message as needed.
+ *
+ * @param out The \ref wipc_out to initialize.
+ * @param data The \ref writer of the text the messages apply to.
+ * @param data_fd The file descriptor to write the text to.
+ * @param fd The file descriptor to send messages to.
+ */
+void wipc_out_init( wipc_out_t *out, writer_t *data, int data_fd, int fd );
+
+/**
+ * Sends a message that applies at the current end of the text.
+ *
+ * @param out The \ref wipc_out to use.
+ * @param code The \ref wipc_code.
+ * @param line_width The new line width for #WIPC_CODE_NEW_LEADER.
+ * @param leader The new leader for #WIPC_CODE_NEW_LEADER; NULL otherwise.
+ */
+void wipc_out_send( wipc_out_t *out, wipc_code_t code, size_t line_width,
+                    char const *leader );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+_GL_INLINE_HEADER_END
+
+#endif /* wrap_wipc_H */
+/* vim:set et sw=2 ts=2: */
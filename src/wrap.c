@@ -20,33 +20,69 @@
 
 /**
  * @file
- * Implements **wrap**(1).
+ * Implements the **wrap**(1) engine used by both **wrap**(1) and, linked in,
+ * **wrapc**(1).
  */
 
 // local
 #include "pjl_config.h"                 /* must go first */
+#include "abbrev.h"
 #include "alias.h"
 #include "common.h"
+#include "conf_cache.h"
+#include "doxygen.h"
+#include "git.h"
+#include "hyphenate.h"
+#include "json.h"
 #include "markdown.h"
+#include "nobreak.h"
 #include "options.h"
+#include "para_cache.h"
+#include "para_index.h"
 #include "pattern.h"
+#include "probe.h"
+#include "read_conf.h"
+#include "reader.h"
+#include "simd.h"
+#include "span.h"
 #include "unicode.h"
 #include "util.h"
+#include "wipc.h"
+#include "wrap.h"
 #include "wregex.h"
+#include "writer.h"
 
 /// @cond DOXYGEN_IGNORE
 
 // standard
 #include <assert.h>
 #include <ctype.h>
+#include <fcntl.h>                      /* for open(2) */
+#include <inttypes.h>                   /* for PRIu64 */
+#include <poll.h>                       /* for poll(2) */
+#if HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY
+#include <sched.h>                      /* for sched_setaffinity(2) */
+#endif /* HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY */
+#include <signal.h>                     /* for kill(2) */
 #include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for SIZE_MAX, uint64_t */
 #include <stdio.h>
 #include <stdlib.h>                     /* for exit(), ... */
 #include <string.h>
+#include <sys/resource.h>               /* for RUSAGE_SELF */
+#include <sys/stat.h>                   /* for fchmod(2), stat(2) */
+#include <sys/wait.h>                   /* for waitpid(2) */
 #include <sysexits.h>
 #include <unistd.h>
 
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+# include <sys/mman.h>                  /* for mmap(2) */
+# ifdef MAP_ANONYMOUS
+#   define WITH_PARA_MARKDOWN 1
+# endif /* MAP_ANONYMOUS */
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+
 /// @endcond
 
 /**
@@ -58,689 +94,5917 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-#define WIPC_DEFER(BUF,SIZE,CODE) WPIC_DEFERF( BUF, SIZE, CODE, "%c", '\n' )
+/**
+ * Exit status for either `--check` or `--diff` when the input isn't already
+ * formatted.
+ */
+#define CHECK_EX_UNFORMATTED      1
+
+/**
+ * Number of characters at the start of each file checked by simd_is_binary()
+ * when reformatting files in place.
+ */
+#define IN_PLACE_PEEK_SIZE        8192
 
-#define WIPC_DEFERF(BUF,SIZE,CODE,FORMAT,...) \
-  snprintf( (BUF), (SIZE), ("%c" FORMAT), (CODE), __VA_ARGS__ )
 
 /**
- * Hyphenation states.
+ * Minimum number of characters of input per chunk when reformatting
+ * paragraphs in parallel: below this, the cost of forking outweighs any gain.
  */
-enum hyphen {                           // H = hyphen-adjacent char
-  HYPHEN_NO,                            ///< Didn't encounter a hyphen.
-  HYPHEN_MAYBE,                         ///< Encountered `H-`.
-  HYPHEN_YES                            ///< Encountered `H-H`.
-};
-typedef enum hyphen hyphen_t;
+#define PARA_CHUNK_SIZE_MIN       (1024 * 1024)
+
+/**
+ * Number of chunks per job when reformatting paragraphs in parallel: more,
+ * smaller chunks let the output of each be held until its turn in less memory
+ * and let a job that finishes early start another.
+ */
+#define PARA_CHUNKS_PER_JOB       8
+
+/**
+ * Maximum length of a line counted by wrap_width_estimate(): longer lines
+ * (e.g., of a table or unwrapped text) weren't wrapped to any line width.
+ */
+#define WIDTH_AUTO_LEN_MAX        255
+
+/**
+ * The reciprocal of the fraction of wrapped lines that must be of the longest
+ * length counted by wrap_width_estimate() so that a few overlong lines (e.g.,
+ * of a long URL) don't count.
+ */
+#define WIDTH_AUTO_LEN_RATIO      16
 
 /**
- * Line indentation type.
+ * Minimum number of wrapped lines wrap_width_estimate() needs.
  */
-enum indent {
-  INDENT_NONE,                          ///< No indentation.
+#define WIDTH_AUTO_LINES_MIN      4
 
-  /// Indent only first line of a paragraph.
-  INDENT_LINE,
+/**
+ * Maximum number of characters at the start of the input that
+ * `--width=auto` looks at.
+ */
+#define WIDTH_AUTO_SIZE_MAX       (64 * 1024)
+
+/**
+ * Number of consecutive line lengths, ending with the longest counted by
+ * wrap_width_estimate(), that must together contain at least 1 in
+ * #WIDTH_AUTO_WINDOW_RATIO of the wrapped lines: lines of wrapped text mostly
+ * fall within a few columns short of the line width.
+ */
+#define WIDTH_AUTO_WINDOW         8
+
+/**
+ * The reciprocal of the fraction of wrapped lines that #WIDTH_AUTO_WINDOW
+ * line lengths must contain.
+ */
+#define WIDTH_AUTO_WINDOW_RATIO   4
 
-  /// Indent all lines but first of a paragraph.
-  INDENT_HANG
+
+/**
+ * Wrapping engines, each using every optimization of those before it plus its
+ * own.  All produce the same output for the same input and options, just at
+ * different speeds.
+ *
+ * @sa engine_init()
+ */
+enum wrap_engine {
+  /// The generic main loop reading one byte at a time with no SIMD, no
+  /// skipping of what's already formatted, no paragraph cache, and no
+  /// parallel jobs.
+  WRAP_ENGINE_REFERENCE,
+
+  /// Main loops specialized for the features enabled, ASCII and valid UTF-8
+  /// fast paths, skipping of what's already formatted, the paragraph cache,
+  /// and parallel jobs.
+  WRAP_ENGINE_FAST,
+
+  /// Also copies the rest of a word all at once rather than one character at
+  /// a time.
+  WRAP_ENGINE_SPAN,
+
+  /// Also uses SIMD instructions to scan, span, and check UTF-8, if the CPU
+  /// supports them.
+  WRAP_ENGINE_SIMD
 };
-typedef enum indent indent_t;
+typedef enum wrap_engine wrap_engine_t;
 
-// extern variable definitions
-char const         *me;                 // executable name
+/**
+ * Names of the \ref wrap_engine for `WRAP_ENGINE` and `--stats`.
+ */
+static char const *const WRAP_ENGINE_NAMES[] = {
+  "reference", "fast", "span", "simd"
+};
+/**
+ * Maximum number of characters of output held until their turn when
+ * reformatting paragraphs in parallel: once reached, jobs whose output isn't
+ * next are left blocked writing it.
+ */
+#define PARA_REORDER_MAX          (16 * 1024 * 1024)
 
-// local variable definitions
-static wregex_t     block_regex;        ///< Compiled from opt_block_regex.
-static size_t       consec_newlines;    ///< Number of consecutive newlines.
-static bool         encountered_nonws;  ///< Encountered a non-whitespace char?
-static hyphen_t     hyphen;             ///< Hyphen state.
-static indent_t     indent = INDENT_LINE;
-static line_buf_t   input_buf;          ///< Input buffer.
-static line_buf_t   ipc_buf;            ///< Deferred IPC message.
-static size_t       ipc_width;          ///< Deferred IPC line width.
-static bool         is_long_line;       ///< Line longer than line_width?
-static bool         is_preformatted;    ///< Passing through preformatted text?
-static size_t       line_width;         ///< Maximum width of a line.
-static size_t       nonws_no_wrap_range[2];
-static wregex_t     nonws_no_wrap_regex;
-static line_buf_t   output_buf;         ///< Output buffer.
-static size_t       output_len;         ///< Number of characters in output_buf.
-static size_t       output_width;       ///< Actual width of output_buf.
-static line_buf_t   proto_buf;          ///< Prototype buffer.
-static line_buf_t   proto_tws;          // prototype trailing whitespace, if any
-static size_t       put_spaces;         ///< Spaces to put between words.
-static bool         was_eos_char;       ///< Prev char an end-of-sentence char?
+/**
+ * Size of each page of output held until its turn when reformatting
+ * paragraphs in parallel.
+ */
+#define PARA_PAGE_SIZE            (64 * 1024)
 
-// local functions
-NODISCARD
-static char32_t     buf_getcp( char const**, utf8c_t );
+/**
+ * The input being checked against its reformatted output for `--check`.
+ *
+ * @sa check_write()
+ */
+struct check_in {
+  char const *s;                        ///< Input.
+  size_t      size;                     ///< Length of \a s.
+  size_t      pos;                      ///< Length compared so far.
+};
+typedef struct check_in check_in_t;
 
-NODISCARD
-static size_t       buf_readline( void );
+/**
+ * A unified diff of the input and its reformatted output for `--diff` being
+ * written.
+ *
+ * @sa diff_chunk()
+ */
+struct diff_out {
+  writer_t *w;                          ///< Writer to write the diff to.
+  size_t    in_lines;                   ///< Number of input lines so far.
+  size_t    out_lines;                  ///< Number of output lines so far.
+  bool      differs;                    ///< Has any hunk been written?
+};
+typedef struct diff_out diff_out_t;
 
-static void         delimit_paragraph( void );
-static void         init( int, char const*[] );
+/**
+ * The edits that turn the input into its reformatted output for `--edits`
+ * being written.
+ *
+ * @sa edits_chunk()
+ */
+struct edits_out {
+  writer_t   *w;                        ///< Writer to write the edits to.
+  json_buf_t  buf;                      ///< Buffer for composing an edit.
+};
+typedef struct edits_out edits_out_t;
 
-NODISCARD
-static bool         markdown_adjust( void );
+/**
+ * A child process reformatting a file in place.
+ *
+ * @sa in_place_fork()
+ */
+struct in_place_job {
+  pid_t   pid;                          ///< Process ID of the child.
+  size_t  file_idx;                     ///< Index into \ref opt_files.
+  char   *temp_path;                    ///< Path of temporary output file.
+  char const *real_path;                ///< Path of the file to replace.
+  size_t  slot;                         ///< Slot for job_pin().
+};
+typedef struct in_place_job in_place_job_t;
 
-static void         markdown_reset( void );
-static void         put_lead_chars( void );
-static void         put_line( size_t, bool );
-static void         put_tabs_spaces( size_t, size_t );
+/**
+ * A file to reformat in place, as found by a single **stat**(2).
+ *
+ * @sa in_place_fork()
+ */
+struct in_place_file {
+  size_t  file_idx;                     ///< Index into \ref opt_files.
+  int     stat_err;                     ///< Error from **stat**(2) or 0.
+  mode_t  mode;                         ///< Mode of the file.
+  size_t  size;                         ///< Size of the file in bytes.
 
-_Noreturn
-static void         usage( int );
+  /// Path of the file with all symbolic links resolved so that a link is
+  /// written through rather than replaced by a regular file or null if
+  /// \ref stat_err is set.
+  char   *real_path;
 
-static void         wipc_parse( char const** );
-static void         wipc_send( char* );
-static void         wrap_cleanup( void );
+  /// Index into \ref opt_files of the identical file reformatted in its stead
+  /// or `SIZE_MAX` if none.
+  size_t  dup_idx;
+};
+typedef struct in_place_file in_place_file_t;
 
-////////// inline functions ///////////////////////////////////////////////////
+/**
+ * The measurements of the paragraphs reformatted to one line width for
+ * `--measure` not yet printed.
+ *
+ * @sa stdin_measure()
+ */
+struct measure_queue {
+  size_t     *pairs;                    ///< Line count & width pairs.
+  size_t      cap;                      ///< Capacity of \a pairs.
+  size_t      len;                      ///< Number of pairs.
+};
+typedef struct measure_queue measure_queue_t;
 
 /**
- * Checks whether the "block" regular expression matches the input buffer.
+ * The cost of reformatting a paragraph printed for `--stats=`_N_.
  *
- * @return Returns `true` only if it does.
+ * @sa stats_para_end()
  */
-NODISCARD
-static inline bool block_regex_matches( void ) {
-  return  opt_block_regex != NULL &&
-          regex_match( &block_regex, input_buf, 0, NULL );
-}
+struct para_cost {
+  uint64_t    ns;                       ///< Nanoseconds reformatting it.
+  uint64_t    offset;                   ///< Byte offset of its first line.
+  uint64_t    line_first;               ///< Line number of its first line.
+  uint64_t    line_last;                ///< Line number of its last line.
+  uint64_t    bytes;                    ///< Length in bytes.
+  uint64_t    regex_calls;              ///< Lines matched against regexes.
+  md_line_t   md_line_type;             ///< Its last Markdown line type.
+  md_depth_t  md_depth;                 ///< Its deepest Markdown depth.
+};
+typedef struct para_cost para_cost_t;
 
 /**
- * Checks whether \a cp is a paragraph delimiter Unicode character.
+ * The reformatted output of a paragraph either to be added to the paragraph
+ * cache or diffed.
  *
- * @param cp The Unicode code-point to check.
- * @return Returns `true` only if \a cp is a paragraph delimiter character.
+ * @sa stdin_diff()
+ * @sa stdin_run_cached()
  */
-NODISCARD
-static inline bool cp_is_para_delim( char32_t cp ) {
-  return  opt_para_delims != NULL && cp_is_ascii( cp ) &&
-          strchr( opt_para_delims, STATIC_CAST( int, cp ) ) != NULL;
-}
+struct para_out {
+  line_buf_t  buf;                      ///< Output.
+  size_t      len;                      ///< Length of \a buf.
+};
+typedef struct para_out para_out_t;
 
 /**
- * Prints an end-of-line and sends any pending IPC message to **wrapc**(1).
+ * A page of output of a \ref para_job held until its turn.  Output is read
+ * from the child straight into pages that are never moved, then all of them
+ * are written via a single **writev**(2).
  */
-static inline void put_eol( void ) {
-  PUTS( eol() );
-  wipc_send( ipc_buf );
-}
+struct para_page {
+  struct para_page *next;               ///< Next page or NULL if none.
+  size_t            len;                ///< Number of characters in \a buf.
+  char              buf[ PARA_PAGE_SIZE ];  ///< Characters of output.
+};
+typedef struct para_page para_page_t;
 
-////////// main ///////////////////////////////////////////////////////////////
+/**
+ * A child process reformatting a chunk of paragraphs of standard input.
+ *
+ * @sa para_fork()
+ */
+struct para_job {
+  pid_t         pid;                    ///< Process ID of the child.
+  int           fd;                     ///< Pipe from the child or -1 at EOF.
+  para_page_t  *pages;                  ///< Output held until its turn.
+  para_page_t  *pages_tail;             ///< Last of \a pages.
+  size_t        pages_len;              ///< Number of \a pages.
+  int           status;                 ///< Exit status once at EOF.
+  size_t        slot;                   ///< Slot for job_pin().
+};
+typedef struct para_job para_job_t;
 
 /**
- * The main entry point.
+ * A variant of the main loop specialized for a combination of features.
  *
- * @param argc The command-line argument count.
- * @param argv The command-line argument values.
- * @return Returns 0 on success, non-zero on failure.
+ * @sa #WRAP_LOOP_VARIANTS
  */
-int main( int argc, char const *argv[] ) {
-  wait_for_debugger_attach( "WRAP_DEBUG" );
-  init( argc, argv );
+struct wrap_loop_variant {
+  unsigned        required;             ///< Features known to be enabled.
+  unsigned        possible;             ///< Features that may be enabled.
+  wrap_loop_fn_t  loop_fn;              ///< The specialized main loop.
+};
+typedef struct wrap_loop_variant wrap_loop_variant_t;
 
-  bool        next_line_is_title = opt_title_line;
-  char const *pb = input_buf;           // pointer to current byte
-  utf8c_t     utf8c;                    // current character's UTF-8 byte(s)
-  size_t      wrap_pos = 0;             // position at which we can wrap
+// Lines read into wrap_ctx::input_buf are renumbered in place by
+// markdown_parse().
+static_assert(
+  SIMD_SPAN_PAD > MD_OL_RENUMBER_PAD,
+  "SIMD_SPAN_PAD must leave room for MD_OL_RENUMBER_PAD"
+);
 
-  /////////////////////////////////////////////////////////////////////////////
+// local variable definitions
+static wrap_ctx_t   stdin_ctx;          ///< Context used by wrap_run().
+static git_file_t const *stdin_git_file;///< Changed lines, if any.
+static uint64_t     stdin_start_ns;     ///< When wrap_run() started.
+static wrap_ctx_t const *stdin_sub_ctx; ///< Stats added at exit, if any.
+static para_cost_t *stats_paras;        ///< Costliest paragraphs, costliest 1st.
+static size_t       stats_paras_len;    ///< Length of \ref stats_paras.
+#if HAVE_FALLOCATE && defined(FALLOC_FL_KEEP_SIZE)
+static pid_t        stdout_trim_pid;    ///< Process that preallocated stdout.
+#endif /* HAVE_FALLOCATE && FALLOC_FL_KEEP_SIZE */
+static wipc_in_t    stdin_wipc_in;      ///< IPC in for wrap_run_wipc().
+static wipc_out_t   stdin_wipc_out;     ///< IPC out for wrap_run_wipc().
+static wrap_engine_t wrap_engine;       ///< Engine to use.
 
-  for ( char32_t cp, cp_prev = '\n';    // current and previous codepoints
-        (cp = buf_getcp( &pb, utf8c )) != CP_EOF; cp_prev = cp ) {
+/// Number of chunks each child absorbed, in memory shared with the parent.
+static size_t      *para_md_absorbed;
 
-    if ( cp == CP_BYTE_ORDER_MARK || cp == CP_INVALID )
-      continue;
+static char const  *para_md_input;      ///< In a child, all of the input.
+static size_t      *para_md_bounds;     ///< In a child, chunk boundaries.
+static size_t       para_md_chunk;      ///< In a child, index of its chunk.
+static size_t       para_md_chunks;     ///< In a child, number of chunks.
+static para_page_t *para_pages_free;    ///< Pages to reuse, if any.
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  HANDLE NEWLINE(s)
-    ///////////////////////////////////////////////////////////////////////////
+// local functions
+NODISCARD
+static char const*  block_regex_anchor( char const*, char** );
 
-    if ( cp == '\r' ) {
-      //
-      // The code is simpler if we always strip \r and add it back later (if
-      // opt_eol is EOL_WINDOWS).
-      //
-      continue;
-    }
+NODISCARD
+static char32_t     buf_getcp( wrap_ctx_t*, char const**, utf8c_t );
 
-    if ( cp == '\n' ) {
-      encountered_nonws = false;
+NODISCARD
+static size_t       buf_readline( wrap_ctx_t* );
 
-      if ( ++consec_newlines >= opt_newlines_delimit ) {
-        //
-        // At least opt_newlines_delimit consecutive newlines: set that the
-        // next line is a title line and delimit the paragraph.
-        //
-        next_line_is_title = opt_title_line;
-        delimit_paragraph();
-        continue;
-      }
-      if ( output_len > 0 && true_clear( &next_line_is_title ) ) {
-        //
-        // The first line of the next paragraph is title line and the buffer
-        // isn't empty (there is a title): print the title.
-        //
-        delimit_paragraph();
-        indent = INDENT_HANG;
-        continue;
-      }
-      if ( was_eos_char ) {
-        if ( opt_eos_delimit ) {
-          //
-          // End-of-sentence characters delimit paragraphs and the previous
-          // character was an end-of-sentence character: delimit the paragraph.
-          //
-          delimit_paragraph();
-        } else {
-          //
-          // We are joining a line after the end of a sentence: force requested
-          // number of spaces.
-          //
-          put_spaces = opt_eos_spaces;
-        }
-        continue;
-      }
-      if ( hyphen == HYPHEN_MAYBE ) {
-        //
-        // We've encountered H-\n meaning that a potentially hyphenated word
-        // ends a line: eat the newline so the word can potentially be rejoined
-        // to the next word when wrapped, e.g.:
-        //
-        //      non-
-        //      whitespace
-        //
-        // can become:
-        //
-        //      non-whitespace
-        //
-        // instead of:
-        //
-        //      non- whitespace
-        //
-        continue;
-      }
-    } else {
-      consec_newlines = 0;
-    }
+NODISCARD
+static bool         check_can_scan( eol_t );
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  HANDLE WHITESPACE
-    ///////////////////////////////////////////////////////////////////////////
+NODISCARD
+static bool         check_is_wrapped( char const*, size_t );
 
-    if ( cp_is_space( cp ) ) {
-      if (  //
-            // We've been handling a "long line" and finally got a whitespace
-            // character at which we can finally wrap: delimit the paragraph.
-            //
-            is_long_line ||
-            //
-            // Leading whitespace characters delimit paragraphs and the
-            // previous character was a newline which means this whitespace
-            // character is at the beginning of a line: delimit the paragraph.
-            //
-            (opt_lead_ws_delimit && cp_prev == '\n') ||
-            //
-            // End-of-sentence characters delimit paragraphs and the previous
-            // character was an end-of-sentence character: delimit the
-            // paragraph.
-            //
-            (opt_eos_delimit && was_eos_char) ||
-            //
-            // The previous character was a paragraph-delimiter character (set
-            // only if opt_para_delims was set): delimit the paragraph.
-            //
-            cp_is_para_delim( cp_prev ) ) {
-        delimit_paragraph();
-      }
-      else if ( hyphen == HYPHEN_MAYBE && !encountered_nonws ) {
-        //
-        // This case is similar to above: we've encountered H-\n meaning that a
-        // potentially hyphenated word ended a line and we've only encountered
-        // leading whitespace on the next line so far: eat the space so the
-        // word can potentially be rejoined to the next word when wrapped.
-        //
-      }
-      else if ( output_len > 0 &&
-                put_spaces < (was_eos_char ? opt_eos_spaces : 1) ) {
-        //
-        // We are not at the beginning of a line: remember to insert 1 space
-        // later and allow opt_eos_spaces after the end of a sentence.
-        //
-        ++put_spaces;
-      }
-      continue;
-    }
+static void         check_write( char const*, size_t, void* );
+static void         ctx_init( wrap_ctx_t* );
+static void         ctx_start( wrap_ctx_t* );
+static void         delimit_paragraph( wrap_ctx_t* );
+static void         diff_chunk( diff_out_t*, char const*, size_t, char const*,
+                                size_t );
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  DISCARD CONTROL CHARACTERS
-    ///////////////////////////////////////////////////////////////////////////
+NODISCARD
+static size_t       diff_line_count( char const*, size_t );
 
-    if ( cp_is_control( cp ) )
-      continue;
+static void         diff_put_lines( writer_t*, char, char const*, size_t );
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  HANDLE LEADING-PARAGRAPH-DELIMITERS, LEADING-DOT, END-OF-SENTENCE, AND
-    //  PARAGRAPH-DELIMITERS
-    ///////////////////////////////////////////////////////////////////////////
+NODISCARD
+static bool         doxygen_adjust( wrap_ctx_t* );
 
-    if ( cp_prev == '\n' ) {
-      if ( opt_lead_dot_ignore && cp == '.' ) {
-        consec_newlines = 0;
-        delimit_paragraph();
-        PUTS( input_buf );              // print the line as-is
-        //
-        // Make state as if line never happened.
-        //
-        PJL_DISCARD_RV( buf_readline() );
-        pb = input_buf;
-        cp = '\n';                      // so cp_prev will become this (again)
-        continue;
-      }
-      if ( block_regex_matches() ) {
-        delimit_paragraph();
-        if ( opt_markdown ) {
-          markdown_init();
-          markdown_reset();
-        }
-      }
-      else if ( hyphen == HYPHEN_MAYBE && !cp_is_hyphen_adjacent( cp ) ) {
-        //
-        // We had encountered H-\n on the previous line meaning that a
-        // potentially hyphenated word ends a line, but the first character on
-        // the next line is not a "hyphen adjacent character" so forget about
-        // hyphenation and put the previously eaten whitespace back.
-        //
-        hyphen = HYPHEN_NO;
-        put_spaces = 1;
-      }
-    }
+NODISCARD
+static bool         doxygen_markdown_adjust( wrap_ctx_t* );
 
-    was_eos_char = cp_is_eos( cp ) || (was_eos_char && cp_is_eos_ext( cp ));
+static void         edits_chunk( edits_out_t*, size_t, char const*, size_t,
+                                 char const*, size_t );
+static void         edits_put( edits_out_t*, size_t, size_t, char const*,
+                               size_t );
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  INSERT SPACES
-    ///////////////////////////////////////////////////////////////////////////
+static void         engine_init( void );
+static void         doxygen_put_pre( wrap_ctx_t* );
 
-    if ( put_spaces > 0 ) {
-      if ( output_len > 0 ) {
-        //
-        // Mark position at a space to perform a wrap if necessary.
-        //
-        wrap_pos = output_len;
-        output_width += put_spaces;
-        do {
-          output_buf[ output_len++ ] = ' ';
-        } while ( --put_spaces > 0 );
-      } else {
-        //
-        // Never put spaces at the beginning of a line.
-        //
-        put_spaces = 0;
-      }
-    }
+static void         hyphen_split( wrap_ctx_t*, char const* );
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  PERFORM INDENTATION
-    ///////////////////////////////////////////////////////////////////////////
+NODISCARD
+static int          in_place_copy( char const*, in_place_file_t const* );
 
-    switch ( indent ) {
-      case INDENT_NONE:
-        break;
-      case INDENT_HANG:
-        put_tabs_spaces( opt_hang_tabs, opt_hang_spaces );
-        break;
-      case INDENT_LINE:
-        put_tabs_spaces( opt_indt_tabs, opt_indt_spaces );
-        break;
-    } // switch
-    indent = INDENT_NONE;
+static void         in_place_dedup( in_place_file_t*, size_t );
 
-    ///////////////////////////////////////////////////////////////////////////
-    //  INSERT NON-SPACE CHARACTER
-    ///////////////////////////////////////////////////////////////////////////
+NODISCARD
+static int          in_place_file_cmp( void const*, void const* );
 
-    encountered_nonws = true;
+static void         in_place_files_free( in_place_file_t*, size_t );
 
-    if ( !opt_no_hyphen ) {
-      size_t const pos = STATIC_CAST( size_t, pb - input_buf );
-      if ( pos >= nonws_no_wrap_range[1] || pos < nonws_no_wrap_range[0] ) {
-        //
-        // We're outside the non-whitespace-no-wrap range.
-        //
-        if ( hyphen == HYPHEN_MAYBE ) {
-          if ( cp_is_hyphen_adjacent( cp ) ) {
-            //
-            // We've encountered H-H meaning that this is definitely a
-            // hyphenated word: set wrap_pos to be here.
-            //
-            hyphen = HYPHEN_YES;
-            wrap_pos = output_len;
-          }
-          else if ( !cp_is_hyphen( cp ) ) {
-            //
-            // We've encountered H-X meaning that this is not a hyphenated
-            // word.
-            //
-            hyphen = HYPHEN_NO;
-          }
-          else {
-            //
-            // We've encountered H-- meaning that this is still potentially a
-            // hyphenated word.
-            //
-          }
+NODISCARD
+static int          in_place_finish( char const*, char*, int );
+
+static void         in_place_fork( void );
+
+NODISCARD
+static bool         in_place_is_binary( char const* );
+
+NODISCARD
+static bool         in_place_is_running( in_place_job_t const*, size_t,
+                                         size_t );
+
+NODISCARD
+static void const*  in_place_map( char const*, size_t );
+
+NODISCARD
+static pid_t        in_place_start( in_place_file_t const*, char**, int* );
+
+NODISCARD
+static char*        in_place_temp_path( char const* );
+
+NODISCARD
+static char const*  input_getline( wrap_ctx_t*, size_t, size_t* );
+
+NODISCARD
+static size_t       input_readline( wrap_ctx_t*, size_t );
+
+static void         input_unget( wrap_ctx_t*, size_t );
+static void         job_pin( size_t );
+
+NODISCARD
+static bool         markdown_adjust( wrap_ctx_t* );
+
+NODISCARD
+static bool         markdown_line_adjust( wrap_ctx_t* );
+
+static void         markdown_no_wrap_find( wrap_ctx_t* ),
+                    markdown_reset( wrap_ctx_t* );
+
+NODISCARD
+static bool         markup_adjust( wrap_ctx_t* );
+
+static void         measure_add( size_t, size_t, void* );
+
+NODISCARD
+static size_t       measure_lead_width( wrap_ctx_t* );
+
+static void         measure_para_end( wrap_ctx_t* );
+static void         measure_write( char const*, size_t, void* );
+
+NODISCARD
+static size_t       minimal_break( wrap_ctx_t*, char const*, size_t, size_t,
+                                   char const* );
+
+static void         minimal_write( wrap_ctx_t*, char const*, size_t,
+                                   char const* );
+
+NODISCARD
+static size_t       para_boundary( char const*, size_t, size_t );
+
+NODISCARD
+static bool         para_is_independent( void );
+
+static void         para_md_bounds_init( char const*, size_t, size_t*,
+                                         size_t );
+
+NODISCARD
+static bool         para_md_extend( wrap_ctx_t* );
+
+NODISCARD
+static bool         para_md_is_fence( char const*, size_t );
+
+NODISCARD
+static bool         para_md_is_independent( void );
+
+NODISCARD
+static bool         para_md_is_list_item( char const*, size_t );
+
+static void         para_out_write( char const*, size_t, void* );
+
+static void         para_fork( void );
+
+PJL_DISCARD
+static size_t       para_job_flush( para_job_t*, bool );
+
+NODISCARD
+static para_page_t* para_page_new( void );
+
+static void         put_lead_chars( wrap_ctx_t* );
+static void         put_line( wrap_ctx_t*, size_t, bool );
+static void         put_md_table( wrap_ctx_t* );
+static void         put_optimal( wrap_ctx_t*, size_t, size_t );
+static void         put_spans( wrap_ctx_t*, size_t, size_t, size_t, size_t );
+static void         put_tabs_spaces( wrap_ctx_t*, size_t, size_t );
+
+NODISCARD
+static bool         quote_adjust( wrap_ctx_t* );
+
+static void         quote_set_depth( wrap_ctx_t*, size_t );
+
+static void         stats_add( wrap_stats_t*, wrap_stats_t const* );
+static void         stats_mem( wrap_ctx_t* );
+static void         stats_para_end( wrap_ctx_t* );
+
+_Noreturn
+static void         stdin_check( void );
+
+NODISCARD
+static size_t       stdin_copy_blank( wrap_ctx_t*, size_t );
+
+_Noreturn
+static void         stdin_diff( wrap_ctx_t* );
+
+_Noreturn
+static void         stdin_edits( wrap_ctx_t* );
+
+NODISCARD
+static eol_t        stdin_eol( void );
+
+_Noreturn
+static void         stdin_follow( wrap_ctx_t* );
+
+NODISCARD
+static size_t       stdin_index_seek( wrap_ctx_t*, size_t );
+
+static void         stdin_index_write( void );
+
+_Noreturn
+static void         stdin_measure( wrap_ctx_t* );
+
+_Noreturn
+static void         stdin_minimal( wrap_ctx_t* );
+
+NODISCARD
+static char const*  stdin_slurp( size_t*, char** );
+
+_Noreturn
+static void         stdin_run( wrap_ctx_t* );
+
+_Noreturn
+static void         stdin_run_cached( wrap_ctx_t*, char const*, size_t );
+
+_Noreturn
+static void         stdin_run_changed( wrap_ctx_t*, git_file_t const* );
+
+_Noreturn
+static void         stdin_run_jsonl( wrap_ctx_t* );
+
+_Noreturn
+static void         stdin_run_widths( void );
+
+NODISCARD
+static size_t       stdin_size_hint( void );
+
+static void         stdout_preallocate( void );
+
+#if HAVE_FALLOCATE && defined(FALLOC_FL_KEEP_SIZE)
+static void         stdout_trim( void );
+#endif /* HAVE_FALLOCATE && FALLOC_FL_KEEP_SIZE */
+
+NODISCARD
+static size_t       str_cols( char const*, size_t, size_t );
+
+NODISCARD
+static char*        width_path( char const*, size_t );
+
+static void         wipc_parse( wrap_ctx_t*, char* );
+
+NODISCARD
+static size_t       wipc_readline( wrap_ctx_t* );
+
+static void         wipc_send( wrap_ctx_t* );
+static void         wipc_write( wrap_ctx_t*, wipc_code_t, size_t,
+                                char const* );
+static void         wrap_cleanup( void );
+static void         wrap_process( wrap_ctx_t* );
+
+NODISCARD
+static bool         wrap_start( wrap_ctx_t* );
+
+////////// inline functions ///////////////////////////////////////////////////
+
+/**
+ * Adds the nanoseconds since \a start to \a *ns, but only if `--stats` was
+ * given.
+ *
+ * @param ns A pointer to the nanoseconds to add to.
+ * @param start The time gotten from stats_now().
+ */
+static inline void stats_charge( uint64_t *ns, uint64_t start ) {
+  if ( unlikely( opt_stats ) )
+    *ns += now_ns() - start;
+}
+
+/**
+ * Raises \a *peak to \a size if it's greater.
+ *
+ * @param peak A pointer to the peak to raise.
+ * @param size The current size.
+ * @return Returns \a size.
+ */
+PJL_DISCARD
+static inline size_t stats_peak( uint64_t *peak, size_t size ) {
+  if ( size > *peak )
+    *peak = size;
+  return size;
+}
+
+/**
+ * Notes that a paragraph starts with the line just read, but only if
+ * `--stats=`_N_ was given and one hasn't started already.  Blank lines never
+ * start one.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ *
+ * @sa stats_para_end()
+ */
+static inline void stats_para_start( wrap_ctx_t *ctx ) {
+  if ( likely( opt_stats_paras == 0 ) || ctx->para_ns != 0 )
+    return;
+  char const *s = ctx->input_buf.str;
+  if ( SKIP_CHARS( s, WS_STRN )[0] == '\0' )
+    return;
+  ctx->para_ns = now_ns();
+  ctx->para_stats = ctx->stats;
+  ctx->para_md_line_type = MD_NONE;
+  ctx->para_md_depth = 0;
+}
+
+/**
+ * Gets the current time, but only if `--stats` was given.
+ *
+ * @return Returns said time in nanoseconds or 0.
+ */
+NODISCARD
+static inline uint64_t stats_now( void ) {
+  return unlikely( opt_stats ) ? now_ns() : 0;
+}
+
+/**
+ * Checks whether the "block" regular expression matches the input buffer.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if it does.
+ */
+NODISCARD
+static inline bool block_regex_matches( wrap_ctx_t *ctx ) {
+  if ( (ctx->features & WRAP_FEAT_BLOCK_REGEX) == 0 )
+    return false;
+  uint64_t const start = stats_now();
+  bool const matched = regex_match(
+    &ctx->block_regex, ctx->input_buf.str, 0, /*words=*/NULL, /*range=*/NULL
+  );
+  stats_charge( &ctx->stats.block_regex_ns, start );
+  ++ctx->stats.block_regex_calls;
+  ctx->stats.block_regex_hits += matched;
+  PROBE2( regex, 'b', matched );
+  return matched;
+}
+
+/**
+ * Checks whether \a cp is a paragraph delimiter Unicode character.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param cp The Unicode code-point to check.
+ * @return Returns `true` only if \a cp is a paragraph delimiter character.
+ */
+NODISCARD
+static inline bool cp_is_para_delim( wrap_ctx_t *ctx, char32_t cp ) {
+  return cp_is_ascii( cp ) &&
+    (ctx->para_delims[ cp >> 6 ] >> (cp & 63) & 1) != 0;
+}
+
+/**
+ * Gets the width of the hang-indent.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns said width.
+ */
+NODISCARD
+static inline size_t hang_width( wrap_ctx_t *ctx ) {
+  return ctx->opt.hang_tabs * ctx->opt.tab_spaces + ctx->opt.hang_spaces;
+}
+
+/**
+ * Checks whether \a buf is the end of a line.
+ *
+ * @param buf The \ref line_buf to check.
+ * @return Returns `true` only if \a buf is either empty or ends with a
+ * newline.
+ */
+NODISCARD
+static inline bool is_line_end( line_buf_t const *buf ) {
+  return buf->len == 0 || buf->str[ buf->len - 1 ] == '\n';
+}
+
+/**
+ * Prints an end-of-line and sends any pending IPC message to **wrapc**(1).
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static inline void put_eol( wrap_ctx_t *ctx ) {
+  if ( unlikely( ctx->measure_fn != NULL ) ) {
+    if ( ctx->measure_line_width > 0 ) {
+      ++ctx->measure_lines;
+      if ( ctx->measure_line_width > ctx->measure_width )
+        ctx->measure_width = ctx->measure_line_width;
+      ctx->measure_line_width = 0;
+    }
+    return;
+  }
+  if ( unlikely( ctx->opt.eol == EOL_INPUT ) ) {
+    //
+    // See the comment in wrap_start().  If no newline has been read at all
+    // yet, the first line is longer than what's been read of it, so assume
+    // Unix end-of-lines.
+    //
+    ctx->opt.eol = reader_eol( ctx->fin ) == EOL_WINDOWS ?
+      EOL_WINDOWS : EOL_UNIX;
+  }
+  size_t const is_crlf = ctx->opt.eol == EOL_WINDOWS;
+  writer_write( &ctx->wout, (char const*)"\r\n" + !is_crlf, 1 + is_crlf );
+  writer_eol( &ctx->wout );
+  PROBE( line_emit );
+  wipc_send( ctx );
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void wrap_ctx_cleanup( wrap_ctx_t *ctx ) {
+  assert( ctx != NULL );
+  writer_cleanup( &ctx->wout );
+  line_buf_cleanup( &ctx->feed_buf );
+  line_buf_cleanup( &ctx->input_buf );
+  line_buf_cleanup( &ctx->ipc_buf );
+  line_buf_cleanup( &ctx->lead_buf );
+  line_buf_cleanup( &ctx->output_buf );
+  line_buf_cleanup( &ctx->proto_buf );
+  line_buf_cleanup( &ctx->proto_tws );
+  span_list_cleanup( &ctx->spans );
+  regex_free( &ctx->block_regex );
+  regex_ranges_cleanup( &ctx->nonws_no_wrap_ranges );
+  regex_words_cleanup( &ctx->nonws_no_wrap_words );
+  FREE( ctx->hyph_breaks );
+  markdown_cleanup( &ctx->md_parser );
+  regex_ranges_cleanup( &ctx->md_no_wrap_ranges );
+  md_table_cleanup( &ctx->md_table );
+  line_buf_cleanup( &ctx->md_table_buf );
+}
+
+void wrap_ctx_init( wrap_ctx_t *ctx, writer_fn_t write_fn, void *data ) {
+  assert( write_fn != NULL );
+  ctx_init( ctx );
+  writer_init_fn( &ctx->wout, write_fn, data );
+}
+
+void wrap_ctx_init_measure( wrap_ctx_t *ctx, wrap_measure_fn_t measure_fn,
+                            void *data ) {
+  assert( measure_fn != NULL );
+  wrap_ctx_init( ctx, &measure_write, NULL );
+  ctx->measure_fn = measure_fn;
+  ctx->measure_data = data;
+}
+
+void wrap_ctx_reset( wrap_ctx_t *ctx ) {
+  assert( ctx != NULL );
+  assert( ctx->fin == NULL );
+  wrap_ctx_t const prev = *ctx;
+  markdown_cleanup( &ctx->md_parser );
+  md_table_cleanup( &ctx->md_table );
+  ctx_start( ctx );
+
+  //
+  // Keep the memory and the compiled regular expression for reuse.
+  //
+  ctx->feed_buf = prev.feed_buf;
+  ctx->input_buf = prev.input_buf;
+  ctx->hyph_breaks = prev.hyph_breaks;
+  ctx->hyph_breaks_cap = prev.hyph_breaks_cap;
+  ctx->nonws_no_wrap_ranges = prev.nonws_no_wrap_ranges;
+  ctx->nonws_no_wrap_ranges.len = 0;
+  ctx->nonws_no_wrap_words = prev.nonws_no_wrap_words;
+  regex_words_reset( &ctx->nonws_no_wrap_words );
+  ctx->output_buf = prev.output_buf;
+  ctx->spans = prev.spans;
+  span_list_clear( &ctx->spans );
+  ctx->block_regex = prev.block_regex;
+  ctx->proto_buf = prev.proto_buf;
+  ctx->proto_tws = prev.proto_tws;
+  ctx->proto_tws.str[0] = '\0';
+  ctx->lead_buf = prev.lead_buf;        // composed of 0 tabs & spaces
+  ctx->md_no_wrap_ranges = prev.md_no_wrap_ranges;
+  ctx->md_no_wrap_ranges.len = 0;
+  ctx->md_table_buf = prev.md_table_buf;
+  ctx->ipc_buf = prev.ipc_buf;
+  ctx->wout = prev.wout;
+  ctx->stats = prev.stats;
+  ctx->measure_fn = prev.measure_fn;
+  ctx->measure_data = prev.measure_data;
+}
+
+void wrap_feed( wrap_ctx_t *ctx, char const *s, size_t len ) {
+  wrap_give( ctx, s, len );
+  if ( len == 0 || ctx->is_wrap_end )
+    return;
+  ctx->feed_end = ctx->feed_len;
+  wrap_process( ctx );
+}
+
+void wrap_finish( wrap_ctx_t *ctx ) {
+  assert( ctx != NULL );
+  assert( ctx->fin == NULL );
+  ctx->is_input_end = true;
+  ctx->feed_end = ctx->feed_len;
+  if ( !ctx->is_wrap_end )
+    wrap_process( ctx );
+  writer_flush( &ctx->wout );
+}
+
+void wrap_give( wrap_ctx_t *ctx, char const *s, size_t len ) {
+  assert( ctx != NULL );
+  assert( ctx->fin == NULL );
+  assert( !ctx->is_input_end );
+  assert( s != NULL || len == 0 );
+
+  if ( len == 0 )
+    return;
+  if ( ctx->is_wrap_end ) {
+    writer_write( &ctx->wout, s, len );
+    return;
+  }
+
+  if ( ctx->feed_pos > 0 ) {
+    //
+    // Discard the input that's already been read so feed_buf never holds more
+    // than an incomplete line plus what's being given now.
+    //
+    ctx->feed_len -= ctx->feed_pos;
+    memmove(
+      ctx->feed_buf.str, ctx->feed_buf.str + ctx->feed_pos, ctx->feed_len
+    );
+    ctx->feed_scan = ctx->feed_scan > ctx->feed_pos ?
+      ctx->feed_scan - ctx->feed_pos : 0;
+    ctx->feed_pos = 0;
+  }
+  line_buf_reserve( &ctx->feed_buf, ctx->feed_len + len );
+  memcpy( ctx->feed_buf.str + ctx->feed_len, s, len );
+  ctx->feed_len += len;
+}
+
+void wrap_init( void ) {
+  ASSERT_RUN_ONCE();
+  ATEXIT( wrap_cleanup );
+
+  engine_init();
+
+  //
+  // Characters are classified by built-in tables, so a UTF-8 locale is needed
+  // only by the C library's regular expressions and by towlower(3) for
+  // hyphenation.
+  //
+  startup_charge( STARTUP_INIT );
+#ifndef WITH_PCRE2
+  if ( opt_block_regex != NULL )
+    setlocale_utf8();
+#endif /* WITH_PCRE2 */
+  if ( opt_hyphenate != NULL )
+    setlocale_utf8();
+  startup_charge( STARTUP_LOCALE );
+
+  //
+  // The characters that, when they follow a non-whitespace character in a
+  // word, would only be appended to output_buf one at a time by the main loop
+  // without changing any other state: printable ASCII characters that are
+  // neither whitespace, hyphens, end-of-sentence, nor end-of-sentence-extender
+  // characters.  When breaking per Unicode, they must also be ones between
+  // which there are no break opportunities.
+  //
+  cp_props_t const NOT_WORD = CP_PROP_CONTROL | CP_PROP_EOS | CP_PROP_EOS_EXT |
+                              CP_PROP_HYPHEN | CP_PROP_SPACE;
+  bool ascii_word_chars[ 256 ] = { false };
+  for ( char32_t cp = 0x21; cp < 0x7F; ++cp ) {
+    ascii_word_chars[ cp ] = (cp_props( cp ) & NOT_WORD) == 0 &&
+      (!opt_unicode_breaks || cp_lb( cp ) == CP_LB_AL ||
+        cp_lb( cp ) == CP_LB_NU);
+  } // for
+  if ( wrap_engine >= WRAP_ENGINE_SPAN )
+    simd_span_init( ascii_word_chars );
+
+  //
+  // Initialize the tables that would otherwise be initialized when first used
+  // so that any number of contexts in any number of threads only ever read
+  // them.
+  //
+  dox_init();
+  huge_init();
+  md_init();
+  simd_init();
+
+  if ( opt_in_place )
+    in_place_fork();                    // returns only in a child
+  if ( opt_line_width == LINE_WIDTH_AUTO ) {
+    //
+    // Estimate the width from only the input that's already buffered so it's
+    // neither read twice nor read ahead of time.
+    //
+    size_t size;
+    char const *const s = reader_buffered( stdin, &size );
+    opt_line_width = wrap_width_estimate(
+      s, size < WIDTH_AUTO_SIZE_MAX ? size : WIDTH_AUTO_SIZE_MAX
+    );
+    if ( opt_line_width == 0 )
+      opt_line_width = LINE_WIDTH_DEFAULT;
+  }
+  stdout_preallocate();
+  //
+  // Diff line numbers would span chunks and statistics would be split among
+  // the jobs, so neither is done in parallel.
+  //
+  if ( opt_jobs != 1 && !opt_diff && !opt_stats &&
+       wrap_engine > WRAP_ENGINE_REFERENCE ) {
+    para_fork();                        // returns in a child or if serial
+  }
+
+  abbrev_init( opt_abbreviations );
+  if ( opt_hyphenate != NULL )
+    hyphenate_init( opt_hyphenate );
+  if ( opt_no_break != NULL )
+    nobreak_init( opt_no_break );
+}
+
+void wrap_preset( void ) {
+  char const *const cache_mb = getenv( "WRAP_SERVER_CACHE" );
+  para_cache_shm_init(
+    cache_mb == NULL || *cache_mb == '\0' ?
+      PARA_CACHE_SHM_SIZE_DEFAULT :
+      STATIC_CAST( size_t, check_atou( cache_mb ) ) * 1024 * 1024
+  );
+  if ( read_conf( /*conf_file=*/NULL ) == NULL )
+    return;
+  size_t n_aliases;
+  alias_t const *const aliases = alias_list( &n_aliases );
+  for ( size_t i = 0; i < n_aliases; ++i ) {
+    char const *const block_regex = options_alias_block_regex( &aliases[i] );
+    if ( block_regex != NULL ) {
+      char *temp;
+      regex_preset( block_regex_anchor( block_regex, &temp ) );
+      FREE( temp );
+    }
+  } // for
+  //
+  // Each request reads its own configuration file.
+  //
+  alias_cleanup();
+  pattern_cleanup();
+}
+
+void wrap_run( void ) {
+  wrap_ctx_t *const ctx = &stdin_ctx;
+  stdin_start_ns = now_ns();
+  ctx_init( ctx );
+  writer_init( &ctx->wout, stdout );
+  ctx->wout.count_lines = opt_stats;
+  writer_limit_lines( &ctx->wout, opt_max_lines );
+  if ( opt_expand_tabs )
+    writer_expand_tabs( &ctx->wout );
+  writer_async( &ctx->wout );
+  stdin_run( ctx );
+}
+
+void wrap_run_wipc( int from_fd, int to_fd ) {
+  wrap_ctx_t *const ctx = &stdin_ctx;
+  stdin_start_ns = now_ns();
+  ctx_init( ctx );
+  wipc_in_init( &stdin_wipc_in, from_fd );
+  wipc_out_init( &stdin_wipc_out, &ctx->wout, STDOUT_FILENO, to_fd );
+  ctx->wout.count_lines = opt_stats;
+  ctx->wipc_in = &stdin_wipc_in;
+  ctx->wipc_out = &stdin_wipc_out;
+  stdin_run( ctx );
+}
+
+void wrap_stats_print( void ) {
+  static char const *const MD_LINE_NAME[] = {
+    "none", "code", "dl", "footnote_def", "header_atx", "header_line", "hr",
+    "html_abbr", "html_block", "link_label", "ol", "table", "text", "ul"
+  };
+  static_assert(
+    ARRAY_SIZE( MD_LINE_NAME ) == sizeof MD_LINE_TYPES - 1,
+    "MD_LINE_NAME must have a name for every MD_LINE_TYPES"
+  );
+
+  wrap_ctx_t *const ctx = &stdin_ctx;
+  if ( ctx->wout.buf == NULL )          // never started
+    return;
+  writer_flush( &ctx->wout );
+  stats_mem( ctx );
+  if ( stdin_sub_ctx != NULL )          // exit() left it on the stack
+    stats_add( &ctx->stats, &stdin_sub_ctx->stats );
+  wrap_stats_t const *const s = &ctx->stats;
+
+  EPRINTF(
+    "%s: stats: engine=%s isa=%s wall=%.6f"
+    " bytes_in=%" PRIu64 " bytes_out=%zu"
+    " lines_in=%" PRIu64 " lines_out=%" PRIu64
+    " paragraphs=%" PRIu64
+    " wraps_space=%" PRIu64 " wraps_hyphen=%" PRIu64
+    " long_lines=%" PRIu64,
+    me, WRAP_ENGINE_NAMES[ wrap_engine ], simd_isa_name( simd_isa() ),
+    STATIC_CAST( double, now_ns() - stdin_start_ns ) / 1e9,
+    s->bytes_in, ctx->wout.written,
+    s->lines_in, ctx->wout.lines,
+    s->paragraphs,
+    s->wraps_space, s->wraps_hyphen,
+    s->long_lines
+  );
+  if ( opt_block_regex != NULL ) {
+    EPRINTF(
+      " block_regex.calls=%" PRIu64 " block_regex.hits=%" PRIu64
+      " block_regex.secs=%.6f",
+      s->block_regex_calls, s->block_regex_hits,
+      STATIC_CAST( double, s->block_regex_ns ) / 1e9
+    );
+  }
+  if ( ctx->nonws_no_wrap_enabled ) {
+    EPRINTF(
+      " uri_regex.calls=%" PRIu64 " uri_regex.hits=%" PRIu64
+      " uri_regex.secs=%.6f",
+      s->uri_regex_calls, s->uri_regex_hits,
+      STATIC_CAST( double, s->uri_regex_ns ) / 1e9
+    );
+  }
+  if ( opt_markdown ) {
+    for ( size_t i = 0; i < ARRAY_SIZE( MD_LINE_NAME ); ++i ) {
+      if ( s->md_lines[i] > 0 )
+        EPRINTF( " md.%s=%" PRIu64, MD_LINE_NAME[i], s->md_lines[i] );
+    } // for
+    EPRINTF( " md.secs=%.6f", STATIC_CAST( double, s->md_ns ) / 1e9 );
+  }
+  if ( s->ipc > 0 ) {
+    EPRINTF(
+      " ipc=%" PRIu64 " ipc.secs=%.6f",
+      s->ipc, STATIC_CAST( double, s->ipc_ns ) / 1e9
+    );
+  }
+  if ( opt_para_cache != NULL ) {
+    para_cache_stats_t const c = para_cache_stats();
+    EPRINTF(
+      " para_cache.hits=%" PRIu64 " para_cache.misses=%" PRIu64
+      " para_cache.evictions=%" PRIu64,
+      c.hits, c.misses, c.evictions
+    );
+  }
+
+  //
+  // Memory shared by all contexts is allocated up front and only grows, so
+  // what it is now is its peak.
+  //
+  size_t const shared_input = reader_mem();
+  size_t const shared_regex = regex_presets_mem();
+  size_t const tables = alias_mem() + pattern_mem();
+  size_t const caches = conf_cache_mem() + para_cache_mem();
+  EPRINTF(
+    " mem.input=%" PRIu64 " mem.output=%" PRIu64 " mem.regex=%" PRIu64
+    " mem.markdown=%" PRIu64 " mem.tables=%zu mem.caches=%zu"
+    " mem.peak=%" PRIu64 " peak_rss_kb=%zu",
+    s->mem_input + shared_input, s->mem_output, s->mem_regex + shared_regex,
+    s->mem_markdown, tables, caches,
+    s->mem_total + shared_input + shared_regex + tables + caches,
+    peak_rss_kb( RUSAGE_SELF )
+  );
+  EPUTC( '\n' );
+
+  for ( size_t i = 0; i < stats_paras_len; ++i ) {
+    para_cost_t const *const p = &stats_paras[i];
+    EPRINTF(
+      "%s: stats: para=%zu secs=%.6f offset=%" PRIu64
+      " lines=%" PRIu64 "-%" PRIu64 " bytes=%" PRIu64
+      " regex.calls=%" PRIu64,
+      me, i + 1, STATIC_CAST( double, p->ns ) / 1e9, p->offset,
+      p->line_first, p->line_last, p->bytes,
+      p->regex_calls
+    );
+    if ( opt_markdown ) {
+      EPRINTF( " md.type=%s md.depth=%zu",
+        MD_LINE_NAME[
+          strchr( MD_LINE_TYPES, STATIC_CAST( char, p->md_line_type ) ) -
+          MD_LINE_TYPES
+        ],
+        p->md_depth
+      );
+    }
+    EPUTC( '\n' );
+  } // for
+  FREE( stats_paras );
+}
+
+wrap_step_t wrap_step( wrap_ctx_t *ctx, size_t budget ) {
+  assert( ctx != NULL );
+  assert( ctx->fin == NULL );
+  assert( !ctx->is_input_end );
+
+  size_t const rem = ctx->feed_len - ctx->feed_pos;
+  if ( rem == 0 )
+    return WRAP_STEP_NEED_INPUT;
+  if ( ctx->is_wrap_end ) {             // pass the rest through verbatim
+    writer_write( &ctx->wout, ctx->feed_buf.str + ctx->feed_pos, rem );
+    ctx->feed_pos = ctx->feed_end = ctx->feed_len;
+    return WRAP_STEP_NEED_INPUT;
+  }
+
+  size_t const pos = ctx->feed_pos;
+  size_t from = budget < rem ?
+    pos + (budget > 0 ? budget - 1 : 0) : ctx->feed_len;
+  for (;;) {
+    ctx->feed_end = ctx->feed_len;
+    if ( from < ctx->feed_len ) {
+      char const *const nl = memchr(
+        ctx->feed_buf.str + from, '\n', ctx->feed_len - from
+      );
+      if ( nl != NULL )
+        ctx->feed_end = STATIC_CAST( size_t, nl - ctx->feed_buf.str ) + 1;
+    }
+    wrap_process( ctx );
+    if ( ctx->feed_pos != pos || ctx->feed_end == ctx->feed_len ||
+         ctx->is_wrap_end ) {
+      break;
+    }
+    //
+    // Nothing was reformatted because a line needs those after it (e.g., to
+    // know whether a Doxygen command continues) and was put back: include the
+    // next line too.
+    //
+    from = ctx->feed_end;
+  } // for
+
+  writer_spill( &ctx->wout );
+  return ctx->feed_end < ctx->feed_len && !ctx->is_wrap_end ?
+    WRAP_STEP_AGAIN : WRAP_STEP_NEED_INPUT;
+}
+
+size_t wrap_width_estimate( char const *s, size_t size ) {
+  assert( s != NULL || size == 0 );
+  size_t lens[ WIDTH_AUTO_LEN_MAX + 1 ] = { 0 };
+  size_t lines = 0;
+  size_t prev_len = 0;                  // width of previous line, if any
+
+  for ( char const *line = s, *const end = s + size; line < end; ) {
+    char const *const nl =
+      memchr( line, '\n', STATIC_CAST( size_t, end - line ) );
+    if ( nl == NULL )                   // possibly incomplete last line
+      break;
+    size_t line_len = STATIC_CAST( size_t, nl - line );
+    if ( line_len > 0 && line[ line_len - 1 ] == '\r' )
+      --line_len;
+    size_t const len =
+      str_cols( line, line_len - simd_ws_rspan( line, line_len ), 0 );
+    //
+    // Only a line followed by another line of the same paragraph was wrapped:
+    // the last line of a paragraph is typically shorter.
+    //
+    if ( len > 0 && prev_len > 0 && prev_len <= WIDTH_AUTO_LEN_MAX ) {
+      ++lens[ prev_len ];
+      ++lines;
+    }
+    prev_len = len;
+    line = nl + 1;
+  } // for
+
+  if ( lines < WIDTH_AUTO_LINES_MIN )
+    return 0;
+  //
+  // The longest wrapped line is one column narrower than the line width since
+  // a line is wrapped before reaching it.
+  //
+  size_t window = 0;                    // lines within the window
+  size_t width = 0;
+  for ( size_t len = 1; len <= WIDTH_AUTO_LEN_MAX; ++len ) {
+    window += lens[ len ];
+    if ( lens[ len ] * WIDTH_AUTO_LEN_RATIO >= lines &&
+         window * WIDTH_AUTO_WINDOW_RATIO >= lines ) {
+      width = len + 1;
+    }
+    if ( len >= WIDTH_AUTO_WINDOW )
+      window -= lens[ len - WIDTH_AUTO_WINDOW + 1 ];
+  } // for
+  return width;
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Anchors a block regular expression to the beginning of a line.
+ *
+ * @param block_regex The block regular expression.
+ * @param ptemp A pointer to receive either a pointer to memory that must be
+ * freed or NULL.
+ * @return Returns either \a block_regex if it already begins with `^` or a
+ * copy of it that does.
+ */
+static char const* block_regex_anchor( char const *block_regex,
+                                       char **ptemp ) {
+  assert( block_regex != NULL );
+  assert( ptemp != NULL );
+  *ptemp = NULL;
+  if ( block_regex[0] == '^' )
+    return block_regex;
+  *ptemp = MALLOC( char, strlen( block_regex ) + 1/*^*/ + 1/*\0*/ );
+  (*ptemp)[0] = '^';
+  strcpy( *ptemp + 1, block_regex );
+  return *ptemp;
+}
+
+/**
+ * Gets the next character from the input.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param ppc A pointer to the pointer to character to advance.
+ * @return Returns said character as an `unsigned char` (so the byte 0xFF
+ * isn't mistaken for \c EOF) or \c EOF.
+ */
+NODISCARD
+static int buf_getc( wrap_ctx_t *ctx, char const **ppc ) {
+  assert( ppc != NULL );
+  assert( *ppc != NULL );
+
+  while ( **ppc == '\0' ) {
+    if ( unlikely( buf_readline( ctx ) == 0 ) ) {
+      *ppc = "";                        // so the next call reads a line
+      return EOF;
+    }
+    //
+    // When wrapping Markdown, we have to strip leading whitespace from lines
+    // since it interferes with indenting (unless it's the line after one
+    // ignored for starting with a '.' that the main loop would have read).
+    //
+    *ppc = opt_markdown && !true_clear( &ctx->keep_lead_ws ) ?
+      ctx->input_desc.ws_end : ctx->input_buf.str;
+    if ( !opt_markdown || **ppc != '\0' )
+      break;
+  } // while
+
+  if ( ctx->nonws_no_wrap_enabled && ctx->nonws_no_wrap_check ) {
+    size_t const pos = STATIC_CAST( size_t, *ppc - ctx->input_buf.str );
+    //
+    // If there was a previous non-whitespace-no-wrap range and we're past it,
+    // advance to the next one on the same line, if any.
+    //
+    if ( pos >= ctx->nonws_no_wrap_range[1] ) {
+      size_t const *next;
+      do {
+        if ( ctx->nonws_no_wrap_next == ctx->nonws_no_wrap_ranges.len ) {
+          ctx->nonws_no_wrap_check = false;
+          break;
+        }
+        next = ctx->nonws_no_wrap_ranges.range[ ctx->nonws_no_wrap_next++ ];
+      } while ( next[1] <= pos );
+      if ( ctx->nonws_no_wrap_check ) {
+        ctx->nonws_no_wrap_range[0] = next[0];
+        ctx->nonws_no_wrap_range[1] = next[1];
+      }
+    }
+  }
+
+  return STATIC_CAST( unsigned char, *(*ppc)++ );
+}
+
+/**
+ * Gets bytes comprising the next UTF-8 character and its corresponding Unicode
+ * code-point from the input.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param ppc A pointer to the pointer to character to advance.
+ * @param utf8c The buffer to put the UTF-8 bytes into.
+ * @return Returns said code-point or \c CP_EOF.
+ */
+NODISCARD
+static char32_t buf_getcp( wrap_ctx_t *ctx, char const **ppc, utf8c_t utf8c ) {
+  int c;
+  if ( unlikely( (c = buf_getc( ctx, ppc )) == EOF ) )
+    return CP_EOF;
+  if ( ctx->input_utf8 == SIMD_UTF8_ASCII ) {
+    utf8c[0] = STATIC_CAST( char, c );
+    return STATIC_CAST( char32_t, c );
+  }
+  size_t const len = utf8_len( STATIC_CAST( char, c ) );
+  if ( unlikely( len == 0 ) )
+    return CP_INVALID;
+  utf8c[0] = STATIC_CAST( char, c );
+  if ( ctx->input_utf8 == SIMD_UTF8_VALID ) {
+    //
+    // The whole line has already been validated, so the rest of the bytes of
+    // the character are known to be there and be continuation bytes.
+    //
+    memcpy( utf8c + 1, *ppc, len - 1 );
+    *ppc += len - 1;
+    return utf8_decode( utf8c );
+  }
+  for ( size_t i = 1; i < len; ++i ) {
+    if ( unlikely( (c = buf_getc( ctx, ppc )) == EOF ) )
+      return CP_EOF;
+    if ( unlikely( !utf8_is_cont( STATIC_CAST( char, c ) ) ) )
+      return CP_INVALID;
+    utf8c[i] = STATIC_CAST( char, c );
+  } // for
+
+  return utf8_decode( utf8c );
+}
+
+/**
+ * Reads the next line of input.  If wrapping Markdown, adjust wrap's settings;
+ * otherwise, reads a long line in chunks of at most #LINE_CHUNK_SIZE_MAX
+ * characters so memory use is bounded.  Either way, also sets
+ * \ref wrap_ctx::input_utf8 so buf_getcp() only has to check characters of
+ * lines that aren't valid and finds all of the line's
+ * \ref wrap_ctx::nonws_no_wrap_ranges.
+ *
+ * IPC lines and lines while \ref wrap_ctx::is_preformatted is `true` are
+ * handled here, once per line, so the per-character main loop never has to
+ * check for them.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns the number of bytes read or 0 if either there's no more
+ * input or the rest is to be passed through verbatim.
+ */
+NODISCARD
+static size_t buf_readline( wrap_ctx_t *ctx ) {
+  if ( unlikely( ctx->is_wrap_end ) )
+    return 0;
+
+  //
+  // Structured text is classified a whole line at a time.
+  //
+  size_t const size_max = ctx->block_fn != NULL ?
+    SIZE_MAX : LINE_CHUNK_SIZE_MAX;
+  size_t bytes_read;
+
+  while ( (bytes_read = input_readline( ctx, size_max )) > 0 ) {
+    //
+    // Don't pass either IPC lines or any lines while is_preformatted is true
+    // through either the Doxygen or Markdown parser.
+    //
+    if ( unlikely( ctx->is_ipc_line ) ) {
+      put_md_table( ctx );
+      uint64_t const start = stats_now();
+      wipc_parse( ctx, ctx->input_buf.str + 1 );
+      stats_charge( &ctx->stats.ipc_ns, start );
+      ++ctx->stats.ipc;
+      if ( ctx->is_wrap_end )
+        return 0;
+      continue;
+    }
+    stats_para_start( ctx );
+    ctx->stats.bytes_in += bytes_read;
+    ++ctx->stats.lines_in;
+    if ( unlikely( opt_stats ) )
+      stats_mem( ctx );
+    PROBE1( line_read, bytes_read );
+    if ( unlikely( ctx->is_preformatted ) ) {
+      put_md_table( ctx );
+      writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+      continue;
+    }
+
+    //
+    // Lines of structured text that are never wrapped (Markdown code, lines
+    // that Doxygen commands say aren't, etc.) are printed as-is in their
+    // entirety by block_fn that then returns false, so they never get to
+    // buf_getcp() and the per-character main loop.
+    //
+    if ( ctx->block_fn == NULL || (*ctx->block_fn)( ctx ) )
+      break;
+  } // while
+  if ( bytes_read == 0 && !ctx->is_input_end )
+    return 0;                           // more input may yet be given
+
+  //
+  // The end of input (like an IPC or preformatted line) also ends a table.
+  //
+  put_md_table( ctx );
+
+#ifdef DEBUG_MARKDOWN
+  if ( bytes_read == 0 )
+    MD_DEBUG( "====================\n" );
+#endif /* DEBUG_MARKDOWN */
+  ctx->input_utf8 = wrap_engine == WRAP_ENGINE_REFERENCE ? SIMD_UTF8_INVALID :
+    simd_utf8_check( ctx->input_buf.str, bytes_read );
+  if ( ctx->nonws_no_wrap_enabled ) {
+    regex_words_reset( &ctx->nonws_no_wrap_words );
+    uint64_t const start = stats_now();
+    if ( opt_markdown || opt_markup == MARKUP_HTML ||
+         opt_markup == MARKUP_ROFF ) {
+      markdown_no_wrap_find( ctx );
+    } else {
+      regex_wrap_re_match_all(
+        ctx->input_buf.str, &ctx->nonws_no_wrap_words,
+        &ctx->nonws_no_wrap_ranges
+      );
+      ctx->stats.uri_regex_hits += ctx->nonws_no_wrap_ranges.len;
+    }
+    if ( opt_no_break != NULL )
+      nobreak_find( ctx->input_buf.str, &ctx->nonws_no_wrap_ranges );
+    stats_charge( &ctx->stats.uri_regex_ns, start );
+    ++ctx->stats.uri_regex_calls;
+    PROBE2( regex, 'u', ctx->nonws_no_wrap_ranges.len > 0 );
+    ctx->nonws_no_wrap_check = ctx->nonws_no_wrap_ranges.len > 0;
+    ctx->nonws_no_wrap_next = 0;
+    ctx->nonws_no_wrap_range[0] = ctx->nonws_no_wrap_range[1] = 0;
+  }
+  ctx->hyph_valid = false;
+  return bytes_read;
+}
+
+/**
+ * Checks whether the options are such that check_is_wrapped() can tell that a
+ * paragraph is already formatted without reformatting it.
+ *
+ * @param eol The end-of-lines the output uses.
+ * @return Returns `true` only if it can.
+ */
+static bool check_can_scan( eol_t eol ) {
+  return  wrap_engine > WRAP_ENGINE_REFERENCE &&
+          para_is_independent() && eol == EOL_UNIX &&
+          opt_block_regex == NULL && !opt_eos_delimit &&
+          opt_hang_spaces == 0 && opt_hang_tabs == 0 &&
+          opt_hyphenate == NULL && opt_indt_spaces == 0 &&
+          opt_indt_tabs == 0 && !opt_justify && !opt_lead_dot_ignore &&
+          opt_lead_spaces == 0 && opt_lead_string == NULL &&
+          opt_lead_tabs == 0 && !opt_lead_ws_delimit &&
+          opt_mirror_spaces == 0 && opt_mirror_tabs == 0 &&
+          opt_newlines_delimit == 2 && opt_no_break == NULL &&
+          opt_optimal == 0 && opt_para_delims == NULL && !opt_title_line &&
+          !opt_unicode_breaks;
+}
+
+/**
+ * Checks, by only scanning it, whether a chunk of text (as split by
+ * para_boundary()) is already formatted: that it's a single paragraph of
+ * printable ASCII having every line shorter than the line width, no spaces but
+ * those that would be kept, and no line whose next line's first word (or, if
+ * it contains a hyphen, the part of it through the first hyphen) would fit at
+ * its end, followed by a blank line.
+ *
+ * @param s The text to check.
+ * @param size The length of \a s.
+ * @return Returns `true` only if reformatting \a s definitely produces \a s
+ * exactly; `false` if it can't be told without reformatting.
+ *
+ * @sa check_can_scan()
+ */
+static bool check_is_wrapped( char const *s, size_t size ) {
+  assert( s != NULL );
+  if ( size < 2 || s[ size - 1 ] != '\n' || s[ size - 2 ] != '\n' )
+    return false;
+
+  size_t const line_width = opt_line_width;
+  size_t join_width = 0;                // width to join previous line, if any
+
+  for ( char const *line = s, *const end = s + size; line < end; ) {
+    char const *const nl =
+      memchr( line, '\n', STATIC_CAST( size_t, end - line ) );
+    size_t const len = STATIC_CAST( size_t, nl - line );
+    if ( len == 0 )                     // the blank line at the end
+      return join_width > 0 && nl + 1 == end;
+    if ( len >= line_width || line[0] == ' ' || line[ len - 1 ] == ' ' )
+      return false;
+
+    bool is_eos = false;
+    size_t first_len = 0;               // length of first word or part
+    size_t spaces = 0;
+    for ( size_t i = 0; i < len; ++i ) {
+      char const c = line[i];
+      if ( c == ' ' ) {
+        if ( ++spaces > (is_eos ? opt_eos_spaces : 1) )
+          return false;
+        if ( first_len == 0 )
+          first_len = i;
+        continue;
+      }
+      if ( !cp_is_ascii( STATIC_CAST( char8_t, c ) ) || !isgraph( c ) )
+        return false;
+      cp_props_t const props = cp_props( STATIC_CAST( char8_t, c ) );
+      if ( (props & CP_PROP_HYPHEN) != 0 ) {
+        if ( i + 1 == len || line[ i + 1 ] == ' ' )
+          return false;                 // might be rejoined or respaced
+        if ( first_len == 0 )
+          first_len = i + 1;
+      }
+      if ( (props & CP_PROP_EOS) != 0 )
+        is_eos = c != '.' || !abbrev_ends( line, i );
+      else
+        is_eos = is_eos && (props & CP_PROP_EOS_EXT) != 0;
+      spaces = 0;
+    } // for
+    if ( first_len == 0 )
+      first_len = len;
+
+    if ( join_width > 0 && join_width + first_len < line_width )
+      return false;                     // would be joined to previous line
+    join_width = len + (is_eos ? opt_eos_spaces : 1);
+    line = nl + 1;
+  } // for
+
+  return false;
+}
+
+/**
+ * The \ref writer_fn_t that compares output to the input being checked: if
+ * it differs, exits with #CHECK_EX_UNFORMATTED.
+ *
+ * @param s The output.
+ * @param len The length of \a s.
+ * @param data A pointer to the \ref check_in.
+ */
+static void check_write( char const *s, size_t len, void *data ) {
+  check_in_t *const in = data;
+  if ( len > in->size - in->pos ||
+       (s != in->s + in->pos && memcmp( s, in->s + in->pos, len ) != 0) ) {
+    exit( CHECK_EX_UNFORMATTED );
+  }
+  in->pos += len;
+}
+
+/**
+ * Initializes \a ctx per the current options except for its input and output.
+ *
+ * @param ctx The \ref wrap_ctx to initialize.
+ */
+static void ctx_init( wrap_ctx_t *ctx ) {
+  assert( ctx != NULL );
+  ctx_start( ctx );
+
+  line_buf_init( &ctx->input_buf );
+  line_buf_init( &ctx->ipc_buf );
+  line_buf_init( &ctx->lead_buf );
+  line_buf_init( &ctx->output_buf );
+  line_buf_init( &ctx->proto_buf );
+  line_buf_init( &ctx->proto_tws );
+
+  if ( opt_block_regex != NULL ) {
+    char *temp;
+    char const *const block_regex =
+      block_regex_anchor( opt_block_regex, &temp );
+    startup_charge( STARTUP_INIT );
+    int const regex_err_code =
+      regex_compile( &ctx->block_regex, block_regex );
+    startup_charge( STARTUP_REGEX );
+    profile_mark( PROFILE_REGEX );
+    if ( regex_err_code != 0 ) {
+      char err_buf[ REGEX_ERROR_SIZE ];
+      fatal_error( EX_USAGE,
+        "\"%s\": regular expression error (%d): %s\n",
+        block_regex, regex_err_code,
+        regex_error( &ctx->block_regex, regex_err_code, err_buf )
+      );
+    }
+    FREE( temp );
+  }
+}
+
+/**
+ * Sets all of the state of \a ctx per the current options, but allocates
+ * nothing but what the parsers need.
+ *
+ * @param ctx The \ref wrap_ctx to start.
+ *
+ * @sa ctx_init()
+ * @sa wrap_ctx_reset()
+ */
+static void ctx_start( wrap_ctx_t *ctx ) {
+  assert( ctx != NULL );
+
+  *ctx = (wrap_ctx_t){
+    .opt = {
+      .eol = opt_eol,
+      .eos_spaces = opt_eos_spaces,
+      .hang_spaces = opt_hang_spaces,
+      .hang_tabs = opt_hang_tabs,
+      .indt_spaces = opt_indt_spaces,
+      .indt_tabs = opt_indt_tabs,
+      //
+      // Markdown adjusts the line width line by line, so lines must be wrapped
+      // as they're read and not justified.  (The options are mutually
+      // exclusive on the command-line, but any may come from a configuration
+      // file.)
+      //
+      .justify = opt_justify && !opt_markdown,
+      .lead_spaces = opt_lead_spaces,
+      .lead_tabs = opt_lead_tabs,
+      .line_width = opt_line_width,
+      .newlines_delimit = opt_newlines_delimit,
+      .optimal = opt_markdown ? 0 : opt_optimal,
+      .tab_spaces = opt_markdown ? MD_TAB_SPACES : opt_tab_spaces,
+    },
+    .cp_prev = '\n',
+    .gcb_state = CP_GCB_STATE_INIT,
+    .lb_prev = CP_LB_SP,
+    .next_line_is_title = opt_title_line,
+    .indent = INDENT_LINE,
+    .md_prev_seq_num = MD_SEQ_NUM_INIT,
+    //
+    // URLs and e-mail addresses mustn't be wrapped within either at hyphens
+    // or, when breaking per Unicode, at, say, a '/'.
+    //
+    .nonws_no_wrap_enabled = !opt_no_hyphen || opt_unicode_breaks ||
+                             opt_markup == MARKUP_HTML ||
+                             opt_markup == MARKUP_ROFF,
+  };
+
+  if ( opt_para_delims != NULL ) {
+    for ( char const *s = opt_para_delims; *s != '\0'; ++s ) {
+      char32_t const cp = STATIC_CAST( char8_t, *s );
+      if ( cp_is_ascii( cp ) )
+        ctx->para_delims[ cp >> 6 ] |= UINT64_C(1) << (cp & 63);
+    } // for
+  }
+
+  //
+  // In roff, a newline in text is a space, so a word wrapped at a hyphen (or
+  // hyphenated) would be printed as two.
+  //
+  bool const is_roff = opt_markup == MARKUP_ROFF;
+
+  ctx->features =
+    (opt_block_regex != NULL                  ? WRAP_FEAT_BLOCK_REGEX     : 0) |
+    (opt_eos_delimit                          ? WRAP_FEAT_EOS_DELIMIT     : 0) |
+    (opt_markup == MARKUP_HTML || opt_markup == MARKUP_ROFF ?
+                                                WRAP_FEAT_GLUE_SPACES     : 0) |
+    (!opt_no_hyphen && !is_roff               ? WRAP_FEAT_HYPHEN          : 0) |
+    (opt_hyphenate != NULL && !is_roff        ? WRAP_FEAT_HYPHENATE       : 0) |
+    (opt_lead_dot_ignore                      ? WRAP_FEAT_LEAD_DOT_IGNORE : 0) |
+    (opt_lead_ws_delimit                      ? WRAP_FEAT_LEAD_WS_DELIMIT : 0) |
+    (opt_markdown                             ? WRAP_FEAT_MARKDOWN        : 0) |
+    (ctx->opt.optimal > 0                     ? WRAP_FEAT_OPTIMAL         : 0) |
+    ((ctx->para_delims[0] | ctx->para_delims[1]) != 0 ?
+                                                WRAP_FEAT_PARA_DELIMS     : 0) |
+    (opt_unicode_breaks                       ? WRAP_FEAT_UNICODE_BREAKS  : 0);
+
+  //
+  // At most one line classifier is called per line.  To add a kind of
+  // structured text, write a wrap_block_fn_t for it (and for each kind it may
+  // be combined with) and select it here.
+  //
+  ctx->block_fn = opt_markdown ?
+    (opt_doxygen ? &doxygen_markdown_adjust : &markdown_line_adjust) :
+    opt_doxygen ? &doxygen_adjust :
+    opt_markup != MARKUP_NONE ? &markup_adjust :
+    opt_email_quotes ? &quote_adjust : NULL;
+
+  if ( opt_doxygen )
+    dox_parser_init( &ctx->dox_parser );
+  if ( opt_markup != MARKUP_NONE )
+    markup_parser_init( &ctx->markup_parser, opt_markup );
+  if ( opt_markdown ) {
+    startup_charge( STARTUP_INIT );
+    markdown_init( &ctx->md_parser );
+    startup_charge( STARTUP_MARKDOWN );
+  }
+
+  int const temp_width = STATIC_CAST( int, ctx->opt.line_width ) -
+    STATIC_CAST( int,
+      2 * (opt_mirror_tabs * ctx->opt.tab_spaces + opt_mirror_spaces) +
+      ctx->opt.lead_tabs * ctx->opt.tab_spaces + ctx->opt.lead_spaces
+    );
+
+  if ( temp_width < LINE_WIDTH_MINIMUM ) {
+    fatal_error( EX_USAGE,
+      "line-width (%d) is too small (<%d)\n",
+      temp_width, LINE_WIDTH_MINIMUM
+    );
+  }
+  ctx->opt.line_width = ctx->line_width = STATIC_CAST( size_t, temp_width );
+
+  ctx->opt.lead_tabs   += opt_mirror_tabs;
+  ctx->opt.lead_spaces += opt_mirror_spaces;
+}
+
+/**
+ * Delimits a paragraph.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void delimit_paragraph( wrap_ctx_t *ctx ) {
+  ++ctx->stats.paragraphs;
+  if ( unlikely( ctx->para_ns != 0 ) )
+    stats_para_end( ctx );
+  PROBE( para_delimit );
+  if ( ctx->output_len > 0 && ctx->opt.optimal > 0 && !ctx->is_long_line ) {
+    put_optimal( ctx, ctx->spans.len, ctx->spans.len );
+  } else if ( ctx->output_len > 0 ) {
+    //
+    // Print what's in the buffer before delimiting the paragraph.  If we've
+    // been handling a "long line," it's now finally ended; otherwise, print
+    // the leading characters.
+    //
+    if ( !true_clear( &ctx->is_long_line ) )
+      put_lead_chars( ctx );
+    put_line( ctx, ctx->output_len, /*do_eol=*/true );
+  } else if ( true_clear( &ctx->is_long_line ) ) {
+    put_eol( ctx );                     // delimit the "long line"
+  }
+  measure_para_end( ctx );
+
+  ctx->encountered_nonws = false;
+  ctx->hyphen = HYPHEN_NO;
+  ctx->indent = opt_markdown ? INDENT_NONE : INDENT_LINE;
+  ctx->put_spaces = 0;
+  ctx->was_eos_char = false;
+
+  if ( ctx->consec_newlines == 2 ||
+      (ctx->consec_newlines > 2 && opt_newlines_delimit == 1) ) {
+    put_lead_chars( ctx );
+    put_eol( ctx );
+  }
+}
+
+/**
+ * Writes a hunk of a unified diff for a chunk of input (as split by
+ * para_boundary()) and its reformatted output, if they differ, leaving out
+ * the lines at the beginning and end they have in common.
+ *
+ * @param diff The \ref diff_out to use.
+ * @param in The input.
+ * @param in_len The length of \a in.
+ * @param out The reformatted output of \a in.
+ * @param out_len The length of \a out.
+ */
+static void diff_chunk( diff_out_t *diff, char const *in, size_t in_len,
+                        char const *out, size_t out_len ) {
+  assert( diff != NULL );
+  assert( in != NULL );
+  assert( out != NULL );
+
+  if ( in_len == out_len && memcmp( in, out, in_len ) == 0 ) {
+    size_t const lines = diff_line_count( in, in_len );
+    diff->in_lines += lines;
+    diff->out_lines += lines;
+    return;
+  }
+
+  //
+  // Leave out the lines at the beginning both have in common ...
+  //
+  for (;;) {
+    char const *const nl = memchr( in, '\n', in_len );
+    if ( nl == NULL )
+      break;
+    size_t const len = STATIC_CAST( size_t, nl - in ) + 1;
+    if ( len > out_len || memcmp( in, out, len ) != 0 )
+      break;
+    in += len;
+    in_len -= len;
+    out += len;
+    out_len -= len;
+    ++diff->in_lines;
+    ++diff->out_lines;
+  } // for
+
+  //
+  // ... and at the end.
+  //
+  size_t common_len = 0;
+  while ( common_len < in_len && common_len < out_len ) {
+    size_t const in_end = in_len - common_len;
+    size_t const out_end = out_len - common_len;
+    size_t line = in_end - 1;           // start of last line of input left
+    while ( line > 0 && in[ line - 1 ] != '\n' )
+      --line;
+    size_t const len = in_end - line;
+    if ( len > out_end || memcmp( in + line, out + out_end - len, len ) != 0 ||
+         (len < out_end && out[ out_end - len - 1 ] != '\n') ) {
+      break;
+    }
+    common_len += len;
+  } // while
+  size_t const common_lines =
+    diff_line_count( in + in_len - common_len, common_len );
+  in_len -= common_len;
+  out_len -= common_len;
+
+  if ( !diff->differs ) {
+    char const *const name = opt_fin_path != NULL ? opt_fin_path : "-";
+    writer_printf( diff->w, "--- %s\n+++ %s\n", name, name );
+    diff->differs = true;
+  }
+
+  size_t const in_n = diff_line_count( in, in_len );
+  size_t const out_n = diff_line_count( out, out_len );
+  //
+  // For an empty range, a unified diff gives the line before it.
+  //
+  writer_printf( diff->w, "@@ -%zu,%zu +%zu,%zu @@\n",
+    diff->in_lines + (in_n > 0), in_n,
+    diff->out_lines + (out_n > 0), out_n
+  );
+  diff_put_lines( diff->w, '-', in, in_len );
+  diff_put_lines( diff->w, '+', out, out_len );
+
+  diff->in_lines += in_n + common_lines;
+  diff->out_lines += out_n + common_lines;
+}
+
+/**
+ * Counts the lines of \a s, including a last one not ending in a newline.
+ *
+ * @param s The text to count the lines of.
+ * @param len The length of \a s.
+ * @return Returns said number of lines.
+ */
+static size_t diff_line_count( char const *s, size_t len ) {
+  assert( s != NULL );
+  size_t lines = len > 0 && s[ len - 1 ] != '\n';
+  for ( char const *const end = s + len;
+        (s = memchr( s, '\n', STATIC_CAST( size_t, end - s ) )) != NULL;
+        ++s ) {
+    ++lines;
+  } // for
+  return lines;
+}
+
+/**
+ * Writes lines of a hunk of a unified diff.
+ *
+ * @param w The \ref writer to write to.
+ * @param c The character to prefix each line with, either `-` or `+`.
+ * @param s The lines to write.
+ * @param len The length of \a s.
+ */
+static void diff_put_lines( writer_t *w, char c, char const *s, size_t len ) {
+  assert( w != NULL );
+  assert( s != NULL );
+  for ( char const *const end = s + len; s < end; ) {
+    char const *const nl = memchr( s, '\n', STATIC_CAST( size_t, end - s ) );
+    char const *const next = nl != NULL ? nl + 1 : end;
+    writer_putc( w, c );
+    writer_write( w, s, STATIC_CAST( size_t, next - s ) );
+    if ( nl == NULL )
+      writer_puts( w, "\n\\ No newline at end of file\n" );
+    s = next;
+  } // for
+}
+
+
+/**
+ * Adjusts wrap's handling of the current line per the Doxygen command, if any,
+ * it starts with: delimits the paragraph before a line starting with a
+ * #DOX_BOL command and prints lines that are never wrapped (those starting
+ * with a #DOX_EOL command and preformatted text) as-is "behind wrap's back."
+ * This does natively what **wrapc**(1) would otherwise have to tell wrap to do
+ * via IPC.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the line should be wrapped.
+ */
+static bool doxygen_adjust( wrap_ctx_t *ctx ) {
+  //
+  // When also wrapping Markdown, md_line_desc_init() has already skipped the
+  // line's leading whitespace, so don't skip it again.
+  //
+  dox_line_t const dox_line = opt_markdown ?
+    dox_parse_nws( &ctx->dox_parser, ctx->input_desc.ws_end ) :
+    dox_parse( &ctx->dox_parser, ctx->input_buf.str );
+  if ( dox_line != DOX_LINE_TEXT )
+    put_md_table( ctx );
+
+  if ( true_clear( &ctx->dox_pre_pending ) ) {
+    //
+    // The previous line started with a DOX_PRE command: flush it before the
+    // preformatted text.
+    //
+    delimit_paragraph( ctx );
+  }
+
+  switch ( dox_line ) {
+    case DOX_LINE_TEXT:
+      break;
+    case DOX_LINE_BOL:
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      break;
+    case DOX_LINE_PRE_BEGIN:
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      ctx->dox_pre_pending = true;
+      break;
+    case DOX_LINE_EOL:
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      FALLTHROUGH;
+    case DOX_LINE_PRE_END:
+      writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+      ctx->consec_newlines = 1;
+      delimit_paragraph( ctx );
+      return false;
+    case DOX_LINE_PRE:
+      writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+      doxygen_put_pre( ctx );
+      return false;
+  } // switch
+
+  return true;
+}
+
+/**
+ * The \ref wrap_block_fn_t for Doxygen within Markdown: a line that Doxygen
+ * commands say is never wrapped isn't parsed as Markdown.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the line should be wrapped.
+ */
+NODISCARD
+static bool doxygen_markdown_adjust( wrap_ctx_t *ctx ) {
+  md_line_desc_init( &ctx->input_desc, ctx->input_buf.str );
+  return doxygen_adjust( ctx ) && markdown_adjust( ctx );
+}
+
+/**
+ * Sets the engine to use from the `WRAP_ENGINE` environment variable.  If
+ * unset or `auto`, it's the fastest engine since `test/equiv_check.sh` checks
+ * that every engine produces the same output as the reference engine.
+ */
+static void engine_init( void ) {
+  char const *const name = getenv( "WRAP_ENGINE" );
+  wrap_engine = WRAP_ENGINE_SIMD;
+  if ( name != NULL && name[0] != '\0' && strcmp( name, "auto" ) != 0 ) {
+    for ( size_t i = 0; ; ++i ) {
+      if ( i == ARRAY_SIZE( WRAP_ENGINE_NAMES ) ) {
+        fatal_error( EX_USAGE,
+          "\"%s\": invalid value for WRAP_ENGINE;\n\tmust be one of:"
+          " auto, reference, fast, span, or simd\n", name
+        );
+      }
+      if ( strcmp( name, WRAP_ENGINE_NAMES[i] ) == 0 ) {
+        wrap_engine = STATIC_CAST( wrap_engine_t, i );
+        break;
+      }
+    } // for
+  }
+  if ( wrap_engine < WRAP_ENGINE_SIMD )
+    simd_scalar_only();
+}
+
+/**
+ * Prints the remaining lines of Doxygen preformatted text, if any, as-is
+ * directly from the reader's buffer without copying them into
+ * \ref wrap_ctx::input_buf first.  The first line that isn't preformatted
+ * text, either its end command or an IPC line, is un-read so it's read again
+ * as usual; as is the last line if it's not newline-terminated.  Reading stops
+ * before an out-of-band IPC message that applies, too.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void doxygen_put_pre( wrap_ctx_t *ctx ) {
+  for (;;) {
+    if ( ctx->wipc_in != NULL &&
+         wipc_in_due( ctx->wipc_in, ctx->input_offset ) ) {
+      break;
+    }
+    size_t size;
+    char const *const line = input_getline( ctx, SIZE_MAX, &size );
+    if ( line == NULL )
+      break;
+    if ( line[ size - 1 ] != '\n' ||
+         (opt_data_link_esc && memchr( line, WIPC_CODE_HELLO, size ) != NULL) ||
+         dox_is_pre_end( &ctx->dox_parser, line ) ) {
+      input_unget( ctx, size );
+      break;
+    }
+    writer_write( &ctx->wout, line, size );
+    ctx->stats.bytes_in += size;
+    ++ctx->stats.lines_in;
+    PROBE1( line_read, size );
+  } // for
+}
+
+/**
+ * Writes the edits that turn a chunk of input (as split by para_boundary())
+ * into its reformatted output, if they differ.  Since reformatting almost
+ * always only changes the whitespace between words, both are walked in step
+ * and an edit is written for each run of whitespace that differs; only if the
+ * words themselves differ (e.g., by hyphenation) is the rest of the chunk,
+ * less what both end with, replaced by a single edit.
+ *
+ * @param edits The \ref edits_out to use.
+ * @param offset The offset of \a in within all of the input.
+ * @param in The input.
+ * @param in_len The length of \a in.
+ * @param out The reformatted output of \a in.
+ * @param out_len The length of \a out.
+ */
+static void edits_chunk( edits_out_t *edits, size_t offset, char const *in,
+                         size_t in_len, char const *out, size_t out_len ) {
+  assert( edits != NULL );
+  assert( in != NULL );
+  assert( out != NULL );
+
+  if ( in_len == out_len && memcmp( in, out, in_len ) == 0 )
+    return;
+
+  size_t i = 0, j = 0;
+  while ( i < in_len && j < out_len ) {
+    bool const in_ws = strchr( WS_STRN, in[i] ) != NULL;
+    bool const out_ws = strchr( WS_STRN, out[j] ) != NULL;
+    if ( !in_ws && !out_ws ) {
+      if ( in[i] != out[j] )
+        break;
+      ++i;
+      ++j;
+      continue;
+    }
+    size_t const i_ws = i, j_ws = j;
+    while ( i < in_len && strchr( WS_STRN, in[i] ) != NULL )
+      ++i;
+    while ( j < out_len && strchr( WS_STRN, out[j] ) != NULL )
+      ++j;
+    if ( i - i_ws != j - j_ws ||
+         memcmp( in + i_ws, out + j_ws, i - i_ws ) != 0 ) {
+      edits_put( edits, offset + i_ws, i - i_ws, out + j_ws, j - j_ws );
+    }
+  } // while
+
+  if ( i == in_len && j == out_len )
+    return;
+  size_t suffix = 0;
+  while ( suffix < in_len - i && suffix < out_len - j &&
+          in[ in_len - 1 - suffix ] == out[ out_len - 1 - suffix ] ) {
+    ++suffix;
+  } // while
+  edits_put(
+    edits, offset + i, in_len - i - suffix, out + j, out_len - j - suffix
+  );
+}
+
+/**
+ * Writes an edit as a line of JSON of the form:
+ *
+ *      {"offset":N,"delete":N,"insert":"STRING"}
+ *
+ * @param edits The \ref edits_out to use.
+ * @param offset The offset within the input of the characters to delete.
+ * @param del_len The number of characters to delete.
+ * @param s The characters to insert in their place.
+ * @param len The length of \a s.
+ */
+static void edits_put( edits_out_t *edits, size_t offset, size_t del_len,
+                       char const *s, size_t len ) {
+  assert( edits != NULL );
+  edits->buf.len = 0;
+  json_buf_printf( &edits->buf,
+    "{\"offset\":%zu,\"delete\":%zu,\"insert\":", offset, del_len
+  );
+  json_buf_put_str( &edits->buf, s, len );
+  json_buf_put( &edits->buf, "}\n", 2 );
+  writer_write( edits->w, edits->buf.str, edits->buf.len );
+}
+
+/**
+ * Splits the span of the current word, the last span, where it may be
+ * hyphenated (if at all) so that the line up to and including a hyphen
+ * inserted there fits within the line width: the span becomes that part and
+ * the rest becomes a new last span.  The hyphenation points of the whole word
+ * are remembered so that, if the rest still doesn't fit on the next line, it's
+ * split where the whole word may be hyphenated and not where only the rest
+ * may be.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param pb A pointer to just after the current word's last character within
+ * \ref wrap_ctx::input_buf.
+ */
+static void hyphen_split( wrap_ctx_t *ctx, char const *pb ) {
+  assert( pb != NULL );
+  assert( ctx->spans.len > 0 );
+
+  word_span_t *const word = span_list_last( &ctx->spans );
+  size_t const pos = STATIC_CAST( size_t, pb - ctx->input_buf.str );
+  if ( word->len == 0 || word->len > pos )
+    return;
+  size_t const begin = pos - word->len;
+  if ( pos > ctx->nonws_no_wrap_range[0] &&
+       begin < ctx->nonws_no_wrap_range[1] )
+    return;                             // within a URL or e-mail address
+  if ( memcmp( ctx->input_buf.str + begin, ctx->output_buf.str + word->offset,
+               word->len ) != 0 ) {
+    return;                             // not copied verbatim from input_buf
+  }
+
+  size_t end = pos;
+  while ( ctx->input_buf.str[ end ] != '\0' &&
+          !is_space( ctx->input_buf.str[ end ] ) )
+    ++end;
+
+  if ( !ctx->hyph_valid || end != ctx->hyph_end || begin < ctx->hyph_begin ) {
+    //
+    // Hyphenate only whole words and not what follows a hyphen (including a
+    // soft hyphen) or a break within a word.
+    //
+    if ( (begin > 0 && !is_space( ctx->input_buf.str[ begin - 1 ] )) ||
+         (word->gap == 0 && ctx->spans.len > 1 && word[-1].len > 0) ) {
+      return;
+    }
+    size_t const word_len = end - begin;
+    if ( word_len > ctx->hyph_breaks_cap ) {
+      ctx->hyph_breaks_cap = word_len;
+      REALLOC( ctx->hyph_breaks, bool, ctx->hyph_breaks_cap );
+    }
+    ctx->hyph_found =
+      hyphenate_word( ctx->input_buf.str + begin, word_len, ctx->hyph_breaks );
+    ctx->hyph_begin = begin;
+    ctx->hyph_end = end;
+    ctx->hyph_valid = true;
+  }
+  if ( !ctx->hyph_found )
+    return;
+
+  //
+  // Find the last point where the line up to it plus a hyphen fits.
+  //
+  size_t const line_before = ctx->output_width - word->width;
+  size_t split = 0, split_width = 0, width = 0;
+  for ( size_t i = begin; i < pos; ) {
+    if ( i > begin && ctx->hyph_breaks[ i - ctx->hyph_begin ] ) {
+      if ( line_before + width + 1 >= ctx->line_width )
+        break;
+      split = i;
+      split_width = width;
+    }
+    width += cp_width( utf8_decode( ctx->input_buf.str + i ) );
+    i += utf8_len( ctx->input_buf.str[i] );
+  } // for
+  if ( split == 0 )
+    return;
+
+  size_t const cut = word->offset + (split - begin);
+  line_buf_reserve( &ctx->output_buf, ctx->output_len + 1 );
+  memmove(
+    ctx->output_buf.str + cut + 1, ctx->output_buf.str + cut,
+    ctx->output_len - cut
+  );
+  ctx->output_buf.str[ cut ] = '-';
+  ++ctx->output_len;
+  ++ctx->output_width;
+
+  size_t const rest_len = word->len - (cut - word->offset);
+  size_t const rest_width = word->width - split_width;
+  word->len = cut + 1 - word->offset;
+  word->width = split_width + 1;
+  word_span_t *const rest = span_list_push( &ctx->spans, cut + 1, /*gap=*/0 );
+  rest->len = rest_len;
+  rest->width = rest_width;
+}
+/**
+ * Replaces the file \a file with a copy of the already reformatted file at
+ * \a from_path, i.e., the identical file reformatted in its stead, the same
+ * way as if it had been reformatted itself.
+ *
+ * @param from_path The path of the file to copy.
+ * @param file The \ref in_place_file to replace.
+ * @return Returns the exit status for \a file.
+ */
+NODISCARD
+static int in_place_copy( char const *from_path, in_place_file_t const *file ) {
+  assert( from_path != NULL );
+  assert( file != NULL );
+
+  char const *const path = file->real_path;
+  int const from_fd = open( from_path, O_RDONLY );
+  if ( from_fd == -1 ) {
+    EPRINTF( "%s: \"%s\": %s\n", me, from_path, STRERROR() );
+    return EX_NOINPUT;
+  }
+  char *const temp_path = in_place_temp_path( path );
+  int const temp_fd = mkstemp( temp_path );
+  if ( temp_fd == -1 ) {
+    EPRINTF( "%s: \"%s\": %s\n", me, temp_path, STRERROR() );
+    FREE( temp_path );
+    close( from_fd );
+    return EX_CANTCREAT;
+  }
+  PJL_DISCARD_RV( fchmod( temp_fd, file->mode & 07777 ) );
+
+  char buf[ 1 << 16 ];
+  int err = 0;
+  for (;;) {
+    ssize_t const n = read( from_fd, buf, sizeof buf );
+    if ( n == -1 && errno == EINTR )
+      continue;
+    if ( n <= 0 ) {
+      err = n == 0 ? 0 : errno;
+      break;
+    }
+    err = fd_write( temp_fd, buf, STATIC_CAST( size_t, n ) );
+    if ( err != 0 )
+      break;
+  } // for
+  close( from_fd );
+  if ( close( temp_fd ) == -1 && err == 0 )
+    err = errno;
+  if ( err != 0 )
+    EPRINTF( "%s: \"%s\": %s\n", me, temp_path, strerror( err ) );
+  return in_place_finish( path, temp_path, err == 0 ? EX_OK : EX_IOERR );
+}
+
+/**
+ * Finds the files among \a files that are identical to an earlier one: their
+ * contents and the options they'd be reformatted with are the same.  Each
+ * such file's \ref in_place_file::dup_idx "dup_idx" is set to the index of
+ * the first one so the rest can get copies of its reformatted contents rather
+ * than be reformatted themselves.
+ *
+ * @param files The \ref in_place_file objects sorted by in_place_file_cmp().
+ * @param files_len The number of \a files.
+ *
+ * @remarks Only files of the same size can be identical, so only those are
+ * hashed (memory-mapped) at all.  Since the hash isn't cryptographic, files
+ * whose hashes are the same are also compared.
+ */
+static void in_place_dedup( in_place_file_t *files, size_t files_len ) {
+  assert( files != NULL );
+
+  for ( size_t i = 0; i < files_len; ++i )
+    files[i].dup_idx = SIZE_MAX;
+  if ( opt_git_files != NULL )
+    return;                             // changed lines differ per file
+
+  void const **maps = NULL;
+  uint64_t *hashes = NULL;
+
+  for ( size_t begin = 0, end; begin < files_len; begin = end ) {
+    size_t const size = files[ begin ].size;
+    for ( end = begin + 1; end < files_len && files[ end ].size == size;
+          ++end ) {
+      ;
+    } // for
+    if ( end - begin < 2 || size == 0 )
+      continue;
+
+    REALLOC( maps, void const*, end - begin );
+    REALLOC( hashes, uint64_t, end - begin );
+    for ( size_t i = begin; i < end; ++i ) {
+      char const *const path = opt_files[ files[i].file_idx ];
+      maps[ i - begin ] = files[i].stat_err == 0 &&
+        S_ISREG( files[i].mode ) ? in_place_map( path, size ) : NULL;
+      if ( maps[ i - begin ] != NULL ) {
+        hashes[ i - begin ] =
+          mem_hash( maps[ i - begin ], size, options_file_hash( path ) );
+      }
+    } // for
+
+    for ( size_t i = begin + 1; i < end; ++i ) {
+      if ( maps[ i - begin ] == NULL )
+        continue;
+      for ( size_t j = begin; j < i; ++j ) {
+        if ( maps[ j - begin ] != NULL && files[j].dup_idx == SIZE_MAX &&
+             hashes[ j - begin ] == hashes[ i - begin ] &&
+             memcmp( maps[ j - begin ], maps[ i - begin ], size ) == 0 ) {
+          files[i].dup_idx = files[j].file_idx;
+          break;
+        }
+      } // for
+    } // for
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+    for ( size_t i = begin; i < end; ++i ) {
+      if ( maps[ i - begin ] != NULL )
+        munmap( CONST_CAST( void*, maps[ i - begin ] ), size );
+    } // for
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+  } // for
+
+  FREE( maps );
+  FREE( hashes );
+}
+
+/**
+ * Compares two \ref in_place_file objects so that larger files sort first and
+ * files of the same size sort in command-line order; but files identical to
+ * another sort after all others since they need only be copied.
+ *
+ * @param i_file1 A pointer to the first \ref in_place_file.
+ * @param i_file2 A pointer to the second \ref in_place_file.
+ * @return Returns a number less than 0, 0, or greater than 0 if \a i_file1 is
+ * to start before, the same as, or after \a i_file2, respectively.
+ */
+static int in_place_file_cmp( void const *i_file1, void const *i_file2 ) {
+  in_place_file_t const *const file1 = i_file1;
+  in_place_file_t const *const file2 = i_file2;
+  bool const is_dup1 = file1->dup_idx != SIZE_MAX;
+  bool const is_dup2 = file2->dup_idx != SIZE_MAX;
+  if ( is_dup1 != is_dup2 )
+    return is_dup1 ? 1 : -1;
+  if ( file1->size != file2->size )
+    return file1->size > file2->size ? -1 : 1;
+  return file1->file_idx < file2->file_idx ? -1 : 1;
+}
+
+/**
+ * Frees the \ref in_place_file objects \a files.
+ *
+ * @param files The \ref in_place_file objects to free.
+ * @param files_len The number of \a files.
+ */
+static void in_place_files_free( in_place_file_t *files, size_t files_len ) {
+  for ( size_t i = 0; i < files_len; ++i )
+    free( files[i].real_path );
+  FREE( files );
+}
+
+/**
+ * Finishes reformatting \a path in place after its temporary file has been
+ * written: if that succeeded, renames \a temp_path to \a path; otherwise
+ * removes \a temp_path.
+ *
+ * @param path The path of the file being reformatted.
+ * @param temp_path The path of the temporary file written.  It is freed.
+ * @param status The exit status of writing \a temp_path.
+ * @return Returns the exit status for \a path.
+ */
+NODISCARD
+static int in_place_finish( char const *path, char *temp_path, int status ) {
+  assert( path != NULL );
+  assert( temp_path != NULL );
+
+  if ( status == EX_OK && rename( temp_path, path ) == -1 ) {
+    EPRINTF( "%s: \"%s\": %s\n", me, path, STRERROR() );
+    status = EX_IOERR;
+  }
+  if ( status != EX_OK )
+    PJL_DISCARD_RV( unlink( temp_path ) );
+  FREE( temp_path );
+  return status;
+}
+
+/**
+ * Reformats each of \ref opt_files in place.  For each file, forks a child
+ * process that reads the file and writes to a temporary file in the same
+ * directory; if the child succeeds, the temporary file is renamed to the
+ * original file.  Up to \ref opt_jobs children are run concurrently, each
+ * starting as soon as any other finishes.  Options, the configuration file,
+ * and the URI regular expression are all processed only once by the parent.
+ *
+ * @remarks Files are started largest first so that a large file isn't started
+ * last while every other CPU has nothing left to do.  A file identical to one
+ * before it, e.g., one of many copies of a license, isn't reformatted at all:
+ * once the first has been, it's copied instead.  Each child may also use
+ * a share of the CPUs in proportion to its file's share of all the bytes to
+ * reformat its file in parallel via para_fork(), so a file much larger than
+ * all the rest doesn't take as long as all of them.
+ *
+ * @remarks In the parent, this function never returns: it exits with the
+ * status of the first file (in command-line order) that failed, if any.  In
+ * each child, it returns so that **wrap**(1) proceeds as if only that one file
+ * had been given.
+ */
+static void in_place_fork( void ) {
+  size_t cpus_max = opt_jobs;
+  if ( cpus_max == 0 ) {
+    long const cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    cpus_max = cpus > 0 ? STATIC_CAST( size_t, cpus ) : 1;
+  }
+  size_t const jobs_max =
+    cpus_max < opt_files_len ? cpus_max : opt_files_len;
+
+  in_place_file_t *const files = MALLOC( in_place_file_t, opt_files_len );
+  uintmax_t total_size = 0;
+  for ( size_t i = 0; i < opt_files_len; ++i ) {
+    struct stat st;
+    files[i] = (in_place_file_t){ .file_idx = i };
+    if ( stat( opt_files[i], &st ) == -1 ||
+         (files[i].real_path = realpath( opt_files[i], NULL )) == NULL ) {
+      files[i].stat_err = errno;
+      continue;
+    }
+    files[i].mode = st.st_mode;
+    if ( S_ISREG( st.st_mode ) )
+      files[i].size = STATIC_CAST( size_t, st.st_size );
+  } // for
+  qsort( files, opt_files_len, sizeof *files, &in_place_file_cmp );
+  in_place_dedup( files, opt_files_len );
+  qsort( files, opt_files_len, sizeof *files, &in_place_file_cmp );
+  for ( size_t i = 0; i < opt_files_len; ++i ) {
+    if ( files[i].dup_idx == SIZE_MAX )
+      total_size += files[i].size;
+  } // for
+  bool *const reformatted = MALLOC( bool, opt_files_len );
+  memset( reformatted, 0, opt_files_len * sizeof *reformatted );
+
+  in_place_job_t *const jobs = MALLOC( in_place_job_t, jobs_max );
+  for ( size_t i = 0; i < jobs_max; ++i )
+    jobs[i].slot = i;
+  size_t  jobs_len = 0;
+  int     exit_status = EX_OK;
+  size_t  fail_idx = opt_files_len;     // index of first file that failed
+
+  for ( size_t next_idx = 0; next_idx < opt_files_len || jobs_len > 0; ) {
+    size_t  done_idx;
+    int     status = EX_OK;
+
+    if ( next_idx < opt_files_len && jobs_len < jobs_max &&
+         !in_place_is_running( jobs, jobs_len, files[ next_idx ].dup_idx ) ) {
+      in_place_file_t const *const file = &files[ next_idx++ ];
+      if ( file->dup_idx != SIZE_MAX && reformatted[ file->dup_idx ] ) {
+        done_idx = file->file_idx;
+        status = in_place_copy( opt_files[ file->dup_idx ], file );
+        goto done;
+      }
+      //
+      // Otherwise the file it's identical to either failed or was skipped, so
+      // it's reformatted itself (that will fail or be skipped the same way).
+      //
+      in_place_job_t *const job = &jobs[ jobs_len ];
+      job->file_idx = file->file_idx;
+      job->real_path = file->real_path;
+      job->pid = in_place_start( file, &job->temp_path, &status );
+      if ( job->pid == 0 ) {            // child
+        uintmax_t const share = total_size == 0 ? 0 :
+          file->size * STATIC_CAST( uintmax_t, cpus_max ) / total_size;
+        opt_jobs = share > 1 ? STATIC_CAST( size_t, share ) : 1;
+        if ( opt_jobs == 1 )
+          job_pin( job->slot );
+        in_place_files_free( files, opt_files_len );
+        FREE( jobs );
+        FREE( reformatted );
+        return;
+      }
+      if ( job->pid > 0 ) {
+        ++jobs_len;
+        continue;
+      }
+      done_idx = job->file_idx;
+    }
+    else {
+      int wait_status;
+      pid_t const pid = waitpid( -1, &wait_status, 0 );
+      PERROR_EXIT_IF( pid == -1, EX_OSERR );
+      size_t j = 0;
+      while ( jobs[j].pid != pid ) {
+        ++j;
+        assert( j < jobs_len );
+      } // while
+      done_idx = jobs[j].file_idx;
+      status = in_place_finish(
+        jobs[j].real_path, jobs[j].temp_path,
+        WIFEXITED( wait_status ) ? WEXITSTATUS( wait_status ) : EX_SOFTWARE
+      );
+      reformatted[ done_idx ] = status == EX_OK;
+      size_t const slot = jobs[j].slot;
+      jobs[j] = jobs[ --jobs_len ];
+      jobs[ jobs_len ].slot = slot;     // for the next job started
+    }
+
+done:
+    if ( status != EX_OK && done_idx < fail_idx ) {
+      fail_idx = done_idx;
+      exit_status = status;
+    }
+  } // for
+
+  in_place_files_free( files, opt_files_len );
+  FREE( jobs );
+  FREE( reformatted );
+  exit( exit_status );
+}
+
+/**
+ * Checks whether the file at \a path looks like binary data (e.g., an image or
+ * UTF-16 text) by its first #IN_PLACE_PEEK_SIZE characters so it can be
+ * skipped rather than mangled.
+ *
+ * @param path The path of the file to check.
+ * @return Returns `true` only if the file looks binary.  If it can't be read,
+ * returns `false` so the error is reported when it's reformatted.
+ */
+NODISCARD
+static bool in_place_is_binary( char const *path ) {
+  assert( path != NULL );
+  int const fd = open( path, O_RDONLY );
+  if ( fd == -1 )
+    return false;
+  char buf[ IN_PLACE_PEEK_SIZE ];
+  ssize_t bytes_read;
+  do {
+    bytes_read = read( fd, buf, sizeof buf );
+  } while ( bytes_read == -1 && errno == EINTR );
+  close( fd );
+  return bytes_read > 0 &&
+    simd_is_binary( buf, STATIC_CAST( size_t, bytes_read ) );
+}
+
+/**
+ * Checks whether the file at index \a file_idx into \ref opt_files is being
+ * reformatted by one of \a jobs.
+ *
+ * @param jobs The \ref in_place_job objects running.
+ * @param jobs_len The number of \a jobs.
+ * @param file_idx The index of the file or `SIZE_MAX` for none.
+ * @return Returns `true` only if it is.
+ */
+NODISCARD
+static bool in_place_is_running( in_place_job_t const *jobs, size_t jobs_len,
+                                 size_t file_idx ) {
+  for ( size_t i = 0; file_idx != SIZE_MAX && i < jobs_len; ++i ) {
+    if ( jobs[i].file_idx == file_idx )
+      return true;
+  } // for
+  return false;
+}
+
+/**
+ * Maps the file at \a path into memory read-only.
+ *
+ * @param path The path of the file to map.
+ * @param size The size of the file; must not be 0.
+ * @return Returns a pointer to the mapped file or null if it couldn't be.
+ */
+NODISCARD
+static void const* in_place_map( char const *path, size_t size ) {
+  assert( path != NULL );
+  assert( size > 0 );
+#if HAVE_MMAP && HAVE_SYS_MMAN_H
+  int const fd = open( path, O_RDONLY );
+  if ( fd == -1 )
+    return NULL;
+  void *const map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  close( fd );
+  return map == MAP_FAILED ? NULL : map;
+#else
+  (void)path;
+  (void)size;
+  return NULL;
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+}
+
+/**
+ * Starts reformatting \a file in place by forking a child process whose
+ * standard input is \a file and whose standard output is a new temporary
+ * file in the same directory.
+ *
+ * @param file The \ref in_place_file to reformat.
+ * @param ptemp_path A pointer to receive the path of the temporary file.  The
+ * caller is responsible for freeing it, but only if a child was forked.
+ * @param pstatus A pointer to receive the exit status for \a path, but only
+ * if a child could not be forked for it.
+ * @return In the parent, returns the child's process ID or -1 if \a file
+ * either could not be reformatted or was skipped because it looks binary; in
+ * the child, returns 0.
+ */
+NODISCARD
+static pid_t in_place_start( in_place_file_t const *file, char **ptemp_path,
+                             int *pstatus ) {
+  assert( file != NULL );
+  assert( ptemp_path != NULL );
+  assert( pstatus != NULL );
+
+  char const *const path = opt_files[ file->file_idx ];
+  if ( file->stat_err != 0 ) {
+    EPRINTF( "%s: \"%s\": %s\n", me, path, strerror( file->stat_err ) );
+    *pstatus = EX_NOINPUT;
+    return -1;
+  }
+  if ( !S_ISREG( file->mode ) ) {
+    EPRINTF( "%s: \"%s\": not a regular file\n", me, path );
+    *pstatus = EX_NOINPUT;
+    return -1;
+  }
+  if ( in_place_is_binary( path ) ) {
+    EPRINTF( "%s: \"%s\": binary file; skipped\n", me, path );
+    *pstatus = EX_OK;
+    return -1;
+  }
+
+  char *const temp_path = in_place_temp_path( file->real_path );
+  int const temp_fd = mkstemp( temp_path );
+  if ( temp_fd == -1 ) {
+    EPRINTF( "%s: \"%s\": %s\n", me, temp_path, STRERROR() );
+    FREE( temp_path );
+    *pstatus = EX_CANTCREAT;
+    return -1;
+  }
+  PJL_DISCARD_RV( fchmod( temp_fd, file->mode & 07777 ) );
+
+  PERROR_EXIT_IF( fflush( stdout ) != 0, EX_IOERR );
+  pid_t const pid = fork();
+  PERROR_EXIT_IF( pid == -1, EX_OSERR );
+  if ( pid == 0 ) {                     // child
+    DUP2( temp_fd, STDOUT_FILENO );
+    close( temp_fd );
+    FREE( temp_path );
+    if ( freopen( path, "r", stdin ) == NULL )
+      fatal_error( EX_NOINPUT, "\"%s\": %s\n", path, STRERROR() );
+    options_init_file( path );
+    if ( opt_git_files != NULL )
+      stdin_git_file = &opt_git_files[ file->file_idx ];
+    return 0;
+  }
+
+  close( temp_fd );
+  *ptemp_path = temp_path;
+  return pid;
+}
+
+/**
+ * Creates a template for **mkstemp**(3) for a temporary file in the same
+ * directory as \a path, e.g., `dir/.file.XXXXXX` for `dir/file`.
+ *
+ * @param path The path of the file to create a temporary file path for.
+ * @return Returns said path.  The caller is responsible for freeing it.
+ */
+static char* in_place_temp_path( char const *path ) {
+  assert( path != NULL );
+  static char const SUFFIX[] = ".XXXXXX";
+  char const *const base = base_name( path );
+  size_t const dir_len = STATIC_CAST( size_t, base - path );
+  size_t const base_len = strlen( base );
+
+  char *const temp_path =
+    MALLOC( char, dir_len + 1/*.*/ + base_len + sizeof SUFFIX );
+  memcpy( temp_path, path, dir_len );
+  temp_path[ dir_len ] = '.';
+  memcpy( temp_path + dir_len + 1, base, base_len );
+  strcpy( temp_path + dir_len + 1 + base_len, SUFFIX );
+  return temp_path;
+}
+
+/**
+ * Gets a line of the input of \a ctx without copying it: either from its file
+ * via reader_getline() or from what's been given via wrap_feed().  For the
+ * latter, a line is gotten only once it's complete (or no more input is
+ * coming) so that it's gotten in the same chunks however the input was given.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param size_max The maximum number of characters to get.
+ * @param psize A pointer to receive the number of characters gotten.
+ * @return Returns a pointer to the start of the line that's valid only until
+ * the next time input is read or given or NULL if there is no line either
+ * yet or at all.  The line is _not_ null-terminated.
+ *
+ * @sa input_unget()
+ */
+static char const* input_getline( wrap_ctx_t *ctx, size_t size_max,
+                                  size_t *psize ) {
+  assert( psize != NULL );
+  if ( ctx->fin != NULL ) {
+    if ( ctx->wipc_in != NULL )
+      size_max = wipc_in_limit( ctx->wipc_in, ctx->input_offset, size_max );
+    char const *const line = reader_getline( ctx->fin, size_max, psize );
+    if ( line != NULL )
+      ctx->input_offset += *psize;
+    return line;
+  }
+
+  size_t const rem = ctx->feed_end - ctx->feed_pos;
+  if ( rem == 0 )
+    return NULL;
+  char const *const line = ctx->feed_buf.str + ctx->feed_pos;
+  //
+  // A line given in many small pieces would otherwise be searched for a
+  // newline from its beginning once per piece.
+  //
+  size_t const scanned = ctx->feed_scan > ctx->feed_pos ?
+    ctx->feed_scan - ctx->feed_pos : 0;
+  char const *const nl = memchr( line + scanned, '\n', rem - scanned );
+  if ( nl == NULL && !ctx->is_input_end ) {
+    ctx->feed_scan = ctx->feed_end;
+    return NULL;
+  }
+  size_t size = nl != NULL ? STATIC_CAST( size_t, nl - line ) + 1 : rem;
+  if ( size > size_max )
+    size = size_max;
+  ctx->feed_pos += size;
+  ctx->input_offset += size;
+  *psize = size;
+  return line;
+}
+
+/**
+ * Reads a line of the input of \a ctx into its \ref wrap_ctx::input_buf like
+ * check_readline() does.  If an IPC message applies in the middle of the
+ * line, reading stops just before it.  If an out-of-band IPC message applies
+ * first, it's read instead as the equivalent in-band IPC line.  Either way,
+ * also sets \ref wrap_ctx::is_ipc_line.  At the end of the input, it may be
+ * extended via para_md_extend().
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param size_max The maximum number of characters to read.
+ * @return Returns the number of characters read.  If 0 but more input may yet
+ * be given, \ref wrap_ctx::input_buf is left as it was.
+ */
+static size_t input_readline( wrap_ctx_t *ctx, size_t size_max ) {
+  ctx->is_ipc_line = false;
+  if ( ctx->fin != NULL && ctx->wipc_in == NULL && !opt_data_link_esc ) {
+    size_t size = check_readline( &ctx->input_buf, ctx->fin, size_max );
+    while ( unlikely( size == 0 ) && para_md_extend( ctx ) )
+      size = check_readline( &ctx->input_buf, ctx->fin, size_max );
+    ctx->input_offset += size;
+    return size;
+  }
+
+  size_t len = 0;
+  while ( len < size_max ) {
+    if ( ctx->wipc_in != NULL &&
+         wipc_in_due( ctx->wipc_in, ctx->input_offset ) ) {
+      if ( len > 0 )
+        break;                          // message applies mid-line
+      ctx->is_ipc_line = true;
+      return wipc_readline( ctx );
+    }
+
+    size_t size;
+    char const *const line = input_getline( ctx, size_max - len, &size );
+    if ( line == NULL ) {
+      if ( len == 0 && ctx->fin == NULL && !ctx->is_input_end )
+        return 0;
+      break;
+    }
+
+    bool is_split = false;
+    if ( opt_data_link_esc ) {
+      char const *const hello = memchr( line, WIPC_CODE_HELLO, size );
+      if ( hello == line && len == 0 ) {
+        ctx->is_ipc_line = true;
+      } else if ( hello != NULL ) {     // message starts mid-line
+        size_t const text_size = STATIC_CAST( size_t, hello - line );
+        input_unget( ctx, size - text_size );
+        size = text_size;
+        is_split = true;
+      }
+    }
+
+    line_buf_reserve( &ctx->input_buf, len + size );
+    if ( size > 0 )
+      memcpy( ctx->input_buf.str + len, line, size );
+    len += size;
+    if ( is_split || line[ size - 1 ] == '\n' )
+      break;
+  } // while
+
+  line_buf_reserve( &ctx->input_buf, len + SIMD_SPAN_PAD );
+  ctx->input_buf.str[ len ] = '\0';
+  ctx->input_buf.len = len;
+  return len;
+}
+
+/**
+ * Un-gets the line, or the end of the line, most recently gotten via
+ * input_getline() so that it's gotten again next.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param size The number of characters of the line (or its end) to un-get.
+ */
+static void input_unget( wrap_ctx_t *ctx, size_t size ) {
+  if ( ctx->fin != NULL ) {
+    reader_unget( ctx->fin, size );
+  } else {
+    assert( size <= ctx->feed_pos );
+    ctx->feed_pos -= size;
+    ctx->feed_scan = ctx->feed_pos;
+  }
+  ctx->input_offset -= size;
+}
+
+/**
+ * If \ref opt_affinity, pins the calling process, a job run in parallel, to
+ * one CPU: the \a slot'th (modulo their number) of those it may run on.  Jobs
+ * running at the same time must be given different slots.  This is done
+ * before the job allocates any memory so that, on a NUMA system, its memory
+ * is allocated on the CPU's node.
+ *
+ * @param slot The slot of the job among those running.
+ */
+static void job_pin( size_t slot ) {
+#if HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY
+  if ( !opt_affinity )
+    return;
+  cpu_set_t cpus;
+  if ( sched_getaffinity( 0, sizeof cpus, &cpus ) == -1 )
+    return;
+  int const cpus_len = CPU_COUNT( &cpus );
+  if ( cpus_len < 2 )
+    return;
+  slot %= STATIC_CAST( size_t, cpus_len );
+  for ( size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+    if ( CPU_ISSET( cpu, &cpus ) && slot-- == 0 ) {
+      CPU_ZERO( &cpus );
+      CPU_SET( cpu, &cpus );
+      PJL_DISCARD_RV( sched_setaffinity( 0, sizeof cpus, &cpus ) );
+      return;
+    }
+  } // for
+#else
+  (void)slot;
+#endif /* HAVE_SCHED_H && HAVE_SCHED_SETAFFINITY */
+}
+
+/**
+ * Adjusts wrap's indent, hang-indent, and line-width for each Markdown line.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` if we're to proceed or \c false if another line
+ * should be read.
+ */
+NODISCARD
+static bool markdown_adjust( wrap_ctx_t *ctx ) {
+  uint64_t const start = stats_now();
+  md_state_t const *const md =
+    markdown_parse( &ctx->md_parser, &ctx->input_desc );
+  stats_charge( &ctx->stats.md_ns, start );
+  ++ctx->stats.md_lines[
+    strchr( MD_LINE_TYPES, STATIC_CAST( char, md->line_type ) ) - MD_LINE_TYPES
+  ];
+  MD_DEBUG(
+    "T=%c N=%2u D=%u L=%u H=%u|%s",
+    STATIC_CAST( char, md->line_type ), md->seq_num, md->depth,
+    md->indent_left, md->indent_hang, ctx->input_buf.str
+  );
+
+  if ( unlikely( ctx->para_ns != 0 ) && ctx->input_desc.nws[0] != '\0' ) {
+    ctx->para_md_line_type = md->line_type;
+    if ( md->depth > ctx->para_md_depth )
+      ctx->para_md_depth = md->depth;
+  }
+
+  if ( md->line_type != MD_TABLE )
+    put_md_table( ctx );
+
+  if ( ctx->md_prev_line_type != md->line_type ) {
+    switch ( ctx->md_prev_line_type ) {
+      case MD_CODE:
+      case MD_HEADER_ATX:
+      case MD_HR:
+      case MD_HTML_ABBR:
+      case MD_HTML_BLOCK:
+      case MD_LINK_LABEL:
+      case MD_TABLE:
+        ctx->consec_newlines = 0;
+        if ( ctx->input_desc.nws[0] == '\0' ) {
+          //
+          // Prevent blank lines immediately after these Markdown line types
+          // from being swallowed by wrap by just printing them directly.
+          //
+          writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+        }
+        break;
+      case MD_DL:
+      case MD_FOOTNOTE_DEF:
+      case MD_HEADER_LINE:
+      case MD_NONE:
+      case MD_OL:
+      case MD_TEXT:
+      case MD_UL:
+        // nothing to do
+        break;
+    } // switch
+
+    if ( md->line_type == MD_FOOTNOTE_DEF && !md->footnote_def_has_text ) {
+      //
+      // For a footnote definition line that does not have text on the same
+      // line:
+      //
+      //      [^1]:
+      //          Like this.
+      //
+      // print the marker line as-is "behind wrap's back" so it won't be
+      // wrapped.
+      //
+      writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+      ctx->input_buf.str[0] = '\0';
+      ctx->input_buf.len = 0;
+      md_line_desc_init( &ctx->input_desc, ctx->input_buf.str );
+    }
+
+    ctx->md_prev_line_type = md->line_type;
+  }
+
+  switch ( md->line_type ) {
+    case MD_TABLE:
+      if ( opt_markdown_tables ) {
+        //
+        // Flush output_buf and collect the table's rows to print them with
+        // their columns aligned once the table ends.
+        //
+        put_lead_chars( ctx );
+        put_line( ctx, ctx->output_len, /*do_eol=*/true );
+        md_table_add( &ctx->md_table, ctx->input_buf.str );
+        return false;
+      }
+      FALLTHROUGH;
+    case MD_CODE:
+    case MD_HEADER_ATX:
+    case MD_HEADER_LINE:
+    case MD_HR:
+    case MD_HTML_ABBR:
+    case MD_HTML_BLOCK:
+    case MD_LINK_LABEL:
+      //
+      // Flush output_buf and print the Markdown line as-is "behind wrap's
+      // back" because these line types are never wrapped.
+      //
+      put_lead_chars( ctx );
+      put_line( ctx, ctx->output_len, /*do_eol=*/true );
+      writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+      return false;
+
+    case MD_DL:
+    case MD_FOOTNOTE_DEF:
+    case MD_OL:
+    case MD_UL:
+      if ( md->seq_num > ctx->md_prev_seq_num ) {
+        //
+        // We're changing line types: flush output_buf.
+        //
+        put_lead_chars( ctx );
+        put_line( ctx, ctx->output_len, /*do_eol=*/true );
+        ctx->md_prev_seq_num = md->seq_num;
+      }
+      else if ( ctx->output_len == 0 && ctx->input_desc.nws[0] != '\0' ) {
+        //
+        // Same line type, but new line: hang indent.
+        //
+        put_tabs_spaces( ctx, /*tabs=*/0, md->indent_hang );
+      }
+      ctx->line_width = ctx->opt.line_width - md->indent_left;
+      ctx->opt.lead_spaces = md->indent_left;
+      ctx->opt.hang_spaces = md->indent_hang;
+      return true;
+
+    case MD_NONE:
+    case MD_TEXT:
+      markdown_reset( ctx );
+      return true;
+  } // switch
+}
+
+/**
+ * The \ref wrap_block_fn_t for Markdown.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the line should be wrapped.
+ *
+ * @sa markdown_adjust()
+ */
+NODISCARD
+static bool markdown_line_adjust( wrap_ctx_t *ctx ) {
+  md_line_desc_init( &ctx->input_desc, ctx->input_buf.str );
+  return markdown_adjust( ctx );
+}
+
+/**
+ * Finds all of the \ref wrap_ctx::nonws_no_wrap_ranges of
+ * \ref wrap_ctx::input_buf when wrapping Markdown: those of its code spans,
+ * link destinations, and autolinks found by md_inline_no_wrap() (or, when
+ * wrapping HTML, those of its tags found by markup_html_no_wrap(); or, when
+ * wrapping roff, those found by markup_roff_no_wrap()) along with
+ * those of the URLs and e-mail addresses found by regex_wrap_re_match() only
+ * in the text between them so the text of the former is never matched against
+ * #WRAP_RE at all.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void markdown_no_wrap_find( wrap_ctx_t *ctx ) {
+  if ( opt_markdown )
+    md_inline_no_wrap( ctx->input_buf.str, &ctx->md_no_wrap_ranges );
+  else if ( opt_markup == MARKUP_HTML )
+    markup_html_no_wrap( ctx->input_buf.str, &ctx->md_no_wrap_ranges );
+  else
+    markup_roff_no_wrap( ctx->input_buf.str, &ctx->md_no_wrap_ranges );
+  ctx->nonws_no_wrap_ranges.len = 0;
+
+  size_t offset = 0;
+  for ( size_t i = 0; i <= ctx->md_no_wrap_ranges.len; ++i ) {
+    size_t const *const md = i < ctx->md_no_wrap_ranges.len ?
+      ctx->md_no_wrap_ranges.range[i] : NULL;
+    if ( md == NULL || md[0] > offset ) {
+      //
+      // Temporarily end the string at the next Markdown span so the regex
+      // can't scan into it.
+      //
+      char saved = '\0';
+      if ( md != NULL ) {
+        saved = ctx->input_buf.str[ md[0] ];
+        ctx->input_buf.str[ md[0] ] = '\0';
+      }
+      size_t match[2];
+      while ( regex_wrap_re_match( ctx->input_buf.str, offset,
+                                   &ctx->nonws_no_wrap_words, match ) ) {
+        regex_ranges_add( &ctx->nonws_no_wrap_ranges, match[0], match[1] );
+        ++ctx->stats.uri_regex_hits;
+        offset = match[1];
+      } // while
+      if ( md == NULL )
+        break;
+      ctx->input_buf.str[ md[0] ] = saved;
+    }
+    regex_ranges_add( &ctx->nonws_no_wrap_ranges, md[0], md[1] );
+    offset = md[1];
+  } // for
+}
+
+/**
+ * Resets variables affected by the Markdown parser.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void markdown_reset( wrap_ctx_t *ctx ) {
+  ctx->line_width = ctx->opt.line_width;
+  ctx->opt.hang_spaces = ctx->opt.lead_spaces = 0;
+}
+
+/**
+ * The \ref wrap_block_fn_t for reStructuredText, AsciiDoc, HTML, and roff:
+ * delimits the paragraph before a line that starts one and indents the line
+ * and those after it per its indent and list item marker, if any; and prints
+ * lines of markup and preformatted text as-is "behind wrap's back."
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the line should be wrapped.
+ */
+NODISCARD
+static bool markup_adjust( wrap_ctx_t *ctx ) {
+  markup_parser_t const *const parser = &ctx->markup_parser;
+  switch ( markup_parse( &ctx->markup_parser, ctx->input_buf.str,
+                         ctx->input_buf.len ) ) {
+    case MARKUP_LINE_TEXT:
+      break;
+    case MARKUP_LINE_PARA: {
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      //
+      // Keep at least one character's width to wrap within no matter how
+      // deeply the paragraph is indented.
+      //
+      size_t const indent = parser->indent < ctx->opt.line_width ?
+        parser->indent : ctx->opt.line_width - 1;
+      size_t const width = ctx->opt.line_width - indent;
+      ctx->line_width = width;
+      ctx->opt.lead_spaces = indent;
+      ctx->opt.hang_spaces = parser->hang < width ? parser->hang : width - 1;
+      break;
+    }
+    case MARKUP_LINE_VERBATIM:
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+      //
+      // So a blank line after it is printed as the paragraph delimiter it is.
+      //
+      ctx->consec_newlines = 1;
+      return false;
+  } // switch
+
+  return true;
+}
+
+/**
+ * Adds the measurements of a paragraph to a \ref measure_queue.
+ *
+ * @param lines The number of lines the paragraph takes.
+ * @param width The width of its widest line.
+ * @param data A pointer to the \ref measure_queue.
+ */
+static void measure_add( size_t lines, size_t width, void *data ) {
+  measure_queue_t *const q = data;
+  if ( q->len == q->cap ) {
+    q->cap = q->cap == 0 ? 64 : q->cap * 2;
+    REALLOC( q->pairs, size_t, q->cap * 2 );
+  }
+  q->pairs[ q->len * 2 ] = lines;
+  q->pairs[ q->len * 2 + 1 ] = width;
+  ++q->len;
+}
+
+/**
+ * Gets the width of the leading characters put_lead_chars() would print.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns said width.
+ */
+NODISCARD
+static size_t measure_lead_width( wrap_ctx_t *ctx ) {
+  if ( ctx->proto_len == 0 )
+    return ctx->opt.lead_tabs * ctx->opt.tab_spaces + ctx->opt.lead_spaces;
+  size_t width = 0;
+  for ( size_t i = 0; i < ctx->proto_len; ++i ) {
+    char const *const s = ctx->proto_buf.str + i;
+    if ( *s == '\t' )
+      width += ctx->opt.tab_spaces - width % ctx->opt.tab_spaces;
+    else if ( !utf8_is_cont( *s ) )
+      width += utf8_width( s );
+  } // for
+  return width + ctx->proto_tws_len;
+}
+
+/**
+ * If measuring, hands the measurements of the paragraph just printed, if any,
+ * to \ref wrap_ctx::measure_fn.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void measure_para_end( wrap_ctx_t *ctx ) {
+  if ( ctx->measure_fn == NULL || ctx->measure_lines == 0 )
+    return;
+  (*ctx->measure_fn)(
+    ctx->measure_lines, ctx->measure_width, ctx->measure_data
+  );
+  ctx->measure_lines = ctx->measure_width = 0;
+}
+
+/**
+ * Discards output: the writer function of a \ref wrap_ctx that's only
+ * measuring.
+ *
+ * @param s Not used.
+ * @param len Not used.
+ * @param data Not used.
+ */
+static void measure_write( char const *s, size_t len, void *data ) {
+  (void)s;
+  (void)len;
+  (void)data;
+}
+
+/**
+ * Writes all but the last part of a line that's too long broken at the last
+ * spaces that leave each part shorter than the line width, each part starting
+ * with the line's leading whitespace.  A word that's too long by itself is
+ * left as-is.
+ *
+ * @param ctx The \ref wrap_ctx to write via.
+ * @param s The line without its end-of-line or trailing whitespace.
+ * @param len The number of characters of \a s.
+ * @param lead_len The number of characters of leading whitespace of \a s.
+ * @param line_eol The end-of-line to write after each part.
+ * @return Returns the offset within \a s of the last part (after the spaces
+ * before it) or 0 if \a s can't be broken at all.
+ *
+ * @sa stdin_minimal()
+ */
+static size_t minimal_break( wrap_ctx_t *ctx, char const *s, size_t len,
+                             size_t lead_len, char const *line_eol ) {
+  assert( s != NULL );
+  assert( lead_len <= len );
+
+  size_t const lead_cols = str_cols( s, lead_len, 0 );
+  char const *const end = s + len;
+  char const *part = s + lead_len;      // start of the current part
+  char const *brk = NULL;               // spaces after which to break, if any
+  char const *brk_end = NULL;
+  size_t col = lead_cols;
+
+  for ( char const *c = part; c < end; ) {
+    if ( *c == ' ' || *c == '\t' ) {
+      brk = c;
+      brk_end = c + simd_ws_span( c, STATIC_CAST( size_t, end - c ) );
+      col = str_cols( brk, STATIC_CAST( size_t, brk_end - brk ), col );
+      c = brk_end;
+      continue;
+    }
+    size_t c_len = utf8_len( *c );
+    if ( c_len == 0 || c + c_len > end )
+      c_len = 1;                        // invalid UTF-8
+    col = str_cols( c, c_len, col );
+    c += c_len;
+    if ( col >= opt_line_width && brk != NULL ) {
+      writer_write( &ctx->wout, s, lead_len );
+      minimal_write(
+        ctx, part, STATIC_CAST( size_t, brk - part ), line_eol
+      );
+      part = brk_end;
+      brk = NULL;
+      col = str_cols( part, STATIC_CAST( size_t, c - part ), lead_cols );
+    }
+  } // for
+
+  return part > s + lead_len ? STATIC_CAST( size_t, part - s ) : 0;
+}
+
+/**
+ * Writes a line and an end-of-line.
+ *
+ * @param ctx The \ref wrap_ctx to write via.
+ * @param s The line without its end-of-line.
+ * @param len The number of characters of \a s.
+ * @param line_eol The end-of-line to write.
+ *
+ * @sa stdin_minimal()
+ */
+static void minimal_write( wrap_ctx_t *ctx, char const *s, size_t len,
+                           char const *line_eol ) {
+  writer_write( &ctx->wout, s, len );
+  writer_write( &ctx->wout, line_eol, strlen( line_eol ) );
+}
+
+/**
+ * Gets the offset of the first paragraph boundary at or after \a pos in \a s,
+ * that is just after one or more blank lines and just before a line that does
+ * not start with whitespace.  Reformatting the text before and after such a
+ * boundary separately produces the same output as reformatting it all at once.
+ *
+ * @param s The text to search.
+ * @param size The number of characters of \a s.
+ * @param pos The offset to start searching at.
+ * @return Returns said offset or \a size if none.
+ */
+static size_t para_boundary( char const *s, size_t size, size_t pos ) {
+  assert( s != NULL );
+  while ( pos < size ) {
+    char const *const nl = memchr( s + pos, '\n', size - pos );
+    if ( nl == NULL )
+      break;
+    pos = STATIC_CAST( size_t, nl - s ) + 1;
+    bool blank_line = false;
+    for (;;) {
+      size_t n = pos;
+      if ( n < size && s[n] == '\r' )
+        ++n;
+      if ( n >= size || s[n] != '\n' )
+        break;
+      blank_line = true;
+      pos = n + 1;
+    } // for
+    if ( blank_line && pos < size && !is_space( s[ pos ] ) )
+      return pos;
+  } // while
+  return size;
+}
+
+/**
+ * Checks whether the options don't carry state from one paragraph to the next
+ * so that paragraphs can be reformatted separately.
+ *
+ * @return Returns `true` only if reformatting the text before and after a
+ * paragraph boundary separately produces the same output as reformatting it
+ * all at once.
+ *
+ * @sa para_boundary()
+ */
+static bool para_is_independent( void ) {
+  return  !opt_data_link_esc && !opt_doxygen && opt_lines_first == 0 &&
+          !opt_email_quotes && !opt_markdown && opt_markup == MARKUP_NONE &&
+          !opt_prototype && opt_newlines_delimit <= 2;
+}
+
+/**
+ * Initializes the boundaries of the chunks Markdown is split into to be
+ * reformatted in parallel.  Each is a paragraph boundary (see para_boundary())
+ * where a quick scan guesses the Markdown parser is back in its initial state:
+ * neither within a code fence nor just before a list item that may continue a
+ * list before the boundary.  The guess is checked by para_md_extend().
+ *
+ * @param s The text to split.
+ * @param size The number of characters of \a s.
+ * @param bounds The boundaries to initialize: \a bounds[0] and
+ * \a bounds[chunks] must already be 0 and \a size, respectively.
+ * @param chunks The number of chunks.
+ */
+static void para_md_bounds_init( char const *s, size_t size, size_t *bounds,
+                                 size_t chunks ) {
+  assert( s != NULL );
+  assert( bounds != NULL );
+
+  bool    in_fence = false;
+  size_t  scanned = 0;                  // offset scanned for fences up to
+
+  for ( size_t i = 1; i < chunks; ++i ) {
+    size_t pos = size / chunks * i;
+    if ( pos < bounds[ i - 1 ] )
+      pos = bounds[ i - 1 ];
+    for (;;) {
+      pos = para_boundary( s, size, pos );
+      while ( scanned < pos ) {
+        char const *const nl = memchr( s + scanned, '\n', pos - scanned );
+        size_t const end = nl != NULL ? STATIC_CAST( size_t, nl - s ) + 1 : pos;
+        if ( para_md_is_fence( s + scanned, end - scanned ) )
+          in_fence = !in_fence;
+        scanned = end;
+      } // while
+      if ( pos == size ||
+           (!in_fence && !para_md_is_list_item( s + pos, size - pos )) ) {
+        break;
+      }
+    } // for
+    bounds[i] = pos;
+  } // for
+}
+
+/**
+ * In a child reformatting a chunk of Markdown in parallel, at the end of its
+ * input, checks whether the Markdown parser would parse the next chunk as from
+ * its initial state as was assumed for that chunk.  If not, it was reformatted
+ * speculatively from the wrong state, so the child absorbs it, i.e., extends
+ * its input by it so it's reformatted from the right state instead; the
+ * parent discards the next chunk's own output.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the input was extended.
+ */
+NODISCARD
+static bool para_md_extend( wrap_ctx_t *ctx ) {
+  assert( ctx != NULL );
+  if ( para_md_bounds == NULL || ctx->fin != stdin )
+    return false;
+
+  size_t *const absorbed = &para_md_absorbed[ para_md_chunk ];
+  size_t const next = para_md_chunk + 1 + *absorbed;
+  if ( next < para_md_chunks ) {
+    char const *const line = para_md_input + para_md_bounds[ next ];
+    size_t const size = para_md_bounds[ next + 1 ] - para_md_bounds[ next ];
+    char const *const nl = memchr( line, '\n', size );
+    size_t const line_size =
+      nl != NULL ? STATIC_CAST( size_t, nl - line ) + 1 : size;
+    if ( !markdown_is_initial( &ctx->md_parser, line, line_size ) ) {
+      reader_extend( stdin, size );
+      ++*absorbed;
+      return true;
+    }
+  }
+
+  FREE( para_md_bounds );
+  para_md_bounds = NULL;                // the check is done only once
+  return false;
+}
+
+/**
+ * Checks whether \a line starts or ends a Markdown code fence.
+ *
+ * @param line The line to check.
+ * @param size The number of characters of \a line.
+ * @return Returns `true` only if \a line starts with at most 3 spaces
+ * followed by at least 3 of either <tt>`</tt> or `~`.
+ */
+NODISCARD
+static bool para_md_is_fence( char const *line, size_t size ) {
+  assert( line != NULL );
+  size_t i = 0;
+  while ( i < 3 && i < size && line[i] == ' ' )
+    ++i;
+  if ( i == size || (line[i] != '`' && line[i] != '~') )
+    return false;
+  char const c = line[i];
+  size_t n = 0;
+  for ( ; i < size && line[i] == c; ++i )
+    ++n;
+  return n >= 3;
+}
+
+/**
+ * Checks whether the options, other than Markdown, don't carry state from one
+ * paragraph to the next so that Markdown can be reformatted in parallel
+ * speculatively.
+ *
+ * @return Returns `true` only if Markdown can be reformatted in parallel.
+ *
+ * @sa para_is_independent()
+ */
+NODISCARD
+static bool para_md_is_independent( void ) {
+#ifdef WITH_PARA_MARKDOWN
+  return  opt_markdown && !opt_data_link_esc && !opt_doxygen &&
+          opt_lines_first == 0 && !opt_prototype && opt_newlines_delimit <= 2;
+#else
+  return false;
+#endif /* WITH_PARA_MARKDOWN */
+}
+
+/**
+ * Checks whether \a line, that doesn't start with whitespace, starts a
+ * Markdown list item (including a definition list one).
+ *
+ * @param line The line to check.
+ * @param size The number of characters of \a line.
+ * @return Returns `true` only if \a line starts a list item.
+ */
+NODISCARD
+static bool para_md_is_list_item( char const *line, size_t size ) {
+  assert( line != NULL );
+  size_t i = 0;
+  if ( size > 0 && line[0] != '\0' && strchr( "*+-:", line[0] ) != NULL ) {
+    i = 1;
+  } else {
+    while ( i < size && isdigit( STATIC_CAST( unsigned char, line[i] ) ) )
+      ++i;
+    if ( i == 0 || i == size || (line[i] != '.' && line[i] != ')') )
+      return false;
+    ++i;
+  }
+  return i == size || line[i] == ' ' || line[i] == '\t' || line[i] == '\n';
+}
+
+/**
+ * The \ref writer_fn_t that appends the output of reformatting a paragraph to
+ * a \ref para_out.
+ *
+ * @param s The output.
+ * @param len The length of \a s.
+ * @param data A pointer to the \ref para_out.
+ */
+static void para_out_write( char const *s, size_t len, void *data ) {
+  para_out_t *const out = data;
+  line_buf_reserve( &out->buf, out->len + len );
+  memcpy( out->buf.str + out->len, s, len );
+  out->len += len;
+}
+
+/**
+ * Writes all the output a \ref para_job has held to standard output via a
+ * single **writev**(2), if requested, and frees it.
+ *
+ * @param job The \ref para_job whose output to flush.
+ * @param is_write If `true`, write the output; if `false`, discard it.
+ * @return Returns the number of characters freed.
+ */
+static size_t para_job_flush( para_job_t *job, bool is_write ) {
+  assert( job != NULL );
+  if ( job->pages == NULL )
+    return 0;
+
+  if ( is_write ) {
+    struct iovec *const iov = MALLOC( struct iovec, job->pages_len );
+    size_t iov_len = 0;
+    for ( para_page_t *page = job->pages; page != NULL; page = page->next )
+      iov[ iov_len++ ] = (struct iovec){ page->buf, page->len };
+    writev_all( STDOUT_FILENO, iov, iov_len );
+    FREE( iov );
+  }
+
+  size_t freed = 0;
+  for ( para_page_t *page = job->pages, *next; page != NULL; page = next ) {
+    next = page->next;
+    freed += page->len;
+    page->next = para_pages_free;
+    para_pages_free = page;
+  } // for
+
+  job->pages = job->pages_tail = NULL;
+  job->pages_len = 0;
+  return freed;
+}
+
+/**
+ * Gets a \ref para_page, reusing one that para_job_flush() is done with, if
+ * any.  If huge pages are enabled, allocates as many pages at a time as fit in
+ * a huge page so the output being held is backed by them.
+ *
+ * @return Returns said page.
+ */
+static para_page_t* para_page_new( void ) {
+  if ( para_pages_free == NULL ) {
+    size_t const huge_size = huge_page_size();
+    size_t const n = huge_size / sizeof( para_page_t );
+    if ( n == 0 )
+      return MALLOC( para_page_t, 1 );
+    para_page_t *const pages = huge_alloc( huge_size );
+    for ( size_t i = n; i-- > 0; ) {
+      pages[i].next = para_pages_free;
+      para_pages_free = &pages[i];
+    } // for
+  }
+  para_page_t *const page = para_pages_free;
+  para_pages_free = page->next;
+  return page;
+}
+
+/**
+ * Reformats standard input in parallel, if possible.  When standard input is
+ * a large regular file and the options don't carry state from one paragraph
+ * to the next, splits it at paragraph boundaries into #PARA_CHUNKS_PER_JOB
+ * chunks per job and forks a child process to reformat each, up to
+ * \ref opt_jobs at a time, in order.  The parent copies the output of the
+ * earliest chunk not yet copied to standard output as it's written and holds
+ * that of later chunks until their turn, but no more than #PARA_REORDER_MAX
+ * characters: beyond that, it stops reading their output so their children
+ * block and no more are started until the earliest chunk is done.
+ *
+ * @remarks If reformatting in parallel, in the parent, this function never
+ * returns: it exits with the status of the first child that failed, if any.
+ * In each child, it returns so that **wrap**(1) proceeds as if only that
+ * child's chunk were its input.  Otherwise, it returns so that **wrap**(1)
+ * proceeds serially.
+ *
+ * @remarks Markdown carries state from one paragraph to the next, but usually
+ * not past a paragraph boundary at the top level, so it's split at those
+ * boundaries (see para_md_bounds_init()) and reformatted speculatively: if a
+ * child finds the Markdown parser isn't in its initial state at the end of
+ * its chunk after all, it absorbs the next chunk (see para_md_extend()) and
+ * the parent discards the output of the next chunk's own child.
+ *
+ * @remarks If the `WRAP_PARA_STATS` environment variable is affirmative, the
+ * parent prints the number of chunks, the most output it held, the number and
+ * duration of stalls (when it stopped reading output because of the limit),
+ * and the number of chunks absorbed to standard error to help tune
+ * #PARA_CHUNKS_PER_JOB and #PARA_REORDER_MAX.
+ *
+ * @sa para_boundary()
+ */
+static void para_fork( void ) {
+  bool const is_md = para_md_is_independent();
+  if ( !is_md && !para_is_independent() )
+    return;
+
+  size_t size;
+  char const *const s = reader_peek( stdin, &size );
+  if ( s == NULL )
+    return;
+
+  size_t jobs_max = opt_jobs;
+  if ( jobs_max == 0 ) {
+    long const cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    jobs_max = cpus > 0 ? STATIC_CAST( size_t, cpus ) : 1;
+  }
+  size_t chunks = jobs_max * PARA_CHUNKS_PER_JOB;
+  if ( chunks > size / PARA_CHUNK_SIZE_MIN )
+    chunks = size / PARA_CHUNK_SIZE_MIN;
+  if ( chunks < 2 || jobs_max < 2 )
+    return;
+
+  size_t *const bounds = MALLOC( size_t, chunks + 1 );
+  bounds[0] = 0;
+  bounds[ chunks ] = size;
+  if ( is_md ) {
+    para_md_bounds_init( s, size, bounds, chunks );
+#ifdef WITH_PARA_MARKDOWN
+    para_md_absorbed = mmap(
+      NULL, chunks * sizeof( size_t ), PROT_READ | PROT_WRITE,
+      MAP_ANONYMOUS | MAP_SHARED, -1, 0
+    );
+    PERROR_EXIT_IF( para_md_absorbed == MAP_FAILED, EX_OSERR );
+#endif /* WITH_PARA_MARKDOWN */
+  } else {
+    for ( size_t i = 1; i < chunks; ++i )
+      bounds[i] = para_boundary( s, size, size / chunks * i );
+  }
+
+  para_job_t *const jobs = MALLOC( para_job_t, chunks );
+  struct pollfd *const pfds = MALLOC( struct pollfd, jobs_max );
+  size_t *const pfd_jobs = MALLOC( size_t, jobs_max );
+  size_t *const slots = MALLOC( size_t, jobs_max );  // free, lowest last
+  size_t slots_len = jobs_max;
+  for ( size_t i = 0; i < jobs_max; ++i )
+    slots[i] = jobs_max - 1 - i;
+
+  bool const is_stats = is_affirmative( getenv( "WRAP_PARA_STATS" ) );
+  size_t    held = 0, held_max = 0;     // output held until its turn
+  size_t    head = 0;                   // earliest chunk not yet copied
+  size_t    next = 0;                   // next chunk to start
+  size_t    running = 0;                // children not yet at EOF
+  size_t    stalls = 0;
+  uint64_t  stall_ns = 0, stall_start_ns = 0;
+  size_t    absorbed = 0;               // chunks absorbed by others
+  int       exit_status = EX_OK;
+
+  PERROR_EXIT_IF( fflush( stdout ) != 0, EX_IOERR );
+
+  while ( head < next || (next < chunks && exit_status == EX_OK) ) {
+    while ( next < chunks && running < jobs_max && held < PARA_REORDER_MAX &&
+            exit_status == EX_OK ) {
+      int pipe_fds[2];
+      PIPE( pipe_fds );
+      size_t const slot = slots[ --slots_len ];
+      pid_t const pid = fork();
+      PERROR_EXIT_IF( pid == -1, EX_OSERR );
+      if ( pid == 0 ) {                 // child
+        job_pin( slot );
+        close( pipe_fds[0] );
+        for ( size_t i = head; i < next; ++i ) {
+          if ( jobs[i].fd != -1 )
+            close( jobs[i].fd );
+        } // for
+        DUP2( pipe_fds[1], STDOUT_FILENO );
+        close( pipe_fds[1] );
+        reader_limit( stdin, bounds[ next ], bounds[ next + 1 ] - bounds[ next ] );
+        if ( is_md ) {
+          para_md_input = s;
+          para_md_bounds = bounds;
+          para_md_chunk = next;
+          para_md_chunks = chunks;
+        } else {
+          FREE( bounds );
         }
-        else if ( cp_is_hyphen_adjacent( cp_prev ) && cp_is_hyphen( cp ) ) {
+        FREE( jobs );
+        FREE( pfds );
+        FREE( pfd_jobs );
+        FREE( slots );
+        return;
+      }
+      close( pipe_fds[1] );
+      jobs[ next ] = (para_job_t){
+        .pid = pid, .fd = pipe_fds[0], .slot = slot
+      };
+      ++next;
+      ++running;
+    } // while
+
+    para_job_t *const hjob = &jobs[ head ];
+    if ( hjob->fd == -1 ) {             // earliest chunk is done
+      if ( exit_status == EX_OK )
+        exit_status = hjob->status;
+      if ( is_md ) {
+        //
+        // Discard the chunks the earliest chunk's child absorbed: their own
+        // children reformatted them from the wrong state.
+        //
+        size_t const end = head + 1 + para_md_absorbed[ head ];
+        absorbed += end - (head + 1);
+        for ( size_t i = head + 1; i < end && i < next; ++i ) {
+          para_job_t *const job = &jobs[i];
+          held -= para_job_flush( job, /*is_write=*/false );
+          if ( job->fd == -1 )
+            continue;
+          PJL_DISCARD_RV( kill( job->pid, SIGTERM ) );
+          close( job->fd );
+          job->fd = -1;
+          --running;
+          slots[ slots_len++ ] = job->slot;
+          int wait_status;
+          PERROR_EXIT_IF( waitpid( job->pid, &wait_status, 0 ) == -1, EX_OSERR );
+        } // for
+        if ( next < end )
+          next = end;
+        head = end - 1;
+      }
+      if ( ++head < next )
+        held -= para_job_flush( &jobs[ head ], exit_status == EX_OK );
+      continue;
+    }
+
+    //
+    // Always read the earliest chunk's output; read later chunks' output only
+    // while there's room to hold it.
+    //
+    nfds_t pfds_len = 0;
+    bool is_stalled = false;
+    for ( size_t i = head; i < next; ++i ) {
+      if ( jobs[i].fd == -1 )
+        continue;
+      if ( i > head && held >= PARA_REORDER_MAX ) {
+        is_stalled = true;
+        continue;
+      }
+      pfds[ pfds_len ] = (struct pollfd){ .fd = jobs[i].fd, .events = POLLIN };
+      pfd_jobs[ pfds_len++ ] = i;
+    } // for
+    if ( is_stats ) {
+      if ( is_stalled && stall_start_ns == 0 ) {
+        ++stalls;
+        stall_start_ns = now_ns();
+      } else if ( !is_stalled && stall_start_ns != 0 ) {
+        stall_ns += now_ns() - stall_start_ns;
+        stall_start_ns = 0;
+      }
+    }
+
+    if ( poll( pfds, pfds_len, /*timeout=*/-1 ) == -1 ) {
+      PERROR_EXIT_IF( errno != EINTR, EX_OSERR );
+      continue;
+    }
+    for ( nfds_t p = 0; p < pfds_len; ++p ) {
+      if ( pfds[p].revents == 0 )
+        continue;
+      para_job_t *const job = &jobs[ pfd_jobs[p] ];
+      //
+      // Read output to be held straight into its last page, adding one if
+      // need be; read anything else into a scratch buffer.
+      //
+      bool const is_held = job != hjob && exit_status == EX_OK;
+      if ( is_held && (job->pages_tail == NULL ||
+                       job->pages_tail->len == PARA_PAGE_SIZE) ) {
+        para_page_t *const page = para_page_new();
+        page->next = NULL;
+        page->len = 0;
+        if ( job->pages_tail == NULL )
+          job->pages = page;
+        else
+          job->pages_tail->next = page;
+        job->pages_tail = page;
+        ++job->pages_len;
+      }
+      char chunk[ PARA_PAGE_SIZE ];
+      char *const dst = is_held ?
+        job->pages_tail->buf + job->pages_tail->len : chunk;
+      size_t const dst_size = is_held ?
+        PARA_PAGE_SIZE - job->pages_tail->len : sizeof chunk;
+      ssize_t const n = read( job->fd, dst, dst_size );
+      if ( n == -1 ) {
+        PERROR_EXIT_IF( errno != EINTR, EX_IOERR );
+        continue;
+      }
+      if ( n == 0 ) {
+        close( job->fd );
+        job->fd = -1;
+        --running;
+        slots[ slots_len++ ] = job->slot;
+        int wait_status;
+        PERROR_EXIT_IF( waitpid( job->pid, &wait_status, 0 ) == -1, EX_OSERR );
+        job->status = WIFEXITED( wait_status ) ?
+          WEXITSTATUS( wait_status ) : EX_SOFTWARE;
+        continue;
+      }
+      size_t const len = STATIC_CAST( size_t, n );
+      if ( exit_status != EX_OK )
+        continue;                       // just drain it
+      if ( !is_held ) {
+        write_all( STDOUT_FILENO, chunk, len );
+        continue;
+      }
+      job->pages_tail->len += len;
+      held += len;
+      if ( held > held_max )
+        held_max = held;
+    } // for
+  } // while
+
+  if ( is_stats ) {
+    EPRINTF(
+      "%s: para: chunks=%zu jobs=%zu held_max=%zu stalls=%zu stall=%.9f"
+      " absorbed=%zu\n",
+      me, chunks, jobs_max, held_max, stalls,
+      STATIC_CAST( double, stall_ns ) / 1e9, absorbed
+    );
+  }
+
+  FREE( bounds );
+  FREE( jobs );
+  FREE( pfds );
+  FREE( pfd_jobs );
+  FREE( slots );
+  exit( exit_status );
+}
+
+/**
+ * Prints the leading characters for lines.  The lead tabs and spaces are
+ * composed into \ref wrap_ctx::lead_buf only when they change (e.g., by
+ * Markdown) rather than for every line.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void put_lead_chars( wrap_ctx_t *ctx ) {
+  if ( unlikely( ctx->measure_fn != NULL ) ) {
+    //
+    // Leading characters alone (as for a blank line) don't make a line.
+    //
+    if ( ctx->output_len > 0 )
+      ctx->measure_line_width += measure_lead_width( ctx );
+    return;
+  }
+  if ( ctx->proto_len > 0 ) {
+    writer_write( &ctx->wout, ctx->proto_buf.str, ctx->proto_len );
+    if ( ctx->output_len > 0 )
+      writer_write( &ctx->wout, ctx->proto_tws.str, ctx->proto_tws_len );
+    return;
+  }
+  if ( ctx->output_len == 0 )
+    return;
+  size_t const tabs = ctx->opt.lead_tabs, spaces = ctx->opt.lead_spaces;
+  if ( unlikely( tabs != ctx->lead_tabs || spaces != ctx->lead_spaces ) ) {
+    line_buf_reserve( &ctx->lead_buf, tabs + spaces );
+    memset( ctx->lead_buf.str, '\t', tabs );
+    memset( ctx->lead_buf.str + tabs, ' ', spaces );
+    ctx->lead_tabs = tabs;
+    ctx->lead_spaces = spaces;
+  }
+  writer_write( &ctx->wout, ctx->lead_buf.str, tabs + spaces );
+}
+
+/**
+ * Prints the current output buffer as a line and resets the output buffer's
+ * length and spans.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param len The length of the output buffer.
+ * @param do_eol If `true`, prints and end-of-line afterwards.
+ */
+static void put_line( wrap_ctx_t *ctx, size_t len, bool do_eol ) {
+  if ( len > 0 && unlikely( ctx->measure_fn != NULL ) ) {
+    size_t width = ctx->output_width;
+    for ( size_t k = ctx->spans.len;
+          k > 0 && ctx->spans.spans[ k - 1 ].offset >= len; --k ) {
+      word_span_t const *const span = &ctx->spans.spans[ k - 1 ];
+      width -= span->gap + span->width;
+    } // for
+    if ( ctx->opt.justify && do_eol && len < ctx->output_len &&
+         width < ctx->line_width ) {
+      width = ctx->line_width - 1;
+    }
+    ctx->measure_line_width += width;
+    if ( do_eol )
+      put_eol( ctx );
+  } else if ( len > 0 ) {
+    if ( ctx->opt.justify && do_eol && len < ctx->output_len ) {
+      //
+      // The line is being wrapped (rather than ending the paragraph), so
+      // justify it: the spans that start before len are those of the line.
+      //
+      size_t spans_end = ctx->spans.len;
+      size_t width = ctx->output_width;
+      while ( spans_end > 0 &&
+              ctx->spans.spans[ spans_end - 1 ].offset >= len ) {
+        word_span_t const *const span = &ctx->spans.spans[ --spans_end ];
+        width -= span->gap + span->width;
+      } // while
+      size_t const pad =
+        width < ctx->line_width ? ctx->line_width - 1 - width : 0;
+      put_spans( ctx, 0, 0, spans_end, pad );
+    } else {
+      writer_write( &ctx->wout, ctx->output_buf.str, len );
+    }
+    if ( do_eol )
+      put_eol( ctx );
+  }
+  ctx->output_len = ctx->output_width = 0;
+  span_list_clear( &ctx->spans );
+}
+
+/**
+ * Prints the rows of the Markdown table collected by markdown_adjust(), if
+ * any, with its columns aligned.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void put_md_table( wrap_ctx_t *ctx ) {
+  if ( ctx->md_table.rows_len == 0 )
+    return;
+  size_t const len = md_table_format( &ctx->md_table, &ctx->md_table_buf );
+  writer_write( &ctx->wout, ctx->md_table_buf.str, len );
+}
+
+/**
+ * Prints the current output buffer as lines wrapped so as to minimize
+ * raggedness.  Spans that aren't printed are moved to the start of the output
+ * buffer after the hang-indent; if all are printed, resets the output buffer's
+ * length and spans.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param spans_end The number of spans (from the first) to wrap.  Spans after
+ * those are never printed.
+ * @param commit_max The maximum number of spans to print: lines are printed
+ * (in order) only so long as they end at or before it, except the first line
+ * is printed regardless unless it's the only line.
+ *
+ * @sa span_break_optimal()
+ */
+static void put_optimal( wrap_ctx_t *ctx, size_t spans_end,
+                         size_t commit_max ) {
+  assert( spans_end > 0 );
+  assert( spans_end <= ctx->spans.len );
+
+  //
+  // Whatever precedes the first span is the first line's indentation.
+  //
+  size_t first_indent = ctx->output_width;
+  for ( size_t k = 0; k < ctx->spans.len; ++k )
+    first_indent -=
+      (k > 0 ? ctx->spans.spans[k].gap : 0) + ctx->spans.spans[k].width;
+
+  span_list_t const wrapped = { .spans = ctx->spans.spans, .len = spans_end };
+  size_t lines_len;
+  size_t *const starts = span_break_optimal(
+    &wrapped, first_indent, hang_width( ctx ), ctx->line_width - 1, &lines_len
+  );
+
+  size_t printed_end = 0;
+  for ( size_t line = 0; line < lines_len; ++line ) {
+    size_t const end = line + 1 < lines_len ? starts[ line + 1 ] : spans_end;
+    if ( end > commit_max && (line > 0 || lines_len == 1) )
+      break;
+    size_t const start = starts[ line ];
+    size_t from = 0;
+    put_lead_chars( ctx );
+    if ( line > 0 ) {
+      if ( ctx->spans.spans[ start ].gap > 0 )
+        ++ctx->stats.wraps_space;
+      else
+        ++ctx->stats.wraps_hyphen;
+      from = ctx->spans.spans[ start ].offset;
+      if ( ctx->measure_fn == NULL ) {
+        for ( size_t i = 0; i < ctx->opt.hang_tabs; ++i )
+          writer_putc( &ctx->wout, '\t' );
+        for ( size_t i = 0; i < ctx->opt.hang_spaces; ++i )
+          writer_putc( &ctx->wout, ' ' );
+      }
+    }
+    size_t pad = 0, width = 0;
+    if ( ctx->measure_fn != NULL ||
+         (ctx->opt.justify && end < ctx->spans.len) ) {
+      width = line > 0 ? hang_width( ctx ) : first_indent;
+      for ( size_t k = start; k < end; ++k )
+        width +=
+          (k > start ? ctx->spans.spans[k].gap : 0) + ctx->spans.spans[k].width;
+      if ( ctx->opt.justify && end < ctx->spans.len &&
+           width < ctx->line_width ) {
+        pad = ctx->line_width - 1 - width;
+      }
+    }
+    if ( ctx->measure_fn != NULL )
+      ctx->measure_line_width += width + pad;
+    else
+      put_spans( ctx, from, start, end, pad );
+    put_eol( ctx );
+    printed_end = end;
+  } // for
+  FREE( starts );
+
+  if ( printed_end == ctx->spans.len ) {
+    ctx->output_len = ctx->output_width = 0;
+    span_list_clear( &ctx->spans );
+    return;
+  }
+
+  //
+  // Move the spans that weren't printed to the start of output_buf after the
+  // hang-indent.
+  //
+  word_span_t *const kept = ctx->spans.spans + printed_end;
+  size_t const kept_len = ctx->spans.len - printed_end;
+  size_t const from = kept[0].offset;
+  size_t const hang_len = ctx->opt.hang_tabs + ctx->opt.hang_spaces;
+  line_buf_reserve( &ctx->output_buf, hang_len + ctx->output_len - from );
+  memmove(
+    ctx->output_buf.str + hang_len, ctx->output_buf.str + from,
+    ctx->output_len - from
+  );
+  memset( ctx->output_buf.str, '\t', ctx->opt.hang_tabs );
+  memset( ctx->output_buf.str + ctx->opt.hang_tabs, ' ', ctx->opt.hang_spaces );
+  ctx->output_len = hang_len + ctx->output_len - from;
+
+  ctx->output_width = hang_width( ctx );
+  kept[0].gap = 0;
+  for ( size_t k = 0; k < kept_len; ++k ) {
+    kept[k].offset = kept[k].offset - from + hang_len;
+    ctx->output_width += kept[k].gap + kept[k].width;
+  } // for
+  memmove( ctx->spans.spans, kept, kept_len * sizeof *kept );
+  ctx->spans.len = kept_len;
+}
+
+/**
+ * Prints the characters of the output buffer from \a from through the end of
+ * the last of the spans [\a first, \a end), distributing \a pad additional
+ * spaces as evenly as possible among the spaces between them.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param from The offset into the output buffer to start printing at.
+ * @param first The index of the first span to print.
+ * @param end One past the index of the last span to print.
+ * @param pad The number of additional spaces to distribute; the spaces after
+ * the leftmost words get one fewer when they can't be distributed evenly.
+ */
+static void put_spans( wrap_ctx_t *ctx, size_t from, size_t first,
+                       size_t end, size_t pad ) {
+  assert( first < end );
+  assert( end <= ctx->spans.len );
+
+  //
+  // Only spaces after a word (that is not after indentation only) can be
+  // padded; a span with a gap of 0 follows a hyphen.
+  //
+  size_t gaps = 0;
+  if ( pad > 0 ) {
+    for ( size_t k = first + 1; k < end; ++k )
+      gaps += ctx->spans.spans[k].gap > 0 && ctx->spans.spans[ k - 1 ].len > 0;
+  }
+  size_t const pad_each = gaps > 0 ? pad / gaps : 0;
+  size_t const pad_rem  = gaps > 0 ? pad % gaps : 0;
+
+  if ( gaps > 0 ) {
+    for ( size_t k = first + 1; k < end; ++k ) {
+      word_span_t const *const span = &ctx->spans.spans[k];
+      if ( span->gap == 0 || span[-1].len == 0 )
+        continue;
+      --gaps;
+      size_t const to = span->offset - span->gap;
+      writer_write( &ctx->wout, ctx->output_buf.str + from, to - from );
+      for ( size_t i = span->gap + pad_each + (gaps < pad_rem); i > 0; --i )
+        writer_putc( &ctx->wout, ' ' );
+      from = span->offset;
+    } // for
+  }
+
+  word_span_t const *const last = &ctx->spans.spans[ end - 1 ];
+  writer_write(
+    &ctx->wout, ctx->output_buf.str + from, last->offset + last->len - from
+  );
+}
+
+/**
+ * Puts \a tabs tabs and \a spaces spaces (in that order) into the output
+ * buffer and increments the output width accordingly.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param tabs The number of tabs to put.
+ * @param spaces The number of spaces to put.
+ */
+static void put_tabs_spaces( wrap_ctx_t *ctx, size_t tabs, size_t spaces ) {
+  ctx->output_width += tabs * ctx->opt.tab_spaces + spaces;
+  line_buf_reserve( &ctx->output_buf, ctx->output_len + tabs + spaces );
+  char *const s = ctx->output_buf.str + ctx->output_len;
+  memset( s, '\t', tabs );
+  memset( s + tabs, ' ', spaces );
+  ctx->output_len += tabs + spaces;
+}
+
+/**
+ * The \ref wrap_block_fn_t for quoted e-mail: strips the line's quote prefix,
+ * e.g., `> > `, whose depth is the number of `>` in it, so the text is wrapped
+ * as if it weren't quoted.  A change of depth delimits the paragraph.  An
+ * unquoted signature (the lines after a `-- ` line) is printed as-is since its
+ * lines are almost never meant to be joined.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the line should be wrapped.
+ */
+NODISCARD
+static bool quote_adjust( wrap_ctx_t *ctx ) {
+  char *const s = ctx->input_buf.str;
+  size_t depth = 0, n = 0;
+  while ( s[n] == '>' ) {
+    ++depth;
+    if ( s[ ++n ] == ' ' )
+      ++n;
+  } // while
+
+  bool const is_sig = depth == 0 &&
+    (ctx->quote_in_sig || strcmp( s, "-- \n" ) == 0 ||
+     strcmp( s, "-- \r\n" ) == 0);
+  ctx->quote_in_sig = is_sig;
+
+  if ( depth != ctx->quote_depth || is_sig ) {
+    ctx->consec_newlines = 0;
+    delimit_paragraph( ctx );
+    //
+    // So a blank line after it is printed as the paragraph delimiter it is.
+    //
+    ctx->consec_newlines = 1;
+    if ( depth != ctx->quote_depth )
+      quote_set_depth( ctx, depth );
+    if ( is_sig ) {
+      writer_write( &ctx->wout, s, ctx->input_buf.len );
+      return false;
+    }
+  }
+
+  if ( n > 0 ) {
+    ctx->input_buf.len -= n;
+    memmove( s, s + n, ctx->input_buf.len + 1 /* null */ );
+  }
+  return true;
+}
+
+/**
+ * Sets the e-mail quote depth of the lines to print: they're prefixed by that
+ * many `>` followed by a space that's omitted from otherwise empty lines.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param depth The quote depth.
+ */
+static void quote_set_depth( wrap_ctx_t *ctx, size_t depth ) {
+  ctx->quote_depth = depth;
+  line_buf_reserve( &ctx->proto_buf, depth );
+  memset( ctx->proto_buf.str, '>', depth );
+  ctx->proto_buf.str[ depth ] = '\0';
+  ctx->proto_len = depth;
+  ctx->proto_tws.str[0] = ' ';
+  ctx->proto_tws_len = depth > 0;
+
+  size_t const width = depth > 0 ? depth + 1 : 0;
+  ctx->line_width = width + LINE_WIDTH_MINIMUM <= ctx->opt.line_width ?
+    ctx->opt.line_width - width : LINE_WIDTH_MINIMUM;
+}
+
+/**
+ * Adds the statistics of another context to those of \a to.
+ *
+ * @param to The statistics to add to.
+ * @param from The statistics to add.
+ */
+static void stats_add( wrap_stats_t *to, wrap_stats_t const *from ) {
+  static size_t const N = sizeof( wrap_stats_t ) / sizeof( uint64_t );
+  uint64_t *const to_n = POINTER_CAST( uint64_t*, to );
+  uint64_t const *const from_n = POINTER_CAST( uint64_t const*, from );
+  for ( size_t i = 0; i < N; ++i )
+    to_n[i] += from_n[i];
+}
+
+/**
+ * Raises the peak memory of each subsystem of \a ctx in its \ref wrap_stats
+ * to what it's using now.  Only memory that belongs to \a ctx is counted:
+ * that shared by all contexts is counted by wrap_stats_print().
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void stats_mem( wrap_ctx_t *ctx ) {
+  md_table_t const *const t = &ctx->md_table;
+  wrap_stats_t *const s = &ctx->stats;
+  size_t total = 0;
+
+  total += stats_peak( &s->mem_input,
+    ctx->feed_buf.cap + ctx->input_buf.cap
+  );
+  total += stats_peak( &s->mem_output,
+    ctx->output_buf.cap + ctx->spans.cap * sizeof( word_span_t ) +
+    ctx->lead_buf.cap + writer_mem( &ctx->wout )
+  );
+  total += stats_peak( &s->mem_regex,
+    ctx->nonws_no_wrap_ranges.cap * sizeof( size_t[2] ) +
+    ctx->nonws_no_wrap_words.cap / 8 /* bits */
+  );
+  total += stats_peak( &s->mem_markdown,
+    ctx->md_parser.spill_cap * sizeof( md_state_t ) +
+    ctx->md_no_wrap_ranges.cap * sizeof( size_t[2] ) +
+    ctx->md_table_buf.cap + t->text.cap +
+    t->cells_cap * sizeof( md_table_cell_t ) +
+    t->rows_cap * sizeof( md_table_row_t ) +
+    t->cols_cap * (sizeof( size_t ) + sizeof( md_table_align_t ))
+  );
+  stats_peak( &s->mem_total, total );
+}
+
+/**
+ * Notes that the paragraph started by stats_para_start() has been delimited:
+ * if it's among the \ref opt_stats_paras costliest so far, adds it to \ref
+ * stats_paras keeping them costliest first.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void stats_para_end( wrap_ctx_t *ctx ) {
+  assert( ctx->para_ns != 0 );
+  wrap_stats_t const *const from = &ctx->para_stats;
+  wrap_stats_t const *const to = &ctx->stats;
+  para_cost_t const cost = {
+    .ns = now_ns() - ctx->para_ns,
+    .offset = from->bytes_in,
+    .line_first = from->lines_in + 1,
+    .line_last = to->lines_in,
+    .bytes = to->bytes_in - from->bytes_in,
+    .regex_calls = (to->block_regex_calls - from->block_regex_calls) +
+                   (to->uri_regex_calls - from->uri_regex_calls),
+    .md_line_type = ctx->para_md_line_type,
+    .md_depth = ctx->para_md_depth
+  };
+  ctx->para_ns = 0;
+
+  if ( stats_paras == NULL )
+    stats_paras = MALLOC( para_cost_t, opt_stats_paras );
+  size_t i = stats_paras_len;
+  if ( i == opt_stats_paras ) {
+    if ( cost.ns <= stats_paras[ i - 1 ].ns )
+      return;
+    --i;                                // replace the cheapest
+  } else {
+    ++stats_paras_len;
+  }
+  for ( ; i > 0 && stats_paras[ i - 1 ].ns < cost.ns; --i )
+    stats_paras[i] = stats_paras[ i - 1 ];
+  stats_paras[i] = cost;
+}
+
+/**
+ * Checks whether standard input is already formatted, i.e., that reformatting
+ * it wouldn't change it, then exits with either `EX_OK` if so or
+ * #CHECK_EX_UNFORMATTED if not as soon as a difference is found.  Nothing is
+ * written.
+ *
+ * @remarks When paragraphs can be reformatted separately, those that
+ * check_is_wrapped() can tell are already formatted aren't reformatted.
+ */
+static void stdin_check( void ) {
+  size_t size;
+  char *buf;
+  char const *const s = stdin_slurp( &size, &buf );
+
+  check_in_t in = { .s = s, .size = size };
+  wrap_ctx_t check_ctx;
+  wrap_ctx_init( &check_ctx, &check_write, &in );
+  stdin_sub_ctx = &check_ctx;           // check_write() may exit early
+
+  if ( para_is_independent() ) {
+    eol_t const eol = stdin_eol();
+    bool const can_scan = check_can_scan( eol );
+    for ( size_t pos = 0; pos < size; ) {
+      size_t const end = para_boundary( s, size, pos );
+      if ( can_scan && check_is_wrapped( s + pos, end - pos ) ) {
+        check_write( s + pos, end - pos, &in );
+      } else {
+        check_ctx.opt.eol = eol;
+        wrap_feed( &check_ctx, s + pos, end - pos );
+        wrap_finish( &check_ctx );
+        wrap_ctx_reset( &check_ctx );
+      }
+      pos = end;
+    } // for
+  } else {
+    wrap_feed( &check_ctx, s, size );
+    wrap_finish( &check_ctx );
+  }
+
+  wrap_ctx_cleanup( &check_ctx );
+  free( buf );
+  exit( in.pos == size ? EX_OK : CHECK_EX_UNFORMATTED );
+}
+
+/**
+ * Copies the blank lines, if any, at the current position of standard input
+ * verbatim.
+ *
+ * @param ctx The \ref wrap_ctx to write the lines via.
+ * @param lines_max The maximum number of lines to copy.
+ * @return Returns the number of lines copied.
+ */
+static size_t stdin_copy_blank( wrap_ctx_t *ctx, size_t lines_max ) {
+  size_t copied = 0;
+  while ( copied < lines_max ) {
+    size_t lines = 1, size;
+    char const *const s = reader_getlines( stdin, &lines, &size );
+    if ( s == NULL )
+      break;
+    size_t i = 0;
+    while ( i < size && (is_space( s[i] ) || is_eol( s[i] )) )
+      ++i;
+    //
+    // If lines is still 1, only part of a (long) line was gotten.
+    //
+    if ( lines > 0 || i < size ) {
+      reader_unget( stdin, size );
+      break;
+    }
+    writer_write( &ctx->wout, s, size );
+    ++copied;
+  } // while
+  return copied;
+}
+
+/**
+ * Writes a unified diff of standard input and its reformatted output of only
+ * the paragraphs that would change, then exits with either `EX_OK` if none
+ * would or #CHECK_EX_UNFORMATTED if any would.
+ *
+ * @param ctx The \ref wrap_ctx to write the diff via.
+ *
+ * @remarks When paragraphs can be reformatted separately, each is reformatted
+ * and diffed in turn (and those that check_is_wrapped() can tell are already
+ * formatted aren't reformatted) so that each that changes gets its own hunk.
+ * Otherwise, the input is reformatted all at once and diffed as a whole.
+ */
+static void stdin_diff( wrap_ctx_t *ctx ) {
+  size_t size;
+  char *buf;
+  char const *const s = stdin_slurp( &size, &buf );
+
+  diff_out_t diff = { .w = &ctx->wout };
+  para_out_t out = { 0 };
+  line_buf_init( &out.buf );
+  wrap_ctx_t diff_ctx;
+  wrap_ctx_init( &diff_ctx, &para_out_write, &out );
+  stdin_sub_ctx = &diff_ctx;
+
+  if ( para_is_independent() ) {
+    eol_t const eol = stdin_eol();
+    bool const can_scan = check_can_scan( eol );
+    for ( size_t pos = 0; pos < size; ) {
+      size_t const end = para_boundary( s, size, pos );
+      if ( can_scan && check_is_wrapped( s + pos, end - pos ) ) {
+        diff_chunk( &diff, s + pos, end - pos, s + pos, end - pos );
+      } else {
+        diff_ctx.opt.eol = eol;
+        out.len = 0;
+        wrap_feed( &diff_ctx, s + pos, end - pos );
+        wrap_finish( &diff_ctx );
+        wrap_ctx_reset( &diff_ctx );
+        diff_chunk( &diff, s + pos, end - pos, out.buf.str, out.len );
+      }
+      pos = end;
+    } // for
+  } else {
+    wrap_feed( &diff_ctx, s, size );
+    wrap_finish( &diff_ctx );
+    diff_chunk( &diff, s, size, out.buf.str, out.len );
+  }
+
+  wrap_ctx_cleanup( &diff_ctx );
+  line_buf_cleanup( &out.buf );
+  free( buf );
+  writer_flush( &ctx->wout );
+  exit( diff.differs ? CHECK_EX_UNFORMATTED : EX_OK );
+}
+
+/**
+ * Reformats standard input until EOF, then exits, but writes only the edits
+ * that would turn the input into the output (as edits_chunk() does) rather
+ * than the output itself so that, e.g., an editor can apply just them instead
+ * of replacing all the text.  Edits are written in order of their offsets
+ * that are those within the original input.
+ *
+ * @param ctx The \ref wrap_ctx to use.  Its output must already have been
+ * initialized.
+ *
+ * @sa stdin_run()
+ */
+static void stdin_edits( wrap_ctx_t *ctx ) {
+  size_t size;
+  char *buf;
+  char const *const s = stdin_slurp( &size, &buf );
+
+  edits_out_t edits = { .w = &ctx->wout };
+  para_out_t out = { 0 };
+  line_buf_init( &out.buf );
+  wrap_ctx_t edits_ctx;
+  wrap_ctx_init( &edits_ctx, &para_out_write, &out );
+  stdin_sub_ctx = &edits_ctx;
+
+  if ( para_is_independent() ) {
+    eol_t const eol = stdin_eol();
+    bool const can_scan = check_can_scan( eol );
+    for ( size_t pos = 0; pos < size; ) {
+      size_t const end = para_boundary( s, size, pos );
+      if ( !can_scan || !check_is_wrapped( s + pos, end - pos ) ) {
+        edits_ctx.opt.eol = eol;
+        out.len = 0;
+        wrap_feed( &edits_ctx, s + pos, end - pos );
+        wrap_finish( &edits_ctx );
+        wrap_ctx_reset( &edits_ctx );
+        edits_chunk( &edits, pos, s + pos, end - pos, out.buf.str, out.len );
+      }
+      pos = end;
+    } // for
+  } else {
+    wrap_feed( &edits_ctx, s, size );
+    wrap_finish( &edits_ctx );
+    edits_chunk( &edits, 0, s, size, out.buf.str, out.len );
+  }
+
+  wrap_ctx_cleanup( &edits_ctx );
+  line_buf_cleanup( &out.buf );
+  json_buf_cleanup( &edits.buf );
+  free( buf );
+  writer_flush( &ctx->wout );
+  exit( EX_OK );
+}
+
+/**
+ * Gets the end-of-lines to use for the output of standard input when its
+ * paragraphs are reformatted separately, i.e., resolved from all of the input
+ * up front.
+ *
+ * @return Returns either #EOL_UNIX or #EOL_WINDOWS.
+ */
+static eol_t stdin_eol( void ) {
+  if ( opt_eol != EOL_INPUT )
+    return opt_eol;
+  return reader_eol( stdin ) == EOL_WINDOWS ? EOL_WINDOWS : EOL_UNIX;
+}
+
+/**
+ * Reformats standard input until EOF, then exits, as it arrives, e.g., from
+ * `tail -f`: whenever no more input has arrived for \ref opt_follow
+ * milliseconds, the current paragraph is ended as if a blank line had been
+ * read (but without printing one) and the output is flushed so that it lags
+ * the input by a bounded amount of time.  A line that hasn't been ended by a
+ * newline yet is held until it is.
+ *
+ * @param ctx The \ref wrap_ctx to use.  Its output must already have been
+ * initialized.
+ *
+ * @sa stdin_run()
+ */
+static void stdin_follow( wrap_ctx_t *ctx ) {
+  ctx->fin = NULL;                      // input is given via wrap_feed()
+  char *const buf = MALLOC( char, READER_BUF_SIZE );
+  bool is_pending = false;              // output since last idle flush?
+
+  for (;;) {
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    int const timeout = is_pending ? STATIC_CAST( int, opt_follow ) : -1;
+    int const n = poll( &pfd, 1, timeout );
+    if ( n == -1 ) {
+      PERROR_EXIT_IF( errno != EINTR, EX_OSERR );
+      continue;
+    }
+    if ( n == 0 ) {                     // idle: end the paragraph so far
+      if ( ctx->output_len > 0 || ctx->is_long_line ) {
+        ctx->consec_newlines = 0;
+        delimit_paragraph( ctx );
+      }
+      writer_flush( &ctx->wout );
+      is_pending = false;
+      continue;
+    }
+
+    ssize_t const bytes_read = read( STDIN_FILENO, buf, READER_BUF_SIZE );
+    if ( bytes_read == -1 ) {
+      PERROR_EXIT_IF( errno != EINTR, EX_IOERR );
+      continue;
+    }
+    if ( bytes_read == 0 )
+      break;
+    wrap_feed( ctx, buf, STATIC_CAST( size_t, bytes_read ) );
+    writer_flush( &ctx->wout );
+    is_pending = true;
+  } // for
+
+  free( buf );
+  wrap_finish( ctx );
+  exit( EX_OK );
+}
+
+/**
+ * Seeks standard input to the last paragraph boundary at or before line
+ * \a line_no in the index \ref opt_read_index written by
+ * stdin_index_write(), writing the input before it verbatim, so the lines
+ * before it needn't be scanned.  If standard input can't be memory-mapped or
+ * the index can't be used, does nothing.
+ *
+ * @param ctx The \ref wrap_ctx to write the input before the boundary via.
+ * @param line_no The number of the line to seek toward.
+ * @return Returns the number of the line standard input is now at.
+ */
+static size_t stdin_index_seek( wrap_ctx_t *ctx, size_t line_no ) {
+  assert( ctx != NULL );
+
+  size_t size;
+  char const *const s = reader_peek( stdin, &size );
+  struct stat st;
+  if ( s == NULL || fstat( fileno( stdin ), &st ) == -1 )
+    return 1;
+
+  size_t offset;
+  size_t const offset_line_no = para_index_find(
+    opt_read_index, size, STATIC_CAST( uint64_t, st.st_mtime ), line_no,
+    &offset
+  );
+  if ( offset > 0 ) {
+    writer_write( &ctx->wout, s, offset );
+    reader_limit( stdin, offset, size - offset );
+  }
+  return offset_line_no;
+}
+
+/**
+ * Writes the paragraph index \ref opt_write_index of standard input: the
+ * byte offset and line number of each paragraph boundary (see
+ * para_boundary()).  It's written while reformatting the input in full so
+ * that a later run reformatting only a range of lines of the same input via
+ * `--lines` and `--read-index` can seek to the last boundary before the range
+ * via stdin_index_seek() rather than scan every line before it.
+ *
+ * @note Standard input must be memory-mapped so the index can be written
+ * from its pages before they're reformatted rather than from a copy.
+ */
+static void stdin_index_write( void ) {
+  size_t size;
+  char const *const s = reader_peek( stdin, &size );
+  struct stat st;
+  if ( s == NULL || fstat( fileno( stdin ), &st ) == -1 ) {
+    fatal_error( EX_USAGE,
+      "%s: input must be an uncompressed regular file\n",
+      opt_format( COPT_WRITE_INDEX )
+    );
+  }
+
+  FILE *const findex = para_index_create(
+    opt_write_index, size, STATIC_CAST( uint64_t, st.st_mtime )
+  );
+  size_t line_no = 1;
+  for ( size_t pos = 0; pos < size; ) {
+    size_t const end = para_boundary( s, size, pos );
+    for ( char const *nl = s + pos;
+          (nl = memchr( nl, '\n', STATIC_CAST( size_t, s + end - nl ) ))
+            != NULL; ++nl ) {
+      ++line_no;
+    } // for
+    if ( end < size )
+      para_index_add( findex, end, line_no );
+    pos = end;
+  } // for
+  para_index_close( findex );
+}
+
+/**
+ * Measures standard input until EOF, then exits: for each paragraph, prints a
+ * line of the number of lines it takes and the width of its widest line when
+ * reformatted to each of \ref opt_widths (or just \ref opt_line_width), the
+ * pairs separated by tabs.  No text is printed.  The input is read only once;
+ * each chunk is measured for every width while it's still in the CPU's cache.
+ *
+ * @param ctx The \ref wrap_ctx whose output to print the measurements via.
+ *
+ * @sa stdin_run()
+ * @sa wrap_ctx_init_measure()
+ */
+static void stdin_measure( wrap_ctx_t *ctx ) {
+  size_t const widths_len = opt_widths_len > 0 ? opt_widths_len : 1;
+  wrap_ctx_t *const ctxs = MALLOC( wrap_ctx_t, widths_len );
+  measure_queue_t *const qs = MALLOC( measure_queue_t, widths_len );
+  size_t const line_width = opt_line_width;
+
+  for ( size_t i = 0; i < widths_len; ++i ) {
+    if ( opt_widths_len > 0 )
+      opt_line_width = opt_widths[i];   // ctx_init() reads it
+    qs[i] = (measure_queue_t){ 0 };
+    wrap_ctx_init_measure( &ctxs[i], &measure_add, &qs[i] );
+  } // for
+  opt_line_width = line_width;
+
+  reader_async( stdin );
+  for ( bool is_end = false; !is_end; ) {
+    size_t lines = SIZE_MAX, size;
+    char const *const s = reader_getlines( stdin, &lines, &size );
+    is_end = s == NULL;
+    for ( size_t i = 0; i < widths_len; ++i ) {
+      if ( is_end )
+        wrap_finish( &ctxs[i] );
+      else
+        wrap_feed( &ctxs[i], s, size );
+    } // for
+
+    //
+    // Every width sees the same paragraphs, but not all at the same time, so
+    // print only those all have measured so far.
+    //
+    size_t rows = qs[0].len;
+    for ( size_t i = 1; i < widths_len; ++i ) {
+      if ( qs[i].len < rows )
+        rows = qs[i].len;
+    } // for
+    if ( rows == 0 )
+      continue;
+    for ( size_t row = 0; row < rows; ++row ) {
+      for ( size_t i = 0; i < widths_len; ++i ) {
+        size_t const *const pair = qs[i].pairs + row * 2;
+        char buf[ 48 ];
+        int const len = snprintf( buf, sizeof buf, "%s%zu %zu",
+          i > 0 ? "\t" : "", pair[0], pair[1]
+        );
+        writer_write( &ctx->wout, buf, STATIC_CAST( size_t, len ) );
+      } // for
+      writer_putc( &ctx->wout, '\n' );
+    } // for
+    for ( size_t i = 0; i < widths_len; ++i ) {
+      qs[i].len -= rows;
+      memmove(
+        qs[i].pairs, qs[i].pairs + rows * 2, qs[i].len * 2 * sizeof( size_t )
+      );
+    } // for
+  } // for
+  FERROR( stdin );
+  writer_flush( &ctx->wout );
+
+  for ( size_t i = 0; i < widths_len; ++i ) {
+    wrap_ctx_cleanup( &ctxs[i] );
+    FREE( qs[i].pairs );
+  } // for
+  FREE( ctxs );
+  FREE( qs );
+  exit( EX_OK );
+}
+
+/**
+ * Only breaks the lines of standard input that are too long until EOF, then
+ * exits.  A line shorter than the line width is written as-is having only its
+ * width computed, so input that's mostly formatted already costs little and
+ * changes little.  A line that's too long is broken via minimal_break(); what
+ * remains is joined with the next line if it's non-blank and has the same
+ * leading whitespace (where reformatting would have put it) or is otherwise a
+ * line by itself.
+ *
+ * @param ctx The \ref wrap_ctx whose output to write via.
+ *
+ * @sa stdin_run()
+ */
+static void stdin_minimal( wrap_ctx_t *ctx ) {
+  line_buf_t carry;                     // remains of the line last broken
+  line_buf_init( &carry );
+  size_t carry_lead_len = 0;
+  char const *carry_eol = "";
+
+  reader_async( stdin );
+  for (;;) {
+    size_t size;
+    char const *s = reader_getline( stdin, SIZE_MAX, &size );
+    if ( s == NULL )
+      break;
+    size_t len = size;
+    char const *line_eol = "";
+    if ( len > 0 && s[ len - 1 ] == '\n' ) {
+      line_eol = len > 1 && s[ len - 2 ] == '\r' ? "\r\n" : "\n";
+      len -= strlen( line_eol );
+      if ( opt_eol != EOL_INPUT )
+        line_eol = eol();
+    }
+    size_t const lead_len = simd_ws_span( s, len );
+
+    if ( carry.len > 0 ) {
+      if ( lead_len < len && lead_len == carry_lead_len &&
+           memcmp( s, carry.str, lead_len ) == 0 ) {
+        size_t const join_len = len - lead_len;
+        char const last = carry.str[ carry.len - 1 ];
+        size_t const spaces =
+          cp_is_ascii( STATIC_CAST( char8_t, last ) ) &&
+          (cp_props( STATIC_CAST( char8_t, last ) ) & CP_PROP_EOS) != 0 &&
+          (last != '.' || !abbrev_ends( carry.str, carry.len - 1 )) ?
+            opt_eos_spaces : 1;
+        line_buf_reserve( &carry, carry.len + spaces + join_len );
+        memset( carry.str + carry.len, ' ', spaces );
+        carry.len += spaces;
+        memcpy( carry.str + carry.len, s + lead_len, join_len );
+        s = carry.str;
+        len = carry.len + join_len;
+      } else {
+        minimal_write( ctx, carry.str, carry.len, carry_eol );
+      }
+      carry.len = 0;
+    }
+
+    size_t const text_len = len - simd_ws_rspan( s, len );
+    //
+    // A line can't be wider than its number of characters except for tabs.
+    //
+    if ( (text_len < opt_line_width && memchr( s, '\t', text_len ) == NULL) ||
+         str_cols( s, text_len, 0 ) < opt_line_width ) {
+      minimal_write( ctx, s, len, line_eol );
+      continue;
+    }
+    size_t const rest = minimal_break( ctx, s, text_len, lead_len,
+      // the last line may lack an end-of-line, but all but its last part need
+      // one
+      *line_eol != '\0' ? line_eol :
+      stdin_eol() == EOL_WINDOWS ? "\r\n" : "\n"
+    );
+    if ( rest == 0 ) {
+      minimal_write( ctx, s, len, line_eol );
+      continue;
+    }
+    if ( s != carry.str ) {
+      line_buf_reserve( &carry, lead_len + text_len - rest );
+      memcpy( carry.str, s, lead_len );
+    }
+    memmove( carry.str + lead_len, s + rest, text_len - rest );
+    carry.len = lead_len + text_len - rest;
+    carry_lead_len = lead_len;
+    carry_eol = line_eol;
+  } // for
+
+  if ( carry.len > 0 )
+    minimal_write( ctx, carry.str, carry.len, carry_eol );
+  FERROR( stdin );
+  writer_flush( &ctx->wout );
+  line_buf_cleanup( &carry );
+  exit( EX_OK );
+}
+
+/**
+ * Reformats standard input until EOF, then exits.  If only a range of lines is
+ * to be reformatted, the lines before and after it are passed through
+ * verbatim.  If paragraphs are to be cached and standard input can be
+ * memory-mapped, reformats it via stdin_run_cached() instead.  If only
+ * checking or diffing, checks it via stdin_check() or diffs it via
+ * stdin_diff() instead.  If only writing edits, does so via stdin_edits()
+ * instead.  If reformatting a member of JSON Lines records, does so via
+ * stdin_run_jsonl() instead.  If only measuring, does so via stdin_measure()
+ * instead.  If writing a paragraph index, does so via stdin_index_write()
+ * first.  If reading one, seeks to the range of lines via stdin_index_seek().
+ *
+ * @param ctx The \ref wrap_ctx to use.  Its output must already have been
+ * initialized.
+ *
+ * @sa wrap_run()
+ * @sa wrap_run_wipc()
+ */
+static void stdin_run( wrap_ctx_t *ctx ) {
+  if ( opt_check )
+    stdin_check();
+  if ( opt_diff )
+    stdin_diff( ctx );
+  if ( opt_edits )
+    stdin_edits( ctx );
+  if ( opt_follow > 0 )
+    stdin_follow( ctx );
+  if ( opt_measure )
+    stdin_measure( ctx );
+  if ( opt_minimal )
+    stdin_minimal( ctx );
+  if ( opt_widths_len > 0 )
+    stdin_run_widths();
+  if ( opt_jsonl != NULL )
+    stdin_run_jsonl( ctx );
+  if ( stdin_git_file != NULL ) {
+    if ( para_is_independent() )
+      stdin_run_changed( ctx, stdin_git_file );
+    //
+    // Otherwise, paragraphs can't be reformatted separately, so reformat from
+    // the first changed line through the last.
+    //
+    assert( stdin_git_file->lines_len > 0 );
+    opt_lines_first = stdin_git_file->lines[0].first;
+    opt_lines_last =
+      stdin_git_file->lines[ stdin_git_file->lines_len - 1 ].last;
+  }
+  if ( opt_write_index != NULL )
+    stdin_index_write();
+  ctx->fin = stdin;
+  ctx->is_input_end = true;             // reading reaches EOF only at the end
+  reader_async( stdin );
+
+  if ( opt_lines_first > 0 ) {
+    size_t const line_no = opt_read_index != NULL ?
+      stdin_index_seek( ctx, opt_lines_first ) : 1;
+    for ( size_t lines = opt_lines_first - line_no, size; lines > 0; ) {
+      char const *const s = reader_getlines( stdin, &lines, &size );
+      if ( s == NULL )
+        break;
+      writer_write( &ctx->wout, s, size );
+    } // for
+    //
+    // Reformat only the range as if it were all of the input so, e.g., its
+    // first line is the one used for --prototype -- except that reformatting
+    // drops leading blank lines, so copy those since, e.g., a range that
+    // starts on the blank line between two paragraphs must keep it.
+    //
+    size_t const range_lines = opt_lines_last == SIZE_MAX ? SIZE_MAX :
+      opt_lines_last - opt_lines_first + 1;
+    size_t const blank_lines = stdin_copy_blank( ctx, range_lines );
+    reader_limit_lines( stdin, range_lines == SIZE_MAX ? SIZE_MAX :
+      range_lines - blank_lines
+    );
+  }
+
+  if ( opt_para_cache != NULL && para_is_independent() &&
+       wrap_engine > WRAP_ENGINE_REFERENCE ) {
+    size_t size;
+    char const *const s = reader_peek( stdin, &size );
+    if ( s != NULL )
+      stdin_run_cached( ctx, s, size );
+  }
+
+  wrap_process( ctx );
+  if ( ctx->is_wrap_end || opt_lines_first > 0 ) {
+    reader_limit_lines( stdin, SIZE_MAX );
+    if ( ctx->wout.file != NULL ) {
+      PJL_DISCARD_RV( writer_copy( &ctx->wout, stdin ) );
+    } else {                            // IPC: bypass the output's function
+      writer_flush( &ctx->wout );
+      fcopy( stdin, stdout );
+    }
+  } else {
+    FERROR( stdin );
+  }
+  exit( EX_OK );
+}
+
+/**
+ * Reformats standard input paragraph by paragraph until EOF, then exits.  The
+ * output of each paragraph is copied from the paragraph cache, if there,
+ * rather than reformatted.
+ *
+ * @param ctx The \ref wrap_ctx to write the output via.
+ * @param s All of the remaining input.
+ * @param size The length of \a s.
+ *
+ * @sa para_boundary()
+ */
+static void stdin_run_cached( wrap_ctx_t *ctx, char const *s, size_t size ) {
+  eol_t const eol = stdin_eol();
+  para_cache_open(
+    opt_para_cache, mem_hash( &eol, sizeof eol, options_hash() )
+  );
+
+  para_out_t out = { 0 };
+  line_buf_init( &out.buf );
+  wrap_ctx_t para_ctx;
+  wrap_ctx_init( &para_ctx, &para_out_write, &out );
+
+  for ( size_t pos = 0; pos < size; ) {
+    size_t const end = para_boundary( s, size, pos );
+    size_t out_len;
+    char const *out_s = para_cache_get( s + pos, end - pos, &out_len );
+    if ( out_s == NULL ) {
+      para_ctx.opt.eol = eol;
+      out.len = 0;
+      wrap_feed( &para_ctx, s + pos, end - pos );
+      wrap_finish( &para_ctx );
+      wrap_ctx_reset( &para_ctx );
+      para_cache_put( s + pos, end - pos, out.buf.str, out.len );
+      out_s = out.buf.str;
+      out_len = out.len;
+    }
+    writer_write( &ctx->wout, out_s, out_len );
+    pos = end;
+  } // for
+
+  stats_add( &ctx->stats, &para_ctx.stats );
+  wrap_ctx_cleanup( &para_ctx );
+  line_buf_cleanup( &out.buf );
+  writer_flush( &ctx->wout );
+  exit( EX_OK );
+}
+
+/**
+ * Reformats only the paragraphs of standard input that contain at least one
+ * changed line, copying the rest verbatim, then exits.
+ *
+ * @param ctx The \ref wrap_ctx to write the output via.
+ * @param file The \ref git_file having the changed lines.
+ *
+ * @sa para_boundary()
+ */
+static void stdin_run_changed( wrap_ctx_t *ctx, git_file_t const *file ) {
+  assert( file != NULL );
+  size_t size;
+  char *buf;
+  char const *const s = stdin_slurp( &size, &buf );
+  eol_t const eol = stdin_eol();
+
+  para_out_t out = { 0 };
+  line_buf_init( &out.buf );
+  wrap_ctx_t para_ctx;
+  wrap_ctx_init( &para_ctx, &para_out_write, &out );
+  stdin_sub_ctx = &para_ctx;
+
+  size_t line_no = 1;                   // of the paragraph's first line
+  size_t range_idx = 0;                 // of the next range of lines
+
+  for ( size_t pos = 0; pos < size; ) {
+    size_t const end = para_boundary( s, size, pos );
+    size_t newlines = 0;
+    for ( char const *nl = s + pos;
+          (nl = memchr( nl, '\n', STATIC_CAST( size_t, s + end - nl ) ))
+            != NULL; ++nl ) {
+      ++newlines;
+    } // for
+    size_t const last_no =
+      line_no + newlines - (newlines > 0 && s[ end - 1 ] == '\n');
+
+    while ( range_idx < file->lines_len &&
+            file->lines[ range_idx ].last < line_no ) {
+      ++range_idx;
+    } // while
+    if ( range_idx < file->lines_len &&
+         file->lines[ range_idx ].first <= last_no ) {
+      para_ctx.opt.eol = eol;
+      out.len = 0;
+      wrap_feed( &para_ctx, s + pos, end - pos );
+      wrap_finish( &para_ctx );
+      wrap_ctx_reset( &para_ctx );
+      writer_write( &ctx->wout, out.buf.str, out.len );
+    } else {
+      writer_write( &ctx->wout, s + pos, end - pos );
+    }
+
+    line_no += newlines;
+    pos = end;
+  } // for
+
+  wrap_ctx_cleanup( &para_ctx );
+  line_buf_cleanup( &out.buf );
+  free( buf );
+  writer_flush( &ctx->wout );
+  exit( EX_OK );
+}
+
+/**
+ * Reformats the string value of the \ref opt_jsonl member of every JSON Lines
+ * record of standard input until EOF, then exits.  Records are only scanned
+ * for the member, not parsed.  The reformatted value is either re-escaped in
+ * place, leaving the rest of the record as-is, or, if \ref opt_jsonl_text,
+ * written as text with a blank line between records.  Records not having the
+ * member are passed through as-is or, if writing text, skipped.
+ *
+ * @param ctx The \ref wrap_ctx to write the output via.
+ *
+ * @sa json_scan_str_member()
+ */
+static void stdin_run_jsonl( wrap_ctx_t *ctx ) {
+  size_t const name_len = strlen( opt_jsonl );
+  json_scan_init();
+
+  para_out_t out = { 0 };
+  line_buf_init( &out.buf );
+  wrap_ctx_t para_ctx;
+  wrap_ctx_init( &para_ctx, &para_out_write, &out );
+  json_buf_t chunk = { 0 }, value = { 0 };
+  bool is_first = true;
+
+  reader_async( stdin );
+  for (;;) {
+    size_t lines = SIZE_MAX, size;
+    char const *const s = reader_getlines( stdin, &lines, &size );
+    if ( s == NULL )
+      break;
+    //
+    // The scanner needs the records null-terminated and padded.
+    //
+    chunk.len = 0;
+    json_buf_reserve( &chunk, size + 1 + SIMD_SPAN_PAD );
+    memcpy( chunk.str, s, size );
+    chunk.str[ size ] = '\0';
+
+    char const *const end = chunk.str + size;
+    for ( char const *rec = chunk.str, *rec_end; rec < end; rec = rec_end ) {
+      char const *const nl =
+        memchr( rec, '\n', STATIC_CAST( size_t, end - rec ) );
+      rec_end = nl != NULL ? nl + 1 : end;
+
+      char const *begin, *value_end;
+      value.len = 0;
+      if ( !json_scan_str_member( rec, opt_jsonl, name_len,
+                                  &begin, &value_end ) ||
+           !json_str_decode( begin, STATIC_CAST( size_t, value_end - begin ),
+                             &value ) ) {
+        if ( !opt_jsonl_text )
+          writer_write( &ctx->wout, rec, STATIC_CAST( size_t, rec_end - rec ) );
+        continue;
+      }
+
+      out.len = 0;
+      wrap_feed( &para_ctx, value.str, value.len );
+      wrap_finish( &para_ctx );
+      wrap_ctx_reset( &para_ctx );
+
+      if ( opt_jsonl_text ) {
+        if ( !true_clear( &is_first ) )
+          writer_write( &ctx->wout, "\n", 1 );
+        writer_write( &ctx->wout, out.buf.str, out.len );
+        continue;
+      }
+
+      //
+      // Reformatting always ends the value with a newline, but it didn't
+      // necessarily have one to begin with.
+      //
+      size_t out_len = out.len;
+      if ( (value.len == 0 || value.str[ value.len - 1 ] != '\n') &&
+           out_len > 0 && out.buf.str[ out_len - 1 ] == '\n' ) {
+        --out_len;
+        if ( out_len > 0 && out.buf.str[ out_len - 1 ] == '\r' )
+          --out_len;
+      }
+      value.len = 0;
+      json_buf_put_str( &value, out.buf.str, out_len );
+      writer_write( &ctx->wout, rec, STATIC_CAST( size_t, begin - rec ) );
+      writer_write( &ctx->wout, value.str, value.len );
+      writer_write( &ctx->wout, value_end,
+        STATIC_CAST( size_t, rec_end - value_end )
+      );
+    } // for
+  } // for
+  FERROR( stdin );
+
+  stats_add( &ctx->stats, &para_ctx.stats );
+  wrap_ctx_cleanup( &para_ctx );
+  json_buf_cleanup( &chunk );
+  json_buf_cleanup( &value );
+  line_buf_cleanup( &out.buf );
+  writer_flush( &ctx->wout );
+  exit( EX_OK );
+}
+
+/**
+ * Reformats standard input to each of \ref opt_widths, writing the output
+ * for each to its own file, then exits.  The input is read only once: each
+ * chunk of it is given to every width's \ref wrap_ctx in turn while it's
+ * still in the CPU's cache.
+ *
+ * @sa width_path()
+ */
+static void stdin_run_widths( void ) {
+  wrap_ctx_t *const ctxs = MALLOC( wrap_ctx_t, opt_widths_len );
+  size_t const line_width = opt_line_width;
+
+  for ( size_t i = 0; i < opt_widths_len; ++i ) {
+    char *const path = width_path( opt_widths_path, opt_widths[i] );
+    FILE *const fout = fopen( path, "w" );
+    if ( fout == NULL )
+      fatal_error( EX_CANTCREAT, "\"%s\": %s\n", path, STRERROR() );
+    FREE( path );
+    opt_line_width = opt_widths[i];     // ctx_init() reads it
+    ctx_init( &ctxs[i] );
+    writer_init( &ctxs[i].wout, fout );
+    if ( opt_expand_tabs )
+      writer_expand_tabs( &ctxs[i].wout );
+  } // for
+  opt_line_width = line_width;
+
+  reader_async( stdin );
+  for (;;) {
+    size_t lines = SIZE_MAX, size;
+    char const *const s = reader_getlines( stdin, &lines, &size );
+    if ( s == NULL )
+      break;
+    for ( size_t i = 0; i < opt_widths_len; ++i )
+      wrap_feed( &ctxs[i], s, size );
+  } // for
+  FERROR( stdin );
+
+  for ( size_t i = 0; i < opt_widths_len; ++i ) {
+    FILE *const fout = ctxs[i].wout.file;
+    wrap_finish( &ctxs[i] );
+    wrap_ctx_cleanup( &ctxs[i] );
+    PERROR_EXIT_IF( fclose( fout ) != 0, EX_IOERR );
+  } // for
+  FREE( ctxs );
+  exit( EX_OK );
+}
+
+/**
+ * Reads all of standard input.
+ *
+ * @param psize A pointer to receive the length of the input.
+ * @param pbuf A pointer to receive a pointer to the buffer that the caller
+ * must free (that's NULL if standard input could be memory-mapped instead).
+ * @return Returns a pointer to the input.
+ */
+static char const* stdin_slurp( size_t *psize, char **pbuf ) {
+  assert( psize != NULL );
+  assert( pbuf != NULL );
+
+  *pbuf = NULL;
+  char const *const s = reader_peek( stdin, psize );
+  if ( s != NULL )
+    return s;
+
+  //
+  // Standard input can't be memory-mapped, but if it's a regular file (e.g.,
+  // a compressed one), its size is a good lower bound for the buffer's.
+  //
+  size_t cap = stdin_size_hint(), size = 0;
+  if ( cap > 0 )
+    *pbuf = MALLOC( char, cap );
+  for ( size_t lines = SIZE_MAX, n;; ) {
+    char const *const chunk = reader_getlines( stdin, &lines, &n );
+    if ( chunk == NULL )
+      break;
+    if ( size + n > cap ) {
+      cap = cap == 0 ? n : cap * 2;
+      if ( cap < size + n )
+        cap = size + n;
+      REALLOC( *pbuf, char, cap );
+    }
+    memcpy( *pbuf + size, chunk, n );
+    size += n;
+  } // for
+  FERROR( stdin );
+  *psize = size;
+  return *pbuf != NULL ? *pbuf : "";
+}
+
+/**
+ * Gets the number of characters remaining to be read from standard input if
+ * it's a regular file.
+ *
+ * @return Returns said number or 0 if standard input isn't a regular file.
+ */
+static size_t stdin_size_hint( void ) {
+  struct stat st;
+  if ( fstat( STDIN_FILENO, &st ) == -1 || !S_ISREG( st.st_mode ) )
+    return 0;
+  off_t const offset = lseek( STDIN_FILENO, 0, SEEK_CUR );
+  if ( offset == -1 || offset >= st.st_size )
+    return 0;
+  return STATIC_CAST( size_t, st.st_size - offset );
+}
+
+/**
+ * Preallocates disk space for standard output if it's an empty regular file,
+ * e.g., one given by `--output` or the temporary file for `--in-place`, and
+ * standard input is a regular file: the output is likely about as long as the
+ * input, so this lets the file system allocate it contiguously up front.  The
+ * space isn't counted in the file's size and whatever isn't written is given
+ * back at exit via stdout_trim().
+ */
+static void stdout_preallocate( void ) {
+#if HAVE_FALLOCATE && defined(FALLOC_FL_KEEP_SIZE)
+  size_t const size = stdin_size_hint();
+  struct stat st;
+  if ( size == 0 || fstat( STDOUT_FILENO, &st ) == -1 ||
+       !S_ISREG( st.st_mode ) || st.st_size != 0 ) {
+    return;
+  }
+  if ( fallocate( STDOUT_FILENO, FALLOC_FL_KEEP_SIZE, 0,
+                  STATIC_CAST( off_t, size ) ) == -1 ) {
+    return;                             // e.g., not supported: no matter
+  }
+  stdout_trim_pid = getpid();
+  ATEXIT( &stdout_trim );
+#endif /* HAVE_FALLOCATE && FALLOC_FL_KEEP_SIZE */
+}
+
+#if HAVE_FALLOCATE && defined(FALLOC_FL_KEEP_SIZE)
+/**
+ * Gives back the disk space preallocated by stdout_preallocate() past the end
+ * of what was actually written.  Truncating a file to its own size frees any
+ * blocks preallocated past its end.
+ */
+static void stdout_trim( void ) {
+  if ( getpid() != stdout_trim_pid )    // a child forked by para_fork()
+    return;
+  if ( fflush( stdout ) != 0 )
+    return;
+  off_t const size = lseek( STDOUT_FILENO, 0, SEEK_CUR );
+  if ( size != -1 )
+    PJL_DISCARD_RV( ftruncate( STDOUT_FILENO, size ) );
+}
+#endif /* HAVE_FALLOCATE && FALLOC_FL_KEEP_SIZE */
+
+/**
+ * Gets the column text ends at when displayed where tabs go to the next
+ * tab-stop every \ref opt_tab_spaces columns.
+ *
+ * @param s The text.  It need not be null-terminated.
+ * @param len The number of characters of \a s.
+ * @param col The column \a s starts at.
+ * @return Returns said column.
+ */
+static size_t str_cols( char const *s, size_t len, size_t col ) {
+  assert( s != NULL || len == 0 );
+  for ( char const *const end = s + len; s < end; ++s ) {
+    if ( *s == '\t' )
+      col += opt_tab_spaces - col % opt_tab_spaces;
+    else if ( !utf8_is_cont( *s ) )
+      col += s + utf8_len( *s ) <= end ? utf8_width( s ) : 1;
+  } // for
+  return col;
+}
+
+/**
+ * Gets the path of the file to write the output for \a width to: \a path
+ * with `.`\a width inserted before its extension, if any, e.g., `doc.72.txt`
+ * for `doc.txt`.
+ *
+ * @param path The path given by `--output`.
+ * @param width The line width.
+ * @return Returns said path.  The caller is responsible for freeing it.
+ */
+static char* width_path( char const *path, size_t width ) {
+  assert( path != NULL );
+  char const *const base = base_name( path );
+  char const *ext = strrchr( base, '.' );
+  if ( ext == NULL || ext == base )     // no extension or a dot file
+    ext = base + strlen( base );
+  int const prefix_len = STATIC_CAST( int, ext - path );
+
+  size_t const size = strlen( path ) + 1/*.*/ + 20/*width*/ + 1/*null*/;
+  char *const wpath = MALLOC( char, size );
+  snprintf( wpath, size, "%.*s.%zu%s", prefix_len, path, width, ext );
+  return wpath;
+}
+
+/**
+ * Parses an IPC message.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param msg The message positioned at the IPC code after #WIPC_CODE_HELLO.
+ */
+static void wipc_parse( wrap_ctx_t *ctx, char *msg ) {
+  assert( msg != NULL );
+
+  char const c = *msg++;
+  if ( unlikely( c == '\0' ) )
+    return;
+  PROBE1( ipc_recv, c );
+
+  switch ( STATIC_CAST( wipc_code_t, c ) ) {
+    case WIPC_CODE_HELLO:               // shouldn't happen
+    case WIPC_CODE_SYNC:
+      break;
+
+    case WIPC_CODE_DELIMIT_PARAGRAPH:
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      wipc_write( ctx, WIPC_CODE_DELIMIT_PARAGRAPH, 0, /*leader=*/NULL );
+      break;
+
+    case WIPC_CODE_NEW_LEADER:
+      NO_OP;
+      //
+      // We've been told by wrapc (child 1) that the comment characters and/or
+      // leading whitespace has changed: we have to echo it back to the other
+      // wrapc process (parent).
+      //
+      // If an output line has already been started, we have to defer the IPC
+      // until just after the line is sent; otherwise, we must send it
+      // immediately.
+      //
+      char *sep;
+      size_t const new_line_width = strtoul( msg, &sep, 10 );
+      char *const leader = sep + 1;
+      size_t const leader_len = chop_eol( leader, strlen( leader ) );
+      if ( ctx->output_len > 0 ) {
+        line_buf_reserve( &ctx->ipc_buf, leader_len );
+        strcpy( ctx->ipc_buf.str, leader );
+        ctx->ipc_width = new_line_width;
+      } else {
+        wipc_write( ctx, WIPC_CODE_NEW_LEADER, new_line_width, leader );
+        ctx->line_width = ctx->opt.line_width = new_line_width;
+      }
+      break;
+
+    case WIPC_CODE_PREFORMATTED_BEGIN:
+      delimit_paragraph( ctx );
+      wipc_write( ctx, WIPC_CODE_PREFORMATTED_BEGIN, 0, /*leader=*/NULL );
+      ctx->is_preformatted = true;
+      break;
+
+    case WIPC_CODE_PREFORMATTED_END:
+      ctx->consec_newlines = 1;
+      delimit_paragraph( ctx );
+      wipc_write( ctx, WIPC_CODE_PREFORMATTED_END, 0, /*leader=*/NULL );
+      ctx->is_preformatted = false;
+      break;
+
+    case WIPC_CODE_WRAP_END:
+      //
+      // We've been told by wrapc (child 1) that we've reached the end of the
+      // comment: dump any remaining buffer, propagate the interprocess message
+      // to the other wrapc process (parent), and pass the rest of the input
+      // through verbatim (that wrap_process()'s caller does).
+      //
+      ctx->consec_newlines = 0;
+      delimit_paragraph( ctx );
+      wipc_write( ctx, WIPC_CODE_WRAP_END, 0, /*leader=*/NULL );
+      ctx->is_wrap_end = true;
+      break;
+  } // switch
+}
+
+/**
+ * Reads the out-of-band IPC message that applies into
+ * \ref wrap_ctx::input_buf as the equivalent in-band IPC line so that both
+ * are handled the same.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns the number of characters of the line.
+ */
+static size_t wipc_readline( wrap_ctx_t *ctx ) {
+  wipc_in_t *const in = ctx->wipc_in;
+  wipc_code_t const code = STATIC_CAST( wipc_code_t, in->frame.code );
+
+  // HELLO + code + line width + separator + leader + newline
+  size_t const size = 1 + 1 + 20 + 1 + in->frame.leader_len + 1;
+  line_buf_reserve( &ctx->input_buf, size + SIMD_SPAN_PAD );
+  int const len = code == WIPC_CODE_NEW_LEADER ?
+    snprintf(
+      ctx->input_buf.str, size + 1, "%c%c%zu" WIPC_PARAM_SEP "%s\n",
+      WIPC_CODE_HELLO, STATIC_CAST( char, code ),
+      STATIC_CAST( size_t, in->frame.line_width ),
+      in->leader.str
+    ) :
+    snprintf(
+      ctx->input_buf.str, size + 1, "%c%c\n",
+      WIPC_CODE_HELLO, STATIC_CAST( char, code )
+    );
+
+  wipc_in_consume( in );
+  ctx->input_buf.len = STATIC_CAST( size_t, len );
+  return ctx->input_buf.len;
+}
+
+/**
+ * Sends the deferred #WIPC_CODE_NEW_LEADER IPC message, if any, to
+ * **wrapc**(1) and applies its line width.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void wipc_send( wrap_ctx_t *ctx ) {
+  if ( ctx->ipc_width > 0 ) {
+    wipc_write(
+      ctx, WIPC_CODE_NEW_LEADER, ctx->ipc_width, ctx->ipc_buf.str
+    );
+    ctx->line_width = ctx->opt.line_width = ctx->ipc_width;
+    ctx->ipc_width = 0;
+  }
+}
+
+/**
+ * Sends an IPC message to **wrapc**(1): out-of-band if \a ctx has a
+ * \ref wrap_ctx::wipc_out; otherwise in-band via its output.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param code The \ref wipc_code.
+ * @param line_width The new line width for #WIPC_CODE_NEW_LEADER.
+ * @param leader The new leader for #WIPC_CODE_NEW_LEADER; NULL otherwise.
+ */
+static void wipc_write( wrap_ctx_t *ctx, wipc_code_t code, size_t line_width,
+                        char const *leader ) {
+  if ( ctx->wipc_out != NULL ) {
+    wipc_out_send( ctx->wipc_out, code, line_width, leader );
+  } else if ( leader != NULL ) {
+    WIPC_SENDF(
+      &ctx->wout, STATIC_CAST( char, code ), "%zu" WIPC_PARAM_SEP "%s\n",
+      line_width, leader
+    );
+  } else {
+    WIPC_SEND( &ctx->wout, STATIC_CAST( char, code ) );
+  }
+}
+
+/**
+ * Cleans up wrap data.
+ */
+static void wrap_cleanup( void ) {
+  wrap_ctx_cleanup( &stdin_ctx );
+  wipc_in_cleanup( &stdin_wipc_in );
+  hyphenate_cleanup();
+}
+
+/**
+ * The main loop: reformats as much of the input of \a ctx as has been given so
+ * far, saving its state in \a ctx so it resumes where it left off when given
+ * more.
+ *
+ * It's always inlined into each of its variants so that, for each, \a required
+ * and \a possible are constants: the checks for every feature in \a required
+ * are eliminated as are the code for every feature not in \a possible.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param required The bitwise-or of the \ref wrap_feature known to be enabled
+ * in \ref wrap_ctx::features.
+ * @param possible The bitwise-or of the \ref wrap_feature that may be enabled
+ * in \ref wrap_ctx::features.  It must include \a required.
+ *
+ * @sa #WRAP_LOOP_VARIANTS
+ */
+PJL_ALWAYS_INLINE
+static inline void wrap_loop( wrap_ctx_t *ctx, unsigned const required,
+                              unsigned const possible ) {
+  // Checks whether the wrap_feature FEAT is enabled.
+#define HAS(FEAT) \
+  (((required) & (FEAT)) != 0 || (possible & features & (FEAT)) != 0)
+
+  unsigned const features = ctx->features;
+  assert( (features & required) == required );
+  assert( (features & ~possible) == 0 );
+
+  bool        next_line_is_title = ctx->next_line_is_title;
+  char const *pb = ctx->pb;             // pointer to current byte
+  utf8c_t     utf8c;                    // current character's UTF-8 byte(s)
+  cp_gcb_state_t gcb_state = ctx->gcb_state;
+  cp_lb_t     lb_prev = ctx->lb_prev;   // previous char's line-break class
+  char32_t    cp, cp_prev = ctx->cp_prev; // current and previous codepoints
+
+  /////////////////////////////////////////////////////////////////////////////
+
+  for ( ; (cp = buf_getcp( ctx, &pb, utf8c )) != CP_EOF; cp_prev = cp ) {
+
+    if ( cp == CP_INVALID )
+      continue;
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  HANDLE NEWLINE(s)
+    ///////////////////////////////////////////////////////////////////////////
+
+    if ( cp == '\r' ) {
+      //
+      // The code is simpler if we always strip \r and add it back later (if
+      // opt_eol is EOL_WINDOWS).  This is checked before looking up the
+      // character's properties since they'd go unused.
+      //
+      continue;
+    }
+
+    cp_props_t const props = cp_props( cp );
+
+    if ( cp == '\n' ) {
+      ctx->encountered_nonws = false;
+
+      if ( ++ctx->consec_newlines >= ctx->opt.newlines_delimit ) {
+        //
+        // At least newlines_delimit consecutive newlines: set that the next
+        // line is a title line and delimit the paragraph.
+        //
+        next_line_is_title = opt_title_line;
+        delimit_paragraph( ctx );
+        continue;
+      }
+      if ( ctx->output_len > 0 && true_clear( &next_line_is_title ) ) {
+        //
+        // The first line of the next paragraph is title line and the buffer
+        // isn't empty (there is a title): print the title.
+        //
+        delimit_paragraph( ctx );
+        ctx->indent = INDENT_HANG;
+        continue;
+      }
+      if ( ctx->was_eos_char ) {
+        if ( HAS( WRAP_FEAT_EOS_DELIMIT ) ) {
           //
-          // We've encountered H- meaning that this is potentially a
-          // hyphenated word.
+          // End-of-sentence characters delimit paragraphs and the previous
+          // character was an end-of-sentence character: delimit the paragraph.
+          //
+          delimit_paragraph( ctx );
+        } else {
           //
-          hyphen = HYPHEN_MAYBE;
+          // We are joining a line after the end of a sentence: force requested
+          // number of spaces.
+          //
+          ctx->put_spaces = ctx->opt.eos_spaces;
         }
+        continue;
+      }
+      if ( ctx->hyphen == HYPHEN_MAYBE ) {
+        //
+        // We've encountered H-\n meaning that a potentially hyphenated word
+        // ends a line: eat the newline so the word can potentially be rejoined
+        // to the next word when wrapped, e.g.:
+        //
+        //      non-
+        //      whitespace
+        //
+        // can become:
+        //
+        //      non-whitespace
+        //
+        // instead of:
+        //
+        //      non- whitespace
+        //
+        continue;
       }
+    } else {
+      ctx->consec_newlines = 0;
     }
 
-    output_len += utf8_copy_char( output_buf + output_len, utf8c );
-    if ( ++output_width < line_width )
-      continue;                         // haven't exceeded line width yet
-
     ///////////////////////////////////////////////////////////////////////////
-    //  EXCEEDED LINE WIDTH; PRINT LINE OUT
+    //  HANDLE WHITESPACE
     ///////////////////////////////////////////////////////////////////////////
 
-    if ( wrap_pos == 0 ) {
-      //
-      // We've exceeded the line width, but haven't encountered a whitespace
-      // character at which to wrap; therefore, we've got a "long line."
-      //
-      if ( !is_long_line )
-        put_lead_chars();
-      put_line( output_len, /*do_eol=*/false );
-      is_long_line = true;
+    if ( (props & CP_PROP_SPACE) != 0 ) {
+      gcb_state = CP_GCB_STATE_INIT;    // no cluster continues past a space
+      if (  //
+            // We've been handling a "long line" and finally got a whitespace
+            // character at which we can finally wrap: delimit the paragraph.
+            //
+            ctx->is_long_line ||
+            //
+            // Leading whitespace characters delimit paragraphs and the
+            // previous character was a newline which means this whitespace
+            // character is at the beginning of a line: delimit the paragraph.
+            //
+            (HAS( WRAP_FEAT_LEAD_WS_DELIMIT ) && cp_prev == '\n') ||
+            //
+            // End-of-sentence characters delimit paragraphs and the previous
+            // character was an end-of-sentence character: delimit the
+            // paragraph.
+            //
+            (HAS( WRAP_FEAT_EOS_DELIMIT ) && ctx->was_eos_char) ||
+            //
+            // The previous character was a paragraph-delimiter character:
+            // delimit the paragraph.
+            //
+            (HAS( WRAP_FEAT_PARA_DELIMS ) &&
+             cp_is_para_delim( ctx, cp_prev )) ) {
+        delimit_paragraph( ctx );
+      }
+      else if ( ctx->hyphen == HYPHEN_MAYBE && !ctx->encountered_nonws ) {
+        //
+        // This case is similar to above: we've encountered H-\n meaning that a
+        // potentially hyphenated word ended a line and we've only encountered
+        // leading whitespace on the next line so far: eat the space so the
+        // word can potentially be rejoined to the next word when wrapped.
+        //
+      }
+      else if ( ctx->output_len > 0 && ctx->put_spaces <
+                (ctx->was_eos_char ? ctx->opt.eos_spaces : 1) ) {
+        //
+        // We are not at the beginning of a line: remember to insert 1 space
+        // later and allow eos_spaces after the end of a sentence.
+        //
+        ++ctx->put_spaces;
+      }
       continue;
     }
 
-    //
-    // A call to put_line() will terminate output_buf with a NULL at wrap_pos
-    // that is ordinarily at a space and so doesn't need to be preserved.
-    // However, when wrapping at a hyphen, it's at the character past the
-    // hyphen that must be preserved in the output so we keep a copy of it to
-    // be restored after the call to put_line().
-    //
-    char const c_past_hyphen = output_buf[ wrap_pos ];
+    ///////////////////////////////////////////////////////////////////////////
+    //  DISCARD CONTROL CHARACTERS
+    ///////////////////////////////////////////////////////////////////////////
+
+    if ( (props & CP_PROP_CONTROL) != 0 )
+      continue;
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  HANDLE LEADING-PARAGRAPH-DELIMITERS, LEADING-DOT, END-OF-SENTENCE, AND
+    //  PARAGRAPH-DELIMITERS
+    ///////////////////////////////////////////////////////////////////////////
 
-    size_t const prev_output_len = output_len;
-    put_lead_chars();
-    put_line( wrap_pos, /*do_eol=*/true );
+    if ( cp_prev == '\n' ) {
+      if ( HAS( WRAP_FEAT_LEAD_DOT_IGNORE ) && cp == '.' ) {
+        ctx->consec_newlines = 0;
+        delimit_paragraph( ctx );
+        // Print the line as-is.
+        writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+        //
+        // A long line is read in chunks: print the rest of it as-is, too.
+        //
+        while ( !is_line_end( &ctx->input_buf ) && buf_readline( ctx ) > 0 )
+          writer_write( &ctx->wout, ctx->input_buf.str, ctx->input_buf.len );
+        //
+        // Make state as if line never happened.  If the next line hasn't been
+        // given yet, it's read once it has.
+        //
+        if ( buf_readline( ctx ) > 0 ) {
+          pb = ctx->input_buf.str;
+        } else {
+          pb = "";
+          ctx->keep_lead_ws = true;
+        }
+        cp = '\n';                      // so cp_prev will become this (again)
+        continue;
+      }
+      if ( HAS( WRAP_FEAT_BLOCK_REGEX ) && block_regex_matches( ctx ) ) {
+        delimit_paragraph( ctx );
+        if ( HAS( WRAP_FEAT_MARKDOWN ) ) {
+          markdown_init( &ctx->md_parser );
+          markdown_reset( ctx );
+        }
+      }
+      else if ( ctx->hyphen == HYPHEN_MAYBE && (props & CP_PROP_ALPHA) == 0 ) {
+        //
+        // We had encountered H-\n on the previous line meaning that a
+        // potentially hyphenated word ends a line, but the first character on
+        // the next line is not a "hyphen adjacent character" so forget about
+        // hyphenation and put the previously eaten whitespace back.
+        //
+        ctx->hyphen = HYPHEN_NO;
+        ctx->put_spaces = 1;
+      }
+    }
 
-    if ( hyphen != HYPHEN_NO ) {
+    if ( (props & CP_PROP_EOS) != 0 ) {
       //
-      // Per the above comment, put the preserved character back and include it
-      // in the slide-to-the-left (below).
+      // A period after an abbreviation, e.g., "e.g.", doesn't end a sentence.
+      // Only a period that directly follows a word need be looked up.
       //
-      output_buf[ wrap_pos-- ] = c_past_hyphen;
+      ctx->was_eos_char = cp != '.' || ctx->put_spaces > 0 ||
+        !abbrev_ends( ctx->output_buf.str, ctx->output_len );
+    } else {
+      ctx->was_eos_char =
+        ctx->was_eos_char && (props & CP_PROP_EOS_EXT) != 0;
     }
 
-    put_tabs_spaces( opt_hang_tabs, opt_hang_spaces );
+    ///////////////////////////////////////////////////////////////////////////
+    //  INSERT SPACES
+    ///////////////////////////////////////////////////////////////////////////
 
-    //
-    // Slide the partial word to the left where we can pick up from where we
-    // left off the next time around.
-    //
-    for ( size_t from_pos = wrap_pos + 1/*null*/;
-          from_pos < prev_output_len; ) {
-      char const *const from = output_buf + from_pos;
-      size_t const len = utf8_len( from[0] );
-      if ( !cp_is_space( utf8_decode( from ) ) ) {
-        utf8_copy_char( output_buf + output_len, from );
-        output_len += len;
-        ++output_width;
+    if ( ctx->put_spaces > 0 ) {
+      if ( ctx->output_len > 0 ) {
+        if ( HAS( WRAP_FEAT_OPTIMAL ) && ctx->spans.len >= ctx->opt.optimal &&
+             ctx->output_width >= ctx->line_width ) {
+          //
+          // We're minimizing raggedness, but the paragraph has gotten too long
+          // to keep all of it (and doesn't fit on one line): print the lines
+          // of about the first half of it (that are unlikely to change however
+          // the paragraph continues).
+          //
+          put_optimal( ctx, ctx->spans.len, ctx->spans.len / 2 );
+        }
+        if ( ctx->spans.len == 0 ) {
+          //
+          // There's only indentation so far: make it a span of its own so the
+          // line can still be wrapped at this space.
+          //
+          span_list_push( &ctx->spans, 0, 0 );
+        }
+        size_t const gap = ctx->put_spaces;
+        ctx->output_width += ctx->put_spaces;
+        line_buf_reserve( &ctx->output_buf, ctx->output_len + ctx->put_spaces );
+        do {
+          ctx->output_buf.str[ ctx->output_len++ ] = ' ';
+        } while ( --ctx->put_spaces > 0 );
+        //
+        // The position of the character after the spaces: they're within a
+        // range only if it's not the range's first character.
+        //
+        size_t const pos = STATIC_CAST( size_t, pb - ctx->input_buf.str ) -
+          utf8_len( utf8c[0] );
+        if ( HAS( WRAP_FEAT_GLUE_SPACES ) && ctx->nonws_no_wrap_check &&
+             pos > ctx->nonws_no_wrap_range[0] &&
+             pos < ctx->nonws_no_wrap_range[1] ) {
+          //
+          // The spaces are within an HTML tag (or before a roff word that
+          // mustn't start a line): keep them as part of the current span so
+          // it's never wrapped within.
+          //
+          word_span_t *const word = span_list_last( &ctx->spans );
+          word->len += gap;
+          word->width += gap;
+        } else {
+          //
+          // Start a new span after the spaces at which to perform a wrap if
+          // necessary.
+          //
+          span_list_push( &ctx->spans, ctx->output_len, gap );
+        }
+      } else {
+        //
+        // Never put spaces at the beginning of a line.
+        //
+        ctx->put_spaces = 0;
       }
-      from_pos += len;
-    } // for
-
-    hyphen = HYPHEN_NO;
-    is_long_line = false;
-    wrap_pos = 0;
-  } // for
+    }
 
-  /////////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    //  PERFORM INDENTATION
+    ///////////////////////////////////////////////////////////////////////////
 
-  FERROR( stdin );
-  if ( output_len > 0 ) {               // print left-over text
-    if ( !is_long_line )
-      put_lead_chars();
-    put_line( output_len, /*do_eol=*/true );
-  }
-  exit( EX_OK );
-}
+    switch ( ctx->indent ) {
+      case INDENT_NONE:
+        break;
+      case INDENT_HANG:
+        put_tabs_spaces( ctx, ctx->opt.hang_tabs, ctx->opt.hang_spaces );
+        break;
+      case INDENT_LINE:
+        put_tabs_spaces( ctx, ctx->opt.indt_tabs, ctx->opt.indt_spaces );
+        break;
+    } // switch
+    ctx->indent = INDENT_NONE;
 
-////////// local functions ////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    //  INSERT NON-SPACE CHARACTER
+    ///////////////////////////////////////////////////////////////////////////
 
-/**
- * Gets the next character from the input.
- *
- * @param ppc A pointer to the pointer to character to advance.
- * @return Returns said character or \c EOF.
- */
-NODISCARD
-static int buf_getc( char const **ppc ) {
-  assert( ppc != NULL );
-  assert( *ppc != NULL );
-  static bool check_for_nonws_no_wrap_match = true;
+    ctx->encountered_nonws = true;
 
-  while ( **ppc == '\0' ) {
-read_line:
-    if ( unlikely( buf_readline() == 0 ) )
-      return EOF;
-    *ppc = input_buf;
-    nonws_no_wrap_range[1] = 0;
-    check_for_nonws_no_wrap_match = true;
     //
-    // When wrapping Markdown, we have to strip leading whitespace from lines
-    // since it interferes with indenting.
+    // A character that continues a grapheme cluster (e.g., a combining mark
+    // or an emoji joined by a ZWJ) is never wrapped before.
     //
-    if ( !opt_markdown || *SKIP_CHARS( *ppc, WS_STR ) != '\0' )
-      break;
-  } // while
+    bool const is_cluster_start = cp_gcb_is_break( &gcb_state, cp );
 
-  if ( !opt_no_hyphen && check_for_nonws_no_wrap_match ) {
-    size_t const pos = STATIC_CAST( size_t, *ppc - input_buf );
-    //
-    // If there was a previous non-whitespace-no-wrap range and we're past it,
-    // see if there is another match on the same line.
-    //
-    if ( pos >= nonws_no_wrap_range[1] ) {
-      check_for_nonws_no_wrap_match = regex_match(
-        &nonws_no_wrap_regex, input_buf, pos, nonws_no_wrap_range
-      );
+    if ( HAS( WRAP_FEAT_HYPHEN ) ) {
+      size_t const pos = STATIC_CAST( size_t, pb - ctx->input_buf.str );
+      if ( pos >= ctx->nonws_no_wrap_range[1] ||
+           pos < ctx->nonws_no_wrap_range[0] ) {
+        //
+        // We're outside the non-whitespace-no-wrap range.
+        //
+        if ( ctx->hyphen == HYPHEN_MAYBE ) {
+          if ( (props & CP_PROP_ALPHA) != 0 && is_cluster_start ) {
+            //
+            // We've encountered H-H meaning that this is definitely a
+            // hyphenated word: start a new span here at which to perform a
+            // wrap if necessary.
+            //
+            ctx->hyphen = HYPHEN_YES;
+            span_list_push( &ctx->spans, ctx->output_len, /*gap=*/0 );
+          }
+          else if ( (props & CP_PROP_HYPHEN) == 0 ) {
+            //
+            // We've encountered H-X meaning that this is not a hyphenated
+            // word.
+            //
+            ctx->hyphen = HYPHEN_NO;
+          }
+          else {
+            //
+            // We've encountered H-- meaning that this is still potentially a
+            // hyphenated word.
+            //
+          }
+        }
+        else if ( (props & CP_PROP_HYPHEN) != 0 &&
+                  cp_is_hyphen_adjacent( cp_prev ) ) {
+          //
+          // We've encountered H- meaning that this is potentially a
+          // hyphenated word.
+          //
+          ctx->hyphen = HYPHEN_MAYBE;
+        }
+      }
+    }
+
+    if ( HAS( WRAP_FEAT_UNICODE_BREAKS ) ) {
+      cp_lb_t const lb = cp_lb( cp );
+      if ( is_cluster_start && ctx->spans.len > 0 &&
+           span_list_last( &ctx->spans )->len > 0 &&
+           cp_lb_is_break( lb_prev, lb ) && !cp_is_hyphen( cp_prev ) ) {
+        //
+        // Unlike for hyphens, this character itself (that ends just before
+        // pos) must be outside the non-whitespace-no-wrap range so a URL
+        // isn't wrapped before its last character.
+        //
+        size_t const pos = STATIC_CAST( size_t, pb - ctx->input_buf.str );
+        if ( pos > ctx->nonws_no_wrap_range[1] ||
+             pos <= ctx->nonws_no_wrap_range[0] ) {
+          //
+          // Unicode allows a line break between the previous character and
+          // this one, e.g., between ideographs: start a new span here at
+          // which to perform a wrap if necessary.  (Breaks after hyphens are
+          // left to the hyphen handling above.)
+          //
+          span_list_push( &ctx->spans, ctx->output_len, /*gap=*/0 );
+        }
+      }
+      //
+      // The rest of a cluster doesn't change the class (LB9), except that
+      // whatever follows a ZWJ takes its place.
+      //
+      if ( (is_cluster_start && lb != CP_LB_CM) || lb == CP_LB_ZWJ ||
+           lb_prev == CP_LB_ZWJ ) {
+        lb_prev = lb;
+      }
     }
-  }
 
-  int const c = *(*ppc)++;
+    if ( ctx->spans.len == 0 )
+      span_list_push( &ctx->spans, ctx->output_len, /*gap=*/0 );
+    word_span_t *const word = span_list_last( &ctx->spans );
 
-  if ( !opt_data_link_esc )
-    return c;
+    line_buf_reserve( &ctx->output_buf, ctx->output_len + UTF8_CHAR_SIZE_MAX );
+    size_t const cp_len =
+      utf8_copy_char( ctx->output_buf.str + ctx->output_len, utf8c );
+    ctx->output_len += cp_len;
+    word->len += cp_len;
+    size_t const cp_cols = cp_gcb_width( gcb_state, cp );
+    word->width += cp_cols;
+    ctx->output_width += cp_cols;
 
-  if ( c == WIPC_CODE_HELLO ) {
-    wipc_parse( ppc );
-    goto read_line;
-  }
+    //
+    // When minimizing raggedness, lines are wrapped only once the paragraph
+    // ends, so all that matters until then is whether the current word would
+    // fit on a line by itself.
+    //
+    size_t const width =
+      !HAS( WRAP_FEAT_OPTIMAL ) || ctx->is_long_line ? ctx->output_width :
+      ctx->spans.len == 1 ? ctx->output_width : hang_width( ctx ) + word->width;
 
-  if ( is_preformatted ) {
-    PUTS( input_buf );
-    goto read_line;
-  }
+    if ( width < ctx->line_width ) {
+      //
+      // We haven't exceeded the line width yet.  If the rest of the word is
+      // made up of characters that would only be appended to output_buf, copy
+      // as many of them as possible all at once rather than one at a time.
+      // When breaking per Unicode, that's possible only after a letter or
+      // digit since there may be a break opportunity between anything else
+      // and a letter.
+      //
+      if ( ctx->hyphen != HYPHEN_MAYBE && (!HAS( WRAP_FEAT_UNICODE_BREAKS ) ||
+           lb_prev == CP_LB_AL || lb_prev == CP_LB_HL ||
+           lb_prev == CP_LB_NU) ) {
+        size_t n_max = ctx->line_width - width - 1;
+        if ( ctx->nonws_no_wrap_enabled && ctx->nonws_no_wrap_check ) {
+          //
+          // Don't go past the end of the current non-whitespace-no-wrap range
+          // since buf_getc() must look for the next one there.
+          //
+          size_t const pos = STATIC_CAST( size_t, pb - ctx->input_buf.str );
+          size_t const range_rem = pos < ctx->nonws_no_wrap_range[1] ?
+            ctx->nonws_no_wrap_range[1] - pos : 0;
+          if ( n_max > range_rem )
+            n_max = range_rem;
+        }
+        size_t const n = simd_span( pb, n_max );
+        if ( n > 0 ) {
+          line_buf_reserve( &ctx->output_buf, ctx->output_len + n );
+          memcpy( ctx->output_buf.str + ctx->output_len, pb, n );
+          ctx->output_len += n;
+          ctx->output_width += n;
+          word->len += n;
+          word->width += n;
+          pb += n;
+          cp = STATIC_CAST( unsigned char, pb[-1] );
+          gcb_state = CP_GCB_OTHER;
+          ctx->was_eos_char = false;
+          if ( HAS( WRAP_FEAT_UNICODE_BREAKS ) )
+            lb_prev = cp_lb( cp );
+        }
+      }
+      continue;
+    }
 
-  return c;
-}
+    ///////////////////////////////////////////////////////////////////////////
+    //  EXCEEDED LINE WIDTH; PRINT LINE OUT
+    ///////////////////////////////////////////////////////////////////////////
 
-/**
- * Gets bytes comprising the next UTF-8 character and its corresponding Unicode
- * code-point from the input.
- *
- * @param ppc A pointer to the pointer to character to advance.
- * @param utf8c The buffer to put the UTF-8 bytes into.
- * @return Returns said code-point or \c CP_EOF.
- */
-NODISCARD
-static char32_t buf_getcp( char const **ppc, utf8c_t utf8c ) {
-  int c;
-  if ( unlikely( (c = buf_getc( ppc )) == EOF ) )
-    return CP_EOF;
-  size_t const len = utf8_len( STATIC_CAST( char, c ) );
-  if ( unlikely( len == 0 ) )
-    return CP_INVALID;
-  utf8c[0] = STATIC_CAST( char, c );
-  for ( size_t i = 1; i < len; ++i ) {
-    if ( unlikely( (c = buf_getc( ppc )) == EOF ) )
-      return CP_EOF;
-    if ( unlikely( !utf8_is_cont( STATIC_CAST( char, c ) ) ) )
-      return CP_INVALID;
-    utf8c[i] = STATIC_CAST( char, c );
-  } // for
+    if ( HAS( WRAP_FEAT_OPTIMAL ) && !ctx->is_long_line &&
+         ctx->spans.len > 1 ) {
+      //
+      // We're minimizing raggedness, but the current word is too wide to fit
+      // on a line by itself: print the lines before it so it can be handled
+      // as a "long line" (below) without having to keep all of it.
+      //
+      put_optimal( ctx, ctx->spans.len - 1, ctx->spans.len - 1 );
+    }
 
-  return utf8_decode( utf8c );
-}
+    if ( HAS( WRAP_FEAT_HYPHENATE ) && !ctx->is_long_line ) {
+      //
+      // If the current word may be hyphenated so that its first part fits on
+      // the line, split its span there so it's wrapped after that (below).
+      //
+      hyphen_split( ctx, pb );
+    }
 
-/**
- * Reads the next line of input.  If wrapping Markdown, adjust wrap's settings.
- *
- * @return Returns the number of bytes read.
- */
-NODISCARD
-static size_t buf_readline( void ) {
-  size_t bytes_read;
+    if ( ctx->spans.len < 2 ) {
+      //
+      // We've exceeded the line width, but haven't encountered a whitespace
+      // character at which to wrap; therefore, we've got a "long line."
+      //
+      if ( !ctx->is_long_line ) {
+        put_lead_chars( ctx );
+        ++ctx->stats.long_lines;
+      }
+      put_line( ctx, ctx->output_len, /*do_eol=*/false );
+      ctx->is_long_line = true;
+      continue;
+    }
 
-  while ( (bytes_read = check_readline( input_buf, stdin )) > 0 ) {
-    if ( !opt_markdown )
-      break;
-    //
-    // We're doing Markdown: we might have to adjust wrap's indent, hang-
-    // indent, and line-width for each Markdown line.
     //
-    // However, don't pass either IPC lines or any lines while is_preformatted
-    // is true through the Markdown parser.
+    // Wrap before the last span: print everything before it (but not the
+    // spaces preceding it), then move the span (that is the partial word) to
+    // the left after the hang-indent where we can pick up from where we left
+    // off the next time around.
     //
-    if ( input_buf[0] == WIPC_CODE_HELLO || is_preformatted )
-      break;
+    word_span_t const partial = *span_list_last( &ctx->spans );
+    if ( partial.gap > 0 )
+      ++ctx->stats.wraps_space;
+    else
+      ++ctx->stats.wraps_hyphen;
+    put_lead_chars( ctx );
+    put_line( ctx, partial.offset - partial.gap, /*do_eol=*/true );
 
-    if ( markdown_adjust() )
-      break;
-  } // while
+    size_t const hang_len = ctx->opt.hang_tabs + ctx->opt.hang_spaces;
+    line_buf_reserve( &ctx->output_buf, hang_len + partial.len );
+    memmove(
+      ctx->output_buf.str + hang_len, ctx->output_buf.str + partial.offset,
+      partial.len
+    );
+    put_tabs_spaces( ctx, ctx->opt.hang_tabs, ctx->opt.hang_spaces );
+    word_span_t *const moved =
+      span_list_push( &ctx->spans, ctx->output_len, /*gap=*/0 );
+    moved->len = partial.len;
+    moved->width = partial.width;
+    ctx->output_len += partial.len;
+    ctx->output_width += partial.width;
 
-#ifdef DEBUG_MARKDOWN
-  if ( bytes_read == 0 )
-    MD_DEBUG( "====================\n" );
-#endif /* DEBUG_MARKDOWN */
-  return bytes_read;
-}
+    ctx->hyphen = HYPHEN_NO;
+    ctx->is_long_line = false;
+  } // for
 
-/**
- * Delimits a paragraph.
- */
-static void delimit_paragraph( void ) {
-  if ( output_len > 0 ) {
-    //
-    // Print what's in the buffer before delimiting the paragraph.  If we've
-    // been handling a "long line," it's now finally ended; otherwise, print
-    // the leading characters.
-    //
-    if ( !true_clear( &is_long_line ) )
-      put_lead_chars();
-    put_line( output_len, /*do_eol=*/true );
-  } else if ( is_long_line ) {
-    put_eol();                          // delimit the "long line"
-  }
+  /////////////////////////////////////////////////////////////////////////////
 
-  encountered_nonws = false;
-  hyphen = HYPHEN_NO;
-  indent = opt_markdown ? INDENT_NONE : INDENT_LINE;
-  put_spaces = 0;
-  was_eos_char = false;
+  ctx->next_line_is_title = next_line_is_title;
+  ctx->pb = pb;
+  ctx->gcb_state = gcb_state;
+  ctx->lb_prev = lb_prev;
+  ctx->cp_prev = cp_prev;
 
-  if ( consec_newlines == 2 ||
-      (consec_newlines > 2 && opt_newlines_delimit == 1) ) {
-    put_lead_chars();
-    put_eol();
-  }
+#undef HAS
 }
 
 /**
- * Sets-up clean-up, parses command-line options, reads the conf. file, sets-up
- * I/O, and probes the input for end-of-line type.
+ * The variants of wrap_loop(), most specialized first, as a list of
+ * <code>X(</code><i>name</i><code>,</code> <i>required</i><code>,</code>
+ * <i>possible</i><code>)</code> where _required_ are the \ref wrap_feature
+ * known to be enabled and _possible_ are those that may additionally be.  The
+ * last must be able to handle any combination of features.
  *
- * @param argc The number of command-line arguments from main().
- * @param argv The command-line arguments from main().
+ * @param X The macro to expand for each variant.
+ *
+ * @sa wrap_loop_find()
  */
-static void init( int argc, char const *argv[] ) {
-  ASSERT_RUN_ONCE();
-  ATEXIT( common_cleanup );
-  ATEXIT( wrap_cleanup );
+#define WRAP_LOOP_VARIANTS(X)                                               \
+  X( plain,       WRAP_FEAT_HYPHEN,       WRAP_FEAT_BLOCK_REGEX           ) \
+  X( no_hyphen,   0,                      WRAP_FEAT_BLOCK_REGEX           ) \
+  X( markdown,    WRAP_FEAT_MARKDOWN,     WRAP_FEAT_BLOCK_REGEX             \
+                                        | WRAP_FEAT_HYPHEN                ) \
+  X( eos_delimit, WRAP_FEAT_EOS_DELIMIT,  WRAP_FEAT_BLOCK_REGEX             \
+                                        | WRAP_FEAT_HYPHEN                  \
+                                        | WRAP_FEAT_MARKDOWN              ) \
+  X( any,         0,                      ~0u                             )
 
-  options_init( argc, argv, usage );
-  setlocale_utf8();
+/// @cond DOXYGEN_IGNORE
 
-  if ( opt_markdown ) {
-    markdown_init();
-    opt_tab_spaces = MD_TAB_SPACES;
+#define WRAP_LOOP_DEFINE(NAME,REQUIRED,POSSIBLE)            \
+  static void wrap_loop_##NAME( wrap_ctx_t *ctx ) {         \
+    wrap_loop( ctx, (REQUIRED), (REQUIRED) | (POSSIBLE) );  \
   }
 
-  int const temp_width = STATIC_CAST( int, opt_line_width ) -
-    STATIC_CAST( int,
-      2 * (opt_mirror_tabs * opt_tab_spaces + opt_mirror_spaces) +
-      opt_lead_tabs * opt_tab_spaces + opt_lead_spaces
-    );
+#define WRAP_LOOP_ENTRY(NAME,REQUIRED,POSSIBLE) \
+  { (REQUIRED), (REQUIRED) | (POSSIBLE), &wrap_loop_##NAME },
 
-  if ( temp_width < LINE_WIDTH_MINIMUM ) {
-    fatal_error( EX_USAGE,
-      "line-width (%d) is too small (<%d)\n",
-      temp_width, LINE_WIDTH_MINIMUM
-    );
-  }
-  opt_line_width = line_width = STATIC_CAST( size_t, temp_width );
+WRAP_LOOP_VARIANTS( WRAP_LOOP_DEFINE )
 
-  opt_lead_tabs   += opt_mirror_tabs;
-  opt_lead_spaces += opt_mirror_spaces;
+/// @endcond
 
-  if ( !opt_no_hyphen ) {
-    int const regex_err_code = regex_compile( &nonws_no_wrap_regex, WRAP_RE );
-    if ( regex_err_code != 0 ) {
-      fatal_error( EX_SOFTWARE,
-        "internal regular expression error (%d): %s\n",
-        regex_err_code, regex_error( &nonws_no_wrap_regex, regex_err_code )
+/**
+ * Finds the most specialized variant of wrap_loop() for \a features.
+ *
+ * @param features The bitwise-or of the enabled \ref wrap_feature.
+ * @return Returns said variant.
+ */
+NODISCARD
+static wrap_loop_fn_t wrap_loop_find( unsigned features ) {
+  static wrap_loop_variant_t const VARIANTS[] = {
+    WRAP_LOOP_VARIANTS( WRAP_LOOP_ENTRY )
+  };
+  for ( size_t i = 0; i < ARRAY_SIZE( VARIANTS ); ++i ) {
+    wrap_loop_variant_t const *const v = &VARIANTS[i];
+    if ( (features & v->required) == v->required &&
+         (features & ~v->possible) == 0 ) {
+      return v->loop_fn;
+    }
+  } // for
+  INTERNAL_ERROR( "no main loop variant for features %#x\n", features );
+}
+
+/**
+ * Reformats as much of the input of \a ctx as has been given so far: for a
+ * file, reads until EOF and, for input given via wrap_feed(), stops when it
+ * runs out of complete lines.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+static void wrap_process( wrap_ctx_t *ctx ) {
+  if ( !ctx->is_started && !wrap_start( ctx ) )
+    return;
+
+  (*ctx->loop_fn)( ctx );
+
+  if ( ctx->is_wrap_end ) {
+    if ( ctx->fin == NULL ) {           // pass the rest through verbatim
+      writer_write(
+        &ctx->wout, ctx->feed_buf.str + ctx->feed_pos,
+        ctx->feed_end - ctx->feed_pos
       );
+      ctx->feed_pos = ctx->feed_end;
     }
+    return;
   }
+  if ( !ctx->is_input_end )
+    return;
 
-  if ( opt_block_regex != NULL ) {
-    if ( opt_block_regex[0] != '^' ) {
-      char *const temp =
-        free_later( MALLOC( char, strlen( opt_block_regex ) + 1/*\0*/ ) );
-      temp[0] = '^';
-      strcpy( temp + 1, opt_block_regex );
-      opt_block_regex = temp;
-    }
-    int const regex_err_code = regex_compile( &block_regex, opt_block_regex );
-    if ( regex_err_code != 0 ) {
-      fatal_error( EX_USAGE,
-        "\"%s\": regular expression error (%d): %s\n",
-        opt_block_regex, regex_err_code,
-        regex_error( &block_regex, regex_err_code )
-      );
+  if ( ctx->output_len > 0 ) {          // print left-over text
+    if ( ctx->opt.optimal > 0 && !ctx->is_long_line ) {
+      put_optimal( ctx, ctx->spans.len, ctx->spans.len );
+    } else {
+      if ( !ctx->is_long_line )
+        put_lead_chars( ctx );
+      put_line( ctx, ctx->output_len, /*do_eol=*/true );
     }
   }
+  measure_para_end( ctx );
+}
 
-  size_t const bytes_read = buf_readline();
-  if ( bytes_read == 0 )
-    exit( EX_OK );
+/**
+ * Starts reformatting the input of \a ctx by reading its first line.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if either the first line was read or the rest
+ * of the input is to be passed through verbatim or `false` if there is no
+ * input either yet or at all.
+ */
+static bool wrap_start( wrap_ctx_t *ctx ) {
+  ctx->loop_fn = wrap_engine == WRAP_ENGINE_REFERENCE ?
+    &wrap_loop_any : wrap_loop_find( ctx->features );
 
-  if ( opt_eol == EOL_INPUT ) {
+  size_t const bytes_read = buf_readline( ctx );
+  if ( bytes_read == 0 ) {
+    if ( !ctx->is_wrap_end )
+      return false;
+    ctx->pb = "";                       // so the rest is passed through
+    ctx->is_started = true;
+    return true;
+  }
+
+  if ( ctx->opt.eol == EOL_INPUT && ctx->fin == NULL ) {
     //
     // We're supposed to use the same end-of-lines as the input, but we can't
     // just wait until we read a \r as part of the normal character-at-a-time
@@ -748,10 +6012,26 @@ static void init( int argc, char const *argv[] ) {
     // first line is a long line, we'll need to wrap it (by emitting a newline)
     // before we get to the end of the line and read the \r.
     //
-    // Therefore, we have to read only the first line in its entirety and peek
-    // ahead to see if it ends with \r\n.
+    // For a file, the reader notes the end-of-line of the first newline as
+    // soon as it reads the block containing it (which, for a memory-mapped
+    // file, is immediately, and, for parallel wrapping, is before forking) so
+    // put_eol() asks it when it first needs to know.  For input that's given,
+    // the first line is complete by now, so peek at whether it ends with \r\n.
+    //
+    ctx->opt.eol = is_windows_eol( ctx->input_buf.str, bytes_read ) ?
+      EOL_WINDOWS : EOL_UNIX;
+  }
+
+  ctx->pb = ctx->input_buf.str;
+  if ( ctx->input_offset == bytes_read &&
+       strncmp( ctx->pb, UTF8_BYTE_ORDER_MARK, 3 ) == 0 ) {
     //
-    opt_eol = is_windows_eol( input_buf, bytes_read ) ? EOL_WINDOWS : EOL_UNIX;
+    // A byte order mark is meaningful only at the very start of the input,
+    // so it's handled only here rather than checked for every character.
+    //
+    if ( opt_keep_bom )
+      writer_write( &ctx->wout, UTF8_BYTE_ORDER_MARK, 3 );
+    ctx->pb += 3;
   }
 
   //
@@ -760,18 +6040,21 @@ static void init( int argc, char const *argv[] ) {
   if ( opt_lead_string != NULL || opt_prototype ) {
     size_t proto_len = 0;
     size_t proto_width = 0;
-    for ( char const *s = opt_lead_string != NULL ? opt_lead_string : input_buf;
-          *s != '\0';
-          ++s, ++proto_len ) {
+    char const *const proto =
+      opt_lead_string != NULL ? opt_lead_string : ctx->pb;
+    for ( char const *s = proto; *s != '\0'; ++s, ++proto_len ) {
       if ( opt_prototype && !is_space( *s ) )
         break;
-      if ( proto_len == sizeof proto_buf - 1 )
-        break;
-      proto_buf[ proto_len ] = *s;
-      proto_width += *s == '\t' ?
-        (opt_tab_spaces - proto_len % opt_tab_spaces) : 1;
+      line_buf_reserve( &ctx->proto_buf, proto_len + 1 );
+      ctx->proto_buf.str[ proto_len ] = *s;
+      if ( *s == '\t' )
+        proto_width += ctx->opt.tab_spaces - proto_len % ctx->opt.tab_spaces;
+      else if ( !utf8_is_cont( *s ) )
+        proto_width += utf8_width( s );
     } // for
-    line_width = opt_line_width - proto_width;
+    ctx->proto_buf.str[ proto_len ] = '\0';
+    ctx->proto_len = proto_len;
+    ctx->line_width = ctx->opt.line_width - proto_width;
     if ( opt_lead_string != NULL ) {
       //
       // Split off the trailing whitespace (tws) from the prototype so that if
@@ -786,365 +6069,15 @@ static void init( int argc, char const *argv[] ) {
       // then when we wrapped the text above, the second line would become "# "
       // containing a trailing whitespace.
       //
-      split_tws( proto_buf, proto_len, proto_tws );
-    }
-  }
-}
-
-/**
- * Adjusts wrap's indent, hang-indent, and line-width for each Markdown line.
- *
- * @return Returns `true` if we're to proceed or \c false if another line
- * should be read.
- */
-NODISCARD
-static bool markdown_adjust( void ) {
-  static md_line_t  prev_line_type;
-  static md_seq_t   prev_seq_num = MD_SEQ_NUM_INIT;
-
-  md_state_t const *const md = markdown_parse( input_buf );
-  MD_DEBUG(
-    "T=%c N=%2u D=%u L=%u H=%u|%s",
-    STATIC_CAST( char, md->line_type ), md->seq_num, md->depth,
-    md->indent_left, md->indent_hang, input_buf
-  );
-
-  if ( prev_line_type != md->line_type ) {
-    switch ( prev_line_type ) {
-      case MD_CODE:
-      case MD_HEADER_ATX:
-      case MD_HR:
-      case MD_HTML_ABBR:
-      case MD_HTML_BLOCK:
-      case MD_LINK_LABEL:
-      case MD_TABLE:
-        consec_newlines = 0;
-        if ( is_blank_line( input_buf ) ) {
-          //
-          // Prevent blank lines immediately after these Markdown line types
-          // from being swallowed by wrap by just printing them directly.
-          //
-          PUTS( input_buf );
-        }
-        break;
-      case MD_DL:
-      case MD_FOOTNOTE_DEF:
-      case MD_HEADER_LINE:
-      case MD_NONE:
-      case MD_OL:
-      case MD_TEXT:
-      case MD_UL:
-        // nothing to do
-        break;
-    } // switch
-
-    if ( md->line_type == MD_FOOTNOTE_DEF && !md->footnote_def_has_text ) {
-      //
-      // For a footnote definition line that does not have text on the same
-      // line:
-      //
-      //      [^1]:
-      //          Like this.
-      //
-      // print the marker line as-is "behind wrap's back" so it won't be
-      // wrapped.
-      //
-      PUTS( input_buf );
-      input_buf[0] = '\0';
-    }
-
-    prev_line_type = md->line_type;
-  }
-
-  switch ( md->line_type ) {
-    case MD_CODE:
-    case MD_HEADER_ATX:
-    case MD_HEADER_LINE:
-    case MD_HR:
-    case MD_HTML_ABBR:
-    case MD_HTML_BLOCK:
-    case MD_LINK_LABEL:
-    case MD_TABLE:
-      //
-      // Flush output_buf and print the Markdown line as-is "behind wrap's
-      // back" because these line types are never wrapped.
-      //
-      put_lead_chars();
-      put_line( output_len, /*do_eol=*/true );
-      PUTS( input_buf );
-      return false;
-
-    case MD_DL:
-    case MD_FOOTNOTE_DEF:
-    case MD_OL:
-    case MD_UL:
-      if ( md->seq_num > prev_seq_num ) {
-        //
-        // We're changing line types: flush output_buf.
-        //
-        put_lead_chars();
-        put_line( output_len, /*do_eol=*/true );
-        prev_seq_num = md->seq_num;
-      }
-      else if ( output_len == 0 && !is_blank_line( input_buf ) ) {
-        //
-        // Same line type, but new line: hang indent.
-        //
-        put_tabs_spaces( /*tabs=*/0, md->indent_hang );
-      }
-      line_width = opt_line_width - md->indent_left;
-      opt_lead_spaces = md->indent_left;
-      opt_hang_spaces = md->indent_hang;
-      return true;
-
-    case MD_NONE:
-    case MD_TEXT:
-      markdown_reset();
-      return true;
-  } // switch
-}
-
-/**
- * Resets variables affected by the Markdown parser.
- */
-static void markdown_reset( void ) {
-  line_width = opt_line_width;
-  opt_hang_spaces = opt_lead_spaces = 0;
-}
-
-/**
- * Prints the leading characters for lines.
- */
-static void put_lead_chars( void ) {
-  if ( proto_buf[0] != '\0' ) {
-    PRINTF( "%s%s", proto_buf, output_len > 0 ? proto_tws : "" );
-  }
-  else if ( output_len > 0 ) {
-    for ( size_t i = 0; i < opt_lead_tabs; ++i )
-      PUTC( '\t' );
-    for ( size_t i = 0; i < opt_lead_spaces; ++i )
-      PUTC( ' ' );
-  }
-}
-
-/**
- * Prints the current output buffer as a line and resets the output buffer's
- * length.
- *
- * @param len The length of the output buffer.
- * @param do_eol If `true`, prints and end-of-line afterwards.
- */
-static void put_line( size_t len, bool do_eol ) {
-  output_buf[ len ] = '\0';
-  if ( len > 0 ) {
-    PUTS( output_buf );
-    if ( do_eol )
-      put_eol();
-  }
-  output_len = output_width = 0;
-}
-
-/**
- * Puts \a tabs tabs and \a spaces spaces (in that order) into the output
- * buffer and increments the output width accordingly.
- *
- * @param tabs The number of tabs to put.
- * @param spaces The number of spaces to put.
- */
-static void put_tabs_spaces( size_t tabs, size_t spaces ) {
-  output_width += tabs * opt_tab_spaces + spaces;
-  while ( tabs-- > 0 )
-    output_buf[ output_len++ ] = '\t';
-  while ( spaces-- > 0 )
-    output_buf[ output_len++ ] = ' ';
-}
-
-/**
- * Prints the usage message and exits.
- *
- * @param status The status to exit with.  If it is `EX_OK`, prints to standard
- * output; otherwise prints to standard error.
- */
-static void usage( int status ) {
-  fprintf( status == EX_OK ? stdout : stderr,
-"usage: " PACKAGE " [options]\n"
-"options:\n"
-"  --alias=NAME           " UOPT(ALIAS)
-                          "Use alias from configuration file.\n"
-"  --all-newlines-delimit " UOPT(ALL_NEWLINES_DELIMIT)
-                          "Treat newlines as paragraph delimiters.\n"
-"  --block-regex=REGEX    " UOPT(BLOCK_REGEX)
-                          "Block leading regular expression.\n"
-"  --config=FILE          " UOPT(CONFIG)
-                          "Configuration file path [default: ~/" CONF_FILE_NAME_DEFAULT "].\n"
-"  --dot-ignore           " UOPT(DOT_IGNORE)
-                          "Do not alter lines that begin with '.' (dot).\n"
-"  --eol=STR              " UOPT(EOL) "\n"
-"      Set line-endings as input/Unix/Windows [default: input].\n"
-"  --eos-delimit          " UOPT(EOS_DELIMIT) "\n"
-"      Treat whitespace after end-of-sentence as a paragraph delimiter.\n"
-"  --eos-spaces=NUM       " UOPT(EOS_SPACES)
-                          "Spaces after end-of-sentence [default: " STRINGIFY(EOS_SPACES_DEFAULT) "].\n"
-"  --file=FILE            " UOPT(FILE)
-                          "Read from this file [default: stdin].\n"
-"  --file-name=NAME       " UOPT(FILE_NAME)
-                          "Filename for stdin.\n"
-"  --hang-spaces=NUM      " UOPT(HANG_SPACES) "\n"
-"      Hang-indent spaces after tabs for all but first line of every paragraph.\n"
-"  --hang-tabs=NUM        " UOPT(HANG_TABS) "\n"
-"      Hang-indent tabs for all but first line of every paragraph.\n"
-"  --help                 " UOPT(HELP)
-                          "Print this help and exit.\n"
-"  --indent-spaces=NUM    " UOPT(INDENT_SPACES) "\n"
-"      Indent spaces after tabs for first line of every paragraph.\n"
-"  --indent-tabs=NUM      " UOPT(INDENT_TABS)
-                          "Indent tabs for first line of every paragraph.\n"
-"  --lead-spaces=NUM      " UOPT(LEAD_SPACES)
-                          "Prepend leading spaces after tabs to every line.\n"
-"  --lead-string=STR      " UOPT(LEAD_STRING)
-                          "String to prepend to every line.\n"
-"  --lead-tabs=NUM        " UOPT(LEAD_TABS)
-                          "Prepend leading tabs to every line.\n"
-"  --markdown             " UOPT(MARKDOWN)
-                          "Format Markdown.\n"
-"  --mirror-spaces=NUM    " UOPT(MIRROR_SPACES)
-                          "Mirror spaces.\n"
-"  --mirror-tabs=NUM      " UOPT(MIRROR_TABS)
-                          "Mirror tabs.\n"
-"  --no-config            " UOPT(NO_CONFIG)
-                          "Suppress reading configuration file.\n"
-"  --no-hyphen            " UOPT(NO_HYPHEN)
-                          "Suppress wrapping at hyphen characters.\n"
-"  --no-newlines-delimit  " UOPT(NO_NEWLINES_DELIMIT)
-                          "Do not treat newlines as paragraph delimiters.\n"
-"  --output=FILE          " UOPT(OUTPUT)
-                          "Write to this file [default: stdout].\n"
-"  --para-chars=STR       " UOPT(PARA_CHARS)
-                          "Additional paragraph delimiter characters.\n"
-"  --prototype            " UOPT(PROTOTYPE) "\n"
-"      Treat leading whitespace on first line as prototype.\n"
-"  --tab-spaces=NUM       " UOPT(TAB_SPACES)
-                          "Tab-spaces equivalence [default: " STRINGIFY(TAB_SPACES_DEFAULT) "].\n"
-"  --title                " UOPT(TITLE_LINE)
-                          "Treat paragraph's first line as title.\n"
-"  --version              " UOPT(VERSION)
-                          "Print version and exit.\n"
-"  --whitespace-delimit   " UOPT(WHITESPACE_DELIMIT) "\n"
-"      Treat lines beginning with whitespace as paragraph delimiters.\n"
-"  --width=NUM|terminal   " UOPT(WIDTH)
-                          "Line width [default: " STRINGIFY(LINE_WIDTH_DEFAULT) "].\n"
-"\n"
-PACKAGE_NAME " home page: " PACKAGE_URL "\n"
-"Report bugs to: " PACKAGE_BUGREPORT "\n"
-  );
-  exit( status );
-}
-
-/**
- * Parses a \ref wipc_code.
- *
- * @param ppc A pointer to the pointer to character to advance.  It must be
- * positioned at the IPC code after #WIPC_CODE_HELLO.
- */
-static void wipc_parse( char const **ppc ) {
-  assert( ppc != NULL );
-  assert( *ppc != NULL );
-
-  char const c = *(*ppc)++;
-  if ( unlikely( c == '\0' ) )
-    return;
-
-  switch ( STATIC_CAST( wipc_code_t, c ) ) {
-    case WIPC_CODE_HELLO:               // shouldn't happen
-      break;
-
-    case WIPC_CODE_DELIMIT_PARAGRAPH:
-      consec_newlines = 0;
-      delimit_paragraph();
-      WIPC_SEND( stdout, WIPC_CODE_DELIMIT_PARAGRAPH );
-      break;
-
-    case WIPC_CODE_NEW_LEADER:
-      NO_OP;
-      //
-      // We've been told by wrapc (child 1) that the comment characters and/or
-      // leading whitespace has changed: we have to echo it back to the other
-      // wrapc process (parent).
-      //
-      // If an output line has already been started, we have to defer the IPC
-      // until just after the line is sent; otherwise, we must send it
-      // immediately.
-      //
-      char *sep;
-      size_t const new_line_width = strtoul( *ppc, &sep, 10 );
-      if ( output_len > 0 ) {
-        WIPC_DEFERF(
-          ipc_buf, sizeof ipc_buf,
-          WIPC_CODE_NEW_LEADER, "%zu" WIPC_PARAM_SEP "%s",
-          new_line_width, sep + 1
-        );
-        ipc_width = new_line_width;
-      } else {
-        WIPC_SENDF(
-          stdout,
-          WIPC_CODE_NEW_LEADER, "%zu" WIPC_PARAM_SEP "%s",
-          new_line_width, sep + 1
-        );
-        line_width = opt_line_width = new_line_width;
-      }
-      break;
-
-    case WIPC_CODE_PREFORMATTED_BEGIN:
-      delimit_paragraph();
-      WIPC_SEND( stdout, WIPC_CODE_PREFORMATTED_BEGIN );
-      is_preformatted = true;
-      break;
-
-    case WIPC_CODE_PREFORMATTED_END:
-      consec_newlines = 1;
-      delimit_paragraph();
-      WIPC_SEND( stdout, WIPC_CODE_PREFORMATTED_END );
-      is_preformatted = false;
-      break;
-
-    case WIPC_CODE_WRAP_END:
-      //
-      // We've been told by wrapc (child 1) that we've reached the end of the
-      // comment: dump any remaining buffer, propagate the interprocess message
-      // to the other wrapc process (parent), and pass text through verbatim.
-      //
-      consec_newlines = 0;
-      delimit_paragraph();
-      WIPC_SEND( stdout, WIPC_CODE_WRAP_END );
-      fcopy( stdin, stdout );
-      exit( EX_OK );
-  } // switch
-}
-
-/**
- * Sends an already formatted IPC (interprocess communication) message (if not
- * empty) to **wrapc**(1).
- *
- * @param msg The message to send.  If sent, the buffer is truncated.
- */
-static void wipc_send( char *msg ) {
-  assert( msg != NULL );
-  if ( msg[0] != '\0' ) {
-    WIPC_SENDF( stdout, /*IPC_code=*/msg[0], "%s", msg + 1 );
-    msg[0] = '\0';
-    if ( ipc_width > 0 ) {
-      line_width = opt_line_width = ipc_width;
-      ipc_width = 0;
+      line_buf_reserve( &ctx->proto_tws, proto_len );
+      ctx->proto_len =
+        split_tws( ctx->proto_buf.str, proto_len, ctx->proto_tws.str );
+      ctx->proto_tws_len = proto_len - ctx->proto_len;
     }
   }
-}
 
-/**
- * Cleans up wrap data.
- */
-static void wrap_cleanup( void ) {
-  regex_free( &block_regex );
-  regex_free( &nonws_no_wrap_regex );
+  ctx->is_started = true;
+  return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,513 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_wrap_H
+#define wrap_wrap_H
+
+/**
+ * @file
+ * Declares a data structure and functions for running the **wrap**(1) engine
+ * that's linked into both **wrap**(1) and **wrapc**(1).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "doxygen.h"
+#include "markdown.h"
+#include "markup.h"
+#include "options.h"
+#include "simd.h"
+#include "span.h"
+#include "unicode.h"
+#include "wipc.h"
+#include "wregex.h"
+#include "writer.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint64_t */
+#include <stdio.h>                      /* for FILE */
+
+/// @endcond
+
+/**
+ * @defgroup wrap-engine-group Wrap Engine
+ * A data structure and functions for reformatting text per the current
+ * options: either standard input to standard output or, via a \ref wrap_ctx,
+ * text given to it piecemeal to a function.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Hyphenation states.
+ */
+enum hyphen {                           // H = hyphen-adjacent char
+  HYPHEN_NO,                            ///< Didn't encounter a hyphen.
+  HYPHEN_MAYBE,                         ///< Encountered `H-`.
+  HYPHEN_YES                            ///< Encountered `H-H`.
+};
+typedef enum hyphen hyphen_t;
+
+/**
+ * Line indentation type.
+ */
+enum indent {
+  INDENT_NONE,                          ///< No indentation.
+
+  /// Indent only first line of a paragraph.
+  INDENT_LINE,
+
+  /// Indent all lines but first of a paragraph.
+  INDENT_HANG
+};
+typedef enum indent indent_t;
+
+/**
+ * Features of the main loop resolved from the options once per
+ * \ref wrap_ctx so the main loop can be specialized for a combination of
+ * them: a branch of a feature that can't be enabled is eliminated entirely.
+ */
+enum wrap_feature {
+  WRAP_FEAT_BLOCK_REGEX     = 1u << 0,  ///< Block regular expression given?
+  WRAP_FEAT_EOS_DELIMIT     = 1u << 1,  ///< End-of-sentence delimits para's?
+  WRAP_FEAT_GLUE_SPACES     = 1u << 2,  ///< Never wrap at no-wrap spaces?
+  WRAP_FEAT_HYPHEN          = 1u << 3,  ///< Wrap at hyphens?
+  WRAP_FEAT_HYPHENATE       = 1u << 4,  ///< Hyphenate long words?
+  WRAP_FEAT_LEAD_DOT_IGNORE = 1u << 5,  ///< Ignore lines starting with '.'?
+  WRAP_FEAT_LEAD_WS_DELIMIT = 1u << 6,  ///< Leading whitespace delimit para's?
+  WRAP_FEAT_MARKDOWN        = 1u << 7,  ///< Format Markdown?
+  WRAP_FEAT_OPTIMAL         = 1u << 8,  ///< Minimize raggedness?
+  WRAP_FEAT_PARA_DELIMS     = 1u << 9,  ///< Paragraph delimiter characters?
+  WRAP_FEAT_UNICODE_BREAKS  = 1u << 10  ///< Break per Unicode (UAX #14)?
+};
+typedef enum wrap_feature wrap_feature_t;
+
+
+/**
+ * The options a \ref wrap_ctx starts with copies of, but then adjusts, e.g.,
+ * per Markdown line, so that the global options are never changed.
+ */
+struct wrap_opts {
+  eol_t     eol;                        ///< End-of-line treatment.
+  size_t    eos_spaces;                 ///< Spaces after end-of-sentence.
+  size_t    hang_spaces;                ///< Hanging-indent spaces.
+  size_t    hang_tabs;                  ///< Hanging-indent tabs.
+  size_t    indt_spaces;                ///< Indent spaces.
+  size_t    indt_tabs;                  ///< Indent tabs.
+  bool      justify;                    ///< Justify lines?
+  size_t    lead_spaces;                ///< Number of leading spaces.
+  size_t    lead_tabs;                  ///< Number of leading tabs.
+  size_t    line_width;                 ///< Maximum line width.
+  size_t    newlines_delimit;           ///< Newlines that delimit para's.
+  size_t    optimal;                    ///< Words kept to minimize raggedness.
+  size_t    tab_spaces;                 ///< Number of spaces 1 tab equals.
+};
+typedef struct wrap_opts wrap_opts_t;
+
+struct wrap_ctx;
+
+/**
+ * The signature for a function that classifies the line just read for a kind
+ * of structured text, e.g., Markdown, and adjusts wrap's handling of it: it
+ * may delimit the paragraph before it, adjust the indent, hang-indent, or
+ * line-width for it, or print it as-is if it's never wrapped, e.g., because
+ * it's preformatted.  One is called once per line, if at all, so a kind of
+ * structured text costs nothing for the others.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @return Returns `true` only if the line is to be wrapped; `false` if it has
+ * been handled entirely and the next line should be read.
+ */
+typedef bool (*wrap_block_fn_t)( struct wrap_ctx *ctx );
+
+/**
+ * The signature for a variant of the main loop specialized for a combination
+ * of \ref wrap_feature.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ */
+typedef void (*wrap_loop_fn_t)( struct wrap_ctx *ctx );
+
+/**
+ * The signature for a function that a \ref wrap_ctx initialized by
+ * wrap_ctx_init_measure() hands the measurements of each paragraph it
+ * reformats to rather than the output.
+ *
+ * @param lines The number of lines the paragraph takes.
+ * @param width The width of its widest line including any leading
+ * characters.
+ * @param data The data given to wrap_ctx_init_measure().
+ */
+typedef void (*wrap_measure_fn_t)( size_t lines, size_t width, void *data );
+
+/**
+ * Counts of what a \ref wrap_ctx has done, printed for `--stats`.  Times and
+ * peak memory are measured only if `--stats` was given.
+ *
+ * @note Every member must be a `uint64_t` since they're added as an array.
+ */
+struct wrap_stats {
+  uint64_t  bytes_in;                   ///< Bytes of text read.
+  uint64_t  lines_in;                   ///< Lines of text read.
+  uint64_t  paragraphs;                 ///< Paragraphs delimited.
+  uint64_t  wraps_space;                ///< Lines wrapped at whitespace.
+  uint64_t  wraps_hyphen;               ///< Lines wrapped after a hyphen.
+  uint64_t  long_lines;                 ///< Words too long for a line.
+  uint64_t  block_regex_calls;          ///< Lines matched against `-b`.
+  uint64_t  block_regex_hits;           ///< Lines `-b` matched.
+  uint64_t  block_regex_ns;             ///< Nanoseconds matching `-b`.
+  uint64_t  uri_regex_calls;            ///< Lines searched for URIs.
+  uint64_t  uri_regex_hits;             ///< URIs and e-mail addresses found.
+  uint64_t  uri_regex_ns;               ///< Nanoseconds searching for URIs.
+  uint64_t  md_lines[ sizeof MD_LINE_TYPES - 1 ]; ///< Lines by \ref md_line.
+  uint64_t  md_ns;                      ///< Nanoseconds parsing Markdown.
+  uint64_t  ipc;                        ///< IPC messages processed.
+  uint64_t  ipc_ns;                     ///< Nanoseconds processing IPC.
+  uint64_t  mem_input;                  ///< Peak bytes of input buffers.
+  uint64_t  mem_output;                 ///< Peak bytes of output buffers.
+  uint64_t  mem_regex;                  ///< Peak bytes of regex matches.
+  uint64_t  mem_markdown;               ///< Peak bytes of Markdown state.
+  uint64_t  mem_total;                  ///< Peak bytes of all at once.
+};
+typedef struct wrap_stats wrap_stats_t;
+
+/**
+ * The entire state of reformatting one text: any number of contexts may be in
+ * use at once, including in different threads since, once wrap_init() has
+ * been called, all the state they share is only ever read.
+ *
+ * @sa wrap_ctx_init()
+ */
+struct wrap_ctx {
+  wrap_opts_t     opt;                  ///< Adjusted options.
+  unsigned        features;             ///< Bitwise-or of \ref wrap_feature.
+  wrap_loop_fn_t  loop_fn;              ///< Main loop for features.
+  wrap_block_fn_t block_fn;             ///< Line classifier, if any.
+
+  FILE           *fin;                  ///< File to read input from, if any.
+  line_buf_t      feed_buf;             ///< Otherwise, input from wrap_feed().
+  size_t          feed_len;             ///< Number of characters in feed_buf.
+  size_t          feed_pos;             ///< Position of next line in feed_buf.
+  size_t          feed_scan;            ///< No newline in feed_buf before it.
+  size_t          feed_end;             ///< Reformat feed_buf only up to it.
+  bool            is_input_end;         ///< No more input is coming?
+  bool            is_started;           ///< Has the first line been read?
+  bool            is_wrap_end;          ///< Passing the rest through as-is?
+
+  line_buf_t      input_buf;            ///< Input buffer.
+  md_line_desc_t  input_desc;           ///< Markdown input_buf descriptor.
+  simd_utf8_t     input_utf8;           ///< Whether input_buf is valid UTF-8.
+  char const     *pb;                   ///< Next byte to read when resumed.
+  bool            keep_lead_ws;         ///< Keep next line's leading spaces?
+
+  char32_t        cp_prev;              ///< Previous code-point.
+  cp_gcb_state_t  gcb_state;            ///< Grapheme cluster state.
+  cp_lb_t         lb_prev;              ///< Previous char's line-break class.
+  bool            next_line_is_title;   ///< Is next line a title line?
+
+  size_t          consec_newlines;      ///< Number of consecutive newlines.
+  bool            encountered_nonws;    ///< Encountered a non-whitespace char?
+  hyphen_t        hyphen;               ///< Hyphen state.
+  indent_t        indent;               ///< Indentation to put next.
+  bool            is_long_line;         ///< Line longer than line_width?
+  size_t          line_width;           ///< Maximum width of a line.
+  size_t          put_spaces;           ///< Spaces to put between words.
+  bool            was_eos_char;         ///< Prev char an end-of-sentence char?
+
+  size_t          hyph_begin;           ///< Where hyph_breaks' word begins.
+  bool           *hyph_breaks;          ///< Where it may be hyphenated.
+  size_t          hyph_breaks_cap;      ///< Capacity of hyph_breaks.
+  size_t          hyph_end;             ///< Where hyph_breaks' word ends.
+  bool            hyph_found;           ///< Any hyph_breaks at all?
+  bool            hyph_valid;           ///< Is hyph_breaks for input_buf?
+
+  bool            nonws_no_wrap_check;  ///< More ranges on the line?
+  bool            nonws_no_wrap_enabled;  ///< Look for matches at all?
+  size_t          nonws_no_wrap_next;   ///< Next of nonws_no_wrap_ranges.
+  size_t          nonws_no_wrap_range[2]; ///< Current range.
+  regex_ranges_t  nonws_no_wrap_ranges; ///< All ranges of input_buf.
+  regex_words_t   nonws_no_wrap_words;  ///< Where words begin in input_buf.
+
+  line_buf_t      output_buf;           ///< Output buffer.
+  size_t          output_len;           ///< Number of characters in output_buf.
+  size_t          output_width;         ///< Actual width of output_buf.
+  span_list_t     spans;                ///< Spans of words in output_buf.
+
+  wregex_t        block_regex;          ///< Compiled from opt_block_regex.
+  uint64_t        para_delims[2];       ///< Bitmap of opt_para_delims.
+  line_buf_t      proto_buf;            ///< Prototype buffer.
+  size_t          proto_len;            ///< Length of proto_buf.
+  line_buf_t      proto_tws;            ///< Prototype trailing whitespace.
+  size_t          proto_tws_len;        ///< Length of proto_tws.
+  line_buf_t      lead_buf;             ///< Lead tabs & spaces precomposed.
+  size_t          lead_tabs;            ///< Tabs lead_buf is composed of.
+  size_t          lead_spaces;          ///< Spaces lead_buf is composed of.
+
+  dox_parser_t    dox_parser;           ///< Doxygen parser.
+  bool            dox_pre_pending;      ///< Preformatted text after line?
+
+  md_parser_t     md_parser;            ///< Markdown parser.
+  md_line_t       md_prev_line_type;    ///< Previous Markdown line type.
+  md_seq_t        md_prev_seq_num;      ///< Previous Markdown seq number.
+  regex_ranges_t  md_no_wrap_ranges;    ///< Markdown spans of input_buf.
+  md_table_t      md_table;             ///< Markdown table being aligned.
+  line_buf_t      md_table_buf;         ///< Aligned md_table.
+
+  markup_parser_t markup_parser;        ///< reStructuredText/AsciiDoc parser.
+
+  size_t          quote_depth;          ///< E-mail quote depth of line.
+  bool            quote_in_sig;         ///< In unquoted e-mail signature?
+
+  line_buf_t      ipc_buf;              ///< Deferred IPC message's leader.
+  size_t          ipc_width;            ///< Deferred IPC line width, if any.
+  bool            is_ipc_line;          ///< Is input_buf an IPC message?
+  bool            is_preformatted;      ///< Passing through preformatted text?
+  uint64_t        input_offset;         ///< Characters of input read.
+  wipc_in_t      *wipc_in;              ///< Out-of-band IPC in, if any.
+  wipc_out_t     *wipc_out;             ///< Out-of-band IPC out, if any.
+
+  writer_t        wout;                 ///< Batched output.
+  wrap_stats_t    stats;                ///< Counts for `--stats`.
+  uint64_t        para_ns;              ///< When paragraph started; 0 = none.
+  wrap_stats_t    para_stats;           ///< \ref stats when it started.
+  md_line_t       para_md_line_type;    ///< Its last Markdown line type.
+  md_depth_t      para_md_depth;        ///< Its deepest Markdown depth.
+
+  wrap_measure_fn_t measure_fn;         ///< If measuring, function to call.
+  void           *measure_data;         ///< Data to pass to measure_fn.
+  size_t          measure_lines;        ///< Lines of paragraph so far.
+  size_t          measure_width;        ///< Its widest line so far.
+  size_t          measure_line_width;   ///< Width of the current line so far.
+};
+typedef struct wrap_ctx wrap_ctx_t;
+
+/**
+ * What wrap_step() returns.
+ */
+enum wrap_step {
+  WRAP_STEP_AGAIN,                      ///< Budget spent; call again.
+  WRAP_STEP_NEED_INPUT                  ///< Complete lines given are done.
+};
+typedef enum wrap_step wrap_step_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Frees all memory used by \a ctx.
+ *
+ * @param ctx The \ref wrap_ctx to clean up.
+ *
+ * @sa wrap_ctx_init()
+ */
+void wrap_ctx_cleanup( wrap_ctx_t *ctx );
+
+/**
+ * Initializes \a ctx to reformat text per the current options given to it via
+ * wrap_feed() and hand the output to \a write_fn.
+ *
+ * @param ctx The \ref wrap_ctx to initialize.
+ * @param write_fn The function to hand each buffer of output to.
+ * @param data The data to pass to \a write_fn.
+ *
+ * @note wrap_init() must have been called first.
+ *
+ * @sa wrap_ctx_cleanup()
+ * @sa wrap_feed()
+ * @sa wrap_finish()
+ */
+void wrap_ctx_init( wrap_ctx_t *ctx, writer_fn_t write_fn, void *data );
+
+/**
+ * Initializes \a ctx like wrap_ctx_init() does, but to only measure the text:
+ * lines are broken exactly as they would be, but never written; instead,
+ * the number of lines each paragraph takes and the width of its widest line
+ * are handed to \a measure_fn.  Lines passed through as-is (e.g.,
+ * preformatted text) aren't measured.
+ *
+ * @param ctx The \ref wrap_ctx to initialize.
+ * @param measure_fn The function to hand each paragraph's measurements to.
+ * @param data The data to pass to \a measure_fn.
+ *
+ * @note wrap_init() must have been called first.
+ *
+ * @sa wrap_ctx_cleanup()
+ * @sa wrap_feed()
+ * @sa wrap_finish()
+ */
+void wrap_ctx_init_measure( wrap_ctx_t *ctx, wrap_measure_fn_t measure_fn,
+                            void *data );
+
+/**
+ * Resets \a ctx, once wrap_finish() has been called for it, to reformat
+ * another text per the current options, e.g., a line width that has changed
+ * since, reusing all of its memory.
+ *
+ * @param ctx The \ref wrap_ctx to reset.
+ *
+ * @sa wrap_ctx_init()
+ */
+void wrap_ctx_reset( wrap_ctx_t *ctx );
+
+/**
+ * Gives more input to \a ctx: every line of it that's complete is reformatted
+ * right away; the rest is kept until either its end is given or wrap_finish()
+ * is called.  The output is the same however the input is divided among
+ * calls.
+ *
+ * @param ctx The \ref wrap_ctx to give the input to.
+ * @param s The characters of input.
+ * @param len The number of characters of input.
+ *
+ * @sa wrap_finish()
+ * @sa wrap_step()
+ */
+void wrap_feed( wrap_ctx_t *ctx, char const *s, size_t len );
+
+/**
+ * Tells \a ctx that there is no more input: reformats what's left and hands
+ * all remaining output to its function.
+ *
+ * @param ctx The \ref wrap_ctx to finish.
+ *
+ * @sa wrap_feed()
+ */
+void wrap_finish( wrap_ctx_t *ctx );
+
+/**
+ * Gives more input to \a ctx like wrap_feed(), but without reformatting any
+ * of it: that's done by subsequent calls to wrap_step().
+ *
+ * @param ctx The \ref wrap_ctx to give the input to.
+ * @param s The characters of input.
+ * @param len The number of characters of input.
+ *
+ * @sa wrap_step()
+ */
+void wrap_give( wrap_ctx_t *ctx, char const *s, size_t len );
+
+/**
+ * Initializes the engine: sets-up clean-up and applies the options that are
+ * the same for every \ref wrap_ctx.  For **wrap**(1), it may also fork child
+ * processes to reformat either files in place or standard input in parallel.
+ *
+ * @note This must be called exactly once, after options_init() (or after the
+ * options have otherwise been set), and before either wrap_ctx_init() or
+ * wrap_run().
+ *
+ * @sa wrap_run()
+ */
+void wrap_init( void );
+
+/**
+ * Prepares once what each \ref wrap_ctx initialized afterwards for an alias
+ * of the configuration file found from the current directory would otherwise
+ * prepare itself: compiles the alias's block regular expression.  A
+ * \ref wrap_ctx whose block regular expression is the same, including in any
+ * process forked afterwards and whichever configuration file it read, borrows
+ * the compiled code.  Also creates the paragraph cache shared by all workers
+ * of the size in mebibytes given by `WRAP_SERVER_CACHE`, if any.
+ *
+ * @note This is meant to be called by a server before forking workers.
+ *
+ * @sa para_cache_shm_init()
+ * @sa regex_preset()
+ * @sa server_main()
+ */
+void wrap_preset( void );
+
+/**
+ * Reformats standard input to standard output until EOF, then exits.
+ *
+ * @sa wrap_init()
+ */
+_Noreturn void wrap_run( void );
+
+/**
+ * Reformats standard input to standard output until EOF like wrap_run() does,
+ * but receives and sends IPC messages out-of-band rather than in-band.
+ *
+ * @param from_fd The file descriptor to receive IPC messages from.
+ * @param to_fd The file descriptor to send IPC messages to.
+ *
+ * @sa wrap_init()
+ * @sa \ref wipc-group
+ */
+_Noreturn void wrap_run_wipc( int from_fd, int to_fd );
+
+/**
+ * Prints the \ref wrap_stats of reformatting standard input via wrap_run() to
+ * standard error as a single line of _name_`=`_value_ pairs.
+ *
+ * @note This is meant to be registered via **atexit**(3) after wrap_init()
+ * has been called so that it's called before the output is cleaned up.
+ */
+void wrap_stats_print( void );
+
+/**
+ * Reformats some of the input given to \a ctx via wrap_give(): the lines up
+ * to and including the one that the first \a budget characters not yet
+ * reformatted end within, so a line is never split between calls.  It never
+ * waits for input, so an event loop can interleave calls to it with other
+ * work rather than reformatting a large document all at once.  All output
+ * produced is handed to the function given to wrap_ctx_init() before it
+ * returns.
+ *
+ * @param ctx The \ref wrap_ctx to use.
+ * @param budget The number of characters to reformat (at least one line).
+ * @return Returns #WRAP_STEP_AGAIN if it stopped short of the end of the
+ * input given because of \a budget (though what's left may turn out to be
+ * only an incomplete line) or #WRAP_STEP_NEED_INPUT if not.  Either way, the
+ * caller may give more input or, if there is none, call wrap_finish().
+ *
+ * @sa wrap_feed()
+ */
+NODISCARD
+wrap_step_t wrap_step( wrap_ctx_t *ctx, size_t budget );
+
+/**
+ * Estimates the line width that text was already wrapped to from a histogram
+ * of the lengths (in columns) of its lines that were wrapped, i.e., that are
+ * followed by a non-blank line.  Since text is wrapped before a line reaches
+ * the line width, it's one more than the longest such length that, together
+ * with the few lengths just shorter than it, accounts for a good fraction of
+ * the lines.
+ *
+ * @param s The text.  Only complete lines are counted.
+ * @param size The number of characters of \a s.
+ * @return Returns said line width or 0 if there are too few wrapped lines to
+ * tell.
+ *
+ * @sa #LINE_WIDTH_AUTO
+ */
+NODISCARD
+size_t wrap_width_estimate( char const *s, size_t size );
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+#endif /* wrap_wrap_H */
+/* vim:set et sw=2 ts=2: */
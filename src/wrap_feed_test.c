@@ -0,0 +1,244 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_feed_test.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Checks that reformatting text via wrap_feed() gives the same output however
+ * the text is divided among calls, as does reformatting it via wrap_give()
+ * and wrap_step() whatever the budget.  It takes the same options as
+ * **wrap**(1) and prints the output so it can be compared against that of
+ * **wrap**(1).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "options.h"
+#include "util.h"
+#include "wrap.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdio.h>
+#include <stdlib.h>                     /* for exit() */
+#include <string.h>
+#include <sysexits.h>
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A growable buffer of characters.
+ */
+struct test_buf {
+  char   *str;                          ///< Characters (not null-terminated).
+  size_t  len;                          ///< Number of characters.
+  size_t  cap;                          ///< Capacity of \a str.
+};
+typedef struct test_buf test_buf_t;
+
+// local constant definitions
+
+/// Sizes of the pieces to give the input to wrap_feed() in.
+static size_t const TEST_PIECE_SIZES[] = { 1, 2, 3, 7, 64, 4093 };
+
+/// Budgets to give wrap_step().
+static size_t const TEST_STEP_BUDGETS[] = { 0, 1, 64, 4093 };
+
+/// Size of the pieces to give the input to wrap_give() in.
+#define TEST_STEP_PIECE_SIZE      1021
+
+// extern variable definitions
+char const         *me;                 ///< Program name.
+
+// local functions
+static void         buf_append( test_buf_t*, char const*, size_t );
+static void         buf_write( char const*, size_t, void* );
+
+NODISCARD
+static test_buf_t   read_input( void );
+
+NODISCARD
+static test_buf_t   test_step( test_buf_t const*, size_t );
+
+NODISCARD
+static test_buf_t   test_wrap( test_buf_t const*, size_t );
+
+_Noreturn
+static void         usage( int );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Appends \a len characters of \a s to \a buf.
+ *
+ * @param buf The \ref test_buf to append to.
+ * @param s The characters to append.
+ * @param len The number of characters to append.
+ */
+static void buf_append( test_buf_t *buf, char const *s, size_t len ) {
+  if ( buf->len + len > buf->cap ) {
+    buf->cap = (buf->len + len) * 2;
+    REALLOC( buf->str, char, buf->cap );
+  }
+  memcpy( buf->str + buf->len, s, len );
+  buf->len += len;
+}
+
+/**
+ * The \ref writer_fn_t that appends the output of wrap_feed() to a
+ * \ref test_buf.
+ *
+ * @param s The characters of output.
+ * @param len The number of characters of output.
+ * @param data A pointer to the \ref test_buf to append to.
+ */
+static void buf_write( char const *s, size_t len, void *data ) {
+  buf_append( data, s, len );
+}
+
+/**
+ * Reads all of standard input.
+ *
+ * @return Returns said input that must be freed.
+ */
+static test_buf_t read_input( void ) {
+  test_buf_t input = { NULL, 0, 0 };
+  char chunk[ 8192 ];
+  size_t n;
+  while ( (n = fread( chunk, 1, sizeof chunk, stdin )) > 0 )
+    buf_append( &input, chunk, n );
+  FERROR( stdin );
+  return input;
+}
+
+/**
+ * Reformats \a input by giving it to wrap_give() in pieces of
+ * #TEST_STEP_PIECE_SIZE, calling wrap_step() only once after each so that
+ * input not yet reformatted accumulates, then calling it until it needs more.
+ *
+ * @param input The input to reformat.
+ * @param budget The budget to give wrap_step().
+ * @return Returns the output that must be freed.
+ */
+static test_buf_t test_step( test_buf_t const *input, size_t budget ) {
+  test_buf_t output = { NULL, 0, 0 };
+  wrap_ctx_t ctx;
+  wrap_ctx_init( &ctx, &buf_write, &output );
+  for ( size_t pos = 0; pos < input->len; pos += TEST_STEP_PIECE_SIZE ) {
+    size_t const len = input->len - pos < TEST_STEP_PIECE_SIZE ?
+      input->len - pos : TEST_STEP_PIECE_SIZE;
+    wrap_give( &ctx, input->str + pos, len );
+    PJL_DISCARD_RV( wrap_step( &ctx, budget ) );
+  } // for
+  while ( wrap_step( &ctx, budget ) == WRAP_STEP_AGAIN )
+    ;
+  wrap_finish( &ctx );
+  wrap_ctx_cleanup( &ctx );
+  return output;
+}
+
+/**
+ * Reformats \a input by giving it to wrap_feed() in pieces.
+ *
+ * @param input The input to reformat.
+ * @param piece_size The size of each piece (but the last).
+ * @return Returns the output that must be freed.
+ */
+static test_buf_t test_wrap( test_buf_t const *input, size_t piece_size ) {
+  test_buf_t output = { NULL, 0, 0 };
+  wrap_ctx_t ctx;
+  wrap_ctx_init( &ctx, &buf_write, &output );
+  for ( size_t pos = 0; pos < input->len; pos += piece_size ) {
+    size_t const len = input->len - pos < piece_size ?
+      input->len - pos : piece_size;
+    wrap_feed( &ctx, input->str + pos, len );
+  } // for
+  wrap_finish( &ctx );
+  wrap_ctx_cleanup( &ctx );
+  return output;
+}
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.
+ */
+static void usage( int status ) {
+  EPRINTF( "usage: %s [wrap-options]\n", me );
+  exit( status );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  ATEXIT( common_cleanup );
+  options_init( argc, argv, usage );
+  wrap_init();
+
+  test_buf_t input = read_input();
+  test_buf_t const whole = test_wrap( &input, input.len > 0 ? input.len : 1 );
+  unsigned mismatches = 0;
+
+  for ( size_t i = 0; i < ARRAY_SIZE( TEST_PIECE_SIZES ); ++i ) {
+    test_buf_t pieces = test_wrap( &input, TEST_PIECE_SIZES[i] );
+    if ( pieces.len != whole.len ||
+         memcmp( pieces.str, whole.str, whole.len ) != 0 ) {
+      EPRINTF(
+        "%s: output differs when given in pieces of %zu\n",
+        me, TEST_PIECE_SIZES[i]
+      );
+      ++mismatches;
+    }
+    FREE( pieces.str );
+  } // for
+
+  for ( size_t i = 0; i < ARRAY_SIZE( TEST_STEP_BUDGETS ); ++i ) {
+    test_buf_t steps = test_step( &input, TEST_STEP_BUDGETS[i] );
+    if ( steps.len != whole.len ||
+         memcmp( steps.str, whole.str, whole.len ) != 0 ) {
+      EPRINTF(
+        "%s: output differs when stepped with budget %zu\n",
+        me, TEST_STEP_BUDGETS[i]
+      );
+      ++mismatches;
+    }
+    FREE( steps.str );
+  } // for
+
+  if ( whole.len > 0 )
+    PERROR_EXIT_IF( fwrite( whole.str, 1, whole.len, stdout ) != whole.len,
+                    EX_IOERR );
+  FREE( input.str );
+  FREE( whole.str );
+  exit( mismatches > 0 ? EX_SOFTWARE : EX_OK );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
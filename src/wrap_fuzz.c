@@ -0,0 +1,342 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_fuzz.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * A fuzzing harness that checks that the wrap engine reformats in time linear
+ * in the size of its input: it reformats input via wrap_feed() and fails if
+ * the time per byte, less the fixed cost of reformatting nothing, exceeds a
+ * threshold, i.e., the input makes the engine rescan what it's already seen.
+ *
+ * By default, it takes the same options as **wrap**(1), reformats standard
+ * input, prints the output (so it can be compared against that of
+ * **wrap**(1)), and exits with `EX_SOFTWARE` if the threshold was exceeded.
+ * That also suits AFL (e.g., `afl-fuzz -i in -o out -- wrap_fuzz -f @@`).
+ *
+ * If compiled with `-DWRAP_FUZZ_LIBFUZZER` and `-fsanitize=fuzzer`, it's
+ * instead a libFuzzer target that takes **wrap**(1) options from the
+ * `WRAP_FUZZ_OPTIONS` environment variable and aborts (so libFuzzer saves the
+ * input) if the threshold was exceeded.
+ *
+ * Either way, these environment variables may be set:
+ *
+ *  + `WRAP_FUZZ_NS_PER_BYTE`: The threshold in nanoseconds per byte
+ *    [default: #FUZZ_NS_PER_BYTE_DEFAULT].
+ *  + `WRAP_FUZZ_MIN_BYTES`: The size below which input is too small to be
+ *    timed reliably so the threshold isn't checked
+ *    [default: #FUZZ_MIN_BYTES_DEFAULT].
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "options.h"
+#include "util.h"
+#include "wrap.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <inttypes.h>                   /* for PRIu64 */
+#include <stdint.h>                     /* for uint8_t, uint64_t */
+#include <stdio.h>
+#include <stdlib.h>                     /* for abort(3), exit(3), getenv(3) */
+#include <string.h>
+#include <sysexits.h>
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A growable buffer of characters.
+ */
+struct fuzz_buf {
+  char   *str;                          ///< Characters (not null-terminated).
+  size_t  len;                          ///< Number of characters.
+  size_t  cap;                          ///< Capacity of \a str.
+};
+typedef struct fuzz_buf fuzz_buf_t;
+
+// local constant definitions
+
+/// Default for `WRAP_FUZZ_MIN_BYTES`.
+#define FUZZ_MIN_BYTES_DEFAULT    4096
+
+/// Default for `WRAP_FUZZ_NS_PER_BYTE`.
+#define FUZZ_NS_PER_BYTE_DEFAULT  1000
+
+/// Times to reformat input, of which the fastest is taken.
+#define FUZZ_RUNS                 3
+
+// extern variable definitions
+char const         *me;                 ///< Program name.
+
+// local variable definitions
+static uint64_t     fuzz_base_ns;       ///< Time to reformat nothing.
+static size_t       fuzz_min_bytes;     ///< Checked only if at least this.
+static uint64_t     fuzz_ns_per_byte;   ///< Threshold.
+
+// local functions
+static void         buf_append( fuzz_buf_t*, char const*, size_t );
+static void         buf_write( char const*, size_t, void* );
+
+NODISCARD
+static uint64_t     env_uint( char const*, uint64_t );
+
+static void         fuzz_init( void );
+
+NODISCARD
+static uint64_t     fuzz_ns_per_byte_of( char const*, size_t );
+
+NODISCARD
+static uint64_t     fuzz_time( char const*, size_t, fuzz_buf_t* );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Appends \a len characters of \a s to \a buf.
+ *
+ * @param buf The \ref fuzz_buf to append to.
+ * @param s The characters to append.
+ * @param len The number of characters to append.
+ */
+static void buf_append( fuzz_buf_t *buf, char const *s, size_t len ) {
+  if ( buf->len + len > buf->cap ) {
+    buf->cap = (buf->len + len) * 2;
+    REALLOC( buf->str, char, buf->cap );
+  }
+  memcpy( buf->str + buf->len, s, len );
+  buf->len += len;
+}
+
+/**
+ * The \ref writer_fn_t that appends the output of wrap_feed() to a
+ * \ref fuzz_buf, if any.
+ *
+ * @param s The characters of output.
+ * @param len The number of characters of output.
+ * @param data A pointer to the \ref fuzz_buf to append to or NULL to discard
+ * the output.
+ */
+static void buf_write( char const *s, size_t len, void *data ) {
+  if ( data != NULL )
+    buf_append( data, s, len );
+}
+
+/**
+ * Gets the value of an environment variable as an unsigned integer.
+ *
+ * @param name The name of the environment variable.
+ * @param default_value The value if \a name isn't set.
+ * @return Returns said value.
+ */
+static uint64_t env_uint( char const *name, uint64_t default_value ) {
+  char const *const value = getenv( name );
+  if ( value == NULL || value[0] == '\0' )
+    return default_value;
+  char *end;
+  unsigned long long const n = strtoull( value, &end, 10 );
+  if ( *end != '\0' )
+    fatal_error( EX_USAGE, "\"%s\": invalid value for %s\n", value, name );
+  return n;
+}
+
+/**
+ * Initializes the thresholds and measures the fixed cost of reformatting.
+ * This must be called after wrap_init().
+ */
+static void fuzz_init( void ) {
+  fuzz_min_bytes = env_uint( "WRAP_FUZZ_MIN_BYTES", FUZZ_MIN_BYTES_DEFAULT );
+  fuzz_ns_per_byte =
+    env_uint( "WRAP_FUZZ_NS_PER_BYTE", FUZZ_NS_PER_BYTE_DEFAULT );
+  fuzz_base_ns = fuzz_time( "", 0, /*output=*/NULL );
+}
+
+/**
+ * Gets the time per byte to reformat \a s less the fixed cost of reformatting.
+ *
+ * @param s The input to reformat.
+ * @param len The length of \a s.
+ * @return Returns said time in nanoseconds per byte or 0 if \a len is too
+ * small for it to be reliable.
+ */
+static uint64_t fuzz_ns_per_byte_of( char const *s, size_t len ) {
+  if ( len < fuzz_min_bytes || len == 0 )
+    return 0;
+  uint64_t const ns = fuzz_time( s, len, /*output=*/NULL );
+  return ns > fuzz_base_ns ? (ns - fuzz_base_ns) / len : 0;
+}
+
+/**
+ * Reformats \a s via wrap_feed() #FUZZ_RUNS times.
+ *
+ * @param s The input to reformat.
+ * @param len The length of \a s.
+ * @param output The \ref fuzz_buf to append the output of the first run to or
+ * NULL for none.
+ * @return Returns the fastest time in nanoseconds.
+ */
+static uint64_t fuzz_time( char const *s, size_t len, fuzz_buf_t *output ) {
+  uint64_t min_ns = UINT64_MAX;
+  for ( unsigned run = 0; run < FUZZ_RUNS; ++run ) {
+    wrap_ctx_t ctx;
+    uint64_t const start = now_ns();
+    wrap_ctx_init( &ctx, &buf_write, run == 0 ? output : NULL );
+    if ( len > 0 )                      // s may be NULL if not
+      wrap_feed( &ctx, s, len );
+    wrap_finish( &ctx );
+    wrap_ctx_cleanup( &ctx );
+    uint64_t const ns = now_ns() - start;
+    if ( ns < min_ns )
+      min_ns = ns;
+  } // for
+  return min_ns;
+}
+
+#ifdef WRAP_FUZZ_LIBFUZZER
+
+////////// libFuzzer //////////////////////////////////////////////////////////
+
+// libFuzzer entry points
+int LLVMFuzzerInitialize( int*, char*** );
+int LLVMFuzzerTestOneInput( uint8_t const*, size_t );
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.
+ */
+_Noreturn
+static void usage( int status ) {
+  EPRINTF( "%s: WRAP_FUZZ_OPTIONS: invalid wrap options\n", me );
+  exit( status );
+}
+
+/**
+ * Initializes the engine with the options in the `WRAP_FUZZ_OPTIONS`
+ * environment variable (libFuzzer's own are on the command-line).
+ *
+ * @param pargc A pointer to the command-line argument count.
+ * @param pargv A pointer to the command-line argument values.
+ * @return Always returns 0.
+ */
+int LLVMFuzzerInitialize( int *pargc, char ***pargv ) {
+  static char const *argv[ 64 ];
+  int argc = 0;
+  argv[ argc++ ] = (*pargv)[0];
+  argv[ argc++ ] = "--no-config";
+
+  char const *const options = getenv( "WRAP_FUZZ_OPTIONS" );
+  if ( options != NULL ) {
+    char *const buf = check_strdup( options );
+    for ( char *arg = strtok( buf, " " );
+          arg != NULL && argc < STATIC_CAST( int, ARRAY_SIZE( argv ) ) - 1;
+          arg = strtok( NULL, " " ) ) {
+      argv[ argc++ ] = arg;
+    } // for
+  }
+  argv[ argc ] = NULL;
+
+  (void)pargc;
+  ATEXIT( common_cleanup );
+  options_init( argc, argv, usage );
+  wrap_init();
+  fuzz_init();
+  return 0;
+}
+
+/**
+ * Reformats \a data and aborts if it took too long per byte.
+ *
+ * @param data The input to reformat.
+ * @param size The size of \a data.
+ * @return Always returns 0.
+ */
+int LLVMFuzzerTestOneInput( uint8_t const *data, size_t size ) {
+  char const *const s = POINTER_CAST( char const*, data );
+  uint64_t const ns_per_byte = fuzz_ns_per_byte_of( s, size );
+  if ( ns_per_byte > fuzz_ns_per_byte ) {
+    EPRINTF(
+      "%s: %" PRIu64 " ns/byte exceeds %" PRIu64 " for %zu bytes\n",
+      me, ns_per_byte, fuzz_ns_per_byte, size
+    );
+    abort();
+  }
+  return 0;
+}
+
+#else /* WRAP_FUZZ_LIBFUZZER */
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.
+ */
+_Noreturn
+static void usage( int status ) {
+  EPRINTF( "usage: %s [wrap-options]\n", me );
+  exit( status );
+}
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  ATEXIT( common_cleanup );
+  options_init( argc, argv, usage );
+  wrap_init();
+  fuzz_init();
+
+  fuzz_buf_t input = { NULL, 0, 0 };
+  char chunk[ 8192 ];
+  for ( size_t n; (n = fread( chunk, 1, sizeof chunk, stdin )) > 0; )
+    buf_append( &input, chunk, n );
+  FERROR( stdin );
+
+  fuzz_buf_t output = { NULL, 0, 0 };
+  PJL_DISCARD_RV( fuzz_time( input.str, input.len, &output ) );
+  if ( output.len > 0 )
+    PERROR_EXIT_IF( fwrite( output.str, 1, output.len, stdout ) != output.len,
+                    EX_IOERR );
+
+  uint64_t const ns_per_byte = fuzz_ns_per_byte_of( input.str, input.len );
+  FREE( input.str );
+  FREE( output.str );
+  if ( ns_per_byte > fuzz_ns_per_byte ) {
+    EPRINTF(
+      "%s: %" PRIu64 " ns/byte exceeds %" PRIu64 "\n",
+      me, ns_per_byte, fuzz_ns_per_byte
+    );
+    exit( EX_SOFTWARE );
+  }
+  exit( EX_OK );
+}
+
+#endif /* WRAP_FUZZ_LIBFUZZER */
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,1679 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_lsp.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Implements **wrap-lsp**(1): a Language Server Protocol server that
+ * reformats plain text and Markdown via the **wrap**(1) engine and comments in
+ * source code via **wrapc**(1) for editors.
+ *
+ * @remarks The server holds every open document in memory and applies the
+ * editor's incremental changes to it.  Each formatting request is run by a
+ * child process forked from the server (but not exec'd) that parses options
+ * and runs exactly as either **wrap**(1) or **wrapc**(1) would.  The server
+ * itself never parses options, so every child starts from pristine options.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "json.h"
+#include "options.h"
+#include "rope.h"
+#include "unicode.h"
+#include "util.h"
+#include "wrap.h"
+#include "wrapc.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>                      /* for fcntl(2), open(2) */
+#include <getopt.h>
+#include <limits.h>                     /* for PATH_MAX */
+#include <poll.h>
+#include <signal.h>                     /* for signal(2) */
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for SIZE_MAX */
+#include <stdio.h>
+#include <stdlib.h>                     /* for exit(3) */
+#include <string.h>
+#include <strings.h>                    /* for strncasecmp(3) */
+#include <sys/wait.h>                   /* for waitpid(2) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for close(2), fork(2), ... */
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define LSP_CONTENT_LENGTH        "Content-Length:"
+
+/**
+ * JSON-RPC and LSP error codes.
+ */
+enum lsp_error {
+  LSP_ERR_PARSE             = -32700,   ///< Invalid JSON.
+  LSP_ERR_INVALID_REQUEST   = -32600,   ///< Not a valid request.
+  LSP_ERR_METHOD_NOT_FOUND  = -32601,   ///< Method not supported.
+  LSP_ERR_INVALID_PARAMS    = -32602,   ///< Invalid parameters.
+  LSP_ERR_NOT_INITIALIZED   = -32002,   ///< Request before `initialize`.
+  LSP_ERR_REQUEST_FAILED    = -32803    ///< Formatting failed.
+};
+typedef enum lsp_error lsp_error_t;
+
+/**
+ * A `TextEdit` sent in response to a `textDocument/formatting` request that
+ * the client hasn't (yet) been seen to apply.
+ */
+struct lsp_edit {
+  bool        is_sent;                  ///< Was an edit sent?
+  size_t      begin;                    ///< Offset of first character edited.
+  char       *text;                     ///< The new text.
+  size_t      text_len;                 ///< Length of \a text.
+  size_t      doc_len;                  ///< Length of document once applied.
+};
+typedef struct lsp_edit lsp_edit_t;
+
+/**
+ * A document open in the editor.
+ */
+struct lsp_doc {
+  char       *uri;                      ///< Document URI.
+  char       *lang_id;                  ///< Language identifier.
+  rope_t      text;                     ///< Text of the document.
+  bool        is_dirty;                 ///< Changed since last reformatted?
+  size_t      dirty_begin;              ///< Offset of first changed character.
+  size_t      dirty_end;                ///< Offset of one past last changed.
+  size_t      tab_size;                 ///< `tabSize` last reformatted with.
+  lsp_edit_t  edit;                     ///< Edit sent but not yet applied.
+};
+typedef struct lsp_doc lsp_doc_t;
+
+/**
+ * The signature for a function that handles an LSP method.
+ *
+ * @param id The request ID or NULL for a notification.
+ * @param params The parameters, if any.
+ */
+typedef void (*lsp_method_fn_t)( json_value_t const *id,
+                                 json_value_t const *params );
+
+/**
+ * An LSP method and its handler.
+ */
+struct lsp_method {
+  char const     *name;                 ///< Method name.
+  lsp_method_fn_t fn;                   ///< Method handler.
+};
+typedef struct lsp_method lsp_method_t;
+
+// extern variable definitions
+char const         *me;                 ///< Program name.
+
+// local variable definitions
+static char const **lsp_args;           ///< Options given to every child.
+static size_t       lsp_args_len;       ///< Length of \ref lsp_args.
+static lsp_doc_t   *lsp_docs;           ///< Open documents.
+static size_t       lsp_docs_len;       ///< Length of \ref lsp_docs.
+static json_buf_t   lsp_in;             ///< Buffer for messages read.
+static int          lsp_in_fd = STDIN_FILENO; ///< File to read messages from.
+static size_t       lsp_in_pos;         ///< Position of next message read.
+static bool         lsp_is_initialized; ///< Was `initialize` received?
+static bool         lsp_is_shutdown;    ///< Was `shutdown` received?
+static bool         lsp_is_utf8;        ///< Are positions in UTF-8 bytes?
+static bool         lsp_json_lines;     ///< Messages are JSON lines?
+static int          lsp_out_fd = STDOUT_FILENO; ///< File to write messages to.
+
+/**
+ * Language identifiers of documents that are reformatted entirely by
+ * **wrap**(1) rather than only their comments by **wrapc**(1).
+ */
+static char const *const LSP_TEXT_LANG_IDS[] = {
+  "",
+  "git-commit",
+  "gitcommit",
+  "markdown",
+  "plaintext",
+  "text",
+  NULL
+};
+
+// local functions
+static void         lsp_add_arg( char const* );
+static void         lsp_cleanup( void );
+
+_Noreturn
+static void         lsp_usage( int );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Adds an option to be given to every child.
+ *
+ * @param arg The option.  It's duplicated.
+ */
+static void lsp_add_arg( char const *arg ) {
+  assert( arg != NULL );
+  REALLOC( lsp_args, char const*, lsp_args_len + 1 );
+  lsp_args[ lsp_args_len++ ] = check_strdup( arg );
+}
+
+/**
+ * Cleans up **wrap-lsp**(1) data.
+ */
+static void lsp_cleanup( void ) {
+  for ( size_t i = 0; i < lsp_docs_len; ++i ) {
+    FREE( lsp_docs[i].uri );
+    FREE( lsp_docs[i].lang_id );
+    FREE( lsp_docs[i].edit.text );
+    rope_cleanup( &lsp_docs[i].text );
+  } // for
+  FREE( lsp_docs );
+  for ( size_t i = 0; i < lsp_args_len; ++i )
+    FREE( lsp_args[i] );
+  FREE( lsp_args );
+  json_buf_cleanup( &lsp_in );
+  arena_reset( /*keep_chunk=*/false );
+}
+
+/**
+ * Finds an open document.
+ *
+ * @param uri The URI of the document.  It may be NULL.
+ * @return Returns said document or NULL if not found.
+ */
+NODISCARD
+static lsp_doc_t* lsp_doc_find( json_value_t const *uri ) {
+  if ( uri != NULL ) {
+    for ( size_t i = 0; i < lsp_docs_len; ++i ) {
+      if ( strcmp( lsp_docs[i].uri, uri->s ) == 0 )
+        return &lsp_docs[i];
+    } // for
+  }
+  return NULL;
+}
+
+/**
+ * Checks whether a document contains an edit, i.e., whether the client
+ * applied it.
+ *
+ * @param doc The \ref lsp_doc to check.
+ * @param edit The \ref lsp_edit to check for.
+ * @return Returns `true` only if \a doc contains \a edit.
+ */
+NODISCARD
+static bool lsp_doc_has_edit( lsp_doc_t const *doc, lsp_edit_t const *edit ) {
+  assert( doc != NULL );
+  assert( edit != NULL );
+  if ( !edit->is_sent || rope_len( &doc->text ) != edit->doc_len )
+    return false;
+  rope_iter_t it = { .rope = &doc->text };
+  for ( size_t i = 0; i < edit->text_len; ++i ) {
+    if ( rope_iter_at( &it, edit->begin + i ) != edit->text[i] )
+      return false;
+  } // for
+  return true;
+}
+
+/**
+ * Replaces characters of the text of a document.
+ *
+ * @param doc The \ref lsp_doc to replace the characters of.
+ * @param begin The offset of the first character to replace.
+ * @param end The offset of one past the last character to replace.
+ * @param s The characters to replace them with.
+ * @param len The number of characters to replace them with.
+ */
+static void lsp_doc_replace( lsp_doc_t *doc, size_t begin, size_t end,
+                             char const *s, size_t len ) {
+  assert( doc != NULL );
+  assert( begin <= end );
+  assert( end <= rope_len( &doc->text ) );
+
+  size_t const old_len = end - begin;
+  rope_replace( &doc->text, begin, end, s, len );
+
+  //
+  // Grow the range of changed characters to include the new ones, shifting
+  // its end, if it's after the replaced characters, by the change in length.
+  //
+  if ( !doc->is_dirty ) {
+    doc->is_dirty = true;
+    doc->dirty_begin = begin;
+    doc->dirty_end = begin + len;
+    return;
+  }
+  if ( doc->dirty_end >= end )
+    doc->dirty_end = doc->dirty_end - old_len + len;
+  else if ( doc->dirty_end > begin )
+    doc->dirty_end = begin + len;
+  if ( doc->dirty_begin > begin )
+    doc->dirty_begin = begin;
+  if ( doc->dirty_end < begin + len )
+    doc->dirty_end = begin + len;
+}
+
+/**
+ * Checks whether a document is reformatted entirely by **wrap**(1) rather
+ * than only its comments by **wrapc**(1).
+ *
+ * @param doc The \ref lsp_doc to check.
+ * @return Returns `true` only if \a doc is text.
+ */
+NODISCARD
+static bool lsp_doc_is_text( lsp_doc_t const *doc ) {
+  assert( doc != NULL );
+  for ( char const *const *id = LSP_TEXT_LANG_IDS; *id != NULL; ++id ) {
+    if ( strcmp( doc->lang_id, *id ) == 0 )
+      return true;
+  } // for
+  return false;
+}
+
+/**
+ * Gets the number of position units of a UTF-8 character: 1 byte for UTF-8;
+ * 1 or 2 code units for UTF-16.
+ *
+ * @param c The first byte of the UTF-8 encoded character.
+ * @return Returns said number of units.
+ */
+NODISCARD
+static size_t lsp_char_units( char c ) {
+  if ( lsp_is_utf8 )
+    return 1;
+  return STATIC_CAST( unsigned char, c ) >= 0xF0 ? 2 : 1;
+}
+
+/**
+ * Gets the offset of a position in a document.
+ *
+ * @param doc The \ref lsp_doc to use.
+ * @param pos The LSP `Position`.
+ * @param poff A pointer to receive the offset.  A position beyond the end of
+ * either its line or the document is clamped to it.
+ * @return Returns `true` only if \a pos is a valid `Position`.
+ */
+NODISCARD
+static bool lsp_doc_offset( lsp_doc_t const *doc, json_value_t const *pos,
+                            size_t *poff ) {
+  assert( doc != NULL );
+  assert( poff != NULL );
+
+  size_t line, character;
+  if ( !json_get_size( pos, "line", &line ) ||
+       !json_get_size( pos, "character", &character ) ) {
+    return false;
+  }
+
+  size_t const end = rope_len( &doc->text );
+  size_t off = rope_line_offset( &doc->text, line );
+  rope_iter_t it = { .rope = &doc->text };
+  for ( size_t units = 0; units < character && off < end; ) {
+    char const c = rope_iter_at( &it, off );
+    if ( c == '\n' ||
+         (c == '\r' && off + 1 < end && rope_iter_at( &it, off + 1 ) == '\n') ) {
+      break;
+    }
+    units += lsp_char_units( c );
+    ++off;
+    if ( !lsp_is_utf8 ) {
+      while ( off < end && utf8_is_cont( rope_iter_at( &it, off ) ) )
+        ++off;
+    }
+  } // for
+
+  *poff = off;
+  return true;
+}
+
+/**
+ * Puts the LSP `Position` of an offset in a document.
+ *
+ * @param doc The \ref lsp_doc to use.
+ * @param off The offset.
+ * @param buf The \ref json_buf to put the position into.
+ */
+static void lsp_doc_put_position( lsp_doc_t const *doc, size_t off,
+                                  json_buf_t *buf ) {
+  assert( doc != NULL );
+  assert( off <= rope_len( &doc->text ) );
+  assert( buf != NULL );
+
+  size_t const line = rope_line( &doc->text, off );
+  rope_iter_t it = { .rope = &doc->text };
+  size_t character = 0;
+  for ( size_t i = rope_line_offset( &doc->text, line ); i < off; ++i ) {
+    char const c = rope_iter_at( &it, i );
+    if ( lsp_is_utf8 || !utf8_is_cont( c ) )
+      character += lsp_char_units( c );
+  } // for
+
+  json_buf_printf(
+    buf, "{\"line\":%zu,\"character\":%zu}", line, character
+  );
+}
+
+/**
+ * Gets the offset of the beginning of the line containing an offset.
+ *
+ * @param doc The \ref lsp_doc to use.
+ * @param off The offset.
+ * @return Returns said offset.
+ */
+NODISCARD
+static size_t lsp_doc_line_begin( lsp_doc_t const *doc, size_t off ) {
+  assert( doc != NULL );
+  return rope_line_offset( &doc->text, rope_line( &doc->text, off ) );
+}
+
+/**
+ * Gets the offset of the end of the line containing an offset, including
+ * its end-of-line, if any.
+ *
+ * @param doc The \ref lsp_doc to use.
+ * @param off The offset.
+ * @return Returns said offset.
+ */
+NODISCARD
+static size_t lsp_doc_line_end( lsp_doc_t const *doc, size_t off ) {
+  assert( doc != NULL );
+  return rope_line_offset( &doc->text, rope_line( &doc->text, off ) + 1 );
+}
+
+/**
+ * Checks whether a line of a document is blank.
+ *
+ * @param doc The \ref lsp_doc to use.
+ * @param begin The offset of the beginning of the line.
+ * @return Returns `true` only if the line contains only whitespace.
+ */
+NODISCARD
+static bool lsp_doc_line_is_blank( lsp_doc_t const *doc, size_t begin ) {
+  assert( doc != NULL );
+  rope_iter_t it = { .rope = &doc->text };
+  for ( size_t i = begin, end = rope_len( &doc->text ); i < end; ++i ) {
+    switch ( rope_iter_at( &it, i ) ) {
+      case ' ' :
+      case '\t':
+      case '\r':
+        continue;
+      case '\n':
+        return true;
+    } // switch
+    return false;
+  } // for
+  return true;
+}
+
+/**
+ * Checks whether a line of a document starts a paragraph that can be
+ * reformatted separately from the text before it, that is it follows a blank
+ * line and starts with a non-whitespace character.
+ *
+ * @param doc The \ref lsp_doc to use.
+ * @param begin The offset of the beginning of the line.
+ * @return Returns `true` only if the line starts such a paragraph.
+ */
+NODISCARD
+static bool lsp_doc_line_is_para( lsp_doc_t const *doc, size_t begin ) {
+  assert( doc != NULL );
+  rope_iter_t it = { .rope = &doc->text };
+  return begin > 0 && begin < rope_len( &doc->text ) &&
+    !is_space( rope_iter_at( &it, begin ) ) &&
+    lsp_doc_line_is_blank( doc, lsp_doc_line_begin( doc, begin - 1 ) );
+}
+
+/**
+ * Appends the characters available from a file descriptor to \a buf.
+ *
+ * @param fd The file descriptor to read from.
+ * @param buf The \ref json_buf to append to.
+ * @return Returns the number of characters read or 0 upon either end-of-file
+ * or error.
+ */
+NODISCARD
+static size_t lsp_fd_read( int fd, json_buf_t *buf ) {
+  assert( buf != NULL );
+  json_buf_reserve( buf, 4096 );
+  ssize_t n;
+  while ( (n = read( fd, buf->str + buf->len, buf->cap - buf->len )) == -1 &&
+          errno == EINTR ) {
+    // empty
+  } // while
+  if ( n <= 0 )
+    return 0;
+  buf->len += STATIC_CAST( size_t, n );
+  return STATIC_CAST( size_t, n );
+}
+
+/**
+ * Reads more of the input until at least \a n characters are available after
+ * \ref lsp_in_pos.
+ *
+ * @param n The number of characters required.
+ * @return Returns `true` only if they are; `false` upon end-of-file.
+ */
+NODISCARD
+static bool lsp_read( size_t n ) {
+  while ( lsp_in.len - lsp_in_pos < n ) {
+    if ( lsp_in_pos > 0 ) {
+      lsp_in.len -= lsp_in_pos;
+      memmove( lsp_in.str, lsp_in.str + lsp_in_pos, lsp_in.len );
+      lsp_in_pos = 0;
+    }
+    json_buf_reserve( &lsp_in, n );
+    if ( lsp_fd_read( lsp_in_fd, &lsp_in ) == 0 )
+      return false;
+  } // while
+  return true;
+}
+
+/**
+ * Reads the next message: either the content following its header or, if
+ * \ref lsp_json_lines, the next non-blank line.
+ *
+ * @param plen A pointer to receive the length of the message.
+ * @return Returns said message (valid only until the next call) or NULL upon
+ * end-of-file.
+ */
+NODISCARD
+static char const* lsp_read_message( size_t *plen ) {
+  assert( plen != NULL );
+
+  size_t content_len = SIZE_MAX;
+  for (;;) {
+    char const *nl = NULL;
+    while ( lsp_in_pos == lsp_in.len ||
+            (nl = memchr( lsp_in.str + lsp_in_pos, '\n',
+                          lsp_in.len - lsp_in_pos )) == NULL ) {
+      if ( !lsp_read( lsp_in.len - lsp_in_pos + 1 ) ) {
+        if ( lsp_in.len > lsp_in_pos )
+          fatal_error( EX_DATAERR, "unexpected end of input\n" );
+        return NULL;
+      }
+    } // while
+    char const *const line = lsp_in.str + lsp_in_pos;
+    size_t line_len = STATIC_CAST( size_t, nl - line );
+    if ( line_len > 0 && line[ line_len - 1 ] == '\r' )
+      --line_len;
+    lsp_in_pos += STATIC_CAST( size_t, nl - line ) + 1;
+    if ( lsp_json_lines ) {
+      if ( line_len == 0 )
+        continue;
+      *plen = line_len;
+      return line;
+    }
+    if ( line_len == 0 )
+      break;
+    if ( line_len > sizeof LSP_CONTENT_LENGTH - 1 &&
+         strncasecmp( line, LSP_CONTENT_LENGTH,
+                      sizeof LSP_CONTENT_LENGTH - 1 ) == 0 ) {
+      content_len = 0;
+      for ( size_t i = sizeof LSP_CONTENT_LENGTH - 1; i < line_len; ++i ) {
+        if ( line[i] >= '0' && line[i] <= '9' )
+          content_len =
+            content_len * 10 + STATIC_CAST( size_t, line[i] - '0' );
+        else if ( line[i] != ' ' )
+          fatal_error( EX_DATAERR, "invalid " LSP_CONTENT_LENGTH "\n" );
+      } // for
+    }
+  } // for
+
+  if ( content_len == SIZE_MAX )
+    fatal_error( EX_DATAERR, LSP_CONTENT_LENGTH " expected\n" );
+  if ( !lsp_read( content_len ) )
+    fatal_error( EX_DATAERR, "unexpected end of input\n" );
+  char const *const msg = lsp_in.str + lsp_in_pos;
+  lsp_in_pos += content_len;
+  *plen = content_len;
+  return msg;
+}
+
+/**
+ * Sends a message either preceded by its header or, if \ref lsp_json_lines,
+ * followed by a newline.
+ *
+ * @param buf The \ref json_buf containing the message.
+ */
+static void lsp_send( json_buf_t const *buf ) {
+  assert( buf != NULL );
+  if ( lsp_json_lines ) {
+    if ( fd_write( lsp_out_fd, buf->str, buf->len ) != 0 ||
+         fd_write( lsp_out_fd, "\n", 1 ) != 0 ) {
+      perror_exit( EX_IOERR );
+    }
+    return;
+  }
+  char header[ 64 ];
+  int const header_len = snprintf(
+    header, sizeof header, LSP_CONTENT_LENGTH " %zu\r\n\r\n", buf->len
+  );
+  size_t const len = STATIC_CAST( size_t, header_len );
+  if ( fd_write( lsp_out_fd, header, len ) != 0 ||
+       fd_write( lsp_out_fd, buf->str, buf->len ) != 0 ) {
+    perror_exit( EX_IOERR );
+  }
+}
+
+/**
+ * Begins a response: puts everything up to its `result` or `error` value.
+ *
+ * @param buf The \ref json_buf to put the response into.
+ * @param id The request ID or NULL if unknown.
+ * @param member Either `result` or `error`.
+ */
+static void lsp_response_begin( json_buf_t *buf, json_value_t const *id,
+                                char const *member ) {
+  assert( buf != NULL );
+  assert( member != NULL );
+  json_buf_printf( buf, "{\"jsonrpc\":\"2.0\",\"id\":" );
+  if ( id != NULL && id->type == JSON_STRING )
+    json_buf_put_str( buf, id->s, id->len );
+  else if ( id != NULL && id->type == JSON_NUMBER )
+    json_buf_printf( buf, "%.17g", id->n );
+  else
+    json_buf_printf( buf, "null" );
+  json_buf_printf( buf, ",\"%s\":", member );
+}
+
+/**
+ * Sends an error response.
+ *
+ * @param id The request ID or NULL if unknown.
+ * @param code The \ref lsp_error code.
+ * @param format The `printf()` style format string of the message.
+ * @param ... The `printf()` arguments.
+ */
+PJL_PRINTF_LIKE_FUNC(3)
+static void lsp_send_error( json_value_t const *id, lsp_error_t code,
+                            char const *format, ... ) {
+  assert( format != NULL );
+
+  va_list args;
+  va_start( args, format );
+  int const raw_len = vsnprintf( NULL, 0, format, args );
+  va_end( args );
+  PERROR_EXIT_IF( raw_len < 0, EX_SOFTWARE );
+  size_t const len = STATIC_CAST( size_t, raw_len );
+  char *const message = arena_alloc( len + 1 );
+  va_start( args, format );
+  PJL_DISCARD_RV( vsnprintf( message, len + 1, format, args ) );
+  va_end( args );
+
+  json_buf_t buf = { 0 };
+  lsp_response_begin( &buf, id, "error" );
+  json_buf_printf( &buf, "{\"code\":%d,\"message\":", code );
+  json_buf_put_str( &buf, message, len );
+  json_buf_put( &buf, "}}", 2 );
+  lsp_send( &buf );
+  json_buf_cleanup( &buf );
+}
+
+/**
+ * Sends a response having a result.
+ *
+ * @param id The request ID.
+ * @param result The JSON of the result.
+ * @param result_len The length of \a result.
+ */
+static void lsp_send_result( json_value_t const *id, char const *result,
+                             size_t result_len ) {
+  json_buf_t buf = { 0 };
+  lsp_response_begin( &buf, id, "result" );
+  json_buf_put( &buf, result, result_len );
+  json_buf_put( &buf, "}", 1 );
+  lsp_send( &buf );
+  json_buf_cleanup( &buf );
+}
+
+/**
+ * Gets the path of a `file:` URI.
+ *
+ * @param uri The URI.
+ * @return Returns said path (allocated via arena_alloc()) or NULL if \a uri
+ * isn't a `file:` URI.
+ */
+NODISCARD
+static char* lsp_uri_path( char const *uri ) {
+  assert( uri != NULL );
+  static char const FILE_SCHEME[] = "file://";
+  if ( strncmp( uri, FILE_SCHEME, sizeof FILE_SCHEME - 1 ) != 0 )
+    return NULL;
+  uri += sizeof FILE_SCHEME - 1;
+  if ( *uri != '/' )                    // not the local host
+    return NULL;
+
+  char *const path = arena_alloc( strlen( uri ) + 1 );
+  char *d = path;
+  for ( ; *uri != '\0'; ++uri ) {
+    unsigned hex;
+    if ( uri[0] == '%' && sscanf( uri + 1, "%2x", &hex ) == 1 &&
+         hex != 0 && uri[1] != '\0' && uri[2] != '\0' ) {
+      *d++ = STATIC_CAST( char, hex );
+      uri += 2;
+    }
+    else {
+      *d++ = *uri;
+    }
+  } // for
+  *d = '\0';
+  return path;
+}
+
+/**
+ * Reformats text by forking a child that runs as either **wrap**(1) or
+ * **wrapc**(1) with standard input, output, and error connected to the server
+ * via pipes.
+ *
+ * @param argc The argument count for the child.
+ * @param argv The argument values for the child.  If `argv[0]` is `wrapc`,
+ * runs as **wrapc**(1).
+ * @param dir The directory to run in or NULL for the current one.
+ * @param rope The \ref rope containing the text.  It's written to the child
+ * a chunk at a time.
+ * @param begin The offset of the first character of the text.
+ * @param end The offset of one past the last character of the text.
+ * @param out The \ref json_buf to receive the reformatted text.
+ * @param err The \ref json_buf to receive error messages.
+ * @return Returns `true` only upon success.
+ */
+NODISCARD
+static bool lsp_run( int argc, char const *argv[], char const *dir,
+                     rope_t const *rope, size_t begin, size_t end,
+                     json_buf_t *out, json_buf_t *err ) {
+  assert( argv != NULL );
+  assert( rope != NULL );
+  assert( begin <= end );
+  assert( out != NULL );
+  assert( err != NULL );
+
+  int in[2], from_out[2], from_err[2];
+  PIPE( in );
+  PIPE( from_out );
+  PIPE( from_err );
+
+  pid_t const pid = fork();
+  PERROR_EXIT_IF( pid == -1, EX_OSERR );
+  if ( pid == 0 ) {
+    PJL_DISCARD_RV( signal( SIGPIPE, SIG_DFL ) );
+    DUP2( in[0], STDIN_FILENO );
+    DUP2( from_out[1], STDOUT_FILENO );
+    DUP2( from_err[1], STDERR_FILENO );
+    int const fds[] = {
+      in[0], in[1], from_out[0], from_out[1], from_err[0], from_err[1],
+      lsp_in_fd, lsp_out_fd
+    };
+    for ( size_t i = 0; i < ARRAY_SIZE( fds ); ++i ) {
+      if ( fds[i] > STDERR_FILENO )
+        close( fds[i] );
+    } // for
+    if ( dir != NULL )
+      PJL_DISCARD_RV( chdir( dir ) );
+    if ( strcmp( argv[0], PACKAGE "c" ) == 0 )
+      wrapc_run( argc, argv );
+    options_init( argc, argv, lsp_usage );
+    wrap_init();
+    wrap_run();
+  }
+
+  close( in[0] );
+  close( from_out[1] );
+  close( from_err[1] );
+  PERROR_EXIT_IF( fcntl( in[1], F_SETFL, O_NONBLOCK ) == -1, EX_OSERR );
+
+  //
+  // Write the text and read the reformatted text at the same time lest either
+  // pipe fill up and the child and server wait on each other forever.
+  //
+  struct pollfd pfds[] = {
+    { .fd = in[1],       .events = POLLOUT },
+    { .fd = from_out[0], .events = POLLIN  },
+    { .fd = from_err[0], .events = POLLIN  }
+  };
+  json_buf_t *const bufs[] = { NULL, out, err };
+  size_t const len = end - begin;
+  size_t written = 0;
+  if ( len == 0 ) {
+    close( in[1] );
+    pfds[0].fd = -1;
+  }
+  while ( pfds[0].fd != -1 || pfds[1].fd != -1 || pfds[2].fd != -1 ) {
+    if ( poll( pfds, ARRAY_SIZE( pfds ), /*timeout=*/-1 ) == -1 ) {
+      if ( errno == EINTR )
+        continue;
+      perror_exit( EX_OSERR );
+    }
+    if ( pfds[0].revents != 0 ) {
+      size_t const off = begin + written;
+      size_t chunk_begin, chunk_len;
+      char const *const chunk =
+        rope_chunk( rope, off, &chunk_begin, &chunk_len );
+      size_t const chunk_end = chunk_begin + chunk_len;
+      ssize_t const n = write(
+        in[1], chunk + (off - chunk_begin),
+        (chunk_end < end ? chunk_end : end) - off
+      );
+      if ( n > 0 )
+        written += STATIC_CAST( size_t, n );
+      if ( written == len || (n == -1 && errno != EAGAIN && errno != EINTR) ) {
+        close( in[1] );                 // done or child stopped reading
+        pfds[0].fd = -1;
+      }
+    }
+    for ( size_t i = 1; i < ARRAY_SIZE( pfds ); ++i ) {
+      if ( pfds[i].revents != 0 && lsp_fd_read( pfds[i].fd, bufs[i] ) == 0 ) {
+        close( pfds[i].fd );
+        pfds[i].fd = -1;
+      }
+    } // for
+  } // while
+
+  int status;
+  while ( waitpid( pid, &status, 0 ) == -1 ) {
+    if ( errno != EINTR )
+      perror_exit( EX_OSERR );
+  } // while
+  return WIFEXITED( status ) && WEXITSTATUS( status ) == EX_OK;
+}
+
+/**
+ * Reformats text of a document via lsp_run() as either **wrap**(1) or
+ * **wrapc**(1) depending on its language.
+ *
+ * @param doc The \ref lsp_doc to reformat part of.
+ * @param begin The offset of the first character to reformat.
+ * @param end The offset of one past the last character to reformat.
+ * @param options The LSP `FormattingOptions`, if any.
+ * @param out The \ref json_buf to receive the reformatted text.
+ * @param err The \ref json_buf to receive error messages.
+ * @return Returns `true` only upon success.
+ */
+NODISCARD
+static bool lsp_wrap( lsp_doc_t const *doc, size_t begin, size_t end,
+                      json_value_t const *options, json_buf_t *out,
+                      json_buf_t *err ) {
+  assert( doc != NULL );
+  assert( out != NULL );
+  assert( err != NULL );
+
+  bool const is_text = lsp_doc_is_text( doc );
+  char const **const argv = ARENA_ALLOC( char const*, 5 + lsp_args_len + 1 );
+  int argc = 0;
+  argv[ argc++ ] = is_text ? PACKAGE : PACKAGE "c";
+
+  char *const path = lsp_uri_path( doc->uri );
+  char *dir = NULL;
+  if ( path != NULL ) {
+    char *const slash = strrchr( path, '/' );
+    if ( slash[1] != '\0' ) {
+      char *const arg = arena_alloc( sizeof "--file-name=" + strlen( slash ) );
+      strcpy( arg, "--file-name=" );
+      strcat( arg, slash + 1 );
+      argv[ argc++ ] = arg;
+    }
+    //
+    // Run in the document's directory so the nearest .wraprc to it is found.
+    //
+    dir = path;
+    if ( slash == path )
+      slash[1] = '\0';                 // root directory
+    else
+      slash[0] = '\0';
+  }
+
+  bool const is_markdown = strcmp( doc->lang_id, "markdown" ) == 0;
+  size_t tab_size;
+  if ( !is_markdown && json_get_size( options, "tabSize", &tab_size ) &&
+       tab_size > 0 ) {
+    char *const arg = arena_alloc( sizeof "--tab-spaces=" + 20 );
+    sprintf( arg, "--tab-spaces=%zu", tab_size );
+    argv[ argc++ ] = arg;
+  }
+  if ( is_markdown )
+    argv[ argc++ ] = "--markdown";
+  if ( !is_text )
+    argv[ argc++ ] = "--all-comments";
+  for ( size_t i = 0; i < lsp_args_len; ++i )
+    argv[ argc++ ] = lsp_args[i];
+  argv[ argc ] = NULL;
+
+  return lsp_run( argc, argv, dir, &doc->text, begin, end, out, err );
+}
+
+/**
+ * Sends the result of reformatting part of a document: either an empty array
+ * if it's unchanged or an array of one `TextEdit` that replaces only the lines
+ * that changed.
+ *
+ * @param id The request ID.
+ * @param doc The \ref lsp_doc that was reformatted.
+ * @param begin The offset of the first character reformatted.
+ * @param end The offset of one past the last character reformatted.
+ * @param b The reformatted text.
+ * @param b_len The length of \a b.
+ * @param pedit If not NULL, a pointer to the \ref lsp_edit to receive the edit
+ * sent, if any.
+ */
+static void lsp_send_edit( json_value_t const *id, lsp_doc_t const *doc,
+                           size_t begin, size_t end, char const *b,
+                           size_t b_len, lsp_edit_t *pedit ) {
+  assert( doc != NULL );
+  assert( begin <= end );
+  assert( b != NULL || b_len == 0 );
+
+  rope_iter_t it = { .rope = &doc->text };
+  size_t const a_len = end - begin;
+
+  //
+  // Trim the lines that didn't change from both the beginning and end so the
+  // edit is no bigger than it has to be.
+  //
+  size_t prefix = 0;
+  size_t i = 0;
+  for ( ; i < a_len && i < b_len && rope_iter_at( &it, begin + i ) == b[i];
+        ++i ) {
+    if ( b[i] == '\n' )
+      prefix = i + 1;
+  } // for
+  if ( i == a_len && i == b_len ) {
+    lsp_send_result( id, "[]", 2 );
+    return;
+  }
+  size_t suffix = 0;
+  for ( size_t j = 1; j <= a_len - prefix && j <= b_len - prefix &&
+                      rope_iter_at( &it, end - j ) == b[ b_len - j ]; ++j ) {
+    if ( a_len - j > prefix && b_len - j > prefix &&
+         rope_iter_at( &it, end - j - 1 ) == '\n' &&
+         b[ b_len - j - 1 ] == '\n' ) {
+      suffix = j;
+    }
+  } // for
+
+  json_buf_t result = { 0 };
+  json_buf_printf( &result, "[{\"range\":{\"start\":" );
+  lsp_doc_put_position( doc, begin + prefix, &result );
+  json_buf_printf( &result, ",\"end\":" );
+  lsp_doc_put_position( doc, end - suffix, &result );
+  json_buf_printf( &result, "},\"newText\":" );
+  json_buf_put_str( &result, b + prefix, b_len - prefix - suffix );
+  json_buf_put( &result, "}]", 2 );
+  lsp_send_result( id, result.str, result.len );
+  json_buf_cleanup( &result );
+
+  if ( pedit != NULL ) {
+    size_t const text_len = b_len - prefix - suffix;
+    *pedit = (lsp_edit_t){
+      .is_sent = true,
+      .begin = begin + prefix,
+      .text = MALLOC( char, text_len + 1 ),
+      .text_len = text_len,
+      .doc_len = rope_len( &doc->text ) - (end - begin) + b_len
+    };
+    memcpy( pedit->text, b + prefix, text_len );
+  }
+}
+
+/**
+ * Gets the message of why reformatting failed: the first line of what the
+ * child printed to standard error, if any.
+ *
+ * @param err The \ref json_buf containing what was printed.
+ * @param plen A pointer to receive the length of the message.
+ * @return Returns said message (that's not null-terminated).
+ */
+NODISCARD
+static char const* lsp_error_line( json_buf_t const *err, size_t *plen ) {
+  assert( err != NULL );
+  assert( plen != NULL );
+  char const *const nl =
+    err->len > 0 ? memchr( err->str, '\n', err->len ) : NULL;
+  *plen = nl != NULL ? STATIC_CAST( size_t, nl - err->str ) : err->len;
+  if ( *plen > 0 )
+    return err->str;
+  static char const FAILED[] = "reformatting failed";
+  *plen = sizeof FAILED - 1;
+  return FAILED;
+}
+
+/**
+ * Reformats part of a document and sends the result.
+ *
+ * @param id The request ID.
+ * @param doc The \ref lsp_doc to reformat part of.
+ * @param begin The offset of the first character to reformat.
+ * @param end The offset of one past the last character to reformat.
+ * @param options The LSP `FormattingOptions`, if any.
+ * @param pedit If not NULL, a pointer to the \ref lsp_edit to receive the edit
+ * sent, if any.
+ * @return Returns `true` only if reformatting succeeded.
+ */
+static bool lsp_format( json_value_t const *id, lsp_doc_t const *doc,
+                        size_t begin, size_t end,
+                        json_value_t const *options, lsp_edit_t *pedit ) {
+  assert( doc != NULL );
+  assert( begin <= end );
+  assert( end <= rope_len( &doc->text ) );
+
+  rope_iter_t it = { .rope = &doc->text };
+  json_buf_t out = { 0 }, err = { 0 };
+
+  bool const ok = lsp_wrap( doc, begin, end, options, &out, &err );
+  if ( ok ) {
+    size_t b_len = out.len;
+    if ( (end == begin || rope_iter_at( &it, end - 1 ) != '\n') && b_len > 0 &&
+         out.str[ b_len - 1 ] == '\n' ) {
+      //
+      // The text didn't end with an end-of-line, so the reformatted text
+      // mustn't either.
+      //
+      --b_len;
+      if ( b_len > 0 && out.str[ b_len - 1 ] == '\r' )
+        --b_len;
+    }
+    lsp_send_edit( id, doc, begin, end, out.str, b_len, pedit );
+  }
+  else {
+    size_t err_len;
+    char const *const err_s = lsp_error_line( &err, &err_len );
+    lsp_send_error( id, LSP_ERR_REQUEST_FAILED, "%.*s",
+                    STATIC_CAST( int, err_len ), err_s );
+  }
+
+  json_buf_cleanup( &out );
+  json_buf_cleanup( &err );
+  return ok;
+}
+
+/**
+ * Gets the open document a request is for, sending an error response if
+ * there's none.
+ *
+ * @param id The request ID.
+ * @param params The request parameters.
+ * @return Returns said document or NULL if none.
+ */
+NODISCARD
+static lsp_doc_t* lsp_request_doc( json_value_t const *id,
+                                   json_value_t const *params ) {
+  json_value_t const *const uri =
+    json_get_str( json_get( params, "textDocument" ), "uri" );
+  lsp_doc_t *const doc = lsp_doc_find( uri );
+  if ( doc == NULL ) {
+    if ( uri == NULL )
+      lsp_send_error( id, LSP_ERR_INVALID_PARAMS, "document URI expected" );
+    else
+      lsp_send_error( id, LSP_ERR_INVALID_PARAMS, "%s: document not open",
+                      uri->s );
+  }
+  return doc;
+}
+
+////////// LSP methods ////////////////////////////////////////////////////////
+
+/**
+ * Handles the `exit` notification.
+ *
+ * @param id Not used.
+ * @param params Not used.
+ */
+static void lsp_exit( json_value_t const *id, json_value_t const *params ) {
+  (void)id;
+  (void)params;
+  exit( lsp_is_shutdown ? EX_OK : 1 );
+}
+
+/**
+ * Handles the `initialize` request.
+ *
+ * @param id The request ID.
+ * @param params The request parameters.
+ */
+static void lsp_initialize( json_value_t const *id,
+                            json_value_t const *params ) {
+  json_value_t const *const encodings = json_get(
+    json_get( json_get( params, "capabilities" ), "general" ),
+    "positionEncodings"
+  );
+  if ( encodings != NULL && encodings->type == JSON_ARRAY ) {
+    for ( json_value_t const *e = encodings->first; e != NULL; e = e->next ) {
+      if ( e->type == JSON_STRING && strcmp( e->s, "utf-8" ) == 0 )
+        lsp_is_utf8 = true;
+    } // for
+  }
+
+  json_value_t const *const args =
+    json_get( json_get( params, "initializationOptions" ), "args" );
+  if ( args != NULL ) {
+    if ( args->type != JSON_ARRAY ) {
+      lsp_send_error( id, LSP_ERR_INVALID_PARAMS, "args: array expected" );
+      return;
+    }
+    for ( json_value_t const *arg = args->first; arg != NULL;
+          arg = arg->next ) {
+      if ( arg->type != JSON_STRING ) {
+        lsp_send_error( id, LSP_ERR_INVALID_PARAMS, "args: string expected" );
+        return;
+      }
+    } // for
+    for ( json_value_t const *arg = args->first; arg != NULL; arg = arg->next )
+      lsp_add_arg( arg->s );
+  }
+
+  json_buf_t result = { 0 };
+  json_buf_printf( &result,
+    "{"
+      "\"capabilities\":{"
+        "\"positionEncoding\":\"%s\","
+        "\"textDocumentSync\":{\"openClose\":true,\"change\":2},"
+        "\"documentFormattingProvider\":true,"
+        "\"documentRangeFormattingProvider\":true,"
+        "\"documentOnTypeFormattingProvider\":{"
+          "\"firstTriggerCharacter\":\" \""
+        "}"
+      "},"
+      "\"serverInfo\":{\"name\":\"%s\"}"
+    "}",
+    lsp_is_utf8 ? "utf-8" : "utf-16", me
+  );
+  lsp_send_result( id, result.str, result.len );
+  json_buf_cleanup( &result );
+  lsp_is_initialized = true;
+}
+
+/**
+ * Handles the `shutdown` request.
+ *
+ * @param id The request ID.
+ * @param params Not used.
+ */
+static void lsp_shutdown( json_value_t const *id,
+                          json_value_t const *params ) {
+  (void)params;
+  lsp_is_shutdown = true;
+  lsp_send_result( id, "null", 4 );
+}
+
+/**
+ * Handles the `textDocument/didChange` notification: applies each change to
+ * the document.  If the document then contains the edit last sent for it by
+ * lsp_formatting(), the client applied it, so the document is now known to be
+ * reformatted.
+ *
+ * @param id Not used.
+ * @param params The notification parameters.
+ */
+static void lsp_did_change( json_value_t const *id,
+                            json_value_t const *params ) {
+  (void)id;
+  lsp_doc_t *const doc = lsp_doc_find(
+    json_get_str( json_get( params, "textDocument" ), "uri" )
+  );
+  json_value_t const *const changes = json_get( params, "contentChanges" );
+  if ( doc == NULL || changes == NULL || changes->type != JSON_ARRAY )
+    return;
+  lsp_edit_t const edit = doc->edit;
+  doc->edit = (lsp_edit_t){ 0 };
+
+  for ( json_value_t const *change = changes->first; change != NULL;
+        change = change->next ) {
+    json_value_t const *const text = json_get_str( change, "text" );
+    if ( text == NULL )
+      continue;
+    json_value_t const *const range = json_get( change, "range" );
+    size_t begin = 0, end = rope_len( &doc->text );
+    if ( range != NULL &&
+         (!lsp_doc_offset( doc, json_get( range, "start" ), &begin ) ||
+          !lsp_doc_offset( doc, json_get( range, "end" ), &end ) ||
+          begin > end) ) {
+      continue;
+    }
+    lsp_doc_replace( doc, begin, end, text->s, text->len );
+  } // for
+
+  if ( lsp_doc_has_edit( doc, &edit ) )
+    doc->is_dirty = false;
+  FREE( edit.text );
+}
+
+/**
+ * Handles the `textDocument/didClose` notification.
+ *
+ * @param id Not used.
+ * @param params The notification parameters.
+ */
+static void lsp_did_close( json_value_t const *id,
+                           json_value_t const *params ) {
+  (void)id;
+  lsp_doc_t *const doc = lsp_doc_find(
+    json_get_str( json_get( params, "textDocument" ), "uri" )
+  );
+  if ( doc == NULL )
+    return;
+  FREE( doc->uri );
+  FREE( doc->lang_id );
+  FREE( doc->edit.text );
+  rope_cleanup( &doc->text );
+  *doc = lsp_docs[ --lsp_docs_len ];
+}
+
+/**
+ * Handles the `textDocument/didOpen` notification.
+ *
+ * @param id Not used.
+ * @param params The notification parameters.
+ */
+static void lsp_did_open( json_value_t const *id,
+                          json_value_t const *params ) {
+  (void)id;
+  json_value_t const *const td = json_get( params, "textDocument" );
+  json_value_t const *const uri = json_get_str( td, "uri" );
+  json_value_t const *const text = json_get_str( td, "text" );
+  if ( uri == NULL || text == NULL )
+    return;
+  json_value_t const *const lang_id = json_get_str( td, "languageId" );
+
+  lsp_doc_t *doc = lsp_doc_find( uri );
+  if ( doc == NULL ) {
+    REALLOC( lsp_docs, lsp_doc_t, lsp_docs_len + 1 );
+    doc = &lsp_docs[ lsp_docs_len++ ];
+    *doc = (lsp_doc_t){ .uri = check_strdup( uri->s ) };
+  }
+  else {
+    FREE( doc->lang_id );
+    FREE( doc->edit.text );
+    doc->edit = (lsp_edit_t){ 0 };
+    rope_cleanup( &doc->text );
+  }
+  doc->lang_id = check_strdup( lang_id != NULL ? lang_id->s : "" );
+  rope_replace( &doc->text, 0, 0, text->s, text->len );
+  doc->is_dirty = true;
+  doc->dirty_begin = 0;
+  doc->dirty_end = text->len;
+}
+
+/**
+ * Handles the `textDocument/formatting` request: reformats the document.
+ *
+ * Once a text document has been reformatted (and the client has applied the
+ * edit, if any), everything but what has since changed is known to already be
+ * reformatted, so only the paragraphs containing the changes are reformatted
+ * again (or nothing if nothing has changed) making the cost proportional to
+ * the size of the changes rather than of the document.  Paragraphs are delimited the same way as for
+ * reformatting in parallel: a blank line followed by a line not starting
+ * with whitespace.  Other documents, e.g., Markdown where a paragraph may be
+ * within a fenced code block, are always reformatted in their entirety.
+ *
+ * @param id The request ID.
+ * @param params The request parameters.
+ */
+static void lsp_formatting( json_value_t const *id,
+                            json_value_t const *params ) {
+  lsp_doc_t *const doc = lsp_request_doc( id, params );
+  if ( doc == NULL )
+    return;
+  json_value_t const *const options = json_get( params, "options" );
+  size_t tab_size = 0;
+  PJL_DISCARD_RV( json_get_size( options, "tabSize", &tab_size ) );
+  if ( tab_size != doc->tab_size ) {
+    doc->is_dirty = true;
+    doc->dirty_begin = 0;
+    doc->dirty_end = rope_len( &doc->text );
+  }
+  if ( !doc->is_dirty ) {
+    lsp_send_result( id, "[]", 2 );
+    return;
+  }
+
+  size_t const len = rope_len( &doc->text );
+  size_t begin = 0, end = len;
+  if ( lsp_doc_is_text( doc ) && strcmp( doc->lang_id, "markdown" ) != 0 ) {
+    begin = lsp_doc_line_begin( doc, doc->dirty_begin );
+    while ( begin > 0 && !lsp_doc_line_is_para( doc, begin ) )
+      begin = lsp_doc_line_begin( doc, begin - 1 );
+    end = lsp_doc_line_end( doc, doc->dirty_end );
+    while ( end < len && !lsp_doc_line_is_para( doc, end ) )
+      end = lsp_doc_line_end( doc, end );
+  }
+
+  FREE( doc->edit.text );
+  doc->edit = (lsp_edit_t){ 0 };
+  if ( lsp_format( id, doc, begin, end, options, &doc->edit ) ) {
+    //
+    // If an edit was sent, the client might not apply it (e.g., if it timed
+    // out), so the document isn't known to be reformatted until it does: see
+    // lsp_did_change().
+    //
+    if ( !doc->edit.is_sent )
+      doc->is_dirty = false;
+    doc->tab_size = tab_size;
+  }
+}
+
+/**
+ * Handles the `textDocument/onTypeFormatting` request: when a space is typed,
+ * reformats the paragraph containing the cursor up to the cursor the way
+ * auto-fill does.  The space, anything after the cursor, and all following
+ * lines are left alone.
+ *
+ * @param id The request ID.
+ * @param params The request parameters.
+ */
+static void lsp_on_type_formatting( json_value_t const *id,
+                                    json_value_t const *params ) {
+  lsp_doc_t const *const doc = lsp_request_doc( id, params );
+  if ( doc == NULL )
+    return;
+  size_t cursor;
+  if ( !lsp_doc_offset( doc, json_get( params, "position" ), &cursor ) ) {
+    lsp_send_error( id, LSP_ERR_INVALID_PARAMS, "position expected" );
+    return;
+  }
+
+  size_t const line_begin = lsp_doc_line_begin( doc, cursor );
+  rope_iter_t it = { .rope = &doc->text };
+  size_t end = cursor;
+  while ( end > line_begin &&
+          (rope_iter_at( &it, end - 1 ) == ' ' ||
+           rope_iter_at( &it, end - 1 ) == '\t') ) {
+    --end;
+  } // while
+  if ( end == line_begin ) {
+    lsp_send_result( id, "[]", 2 );
+    return;
+  }
+
+  size_t begin = line_begin;
+  while ( begin > 0 ) {
+    size_t const prev_begin = lsp_doc_line_begin( doc, begin - 1 );
+    if ( lsp_doc_line_is_blank( doc, prev_begin ) )
+      break;
+    begin = prev_begin;
+  } // while
+
+  PJL_DISCARD_RV(
+    lsp_format( id, doc, begin, end, json_get( params, "options" ),
+                /*pedit=*/NULL )
+  );
+}
+
+/**
+ * Handles the `textDocument/rangeFormatting` request: reformats the lines
+ * the range spans.
+ *
+ * @param id The request ID.
+ * @param params The request parameters.
+ */
+static void lsp_range_formatting( json_value_t const *id,
+                                  json_value_t const *params ) {
+  lsp_doc_t const *const doc = lsp_request_doc( id, params );
+  if ( doc == NULL )
+    return;
+  json_value_t const *const range = json_get( params, "range" );
+  json_value_t const *const range_end = json_get( range, "end" );
+  size_t begin, end;
+  if ( !lsp_doc_offset( doc, json_get( range, "start" ), &begin ) ||
+       !lsp_doc_offset( doc, range_end, &end ) || begin > end ) {
+    lsp_send_error( id, LSP_ERR_INVALID_PARAMS, "range expected" );
+    return;
+  }
+
+  begin = lsp_doc_line_begin( doc, begin );
+  size_t character;
+  //
+  // A range ending at the beginning of a line, e.g., when whole lines are
+  // selected, doesn't include that line.
+  //
+  if ( !(end > begin && json_get_size( range_end, "character", &character ) &&
+         character == 0) ) {
+    end = lsp_doc_line_end( doc, end );
+  }
+
+  PJL_DISCARD_RV(
+    lsp_format( id, doc, begin, end, json_get( params, "options" ),
+                /*pedit=*/NULL )
+  );
+}
+
+/**
+ * LSP methods, sorted by name.
+ */
+static lsp_method_t const LSP_METHODS[] = {
+  { "exit",                             &lsp_exit               },
+  { "initialize",                       &lsp_initialize         },
+  { "shutdown",                         &lsp_shutdown           },
+  { "textDocument/didChange",           &lsp_did_change         },
+  { "textDocument/didClose",            &lsp_did_close          },
+  { "textDocument/didOpen",             &lsp_did_open           },
+  { "textDocument/formatting",          &lsp_formatting         },
+  { "textDocument/onTypeFormatting",    &lsp_on_type_formatting },
+  { "textDocument/rangeFormatting",     &lsp_range_formatting   },
+};
+
+/**
+ * Handles a message.
+ *
+ * @param msg The message.
+ */
+static void lsp_handle( json_value_t const *msg ) {
+  assert( msg != NULL );
+
+  json_value_t const *const id = json_get( msg, "id" );
+  json_value_t const *const method = json_get_str( msg, "method" );
+  if ( method == NULL ) {
+    if ( id == NULL || json_get( msg, "result" ) == NULL )
+      lsp_send_error( id, LSP_ERR_INVALID_REQUEST, "method expected" );
+    return;                             // ignore responses
+  }
+
+  lsp_method_t const *m = NULL;
+  for ( size_t i = 0; i < ARRAY_SIZE( LSP_METHODS ); ++i ) {
+    if ( strcmp( LSP_METHODS[i].name, method->s ) == 0 ) {
+      m = &LSP_METHODS[i];
+      break;
+    }
+  } // for
+
+  if ( id == NULL ) {                   // notification
+    if ( m != NULL && (lsp_is_initialized || m->fn == &lsp_exit) )
+      (*m->fn)( NULL, json_get( msg, "params" ) );
+    return;
+  }
+  if ( m == NULL ) {
+    lsp_send_error( id, LSP_ERR_METHOD_NOT_FOUND, "%s: method not found",
+                    method->s );
+    return;
+  }
+  if ( !lsp_is_initialized && m->fn != &lsp_initialize ) {
+    lsp_send_error( id, LSP_ERR_NOT_INITIALIZED, "server not initialized" );
+    return;
+  }
+  if ( lsp_is_initialized && m->fn == &lsp_initialize ) {
+    lsp_send_error( id, LSP_ERR_INVALID_REQUEST, "server already initialized" );
+    return;
+  }
+  if ( lsp_is_shutdown ) {
+    lsp_send_error( id, LSP_ERR_INVALID_REQUEST, "server shut down" );
+    return;
+  }
+  (*m->fn)( id, json_get( msg, "params" ) );
+}
+
+/**
+ * Handles a request in the format of a Vim channel message: an array of a
+ * number and an object having the members:
+ *
+ * + `text`: The text to reformat.
+ * + `args`: An optional array of options (after those given to every child).
+ * + `dir`: An optional directory to run in.
+ * + `wrapc`: If `true`, runs as **wrapc**(1).
+ *
+ * Sends a response of an array of the same number and an object having either
+ * `text`, the reformatted text, or `error`, why reformatting failed.
+ *
+ * @param msg The message.
+ */
+static void lsp_job( json_value_t const *msg ) {
+  assert( msg != NULL );
+  assert( msg->type == JSON_ARRAY );
+
+  json_value_t const *const id = msg->first;
+  json_value_t const *const req = id != NULL ? id->next : NULL;
+  json_value_t const *const text = json_get_str( req, "text" );
+  json_value_t const *const args = json_get( req, "args" );
+  json_value_t const *const dir = json_get_str( req, "dir" );
+  json_value_t const *const wrapc = json_get( req, "wrapc" );
+
+  json_buf_t buf = { 0 };
+  json_buf_put( &buf, "[", 1 );
+  if ( id != NULL && id->type == JSON_NUMBER )
+    json_buf_printf( &buf, "%.17g", id->n );
+  else
+    json_buf_put( &buf, "0", 1 );
+
+  char const *error = NULL;
+  size_t args_len = 0;
+  if ( id == NULL || id->type != JSON_NUMBER || req == NULL ||
+       req->type != JSON_OBJECT || req->next != NULL ) {
+    error = "[number,object] expected";
+  }
+  else if ( text == NULL ) {
+    error = "\"text\": string expected";
+  }
+  else if ( args != NULL ) {
+    if ( args->type != JSON_ARRAY ) {
+      error = "\"args\": array expected";
+    }
+    else {
+      for ( json_value_t const *arg = args->first; arg != NULL;
+            arg = arg->next ) {
+        if ( arg->type != JSON_STRING ) {
+          error = "\"args\": array of strings expected";
+          break;
+        }
+        ++args_len;
+      } // for
+    }
+  }
+
+  json_buf_t out = { 0 }, err = { 0 };
+  if ( error == NULL ) {
+    char const **const argv =
+      ARENA_ALLOC( char const*, 1 + lsp_args_len + args_len + 1 );
+    int argc = 0;
+    bool const is_wrapc =
+      wrapc != NULL && wrapc->type == JSON_BOOL && wrapc->b;
+    argv[ argc++ ] = is_wrapc ? PACKAGE "c" : PACKAGE;
+    for ( size_t i = 0; i < lsp_args_len; ++i )
+      argv[ argc++ ] = lsp_args[i];
+    if ( args != NULL ) {
+      for ( json_value_t const *arg = args->first; arg != NULL;
+            arg = arg->next ) {
+        argv[ argc++ ] = arg->s;
+      } // for
+    }
+    argv[ argc ] = NULL;
+
+    rope_t rope = { 0 };
+    rope_replace( &rope, 0, 0, text->s, text->len );
+    bool const ok = lsp_run( argc, argv, dir != NULL ? dir->s : NULL, &rope,
+                             0, text->len, &out, &err );
+    rope_cleanup( &rope );
+    if ( ok ) {
+      json_buf_printf( &buf, ",{\"text\":" );
+      json_buf_put_str( &buf, out.str, out.len );
+    }
+    else {
+      size_t err_len;
+      char const *const err_s = lsp_error_line( &err, &err_len );
+      json_buf_printf( &buf, ",{\"error\":" );
+      json_buf_put_str( &buf, err_s, err_len );
+    }
+  }
+  else {
+    json_buf_printf( &buf, ",{\"error\":" );
+    json_buf_put_str( &buf, error, strlen( error ) );
+  }
+
+  json_buf_put( &buf, "}]", 2 );
+  lsp_send( &buf );
+  json_buf_cleanup( &buf );
+  json_buf_cleanup( &out );
+  json_buf_cleanup( &err );
+}
+
+/**
+ * Parses the command-line options.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ */
+static void lsp_parse_options( int argc, char const *argv[] ) {
+  static struct option const OPTS_LONG[] = {
+    { "config",     required_argument,  NULL, 'c' },
+    { "no-config",  no_argument,        NULL, 'C' },
+    { "file",       required_argument,  NULL, 'f' },
+    { "help",       no_argument,        NULL, 'h' },
+    { "json-lines", no_argument,        NULL, 'j' },
+    { "output",     required_argument,  NULL, 'o' },
+    { "version",    no_argument,        NULL, 'v' },
+    { NULL,         0,                  NULL, 0   }
+  };
+
+  char const *fin_path = NULL, *fout_path = NULL;
+  for (;;) {
+    int const opt = getopt_long(
+      argc, CONST_CAST( char**, argv ), "c:Cf:hjo:v", OPTS_LONG, NULL
+    );
+    if ( opt == -1 )
+      break;
+    switch ( opt ) {
+      case 'c': {
+        //
+        // Children run in their document's directory, so a relative path
+        // must be made absolute.
+        //
+        char cwd[ PATH_MAX ];
+        if ( optarg[0] != '/' && getcwd( cwd, sizeof cwd ) != NULL ) {
+          char *const arg = arena_alloc(
+            sizeof "--config=/" + strlen( cwd ) + strlen( optarg )
+          );
+          sprintf( arg, "--config=%s/%s", cwd, optarg );
+          lsp_add_arg( arg );
+        }
+        else {
+          char *const arg =
+            arena_alloc( sizeof "--config=" + strlen( optarg ) );
+          sprintf( arg, "--config=%s", optarg );
+          lsp_add_arg( arg );
+        }
+        break;
+      }
+      case 'C':
+        lsp_add_arg( "--no-config" );
+        break;
+      case 'f':
+        fin_path = optarg;
+        break;
+      case 'h':
+        lsp_usage( EX_OK );
+      case 'j':
+        lsp_json_lines = true;
+        break;
+      case 'o':
+        fout_path = optarg;
+        break;
+      case 'v':
+        puts( PACKAGE_STRING );
+        exit( EX_OK );
+      default:
+        lsp_usage( EX_USAGE );
+    } // switch
+  } // for
+  if ( optind < argc )
+    lsp_usage( EX_USAGE );
+
+  if ( fin_path != NULL && strcmp( fin_path, "-" ) != 0 ) {
+    lsp_in_fd = open( fin_path, O_RDONLY );
+    if ( lsp_in_fd == -1 )
+      fatal_error( EX_NOINPUT, "\"%s\": %s\n", fin_path, STRERROR() );
+  }
+  if ( fout_path != NULL && strcmp( fout_path, "-" ) != 0 ) {
+    lsp_out_fd = open( fout_path, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+    if ( lsp_out_fd == -1 )
+      fatal_error( EX_CANTCREAT, "\"%s\": %s\n", fout_path, STRERROR() );
+  }
+}
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.  If it is `EX_OK`, prints to standard
+ * output; otherwise prints to standard error.
+ */
+static void lsp_usage( int status ) {
+  fprintf( status == EX_OK ? stdout : stderr,
+"usage: %s [options]\n"
+"options:\n"
+"  --config=FILE   (-c) Configuration file path [default: nearest .wraprc].\n"
+"  --file=FILE     (-f) Read messages from this file [default: stdin].\n"
+"  --help          (-h) Print this help and exit.\n"
+"  --json-lines    (-j) Read and write messages as JSON lines.\n"
+"  --no-config     (-C) Suppress reading configuration file.\n"
+"  --output=FILE   (-o) Write messages to this file [default: stdout].\n"
+"  --version       (-v) Print version and exit.\n"
+"\n"
+PACKAGE_NAME " home page: " PACKAGE_URL "\n"
+"Report bugs to: " PACKAGE_BUGREPORT "\n",
+    me
+  );
+  exit( status );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  me = base_name( argv[0] );
+  ATEXIT( lsp_cleanup );
+  lsp_parse_options( argc, argv );
+
+  //
+  // A child that exits without reading all of its input mustn't kill us.
+  //
+  PJL_DISCARD_RV( signal( SIGPIPE, SIG_IGN ) );
+
+  for (;;) {
+    size_t len;
+    char const *const s = lsp_read_message( &len );
+    if ( s == NULL )
+      break;
+    json_value_t const *const msg = json_parse( s, len );
+    if ( msg == NULL )
+      lsp_send_error( NULL, LSP_ERR_PARSE, "invalid JSON" );
+    else if ( lsp_json_lines && msg->type == JSON_ARRAY )
+      lsp_job( msg );
+    else if ( msg->type != JSON_OBJECT )
+      lsp_send_error( NULL, LSP_ERR_INVALID_REQUEST, "object expected" );
+    else
+      lsp_handle( msg );
+    arena_reset( /*keep_chunk=*/true );
+  } // for
+
+  //
+  // A client that sends only Vim channel messages never sends shutdown.
+  //
+  exit(
+    lsp_is_shutdown || (lsp_json_lines && !lsp_is_initialized) ? EX_OK : 1
+  );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
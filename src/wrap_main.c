@@ -0,0 +1,234 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_main.c
+**
+**      Copyright (C) 1996-2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Implements **wrap**(1): parses its options, then runs the engine.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "options.h"
+#include "server.h"
+#include "util.h"
+#include "wrap.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdio.h>
+#include <stdlib.h>                     /* for exit() */
+#include <sysexits.h>
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+// extern variable definitions
+char const         *me;                 // executable name
+
+// local functions
+_Noreturn
+static void         usage( int );
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  server_main( PACKAGE, &wrap_preset, &argc, &argv );
+  profile_init();
+  startup_stats_init();
+  wait_for_debugger_attach( "WRAP_DEBUG" );
+  ATEXIT( common_cleanup );
+  options_init( argc, argv, usage );
+  startup_charge( STARTUP_OPTIONS );
+  profile_mark( PROFILE_CONF );
+  wrap_init();
+  if ( opt_stats )
+    ATEXIT( wrap_stats_print );
+  startup_charge( STARTUP_INIT );
+  wrap_run();
+}
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.  If it is `EX_OK`, prints to standard
+ * output; otherwise prints to standard error.
+ */
+static void usage( int status ) {
+  FILE *const fout = status == EX_OK ? stdout : stderr;
+  //
+  // The usage is split in two since a single string literal that long exceeds
+  // the length C compilers are required to support.
+  //
+  fprintf( fout,
+"usage: " PACKAGE " [options]\n"
+"       " PACKAGE " -O [options] FILE...\n"
+"       " PACKAGE " --git-changed[=REV] [options] [PATHSPEC...]\n"
+"       " PACKAGE " --server=SOCKET\n"
+"       " PACKAGE " --client=SOCKET [options]\n"
+"options:\n"
+"  --abbreviations=FILE   " UOPT(ABBREVIATIONS)
+                          "Abbreviations in FILE do not end sentences.\n"
+"  --affinity             " UOPT(AFFINITY)
+                          "Pin each parallel job to its own CPU.\n"
+"  --alias=NAME           " UOPT(ALIAS)
+                          "Use alias from configuration file.\n"
+"  --all-newlines-delimit " UOPT(ALL_NEWLINES_DELIMIT)
+                          "Treat newlines as paragraph delimiters.\n"
+"  --block-regex=REGEX    " UOPT(BLOCK_REGEX)
+                          "Block leading regular expression.\n"
+"  --check                " UOPT(CHECK)
+                          "Only check input is already formatted.\n"
+"  --config=FILE          " UOPT(CONFIG)
+                          "Configuration file path [default: nearest " CONF_FILE_NAME_DEFAULT "].\n"
+"  --diff                 " UOPT(DIFF)
+                          "Only write a unified diff of changes.\n"
+"  --dot-ignore           " UOPT(DOT_IGNORE)
+                          "Do not alter lines that begin with '.' (dot).\n"
+"  --doxygen              " UOPT(DOXYGEN)
+                          "Format Doxygen.\n"
+"  --edits                " UOPT(EDITS)
+                          "Only write edits of input as JSON Lines.\n"
+"  --email-quotes         " UOPT(EMAIL_QUOTES)
+                          "Format quoted e-mail.\n"
+"  --eol=STR              " UOPT(EOL) "\n"
+"      Set line-endings as input/Unix/Windows [default: input].\n"
+"  --eos-delimit          " UOPT(EOS_DELIMIT) "\n"
+"      Treat whitespace after end-of-sentence as a paragraph delimiter.\n"
+"  --eos-spaces=NUM       " UOPT(EOS_SPACES)
+                          "Spaces after end-of-sentence [default: " STRINGIFY(EOS_SPACES_DEFAULT) "].\n"
+"  --expand-tabs          " UOPT(EXPAND_TABS)
+                          "Expand tabs in output to spaces.\n"
+"  --file=FILE            " UOPT(FILE)
+                          "Read from this file [default: stdin].\n"
+"  --file-name=NAME       " UOPT(FILE_NAME)
+                          "Filename for stdin.\n"
+"  --follow[=MS]          " UOPT(FOLLOW) "\n"
+"      Flush output after MS milliseconds without input [default: " STRINGIFY(FOLLOW_MS_DEFAULT) "].\n"
+"  --git-changed[=REV]    " UOPT(GIT_CHANGED) "\n"
+"      Reformat in place only paragraphs changed since REV [default: HEAD].\n"
+"  --hang-spaces=NUM      " UOPT(HANG_SPACES) "\n"
+"      Hang-indent spaces after tabs for all but first line of every paragraph.\n"
+"  --hang-tabs=NUM        " UOPT(HANG_TABS) "\n"
+"      Hang-indent tabs for all but first line of every paragraph.\n"
+"  --help                 " UOPT(HELP)
+                          "Print this help and exit.\n"
+"  --hyphenate=FILE       " UOPT(HYPHENATE)
+                          "Hyphenate long words using patterns in FILE.\n"
+"  --in-place             " UOPT(IN_PLACE)
+                          "Reformat FILE(s) in place.\n"
+"  --indent-spaces=NUM    " UOPT(INDENT_SPACES) "\n"
+"      Indent spaces after tabs for first line of every paragraph.\n"
+"  --indent-tabs=NUM      " UOPT(INDENT_TABS)
+                          "Indent tabs for first line of every paragraph.\n"
+"  --jobs=NUM             " UOPT(JOBS)
+                          "Number of parallel jobs [default: 1].\n"
+"  --jsonl=[text:]FIELD   " UOPT(JSONL) "\n"
+"      Reformat FIELD of JSON Lines records in place or as text.\n"
+"  --justify              " UOPT(JUSTIFY)
+                          "Justify lines to the line width.\n"
+"  --keep-bom             " UOPT(KEEP_BOM)
+                          "Keep a byte order mark starting the input.\n"
+"  --keep-encoding\n"
+"      Write output in the input's UTF-16 or UTF-32 encoding.\n"
+"  --lead-spaces=NUM      " UOPT(LEAD_SPACES)
+                          "Prepend leading spaces after tabs to every line.\n"
+"  --lead-string=STR      " UOPT(LEAD_STRING)
+                          "String to prepend to every line.\n"
+"  --lead-tabs=NUM        " UOPT(LEAD_TABS)
+                          "Prepend leading tabs to every line.\n"
+"  --lines=N[-[M]]        " UOPT(LINES)
+                          "Reformat only lines N through M.\n"
+"  --markdown             " UOPT(MARKDOWN)
+                          "Format Markdown.\n"
+"  --markdown-tables      " UOPT(MARKDOWN_TABLES)
+                          "Align Markdown table columns.\n"
+"  --markup=LANG          " UOPT(MARKUP) "\n"
+"      Format reStructuredText (rst), AsciiDoc (asciidoc), HTML (html), or roff.\n"
+"  --max-lines=NUM        " UOPT(MAX_LINES)
+                          "Stop after writing NUM lines.\n"
+"  --measure              " UOPT(MEASURE) "\n"
+"      Only print each paragraph's line count and maximum width.\n"
+"  --minimal\n"
+"      Only break lines that are too long.\n"
+"  --mirror-spaces=NUM    " UOPT(MIRROR_SPACES)
+                          "Mirror spaces.\n"
+"  --mirror-tabs=NUM      " UOPT(MIRROR_TABS)
+                          "Mirror tabs.\n"
+  );
+  fprintf( fout,
+"  --no-break=FILE        " UOPT(NO_BREAK)
+                          "Never wrap within tokens listed in FILE.\n"
+"  --no-config            " UOPT(NO_CONFIG)
+                          "Suppress reading configuration file.\n"
+"  --no-hyphen            " UOPT(NO_HYPHEN)
+                          "Suppress wrapping at hyphen characters.\n"
+"  --no-newlines-delimit  " UOPT(NO_NEWLINES_DELIMIT)
+                          "Do not treat newlines as paragraph delimiters.\n"
+"  --optimal[=NUM]        " UOPT(OPTIMAL)
+                          "Minimize raggedness rather than fill lines.\n"
+"  --output=FILE          " UOPT(OUTPUT)
+                          "Write to this file [default: stdout].\n"
+"  --para-cache[=FILE]    " UOPT(PARA_CACHE)
+                          "Reuse unchanged paragraphs' output from cache.\n"
+"  --para-chars=STR       " UOPT(PARA_CHARS)
+                          "Additional paragraph delimiter characters.\n"
+"  --prototype            " UOPT(PROTOTYPE) "\n"
+"      Treat leading whitespace on first line as prototype.\n"
+"  --read-index=FILE\n"
+"      Seek to --lines via paragraph index FILE.\n"
+"  --stats[=NUM]          " UOPT(STATS) "\n"
+"      Print statistics and NUM costliest paragraphs to stderr.\n"
+"  --tab-spaces=NUM       " UOPT(TAB_SPACES)
+                          "Tab-spaces equivalence [default: " STRINGIFY(TAB_SPACES_DEFAULT) "].\n"
+"  --title                " UOPT(TITLE_LINE)
+                          "Treat paragraph's first line as title.\n"
+"  --unicode-breaks       " UOPT(UNICODE_BREAKS) "\n"
+"      Also wrap where Unicode allows, e.g., between ideographs.\n"
+"  --version              " UOPT(VERSION)
+                          "Print version and exit.\n"
+"  --whitespace-delimit   " UOPT(WHITESPACE_DELIMIT) "\n"
+"      Treat lines beginning with whitespace as paragraph delimiters.\n"
+"  --width=NUM|auto|terminal " UOPT(WIDTH) "\n"
+"      Line width [default: " STRINGIFY(LINE_WIDTH_DEFAULT) "].\n"
+"  --widths=NUM,...       " UOPT(WIDTHS) "\n"
+"      Write output for each line width to its own --output file.\n"
+"  --write-index=FILE\n"
+"      Write paragraph index FILE for --read-index.\n"
+"\n"
+PACKAGE_NAME " home page: " PACKAGE_URL "\n"
+"Report bugs to: " PACKAGE_BUGREPORT "\n"
+  );
+  exit( status );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
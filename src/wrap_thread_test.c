@@ -0,0 +1,267 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_thread_test.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Checks that reformatting text via wrap_feed() in several threads at once,
+ * each with its own \ref wrap_ctx, gives the same output in every thread as in
+ * one.  It takes the same options as **wrap**(1) and prints the output so it
+ * can be compared against that of **wrap**(1).
+ *
+ * @remarks Different output would show only some data races; to find all of
+ * them, configure with both `CFLAGS` and `LDFLAGS` set to
+ * `-fsanitize=thread` so ThreadSanitizer checks every access while this runs.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "options.h"
+#include "util.h"
+#include "wrap.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>                     /* for exit() */
+#include <string.h>
+#include <sysexits.h>
+
+#if defined(WITH_PIPELINE) && HAVE_PTHREAD_H
+# include <pthread.h>
+# define WITH_THREADS 1
+#endif /* WITH_PIPELINE && HAVE_PTHREAD_H */
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Number of threads to reformat the input in at once.
+#define TEST_THREADS              4
+
+/// Number of times each thread reformats the input.
+#define TEST_ROUNDS               8
+
+/**
+ * A growable buffer of characters.
+ */
+struct test_buf {
+  char   *str;                          ///< Characters (not null-terminated).
+  size_t  len;                          ///< Number of characters.
+  size_t  cap;                          ///< Capacity of \a str.
+};
+typedef struct test_buf test_buf_t;
+
+/**
+ * What a thread is given and what it finds.
+ */
+struct test_job {
+  test_buf_t const *input;              ///< The input to reformat.
+  size_t            piece_size;         ///< Size of pieces to give it in.
+  test_buf_t        output;             ///< Its output the first time.
+  bool              is_same;            ///< Was the output always the same?
+};
+typedef struct test_job test_job_t;
+
+// extern variable definitions
+char const         *me;                 ///< Program name.
+
+// local functions
+static void         buf_append( test_buf_t*, char const*, size_t );
+static void         buf_write( char const*, size_t, void* );
+
+NODISCARD
+static test_buf_t   read_input( void );
+
+static void*        test_job_main( void* );
+
+NODISCARD
+static test_buf_t   test_wrap( test_buf_t const*, size_t );
+
+_Noreturn
+static void         usage( int );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Appends \a len characters of \a s to \a buf.
+ *
+ * @param buf The \ref test_buf to append to.
+ * @param s The characters to append.
+ * @param len The number of characters to append.
+ */
+static void buf_append( test_buf_t *buf, char const *s, size_t len ) {
+  if ( buf->len + len > buf->cap ) {
+    buf->cap = (buf->len + len) * 2;
+    REALLOC( buf->str, char, buf->cap );
+  }
+  memcpy( buf->str + buf->len, s, len );
+  buf->len += len;
+}
+
+/**
+ * The \ref writer_fn_t that appends the output of wrap_feed() to a
+ * \ref test_buf.
+ *
+ * @param s The characters of output.
+ * @param len The number of characters of output.
+ * @param data A pointer to the \ref test_buf to append to.
+ */
+static void buf_write( char const *s, size_t len, void *data ) {
+  buf_append( data, s, len );
+}
+
+/**
+ * Reads all of standard input.
+ *
+ * @return Returns said input that must be freed.
+ */
+static test_buf_t read_input( void ) {
+  test_buf_t input = { NULL, 0, 0 };
+  char chunk[ 8192 ];
+  size_t n;
+  while ( (n = fread( chunk, 1, sizeof chunk, stdin )) > 0 )
+    buf_append( &input, chunk, n );
+  FERROR( stdin );
+  return input;
+}
+
+/**
+ * Reformats a \ref test_job's input #TEST_ROUNDS times and notes whether the
+ * output was always the same as the first time.
+ *
+ * @param data A pointer to the \ref test_job.
+ * @return Returns NULL.
+ */
+static void* test_job_main( void *data ) {
+  test_job_t *const job = data;
+  job->output = test_wrap( job->input, job->piece_size );
+  job->is_same = true;
+  for ( unsigned round = 1; round < TEST_ROUNDS; ++round ) {
+    test_buf_t output = test_wrap( job->input, job->piece_size );
+    if ( output.len != job->output.len ||
+         memcmp( output.str, job->output.str, output.len ) != 0 ) {
+      job->is_same = false;
+    }
+    FREE( output.str );
+  } // for
+  return NULL;
+}
+
+/**
+ * Reformats \a input by giving it to wrap_feed() in pieces.
+ *
+ * @param input The input to reformat.
+ * @param piece_size The size of each piece (but the last).
+ * @return Returns the output that must be freed.
+ */
+static test_buf_t test_wrap( test_buf_t const *input, size_t piece_size ) {
+  test_buf_t output = { NULL, 0, 0 };
+  wrap_ctx_t ctx;
+  wrap_ctx_init( &ctx, &buf_write, &output );
+  for ( size_t pos = 0; pos < input->len; pos += piece_size ) {
+    size_t const len = input->len - pos < piece_size ?
+      input->len - pos : piece_size;
+    wrap_feed( &ctx, input->str + pos, len );
+  } // for
+  wrap_finish( &ctx );
+  wrap_ctx_cleanup( &ctx );
+  return output;
+}
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.
+ */
+static void usage( int status ) {
+  EPRINTF( "usage: %s [wrap-options]\n", me );
+  exit( status );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  ATEXIT( common_cleanup );
+  options_init( argc, argv, usage );
+  wrap_init();
+
+  test_buf_t input = read_input();
+
+  //
+  // Start all the threads before reformatting anything at all so that
+  // anything initialized when first used is initialized while they race.
+  //
+  test_job_t jobs[ TEST_THREADS ];
+  for ( unsigned i = 0; i < TEST_THREADS; ++i ) {
+    jobs[i] = (test_job_t){
+      .input = &input,
+      .piece_size = 1u << (3 * i)       // 1, 8, 64, 512
+    };
+  } // for
+
+#ifdef WITH_THREADS
+  pthread_t tids[ TEST_THREADS ];
+  for ( unsigned i = 0; i < TEST_THREADS; ++i ) {
+    PERROR_EXIT_IF(
+      pthread_create( &tids[i], /*attr=*/NULL, &test_job_main, &jobs[i] ) != 0,
+      EX_OSERR
+    );
+  } // for
+  for ( unsigned i = 0; i < TEST_THREADS; ++i )
+    PJL_DISCARD_RV( pthread_join( tids[i], /*retval=*/NULL ) );
+#else
+  for ( unsigned i = 0; i < TEST_THREADS; ++i )
+    PJL_DISCARD_RV( test_job_main( &jobs[i] ) );
+#endif /* WITH_THREADS */
+
+  test_buf_t const whole = test_wrap( &input, input.len > 0 ? input.len : 1 );
+  unsigned mismatches = 0;
+  for ( unsigned i = 0; i < TEST_THREADS; ++i ) {
+    if ( !jobs[i].is_same || jobs[i].output.len != whole.len ||
+         memcmp( jobs[i].output.str, whole.str, whole.len ) != 0 ) {
+      EPRINTF(
+        "%s: output differs in thread given pieces of %zu\n",
+        me, jobs[i].piece_size
+      );
+      ++mismatches;
+    }
+    FREE( jobs[i].output.str );
+  } // for
+
+  if ( whole.len > 0 )
+    PERROR_EXIT_IF( fwrite( whole.str, 1, whole.len, stdout ) != whole.len,
+                    EX_IOERR );
+  FREE( input.str );
+  FREE( whole.str );
+  exit( mismatches > 0 ? EX_SOFTWARE : EX_OK );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,192 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_wasm.c
+**
+**      Copyright (C) 2026  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Implements the WebAssembly module of the **wrap**(1) engine for reformatting
+ * text in a web browser: it exports functions that reformat text in memory
+ * via wrap_feed() that `wrap_wasm.js` wraps in a JavaScript API.  Neither
+ * standard input nor standard output is used.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "common.h"
+#include "options.h"
+#include "util.h"
+#include "wrap.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdio.h>
+#include <stdlib.h>                     /* for exit() */
+#include <string.h>
+#include <sysexits.h>
+
+#ifdef __EMSCRIPTEN__
+# include <emscripten/emscripten.h>
+#else
+# define EMSCRIPTEN_KEEPALIVE           /* nothing */
+#endif /* __EMSCRIPTEN__ */
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A growable buffer of the characters of output.
+ */
+struct wasm_buf {
+  char   *str;                          ///< Characters (not null-terminated).
+  size_t  len;                          ///< Number of characters.
+  size_t  cap;                          ///< Capacity of \a str.
+};
+typedef struct wasm_buf wasm_buf_t;
+
+// extern variable definitions
+char const         *me;                 ///< Program name.
+
+// local variable definitions
+static wrap_ctx_t   wasm_ctx;           ///< Context reused for every text.
+static size_t       wasm_line_width;    ///< Line width given by the options.
+static wasm_buf_t   wasm_out;           ///< Output of the last text.
+
+// extern functions
+EMSCRIPTEN_KEEPALIVE
+int                 wrap_wasm_init( int, char const*[] );
+
+EMSCRIPTEN_KEEPALIVE
+size_t              wrap_wasm_len( void );
+
+EMSCRIPTEN_KEEPALIVE
+char const*         wrap_wasm_wrap( char const*, size_t, size_t );
+
+// local functions
+static void         buf_write( char const*, size_t, void* );
+
+_Noreturn
+static void         usage( int );
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * The \ref writer_fn_t that appends the output of wrap_feed() to a
+ * \ref wasm_buf.
+ *
+ * @param s The characters of output.
+ * @param len The number of characters of output.
+ * @param data A pointer to the \ref wasm_buf to append to.
+ */
+static void buf_write( char const *s, size_t len, void *data ) {
+  wasm_buf_t *const buf = data;
+  if ( buf->len + len > buf->cap ) {
+    buf->cap = (buf->len + len) * 2;
+    REALLOC( buf->str, char, buf->cap );
+  }
+  memcpy( buf->str + buf->len, s, len );
+  buf->len += len;
+}
+
+/**
+ * Prints the usage message and exits.
+ *
+ * @param status The status to exit with.
+ */
+static void usage( int status ) {
+  EPRINTF( "%s: options are those of " PACKAGE "(1)\n", me );
+  exit( status );
+}
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Initializes the engine: parses the options that then apply to every text
+ * reformatted by wrap_wasm_wrap().
+ *
+ * @param argc The argument count.
+ * @param argv The argument values: the first is the program name and the rest
+ * are the same options as for **wrap**(1).  They must remain valid.
+ * @return Returns 0 on success; exits on error.
+ *
+ * @note This must be called exactly once before wrap_wasm_wrap().
+ */
+int wrap_wasm_init( int argc, char const *argv[] ) {
+  options_init( argc, argv, usage );
+  //
+  // There are neither files nor processes in a browser.
+  //
+  if ( opt_in_place || opt_jobs != 1 )
+    fatal_error( EX_USAGE, "neither --in-place nor --jobs is supported\n" );
+  wasm_line_width = opt_line_width;
+  if ( wasm_line_width == LINE_WIDTH_AUTO )
+    opt_line_width = LINE_WIDTH_DEFAULT;  // estimated for each text instead
+  wrap_init();
+  wrap_ctx_init( &wasm_ctx, &buf_write, &wasm_out );
+  return EX_OK;
+}
+
+/**
+ * Gets the length of the output of the last call to wrap_wasm_wrap().
+ *
+ * @return Returns said length.
+ */
+size_t wrap_wasm_len( void ) {
+  return wasm_out.len;
+}
+
+/**
+ * Reformats text.
+ *
+ * @param s The characters of the text.  They need not be null-terminated.
+ * @param len The number of characters of \a s.
+ * @param line_width The line width, 0 for that given by the options, or
+ * `SIZE_MAX` to estimate the width \a s was already wrapped to.
+ * @return Returns the reformatted text (not null-terminated) whose length is
+ * returned by wrap_wasm_len().  It remains valid only until the next call.
+ */
+char const* wrap_wasm_wrap( char const *s, size_t len, size_t line_width ) {
+  if ( line_width == 0 )
+    line_width = wasm_line_width;
+  if ( line_width == LINE_WIDTH_AUTO ) {
+    line_width = wrap_width_estimate( s, len );
+    if ( line_width == 0 )
+      line_width = LINE_WIDTH_DEFAULT;
+  }
+  opt_line_width = line_width;
+  wasm_out.len = 0;
+  wrap_ctx_reset( &wasm_ctx );          // ctx_start() reads opt_line_width
+  wrap_feed( &wasm_ctx, s, len );
+  wrap_finish( &wasm_ctx );
+  return wasm_out.str;
+}
+
+/**
+ * The main entry point: there's nothing to do until wrap_wasm_init() is
+ * called.
+ *
+ * @return Returns 0.
+ */
+int main( void ) {
+  return EX_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,79 @@
+/*
+**      wrap -- text reformatter
+**      src/wrap_wasm.js
+**
+**      Copyright (C) 2026  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * The JavaScript API of the WebAssembly module of the wrap engine built by
+ * "make wasm".  For example:
+ *
+ *      import { createWrap } from './wrap_wasm.js';
+ *      const wrap = await createWrap( [ '--markdown' ] );
+ *      preview.textContent = wrap.wrap( editor.value, 72 );
+ *
+ * Text is reformatted synchronously entirely in the browser.
+ */
+
+import createModule from './wrap_wasm.mjs';
+
+/**
+ * Creates a reformatter.  Since the engine's options are global to the
+ * module, each reformatter has a module of its own.
+ *
+ * @param {string[]} [args] The same options as for wrap(1), e.g.,
+ * `[ '--markdown', '--width=72' ]`.  A configuration file is never read.
+ * @return {Promise<{wrap: function(string, number=): string}>} Returns a
+ * promise of an object whose `wrap( text, width )` method returns `text`
+ * reformatted to `width` or, if 0 or omitted, the width given by `args`.
+ * @throws Throws (or rejects) if any option is invalid.
+ */
+export async function createWrap( args = [] ) {
+  const m = await createModule();
+  const argv = [ 'wrap', '--no-config', ...args ];
+
+  // The options keep pointers into argv, so it's never freed.
+  const argvPtr = m._malloc( 4 * (argv.length + 1) );
+  argv.forEach( ( arg, i ) => {
+    m.HEAPU32[ (argvPtr >> 2) + i ] = m.stringToNewUTF8( arg );
+  } );
+  m.HEAPU32[ (argvPtr >> 2) + argv.length ] = 0;
+  m._wrap_wasm_init( argv.length, argvPtr );
+
+  const decoder = new TextDecoder();
+  const encoder = new TextEncoder();
+
+  return {
+    wrap( text, width = 0 ) {
+      const bytes = encoder.encode( text );
+      const textPtr = m._malloc( bytes.length + 1 );
+      try {
+        m.HEAPU8.set( bytes, textPtr );
+        const outPtr = m._wrap_wasm_wrap( textPtr, bytes.length, width );
+        // HEAPU8 may have been replaced if memory grew.
+        return decoder.decode(
+          m.HEAPU8.subarray( outPtr, outPtr + m._wrap_wasm_len() )
+        );
+      } finally {
+        m._free( textPtr );
+      }
+    }
+  };
+}
+
+/* vim:set et sw=2 ts=2: */
@@ -20,7 +20,8 @@
 
 /**
  * @file
- * Implements **wrapc**(1).
+ * Implements **wrapc**(1): reformats comments by running the **wrap**(1)
+ * engine on their text.
  */
 
 // local
@@ -28,27 +29,43 @@
 #include "alias.h"
 #include "cc_map.h"
 #include "common.h"
-#include "doxygen.h"
+#include "lang.h"
 #include "markdown.h"
 #include "options.h"
 #include "pattern.h"
+#include "probe.h"
+#include "reader.h"
+#include "simd.h"
+#include "unicode.h"
 #include "util.h"
+#include "wipc.h"
+#include "wrap.h"
+#include "wrapc.h"
+#include "writer.h"
 
 /// @cond DOXYGEN_IGNORE
 
 // standard
 #include <assert.h>
 #include <ctype.h>
+#include <fcntl.h>                      /* for F_SETPIPE_SZ */
 #include <limits.h>                     /* for PATH_MAX */
 #include <signal.h>                     /* for kill() */
+#if HAVE_POSIX_SPAWNP && HAVE_SPAWN_H
+#include <spawn.h>                      /* for posix_spawnp() */
+#endif /* HAVE_POSIX_SPAWNP && HAVE_SPAWN_H */
 #include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <inttypes.h>                   /* for PRIu64 */
+#include <stdint.h>                     /* for SIZE_MAX */
 #include <stdio.h>
-#include <stdlib.h>                     /* for exit() */
+#include <stdlib.h>                     /* for exit(), getenv() */
 #include <string.h>                     /* for str...() */
+#include <sys/resource.h>               /* for getrusage(2) */
 #include <sys/wait.h>                   /* for wait() */
 #include <sysexits.h>
-#include <unistd.h>                     /* for close(), fork(), ... */
+#include <time.h>                       /* for clock_gettime(3) */
+#include <unistd.h>                     /* for close(), environ, ... */
 
 /*
  * Uncomment the line below to debug read_source_write_wrap() (RSWW) by not
@@ -73,11 +90,30 @@
 /// Maximum **wrap**(1) command-line argument size.
 #define ARG_BUF_SIZE              25
 
+/**
+ * Minimum number of characters of input per chunk when reformatting all
+ * comments in parallel: below this, the cost of forking outweighs any gain.
+ */
+#define COMMENTS_CHUNK_SIZE_MIN   (1024 * 1024)
+
+/**
+ * Default capacity of each pipe between the processes unless overridden by
+ * the `WRAPC_PIPE_SIZE` environment variable.  The larger the pipes, the less
+ * often the three processes have to context switch to wait for each other.
+ */
+#define PIPE_SIZE_DEFAULT         (1024 * 1024)
+
+/**
+ * Size of the `stdio` buffer used by read_source_write_wrap() for writing to
+ * **wrap**(1).
+ */
+#define PIPE_STDIO_BUF_SIZE       (64 * 1024)
+
 /**
  * Redirects \a FD file-descriptor to/from pipe \a P.
  *
  * @param FD The file descriptor to redirect.
- * @param P The pipe index, 0 or 1, to redirect to.
+ * @param P The pipe index, #TO_WRAP or #FROM_WRAP, to redirect to.
  */
 #define REDIRECT(FD,P) \
   BLOCK( DUP2( pipes[P][FD], FD ); close_pipe( pipes[P] ); )
@@ -88,7 +124,7 @@
  * @param input_buf The input buffer to use.  It must contain the first line of
  * text read.
  */
-void align_eol_comments( char input_buf[const] );
+void align_eol_comments( line_buf_t *input_buf );
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -113,39 +149,120 @@ enum delim {
   DELIM_SINGLE,
 
   ///
-  /// Double character comment delimiter.
+  /// Multiple character comment delimiter.
   ///
-  /// @remarks Two _different_ characters begin the comment that typically has
-  /// the same characters reversed that end the comment, e.g., `/*` and `*/`.
+  /// @remarks Two or more characters begin the comment that typically has
+  /// two or more characters that end the comment, e.g., `/*` and `*/` or
+  /// `<!--` and `-->`.
   ///
   DELIM_DOUBLE,
 };
 typedef enum delim delim_t;
 
+/**
+ * How a comment read by read_comment() ended.
+ */
+enum comment_end {
+  COMMENT_END_EOF,                      ///< At the end of the input.
+  COMMENT_END_BEFORE,                   ///< Just before the current line.
+  COMMENT_END_AT                        ///< At the current line.
+};
+typedef enum comment_end comment_end_t;
+
+/**
+ * What's known about the prefix of a line of input from having spanned it once
+ * so that is_line_comment(), is_block_comment(), and prefix_span() needn't
+ * each span it again every time the line is checked.
+ */
+struct line_desc {
+  size_t  ws_len;                       ///< Length of leading whitespace.
+  size_t  cc_len;                       ///< First delimiter length; 0 = none.
+  size_t  prefix_len;                   ///< Length per prefix_span().
+  int8_t  is_block;                     ///< Per is_block_comment(); -1 = unset.
+  bool    is_valid;                     ///< Is it for the line as it is now?
+};
+typedef struct line_desc line_desc_t;
+
 /**
  * Contains the current and next lines of input so the next line can be peeked
  * at to determine how to proceed.
  */
 struct dual_line {
-  line_buf_t  dl_line[2];               ///< Two lines.
-  char       *dl_curr;                  ///< Pointer to current line.
-  char       *dl_next;                  ///< Pointer to next line.
+  line_buf_t   dl_line[2];              ///< Two lines.
+  line_desc_t  dl_desc[2];              ///< Their descriptors.
+  line_buf_t  *dl_curr;                 ///< Pointer to current line.
+  line_buf_t  *dl_next;                 ///< Pointer to next line.
+  line_desc_t *dl_curr_desc;            ///< Pointer to current line's desc.
+  line_desc_t *dl_next_desc;            ///< Pointer to next line's desc.
 };
 typedef struct dual_line dual_line_t;
 
-// extern variable definitions
-char const         *me;                 // executable name
+/**
+ * The output of the **wrap**(1) engine run in-process by wrap_all_comments().
+ */
+struct wrapped {
+  writer_t   *wout;                     ///< Writer to put each line to.
+  line_buf_t  buf;                      ///< Output not yet put, if any.
+  size_t      len;                      ///< Length of \a buf.
+  line_buf_t  line_buf;                 ///< Line being put.
+  line_buf_t  proto_tws;                ///< Prototype trailing whitespace.
+};
+typedef struct wrapped wrapped_t;
+
+/**
+ * A child process reformatting the comments of a chunk of standard input.
+ *
+ * @sa wrap_all_comments_fork()
+ */
+struct comments_job {
+  pid_t   pid;                          ///< Process ID of the child.
+  FILE   *fout;                         ///< Temporary file of its output.
+};
+typedef struct comments_job comments_job_t;
+
+/**
+ * Stages of the pipeline of processes (see \ref pipes).
+ */
+enum stage {
+  STAGE_READ,                           ///< Child 1 reading the source.
+  STAGE_WRAP,                           ///< Child 2 being **wrap**(1).
+  STAGE_WRITE                           ///< Parent writing stdout.
+};
+typedef enum stage stage_t;
+
+/**
+ * Statistics of a \ref stage printed for `--stats`.
+ */
+struct stage_stats {
+  double    wall_secs;                  ///< Wall time until it finished.
+  double    cpu_secs;                   ///< User plus system CPU time.
+  uint64_t  bytes_in;                   ///< Bytes read.
+  uint64_t  bytes_out;                  ///< Bytes written.
+  uint64_t  lines;                      ///< Lines read.
+  uint64_t  ipc;                        ///< IPC messages sent or received.
+};
+typedef struct stage_stats stage_stats_t;
 
 // local variable definitions
-static char         close_cc[2];        ///< Closing comment delimiter char(s).
+static char         close_cc[ CC_DELIM_LEN_MAX + 1 ];
+                                        ///< Closing comment delimiter char(s).
+static size_t       close_cc_len;       ///< Length of \ref close_cc.
 static delim_t      delim;              ///< Comment delimiter type.
+static size_t       open_cc_len;        ///< Length of opening delimiter.
 static dual_line_t  input_lines;        ///< Input lines.
 static line_buf_t   prefix_buf;         ///< Characters stripped/prepended.
 static size_t       prefix_len;         ///< Length of \ref prefix_buf.
+static size_t       prefix_tws_len;     ///< Length of its tws split off.
 static line_buf_t   suffix_buf;         ///< Characters stripped/appended.
 static size_t       suffix_len;         ///< Length of \ref suffix_buf.
+static bool         is_ipc_oob;         ///< Send IPC messages out-of-band?
+static pid_t        rsww_pid;           ///< read_source_write_wrap() child.
+static pid_t        wrap_pid;           ///< fork_wrap() child.
+static stage_stats_t stats[3];          ///< Indexed by \ref stage.
+static int          stats_pipe[2];      ///< Child 1 sends its stats via.
+static double       stats_start;        ///< When the stages started.
 /**
- * Two pipes:
+ * Four pipes:
  *
  *      pipes[0][1] <- read_source_write_wrap()  [child 1]
  *              [0] -> wrap(1)                   [child 2]
@@ -153,6 +270,10 @@ static size_t       suffix_len;         ///< Length of \ref suffix_buf.
  *      pipes[1][1] <- wrap(1)                   [child 2]
  *              [0] -> read_wrap_write_stdout()  [parent]
  *
+ *      pipes[2]    is like pipes[0] and pipes[3] is like pipes[1], but for
+ *                  IPC messages sent out-of-band (see \ref wipc-group)
+ *                  rather than in-band, i.e., unless **wrap**(1) is exec'd.
+ *
  * @remarks
  * @parblock
  * **wrapc**(1) forks twice:
@@ -161,7 +282,8 @@ static size_t       suffix_len;         ///< Length of \ref suffix_buf.
  *     stdin, strips leading whitespace and comment delimiter characters, and
  *     writes to `pipe[0][1]` connected to child 2.
  *
- *  2. Child 2 exec's itself into **wrap**(1), reads text from stdin via
+ *  2. Child 2 runs the **wrap**(1) engine linked into **wrapc**(1) (or, as
+ *     a fallback, exec's itself into **wrap**(1)), reads text from stdin via
  *     `pipes[0][0]` connected to child 1, reformats it, and writes to stdout
  *     via `pipe[1][1]` connected to the parent.
  *
@@ -170,38 +292,79 @@ static size_t       suffix_len;         ///< Length of \ref suffix_buf.
  * read_wrap_write_stdout().
  * @endparblock
  */
-static int          pipes[2][2];
+static int          pipes[4][2];
 
-#define CURR        input_lines.dl_curr /**< Shorthand for current line. */
-#define NEXT        input_lines.dl_next /**< Shorthand for next line. */
+#define CURR_BUF    input_lines.dl_curr /**< Current line buffer. */
+#define NEXT_BUF    input_lines.dl_next /**< Next line buffer. */
+#define CURR_DESC   input_lines.dl_curr_desc  /**< Current line's desc. */
+#define NEXT_DESC   input_lines.dl_next_desc  /**< Next line's desc. */
+#define CURR        CURR_BUF->str       /**< Shorthand for current line. */
+#define NEXT        NEXT_BUF->str       /**< Shorthand for next line. */
 
 #define TO_WRAP     0                   /**< To refer to \ref pipes[0]. */
 #define FROM_WRAP   1                   /**< To refer to \ref pipes[1]. */
+#define TO_WRAP_IPC 2                   /**< To refer to \ref pipes[2]. */
+#define FROM_WRAP_IPC 3                 /**< To refer to \ref pipes[3]. */
 
 // local functions
-static void         adjust_comment_width( char* );
+static void         adjust_comment_width( line_buf_t* );
 static void         chop_suffix( char* );
-static void         fork_exec_wrap( pid_t );
+
+#ifndef DEBUG_RSWW
+#endif /* DEBUG_RSWW */
+
+static void         fork_wrap( pid_t );
 static void         init( int, char const*[] );
 
 NODISCARD
 static bool         is_block_comment( char const* );
 
+NODISCARD
+static bool         is_code_line( char const*, size_t );
+
 NODISCARD
 static char const*  is_line_comment( char const* );
 
 NODISCARD
 static char const*  is_terminated_comment( char* );
 
+static void         kill_child_processes( void );
+
+NODISCARD
+static line_desc_t* line_desc( char const* );
+
+static void         line_descs_invalidate( void );
+static void         next_line( void );
+
+NODISCARD
+static double       now_secs( void );
+
+static void         peek_line( void );
+static void         pipe_resize( int[const static 2] );
+
 NODISCARD
 static size_t       prefix_span( char const* );
 
+static void         put_code_lines( writer_t* );
+
+NODISCARD
+static bool         put_wrapped_line( writer_t*, line_buf_t*, size_t,
+                                      line_buf_t* );
+
+NODISCARD
+static comment_end_t read_comment( writer_t*, wipc_out_t*, bool );
+
 static void         read_prototype( void );
 
 NODISCARD
 static pid_t        read_source_write_wrap( void );
 
 static void         read_wrap_write_stdout( void );
+
+NODISCARD
+static double       rusage_secs( int );
+
+static void         set_leader( size_t, char const*, line_buf_t* );
 static void         set_prefix( char const*, size_t );
 
 NODISCARD
@@ -210,6 +373,11 @@ static char*        skip_c( char*, char );
 NODISCARD
 static char*        skip_n( char*, size_t );
 
+static void         spawn_wrap( pid_t );
+static void         split_prefix_tws( line_buf_t* );
+static void         stats_print( void );
+static void         stats_send( void );
+
 NODISCARD
 static size_t       strlen_no_eol( char const* );
 
@@ -222,9 +390,12 @@ static size_t       str_width( char const* );
 _Noreturn
 static void         usage( int );
 static void         wait_for_child_processes( void );
-
-NODISCARD
-static bool         wrap_dox_line( char const*, FILE* );
+static void         wrap_all_comments( void );
+static void         wrap_all_comments_fork( void );
+static void         wrap_feed_write( char const*, size_t, void* );
+static void         wrapc_cleanup( void );
+static void         wrapped_put( wrapped_t*, char const*, size_t );
+static void         wrapped_write( char const*, size_t, void* );
 
 ////////// inline functions ///////////////////////////////////////////////////
 
@@ -246,50 +417,66 @@ static inline void close_pipe( int pipe[const static 2] ) {
  */
 NODISCARD
 static inline bool is_comment_char( char c ) {
-  return c != '\0' && strchr( opt_comment_chars, c ) != NULL;
+  return cc_map_is_char( c );
 }
 
 /**
  * Gets whether the first non-whitespace character in \a s is a comment
- * character.
+ * character or starts a comment delimiter.
  *
- * @param s The string to check.
+ * @param s The string to check.  It must be either \ref CURR or \ref NEXT.
  * @return Returns a pointer to the first non-whitespace character in \a s only
- * if it's a comment delimiter character; NULL otherwise.
+ * if it's a comment delimiter character or starts a comment delimiter, e.g.,
+ * `REM`; NULL otherwise.
  */
 NODISCARD
 static inline char const* is_line_comment( char const *s ) {
-  return is_comment_char( SKIP_CHARS( s, WS_ST )[0] ) ? s : NULL;
+  line_desc_t const *const desc = line_desc( s );
+  return desc->cc_len > 0 ? s + desc->ws_len : NULL;
 }
 
 /**
  * Swaps the two line buffers.
  */
 static inline void swap_line_bufs( void ) {
-  char *const temp = CURR;
-  CURR = NEXT;
-  NEXT = temp;
+  line_buf_t *const temp = CURR_BUF;
+  CURR_BUF = NEXT_BUF;
+  NEXT_BUF = temp;
+  line_desc_t *const temp_desc = CURR_DESC;
+  CURR_DESC = NEXT_DESC;
+  NEXT_DESC = temp_desc;
 }
 
-////////// main ///////////////////////////////////////////////////////////////
+////////// extern functions ///////////////////////////////////////////////////
 
-/**
- * The main entry point.
- *
- * @param argc The command-line argument count.
- * @param argv The command-line argument values.
- * @return Returns 0 on success, non-zero on failure.
- */
-int main( int argc, char const *argv[] ) {
+void wrapc_run( int argc, char const *argv[] ) {
+  profile_init();
+  startup_stats_init();
   wait_for_debugger_attach( "WRAPC_DEBUG" );
   init( argc, argv );
-  if ( opt_align_column > 0 ) {
-    align_eol_comments( CURR );
+  if ( opt_align_column > 0 || opt_align_block ) {
+    align_eol_comments( CURR_BUF );
+  } else if ( opt_all_comments ) {
+    wrap_all_comments();
   } else {
     read_prototype();
+#ifndef DEBUG_RSWW
+    is_ipc_oob = !is_affirmative( getenv( "WRAPC_EXEC_WRAP" ) );
+#endif /* DEBUG_RSWW */
     PIPE( pipes[ TO_WRAP ] );
     PIPE( pipes[ FROM_WRAP ] );
-    fork_exec_wrap( read_source_write_wrap() );
+    PIPE( pipes[ TO_WRAP_IPC ] );
+    PIPE( pipes[ FROM_WRAP_IPC ] );
+    pipe_resize( pipes[ TO_WRAP ] );
+    pipe_resize( pipes[ FROM_WRAP ] );
+    if ( opt_stats ) {
+      PIPE( stats_pipe );
+      stats_start = now_secs();
+    }
+    rsww_pid = read_source_write_wrap();
+    fork_wrap( rsww_pid );
+    ATEXIT( &kill_child_processes );
+    profile_role( "write" );
     read_wrap_write_stdout();
     wait_for_child_processes();
   }
@@ -298,84 +485,229 @@ int main( int argc, char const *argv[] ) {
 
 ////////// IPC functions //////////////////////////////////////////////////////
 
+#ifndef DEBUG_RSWW
 /**
- * Forks (becomming child 2) and execs into **wrap**(1).
+ * Spawns **wrap**(1) as child 2 passing it the options it needs.  This is done
+ * only if the `WRAPC_EXEC_WRAP` environment variable is affirmative; otherwise
+ * child 2 runs the **wrap**(1) engine linked into **wrapc**(1) directly.
+ *
+ * @remarks If available, **posix_spawnp**(3) is used so that, unlike
+ * **fork**(2), the parent's address space isn't copied only to be replaced by
+ * the exec that immediately follows.
  *
  * @param read_source_write_wrap_pid The process ID of read_source_write_wrap()
  * (in case we need to kill it).
+ *
+ * @sa fork_wrap()
  */
-static void fork_exec_wrap( pid_t read_source_write_wrap_pid ) {
-#ifdef DEBUG_RSWW
-  (void)ARG_BUF_SIZE;
-  (void)pipes;
-  (void)read_source_write_wrap_pid;
-#else
-  pid_t const pid = fork();
-  if ( unlikely( pid == -1 ) ) {        // we failed, so kill the first child
-    kill( read_source_write_wrap_pid, SIGTERM );
-    perror_exit( EX_OSERR );
-  }
-  if ( pid != 0 )                       // parent process
-    return;
-
+static void spawn_wrap( pid_t read_source_write_wrap_pid ) {
   typedef char arg_buf_t[ ARG_BUF_SIZE ];
-  typedef char path_buf_t[ PATH_MAX ];
 
-  arg_buf_t   arg_opt_alias;
-  arg_buf_t   arg_opt_block_regex;
-  arg_buf_t   arg_opt_conf_file;
   arg_buf_t   arg_opt_eol;
   arg_buf_t   arg_opt_eos_spaces;
-  path_buf_t  arg_opt_fin_name;
+  arg_buf_t   arg_opt_hang_spaces;
+  arg_buf_t   arg_opt_hang_tabs;
+  arg_buf_t   arg_opt_indt_spaces;
+  arg_buf_t   arg_opt_indt_tabs;
+  arg_buf_t   arg_opt_lead_spaces;
+  arg_buf_t   arg_opt_lead_tabs;
   arg_buf_t   arg_opt_line_width;
-  arg_buf_t   arg_opt_para_delims;
+  arg_buf_t   arg_opt_mirror_spaces;
+  arg_buf_t   arg_opt_mirror_tabs;
+  arg_buf_t   arg_opt_optimal;
   arg_buf_t   arg_opt_tab_spaces;
 
   size_t argc = 0;
-  char *argv[17];                       // must be +1 of greatest arg below
+  char *argv[42];                       // must be +1 of most args below
 
 #define ARG_CHECK                 assert( argc < ARRAY_SIZE( argv ) )
 #define ARG_SET(ARG)              BLOCK( ARG_CHECK; argv[ argc++ ] = (ARG); )
-#define ARG_DUP(FMT)              ARG_SET( check_strdup( FMT ) )
+#define ARG_DUP(FMT)              ARG_SET( CONST_CAST( char*, FMT ) )
 #define ARG_END                   ARG_SET( NULL )
 
 #define ARG_FMT(ARG,FMT) BLOCK( \
   snprintf( arg_##ARG, sizeof arg_##ARG, (FMT), (ARG) ); ARG_SET( arg_##ARG ); )
 
+#define ARG_STR(ARG,OPT) \
+  BLOCK( ARG_DUP( OPT ); ARG_SET( CONST_CAST( char*, (ARG) ) ); )
+
 // These intentionally do NOT use BLOCK().
 #define IF_ARG_DUP(ARG,FMT)       if ( ARG ) ARG_DUP( FMT )
 #define IF_ARG_FMT(ARG,FMT)       if ( ARG ) ARG_FMT( ARG, FMT )
+#define IF_ARG_STR(ARG,OPT)       if ( ARG ) ARG_STR( ARG, OPT )
 
   // Quoting string arguments is unnecessary since no shell is involved.
 
+  //
+  // The configuration file (if any) has already been read, the alias (if any)
+  // applied, and the file name (if any) matched against its patterns, so wrap
+  // is given the resulting options and told not to read the file again.
+  // String arguments are given separately so they're never truncated.
+  //
+  // Options that may not be given with --markdown or --prototype on a command-
+  // line are omitted with them.
+  //
   /*  0 */    ARG_DUP(                  PACKAGE );
-  /*  1 */ IF_ARG_FMT( opt_alias      , "-" SOPT(ALIAS)       "%s"  );
-  /*  2 */ IF_ARG_FMT( opt_block_regex, "-" SOPT(BLOCK_REGEX) "%s"  );
-  /*  3 */ IF_ARG_FMT( opt_conf_file  , "-" SOPT(CONFIG)      "%s"  );
-  /*  4 */ IF_ARG_DUP( opt_no_conf    , "-" SOPT(NO_CONFIG)         );
-  /*  5 */ IF_ARG_DUP( opt_eos_delimit, "-" SOPT(EOS_DELIMIT)       );
-  /*  6 */ IF_ARG_FMT( opt_eos_spaces , "-" SOPT(EOS_SPACES)  "%zu" );
-  /*  7 */ IF_ARG_FMT( opt_fin_name   , "-" SOPT(FILE_NAME)   "%s"  );
-  /*  8 */    ARG_FMT( opt_eol        , "-" SOPT(EOL)         "%c"  );
-  /*  9 */ IF_ARG_FMT( opt_para_delims, "-" SOPT(PARA_CHARS)  "%s"  );
-  /* 10 */ IF_ARG_DUP( opt_markdown   , "-" SOPT(MARKDOWN)          );
-         else ARG_FMT( opt_tab_spaces , "-" SOPT(TAB_SPACES)  "%zu" );
-  /* 11 */ IF_ARG_DUP( opt_title_line , "-" SOPT(TITLE_LINE)        );
-  /* 12 */    ARG_FMT( opt_line_width , "-" SOPT(WIDTH)       "%zu" );
-  /* 13 */ IF_ARG_DUP( opt_doxygen    , "-" SOPT(DOXYGEN)           );
-  /* 14 */ IF_ARG_DUP( opt_no_hyphen  , "-" SOPT(NO_HYPHEN)         );
-  /* 15 */    ARG_DUP(                  "-" SOPT(ENABLE_IPC)        );
-  /* 16 */    ARG_END;
+  /*  1 */    ARG_DUP(                  "-" SOPT(NO_CONFIG)         );
+  /*  2 */ IF_ARG_STR( opt_block_regex, "-" SOPT(BLOCK_REGEX)       );
+  /*  4 */ IF_ARG_DUP( opt_eos_delimit, "-" SOPT(EOS_DELIMIT)       );
+  /*  5 */ IF_ARG_FMT( opt_eos_spaces , "-" SOPT(EOS_SPACES)  "%zu" );
+  /*  6 */    ARG_FMT( opt_eol        , "-" SOPT(EOL)         "%c"  );
+  /*  7 */ IF_ARG_STR( opt_para_delims, "-" SOPT(PARA_CHARS)        );
+  /*  9 */    ARG_FMT( opt_line_width , "-" SOPT(WIDTH)       "%zu" );
+  /* 10 */ IF_ARG_DUP( opt_doxygen    , "-" SOPT(DOXYGEN)           );
+  /* 11 */ IF_ARG_DUP( opt_no_hyphen  , "-" SOPT(NO_HYPHEN)         );
+  /* 12 */ IF_ARG_DUP( opt_unicode_breaks, "-" SOPT(UNICODE_BREAKS) );
+  /* 13 */ IF_ARG_STR( opt_hyphenate  , "-" SOPT(HYPHENATE)         );
+  /* 15 */ IF_ARG_STR( opt_no_break   , "-" SOPT(NO_BREAK)          );
+  /* 17 */ IF_ARG_STR( opt_abbreviations, "-" SOPT(ABBREVIATIONS) );
+  /* 19 */ IF_ARG_DUP( opt_markdown_tables, "-" SOPT(MARKDOWN_TABLES) );
+  /* 20 */ IF_ARG_DUP( opt_prototype  , "-" SOPT(PROTOTYPE)         );
+  /* 21 */ if ( opt_markup != MARKUP_NONE && !opt_doxygen && !opt_markdown &&
+                !opt_prototype && !opt_title_line )
+              ARG_DUP( opt_markup == MARKUP_RST  ? "-" SOPT(MARKUP) "rst"  :
+                       opt_markup == MARKUP_HTML ? "-" SOPT(MARKUP) "html" :
+                       opt_markup == MARKUP_ROFF ? "-" SOPT(MARKUP) "roff" :
+                                                   "-" SOPT(MARKUP) "asciidoc" );
+  /* 22 */ if ( opt_email_quotes && !opt_doxygen && !opt_markdown &&
+                opt_markup == MARKUP_NONE && !opt_prototype )
+              ARG_DUP(                  "-" SOPT(EMAIL_QUOTES)      );
+  /* 23 */ if ( opt_newlines_delimit == 1 )
+              ARG_DUP(                  "-" SOPT(ALL_NEWLINES_DELIMIT) );
+         else if ( opt_newlines_delimit == SIZE_MAX )
+              ARG_DUP(                  "-" SOPT(NO_NEWLINES_DELIMIT) );
+  if ( opt_markdown ) {
+    /* 24 */  ARG_DUP(                  "-" SOPT(MARKDOWN)          );
+  } else {
+    /* 24 */  ARG_FMT( opt_tab_spaces , "-" SOPT(TAB_SPACES)  "%zu" );
+    /* 25 */ IF_ARG_DUP( opt_justify  , "-" SOPT(JUSTIFY)           );
+    /* 26 */ IF_ARG_FMT( opt_optimal  , "-" SOPT(OPTIMAL)     "%zu" );
+    /* 27 */ IF_ARG_DUP( opt_title_line, "-" SOPT(TITLE_LINE)       );
+  }
+  if ( !opt_email_quotes && !opt_markdown && opt_markup == MARKUP_NONE &&
+       !opt_prototype ) {
+    /* 28 */ IF_ARG_DUP( opt_lead_dot_ignore, "-" SOPT(DOT_IGNORE)  );
+    /* 29 */ IF_ARG_FMT( opt_hang_spaces, "-" SOPT(HANG_SPACES)   "%zu" );
+    /* 30 */ IF_ARG_FMT( opt_hang_tabs  , "-" SOPT(HANG_TABS)     "%zu" );
+    /* 31 */ IF_ARG_FMT( opt_indt_spaces, "-" SOPT(INDENT_SPACES) "%zu" );
+    /* 32 */ IF_ARG_FMT( opt_indt_tabs  , "-" SOPT(INDENT_TABS)   "%zu" );
+    /* 33 */ IF_ARG_FMT( opt_lead_spaces, "-" SOPT(LEAD_SPACES)   "%zu" );
+    /* 34 */ IF_ARG_STR( opt_lead_string, "-" SOPT(LEAD_STRING)         );
+    /* 36 */ IF_ARG_FMT( opt_lead_tabs  , "-" SOPT(LEAD_TABS)     "%zu" );
+    /* 37 */ IF_ARG_FMT( opt_mirror_spaces, "-" SOPT(MIRROR_SPACES) "%zu" );
+    /* 38 */ IF_ARG_FMT( opt_mirror_tabs, "-" SOPT(MIRROR_TABS)   "%zu" );
+    /* 39 */ IF_ARG_DUP( opt_lead_ws_delimit, "-" SOPT(WHITESPACE_DELIMIT) );
+  }
+  /* 40 */    ARG_DUP(                  "-" SOPT(ENABLE_IPC)        );
+  /* 41 */    ARG_END;
 
+#if HAVE_POSIX_SPAWNP && HAVE_SPAWN_H
   //
   // Read from pipes[TO_WRAP] (read_source_write_wrap() in child 1) and write
-  // to pipes[FROM_WRAP] (read_wrap_write_stdout() in parent); exec into
-  // wrap(1).
+  // to pipes[FROM_WRAP] (read_wrap_write_stdout() in parent).
   //
+  posix_spawn_file_actions_t actions;
+  int err = posix_spawn_file_actions_init( &actions );
+  if ( err == 0 )
+    err = posix_spawn_file_actions_adddup2(
+      &actions, pipes[ TO_WRAP ][ STDIN_FILENO ], STDIN_FILENO
+    );
+  if ( err == 0 )
+    err = posix_spawn_file_actions_adddup2(
+      &actions, pipes[ FROM_WRAP ][ STDOUT_FILENO ], STDOUT_FILENO
+    );
+  for ( size_t i = 0; err == 0 && i < ARRAY_SIZE( pipes ); ++i ) {
+    err = posix_spawn_file_actions_addclose( &actions, pipes[i][0] );
+    if ( err == 0 )
+      err = posix_spawn_file_actions_addclose( &actions, pipes[i][1] );
+  } // for
+
+  pid_t pid;
+  if ( err == 0 )
+    err = posix_spawnp( &pid, PACKAGE, &actions, NULL, argv, environ );
+  posix_spawn_file_actions_destroy( &actions );
+  if ( unlikely( err != 0 ) ) {         // we failed, so kill the first child
+    kill( read_source_write_wrap_pid, SIGTERM );
+    fatal_error( EX_OSERR, "can't spawn %s: %s\n", PACKAGE, strerror( err ) );
+  }
+  wrap_pid = pid;
+#else
+  pid_t const pid = fork();
+  if ( unlikely( pid == -1 ) ) {        // we failed, so kill the first child
+    kill( read_source_write_wrap_pid, SIGTERM );
+    perror_exit( EX_OSERR );
+  }
+  if ( pid != 0 ) {                     // parent process
+    wrap_pid = pid;
+    return;
+  }
+
   REDIRECT( STDIN_FILENO, TO_WRAP );
   REDIRECT( STDOUT_FILENO, FROM_WRAP );
+  close_pipe( pipes[ TO_WRAP_IPC ] );
+  close_pipe( pipes[ FROM_WRAP_IPC ] );
   execvp( PACKAGE, argv );              // should not return
   perror_exit( EX_OSERR );
+#endif /* HAVE_POSIX_SPAWNP && HAVE_SPAWN_H */
+}
+#endif /* DEBUG_RSWW */
+
+/**
+ * Forks (becomming child 2) and runs the **wrap**(1) engine, or, for in-band
+ * IPC, spawns **wrap**(1) itself instead.
+ *
+ * @param read_source_write_wrap_pid The process ID of read_source_write_wrap()
+ * (in case we need to kill it).
+ *
+ * @sa spawn_wrap()
+ */
+static void fork_wrap( pid_t read_source_write_wrap_pid ) {
+#ifdef DEBUG_RSWW
+  (void)ARG_BUF_SIZE;
+  (void)pipes;
+  (void)read_source_write_wrap_pid;
+#else
+  if ( !is_ipc_oob ) {
+    spawn_wrap( read_source_write_wrap_pid );
+    return;
+  }
+
+  pid_t const pid = fork();
+  if ( unlikely( pid == -1 ) ) {        // we failed, so kill the first child
+    kill( read_source_write_wrap_pid, SIGTERM );
+    perror_exit( EX_OSERR );
+  }
+  if ( pid != 0 ) {                     // parent process
+    wrap_pid = pid;
+    return;
+  }
+
+  //
+  // Read from pipes[TO_WRAP] (read_source_write_wrap() in child 1) and write
+  // to pipes[FROM_WRAP] (read_wrap_write_stdout() in parent).
+  //
+  REDIRECT( STDIN_FILENO, TO_WRAP );
+  REDIRECT( STDOUT_FILENO, FROM_WRAP );
+  close( pipes[ TO_WRAP_IPC ][ STDOUT_FILENO ] );
+  close( pipes[ FROM_WRAP_IPC ][ STDIN_FILENO ] );
+
+  profile_role( "wrap" );
+  wait_for_debugger_attach( "WRAPC_DEBUG_WRAP" );
+  //
+  // The options (including those from the configuration file) have already
+  // been set by init() and adjusted for the comment, so the engine can just
+  // use them as-is with neither an exec nor parsing them again.  However,
+  // what was read from the source is still buffered for what's now the pipe.
+  //
+  // Since IPC messages are sent out-of-band, opt_data_link_esc is left false
+  // so the text is never checked for them.
+  //
+  reader_forget( stdin );
+  wrap_init();
+  wrap_run_wipc(
+    pipes[ TO_WRAP_IPC ][ STDIN_FILENO ],
+    pipes[ FROM_WRAP_IPC ][ STDOUT_FILENO ]
+  );
 #endif /* DEBUG_RSWW */
 }
 
@@ -395,11 +727,14 @@ static pid_t read_source_write_wrap( void ) {
   PERROR_EXIT_IF( pid == -1, EX_OSERR );
   if ( pid != 0 )                       // parent process
     return pid;
+  profile_role( "read" );
   //
   // We don't use these here.
   //
   close_pipe( pipes[ FROM_WRAP ] );
+  close_pipe( pipes[ FROM_WRAP_IPC ] );
   close( pipes[ TO_WRAP ][ STDIN_FILENO ] );
+  close( pipes[ TO_WRAP_IPC ][ STDIN_FILENO ] );
   //
   // Read from stdin and write to pipes[TO_WRAP] (wrap).
   //
@@ -409,18 +744,38 @@ static pid_t read_source_write_wrap( void ) {
       "child can't open pipe for writing: %s\n", STRERROR()
     );
   }
+  PERROR_EXIT_IF(
+    setvbuf( fwrap, NULL, _IOFBF, PIPE_STDIO_BUF_SIZE ) != 0, EX_OSERR
+  );
   wait_for_debugger_attach( "WRAPC_DEBUG_RSRW" );
 #else
   FILE *const fwrap = stdout;
 #endif /* DEBUG_RSWW */
 
+  writer_t wout;
+  wipc_out_t wipc_out;
+  if ( is_ipc_oob ) {
+    wipc_out_init(
+      &wipc_out, &wout, pipes[ TO_WRAP ][ STDOUT_FILENO ],
+      pipes[ TO_WRAP_IPC ][ STDOUT_FILENO ]
+    );
+  } else {
+    writer_init( &wout, fwrap );
+  }
+
   if ( NEXT[0] != '\0' ) {
     //
     // For block comments, write the first line directly to the output.
     //
-    adjust_comment_width( CURR );
+    adjust_comment_width( CURR_BUF );
     PUTS( CURR );
-    swap_line_bufs();
+    //
+    // The parent writes the wrapped lines to stdout directly, so flush now
+    // lest this line be written only when we exit, i.e., possibly after some
+    // of those lines.
+    //
+    PERROR_EXIT_IF( fflush( stdout ) != 0, EX_IOERR );
+    next_line();
   }
 
   //
@@ -431,104 +786,31 @@ static pid_t read_source_write_wrap( void ) {
   //
   bool const proto_is_comment = is_line_comment( CURR ) != NULL;
 
-  for ( ; CURR[0] != '\0'; swap_line_bufs() ) {
-    //
-    // In order to know when a comment ends, we have to peek at the next line.
-    //
-    PJL_DISCARD_RV( check_readline( NEXT, stdin ) );
-
-    if ( proto_is_comment && is_line_comment( CURR ) == NULL ) {
-      //
-      // This handles cases like:
-      //
-      //      proto     ->  # This is a comment.
-      //      curr_buf  ->  not_a_comment();
-      //
-      goto verbatim;
-    }
-
-    if ( !(proto_is_comment && is_line_comment( NEXT ) != NULL) &&
-         is_block_comment( CURR ) ) {
-      //
-      // This handles cases like:
-      //
-      //                    /*
-      //      proto     ->  This is a comment.
-      //      curr_buf  ->  */
-      //
-      // or:
-      //                    /*
-      //                     * This is a comment.
-      //      curr_buf  ->   */
-      //      next_buf  ->  [empty]
-      //
-      adjust_comment_width( CURR );
-      goto verbatim;
-    }
-
-    size_t curr_prefix_len = prefix_span( CURR );
-    if ( opt_doxygen || opt_markdown ) {
-      if ( curr_prefix_len > prefix_len ) {
-        //
-        // We can't strip all whitespace after the comment delimiter characters
-        // because:
-        //
-        // 1. Doxygen needs the whitespace when doing preformatted text.
-        // 2. Markdown relies on indentation for state changes.
-        //
-        // Hence we strip only the length of the initial prototype -- but only
-        // if it's less.
-        //
-        curr_prefix_len = prefix_len;
-      }
-      else if ( curr_prefix_len < prefix_len &&
-                !is_eol( CURR[ curr_prefix_len ] ) ) {
-        //
-        // The leading comment delimiter characters and/or whitespace length
-        // has decreased.  This can happen in a case like:
-        //
-        //      *  + This is a list item.
-        //      *
-        //      * Not part of the list item.
-        //
-        // where the list item was indented 2 spaces after the + but the
-        // regular text was indented only 1 space.  If this check were not
-        // done, then the "Not" text would end up also being indented 2 spaces.
-        //
-        // We therefore have to increase opt_line_width by the delta and also
-        // notify both wrap(1) and the other wrapc(1) processes of the changes.
-        //
-        opt_line_width += prefix_len - curr_prefix_len;
-        set_prefix( CURR, curr_prefix_len );
-        WIPC_SENDF(
-          fwrap, WIPC_CODE_NEW_LEADER, "%zu" WIPC_PARAM_SEP "%s\n",
-          opt_line_width, prefix_buf
-        );
-      }
-    }
-
-    // Skip over the prefix and chop off the suffix.
-    char *const line = skip_n( CURR, curr_prefix_len );
-    if ( suffix_buf[0] != '\0' )
-      chop_suffix( line );
-
-    if ( opt_doxygen && wrap_dox_line( line, fwrap ) )
-      continue;
-
-    FPUTS( line, fwrap );
-  } // for
-  exit( EX_OK );
+  if ( read_comment( &wout, is_ipc_oob ? &wipc_out : NULL,
+                     proto_is_comment ) == COMMENT_END_EOF ) {
+    writer_cleanup( &wout );
+    stats[ STAGE_READ ].bytes_out = wout.written;
+    stats_send();
+    exit( EX_OK );
+  }
 
-verbatim:
   //
   // We've reached the end of the comment: signal wrap(1) that we're now
   // ending wrapping, write any remaining lines, then just copy text through
   // verbatim.
   //
-  WIPC_SEND( fwrap, WIPC_CODE_WRAP_END );
-  FPUTS( CURR, fwrap );
-  FPUTS( NEXT, fwrap );
-  fcopy( stdin, fwrap );
+  if ( is_ipc_oob )
+    wipc_out_send( &wipc_out, WIPC_CODE_WRAP_END, 0, /*leader=*/NULL );
+  else
+    WIPC_SEND( &wout, WIPC_CODE_WRAP_END );
+  ++stats[ STAGE_READ ].ipc;
+  writer_write( &wout, CURR, CURR_BUF->len );
+  writer_write( &wout, NEXT, NEXT_BUF->len );
+  writer_cleanup( &wout );
+  size_t const copied = fcopy( stdin, fwrap );
+  stats[ STAGE_READ ].bytes_in += copied;
+  stats[ STAGE_READ ].bytes_out = wout.written + copied;
+  stats_send();
   exit( EX_OK );
 }
 
@@ -545,7 +827,9 @@ static void read_wrap_write_stdout( void ) {
   // We don't use these here.
   //
   close_pipe( pipes[ TO_WRAP ] );
+  close_pipe( pipes[ TO_WRAP_IPC ] );
   close( pipes[ FROM_WRAP ][ STDOUT_FILENO ] );
+  close( pipes[ FROM_WRAP_IPC ][ STDOUT_FILENO ] );
   //
   // Read from pipes[FROM_WRAP] (wrap) and write to stdout.
   //
@@ -572,81 +856,71 @@ static void read_wrap_write_stdout( void ) {
   // above, the second line would become "# " containing a trailing whitespace.
   //
   line_buf_t proto_tws;                 // prototype trailing whitespace, if any
-  split_tws( prefix_buf, prefix_len, proto_tws );
+  line_buf_init( &proto_tws );
+  split_prefix_tws( &proto_tws );
 
   line_buf_t line_buf;
+  line_buf_init( &line_buf );
+  writer_t wout;
+  writer_init( &wout, stdout );
+  writer_limit_lines( &wout, opt_max_lines );
+  if ( opt_expand_tabs )
+    writer_expand_tabs( &wout );
+  wipc_in_t wipc_in;
+  wipc_in_init( &wipc_in, pipes[ FROM_WRAP_IPC ][ STDIN_FILENO ] );
+  uint64_t offset = 0;                  // of the line about to be read
+  size_t copied = 0;                    // by fcopy() after the comment
 
   for (;;) {
-    size_t line_size = sizeof line_buf;
-    if ( unlikely( fgetsz( line_buf, &line_size, fwrap ) == NULL ) )
-      break;
-    line_size = chop_eol( line_buf, line_size );
-    char *line = line_buf;
-
-    if ( line[0] == WIPC_CODE_HELLO ) {
-      switch ( STATIC_CAST( wipc_code_t, line[1] ) ) {
-        case WIPC_CODE_HELLO:           // shouldn't happen
-          break;
-
+    if ( is_ipc_oob && wipc_in_due( &wipc_in, offset ) ) {
+      ++stats[ STAGE_WRITE ].ipc;
+      PROBE1( ipc_recv, wipc_in.frame.code );
+      switch ( STATIC_CAST( wipc_code_t, wipc_in.frame.code ) ) {
         case WIPC_CODE_NEW_LEADER:
-          NO_OP;
-          //
-          // We've been told by child 1 (read_source_write_wrap(), via child 2,
-          // wrap) that the leading comment delimiter characters and/or
-          // whitespace has changed: adjust opt_line_width and prefix_buf.
-          //
-          char *sep;
-          opt_line_width = strtoul( line + 2, &sep, 10 );
-          prefix_len = strcpy_len( prefix_buf, sep + 1 );
-          split_tws( prefix_buf, prefix_len, proto_tws );
-          continue;
-
+          set_leader( wipc_in.frame.line_width, wipc_in.leader.str,
+                      &proto_tws );
+          break;
+        case WIPC_CODE_WRAP_END:
+          goto wrap_end;
         case WIPC_CODE_DELIMIT_PARAGRAPH:
+        case WIPC_CODE_HELLO:           // shouldn't happen
         case WIPC_CODE_PREFORMATTED_BEGIN:
         case WIPC_CODE_PREFORMATTED_END:
-          //
-          // We only have to "eat" these and do nothing else.
-          //
-          continue;
-
-        case WIPC_CODE_WRAP_END:
-          //
-          // We've been told by child 1 (read_source_write_wrap(), via child 2,
-          // wrap) that we've reached the end of the comment: dump any
-          // remaining buffer and pass text through verbatim.
-          //
-          fcopy( fwrap, stdout );
-          goto done;
+        case WIPC_CODE_SYNC:            // shouldn't happen
+          break;
       } // switch
-
-      //
-      // We got a HELLO followed by an unknown WIPC code: skip over the HELLO
-      // and format the remaining buffer.
-      //
-      ++line;
-      --line_size;
-    }
-
-    if ( suffix_buf[0] != '\0' ) {
-      //
-      // Pad the width with spaces in order to append the terminating comment
-      // character(s) back.
-      //
-      while ( line_size < opt_line_width )
-        line[ line_size++ ] = ' ';
-      line[ line_size ] = '\0';
+      wipc_in_consume( &wipc_in );
+      continue;
     }
 
-    // don't emit proto_tws for blank lines
-    PRINTF(
-      "%s%s%s%s%s",
-      prefix_buf, is_blank_line( line ) ? "" : proto_tws, line, suffix_buf,
-      eol()
-    );
+    size_t const line_size = check_readline( &line_buf, fwrap, SIZE_MAX );
+    if ( unlikely( line_size == 0 ) )
+      break;
+    offset += line_size;
+    ++stats[ STAGE_WRITE ].lines;
+    PROBE( line_emit );
+    if ( !put_wrapped_line( &wout, &line_buf, line_size, &proto_tws ) )
+      goto wrap_end;
   } // for
+  goto done;
+
+wrap_end:
+  //
+  // We've been told by child 1 (read_source_write_wrap(), via child 2, wrap)
+  // that we've reached the end of the comment: dump any remaining buffer and
+  // pass text through verbatim.
+  //
+  copied = writer_copy( &wout, fwrap );
 
 done:
-  FERROR( fwrap );
+  writer_cleanup( &wout );
+  stats[ STAGE_WRITE ].bytes_in = offset + copied;
+  stats[ STAGE_WRITE ].bytes_out = wout.written;
+  if ( wout.lines_max == 0 )            // else copied via wout already
+    stats[ STAGE_WRITE ].bytes_out += copied;
+  wipc_in_cleanup( &wipc_in );
+  line_buf_cleanup( &line_buf );
+  line_buf_cleanup( &proto_tws );
 #endif /* DEBUG_RSWW */
 }
 
@@ -658,10 +932,13 @@ done:
  *
  * @param s The newline- and null-terminated string to adjust.
  */
-static void adjust_comment_width( char *s ) {
-  assert( s != NULL );
-  size_t const delim_len = suffix_buf[0] ? suffix_len : 1 + !!close_cc[1];
+static void adjust_comment_width( line_buf_t *buf ) {
+  assert( buf != NULL );
+  size_t const delim_len =
+    suffix_buf.str[0] ? suffix_len : close_cc_len > 1 ? close_cc_len : 1;
   size_t const width = opt_line_width + prefix_len + suffix_len;
+  line_buf_reserve( buf, width + 2/*\r\n*/ );
+  char *const s = buf->str;
   size_t s_len = strlen_no_eol( s );
 
   if ( s_len > width ) {
@@ -671,12 +948,12 @@ static void adjust_comment_width( char *s ) {
     //
     memmove(
       s + width - delim_len,
-      suffix_buf[0] ? suffix_buf : s + s_len - delim_len,
+      suffix_buf.str[0] ? suffix_buf.str : s + s_len - delim_len,
       delim_len
     );
-    strcpy( s + width, eol() );
+    buf->len = width + strcpy_len( s + width, eol() );
   }
-  else if ( suffix_buf[0] != '\0' && s_len < width ) {
+  else if ( suffix_buf.str[0] != '\0' && s_len < width ) {
     //
     // If we're doing terminated comments, lengthen the comment line by
     // "inserting" a multiple of the first comment delimiter character.
@@ -692,13 +969,16 @@ static void adjust_comment_width( char *s ) {
         s[ s_len - 1 ] = close_cc[0];
         break;
       case DELIM_DOUBLE:
-        for ( --s_len; s_len < width; ++s_len )
+        for ( s_len -= close_cc_len - 1; s_len < width; ++s_len )
           s[ s_len ] = close_cc[0];
-        s[ s_len - 1 ] = close_cc[1];
+        memcpy(
+          s + s_len - (close_cc_len - 1), close_cc + 1, close_cc_len - 1
+        );
         break;
     } // switch
-    strcpy( s + width, eol() );
+    buf->len = width + strcpy_len( s + width, eol() );
   }
+  line_descs_invalidate();
 }
 
 /**
@@ -708,10 +988,10 @@ static void adjust_comment_width( char *s ) {
  */
 static void chop_suffix( char *s ) {
   assert( s != NULL );
-  assert( suffix_buf[0] != '\0' );
+  assert( suffix_buf.str[0] != '\0' );
   char *cc = s;
 
-  for ( ; (cc = strchr( cc, suffix_buf[0] )) != NULL; ++cc ) {
+  for ( ; (cc = strchr( cc, suffix_buf.str[0] )) != NULL; ++cc ) {
     switch ( delim ) {
       case DELIM_EOL:
         NO_OP;
@@ -732,7 +1012,7 @@ static void chop_suffix( char *s ) {
         // any, are only whitespace.  If not, then it's not the last terminator
         // character on the line.
         //
-        char *const after_cc = skip_c( cc, suffix_buf[0] );
+        char *const after_cc = skip_c( cc, suffix_buf.str[0] );
         if ( after_cc[ strspn( after_cc, WS_STRN ) ] == '\0' )
           goto done;
         cc = after_cc - 1;
@@ -740,15 +1020,17 @@ static void chop_suffix( char *s ) {
       case DELIM_SINGLE:
         goto done;
       case DELIM_DOUBLE:
-        if ( strncmp( cc, suffix_buf, suffix_len ) == 0 )
+        if ( strncmp( cc, suffix_buf.str, suffix_len ) == 0 )
           goto done;
         break;
     } // switch
   } // for
 
 done:
-  if ( cc != NULL )
+  if ( cc != NULL ) {
     *cc = '\0';
+    line_descs_invalidate();
+  }
 }
 
 /**
@@ -761,16 +1043,55 @@ done:
 static void init( int argc, char const *argv[] ) {
   ASSERT_RUN_ONCE();
   ATEXIT( common_cleanup );
+  ATEXIT( wrapc_cleanup );
 
   options_init( argc, argv, usage );
+  startup_charge( STARTUP_OPTIONS );
+  profile_mark( PROFILE_CONF );
+  if ( opt_in_place )
+    opt_all_comments = true;
+  if ( opt_all_comments ) {
+    //
+    // The leader may change within a comment: since the engine is given the
+    // text via wrap_feed() and hands its output back via wrapped_write(), IPC
+    // messages are sent in-band through both.
+    //
+    opt_data_link_esc = true;
+    //
+    // For --in-place, this returns only in a child for each file after its
+    // alias (hence its comment delimiters) has been applied, so it must be
+    // called before they're compiled.
+    //
+    wrap_init();
+  }
+  //
+  // Unless comment delimiters were given either explicitly or by an alias
+  // (including that of a configuration file pattern matching the file name),
+  // use those of the file's language, if known.
+  //
+  lang_t const *const lang = lang_find( opt_fin_name );
+  if ( lang->comment_chars != NULL && !opt_given( COPT(COMMENT_CHARS) ) )
+    opt_comment_chars = lang->comment_chars;
+  if ( !lang->is_doxygen )
+    opt_doxygen = false;
   opt_comment_chars = cc_map_compile( opt_comment_chars );
-
-  CURR = input_lines.dl_line[0];
-  NEXT = input_lines.dl_line[1];
-
-  size_t const size = check_readline( CURR, stdin );
+  startup_charge( STARTUP_INIT );
+
+  CURR_BUF = &input_lines.dl_line[0];
+  NEXT_BUF = &input_lines.dl_line[1];
+  CURR_DESC = &input_lines.dl_desc[0];
+  NEXT_DESC = &input_lines.dl_desc[1];
+  line_buf_init( CURR_BUF );
+  line_buf_init( NEXT_BUF );
+  line_buf_init( &prefix_buf );
+  line_buf_init( &suffix_buf );
+
+  size_t const size = check_readline( CURR_BUF, stdin, SIZE_MAX );
   if ( size == 0 )
     exit( EX_OK );
+  stats[ STAGE_READ ].bytes_in = size;
+  stats[ STAGE_READ ].lines = 1;
+  PROBE1( line_read, size );
 
   if ( opt_eol == EOL_INPUT && is_windows_eol( CURR, size ) ) {
     //
@@ -782,21 +1103,46 @@ static void init( int argc, char const *argv[] ) {
 
 /**
  * Checks whether the given string is the beginning of a block comment: starts
- * with a comment delimiter character and contains only non-alpha characters
- * thereafter.
+ * with a comment delimiter (or comment delimiter character) and contains only
+ * non-alpha characters thereafter.
  *
- * @param s The string to check.
+ * @param s The string to check.  It must be either \ref CURR or \ref NEXT.
  * @return Returns `true` only if \a s is the beginning of a block comment.
  */
 NODISCARD
 static bool is_block_comment( char const *s ) {
   assert( s != NULL );
-  if ( (s = is_line_comment( s )) != NULL ) {
-    for ( ++s; *s && *s != '\n' && !isalpha( *s ); ++s )
+  line_desc_t *const desc = line_desc( s );
+  if ( desc->cc_len == 0 )
+    return false;
+  if ( desc->is_block < 0 ) {
+    for ( s += desc->ws_len + desc->cc_len;
+          *s && *s != '\n' && !isalpha( *s ); ++s )
       /* empty */;
-    return *s == '\n';
+    desc->is_block = STATIC_CAST( int8_t, *s == '\n' );
   }
-  return false;
+  return desc->is_block;
+}
+
+/**
+ * Checks whether the given line is certainly code, i.e., not blank and its
+ * first non-whitespace character neither is a comment delimiter character nor
+ * starts a comment delimiter whatever comment delimiters are in use.
+ *
+ * @param line The line to check.  It need not be null-terminated.
+ * @param size The size of \a line.
+ * @return Returns `true` only if \a line is code.
+ *
+ * @sa put_code_lines()
+ */
+NODISCARD
+static bool is_code_line( char const *line, size_t size ) {
+  assert( line != NULL );
+  size_t ws_len = 0;
+  while ( ws_len < size && is_space( line[ ws_len ] ) )
+    ++ws_len;
+  return ws_len < size && !is_comment_char( line[ ws_len ] ) &&
+    !cc_map_is_first( line[ ws_len ] );
 }
 
 /**
@@ -880,9 +1226,22 @@ static char const* is_terminated_comment( char *s ) {
         } // while
         break;
 
-      case DELIM_DOUBLE:
+      case DELIM_DOUBLE: {
+        char const *const open = s;
+        size_t const n = close_cc_len - 1;
         while ( *++s != '\0' ) {
-          if ( cc == NULL ) {
+          if ( *s == close_cc[n] &&
+               STATIC_CAST( size_t, s - open ) >= open_cc_len - 1 + n &&
+               strncmp( s - n, close_cc, n ) == 0 ) {
+            //
+            // We've found the closing comment delimiter (that doesn't overlap
+            // the opening one by more than the latter's last character).
+            //
+            if ( cc == NULL )
+              cc = s - n;
+            tws = s + 1;
+          }
+          else if ( cc == NULL ) {
             if ( *s == close_cc[0] ) {
               //
               // We've found the first occurrence of the comment delimiter
@@ -890,41 +1249,422 @@ static char const* is_terminated_comment( char *s ) {
               //
               cc = s;
             }
-          } else if ( *s != close_cc[0] ) {
-            if ( *s == close_cc[1] && s[-1] == close_cc[0] ) {
-              tws = s + 1;
-            } else if ( !isspace( *s ) ) {
-              if ( tws != NULL )
-                return NULL;
-              cc = NULL;
-            }
+          }
+          else if ( *s != close_cc[0] && !isspace( *s ) ) {
+            if ( tws != NULL )
+              return NULL;
+            cc = NULL;
           }
         } // while
         break;
+      }
     } // switch
   }
 
-  if ( tws != NULL && cc != NULL )
+  if ( tws != NULL && cc != NULL ) {
     strcpy( tws, eol() );
+    line_descs_invalidate();
+  }
   return cc;
 }
 
+/**
+ * Kills the child processes that haven't been waited for, if any, e.g., upon
+ * exiting early because no more output is wanted so they don't continue to
+ * read and reformat the rest of the input.
+ *
+ * @sa wait_for_child_processes()
+ */
+static void kill_child_processes( void ) {
+  if ( rsww_pid > 0 )
+    PJL_DISCARD_RV( kill( rsww_pid, SIGTERM ) );
+  if ( wrap_pid > 0 )
+    PJL_DISCARD_RV( kill( wrap_pid, SIGTERM ) );
+}
+
+/**
+ * Gets the \ref line_desc of \a s, spanning its prefix only if it's changed
+ * since last spanned.
+ *
+ * @param s The string to get the \ref line_desc of.  It must be either \ref
+ * CURR or \ref NEXT.
+ * @return Returns said \ref line_desc.
+ */
+static line_desc_t* line_desc( char const *s ) {
+  assert( s == CURR || s == NEXT );
+  line_desc_t *const desc = s == CURR ? CURR_DESC : NEXT_DESC;
+  if ( desc->is_valid )
+    return desc;
+
+  size_t const ws_len = strspn( s, WS_ST );
+  size_t cc_len = 0;
+  size_t first_len = 0;
+  for ( s += ws_len;; ) {
+    size_t const len = cc_map_is_first( s[ cc_len ] ) ?
+      cc_map_match( s + cc_len, NULL ) : 0;
+    if ( len > 0 )
+      cc_len += len;
+    else if ( is_comment_char( s[ cc_len ] ) )
+      ++cc_len;
+    else
+      break;
+    if ( first_len == 0 )
+      first_len = cc_len;
+  } // for
+
+  *desc = (line_desc_t){
+    .ws_len = ws_len,
+    .cc_len = first_len,
+    .prefix_len = cc_len > 0 ?
+      ws_len + cc_len + strspn( s + cc_len, WS_ST ) : ws_len,
+    .is_block = -1,
+    .is_valid = true
+  };
+  return desc;
+}
+
+/**
+ * Invalidates the \ref line_desc of both \ref CURR and \ref NEXT.  This must
+ * be called whenever either line is altered or cc_map_restrict() is called.
+ */
+static void line_descs_invalidate( void ) {
+  CURR_DESC->is_valid = NEXT_DESC->is_valid = false;
+}
+
+/**
+ * Advances to the next line of input: the one peeked at via peek_line(), if
+ * any, or the one read now.
+ */
+static void next_line( void ) {
+  peek_line();
+  swap_line_bufs();
+  NEXT[0] = '\0';
+  NEXT_BUF->len = 0;
+  NEXT_DESC->is_valid = false;
+}
+
+/**
+ * Gets the current time of the monotonic clock.
+ *
+ * @return Returns said time in seconds.
+ */
+static double now_secs( void ) {
+  struct timespec ts;
+  PERROR_EXIT_IF( clock_gettime( CLOCK_MONOTONIC, &ts ) == -1, EX_OSERR );
+  return STATIC_CAST( double, ts.tv_sec ) +
+         STATIC_CAST( double, ts.tv_nsec ) / 1000000000.0;
+}
+
+/**
+ * Peeks at the next line of input, i.e., reads it into \ref NEXT_BUF, unless
+ * it's already been peeked at.
+ */
+static void peek_line( void ) {
+  if ( NEXT[0] != '\0' )
+    return;
+  NEXT_DESC->is_valid = false;
+  size_t const size = check_readline( NEXT_BUF, stdin, SIZE_MAX );
+  if ( size > 0 ) {
+    stats[ STAGE_READ ].bytes_in += size;
+    ++stats[ STAGE_READ ].lines;
+    PROBE1( line_read, size );
+  }
+}
+
+/**
+ * Sets the capacity of a pipe to the value of the `WRAPC_PIPE_SIZE`
+ * environment variable, if set, or #PIPE_SIZE_DEFAULT, if not.  A value of 0
+ * means to keep the system default.  If the capacity can't be set (e.g., the
+ * platform doesn't support it or the size exceeds the system maximum), it's
+ * silently left as-is.
+ *
+ * @param pipe The pipe to resize.
+ */
+static void pipe_resize( int pipe[const static 2] ) {
+#ifdef F_SETPIPE_SZ
+  char const *const env_size = getenv( "WRAPC_PIPE_SIZE" );
+  unsigned const size =
+    env_size != NULL ? check_atou( env_size ) : PIPE_SIZE_DEFAULT;
+  if ( size > 0 && size <= INT_MAX ) {
+    PJL_DISCARD_RV(
+      fcntl( pipe[ STDOUT_FILENO ], F_SETPIPE_SZ, STATIC_CAST( int, size ) )
+    );
+  }
+#else
+  (void)pipe;
+#endif /* F_SETPIPE_SZ */
+}
+
 /**
  * Spans the initial part of \a s for the prefix "prototype."  The prefix is
  * defined as \c ^{WS}*{CC}*{WS}* where \c WS is whitespace and \c CC are
- * comment delimiter characters.
+ * comment delimiters or comment delimiter characters.
  *
- * @param s The string to span.
+ * @param s The string to span.  It must be either \ref CURR or \ref NEXT.
  * @return Returns the length of the prototype.
  */
 NODISCARD
 static size_t prefix_span( char const *s ) {
   assert( s != NULL );
-  size_t ws_len = strspn( s, WS_ST );
-  size_t const cc_len = strspn( s += ws_len, opt_comment_chars );
-  if ( cc_len > 0 )
-    ws_len += strspn( s + cc_len, WS_ST );
-  return ws_len + cc_len;
+  return line_desc( s )->prefix_len;
+}
+
+/**
+ * Puts the current line, that must not be a comment, and every consecutive
+ * line after it that also isn't to \a wout verbatim, then advances to the
+ * first line that is (if any).
+ *
+ * @remarks Since most of the lines of a source file aren't comments, lines
+ * after the current one (unless one has been peeked at) are put straight from
+ * the reader's buffer: each is neither copied into a \ref line_buf nor
+ * scanned for its end again.
+ *
+ * @param wout The \ref writer to put the lines to.
+ */
+static void put_code_lines( writer_t *wout ) {
+  assert( wout != NULL );
+  writer_write( wout, CURR, CURR_BUF->len );
+  if ( NEXT[0] == '\0' ) {
+    bool is_bol = true;                 // at the beginning of a line?
+    for (;;) {
+      size_t size;
+      char const *const line = reader_getline( stdin, SIZE_MAX, &size );
+      if ( line == NULL )
+        break;
+      if ( is_bol ) {
+        size_t ws_len = 0;
+        while ( ws_len < size && is_space( line[ ws_len ] ) )
+          ++ws_len;
+        //
+        // Only if the first non-whitespace character (if any) is in this
+        // part of the line can it be known whether the line is a comment.
+        //
+        if ( ws_len == size && line[ size - 1 ] != '\n' ) {
+          reader_unget( stdin, size );
+          break;
+        }
+        if ( ws_len < size && (is_comment_char( line[ ws_len ] ) ||
+                               cc_map_is_first( line[ ws_len ] )) ) {
+          reader_unget( stdin, size );
+          break;
+        }
+      }
+      writer_write( wout, line, size );
+      is_bol = line[ size - 1 ] == '\n';
+    } // for
+    if ( !is_bol ) {
+      //
+      // The last line was put only in part: the rest of it is put as-is.
+      //
+      next_line();
+      writer_write( wout, CURR, CURR_BUF->len );
+    }
+  }
+  next_line();
+}
+
+/**
+ * Puts a line of the output of **wrap**(1) with the leading whitespace and
+ * comment delimiter characters, and the terminating ones, if any, put back;
+ * or, if it's an in-band IPC message, handles it instead.
+ *
+ * @param wout The \ref writer to put the line to.
+ * @param line_buf The \ref line_buf containing the line.  It's altered.
+ * @param line_size The size of the line including its end-of-line, if any.
+ * @param proto_tws The prototype trailing whitespace.
+ * @return Returns `false` only if the line is a #WIPC_CODE_WRAP_END message.
+ */
+NODISCARD
+static bool put_wrapped_line( writer_t *wout, line_buf_t *line_buf,
+                              size_t line_size, line_buf_t *proto_tws ) {
+  assert( wout != NULL );
+  assert( line_buf != NULL );
+  assert( proto_tws != NULL );
+
+  line_size = chop_eol( line_buf->str, line_size );
+  line_buf_reserve( line_buf, 1/*HELLO*/ + opt_line_width );
+  char *line = line_buf->str;
+
+  if ( !is_ipc_oob && line[0] == WIPC_CODE_HELLO ) {
+    ++stats[ STAGE_WRITE ].ipc;
+    PROBE1( ipc_recv, line[1] );
+    switch ( STATIC_CAST( wipc_code_t, line[1] ) ) {
+      case WIPC_CODE_HELLO:             // shouldn't happen
+      case WIPC_CODE_SYNC:              // shouldn't happen
+        break;
+
+      case WIPC_CODE_NEW_LEADER:
+        NO_OP;
+        char *sep;
+        size_t const line_width = strtoul( line + 2, &sep, 10 );
+        set_leader( line_width, sep + 1, proto_tws );
+        return true;
+
+      case WIPC_CODE_DELIMIT_PARAGRAPH:
+      case WIPC_CODE_PREFORMATTED_BEGIN:
+      case WIPC_CODE_PREFORMATTED_END:
+        //
+        // We only have to "eat" these and do nothing else.
+        //
+        return true;
+
+      case WIPC_CODE_WRAP_END:
+        return false;
+    } // switch
+
+    //
+    // We got a HELLO followed by an unknown WIPC code: skip over the HELLO
+    // and format the remaining buffer.
+    //
+    ++line;
+    --line_size;
+  }
+
+  //
+  // Every length is already known, so nothing needs to be scanned for either
+  // its end or a format string: each part is just copied into wout's buffer
+  // that's written only when full.
+  //
+  writer_write( wout, prefix_buf.str, prefix_len - prefix_tws_len );
+  if ( simd_ws_span( line, line_size ) < line_size )  // not for blank lines
+    writer_write( wout, proto_tws->str, prefix_tws_len );
+  writer_write( wout, line, line_size );
+  if ( suffix_buf.str[0] != '\0' ) {
+    //
+    // Pad the width with spaces in order to append the terminating comment
+    // character(s) back.
+    //
+    if ( line_size < opt_line_width ) {
+      memset( line + line_size, ' ', opt_line_width - line_size );
+      writer_write( wout, line + line_size, opt_line_width - line_size );
+    }
+    writer_write( wout, suffix_buf.str, suffix_len );
+  }
+  writer_write( wout, eol(), 1 + (opt_eol == EOL_WINDOWS) );
+  writer_eol( wout );
+  return true;
+}
+
+/**
+ * Reads the source text of the comment starting at the current line and
+ * writes it, with the leading whitespace and comment delimiter characters
+ * stripped from each line, to \a wrap.
+ *
+ * @param wrap The \ref writer to write the text to the **wrap**(1) engine.
+ * @param wipc_out The \ref wipc_out to send IPC messages out-of-band with or
+ * NULL to send them in-band via \a wrap.
+ * @param proto_is_comment If `false`, the current line is not a comment, so
+ * neither is any line required to be.
+ * @return Returns how the comment ended.  For #COMMENT_END_AT, the current
+ * line, the end of the comment, is to be passed through verbatim.
+ */
+NODISCARD
+static comment_end_t read_comment( writer_t *wrap, wipc_out_t *wipc_out,
+                                   bool proto_is_comment ) {
+  assert( wrap != NULL );
+
+  //
+  // The leader and line width as changed so far by the comment.  These are
+  // kept apart from prefix_len and opt_line_width that are for the output:
+  // wrap(1) still has to send some lines before the changes apply to them.
+  //
+  size_t leader_len = prefix_len;
+  size_t line_width = opt_line_width;
+
+  for ( ; CURR[0] != '\0'; next_line() ) {
+    //
+    // In order to know when a comment ends, we have to peek at the next line.
+    //
+    peek_line();
+
+    if ( proto_is_comment && is_line_comment( CURR ) == NULL ) {
+      //
+      // This handles cases like:
+      //
+      //      proto     ->  # This is a comment.
+      //      curr_buf  ->  not_a_comment();
+      //
+      return COMMENT_END_BEFORE;
+    }
+
+    if ( !(proto_is_comment && is_line_comment( NEXT ) != NULL) &&
+         is_block_comment( CURR ) ) {
+      //
+      // This handles cases like:
+      //
+      //                    /*
+      //      proto     ->  This is a comment.
+      //      curr_buf  ->  */
+      //
+      // or:
+      //                    /*
+      //                     * This is a comment.
+      //      curr_buf  ->   */
+      //      next_buf  ->  [empty]
+      //
+      adjust_comment_width( CURR_BUF );
+      return COMMENT_END_AT;
+    }
+
+    size_t curr_prefix_len = prefix_span( CURR );
+    if ( opt_doxygen || opt_markdown ) {
+      if ( curr_prefix_len > leader_len ) {
+        //
+        // We can't strip all whitespace after the comment delimiter characters
+        // because:
+        //
+        // 1. Doxygen needs the whitespace when doing preformatted text.
+        // 2. Markdown relies on indentation for state changes.
+        //
+        // Hence we strip only the length of the initial prototype -- but only
+        // if it's less.
+        //
+        curr_prefix_len = leader_len;
+      }
+      else if ( curr_prefix_len < leader_len &&
+                !is_eol( CURR[ curr_prefix_len ] ) ) {
+        //
+        // The leading comment delimiter characters and/or whitespace length
+        // has decreased.  This can happen in a case like:
+        //
+        //      *  + This is a list item.
+        //      *
+        //      * Not part of the list item.
+        //
+        // where the list item was indented 2 spaces after the + but the
+        // regular text was indented only 1 space.  If this check were not
+        // done, then the "Not" text would end up also being indented 2 spaces.
+        //
+        // We therefore have to increase the line width by the delta and also
+        // notify both wrap(1) and the other wrapc(1) processes of the changes.
+        //
+        line_width += leader_len - curr_prefix_len;
+        leader_len = curr_prefix_len;
+        char *const leader_end = CURR + leader_len;
+        char const c = *leader_end;
+        *leader_end = '\0';             // so CURR is just the new leader
+        if ( wipc_out != NULL ) {
+          wipc_out_send( wipc_out, WIPC_CODE_NEW_LEADER, line_width, CURR );
+        } else {
+          WIPC_SENDF(
+            wrap, WIPC_CODE_NEW_LEADER, "%zu" WIPC_PARAM_SEP "%s\n",
+            line_width, CURR
+          );
+        }
+        ++stats[ STAGE_READ ].ipc;
+        *leader_end = c;
+      }
+    }
+
+    // Skip over the prefix and chop off the suffix.
+    char *const line = skip_n( CURR, curr_prefix_len );
+    if ( suffix_buf.str[0] != '\0' )
+      chop_suffix( line );
+
+    writer_puts( wrap, line );
+  } // for
+
+  return COMMENT_END_EOF;
 }
 
 /**
@@ -934,7 +1674,39 @@ static size_t prefix_span( char const *s ) {
  */
 static void read_prototype( void ) {
   char const *const cc = is_line_comment( CURR );
-  if ( cc != NULL ) {
+  cc_delim_t const *cc_delim;
+  size_t const cc_len = cc != NULL ? cc_map_match( cc, &cc_delim ) : 0;
+
+  if ( cc_len > 2 || (cc_len > 0 && cc_delim->is_word) ) {
+    //
+    // Any other comment delimiter, e.g., "<!--" or "REM", is recognized as a
+    // whole with only its own closing comment delimiter, if any.  From now on,
+    // recognize only it and, as comment delimiter characters, only those of
+    // the latter (or of the former if it's a to-end-of-line one) so that,
+    // e.g., "<p>" isn't mistaken for part of a "<!--" comment.
+    //
+    open_cc_len = cc_len;
+    close_cc_len = cc_delim->close_len;
+    switch ( close_cc_len ) {
+      case 0:
+        delim = DELIM_EOL;              // e.g., ";;;" (Lisp)
+        if ( !cc_delim->is_word )
+          close_cc[ close_cc_len++ ] = cc_delim->open[0];
+        close_cc[ close_cc_len ] = '\0';
+        break;
+      case 1:
+        delim = DELIM_SINGLE;           // e.g., "--[" ... "]"
+        strcpy( close_cc, cc_delim->close );
+        break;
+      default:
+        delim = DELIM_DOUBLE;           // e.g., "<!--" ... "-->"
+        strcpy( close_cc, cc_delim->close );
+        break;
+    } // switch
+    cc_map_restrict( close_cc, cc_delim );
+    line_descs_invalidate();
+  }
+  else if ( cc != NULL ) {
     //
     // From now on, recognize only the comment delimiter character(s) found as
     // comment delimiters.  This handles cases like:
@@ -967,7 +1739,8 @@ static void read_prototype( void ) {
     //
     // While this is useful (and efficient) for checking whether a character is
     // a comment delimiter character, it's difficult to use for other purposes.
-    // Therefore, the global close_cc[] and delim variables help out.
+    // Therefore, the global close_cc[], delim, and related variables help
+    // out.
     //
     char cc_buf[ 3 + 1/*null*/ ] = { '\0' };
     char *s = cc_buf;
@@ -1031,20 +1804,25 @@ static void read_prototype( void ) {
     switch ( delim ) {
       case DELIM_EOL:
         close_cc[0] = cc_buf[0];        // e.g., "#"
+        close_cc_len = 1;
         break;
       case DELIM_SINGLE:
         close_cc[0] = cc_buf[1];        // e.g., "}" (Pascal)
+        close_cc_len = 1;
         break;
       case DELIM_DOUBLE:
         close_cc[0] = cc_buf[1];
         close_cc[1] = cc_buf[2] != '\0' ?
           cc_buf[2]                     // e.g., "(*)" (Pascal)
         : cc_buf[0];                    // e.g., "/*"  (C)
+        close_cc_len = open_cc_len = 2;
     } // switch
+    close_cc[ close_cc_len ] = '\0';
 
     // restrict recognized comment characters to those found
     cc_buf[2] = '\0';
-    opt_comment_chars = cc_map_compile( cc_buf );
+    cc_map_restrict( cc_buf, cc_delim );
+    line_descs_invalidate();
   }
 
   char *proto = CURR;
@@ -1060,7 +1838,7 @@ static void read_prototype( void ) {
     // + The first line should not be altered.
     // + The second line becomes the prototype.
     //
-    PJL_DISCARD_RV( check_readline( NEXT, stdin ) );
+    peek_line();
     proto = NEXT;
   }
 
@@ -1069,13 +1847,14 @@ static void read_prototype( void ) {
   // Initialize the prefix and adjust the line width accordingly.
   //
   set_prefix( proto, prefix_span( proto ) );
-  line_width -= STATIC_CAST( int, str_width( prefix_buf ) );
+  line_width -= STATIC_CAST( int, str_width( prefix_buf.str ) );
   //
   // Initialize the suffix, if any, and adjust the line width accordingly.
   //
   char const *const tc = is_terminated_comment( proto );
   if ( tc != NULL ) {
-    suffix_len = chop_eol( suffix_buf, strcpy_len( suffix_buf, tc ) );
+    line_buf_reserve( &suffix_buf, strlen( tc ) );
+    suffix_len = chop_eol( suffix_buf.str, strcpy_len( suffix_buf.str, tc ) );
     line_width -= 1/*space*/ + STATIC_CAST( int, suffix_len );
   }
 
@@ -1088,6 +1867,42 @@ static void read_prototype( void ) {
   opt_line_width = STATIC_CAST( size_t, line_width );
 }
 
+/**
+ * Gets the CPU time used.
+ *
+ * @param who Either `RUSAGE_SELF` or `RUSAGE_CHILDREN` (all waited-for).
+ * @return Returns the user plus system CPU time in seconds.
+ */
+static double rusage_secs( int who ) {
+#define TV_SECS(TV)                                   \
+  ( STATIC_CAST( double, (TV).tv_sec ) +              \
+    STATIC_CAST( double, (TV).tv_usec ) / 1000000.0 )
+  struct rusage ru;
+  PERROR_EXIT_IF( getrusage( who, &ru ) == -1, EX_OSERR );
+  return TV_SECS( ru.ru_utime ) + TV_SECS( ru.ru_stime );
+#undef TV_SECS
+}
+
+/**
+ * Sets the leading comment delimiter characters and/or whitespace and the line
+ * width per a #WIPC_CODE_NEW_LEADER IPC message from child 1
+ * (read_source_write_wrap(), via child 2, wrap).
+ *
+ * @param line_width The new line width.
+ * @param leader The new leading comment delimiter characters and/or
+ * whitespace.
+ * @param proto_tws The prototype trailing whitespace to split off from \a
+ * leader.
+ */
+static void set_leader( size_t line_width, char const *leader,
+                        line_buf_t *proto_tws ) {
+  assert( leader != NULL );
+  assert( proto_tws != NULL );
+  opt_line_width = line_width;
+  set_prefix( leader, strlen( leader ) );
+  split_prefix_tws( proto_tws );
+}
+
 /**
  * Sets the prefix string.
  *
@@ -1096,8 +1911,9 @@ static void read_prototype( void ) {
  */
 static void set_prefix( char const *prefix, size_t len ) {
   assert( prefix != NULL );
-  strncpy( prefix_buf, prefix, len );
-  prefix_buf[ len ] = '\0';
+  line_buf_reserve( &prefix_buf, len );
+  strncpy( prefix_buf.str, prefix, len );
+  prefix_buf.str[ len ] = '\0';
   prefix_len = len;
 }
 
@@ -1132,6 +1948,96 @@ static char* skip_n( char *s, size_t n ) {
   return s;
 }
 
+/**
+ * Splits off the trailing whitespace from \ref prefix_buf into \a proto_tws
+ * setting \ref prefix_tws_len.
+ *
+ * @param proto_tws The \ref line_buf to receive the trailing whitespace.
+ */
+static void split_prefix_tws( line_buf_t *proto_tws ) {
+  assert( proto_tws != NULL );
+  line_buf_reserve( proto_tws, prefix_len );
+  prefix_tws_len =
+    prefix_len - split_tws( prefix_buf.str, prefix_len, proto_tws->str );
+}
+
+/**
+ * Prints the statistics of every \ref stage to standard error as a single
+ * line of _stage_`.`_name_`=`_value_ pairs.
+ *
+ * @remarks Since child 2 may be exec'd into **wrap**(1), its text is counted
+ * only by its neighbors, so all its statistics but its times are theirs.
+ *
+ * @sa stats_send()
+ */
+static void stats_print( void ) {
+  static char const *const STAGE_NAME[] = { "read", "wrap", "write" };
+
+  stats[ STAGE_WRITE ].wall_secs = now_secs() - stats_start;
+  stats[ STAGE_WRITE ].cpu_secs = rusage_secs( RUSAGE_SELF );
+
+  //
+  // Child 1's times were measured here while waiting for it, so take only its
+  // counts from what it sent.
+  //
+  close( stats_pipe[ STDOUT_FILENO ] );
+  stage_stats_t sent;
+  ssize_t const n = read( stats_pipe[ STDIN_FILENO ], &sent, sizeof sent );
+  PERROR_EXIT_IF( n == -1, EX_IOERR );
+  if ( n == sizeof sent ) {
+    stats[ STAGE_READ ].bytes_in  = sent.bytes_in;
+    stats[ STAGE_READ ].bytes_out = sent.bytes_out;
+    stats[ STAGE_READ ].lines     = sent.lines;
+    stats[ STAGE_READ ].ipc       = sent.ipc;
+  }
+  close( stats_pipe[ STDIN_FILENO ] );
+
+  stats[ STAGE_WRAP ].bytes_in  = stats[ STAGE_READ ].bytes_out;
+  stats[ STAGE_WRAP ].bytes_out = stats[ STAGE_WRITE ].bytes_in;
+  stats[ STAGE_WRAP ].lines     = stats[ STAGE_WRITE ].lines;
+  stats[ STAGE_WRAP ].ipc       = stats[ STAGE_READ ].ipc;
+
+  EPRINTF( "%s: stats:", me );
+  for ( size_t i = 0; i < ARRAY_SIZE( stats ); ++i ) {
+    char const *const name = STAGE_NAME[i];
+    stage_stats_t const *const s = &stats[i];
+    EPRINTF(
+      " %s.wall=%.6f %s.cpu=%.6f"
+      " %s.bytes_in=%" PRIu64 " %s.bytes_out=%" PRIu64
+      " %s.lines=%" PRIu64 " %s.ipc=%" PRIu64,
+      name, s->wall_secs, name, s->cpu_secs,
+      name, s->bytes_in, name, s->bytes_out,
+      name, s->lines, name, s->ipc
+    );
+  } // for
+
+  //
+  // The peak of children is that of the largest, not of each.
+  //
+  size_t const self_rss_kb = peak_rss_kb( RUSAGE_SELF );
+  size_t const children_rss_kb = peak_rss_kb( RUSAGE_CHILDREN );
+  EPRINTF( " peak_rss_kb=%zu",
+    self_rss_kb > children_rss_kb ? self_rss_kb : children_rss_kb
+  );
+  EPUTC( '\n' );
+}
+
+/**
+ * If `--stats` was given, sends child 1's statistics but its times (that are
+ * measured by the parent) to the parent.
+ *
+ * @sa stats_print()
+ */
+static void stats_send( void ) {
+  if ( opt_stats ) {
+    write_all(
+      stats_pipe[ STDOUT_FILENO ],
+      POINTER_CAST( char const*, &stats[ STAGE_READ ] ),
+      sizeof stats[ STAGE_READ ]
+    );
+  }
+}
+
 /**
  * A special variant of **strlen**(3) that gets the length not including
  * trailing end-of-line characters, if any.
@@ -1185,8 +2091,12 @@ NODISCARD
 static size_t str_width( char const *s ) {
   assert( s != NULL );
   size_t width = 0;
-  while ( *s != '\0' )
-    width += char_width( *s++, width );
+  for ( ; *s != '\0'; ++s ) {
+    if ( *s == '\t' )
+      width += char_width( *s, width );
+    else if ( !utf8_is_cont( *s ) )
+      width += utf8_width( s );
+  } // for
   return width;
 }
 
@@ -1199,17 +2109,23 @@ static size_t str_width( char const *s ) {
 static void usage( int status ) {
   fprintf( status == EX_OK ? stdout : stderr,
 "usage: " PACKAGE "c [options]\n"
+"       " PACKAGE "c -O [options] FILE...\n"
+"       " PACKAGE "c --git-changed[=REV] [options] [PATHSPEC...]\n"
+"       " PACKAGE "c --server=SOCKET\n"
+"       " PACKAGE "c --client=SOCKET [options]\n"
 "options:\n"
 "  --alias=NAME           " UOPT(ALIAS)
                           "Use alias from configuration file.\n"
 "  --align-column=NUM[,S] " UOPT(ALIGN_COLUMN)
-                          "Column to align end-of-line comments on.\n"
+                          "Column (or b) to align end-of-line comments on.\n"
+"  --all-comments         " UOPT(ALL_COMMENTS)
+                          "Reformat all comments, not just the first.\n"
 "  --block-regex=REGEX    " UOPT(BLOCK_REGEX)
                           "Block leading regular expression.\n"
 "  --comment-chars=STR    " UOPT(COMMENT_CHARS)
                           "Comment delimiter characters.\n"
 "  --config=FILE          " UOPT(CONFIG)
-                          "The configuration file [default: ~/" CONF_FILE_NAME_DEFAULT "].\n"
+                          "The configuration file [default: nearest " CONF_FILE_NAME_DEFAULT "].\n"
 "  --doxygen              " UOPT(DOXYGEN)
                           "Format Doxygen.\n"
 "  --eol=STR              " UOPT(EOL) "\n"
@@ -1218,14 +2134,24 @@ static void usage( int status ) {
 "      Treat whitespace after end-of-sentence as a paragraph delimiter.\n"
 "  --eos-spaces=NUM       " UOPT(EOS_SPACES)
                           "Spaces after end-of-sentence [default: " STRINGIFY(EOS_SPACES_DEFAULT) "].\n"
+"  --expand-tabs          " UOPT(EXPAND_TABS)
+                          "Expand tabs in output to spaces.\n"
 "  --file=FILE            " UOPT(FILE)
                           "Read from this file [default: stdin].\n"
 "  --file-name=NAME       " UOPT(FILE_NAME)
                           "Filename for stdin.\n"
+"  --git-changed[=REV]    " UOPT(GIT_CHANGED) "\n"
+"      Reformat in place all comments in files changed since REV [default: HEAD].\n"
 "  --help                 " UOPT(HELP)
                           "Print this help and exit.\n"
+"  --in-place             " UOPT(IN_PLACE)
+                          "Reformat all comments in FILE(s) in place.\n"
+"  --jobs=NUM             " UOPT(JOBS)
+                          "Number of files or chunks reformatted in parallel [default: 1].\n"
 "  --markdown             " UOPT(MARKDOWN)
                           "Format Markdown.\n"
+"  --max-lines=NUM        " UOPT(MAX_LINES)
+                          "Stop after writing NUM lines.\n"
 "  --no-config            " UOPT(NO_CONFIG)
                           "Suppress reading configuration file.\n"
 "  --no-hyphen            " UOPT(NO_HYPHEN)
@@ -1234,10 +2160,14 @@ static void usage( int status ) {
                           "Write to this file [default: stdout].\n"
 "  --para-chars=STR       " UOPT(PARA_CHARS)
                           "Additional paragraph delimiter characters.\n"
+"  --stats                " UOPT(STATS)
+                          "Print statistics of each process to stderr.\n"
 "  --tab-spaces=NUM       " UOPT(TAB_SPACES)
                           "Tab-spaces equivalence [default: " STRINGIFY(TAB_SPACES_DEFAULT) "].\n"
 "  --title                " UOPT(TITLE_LINE)
                           "Treat paragraph's first line as title.\n"
+"  --unicode-breaks       " UOPT(UNICODE_BREAKS) "\n"
+"      Also wrap where Unicode allows, e.g., between ideographs.\n"
 "  --version              " UOPT(VERSION)
                           "Print version and exit.\n"
 "  --width=NUM|terminal   " UOPT(WIDTH) "Line width [default: " STRINGIFY(LINE_WIDTH_DEFAULT) "].\n"
@@ -1253,8 +2183,14 @@ PACKAGE_NAME " home page: " PACKAGE_URL "\n"
  */
 static void wait_for_child_processes( void ) {
 #ifndef DEBUG_RSWW
+  double cpu_secs_prev = 0;
   int wait_status;
   for ( pid_t pid; (pid = wait( &wait_status )) > 0; ) {
+    bool const is_rsww = pid == rsww_pid;
+    if ( is_rsww )                      // so kill_child_processes() won't
+      rsww_pid = 0;
+    else if ( pid == wrap_pid )
+      wrap_pid = 0;
     if ( WIFEXITED( wait_status ) ) {
       int const exit_status = WEXITSTATUS( wait_status );
       if ( exit_status != 0 ) {
@@ -1270,87 +2206,297 @@ static void wait_for_child_processes( void ) {
         signal, strsignal( signal )
       );
     }
+    if ( opt_stats ) {
+      //
+      // The resource usage of all waited-for children is cumulative, so each
+      // child's is the difference from that of the previous one.
+      //
+      stage_stats_t *const s = &stats[ is_rsww ? STAGE_READ : STAGE_WRAP ];
+      double const cpu_secs = rusage_secs( RUSAGE_CHILDREN );
+      s->wall_secs = now_secs() - stats_start;
+      s->cpu_secs = cpu_secs - cpu_secs_prev;
+      cpu_secs_prev = cpu_secs;
+    }
   } // for
+
+  if ( opt_stats )
+    stats_print();
 #endif /* DEBUG_RSWW */
 }
 
 /**
- * If \a line starts with a Doxygen command, handle it.
- *
- * @param line The line of text to check.
- * @param fout The `FILE` to possibly write to.
- * @return Returns `true` only if a Doxygen command was handled; `false`
- * otherwise.
- *
- * @note The caller _must_ write \a line only if this function returns \a
- * false.
+ * Reformats every comment in the input, passing all other lines through
+ * verbatim: each comment is found as **wrapc**(1) finds the first (and only)
+ * one otherwise, then reformatted by the **wrap**(1) engine in-process with
+ * the same \ref wrap_ctx reset for each rather than by child processes.
+ * Large input may instead be split among child processes via
+ * wrap_all_comments_fork().
  */
-static bool wrap_dox_line( char const *line, FILE *fout ) {
-  char dox_cmd_name[ DOX_CMD_NAME_SIZE_MAX + 1 ];
-  if ( !dox_parse_cmd_name( line, dox_cmd_name ) )
-    return false;
+static void wrap_all_comments( void ) {
+  //
+  // Each comment restricts this per its own leader (via read_prototype()),
+  // so the original value is needed for the next.
+  //
+  size_t const line_width = opt_line_width;
+
+  writer_t wout;
+  writer_init( &wout, stdout );
+  writer_limit_lines( &wout, opt_max_lines );
+  if ( opt_expand_tabs )
+    writer_expand_tabs( &wout );
+  wrapped_t wrapped = { .wout = &wout };
+  line_buf_init( &wrapped.buf );
+  line_buf_init( &wrapped.line_buf );
+  line_buf_init( &wrapped.proto_tws );
+  wrap_ctx_t ctx;
+  wrap_ctx_init( &ctx, &wrapped_write, &wrapped );
+  writer_t wrap;
+  writer_init_fn( &wrap, &wrap_feed_write, &ctx );
+  bool is_fork_tried = opt_jobs == 1;
+
+  while ( CURR[0] != '\0' ) {
+    cc_map_restrict( /*cc=*/NULL, /*delim=*/NULL );
+    line_descs_invalidate();
+    if ( is_line_comment( CURR ) == NULL ) {
+      if ( !is_fork_tried ) {
+        is_fork_tried = true;
+        writer_flush( &wout );
+        wrap_all_comments_fork();
+      }
+      put_code_lines( &wout );
+      continue;
+    }
 
-  static dox_cmd_t const *prev_dox_cmd;
-  if ( prev_dox_cmd != NULL ) {
-    if ( strcmp( dox_cmd_name, prev_dox_cmd->end_name ) == 0 ) {
+    opt_line_width = line_width;
+    close_cc[0] = '\0';
+    close_cc_len = 0;
+    suffix_buf.str[0] = '\0';
+    suffix_len = 0;
+    read_prototype();
+    wrap_ctx_reset( &ctx );
+
+    if ( NEXT[0] != '\0' && is_block_comment( CURR ) ) {
       //
-      // We've encountered the previous Doxygen command's corresponding end
-      // command: put that line, then tell wrap to resume wrapping.
+      // For block comments, write the first line directly to the output.
       //
-      FPUTS( line, fout );
-      WIPC_SEND( fout, WIPC_CODE_PREFORMATTED_END );
-      prev_dox_cmd = NULL;
-      return true;
+      adjust_comment_width( CURR_BUF );
+      writer_write( &wout, CURR, CURR_BUF->len );
+      next_line();
     }
 
-    //
-    // It's not the corresponding end command for the previous Doxygen command
-    // that copies preformatted text: just pass it along to wrap as-is.
-    //
-    return false;
-  }
+    // See the comment in read_wrap_write_stdout().
+    split_prefix_tws( &wrapped.proto_tws );
 
-  //
-  // See if it's a known Doxygen command.
-  //
-  dox_cmd_t const *const dox_cmd = dox_find_cmd( dox_cmd_name );
-  if ( dox_cmd == NULL ) {
     //
-    // It's a Doxygen command we know nothing about (or something that looks
-    // like a Doxgen command, e.g., "\t"): just pass it along to wrap as-is
-    // and hope for the best.
+    // Unlike for only the first comment, a line that's not a comment always
+    // ends it lest code be reformatted.
     //
-    return false;
-  }
+    comment_end_t const end =
+      read_comment( &wrap, /*wipc_out=*/NULL, /*proto_is_comment=*/true );
+    writer_flush( &wrap );
+    wrap_finish( &ctx );
+    if ( wrapped.len > 0 ) {            // last line has no end-of-line
+      wrapped_put( &wrapped, wrapped.buf.str, wrapped.len );
+      wrapped.len = 0;
+    }
 
-  if ( (dox_cmd->type & DOX_BOL) != 0 )
-    WIPC_SEND( fout, WIPC_CODE_DELIMIT_PARAGRAPH );
+    if ( end == COMMENT_END_AT ) {
+      writer_write( &wout, CURR, CURR_BUF->len );
+      next_line();
+    }
+  } // while
+
+  writer_cleanup( &wrap );
+  wrap_ctx_cleanup( &ctx );
+  line_buf_cleanup( &wrapped.buf );
+  line_buf_cleanup( &wrapped.line_buf );
+  line_buf_cleanup( &wrapped.proto_tws );
+  writer_cleanup( &wout );
+}
 
-  if ( (dox_cmd->type & DOX_EOL) != 0 ) {
-    //
-    // The Doxygen command continues until the end of the line: treat it as
-    // preformatted.
-    //
-    WIPC_SEND( fout, WIPC_CODE_PREFORMATTED_BEGIN );
+/**
+ * If standard input is a large regular file, splits the rest of it after
+ * \ref NEXT into up to \ref opt_jobs chunks and forks a child process to
+ * reformat all the comments of each into a temporary file.  The parent then
+ * copies the temporary files to standard output in order.
+ *
+ * @remarks Chunks are split only between two lines of code (see
+ * is_code_line()) since a comment never spans such lines: each chunk's first
+ * line is then handled just as it would have been had there been no split,
+ * i.e., put verbatim with nothing carried over from the lines before.
+ *
+ * @remarks If reformatting in parallel, in the parent, this function never
+ * returns: it exits with the status of the first child that failed, if any.
+ * In each child, it returns so that wrap_all_comments() proceeds as if only
+ * that child's chunk were the rest of its input.  Otherwise, it returns so
+ * that wrap_all_comments() proceeds serially.
+ *
+ * @note This must be called only when \ref CURR is code and no comment
+ * delimiters are restricted.
+ */
+static void wrap_all_comments_fork( void ) {
+  size_t size;
+  char const *const s = reader_peek( stdin, &size );
+  if ( s == NULL )
+    return;
+
+  size_t chunks = opt_jobs;
+  if ( chunks == 0 ) {
+    long const cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    chunks = cpus > 0 ? STATIC_CAST( size_t, cpus ) : 1;
   }
+  if ( chunks > size / COMMENTS_CHUNK_SIZE_MIN )
+    chunks = size / COMMENTS_CHUNK_SIZE_MIN;
+  if ( chunks < 2 )
+    return;
+
+  comments_job_t *const jobs = MALLOC( comments_job_t, chunks );
+  size_t jobs_len = 0;
+
+  for ( size_t start = 0; start < size; ++jobs_len ) {
+    size_t end = size;
+    if ( jobs_len + 1 < chunks ) {
+      size_t pos = size / chunks * (jobs_len + 1);
+      if ( pos < start )
+        pos = start;
+      //
+      // Find the first line at or after pos that, along with the line before
+      // it, is code.
+      //
+      char const *prev = NULL;          // line before the candidate
+      for ( char const *nl;
+            (nl = memchr( s + pos, '\n', size - pos )) != NULL; ) {
+        char const *const line = nl + 1;
+        size_t const line_pos = STATIC_CAST( size_t, line - s );
+        if ( line_pos == size )
+          break;
+        char const *const line_nl = memchr( line, '\n', size - line_pos );
+        size_t const line_size = line_nl != NULL ?
+          STATIC_CAST( size_t, line_nl - line ) + 1 : size - line_pos;
+        if ( prev != NULL &&
+             is_code_line( prev, STATIC_CAST( size_t, line - prev ) ) &&
+             is_code_line( line, line_size ) ) {
+          end = line_pos;
+          break;
+        }
+        prev = line;
+        pos = line_pos;
+      } // for
+    }
+    FILE *const ftemp = tmpfile();
+    PERROR_EXIT_IF( ftemp == NULL, EX_CANTCREAT );
+
+    PERROR_EXIT_IF( fflush( stdout ) != 0, EX_IOERR );
+    pid_t const pid = fork();
+    PERROR_EXIT_IF( pid == -1, EX_OSERR );
+    if ( pid == 0 ) {                   // child
+      DUP2( fileno( ftemp ), STDOUT_FILENO );
+      PJL_DISCARD_RV( fclose( ftemp ) );
+      reader_limit( stdin, start, end - start );
+      if ( start > 0 ) {
+        //
+        // The current and next lines belong to the first chunk: start afresh
+        // from this chunk's first line.
+        //
+        NEXT[0] = '\0';
+        NEXT_BUF->len = 0;
+        next_line();
+      }
+      FREE( jobs );
+      return;
+    }
 
-  FPUTS( line, fout );
+    jobs[ jobs_len ] = (comments_job_t){ .pid = pid, .fout = ftemp };
+    start = end;
+  } // for
 
-  if ( (dox_cmd->type & DOX_EOL) != 0 )
-    WIPC_SEND( fout, WIPC_CODE_PREFORMATTED_END );
+  int exit_status = EX_OK;
+  for ( size_t i = 0; i < jobs_len; ++i ) {
+    int wait_status;
+    PERROR_EXIT_IF( waitpid( jobs[i].pid, &wait_status, 0 ) == -1, EX_OSERR );
+    if ( exit_status == EX_OK ) {
+      exit_status = WIFEXITED( wait_status ) ?
+        WEXITSTATUS( wait_status ) : EX_SOFTWARE;
+      if ( exit_status == EX_OK ) {
+        rewind( jobs[i].fout );
+        fcopy( jobs[i].fout, stdout );
+      }
+    }
+    PJL_DISCARD_RV( fclose( jobs[i].fout ) );
+  } // for
 
-  if ( (dox_cmd->type & DOX_PRE) != 0 ) {
-    //
-    // The Doxygen command is for a block of preformatted text (e.g., @code,
-    // @dot, @verbatim, etc.): tell wrap to suspend wrapping and begin sending
-    // preformatted text through verbatim until we encounter the command's
-    // corresponding end command.
-    //
-    WIPC_SEND( fout, WIPC_CODE_PREFORMATTED_BEGIN );
-    prev_dox_cmd = dox_cmd;
-  }
+  FREE( jobs );
+  exit( exit_status );
+}
 
-  return true;
+/**
+ * The \ref writer_fn_t that gives the stripped text of a comment to the
+ * **wrap**(1) engine.
+ *
+ * @param s The characters of text.
+ * @param len The number of characters of text.
+ * @param data A pointer to the \ref wrap_ctx to give the text to.
+ */
+static void wrap_feed_write( char const *s, size_t len, void *data ) {
+  wrap_feed( data, s, len );
+}
+
+/**
+ * Cleans up **wrapc**(1) data.
+ */
+static void wrapc_cleanup( void ) {
+  line_buf_cleanup( &input_lines.dl_line[0] );
+  line_buf_cleanup( &input_lines.dl_line[1] );
+  line_buf_cleanup( &prefix_buf );
+  line_buf_cleanup( &suffix_buf );
+}
+
+/**
+ * Puts a line of the output of the **wrap**(1) engine run in-process.
+ *
+ * @param wrapped The \ref wrapped to use.
+ * @param line The line.
+ * @param size The size of the line including its end-of-line, if any.
+ */
+static void wrapped_put( wrapped_t *wrapped, char const *line, size_t size ) {
+  assert( wrapped != NULL );
+  assert( line != NULL );
+  line_buf_reserve( &wrapped->line_buf, size );
+  memcpy( wrapped->line_buf.str, line, size );
+  wrapped->line_buf.str[ size ] = '\0';
+  PJL_DISCARD_RV(
+    put_wrapped_line(
+      wrapped->wout, &wrapped->line_buf, size, &wrapped->proto_tws
+    )
+  );
+}
+
+/**
+ * The \ref writer_fn_t that puts each line of the output of the **wrap**(1)
+ * engine run in-process as it's completed.
+ *
+ * @param s The characters of output.
+ * @param len The number of characters of output.
+ * @param data A pointer to the \ref wrapped to use.
+ */
+static void wrapped_write( char const *s, size_t len, void *data ) {
+  wrapped_t *const wrapped = data;
+  line_buf_reserve( &wrapped->buf, wrapped->len + len );
+  memcpy( wrapped->buf.str + wrapped->len, s, len );
+  wrapped->len += len;
+
+  size_t pos = 0;
+  for ( char const *nl;
+        (nl = memchr( wrapped->buf.str + pos, '\n',
+                      wrapped->len - pos )) != NULL; ) {
+    size_t const size =
+      STATIC_CAST( size_t, nl - (wrapped->buf.str + pos) ) + 1;
+    wrapped_put( wrapped, wrapped->buf.str + pos, size );
+    pos += size;
+  } // for
+
+  wrapped->len -= pos;
+  memmove( wrapped->buf.str, wrapped->buf.str + pos, wrapped->len );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
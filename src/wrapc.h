@@ -0,0 +1,50 @@
+/*
+**      wrap -- text reformatter
+**      src/wrapc.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_wrapc_H
+#define wrap_wrapc_H
+
+/**
+ * @file
+ * Declares the function that runs **wrapc**(1) so it can be linked into
+ * other programs, e.g., **wrap-lsp**(1).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Runs **wrapc**(1): parses \a argv, then reformats the comment read from
+ * standard input (or every comment for `--all-comments`) to standard output.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.  Its `argv[0]` must be
+ * `wrapc` for its options to be those of **wrapc**(1).
+ *
+ * @note This must be called at most once per process.
+ */
+_Noreturn void wrapc_run( int argc, char const *argv[] );
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif /* wrap_wrapc_H */
+/* vim:set et sw=2 ts=2: */
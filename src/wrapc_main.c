@@ -0,0 +1,52 @@
+/*
+**      wrap -- text reformatter
+**      src/wrapc_main.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Implements the main entry point of **wrapc**(1).
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "server.h"
+#include "wrap.h"
+#include "wrapc.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+// extern variable definitions
+char const         *me;                 // executable name
+
+////////// main ///////////////////////////////////////////////////////////////
+
+/**
+ * The main entry point.
+ *
+ * @param argc The command-line argument count.
+ * @param argv The command-line argument values.
+ * @return Returns 0 on success, non-zero on failure.
+ */
+int main( int argc, char const *argv[] ) {
+  server_main( PACKAGE "c", &wrap_preset, &argc, &argv );
+  wrapc_run( argc, argv );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,67 @@
+/*
+**      wrap -- text reformatter
+**      src/wraphyph.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Compiles a TeX hyphenation pattern file (e.g., `hyph-en-us.tex`) into the
+ * binary form that **wrap**(1) memory-maps for its `--hyphenate` option.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "hyphenate.h"
+#include "util.h"
+
+// standard
+#include <stdlib.h>
+#include <sysexits.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// extern variable definitions
+char const *me;                         ///< Program name.
+
+// local functions
+_Noreturn
+static void usage( void );
+
+////////// local functions ////////////////////////////////////////////////////
+
+static void usage( void ) {
+  EPRINTF( "usage: %s hyph-file.tex compiled-file\n", me );
+  exit( EX_USAGE );
+}
+
+////////// main ///////////////////////////////////////////////////////////////
+
+int main( int argc, char const *argv[] ) {
+  me = base_name( argv[0] );
+  if ( argc != 3 )
+    usage();
+
+  setlocale_utf8();
+  hyphenate_init( argv[1] );
+  hyphenate_write( argv[2] );
+  hyphenate_cleanup();
+  exit( EX_OK );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
@@ -32,58 +32,323 @@
 // standard
 #include <assert.h>
 #include <stdbool.h>
+#include <string.h>                     /* for memcpy(3), strnlen(3), ... */
 #include <sysexits.h>
-#include <wctype.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 
 // local constant definitions
+#ifdef WITH_PCRE2
+static uint32_t const WRAP_REGEX_COMPILE_FLAGS =
+  PCRE2_MATCH_INVALID_UTF | PCRE2_UCP | PCRE2_UTF;
+#else
 static int const    WRAP_REGEX_COMPILE_FLAGS = REG_EXTENDED;
+#endif /* WITH_PCRE2 */
 
-////////// inline functions ///////////////////////////////////////////////////
+/**
+ * The properties that determine whether a word begins at a character: a word
+ * begins wherever either of these properties differs from those of the
+ * character before.
+ */
+static cp_props_t const WORD_PROPS = CP_PROP_SPACE | CP_PROP_WORD;
 
 /**
- * Checks whether \a cp is a word character, that is an alphanumeric or \c _
- * character.  Note that this function is locale sensitive.
- *
- * @param cp The code-point to check.
- * @return Returns `true` only if \a cp is a word code-point.
+ * The maximum number of threads of regex_wrap_re_match() that are searched to
+ * find one already in a state.
+ */
+static size_t const WRAP_RE_DFA_SCAN_MAX = 16;
+
+/**
+ * A regular expression compiled by regex_preset().
  */
+struct regex_preset {
+  char             *pattern;            ///< The pattern compiled.
+  wregex_t          re;                 ///< Its compiled code.
+};
+typedef struct regex_preset regex_preset_t;
+
+// local variable definitions
+static regex_preset_t *regex_presets;   ///< Regular expressions compiled once.
+static size_t       regex_presets_len;  ///< Length of \ref regex_presets.
+
+// local functions
 NODISCARD
-static inline bool cp_is_word_char( char32_t cp ) {
-  return iswalnum( STATIC_CAST( wint_t, cp ) ) || cp == '_';
-}
+static bool is_begin_word_boundary( char const*, size_t, size_t,
+                                    regex_words_t* );
+
+NODISCARD
+static char* literal_prefix( char const*, size_t* );
+
+static void   regex_presets_cleanup( void );
+
+NODISCARD
+static cp_props_t word_props( char const** );
+
+static void words_classify( regex_words_t*, char const*, size_t );
+
+NODISCARD
+static bool wrap_re_candidate( char const*, size_t* );
+
+NODISCARD
+static unsigned wrap_re_class( char const*, size_t* );
+
+NODISCARD
+static bool wrap_re_thread_in( uint16_t const*, size_t, unsigned );
 
 ////////// local functions ////////////////////////////////////////////////////
 
 /**
- * Checks whether the character at \a curr is the beginning of a word.  This
+ * Frees all regular expressions compiled by regex_preset().
+ */
+static void regex_presets_cleanup( void ) {
+  for ( size_t i = 0; i < regex_presets_len; ++i ) {
+    regex_free( &regex_presets[i].re );
+    FREE( regex_presets[i].pattern );
+  } // for
+  FREE( regex_presets );
+  regex_presets = NULL;
+  regex_presets_len = 0;
+}
+
+/**
+ * Checks whether the character at \a i is the beginning of a word.  This
  * function exists because POSIX regular expressions don't support \c \\b
  * (match a word boundary).
  *
  * @param s The UTF-8 encoded string to check within.
- * @param curr A pointer to the first byte of the UTF-8 encoded character to
+ * @param offset The offset into \a s where matching started: a word always
+ * begins there.
+ * @param i The index of the first byte of the UTF-8 encoded character to
  * check.
- * @return Returns `true` only if the character at \a curr is at the beginning
+ * @param words A pointer to the \ref regex_words for \a s or NULL to
+ * classify the characters from \a offset to \a i for just this check.
+ * @return Returns `true` only if the character at \a i is at the beginning
  * of a word.
  */
-NODISCARD
-static bool is_begin_word_boundary( char const *s, char const *curr ) {
+static bool is_begin_word_boundary( char const *s, size_t offset, size_t i,
+                                    regex_words_t *words ) {
   assert( s != NULL );
-  assert( curr != NULL );
-  assert( curr >= s );
+  assert( i >= offset );
 
-  if ( curr == s )
+  if ( i == offset )
     return true;
-  char const *const prev = utf8_rsync( s, curr - 1 );
-  if ( prev == NULL )
+
+  if ( words == NULL ) {
+    char const *p = s + offset;
+    char const *curr = s + i;
+    cp_props_t prev;
+    do {
+      prev = word_props( &p );
+    } while ( p < curr );
+    return word_props( &curr ) != prev;
+  }
+
+  words_classify( words, s, i );
+  return (words->bits[ i >> 6 ] >> (i & 63)) & 1u;
+}
+
+/**
+ * Gets the literal characters that every match of \a pattern must begin with.
+ * This is conservative: it stops at the first character that's special (or
+ * might be) and drops the last literal character if it's optional.
+ *
+ * @param pattern The regular expression pattern.
+ * @param plen A pointer to receive the length of the prefix.
+ * @return Returns said prefix (that the caller is responsible for freeing) or
+ * NULL if either \a pattern doesn't begin with `^` or has no literal prefix.
+ */
+static char* literal_prefix( char const *pattern, size_t *plen ) {
+  static char const META_CHARS[] = "$()*+.?[\\]^{|}";
+  assert( pattern != NULL );
+  assert( plen != NULL );
+
+  //
+  // A | anywhere might be an alternative at the top level that doesn't begin
+  // with the prefix, so don't bother.
+  //
+  if ( pattern[0] != '^' || strchr( pattern, '|' ) != NULL )
+    return NULL;
+
+  char *const prefix = MALLOC( char, strlen( pattern ) );
+  size_t len = 0;
+
+  for ( char const *p = pattern + 1; *p != '\0'; ) {
+    char const *lit = p;
+    size_t lit_len = 1;
+    if ( *p == '\\' ) {
+      if ( p[1] == '\0' || strchr( META_CHARS, p[1] ) == NULL )
+        break;                          // e.g., \w or \<: not literal
+      lit = ++p;
+    }
+    else if ( strchr( META_CHARS, *p ) != NULL ) {
+      break;
+    }
+    else if ( (lit_len = utf8_len( *p )) == 0 ) {
+      lit_len = 1;                      // invalid UTF-8: take it as a byte
+    }
+    else if ( strnlen( p, lit_len ) < lit_len ) {
+      break;                            // truncated UTF-8
+    }
+    p += lit_len;
+
+    if ( *p != '\0' && strchr( "*+?{", *p ) != NULL ) {
+      //
+      // The literal character is repeated: it's required only for +.
+      //
+      if ( *p == '+' ) {
+        memcpy( prefix + len, lit, lit_len );
+        len += lit_len;
+      }
+      break;
+    }
+
+    memcpy( prefix + len, lit, lit_len );
+    len += lit_len;
+  } // for
+
+  if ( len == 0 ) {
+    FREE( prefix );
+    return NULL;
+  }
+  *plen = len;
+  return prefix;
+}
+
+/**
+ * Gets the \ref WORD_PROPS properties of the UTF-8 encoded character at \a
+ * *ps and advances past it.  An invalid byte is treated as a character by
+ * itself having no properties.
+ *
+ * @param ps A pointer to the pointer to the first byte of the character.
+ * @return Returns said properties.
+ */
+static cp_props_t word_props( char const **ps ) {
+  assert( ps != NULL );
+  assert( *ps != NULL );
+  size_t len = utf8_len( **ps );
+  for ( size_t i = 1; i < len; ++i ) {
+    if ( !utf8_is_cont( (*ps)[i] ) ) {  // truncated, e.g., by the null
+      len = 0;
+      break;
+    }
+  } // for
+  char32_t const cp = len > 0 ? utf8_decode( *ps ) : CP_INVALID;
+  if ( cp == CP_INVALID ) {
+    ++*ps;
+    return 0;
+  }
+  *ps += len;
+  return cp_props( cp ) & WORD_PROPS;
+}
+
+/**
+ * Classifies the characters of \a line as far as needed to include the byte
+ * at \a i (if not done already) setting \a words bits wherever a word begins.
+ *
+ * @param words A pointer to the \ref regex_words to update.
+ * @param line The UTF-8 encoded line \a words is for.
+ * @param i The index of the byte that must be classified.
+ */
+static void words_classify( regex_words_t *words, char const *line, size_t i ) {
+  assert( words != NULL );
+  assert( line != NULL );
+
+  if ( i < words->len )
+    return;
+  if ( i >= words->cap ) {
+    size_t const old_n = words->cap >> 6;
+    size_t new_n = old_n == 0 ? 4 : old_n;
+    while ( (new_n << 6) <= i )
+      new_n <<= 1;
+    REALLOC( words->bits, uint64_t, new_n );
+    memset( words->bits + old_n, 0, (new_n - old_n) * sizeof( uint64_t ) );
+    words->cap = new_n << 6;
+  }
+
+  char const *s = line + words->len;
+  do {
+    size_t const j = STATIC_CAST( size_t, s - line );
+    cp_props_t const props = word_props( &s );
+    if ( props != words->prev && j > 0 )
+      words->bits[ j >> 6 ] |= UINT64_C(1) << (j & 63);
+    words->prev = props;
+  } while ( STATIC_CAST( size_t, s - line ) <= i );
+  words->len = STATIC_CAST( size_t, s - line );
+}
+
+/**
+ * Finds the first whitespace-delimited word of \a s at or after \a *offset
+ * that contains what every match of #WRAP_RE must contain: an `@`, a `://`, or
+ * a `file:`.  Since no match can contain whitespace, it's faster to search
+ * for these literally first so that the DFA need only be run on lines that
+ * might match starting from the word that might.
+ *
+ * @param s The string to search.
+ * @param offset A pointer to the offset into \a s to start.  On success, it's
+ * set to the offset of the beginning of the word (but never before where it
+ * started).
+ * @return Returns `true` only if such a word was found.
+ */
+static bool wrap_re_candidate( char const *s, size_t *offset ) {
+  assert( s != NULL );
+  assert( offset != NULL );
+
+  char const *const begin = s + *offset;
+  for ( char const *p = begin; (p = strpbrk( p, "@:" )) != NULL; ++p ) {
+    if ( *p == ':' && strncmp( p + 1, "//", 2 ) != 0 &&
+         !(p - begin >= 4 && strncmp( p - 4, "file", 4 ) == 0) ) {
+      continue;
+    }
+    while ( p > begin && !is_space( p[-1] ) )
+      --p;
+    *offset = STATIC_CAST( size_t, p - s );
     return true;
+  } // for
+  return false;
+}
 
-  char32_t const curr_cp = utf8_decode( curr );
-  char32_t const prev_cp = utf8_decode( prev );
+/**
+ * Gets the \ref WRAP_RE_DFA symbol class of the UTF-8 encoded character at
+ * \a s.
+ *
+ * @param s A pointer to the first byte of the character.
+ * @param plen A pointer to receive the number of bytes of the character.
+ * @return Returns said class.
+ */
+static unsigned wrap_re_class( char const *s, size_t *plen ) {
+  extern uint8_t const WRAP_RE_DFA_ALNUM;
+  extern uint8_t const WRAP_RE_DFA_ASCII[];
+  assert( s != NULL );
+  assert( plen != NULL );
+
+  char8_t const c8 = STATIC_CAST( char8_t, *s );
+  if ( c8 <= 0x7F ) {
+    *plen = 1;
+    return WRAP_RE_DFA_ASCII[ c8 ];
+  }
+  char const *next = s;
+  cp_props_t const props = word_props( &next );
+  *plen = STATIC_CAST( size_t, next - s );
+  return (props & CP_PROP_WORD) != 0 ? WRAP_RE_DFA_ALNUM : 0;
+}
 
-  return (cp_is_word_char( curr_cp ) ^ cp_is_word_char( prev_cp ))
-      || (cp_is_space( curr_cp ) ^ cp_is_space( prev_cp ));
+/**
+ * Checks whether any of the first \a n threads of regex_wrap_re_match() is in
+ * \a state.
+ *
+ * @param th_state The states of the threads.
+ * @param n The number of threads.
+ * @param state The state to check for.
+ * @return Returns `true` only if one is.
+ */
+static bool wrap_re_thread_in( uint16_t const *th_state, size_t n,
+                               unsigned state ) {
+  assert( th_state != NULL );
+  for ( size_t t = 0; t < n; ++t ) {
+    if ( th_state[t] == state )
+      return true;
+  } // for
+  return false;
 }
 
 ////////// extern functions ///////////////////////////////////////////////////
@@ -91,47 +356,328 @@ static bool is_begin_word_boundary( char const *s, char const *curr ) {
 int regex_compile( wregex_t *re, char const *pattern ) {
   assert( re != NULL );
   assert( pattern != NULL );
-  return regcomp( re, pattern, WRAP_REGEX_COMPILE_FLAGS );
+
+  for ( size_t i = 0; i < regex_presets_len; ++i ) {
+    if ( strcmp( regex_presets[i].pattern, pattern ) == 0 ) {
+      *re = regex_presets[i].re;
+      re->is_borrowed = true;
+#ifdef WITH_PCRE2
+      re->match_data = pcre2_match_data_create( 1, /*gcontext=*/NULL );
+#endif /* WITH_PCRE2 */
+      return 0;
+    }
+  } // for
+
+  re->is_borrowed = false;
+  re->prefix_len = 0;
+  re->prefix = literal_prefix( pattern, &re->prefix_len );
+#ifdef WITH_PCRE2
+  int err_code;
+  PCRE2_SIZE err_offset;
+  re->code = pcre2_compile(
+    POINTER_CAST( PCRE2_SPTR, pattern ), PCRE2_ZERO_TERMINATED,
+    WRAP_REGEX_COMPILE_FLAGS, &err_code, &err_offset, /*ccontext=*/NULL
+  );
+  if ( re->code == NULL )
+    return err_code;
+  //
+  // If JIT compilation isn't supported, matching just falls back to the
+  // interpreter.
+  //
+  PJL_DISCARD_RV( pcre2_jit_compile( re->code, PCRE2_JIT_COMPLETE ) );
+  re->match_data = pcre2_match_data_create( 1, /*gcontext=*/NULL );
+  return 0;
+#else
+  return regcomp( &re->regex, pattern, WRAP_REGEX_COMPILE_FLAGS );
+#endif /* WITH_PCRE2 */
 }
 
-char const* regex_error( wregex_t *re, int err_code ) {
+char const* regex_error( wregex_t *re, int err_code,
+                         char err_buf[const static REGEX_ERROR_SIZE] ) {
   assert( re != NULL );
-  static char err_buf[ 128 ];
-  PJL_DISCARD_RV( regerror( err_code, re, err_buf, sizeof err_buf ) );
+#ifdef WITH_PCRE2
+  PJL_DISCARD_RV(
+    pcre2_get_error_message(
+      err_code, POINTER_CAST( PCRE2_UCHAR*, err_buf ), REGEX_ERROR_SIZE
+    )
+  );
+#else
+  PJL_DISCARD_RV(
+    regerror( err_code, &re->regex, err_buf, REGEX_ERROR_SIZE )
+  );
+#endif /* WITH_PCRE2 */
   return err_buf;
 }
 
 void regex_free( wregex_t *re ) {
   assert( re != NULL );
-  regfree( re );
+#ifdef WITH_PCRE2
+  pcre2_match_data_free( re->match_data );
+  re->match_data = NULL;
+  if ( !re->is_borrowed )
+    pcre2_code_free( re->code );
+  re->code = NULL;
+#else
+  if ( !re->is_borrowed )
+    regfree( &re->regex );
+#endif /* WITH_PCRE2 */
+  if ( !re->is_borrowed )
+    FREE( re->prefix );
+  re->prefix = NULL;
+  re->prefix_len = 0;
+  re->is_borrowed = false;
 }
 
-bool regex_match( wregex_t *re, char const *s, size_t offset, size_t *range ) {
+bool regex_match( wregex_t *re, char const *s, size_t offset,
+                  regex_words_t *words, size_t *range ) {
   assert( re != NULL );
   assert( s != NULL );
 
   char const *const so = s + offset;
-  regmatch_t match[ re->re_nsub + 1 ];
+  size_t match_so, match_eo;
 
-  int const err_code = regexec( re, so, re->re_nsub + 1, match, /*eflags=*/0 );
+  if ( re->prefix_len > 0 && strncmp( so, re->prefix, re->prefix_len ) != 0 )
+    return false;
+
+#ifdef WITH_PCRE2
+  //
+  // Match against the string starting at so, not s starting at offset, so
+  // ^ matches at so the same as it does for regexec(3).
+  //
+  int const err_code = pcre2_match(
+    re->code, POINTER_CAST( PCRE2_SPTR, so ), PCRE2_ZERO_TERMINATED,
+    /*startoffset=*/0, /*options=*/0, re->match_data, /*mcontext=*/NULL
+  );
+  if ( err_code == PCRE2_ERROR_NOMATCH )
+    return false;
+  if ( err_code < 0 ) {
+    char err_buf[ REGEX_ERROR_SIZE ];
+    fatal_error( EX_SOFTWARE,
+      "regular expression error (%d): %s\n",
+      err_code, regex_error( re, err_code, err_buf )
+    );
+  }
+  PCRE2_SIZE const *const ovector =
+    pcre2_get_ovector_pointer( re->match_data );
+  match_so = ovector[0];
+  match_eo = ovector[1];
+#else
+  //
+  // Ask for only the whole match: regexec(3) then needn't track where each
+  // subexpression matched.
+  //
+  regmatch_t match[1];
+
+  int const err_code = regexec( &re->regex, so, 1, match, /*eflags=*/0 );
 
   if ( err_code == REG_NOMATCH )
     return false;
   if ( err_code < 0 ) {
+    char err_buf[ REGEX_ERROR_SIZE ];
     fatal_error( EX_SOFTWARE,
       "regular expression error (%d): %s\n",
-      err_code, regex_error( re, err_code )
+      err_code, regex_error( re, err_code, err_buf )
     );
   }
-  if ( !is_begin_word_boundary( so, so + match[0].rm_so ) )
+  match_so = STATIC_CAST( size_t, match[0].rm_so );
+  match_eo = STATIC_CAST( size_t, match[0].rm_eo );
+#endif /* WITH_PCRE2 */
+
+  if ( !is_begin_word_boundary( s, offset, match_so + offset, words ) )
     return false;
 
   if ( range != NULL ) {
-    range[0] = STATIC_CAST( size_t, match[0].rm_so ) + offset;
-    range[1] = STATIC_CAST( size_t, match[0].rm_eo ) + offset;
+    range[0] = match_so + offset;
+    range[1] = match_eo + offset;
   }
   return true;
 }
 
+void regex_preset( char const *pattern ) {
+  assert( pattern != NULL );
+  wregex_t re;
+  if ( regex_compile( &re, pattern ) != 0 ) {
+    FREE( re.prefix );                  // reported when compiled for real
+    return;
+  }
+  if ( re.is_borrowed ) {               // already preset
+    regex_free( &re );
+    return;
+  }
+  RUN_ONCE ATEXIT( &regex_presets_cleanup );
+  REALLOC( regex_presets, regex_preset_t, regex_presets_len + 1 );
+  regex_presets[ regex_presets_len++ ] =
+    (regex_preset_t){ .pattern = check_strdup( pattern ), .re = re };
+}
+
+size_t regex_presets_mem( void ) {
+  size_t size = regex_presets_len * sizeof( regex_preset_t );
+  for ( size_t i = 0; i < regex_presets_len; ++i ) {
+    regex_preset_t const *const preset = &regex_presets[i];
+    size_t const pattern_len = strlen( preset->pattern );
+    size += pattern_len + 1;
+    if ( preset->re.prefix != NULL )
+      size += pattern_len;              // as allocated by literal_prefix()
+#ifdef WITH_PCRE2
+    size_t code_size;
+    if ( pcre2_pattern_info( preset->re.code, PCRE2_INFO_SIZE,
+                             &code_size ) == 0 ) {
+      size += code_size;
+    }
+#endif /* WITH_PCRE2 */
+  } // for
+  return size;
+}
+
+void regex_ranges_add( regex_ranges_t *ranges, size_t begin, size_t end ) {
+  assert( ranges != NULL );
+  assert( begin <= end );
+
+  if ( ranges->len > 0 ) {
+    size_t *const last = ranges->range[ ranges->len - 1 ];
+    assert( begin >= last[0] );
+    if ( begin < last[1] ) {
+      if ( end > last[1] )
+        last[1] = end;
+      return;
+    }
+  }
+  if ( ranges->len == ranges->cap ) {
+    ranges->cap = ranges->cap == 0 ? 4 : ranges->cap * 2;
+    REALLOC( ranges->range, size_t[2], ranges->cap );
+  }
+  ranges->range[ ranges->len ][0] = begin;
+  ranges->range[ ranges->len ][1] = end;
+  ++ranges->len;
+}
+
+void regex_ranges_cleanup( regex_ranges_t *ranges ) {
+  assert( ranges != NULL );
+  FREE( ranges->range );
+  ranges->range = NULL;
+  ranges->cap = ranges->len = 0;
+}
+
+bool regex_wrap_re_match( char const *s, size_t offset, regex_words_t *words,
+                          size_t *range ) {
+  extern uint16_t const WRAP_RE_DFA[][ WRAP_RE_DFA_CLASSES ];
+  assert( s != NULL );
+
+  //
+  // Find the leftmost-longest match as regexec(3) would, i.e., the longest
+  // match starting at the first position where there's any.  Since no match
+  // contains whitespace, only words that are candidates need be tried.
+  //
+  // Running the DFA from each position of a word in turn would be quadratic
+  // in the length of the word when runs go far before dying (e.g., "a-a-...-a"
+  // that looks like the start of an e-mail address), so instead it's run from
+  // every position at once as a "thread" per position.  Threads in the same
+  // state have the same future, so only the one that began first is kept:
+  // hence there are never more threads than states and each character is
+  // classified only once.  There are usually only a few threads, so finding
+  // one already in a state is done by searching them until there are more
+  // than \ref WRAP_RE_DFA_SCAN_MAX; only then is th_seen needed.
+  //
+  size_t    th_begin[ WRAP_RE_DFA_STATES ]; // Where each thread began.
+  uint16_t  th_state[ WRAP_RE_DFA_STATES ]; // The current state of each.
+  size_t    th_seen[ WRAP_RE_DFA_STATES ];  // 1 + where a state was reached.
+  bool      th_seen_zeroed = false;
+
+  for ( size_t word = offset; wrap_re_candidate( s, &word ); ) {
+    size_t begin = 0, end = 0, n_th = 0, word_end = 0;
+    for ( size_t i = word;; ) {
+      if ( word_end == 0 && (s[i] == '\0' || is_space( s[i] )) )
+        word_end = i;
+      if ( word_end == 0 && end == 0 ) {
+        th_begin[ n_th ] = i;
+        th_state[ n_th++ ] = 1;
+      }
+      if ( n_th == 0 )
+        break;
+
+      bool const use_seen = n_th > WRAP_RE_DFA_SCAN_MAX;
+      if ( use_seen && !th_seen_zeroed ) {
+        MEM_ZERO( &th_seen );
+        th_seen_zeroed = true;
+      }
+
+      size_t len;
+      unsigned const sym = wrap_re_class( s + i, &len );
+      size_t n = 0;
+      for ( size_t t = 0; t < n_th; ++t ) {
+        unsigned state = WRAP_RE_DFA[ th_state[t] ][ sym ];
+        if ( state == 0 )
+          continue;
+        bool const is_accept = (state & WRAP_RE_DFA_ACCEPT) != 0;
+        state &= ~WRAP_RE_DFA_ACCEPT;
+        if ( use_seen ) {
+          if ( th_seen[ state ] == i + 1 )
+            continue;                   // an earlier thread is in state
+          th_seen[ state ] = i + 1;
+        }
+        else if ( wrap_re_thread_in( th_state, n, state ) ) {
+          continue;                     // ditto
+        }
+        if ( end > 0 && th_begin[t] > begin )
+          continue;                     // can't be leftmost
+        if ( is_accept ) {
+          begin = th_begin[t];
+          end = i + len;
+        }
+        th_begin[ n ] = th_begin[t];
+        th_state[ n++ ] = STATIC_CAST( uint16_t, state );
+      } // for
+      n_th = n;
+      i += len;
+    } // for
+
+    if ( end > 0 ) {
+      if ( !is_begin_word_boundary( s, offset, begin, words ) )
+        return false;
+      if ( range != NULL ) {
+        range[0] = begin;
+        range[1] = end;
+      }
+      return true;
+    }
+    word = word_end;
+  } // for
+
+  return false;
+}
+
+size_t regex_wrap_re_match_all( char const *s, regex_words_t *words,
+                                regex_ranges_t *ranges ) {
+  assert( s != NULL );
+  assert( ranges != NULL );
+
+  ranges->len = 0;
+  for ( size_t offset = 0;; ) {
+    size_t range[2];
+    if ( !regex_wrap_re_match( s, offset, words, range ) )
+      break;
+    regex_ranges_add( ranges, range[0], range[1] );
+    offset = range[1];
+  } // for
+  return ranges->len;
+}
+
+void regex_words_cleanup( regex_words_t *words ) {
+  assert( words != NULL );
+  FREE( words->bits );
+  words->bits = NULL;
+  words->cap = words->len = 0;
+  words->prev = 0;
+}
+
+void regex_words_reset( regex_words_t *words ) {
+  assert( words != NULL );
+  if ( words->len > 0 ) {
+    memset( words->bits, 0, ((words->len + 63) >> 6) * sizeof( uint64_t ) );
+    words->len = 0;
+    words->prev = 0;
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /* vim:set et sw=2 ts=2: */
@@ -24,16 +24,23 @@
 /**
  * @file
  * Declares macros for e-mail and URI regular expressions as well as a wrapper
- * API around POSIX regex (that could easily be swapped out for, say, PCRE2).
+ * API around either POSIX regex or, if configured `--with-pcre2`, PCRE2.
  */
 
 // local
 #include "pjl_config.h"                 /* must go first */
+#include "unicode.h"
 
 // standard
+#ifdef WITH_PCRE2
+#define PCRE2_CODE_UNIT_WIDTH 8
+#include <pcre2.h>
+#else
 #include <regex.h>
+#endif /* WITH_PCRE2 */
 #include <stdbool.h>
 #include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint64_t */
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -115,12 +122,80 @@
   "(" WRAP_RE_FTP_URI ")"   "|"   \
   "(" WRAP_RE_HTTP_URI ")"
 
-typedef regex_t wregex_t;
+/**
+ * Size of a buffer for regex_error().
+ */
+#define REGEX_ERROR_SIZE          128
+
+/**
+ * The bit of a next state of \ref WRAP_RE_DFA that is set only if the state
+ * is accepting.
+ */
+#define WRAP_RE_DFA_ACCEPT        0x8000u
+
+/**
+ * The number of symbol classes of \ref WRAP_RE_DFA.
+ */
+#define WRAP_RE_DFA_CLASSES       28
+
+/**
+ * The number of states of \ref WRAP_RE_DFA.
+ */
+#define WRAP_RE_DFA_STATES        1011
+
+/**
+ * A compiled regular expression.
+ */
+struct wregex {
+#ifdef WITH_PCRE2
+  pcre2_code       *code;               ///< Compiled (and JIT-compiled) code.
+  pcre2_match_data *match_data;         ///< Result of the last match.
+#else
+  regex_t           regex;              ///< Compiled code.
+#endif /* WITH_PCRE2 */
+  char             *prefix;             ///< Literal prefix of `^` pattern.
+  size_t            prefix_len;         ///< Length of \a prefix or 0 if none.
+  bool              is_borrowed;        ///< Code is from regex_preset()?
+};
+typedef struct wregex wregex_t;
+
+/**
+ * Where words begin within a line, computed from the table of Unicode
+ * properties at most once per line (and only as far as needed) by
+ * regex_match() when checking whether a match begins a word.
+ *
+ * @sa regex_words_cleanup()
+ * @sa regex_words_reset()
+ */
+struct regex_words {
+  uint64_t  *bits;                      ///< Bit _i_ set if word begins at _i_.
+  size_t     cap;                       ///< Number of bytes \a bits covers.
+  size_t     len;                       ///< Number of bytes classified so far.
+  cp_props_t prev;                      ///< Properties of character before.
+};
+typedef struct regex_words regex_words_t;
+
+/**
+ * Ranges of a string that matched, in order.
+ *
+ * @sa regex_ranges_add()
+ * @sa regex_ranges_cleanup()
+ * @sa regex_wrap_re_match_all()
+ */
+struct regex_ranges {
+  size_t   (*range)[2];                 ///< Beginning and one past end pairs.
+  size_t     len;                       ///< Number of ranges.
+  size_t     cap;                       ///< Capacity of \a range.
+};
+typedef struct regex_ranges regex_ranges_t;
 
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
- * Compiles a regular expression pattern.
+ * Compiles a regular expression pattern.  If \a pattern begins with `^` and
+ * then literal characters, they're remembered so regex_match() can quickly
+ * reject a string not starting with them without running the matcher.  If
+ * \a pattern was compiled by regex_preset(), borrows its code instead.
  *
  * @param re A pointer to the wregex_t to compile to.
  * @param pattern The regular expression pattern to compile.
@@ -134,10 +209,12 @@ int regex_compile( wregex_t *re, char const *pattern );
  *
  * @param re The wregex_t involved in the error.
  * @param err_code The error code.
- * @return Returns a pointer to a static buffer containing the error message.
+ * @param err_buf The buffer to put the error message into.
+ * @return Returns \a err_buf.
  */
 NODISCARD
-char const* regex_error( wregex_t *re, int err_code );
+char const* regex_error( wregex_t *re, int err_code,
+                         char err_buf[const static REGEX_ERROR_SIZE] );
 
 /**
  * Frees all memory used by a wregex_t.
@@ -153,6 +230,8 @@ void regex_free( wregex_t *re );
  * @param re A pointer to the wregex_t to match against.
  * @param s The string to match.
  * @param offset The offset into \a s to start.
+ * @param words A pointer to the \ref regex_words for \a s to use and update
+ * or NULL if \a s is matched against only once.
  * @param range A pointer to an array of size 2 to receive the beginning
  * position and one past the end position of the match -- set only if not NULL
  * and there was a match.
@@ -160,7 +239,98 @@ void regex_free( wregex_t *re );
  */
 NODISCARD
 bool regex_match( wregex_t *re, char const *s, size_t offset,
-                  size_t *range );
+                  regex_words_t *words, size_t *range );
+
+/**
+ * Compiles a regular expression pattern once so that regex_compile() of the
+ * same pattern, including in any process forked afterwards, just borrows the
+ * compiled code rather than compiling it again.  An invalid \a pattern is
+ * ignored here since it's reported by regex_compile().
+ *
+ * @param pattern The regular expression pattern to compile.
+ */
+void regex_preset( char const *pattern );
+
+/**
+ * Gets the number of bytes of heap memory used by the regular expressions
+ * compiled by regex_preset().  Their compiled code is included only when
+ * compiled by PCRE2 since POSIX doesn't say how big it is.
+ *
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t regex_presets_mem( void );
+
+/**
+ * Attempts to match \a s against #WRAP_RE.  This is equivalent to, but much
+ * faster than, regex_match() with #WRAP_RE compiled since it instead uses a
+ * DFA generated from #WRAP_RE by `mkwregex.py`.
+ *
+ * @param s The string to match.
+ * @param offset The offset into \a s to start.
+ * @param words A pointer to the \ref regex_words for \a s to use and update
+ * or NULL if \a s is matched against only once.
+ * @param range A pointer to an array of size 2 to receive the beginning
+ * position and one past the end position of the match -- set only if not NULL
+ * and there was a match.
+ * @return Returns `true` only if there was a match.
+ */
+NODISCARD
+bool regex_wrap_re_match( char const *s, size_t offset, regex_words_t *words,
+                          size_t *range );
+
+/**
+ * Matches \a s against #WRAP_RE as many times as possible: first from the
+ * beginning of \a s, then from the end of each match.  This is equivalent to
+ * calling regex_wrap_re_match() repeatedly, but in a single pass.
+ *
+ * @param s The string to match.
+ * @param words A pointer to the \ref regex_words for \a s to use and update.
+ * @param ranges A pointer to the \ref regex_ranges to receive the ranges of
+ * all the matches.
+ * @return Returns the number of matches.
+ *
+ * @sa regex_ranges_cleanup()
+ */
+PJL_DISCARD
+size_t regex_wrap_re_match_all( char const *s, regex_words_t *words,
+                                regex_ranges_t *ranges );
+
+/**
+ * Appends a range to \a ranges or, if it begins before the end of the last
+ * range, extends the last range by it.
+ *
+ * @param ranges A pointer to the \ref regex_ranges to append to.
+ * @param begin The beginning position of the range.  It must be no less than
+ * that of the last range.
+ * @param end One past the end position of the range.
+ */
+void regex_ranges_add( regex_ranges_t *ranges, size_t begin, size_t end );
+
+/**
+ * Frees all memory used by a \ref regex_ranges.
+ *
+ * @param ranges A pointer to the \ref regex_ranges to free.
+ */
+void regex_ranges_cleanup( regex_ranges_t *ranges );
+
+/**
+ * Frees all memory used by a \ref regex_words.
+ *
+ * @param words A pointer to the \ref regex_words to free.
+ *
+ * @sa regex_words_reset()
+ */
+void regex_words_cleanup( regex_words_t *words );
+
+/**
+ * Resets a \ref regex_words so it can be used for a new string.
+ *
+ * @param words A pointer to the \ref regex_words to reset.
+ *
+ * @sa regex_words_cleanup()
+ */
+void regex_words_reset( regex_words_t *words );
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,3132 @@
+/*
+**      wrap -- text reformatter
+**      src/wregex_tables.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines the tables of a DFA that recognizes #WRAP_RE.
+ *
+ * @note This file was generated by `mkwregex.py` from the macros in
+ * `wregex.h`; don't edit it by hand.  To regenerate it, do `make
+ * wregex-tables`.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#include "wregex.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <stdint.h>                     /* for uint8_t, uint16_t */
+
+/// @endcond
+
+///////////////////////////////////////////////////////////////////////////////
+
+static_assert( WRAP_RE_DFA_ACCEPT == 0x8000u, "regenerate table" );
+static_assert( WRAP_RE_DFA_CLASSES == 28, "regenerate table" );
+static_assert( WRAP_RE_DFA_STATES == 1011, "regenerate table" );
+static_assert( sizeof WRAP_RE == 1008, "regenerate table" );
+
+/**
+ * The #WRAP_RE the tables were generated from so a stale build can be caught
+ * at run-time if \c sizeof #WRAP_RE didn't change.
+ */
+char const WRAP_RE_DFA_PATTERN[] =
+  "((mailto:)?[[:alnum:]!#$%&'*+/=?^_`{|}~-]([\\.[:alnum:]!#$%&'*+/=?^_`{|}"
+  "~-]*[[:alnum:]!#$%&'*+/=?^_`{|}~-])?@[[:alnum:]]([[:alnum:]-]{0,61}[[:al"
+  "num:]])?(\\.[[:alnum:]]([[:alnum:]-]{0,61}[[:alnum:]])?)*\\.[[:alnum:]]{"
+  "2,63})|(file:(//(([!$&'()*+,;=:[:alnum:]._~-]|%([[:xdigit:]]{2}|%))+@)?("
+  "[[:alnum:]]([[:alnum:]-]{0,61}[[:alnum:]])?)?)?/([!$&'()*+,;=/:@[:alnum:"
+  "]._~-]|%([[:xdigit:]]{2}|%))*)|(ftp://(([!$&'()*+,;=:[:alnum:]._~-]|%([["
+  ":xdigit:]]{2}|%))+@)?[[:alnum:]]([[:alnum:]-]{0,61}[[:alnum:]])?(\\.[[:a"
+  "lnum:]]([[:alnum:]-]{0,61}[[:alnum:]])?)*\\.[[:alnum:]]{2,63}(:[1-9][0-9"
+  "]{1,4})?(/([!$&'()*+,;=/:@[:alnum:]._~-]|%([[:xdigit:]]{2}|%))*)?)|(http"
+  "s?://(([!$&'()*+,;=:[:alnum:]._~-]|%([[:xdigit:]]{2}|%))+@)?[[:alnum:]]("
+  "[[:alnum:]-]{0,61}[[:alnum:]])?(\\.[[:alnum:]]([[:alnum:]-]{0,61}[[:alnu"
+  "m:]])?)*\\.[[:alnum:]]{2,63}(:[1-9][0-9]{1,4})?(/([!$&'()*+,;=/:@[:alnum"
+  ":]._~-]|%([[:xdigit:]]{2}|%))*)?(\\?([!$&'()*+,;=/:?@[:alnum:]._~-]|%([["
+  ":xdigit:]]{2}|%))*)?(#([!$&'()*+,;=/:?@[:alnum:]._~-]|%([[:xdigit:]]{2}|"
+  "%))*)?)";
+
+/**
+ * The \ref WRAP_RE_DFA symbol class of each ASCII character.
+ */
+uint8_t const WRAP_RE_DFA_ASCII[] = {
+  /*       0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F */
+  /* 0 */   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  /* 1 */   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  /* 2 */   0,  1,  0,  2,  1,  3,  1,  1,  4,  4,  1,  1,  4,  5,  6,  7,
+  /* 3 */   8,  9,  9,  9,  9,  9,  9,  9,  9,  9, 10,  4,  0,  1,  0, 11,
+  /* 4 */  12, 13, 13, 13, 13, 13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+  /* 5 */  14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,  0, 15,  0, 16,  1,
+  /* 6 */  16, 17, 13, 13, 13, 18, 19, 14, 20, 21, 14, 14, 22, 23, 14, 24,
+  /* 7 */  25, 14, 14, 26, 27, 14, 14, 14, 14, 14, 14, 16, 16, 16,  1,  0
+};
+
+/**
+ * The \ref WRAP_RE_DFA symbol class of non-ASCII alphanumeric characters.
+ */
+uint8_t const WRAP_RE_DFA_ALNUM = 14;
+
+/**
+ * The DFA that recognizes #WRAP_RE: indexed by state and symbol class, gives
+ * the next state.  State 0 is dead; state 1 is the start.  A next state has
+ * #WRAP_RE_DFA_ACCEPT set only if it is accepting.
+ */
+uint16_t const WRAP_RE_DFA[][ WRAP_RE_DFA_CLASSES ] = {
+  /*    0 */ {     0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*    1 */ {     0,    2,    2,    2,    0,    2,    0,    2,    2,    2,
+                   0,    2,    0,    2,    2,    0,    2,    2,    2,    3,
+                   4,    2,    2,    5,    2,    2,    2,    2 },
+  /*    2 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*    3 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    8,    2,    2,    2,    2,    2,    9 },
+  /*    4 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,   10 },
+  /*    5 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,   11,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*    6 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    0,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*    7 */ {     0,    0,    0,    0,    0,    0,    0,    0,   12,   12,
+                   0,    0,    0,   12,   12,    0,    0,   12,   12,   12,
+                  12,   12,   12,   12,   12,   12,   12,   12 },
+  /*    8 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,   13,    2,    2,    2,    2,    2 },
+  /*    9 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,   14,    2,    2 },
+  /*   10 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,   15 },
+  /*   11 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,   16,    2,    2,    2,    2,    2,    2 },
+  /*   12 */ {     0,    0,    0,    0,    0,   17,   18,    0,   19,   19,
+                   0,    0,    0,   19,   19,    0,    0,   19,   19,   19,
+                  19,   19,   19,   19,   19,   19,   19,   19 },
+  /*   13 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,   20,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*   14 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                  21,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*   15 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,   22,    2,    2 },
+  /*   16 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,   23,    2,    2,    2,    2,    2 },
+  /*   17 */ {     0,    0,    0,    0,    0,   24,    0,    0,   25,   25,
+                   0,    0,    0,   25,   25,    0,    0,   25,   25,   25,
+                  25,   25,   25,   25,   25,   25,   25,   25 },
+  /*   18 */ {     0,    0,    0,    0,    0,    0,    0,    0,   26,   26,
+                   0,    0,    0,   26,   26,    0,    0,   26,   26,   26,
+                  26,   26,   26,   26,   26,   26,   26,   26 },
+  /*   19 */ {     0,    0,    0,    0,    0,   24,   18,    0,   25,   25,
+                   0,    0,    0,   25,   25,    0,    0,   25,   25,   25,
+                  25,   25,   25,   25,   25,   25,   25,   25 },
+  /*   20 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                  27,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*   21 */ {     0,    0,    0,    0,    0,    0,    0,   28,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   22 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                  29,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,   30,    2 },
+  /*   23 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,   31 },
+  /*   24 */ {     0,    0,    0,    0,    0,   32,    0,    0,   33,   33,
+                   0,    0,    0,   33,   33,    0,    0,   33,   33,   33,
+                  33,   33,   33,   33,   33,   33,   33,   33 },
+  /*   25 */ {     0,    0,    0,    0,    0,   32,   18,    0,   33,   33,
+                   0,    0,    0,   33,   33,    0,    0,   33,   33,   33,
+                  33,   33,   33,   33,   33,   33,   33,   33 },
+  /*   26 */ {     0,    0,    0,    0,    0,   17,   18,    0,32802,32802,
+                   0,    0,    0,32802,32802,    0,    0,32802,32802,32802,
+               32802,32802,32802,32802,32802,32802,32802,32802 },
+  /*   27 */ {     0,    0,    0,    0,    0,    0,    0,32803,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   28 */ {     0,    0,    0,    0,    0,    0,    0,   36,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   29 */ {     0,    0,    0,    0,    0,    0,    0,   37,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   30 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                  29,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*   31 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                   0,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,   38,    2,    2,    2 },
+  /*   32 */ {     0,    0,    0,    0,    0,   39,    0,    0,   40,   40,
+                   0,    0,    0,   40,   40,    0,    0,   40,   40,   40,
+                  40,   40,   40,   40,   40,   40,   40,   40 },
+  /*   33 */ {     0,    0,    0,    0,    0,   39,   18,    0,   40,   40,
+                   0,    0,    0,   40,   40,    0,    0,   40,   40,   40,
+                  40,   40,   40,   40,   40,   40,   40,   40 },
+  /*   34 */ {     0,    0,    0,    0,    0,   24,   18,    0,32809,32809,
+                   0,    0,    0,32809,32809,    0,    0,32809,32809,32809,
+               32809,32809,32809,32809,32809,32809,32809,32809 },
+  /*   35 */ {     0,32803,    0,   42,32803,32803,32803,32803,32803,32803,
+               32803,    0,32803,32803,32803,    0,    0,32803,32803,32803,
+               32803,32803,32803,32803,32803,32803,32803,32803 },
+  /*   36 */ {     0,   43,    0,   44,   43,   43,   43,    0,   45,   45,
+                  43,    0,    0,   45,   45,    0,    0,   45,   45,   45,
+                  45,   45,   45,   45,   45,   45,   45,   45 },
+  /*   37 */ {     0,    0,    0,    0,    0,    0,    0,   46,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   38 */ {     0,    2,    2,    2,    0,    2,    6,    2,    2,    2,
+                  47,    2,    7,    2,    2,    6,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*   39 */ {     0,    0,    0,    0,    0,   48,    0,    0,   49,   49,
+                   0,    0,    0,   49,   49,    0,    0,   49,   49,   49,
+                  49,   49,   49,   49,   49,   49,   49,   49 },
+  /*   40 */ {     0,    0,    0,    0,    0,   48,   18,    0,   49,   49,
+                   0,    0,    0,   49,   49,    0,    0,   49,   49,   49,
+                  49,   49,   49,   49,   49,   49,   49,   49 },
+  /*   41 */ {     0,    0,    0,    0,    0,   32,   18,    0,32818,32818,
+                   0,    0,    0,32818,32818,    0,    0,32818,32818,32818,
+               32818,32818,32818,32818,32818,32818,32818,32818 },
+  /*   42 */ {     0,    0,    0,32803,    0,    0,    0,    0,   51,   51,
+                   0,    0,    0,   51,    0,    0,    0,   51,   51,   51,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   43 */ {     0,   43,    0,   44,   43,   43,   43,    0,   43,   43,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*   44 */ {     0,    0,    0,   43,    0,    0,    0,    0,   53,   53,
+                   0,    0,    0,   53,    0,    0,    0,   53,   53,   53,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   45 */ {     0,   43,    0,   44,   43,   54,   55,    0,   56,   56,
+                  43,    0,   52,   56,   56,    0,    0,   56,   56,   56,
+                  56,   56,   56,   56,   56,   56,   56,   56 },
+  /*   46 */ {     0,   57,    0,   58,   57,   57,   57,    0,   59,   59,
+                  57,    0,    0,   59,   59,    0,    0,   59,   59,   59,
+                  59,   59,   59,   59,   59,   59,   59,   59 },
+  /*   47 */ {     0,    2,    2,    2,    0,    2,    0,    2,    2,    2,
+                   0,    2,    0,    2,    2,    0,    2,    2,    2,    2,
+                   2,    2,    2,    2,    2,    2,    2,    2 },
+  /*   48 */ {     0,    0,    0,    0,    0,   60,    0,    0,   61,   61,
+                   0,    0,    0,   61,   61,    0,    0,   61,   61,   61,
+                  61,   61,   61,   61,   61,   61,   61,   61 },
+  /*   49 */ {     0,    0,    0,    0,    0,   60,   18,    0,   61,   61,
+                   0,    0,    0,   61,   61,    0,    0,   61,   61,   61,
+                  61,   61,   61,   61,   61,   61,   61,   61 },
+  /*   50 */ {     0,    0,    0,    0,    0,   39,   18,    0,32830,32830,
+                   0,    0,    0,32830,32830,    0,    0,32830,32830,32830,
+               32830,32830,32830,32830,32830,32830,32830,32830 },
+  /*   51 */ {     0,    0,    0,    0,    0,    0,    0,    0,32803,32803,
+                   0,    0,    0,32803,    0,    0,    0,32803,32803,32803,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   52 */ {     0,    0,    0,    0,    0,    0,    0,    0,   63,   63,
+                   0,    0,    0,   63,   63,    0,    0,   63,   63,   63,
+                  63,   63,   63,   63,   63,   63,   63,   63 },
+  /*   53 */ {     0,    0,    0,    0,    0,    0,    0,    0,   43,   43,
+                   0,    0,    0,   43,    0,    0,    0,   43,   43,   43,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   54 */ {     0,   43,    0,   44,   43,   64,   43,    0,   65,   65,
+                  43,    0,   52,   65,   65,    0,    0,   65,   65,   65,
+                  65,   65,   65,   65,   65,   65,   65,   65 },
+  /*   55 */ {     0,   43,    0,   44,   43,   43,   43,    0,   66,   66,
+                  43,    0,   52,   66,   66,    0,    0,   66,   66,   66,
+                  66,   66,   66,   66,   66,   66,   66,   66 },
+  /*   56 */ {     0,   43,    0,   44,   43,   64,   55,    0,   65,   65,
+                  43,    0,   52,   65,   65,    0,    0,   65,   65,   65,
+                  65,   65,   65,   65,   65,   65,   65,   65 },
+  /*   57 */ {     0,   57,    0,   58,   57,   57,   57,    0,   57,   57,
+                  57,    0,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*   58 */ {     0,    0,    0,   57,    0,    0,    0,    0,   68,   68,
+                   0,    0,    0,   68,    0,    0,    0,   68,   68,   68,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   59 */ {     0,   57,    0,   58,   57,   69,   70,    0,   71,   71,
+                  57,    0,   67,   71,   71,    0,    0,   71,   71,   71,
+                  71,   71,   71,   71,   71,   71,   71,   71 },
+  /*   60 */ {     0,    0,    0,    0,    0,   72,    0,    0,   73,   73,
+                   0,    0,    0,   73,   73,    0,    0,   73,   73,   73,
+                  73,   73,   73,   73,   73,   73,   73,   73 },
+  /*   61 */ {     0,    0,    0,    0,    0,   72,   18,    0,   73,   73,
+                   0,    0,    0,   73,   73,    0,    0,   73,   73,   73,
+                  73,   73,   73,   73,   73,   73,   73,   73 },
+  /*   62 */ {     0,    0,    0,    0,    0,   48,   18,    0,32842,32842,
+                   0,    0,    0,32842,32842,    0,    0,32842,32842,32842,
+               32842,32842,32842,32842,32842,32842,32842,32842 },
+  /*   63 */ {     0,    0,    0,    0,    0,   75,   76,    0,   77,   77,
+                   0,    0,    0,   77,   77,    0,    0,   77,   77,   77,
+                  77,   77,   77,   77,   77,   77,   77,   77 },
+  /*   64 */ {     0,   43,    0,   44,   43,   78,   43,    0,   79,   79,
+                  43,    0,   52,   79,   79,    0,    0,   79,   79,   79,
+                  79,   79,   79,   79,   79,   79,   79,   79 },
+  /*   65 */ {     0,   43,    0,   44,   43,   78,   55,    0,   79,   79,
+                  43,    0,   52,   79,   79,    0,    0,   79,   79,   79,
+                  79,   79,   79,   79,   79,   79,   79,   79 },
+  /*   66 */ {     0,   43,    0,   44,   43,   54,   55,    0,32848,32848,
+                  43,    0,   52,32848,32848,    0,    0,32848,32848,32848,
+               32848,32848,32848,32848,32848,32848,32848,32848 },
+  /*   67 */ {     0,    0,    0,    0,    0,    0,    0,    0,   81,   81,
+                   0,    0,    0,   81,   81,    0,    0,   81,   81,   81,
+                  81,   81,   81,   81,   81,   81,   81,   81 },
+  /*   68 */ {     0,    0,    0,    0,    0,    0,    0,    0,   57,   57,
+                   0,    0,    0,   57,    0,    0,    0,   57,   57,   57,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*   69 */ {     0,   57,    0,   58,   57,   82,   57,    0,   83,   83,
+                  57,    0,   67,   83,   83,    0,    0,   83,   83,   83,
+                  83,   83,   83,   83,   83,   83,   83,   83 },
+  /*   70 */ {     0,   57,    0,   58,   57,   57,   57,    0,   84,   84,
+                  57,    0,   67,   84,   84,    0,    0,   84,   84,   84,
+                  84,   84,   84,   84,   84,   84,   84,   84 },
+  /*   71 */ {     0,   57,    0,   58,   57,   82,   70,    0,   83,   83,
+                  57,    0,   67,   83,   83,    0,    0,   83,   83,   83,
+                  83,   83,   83,   83,   83,   83,   83,   83 },
+  /*   72 */ {     0,    0,    0,    0,    0,   85,    0,    0,   86,   86,
+                   0,    0,    0,   86,   86,    0,    0,   86,   86,   86,
+                  86,   86,   86,   86,   86,   86,   86,   86 },
+  /*   73 */ {     0,    0,    0,    0,    0,   85,   18,    0,   86,   86,
+                   0,    0,    0,   86,   86,    0,    0,   86,   86,   86,
+                  86,   86,   86,   86,   86,   86,   86,   86 },
+  /*   74 */ {     0,    0,    0,    0,    0,   60,   18,    0,32855,32855,
+                   0,    0,    0,32855,32855,    0,    0,32855,32855,32855,
+               32855,32855,32855,32855,32855,32855,32855,32855 },
+  /*   75 */ {     0,    0,    0,    0,    0,   88,    0,    0,   89,   89,
+                   0,    0,    0,   89,   89,    0,    0,   89,   89,   89,
+                  89,   89,   89,   89,   89,   89,   89,   89 },
+  /*   76 */ {     0,    0,    0,    0,    0,    0,    0,    0,   90,   90,
+                   0,    0,    0,   90,   90,    0,    0,   90,   90,   90,
+                  90,   90,   90,   90,   90,   90,   90,   90 },
+  /*   77 */ {     0,    0,    0,    0,    0,   88,   76,    0,   89,   89,
+                   0,    0,    0,   89,   89,    0,    0,   89,   89,   89,
+                  89,   89,   89,   89,   89,   89,   89,   89 },
+  /*   78 */ {     0,   43,    0,   44,   43,   91,   43,    0,   92,   92,
+                  43,    0,   52,   92,   92,    0,    0,   92,   92,   92,
+                  92,   92,   92,   92,   92,   92,   92,   92 },
+  /*   79 */ {     0,   43,    0,   44,   43,   91,   55,    0,   92,   92,
+                  43,    0,   52,   92,   92,    0,    0,   92,   92,   92,
+                  92,   92,   92,   92,   92,   92,   92,   92 },
+  /*   80 */ {     0,   43,    0,   44,   43,   64,   55,32803,32861,32861,
+                  94,    0,   52,32861,32861,    0,    0,32861,32861,32861,
+               32861,32861,32861,32861,32861,32861,32861,32861 },
+  /*   81 */ {     0,    0,    0,    0,    0,   95,   96,    0,   97,   97,
+                   0,    0,    0,   97,   97,    0,    0,   97,   97,   97,
+                  97,   97,   97,   97,   97,   97,   97,   97 },
+  /*   82 */ {     0,   57,    0,   58,   57,   98,   57,    0,   99,   99,
+                  57,    0,   67,   99,   99,    0,    0,   99,   99,   99,
+                  99,   99,   99,   99,   99,   99,   99,   99 },
+  /*   83 */ {     0,   57,    0,   58,   57,   98,   70,    0,   99,   99,
+                  57,    0,   67,   99,   99,    0,    0,   99,   99,   99,
+                  99,   99,   99,   99,   99,   99,   99,   99 },
+  /*   84 */ {     0,   57,    0,   58,   57,   69,   70,    0,32868,32868,
+                  57,    0,   67,32868,32868,    0,    0,32868,32868,32868,
+               32868,32868,32868,32868,32868,32868,32868,32868 },
+  /*   85 */ {     0,    0,    0,    0,    0,  101,    0,    0,  102,  102,
+                   0,    0,    0,  102,  102,    0,    0,  102,  102,  102,
+                 102,  102,  102,  102,  102,  102,  102,  102 },
+  /*   86 */ {     0,    0,    0,    0,    0,  101,   18,    0,  102,  102,
+                   0,    0,    0,  102,  102,    0,    0,  102,  102,  102,
+                 102,  102,  102,  102,  102,  102,  102,  102 },
+  /*   87 */ {     0,    0,    0,    0,    0,   72,   18,    0,32871,32871,
+                   0,    0,    0,32871,32871,    0,    0,32871,32871,32871,
+               32871,32871,32871,32871,32871,32871,32871,32871 },
+  /*   88 */ {     0,    0,    0,    0,    0,  104,    0,    0,  105,  105,
+                   0,    0,    0,  105,  105,    0,    0,  105,  105,  105,
+                 105,  105,  105,  105,  105,  105,  105,  105 },
+  /*   89 */ {     0,    0,    0,    0,    0,  104,   76,    0,  105,  105,
+                   0,    0,    0,  105,  105,    0,    0,  105,  105,  105,
+                 105,  105,  105,  105,  105,  105,  105,  105 },
+  /*   90 */ {     0,    0,    0,    0,    0,   75,   76,    0,32874,32874,
+                   0,    0,    0,32874,32874,    0,    0,32874,32874,32874,
+               32874,32874,32874,32874,32874,32874,32874,32874 },
+  /*   91 */ {     0,   43,    0,   44,   43,  107,   43,    0,  108,  108,
+                  43,    0,   52,  108,  108,    0,    0,  108,  108,  108,
+                 108,  108,  108,  108,  108,  108,  108,  108 },
+  /*   92 */ {     0,   43,    0,   44,   43,  107,   55,    0,  108,  108,
+                  43,    0,   52,  108,  108,    0,    0,  108,  108,  108,
+                 108,  108,  108,  108,  108,  108,  108,  108 },
+  /*   93 */ {     0,   43,    0,   44,   43,   78,   55,32803,32877,32877,
+                  94,    0,   52,32877,32877,    0,    0,32877,32877,32877,
+               32877,32877,32877,32877,32877,32877,32877,32877 },
+  /*   94 */ {     0,   43,    0,   44,   43,   43,   43,    0,   43,  110,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*   95 */ {     0,    0,    0,    0,    0,  111,    0,    0,  112,  112,
+                   0,    0,    0,  112,  112,    0,    0,  112,  112,  112,
+                 112,  112,  112,  112,  112,  112,  112,  112 },
+  /*   96 */ {     0,    0,    0,    0,    0,    0,    0,    0,  113,  113,
+                   0,    0,    0,  113,  113,    0,    0,  113,  113,  113,
+                 113,  113,  113,  113,  113,  113,  113,  113 },
+  /*   97 */ {     0,    0,    0,    0,    0,  111,   96,    0,  112,  112,
+                   0,    0,    0,  112,  112,    0,    0,  112,  112,  112,
+                 112,  112,  112,  112,  112,  112,  112,  112 },
+  /*   98 */ {     0,   57,    0,   58,   57,  114,   57,    0,  115,  115,
+                  57,    0,   67,  115,  115,    0,    0,  115,  115,  115,
+                 115,  115,  115,  115,  115,  115,  115,  115 },
+  /*   99 */ {     0,   57,    0,   58,   57,  114,   70,    0,  115,  115,
+                  57,    0,   67,  115,  115,    0,    0,  115,  115,  115,
+                 115,  115,  115,  115,  115,  115,  115,  115 },
+  /*  100 */ {     0,   57,32884,   58,   57,   82,   70,32885,32886,32886,
+                 119,32885,   67,32886,32886,    0,    0,32886,32886,32886,
+               32886,32886,32886,32886,32886,32886,32886,32886 },
+  /*  101 */ {     0,    0,    0,    0,    0,  120,    0,    0,  121,  121,
+                   0,    0,    0,  121,  121,    0,    0,  121,  121,  121,
+                 121,  121,  121,  121,  121,  121,  121,  121 },
+  /*  102 */ {     0,    0,    0,    0,    0,  120,   18,    0,  121,  121,
+                   0,    0,    0,  121,  121,    0,    0,  121,  121,  121,
+                 121,  121,  121,  121,  121,  121,  121,  121 },
+  /*  103 */ {     0,    0,    0,    0,    0,   85,   18,    0,32890,32890,
+                   0,    0,    0,32890,32890,    0,    0,32890,32890,32890,
+               32890,32890,32890,32890,32890,32890,32890,32890 },
+  /*  104 */ {     0,    0,    0,    0,    0,  123,    0,    0,  124,  124,
+                   0,    0,    0,  124,  124,    0,    0,  124,  124,  124,
+                 124,  124,  124,  124,  124,  124,  124,  124 },
+  /*  105 */ {     0,    0,    0,    0,    0,  123,   76,    0,  124,  124,
+                   0,    0,    0,  124,  124,    0,    0,  124,  124,  124,
+                 124,  124,  124,  124,  124,  124,  124,  124 },
+  /*  106 */ {     0,    0,    0,    0,    0,   88,   76,32803,32893,32893,
+                 126,    0,    0,32893,32893,    0,    0,32893,32893,32893,
+               32893,32893,32893,32893,32893,32893,32893,32893 },
+  /*  107 */ {     0,   43,    0,   44,   43,  127,   43,    0,  128,  128,
+                  43,    0,   52,  128,  128,    0,    0,  128,  128,  128,
+                 128,  128,  128,  128,  128,  128,  128,  128 },
+  /*  108 */ {     0,   43,    0,   44,   43,  127,   55,    0,  128,  128,
+                  43,    0,   52,  128,  128,    0,    0,  128,  128,  128,
+                 128,  128,  128,  128,  128,  128,  128,  128 },
+  /*  109 */ {     0,   43,    0,   44,   43,   91,   55,32803,32897,32897,
+                  94,    0,   52,32897,32897,    0,    0,32897,32897,32897,
+               32897,32897,32897,32897,32897,32897,32897,32897 },
+  /*  110 */ {     0,   43,    0,   44,   43,   43,   43,    0,32898,32898,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*  111 */ {     0,    0,    0,    0,    0,  131,    0,    0,  132,  132,
+                   0,    0,    0,  132,  132,    0,    0,  132,  132,  132,
+                 132,  132,  132,  132,  132,  132,  132,  132 },
+  /*  112 */ {     0,    0,    0,    0,    0,  131,   96,    0,  132,  132,
+                   0,    0,    0,  132,  132,    0,    0,  132,  132,  132,
+                 132,  132,  132,  132,  132,  132,  132,  132 },
+  /*  113 */ {     0,    0,    0,    0,    0,   95,   96,    0,32901,32901,
+                   0,    0,    0,32901,32901,    0,    0,32901,32901,32901,
+               32901,32901,32901,32901,32901,32901,32901,32901 },
+  /*  114 */ {     0,   57,    0,   58,   57,  134,   57,    0,  135,  135,
+                  57,    0,   67,  135,  135,    0,    0,  135,  135,  135,
+                 135,  135,  135,  135,  135,  135,  135,  135 },
+  /*  115 */ {     0,   57,    0,   58,   57,  134,   70,    0,  135,  135,
+                  57,    0,   67,  135,  135,    0,    0,  135,  135,  135,
+                 135,  135,  135,  135,  135,  135,  135,  135 },
+  /*  116 */ {     0,32884,    0,  136,32884,32884,32884,32884,32884,32884,
+               32884,32884,32884,32884,32884,    0,    0,32884,32884,32884,
+               32884,32884,32884,32884,32884,32884,32884,32884 },
+  /*  117 */ {     0,32885,32884,  137,32885,32885,32885,32885,32885,32885,
+               32885,32885,32885,32885,32885,    0,    0,32885,32885,32885,
+               32885,32885,32885,32885,32885,32885,32885,32885 },
+  /*  118 */ {     0,   57,32884,   58,   57,   98,   70,32885,32906,32906,
+                 119,32885,   67,32906,32906,    0,    0,32906,32906,32906,
+               32906,32906,32906,32906,32906,32906,32906,32906 },
+  /*  119 */ {     0,   57,    0,   58,   57,   57,   57,    0,   57,  139,
+                  57,    0,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  120 */ {     0,    0,    0,    0,    0,  140,    0,    0,  141,  141,
+                   0,    0,    0,  141,  141,    0,    0,  141,  141,  141,
+                 141,  141,  141,  141,  141,  141,  141,  141 },
+  /*  121 */ {     0,    0,    0,    0,    0,  140,   18,    0,  141,  141,
+                   0,    0,    0,  141,  141,    0,    0,  141,  141,  141,
+                 141,  141,  141,  141,  141,  141,  141,  141 },
+  /*  122 */ {     0,    0,    0,    0,    0,  101,   18,    0,32910,32910,
+                   0,    0,    0,32910,32910,    0,    0,32910,32910,32910,
+               32910,32910,32910,32910,32910,32910,32910,32910 },
+  /*  123 */ {     0,    0,    0,    0,    0,  143,    0,    0,  144,  144,
+                   0,    0,    0,  144,  144,    0,    0,  144,  144,  144,
+                 144,  144,  144,  144,  144,  144,  144,  144 },
+  /*  124 */ {     0,    0,    0,    0,    0,  143,   76,    0,  144,  144,
+                   0,    0,    0,  144,  144,    0,    0,  144,  144,  144,
+                 144,  144,  144,  144,  144,  144,  144,  144 },
+  /*  125 */ {     0,    0,    0,    0,    0,  104,   76,32803,32913,32913,
+                 126,    0,    0,32913,32913,    0,    0,32913,32913,32913,
+               32913,32913,32913,32913,32913,32913,32913,32913 },
+  /*  126 */ {     0,    0,    0,    0,    0,    0,    0,    0,    0,  146,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  127 */ {     0,   43,    0,   44,   43,  147,   43,    0,  148,  148,
+                  43,    0,   52,  148,  148,    0,    0,  148,  148,  148,
+                 148,  148,  148,  148,  148,  148,  148,  148 },
+  /*  128 */ {     0,   43,    0,   44,   43,  147,   55,    0,  148,  148,
+                  43,    0,   52,  148,  148,    0,    0,  148,  148,  148,
+                 148,  148,  148,  148,  148,  148,  148,  148 },
+  /*  129 */ {     0,   43,    0,   44,   43,  107,   55,32803,32917,32917,
+                  94,    0,   52,32917,32917,    0,    0,32917,32917,32917,
+               32917,32917,32917,32917,32917,32917,32917,32917 },
+  /*  130 */ {     0,   43,    0,   44,   43,   43,   43,32803,32918,32918,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*  131 */ {     0,    0,    0,    0,    0,  151,    0,    0,  152,  152,
+                   0,    0,    0,  152,  152,    0,    0,  152,  152,  152,
+                 152,  152,  152,  152,  152,  152,  152,  152 },
+  /*  132 */ {     0,    0,    0,    0,    0,  151,   96,    0,  152,  152,
+                   0,    0,    0,  152,  152,    0,    0,  152,  152,  152,
+                 152,  152,  152,  152,  152,  152,  152,  152 },
+  /*  133 */ {     0,    0,32884,    0,    0,  111,   96,32885,32921,32921,
+                 154,32885,    0,32921,32921,    0,    0,32921,32921,32921,
+               32921,32921,32921,32921,32921,32921,32921,32921 },
+  /*  134 */ {     0,   57,    0,   58,   57,  155,   57,    0,  156,  156,
+                  57,    0,   67,  156,  156,    0,    0,  156,  156,  156,
+                 156,  156,  156,  156,  156,  156,  156,  156 },
+  /*  135 */ {     0,   57,    0,   58,   57,  155,   70,    0,  156,  156,
+                  57,    0,   67,  156,  156,    0,    0,  156,  156,  156,
+                 156,  156,  156,  156,  156,  156,  156,  156 },
+  /*  136 */ {     0,    0,    0,32884,    0,    0,    0,    0,  157,  157,
+                   0,    0,    0,  157,    0,    0,    0,  157,  157,  157,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  137 */ {     0,    0,    0,32885,    0,    0,    0,    0,  158,  158,
+                   0,    0,    0,  158,    0,    0,    0,  158,  158,  158,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  138 */ {     0,   57,32884,   58,   57,  114,   70,32885,32927,32927,
+                 119,32885,   67,32927,32927,    0,    0,32927,32927,32927,
+               32927,32927,32927,32927,32927,32927,32927,32927 },
+  /*  139 */ {     0,   57,    0,   58,   57,   57,   57,    0,32928,32928,
+                  57,    0,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  140 */ {     0,    0,    0,    0,    0,  161,    0,    0,  162,  162,
+                   0,    0,    0,  162,  162,    0,    0,  162,  162,  162,
+                 162,  162,  162,  162,  162,  162,  162,  162 },
+  /*  141 */ {     0,    0,    0,    0,    0,  161,   18,    0,  162,  162,
+                   0,    0,    0,  162,  162,    0,    0,  162,  162,  162,
+                 162,  162,  162,  162,  162,  162,  162,  162 },
+  /*  142 */ {     0,    0,    0,    0,    0,  120,   18,    0,32931,32931,
+                   0,    0,    0,32931,32931,    0,    0,32931,32931,32931,
+               32931,32931,32931,32931,32931,32931,32931,32931 },
+  /*  143 */ {     0,    0,    0,    0,    0,  164,    0,    0,  165,  165,
+                   0,    0,    0,  165,  165,    0,    0,  165,  165,  165,
+                 165,  165,  165,  165,  165,  165,  165,  165 },
+  /*  144 */ {     0,    0,    0,    0,    0,  164,   76,    0,  165,  165,
+                   0,    0,    0,  165,  165,    0,    0,  165,  165,  165,
+                 165,  165,  165,  165,  165,  165,  165,  165 },
+  /*  145 */ {     0,    0,    0,    0,    0,  123,   76,32803,32934,32934,
+                 126,    0,    0,32934,32934,    0,    0,32934,32934,32934,
+               32934,32934,32934,32934,32934,32934,32934,32934 },
+  /*  146 */ {     0,    0,    0,    0,    0,    0,    0,    0,32935,32935,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  147 */ {     0,   43,    0,   44,   43,  168,   43,    0,  169,  169,
+                  43,    0,   52,  169,  169,    0,    0,  169,  169,  169,
+                 169,  169,  169,  169,  169,  169,  169,  169 },
+  /*  148 */ {     0,   43,    0,   44,   43,  168,   55,    0,  169,  169,
+                  43,    0,   52,  169,  169,    0,    0,  169,  169,  169,
+                 169,  169,  169,  169,  169,  169,  169,  169 },
+  /*  149 */ {     0,   43,    0,   44,   43,  127,   55,32803,32938,32938,
+                  94,    0,   52,32938,32938,    0,    0,32938,32938,32938,
+               32938,32938,32938,32938,32938,32938,32938,32938 },
+  /*  150 */ {     0,   43,    0,   44,   43,   43,   43,32803,32939,32939,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*  151 */ {     0,    0,    0,    0,    0,  172,    0,    0,  173,  173,
+                   0,    0,    0,  173,  173,    0,    0,  173,  173,  173,
+                 173,  173,  173,  173,  173,  173,  173,  173 },
+  /*  152 */ {     0,    0,    0,    0,    0,  172,   96,    0,  173,  173,
+                   0,    0,    0,  173,  173,    0,    0,  173,  173,  173,
+                 173,  173,  173,  173,  173,  173,  173,  173 },
+  /*  153 */ {     0,    0,32884,    0,    0,  131,   96,32885,32942,32942,
+                 154,32885,    0,32942,32942,    0,    0,32942,32942,32942,
+               32942,32942,32942,32942,32942,32942,32942,32942 },
+  /*  154 */ {     0,    0,    0,    0,    0,    0,    0,    0,    0,  175,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  155 */ {     0,   57,    0,   58,   57,  176,   57,    0,  177,  177,
+                  57,    0,   67,  177,  177,    0,    0,  177,  177,  177,
+                 177,  177,  177,  177,  177,  177,  177,  177 },
+  /*  156 */ {     0,   57,    0,   58,   57,  176,   70,    0,  177,  177,
+                  57,    0,   67,  177,  177,    0,    0,  177,  177,  177,
+                 177,  177,  177,  177,  177,  177,  177,  177 },
+  /*  157 */ {     0,    0,    0,    0,    0,    0,    0,    0,32884,32884,
+                   0,    0,    0,32884,    0,    0,    0,32884,32884,32884,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  158 */ {     0,    0,    0,    0,    0,    0,    0,    0,32885,32885,
+                   0,    0,    0,32885,    0,    0,    0,32885,32885,32885,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  159 */ {     0,   57,32884,   58,   57,  134,   70,32885,32946,32946,
+                 119,32885,   67,32946,32946,    0,    0,32946,32946,32946,
+               32946,32946,32946,32946,32946,32946,32946,32946 },
+  /*  160 */ {     0,   57,32884,   58,   57,   57,   57,32885,32947,32947,
+                  57,32885,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  161 */ {     0,    0,    0,    0,    0,  180,    0,    0,  181,  181,
+                   0,    0,    0,  181,  181,    0,    0,  181,  181,  181,
+                 181,  181,  181,  181,  181,  181,  181,  181 },
+  /*  162 */ {     0,    0,    0,    0,    0,  180,   18,    0,  181,  181,
+                   0,    0,    0,  181,  181,    0,    0,  181,  181,  181,
+                 181,  181,  181,  181,  181,  181,  181,  181 },
+  /*  163 */ {     0,    0,    0,    0,    0,  140,   18,    0,32950,32950,
+                   0,    0,    0,32950,32950,    0,    0,32950,32950,32950,
+               32950,32950,32950,32950,32950,32950,32950,32950 },
+  /*  164 */ {     0,    0,    0,    0,    0,  183,    0,    0,  184,  184,
+                   0,    0,    0,  184,  184,    0,    0,  184,  184,  184,
+                 184,  184,  184,  184,  184,  184,  184,  184 },
+  /*  165 */ {     0,    0,    0,    0,    0,  183,   76,    0,  184,  184,
+                   0,    0,    0,  184,  184,    0,    0,  184,  184,  184,
+                 184,  184,  184,  184,  184,  184,  184,  184 },
+  /*  166 */ {     0,    0,    0,    0,    0,  143,   76,32803,32953,32953,
+                 126,    0,    0,32953,32953,    0,    0,32953,32953,32953,
+               32953,32953,32953,32953,32953,32953,32953,32953 },
+  /*  167 */ {     0,    0,    0,    0,    0,    0,    0,32803,32954,32954,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  168 */ {     0,   43,    0,   44,   43,  187,   43,    0,  188,  188,
+                  43,    0,   52,  188,  188,    0,    0,  188,  188,  188,
+                 188,  188,  188,  188,  188,  188,  188,  188 },
+  /*  169 */ {     0,   43,    0,   44,   43,  187,   55,    0,  188,  188,
+                  43,    0,   52,  188,  188,    0,    0,  188,  188,  188,
+                 188,  188,  188,  188,  188,  188,  188,  188 },
+  /*  170 */ {     0,   43,    0,   44,   43,  147,   55,32803,32957,32957,
+                  94,    0,   52,32957,32957,    0,    0,32957,32957,32957,
+               32957,32957,32957,32957,32957,32957,32957,32957 },
+  /*  171 */ {     0,   43,    0,   44,   43,   43,   43,32803,32958,32958,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*  172 */ {     0,    0,    0,    0,    0,  191,    0,    0,  192,  192,
+                   0,    0,    0,  192,  192,    0,    0,  192,  192,  192,
+                 192,  192,  192,  192,  192,  192,  192,  192 },
+  /*  173 */ {     0,    0,    0,    0,    0,  191,   96,    0,  192,  192,
+                   0,    0,    0,  192,  192,    0,    0,  192,  192,  192,
+                 192,  192,  192,  192,  192,  192,  192,  192 },
+  /*  174 */ {     0,    0,32884,    0,    0,  151,   96,32885,32961,32961,
+                 154,32885,    0,32961,32961,    0,    0,32961,32961,32961,
+               32961,32961,32961,32961,32961,32961,32961,32961 },
+  /*  175 */ {     0,    0,    0,    0,    0,    0,    0,    0,32962,32962,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  176 */ {     0,   57,    0,   58,   57,  195,   57,    0,  196,  196,
+                  57,    0,   67,  196,  196,    0,    0,  196,  196,  196,
+                 196,  196,  196,  196,  196,  196,  196,  196 },
+  /*  177 */ {     0,   57,    0,   58,   57,  195,   70,    0,  196,  196,
+                  57,    0,   67,  196,  196,    0,    0,  196,  196,  196,
+                 196,  196,  196,  196,  196,  196,  196,  196 },
+  /*  178 */ {     0,   57,32884,   58,   57,  155,   70,32885,32965,32965,
+                 119,32885,   67,32965,32965,    0,    0,32965,32965,32965,
+               32965,32965,32965,32965,32965,32965,32965,32965 },
+  /*  179 */ {     0,   57,32884,   58,   57,   57,   57,32885,32966,32966,
+                  57,32885,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  180 */ {     0,    0,    0,    0,    0,  199,    0,    0,  200,  200,
+                   0,    0,    0,  200,  200,    0,    0,  200,  200,  200,
+                 200,  200,  200,  200,  200,  200,  200,  200 },
+  /*  181 */ {     0,    0,    0,    0,    0,  199,   18,    0,  200,  200,
+                   0,    0,    0,  200,  200,    0,    0,  200,  200,  200,
+                 200,  200,  200,  200,  200,  200,  200,  200 },
+  /*  182 */ {     0,    0,    0,    0,    0,  161,   18,    0,32969,32969,
+                   0,    0,    0,32969,32969,    0,    0,32969,32969,32969,
+               32969,32969,32969,32969,32969,32969,32969,32969 },
+  /*  183 */ {     0,    0,    0,    0,    0,  202,    0,    0,  203,  203,
+                   0,    0,    0,  203,  203,    0,    0,  203,  203,  203,
+                 203,  203,  203,  203,  203,  203,  203,  203 },
+  /*  184 */ {     0,    0,    0,    0,    0,  202,   76,    0,  203,  203,
+                   0,    0,    0,  203,  203,    0,    0,  203,  203,  203,
+                 203,  203,  203,  203,  203,  203,  203,  203 },
+  /*  185 */ {     0,    0,    0,    0,    0,  164,   76,32803,32972,32972,
+                 126,    0,    0,32972,32972,    0,    0,32972,32972,32972,
+               32972,32972,32972,32972,32972,32972,32972,32972 },
+  /*  186 */ {     0,    0,    0,    0,    0,    0,    0,32803,32973,32973,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  187 */ {     0,   43,    0,   44,   43,  206,   43,    0,  207,  207,
+                  43,    0,   52,  207,  207,    0,    0,  207,  207,  207,
+                 207,  207,  207,  207,  207,  207,  207,  207 },
+  /*  188 */ {     0,   43,    0,   44,   43,  206,   55,    0,  207,  207,
+                  43,    0,   52,  207,  207,    0,    0,  207,  207,  207,
+                 207,  207,  207,  207,  207,  207,  207,  207 },
+  /*  189 */ {     0,   43,    0,   44,   43,  168,   55,32803,32976,32976,
+                  94,    0,   52,32976,32976,    0,    0,32976,32976,32976,
+               32976,32976,32976,32976,32976,32976,32976,32976 },
+  /*  190 */ {     0,   43,    0,   44,   43,   43,   43,32803,   43,   43,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*  191 */ {     0,    0,    0,    0,    0,  209,    0,    0,  210,  210,
+                   0,    0,    0,  210,  210,    0,    0,  210,  210,  210,
+                 210,  210,  210,  210,  210,  210,  210,  210 },
+  /*  192 */ {     0,    0,    0,    0,    0,  209,   96,    0,  210,  210,
+                   0,    0,    0,  210,  210,    0,    0,  210,  210,  210,
+                 210,  210,  210,  210,  210,  210,  210,  210 },
+  /*  193 */ {     0,    0,32884,    0,    0,  172,   96,32885,32979,32979,
+                 154,32885,    0,32979,32979,    0,    0,32979,32979,32979,
+               32979,32979,32979,32979,32979,32979,32979,32979 },
+  /*  194 */ {     0,    0,32884,    0,    0,    0,    0,32885,32980,32980,
+                   0,32885,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  195 */ {     0,   57,    0,   58,   57,  213,   57,    0,  214,  214,
+                  57,    0,   67,  214,  214,    0,    0,  214,  214,  214,
+                 214,  214,  214,  214,  214,  214,  214,  214 },
+  /*  196 */ {     0,   57,    0,   58,   57,  213,   70,    0,  214,  214,
+                  57,    0,   67,  214,  214,    0,    0,  214,  214,  214,
+                 214,  214,  214,  214,  214,  214,  214,  214 },
+  /*  197 */ {     0,   57,32884,   58,   57,  176,   70,32885,32983,32983,
+                 119,32885,   67,32983,32983,    0,    0,32983,32983,32983,
+               32983,32983,32983,32983,32983,32983,32983,32983 },
+  /*  198 */ {     0,   57,32884,   58,   57,   57,   57,32885,32984,32984,
+                  57,32885,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  199 */ {     0,    0,    0,    0,    0,  217,    0,    0,  218,  218,
+                   0,    0,    0,  218,  218,    0,    0,  218,  218,  218,
+                 218,  218,  218,  218,  218,  218,  218,  218 },
+  /*  200 */ {     0,    0,    0,    0,    0,  217,   18,    0,  218,  218,
+                   0,    0,    0,  218,  218,    0,    0,  218,  218,  218,
+                 218,  218,  218,  218,  218,  218,  218,  218 },
+  /*  201 */ {     0,    0,    0,    0,    0,  180,   18,    0,32987,32987,
+                   0,    0,    0,32987,32987,    0,    0,32987,32987,32987,
+               32987,32987,32987,32987,32987,32987,32987,32987 },
+  /*  202 */ {     0,    0,    0,    0,    0,  220,    0,    0,  221,  221,
+                   0,    0,    0,  221,  221,    0,    0,  221,  221,  221,
+                 221,  221,  221,  221,  221,  221,  221,  221 },
+  /*  203 */ {     0,    0,    0,    0,    0,  220,   76,    0,  221,  221,
+                   0,    0,    0,  221,  221,    0,    0,  221,  221,  221,
+                 221,  221,  221,  221,  221,  221,  221,  221 },
+  /*  204 */ {     0,    0,    0,    0,    0,  183,   76,32803,32990,32990,
+                 126,    0,    0,32990,32990,    0,    0,32990,32990,32990,
+               32990,32990,32990,32990,32990,32990,32990,32990 },
+  /*  205 */ {     0,    0,    0,    0,    0,    0,    0,32803,32991,32991,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  206 */ {     0,   43,    0,   44,   43,  224,   43,    0,  225,  225,
+                  43,    0,   52,  225,  225,    0,    0,  225,  225,  225,
+                 225,  225,  225,  225,  225,  225,  225,  225 },
+  /*  207 */ {     0,   43,    0,   44,   43,  224,   55,    0,  225,  225,
+                  43,    0,   52,  225,  225,    0,    0,  225,  225,  225,
+                 225,  225,  225,  225,  225,  225,  225,  225 },
+  /*  208 */ {     0,   43,    0,   44,   43,  187,   55,32803,32994,32994,
+                  94,    0,   52,32994,32994,    0,    0,32994,32994,32994,
+               32994,32994,32994,32994,32994,32994,32994,32994 },
+  /*  209 */ {     0,    0,    0,    0,    0,  227,    0,    0,  228,  228,
+                   0,    0,    0,  228,  228,    0,    0,  228,  228,  228,
+                 228,  228,  228,  228,  228,  228,  228,  228 },
+  /*  210 */ {     0,    0,    0,    0,    0,  227,   96,    0,  228,  228,
+                   0,    0,    0,  228,  228,    0,    0,  228,  228,  228,
+                 228,  228,  228,  228,  228,  228,  228,  228 },
+  /*  211 */ {     0,    0,32884,    0,    0,  191,   96,32885,32997,32997,
+                 154,32885,    0,32997,32997,    0,    0,32997,32997,32997,
+               32997,32997,32997,32997,32997,32997,32997,32997 },
+  /*  212 */ {     0,    0,32884,    0,    0,    0,    0,32885,32998,32998,
+                   0,32885,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  213 */ {     0,   57,    0,   58,   57,  231,   57,    0,  232,  232,
+                  57,    0,   67,  232,  232,    0,    0,  232,  232,  232,
+                 232,  232,  232,  232,  232,  232,  232,  232 },
+  /*  214 */ {     0,   57,    0,   58,   57,  231,   70,    0,  232,  232,
+                  57,    0,   67,  232,  232,    0,    0,  232,  232,  232,
+                 232,  232,  232,  232,  232,  232,  232,  232 },
+  /*  215 */ {     0,   57,32884,   58,   57,  195,   70,32885,33001,33001,
+                 119,32885,   67,33001,33001,    0,    0,33001,33001,33001,
+               33001,33001,33001,33001,33001,33001,33001,33001 },
+  /*  216 */ {     0,   57,32884,   58,   57,   57,   57,32885,   57,   57,
+                  57,32885,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  217 */ {     0,    0,    0,    0,    0,  234,    0,    0,  235,  235,
+                   0,    0,    0,  235,  235,    0,    0,  235,  235,  235,
+                 235,  235,  235,  235,  235,  235,  235,  235 },
+  /*  218 */ {     0,    0,    0,    0,    0,  234,   18,    0,  235,  235,
+                   0,    0,    0,  235,  235,    0,    0,  235,  235,  235,
+                 235,  235,  235,  235,  235,  235,  235,  235 },
+  /*  219 */ {     0,    0,    0,    0,    0,  199,   18,    0,33004,33004,
+                   0,    0,    0,33004,33004,    0,    0,33004,33004,33004,
+               33004,33004,33004,33004,33004,33004,33004,33004 },
+  /*  220 */ {     0,    0,    0,    0,    0,  237,    0,    0,  238,  238,
+                   0,    0,    0,  238,  238,    0,    0,  238,  238,  238,
+                 238,  238,  238,  238,  238,  238,  238,  238 },
+  /*  221 */ {     0,    0,    0,    0,    0,  237,   76,    0,  238,  238,
+                   0,    0,    0,  238,  238,    0,    0,  238,  238,  238,
+                 238,  238,  238,  238,  238,  238,  238,  238 },
+  /*  222 */ {     0,    0,    0,    0,    0,  202,   76,32803,33007,33007,
+                 126,    0,    0,33007,33007,    0,    0,33007,33007,33007,
+               33007,33007,33007,33007,33007,33007,33007,33007 },
+  /*  223 */ {     0,    0,    0,    0,    0,    0,    0,32803,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  224 */ {     0,   43,    0,   44,   43,  240,   43,    0,  241,  241,
+                  43,    0,   52,  241,  241,    0,    0,  241,  241,  241,
+                 241,  241,  241,  241,  241,  241,  241,  241 },
+  /*  225 */ {     0,   43,    0,   44,   43,  240,   55,    0,  241,  241,
+                  43,    0,   52,  241,  241,    0,    0,  241,  241,  241,
+                 241,  241,  241,  241,  241,  241,  241,  241 },
+  /*  226 */ {     0,   43,    0,   44,   43,  206,   55,32803,33010,33010,
+                  94,    0,   52,33010,33010,    0,    0,33010,33010,33010,
+               33010,33010,33010,33010,33010,33010,33010,33010 },
+  /*  227 */ {     0,    0,    0,    0,    0,  243,    0,    0,  244,  244,
+                   0,    0,    0,  244,  244,    0,    0,  244,  244,  244,
+                 244,  244,  244,  244,  244,  244,  244,  244 },
+  /*  228 */ {     0,    0,    0,    0,    0,  243,   96,    0,  244,  244,
+                   0,    0,    0,  244,  244,    0,    0,  244,  244,  244,
+                 244,  244,  244,  244,  244,  244,  244,  244 },
+  /*  229 */ {     0,    0,32884,    0,    0,  209,   96,32885,33013,33013,
+                 154,32885,    0,33013,33013,    0,    0,33013,33013,33013,
+               33013,33013,33013,33013,33013,33013,33013,33013 },
+  /*  230 */ {     0,    0,32884,    0,    0,    0,    0,32885,33014,33014,
+                   0,32885,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  231 */ {     0,   57,    0,   58,   57,  247,   57,    0,  248,  248,
+                  57,    0,   67,  248,  248,    0,    0,  248,  248,  248,
+                 248,  248,  248,  248,  248,  248,  248,  248 },
+  /*  232 */ {     0,   57,    0,   58,   57,  247,   70,    0,  248,  248,
+                  57,    0,   67,  248,  248,    0,    0,  248,  248,  248,
+                 248,  248,  248,  248,  248,  248,  248,  248 },
+  /*  233 */ {     0,   57,32884,   58,   57,  213,   70,32885,33017,33017,
+                 119,32885,   67,33017,33017,    0,    0,33017,33017,33017,
+               33017,33017,33017,33017,33017,33017,33017,33017 },
+  /*  234 */ {     0,    0,    0,    0,    0,  250,    0,    0,  251,  251,
+                   0,    0,    0,  251,  251,    0,    0,  251,  251,  251,
+                 251,  251,  251,  251,  251,  251,  251,  251 },
+  /*  235 */ {     0,    0,    0,    0,    0,  250,   18,    0,  251,  251,
+                   0,    0,    0,  251,  251,    0,    0,  251,  251,  251,
+                 251,  251,  251,  251,  251,  251,  251,  251 },
+  /*  236 */ {     0,    0,    0,    0,    0,  217,   18,    0,33020,33020,
+                   0,    0,    0,33020,33020,    0,    0,33020,33020,33020,
+               33020,33020,33020,33020,33020,33020,33020,33020 },
+  /*  237 */ {     0,    0,    0,    0,    0,  253,    0,    0,  254,  254,
+                   0,    0,    0,  254,  254,    0,    0,  254,  254,  254,
+                 254,  254,  254,  254,  254,  254,  254,  254 },
+  /*  238 */ {     0,    0,    0,    0,    0,  253,   76,    0,  254,  254,
+                   0,    0,    0,  254,  254,    0,    0,  254,  254,  254,
+                 254,  254,  254,  254,  254,  254,  254,  254 },
+  /*  239 */ {     0,    0,    0,    0,    0,  220,   76,32803,33023,33023,
+                 126,    0,    0,33023,33023,    0,    0,33023,33023,33023,
+               33023,33023,33023,33023,33023,33023,33023,33023 },
+  /*  240 */ {     0,   43,    0,   44,   43,  256,   43,    0,  257,  257,
+                  43,    0,   52,  257,  257,    0,    0,  257,  257,  257,
+                 257,  257,  257,  257,  257,  257,  257,  257 },
+  /*  241 */ {     0,   43,    0,   44,   43,  256,   55,    0,  257,  257,
+                  43,    0,   52,  257,  257,    0,    0,  257,  257,  257,
+                 257,  257,  257,  257,  257,  257,  257,  257 },
+  /*  242 */ {     0,   43,    0,   44,   43,  224,   55,32803,33026,33026,
+                  94,    0,   52,33026,33026,    0,    0,33026,33026,33026,
+               33026,33026,33026,33026,33026,33026,33026,33026 },
+  /*  243 */ {     0,    0,    0,    0,    0,  259,    0,    0,  260,  260,
+                   0,    0,    0,  260,  260,    0,    0,  260,  260,  260,
+                 260,  260,  260,  260,  260,  260,  260,  260 },
+  /*  244 */ {     0,    0,    0,    0,    0,  259,   96,    0,  260,  260,
+                   0,    0,    0,  260,  260,    0,    0,  260,  260,  260,
+                 260,  260,  260,  260,  260,  260,  260,  260 },
+  /*  245 */ {     0,    0,32884,    0,    0,  227,   96,32885,33029,33029,
+                 154,32885,    0,33029,33029,    0,    0,33029,33029,33029,
+               33029,33029,33029,33029,33029,33029,33029,33029 },
+  /*  246 */ {     0,    0,32884,    0,    0,    0,    0,32885,    0,    0,
+                   0,32885,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  247 */ {     0,   57,    0,   58,   57,  262,   57,    0,  263,  263,
+                  57,    0,   67,  263,  263,    0,    0,  263,  263,  263,
+                 263,  263,  263,  263,  263,  263,  263,  263 },
+  /*  248 */ {     0,   57,    0,   58,   57,  262,   70,    0,  263,  263,
+                  57,    0,   67,  263,  263,    0,    0,  263,  263,  263,
+                 263,  263,  263,  263,  263,  263,  263,  263 },
+  /*  249 */ {     0,   57,32884,   58,   57,  231,   70,32885,33032,33032,
+                 119,32885,   67,33032,33032,    0,    0,33032,33032,33032,
+               33032,33032,33032,33032,33032,33032,33032,33032 },
+  /*  250 */ {     0,    0,    0,    0,    0,  265,    0,    0,  266,  266,
+                   0,    0,    0,  266,  266,    0,    0,  266,  266,  266,
+                 266,  266,  266,  266,  266,  266,  266,  266 },
+  /*  251 */ {     0,    0,    0,    0,    0,  265,   18,    0,  266,  266,
+                   0,    0,    0,  266,  266,    0,    0,  266,  266,  266,
+                 266,  266,  266,  266,  266,  266,  266,  266 },
+  /*  252 */ {     0,    0,    0,    0,    0,  234,   18,    0,33035,33035,
+                   0,    0,    0,33035,33035,    0,    0,33035,33035,33035,
+               33035,33035,33035,33035,33035,33035,33035,33035 },
+  /*  253 */ {     0,    0,    0,    0,    0,  268,    0,    0,  269,  269,
+                   0,    0,    0,  269,  269,    0,    0,  269,  269,  269,
+                 269,  269,  269,  269,  269,  269,  269,  269 },
+  /*  254 */ {     0,    0,    0,    0,    0,  268,   76,    0,  269,  269,
+                   0,    0,    0,  269,  269,    0,    0,  269,  269,  269,
+                 269,  269,  269,  269,  269,  269,  269,  269 },
+  /*  255 */ {     0,    0,    0,    0,    0,  237,   76,32803,33038,33038,
+                 126,    0,    0,33038,33038,    0,    0,33038,33038,33038,
+               33038,33038,33038,33038,33038,33038,33038,33038 },
+  /*  256 */ {     0,   43,    0,   44,   43,  271,   43,    0,  272,  272,
+                  43,    0,   52,  272,  272,    0,    0,  272,  272,  272,
+                 272,  272,  272,  272,  272,  272,  272,  272 },
+  /*  257 */ {     0,   43,    0,   44,   43,  271,   55,    0,  272,  272,
+                  43,    0,   52,  272,  272,    0,    0,  272,  272,  272,
+                 272,  272,  272,  272,  272,  272,  272,  272 },
+  /*  258 */ {     0,   43,    0,   44,   43,  240,   55,32803,33041,33041,
+                  94,    0,   52,33041,33041,    0,    0,33041,33041,33041,
+               33041,33041,33041,33041,33041,33041,33041,33041 },
+  /*  259 */ {     0,    0,    0,    0,    0,  274,    0,    0,  275,  275,
+                   0,    0,    0,  275,  275,    0,    0,  275,  275,  275,
+                 275,  275,  275,  275,  275,  275,  275,  275 },
+  /*  260 */ {     0,    0,    0,    0,    0,  274,   96,    0,  275,  275,
+                   0,    0,    0,  275,  275,    0,    0,  275,  275,  275,
+                 275,  275,  275,  275,  275,  275,  275,  275 },
+  /*  261 */ {     0,    0,32884,    0,    0,  243,   96,32885,33044,33044,
+                 154,32885,    0,33044,33044,    0,    0,33044,33044,33044,
+               33044,33044,33044,33044,33044,33044,33044,33044 },
+  /*  262 */ {     0,   57,    0,   58,   57,  277,   57,    0,  278,  278,
+                  57,    0,   67,  278,  278,    0,    0,  278,  278,  278,
+                 278,  278,  278,  278,  278,  278,  278,  278 },
+  /*  263 */ {     0,   57,    0,   58,   57,  277,   70,    0,  278,  278,
+                  57,    0,   67,  278,  278,    0,    0,  278,  278,  278,
+                 278,  278,  278,  278,  278,  278,  278,  278 },
+  /*  264 */ {     0,   57,32884,   58,   57,  247,   70,32885,33047,33047,
+                 119,32885,   67,33047,33047,    0,    0,33047,33047,33047,
+               33047,33047,33047,33047,33047,33047,33047,33047 },
+  /*  265 */ {     0,    0,    0,    0,    0,  280,    0,    0,  281,  281,
+                   0,    0,    0,  281,  281,    0,    0,  281,  281,  281,
+                 281,  281,  281,  281,  281,  281,  281,  281 },
+  /*  266 */ {     0,    0,    0,    0,    0,  280,   18,    0,  281,  281,
+                   0,    0,    0,  281,  281,    0,    0,  281,  281,  281,
+                 281,  281,  281,  281,  281,  281,  281,  281 },
+  /*  267 */ {     0,    0,    0,    0,    0,  250,   18,    0,33050,33050,
+                   0,    0,    0,33050,33050,    0,    0,33050,33050,33050,
+               33050,33050,33050,33050,33050,33050,33050,33050 },
+  /*  268 */ {     0,    0,    0,    0,    0,  283,    0,    0,  284,  284,
+                   0,    0,    0,  284,  284,    0,    0,  284,  284,  284,
+                 284,  284,  284,  284,  284,  284,  284,  284 },
+  /*  269 */ {     0,    0,    0,    0,    0,  283,   76,    0,  284,  284,
+                   0,    0,    0,  284,  284,    0,    0,  284,  284,  284,
+                 284,  284,  284,  284,  284,  284,  284,  284 },
+  /*  270 */ {     0,    0,    0,    0,    0,  253,   76,32803,33053,33053,
+                 126,    0,    0,33053,33053,    0,    0,33053,33053,33053,
+               33053,33053,33053,33053,33053,33053,33053,33053 },
+  /*  271 */ {     0,   43,    0,   44,   43,  286,   43,    0,  287,  287,
+                  43,    0,   52,  287,  287,    0,    0,  287,  287,  287,
+                 287,  287,  287,  287,  287,  287,  287,  287 },
+  /*  272 */ {     0,   43,    0,   44,   43,  286,   55,    0,  287,  287,
+                  43,    0,   52,  287,  287,    0,    0,  287,  287,  287,
+                 287,  287,  287,  287,  287,  287,  287,  287 },
+  /*  273 */ {     0,   43,    0,   44,   43,  256,   55,32803,33056,33056,
+                  94,    0,   52,33056,33056,    0,    0,33056,33056,33056,
+               33056,33056,33056,33056,33056,33056,33056,33056 },
+  /*  274 */ {     0,    0,    0,    0,    0,  289,    0,    0,  290,  290,
+                   0,    0,    0,  290,  290,    0,    0,  290,  290,  290,
+                 290,  290,  290,  290,  290,  290,  290,  290 },
+  /*  275 */ {     0,    0,    0,    0,    0,  289,   96,    0,  290,  290,
+                   0,    0,    0,  290,  290,    0,    0,  290,  290,  290,
+                 290,  290,  290,  290,  290,  290,  290,  290 },
+  /*  276 */ {     0,    0,32884,    0,    0,  259,   96,32885,33059,33059,
+                 154,32885,    0,33059,33059,    0,    0,33059,33059,33059,
+               33059,33059,33059,33059,33059,33059,33059,33059 },
+  /*  277 */ {     0,   57,    0,   58,   57,  292,   57,    0,  293,  293,
+                  57,    0,   67,  293,  293,    0,    0,  293,  293,  293,
+                 293,  293,  293,  293,  293,  293,  293,  293 },
+  /*  278 */ {     0,   57,    0,   58,   57,  292,   70,    0,  293,  293,
+                  57,    0,   67,  293,  293,    0,    0,  293,  293,  293,
+                 293,  293,  293,  293,  293,  293,  293,  293 },
+  /*  279 */ {     0,   57,32884,   58,   57,  262,   70,32885,33062,33062,
+                 119,32885,   67,33062,33062,    0,    0,33062,33062,33062,
+               33062,33062,33062,33062,33062,33062,33062,33062 },
+  /*  280 */ {     0,    0,    0,    0,    0,  295,    0,    0,  296,  296,
+                   0,    0,    0,  296,  296,    0,    0,  296,  296,  296,
+                 296,  296,  296,  296,  296,  296,  296,  296 },
+  /*  281 */ {     0,    0,    0,    0,    0,  295,   18,    0,  296,  296,
+                   0,    0,    0,  296,  296,    0,    0,  296,  296,  296,
+                 296,  296,  296,  296,  296,  296,  296,  296 },
+  /*  282 */ {     0,    0,    0,    0,    0,  265,   18,    0,33065,33065,
+                   0,    0,    0,33065,33065,    0,    0,33065,33065,33065,
+               33065,33065,33065,33065,33065,33065,33065,33065 },
+  /*  283 */ {     0,    0,    0,    0,    0,  298,    0,    0,  299,  299,
+                   0,    0,    0,  299,  299,    0,    0,  299,  299,  299,
+                 299,  299,  299,  299,  299,  299,  299,  299 },
+  /*  284 */ {     0,    0,    0,    0,    0,  298,   76,    0,  299,  299,
+                   0,    0,    0,  299,  299,    0,    0,  299,  299,  299,
+                 299,  299,  299,  299,  299,  299,  299,  299 },
+  /*  285 */ {     0,    0,    0,    0,    0,  268,   76,32803,33068,33068,
+                 126,    0,    0,33068,33068,    0,    0,33068,33068,33068,
+               33068,33068,33068,33068,33068,33068,33068,33068 },
+  /*  286 */ {     0,   43,    0,   44,   43,  301,   43,    0,  302,  302,
+                  43,    0,   52,  302,  302,    0,    0,  302,  302,  302,
+                 302,  302,  302,  302,  302,  302,  302,  302 },
+  /*  287 */ {     0,   43,    0,   44,   43,  301,   55,    0,  302,  302,
+                  43,    0,   52,  302,  302,    0,    0,  302,  302,  302,
+                 302,  302,  302,  302,  302,  302,  302,  302 },
+  /*  288 */ {     0,   43,    0,   44,   43,  271,   55,32803,33071,33071,
+                  94,    0,   52,33071,33071,    0,    0,33071,33071,33071,
+               33071,33071,33071,33071,33071,33071,33071,33071 },
+  /*  289 */ {     0,    0,    0,    0,    0,  304,    0,    0,  305,  305,
+                   0,    0,    0,  305,  305,    0,    0,  305,  305,  305,
+                 305,  305,  305,  305,  305,  305,  305,  305 },
+  /*  290 */ {     0,    0,    0,    0,    0,  304,   96,    0,  305,  305,
+                   0,    0,    0,  305,  305,    0,    0,  305,  305,  305,
+                 305,  305,  305,  305,  305,  305,  305,  305 },
+  /*  291 */ {     0,    0,32884,    0,    0,  274,   96,32885,33074,33074,
+                 154,32885,    0,33074,33074,    0,    0,33074,33074,33074,
+               33074,33074,33074,33074,33074,33074,33074,33074 },
+  /*  292 */ {     0,   57,    0,   58,   57,  307,   57,    0,  308,  308,
+                  57,    0,   67,  308,  308,    0,    0,  308,  308,  308,
+                 308,  308,  308,  308,  308,  308,  308,  308 },
+  /*  293 */ {     0,   57,    0,   58,   57,  307,   70,    0,  308,  308,
+                  57,    0,   67,  308,  308,    0,    0,  308,  308,  308,
+                 308,  308,  308,  308,  308,  308,  308,  308 },
+  /*  294 */ {     0,   57,32884,   58,   57,  277,   70,32885,33077,33077,
+                 119,32885,   67,33077,33077,    0,    0,33077,33077,33077,
+               33077,33077,33077,33077,33077,33077,33077,33077 },
+  /*  295 */ {     0,    0,    0,    0,    0,  310,    0,    0,  311,  311,
+                   0,    0,    0,  311,  311,    0,    0,  311,  311,  311,
+                 311,  311,  311,  311,  311,  311,  311,  311 },
+  /*  296 */ {     0,    0,    0,    0,    0,  310,   18,    0,  311,  311,
+                   0,    0,    0,  311,  311,    0,    0,  311,  311,  311,
+                 311,  311,  311,  311,  311,  311,  311,  311 },
+  /*  297 */ {     0,    0,    0,    0,    0,  280,   18,    0,33080,33080,
+                   0,    0,    0,33080,33080,    0,    0,33080,33080,33080,
+               33080,33080,33080,33080,33080,33080,33080,33080 },
+  /*  298 */ {     0,    0,    0,    0,    0,  313,    0,    0,  314,  314,
+                   0,    0,    0,  314,  314,    0,    0,  314,  314,  314,
+                 314,  314,  314,  314,  314,  314,  314,  314 },
+  /*  299 */ {     0,    0,    0,    0,    0,  313,   76,    0,  314,  314,
+                   0,    0,    0,  314,  314,    0,    0,  314,  314,  314,
+                 314,  314,  314,  314,  314,  314,  314,  314 },
+  /*  300 */ {     0,    0,    0,    0,    0,  283,   76,32803,33083,33083,
+                 126,    0,    0,33083,33083,    0,    0,33083,33083,33083,
+               33083,33083,33083,33083,33083,33083,33083,33083 },
+  /*  301 */ {     0,   43,    0,   44,   43,  316,   43,    0,  317,  317,
+                  43,    0,   52,  317,  317,    0,    0,  317,  317,  317,
+                 317,  317,  317,  317,  317,  317,  317,  317 },
+  /*  302 */ {     0,   43,    0,   44,   43,  316,   55,    0,  317,  317,
+                  43,    0,   52,  317,  317,    0,    0,  317,  317,  317,
+                 317,  317,  317,  317,  317,  317,  317,  317 },
+  /*  303 */ {     0,   43,    0,   44,   43,  286,   55,32803,33086,33086,
+                  94,    0,   52,33086,33086,    0,    0,33086,33086,33086,
+               33086,33086,33086,33086,33086,33086,33086,33086 },
+  /*  304 */ {     0,    0,    0,    0,    0,  319,    0,    0,  320,  320,
+                   0,    0,    0,  320,  320,    0,    0,  320,  320,  320,
+                 320,  320,  320,  320,  320,  320,  320,  320 },
+  /*  305 */ {     0,    0,    0,    0,    0,  319,   96,    0,  320,  320,
+                   0,    0,    0,  320,  320,    0,    0,  320,  320,  320,
+                 320,  320,  320,  320,  320,  320,  320,  320 },
+  /*  306 */ {     0,    0,32884,    0,    0,  289,   96,32885,33089,33089,
+                 154,32885,    0,33089,33089,    0,    0,33089,33089,33089,
+               33089,33089,33089,33089,33089,33089,33089,33089 },
+  /*  307 */ {     0,   57,    0,   58,   57,  322,   57,    0,  323,  323,
+                  57,    0,   67,  323,  323,    0,    0,  323,  323,  323,
+                 323,  323,  323,  323,  323,  323,  323,  323 },
+  /*  308 */ {     0,   57,    0,   58,   57,  322,   70,    0,  323,  323,
+                  57,    0,   67,  323,  323,    0,    0,  323,  323,  323,
+                 323,  323,  323,  323,  323,  323,  323,  323 },
+  /*  309 */ {     0,   57,32884,   58,   57,  292,   70,32885,33092,33092,
+                 119,32885,   67,33092,33092,    0,    0,33092,33092,33092,
+               33092,33092,33092,33092,33092,33092,33092,33092 },
+  /*  310 */ {     0,    0,    0,    0,    0,  325,    0,    0,  326,  326,
+                   0,    0,    0,  326,  326,    0,    0,  326,  326,  326,
+                 326,  326,  326,  326,  326,  326,  326,  326 },
+  /*  311 */ {     0,    0,    0,    0,    0,  325,   18,    0,  326,  326,
+                   0,    0,    0,  326,  326,    0,    0,  326,  326,  326,
+                 326,  326,  326,  326,  326,  326,  326,  326 },
+  /*  312 */ {     0,    0,    0,    0,    0,  295,   18,    0,33095,33095,
+                   0,    0,    0,33095,33095,    0,    0,33095,33095,33095,
+               33095,33095,33095,33095,33095,33095,33095,33095 },
+  /*  313 */ {     0,    0,    0,    0,    0,  328,    0,    0,  329,  329,
+                   0,    0,    0,  329,  329,    0,    0,  329,  329,  329,
+                 329,  329,  329,  329,  329,  329,  329,  329 },
+  /*  314 */ {     0,    0,    0,    0,    0,  328,   76,    0,  329,  329,
+                   0,    0,    0,  329,  329,    0,    0,  329,  329,  329,
+                 329,  329,  329,  329,  329,  329,  329,  329 },
+  /*  315 */ {     0,    0,    0,    0,    0,  298,   76,32803,33098,33098,
+                 126,    0,    0,33098,33098,    0,    0,33098,33098,33098,
+               33098,33098,33098,33098,33098,33098,33098,33098 },
+  /*  316 */ {     0,   43,    0,   44,   43,  331,   43,    0,  332,  332,
+                  43,    0,   52,  332,  332,    0,    0,  332,  332,  332,
+                 332,  332,  332,  332,  332,  332,  332,  332 },
+  /*  317 */ {     0,   43,    0,   44,   43,  331,   55,    0,  332,  332,
+                  43,    0,   52,  332,  332,    0,    0,  332,  332,  332,
+                 332,  332,  332,  332,  332,  332,  332,  332 },
+  /*  318 */ {     0,   43,    0,   44,   43,  301,   55,32803,33101,33101,
+                  94,    0,   52,33101,33101,    0,    0,33101,33101,33101,
+               33101,33101,33101,33101,33101,33101,33101,33101 },
+  /*  319 */ {     0,    0,    0,    0,    0,  334,    0,    0,  335,  335,
+                   0,    0,    0,  335,  335,    0,    0,  335,  335,  335,
+                 335,  335,  335,  335,  335,  335,  335,  335 },
+  /*  320 */ {     0,    0,    0,    0,    0,  334,   96,    0,  335,  335,
+                   0,    0,    0,  335,  335,    0,    0,  335,  335,  335,
+                 335,  335,  335,  335,  335,  335,  335,  335 },
+  /*  321 */ {     0,    0,32884,    0,    0,  304,   96,32885,33104,33104,
+                 154,32885,    0,33104,33104,    0,    0,33104,33104,33104,
+               33104,33104,33104,33104,33104,33104,33104,33104 },
+  /*  322 */ {     0,   57,    0,   58,   57,  337,   57,    0,  338,  338,
+                  57,    0,   67,  338,  338,    0,    0,  338,  338,  338,
+                 338,  338,  338,  338,  338,  338,  338,  338 },
+  /*  323 */ {     0,   57,    0,   58,   57,  337,   70,    0,  338,  338,
+                  57,    0,   67,  338,  338,    0,    0,  338,  338,  338,
+                 338,  338,  338,  338,  338,  338,  338,  338 },
+  /*  324 */ {     0,   57,32884,   58,   57,  307,   70,32885,33107,33107,
+                 119,32885,   67,33107,33107,    0,    0,33107,33107,33107,
+               33107,33107,33107,33107,33107,33107,33107,33107 },
+  /*  325 */ {     0,    0,    0,    0,    0,  340,    0,    0,  341,  341,
+                   0,    0,    0,  341,  341,    0,    0,  341,  341,  341,
+                 341,  341,  341,  341,  341,  341,  341,  341 },
+  /*  326 */ {     0,    0,    0,    0,    0,  340,   18,    0,  341,  341,
+                   0,    0,    0,  341,  341,    0,    0,  341,  341,  341,
+                 341,  341,  341,  341,  341,  341,  341,  341 },
+  /*  327 */ {     0,    0,    0,    0,    0,  310,   18,    0,33110,33110,
+                   0,    0,    0,33110,33110,    0,    0,33110,33110,33110,
+               33110,33110,33110,33110,33110,33110,33110,33110 },
+  /*  328 */ {     0,    0,    0,    0,    0,  343,    0,    0,  344,  344,
+                   0,    0,    0,  344,  344,    0,    0,  344,  344,  344,
+                 344,  344,  344,  344,  344,  344,  344,  344 },
+  /*  329 */ {     0,    0,    0,    0,    0,  343,   76,    0,  344,  344,
+                   0,    0,    0,  344,  344,    0,    0,  344,  344,  344,
+                 344,  344,  344,  344,  344,  344,  344,  344 },
+  /*  330 */ {     0,    0,    0,    0,    0,  313,   76,32803,33113,33113,
+                 126,    0,    0,33113,33113,    0,    0,33113,33113,33113,
+               33113,33113,33113,33113,33113,33113,33113,33113 },
+  /*  331 */ {     0,   43,    0,   44,   43,  346,   43,    0,  347,  347,
+                  43,    0,   52,  347,  347,    0,    0,  347,  347,  347,
+                 347,  347,  347,  347,  347,  347,  347,  347 },
+  /*  332 */ {     0,   43,    0,   44,   43,  346,   55,    0,  347,  347,
+                  43,    0,   52,  347,  347,    0,    0,  347,  347,  347,
+                 347,  347,  347,  347,  347,  347,  347,  347 },
+  /*  333 */ {     0,   43,    0,   44,   43,  316,   55,32803,33116,33116,
+                  94,    0,   52,33116,33116,    0,    0,33116,33116,33116,
+               33116,33116,33116,33116,33116,33116,33116,33116 },
+  /*  334 */ {     0,    0,    0,    0,    0,  349,    0,    0,  350,  350,
+                   0,    0,    0,  350,  350,    0,    0,  350,  350,  350,
+                 350,  350,  350,  350,  350,  350,  350,  350 },
+  /*  335 */ {     0,    0,    0,    0,    0,  349,   96,    0,  350,  350,
+                   0,    0,    0,  350,  350,    0,    0,  350,  350,  350,
+                 350,  350,  350,  350,  350,  350,  350,  350 },
+  /*  336 */ {     0,    0,32884,    0,    0,  319,   96,32885,33119,33119,
+                 154,32885,    0,33119,33119,    0,    0,33119,33119,33119,
+               33119,33119,33119,33119,33119,33119,33119,33119 },
+  /*  337 */ {     0,   57,    0,   58,   57,  352,   57,    0,  353,  353,
+                  57,    0,   67,  353,  353,    0,    0,  353,  353,  353,
+                 353,  353,  353,  353,  353,  353,  353,  353 },
+  /*  338 */ {     0,   57,    0,   58,   57,  352,   70,    0,  353,  353,
+                  57,    0,   67,  353,  353,    0,    0,  353,  353,  353,
+                 353,  353,  353,  353,  353,  353,  353,  353 },
+  /*  339 */ {     0,   57,32884,   58,   57,  322,   70,32885,33122,33122,
+                 119,32885,   67,33122,33122,    0,    0,33122,33122,33122,
+               33122,33122,33122,33122,33122,33122,33122,33122 },
+  /*  340 */ {     0,    0,    0,    0,    0,  355,    0,    0,  356,  356,
+                   0,    0,    0,  356,  356,    0,    0,  356,  356,  356,
+                 356,  356,  356,  356,  356,  356,  356,  356 },
+  /*  341 */ {     0,    0,    0,    0,    0,  355,   18,    0,  356,  356,
+                   0,    0,    0,  356,  356,    0,    0,  356,  356,  356,
+                 356,  356,  356,  356,  356,  356,  356,  356 },
+  /*  342 */ {     0,    0,    0,    0,    0,  325,   18,    0,33125,33125,
+                   0,    0,    0,33125,33125,    0,    0,33125,33125,33125,
+               33125,33125,33125,33125,33125,33125,33125,33125 },
+  /*  343 */ {     0,    0,    0,    0,    0,  358,    0,    0,  359,  359,
+                   0,    0,    0,  359,  359,    0,    0,  359,  359,  359,
+                 359,  359,  359,  359,  359,  359,  359,  359 },
+  /*  344 */ {     0,    0,    0,    0,    0,  358,   76,    0,  359,  359,
+                   0,    0,    0,  359,  359,    0,    0,  359,  359,  359,
+                 359,  359,  359,  359,  359,  359,  359,  359 },
+  /*  345 */ {     0,    0,    0,    0,    0,  328,   76,32803,33128,33128,
+                 126,    0,    0,33128,33128,    0,    0,33128,33128,33128,
+               33128,33128,33128,33128,33128,33128,33128,33128 },
+  /*  346 */ {     0,   43,    0,   44,   43,  361,   43,    0,  362,  362,
+                  43,    0,   52,  362,  362,    0,    0,  362,  362,  362,
+                 362,  362,  362,  362,  362,  362,  362,  362 },
+  /*  347 */ {     0,   43,    0,   44,   43,  361,   55,    0,  362,  362,
+                  43,    0,   52,  362,  362,    0,    0,  362,  362,  362,
+                 362,  362,  362,  362,  362,  362,  362,  362 },
+  /*  348 */ {     0,   43,    0,   44,   43,  331,   55,32803,33131,33131,
+                  94,    0,   52,33131,33131,    0,    0,33131,33131,33131,
+               33131,33131,33131,33131,33131,33131,33131,33131 },
+  /*  349 */ {     0,    0,    0,    0,    0,  364,    0,    0,  365,  365,
+                   0,    0,    0,  365,  365,    0,    0,  365,  365,  365,
+                 365,  365,  365,  365,  365,  365,  365,  365 },
+  /*  350 */ {     0,    0,    0,    0,    0,  364,   96,    0,  365,  365,
+                   0,    0,    0,  365,  365,    0,    0,  365,  365,  365,
+                 365,  365,  365,  365,  365,  365,  365,  365 },
+  /*  351 */ {     0,    0,32884,    0,    0,  334,   96,32885,33134,33134,
+                 154,32885,    0,33134,33134,    0,    0,33134,33134,33134,
+               33134,33134,33134,33134,33134,33134,33134,33134 },
+  /*  352 */ {     0,   57,    0,   58,   57,  367,   57,    0,  368,  368,
+                  57,    0,   67,  368,  368,    0,    0,  368,  368,  368,
+                 368,  368,  368,  368,  368,  368,  368,  368 },
+  /*  353 */ {     0,   57,    0,   58,   57,  367,   70,    0,  368,  368,
+                  57,    0,   67,  368,  368,    0,    0,  368,  368,  368,
+                 368,  368,  368,  368,  368,  368,  368,  368 },
+  /*  354 */ {     0,   57,32884,   58,   57,  337,   70,32885,33137,33137,
+                 119,32885,   67,33137,33137,    0,    0,33137,33137,33137,
+               33137,33137,33137,33137,33137,33137,33137,33137 },
+  /*  355 */ {     0,    0,    0,    0,    0,  370,    0,    0,  371,  371,
+                   0,    0,    0,  371,  371,    0,    0,  371,  371,  371,
+                 371,  371,  371,  371,  371,  371,  371,  371 },
+  /*  356 */ {     0,    0,    0,    0,    0,  370,   18,    0,  371,  371,
+                   0,    0,    0,  371,  371,    0,    0,  371,  371,  371,
+                 371,  371,  371,  371,  371,  371,  371,  371 },
+  /*  357 */ {     0,    0,    0,    0,    0,  340,   18,    0,33140,33140,
+                   0,    0,    0,33140,33140,    0,    0,33140,33140,33140,
+               33140,33140,33140,33140,33140,33140,33140,33140 },
+  /*  358 */ {     0,    0,    0,    0,    0,  373,    0,    0,  374,  374,
+                   0,    0,    0,  374,  374,    0,    0,  374,  374,  374,
+                 374,  374,  374,  374,  374,  374,  374,  374 },
+  /*  359 */ {     0,    0,    0,    0,    0,  373,   76,    0,  374,  374,
+                   0,    0,    0,  374,  374,    0,    0,  374,  374,  374,
+                 374,  374,  374,  374,  374,  374,  374,  374 },
+  /*  360 */ {     0,    0,    0,    0,    0,  343,   76,32803,33143,33143,
+                 126,    0,    0,33143,33143,    0,    0,33143,33143,33143,
+               33143,33143,33143,33143,33143,33143,33143,33143 },
+  /*  361 */ {     0,   43,    0,   44,   43,  376,   43,    0,  377,  377,
+                  43,    0,   52,  377,  377,    0,    0,  377,  377,  377,
+                 377,  377,  377,  377,  377,  377,  377,  377 },
+  /*  362 */ {     0,   43,    0,   44,   43,  376,   55,    0,  377,  377,
+                  43,    0,   52,  377,  377,    0,    0,  377,  377,  377,
+                 377,  377,  377,  377,  377,  377,  377,  377 },
+  /*  363 */ {     0,   43,    0,   44,   43,  346,   55,32803,33146,33146,
+                  94,    0,   52,33146,33146,    0,    0,33146,33146,33146,
+               33146,33146,33146,33146,33146,33146,33146,33146 },
+  /*  364 */ {     0,    0,    0,    0,    0,  379,    0,    0,  380,  380,
+                   0,    0,    0,  380,  380,    0,    0,  380,  380,  380,
+                 380,  380,  380,  380,  380,  380,  380,  380 },
+  /*  365 */ {     0,    0,    0,    0,    0,  379,   96,    0,  380,  380,
+                   0,    0,    0,  380,  380,    0,    0,  380,  380,  380,
+                 380,  380,  380,  380,  380,  380,  380,  380 },
+  /*  366 */ {     0,    0,32884,    0,    0,  349,   96,32885,33149,33149,
+                 154,32885,    0,33149,33149,    0,    0,33149,33149,33149,
+               33149,33149,33149,33149,33149,33149,33149,33149 },
+  /*  367 */ {     0,   57,    0,   58,   57,  382,   57,    0,  383,  383,
+                  57,    0,   67,  383,  383,    0,    0,  383,  383,  383,
+                 383,  383,  383,  383,  383,  383,  383,  383 },
+  /*  368 */ {     0,   57,    0,   58,   57,  382,   70,    0,  383,  383,
+                  57,    0,   67,  383,  383,    0,    0,  383,  383,  383,
+                 383,  383,  383,  383,  383,  383,  383,  383 },
+  /*  369 */ {     0,   57,32884,   58,   57,  352,   70,32885,33152,33152,
+                 119,32885,   67,33152,33152,    0,    0,33152,33152,33152,
+               33152,33152,33152,33152,33152,33152,33152,33152 },
+  /*  370 */ {     0,    0,    0,    0,    0,  385,    0,    0,  386,  386,
+                   0,    0,    0,  386,  386,    0,    0,  386,  386,  386,
+                 386,  386,  386,  386,  386,  386,  386,  386 },
+  /*  371 */ {     0,    0,    0,    0,    0,  385,   18,    0,  386,  386,
+                   0,    0,    0,  386,  386,    0,    0,  386,  386,  386,
+                 386,  386,  386,  386,  386,  386,  386,  386 },
+  /*  372 */ {     0,    0,    0,    0,    0,  355,   18,    0,33155,33155,
+                   0,    0,    0,33155,33155,    0,    0,33155,33155,33155,
+               33155,33155,33155,33155,33155,33155,33155,33155 },
+  /*  373 */ {     0,    0,    0,    0,    0,  388,    0,    0,  389,  389,
+                   0,    0,    0,  389,  389,    0,    0,  389,  389,  389,
+                 389,  389,  389,  389,  389,  389,  389,  389 },
+  /*  374 */ {     0,    0,    0,    0,    0,  388,   76,    0,  389,  389,
+                   0,    0,    0,  389,  389,    0,    0,  389,  389,  389,
+                 389,  389,  389,  389,  389,  389,  389,  389 },
+  /*  375 */ {     0,    0,    0,    0,    0,  358,   76,32803,33158,33158,
+                 126,    0,    0,33158,33158,    0,    0,33158,33158,33158,
+               33158,33158,33158,33158,33158,33158,33158,33158 },
+  /*  376 */ {     0,   43,    0,   44,   43,  391,   43,    0,  392,  392,
+                  43,    0,   52,  392,  392,    0,    0,  392,  392,  392,
+                 392,  392,  392,  392,  392,  392,  392,  392 },
+  /*  377 */ {     0,   43,    0,   44,   43,  391,   55,    0,  392,  392,
+                  43,    0,   52,  392,  392,    0,    0,  392,  392,  392,
+                 392,  392,  392,  392,  392,  392,  392,  392 },
+  /*  378 */ {     0,   43,    0,   44,   43,  361,   55,32803,33161,33161,
+                  94,    0,   52,33161,33161,    0,    0,33161,33161,33161,
+               33161,33161,33161,33161,33161,33161,33161,33161 },
+  /*  379 */ {     0,    0,    0,    0,    0,  394,    0,    0,  395,  395,
+                   0,    0,    0,  395,  395,    0,    0,  395,  395,  395,
+                 395,  395,  395,  395,  395,  395,  395,  395 },
+  /*  380 */ {     0,    0,    0,    0,    0,  394,   96,    0,  395,  395,
+                   0,    0,    0,  395,  395,    0,    0,  395,  395,  395,
+                 395,  395,  395,  395,  395,  395,  395,  395 },
+  /*  381 */ {     0,    0,32884,    0,    0,  364,   96,32885,33164,33164,
+                 154,32885,    0,33164,33164,    0,    0,33164,33164,33164,
+               33164,33164,33164,33164,33164,33164,33164,33164 },
+  /*  382 */ {     0,   57,    0,   58,   57,  397,   57,    0,  398,  398,
+                  57,    0,   67,  398,  398,    0,    0,  398,  398,  398,
+                 398,  398,  398,  398,  398,  398,  398,  398 },
+  /*  383 */ {     0,   57,    0,   58,   57,  397,   70,    0,  398,  398,
+                  57,    0,   67,  398,  398,    0,    0,  398,  398,  398,
+                 398,  398,  398,  398,  398,  398,  398,  398 },
+  /*  384 */ {     0,   57,32884,   58,   57,  367,   70,32885,33167,33167,
+                 119,32885,   67,33167,33167,    0,    0,33167,33167,33167,
+               33167,33167,33167,33167,33167,33167,33167,33167 },
+  /*  385 */ {     0,    0,    0,    0,    0,  400,    0,    0,  401,  401,
+                   0,    0,    0,  401,  401,    0,    0,  401,  401,  401,
+                 401,  401,  401,  401,  401,  401,  401,  401 },
+  /*  386 */ {     0,    0,    0,    0,    0,  400,   18,    0,  401,  401,
+                   0,    0,    0,  401,  401,    0,    0,  401,  401,  401,
+                 401,  401,  401,  401,  401,  401,  401,  401 },
+  /*  387 */ {     0,    0,    0,    0,    0,  370,   18,    0,33170,33170,
+                   0,    0,    0,33170,33170,    0,    0,33170,33170,33170,
+               33170,33170,33170,33170,33170,33170,33170,33170 },
+  /*  388 */ {     0,    0,    0,    0,    0,  403,    0,    0,  404,  404,
+                   0,    0,    0,  404,  404,    0,    0,  404,  404,  404,
+                 404,  404,  404,  404,  404,  404,  404,  404 },
+  /*  389 */ {     0,    0,    0,    0,    0,  403,   76,    0,  404,  404,
+                   0,    0,    0,  404,  404,    0,    0,  404,  404,  404,
+                 404,  404,  404,  404,  404,  404,  404,  404 },
+  /*  390 */ {     0,    0,    0,    0,    0,  373,   76,32803,33173,33173,
+                 126,    0,    0,33173,33173,    0,    0,33173,33173,33173,
+               33173,33173,33173,33173,33173,33173,33173,33173 },
+  /*  391 */ {     0,   43,    0,   44,   43,  406,   43,    0,  407,  407,
+                  43,    0,   52,  407,  407,    0,    0,  407,  407,  407,
+                 407,  407,  407,  407,  407,  407,  407,  407 },
+  /*  392 */ {     0,   43,    0,   44,   43,  406,   55,    0,  407,  407,
+                  43,    0,   52,  407,  407,    0,    0,  407,  407,  407,
+                 407,  407,  407,  407,  407,  407,  407,  407 },
+  /*  393 */ {     0,   43,    0,   44,   43,  376,   55,32803,33176,33176,
+                  94,    0,   52,33176,33176,    0,    0,33176,33176,33176,
+               33176,33176,33176,33176,33176,33176,33176,33176 },
+  /*  394 */ {     0,    0,    0,    0,    0,  409,    0,    0,  410,  410,
+                   0,    0,    0,  410,  410,    0,    0,  410,  410,  410,
+                 410,  410,  410,  410,  410,  410,  410,  410 },
+  /*  395 */ {     0,    0,    0,    0,    0,  409,   96,    0,  410,  410,
+                   0,    0,    0,  410,  410,    0,    0,  410,  410,  410,
+                 410,  410,  410,  410,  410,  410,  410,  410 },
+  /*  396 */ {     0,    0,32884,    0,    0,  379,   96,32885,33179,33179,
+                 154,32885,    0,33179,33179,    0,    0,33179,33179,33179,
+               33179,33179,33179,33179,33179,33179,33179,33179 },
+  /*  397 */ {     0,   57,    0,   58,   57,  412,   57,    0,  413,  413,
+                  57,    0,   67,  413,  413,    0,    0,  413,  413,  413,
+                 413,  413,  413,  413,  413,  413,  413,  413 },
+  /*  398 */ {     0,   57,    0,   58,   57,  412,   70,    0,  413,  413,
+                  57,    0,   67,  413,  413,    0,    0,  413,  413,  413,
+                 413,  413,  413,  413,  413,  413,  413,  413 },
+  /*  399 */ {     0,   57,32884,   58,   57,  382,   70,32885,33182,33182,
+                 119,32885,   67,33182,33182,    0,    0,33182,33182,33182,
+               33182,33182,33182,33182,33182,33182,33182,33182 },
+  /*  400 */ {     0,    0,    0,    0,    0,  415,    0,    0,  416,  416,
+                   0,    0,    0,  416,  416,    0,    0,  416,  416,  416,
+                 416,  416,  416,  416,  416,  416,  416,  416 },
+  /*  401 */ {     0,    0,    0,    0,    0,  415,   18,    0,  416,  416,
+                   0,    0,    0,  416,  416,    0,    0,  416,  416,  416,
+                 416,  416,  416,  416,  416,  416,  416,  416 },
+  /*  402 */ {     0,    0,    0,    0,    0,  385,   18,    0,33185,33185,
+                   0,    0,    0,33185,33185,    0,    0,33185,33185,33185,
+               33185,33185,33185,33185,33185,33185,33185,33185 },
+  /*  403 */ {     0,    0,    0,    0,    0,  418,    0,    0,  419,  419,
+                   0,    0,    0,  419,  419,    0,    0,  419,  419,  419,
+                 419,  419,  419,  419,  419,  419,  419,  419 },
+  /*  404 */ {     0,    0,    0,    0,    0,  418,   76,    0,  419,  419,
+                   0,    0,    0,  419,  419,    0,    0,  419,  419,  419,
+                 419,  419,  419,  419,  419,  419,  419,  419 },
+  /*  405 */ {     0,    0,    0,    0,    0,  388,   76,32803,33188,33188,
+                 126,    0,    0,33188,33188,    0,    0,33188,33188,33188,
+               33188,33188,33188,33188,33188,33188,33188,33188 },
+  /*  406 */ {     0,   43,    0,   44,   43,  421,   43,    0,  422,  422,
+                  43,    0,   52,  422,  422,    0,    0,  422,  422,  422,
+                 422,  422,  422,  422,  422,  422,  422,  422 },
+  /*  407 */ {     0,   43,    0,   44,   43,  421,   55,    0,  422,  422,
+                  43,    0,   52,  422,  422,    0,    0,  422,  422,  422,
+                 422,  422,  422,  422,  422,  422,  422,  422 },
+  /*  408 */ {     0,   43,    0,   44,   43,  391,   55,32803,33191,33191,
+                  94,    0,   52,33191,33191,    0,    0,33191,33191,33191,
+               33191,33191,33191,33191,33191,33191,33191,33191 },
+  /*  409 */ {     0,    0,    0,    0,    0,  424,    0,    0,  425,  425,
+                   0,    0,    0,  425,  425,    0,    0,  425,  425,  425,
+                 425,  425,  425,  425,  425,  425,  425,  425 },
+  /*  410 */ {     0,    0,    0,    0,    0,  424,   96,    0,  425,  425,
+                   0,    0,    0,  425,  425,    0,    0,  425,  425,  425,
+                 425,  425,  425,  425,  425,  425,  425,  425 },
+  /*  411 */ {     0,    0,32884,    0,    0,  394,   96,32885,33194,33194,
+                 154,32885,    0,33194,33194,    0,    0,33194,33194,33194,
+               33194,33194,33194,33194,33194,33194,33194,33194 },
+  /*  412 */ {     0,   57,    0,   58,   57,  427,   57,    0,  428,  428,
+                  57,    0,   67,  428,  428,    0,    0,  428,  428,  428,
+                 428,  428,  428,  428,  428,  428,  428,  428 },
+  /*  413 */ {     0,   57,    0,   58,   57,  427,   70,    0,  428,  428,
+                  57,    0,   67,  428,  428,    0,    0,  428,  428,  428,
+                 428,  428,  428,  428,  428,  428,  428,  428 },
+  /*  414 */ {     0,   57,32884,   58,   57,  397,   70,32885,33197,33197,
+                 119,32885,   67,33197,33197,    0,    0,33197,33197,33197,
+               33197,33197,33197,33197,33197,33197,33197,33197 },
+  /*  415 */ {     0,    0,    0,    0,    0,  430,    0,    0,  431,  431,
+                   0,    0,    0,  431,  431,    0,    0,  431,  431,  431,
+                 431,  431,  431,  431,  431,  431,  431,  431 },
+  /*  416 */ {     0,    0,    0,    0,    0,  430,   18,    0,  431,  431,
+                   0,    0,    0,  431,  431,    0,    0,  431,  431,  431,
+                 431,  431,  431,  431,  431,  431,  431,  431 },
+  /*  417 */ {     0,    0,    0,    0,    0,  400,   18,    0,33200,33200,
+                   0,    0,    0,33200,33200,    0,    0,33200,33200,33200,
+               33200,33200,33200,33200,33200,33200,33200,33200 },
+  /*  418 */ {     0,    0,    0,    0,    0,  433,    0,    0,  434,  434,
+                   0,    0,    0,  434,  434,    0,    0,  434,  434,  434,
+                 434,  434,  434,  434,  434,  434,  434,  434 },
+  /*  419 */ {     0,    0,    0,    0,    0,  433,   76,    0,  434,  434,
+                   0,    0,    0,  434,  434,    0,    0,  434,  434,  434,
+                 434,  434,  434,  434,  434,  434,  434,  434 },
+  /*  420 */ {     0,    0,    0,    0,    0,  403,   76,32803,33203,33203,
+                 126,    0,    0,33203,33203,    0,    0,33203,33203,33203,
+               33203,33203,33203,33203,33203,33203,33203,33203 },
+  /*  421 */ {     0,   43,    0,   44,   43,  436,   43,    0,  437,  437,
+                  43,    0,   52,  437,  437,    0,    0,  437,  437,  437,
+                 437,  437,  437,  437,  437,  437,  437,  437 },
+  /*  422 */ {     0,   43,    0,   44,   43,  436,   55,    0,  437,  437,
+                  43,    0,   52,  437,  437,    0,    0,  437,  437,  437,
+                 437,  437,  437,  437,  437,  437,  437,  437 },
+  /*  423 */ {     0,   43,    0,   44,   43,  406,   55,32803,33206,33206,
+                  94,    0,   52,33206,33206,    0,    0,33206,33206,33206,
+               33206,33206,33206,33206,33206,33206,33206,33206 },
+  /*  424 */ {     0,    0,    0,    0,    0,  439,    0,    0,  440,  440,
+                   0,    0,    0,  440,  440,    0,    0,  440,  440,  440,
+                 440,  440,  440,  440,  440,  440,  440,  440 },
+  /*  425 */ {     0,    0,    0,    0,    0,  439,   96,    0,  440,  440,
+                   0,    0,    0,  440,  440,    0,    0,  440,  440,  440,
+                 440,  440,  440,  440,  440,  440,  440,  440 },
+  /*  426 */ {     0,    0,32884,    0,    0,  409,   96,32885,33209,33209,
+                 154,32885,    0,33209,33209,    0,    0,33209,33209,33209,
+               33209,33209,33209,33209,33209,33209,33209,33209 },
+  /*  427 */ {     0,   57,    0,   58,   57,  442,   57,    0,  443,  443,
+                  57,    0,   67,  443,  443,    0,    0,  443,  443,  443,
+                 443,  443,  443,  443,  443,  443,  443,  443 },
+  /*  428 */ {     0,   57,    0,   58,   57,  442,   70,    0,  443,  443,
+                  57,    0,   67,  443,  443,    0,    0,  443,  443,  443,
+                 443,  443,  443,  443,  443,  443,  443,  443 },
+  /*  429 */ {     0,   57,32884,   58,   57,  412,   70,32885,33212,33212,
+                 119,32885,   67,33212,33212,    0,    0,33212,33212,33212,
+               33212,33212,33212,33212,33212,33212,33212,33212 },
+  /*  430 */ {     0,    0,    0,    0,    0,  445,    0,    0,  446,  446,
+                   0,    0,    0,  446,  446,    0,    0,  446,  446,  446,
+                 446,  446,  446,  446,  446,  446,  446,  446 },
+  /*  431 */ {     0,    0,    0,    0,    0,  445,   18,    0,  446,  446,
+                   0,    0,    0,  446,  446,    0,    0,  446,  446,  446,
+                 446,  446,  446,  446,  446,  446,  446,  446 },
+  /*  432 */ {     0,    0,    0,    0,    0,  415,   18,    0,33215,33215,
+                   0,    0,    0,33215,33215,    0,    0,33215,33215,33215,
+               33215,33215,33215,33215,33215,33215,33215,33215 },
+  /*  433 */ {     0,    0,    0,    0,    0,  448,    0,    0,  449,  449,
+                   0,    0,    0,  449,  449,    0,    0,  449,  449,  449,
+                 449,  449,  449,  449,  449,  449,  449,  449 },
+  /*  434 */ {     0,    0,    0,    0,    0,  448,   76,    0,  449,  449,
+                   0,    0,    0,  449,  449,    0,    0,  449,  449,  449,
+                 449,  449,  449,  449,  449,  449,  449,  449 },
+  /*  435 */ {     0,    0,    0,    0,    0,  418,   76,32803,33218,33218,
+                 126,    0,    0,33218,33218,    0,    0,33218,33218,33218,
+               33218,33218,33218,33218,33218,33218,33218,33218 },
+  /*  436 */ {     0,   43,    0,   44,   43,  451,   43,    0,  452,  452,
+                  43,    0,   52,  452,  452,    0,    0,  452,  452,  452,
+                 452,  452,  452,  452,  452,  452,  452,  452 },
+  /*  437 */ {     0,   43,    0,   44,   43,  451,   55,    0,  452,  452,
+                  43,    0,   52,  452,  452,    0,    0,  452,  452,  452,
+                 452,  452,  452,  452,  452,  452,  452,  452 },
+  /*  438 */ {     0,   43,    0,   44,   43,  421,   55,32803,33221,33221,
+                  94,    0,   52,33221,33221,    0,    0,33221,33221,33221,
+               33221,33221,33221,33221,33221,33221,33221,33221 },
+  /*  439 */ {     0,    0,    0,    0,    0,  454,    0,    0,  455,  455,
+                   0,    0,    0,  455,  455,    0,    0,  455,  455,  455,
+                 455,  455,  455,  455,  455,  455,  455,  455 },
+  /*  440 */ {     0,    0,    0,    0,    0,  454,   96,    0,  455,  455,
+                   0,    0,    0,  455,  455,    0,    0,  455,  455,  455,
+                 455,  455,  455,  455,  455,  455,  455,  455 },
+  /*  441 */ {     0,    0,32884,    0,    0,  424,   96,32885,33224,33224,
+                 154,32885,    0,33224,33224,    0,    0,33224,33224,33224,
+               33224,33224,33224,33224,33224,33224,33224,33224 },
+  /*  442 */ {     0,   57,    0,   58,   57,  457,   57,    0,  458,  458,
+                  57,    0,   67,  458,  458,    0,    0,  458,  458,  458,
+                 458,  458,  458,  458,  458,  458,  458,  458 },
+  /*  443 */ {     0,   57,    0,   58,   57,  457,   70,    0,  458,  458,
+                  57,    0,   67,  458,  458,    0,    0,  458,  458,  458,
+                 458,  458,  458,  458,  458,  458,  458,  458 },
+  /*  444 */ {     0,   57,32884,   58,   57,  427,   70,32885,33227,33227,
+                 119,32885,   67,33227,33227,    0,    0,33227,33227,33227,
+               33227,33227,33227,33227,33227,33227,33227,33227 },
+  /*  445 */ {     0,    0,    0,    0,    0,  460,    0,    0,  461,  461,
+                   0,    0,    0,  461,  461,    0,    0,  461,  461,  461,
+                 461,  461,  461,  461,  461,  461,  461,  461 },
+  /*  446 */ {     0,    0,    0,    0,    0,  460,   18,    0,  461,  461,
+                   0,    0,    0,  461,  461,    0,    0,  461,  461,  461,
+                 461,  461,  461,  461,  461,  461,  461,  461 },
+  /*  447 */ {     0,    0,    0,    0,    0,  430,   18,    0,33230,33230,
+                   0,    0,    0,33230,33230,    0,    0,33230,33230,33230,
+               33230,33230,33230,33230,33230,33230,33230,33230 },
+  /*  448 */ {     0,    0,    0,    0,    0,  463,    0,    0,  464,  464,
+                   0,    0,    0,  464,  464,    0,    0,  464,  464,  464,
+                 464,  464,  464,  464,  464,  464,  464,  464 },
+  /*  449 */ {     0,    0,    0,    0,    0,  463,   76,    0,  464,  464,
+                   0,    0,    0,  464,  464,    0,    0,  464,  464,  464,
+                 464,  464,  464,  464,  464,  464,  464,  464 },
+  /*  450 */ {     0,    0,    0,    0,    0,  433,   76,32803,33233,33233,
+                 126,    0,    0,33233,33233,    0,    0,33233,33233,33233,
+               33233,33233,33233,33233,33233,33233,33233,33233 },
+  /*  451 */ {     0,   43,    0,   44,   43,  466,   43,    0,  467,  467,
+                  43,    0,   52,  467,  467,    0,    0,  467,  467,  467,
+                 467,  467,  467,  467,  467,  467,  467,  467 },
+  /*  452 */ {     0,   43,    0,   44,   43,  466,   55,    0,  467,  467,
+                  43,    0,   52,  467,  467,    0,    0,  467,  467,  467,
+                 467,  467,  467,  467,  467,  467,  467,  467 },
+  /*  453 */ {     0,   43,    0,   44,   43,  436,   55,32803,33236,33236,
+                  94,    0,   52,33236,33236,    0,    0,33236,33236,33236,
+               33236,33236,33236,33236,33236,33236,33236,33236 },
+  /*  454 */ {     0,    0,    0,    0,    0,  469,    0,    0,  470,  470,
+                   0,    0,    0,  470,  470,    0,    0,  470,  470,  470,
+                 470,  470,  470,  470,  470,  470,  470,  470 },
+  /*  455 */ {     0,    0,    0,    0,    0,  469,   96,    0,  470,  470,
+                   0,    0,    0,  470,  470,    0,    0,  470,  470,  470,
+                 470,  470,  470,  470,  470,  470,  470,  470 },
+  /*  456 */ {     0,    0,32884,    0,    0,  439,   96,32885,33239,33239,
+                 154,32885,    0,33239,33239,    0,    0,33239,33239,33239,
+               33239,33239,33239,33239,33239,33239,33239,33239 },
+  /*  457 */ {     0,   57,    0,   58,   57,  472,   57,    0,  473,  473,
+                  57,    0,   67,  473,  473,    0,    0,  473,  473,  473,
+                 473,  473,  473,  473,  473,  473,  473,  473 },
+  /*  458 */ {     0,   57,    0,   58,   57,  472,   70,    0,  473,  473,
+                  57,    0,   67,  473,  473,    0,    0,  473,  473,  473,
+                 473,  473,  473,  473,  473,  473,  473,  473 },
+  /*  459 */ {     0,   57,32884,   58,   57,  442,   70,32885,33242,33242,
+                 119,32885,   67,33242,33242,    0,    0,33242,33242,33242,
+               33242,33242,33242,33242,33242,33242,33242,33242 },
+  /*  460 */ {     0,    0,    0,    0,    0,  475,    0,    0,  476,  476,
+                   0,    0,    0,  476,  476,    0,    0,  476,  476,  476,
+                 476,  476,  476,  476,  476,  476,  476,  476 },
+  /*  461 */ {     0,    0,    0,    0,    0,  475,   18,    0,  476,  476,
+                   0,    0,    0,  476,  476,    0,    0,  476,  476,  476,
+                 476,  476,  476,  476,  476,  476,  476,  476 },
+  /*  462 */ {     0,    0,    0,    0,    0,  445,   18,    0,33245,33245,
+                   0,    0,    0,33245,33245,    0,    0,33245,33245,33245,
+               33245,33245,33245,33245,33245,33245,33245,33245 },
+  /*  463 */ {     0,    0,    0,    0,    0,  478,    0,    0,  479,  479,
+                   0,    0,    0,  479,  479,    0,    0,  479,  479,  479,
+                 479,  479,  479,  479,  479,  479,  479,  479 },
+  /*  464 */ {     0,    0,    0,    0,    0,  478,   76,    0,  479,  479,
+                   0,    0,    0,  479,  479,    0,    0,  479,  479,  479,
+                 479,  479,  479,  479,  479,  479,  479,  479 },
+  /*  465 */ {     0,    0,    0,    0,    0,  448,   76,32803,33248,33248,
+                 126,    0,    0,33248,33248,    0,    0,33248,33248,33248,
+               33248,33248,33248,33248,33248,33248,33248,33248 },
+  /*  466 */ {     0,   43,    0,   44,   43,  481,   43,    0,  482,  482,
+                  43,    0,   52,  482,  482,    0,    0,  482,  482,  482,
+                 482,  482,  482,  482,  482,  482,  482,  482 },
+  /*  467 */ {     0,   43,    0,   44,   43,  481,   55,    0,  482,  482,
+                  43,    0,   52,  482,  482,    0,    0,  482,  482,  482,
+                 482,  482,  482,  482,  482,  482,  482,  482 },
+  /*  468 */ {     0,   43,    0,   44,   43,  451,   55,32803,33251,33251,
+                  94,    0,   52,33251,33251,    0,    0,33251,33251,33251,
+               33251,33251,33251,33251,33251,33251,33251,33251 },
+  /*  469 */ {     0,    0,    0,    0,    0,  484,    0,    0,  485,  485,
+                   0,    0,    0,  485,  485,    0,    0,  485,  485,  485,
+                 485,  485,  485,  485,  485,  485,  485,  485 },
+  /*  470 */ {     0,    0,    0,    0,    0,  484,   96,    0,  485,  485,
+                   0,    0,    0,  485,  485,    0,    0,  485,  485,  485,
+                 485,  485,  485,  485,  485,  485,  485,  485 },
+  /*  471 */ {     0,    0,32884,    0,    0,  454,   96,32885,33254,33254,
+                 154,32885,    0,33254,33254,    0,    0,33254,33254,33254,
+               33254,33254,33254,33254,33254,33254,33254,33254 },
+  /*  472 */ {     0,   57,    0,   58,   57,  487,   57,    0,  488,  488,
+                  57,    0,   67,  488,  488,    0,    0,  488,  488,  488,
+                 488,  488,  488,  488,  488,  488,  488,  488 },
+  /*  473 */ {     0,   57,    0,   58,   57,  487,   70,    0,  488,  488,
+                  57,    0,   67,  488,  488,    0,    0,  488,  488,  488,
+                 488,  488,  488,  488,  488,  488,  488,  488 },
+  /*  474 */ {     0,   57,32884,   58,   57,  457,   70,32885,33257,33257,
+                 119,32885,   67,33257,33257,    0,    0,33257,33257,33257,
+               33257,33257,33257,33257,33257,33257,33257,33257 },
+  /*  475 */ {     0,    0,    0,    0,    0,  490,    0,    0,  491,  491,
+                   0,    0,    0,  491,  491,    0,    0,  491,  491,  491,
+                 491,  491,  491,  491,  491,  491,  491,  491 },
+  /*  476 */ {     0,    0,    0,    0,    0,  490,   18,    0,  491,  491,
+                   0,    0,    0,  491,  491,    0,    0,  491,  491,  491,
+                 491,  491,  491,  491,  491,  491,  491,  491 },
+  /*  477 */ {     0,    0,    0,    0,    0,  460,   18,    0,33260,33260,
+                   0,    0,    0,33260,33260,    0,    0,33260,33260,33260,
+               33260,33260,33260,33260,33260,33260,33260,33260 },
+  /*  478 */ {     0,    0,    0,    0,    0,  493,    0,    0,  494,  494,
+                   0,    0,    0,  494,  494,    0,    0,  494,  494,  494,
+                 494,  494,  494,  494,  494,  494,  494,  494 },
+  /*  479 */ {     0,    0,    0,    0,    0,  493,   76,    0,  494,  494,
+                   0,    0,    0,  494,  494,    0,    0,  494,  494,  494,
+                 494,  494,  494,  494,  494,  494,  494,  494 },
+  /*  480 */ {     0,    0,    0,    0,    0,  463,   76,32803,33263,33263,
+                 126,    0,    0,33263,33263,    0,    0,33263,33263,33263,
+               33263,33263,33263,33263,33263,33263,33263,33263 },
+  /*  481 */ {     0,   43,    0,   44,   43,  496,   43,    0,  497,  497,
+                  43,    0,   52,  497,  497,    0,    0,  497,  497,  497,
+                 497,  497,  497,  497,  497,  497,  497,  497 },
+  /*  482 */ {     0,   43,    0,   44,   43,  496,   55,    0,  497,  497,
+                  43,    0,   52,  497,  497,    0,    0,  497,  497,  497,
+                 497,  497,  497,  497,  497,  497,  497,  497 },
+  /*  483 */ {     0,   43,    0,   44,   43,  466,   55,32803,33266,33266,
+                  94,    0,   52,33266,33266,    0,    0,33266,33266,33266,
+               33266,33266,33266,33266,33266,33266,33266,33266 },
+  /*  484 */ {     0,    0,    0,    0,    0,  499,    0,    0,  500,  500,
+                   0,    0,    0,  500,  500,    0,    0,  500,  500,  500,
+                 500,  500,  500,  500,  500,  500,  500,  500 },
+  /*  485 */ {     0,    0,    0,    0,    0,  499,   96,    0,  500,  500,
+                   0,    0,    0,  500,  500,    0,    0,  500,  500,  500,
+                 500,  500,  500,  500,  500,  500,  500,  500 },
+  /*  486 */ {     0,    0,32884,    0,    0,  469,   96,32885,33269,33269,
+                 154,32885,    0,33269,33269,    0,    0,33269,33269,33269,
+               33269,33269,33269,33269,33269,33269,33269,33269 },
+  /*  487 */ {     0,   57,    0,   58,   57,  502,   57,    0,  503,  503,
+                  57,    0,   67,  503,  503,    0,    0,  503,  503,  503,
+                 503,  503,  503,  503,  503,  503,  503,  503 },
+  /*  488 */ {     0,   57,    0,   58,   57,  502,   70,    0,  503,  503,
+                  57,    0,   67,  503,  503,    0,    0,  503,  503,  503,
+                 503,  503,  503,  503,  503,  503,  503,  503 },
+  /*  489 */ {     0,   57,32884,   58,   57,  472,   70,32885,33272,33272,
+                 119,32885,   67,33272,33272,    0,    0,33272,33272,33272,
+               33272,33272,33272,33272,33272,33272,33272,33272 },
+  /*  490 */ {     0,    0,    0,    0,    0,  505,    0,    0,  506,  506,
+                   0,    0,    0,  506,  506,    0,    0,  506,  506,  506,
+                 506,  506,  506,  506,  506,  506,  506,  506 },
+  /*  491 */ {     0,    0,    0,    0,    0,  505,   18,    0,  506,  506,
+                   0,    0,    0,  506,  506,    0,    0,  506,  506,  506,
+                 506,  506,  506,  506,  506,  506,  506,  506 },
+  /*  492 */ {     0,    0,    0,    0,    0,  475,   18,    0,33275,33275,
+                   0,    0,    0,33275,33275,    0,    0,33275,33275,33275,
+               33275,33275,33275,33275,33275,33275,33275,33275 },
+  /*  493 */ {     0,    0,    0,    0,    0,  508,    0,    0,  509,  509,
+                   0,    0,    0,  509,  509,    0,    0,  509,  509,  509,
+                 509,  509,  509,  509,  509,  509,  509,  509 },
+  /*  494 */ {     0,    0,    0,    0,    0,  508,   76,    0,  509,  509,
+                   0,    0,    0,  509,  509,    0,    0,  509,  509,  509,
+                 509,  509,  509,  509,  509,  509,  509,  509 },
+  /*  495 */ {     0,    0,    0,    0,    0,  478,   76,32803,33278,33278,
+                 126,    0,    0,33278,33278,    0,    0,33278,33278,33278,
+               33278,33278,33278,33278,33278,33278,33278,33278 },
+  /*  496 */ {     0,   43,    0,   44,   43,  511,   43,    0,  512,  512,
+                  43,    0,   52,  512,  512,    0,    0,  512,  512,  512,
+                 512,  512,  512,  512,  512,  512,  512,  512 },
+  /*  497 */ {     0,   43,    0,   44,   43,  511,   55,    0,  512,  512,
+                  43,    0,   52,  512,  512,    0,    0,  512,  512,  512,
+                 512,  512,  512,  512,  512,  512,  512,  512 },
+  /*  498 */ {     0,   43,    0,   44,   43,  481,   55,32803,33281,33281,
+                  94,    0,   52,33281,33281,    0,    0,33281,33281,33281,
+               33281,33281,33281,33281,33281,33281,33281,33281 },
+  /*  499 */ {     0,    0,    0,    0,    0,  514,    0,    0,  515,  515,
+                   0,    0,    0,  515,  515,    0,    0,  515,  515,  515,
+                 515,  515,  515,  515,  515,  515,  515,  515 },
+  /*  500 */ {     0,    0,    0,    0,    0,  514,   96,    0,  515,  515,
+                   0,    0,    0,  515,  515,    0,    0,  515,  515,  515,
+                 515,  515,  515,  515,  515,  515,  515,  515 },
+  /*  501 */ {     0,    0,32884,    0,    0,  484,   96,32885,33284,33284,
+                 154,32885,    0,33284,33284,    0,    0,33284,33284,33284,
+               33284,33284,33284,33284,33284,33284,33284,33284 },
+  /*  502 */ {     0,   57,    0,   58,   57,  517,   57,    0,  518,  518,
+                  57,    0,   67,  518,  518,    0,    0,  518,  518,  518,
+                 518,  518,  518,  518,  518,  518,  518,  518 },
+  /*  503 */ {     0,   57,    0,   58,   57,  517,   70,    0,  518,  518,
+                  57,    0,   67,  518,  518,    0,    0,  518,  518,  518,
+                 518,  518,  518,  518,  518,  518,  518,  518 },
+  /*  504 */ {     0,   57,32884,   58,   57,  487,   70,32885,33287,33287,
+                 119,32885,   67,33287,33287,    0,    0,33287,33287,33287,
+               33287,33287,33287,33287,33287,33287,33287,33287 },
+  /*  505 */ {     0,    0,    0,    0,    0,  520,    0,    0,  521,  521,
+                   0,    0,    0,  521,  521,    0,    0,  521,  521,  521,
+                 521,  521,  521,  521,  521,  521,  521,  521 },
+  /*  506 */ {     0,    0,    0,    0,    0,  520,   18,    0,  521,  521,
+                   0,    0,    0,  521,  521,    0,    0,  521,  521,  521,
+                 521,  521,  521,  521,  521,  521,  521,  521 },
+  /*  507 */ {     0,    0,    0,    0,    0,  490,   18,    0,33290,33290,
+                   0,    0,    0,33290,33290,    0,    0,33290,33290,33290,
+               33290,33290,33290,33290,33290,33290,33290,33290 },
+  /*  508 */ {     0,    0,    0,    0,    0,  523,    0,    0,  524,  524,
+                   0,    0,    0,  524,  524,    0,    0,  524,  524,  524,
+                 524,  524,  524,  524,  524,  524,  524,  524 },
+  /*  509 */ {     0,    0,    0,    0,    0,  523,   76,    0,  524,  524,
+                   0,    0,    0,  524,  524,    0,    0,  524,  524,  524,
+                 524,  524,  524,  524,  524,  524,  524,  524 },
+  /*  510 */ {     0,    0,    0,    0,    0,  493,   76,32803,33293,33293,
+                 126,    0,    0,33293,33293,    0,    0,33293,33293,33293,
+               33293,33293,33293,33293,33293,33293,33293,33293 },
+  /*  511 */ {     0,   43,    0,   44,   43,  526,   43,    0,  527,  527,
+                  43,    0,   52,  527,  527,    0,    0,  527,  527,  527,
+                 527,  527,  527,  527,  527,  527,  527,  527 },
+  /*  512 */ {     0,   43,    0,   44,   43,  526,   55,    0,  527,  527,
+                  43,    0,   52,  527,  527,    0,    0,  527,  527,  527,
+                 527,  527,  527,  527,  527,  527,  527,  527 },
+  /*  513 */ {     0,   43,    0,   44,   43,  496,   55,32803,33296,33296,
+                  94,    0,   52,33296,33296,    0,    0,33296,33296,33296,
+               33296,33296,33296,33296,33296,33296,33296,33296 },
+  /*  514 */ {     0,    0,    0,    0,    0,  529,    0,    0,  530,  530,
+                   0,    0,    0,  530,  530,    0,    0,  530,  530,  530,
+                 530,  530,  530,  530,  530,  530,  530,  530 },
+  /*  515 */ {     0,    0,    0,    0,    0,  529,   96,    0,  530,  530,
+                   0,    0,    0,  530,  530,    0,    0,  530,  530,  530,
+                 530,  530,  530,  530,  530,  530,  530,  530 },
+  /*  516 */ {     0,    0,32884,    0,    0,  499,   96,32885,33299,33299,
+                 154,32885,    0,33299,33299,    0,    0,33299,33299,33299,
+               33299,33299,33299,33299,33299,33299,33299,33299 },
+  /*  517 */ {     0,   57,    0,   58,   57,  532,   57,    0,  533,  533,
+                  57,    0,   67,  533,  533,    0,    0,  533,  533,  533,
+                 533,  533,  533,  533,  533,  533,  533,  533 },
+  /*  518 */ {     0,   57,    0,   58,   57,  532,   70,    0,  533,  533,
+                  57,    0,   67,  533,  533,    0,    0,  533,  533,  533,
+                 533,  533,  533,  533,  533,  533,  533,  533 },
+  /*  519 */ {     0,   57,32884,   58,   57,  502,   70,32885,33302,33302,
+                 119,32885,   67,33302,33302,    0,    0,33302,33302,33302,
+               33302,33302,33302,33302,33302,33302,33302,33302 },
+  /*  520 */ {     0,    0,    0,    0,    0,  535,    0,    0,  536,  536,
+                   0,    0,    0,  536,  536,    0,    0,  536,  536,  536,
+                 536,  536,  536,  536,  536,  536,  536,  536 },
+  /*  521 */ {     0,    0,    0,    0,    0,  535,   18,    0,  536,  536,
+                   0,    0,    0,  536,  536,    0,    0,  536,  536,  536,
+                 536,  536,  536,  536,  536,  536,  536,  536 },
+  /*  522 */ {     0,    0,    0,    0,    0,  505,   18,    0,33305,33305,
+                   0,    0,    0,33305,33305,    0,    0,33305,33305,33305,
+               33305,33305,33305,33305,33305,33305,33305,33305 },
+  /*  523 */ {     0,    0,    0,    0,    0,  538,    0,    0,  539,  539,
+                   0,    0,    0,  539,  539,    0,    0,  539,  539,  539,
+                 539,  539,  539,  539,  539,  539,  539,  539 },
+  /*  524 */ {     0,    0,    0,    0,    0,  538,   76,    0,  539,  539,
+                   0,    0,    0,  539,  539,    0,    0,  539,  539,  539,
+                 539,  539,  539,  539,  539,  539,  539,  539 },
+  /*  525 */ {     0,    0,    0,    0,    0,  508,   76,32803,33308,33308,
+                 126,    0,    0,33308,33308,    0,    0,33308,33308,33308,
+               33308,33308,33308,33308,33308,33308,33308,33308 },
+  /*  526 */ {     0,   43,    0,   44,   43,  541,   43,    0,  542,  542,
+                  43,    0,   52,  542,  542,    0,    0,  542,  542,  542,
+                 542,  542,  542,  542,  542,  542,  542,  542 },
+  /*  527 */ {     0,   43,    0,   44,   43,  541,   55,    0,  542,  542,
+                  43,    0,   52,  542,  542,    0,    0,  542,  542,  542,
+                 542,  542,  542,  542,  542,  542,  542,  542 },
+  /*  528 */ {     0,   43,    0,   44,   43,  511,   55,32803,33311,33311,
+                  94,    0,   52,33311,33311,    0,    0,33311,33311,33311,
+               33311,33311,33311,33311,33311,33311,33311,33311 },
+  /*  529 */ {     0,    0,    0,    0,    0,  544,    0,    0,  545,  545,
+                   0,    0,    0,  545,  545,    0,    0,  545,  545,  545,
+                 545,  545,  545,  545,  545,  545,  545,  545 },
+  /*  530 */ {     0,    0,    0,    0,    0,  544,   96,    0,  545,  545,
+                   0,    0,    0,  545,  545,    0,    0,  545,  545,  545,
+                 545,  545,  545,  545,  545,  545,  545,  545 },
+  /*  531 */ {     0,    0,32884,    0,    0,  514,   96,32885,33314,33314,
+                 154,32885,    0,33314,33314,    0,    0,33314,33314,33314,
+               33314,33314,33314,33314,33314,33314,33314,33314 },
+  /*  532 */ {     0,   57,    0,   58,   57,  547,   57,    0,  548,  548,
+                  57,    0,   67,  548,  548,    0,    0,  548,  548,  548,
+                 548,  548,  548,  548,  548,  548,  548,  548 },
+  /*  533 */ {     0,   57,    0,   58,   57,  547,   70,    0,  548,  548,
+                  57,    0,   67,  548,  548,    0,    0,  548,  548,  548,
+                 548,  548,  548,  548,  548,  548,  548,  548 },
+  /*  534 */ {     0,   57,32884,   58,   57,  517,   70,32885,33317,33317,
+                 119,32885,   67,33317,33317,    0,    0,33317,33317,33317,
+               33317,33317,33317,33317,33317,33317,33317,33317 },
+  /*  535 */ {     0,    0,    0,    0,    0,  550,    0,    0,  551,  551,
+                   0,    0,    0,  551,  551,    0,    0,  551,  551,  551,
+                 551,  551,  551,  551,  551,  551,  551,  551 },
+  /*  536 */ {     0,    0,    0,    0,    0,  550,   18,    0,  551,  551,
+                   0,    0,    0,  551,  551,    0,    0,  551,  551,  551,
+                 551,  551,  551,  551,  551,  551,  551,  551 },
+  /*  537 */ {     0,    0,    0,    0,    0,  520,   18,    0,33320,33320,
+                   0,    0,    0,33320,33320,    0,    0,33320,33320,33320,
+               33320,33320,33320,33320,33320,33320,33320,33320 },
+  /*  538 */ {     0,    0,    0,    0,    0,  553,    0,    0,  554,  554,
+                   0,    0,    0,  554,  554,    0,    0,  554,  554,  554,
+                 554,  554,  554,  554,  554,  554,  554,  554 },
+  /*  539 */ {     0,    0,    0,    0,    0,  553,   76,    0,  554,  554,
+                   0,    0,    0,  554,  554,    0,    0,  554,  554,  554,
+                 554,  554,  554,  554,  554,  554,  554,  554 },
+  /*  540 */ {     0,    0,    0,    0,    0,  523,   76,32803,33323,33323,
+                 126,    0,    0,33323,33323,    0,    0,33323,33323,33323,
+               33323,33323,33323,33323,33323,33323,33323,33323 },
+  /*  541 */ {     0,   43,    0,   44,   43,  556,   43,    0,  557,  557,
+                  43,    0,   52,  557,  557,    0,    0,  557,  557,  557,
+                 557,  557,  557,  557,  557,  557,  557,  557 },
+  /*  542 */ {     0,   43,    0,   44,   43,  556,   55,    0,  557,  557,
+                  43,    0,   52,  557,  557,    0,    0,  557,  557,  557,
+                 557,  557,  557,  557,  557,  557,  557,  557 },
+  /*  543 */ {     0,   43,    0,   44,   43,  526,   55,32803,33326,33326,
+                  94,    0,   52,33326,33326,    0,    0,33326,33326,33326,
+               33326,33326,33326,33326,33326,33326,33326,33326 },
+  /*  544 */ {     0,    0,    0,    0,    0,  559,    0,    0,  560,  560,
+                   0,    0,    0,  560,  560,    0,    0,  560,  560,  560,
+                 560,  560,  560,  560,  560,  560,  560,  560 },
+  /*  545 */ {     0,    0,    0,    0,    0,  559,   96,    0,  560,  560,
+                   0,    0,    0,  560,  560,    0,    0,  560,  560,  560,
+                 560,  560,  560,  560,  560,  560,  560,  560 },
+  /*  546 */ {     0,    0,32884,    0,    0,  529,   96,32885,33329,33329,
+                 154,32885,    0,33329,33329,    0,    0,33329,33329,33329,
+               33329,33329,33329,33329,33329,33329,33329,33329 },
+  /*  547 */ {     0,   57,    0,   58,   57,  562,   57,    0,  563,  563,
+                  57,    0,   67,  563,  563,    0,    0,  563,  563,  563,
+                 563,  563,  563,  563,  563,  563,  563,  563 },
+  /*  548 */ {     0,   57,    0,   58,   57,  562,   70,    0,  563,  563,
+                  57,    0,   67,  563,  563,    0,    0,  563,  563,  563,
+                 563,  563,  563,  563,  563,  563,  563,  563 },
+  /*  549 */ {     0,   57,32884,   58,   57,  532,   70,32885,33332,33332,
+                 119,32885,   67,33332,33332,    0,    0,33332,33332,33332,
+               33332,33332,33332,33332,33332,33332,33332,33332 },
+  /*  550 */ {     0,    0,    0,    0,    0,  565,    0,    0,  566,  566,
+                   0,    0,    0,  566,  566,    0,    0,  566,  566,  566,
+                 566,  566,  566,  566,  566,  566,  566,  566 },
+  /*  551 */ {     0,    0,    0,    0,    0,  565,   18,    0,  566,  566,
+                   0,    0,    0,  566,  566,    0,    0,  566,  566,  566,
+                 566,  566,  566,  566,  566,  566,  566,  566 },
+  /*  552 */ {     0,    0,    0,    0,    0,  535,   18,    0,33335,33335,
+                   0,    0,    0,33335,33335,    0,    0,33335,33335,33335,
+               33335,33335,33335,33335,33335,33335,33335,33335 },
+  /*  553 */ {     0,    0,    0,    0,    0,  568,    0,    0,  569,  569,
+                   0,    0,    0,  569,  569,    0,    0,  569,  569,  569,
+                 569,  569,  569,  569,  569,  569,  569,  569 },
+  /*  554 */ {     0,    0,    0,    0,    0,  568,   76,    0,  569,  569,
+                   0,    0,    0,  569,  569,    0,    0,  569,  569,  569,
+                 569,  569,  569,  569,  569,  569,  569,  569 },
+  /*  555 */ {     0,    0,    0,    0,    0,  538,   76,32803,33338,33338,
+                 126,    0,    0,33338,33338,    0,    0,33338,33338,33338,
+               33338,33338,33338,33338,33338,33338,33338,33338 },
+  /*  556 */ {     0,   43,    0,   44,   43,  571,   43,    0,  572,  572,
+                  43,    0,   52,  572,  572,    0,    0,  572,  572,  572,
+                 572,  572,  572,  572,  572,  572,  572,  572 },
+  /*  557 */ {     0,   43,    0,   44,   43,  571,   55,    0,  572,  572,
+                  43,    0,   52,  572,  572,    0,    0,  572,  572,  572,
+                 572,  572,  572,  572,  572,  572,  572,  572 },
+  /*  558 */ {     0,   43,    0,   44,   43,  541,   55,32803,33341,33341,
+                  94,    0,   52,33341,33341,    0,    0,33341,33341,33341,
+               33341,33341,33341,33341,33341,33341,33341,33341 },
+  /*  559 */ {     0,    0,    0,    0,    0,  574,    0,    0,  575,  575,
+                   0,    0,    0,  575,  575,    0,    0,  575,  575,  575,
+                 575,  575,  575,  575,  575,  575,  575,  575 },
+  /*  560 */ {     0,    0,    0,    0,    0,  574,   96,    0,  575,  575,
+                   0,    0,    0,  575,  575,    0,    0,  575,  575,  575,
+                 575,  575,  575,  575,  575,  575,  575,  575 },
+  /*  561 */ {     0,    0,32884,    0,    0,  544,   96,32885,33344,33344,
+                 154,32885,    0,33344,33344,    0,    0,33344,33344,33344,
+               33344,33344,33344,33344,33344,33344,33344,33344 },
+  /*  562 */ {     0,   57,    0,   58,   57,  577,   57,    0,  578,  578,
+                  57,    0,   67,  578,  578,    0,    0,  578,  578,  578,
+                 578,  578,  578,  578,  578,  578,  578,  578 },
+  /*  563 */ {     0,   57,    0,   58,   57,  577,   70,    0,  578,  578,
+                  57,    0,   67,  578,  578,    0,    0,  578,  578,  578,
+                 578,  578,  578,  578,  578,  578,  578,  578 },
+  /*  564 */ {     0,   57,32884,   58,   57,  547,   70,32885,33347,33347,
+                 119,32885,   67,33347,33347,    0,    0,33347,33347,33347,
+               33347,33347,33347,33347,33347,33347,33347,33347 },
+  /*  565 */ {     0,    0,    0,    0,    0,  580,    0,    0,  581,  581,
+                   0,    0,    0,  581,  581,    0,    0,  581,  581,  581,
+                 581,  581,  581,  581,  581,  581,  581,  581 },
+  /*  566 */ {     0,    0,    0,    0,    0,  580,   18,    0,  581,  581,
+                   0,    0,    0,  581,  581,    0,    0,  581,  581,  581,
+                 581,  581,  581,  581,  581,  581,  581,  581 },
+  /*  567 */ {     0,    0,    0,    0,    0,  550,   18,    0,33350,33350,
+                   0,    0,    0,33350,33350,    0,    0,33350,33350,33350,
+               33350,33350,33350,33350,33350,33350,33350,33350 },
+  /*  568 */ {     0,    0,    0,    0,    0,  583,    0,    0,  584,  584,
+                   0,    0,    0,  584,  584,    0,    0,  584,  584,  584,
+                 584,  584,  584,  584,  584,  584,  584,  584 },
+  /*  569 */ {     0,    0,    0,    0,    0,  583,   76,    0,  584,  584,
+                   0,    0,    0,  584,  584,    0,    0,  584,  584,  584,
+                 584,  584,  584,  584,  584,  584,  584,  584 },
+  /*  570 */ {     0,    0,    0,    0,    0,  553,   76,32803,33353,33353,
+                 126,    0,    0,33353,33353,    0,    0,33353,33353,33353,
+               33353,33353,33353,33353,33353,33353,33353,33353 },
+  /*  571 */ {     0,   43,    0,   44,   43,  586,   43,    0,  587,  587,
+                  43,    0,   52,  587,  587,    0,    0,  587,  587,  587,
+                 587,  587,  587,  587,  587,  587,  587,  587 },
+  /*  572 */ {     0,   43,    0,   44,   43,  586,   55,    0,  587,  587,
+                  43,    0,   52,  587,  587,    0,    0,  587,  587,  587,
+                 587,  587,  587,  587,  587,  587,  587,  587 },
+  /*  573 */ {     0,   43,    0,   44,   43,  556,   55,32803,33356,33356,
+                  94,    0,   52,33356,33356,    0,    0,33356,33356,33356,
+               33356,33356,33356,33356,33356,33356,33356,33356 },
+  /*  574 */ {     0,    0,    0,    0,    0,  589,    0,    0,  590,  590,
+                   0,    0,    0,  590,  590,    0,    0,  590,  590,  590,
+                 590,  590,  590,  590,  590,  590,  590,  590 },
+  /*  575 */ {     0,    0,    0,    0,    0,  589,   96,    0,  590,  590,
+                   0,    0,    0,  590,  590,    0,    0,  590,  590,  590,
+                 590,  590,  590,  590,  590,  590,  590,  590 },
+  /*  576 */ {     0,    0,32884,    0,    0,  559,   96,32885,33359,33359,
+                 154,32885,    0,33359,33359,    0,    0,33359,33359,33359,
+               33359,33359,33359,33359,33359,33359,33359,33359 },
+  /*  577 */ {     0,   57,    0,   58,   57,  592,   57,    0,  593,  593,
+                  57,    0,   67,  593,  593,    0,    0,  593,  593,  593,
+                 593,  593,  593,  593,  593,  593,  593,  593 },
+  /*  578 */ {     0,   57,    0,   58,   57,  592,   70,    0,  593,  593,
+                  57,    0,   67,  593,  593,    0,    0,  593,  593,  593,
+                 593,  593,  593,  593,  593,  593,  593,  593 },
+  /*  579 */ {     0,   57,32884,   58,   57,  562,   70,32885,33362,33362,
+                 119,32885,   67,33362,33362,    0,    0,33362,33362,33362,
+               33362,33362,33362,33362,33362,33362,33362,33362 },
+  /*  580 */ {     0,    0,    0,    0,    0,  595,    0,    0,  596,  596,
+                   0,    0,    0,  596,  596,    0,    0,  596,  596,  596,
+                 596,  596,  596,  596,  596,  596,  596,  596 },
+  /*  581 */ {     0,    0,    0,    0,    0,  595,   18,    0,  596,  596,
+                   0,    0,    0,  596,  596,    0,    0,  596,  596,  596,
+                 596,  596,  596,  596,  596,  596,  596,  596 },
+  /*  582 */ {     0,    0,    0,    0,    0,  565,   18,    0,33365,33365,
+                   0,    0,    0,33365,33365,    0,    0,33365,33365,33365,
+               33365,33365,33365,33365,33365,33365,33365,33365 },
+  /*  583 */ {     0,    0,    0,    0,    0,  598,    0,    0,  599,  599,
+                   0,    0,    0,  599,  599,    0,    0,  599,  599,  599,
+                 599,  599,  599,  599,  599,  599,  599,  599 },
+  /*  584 */ {     0,    0,    0,    0,    0,  598,   76,    0,  599,  599,
+                   0,    0,    0,  599,  599,    0,    0,  599,  599,  599,
+                 599,  599,  599,  599,  599,  599,  599,  599 },
+  /*  585 */ {     0,    0,    0,    0,    0,  568,   76,32803,33368,33368,
+                 126,    0,    0,33368,33368,    0,    0,33368,33368,33368,
+               33368,33368,33368,33368,33368,33368,33368,33368 },
+  /*  586 */ {     0,   43,    0,   44,   43,  601,   43,    0,  602,  602,
+                  43,    0,   52,  602,  602,    0,    0,  602,  602,  602,
+                 602,  602,  602,  602,  602,  602,  602,  602 },
+  /*  587 */ {     0,   43,    0,   44,   43,  601,   55,    0,  602,  602,
+                  43,    0,   52,  602,  602,    0,    0,  602,  602,  602,
+                 602,  602,  602,  602,  602,  602,  602,  602 },
+  /*  588 */ {     0,   43,    0,   44,   43,  571,   55,32803,33371,33371,
+                  94,    0,   52,33371,33371,    0,    0,33371,33371,33371,
+               33371,33371,33371,33371,33371,33371,33371,33371 },
+  /*  589 */ {     0,    0,    0,    0,    0,  604,    0,    0,  605,  605,
+                   0,    0,    0,  605,  605,    0,    0,  605,  605,  605,
+                 605,  605,  605,  605,  605,  605,  605,  605 },
+  /*  590 */ {     0,    0,    0,    0,    0,  604,   96,    0,  605,  605,
+                   0,    0,    0,  605,  605,    0,    0,  605,  605,  605,
+                 605,  605,  605,  605,  605,  605,  605,  605 },
+  /*  591 */ {     0,    0,32884,    0,    0,  574,   96,32885,33374,33374,
+                 154,32885,    0,33374,33374,    0,    0,33374,33374,33374,
+               33374,33374,33374,33374,33374,33374,33374,33374 },
+  /*  592 */ {     0,   57,    0,   58,   57,  607,   57,    0,  608,  608,
+                  57,    0,   67,  608,  608,    0,    0,  608,  608,  608,
+                 608,  608,  608,  608,  608,  608,  608,  608 },
+  /*  593 */ {     0,   57,    0,   58,   57,  607,   70,    0,  608,  608,
+                  57,    0,   67,  608,  608,    0,    0,  608,  608,  608,
+                 608,  608,  608,  608,  608,  608,  608,  608 },
+  /*  594 */ {     0,   57,32884,   58,   57,  577,   70,32885,33377,33377,
+                 119,32885,   67,33377,33377,    0,    0,33377,33377,33377,
+               33377,33377,33377,33377,33377,33377,33377,33377 },
+  /*  595 */ {     0,    0,    0,    0,    0,  610,    0,    0,  611,  611,
+                   0,    0,    0,  611,  611,    0,    0,  611,  611,  611,
+                 611,  611,  611,  611,  611,  611,  611,  611 },
+  /*  596 */ {     0,    0,    0,    0,    0,  610,   18,    0,  611,  611,
+                   0,    0,    0,  611,  611,    0,    0,  611,  611,  611,
+                 611,  611,  611,  611,  611,  611,  611,  611 },
+  /*  597 */ {     0,    0,    0,    0,    0,  580,   18,    0,33380,33380,
+                   0,    0,    0,33380,33380,    0,    0,33380,33380,33380,
+               33380,33380,33380,33380,33380,33380,33380,33380 },
+  /*  598 */ {     0,    0,    0,    0,    0,  613,    0,    0,  614,  614,
+                   0,    0,    0,  614,  614,    0,    0,  614,  614,  614,
+                 614,  614,  614,  614,  614,  614,  614,  614 },
+  /*  599 */ {     0,    0,    0,    0,    0,  613,   76,    0,  614,  614,
+                   0,    0,    0,  614,  614,    0,    0,  614,  614,  614,
+                 614,  614,  614,  614,  614,  614,  614,  614 },
+  /*  600 */ {     0,    0,    0,    0,    0,  583,   76,32803,33383,33383,
+                 126,    0,    0,33383,33383,    0,    0,33383,33383,33383,
+               33383,33383,33383,33383,33383,33383,33383,33383 },
+  /*  601 */ {     0,   43,    0,   44,   43,  616,   43,    0,  617,  617,
+                  43,    0,   52,  617,  617,    0,    0,  617,  617,  617,
+                 617,  617,  617,  617,  617,  617,  617,  617 },
+  /*  602 */ {     0,   43,    0,   44,   43,  616,   55,    0,  617,  617,
+                  43,    0,   52,  617,  617,    0,    0,  617,  617,  617,
+                 617,  617,  617,  617,  617,  617,  617,  617 },
+  /*  603 */ {     0,   43,    0,   44,   43,  586,   55,32803,33386,33386,
+                  94,    0,   52,33386,33386,    0,    0,33386,33386,33386,
+               33386,33386,33386,33386,33386,33386,33386,33386 },
+  /*  604 */ {     0,    0,    0,    0,    0,  619,    0,    0,  620,  620,
+                   0,    0,    0,  620,  620,    0,    0,  620,  620,  620,
+                 620,  620,  620,  620,  620,  620,  620,  620 },
+  /*  605 */ {     0,    0,    0,    0,    0,  619,   96,    0,  620,  620,
+                   0,    0,    0,  620,  620,    0,    0,  620,  620,  620,
+                 620,  620,  620,  620,  620,  620,  620,  620 },
+  /*  606 */ {     0,    0,32884,    0,    0,  589,   96,32885,33389,33389,
+                 154,32885,    0,33389,33389,    0,    0,33389,33389,33389,
+               33389,33389,33389,33389,33389,33389,33389,33389 },
+  /*  607 */ {     0,   57,    0,   58,   57,  622,   57,    0,  623,  623,
+                  57,    0,   67,  623,  623,    0,    0,  623,  623,  623,
+                 623,  623,  623,  623,  623,  623,  623,  623 },
+  /*  608 */ {     0,   57,    0,   58,   57,  622,   70,    0,  623,  623,
+                  57,    0,   67,  623,  623,    0,    0,  623,  623,  623,
+                 623,  623,  623,  623,  623,  623,  623,  623 },
+  /*  609 */ {     0,   57,32884,   58,   57,  592,   70,32885,33392,33392,
+                 119,32885,   67,33392,33392,    0,    0,33392,33392,33392,
+               33392,33392,33392,33392,33392,33392,33392,33392 },
+  /*  610 */ {     0,    0,    0,    0,    0,  625,    0,    0,  626,  626,
+                   0,    0,    0,  626,  626,    0,    0,  626,  626,  626,
+                 626,  626,  626,  626,  626,  626,  626,  626 },
+  /*  611 */ {     0,    0,    0,    0,    0,  625,   18,    0,  626,  626,
+                   0,    0,    0,  626,  626,    0,    0,  626,  626,  626,
+                 626,  626,  626,  626,  626,  626,  626,  626 },
+  /*  612 */ {     0,    0,    0,    0,    0,  595,   18,    0,33395,33395,
+                   0,    0,    0,33395,33395,    0,    0,33395,33395,33395,
+               33395,33395,33395,33395,33395,33395,33395,33395 },
+  /*  613 */ {     0,    0,    0,    0,    0,  628,    0,    0,  629,  629,
+                   0,    0,    0,  629,  629,    0,    0,  629,  629,  629,
+                 629,  629,  629,  629,  629,  629,  629,  629 },
+  /*  614 */ {     0,    0,    0,    0,    0,  628,   76,    0,  629,  629,
+                   0,    0,    0,  629,  629,    0,    0,  629,  629,  629,
+                 629,  629,  629,  629,  629,  629,  629,  629 },
+  /*  615 */ {     0,    0,    0,    0,    0,  598,   76,32803,33398,33398,
+                 126,    0,    0,33398,33398,    0,    0,33398,33398,33398,
+               33398,33398,33398,33398,33398,33398,33398,33398 },
+  /*  616 */ {     0,   43,    0,   44,   43,  631,   43,    0,  632,  632,
+                  43,    0,   52,  632,  632,    0,    0,  632,  632,  632,
+                 632,  632,  632,  632,  632,  632,  632,  632 },
+  /*  617 */ {     0,   43,    0,   44,   43,  631,   55,    0,  632,  632,
+                  43,    0,   52,  632,  632,    0,    0,  632,  632,  632,
+                 632,  632,  632,  632,  632,  632,  632,  632 },
+  /*  618 */ {     0,   43,    0,   44,   43,  601,   55,32803,33401,33401,
+                  94,    0,   52,33401,33401,    0,    0,33401,33401,33401,
+               33401,33401,33401,33401,33401,33401,33401,33401 },
+  /*  619 */ {     0,    0,    0,    0,    0,  634,    0,    0,  635,  635,
+                   0,    0,    0,  635,  635,    0,    0,  635,  635,  635,
+                 635,  635,  635,  635,  635,  635,  635,  635 },
+  /*  620 */ {     0,    0,    0,    0,    0,  634,   96,    0,  635,  635,
+                   0,    0,    0,  635,  635,    0,    0,  635,  635,  635,
+                 635,  635,  635,  635,  635,  635,  635,  635 },
+  /*  621 */ {     0,    0,32884,    0,    0,  604,   96,32885,33404,33404,
+                 154,32885,    0,33404,33404,    0,    0,33404,33404,33404,
+               33404,33404,33404,33404,33404,33404,33404,33404 },
+  /*  622 */ {     0,   57,    0,   58,   57,  637,   57,    0,  638,  638,
+                  57,    0,   67,  638,  638,    0,    0,  638,  638,  638,
+                 638,  638,  638,  638,  638,  638,  638,  638 },
+  /*  623 */ {     0,   57,    0,   58,   57,  637,   70,    0,  638,  638,
+                  57,    0,   67,  638,  638,    0,    0,  638,  638,  638,
+                 638,  638,  638,  638,  638,  638,  638,  638 },
+  /*  624 */ {     0,   57,32884,   58,   57,  607,   70,32885,33407,33407,
+                 119,32885,   67,33407,33407,    0,    0,33407,33407,33407,
+               33407,33407,33407,33407,33407,33407,33407,33407 },
+  /*  625 */ {     0,    0,    0,    0,    0,  640,    0,    0,  641,  641,
+                   0,    0,    0,  641,  641,    0,    0,  641,  641,  641,
+                 641,  641,  641,  641,  641,  641,  641,  641 },
+  /*  626 */ {     0,    0,    0,    0,    0,  640,   18,    0,  641,  641,
+                   0,    0,    0,  641,  641,    0,    0,  641,  641,  641,
+                 641,  641,  641,  641,  641,  641,  641,  641 },
+  /*  627 */ {     0,    0,    0,    0,    0,  610,   18,    0,33410,33410,
+                   0,    0,    0,33410,33410,    0,    0,33410,33410,33410,
+               33410,33410,33410,33410,33410,33410,33410,33410 },
+  /*  628 */ {     0,    0,    0,    0,    0,  643,    0,    0,  644,  644,
+                   0,    0,    0,  644,  644,    0,    0,  644,  644,  644,
+                 644,  644,  644,  644,  644,  644,  644,  644 },
+  /*  629 */ {     0,    0,    0,    0,    0,  643,   76,    0,  644,  644,
+                   0,    0,    0,  644,  644,    0,    0,  644,  644,  644,
+                 644,  644,  644,  644,  644,  644,  644,  644 },
+  /*  630 */ {     0,    0,    0,    0,    0,  613,   76,32803,33413,33413,
+                 126,    0,    0,33413,33413,    0,    0,33413,33413,33413,
+               33413,33413,33413,33413,33413,33413,33413,33413 },
+  /*  631 */ {     0,   43,    0,   44,   43,  646,   43,    0,  647,  647,
+                  43,    0,   52,  647,  647,    0,    0,  647,  647,  647,
+                 647,  647,  647,  647,  647,  647,  647,  647 },
+  /*  632 */ {     0,   43,    0,   44,   43,  646,   55,    0,  647,  647,
+                  43,    0,   52,  647,  647,    0,    0,  647,  647,  647,
+                 647,  647,  647,  647,  647,  647,  647,  647 },
+  /*  633 */ {     0,   43,    0,   44,   43,  616,   55,32803,33416,33416,
+                  94,    0,   52,33416,33416,    0,    0,33416,33416,33416,
+               33416,33416,33416,33416,33416,33416,33416,33416 },
+  /*  634 */ {     0,    0,    0,    0,    0,  649,    0,    0,  650,  650,
+                   0,    0,    0,  650,  650,    0,    0,  650,  650,  650,
+                 650,  650,  650,  650,  650,  650,  650,  650 },
+  /*  635 */ {     0,    0,    0,    0,    0,  649,   96,    0,  650,  650,
+                   0,    0,    0,  650,  650,    0,    0,  650,  650,  650,
+                 650,  650,  650,  650,  650,  650,  650,  650 },
+  /*  636 */ {     0,    0,32884,    0,    0,  619,   96,32885,33419,33419,
+                 154,32885,    0,33419,33419,    0,    0,33419,33419,33419,
+               33419,33419,33419,33419,33419,33419,33419,33419 },
+  /*  637 */ {     0,   57,    0,   58,   57,  652,   57,    0,  653,  653,
+                  57,    0,   67,  653,  653,    0,    0,  653,  653,  653,
+                 653,  653,  653,  653,  653,  653,  653,  653 },
+  /*  638 */ {     0,   57,    0,   58,   57,  652,   70,    0,  653,  653,
+                  57,    0,   67,  653,  653,    0,    0,  653,  653,  653,
+                 653,  653,  653,  653,  653,  653,  653,  653 },
+  /*  639 */ {     0,   57,32884,   58,   57,  622,   70,32885,33422,33422,
+                 119,32885,   67,33422,33422,    0,    0,33422,33422,33422,
+               33422,33422,33422,33422,33422,33422,33422,33422 },
+  /*  640 */ {     0,    0,    0,    0,    0,  655,    0,    0,  656,  656,
+                   0,    0,    0,  656,  656,    0,    0,  656,  656,  656,
+                 656,  656,  656,  656,  656,  656,  656,  656 },
+  /*  641 */ {     0,    0,    0,    0,    0,  655,   18,    0,  656,  656,
+                   0,    0,    0,  656,  656,    0,    0,  656,  656,  656,
+                 656,  656,  656,  656,  656,  656,  656,  656 },
+  /*  642 */ {     0,    0,    0,    0,    0,  625,   18,    0,33425,33425,
+                   0,    0,    0,33425,33425,    0,    0,33425,33425,33425,
+               33425,33425,33425,33425,33425,33425,33425,33425 },
+  /*  643 */ {     0,    0,    0,    0,    0,  658,    0,    0,  659,  659,
+                   0,    0,    0,  659,  659,    0,    0,  659,  659,  659,
+                 659,  659,  659,  659,  659,  659,  659,  659 },
+  /*  644 */ {     0,    0,    0,    0,    0,  658,   76,    0,  659,  659,
+                   0,    0,    0,  659,  659,    0,    0,  659,  659,  659,
+                 659,  659,  659,  659,  659,  659,  659,  659 },
+  /*  645 */ {     0,    0,    0,    0,    0,  628,   76,32803,33428,33428,
+                 126,    0,    0,33428,33428,    0,    0,33428,33428,33428,
+               33428,33428,33428,33428,33428,33428,33428,33428 },
+  /*  646 */ {     0,   43,    0,   44,   43,  661,   43,    0,  662,  662,
+                  43,    0,   52,  662,  662,    0,    0,  662,  662,  662,
+                 662,  662,  662,  662,  662,  662,  662,  662 },
+  /*  647 */ {     0,   43,    0,   44,   43,  661,   55,    0,  662,  662,
+                  43,    0,   52,  662,  662,    0,    0,  662,  662,  662,
+                 662,  662,  662,  662,  662,  662,  662,  662 },
+  /*  648 */ {     0,   43,    0,   44,   43,  631,   55,32803,33431,33431,
+                  94,    0,   52,33431,33431,    0,    0,33431,33431,33431,
+               33431,33431,33431,33431,33431,33431,33431,33431 },
+  /*  649 */ {     0,    0,    0,    0,    0,  664,    0,    0,  665,  665,
+                   0,    0,    0,  665,  665,    0,    0,  665,  665,  665,
+                 665,  665,  665,  665,  665,  665,  665,  665 },
+  /*  650 */ {     0,    0,    0,    0,    0,  664,   96,    0,  665,  665,
+                   0,    0,    0,  665,  665,    0,    0,  665,  665,  665,
+                 665,  665,  665,  665,  665,  665,  665,  665 },
+  /*  651 */ {     0,    0,32884,    0,    0,  634,   96,32885,33434,33434,
+                 154,32885,    0,33434,33434,    0,    0,33434,33434,33434,
+               33434,33434,33434,33434,33434,33434,33434,33434 },
+  /*  652 */ {     0,   57,    0,   58,   57,  667,   57,    0,  668,  668,
+                  57,    0,   67,  668,  668,    0,    0,  668,  668,  668,
+                 668,  668,  668,  668,  668,  668,  668,  668 },
+  /*  653 */ {     0,   57,    0,   58,   57,  667,   70,    0,  668,  668,
+                  57,    0,   67,  668,  668,    0,    0,  668,  668,  668,
+                 668,  668,  668,  668,  668,  668,  668,  668 },
+  /*  654 */ {     0,   57,32884,   58,   57,  637,   70,32885,33437,33437,
+                 119,32885,   67,33437,33437,    0,    0,33437,33437,33437,
+               33437,33437,33437,33437,33437,33437,33437,33437 },
+  /*  655 */ {     0,    0,    0,    0,    0,  670,    0,    0,  671,  671,
+                   0,    0,    0,  671,  671,    0,    0,  671,  671,  671,
+                 671,  671,  671,  671,  671,  671,  671,  671 },
+  /*  656 */ {     0,    0,    0,    0,    0,  670,   18,    0,  671,  671,
+                   0,    0,    0,  671,  671,    0,    0,  671,  671,  671,
+                 671,  671,  671,  671,  671,  671,  671,  671 },
+  /*  657 */ {     0,    0,    0,    0,    0,  640,   18,    0,33440,33440,
+                   0,    0,    0,33440,33440,    0,    0,33440,33440,33440,
+               33440,33440,33440,33440,33440,33440,33440,33440 },
+  /*  658 */ {     0,    0,    0,    0,    0,  673,    0,    0,  674,  674,
+                   0,    0,    0,  674,  674,    0,    0,  674,  674,  674,
+                 674,  674,  674,  674,  674,  674,  674,  674 },
+  /*  659 */ {     0,    0,    0,    0,    0,  673,   76,    0,  674,  674,
+                   0,    0,    0,  674,  674,    0,    0,  674,  674,  674,
+                 674,  674,  674,  674,  674,  674,  674,  674 },
+  /*  660 */ {     0,    0,    0,    0,    0,  643,   76,32803,33443,33443,
+                 126,    0,    0,33443,33443,    0,    0,33443,33443,33443,
+               33443,33443,33443,33443,33443,33443,33443,33443 },
+  /*  661 */ {     0,   43,    0,   44,   43,  676,   43,    0,  677,  677,
+                  43,    0,   52,  677,  677,    0,    0,  677,  677,  677,
+                 677,  677,  677,  677,  677,  677,  677,  677 },
+  /*  662 */ {     0,   43,    0,   44,   43,  676,   55,    0,  677,  677,
+                  43,    0,   52,  677,  677,    0,    0,  677,  677,  677,
+                 677,  677,  677,  677,  677,  677,  677,  677 },
+  /*  663 */ {     0,   43,    0,   44,   43,  646,   55,32803,33446,33446,
+                  94,    0,   52,33446,33446,    0,    0,33446,33446,33446,
+               33446,33446,33446,33446,33446,33446,33446,33446 },
+  /*  664 */ {     0,    0,    0,    0,    0,  679,    0,    0,  680,  680,
+                   0,    0,    0,  680,  680,    0,    0,  680,  680,  680,
+                 680,  680,  680,  680,  680,  680,  680,  680 },
+  /*  665 */ {     0,    0,    0,    0,    0,  679,   96,    0,  680,  680,
+                   0,    0,    0,  680,  680,    0,    0,  680,  680,  680,
+                 680,  680,  680,  680,  680,  680,  680,  680 },
+  /*  666 */ {     0,    0,32884,    0,    0,  649,   96,32885,33449,33449,
+                 154,32885,    0,33449,33449,    0,    0,33449,33449,33449,
+               33449,33449,33449,33449,33449,33449,33449,33449 },
+  /*  667 */ {     0,   57,    0,   58,   57,  682,   57,    0,  683,  683,
+                  57,    0,   67,  683,  683,    0,    0,  683,  683,  683,
+                 683,  683,  683,  683,  683,  683,  683,  683 },
+  /*  668 */ {     0,   57,    0,   58,   57,  682,   70,    0,  683,  683,
+                  57,    0,   67,  683,  683,    0,    0,  683,  683,  683,
+                 683,  683,  683,  683,  683,  683,  683,  683 },
+  /*  669 */ {     0,   57,32884,   58,   57,  652,   70,32885,33452,33452,
+                 119,32885,   67,33452,33452,    0,    0,33452,33452,33452,
+               33452,33452,33452,33452,33452,33452,33452,33452 },
+  /*  670 */ {     0,    0,    0,    0,    0,  685,    0,    0,  686,  686,
+                   0,    0,    0,  686,  686,    0,    0,  686,  686,  686,
+                 686,  686,  686,  686,  686,  686,  686,  686 },
+  /*  671 */ {     0,    0,    0,    0,    0,  685,   18,    0,  686,  686,
+                   0,    0,    0,  686,  686,    0,    0,  686,  686,  686,
+                 686,  686,  686,  686,  686,  686,  686,  686 },
+  /*  672 */ {     0,    0,    0,    0,    0,  655,   18,    0,33455,33455,
+                   0,    0,    0,33455,33455,    0,    0,33455,33455,33455,
+               33455,33455,33455,33455,33455,33455,33455,33455 },
+  /*  673 */ {     0,    0,    0,    0,    0,  688,    0,    0,  689,  689,
+                   0,    0,    0,  689,  689,    0,    0,  689,  689,  689,
+                 689,  689,  689,  689,  689,  689,  689,  689 },
+  /*  674 */ {     0,    0,    0,    0,    0,  688,   76,    0,  689,  689,
+                   0,    0,    0,  689,  689,    0,    0,  689,  689,  689,
+                 689,  689,  689,  689,  689,  689,  689,  689 },
+  /*  675 */ {     0,    0,    0,    0,    0,  658,   76,32803,33458,33458,
+                 126,    0,    0,33458,33458,    0,    0,33458,33458,33458,
+               33458,33458,33458,33458,33458,33458,33458,33458 },
+  /*  676 */ {     0,   43,    0,   44,   43,  691,   43,    0,  692,  692,
+                  43,    0,   52,  692,  692,    0,    0,  692,  692,  692,
+                 692,  692,  692,  692,  692,  692,  692,  692 },
+  /*  677 */ {     0,   43,    0,   44,   43,  691,   55,    0,  692,  692,
+                  43,    0,   52,  692,  692,    0,    0,  692,  692,  692,
+                 692,  692,  692,  692,  692,  692,  692,  692 },
+  /*  678 */ {     0,   43,    0,   44,   43,  661,   55,32803,33461,33461,
+                  94,    0,   52,33461,33461,    0,    0,33461,33461,33461,
+               33461,33461,33461,33461,33461,33461,33461,33461 },
+  /*  679 */ {     0,    0,    0,    0,    0,  694,    0,    0,  695,  695,
+                   0,    0,    0,  695,  695,    0,    0,  695,  695,  695,
+                 695,  695,  695,  695,  695,  695,  695,  695 },
+  /*  680 */ {     0,    0,    0,    0,    0,  694,   96,    0,  695,  695,
+                   0,    0,    0,  695,  695,    0,    0,  695,  695,  695,
+                 695,  695,  695,  695,  695,  695,  695,  695 },
+  /*  681 */ {     0,    0,32884,    0,    0,  664,   96,32885,33464,33464,
+                 154,32885,    0,33464,33464,    0,    0,33464,33464,33464,
+               33464,33464,33464,33464,33464,33464,33464,33464 },
+  /*  682 */ {     0,   57,    0,   58,   57,  697,   57,    0,  698,  698,
+                  57,    0,   67,  698,  698,    0,    0,  698,  698,  698,
+                 698,  698,  698,  698,  698,  698,  698,  698 },
+  /*  683 */ {     0,   57,    0,   58,   57,  697,   70,    0,  698,  698,
+                  57,    0,   67,  698,  698,    0,    0,  698,  698,  698,
+                 698,  698,  698,  698,  698,  698,  698,  698 },
+  /*  684 */ {     0,   57,32884,   58,   57,  667,   70,32885,33467,33467,
+                 119,32885,   67,33467,33467,    0,    0,33467,33467,33467,
+               33467,33467,33467,33467,33467,33467,33467,33467 },
+  /*  685 */ {     0,    0,    0,    0,    0,  700,    0,    0,  701,  701,
+                   0,    0,    0,  701,  701,    0,    0,  701,  701,  701,
+                 701,  701,  701,  701,  701,  701,  701,  701 },
+  /*  686 */ {     0,    0,    0,    0,    0,  700,   18,    0,  701,  701,
+                   0,    0,    0,  701,  701,    0,    0,  701,  701,  701,
+                 701,  701,  701,  701,  701,  701,  701,  701 },
+  /*  687 */ {     0,    0,    0,    0,    0,  670,   18,    0,33470,33470,
+                   0,    0,    0,33470,33470,    0,    0,33470,33470,33470,
+               33470,33470,33470,33470,33470,33470,33470,33470 },
+  /*  688 */ {     0,    0,    0,    0,    0,  703,    0,    0,  704,  704,
+                   0,    0,    0,  704,  704,    0,    0,  704,  704,  704,
+                 704,  704,  704,  704,  704,  704,  704,  704 },
+  /*  689 */ {     0,    0,    0,    0,    0,  703,   76,    0,  704,  704,
+                   0,    0,    0,  704,  704,    0,    0,  704,  704,  704,
+                 704,  704,  704,  704,  704,  704,  704,  704 },
+  /*  690 */ {     0,    0,    0,    0,    0,  673,   76,32803,33473,33473,
+                 126,    0,    0,33473,33473,    0,    0,33473,33473,33473,
+               33473,33473,33473,33473,33473,33473,33473,33473 },
+  /*  691 */ {     0,   43,    0,   44,   43,  706,   43,    0,  707,  707,
+                  43,    0,   52,  707,  707,    0,    0,  707,  707,  707,
+                 707,  707,  707,  707,  707,  707,  707,  707 },
+  /*  692 */ {     0,   43,    0,   44,   43,  706,   55,    0,  707,  707,
+                  43,    0,   52,  707,  707,    0,    0,  707,  707,  707,
+                 707,  707,  707,  707,  707,  707,  707,  707 },
+  /*  693 */ {     0,   43,    0,   44,   43,  676,   55,32803,33476,33476,
+                  94,    0,   52,33476,33476,    0,    0,33476,33476,33476,
+               33476,33476,33476,33476,33476,33476,33476,33476 },
+  /*  694 */ {     0,    0,    0,    0,    0,  709,    0,    0,  710,  710,
+                   0,    0,    0,  710,  710,    0,    0,  710,  710,  710,
+                 710,  710,  710,  710,  710,  710,  710,  710 },
+  /*  695 */ {     0,    0,    0,    0,    0,  709,   96,    0,  710,  710,
+                   0,    0,    0,  710,  710,    0,    0,  710,  710,  710,
+                 710,  710,  710,  710,  710,  710,  710,  710 },
+  /*  696 */ {     0,    0,32884,    0,    0,  679,   96,32885,33479,33479,
+                 154,32885,    0,33479,33479,    0,    0,33479,33479,33479,
+               33479,33479,33479,33479,33479,33479,33479,33479 },
+  /*  697 */ {     0,   57,    0,   58,   57,  712,   57,    0,  713,  713,
+                  57,    0,   67,  713,  713,    0,    0,  713,  713,  713,
+                 713,  713,  713,  713,  713,  713,  713,  713 },
+  /*  698 */ {     0,   57,    0,   58,   57,  712,   70,    0,  713,  713,
+                  57,    0,   67,  713,  713,    0,    0,  713,  713,  713,
+                 713,  713,  713,  713,  713,  713,  713,  713 },
+  /*  699 */ {     0,   57,32884,   58,   57,  682,   70,32885,33482,33482,
+                 119,32885,   67,33482,33482,    0,    0,33482,33482,33482,
+               33482,33482,33482,33482,33482,33482,33482,33482 },
+  /*  700 */ {     0,    0,    0,    0,    0,  715,    0,    0,  716,  716,
+                   0,    0,    0,  716,  716,    0,    0,  716,  716,  716,
+                 716,  716,  716,  716,  716,  716,  716,  716 },
+  /*  701 */ {     0,    0,    0,    0,    0,  715,   18,    0,  716,  716,
+                   0,    0,    0,  716,  716,    0,    0,  716,  716,  716,
+                 716,  716,  716,  716,  716,  716,  716,  716 },
+  /*  702 */ {     0,    0,    0,    0,    0,  685,   18,    0,33485,33485,
+                   0,    0,    0,33485,33485,    0,    0,33485,33485,33485,
+               33485,33485,33485,33485,33485,33485,33485,33485 },
+  /*  703 */ {     0,    0,    0,    0,    0,  718,    0,    0,  719,  719,
+                   0,    0,    0,  719,  719,    0,    0,  719,  719,  719,
+                 719,  719,  719,  719,  719,  719,  719,  719 },
+  /*  704 */ {     0,    0,    0,    0,    0,  718,   76,    0,  719,  719,
+                   0,    0,    0,  719,  719,    0,    0,  719,  719,  719,
+                 719,  719,  719,  719,  719,  719,  719,  719 },
+  /*  705 */ {     0,    0,    0,    0,    0,  688,   76,32803,33488,33488,
+                 126,    0,    0,33488,33488,    0,    0,33488,33488,33488,
+               33488,33488,33488,33488,33488,33488,33488,33488 },
+  /*  706 */ {     0,   43,    0,   44,   43,  721,   43,    0,  722,  722,
+                  43,    0,   52,  722,  722,    0,    0,  722,  722,  722,
+                 722,  722,  722,  722,  722,  722,  722,  722 },
+  /*  707 */ {     0,   43,    0,   44,   43,  721,   55,    0,  722,  722,
+                  43,    0,   52,  722,  722,    0,    0,  722,  722,  722,
+                 722,  722,  722,  722,  722,  722,  722,  722 },
+  /*  708 */ {     0,   43,    0,   44,   43,  691,   55,32803,33491,33491,
+                  94,    0,   52,33491,33491,    0,    0,33491,33491,33491,
+               33491,33491,33491,33491,33491,33491,33491,33491 },
+  /*  709 */ {     0,    0,    0,    0,    0,  724,    0,    0,  725,  725,
+                   0,    0,    0,  725,  725,    0,    0,  725,  725,  725,
+                 725,  725,  725,  725,  725,  725,  725,  725 },
+  /*  710 */ {     0,    0,    0,    0,    0,  724,   96,    0,  725,  725,
+                   0,    0,    0,  725,  725,    0,    0,  725,  725,  725,
+                 725,  725,  725,  725,  725,  725,  725,  725 },
+  /*  711 */ {     0,    0,32884,    0,    0,  694,   96,32885,33494,33494,
+                 154,32885,    0,33494,33494,    0,    0,33494,33494,33494,
+               33494,33494,33494,33494,33494,33494,33494,33494 },
+  /*  712 */ {     0,   57,    0,   58,   57,  727,   57,    0,  728,  728,
+                  57,    0,   67,  728,  728,    0,    0,  728,  728,  728,
+                 728,  728,  728,  728,  728,  728,  728,  728 },
+  /*  713 */ {     0,   57,    0,   58,   57,  727,   70,    0,  728,  728,
+                  57,    0,   67,  728,  728,    0,    0,  728,  728,  728,
+                 728,  728,  728,  728,  728,  728,  728,  728 },
+  /*  714 */ {     0,   57,32884,   58,   57,  697,   70,32885,33497,33497,
+                 119,32885,   67,33497,33497,    0,    0,33497,33497,33497,
+               33497,33497,33497,33497,33497,33497,33497,33497 },
+  /*  715 */ {     0,    0,    0,    0,    0,  730,    0,    0,  731,  731,
+                   0,    0,    0,  731,  731,    0,    0,  731,  731,  731,
+                 731,  731,  731,  731,  731,  731,  731,  731 },
+  /*  716 */ {     0,    0,    0,    0,    0,  730,   18,    0,  731,  731,
+                   0,    0,    0,  731,  731,    0,    0,  731,  731,  731,
+                 731,  731,  731,  731,  731,  731,  731,  731 },
+  /*  717 */ {     0,    0,    0,    0,    0,  700,   18,    0,33500,33500,
+                   0,    0,    0,33500,33500,    0,    0,33500,33500,33500,
+               33500,33500,33500,33500,33500,33500,33500,33500 },
+  /*  718 */ {     0,    0,    0,    0,    0,  733,    0,    0,  734,  734,
+                   0,    0,    0,  734,  734,    0,    0,  734,  734,  734,
+                 734,  734,  734,  734,  734,  734,  734,  734 },
+  /*  719 */ {     0,    0,    0,    0,    0,  733,   76,    0,  734,  734,
+                   0,    0,    0,  734,  734,    0,    0,  734,  734,  734,
+                 734,  734,  734,  734,  734,  734,  734,  734 },
+  /*  720 */ {     0,    0,    0,    0,    0,  703,   76,32803,33503,33503,
+                 126,    0,    0,33503,33503,    0,    0,33503,33503,33503,
+               33503,33503,33503,33503,33503,33503,33503,33503 },
+  /*  721 */ {     0,   43,    0,   44,   43,  736,   43,    0,  737,  737,
+                  43,    0,   52,  737,  737,    0,    0,  737,  737,  737,
+                 737,  737,  737,  737,  737,  737,  737,  737 },
+  /*  722 */ {     0,   43,    0,   44,   43,  736,   55,    0,  737,  737,
+                  43,    0,   52,  737,  737,    0,    0,  737,  737,  737,
+                 737,  737,  737,  737,  737,  737,  737,  737 },
+  /*  723 */ {     0,   43,    0,   44,   43,  706,   55,32803,33506,33506,
+                  94,    0,   52,33506,33506,    0,    0,33506,33506,33506,
+               33506,33506,33506,33506,33506,33506,33506,33506 },
+  /*  724 */ {     0,    0,    0,    0,    0,  739,    0,    0,  740,  740,
+                   0,    0,    0,  740,  740,    0,    0,  740,  740,  740,
+                 740,  740,  740,  740,  740,  740,  740,  740 },
+  /*  725 */ {     0,    0,    0,    0,    0,  739,   96,    0,  740,  740,
+                   0,    0,    0,  740,  740,    0,    0,  740,  740,  740,
+                 740,  740,  740,  740,  740,  740,  740,  740 },
+  /*  726 */ {     0,    0,32884,    0,    0,  709,   96,32885,33509,33509,
+                 154,32885,    0,33509,33509,    0,    0,33509,33509,33509,
+               33509,33509,33509,33509,33509,33509,33509,33509 },
+  /*  727 */ {     0,   57,    0,   58,   57,  742,   57,    0,  743,  743,
+                  57,    0,   67,  743,  743,    0,    0,  743,  743,  743,
+                 743,  743,  743,  743,  743,  743,  743,  743 },
+  /*  728 */ {     0,   57,    0,   58,   57,  742,   70,    0,  743,  743,
+                  57,    0,   67,  743,  743,    0,    0,  743,  743,  743,
+                 743,  743,  743,  743,  743,  743,  743,  743 },
+  /*  729 */ {     0,   57,32884,   58,   57,  712,   70,32885,33512,33512,
+                 119,32885,   67,33512,33512,    0,    0,33512,33512,33512,
+               33512,33512,33512,33512,33512,33512,33512,33512 },
+  /*  730 */ {     0,    0,    0,    0,    0,  745,    0,    0,  746,  746,
+                   0,    0,    0,  746,  746,    0,    0,  746,  746,  746,
+                 746,  746,  746,  746,  746,  746,  746,  746 },
+  /*  731 */ {     0,    0,    0,    0,    0,  745,   18,    0,  746,  746,
+                   0,    0,    0,  746,  746,    0,    0,  746,  746,  746,
+                 746,  746,  746,  746,  746,  746,  746,  746 },
+  /*  732 */ {     0,    0,    0,    0,    0,  715,   18,    0,33515,33515,
+                   0,    0,    0,33515,33515,    0,    0,33515,33515,33515,
+               33515,33515,33515,33515,33515,33515,33515,33515 },
+  /*  733 */ {     0,    0,    0,    0,    0,  748,    0,    0,  749,  749,
+                   0,    0,    0,  749,  749,    0,    0,  749,  749,  749,
+                 749,  749,  749,  749,  749,  749,  749,  749 },
+  /*  734 */ {     0,    0,    0,    0,    0,  748,   76,    0,  749,  749,
+                   0,    0,    0,  749,  749,    0,    0,  749,  749,  749,
+                 749,  749,  749,  749,  749,  749,  749,  749 },
+  /*  735 */ {     0,    0,    0,    0,    0,  718,   76,32803,33518,33518,
+                 126,    0,    0,33518,33518,    0,    0,33518,33518,33518,
+               33518,33518,33518,33518,33518,33518,33518,33518 },
+  /*  736 */ {     0,   43,    0,   44,   43,  751,   43,    0,  752,  752,
+                  43,    0,   52,  752,  752,    0,    0,  752,  752,  752,
+                 752,  752,  752,  752,  752,  752,  752,  752 },
+  /*  737 */ {     0,   43,    0,   44,   43,  751,   55,    0,  752,  752,
+                  43,    0,   52,  752,  752,    0,    0,  752,  752,  752,
+                 752,  752,  752,  752,  752,  752,  752,  752 },
+  /*  738 */ {     0,   43,    0,   44,   43,  721,   55,32803,33521,33521,
+                  94,    0,   52,33521,33521,    0,    0,33521,33521,33521,
+               33521,33521,33521,33521,33521,33521,33521,33521 },
+  /*  739 */ {     0,    0,    0,    0,    0,  754,    0,    0,  755,  755,
+                   0,    0,    0,  755,  755,    0,    0,  755,  755,  755,
+                 755,  755,  755,  755,  755,  755,  755,  755 },
+  /*  740 */ {     0,    0,    0,    0,    0,  754,   96,    0,  755,  755,
+                   0,    0,    0,  755,  755,    0,    0,  755,  755,  755,
+                 755,  755,  755,  755,  755,  755,  755,  755 },
+  /*  741 */ {     0,    0,32884,    0,    0,  724,   96,32885,33524,33524,
+                 154,32885,    0,33524,33524,    0,    0,33524,33524,33524,
+               33524,33524,33524,33524,33524,33524,33524,33524 },
+  /*  742 */ {     0,   57,    0,   58,   57,  757,   57,    0,  758,  758,
+                  57,    0,   67,  758,  758,    0,    0,  758,  758,  758,
+                 758,  758,  758,  758,  758,  758,  758,  758 },
+  /*  743 */ {     0,   57,    0,   58,   57,  757,   70,    0,  758,  758,
+                  57,    0,   67,  758,  758,    0,    0,  758,  758,  758,
+                 758,  758,  758,  758,  758,  758,  758,  758 },
+  /*  744 */ {     0,   57,32884,   58,   57,  727,   70,32885,33527,33527,
+                 119,32885,   67,33527,33527,    0,    0,33527,33527,33527,
+               33527,33527,33527,33527,33527,33527,33527,33527 },
+  /*  745 */ {     0,    0,    0,    0,    0,  760,    0,    0,  761,  761,
+                   0,    0,    0,  761,  761,    0,    0,  761,  761,  761,
+                 761,  761,  761,  761,  761,  761,  761,  761 },
+  /*  746 */ {     0,    0,    0,    0,    0,  760,   18,    0,  761,  761,
+                   0,    0,    0,  761,  761,    0,    0,  761,  761,  761,
+                 761,  761,  761,  761,  761,  761,  761,  761 },
+  /*  747 */ {     0,    0,    0,    0,    0,  730,   18,    0,33530,33530,
+                   0,    0,    0,33530,33530,    0,    0,33530,33530,33530,
+               33530,33530,33530,33530,33530,33530,33530,33530 },
+  /*  748 */ {     0,    0,    0,    0,    0,  763,    0,    0,  764,  764,
+                   0,    0,    0,  764,  764,    0,    0,  764,  764,  764,
+                 764,  764,  764,  764,  764,  764,  764,  764 },
+  /*  749 */ {     0,    0,    0,    0,    0,  763,   76,    0,  764,  764,
+                   0,    0,    0,  764,  764,    0,    0,  764,  764,  764,
+                 764,  764,  764,  764,  764,  764,  764,  764 },
+  /*  750 */ {     0,    0,    0,    0,    0,  733,   76,32803,33533,33533,
+                 126,    0,    0,33533,33533,    0,    0,33533,33533,33533,
+               33533,33533,33533,33533,33533,33533,33533,33533 },
+  /*  751 */ {     0,   43,    0,   44,   43,  766,   43,    0,  767,  767,
+                  43,    0,   52,  767,  767,    0,    0,  767,  767,  767,
+                 767,  767,  767,  767,  767,  767,  767,  767 },
+  /*  752 */ {     0,   43,    0,   44,   43,  766,   55,    0,  767,  767,
+                  43,    0,   52,  767,  767,    0,    0,  767,  767,  767,
+                 767,  767,  767,  767,  767,  767,  767,  767 },
+  /*  753 */ {     0,   43,    0,   44,   43,  736,   55,32803,33536,33536,
+                  94,    0,   52,33536,33536,    0,    0,33536,33536,33536,
+               33536,33536,33536,33536,33536,33536,33536,33536 },
+  /*  754 */ {     0,    0,    0,    0,    0,  769,    0,    0,  770,  770,
+                   0,    0,    0,  770,  770,    0,    0,  770,  770,  770,
+                 770,  770,  770,  770,  770,  770,  770,  770 },
+  /*  755 */ {     0,    0,    0,    0,    0,  769,   96,    0,  770,  770,
+                   0,    0,    0,  770,  770,    0,    0,  770,  770,  770,
+                 770,  770,  770,  770,  770,  770,  770,  770 },
+  /*  756 */ {     0,    0,32884,    0,    0,  739,   96,32885,33539,33539,
+                 154,32885,    0,33539,33539,    0,    0,33539,33539,33539,
+               33539,33539,33539,33539,33539,33539,33539,33539 },
+  /*  757 */ {     0,   57,    0,   58,   57,  772,   57,    0,  773,  773,
+                  57,    0,   67,  773,  773,    0,    0,  773,  773,  773,
+                 773,  773,  773,  773,  773,  773,  773,  773 },
+  /*  758 */ {     0,   57,    0,   58,   57,  772,   70,    0,  773,  773,
+                  57,    0,   67,  773,  773,    0,    0,  773,  773,  773,
+                 773,  773,  773,  773,  773,  773,  773,  773 },
+  /*  759 */ {     0,   57,32884,   58,   57,  742,   70,32885,33542,33542,
+                 119,32885,   67,33542,33542,    0,    0,33542,33542,33542,
+               33542,33542,33542,33542,33542,33542,33542,33542 },
+  /*  760 */ {     0,    0,    0,    0,    0,  775,    0,    0,  776,  776,
+                   0,    0,    0,  776,  776,    0,    0,  776,  776,  776,
+                 776,  776,  776,  776,  776,  776,  776,  776 },
+  /*  761 */ {     0,    0,    0,    0,    0,  775,   18,    0,  776,  776,
+                   0,    0,    0,  776,  776,    0,    0,  776,  776,  776,
+                 776,  776,  776,  776,  776,  776,  776,  776 },
+  /*  762 */ {     0,    0,    0,    0,    0,  745,   18,    0,33545,33545,
+                   0,    0,    0,33545,33545,    0,    0,33545,33545,33545,
+               33545,33545,33545,33545,33545,33545,33545,33545 },
+  /*  763 */ {     0,    0,    0,    0,    0,  778,    0,    0,  779,  779,
+                   0,    0,    0,  779,  779,    0,    0,  779,  779,  779,
+                 779,  779,  779,  779,  779,  779,  779,  779 },
+  /*  764 */ {     0,    0,    0,    0,    0,  778,   76,    0,  779,  779,
+                   0,    0,    0,  779,  779,    0,    0,  779,  779,  779,
+                 779,  779,  779,  779,  779,  779,  779,  779 },
+  /*  765 */ {     0,    0,    0,    0,    0,  748,   76,32803,33548,33548,
+                 126,    0,    0,33548,33548,    0,    0,33548,33548,33548,
+               33548,33548,33548,33548,33548,33548,33548,33548 },
+  /*  766 */ {     0,   43,    0,   44,   43,  781,   43,    0,  782,  782,
+                  43,    0,   52,  782,  782,    0,    0,  782,  782,  782,
+                 782,  782,  782,  782,  782,  782,  782,  782 },
+  /*  767 */ {     0,   43,    0,   44,   43,  781,   55,    0,  782,  782,
+                  43,    0,   52,  782,  782,    0,    0,  782,  782,  782,
+                 782,  782,  782,  782,  782,  782,  782,  782 },
+  /*  768 */ {     0,   43,    0,   44,   43,  751,   55,32803,33551,33551,
+                  94,    0,   52,33551,33551,    0,    0,33551,33551,33551,
+               33551,33551,33551,33551,33551,33551,33551,33551 },
+  /*  769 */ {     0,    0,    0,    0,    0,  784,    0,    0,  785,  785,
+                   0,    0,    0,  785,  785,    0,    0,  785,  785,  785,
+                 785,  785,  785,  785,  785,  785,  785,  785 },
+  /*  770 */ {     0,    0,    0,    0,    0,  784,   96,    0,  785,  785,
+                   0,    0,    0,  785,  785,    0,    0,  785,  785,  785,
+                 785,  785,  785,  785,  785,  785,  785,  785 },
+  /*  771 */ {     0,    0,32884,    0,    0,  754,   96,32885,33554,33554,
+                 154,32885,    0,33554,33554,    0,    0,33554,33554,33554,
+               33554,33554,33554,33554,33554,33554,33554,33554 },
+  /*  772 */ {     0,   57,    0,   58,   57,  787,   57,    0,  788,  788,
+                  57,    0,   67,  788,  788,    0,    0,  788,  788,  788,
+                 788,  788,  788,  788,  788,  788,  788,  788 },
+  /*  773 */ {     0,   57,    0,   58,   57,  787,   70,    0,  788,  788,
+                  57,    0,   67,  788,  788,    0,    0,  788,  788,  788,
+                 788,  788,  788,  788,  788,  788,  788,  788 },
+  /*  774 */ {     0,   57,32884,   58,   57,  757,   70,32885,33557,33557,
+                 119,32885,   67,33557,33557,    0,    0,33557,33557,33557,
+               33557,33557,33557,33557,33557,33557,33557,33557 },
+  /*  775 */ {     0,    0,    0,    0,    0,  790,    0,    0,  791,  791,
+                   0,    0,    0,  791,  791,    0,    0,  791,  791,  791,
+                 791,  791,  791,  791,  791,  791,  791,  791 },
+  /*  776 */ {     0,    0,    0,    0,    0,  790,   18,    0,  791,  791,
+                   0,    0,    0,  791,  791,    0,    0,  791,  791,  791,
+                 791,  791,  791,  791,  791,  791,  791,  791 },
+  /*  777 */ {     0,    0,    0,    0,    0,  760,   18,    0,33560,33560,
+                   0,    0,    0,33560,33560,    0,    0,33560,33560,33560,
+               33560,33560,33560,33560,33560,33560,33560,33560 },
+  /*  778 */ {     0,    0,    0,    0,    0,  793,    0,    0,  794,  794,
+                   0,    0,    0,  794,  794,    0,    0,  794,  794,  794,
+                 794,  794,  794,  794,  794,  794,  794,  794 },
+  /*  779 */ {     0,    0,    0,    0,    0,  793,   76,    0,  794,  794,
+                   0,    0,    0,  794,  794,    0,    0,  794,  794,  794,
+                 794,  794,  794,  794,  794,  794,  794,  794 },
+  /*  780 */ {     0,    0,    0,    0,    0,  763,   76,32803,33563,33563,
+                 126,    0,    0,33563,33563,    0,    0,33563,33563,33563,
+               33563,33563,33563,33563,33563,33563,33563,33563 },
+  /*  781 */ {     0,   43,    0,   44,   43,  796,   43,    0,  797,  797,
+                  43,    0,   52,  797,  797,    0,    0,  797,  797,  797,
+                 797,  797,  797,  797,  797,  797,  797,  797 },
+  /*  782 */ {     0,   43,    0,   44,   43,  796,   55,    0,  797,  797,
+                  43,    0,   52,  797,  797,    0,    0,  797,  797,  797,
+                 797,  797,  797,  797,  797,  797,  797,  797 },
+  /*  783 */ {     0,   43,    0,   44,   43,  766,   55,32803,33566,33566,
+                  94,    0,   52,33566,33566,    0,    0,33566,33566,33566,
+               33566,33566,33566,33566,33566,33566,33566,33566 },
+  /*  784 */ {     0,    0,    0,    0,    0,  799,    0,    0,  800,  800,
+                   0,    0,    0,  800,  800,    0,    0,  800,  800,  800,
+                 800,  800,  800,  800,  800,  800,  800,  800 },
+  /*  785 */ {     0,    0,    0,    0,    0,  799,   96,    0,  800,  800,
+                   0,    0,    0,  800,  800,    0,    0,  800,  800,  800,
+                 800,  800,  800,  800,  800,  800,  800,  800 },
+  /*  786 */ {     0,    0,32884,    0,    0,  769,   96,32885,33569,33569,
+                 154,32885,    0,33569,33569,    0,    0,33569,33569,33569,
+               33569,33569,33569,33569,33569,33569,33569,33569 },
+  /*  787 */ {     0,   57,    0,   58,   57,  802,   57,    0,  803,  803,
+                  57,    0,   67,  803,  803,    0,    0,  803,  803,  803,
+                 803,  803,  803,  803,  803,  803,  803,  803 },
+  /*  788 */ {     0,   57,    0,   58,   57,  802,   70,    0,  803,  803,
+                  57,    0,   67,  803,  803,    0,    0,  803,  803,  803,
+                 803,  803,  803,  803,  803,  803,  803,  803 },
+  /*  789 */ {     0,   57,32884,   58,   57,  772,   70,32885,33572,33572,
+                 119,32885,   67,33572,33572,    0,    0,33572,33572,33572,
+               33572,33572,33572,33572,33572,33572,33572,33572 },
+  /*  790 */ {     0,    0,    0,    0,    0,  805,    0,    0,  806,  806,
+                   0,    0,    0,  806,  806,    0,    0,  806,  806,  806,
+                 806,  806,  806,  806,  806,  806,  806,  806 },
+  /*  791 */ {     0,    0,    0,    0,    0,  805,   18,    0,  806,  806,
+                   0,    0,    0,  806,  806,    0,    0,  806,  806,  806,
+                 806,  806,  806,  806,  806,  806,  806,  806 },
+  /*  792 */ {     0,    0,    0,    0,    0,  775,   18,    0,33575,33575,
+                   0,    0,    0,33575,33575,    0,    0,33575,33575,33575,
+               33575,33575,33575,33575,33575,33575,33575,33575 },
+  /*  793 */ {     0,    0,    0,    0,    0,  808,    0,    0,  809,  809,
+                   0,    0,    0,  809,  809,    0,    0,  809,  809,  809,
+                 809,  809,  809,  809,  809,  809,  809,  809 },
+  /*  794 */ {     0,    0,    0,    0,    0,  808,   76,    0,  809,  809,
+                   0,    0,    0,  809,  809,    0,    0,  809,  809,  809,
+                 809,  809,  809,  809,  809,  809,  809,  809 },
+  /*  795 */ {     0,    0,    0,    0,    0,  778,   76,32803,33578,33578,
+                 126,    0,    0,33578,33578,    0,    0,33578,33578,33578,
+               33578,33578,33578,33578,33578,33578,33578,33578 },
+  /*  796 */ {     0,   43,    0,   44,   43,  811,   43,    0,  812,  812,
+                  43,    0,   52,  812,  812,    0,    0,  812,  812,  812,
+                 812,  812,  812,  812,  812,  812,  812,  812 },
+  /*  797 */ {     0,   43,    0,   44,   43,  811,   55,    0,  812,  812,
+                  43,    0,   52,  812,  812,    0,    0,  812,  812,  812,
+                 812,  812,  812,  812,  812,  812,  812,  812 },
+  /*  798 */ {     0,   43,    0,   44,   43,  781,   55,32803,33581,33581,
+                  94,    0,   52,33581,33581,    0,    0,33581,33581,33581,
+               33581,33581,33581,33581,33581,33581,33581,33581 },
+  /*  799 */ {     0,    0,    0,    0,    0,  814,    0,    0,  815,  815,
+                   0,    0,    0,  815,  815,    0,    0,  815,  815,  815,
+                 815,  815,  815,  815,  815,  815,  815,  815 },
+  /*  800 */ {     0,    0,    0,    0,    0,  814,   96,    0,  815,  815,
+                   0,    0,    0,  815,  815,    0,    0,  815,  815,  815,
+                 815,  815,  815,  815,  815,  815,  815,  815 },
+  /*  801 */ {     0,    0,32884,    0,    0,  784,   96,32885,33584,33584,
+                 154,32885,    0,33584,33584,    0,    0,33584,33584,33584,
+               33584,33584,33584,33584,33584,33584,33584,33584 },
+  /*  802 */ {     0,   57,    0,   58,   57,  817,   57,    0,  818,  818,
+                  57,    0,   67,  818,  818,    0,    0,  818,  818,  818,
+                 818,  818,  818,  818,  818,  818,  818,  818 },
+  /*  803 */ {     0,   57,    0,   58,   57,  817,   70,    0,  818,  818,
+                  57,    0,   67,  818,  818,    0,    0,  818,  818,  818,
+                 818,  818,  818,  818,  818,  818,  818,  818 },
+  /*  804 */ {     0,   57,32884,   58,   57,  787,   70,32885,33587,33587,
+                 119,32885,   67,33587,33587,    0,    0,33587,33587,33587,
+               33587,33587,33587,33587,33587,33587,33587,33587 },
+  /*  805 */ {     0,    0,    0,    0,    0,  820,    0,    0,  821,  821,
+                   0,    0,    0,  821,  821,    0,    0,  821,  821,  821,
+                 821,  821,  821,  821,  821,  821,  821,  821 },
+  /*  806 */ {     0,    0,    0,    0,    0,  820,   18,    0,  821,  821,
+                   0,    0,    0,  821,  821,    0,    0,  821,  821,  821,
+                 821,  821,  821,  821,  821,  821,  821,  821 },
+  /*  807 */ {     0,    0,    0,    0,    0,  790,   18,    0,33590,33590,
+                   0,    0,    0,33590,33590,    0,    0,33590,33590,33590,
+               33590,33590,33590,33590,33590,33590,33590,33590 },
+  /*  808 */ {     0,    0,    0,    0,    0,  823,    0,    0,  824,  824,
+                   0,    0,    0,  824,  824,    0,    0,  824,  824,  824,
+                 824,  824,  824,  824,  824,  824,  824,  824 },
+  /*  809 */ {     0,    0,    0,    0,    0,  823,   76,    0,  824,  824,
+                   0,    0,    0,  824,  824,    0,    0,  824,  824,  824,
+                 824,  824,  824,  824,  824,  824,  824,  824 },
+  /*  810 */ {     0,    0,    0,    0,    0,  793,   76,32803,33593,33593,
+                 126,    0,    0,33593,33593,    0,    0,33593,33593,33593,
+               33593,33593,33593,33593,33593,33593,33593,33593 },
+  /*  811 */ {     0,   43,    0,   44,   43,  826,   43,    0,  827,  827,
+                  43,    0,   52,  827,  827,    0,    0,  827,  827,  827,
+                 827,  827,  827,  827,  827,  827,  827,  827 },
+  /*  812 */ {     0,   43,    0,   44,   43,  826,   55,    0,  827,  827,
+                  43,    0,   52,  827,  827,    0,    0,  827,  827,  827,
+                 827,  827,  827,  827,  827,  827,  827,  827 },
+  /*  813 */ {     0,   43,    0,   44,   43,  796,   55,32803,33596,33596,
+                  94,    0,   52,33596,33596,    0,    0,33596,33596,33596,
+               33596,33596,33596,33596,33596,33596,33596,33596 },
+  /*  814 */ {     0,    0,    0,    0,    0,  829,    0,    0,  830,  830,
+                   0,    0,    0,  830,  830,    0,    0,  830,  830,  830,
+                 830,  830,  830,  830,  830,  830,  830,  830 },
+  /*  815 */ {     0,    0,    0,    0,    0,  829,   96,    0,  830,  830,
+                   0,    0,    0,  830,  830,    0,    0,  830,  830,  830,
+                 830,  830,  830,  830,  830,  830,  830,  830 },
+  /*  816 */ {     0,    0,32884,    0,    0,  799,   96,32885,33599,33599,
+                 154,32885,    0,33599,33599,    0,    0,33599,33599,33599,
+               33599,33599,33599,33599,33599,33599,33599,33599 },
+  /*  817 */ {     0,   57,    0,   58,   57,  832,   57,    0,  833,  833,
+                  57,    0,   67,  833,  833,    0,    0,  833,  833,  833,
+                 833,  833,  833,  833,  833,  833,  833,  833 },
+  /*  818 */ {     0,   57,    0,   58,   57,  832,   70,    0,  833,  833,
+                  57,    0,   67,  833,  833,    0,    0,  833,  833,  833,
+                 833,  833,  833,  833,  833,  833,  833,  833 },
+  /*  819 */ {     0,   57,32884,   58,   57,  802,   70,32885,33602,33602,
+                 119,32885,   67,33602,33602,    0,    0,33602,33602,33602,
+               33602,33602,33602,33602,33602,33602,33602,33602 },
+  /*  820 */ {     0,    0,    0,    0,    0,  835,    0,    0,  836,  836,
+                   0,    0,    0,  836,  836,    0,    0,  836,  836,  836,
+                 836,  836,  836,  836,  836,  836,  836,  836 },
+  /*  821 */ {     0,    0,    0,    0,    0,  835,   18,    0,  836,  836,
+                   0,    0,    0,  836,  836,    0,    0,  836,  836,  836,
+                 836,  836,  836,  836,  836,  836,  836,  836 },
+  /*  822 */ {     0,    0,    0,    0,    0,  805,   18,    0,33605,33605,
+                   0,    0,    0,33605,33605,    0,    0,33605,33605,33605,
+               33605,33605,33605,33605,33605,33605,33605,33605 },
+  /*  823 */ {     0,    0,    0,    0,    0,  838,    0,    0,  839,  839,
+                   0,    0,    0,  839,  839,    0,    0,  839,  839,  839,
+                 839,  839,  839,  839,  839,  839,  839,  839 },
+  /*  824 */ {     0,    0,    0,    0,    0,  838,   76,    0,  839,  839,
+                   0,    0,    0,  839,  839,    0,    0,  839,  839,  839,
+                 839,  839,  839,  839,  839,  839,  839,  839 },
+  /*  825 */ {     0,    0,    0,    0,    0,  808,   76,32803,33608,33608,
+                 126,    0,    0,33608,33608,    0,    0,33608,33608,33608,
+               33608,33608,33608,33608,33608,33608,33608,33608 },
+  /*  826 */ {     0,   43,    0,   44,   43,  841,   43,    0,  842,  842,
+                  43,    0,   52,  842,  842,    0,    0,  842,  842,  842,
+                 842,  842,  842,  842,  842,  842,  842,  842 },
+  /*  827 */ {     0,   43,    0,   44,   43,  841,   55,    0,  842,  842,
+                  43,    0,   52,  842,  842,    0,    0,  842,  842,  842,
+                 842,  842,  842,  842,  842,  842,  842,  842 },
+  /*  828 */ {     0,   43,    0,   44,   43,  811,   55,32803,33611,33611,
+                  94,    0,   52,33611,33611,    0,    0,33611,33611,33611,
+               33611,33611,33611,33611,33611,33611,33611,33611 },
+  /*  829 */ {     0,    0,    0,    0,    0,  844,    0,    0,  845,  845,
+                   0,    0,    0,  845,  845,    0,    0,  845,  845,  845,
+                 845,  845,  845,  845,  845,  845,  845,  845 },
+  /*  830 */ {     0,    0,    0,    0,    0,  844,   96,    0,  845,  845,
+                   0,    0,    0,  845,  845,    0,    0,  845,  845,  845,
+                 845,  845,  845,  845,  845,  845,  845,  845 },
+  /*  831 */ {     0,    0,32884,    0,    0,  814,   96,32885,33614,33614,
+                 154,32885,    0,33614,33614,    0,    0,33614,33614,33614,
+               33614,33614,33614,33614,33614,33614,33614,33614 },
+  /*  832 */ {     0,   57,    0,   58,   57,  847,   57,    0,  848,  848,
+                  57,    0,   67,  848,  848,    0,    0,  848,  848,  848,
+                 848,  848,  848,  848,  848,  848,  848,  848 },
+  /*  833 */ {     0,   57,    0,   58,   57,  847,   70,    0,  848,  848,
+                  57,    0,   67,  848,  848,    0,    0,  848,  848,  848,
+                 848,  848,  848,  848,  848,  848,  848,  848 },
+  /*  834 */ {     0,   57,32884,   58,   57,  817,   70,32885,33617,33617,
+                 119,32885,   67,33617,33617,    0,    0,33617,33617,33617,
+               33617,33617,33617,33617,33617,33617,33617,33617 },
+  /*  835 */ {     0,    0,    0,    0,    0,  850,    0,    0,  851,  851,
+                   0,    0,    0,  851,  851,    0,    0,  851,  851,  851,
+                 851,  851,  851,  851,  851,  851,  851,  851 },
+  /*  836 */ {     0,    0,    0,    0,    0,  850,   18,    0,  851,  851,
+                   0,    0,    0,  851,  851,    0,    0,  851,  851,  851,
+                 851,  851,  851,  851,  851,  851,  851,  851 },
+  /*  837 */ {     0,    0,    0,    0,    0,  820,   18,    0,33620,33620,
+                   0,    0,    0,33620,33620,    0,    0,33620,33620,33620,
+               33620,33620,33620,33620,33620,33620,33620,33620 },
+  /*  838 */ {     0,    0,    0,    0,    0,  853,    0,    0,  854,  854,
+                   0,    0,    0,  854,  854,    0,    0,  854,  854,  854,
+                 854,  854,  854,  854,  854,  854,  854,  854 },
+  /*  839 */ {     0,    0,    0,    0,    0,  853,   76,    0,  854,  854,
+                   0,    0,    0,  854,  854,    0,    0,  854,  854,  854,
+                 854,  854,  854,  854,  854,  854,  854,  854 },
+  /*  840 */ {     0,    0,    0,    0,    0,  823,   76,32803,33623,33623,
+                 126,    0,    0,33623,33623,    0,    0,33623,33623,33623,
+               33623,33623,33623,33623,33623,33623,33623,33623 },
+  /*  841 */ {     0,   43,    0,   44,   43,  856,   43,    0,  857,  857,
+                  43,    0,   52,  857,  857,    0,    0,  857,  857,  857,
+                 857,  857,  857,  857,  857,  857,  857,  857 },
+  /*  842 */ {     0,   43,    0,   44,   43,  856,   55,    0,  857,  857,
+                  43,    0,   52,  857,  857,    0,    0,  857,  857,  857,
+                 857,  857,  857,  857,  857,  857,  857,  857 },
+  /*  843 */ {     0,   43,    0,   44,   43,  826,   55,32803,33626,33626,
+                  94,    0,   52,33626,33626,    0,    0,33626,33626,33626,
+               33626,33626,33626,33626,33626,33626,33626,33626 },
+  /*  844 */ {     0,    0,    0,    0,    0,  859,    0,    0,  860,  860,
+                   0,    0,    0,  860,  860,    0,    0,  860,  860,  860,
+                 860,  860,  860,  860,  860,  860,  860,  860 },
+  /*  845 */ {     0,    0,    0,    0,    0,  859,   96,    0,  860,  860,
+                   0,    0,    0,  860,  860,    0,    0,  860,  860,  860,
+                 860,  860,  860,  860,  860,  860,  860,  860 },
+  /*  846 */ {     0,    0,32884,    0,    0,  829,   96,32885,33629,33629,
+                 154,32885,    0,33629,33629,    0,    0,33629,33629,33629,
+               33629,33629,33629,33629,33629,33629,33629,33629 },
+  /*  847 */ {     0,   57,    0,   58,   57,  862,   57,    0,  863,  863,
+                  57,    0,   67,  863,  863,    0,    0,  863,  863,  863,
+                 863,  863,  863,  863,  863,  863,  863,  863 },
+  /*  848 */ {     0,   57,    0,   58,   57,  862,   70,    0,  863,  863,
+                  57,    0,   67,  863,  863,    0,    0,  863,  863,  863,
+                 863,  863,  863,  863,  863,  863,  863,  863 },
+  /*  849 */ {     0,   57,32884,   58,   57,  832,   70,32885,33632,33632,
+                 119,32885,   67,33632,33632,    0,    0,33632,33632,33632,
+               33632,33632,33632,33632,33632,33632,33632,33632 },
+  /*  850 */ {     0,    0,    0,    0,    0,  865,    0,    0,  866,  866,
+                   0,    0,    0,  866,  866,    0,    0,  866,  866,  866,
+                 866,  866,  866,  866,  866,  866,  866,  866 },
+  /*  851 */ {     0,    0,    0,    0,    0,  865,   18,    0,  866,  866,
+                   0,    0,    0,  866,  866,    0,    0,  866,  866,  866,
+                 866,  866,  866,  866,  866,  866,  866,  866 },
+  /*  852 */ {     0,    0,    0,    0,    0,  835,   18,    0,33635,33635,
+                   0,    0,    0,33635,33635,    0,    0,33635,33635,33635,
+               33635,33635,33635,33635,33635,33635,33635,33635 },
+  /*  853 */ {     0,    0,    0,    0,    0,  868,    0,    0,  869,  869,
+                   0,    0,    0,  869,  869,    0,    0,  869,  869,  869,
+                 869,  869,  869,  869,  869,  869,  869,  869 },
+  /*  854 */ {     0,    0,    0,    0,    0,  868,   76,    0,  869,  869,
+                   0,    0,    0,  869,  869,    0,    0,  869,  869,  869,
+                 869,  869,  869,  869,  869,  869,  869,  869 },
+  /*  855 */ {     0,    0,    0,    0,    0,  838,   76,32803,33638,33638,
+                 126,    0,    0,33638,33638,    0,    0,33638,33638,33638,
+               33638,33638,33638,33638,33638,33638,33638,33638 },
+  /*  856 */ {     0,   43,    0,   44,   43,  871,   43,    0,  872,  872,
+                  43,    0,   52,  872,  872,    0,    0,  872,  872,  872,
+                 872,  872,  872,  872,  872,  872,  872,  872 },
+  /*  857 */ {     0,   43,    0,   44,   43,  871,   55,    0,  872,  872,
+                  43,    0,   52,  872,  872,    0,    0,  872,  872,  872,
+                 872,  872,  872,  872,  872,  872,  872,  872 },
+  /*  858 */ {     0,   43,    0,   44,   43,  841,   55,32803,33641,33641,
+                  94,    0,   52,33641,33641,    0,    0,33641,33641,33641,
+               33641,33641,33641,33641,33641,33641,33641,33641 },
+  /*  859 */ {     0,    0,    0,    0,    0,  874,    0,    0,  875,  875,
+                   0,    0,    0,  875,  875,    0,    0,  875,  875,  875,
+                 875,  875,  875,  875,  875,  875,  875,  875 },
+  /*  860 */ {     0,    0,    0,    0,    0,  874,   96,    0,  875,  875,
+                   0,    0,    0,  875,  875,    0,    0,  875,  875,  875,
+                 875,  875,  875,  875,  875,  875,  875,  875 },
+  /*  861 */ {     0,    0,32884,    0,    0,  844,   96,32885,33644,33644,
+                 154,32885,    0,33644,33644,    0,    0,33644,33644,33644,
+               33644,33644,33644,33644,33644,33644,33644,33644 },
+  /*  862 */ {     0,   57,    0,   58,   57,  877,   57,    0,  878,  878,
+                  57,    0,   67,  878,  878,    0,    0,  878,  878,  878,
+                 878,  878,  878,  878,  878,  878,  878,  878 },
+  /*  863 */ {     0,   57,    0,   58,   57,  877,   70,    0,  878,  878,
+                  57,    0,   67,  878,  878,    0,    0,  878,  878,  878,
+                 878,  878,  878,  878,  878,  878,  878,  878 },
+  /*  864 */ {     0,   57,32884,   58,   57,  847,   70,32885,33647,33647,
+                 119,32885,   67,33647,33647,    0,    0,33647,33647,33647,
+               33647,33647,33647,33647,33647,33647,33647,33647 },
+  /*  865 */ {     0,    0,    0,    0,    0,  880,    0,    0,  881,  881,
+                   0,    0,    0,  881,  881,    0,    0,  881,  881,  881,
+                 881,  881,  881,  881,  881,  881,  881,  881 },
+  /*  866 */ {     0,    0,    0,    0,    0,  880,   18,    0,  881,  881,
+                   0,    0,    0,  881,  881,    0,    0,  881,  881,  881,
+                 881,  881,  881,  881,  881,  881,  881,  881 },
+  /*  867 */ {     0,    0,    0,    0,    0,  850,   18,    0,33650,33650,
+                   0,    0,    0,33650,33650,    0,    0,33650,33650,33650,
+               33650,33650,33650,33650,33650,33650,33650,33650 },
+  /*  868 */ {     0,    0,    0,    0,    0,  883,    0,    0,  884,  884,
+                   0,    0,    0,  884,  884,    0,    0,  884,  884,  884,
+                 884,  884,  884,  884,  884,  884,  884,  884 },
+  /*  869 */ {     0,    0,    0,    0,    0,  883,   76,    0,  884,  884,
+                   0,    0,    0,  884,  884,    0,    0,  884,  884,  884,
+                 884,  884,  884,  884,  884,  884,  884,  884 },
+  /*  870 */ {     0,    0,    0,    0,    0,  853,   76,32803,33653,33653,
+                 126,    0,    0,33653,33653,    0,    0,33653,33653,33653,
+               33653,33653,33653,33653,33653,33653,33653,33653 },
+  /*  871 */ {     0,   43,    0,   44,   43,  886,   43,    0,  887,  887,
+                  43,    0,   52,  887,  887,    0,    0,  887,  887,  887,
+                 887,  887,  887,  887,  887,  887,  887,  887 },
+  /*  872 */ {     0,   43,    0,   44,   43,  886,   55,    0,  887,  887,
+                  43,    0,   52,  887,  887,    0,    0,  887,  887,  887,
+                 887,  887,  887,  887,  887,  887,  887,  887 },
+  /*  873 */ {     0,   43,    0,   44,   43,  856,   55,32803,33656,33656,
+                  94,    0,   52,33656,33656,    0,    0,33656,33656,33656,
+               33656,33656,33656,33656,33656,33656,33656,33656 },
+  /*  874 */ {     0,    0,    0,    0,    0,  889,    0,    0,  890,  890,
+                   0,    0,    0,  890,  890,    0,    0,  890,  890,  890,
+                 890,  890,  890,  890,  890,  890,  890,  890 },
+  /*  875 */ {     0,    0,    0,    0,    0,  889,   96,    0,  890,  890,
+                   0,    0,    0,  890,  890,    0,    0,  890,  890,  890,
+                 890,  890,  890,  890,  890,  890,  890,  890 },
+  /*  876 */ {     0,    0,32884,    0,    0,  859,   96,32885,33659,33659,
+                 154,32885,    0,33659,33659,    0,    0,33659,33659,33659,
+               33659,33659,33659,33659,33659,33659,33659,33659 },
+  /*  877 */ {     0,   57,    0,   58,   57,  892,   57,    0,  893,  893,
+                  57,    0,   67,  893,  893,    0,    0,  893,  893,  893,
+                 893,  893,  893,  893,  893,  893,  893,  893 },
+  /*  878 */ {     0,   57,    0,   58,   57,  892,   70,    0,  893,  893,
+                  57,    0,   67,  893,  893,    0,    0,  893,  893,  893,
+                 893,  893,  893,  893,  893,  893,  893,  893 },
+  /*  879 */ {     0,   57,32884,   58,   57,  862,   70,32885,33662,33662,
+                 119,32885,   67,33662,33662,    0,    0,33662,33662,33662,
+               33662,33662,33662,33662,33662,33662,33662,33662 },
+  /*  880 */ {     0,    0,    0,    0,    0,  895,    0,    0,  896,  896,
+                   0,    0,    0,  896,  896,    0,    0,  896,  896,  896,
+                 896,  896,  896,  896,  896,  896,  896,  896 },
+  /*  881 */ {     0,    0,    0,    0,    0,  895,   18,    0,  896,  896,
+                   0,    0,    0,  896,  896,    0,    0,  896,  896,  896,
+                 896,  896,  896,  896,  896,  896,  896,  896 },
+  /*  882 */ {     0,    0,    0,    0,    0,  865,   18,    0,33665,33665,
+                   0,    0,    0,33665,33665,    0,    0,33665,33665,33665,
+               33665,33665,33665,33665,33665,33665,33665,33665 },
+  /*  883 */ {     0,    0,    0,    0,    0,  898,    0,    0,  899,  899,
+                   0,    0,    0,  899,  899,    0,    0,  899,  899,  899,
+                 899,  899,  899,  899,  899,  899,  899,  899 },
+  /*  884 */ {     0,    0,    0,    0,    0,  898,   76,    0,  899,  899,
+                   0,    0,    0,  899,  899,    0,    0,  899,  899,  899,
+                 899,  899,  899,  899,  899,  899,  899,  899 },
+  /*  885 */ {     0,    0,    0,    0,    0,  868,   76,32803,33668,33668,
+                 126,    0,    0,33668,33668,    0,    0,33668,33668,33668,
+               33668,33668,33668,33668,33668,33668,33668,33668 },
+  /*  886 */ {     0,   43,    0,   44,   43,  901,   43,    0,  902,  902,
+                  43,    0,   52,  902,  902,    0,    0,  902,  902,  902,
+                 902,  902,  902,  902,  902,  902,  902,  902 },
+  /*  887 */ {     0,   43,    0,   44,   43,  901,   55,    0,  902,  902,
+                  43,    0,   52,  902,  902,    0,    0,  902,  902,  902,
+                 902,  902,  902,  902,  902,  902,  902,  902 },
+  /*  888 */ {     0,   43,    0,   44,   43,  871,   55,32803,33671,33671,
+                  94,    0,   52,33671,33671,    0,    0,33671,33671,33671,
+               33671,33671,33671,33671,33671,33671,33671,33671 },
+  /*  889 */ {     0,    0,    0,    0,    0,  904,    0,    0,  905,  905,
+                   0,    0,    0,  905,  905,    0,    0,  905,  905,  905,
+                 905,  905,  905,  905,  905,  905,  905,  905 },
+  /*  890 */ {     0,    0,    0,    0,    0,  904,   96,    0,  905,  905,
+                   0,    0,    0,  905,  905,    0,    0,  905,  905,  905,
+                 905,  905,  905,  905,  905,  905,  905,  905 },
+  /*  891 */ {     0,    0,32884,    0,    0,  874,   96,32885,33674,33674,
+                 154,32885,    0,33674,33674,    0,    0,33674,33674,33674,
+               33674,33674,33674,33674,33674,33674,33674,33674 },
+  /*  892 */ {     0,   57,    0,   58,   57,  907,   57,    0,  908,  908,
+                  57,    0,   67,  908,  908,    0,    0,  908,  908,  908,
+                 908,  908,  908,  908,  908,  908,  908,  908 },
+  /*  893 */ {     0,   57,    0,   58,   57,  907,   70,    0,  908,  908,
+                  57,    0,   67,  908,  908,    0,    0,  908,  908,  908,
+                 908,  908,  908,  908,  908,  908,  908,  908 },
+  /*  894 */ {     0,   57,32884,   58,   57,  877,   70,32885,33677,33677,
+                 119,32885,   67,33677,33677,    0,    0,33677,33677,33677,
+               33677,33677,33677,33677,33677,33677,33677,33677 },
+  /*  895 */ {     0,    0,    0,    0,    0,  910,    0,    0,  911,  911,
+                   0,    0,    0,  911,  911,    0,    0,  911,  911,  911,
+                 911,  911,  911,  911,  911,  911,  911,  911 },
+  /*  896 */ {     0,    0,    0,    0,    0,  910,   18,    0,  911,  911,
+                   0,    0,    0,  911,  911,    0,    0,  911,  911,  911,
+                 911,  911,  911,  911,  911,  911,  911,  911 },
+  /*  897 */ {     0,    0,    0,    0,    0,  880,   18,    0,33680,33680,
+                   0,    0,    0,33680,33680,    0,    0,33680,33680,33680,
+               33680,33680,33680,33680,33680,33680,33680,33680 },
+  /*  898 */ {     0,    0,    0,    0,    0,  913,    0,    0,  914,  914,
+                   0,    0,    0,  914,  914,    0,    0,  914,  914,  914,
+                 914,  914,  914,  914,  914,  914,  914,  914 },
+  /*  899 */ {     0,    0,    0,    0,    0,  913,   76,    0,  914,  914,
+                   0,    0,    0,  914,  914,    0,    0,  914,  914,  914,
+                 914,  914,  914,  914,  914,  914,  914,  914 },
+  /*  900 */ {     0,    0,    0,    0,    0,  883,   76,32803,33683,33683,
+                 126,    0,    0,33683,33683,    0,    0,33683,33683,33683,
+               33683,33683,33683,33683,33683,33683,33683,33683 },
+  /*  901 */ {     0,   43,    0,   44,   43,  916,   43,    0,  917,  917,
+                  43,    0,   52,  917,  917,    0,    0,  917,  917,  917,
+                 917,  917,  917,  917,  917,  917,  917,  917 },
+  /*  902 */ {     0,   43,    0,   44,   43,  916,   55,    0,  917,  917,
+                  43,    0,   52,  917,  917,    0,    0,  917,  917,  917,
+                 917,  917,  917,  917,  917,  917,  917,  917 },
+  /*  903 */ {     0,   43,    0,   44,   43,  886,   55,32803,33686,33686,
+                  94,    0,   52,33686,33686,    0,    0,33686,33686,33686,
+               33686,33686,33686,33686,33686,33686,33686,33686 },
+  /*  904 */ {     0,    0,    0,    0,    0,  919,    0,    0,  920,  920,
+                   0,    0,    0,  920,  920,    0,    0,  920,  920,  920,
+                 920,  920,  920,  920,  920,  920,  920,  920 },
+  /*  905 */ {     0,    0,    0,    0,    0,  919,   96,    0,  920,  920,
+                   0,    0,    0,  920,  920,    0,    0,  920,  920,  920,
+                 920,  920,  920,  920,  920,  920,  920,  920 },
+  /*  906 */ {     0,    0,32884,    0,    0,  889,   96,32885,33689,33689,
+                 154,32885,    0,33689,33689,    0,    0,33689,33689,33689,
+               33689,33689,33689,33689,33689,33689,33689,33689 },
+  /*  907 */ {     0,   57,    0,   58,   57,  922,   57,    0,  923,  923,
+                  57,    0,   67,  923,  923,    0,    0,  923,  923,  923,
+                 923,  923,  923,  923,  923,  923,  923,  923 },
+  /*  908 */ {     0,   57,    0,   58,   57,  922,   70,    0,  923,  923,
+                  57,    0,   67,  923,  923,    0,    0,  923,  923,  923,
+                 923,  923,  923,  923,  923,  923,  923,  923 },
+  /*  909 */ {     0,   57,32884,   58,   57,  892,   70,32885,33692,33692,
+                 119,32885,   67,33692,33692,    0,    0,33692,33692,33692,
+               33692,33692,33692,33692,33692,33692,33692,33692 },
+  /*  910 */ {     0,    0,    0,    0,    0,    0,    0,    0,  925,  925,
+                   0,    0,    0,  925,  925,    0,    0,  925,  925,  925,
+                 925,  925,  925,  925,  925,  925,  925,  925 },
+  /*  911 */ {     0,    0,    0,    0,    0,    0,   18,    0,  925,  925,
+                   0,    0,    0,  925,  925,    0,    0,  925,  925,  925,
+                 925,  925,  925,  925,  925,  925,  925,  925 },
+  /*  912 */ {     0,    0,    0,    0,    0,  895,   18,    0,33694,33694,
+                   0,    0,    0,33694,33694,    0,    0,33694,33694,33694,
+               33694,33694,33694,33694,33694,33694,33694,33694 },
+  /*  913 */ {     0,    0,    0,    0,    0,  927,    0,    0,  928,  928,
+                   0,    0,    0,  928,  928,    0,    0,  928,  928,  928,
+                 928,  928,  928,  928,  928,  928,  928,  928 },
+  /*  914 */ {     0,    0,    0,    0,    0,  927,   76,    0,  928,  928,
+                   0,    0,    0,  928,  928,    0,    0,  928,  928,  928,
+                 928,  928,  928,  928,  928,  928,  928,  928 },
+  /*  915 */ {     0,    0,    0,    0,    0,  898,   76,32803,33697,33697,
+                 126,    0,    0,33697,33697,    0,    0,33697,33697,33697,
+               33697,33697,33697,33697,33697,33697,33697,33697 },
+  /*  916 */ {     0,   43,    0,   44,   43,  930,   43,    0,  931,  931,
+                  43,    0,   52,  931,  931,    0,    0,  931,  931,  931,
+                 931,  931,  931,  931,  931,  931,  931,  931 },
+  /*  917 */ {     0,   43,    0,   44,   43,  930,   55,    0,  931,  931,
+                  43,    0,   52,  931,  931,    0,    0,  931,  931,  931,
+                 931,  931,  931,  931,  931,  931,  931,  931 },
+  /*  918 */ {     0,   43,    0,   44,   43,  901,   55,32803,33700,33700,
+                  94,    0,   52,33700,33700,    0,    0,33700,33700,33700,
+               33700,33700,33700,33700,33700,33700,33700,33700 },
+  /*  919 */ {     0,    0,    0,    0,    0,  933,    0,    0,  934,  934,
+                   0,    0,    0,  934,  934,    0,    0,  934,  934,  934,
+                 934,  934,  934,  934,  934,  934,  934,  934 },
+  /*  920 */ {     0,    0,    0,    0,    0,  933,   96,    0,  934,  934,
+                   0,    0,    0,  934,  934,    0,    0,  934,  934,  934,
+                 934,  934,  934,  934,  934,  934,  934,  934 },
+  /*  921 */ {     0,    0,32884,    0,    0,  904,   96,32885,33703,33703,
+                 154,32885,    0,33703,33703,    0,    0,33703,33703,33703,
+               33703,33703,33703,33703,33703,33703,33703,33703 },
+  /*  922 */ {     0,   57,    0,   58,   57,  936,   57,    0,  937,  937,
+                  57,    0,   67,  937,  937,    0,    0,  937,  937,  937,
+                 937,  937,  937,  937,  937,  937,  937,  937 },
+  /*  923 */ {     0,   57,    0,   58,   57,  936,   70,    0,  937,  937,
+                  57,    0,   67,  937,  937,    0,    0,  937,  937,  937,
+                 937,  937,  937,  937,  937,  937,  937,  937 },
+  /*  924 */ {     0,   57,32884,   58,   57,  907,   70,32885,33706,33706,
+                 119,32885,   67,33706,33706,    0,    0,33706,33706,33706,
+               33706,33706,33706,33706,33706,33706,33706,33706 },
+  /*  925 */ {     0,    0,    0,    0,    0,    0,   18,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  926 */ {     0,    0,    0,    0,    0,  910,   18,    0,33707,33707,
+                   0,    0,    0,33707,33707,    0,    0,33707,33707,33707,
+               33707,33707,33707,33707,33707,33707,33707,33707 },
+  /*  927 */ {     0,    0,    0,    0,    0,  940,    0,    0,  941,  941,
+                   0,    0,    0,  941,  941,    0,    0,  941,  941,  941,
+                 941,  941,  941,  941,  941,  941,  941,  941 },
+  /*  928 */ {     0,    0,    0,    0,    0,  940,   76,    0,  941,  941,
+                   0,    0,    0,  941,  941,    0,    0,  941,  941,  941,
+                 941,  941,  941,  941,  941,  941,  941,  941 },
+  /*  929 */ {     0,    0,    0,    0,    0,  913,   76,32803,33710,33710,
+                 126,    0,    0,33710,33710,    0,    0,33710,33710,33710,
+               33710,33710,33710,33710,33710,33710,33710,33710 },
+  /*  930 */ {     0,   43,    0,   44,   43,  943,   43,    0,  944,  944,
+                  43,    0,   52,  944,  944,    0,    0,  944,  944,  944,
+                 944,  944,  944,  944,  944,  944,  944,  944 },
+  /*  931 */ {     0,   43,    0,   44,   43,  943,   55,    0,  944,  944,
+                  43,    0,   52,  944,  944,    0,    0,  944,  944,  944,
+                 944,  944,  944,  944,  944,  944,  944,  944 },
+  /*  932 */ {     0,   43,    0,   44,   43,  916,   55,32803,33713,33713,
+                  94,    0,   52,33713,33713,    0,    0,33713,33713,33713,
+               33713,33713,33713,33713,33713,33713,33713,33713 },
+  /*  933 */ {     0,    0,    0,    0,    0,  946,    0,    0,  947,  947,
+                   0,    0,    0,  947,  947,    0,    0,  947,  947,  947,
+                 947,  947,  947,  947,  947,  947,  947,  947 },
+  /*  934 */ {     0,    0,    0,    0,    0,  946,   96,    0,  947,  947,
+                   0,    0,    0,  947,  947,    0,    0,  947,  947,  947,
+                 947,  947,  947,  947,  947,  947,  947,  947 },
+  /*  935 */ {     0,    0,32884,    0,    0,  919,   96,32885,33716,33716,
+                 154,32885,    0,33716,33716,    0,    0,33716,33716,33716,
+               33716,33716,33716,33716,33716,33716,33716,33716 },
+  /*  936 */ {     0,   57,    0,   58,   57,  949,   57,    0,  950,  950,
+                  57,    0,   67,  950,  950,    0,    0,  950,  950,  950,
+                 950,  950,  950,  950,  950,  950,  950,  950 },
+  /*  937 */ {     0,   57,    0,   58,   57,  949,   70,    0,  950,  950,
+                  57,    0,   67,  950,  950,    0,    0,  950,  950,  950,
+                 950,  950,  950,  950,  950,  950,  950,  950 },
+  /*  938 */ {     0,   57,32884,   58,   57,  922,   70,32885,33719,33719,
+                 119,32885,   67,33719,33719,    0,    0,33719,33719,33719,
+               33719,33719,33719,33719,33719,33719,33719,33719 },
+  /*  939 */ {     0,    0,    0,    0,    0,    0,   18,    0,33720,33720,
+                   0,    0,    0,33720,33720,    0,    0,33720,33720,33720,
+               33720,33720,33720,33720,33720,33720,33720,33720 },
+  /*  940 */ {     0,    0,    0,    0,    0,  953,    0,    0,  954,  954,
+                   0,    0,    0,  954,  954,    0,    0,  954,  954,  954,
+                 954,  954,  954,  954,  954,  954,  954,  954 },
+  /*  941 */ {     0,    0,    0,    0,    0,  953,   76,    0,  954,  954,
+                   0,    0,    0,  954,  954,    0,    0,  954,  954,  954,
+                 954,  954,  954,  954,  954,  954,  954,  954 },
+  /*  942 */ {     0,    0,    0,    0,    0,  927,   76,32803,33723,33723,
+                 126,    0,    0,33723,33723,    0,    0,33723,33723,33723,
+               33723,33723,33723,33723,33723,33723,33723,33723 },
+  /*  943 */ {     0,   43,    0,   44,   43,  956,   43,    0,  957,  957,
+                  43,    0,   52,  957,  957,    0,    0,  957,  957,  957,
+                 957,  957,  957,  957,  957,  957,  957,  957 },
+  /*  944 */ {     0,   43,    0,   44,   43,  956,   55,    0,  957,  957,
+                  43,    0,   52,  957,  957,    0,    0,  957,  957,  957,
+                 957,  957,  957,  957,  957,  957,  957,  957 },
+  /*  945 */ {     0,   43,    0,   44,   43,  930,   55,32803,33726,33726,
+                  94,    0,   52,33726,33726,    0,    0,33726,33726,33726,
+               33726,33726,33726,33726,33726,33726,33726,33726 },
+  /*  946 */ {     0,    0,    0,    0,    0,  959,    0,    0,  960,  960,
+                   0,    0,    0,  960,  960,    0,    0,  960,  960,  960,
+                 960,  960,  960,  960,  960,  960,  960,  960 },
+  /*  947 */ {     0,    0,    0,    0,    0,  959,   96,    0,  960,  960,
+                   0,    0,    0,  960,  960,    0,    0,  960,  960,  960,
+                 960,  960,  960,  960,  960,  960,  960,  960 },
+  /*  948 */ {     0,    0,32884,    0,    0,  933,   96,32885,33729,33729,
+                 154,32885,    0,33729,33729,    0,    0,33729,33729,33729,
+               33729,33729,33729,33729,33729,33729,33729,33729 },
+  /*  949 */ {     0,   57,    0,   58,   57,  962,   57,    0,  963,  963,
+                  57,    0,   67,  963,  963,    0,    0,  963,  963,  963,
+                 963,  963,  963,  963,  963,  963,  963,  963 },
+  /*  950 */ {     0,   57,    0,   58,   57,  962,   70,    0,  963,  963,
+                  57,    0,   67,  963,  963,    0,    0,  963,  963,  963,
+                 963,  963,  963,  963,  963,  963,  963,  963 },
+  /*  951 */ {     0,   57,32884,   58,   57,  936,   70,32885,33732,33732,
+                 119,32885,   67,33732,33732,    0,    0,33732,33732,33732,
+               33732,33732,33732,33732,33732,33732,33732,33732 },
+  /*  952 */ {     0,    0,    0,    0,    0,    0,   18,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  953 */ {     0,    0,    0,    0,    0,  965,    0,    0,  966,  966,
+                   0,    0,    0,  966,  966,    0,    0,  966,  966,  966,
+                 966,  966,  966,  966,  966,  966,  966,  966 },
+  /*  954 */ {     0,    0,    0,    0,    0,  965,   76,    0,  966,  966,
+                   0,    0,    0,  966,  966,    0,    0,  966,  966,  966,
+                 966,  966,  966,  966,  966,  966,  966,  966 },
+  /*  955 */ {     0,    0,    0,    0,    0,  940,   76,32803,33735,33735,
+                 126,    0,    0,33735,33735,    0,    0,33735,33735,33735,
+               33735,33735,33735,33735,33735,33735,33735,33735 },
+  /*  956 */ {     0,   43,    0,   44,   43,  968,   43,    0,  969,  969,
+                  43,    0,   52,  969,  969,    0,    0,  969,  969,  969,
+                 969,  969,  969,  969,  969,  969,  969,  969 },
+  /*  957 */ {     0,   43,    0,   44,   43,  968,   55,    0,  969,  969,
+                  43,    0,   52,  969,  969,    0,    0,  969,  969,  969,
+                 969,  969,  969,  969,  969,  969,  969,  969 },
+  /*  958 */ {     0,   43,    0,   44,   43,  943,   55,32803,33738,33738,
+                  94,    0,   52,33738,33738,    0,    0,33738,33738,33738,
+               33738,33738,33738,33738,33738,33738,33738,33738 },
+  /*  959 */ {     0,    0,    0,    0,    0,  971,    0,    0,  972,  972,
+                   0,    0,    0,  972,  972,    0,    0,  972,  972,  972,
+                 972,  972,  972,  972,  972,  972,  972,  972 },
+  /*  960 */ {     0,    0,    0,    0,    0,  971,   96,    0,  972,  972,
+                   0,    0,    0,  972,  972,    0,    0,  972,  972,  972,
+                 972,  972,  972,  972,  972,  972,  972,  972 },
+  /*  961 */ {     0,    0,32884,    0,    0,  946,   96,32885,33741,33741,
+                 154,32885,    0,33741,33741,    0,    0,33741,33741,33741,
+               33741,33741,33741,33741,33741,33741,33741,33741 },
+  /*  962 */ {     0,   57,    0,   58,   57,  974,   57,    0,  975,  975,
+                  57,    0,   67,  975,  975,    0,    0,  975,  975,  975,
+                 975,  975,  975,  975,  975,  975,  975,  975 },
+  /*  963 */ {     0,   57,    0,   58,   57,  974,   70,    0,  975,  975,
+                  57,    0,   67,  975,  975,    0,    0,  975,  975,  975,
+                 975,  975,  975,  975,  975,  975,  975,  975 },
+  /*  964 */ {     0,   57,32884,   58,   57,  949,   70,32885,33744,33744,
+                 119,32885,   67,33744,33744,    0,    0,33744,33744,33744,
+               33744,33744,33744,33744,33744,33744,33744,33744 },
+  /*  965 */ {     0,    0,    0,    0,    0,  977,    0,    0,  978,  978,
+                   0,    0,    0,  978,  978,    0,    0,  978,  978,  978,
+                 978,  978,  978,  978,  978,  978,  978,  978 },
+  /*  966 */ {     0,    0,    0,    0,    0,  977,   76,    0,  978,  978,
+                   0,    0,    0,  978,  978,    0,    0,  978,  978,  978,
+                 978,  978,  978,  978,  978,  978,  978,  978 },
+  /*  967 */ {     0,    0,    0,    0,    0,  953,   76,32803,33747,33747,
+                 126,    0,    0,33747,33747,    0,    0,33747,33747,33747,
+               33747,33747,33747,33747,33747,33747,33747,33747 },
+  /*  968 */ {     0,   43,    0,   44,   43,   43,   43,    0,  980,  980,
+                  43,    0,   52,  980,  980,    0,    0,  980,  980,  980,
+                 980,  980,  980,  980,  980,  980,  980,  980 },
+  /*  969 */ {     0,   43,    0,   44,   43,   43,   55,    0,  980,  980,
+                  43,    0,   52,  980,  980,    0,    0,  980,  980,  980,
+                 980,  980,  980,  980,  980,  980,  980,  980 },
+  /*  970 */ {     0,   43,    0,   44,   43,  956,   55,32803,33749,33749,
+                  94,    0,   52,33749,33749,    0,    0,33749,33749,33749,
+               33749,33749,33749,33749,33749,33749,33749,33749 },
+  /*  971 */ {     0,    0,    0,    0,    0,  982,    0,    0,  983,  983,
+                   0,    0,    0,  983,  983,    0,    0,  983,  983,  983,
+                 983,  983,  983,  983,  983,  983,  983,  983 },
+  /*  972 */ {     0,    0,    0,    0,    0,  982,   96,    0,  983,  983,
+                   0,    0,    0,  983,  983,    0,    0,  983,  983,  983,
+                 983,  983,  983,  983,  983,  983,  983,  983 },
+  /*  973 */ {     0,    0,32884,    0,    0,  959,   96,32885,33752,33752,
+                 154,32885,    0,33752,33752,    0,    0,33752,33752,33752,
+               33752,33752,33752,33752,33752,33752,33752,33752 },
+  /*  974 */ {     0,   57,    0,   58,   57,  985,   57,    0,  986,  986,
+                  57,    0,   67,  986,  986,    0,    0,  986,  986,  986,
+                 986,  986,  986,  986,  986,  986,  986,  986 },
+  /*  975 */ {     0,   57,    0,   58,   57,  985,   70,    0,  986,  986,
+                  57,    0,   67,  986,  986,    0,    0,  986,  986,  986,
+                 986,  986,  986,  986,  986,  986,  986,  986 },
+  /*  976 */ {     0,   57,32884,   58,   57,  962,   70,32885,33755,33755,
+                 119,32885,   67,33755,33755,    0,    0,33755,33755,33755,
+               33755,33755,33755,33755,33755,33755,33755,33755 },
+  /*  977 */ {     0,    0,    0,    0,    0,  988,    0,    0,  989,  989,
+                   0,    0,    0,  989,  989,    0,    0,  989,  989,  989,
+                 989,  989,  989,  989,  989,  989,  989,  989 },
+  /*  978 */ {     0,    0,    0,    0,    0,  988,   76,    0,  989,  989,
+                   0,    0,    0,  989,  989,    0,    0,  989,  989,  989,
+                 989,  989,  989,  989,  989,  989,  989,  989 },
+  /*  979 */ {     0,    0,    0,    0,    0,  965,   76,32803,33758,33758,
+                 126,    0,    0,33758,33758,    0,    0,33758,33758,33758,
+               33758,33758,33758,33758,33758,33758,33758,33758 },
+  /*  980 */ {     0,   43,    0,   44,   43,   43,   55,    0,   43,   43,
+                  43,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /*  981 */ {     0,   43,    0,   44,   43,  968,   55,32803,33759,33759,
+                  94,    0,   52,33759,33759,    0,    0,33759,33759,33759,
+               33759,33759,33759,33759,33759,33759,33759,33759 },
+  /*  982 */ {     0,    0,    0,    0,    0,  992,    0,    0,  993,  993,
+                   0,    0,    0,  993,  993,    0,    0,  993,  993,  993,
+                 993,  993,  993,  993,  993,  993,  993,  993 },
+  /*  983 */ {     0,    0,    0,    0,    0,  992,   96,    0,  993,  993,
+                   0,    0,    0,  993,  993,    0,    0,  993,  993,  993,
+                 993,  993,  993,  993,  993,  993,  993,  993 },
+  /*  984 */ {     0,    0,32884,    0,    0,  971,   96,32885,33762,33762,
+                 154,32885,    0,33762,33762,    0,    0,33762,33762,33762,
+               33762,33762,33762,33762,33762,33762,33762,33762 },
+  /*  985 */ {     0,   57,    0,   58,   57,   57,   57,    0,  995,  995,
+                  57,    0,   67,  995,  995,    0,    0,  995,  995,  995,
+                 995,  995,  995,  995,  995,  995,  995,  995 },
+  /*  986 */ {     0,   57,    0,   58,   57,   57,   70,    0,  995,  995,
+                  57,    0,   67,  995,  995,    0,    0,  995,  995,  995,
+                 995,  995,  995,  995,  995,  995,  995,  995 },
+  /*  987 */ {     0,   57,32884,   58,   57,  974,   70,32885,33764,33764,
+                 119,32885,   67,33764,33764,    0,    0,33764,33764,33764,
+               33764,33764,33764,33764,33764,33764,33764,33764 },
+  /*  988 */ {     0,    0,    0,    0,    0,    0,    0,    0,  997,  997,
+                   0,    0,    0,  997,  997,    0,    0,  997,  997,  997,
+                 997,  997,  997,  997,  997,  997,  997,  997 },
+  /*  989 */ {     0,    0,    0,    0,    0,    0,   76,    0,  997,  997,
+                   0,    0,    0,  997,  997,    0,    0,  997,  997,  997,
+                 997,  997,  997,  997,  997,  997,  997,  997 },
+  /*  990 */ {     0,    0,    0,    0,    0,  977,   76,32803,33766,33766,
+                 126,    0,    0,33766,33766,    0,    0,33766,33766,33766,
+               33766,33766,33766,33766,33766,33766,33766,33766 },
+  /*  991 */ {     0,   43,    0,   44,   43,   43,   55,32803,33767,33767,
+                  94,    0,   52,33767,33767,    0,    0,33767,33767,33767,
+               33767,33767,33767,33767,33767,33767,33767,33767 },
+  /*  992 */ {     0,    0,    0,    0,    0, 1000,    0,    0, 1001, 1001,
+                   0,    0,    0, 1001, 1001,    0,    0, 1001, 1001, 1001,
+                1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001 },
+  /*  993 */ {     0,    0,    0,    0,    0, 1000,   96,    0, 1001, 1001,
+                   0,    0,    0, 1001, 1001,    0,    0, 1001, 1001, 1001,
+                1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001 },
+  /*  994 */ {     0,    0,32884,    0,    0,  982,   96,32885,33770,33770,
+                 154,32885,    0,33770,33770,    0,    0,33770,33770,33770,
+               33770,33770,33770,33770,33770,33770,33770,33770 },
+  /*  995 */ {     0,   57,    0,   58,   57,   57,   70,    0,   57,   57,
+                  57,    0,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /*  996 */ {     0,   57,32884,   58,   57,  985,   70,32885,33771,33771,
+                 119,32885,   67,33771,33771,    0,    0,33771,33771,33771,
+               33771,33771,33771,33771,33771,33771,33771,33771 },
+  /*  997 */ {     0,    0,    0,    0,    0,    0,   76,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /*  998 */ {     0,    0,    0,    0,    0,  988,   76,32803,33772,33772,
+                 126,    0,    0,33772,33772,    0,    0,33772,33772,33772,
+               33772,33772,33772,33772,33772,33772,33772,33772 },
+  /*  999 */ {     0,   43,    0,   44,   43,   43,   55,32803,   43,   43,
+                  94,    0,   52,   43,   43,    0,    0,   43,   43,   43,
+                  43,   43,   43,   43,   43,   43,   43,   43 },
+  /* 1000 */ {     0,    0,    0,    0,    0,    0,    0,    0, 1005, 1005,
+                   0,    0,    0, 1005, 1005,    0,    0, 1005, 1005, 1005,
+                1005, 1005, 1005, 1005, 1005, 1005, 1005, 1005 },
+  /* 1001 */ {     0,    0,    0,    0,    0,    0,   96,    0, 1005, 1005,
+                   0,    0,    0, 1005, 1005,    0,    0, 1005, 1005, 1005,
+                1005, 1005, 1005, 1005, 1005, 1005, 1005, 1005 },
+  /* 1002 */ {     0,    0,32884,    0,    0,  992,   96,32885,33774,33774,
+                 154,32885,    0,33774,33774,    0,    0,33774,33774,33774,
+               33774,33774,33774,33774,33774,33774,33774,33774 },
+  /* 1003 */ {     0,   57,32884,   58,   57,   57,   70,32885,33775,33775,
+                 119,32885,   67,33775,33775,    0,    0,33775,33775,33775,
+               33775,33775,33775,33775,33775,33775,33775,33775 },
+  /* 1004 */ {     0,    0,    0,    0,    0,    0,   76,32803,33776,33776,
+                 126,    0,    0,33776,33776,    0,    0,33776,33776,33776,
+               33776,33776,33776,33776,33776,33776,33776,33776 },
+  /* 1005 */ {     0,    0,    0,    0,    0,    0,   96,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /* 1006 */ {     0,    0,32884,    0,    0, 1000,   96,32885,33777,33777,
+                 154,32885,    0,33777,33777,    0,    0,33777,33777,33777,
+               33777,33777,33777,33777,33777,33777,33777,33777 },
+  /* 1007 */ {     0,   57,32884,   58,   57,   57,   70,32885,   57,   57,
+                 119,32885,   67,   57,   57,    0,    0,   57,   57,   57,
+                  57,   57,   57,   57,   57,   57,   57,   57 },
+  /* 1008 */ {     0,    0,    0,    0,    0,    0,   76,32803,    0,    0,
+                 126,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+  /* 1009 */ {     0,    0,32884,    0,    0,    0,   96,32885,33778,33778,
+                 154,32885,    0,33778,33778,    0,    0,33778,33778,33778,
+               33778,33778,33778,33778,33778,33778,33778,33778 },
+  /* 1010 */ {     0,    0,32884,    0,    0,    0,   96,32885,    0,    0,
+                 154,32885,    0,    0,    0,    0,    0,    0,    0,    0,
+                   0,    0,    0,    0,    0,    0,    0,    0 },
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/* vim:set et sw=2 ts=2: */
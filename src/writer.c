@@ -0,0 +1,455 @@
+/*
+**      wrap -- text reformatter
+**      src/writer.c
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ * Defines functions for batching output into large writes.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+#define W_WRITER_H_INLINE _GL_EXTERN_INLINE
+#include "writer.h"
+#include "common.h"
+#include "reader.h"
+#include "ring.h"
+#include "util.h"
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <assert.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>                     /* for exit(3) */
+#include <string.h>                     /* for memcpy(3) */
+#include <sysexits.h>
+#include <unistd.h>                     /* for isatty(3) */
+
+/// @endcond
+
+/**
+ * @addtogroup writer-group
+ * @{
+ */
+
+#ifdef WITH_RING
+/**
+ * Write-behind thread for a \ref writer.
+ */
+struct writer_thread {
+  ring_t    ring;                       ///< Buffers being handed off.
+  pthread_t tid;                        ///< Thread ID.
+  int       fd;                         ///< File descriptor to write to.
+  /// `errno` of failed write, if any: written by the thread while the main
+  /// thread may be checking it.
+  _Atomic int error;
+};
+typedef struct writer_thread writer_thread_t;
+
+static_assert( RING_SLOT_SIZE == WRITER_BUF_SIZE, "slot must be a buffer" );
+#endif /* WITH_RING */
+
+// local functions
+_Noreturn
+static void writer_done( writer_t* );
+
+static void writer_handed( writer_t*, char const*, size_t );
+
+NODISCARD
+static bool writer_limit( writer_t const*, char const*, size_t* );
+
+static void writer_out( writer_t*, char const*, size_t );
+
+#ifdef WITH_RING
+static void writer_check( writer_t* );
+
+static void* writer_thread_main( void* );
+#endif /* WITH_RING */
+
+////////// local functions ////////////////////////////////////////////////////
+
+/**
+ * Waits for the last output of \a w allowed by writer_limit_lines() to have
+ * been written, then exits.
+ *
+ * @param w The \ref writer that has reached its limit.
+ */
+static void writer_done( writer_t *w ) {
+  writer_flush( w );
+  exit( EX_OK );
+}
+
+/**
+ * Notes that \a len characters of \a s have been handed off, including for
+ * profile_mark().
+ *
+ * @param w The \ref writer that handed them off.
+ * @param s The characters.
+ * @param len The number of characters.
+ */
+static void writer_handed( writer_t *w, char const *s, size_t len ) {
+  w->written += len;
+  profile_mark( PROFILE_FIRST_OUT );
+  profile_mark( PROFILE_LAST_OUT );
+  if ( unlikely( w->count_lines ) ) {
+    for ( char const *const end = s + len;
+          (s = memchr( s, '\n', STATIC_CAST( size_t, end - s ) )) != NULL;
+          ++s ) {
+      ++w->lines;
+    } // for
+  }
+}
+
+/**
+ * If \a w's output is limited by writer_limit_lines(), shortens \a s so that
+ * it doesn't go past the limit.
+ *
+ * @param w The \ref writer to check the limit of.
+ * @param s The characters about to be handed off.
+ * @param plen A pointer to the number of characters of \a s that's set to the
+ * number that may be.
+ * @return Returns `true` only if handing off \a s reaches the limit.
+ */
+static bool writer_limit( writer_t const *w, char const *s, size_t *plen ) {
+  if ( likely( w->lines_max == 0 ) )
+    return false;
+  if ( w->lines >= w->lines_max ) {     // reached already: discard the rest
+    *plen = 0;
+    return false;
+  }
+  uint64_t left = w->lines_max - w->lines;
+  char const *const end = s + *plen;
+  for ( char const *nl = s;
+        (nl = memchr( nl, '\n', STATIC_CAST( size_t, end - nl ) )) != NULL; ) {
+    if ( --left == 0 ) {
+      *plen = STATIC_CAST( size_t, nl + 1 - s );
+      return true;
+    }
+    ++nl;
+  } // for
+  return false;
+}
+
+/**
+ * Writes \a len characters of \a s to \a w's file or hands them to \a w's
+ * function.
+ *
+ * @param w The \ref writer to write for.
+ * @param s The characters to write.
+ * @param len The number of characters to write.
+ */
+static void writer_out( writer_t *w, char const *s, size_t len ) {
+  if ( unlikely( w->expand_buf != NULL ) )
+    s = tabs_expand( s, &len, &w->expand_col, w->expand_buf );
+  bool const is_done = writer_limit( w, s, &len );
+  writer_handed( w, s, len );
+  if ( w->fn != NULL )
+    (*w->fn)( s, len, w->fn_data );
+  else
+    write_all( fileno( w->file ), s, len );
+  if ( unlikely( is_done ) )
+    writer_done( w );
+}
+
+#ifdef WITH_RING
+/**
+ * Checks whether \a w's write-behind thread failed to write and, if so,
+ * prints an error message and exits.
+ *
+ * @param w The \ref writer to check.
+ */
+static void writer_check( writer_t *w ) {
+  int const error =
+    atomic_load_explicit( &w->thread->error, memory_order_acquire );
+  if ( unlikely( error != 0 ) ) {
+    errno = error;
+    w->buf = NULL;                      // so writer_cleanup() does nothing
+    perror_exit( EX_IOERR );
+  }
+}
+
+/**
+ * The main function of a \ref writer_thread: writes each buffer handed off
+ * until an empty one is received.
+ *
+ * @param arg A pointer to the \ref writer_thread.
+ * @return Always returns NULL.
+ */
+static void* writer_thread_main( void *arg ) {
+  writer_thread_t *const t = arg;
+  for (;;) {
+    size_t len;
+    char const *const buf = ring_acquire_full( &t->ring, &len );
+    if ( len == 0 ) {
+      ring_consume( &t->ring );
+      return NULL;
+    }
+    // After an error, discard the rest.
+    if ( atomic_load_explicit( &t->error, memory_order_relaxed ) == 0 ) {
+      atomic_store_explicit(
+        &t->error, fd_write( t->fd, buf, len ), memory_order_release
+      );
+    }
+    ring_consume( &t->ring );
+  } // for
+}
+#endif /* WITH_RING */
+
+////////// extern functions ///////////////////////////////////////////////////
+
+void writer_async( writer_t *w ) {
+  assert( w != NULL );
+#ifdef WITH_RING
+  if ( w->is_tty || w->thread != NULL || w->fn != NULL ||
+       w->expand_buf != NULL ) {
+    return;
+  }
+  writer_thread_t *const t = MALLOC( writer_thread_t, 1 );
+  if ( !ring_init( &t->ring ) ) {
+    FREE( t );
+    return;
+  }
+  t->fd = fileno( w->file );
+  atomic_init( &t->error, 0 );
+  if ( pthread_create( &t->tid, /*attr=*/NULL, &writer_thread_main, t ) != 0 ) {
+    ring_cleanup( &t->ring );
+    FREE( t );
+    return;
+  }
+
+  //
+  // From now on, the buffer is always one of the ring's slots.
+  //
+  char *const buf = ring_acquire_empty( &t->ring );
+  memcpy( buf, w->buf, w->len );
+  FREE( w->buf );
+  w->buf = buf;
+  w->thread = t;
+#endif /* WITH_RING */
+}
+
+size_t writer_copy( writer_t *w, FILE *ffrom ) {
+  assert( w != NULL );
+  assert( w->file != NULL );
+  assert( ffrom != NULL );
+  if ( w->lines_max == 0 && w->expand_buf == NULL ) {
+    writer_flush( w );
+    return fcopy( ffrom, w->file );
+  }
+  size_t copied = 0;
+  for ( size_t size; ; copied += size ) {
+    char const *const s = reader_getline( ffrom, READER_BUF_SIZE, &size );
+    if ( s == NULL )
+      break;
+    writer_write( w, s, size );
+  } // for
+  FERROR( ffrom );
+  return copied;
+}
+
+void writer_cleanup( writer_t *w ) {
+  assert( w != NULL );
+  if ( w->buf == NULL )
+    return;
+  writer_flush( w );
+  if ( w->expand_buf != NULL ) {
+    line_buf_cleanup( w->expand_buf );
+    FREE( w->expand_buf );
+    w->expand_buf = NULL;
+  }
+#ifdef WITH_RING
+  if ( w->thread != NULL ) {
+    ring_produce( &w->thread->ring, 0 );  // tell the thread to stop
+    PJL_DISCARD_RV( pthread_join( w->thread->tid, /*retval=*/NULL ) );
+    ring_cleanup( &w->thread->ring );
+    FREE( w->thread );
+    w->thread = NULL;
+    w->buf = NULL;
+    return;
+  }
+#endif /* WITH_RING */
+  FREE( w->buf );
+  w->buf = NULL;
+}
+
+void writer_expand_tabs( writer_t *w ) {
+  assert( w != NULL );
+  assert( w->thread == NULL );
+  if ( w->expand_buf != NULL )
+    return;
+  w->expand_buf = MALLOC( line_buf_t, 1 );
+  line_buf_init( w->expand_buf );
+  w->expand_col = 0;
+}
+
+void writer_flush( writer_t *w ) {
+  assert( w != NULL );
+  writer_spill( w );
+#ifdef WITH_RING
+  if ( w->thread != NULL ) {
+    ring_wait_empty( &w->thread->ring );
+    writer_check( w );
+  }
+#endif /* WITH_RING */
+}
+
+void writer_init( writer_t *w, FILE *file ) {
+  assert( w != NULL );
+  assert( file != NULL );
+  w->file = file;
+  w->fn = NULL;
+  w->fn_data = NULL;
+  w->buf = MALLOC( char, WRITER_BUF_SIZE );
+  w->len = 0;
+  w->written = 0;
+  w->count_lines = false;
+  w->lines = 0;
+  w->lines_max = 0;
+  w->is_tty = isatty( fileno( file ) ) != 0;
+  w->thread = NULL;
+  w->expand_buf = NULL;
+  w->expand_col = 0;
+}
+
+void writer_init_fn( writer_t *w, writer_fn_t fn, void *data ) {
+  assert( w != NULL );
+  assert( fn != NULL );
+  w->file = NULL;
+  w->fn = fn;
+  w->fn_data = data;
+  w->buf = MALLOC( char, WRITER_BUF_SIZE );
+  w->len = 0;
+  w->written = 0;
+  w->count_lines = false;
+  w->lines = 0;
+  w->lines_max = 0;
+  w->is_tty = false;
+  w->thread = NULL;
+  w->expand_buf = NULL;
+  w->expand_col = 0;
+}
+
+void writer_limit_lines( writer_t *w, uint64_t lines_max ) {
+  assert( w != NULL );
+  w->lines_max = lines_max;
+  if ( lines_max > 0 )
+    w->count_lines = true;
+}
+
+size_t writer_mem( writer_t const *w ) {
+  assert( w != NULL );
+#ifdef WITH_RING
+  if ( w->thread != NULL )
+    return sizeof( writer_thread_t ) + RING_SLOTS * RING_SLOT_SIZE;
+#endif /* WITH_RING */
+  return (w->buf != NULL ? WRITER_BUF_SIZE : 0) +
+    (w->expand_buf != NULL ? w->expand_buf->cap : 0);
+}
+
+void writer_printf( writer_t *w, char const *format, ... ) {
+  assert( w != NULL );
+  assert( format != NULL );
+
+  va_list args;
+  va_start( args, format );
+  int const raw_len = vsnprintf(
+    w->buf + w->len, WRITER_BUF_SIZE - w->len, format, args
+  );
+  va_end( args );
+  PERROR_EXIT_IF( raw_len < 0, EX_IOERR );
+
+  size_t const len = STATIC_CAST( size_t, raw_len );
+  if ( likely( w->len + len < WRITER_BUF_SIZE ) ) {
+    w->len += len;
+    return;
+  }
+
+  //
+  // It didn't fit: spill and format again either directly into the (now
+  // empty) buffer or, if it's too big even for that, a temporary buffer.
+  //
+  if ( len < WRITER_BUF_SIZE ) {
+    writer_spill( w );
+    va_start( args, format );
+    PJL_DISCARD_RV( vsnprintf( w->buf, len + 1, format, args ) );
+    va_end( args );
+    w->len = len;
+    return;
+  }
+  writer_flush( w );
+  char *const s = MALLOC( char, len + 1 );
+  va_start( args, format );
+  PJL_DISCARD_RV( vsnprintf( s, len + 1, format, args ) );
+  va_end( args );
+  writer_out( w, s, len );
+  FREE( s );
+}
+
+void writer_spill( writer_t *w ) {
+  assert( w != NULL );
+  if ( w->len == 0 )
+    return;
+#ifdef WITH_RING
+  if ( w->thread != NULL ) {
+    bool const is_done = writer_limit( w, w->buf, &w->len );
+    if ( unlikely( w->len == 0 ) )      // limit reached already
+      return;
+    writer_handed( w, w->buf, w->len );
+    ring_produce( &w->thread->ring, w->len );
+    w->buf = ring_acquire_empty( &w->thread->ring );
+    w->len = 0;
+    writer_check( w );
+    if ( unlikely( is_done ) )
+      writer_done( w );
+    return;
+  }
+#endif /* WITH_RING */
+  //
+  // Just in case anything was written directly to the FILE, flush it first
+  // so output remains in order.
+  //
+  if ( w->file != NULL )
+    PERROR_EXIT_IF( fflush( w->file ) != 0, EX_IOERR );
+  writer_out( w, w->buf, w->len );
+  w->len = 0;
+}
+
+void writer_write( writer_t *w, char const *s, size_t len ) {
+  assert( w != NULL );
+  assert( s != NULL );
+  if ( w->len + len > WRITER_BUF_SIZE ) {
+    if ( len >= WRITER_BUF_SIZE ) {     // too big to bother buffering
+      writer_flush( w );
+      writer_out( w, s, len );
+      return;
+    }
+    writer_spill( w );
+  }
+  memcpy( w->buf + w->len, s, len );
+  w->len += len;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,274 @@
+/*
+**      wrap -- text reformatter
+**      src/writer.h
+**
+**      Copyright (C) 2024  Paul J. Lucas
+**
+**      This program is free software: you can redistribute it and/or modify
+**      it under the terms of the GNU General Public License as published by
+**      the Free Software Foundation, either version 3 of the License, or
+**      (at your option) any later version.
+**
+**      This program is distributed in the hope that it will be useful,
+**      but WITHOUT ANY WARRANTY; without even the implied warranty of
+**      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**      GNU General Public License for more details.
+**
+**      You should have received a copy of the GNU General Public License
+**      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef wrap_writer_H
+#define wrap_writer_H
+
+/**
+ * @file
+ * Declares a data structure and functions for batching output into large
+ * writes.
+ */
+
+// local
+#include "pjl_config.h"                 /* must go first */
+
+/// @cond DOXYGEN_IGNORE
+
+// standard
+#include <stdbool.h>
+#include <stddef.h>                     /* for size_t */
+#include <stdint.h>                     /* for uint64_t */
+#include <stdio.h>                      /* for FILE */
+#include <string.h>                     /* for memcpy(3), strlen(3) */
+
+/// @endcond
+
+_GL_INLINE_HEADER_BEGIN
+#ifndef W_WRITER_H_INLINE
+# define W_WRITER_H_INLINE _GL_INLINE
+#endif /* W_WRITER_H_INLINE */
+
+/**
+ * @defgroup writer-group Batched Output Writer
+ * A data structure and functions for appending output into one large
+ * contiguous buffer that is written via a single **write**(2) only when it
+ * fills (or is explicitly flushed) rather than making several **stdio**(3)
+ * calls, each checked for errors, per output line.
+ *
+ * @note Output written to a `FILE` via a \ref writer must be flushed via
+ * writer_flush() before writing anything else directly to the same `FILE`.
+ * @{
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define WRITER_BUF_SIZE           (64 * 1024)   /**< Flush threshold. */
+
+/**
+ * The signature for a function that a \ref writer hands its output to rather
+ * than writing it to a file.
+ *
+ * @param s The characters to write.
+ * @param len The number of characters to write.
+ * @param data The data given to writer_init_fn().
+ */
+typedef void (*writer_fn_t)( char const *s, size_t len, void *data );
+
+/**
+ * Batched output writer.
+ */
+struct writer {
+  FILE                 *file;           ///< File to write to, if any.
+  writer_fn_t           fn;             ///< Otherwise, function to call.
+  void                 *fn_data;        ///< Data to pass to \a fn.
+  char                 *buf;            ///< Buffer of #WRITER_BUF_SIZE chars.
+  size_t                len;            ///< Number of characters in \a buf.
+  size_t                written;        ///< Number of characters handed off.
+  bool                  count_lines;    ///< Count lines handed off?
+  uint64_t              lines;          ///< If so, number of newlines.
+  uint64_t              lines_max;      ///< Exit after this many; 0 = none.
+  bool                  is_tty;         ///< Is \a file a terminal?
+  struct writer_thread *thread;         ///< Write-behind thread, if any.
+  struct line_buf      *expand_buf;     ///< If expanding tabs, buffer to use.
+  size_t                expand_col;     ///< If so, column output ends at.
+};
+typedef struct writer writer_t;
+
+////////// extern functions ///////////////////////////////////////////////////
+
+/**
+ * Starts a thread for \a w that does the actual writing so that the calling
+ * thread can continue producing output while the previous buffer is being
+ * written.  If \a w is writing to a terminal or threads aren't supported, does
+ * nothing.
+ *
+ * @param w The \ref writer to start a write-behind thread for.  If it hands
+ * its output to a function, does nothing.
+ */
+void writer_async( writer_t *w );
+
+/**
+ * Copies \a ffrom to \a w until EOF.  Unless \a w's output is limited by
+ * writer_limit_lines(), flushes \a w and copies \a ffrom directly to \a w's
+ * file instead.
+ *
+ * @param w The \ref writer to copy to.  It must write to a file.
+ * @param ffrom The `FILE` to copy from.
+ * @return Returns the number of bytes copied.
+ */
+size_t writer_copy( writer_t *w, FILE *ffrom );
+
+/**
+ * Flushes and frees all memory used by \a w.
+ *
+ * @param w The \ref writer to clean up.
+ *
+ * @sa writer_init()
+ */
+void writer_cleanup( writer_t *w );
+
+/**
+ * Makes \a w expand tabs to spaces (per tabs_expand()) in all of its output
+ * from now on.  Since the output may then be longer, \a w never gets a
+ * write-behind thread.
+ *
+ * @param w The \ref writer to expand the tabs of.  It must not have a
+ * write-behind thread already.
+ *
+ * @sa writer_async()
+ */
+void writer_expand_tabs( writer_t *w );
+
+/**
+ * Writes any buffered output of \a w to its file (or hands it to its
+ * function) and, if \a w has a write-behind thread, waits for it to have been
+ * written.  If writing fails, prints an error message and exits.
+ *
+ * @param w The \ref writer to flush.
+ */
+void writer_flush( writer_t *w );
+
+/**
+ * Hands off any buffered output of \a w to be written.  Unlike
+ * writer_flush(), if \a w has a write-behind thread, doesn't wait for the
+ * output to have been written.
+ *
+ * @param w The \ref writer to spill.
+ *
+ * @sa writer_async()
+ */
+void writer_spill( writer_t *w );
+
+/**
+ * Initializes \a w.
+ *
+ * @param w The \ref writer to initialize.
+ * @param file The `FILE` to write to eventually.
+ *
+ * @sa writer_cleanup()
+ * @sa writer_init_fn()
+ */
+void writer_init( writer_t *w, FILE *file );
+
+/**
+ * Initializes \a w to hand its output to a function rather than write it to
+ * a file.
+ *
+ * @param w The \ref writer to initialize.
+ * @param fn The function to hand each buffer of output to eventually.
+ * @param data The data to pass to \a fn.
+ *
+ * @sa writer_cleanup()
+ * @sa writer_init()
+ */
+void writer_init_fn( writer_t *w, writer_fn_t fn, void *data );
+
+/**
+ * Limits the output of \a w to \a lines_max lines: once that many have been
+ * written, the rest of the output is discarded and the program exits
+ * successfully immediately rather than continuing to produce output that's
+ * not wanted.
+ *
+ * @param w The \ref writer to limit.
+ * @param lines_max The maximum number of lines to write; 0 = no limit.
+ */
+void writer_limit_lines( writer_t *w, uint64_t lines_max );
+
+/**
+ * Gets the number of bytes of heap memory used by the buffers of \a w,
+ * including those of its write-behind thread, if any.
+ *
+ * @param w The \ref writer to get the memory of.
+ * @return Returns said number of bytes.
+ */
+NODISCARD
+size_t writer_mem( writer_t const *w );
+
+/**
+ * Appends formatted output to \a w.
+ *
+ * @param w The \ref writer to append to.
+ * @param format The `printf()` format string literal to use.
+ * @param ... The `printf()` arguments.
+ */
+PJL_PRINTF_LIKE_FUNC(2)
+void writer_printf( writer_t *w, char const *format, ... );
+
+/**
+ * Appends \a len characters of \a s to \a w's buffer, flushing first if they
+ * don't fit.
+ *
+ * @param w The \ref writer to append to.
+ * @param s The characters to append.
+ * @param len The number of characters to append.
+ */
+void writer_write( writer_t *w, char const *s, size_t len );
+
+/**
+ * Marks the end of an output line: if \a w is writing to a terminal, flushes
+ * it so output appears promptly; otherwise does nothing.
+ *
+ * @param w The \ref writer to use.
+ */
+W_WRITER_H_INLINE
+void writer_eol( writer_t *w ) {
+  if ( w->is_tty )
+    writer_flush( w );
+}
+
+/**
+ * Appends \a c to \a w.
+ *
+ * @param w The \ref writer to append to.
+ * @param c The character to append.
+ */
+W_WRITER_H_INLINE
+void writer_putc( writer_t *w, char c ) {
+  if ( w->len == WRITER_BUF_SIZE )
+    writer_spill( w );
+  w->buf[ w->len++ ] = c;
+}
+
+/**
+ * Appends \a s to \a w.
+ *
+ * @param w The \ref writer to append to.
+ * @param s The null-terminated string to append.
+ */
+W_WRITER_H_INLINE
+void writer_puts( writer_t *w, char const *s ) {
+  size_t const len = strlen( s );
+  if ( w->len + len <= WRITER_BUF_SIZE ) {
+    memcpy( w->buf + w->len, s, len );
+    w->len += len;
+  } else {
+    writer_write( w, s, len );
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/** @} */
+
+_GL_INLINE_HEADER_END
+
+#endif /* wrap_writer_H */
+/* vim:set et sw=2 ts=2: */
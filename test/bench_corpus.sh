@@ -0,0 +1,556 @@
+#! /bin/sh
+##
+#       wrap -- text reformatter
+#       test/bench_corpus.sh
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+##
+# Benchmarks wrap's and wrapc's throughput over synthetic corpora, each
+# generated deterministically (the same bytes every time for a given size) so
+# results can be compared across builds and machines:
+#
+#   prose       Plain prose paragraphs wrapped at 72 columns.
+#   narrow      The same prose wrapped at 20 columns (many more lines out).
+#   uri         Prose dense with URIs and e-mail addresses (never broken at
+#               hyphens).
+#   cjk         CJK text mixed with emoji and Latin words.
+#   md-lists    Markdown with deeply nested lists (wrap -u).
+#   md-code     Markdown with inline code and fenced code blocks (wrap -u).
+#   doxygen-c   C source with Doxygen comments (wrapc -G -x -u).
+#   adv-uri     Adversarial: URI-like tokens thousands of characters long,
+#               some that look like e-mail addresses until their last
+#               character, that a non-linear matcher would rescan.
+#   adv-md-nest Adversarial: Markdown lists and block quotes nested dozens of
+#               levels deep (wrap -u).
+#
+# The adversarial corpora are cases for which wrap_fuzz checks that the engine
+# stays linear; a regression in them likely means it no longer does.
+#
+# For each, prints one tab-separated line of: the corpus name, its size in
+# bytes and lines, the median of a number of runs in seconds and their median
+# absolute deviation (MAD), MB/s and lines/s derived from the median, and the
+# peak resident set size in KB as reported by time(1) or, if no time(1) reports
+# it, by --stats.  The first line is a header.
+#
+# With -e, benchmarks the given engine (see WRAP_ENGINE in wrap(1)) rather than
+# the default so engines can be compared on the same binary.  Likewise, with
+# -H, benchmarks with huge pages (see WRAP_HUGE_PAGES in wrap(1)) so their
+# effect can be measured.
+#
+# With -o, also writes the results to a baseline file in JSON.  With -c,
+# compares the results against such a baseline, adds columns of the baseline's
+# median, the change, the baseline's peak RSS, its change, and "ok",
+# "REGRESSION", or "MEM-REGRESSION", and exits with status 3 if any corpus
+# regressed.  A corpus regressed only if its median is slower than the
+# baseline's by more than the threshold (-t) and by more than three times the
+# two MADs combined, so noise alone doesn't fail it.  Since peak RSS barely
+# varies between runs, a corpus also regressed if it's larger than the
+# baseline's by more than the threshold.
+##
+
+# Uncomment the following line for shell tracing.
+#set -x
+
+########## Functions ##########################################################
+
+local_basename() {
+  ##
+  # Autoconf, 11.15:
+  #
+  # basename
+  #   Not all hosts have a working basename. You can use expr instead.
+  ##
+  expr "//$1" : '.*/\(.*\)'
+}
+
+##
+# Prints the current time in nanoseconds, or, if date(1) doesn't support %N,
+# in seconds multiplied out to nanoseconds.
+##
+now_ns() {
+  NOW=`date +%s%N`
+  case $NOW in
+  *N) expr "$NOW" : '\(.*\)N' \* 1000000000 ;;
+  *)  echo $NOW ;;
+  esac
+}
+
+##
+# Generates a corpus of about $SIZE_MB megabytes to standard output.  Every
+# corpus uses the same linear congruential generator (exact in double
+# arithmetic) and counts bytes, not characters, so any awk generates the same
+# bytes.  The narrow corpus is the same as the prose corpus.
+##
+generate() {
+  KIND=$1
+  [ $KIND = narrow ] && KIND=prose
+  LC_ALL=C awk -v kind="$KIND" -v size=`expr $SIZE_MB \* 1048576` '
+  function rnd( n ) {
+    seed = (seed * 69069 + 1) % 4294967296
+    return int( seed / 4294967296 * n )
+  }
+  function word() {
+    return WORDS[ rnd( WORDS_LEN ) + 1 ]
+  }
+  function sentence(    n, s, i ) {
+    n = 5 + rnd( 15 )
+    s = word()
+    s = toupper( substr( s, 1, 1 ) ) substr( s, 2 )
+    for ( i = 2; i <= n; ++i ) {
+      if ( kind == "uri" && rnd( 4 ) == 0 )
+        s = s " " URIS[ rnd( URIS_LEN ) + 1 ]
+      else if ( kind == "md-code" && rnd( 10 ) == 0 )
+        s = s " `" word() "()`"
+      else
+        s = s " " word()
+    }
+    return s "."
+  }
+  function paragraph(    n, s, i ) {
+    n = 2 + rnd( 6 )
+    s = sentence()
+    for ( i = 2; i <= n; ++i )
+      s = s " " sentence()
+    return s
+  }
+  function cjk_line(    n, s, i ) {
+    n = 10 + rnd( 60 )
+    s = ""
+    for ( i = 1; i <= n; ++i ) {
+      if ( rnd( 12 ) == 0 )
+        s = s " " word() " "
+      else if ( rnd( 20 ) == 0 )
+        s = s EMOJI[ rnd( EMOJI_LEN ) + 1 ]
+      else
+        s = s CJK[ rnd( CJK_LEN ) + 1 ]
+    }
+    return s
+  }
+  function long_uri(    n, s ) {
+    n = 1000 + rnd( 4000 )
+    s = "https://example.com/"
+    while ( length( s ) < n )
+      s = s URI_PARTS[ rnd( URI_PARTS_LEN ) + 1 ]
+    return s
+  }
+  function near_email(    n, s ) {
+    n = 1000 + rnd( 4000 )
+    s = ""
+    while ( length( s ) < n )
+      s = s "a-"
+    return s "@-"
+  }
+  function out( s ) {
+    print s
+    bytes += length( s ) + 1
+  }
+  BEGIN {
+    seed = 42
+    WORDS_LEN = split( "a an the of to in is it that for on with as was at " \
+      "by be this from or are which text line width paragraph wrap filter " \
+      "reformat column margin hyphen sentence word space indent tab comment " \
+      "document character output input option file lead hang mirror " \
+      "justify optimal balance configuration alias pattern expression", WORDS )
+    URIS_LEN = split( "https://example.com/a-b-c " \
+      "http://www.example.org/path/to-some/page?q=x-y#frag-1 " \
+      "ftp://ftp.example.net/pub/file-1.2.tar.gz " \
+      "mailto:first-last@example.com user.name-1@sub-domain.example.co.uk " \
+      "file:///usr/local/share/doc/wrap-1.0/README", URIS )
+    CJK_LEN = split( "日 本 語 の 文 章 を 折 り 返 す 中 文 字 符 한 국 어 " \
+      "テ キ ス ト 段 落 、 。 「 」", CJK )
+    EMOJI_LEN = split( "😀 🎉 👍 🚀 ❤️ 👩‍💻 🇯🇵", EMOJI )
+    URI_PARTS_LEN = split( "a-b/ x.y? q=1& %2F www. user@ ~z/ #f-", URI_PARTS )
+
+    while ( bytes < size ) {
+      if ( kind == "prose" || kind == "uri" ) {
+        out( paragraph() )
+        out( "" )
+      }
+      else if ( kind == "cjk" ) {
+        out( cjk_line() )
+        if ( rnd( 4 ) == 0 )
+          out( "" )
+      }
+      else if ( kind == "md-lists" ) {
+        out( "# " word() " " word() )
+        out( "" )
+        depth = 0
+        n = 5 + rnd( 20 )
+        for ( i = 0; i < n; ++i ) {
+          depth += rnd( 3 ) - 1
+          if ( depth < 0 ) depth = 0
+          if ( depth > 7 ) depth = 7
+          indent = ""
+          for ( j = 0; j < depth; ++j )
+            indent = indent "    "
+          marker = rnd( 2 ) ? "*" : ( (i + 1) "." )
+          out( indent marker " " paragraph() )
+          out( "" )
+        }
+      }
+      else if ( kind == "md-code" ) {
+        out( "## " word() " " word() )
+        out( "" )
+        out( paragraph() )
+        out( "" )
+        out( "```c" )
+        n = 3 + rnd( 10 )
+        for ( i = 0; i < n; ++i )
+          out( "    " word() "_" word() "( " word() ", " rnd( 100 ) " );" )
+        out( "```" )
+        out( "" )
+      }
+      else if ( kind == "adv-uri" ) {
+        out( sentence() " " long_uri() " " sentence() )
+        out( "" )
+        out( sentence() " " near_email() " " sentence() )
+        out( "" )
+      }
+      else if ( kind == "adv-md-nest" ) {
+        n = 10 + rnd( 50 )
+        for ( i = 0; i < n; ++i ) {
+          indent = ""
+          for ( j = 0; j < i; ++j )
+            indent = indent "  "
+          out( indent "* " sentence() )
+        }
+        out( "" )
+        s = ""
+        n = 10 + rnd( 50 )
+        for ( i = 0; i < n; ++i )
+          s = s "> "
+        out( s paragraph() )
+        out( "" )
+      }
+      else if ( kind == "doxygen-c" ) {
+        out( "/**" )
+        out( " * " paragraph() )
+        out( " *" )
+        n = 1 + rnd( 4 )
+        for ( i = 0; i < n; ++i )
+          out( " * @param " word() "_" i " " sentence() " " sentence() )
+        out( " * @return Returns " sentence() )
+        out( " */" )
+        out( "int " word() "_" word() "( int a, int b );" )
+        out( "" )
+      }
+    }
+  }'
+}
+
+##
+# Prints the median and median absolute deviation of the integers given as
+# arguments.
+##
+median_mad() {
+  echo "$@" | awk '
+  function median( a, n,    i, j, t ) {
+    for ( i = 2; i <= n; ++i )          # insertion sort: n is small
+      for ( j = i; j > 1 && a[j-1] > a[j]; --j ) {
+        t = a[j]; a[j] = a[j-1]; a[j-1] = t
+      }
+    return n % 2 ? a[ (n + 1) / 2 ] : (a[ n / 2 ] + a[ n / 2 + 1 ]) / 2
+  }
+  {
+    for ( i = 1; i <= NF; ++i )
+      x[i] = $i
+    m = median( x, NF )
+    for ( i = 1; i <= NF; ++i )
+      d[i] = $i > m ? $i - m : m - $i
+    printf "%.0f %.0f\n", m, median( d, NF )
+  }'
+}
+
+##
+# Prints the baseline median and MAD in nanoseconds and the peak RSS in KB (0
+# if it wasn't measured) for a corpus from a baseline file written by -o, or
+# nothing if it has none.  This isn't a general JSON parser: it relies on each
+# corpus being on a line by itself as written.
+##
+baseline_for() {
+  awk -v name="$1" '
+  $1 == "\"" name "\":" {
+    gsub( /[^0-9]+/, " " )
+    print $1, $2, ($3 == "" ? 0 : $3)
+  }' "$BASELINE"
+}
+
+##
+# Prints the fixed command benchmarked for a corpus.
+##
+command_for() {
+  case $1 in
+  prose)      echo wrap -c /dev/null -w 72 ;;
+  narrow)     echo wrap -c /dev/null -w 20 ;;
+  uri)        echo wrap -c /dev/null -w 60 ;;
+  cjk)        echo wrap -c /dev/null -w 40 ;;
+  md-lists)   echo wrap -c /dev/null -u -w 60 ;;
+  md-code)    echo wrap -c /dev/null -u ;;
+  doxygen-c)  echo wrapc -c /dev/null -G -x -u ;;
+  adv-uri)    echo wrap -c /dev/null -w 60 ;;
+  adv-md-nest) echo wrap -c /dev/null -u ;;
+  esac
+}
+
+##
+# Prints the peak resident set size in KB of a run of $COMMAND over $CORPUS, or
+# "-" if it can't be measured.
+##
+peak_rss_kb() {
+  case $TIME_KIND in
+  gnu)
+    /usr/bin/time -f %M -o $RSS $COMMAND < $CORPUS > /dev/null 2>&1 &&
+      tail -n 1 $RSS
+    ;;
+  bsd)
+    ##
+    # BSD time(1) reports in KB, but macOS's reports in bytes.
+    ##
+    /usr/bin/time -l $COMMAND < $CORPUS > /dev/null 2> $RSS
+    awk -v darwin=$DARWIN '/maximum resident set size/ {
+      print darwin ? int( $1 / 1024 ) : $1
+    }' $RSS
+    ;;
+  *)
+    $COMMAND --stats < $CORPUS 2>&1 > /dev/null |
+      sed -n 's/.* peak_rss_kb=\([0-9]*\).*/\1/p'
+    ;;
+  esac
+}
+
+usage() {
+  [ "$1" ] && { echo "$ME: $*" >&2; usage; }
+  cat >&2 <<END
+usage: $ME [options] [corpus ...]
+options:
+  -c file     Compare against the baseline in file.
+  -e engine   Engine to benchmark (sets WRAP_ENGINE) [default: auto].
+  -H pages    Huge pages: no, yes, or explicit (sets WRAP_HUGE_PAGES) [default: no].
+  -n runs     Runs per corpus, of which the median is reported [default: $RUNS].
+  -o file     Write the results as a baseline to file.
+  -s size     Size of each corpus in MB [default: $SIZE_MB].
+  -t percent  Regression threshold for -c [default: $THRESHOLD].
+corpora: $CORPORA
+END
+  exit 1
+}
+
+########## Begin ##############################################################
+
+ME=`local_basename "$0"`
+
+[ "$BUILD_SRC" ] || {
+  echo "$ME: \$BUILD_SRC not set" >&2
+  exit 2
+}
+
+########## Process command-line ###############################################
+
+CORPORA="prose narrow uri cjk md-lists md-code doxygen-c adv-uri adv-md-nest"
+BASELINE=
+ENGINE=auto
+HUGE_PAGES=no
+OUTPUT=
+RUNS=5
+SIZE_MB=8
+THRESHOLD=10
+
+while getopts c:e:H:n:o:s:t: opt
+do
+  case $opt in
+  c) BASELINE=$OPTARG ;;
+  e) ENGINE=$OPTARG ;;
+  H) HUGE_PAGES=$OPTARG ;;
+  n) RUNS=$OPTARG ;;
+  o) OUTPUT=$OPTARG ;;
+  s) SIZE_MB=$OPTARG ;;
+  t) THRESHOLD=$OPTARG ;;
+  ?) usage ;;
+  esac
+done
+shift `expr $OPTIND - 1`
+
+case $ENGINE in
+auto|reference|fast|span|simd) ;;
+*) usage "\"$ENGINE\": invalid -e" ;;
+esac
+case $HUGE_PAGES in
+no|yes|explicit) ;;
+*) usage "\"$HUGE_PAGES\": invalid -H" ;;
+esac
+expr "$RUNS" : '[1-9][0-9]*$' > /dev/null || usage "\"$RUNS\": invalid -n"
+expr "$SIZE_MB" : '[1-9][0-9]*$' > /dev/null || usage "\"$SIZE_MB\": invalid -s"
+expr "$THRESHOLD" : '[0-9][0-9]*$' > /dev/null ||
+  usage "\"$THRESHOLD\": invalid -t"
+
+if [ "$BASELINE" ]
+then
+  [ -r "$BASELINE" ] || { echo "$ME: \"$BASELINE\": can not read" >&2; exit 2; }
+  BASELINE_MB=`sed -n 's/^ *"size_mb": *\([0-9]*\).*/\1/p' "$BASELINE"`
+  [ "$BASELINE_MB" = "$SIZE_MB" ] || {
+    echo "$ME: \"$BASELINE\": baseline is for -s ${BASELINE_MB:-?}, not $SIZE_MB" >&2
+    exit 2
+  }
+fi
+
+for NAME in "$@"
+do
+  case " $CORPORA " in
+  *" $NAME "*) ;;
+  *) usage "\"$NAME\": unknown corpus" ;;
+  esac
+done
+[ $# -gt 0 ] && CORPORA="$*"
+
+########## Initialize #########################################################
+
+CORPUS=/tmp/wrap_bench_corpus_$$_
+JSON=/tmp/wrap_bench_json_$$_
+RSS=/tmp/wrap_bench_rss_$$_
+
+##
+# Must put BUILD_SRC first in PATH so we get the correct versions of wrap and
+# wrapc.
+##
+PATH=$BUILD_SRC:$PATH
+export PATH
+
+WRAP_ENGINE=$ENGINE
+export WRAP_ENGINE
+WRAP_HUGE_PAGES=$HUGE_PAGES
+export WRAP_HUGE_PAGES
+
+unset WRAP_DEBUG WRAPC_DEBUG WRAPC_DEBUG_RSRW WRAPC_DEBUG_RW
+
+trap 'x=$?; rm -f $CORPUS $JSON $RSS 2>/dev/null; exit $x' EXIT HUP INT TERM
+
+DARWIN=0
+[ "`uname`" = Darwin ] && DARWIN=1
+if /usr/bin/time -f %M -o $RSS true 2>/dev/null
+then TIME_KIND=gnu
+elif /usr/bin/time -l true 2>/dev/null
+then TIME_KIND=bsd
+else TIME_KIND=none
+fi
+
+########## Benchmark ##########################################################
+
+HEADER="corpus\tbytes\tlines\tsecs\tmad_secs\tMB/s\tlines/s\tpeak_rss_kb"
+[ "$BASELINE" ] &&
+  HEADER="$HEADER\tbaseline_secs\tchange\tbaseline_rss_kb\trss_change\tstatus"
+printf "$HEADER\n"
+
+REGRESSIONS=0
+SEP=
+
+for NAME in $CORPORA
+do
+  generate $NAME > $CORPUS
+  COMMAND=`command_for $NAME`
+  BYTES=`wc -c < $CORPUS`
+  LINES=`wc -l < $CORPUS`
+
+  ALL_NS=
+  I=0
+  while [ $I -lt $RUNS ]
+  do
+    START=`now_ns`
+    $COMMAND < $CORPUS > /dev/null || {
+      echo "$ME: $NAME: failed" >&2
+      exit 1
+    }
+    END=`now_ns`
+    ALL_NS="$ALL_NS `expr $END - $START`"
+    I=`expr $I + 1`
+  done
+  set -- `median_mad $ALL_NS`
+  MEDIAN_NS=$1 MAD_NS=$2
+
+  RSS_KB=`peak_rss_kb` RSS_JSON=0
+  case $RSS_KB in
+  ''|*[!0-9]*) RSS_KB=- ;;
+  *)           RSS_JSON=$RSS_KB ;;
+  esac
+  BASE=
+  [ "$BASELINE" ] && BASE=`baseline_for $NAME`
+  LINE=`awk -v name=$NAME -v bytes=$BYTES -v lines=$LINES -v ns=$MEDIAN_NS \
+      -v mad=$MAD_NS -v rss="$RSS_KB" -v base="$BASE" \
+      -v compare="$BASELINE" -v threshold=$THRESHOLD 'BEGIN {
+    s = ns / 1e9
+    printf "%s\t%d\t%d\t%.6f\t%.6f\t%.2f\t%.0f\t%s", name, bytes, lines, s,
+      mad / 1e9, (s > 0 ? bytes / 1048576 / s : 0), (s > 0 ? lines / s : 0), rss
+    if ( compare != "" ) {
+      if ( split( base, b, " " ) < 2 || b[1] == 0 ) {
+        printf "\t-\t-\t-\t-\tnew"
+      } else {
+        change = (ns - b[1]) / b[1] * 100
+        status = "ok"
+        if ( change > threshold && ns - b[1] > 3 * (mad + b[2]) )
+          status = "REGRESSION"
+        printf "\t%.6f\t%+.1f%%", b[1] / 1e9, change
+        if ( b[3] > 0 && rss ~ /^[0-9]+$/ ) {
+          rss_change = (rss - b[3]) / b[3] * 100
+          if ( rss_change > threshold && status == "ok" )
+            status = "MEM-REGRESSION"
+          printf "\t%d\t%+.1f%%", b[3], rss_change
+        } else {
+          printf "\t-\t-"
+        }
+        printf "\t%s", status
+      }
+    }
+    printf "\n"
+  }'`
+  printf "%s\n" "$LINE"
+  case $LINE in
+  *REGRESSION) REGRESSIONS=`expr $REGRESSIONS + 1` ;;
+  esac
+
+  printf '%s    "%s": { "median_ns": %s, "mad_ns": %s, "peak_rss_kb": %s }' \
+    "$SEP" $NAME $MEDIAN_NS $MAD_NS $RSS_JSON >> $JSON
+  SEP=",
+"
+done
+
+if [ "$OUTPUT" ]
+then
+  {
+    echo '{'
+    echo '  "version": 1,'
+    echo "  \"wrap\": \"`wrap -v 2>&1 | head -n 1`\","
+    echo "  \"engine\": \"$ENGINE\","
+    echo "  \"huge_pages\": \"$HUGE_PAGES\","
+    echo "  \"size_mb\": $SIZE_MB,"
+    echo "  \"runs\": $RUNS,"
+    echo '  "corpora": {'
+    cat $JSON
+    echo
+    echo '  }'
+    echo '}'
+  } > "$OUTPUT"
+fi
+
+if [ $REGRESSIONS -gt 0 ]
+then
+  echo "$ME: corpora regressed by more than $THRESHOLD%: $REGRESSIONS" >&2
+  exit 3
+fi
+
+exit 0
+
+# vim:set et sw=2 ts=2:
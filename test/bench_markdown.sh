@@ -0,0 +1,208 @@
+#! /bin/sh
+##
+#       wrap -- text reformatter
+#       test/bench_markdown.sh
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+##
+# Benchmarks wrap's Markdown mode (-u):
+#
+#  1. Checks that the output of every Markdown test is still that of its file
+#     in the expected directory so a speedup can't silently change output.
+#
+#  2. Times "wrap -u" over a corpus made from every Markdown test input plus
+#     README.md repeated a number of times, then over each additional file
+#     given (e.g., the CommonMark specification's spec.txt or large, real-world
+#     READMEs), and reports lines per second for each.
+##
+
+# Uncomment the following line for shell tracing.
+#set -x
+
+########## Functions ##########################################################
+
+local_basename() {
+  ##
+  # Autoconf, 11.15:
+  #
+  # basename
+  #   Not all hosts have a working basename. You can use expr instead.
+  ##
+  expr "//$1" : '.*/\(.*\)'
+}
+
+##
+# Prints the current time in nanoseconds, or, if date(1) doesn't support %N,
+# in seconds multiplied out to nanoseconds.
+##
+now_ns() {
+  NOW=`date +%s%N`
+  case $NOW in
+  *N) expr "$NOW" : '\(.*\)N' \* 1000000000 ;;
+  *)  echo $NOW ;;
+  esac
+}
+
+##
+# Times wrap -u over a file and prints its number of lines, the time taken,
+# and lines per second.
+##
+time_file() {
+  FILE=$1; NAME=$2
+  LINES=`wc -l < "$FILE"`
+  START=`now_ns`
+  wrap -c /dev/null -u $OPTIONS -f "$FILE" -o /dev/null || {
+    echo "$ME: $NAME: wrap failed" >&2
+    exit 1
+  }
+  END=`now_ns`
+  awk -v name="$NAME" -v lines=$LINES -v ns=`expr $END - $START` 'BEGIN {
+    s = ns / 1e9
+    printf "%-24s %10d lines %9.3f s", name, lines, s
+    if ( s > 0 )
+      printf " %12.0f lines/s", lines / s
+    printf "\n"
+  }'
+}
+
+usage() {
+  [ "$1" ] && { echo "$ME: $*" >&2; usage; }
+  cat >&2 <<END
+usage: $ME [options] [file ...]
+options:
+  -n repeat   Times to repeat the built-in corpus [default: $REPEAT].
+  -o options  Additional wrap options [default: none].
+END
+  exit 1
+}
+
+########## Begin ##############################################################
+
+ME=`local_basename "$0"`
+
+[ "$BUILD_SRC" ] || {
+  echo "$ME: \$BUILD_SRC not set" >&2
+  exit 2
+}
+
+########## Process command-line ###############################################
+
+OPTIONS=
+REPEAT=2000
+
+while getopts n:o: opt
+do
+  case $opt in
+  n) REPEAT=$OPTARG ;;
+  o) OPTIONS=$OPTARG ;;
+  ?) usage ;;
+  esac
+done
+shift `expr $OPTIND - 1`
+
+expr "$REPEAT" : '[1-9][0-9]*$' > /dev/null || usage "\"$REPEAT\": invalid -n"
+
+########## Initialize #########################################################
+
+##
+# The automake framework sets $srcdir. If it's empty, it means this script was
+# called by hand, so set it ourselves.
+##
+[ "$srcdir" ] || srcdir="."
+
+DATA_DIR=$srcdir/data
+EXPECTED_DIR=$srcdir/expected
+TESTS_DIR=$srcdir/tests
+CORPUS=/tmp/wrap_bench_corpus_$$_
+INPUTS=/tmp/wrap_bench_inputs_$$_
+OUTPUT=/tmp/wrap_bench_output_$$_
+
+##
+# Must put BUILD_SRC first in PATH so we get the correct version of wrap.
+##
+PATH=$BUILD_SRC:$PATH
+
+unset WRAP_DEBUG
+
+trap 'x=$?; rm -f $CORPUS $INPUTS $OUTPUT 2>/dev/null; exit $x' \
+  EXIT HUP INT TERM
+
+########## Check output stability #############################################
+
+FAILED=0
+PASSED=0
+: > $INPUTS
+
+for TEST in $TESTS_DIR/wrap--Markdown-*.test
+do
+  [ "$IFS" ] && IFS_old=$IFS
+  IFS='|'; read COMMAND CONFIG TEST_OPTIONS INPUT EXPECTED_EXIT < $TEST
+  [ "$IFS_old" ] && IFS=$IFS_old
+
+  EXPECTED_EXIT=`echo $EXPECTED_EXIT`   # trims whitespace
+  [ 0 -eq $EXPECTED_EXIT ] || continue
+
+  COMMAND=`echo $COMMAND`               # trims whitespace
+  CONFIG=`echo $CONFIG`                 # trims whitespace
+  [ "$CONFIG" != /dev/null ] && CONFIG=$DATA_DIR/$CONFIG
+  INPUT=$DATA_DIR/`echo $INPUT`         # trims whitespace
+  TEST_NAME=`local_basename "$TEST"`
+  case $TEST in
+  *crlf*) EXT=crlf ;;
+  *)      EXT=txt ;;
+  esac
+  EXPECTED_OUTPUT="$EXPECTED_DIR/`echo $TEST_NAME | sed s/test$/$EXT/`"
+
+  if $COMMAND -c $CONFIG $TEST_OPTIONS -f $INPUT -o $OUTPUT 2>/dev/null &&
+     cmp -s $EXPECTED_OUTPUT $OUTPUT
+  then
+    PASSED=`expr $PASSED + 1`
+  else
+    echo "$ME: $TEST_NAME: output differs from expected" >&2
+    FAILED=`expr $FAILED + 1`
+  fi
+  echo $INPUT >> $INPUTS
+done
+
+echo "stability: $PASSED passed, $FAILED failed"
+
+########## Time throughput ####################################################
+
+##
+# Each test input is included once even if several tests use it.
+##
+for INPUT in `sort -u $INPUTS` $srcdir/../README.md
+do cat $INPUT
+done > $OUTPUT
+
+: > $CORPUS
+I=0
+while [ $I -lt $REPEAT ]
+do
+  cat $OUTPUT >> $CORPUS
+  I=`expr $I + 1`
+done
+
+time_file $CORPUS "corpus x $REPEAT"
+for FILE in "$@"
+do time_file "$FILE" "`local_basename "$FILE"`"
+done
+
+[ $FAILED -eq 0 ]
+
+# vim:set et sw=2 ts=2:
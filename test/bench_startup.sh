@@ -0,0 +1,232 @@
+#! /bin/sh
+##
+#       wrap -- text reformatter
+#       test/bench_startup.sh
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+##
+# Benchmarks the start-up latency of wrap and wrapc by running each of them
+# many times on an empty or one-line input, as an editor would, and breaks down
+# where the time goes per run:
+#
+#  + exec: the time to run /bin/true the same way, i.e., the cost of the shell
+#    forking and exec'ing any dynamically linked program.
+#
+#  + link/exit: the rest of the time not spent in main(), i.e., loading and
+#    dynamically linking wrap's additional libraries and exiting.
+#
+#  + The time spent in each phase of start-up within main() as reported via
+#    the WRAP_STARTUP_STATS environment variable: options, conf (read_conf()),
+#    locale (setlocale_utf8()), regex (regex_compile()), markdown
+#    (markdown_init()), init (all other initialization), and run (reading,
+#    wrapping, and writing).  For wrapc, these are summed over its processes
+#    that run concurrently, so link/exit isn't reported for it.
+#
+# If a budget is given, exits with status 1 if the mean time per run of any
+# case exceeds it.
+##
+
+# Uncomment the following line for shell tracing.
+#set -x
+
+########## Functions ##########################################################
+
+local_basename() {
+  ##
+  # Autoconf, 11.15:
+  #
+  # basename
+  #   Not all hosts have a working basename. You can use expr instead.
+  ##
+  expr "//$1" : '.*/\(.*\)'
+}
+
+##
+# Prints the current time in nanoseconds, or, if date(1) doesn't support %N,
+# in seconds multiplied out to nanoseconds.
+##
+now_ns() {
+  NOW=`date +%s%N`
+  case $NOW in
+  *N) expr "$NOW" : '\(.*\)N' \* 1000000000 ;;
+  *)  echo $NOW ;;
+  esac
+}
+
+##
+# Prints the mean time per run of a case and that of each phase in
+# microseconds and, if the case is over budget, sets OVER_BUDGET.
+##
+report() {
+  NAME=$1; NS=$2; SHOW_LINK=$3
+  MEAN_US=`awk -v ns=$NS -v runs=$RUNS 'BEGIN { printf "%.1f", ns / runs / 1e3 }'`
+  awk -v name="$NAME" -v runs=$RUNS -v ns=$NS -v exec_ns=$EXEC_NS \
+      -v show_link=$SHOW_LINK '
+  / startup: / {
+    #
+    # wrap: startup: options=0.000012345 conf=0.000000000 ... run=0.000056789
+    #
+    for ( i = 3; i <= NF; ++i ) {
+      if ( split( $i, kv, "=" ) == 2 ) {
+        if ( !( kv[1] in phase ) )
+          order[ ++n ] = kv[1]
+        phase[ kv[1] ] += kv[2]
+        in_main += kv[2]
+      }
+    }
+    next
+  }
+  END {
+    us = 1e6 / runs
+    printf "%s: %d runs %9.1f us/run\n", name, runs, ns / runs / 1e3
+    printf "  %-10s %9.1f us\n", "exec", exec_ns / runs / 1e3
+    if ( show_link )
+      printf "  %-10s %9.1f us\n", "link/exit",
+        (ns - exec_ns) / runs / 1e3 - in_main * us
+    for ( i = 1; i <= n; ++i )
+      printf "  %-10s %9.1f us\n", order[i], phase[ order[i] ] * us
+  }' $STATS
+  if [ "$BUDGET" ] &&
+     awk -v mean=$MEAN_US -v budget=$BUDGET 'BEGIN { exit !(mean > budget) }'
+  then
+    echo "$ME: $NAME: $MEAN_US us/run exceeds budget of $BUDGET us/run" >&2
+    OVER_BUDGET=1
+  fi
+}
+
+##
+# Times a case and reports it.
+##
+time_case() {
+  NAME=$1; SHOW_LINK=$2; shift 2
+  NS=`run_n "$@"` || exit 1
+  report "$NAME" $NS $SHOW_LINK
+}
+
+##
+# Runs a command $RUNS times with standard input from a file, appending its
+# start-up statistics to $STATS, and prints the time taken in nanoseconds.
+##
+run_n() {
+  INPUT=$1; shift
+  : > $STATS
+  START=`now_ns`
+  I=0
+  while [ $I -lt $RUNS ]
+  do
+    "$@" < $INPUT > /dev/null 2>> $STATS || {
+      echo "$ME: $*: failed" >&2
+      exit 1
+    }
+    I=`expr $I + 1`
+  done
+  END=`now_ns`
+  expr $END - $START
+}
+
+usage() {
+  [ "$1" ] && { echo "$ME: $*" >&2; usage; }
+  cat >&2 <<END
+usage: $ME [options]
+options:
+  -b budget  Maximum mean time per run in microseconds [default: none].
+  -n runs    Times to run each case [default: $RUNS].
+END
+  exit 1
+}
+
+########## Begin ##############################################################
+
+ME=`local_basename "$0"`
+
+[ "$BUILD_SRC" ] || {
+  echo "$ME: \$BUILD_SRC not set" >&2
+  exit 2
+}
+
+########## Process command-line ###############################################
+
+BUDGET=
+RUNS=2000
+
+while getopts b:n: opt
+do
+  case $opt in
+  b) BUDGET=$OPTARG ;;
+  n) RUNS=$OPTARG ;;
+  ?) usage ;;
+  esac
+done
+shift `expr $OPTIND - 1`
+[ $# -eq 0 ] || usage
+
+expr "$RUNS" : '[1-9][0-9]*$' > /dev/null || usage "\"$RUNS\": invalid -n"
+[ -z "$BUDGET" ] || expr "$BUDGET" : '[0-9][0-9]*\.\{0,1\}[0-9]*$' \
+  > /dev/null || usage "\"$BUDGET\": invalid -b"
+
+########## Initialize #########################################################
+
+##
+# The automake framework sets $srcdir. If it's empty, it means this script was
+# called by hand, so set it ourselves.
+##
+[ "$srcdir" ] || srcdir="."
+
+CACHE_DIR=/tmp/wrap_bench_startup_cache_$$_
+COMMENT=/tmp/wrap_bench_startup_comment_$$_
+LINE=/tmp/wrap_bench_startup_line_$$_
+STATS=/tmp/wrap_bench_startup_stats_$$_
+
+##
+# Must put BUILD_SRC first in PATH so we get the correct versions of wrap and
+# wrapc.
+##
+PATH=$BUILD_SRC:$PATH
+
+unset WRAP_DEBUG WRAPC_DEBUG WRAPC_DEBUG_RSRW WRAPC_DEBUG_RW
+WRAP_STARTUP_STATS=1; export WRAP_STARTUP_STATS
+XDG_CACHE_HOME=$CACHE_DIR; export XDG_CACHE_HOME
+
+trap 'x=$?; rm -fr $CACHE_DIR $COMMENT $LINE $STATS 2>/dev/null;
+  exit $x' EXIT HUP INT TERM
+
+echo 'The quick brown fox jumps over the lazy dog.' > $LINE
+echo '// The quick brown fox jumps over the lazy dog.' > $COMMENT
+
+##
+# Must use an executable true(1) since the shell's built-in isn't exec'd.
+##
+for TRUE in /bin/true /usr/bin/true
+do [ -x $TRUE ] && break
+done
+EXEC_NS=`run_n /dev/null $TRUE` || exit 1
+
+########## Time cases #########################################################
+
+OVER_BUDGET=
+
+time_case "wrap (empty)"       1 /dev/null wrap
+time_case "wrap (one line)"    1 $LINE wrap
+time_case "wrap -u (one line)" 1 $LINE wrap -u
+time_case "wrap -a (one line)" 1 $LINE wrap -c $srcdir/data/config.wraprc -a man
+time_case "wrapc (one line)"   0 $COMMENT wrapc -c /dev/null
+
+[ "$OVER_BUDGET" ] && exit 1
+exit 0
+
+# vim:set et sw=2 ts=2:
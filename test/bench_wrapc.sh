@@ -0,0 +1,227 @@
+#! /bin/sh
+##
+#       wrap -- text reformatter
+#       test/bench_wrapc.sh
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+##
+# Benchmarks wrapc's Doxygen and Markdown modes (-x -u) over the Doxygen
+# comments of C/C++ headers: those of wrap's own source plus any additional
+# headers given (e.g., those of a large, heavily documented library):
+#
+#  1. Runs wrapc once per comment, as an editor would, i.e., mostly measures
+#     wrapc's per-comment latency.
+#
+#  2. Runs wrapc once over a single comment made from the text of every
+#     comment repeated a number of times, i.e., mostly measures throughput.
+#
+# For each, reports the total time, the CPU time of each of wrapc's processes
+# (child 1 that reads the source, child 2 that's wrap, and the parent that
+# writes the output), the number of IPC messages, and a checksum of the output
+# so that a speedup can be checked not to have changed the output.
+##
+
+# Uncomment the following line for shell tracing.
+#set -x
+
+########## Functions ##########################################################
+
+local_basename() {
+  ##
+  # Autoconf, 11.15:
+  #
+  # basename
+  #   Not all hosts have a working basename. You can use expr instead.
+  ##
+  expr "//$1" : '.*/\(.*\)'
+}
+
+##
+# Prints the current time in nanoseconds, or, if date(1) doesn't support %N,
+# in seconds multiplied out to nanoseconds.
+##
+now_ns() {
+  NOW=`date +%s%N`
+  case $NOW in
+  *N) expr "$NOW" : '\(.*\)N' \* 1000000000 ;;
+  *)  echo $NOW ;;
+  esac
+}
+
+##
+# Prints the totals of the statistics wrapc printed for every run, the time
+# taken, the number of comments or lines, and the output's checksum.
+##
+report() {
+  NAME=$1; COUNT=$2; UNIT=$3; NS=$4
+  SUM=`cksum < $OUTPUT | sed 's/ .*//'`
+  awk -v name="$NAME" -v count=$COUNT -v unit="$UNIT" -v ns=$NS -v sum=$SUM '
+  / stats: / {
+    #
+    # wrapc: stats: read.wall=0.001234 read.cpu=0.000987 ... write.ipc=3
+    #
+    for ( i = 3; i <= NF; ++i )
+      if ( split( $i, kv, "=" ) == 2 )
+        stat[ kv[1] ] += kv[2]
+    next
+  }
+  END {
+    s = ns / 1e9
+    printf "%s: %d %s %9.3f s", name, count, unit, s
+    if ( s > 0 )
+      printf " %12.0f %s/s", count / s, unit
+    printf "\n"
+    printf "  %-24s %9.3f s CPU\n", "child 1 (read source)", stat[ "read.cpu" ]
+    printf "  %-24s %9.3f s CPU\n", "child 2 (wrap)", stat[ "wrap.cpu" ]
+    printf "  %-24s %9.3f s CPU\n", "parent (write stdout)", stat[ "write.cpu" ]
+    printf "  %-24s %9d\n", "IPC messages", stat[ "write.ipc" ]
+    printf "  %-24s %9s\n", "output checksum", sum
+  }' $STATS
+}
+
+##
+# Runs wrapc over a file appending its output to $OUTPUT and its statistics to
+# $STATS.
+##
+run_wrapc() {
+  wrapc -c /dev/null --stats $OPTIONS < "$1" >> $OUTPUT 2>> $STATS || {
+    echo "$ME: $1: wrapc failed" >&2
+    exit 1
+  }
+}
+
+usage() {
+  [ "$1" ] && { echo "$ME: $*" >&2; usage; }
+  cat >&2 <<END
+usage: $ME [options] [header ...]
+options:
+  -n repeat   Times to repeat the comment text [default: $REPEAT].
+  -o options  wrapc options [default: $OPTIONS].
+END
+  exit 1
+}
+
+########## Begin ##############################################################
+
+ME=`local_basename "$0"`
+
+[ "$BUILD_SRC" ] || {
+  echo "$ME: \$BUILD_SRC not set" >&2
+  exit 2
+}
+
+########## Process command-line ###############################################
+
+OPTIONS="-x -u"
+REPEAT=20
+
+while getopts n:o: opt
+do
+  case $opt in
+  n) REPEAT=$OPTARG ;;
+  o) OPTIONS=$OPTARG ;;
+  ?) usage ;;
+  esac
+done
+shift `expr $OPTIND - 1`
+
+expr "$REPEAT" : '[1-9][0-9]*$' > /dev/null || usage "\"$REPEAT\": invalid -n"
+
+########## Initialize #########################################################
+
+##
+# The automake framework sets $srcdir. If it's empty, it means this script was
+# called by hand, so set it ourselves.
+##
+[ "$srcdir" ] || srcdir="."
+
+BLOCKS_DIR=/tmp/wrapc_bench_blocks_$$_
+COMMENT=/tmp/wrapc_bench_comment_$$_
+OUTPUT=/tmp/wrapc_bench_output_$$_
+STATS=/tmp/wrapc_bench_stats_$$_
+TEXT=/tmp/wrapc_bench_text_$$_
+
+##
+# Must put BUILD_SRC first in PATH so we get the correct versions of wrapc and
+# wrap.
+##
+PATH=$BUILD_SRC:$PATH
+
+unset WRAP_DEBUG WRAPC_DEBUG WRAPC_DEBUG_RSRW WRAPC_DEBUG_RW
+
+trap 'x=$?; rm -fr $BLOCKS_DIR $COMMENT $OUTPUT $STATS $TEXT 2>/dev/null;
+  exit $x' EXIT HUP INT TERM
+
+########## Extract comments ###################################################
+
+##
+# Puts every /** ... */ comment of at least 2 lines into its own file and all
+# of their text (without the /** and */ lines) into $TEXT.
+##
+mkdir $BLOCKS_DIR || exit 2
+cat $srcdir/../src/*.h "$@" | awk -v dir=$BLOCKS_DIR -v text=$TEXT '
+  /^[ \t]*\/\*\*[ \t]*$/ { in_comment = 1; n = 0 }
+  in_comment { line[ ++n ] = $0 }
+  in_comment && /\*\// {
+    in_comment = 0
+    if ( n > 2 ) {
+      file = sprintf( "%s/%05d.c", dir, ++blocks )
+      for ( i = 1; i <= n; ++i )
+        print line[i] > file
+      close( file )
+      for ( i = 2; i < n; ++i )
+        print line[i] > text
+    }
+  }'
+
+BLOCKS=`ls $BLOCKS_DIR | wc -l`
+[ $BLOCKS -gt 0 ] || {
+  echo "$ME: no Doxygen comments found" >&2
+  exit 1
+}
+
+########## Time per-comment runs ##############################################
+
+: > $OUTPUT; : > $STATS
+START=`now_ns`
+for BLOCK in $BLOCKS_DIR/*.c
+do run_wrapc $BLOCK
+done
+END=`now_ns`
+report "per comment" $BLOCKS comments `expr $END - $START`
+
+########## Time single-comment run ############################################
+
+{
+  echo '/**'
+  I=0
+  while [ $I -lt $REPEAT ]
+  do
+    cat $TEXT
+    I=`expr $I + 1`
+  done
+  echo ' */'
+} > $COMMENT
+
+: > $OUTPUT; : > $STATS
+START=`now_ns`
+run_wrapc $COMMENT
+END=`now_ns`
+report "single comment x $REPEAT" `wc -l < $COMMENT` lines `expr $END - $START`
+
+# vim:set et sw=2 ts=2:
@@ -0,0 +1,25 @@
+Content-Length: 120
+
+{"jsonrpc":"2.0","id":1,"method":"initialize","params":{"capabilities":{},"initializationOptions":{"args":["-w","30"]}}}Content-Length: 52
+
+{"jsonrpc":"2.0","method":"initialized","params":{}}Content-Length: 221
+
+{"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{"uri":"file:///tmp/a.txt","languageId":"plaintext","version":1,"text":"The quick brown fox jumps over the lazy dog.\n\nSecond para is short.\n"}}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":2,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 256
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":2},"contentChanges":[{"range":{"start":{"line":2,"character":16},"end":{"line":2,"character":21}},"text":"now much much longer than before"}]}}Content-Length: 236
+
+{"jsonrpc":"2.0","id":3,"method":"textDocument/rangeFormatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"range":{"start":{"line":2,"character":0},"end":{"line":2,"character":3}},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 209
+
+{"jsonrpc":"2.0","id":4,"method":"textDocument/onTypeFormatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"position":{"line":0,"character":10},"ch":" ","options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 216
+
+{"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{"uri":"file:///tmp/b.c","languageId":"c","version":1,"text":"int x;\n// This is a long comment that should be wrapped by wrapc.\nint y;\n"}}}Content-Length: 155
+
+{"jsonrpc":"2.0","id":5,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/b.c"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 66
+
+{"jsonrpc":"2.0","id":6,"method":"textDocument/hover","params":{}}Content-Length: 44
+
+{"jsonrpc":"2.0","id":7,"method":"shutdown"}Content-Length: 33
+
+{"jsonrpc":"2.0","method":"exit"}
\ No newline at end of file
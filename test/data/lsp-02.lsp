@@ -0,0 +1,23 @@
+Content-Length: 120
+
+{"jsonrpc":"2.0","id":1,"method":"initialize","params":{"capabilities":{},"initializationOptions":{"args":["-w","30"]}}}Content-Length: 295
+
+{"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{"uri":"file:///tmp/a.txt","languageId":"plaintext","version":1,"text":"The quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n"}}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":2,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 232
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":2},"contentChanges":[{"range":{"start":{"line":3,"character":4},"end":{"line":3,"character":4}},"text":"very very "}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":3,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":4,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 226
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":2},"contentChanges":[{"range":{"start":{"line":0,"character":4},"end":{"line":0,"character":4}},"text":"big "}]}}Content-Length: 230
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":2},"contentChanges":[{"range":{"start":{"line":7,"character":0},"end":{"line":7,"character":0}},"text":"Really, "}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":5,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 45
+
+{"jsonrpc":"2.0","id":99,"method":"shutdown"}Content-Length: 33
+
+{"jsonrpc":"2.0","method":"exit"}
\ No newline at end of file
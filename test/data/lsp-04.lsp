@@ -0,0 +1,23 @@
+Content-Length: 120
+
+{"jsonrpc":"2.0","id":1,"method":"initialize","params":{"capabilities":{},"initializationOptions":{"args":["-w","30"]}}}Content-Length: 3088
+
+{"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{"uri":"file:///tmp/a.txt","languageId":"plaintext","version":1,"text":"The quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n\nThe quick brown fox jumps\nover the lazy dog.\n"}}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":2,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 449
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":2},"contentChanges":[{"range":{"start":{"line":84,"character":4},"end":{"line":84,"character":4}},"text":"very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very very "}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":3,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 227
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":3},"contentChanges":[{"range":{"start":{"line":100,"character":0},"end":{"line":103,"character":5}},"text":"A"}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":4,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 224
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/a.txt","version":4},"contentChanges":[{"range":{"start":{"line":1,"character":0},"end":{"line":1,"character":0}},"text":"x "}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":5,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/a.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 44
+
+{"jsonrpc":"2.0","id":6,"method":"shutdown"}Content-Length: 33
+
+{"jsonrpc":"2.0","method":"exit"}
\ No newline at end of file
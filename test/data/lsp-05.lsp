@@ -0,0 +1,21 @@
+Content-Length: 120
+
+{"jsonrpc":"2.0","id":1,"method":"initialize","params":{"capabilities":{},"initializationOptions":{"args":["-w","30"]}}}Content-Length: 237
+
+{"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{"uri":"file:///tmp/b.txt","languageId":"plaintext","version":1,"text":"The quick brown fox jumps over the lazy dog\nand keeps on running far away.\n\nShort.\n"}}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":2,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/b.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":3,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/b.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 300
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/b.txt","version":2},"contentChanges":[{"range":{"start":{"line":0,"character":0},"end":{"line":2,"character":0}},"text":"The quick brown fox jumps\nover the lazy dog and keeps\non running far away.\n"}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":4,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/b.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 272
+
+{"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///tmp/b.txt","version":3},"contentChanges":[{"range":{"start":{"line":4,"character":0},"end":{"line":4,"character":0}},"text":"A much longer paragraph that must now be wrapped. "}]}}Content-Length: 157
+
+{"jsonrpc":"2.0","id":5,"method":"textDocument/formatting","params":{"textDocument":{"uri":"file:///tmp/b.txt"},"options":{"tabSize":8,"insertSpaces":true}}}Content-Length: 44
+
+{"jsonrpc":"2.0","id":6,"method":"shutdown"}Content-Length: 33
+
+{"jsonrpc":"2.0","method":"exit"}
\ No newline at end of file
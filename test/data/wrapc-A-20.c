@@ -0,0 +1,3 @@
+int naïve = 1; // naïve
+char const *s = "–"; /* en–dash */
+x = y;  # ¿qué?
@@ -0,0 +1,7 @@
+printf( "this // is not a comment \" nor // this" ); // but this is
+char const c = '\''; /* a quote character */
+char const *s = "a\\"; int x = 1; // within the string per the above
+int y = 2; /* not end-of-line */ int z = 3;
+static char const LONG_NAME_TO_SPAN_SEVERAL_VECTOR_BLOCKS_OF_SIXTEEN_OR_MORE[] = "x"; // long
+  int no_comment_on_this_line_at_all_even_though_it_is_rather_long = 0;
+url = "http://example.com"; // a URL
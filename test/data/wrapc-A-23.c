@@ -0,0 +1,10 @@
+enum delim {
+  DELIM_NONE, // no comment delimiter
+  DELIM_EOL,      // e.g., "#" or "//" (to end-of-line)
+  DELIM_SINGLE, // e.g., "{" (Pascal)
+  DELIM_DOUBLE_WIDEST,     // e.g., "/*" (but not "//")
+}; // enum
+
+static int x; /* x */
+static int longer_y;                                  /* y */
+int z = 0;
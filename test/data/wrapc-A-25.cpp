@@ -0,0 +1,6 @@
+auto const re = R"x(a // b " c)x"; // raw string
+auto const s = u8R"(// not)"; int i; // after raw
+char const *t = "a // b"; // plain string
+auto const ml = R"(
+  x = 1; // inside the raw string
+)"; // after
@@ -0,0 +1,7 @@
+def f():
+    """
+    x = 1 # inside the docstring
+    """
+    y = 2 # a comment
+    s = '''a # b''' # after
+    t = "# not" # but this
@@ -0,0 +1,6 @@
+let a = r#"a // "b" c"#; // raw string
+let b = r"// c"; // raw without hashes
+let c = "x
+   // still within the string
+"; // after
+fn f<'a>( x: &'a str ) {} // lifetime
@@ -0,0 +1,5 @@
+s := `a // b\`; x := 1 // raw string
+t := `
+  // within the raw string
+` + "x" // after
+u := "a // b" // interpreted string
@@ -0,0 +1,4 @@
+const s = `a // ${b}
+  // within the template literal \` still
+`; // after
+const t = 'a // b'; // string
@@ -0,0 +1,21 @@
+/*
+ * Reads the output of wrap(1) and prepends the leading whitespace and comment characters back to each line.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+// Prints a greeting.  This line comment is long enough that it really ought to be wrapped.
+// It continues here.
+static void greet( char const *who ) {
+  /*
+   * An indented block comment.
+   * Its lines are joined.
+   */
+  printf( "hello, %s\n", who );         // an end-of-line comment not altered
+}
+
+int main( void ) {
+  greet( "world" );                     /* nor is this one */
+  // The end.
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,12 @@
+#!/usr/bin/env python3
+import os
+
+# We want to resolve the symbolic link of ONLY src_path
+# and not ALL the symbolic links in the entire path,
+# hence we can't use realpath().
+def resolve( src_path ):
+    new_src_path = os.readlink( src_path )
+    # Make the path absolute if it isn't already by joining it with the directory of the original path.
+    if not os.path.isabs( new_src_path ):
+        new_src_path = os.path.join( os.path.dirname( src_path ), new_src_path )
+    return new_src_path
@@ -0,0 +1,15 @@
+/**
+ * Frees a list.
+ *
+ * @param list The list to free.  If it's NULL, this function does nothing at all.
+ * @param free_fn The function to free each element with or NULL for none.
+ */
+void list_free( list_t *list, free_fn_t free_fn );
+
+/**
+ * Gets the length of a list.
+ *
+ * @param list The list to get the length of which is the number of elements in it.
+ * @return Returns said length.
+ */
+size_t list_len( list_t const *list );
@@ -0,0 +1,6 @@
+// Prints a greeting that is long enough that it has to be wrapped by wrapc onto
+// another line.
+#include <stdio.h>
+#include <stdlib.h>
+
+# define GREETING "hello"
@@ -0,0 +1,347 @@
+#! /bin/sh
+##
+#       wrap -- text reformatter
+#       test/equiv_check.sh
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+##
+# Checks that each accelerated engine (WRAP_ENGINE=fast, span, or simd) that
+# wrap can choose among produces output that is byte for byte the same as that
+# of the reference engine (WRAP_ENGINE=reference):
+#
+#   1. Every test in tests/*.test (or only those given) is run by every engine
+#      and their exit statuses and outputs compared.  The expected output
+#      doesn't matter here (the test itself checks that): only that the
+#      engines agree.
+#
+#   2. A number of random corpora (-n), each of about -s KB and generated
+#      deterministically from its seed, mixing prose, hyphens, URIs,
+#      multi-byte and invalid UTF-8, tabs, over-long words, leading dots, and
+#      Markdown, are reformatted with each of a number of sets of options by
+#      every engine and by the default engine with, additionally, --check,
+#      --diff, --jobs, and --para-cache (both when the cache is empty and when
+#      it's full).
+#
+# Since the default engine is the fastest, an engine may become the default
+# only once this passes for it.
+#
+# Prints every difference found and exits with status 1 if any.  A failing
+# corpus can be regenerated via -S and its seed.
+##
+
+# Uncomment the following line for shell tracing.
+#set -x
+
+########## Functions ##########################################################
+
+local_basename() {
+  ##
+  # Autoconf, 11.15:
+  #
+  # basename
+  #   Not all hosts have a working basename. You can use expr instead.
+  ##
+  expr "//$1" : '.*/\(.*\)'
+}
+
+##
+# Compares the output and exit status of the reference run against those of
+# an accelerated run and prints a line for a difference, if any.
+##
+compare() {
+  WHAT=$1
+  if [ "$REF_EXIT" != "$ACC_EXIT" ]
+  then
+    echo "FAIL: $WHAT: exit status $ACC_EXIT, reference $REF_EXIT"
+    FAILED=`expr $FAILED + 1`
+  elif ! cmp -s $REF_OUT $ACC_OUT
+  then
+    echo "FAIL: $WHAT: `cmp $REF_OUT $ACC_OUT 2>&1 | sed 's/^[^:]*: //'`"
+    FAILED=`expr $FAILED + 1`
+  fi
+  CHECKED=`expr $CHECKED + 1`
+}
+
+##
+# Generates a random corpus of about $SIZE_KB kilobytes from seed $1 to
+# standard output.  It uses a linear congruential generator (exact in double
+# arithmetic) and counts bytes, not characters, so any awk generates the same
+# bytes.
+##
+generate() {
+  LC_ALL=C awk -v seed="$1" -v size=`expr $SIZE_KB \* 1024` '
+  function rnd( n ) {
+    seed = (seed * 69069 + 1) % 4294967296
+    return int( seed / 4294967296 * n )
+  }
+  function token(    r, s, n ) {
+    r = rnd( 100 )
+    if ( r < 55 ) return WORDS[ rnd( WORDS_LEN ) + 1 ]
+    if ( r < 62 ) return WORDS[ rnd( WORDS_LEN ) + 1 ] "-" \
+                         WORDS[ rnd( WORDS_LEN ) + 1 ]
+    if ( r < 68 ) return WORDS[ rnd( WORDS_LEN ) + 1 ] \
+                         PUNCT[ rnd( PUNCT_LEN ) + 1 ]
+    if ( r < 73 ) return URIS[ rnd( URIS_LEN ) + 1 ]
+    if ( r < 80 ) return UTF8[ rnd( UTF8_LEN ) + 1 ] UTF8[ rnd( UTF8_LEN ) + 1 ]
+    if ( r < 83 ) return sprintf( "x%cy", 128 + rnd( 128 ) )
+    if ( r < 86 ) return MD[ rnd( MD_LEN ) + 1 ] WORDS[ rnd( WORDS_LEN ) + 1 ] \
+                         MD[ rnd( MD_LEN ) + 1 ]
+    if ( r < 88 ) {
+      n = 10 + rnd( 120 )
+      s = ""
+      while ( length( s ) < n )
+        s = s WORDS[ rnd( WORDS_LEN ) + 1 ]
+      return s
+    }
+    return WORDS[ rnd( WORDS_LEN ) + 1 ] "."
+  }
+  function line(    n, s, i ) {
+    n = rnd( 16 )
+    s = LEADS[ rnd( LEADS_LEN ) + 1 ]
+    if ( s == "_" ) s = ""
+    for ( i = 0; i < n; ++i )
+      s = s token() SPACES[ rnd( SPACES_LEN ) + 1 ]
+    return s token()
+  }
+  function out( s ) {
+    if ( rnd( 40 ) == 0 )
+      s = s "\r"
+    print s
+    bytes += length( s ) + 1
+  }
+  BEGIN {
+    WORDS_LEN = split( "a an the of to in is it that for on with as was at " \
+      "by be this from or are which text line width paragraph wrap filter " \
+      "reformat column margin hyphen sentence word space indent tab comment " \
+      "x y z I 42 3.14 e.g. i.e. Mr. foo_bar fooBar", WORDS )
+    PUNCT_LEN = split( ", ; : ! ? .\" .) ?! ...", PUNCT )
+    URIS_LEN = split( "https://example.com/a-b-c " \
+      "http://www.example.org/path/to-some/page?q=x-y#frag-1 " \
+      "mailto:first-last@example.com user.name-1@sub-domain.example.co.uk " \
+      "file:///usr/local/share/doc/wrap-1.0/README a-a-a-a@-", URIS )
+    UTF8_LEN = split( "é ü ñ ß ø – — “ ” … 日 本 語 한 국 😀 👍 ❤️", UTF8 )
+    MD_LEN = split( "* ** _ ` `` ~~ [ ]( ) < > |", MD )
+    LEADS_LEN = split( "_ _ _ _ _ _ _ _ _ _ _ _ _ _ _ _ " \
+      "# ## * - + 1. 2) > >> | .", LEADS )
+    LEADS[ LEADS_LEN + 1 ] = "    "
+    LEADS[ LEADS_LEN + 2 ] = "\t"
+    LEADS[ LEADS_LEN + 3 ] = "  * "
+    LEADS[ LEADS_LEN + 4 ] = "```"
+    LEADS_LEN += 4
+    SPACES_LEN = split( "_ _ _ _ _ _ _ _ _ _ _ _ _ _ _ _ _ _ x x t", SPACES )
+    for ( i = 1; i <= SPACES_LEN; ++i )
+      SPACES[i] = SPACES[i] == "_" ? " " : SPACES[i] == "x" ? "  " : "\t"
+
+    while ( bytes < size ) {
+      n = 1 + rnd( 8 )
+      for ( i = 0; i < n; ++i )
+        out( line() )
+      out( rnd( 8 ) == 0 ? "  " : "" )
+    }
+  }'
+}
+
+usage() {
+  [ "$1" ] && { echo "$ME: $*" >&2; usage; }
+  cat >&2 <<END
+usage: $ME [options] [test ...]
+options:
+  -n corpora  Number of random corpora [default: $CORPORA].
+  -s size     Size of each random corpus in KB [default: $SIZE_KB].
+  -S seed     Seed of the first random corpus [default: $SEED].
+engines: $ENGINES
+END
+  exit 1
+}
+
+########## Begin ##############################################################
+
+ME=`local_basename "$0"`
+
+[ "$BUILD_SRC" ] || {
+  echo "$ME: \$BUILD_SRC not set" >&2
+  exit 2
+}
+[ "$srcdir" ] || srcdir="."
+
+########## Process command-line ###############################################
+
+CORPORA=8
+ENGINES="fast span simd"
+SEED=1
+SIZE_KB=64
+
+while getopts n:s:S: opt
+do
+  case $opt in
+  n) CORPORA=$OPTARG ;;
+  s) SIZE_KB=$OPTARG ;;
+  S) SEED=$OPTARG ;;
+  ?) usage ;;
+  esac
+done
+shift `expr $OPTIND - 1`
+
+expr "$CORPORA" : '[0-9][0-9]*$' > /dev/null || usage "\"$CORPORA\": invalid -n"
+expr "$SIZE_KB" : '[1-9][0-9]*$' > /dev/null || usage "\"$SIZE_KB\": invalid -s"
+expr "$SEED" : '[0-9][0-9]*$' > /dev/null || usage "\"$SEED\": invalid -S"
+
+if [ $# -gt 0 ]
+then TESTS="$*"
+else TESTS=`ls $srcdir/tests/*.test`
+fi
+
+##
+# The sets of options each random corpus is reformatted with.
+##
+OPTION_SETS="-w80
+-w20
+-w72 -J
+-w40 -E1 -y
+-r
+-w60 -r -J
+-e
+-N -w30
+-W -d
+-B -w24
+-u
+-u -U -w50
+-x -w60
+-T -P -w48
+-L> -H2 -I4 -w64
+-m1 -w56"
+
+########## Initialize #########################################################
+
+CACHE=/tmp/wrap_equiv_cache_$$_
+CORPUS=/tmp/wrap_equiv_corpus_$$_
+REF_OUT=/tmp/wrap_equiv_ref_$$_
+ACC_OUT=/tmp/wrap_equiv_acc_$$_
+
+##
+# Must put BUILD_SRC first in PATH so we get the correct versions of wrap and
+# wrapc.
+##
+PATH=$BUILD_SRC:$PATH
+export PATH
+
+unset WRAP_DEBUG WRAPC_DEBUG WRAPC_DEBUG_RSRW WRAPC_DEBUG_RW WRAP_ENGINE
+
+##
+# Times aren't being checked, so wrap_fuzz shouldn't either.
+##
+WRAP_FUZZ_MIN_BYTES=999999999
+export WRAP_FUZZ_MIN_BYTES
+
+trap 'x=$?; rm -f $CACHE* $CORPUS* $REF_OUT $ACC_OUT 2>/dev/null; exit $x' \
+  EXIT HUP INT TERM
+
+CHECKED=0
+FAILED=0
+
+########## Tests ##############################################################
+
+for TEST in $TESTS
+do
+  TEST_NAME=`local_basename "$TEST"`
+  [ "$IFS" ] && IFS_old=$IFS
+  IFS='|'; read COMMAND CONFIG OPTIONS INPUT EXPECTED_EXIT < $TEST
+  [ "$IFS_old" ] && IFS=$IFS_old
+
+  COMMAND=`echo $COMMAND`               # trims whitespace
+  CONFIG=`echo $CONFIG`                 # trims whitespace
+  [ "$CONFIG" != /dev/null ] && CONFIG=$srcdir/data/$CONFIG
+  INPUT=$srcdir/data/`echo $INPUT`      # trims whitespace
+
+  rm -f $REF_OUT
+  WRAP_ENGINE=reference $COMMAND -c $CONFIG $OPTIONS -f $INPUT -o $REF_OUT \
+    2> /dev/null
+  REF_EXIT=$?
+  touch $REF_OUT                        # in case it wrote nothing
+  for ENGINE in $ENGINES
+  do
+    rm -f $ACC_OUT
+    WRAP_ENGINE=$ENGINE $COMMAND -c $CONFIG $OPTIONS -f $INPUT -o $ACC_OUT \
+      2> /dev/null
+    ACC_EXIT=$?
+    touch $ACC_OUT
+    compare "$TEST_NAME ($ENGINE)"
+  done
+done
+
+########## Random corpora #####################################################
+
+I=0
+while [ $I -lt $CORPORA ]
+do
+  S=`expr $SEED + $I`
+  generate $S > $CORPUS
+
+  echo "$OPTION_SETS" | while read OPTIONS
+  do
+    WRAP_ENGINE=reference wrap -C $OPTIONS < $CORPUS > $REF_OUT 2> /dev/null
+    REF_EXIT=$?
+    for ENGINE in $ENGINES
+    do
+      WRAP_ENGINE=$ENGINE wrap -C $OPTIONS < $CORPUS > $ACC_OUT 2> /dev/null
+      ACC_EXIT=$?
+      compare "seed $S: wrap $OPTIONS ($ENGINE)"
+    done
+
+    wrap -C $OPTIONS -j4 < $CORPUS > $ACC_OUT 2> /dev/null
+    ACC_EXIT=$?
+    compare "seed $S: wrap $OPTIONS -j4"
+
+    rm -f $CACHE
+    for RUN in empty full
+    do
+      wrap -C $OPTIONS -K$CACHE < $CORPUS > $ACC_OUT 2> /dev/null
+      ACC_EXIT=$?
+      compare "seed $S: wrap $OPTIONS -K ($RUN cache)"
+    done
+
+    WRAP_ENGINE=reference wrap -C $OPTIONS -X < $CORPUS > $REF_OUT 2> /dev/null
+    REF_EXIT=$?
+    wrap -C $OPTIONS -X < $CORPUS > $ACC_OUT 2> /dev/null
+    ACC_EXIT=$?
+    compare "seed $S: wrap $OPTIONS -X"
+
+    ##
+    # Most of the reformatted output is already formatted, so checking it
+    # exercises skipping paragraphs that are.
+    ##
+    WRAP_ENGINE=reference wrap -C $OPTIONS < $CORPUS > $CORPUS.out 2> /dev/null
+    WRAP_ENGINE=reference wrap -C $OPTIONS -k < $CORPUS.out > $REF_OUT \
+      2> /dev/null
+    REF_EXIT=$?
+    wrap -C $OPTIONS -k < $CORPUS.out > $ACC_OUT 2> /dev/null
+    ACC_EXIT=$?
+    rm -f $CORPUS.out
+    compare "seed $S: wrap $OPTIONS -k"
+
+    echo "$CHECKED $FAILED" > $CACHE.n
+  done
+  read CHECKED FAILED < $CACHE.n
+  rm -f $CACHE.n
+  I=`expr $I + 1`
+done
+
+echo "$ME: $CHECKED compared, $FAILED different"
+[ $FAILED -eq 0 ]
+
+# vim:set et sw=2 ts=2:
@@ -0,0 +1,161 @@
+#! /bin/sh
+##
+#       wrap -- text reformatter
+#       test/pgo_train.sh
+#
+#       Copyright (C) 2024  Paul J. Lucas
+#
+#       This program is free software: you can redistribute it and/or modify
+#       it under the terms of the GNU General Public License as published by
+#       the Free Software Foundation, either version 3 of the License, or
+#       (at your option) any later version.
+#
+#       This program is distributed in the hope that it will be useful,
+#       but WITHOUT ANY WARRANTY; without even the implied warranty of
+#       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#       GNU General Public License for more details.
+#
+#       You should have received a copy of the GNU General Public License
+#       along with this program.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+##
+# Trains instrumented builds of wrap and wrapc for profile-guided optimization
+# (see "make pgo") by running them over a corpus that covers their hot paths:
+#
+#  + Plain text: the test data's text files, each wrapped with the default
+#    options and a few common ones, and all of them concatenated as a single
+#    large input.
+#
+#  + Markdown: the test data's Markdown files and wrap's own README.md via
+#    wrap -u.
+#
+#  + Comments: the test data's source files via wrapc and every Doxygen comment
+#    of wrap's own headers via wrapc -G -x -u.
+#
+# Only the profile matters, not the output, but a failure of either program is
+# still an error.
+##
+
+# Uncomment the following line for shell tracing.
+#set -x
+
+########## Functions ##########################################################
+
+local_basename() {
+  ##
+  # Autoconf, 11.15:
+  #
+  # basename
+  #   Not all hosts have a working basename. You can use expr instead.
+  ##
+  expr "//$1" : '.*/\(.*\)'
+}
+
+##
+# Runs a command with standard input from a file, discarding its output.
+##
+train() {
+  INPUT=$1; shift
+  "$@" < $INPUT > /dev/null 2>&1 || {
+    echo "$ME: $* < $INPUT: failed" >&2
+    exit 1
+  }
+}
+
+usage() {
+  [ "$1" ] && { echo "$ME: $*" >&2; usage; }
+  cat >&2 <<END
+usage: $ME [options]
+options:
+  -n runs    Times to run over the corpus [default: $RUNS].
+END
+  exit 1
+}
+
+########## Begin ##############################################################
+
+ME=`local_basename "$0"`
+
+[ "$BUILD_SRC" ] || {
+  echo "$ME: \$BUILD_SRC not set" >&2
+  exit 2
+}
+
+########## Process command-line ###############################################
+
+RUNS=3
+
+while getopts n: opt
+do
+  case $opt in
+  n) RUNS=$OPTARG ;;
+  ?) usage ;;
+  esac
+done
+shift `expr $OPTIND - 1`
+[ $# -eq 0 ] || usage
+
+expr "$RUNS" : '[1-9][0-9]*$' > /dev/null || usage "\"$RUNS\": invalid -n"
+
+########## Initialize #########################################################
+
+##
+# The automake framework sets $srcdir. If it's empty, it means this script was
+# called by hand, so set it ourselves.
+##
+[ "$srcdir" ] || srcdir="."
+DATA=$srcdir/data
+TOP_SRC=$srcdir/..
+
+CACHE_DIR=/tmp/wrap_pgo_train_cache_$$_
+CORPUS=/tmp/wrap_pgo_train_corpus_$$_
+
+##
+# Must put BUILD_SRC first in PATH so we get the correct versions of wrap and
+# wrapc.
+##
+PATH=$BUILD_SRC:$PATH
+
+unset WRAP_DEBUG WRAPC_DEBUG WRAPC_DEBUG_RSRW WRAPC_DEBUG_RW
+XDG_CACHE_HOME=$CACHE_DIR; export XDG_CACHE_HOME
+
+trap 'x=$?; rm -fr $CACHE_DIR $CORPUS 2>/dev/null; exit $x' EXIT HUP INT TERM
+
+cat $DATA/*.txt > $CORPUS
+
+########## Train ##############################################################
+
+I=0
+while [ $I -lt $RUNS ]
+do
+  # Plain text.
+  for F in $DATA/*.txt
+  do
+    train $F wrap
+    train $F wrap -w 40 -J
+    train $F wrap -e -T
+  done
+  train $CORPUS wrap
+  train $CORPUS wrap -w 60 -r
+  train $CORPUS wrap -c $DATA/config.wraprc -a man
+
+  # Markdown.
+  for F in $DATA/md-*.md $TOP_SRC/README.md
+  do train $F wrap -u
+  done
+
+  # Comments.
+  for F in $DATA/hello_* $DATA/wrapc-*.c $DATA/wrapc-*.cpp
+  do train $F wrapc -c /dev/null -F `local_basename $F`
+  done
+  for F in $DATA/*.doxy $TOP_SRC/src/*.h
+  do train $F wrapc -c /dev/null -G -x -u
+  done
+
+  I=`expr $I + 1`
+done
+
+exit 0
+
+# vim:set et sw=2 ts=2:
@@ -183,6 +183,13 @@ OUTPUT=/tmp/wrap_test_output_$$_
 
 ########## Run test ###########################################################
 
+run_mddoc_file() {
+  if md_doc_test $TEST > $LOG_FILE 2>&1
+  then pass
+  else fail
+  fi
+}
+
 run_regex_file() {
   if regex_test $TEST > $LOG_FILE 2>&1
   then pass
@@ -190,6 +197,29 @@ run_regex_file() {
   fi
 }
 
+##
+# A .sh test is a shell script for what can't be expressed as a .test, e.g.,
+# piped input or a sequence of commands.  Its standard output is compared
+# against the expected output.  It may use $DATA_DIR for its input and $TEST_TMP
+# (an empty directory) for any files it creates.
+##
+run_sh_file() {
+  EXPECTED_OUTPUT="$EXPECTED_DIR/`echo $TEST_NAME | sed s/sh$/txt/`"
+  TEST_TMP=/tmp/wrap_test_tmp_$$_
+  export DATA_DIR TEST_TMP
+  mkdir $TEST_TMP || { fail ERROR; return; }
+
+  if sh $TEST > $OUTPUT 2> $LOG_FILE
+  then
+    if diff $EXPECTED_OUTPUT $OUTPUT > $LOG_FILE
+    then pass; mv $OUTPUT $LOG_FILE
+    else fail
+    fi
+  else
+    fail ERROR
+  fi
+}
+
 run_wrap_file() {
   [ "$IFS" ] && IFS_old=$IFS
   IFS='|'; read COMMAND CONFIG OPTIONS INPUT EXPECTED_EXIT < $TEST
@@ -245,10 +275,12 @@ unset WRAPC_DEBUG
 unset WRAPC_DEBUG_RSRW
 unset WRAPC_DEBUG_RW
 
-trap "x=$?; rm -f /tmp/*_$$_* 2>/dev/null; exit $x" EXIT HUP INT TERM
+trap "x=$?; rm -rf /tmp/*_$$_* 2>/dev/null; exit $x" EXIT HUP INT TERM
 
 case $TEST in
+*.mddoc)  run_mddoc_file ;;
 *.regex)  run_regex_file ;;
+*.sh)     run_sh_file ;;
 *.test)   run_wrap_file ;;
 esac
 
@@ -0,0 +1,3 @@
+# A file is reformatted in place.
+cp $DATA_DIR/data-01.txt $TEST_TMP/data-01.txt
+wrap -c /dev/null -w30 -O $TEST_TMP/data-01.txt && cat $TEST_TMP/data-01.txt
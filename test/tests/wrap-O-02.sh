@@ -0,0 +1,7 @@
+# A symbolic link is written through: its target is reformatted in place and
+# the link is kept.
+cp $DATA_DIR/data-01.txt $TEST_TMP/data-01.txt
+ln -s data-01.txt $TEST_TMP/link.txt
+wrap -c /dev/null -w30 -O $TEST_TMP/link.txt || exit
+[ -L $TEST_TMP/link.txt ] && echo "link kept"
+cat $TEST_TMP/data-01.txt
@@ -0,0 +1,5 @@
+# A file that looks binary is skipped with a warning and left unchanged.
+printf 'binary\000data\n' > $TEST_TMP/binary.dat
+cp $TEST_TMP/binary.dat $TEST_TMP/binary.orig
+wrap -c /dev/null -w30 -O $TEST_TMP/binary.dat 2>&1 | sed "s|$TEST_TMP/||"
+cmp -s $TEST_TMP/binary.orig $TEST_TMP/binary.dat && echo "file unchanged"
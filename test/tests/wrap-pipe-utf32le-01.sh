@@ -0,0 +1,2 @@
+# UTF-32 from a pipe (that can't be memory-mapped) is transcoded as it's read.
+cat $DATA_DIR/utf32le-01.txt | wrap -c /dev/null -w30
@@ -0,0 +1,17 @@
+# A request sent to a server by a client is run as if wrap itself had been.
+SOCK=$TEST_TMP/sock
+wrap --server=$SOCK &
+SERVER=$!
+i=0
+until [ -S $SOCK ]
+do
+  i=`expr $i + 1`
+  [ $i -gt 100 ] && { kill $SERVER; exit 1; }
+  sleep 0.1
+done
+
+wrap --client=$SOCK -c /dev/null -w30 < $DATA_DIR/data-01.txt
+STATUS=$?
+kill $SERVER && wait $SERVER || exit
+[ -S $SOCK ] && exit 1                  # server didn't remove its socket
+exit $STATUS
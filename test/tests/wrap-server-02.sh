@@ -0,0 +1,28 @@
+# A server split into shards runs requests sent to it by many clients at once
+# the same as one that isn't.
+SOCK=$TEST_TMP/sock
+WRAP_SERVER_SHARDS=2 wrap --server=$SOCK &
+SERVER=$!
+i=0
+until [ -S $SOCK ]
+do
+  i=`expr $i + 1`
+  [ $i -gt 100 ] && { kill $SERVER; exit 1; }
+  sleep 0.1
+done
+
+CLIENTS=
+for i in 1 2 3 4
+do
+  wrap --client=$SOCK -c /dev/null -w30 < $DATA_DIR/data-01.txt \
+    > $TEST_TMP/out$i &
+  CLIENTS="$CLIENTS $!"
+done
+STATUS=0
+for pid in $CLIENTS
+do wait $pid || STATUS=$?
+done
+kill $SERVER && wait $SERVER || exit
+[ -S $SOCK ] && exit 1                  # server didn't remove its socket
+cat $TEST_TMP/out1 $TEST_TMP/out2 $TEST_TMP/out3 $TEST_TMP/out4
+exit $STATUS
@@ -0,0 +1,28 @@
+# A paragraph reformatted for one client is gotten from the cache for another
+# and its output is identical.
+SOCK=$TEST_TMP/sock
+WRAP_SERVER_SHARDS=2 wrap --server=$SOCK &
+SERVER=$!
+i=0
+until [ -S $SOCK ]
+do
+  i=`expr $i + 1`
+  [ $i -gt 100 ] && { kill $SERVER; exit 1; }
+  sleep 0.1
+done
+
+{ cat $DATA_DIR/data-01.txt; echo; cat $DATA_DIR/data-01.txt; } \
+  > $TEST_TMP/input.txt
+STATUS=0
+for i in 1 2
+do
+  wrap --client=$SOCK -c /dev/null -w30 -K$TEST_TMP/cache -R \
+    < $TEST_TMP/input.txt > $TEST_TMP/out$i 2> $TEST_TMP/stats$i ||
+    STATUS=$?
+done
+kill $SERVER && wait $SERVER || exit
+[ -S $SOCK ] && exit 1                  # server didn't remove its socket
+cat $TEST_TMP/out1
+cmp -s $TEST_TMP/out1 $TEST_TMP/out2 && echo "outputs identical"
+tr ' ' '\n' < $TEST_TMP/stats2 | grep '^para_cache\.hits='
+exit $STATUS